@@ -0,0 +1,67 @@
+# Copyright (C) 2011-2018 (see AUTHORS file for a list of contributors)
+#
+# This file is part of GNSS-SDR.
+#
+# GNSS-SDR is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+#
+# GNSS-SDR is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with GNSS-SDR. If not, see <https://www.gnu.org/licenses/>.
+
+# - Find FFTW3F, the single precision FFTW library
+#
+#  FFTW3F_INCLUDE_DIRS - where to find fftw3.h
+#  FFTW3F_LIBRARIES    - List of libraries when using FFTW3F.
+#  FFTW3F_FOUND        - True if FFTW3F found.
+#  FFTW3F_THREADS_LIBRARIES - The multithreaded FFTW3F library, if found.
+
+find_package(PkgConfig)
+pkg_check_modules(PC_FFTW3F "fftw3f >= 3.0")
+
+find_path(FFTW3F_INCLUDE_DIRS
+    NAMES fftw3.h
+    HINTS ${PC_FFTW3F_INCLUDEDIR}
+    PATHS ${FFTW3F_ROOT}/include
+          $ENV{FFTW3F_ROOT}/include
+          ${CMAKE_INSTALL_PREFIX}/include
+          /usr/include
+          /usr/local/include
+          /opt/local/include
+)
+
+find_library(FFTW3F_LIBRARIES
+    NAMES fftw3f libfftw3f
+    HINTS ${PC_FFTW3F_LIBDIR}
+    PATHS ${FFTW3F_ROOT}/lib
+          $ENV{FFTW3F_ROOT}/lib
+          ${CMAKE_INSTALL_PREFIX}/lib
+          ${CMAKE_INSTALL_PREFIX}/lib64
+          /usr/lib
+          /usr/lib64
+          /usr/local/lib
+          /opt/local/lib
+)
+
+find_library(FFTW3F_THREADS_LIBRARIES
+    NAMES fftw3f_threads libfftw3f_threads
+    HINTS ${PC_FFTW3F_LIBDIR}
+    PATHS ${FFTW3F_ROOT}/lib
+          $ENV{FFTW3F_ROOT}/lib
+          ${CMAKE_INSTALL_PREFIX}/lib
+          ${CMAKE_INSTALL_PREFIX}/lib64
+          /usr/lib
+          /usr/lib64
+          /usr/local/lib
+          /opt/local/lib
+)
+
+include(FindPackageHandleStandardArgs)
+find_package_handle_standard_args(FFTW3F DEFAULT_MSG FFTW3F_LIBRARIES FFTW3F_INCLUDE_DIRS)
+mark_as_advanced(FFTW3F_LIBRARIES FFTW3F_THREADS_LIBRARIES FFTW3F_INCLUDE_DIRS)
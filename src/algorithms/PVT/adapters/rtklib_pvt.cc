@@ -5,7 +5,7 @@
  *
  * -------------------------------------------------------------------------
  *
- * Copyright (C) 2010-2018  (see AUTHORS file for a list of contributors)
+ * Copyright (C) 2010-2019  (see AUTHORS file for a list of contributors)
  *
  * GNSS-SDR is a software defined Global Navigation
  *          Satellite Systems receiver
@@ -37,6 +37,8 @@
 #include <boost/archive/xml_oarchive.hpp>
 #include <boost/serialization/map.hpp>
 #include <glog/logging.h>
+#include <algorithm>
+#include <sstream>
 #if OLD_BOOST
 #include <boost/math/common_factor_rt.hpp>
 namespace bc = boost::math;
@@ -76,6 +78,7 @@ RtklibPvt::RtklibPvt(ConfigurationInterface* configuration,
     // NMEA Printer settings
     pvt_output_parameters.flag_nmea_tty_port = configuration->property(role + ".flag_nmea_tty_port", false);
     pvt_output_parameters.nmea_dump_filename = configuration->property(role + ".nmea_dump_filename", default_nmea_dump_filename);
+    pvt_output_parameters.nmea_latency_sentence = configuration->property(role + ".nmea_latency_sentence", false);
     std::string nmea_dump_devname = configuration->property(role + ".nmea_dump_devname", default_nmea_dump_devname);
 
     // RINEX version
@@ -106,6 +109,14 @@ RtklibPvt::RtklibPvt(ConfigurationInterface* configuration,
         }
     pvt_output_parameters.rinexobs_rate_ms = bc::lcm(configuration->property(role + ".rinexobs_rate_ms", 1000), pvt_output_parameters.output_rate_ms);
     pvt_output_parameters.rinexnav_rate_ms = bc::lcm(configuration->property(role + ".rinexnav_rate_ms", 6000), pvt_output_parameters.output_rate_ms);
+    pvt_output_parameters.rinex_rotation = configuration->property(role + ".rinex_rotation", pvt_output_parameters.rinex_rotation);
+    if (pvt_output_parameters.rinex_rotation != "none" and pvt_output_parameters.rinex_rotation != "hourly" and pvt_output_parameters.rinex_rotation != "daily")
+        {
+            std::cout << "Unknown " << role << ".rinex_rotation " << pvt_output_parameters.rinex_rotation << ", the RINEX files will not be rotated" << std::endl;
+            LOG(WARNING) << "Unknown " << role << ".rinex_rotation " << pvt_output_parameters.rinex_rotation;
+            pvt_output_parameters.rinex_rotation = std::string("none");
+        }
+    pvt_output_parameters.rinex_compress = configuration->property(role + ".rinex_compress", pvt_output_parameters.rinex_compress);
 
     // RTCM Printer settings
     pvt_output_parameters.flag_rtcm_tty_port = configuration->property(role + ".flag_rtcm_tty_port", false);
@@ -113,6 +124,9 @@ RtklibPvt::RtklibPvt(ConfigurationInterface* configuration,
     pvt_output_parameters.flag_rtcm_server = configuration->property(role + ".flag_rtcm_server", false);
     pvt_output_parameters.rtcm_tcp_port = configuration->property(role + ".rtcm_tcp_port", 2101);
     pvt_output_parameters.rtcm_station_id = configuration->property(role + ".rtcm_station_id", 1234);
+    pvt_output_parameters.rtcm_ntrip_mountpoint = configuration->property(role + ".rtcm_ntrip_mountpoint", std::string(""));
+    pvt_output_parameters.rtcm_corrections_source = configuration->property(role + ".rtcm_corrections_source", std::string(""));
+    pvt_output_parameters.rtcm_corrections_baud_rate = configuration->property(role + ".rtcm_corrections_baud_rate", pvt_output_parameters.rtcm_corrections_baud_rate);
     // RTCM message rates: least common multiple with output_rate_ms
     int rtcm_MT1019_rate_ms = bc::lcm(configuration->property(role + ".rtcm_MT1019_rate_ms", 5000), pvt_output_parameters.output_rate_ms);
     int rtcm_MT1020_rate_ms = bc::lcm(configuration->property(role + ".rtcm_MT1020_rate_ms", 5000), pvt_output_parameters.output_rate_ms);
@@ -216,6 +230,79 @@ RtklibPvt::RtklibPvt(ConfigurationInterface* configuration,
     if ((gps_1C_count != 0) && (gps_2S_count == 0) && (gps_L5_count != 0) && (gal_1B_count != 0) && (gal_E5a_count != 0) && (gal_E5b_count == 0) && (glo_1G_count == 0) && (glo_2G_count == 0)) pvt_output_parameters.type_of_receiver = 32;  // L1+E1+L5+E5a
     if ((gps_1C_count != 0) && (gps_2S_count == 0) && (gps_L5_count == 0) && (gal_1B_count != 0) && (gal_E5a_count != 0) && (gal_E5b_count == 0) && (glo_1G_count == 0) && (glo_2G_count == 0)) pvt_output_parameters.type_of_receiver = 33;  // L1+E1+E5a
 
+    rtk = make_rtk(configuration, role);
+
+    // Outputs
+    bool default_output_enabled = configuration->property(role + ".output_enabled", true);
+    pvt_output_parameters.output_enabled = default_output_enabled;
+    pvt_output_parameters.rinex_output_enabled = configuration->property(role + ".rinex_output_enabled", default_output_enabled);
+    pvt_output_parameters.gpx_output_enabled = configuration->property(role + ".gpx_output_enabled", default_output_enabled);
+    pvt_output_parameters.geojson_output_enabled = configuration->property(role + ".geojson_output_enabled", default_output_enabled);
+    pvt_output_parameters.kml_output_enabled = configuration->property(role + ".kml_output_enabled", default_output_enabled);
+    pvt_output_parameters.xml_output_enabled = configuration->property(role + ".xml_output_enabled", default_output_enabled);
+    pvt_output_parameters.binary_output_enabled = configuration->property(role + ".binary_output_enabled", pvt_output_parameters.binary_output_enabled);
+    pvt_output_parameters.nmea_output_file_enabled = configuration->property(role + ".nmea_output_file_enabled", default_output_enabled);
+    pvt_output_parameters.rtcm_output_file_enabled = configuration->property(role + ".rtcm_output_file_enabled", default_output_enabled);
+
+    std::string default_output_path = configuration->property(role + ".output_path", std::string("."));
+    pvt_output_parameters.output_path = default_output_path;
+    pvt_output_parameters.rinex_output_path = configuration->property(role + ".rinex_output_path", default_output_path);
+    pvt_output_parameters.gpx_output_path = configuration->property(role + ".gpx_output_path", default_output_path);
+    pvt_output_parameters.geojson_output_path = configuration->property(role + ".geojson_output_path", default_output_path);
+    pvt_output_parameters.kml_output_path = configuration->property(role + ".kml_output_path", default_output_path);
+    pvt_output_parameters.xml_output_path = configuration->property(role + ".xml_output_path", default_output_path);
+    pvt_output_parameters.nmea_output_file_path = configuration->property(role + ".nmea_output_file_path", default_output_path);
+    pvt_output_parameters.rtcm_output_file_path = configuration->property(role + ".rtcm_output_file_path", default_output_path);
+    pvt_output_parameters.output_queue_size = configuration->property(role + ".output_queue_size", pvt_output_parameters.output_queue_size);
+    pvt_output_parameters.output_drop_oldest = configuration->property(role + ".output_drop_oldest", pvt_output_parameters.output_drop_oldest);
+    pvt_output_parameters.output_flush_bytes = configuration->property(role + ".output_flush_bytes", pvt_output_parameters.output_flush_bytes);
+    pvt_output_parameters.output_flush_interval_ms = configuration->property(role + ".output_flush_interval_ms", pvt_output_parameters.output_flush_interval_ms);
+    pvt_output_parameters.nmea_tty_max_pending_bytes = configuration->property(role + ".nmea_tty_max_pending_bytes", pvt_output_parameters.nmea_tty_max_pending_bytes);
+    pvt_output_parameters.nmea_tty_drop_oldest = configuration->property(role + ".nmea_tty_drop_oldest", pvt_output_parameters.nmea_tty_drop_oldest);
+    pvt_output_parameters.precise_solver_queue_size = configuration->property(role + ".precise_solver_queue_size", pvt_output_parameters.precise_solver_queue_size);
+
+    // PVT monitor: addresses separated by '_', as in the Monitor block
+    pvt_output_parameters.monitor_enabled = configuration->property(role + ".enable_monitor", false);
+    std::stringstream monitor_addresses(configuration->property(role + ".monitor_client_addresses", std::string("127.0.0.1")));
+    std::string monitor_address;
+    while (std::getline(monitor_addresses, monitor_address, '_'))
+        {
+            if (!monitor_address.empty() and std::find(pvt_output_parameters.monitor_client_addresses.begin(), pvt_output_parameters.monitor_client_addresses.end(), monitor_address) == pvt_output_parameters.monitor_client_addresses.end())
+                {
+                    pvt_output_parameters.monitor_client_addresses.push_back(monitor_address);
+                }
+        }
+    pvt_output_parameters.monitor_udp_port = configuration->property(role + ".monitor_udp_port", pvt_output_parameters.monitor_udp_port);
+
+    // PVT replay log
+    pvt_output_parameters.replay_log_enabled = configuration->property(role + ".replay_log", pvt_output_parameters.replay_log_enabled);
+    pvt_output_parameters.replay_log_filename = configuration->property(role + ".replay_log_filename", pvt_output_parameters.replay_log_filename);
+
+    // Observables of all the channels in a single input stream
+    pvt_output_parameters.vector_observables = configuration->property("GNSS-SDR.vector_observables", false);
+    pvt_output_parameters.ttff_msg_key = configuration->property("GNSS-SDR.ttff_msg_key", 1101);
+
+    // make PVT object
+    pvt_ = rtklib_make_pvt_cc(in_streams_, pvt_output_parameters, rtk);
+    DLOG(INFO) << "pvt(" << pvt_->unique_id() << ")";
+    if (out_streams_ > 0)
+        {
+            LOG(ERROR) << "The PVT block does not have an output stream";
+        }
+}
+
+
+rtk_t RtklibPvt::make_rtk(ConfigurationInterface* configuration, const std::string& role)
+{
+    int gps_1C_count = configuration->property("Channels_1C.count", 0);
+    int gps_2S_count = configuration->property("Channels_2S.count", 0);
+    int gps_L5_count = configuration->property("Channels_L5.count", 0);
+    int gal_1B_count = configuration->property("Channels_1B.count", 0);
+    int gal_E5a_count = configuration->property("Channels_5X.count", 0);
+    int gal_E5b_count = configuration->property("Channels_7X.count", 0);
+    int glo_1G_count = configuration->property("Channels_1G.count", 0);
+    int glo_2G_count = configuration->property("Channels_2G.count", 0);
+
     // RTKLIB PVT solver options
     // Settings 1
     int positioning_mode = -1;
@@ -479,36 +566,9 @@ RtklibPvt::RtklibPvt(ConfigurationInterface* configuration,
         {}                                                                                 /* char pppopt[256]   ppp option   "-GAP_RESION="  default gap to reset iono parameters (ep) */
     };
 
+    rtk_t rtk{};
     rtkinit(&rtk, &rtklib_configuration_options);
-
-    // Outputs
-    bool default_output_enabled = configuration->property(role + ".output_enabled", true);
-    pvt_output_parameters.output_enabled = default_output_enabled;
-    pvt_output_parameters.rinex_output_enabled = configuration->property(role + ".rinex_output_enabled", default_output_enabled);
-    pvt_output_parameters.gpx_output_enabled = configuration->property(role + ".gpx_output_enabled", default_output_enabled);
-    pvt_output_parameters.geojson_output_enabled = configuration->property(role + ".geojson_output_enabled", default_output_enabled);
-    pvt_output_parameters.kml_output_enabled = configuration->property(role + ".kml_output_enabled", default_output_enabled);
-    pvt_output_parameters.xml_output_enabled = configuration->property(role + ".xml_output_enabled", default_output_enabled);
-    pvt_output_parameters.nmea_output_file_enabled = configuration->property(role + ".nmea_output_file_enabled", default_output_enabled);
-    pvt_output_parameters.rtcm_output_file_enabled = configuration->property(role + ".rtcm_output_file_enabled", default_output_enabled);
-
-    std::string default_output_path = configuration->property(role + ".output_path", std::string("."));
-    pvt_output_parameters.output_path = default_output_path;
-    pvt_output_parameters.rinex_output_path = configuration->property(role + ".rinex_output_path", default_output_path);
-    pvt_output_parameters.gpx_output_path = configuration->property(role + ".gpx_output_path", default_output_path);
-    pvt_output_parameters.geojson_output_path = configuration->property(role + ".geojson_output_path", default_output_path);
-    pvt_output_parameters.kml_output_path = configuration->property(role + ".kml_output_path", default_output_path);
-    pvt_output_parameters.xml_output_path = configuration->property(role + ".xml_output_path", default_output_path);
-    pvt_output_parameters.nmea_output_file_path = configuration->property(role + ".nmea_output_file_path", default_output_path);
-    pvt_output_parameters.rtcm_output_file_path = configuration->property(role + ".rtcm_output_file_path", default_output_path);
-
-    // make PVT object
-    pvt_ = rtklib_make_pvt_cc(in_streams_, pvt_output_parameters, rtk);
-    DLOG(INFO) << "pvt(" << pvt_->unique_id() << ")";
-    if (out_streams_ > 0)
-        {
-            LOG(ERROR) << "The PVT block does not have an output stream";
-        }
+    return rtk;
 }
 
 
@@ -534,31 +594,43 @@ bool RtklibPvt::get_latest_PVT(double* longitude_deg,
 }
 
 
+void RtklibPvt::suspend_position_outputs(bool suspend)
+{
+    pvt_->suspend_position_outputs(suspend);
+}
+
+
+std::shared_ptr<const Pvt_Status> RtklibPvt::get_status() const
+{
+    return pvt_->get_status();
+}
+
+
 void RtklibPvt::clear_ephemeris()
 {
     pvt_->clear_ephemeris();
 }
 
 
-std::map<int, Gps_Ephemeris> RtklibPvt::get_gps_ephemeris() const
+std::shared_ptr<const std::map<int, Gps_Ephemeris>> RtklibPvt::get_gps_ephemeris() const
 {
     return pvt_->get_gps_ephemeris_map();
 }
 
 
-std::map<int, Galileo_Ephemeris> RtklibPvt::get_galileo_ephemeris() const
+std::shared_ptr<const std::map<int, Galileo_Ephemeris>> RtklibPvt::get_galileo_ephemeris() const
 {
     return pvt_->get_galileo_ephemeris_map();
 }
 
 
-std::map<int, Gps_Almanac> RtklibPvt::get_gps_almanac() const
+std::shared_ptr<const std::map<int, Gps_Almanac>> RtklibPvt::get_gps_almanac() const
 {
     return pvt_->get_gps_almanac_map();
 }
 
 
-std::map<int, Galileo_Almanac> RtklibPvt::get_galileo_almanac() const
+std::shared_ptr<const std::map<int, Galileo_Almanac>> RtklibPvt::get_galileo_almanac() const
 {
     return pvt_->get_galileo_almanac_map();
 }
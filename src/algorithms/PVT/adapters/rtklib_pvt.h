@@ -52,6 +52,12 @@ public:
 
     virtual ~RtklibPvt();
 
+    /*!
+     * \brief Builds the RTKLIB solver state from the \p role properties of
+     * \p configuration (positioning mode, masks, models, AR settings...)
+     */
+    static rtk_t make_rtk(ConfigurationInterface* configuration, const std::string& role);
+
     inline std::string role() override
     {
         return role_;
@@ -64,10 +70,10 @@ public:
     }
 
     void clear_ephemeris() override;
-    std::map<int, Gps_Ephemeris> get_gps_ephemeris() const override;
-    std::map<int, Galileo_Ephemeris> get_galileo_ephemeris() const override;
-    std::map<int, Gps_Almanac> get_gps_almanac() const override;
-    std::map<int, Galileo_Almanac> get_galileo_almanac() const override;
+    std::shared_ptr<const std::map<int, Gps_Ephemeris>> get_gps_ephemeris() const override;
+    std::shared_ptr<const std::map<int, Galileo_Ephemeris>> get_galileo_ephemeris() const override;
+    std::shared_ptr<const std::map<int, Gps_Almanac>> get_gps_almanac() const override;
+    std::shared_ptr<const std::map<int, Galileo_Almanac>> get_galileo_almanac() const override;
 
     void connect(gr::top_block_sptr top_block) override;
     void disconnect(gr::top_block_sptr top_block) override;
@@ -92,6 +98,10 @@ public:
         double* course_over_ground_deg,
         time_t* UTC_time) override;
 
+    void suspend_position_outputs(bool suspend) override;
+
+    std::shared_ptr<const Pvt_Status> get_status() const override;
+
 private:
     rtklib_pvt_cc_sptr pvt_;
     rtk_t rtk{};
@@ -5,7 +5,7 @@
  *
  * -------------------------------------------------------------------------
  *
- * Copyright (C) 2010-2018  (see AUTHORS file for a list of contributors)
+ * Copyright (C) 2010-2019  (see AUTHORS file for a list of contributors)
  *
  * GNSS-SDR is a software defined Global Navigation
  *          Satellite Systems receiver
@@ -32,8 +32,11 @@
 #include "display.h"
 #include "galileo_almanac.h"
 #include "galileo_almanac_helper.h"
+#include "gnss_profiler.h"
 #include "gnss_sdr_create_directory.h"
+#include "gnss_trace.h"
 #include "pvt_conf.h"
+#include "source_overflow_counter.h"
 #include <boost/archive/xml_iarchive.hpp>
 #include <boost/archive/xml_oarchive.hpp>
 #include <boost/exception/all.hpp>
@@ -44,8 +47,10 @@
 #include <gnuradio/io_signature.h>
 #include <algorithm>
 #include <exception>
+#include <iomanip>
 #include <iostream>
 #include <map>
+#include <typeindex>
 #if OLD_BOOST
 #include <boost/math/common_factor_rt.hpp>
 namespace bc = boost::math;
@@ -56,6 +61,9 @@ namespace bc = boost::integer;
 
 using google::LogMessage;
 
+// Minimum time between two status snapshots
+const int STATUS_PERIOD_MS = 100;
+
 
 rtklib_pvt_cc_sptr rtklib_make_pvt_cc(uint32_t nchannels,
     const Pvt_Conf& conf_,
@@ -69,207 +77,307 @@ rtklib_pvt_cc_sptr rtklib_make_pvt_cc(uint32_t nchannels,
 
 void rtklib_pvt_cc::msg_handler_telemetry(pmt::pmt_t msg)
 {
-    try
+    const boost::any& telemetry = pmt::any_ref(msg);
+    const auto handler = d_telemetry_handlers.find(std::type_index(telemetry.type()));
+    if (handler != d_telemetry_handlers.cend())
         {
-            // ************* GPS telemetry *****************
-            if (pmt::any_ref(msg).type() == typeid(std::shared_ptr<Gps_Ephemeris>))
-                {
-                    // ### GPS EPHEMERIS ###
-                    std::shared_ptr<Gps_Ephemeris> gps_eph;
-                    gps_eph = boost::any_cast<std::shared_ptr<Gps_Ephemeris>>(pmt::any_ref(msg));
-                    DLOG(INFO) << "Ephemeris record has arrived from SAT ID "
-                               << gps_eph->i_satellite_PRN << " (Block "
-                               << gps_eph->satelliteBlock[gps_eph->i_satellite_PRN] << ")"
-                               << "inserted with Toe=" << gps_eph->d_Toe << " and GPS Week="
-                               << gps_eph->i_GPS_week;
-                    // update/insert new ephemeris record to the global ephemeris map
-                    d_pvt_solver->gps_ephemeris_map[gps_eph->i_satellite_PRN] = *gps_eph;
-                }
-            else if (pmt::any_ref(msg).type() == typeid(std::shared_ptr<Gps_Iono>))
-                {
-                    // ### GPS IONO ###
-                    std::shared_ptr<Gps_Iono> gps_iono;
-                    gps_iono = boost::any_cast<std::shared_ptr<Gps_Iono>>(pmt::any_ref(msg));
-                    d_pvt_solver->gps_iono = *gps_iono;
-                    DLOG(INFO) << "New IONO record has arrived ";
-                }
-            else if (pmt::any_ref(msg).type() == typeid(std::shared_ptr<Gps_Utc_Model>))
-                {
-                    // ### GPS UTC MODEL ###
-                    std::shared_ptr<Gps_Utc_Model> gps_utc_model;
-                    gps_utc_model = boost::any_cast<std::shared_ptr<Gps_Utc_Model>>(pmt::any_ref(msg));
-                    d_pvt_solver->gps_utc_model = *gps_utc_model;
-                    DLOG(INFO) << "New UTC record has arrived ";
-                }
-            else if (pmt::any_ref(msg).type() == typeid(std::shared_ptr<Gps_CNAV_Ephemeris>))
-                {
-                    // ### GPS CNAV message ###
-                    std::shared_ptr<Gps_CNAV_Ephemeris> gps_cnav_ephemeris;
-                    gps_cnav_ephemeris = boost::any_cast<std::shared_ptr<Gps_CNAV_Ephemeris>>(pmt::any_ref(msg));
-                    // update/insert new ephemeris record to the global ephemeris map
-                    d_pvt_solver->gps_cnav_ephemeris_map[gps_cnav_ephemeris->i_satellite_PRN] = *gps_cnav_ephemeris;
-                    DLOG(INFO) << "New GPS CNAV ephemeris record has arrived ";
-                }
-            else if (pmt::any_ref(msg).type() == typeid(std::shared_ptr<Gps_CNAV_Iono>))
-                {
-                    // ### GPS CNAV IONO ###
-                    std::shared_ptr<Gps_CNAV_Iono> gps_cnav_iono;
-                    gps_cnav_iono = boost::any_cast<std::shared_ptr<Gps_CNAV_Iono>>(pmt::any_ref(msg));
-                    d_pvt_solver->gps_cnav_iono = *gps_cnav_iono;
-                    DLOG(INFO) << "New CNAV IONO record has arrived ";
-                }
-            else if (pmt::any_ref(msg).type() == typeid(std::shared_ptr<Gps_CNAV_Utc_Model>))
-                {
-                    // ### GPS CNAV UTC MODEL ###
-                    std::shared_ptr<Gps_CNAV_Utc_Model> gps_cnav_utc_model;
-                    gps_cnav_utc_model = boost::any_cast<std::shared_ptr<Gps_CNAV_Utc_Model>>(pmt::any_ref(msg));
-                    d_pvt_solver->gps_cnav_utc_model = *gps_cnav_utc_model;
-                    DLOG(INFO) << "New CNAV UTC record has arrived ";
-                }
+            handler->second(telemetry);
+        }
+    else
+        {
+            LOG(WARNING) << "msg_handler_telemetry unknown object type!";
+        }
+}
 
-            else if (pmt::any_ref(msg).type() == typeid(std::shared_ptr<Gps_Almanac>))
-                {
-                    // ### GPS ALMANAC ###
-                    std::shared_ptr<Gps_Almanac> gps_almanac;
-                    gps_almanac = boost::any_cast<std::shared_ptr<Gps_Almanac>>(pmt::any_ref(msg));
-                    d_pvt_solver->gps_almanac_map[gps_almanac->i_satellite_PRN] = *gps_almanac;
-                    DLOG(INFO) << "New GPS almanac record has arrived ";
-                }
 
-            // **************** Galileo telemetry ********************
-            else if (pmt::any_ref(msg).type() == typeid(std::shared_ptr<Galileo_Ephemeris>))
-                {
-                    // ### Galileo EPHEMERIS ###
-                    std::shared_ptr<Galileo_Ephemeris> galileo_eph;
-                    galileo_eph = boost::any_cast<std::shared_ptr<Galileo_Ephemeris>>(pmt::any_ref(msg));
-                    // insert new ephemeris record
-                    DLOG(INFO) << "Galileo New Ephemeris record inserted in global map with TOW =" << galileo_eph->TOW_5
-                               << ", GALILEO Week Number =" << galileo_eph->WN_5
-                               << " and Ephemeris IOD = " << galileo_eph->IOD_ephemeris;
-                    // update/insert new ephemeris record to the global ephemeris map
-                    d_pvt_solver->galileo_ephemeris_map[galileo_eph->i_satellite_PRN] = *galileo_eph;
-                }
-            else if (pmt::any_ref(msg).type() == typeid(std::shared_ptr<Galileo_Iono>))
-                {
-                    // ### Galileo IONO ###
-                    std::shared_ptr<Galileo_Iono> galileo_iono;
-                    galileo_iono = boost::any_cast<std::shared_ptr<Galileo_Iono>>(pmt::any_ref(msg));
-                    d_pvt_solver->galileo_iono = *galileo_iono;
-                    DLOG(INFO) << "New IONO record has arrived ";
-                }
-            else if (pmt::any_ref(msg).type() == typeid(std::shared_ptr<Galileo_Utc_Model>))
-                {
-                    // ### Galileo UTC MODEL ###
-                    std::shared_ptr<Galileo_Utc_Model> galileo_utc_model;
-                    galileo_utc_model = boost::any_cast<std::shared_ptr<Galileo_Utc_Model>>(pmt::any_ref(msg));
-                    d_pvt_solver->galileo_utc_model = *galileo_utc_model;
-                    DLOG(INFO) << "New UTC record has arrived ";
-                }
-            else if (pmt::any_ref(msg).type() == typeid(std::shared_ptr<Galileo_Almanac_Helper>))
-                {
-                    // ### Galileo Almanac ###
-                    std::shared_ptr<Galileo_Almanac_Helper> galileo_almanac_helper;
-                    galileo_almanac_helper = boost::any_cast<std::shared_ptr<Galileo_Almanac_Helper>>(pmt::any_ref(msg));
-
-                    Galileo_Almanac sv1 = galileo_almanac_helper->get_almanac(1);
-                    Galileo_Almanac sv2 = galileo_almanac_helper->get_almanac(2);
-                    Galileo_Almanac sv3 = galileo_almanac_helper->get_almanac(3);
-
-                    if (sv1.i_satellite_PRN != 0) d_pvt_solver->galileo_almanac_map[sv1.i_satellite_PRN] = sv1;
-                    if (sv2.i_satellite_PRN != 0) d_pvt_solver->galileo_almanac_map[sv2.i_satellite_PRN] = sv2;
-                    if (sv3.i_satellite_PRN != 0) d_pvt_solver->galileo_almanac_map[sv3.i_satellite_PRN] = sv3;
-                    DLOG(INFO) << "New Galileo Almanac data have arrived ";
-                }
-            else if (pmt::any_ref(msg).type() == typeid(std::shared_ptr<Galileo_Almanac>))
-                {
-                    // ### Galileo Almanac ###
-                    std::shared_ptr<Galileo_Almanac> galileo_alm;
-                    galileo_alm = boost::any_cast<std::shared_ptr<Galileo_Almanac>>(pmt::any_ref(msg));
-                    // update/insert new almanac record to the global almanac map
-                    d_pvt_solver->galileo_almanac_map[galileo_alm->i_satellite_PRN] = *galileo_alm;
-                }
+void rtklib_pvt_cc::init_telemetry_handlers()
+{
+    // ************* GPS telemetry *****************
+    add_telemetry_handler<Gps_Ephemeris>([this](const std::shared_ptr<Gps_Ephemeris>& gps_eph) {
+        // ### GPS EPHEMERIS ###
+        DLOG(INFO) << "Ephemeris record has arrived from SAT ID "
+                   << gps_eph->i_satellite_PRN << " (Block "
+                   << gps_eph->satelliteBlock[gps_eph->i_satellite_PRN] << ")"
+                   << "inserted with Toe=" << gps_eph->d_Toe << " and GPS Week="
+                   << gps_eph->i_GPS_week;
+        // update/insert new ephemeris record to the global ephemeris map
+        d_pvt_solver->gps_ephemeris_map[gps_eph->i_satellite_PRN] = *gps_eph;
+        save_binary_store("gps_ephemeris", "GNSS-SDR_ephemeris_map", d_pvt_solver->gps_ephemeris_map);
+        publish_snapshot(d_gps_ephemeris_snapshot, d_pvt_solver->gps_ephemeris_map);
+    });
+    add_telemetry_handler<Gps_Iono>([this](const std::shared_ptr<Gps_Iono>& gps_iono) {
+        // ### GPS IONO ###
+        d_pvt_solver->gps_iono = *gps_iono;
+        save_binary_store("gps_iono", "GNSS-SDR_iono_model", d_pvt_solver->gps_iono);
+        DLOG(INFO) << "New IONO record has arrived ";
+    });
+    add_telemetry_handler<Gps_Utc_Model>([this](const std::shared_ptr<Gps_Utc_Model>& gps_utc_model) {
+        // ### GPS UTC MODEL ###
+        d_pvt_solver->gps_utc_model = *gps_utc_model;
+        save_binary_store("gps_utc_model", "GNSS-SDR_utc_model", d_pvt_solver->gps_utc_model);
+        DLOG(INFO) << "New UTC record has arrived ";
+    });
+    add_telemetry_handler<Gps_CNAV_Ephemeris>([this](const std::shared_ptr<Gps_CNAV_Ephemeris>& gps_cnav_ephemeris) {
+        // ### GPS CNAV message ###
+        // update/insert new ephemeris record to the global ephemeris map
+        d_pvt_solver->gps_cnav_ephemeris_map[gps_cnav_ephemeris->i_satellite_PRN] = *gps_cnav_ephemeris;
+        save_binary_store("gps_cnav_ephemeris", "GNSS-SDR_cnav_ephemeris_map", d_pvt_solver->gps_cnav_ephemeris_map);
+        DLOG(INFO) << "New GPS CNAV ephemeris record has arrived ";
+    });
+    add_telemetry_handler<Gps_CNAV_Iono>([this](const std::shared_ptr<Gps_CNAV_Iono>& gps_cnav_iono) {
+        // ### GPS CNAV IONO ###
+        d_pvt_solver->gps_cnav_iono = *gps_cnav_iono;
+        save_binary_store("gps_cnav_iono", "GNSS-SDR_cnav_iono_model", d_pvt_solver->gps_cnav_iono);
+        DLOG(INFO) << "New CNAV IONO record has arrived ";
+    });
+    add_telemetry_handler<Gps_CNAV_Utc_Model>([this](const std::shared_ptr<Gps_CNAV_Utc_Model>& gps_cnav_utc_model) {
+        // ### GPS CNAV UTC MODEL ###
+        d_pvt_solver->gps_cnav_utc_model = *gps_cnav_utc_model;
+        save_binary_store("gps_cnav_utc_model", "GNSS-SDR_cnav_utc_model", d_pvt_solver->gps_cnav_utc_model);
+        DLOG(INFO) << "New CNAV UTC record has arrived ";
+    });
+    add_telemetry_handler<Gps_Almanac>([this](const std::shared_ptr<Gps_Almanac>& gps_almanac) {
+        // ### GPS ALMANAC ###
+        d_pvt_solver->gps_almanac_map[gps_almanac->i_satellite_PRN] = *gps_almanac;
+        save_binary_store("gps_almanac", "GNSS-SDR_gps_almanac_map", d_pvt_solver->gps_almanac_map);
+        publish_snapshot(d_gps_almanac_snapshot, d_pvt_solver->gps_almanac_map);
+        DLOG(INFO) << "New GPS almanac record has arrived ";
+    });
+
+    // **************** Galileo telemetry ********************
+    add_telemetry_handler<Galileo_Ephemeris>([this](const std::shared_ptr<Galileo_Ephemeris>& galileo_eph) {
+        // ### Galileo EPHEMERIS ###
+        // insert new ephemeris record
+        DLOG(INFO) << "Galileo New Ephemeris record inserted in global map with TOW =" << galileo_eph->TOW_5
+                   << ", GALILEO Week Number =" << galileo_eph->WN_5
+                   << " and Ephemeris IOD = " << galileo_eph->IOD_ephemeris;
+        // update/insert new ephemeris record to the global ephemeris map
+        d_pvt_solver->galileo_ephemeris_map[galileo_eph->i_satellite_PRN] = *galileo_eph;
+        save_binary_store("gal_ephemeris", "GNSS-SDR_gal_ephemeris_map", d_pvt_solver->galileo_ephemeris_map);
+        publish_snapshot(d_galileo_ephemeris_snapshot, d_pvt_solver->galileo_ephemeris_map);
+    });
+    add_telemetry_handler<Galileo_Iono>([this](const std::shared_ptr<Galileo_Iono>& galileo_iono) {
+        // ### Galileo IONO ###
+        d_pvt_solver->galileo_iono = *galileo_iono;
+        save_binary_store("gal_iono", "GNSS-SDR_gal_iono_model", d_pvt_solver->galileo_iono);
+        DLOG(INFO) << "New IONO record has arrived ";
+    });
+    add_telemetry_handler<Galileo_Utc_Model>([this](const std::shared_ptr<Galileo_Utc_Model>& galileo_utc_model) {
+        // ### Galileo UTC MODEL ###
+        d_pvt_solver->galileo_utc_model = *galileo_utc_model;
+        save_binary_store("gal_utc_model", "GNSS-SDR_gal_utc_model", d_pvt_solver->galileo_utc_model);
+        DLOG(INFO) << "New UTC record has arrived ";
+    });
+    add_telemetry_handler<Galileo_Almanac_Helper>([this](const std::shared_ptr<Galileo_Almanac_Helper>& galileo_almanac_helper) {
+        // ### Galileo Almanac ###
+        Galileo_Almanac sv1 = galileo_almanac_helper->get_almanac(1);
+        Galileo_Almanac sv2 = galileo_almanac_helper->get_almanac(2);
+        Galileo_Almanac sv3 = galileo_almanac_helper->get_almanac(3);
+
+        if (sv1.i_satellite_PRN != 0) d_pvt_solver->galileo_almanac_map[sv1.i_satellite_PRN] = sv1;
+        if (sv2.i_satellite_PRN != 0) d_pvt_solver->galileo_almanac_map[sv2.i_satellite_PRN] = sv2;
+        if (sv3.i_satellite_PRN != 0) d_pvt_solver->galileo_almanac_map[sv3.i_satellite_PRN] = sv3;
+        save_binary_store("gal_almanac", "GNSS-SDR_gal_almanac_map", d_pvt_solver->galileo_almanac_map);
+        publish_snapshot(d_galileo_almanac_snapshot, d_pvt_solver->galileo_almanac_map);
+        DLOG(INFO) << "New Galileo Almanac data have arrived ";
+    });
+    add_telemetry_handler<Galileo_Almanac>([this](const std::shared_ptr<Galileo_Almanac>& galileo_alm) {
+        // ### Galileo Almanac ###
+        // update/insert new almanac record to the global almanac map
+        d_pvt_solver->galileo_almanac_map[galileo_alm->i_satellite_PRN] = *galileo_alm;
+        save_binary_store("gal_almanac", "GNSS-SDR_gal_almanac_map", d_pvt_solver->galileo_almanac_map);
+        publish_snapshot(d_galileo_almanac_snapshot, d_pvt_solver->galileo_almanac_map);
+    });
+
+    // **************** GLONASS GNAV Telemetry **************************
+    add_telemetry_handler<Glonass_Gnav_Ephemeris>([this](const std::shared_ptr<Glonass_Gnav_Ephemeris>& glonass_gnav_eph) {
+        // ### GLONASS GNAV EPHEMERIS ###
+        // TODO Add GLONASS with gps week number and tow,
+        // insert new ephemeris record
+        DLOG(INFO) << "GLONASS GNAV New Ephemeris record inserted in global map with TOW =" << glonass_gnav_eph->d_TOW
+                   << ", Week Number =" << glonass_gnav_eph->d_WN
+                   << " and Ephemeris IOD in UTC = " << glonass_gnav_eph->compute_GLONASS_time(glonass_gnav_eph->d_t_b)
+                   << " from SV = " << glonass_gnav_eph->i_satellite_slot_number;
+        // update/insert new ephemeris record to the global ephemeris map
+        d_pvt_solver->glonass_gnav_ephemeris_map[glonass_gnav_eph->i_satellite_PRN] = *glonass_gnav_eph;
+        save_binary_store("glo_gnav_ephemeris", "GNSS-SDR_gnav_ephemeris_map", d_pvt_solver->glonass_gnav_ephemeris_map);
+    });
+    add_telemetry_handler<Glonass_Gnav_Utc_Model>([this](const std::shared_ptr<Glonass_Gnav_Utc_Model>& glonass_gnav_utc_model) {
+        // ### GLONASS GNAV UTC MODEL ###
+        d_pvt_solver->glonass_gnav_utc_model = *glonass_gnav_utc_model;
+        save_binary_store("glo_utc_model", "GNSS-SDR_glo_utc_model", d_pvt_solver->glonass_gnav_utc_model);
+        DLOG(INFO) << "New GLONASS GNAV UTC record has arrived ";
+    });
+    add_telemetry_handler<Glonass_Gnav_Almanac>([this](const std::shared_ptr<Glonass_Gnav_Almanac>& glonass_gnav_almanac) {
+        // ### GLONASS GNAV Almanac ###
+        d_pvt_solver->glonass_gnav_almanac = *glonass_gnav_almanac;
+        DLOG(INFO) << "New GLONASS GNAV Almanac has arrived "
+                   << ", GLONASS GNAV Slot Number =" << glonass_gnav_almanac->d_n_A;
+    });
+}
 
-            // **************** GLONASS GNAV Telemetry **************************
-            else if (pmt::any_ref(msg).type() == typeid(std::shared_ptr<Glonass_Gnav_Ephemeris>))
-                {
-                    // ### GLONASS GNAV EPHEMERIS ###
-                    std::shared_ptr<Glonass_Gnav_Ephemeris> glonass_gnav_eph;
-                    glonass_gnav_eph = boost::any_cast<std::shared_ptr<Glonass_Gnav_Ephemeris>>(pmt::any_ref(msg));
-                    // TODO Add GLONASS with gps week number and tow,
-                    // insert new ephemeris record
-                    DLOG(INFO) << "GLONASS GNAV New Ephemeris record inserted in global map with TOW =" << glonass_gnav_eph->d_TOW
-                               << ", Week Number =" << glonass_gnav_eph->d_WN
-                               << " and Ephemeris IOD in UTC = " << glonass_gnav_eph->compute_GLONASS_time(glonass_gnav_eph->d_t_b)
-                               << " from SV = " << glonass_gnav_eph->i_satellite_slot_number;
-                    // update/insert new ephemeris record to the global ephemeris map
-                    d_pvt_solver->glonass_gnav_ephemeris_map[glonass_gnav_eph->i_satellite_PRN] = *glonass_gnav_eph;
-                }
-            else if (pmt::any_ref(msg).type() == typeid(std::shared_ptr<Glonass_Gnav_Utc_Model>))
-                {
-                    // ### GLONASS GNAV UTC MODEL ###
-                    std::shared_ptr<Glonass_Gnav_Utc_Model> glonass_gnav_utc_model;
-                    glonass_gnav_utc_model = boost::any_cast<std::shared_ptr<Glonass_Gnav_Utc_Model>>(pmt::any_ref(msg));
-                    d_pvt_solver->glonass_gnav_utc_model = *glonass_gnav_utc_model;
-                    DLOG(INFO) << "New GLONASS GNAV UTC record has arrived ";
-                }
-            else if (pmt::any_ref(msg).type() == typeid(std::shared_ptr<Glonass_Gnav_Almanac>))
+
+void rtklib_pvt_cc::write_precise_solutions()
+{
+    Pvt_Precise_Solution precise;
+    while (d_pvt_solver->pop_precise_solution(precise))
+        {
+            if (!d_precise_solutions_file.is_open())
                 {
-                    // ### GLONASS GNAV Almanac ###
-                    std::shared_ptr<Glonass_Gnav_Almanac> glonass_gnav_almanac;
-                    glonass_gnav_almanac = boost::any_cast<std::shared_ptr<Glonass_Gnav_Almanac>>(pmt::any_ref(msg));
-                    d_pvt_solver->glonass_gnav_almanac = *glonass_gnav_almanac;
-                    DLOG(INFO) << "New GLONASS GNAV Almanac has arrived "
-                               << ", GLONASS GNAV Slot Number =" << glonass_gnav_almanac->d_n_A;
+                    continue;
                 }
-            else
+            int week = 0;
+            double tow = time2gpst(precise.sol.time, &week);
+            d_precise_solutions_file << week << " " << std::setprecision(3) << tow << " "
+                                     << std::setprecision(4) << precise.sol.rr[0] << " " << precise.sol.rr[1] << " " << precise.sol.rr[2] << " "
+                                     << static_cast<int>(precise.sol.stat) << " " << static_cast<int>(precise.sol.ns) << " "
+                                     << std::setprecision(1) << precise.latency_s * 1000.0 << "\n";
+        }
+}
+
+
+void rtklib_pvt_cc::publish_monitor_pvt(double latency_s)
+{
+    const sol_t& sol = d_pvt_solver->pvt_sol;
+    int week = 0;
+    double tow = time2gpst(sol.time, &week);
+    double clock_bias = d_pvt_solver->get_time_offset_s();
+    double dt = tow - d_monitor_pvt.tow_s + 604800.0 * (week - d_monitor_pvt.week);
+    // RTKLIB does not estimate the clock drift: differences of consecutive solutions
+    d_monitor_pvt.clock_drift_s_s = (d_monitor_pvt.sequence > 0 and dt > 0.0) ? (clock_bias - d_monitor_pvt.clock_bias_s) / dt : 0.0;
+    d_monitor_pvt.sequence++;
+    d_monitor_pvt.week = week;
+    d_monitor_pvt.tow_s = tow;
+    d_monitor_pvt.pos_x_m = sol.rr[0];
+    d_monitor_pvt.pos_y_m = sol.rr[1];
+    d_monitor_pvt.pos_z_m = sol.rr[2];
+    d_monitor_pvt.vel_x_m_s = sol.rr[3];
+    d_monitor_pvt.vel_y_m_s = sol.rr[4];
+    d_monitor_pvt.vel_z_m_s = sol.rr[5];
+    d_monitor_pvt.latitude_deg = d_pvt_solver->get_latitude();
+    d_monitor_pvt.longitude_deg = d_pvt_solver->get_longitude();
+    d_monitor_pvt.height_m = d_pvt_solver->get_height();
+    d_monitor_pvt.clock_bias_s = clock_bias;
+    d_monitor_pvt.gdop = d_pvt_solver->get_gdop();
+    d_monitor_pvt.pdop = d_pvt_solver->get_pdop();
+    d_monitor_pvt.hdop = d_pvt_solver->get_hdop();
+    d_monitor_pvt.vdop = d_pvt_solver->get_vdop();
+    d_monitor_pvt.valid_sats = sol.ns;
+    d_monitor_pvt.status = sol.stat;
+    d_monitor_pvt.latency_us = static_cast<uint32_t>(latency_s * 1e6);
+    d_monitor_pvt.source_overflows = signal_source_overflows().load(std::memory_order_relaxed);
+    d_monitor_pvt.end_to_end_latency_us = static_cast<uint32_t>(d_pvt_solver->get_latency_s() * 1e6);
+    d_udp_sink_ptr->write_monitor_pvt(d_monitor_pvt);
+}
+
+
+double rtklib_pvt_cc::end_to_end_latency_s(uint64_t item) const
+{
+    for (const auto& tag : d_arrival_tags)
+        {
+            if (tag.offset == item)
                 {
-                    LOG(WARNING) << "msg_handler_telemetry unknown object type!";
+                    int64_t now_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+                    return static_cast<double>(now_ns - static_cast<int64_t>(pmt::to_uint64(tag.value))) * 1e-9;
                 }
         }
-    catch (boost::bad_any_cast& e)
+    return 0.0;
+}
+
+
+void rtklib_pvt_cc::suspend_position_outputs(bool suspend)
+{
+    d_position_outputs_suspended.store(suspend, std::memory_order_relaxed);
+}
+
+
+void rtklib_pvt_cc::print_position_outputs(const Pvt_Output_Solution& solution)
+{
+    Gnss_Profile_Scope profile("position_printers");
+    if (d_kml_output_enabled) d_kml_dump->print_position(solution, false);
+    if (d_gpx_output_enabled) d_gpx_dump->print_position(solution, false);
+    if (d_geojson_output_enabled) d_geojson_printer->print_position(solution, false);
+    if (d_nmea_output_file_enabled) d_nmea_printer->Print_Nmea_Line(solution, false);
+}
+
+
+int64_t rtklib_pvt_cc::get_rinex_period() const
+{
+    if (d_rinex_rotation == "none")
+        {
+            return 0;
+        }
+    // local time, as the names of the RINEX files, so a new period always gets new names
+    boost::posix_time::ptime now = boost::posix_time::second_clock::local_time();
+    int64_t day = now.date().day_number();
+    if (d_rinex_rotation == "daily")
         {
-            LOG(WARNING) << "msg_handler_telemetry Bad any cast!";
+            return day;
         }
+    return day * 24 + now.time_of_day().hours();
 }
 
 
-std::map<int, Gps_Ephemeris> rtklib_pvt_cc::get_gps_ephemeris_map() const
+void rtklib_pvt_cc::rotate_rinex_files()
 {
-    return d_pvt_solver->gps_ephemeris_map;
+    // the archiver thread closes (and compresses) the old files
+    d_rinex_archiver->release(std::move(rp));
+    rp = std::make_shared<Rinex_Printer>(d_rinex_version, d_rinex_output_path);
+    b_rinex_header_written = false;
+    b_rinex_header_updated = false;
+    d_rinex_period = get_rinex_period();
 }
 
 
-std::map<int, Gps_Almanac> rtklib_pvt_cc::get_gps_almanac_map() const
+std::shared_ptr<const std::map<int, Gps_Ephemeris>> rtklib_pvt_cc::get_gps_ephemeris_map() const
 {
-    return d_pvt_solver->gps_almanac_map;
+    return std::atomic_load(&d_gps_ephemeris_snapshot);
 }
 
 
-std::map<int, Galileo_Ephemeris> rtklib_pvt_cc::get_galileo_ephemeris_map() const
+std::shared_ptr<const std::map<int, Gps_Almanac>> rtklib_pvt_cc::get_gps_almanac_map() const
 {
-    return d_pvt_solver->galileo_ephemeris_map;
+    return std::atomic_load(&d_gps_almanac_snapshot);
 }
 
 
-std::map<int, Galileo_Almanac> rtklib_pvt_cc::get_galileo_almanac_map() const
+std::shared_ptr<const std::map<int, Galileo_Ephemeris>> rtklib_pvt_cc::get_galileo_ephemeris_map() const
 {
-    return d_pvt_solver->galileo_almanac_map;
+    return std::atomic_load(&d_galileo_ephemeris_snapshot);
+}
+
+
+std::shared_ptr<const std::map<int, Galileo_Almanac>> rtklib_pvt_cc::get_galileo_almanac_map() const
+{
+    return std::atomic_load(&d_galileo_almanac_snapshot);
+}
+
+
+std::shared_ptr<const Pvt_Status> rtklib_pvt_cc::get_status() const
+{
+    return std::atomic_load(&d_status_snapshot);
 }
 
 
 void rtklib_pvt_cc::clear_ephemeris()
 {
+    // called from the control thread: wait for the current work() call
+    gr::thread::scoped_lock l(d_setlock);
     d_pvt_solver->gps_ephemeris_map.clear();
     d_pvt_solver->gps_almanac_map.clear();
     d_pvt_solver->galileo_ephemeris_map.clear();
     d_pvt_solver->galileo_almanac_map.clear();
+    publish_snapshot(d_gps_ephemeris_snapshot, d_pvt_solver->gps_ephemeris_map);
+    publish_snapshot(d_gps_almanac_snapshot, d_pvt_solver->gps_almanac_map);
+    publish_snapshot(d_galileo_ephemeris_snapshot, d_pvt_solver->galileo_ephemeris_map);
+    publish_snapshot(d_galileo_almanac_snapshot, d_pvt_solver->galileo_almanac_map);
 }
 
 
 rtklib_pvt_cc::rtklib_pvt_cc(uint32_t nchannels,
     const Pvt_Conf& conf_,
     const rtk_t& rtk) : gr::sync_block("rtklib_pvt_cc",
-                            gr::io_signature::make(nchannels, nchannels, sizeof(Gnss_Synchro)),
+                            conf_.vector_observables ? gr::io_signature::make(1, 1, sizeof(Gnss_Synchro) * nchannels) : gr::io_signature::make(nchannels, nchannels, sizeof(Gnss_Synchro)),
                             gr::io_signature::make(0, 0, 0))
 {
     d_output_rate_ms = conf_.output_rate_ms;
@@ -312,20 +420,27 @@ rtklib_pvt_cc::rtklib_pvt_cc(uint32_t nchannels,
         }
 
     d_nchannels = nchannels;
+    d_vector_observables = conf_.vector_observables;
+    d_epoch_observables = std::vector<const Gnss_Synchro*>(d_nchannels, nullptr);
+    d_gnss_observables = std::vector<Gnss_Synchro>(d_nchannels);
+    d_valid_channels.reserve(d_nchannels);
 
     type_of_rx = conf_.type_of_receiver;
 
     // GPS Ephemeris data message port in
     this->message_port_register_in(pmt::mp("telemetry"));
+    init_telemetry_handlers();
     this->set_msg_handler(pmt::mp("telemetry"), boost::bind(&rtklib_pvt_cc::msg_handler_telemetry, this, _1));
 
     // initialize kml_printer
     std::string kml_dump_filename;
     kml_dump_filename = d_dump_filename;
+    d_position_outputs_suspended = false;
     d_kml_output_enabled = conf_.kml_output_enabled;
     if (d_kml_output_enabled)
         {
             d_kml_dump = std::make_shared<Kml_Printer>(conf_.kml_output_path);
+            d_kml_dump->set_flush_policy(conf_.output_flush_bytes, conf_.output_flush_interval_ms);
             d_kml_dump->set_headers(kml_dump_filename);
         }
     else
@@ -340,6 +455,7 @@ rtklib_pvt_cc::rtklib_pvt_cc(uint32_t nchannels,
     if (d_gpx_output_enabled)
         {
             d_gpx_dump = std::make_shared<Gpx_Printer>(conf_.gpx_output_path);
+            d_gpx_dump->set_flush_policy(conf_.output_flush_bytes, conf_.output_flush_interval_ms);
             d_gpx_dump->set_headers(gpx_dump_filename);
         }
     else
@@ -355,6 +471,7 @@ rtklib_pvt_cc::rtklib_pvt_cc(uint32_t nchannels,
     if (d_geojson_output_enabled)
         {
             d_geojson_printer = std::make_shared<GeoJSON_Printer>(conf_.geojson_output_path);
+            d_geojson_printer->set_flush_policy(conf_.output_flush_bytes, conf_.output_flush_interval_ms);
             d_geojson_printer->set_headers(geojson_dump_filename);
         }
     else
@@ -367,18 +484,28 @@ rtklib_pvt_cc::rtklib_pvt_cc(uint32_t nchannels,
     if (d_nmea_output_file_enabled)
         {
             d_nmea_printer = std::make_shared<Nmea_Printer>(conf_.nmea_dump_filename, conf_.nmea_output_file_enabled, conf_.flag_nmea_tty_port, conf_.nmea_dump_devname, conf_.nmea_output_file_path);
+            d_nmea_printer->set_latency_sentence(conf_.nmea_latency_sentence);
+            d_nmea_printer->set_flush_policy(conf_.output_flush_bytes, conf_.output_flush_interval_ms);
+            d_nmea_printer->set_serial_overflow_policy(conf_.nmea_tty_max_pending_bytes, conf_.nmea_tty_drop_oldest);
         }
     else
         {
             d_nmea_printer = nullptr;
         }
 
+    // the position outputs are printed by their own thread, from snapshots of the solution
+    if ((conf_.output_queue_size > 0) and (d_kml_output_enabled or d_gpx_output_enabled or d_geojson_output_enabled or d_nmea_output_file_enabled))
+        {
+            d_output_writer = std::unique_ptr<Pvt_Output_Writer>(new Pvt_Output_Writer([this](const Pvt_Output_Solution& solution) { print_position_outputs(solution); },
+                conf_.output_queue_size, conf_.output_drop_oldest));
+        }
+
     // initialize rtcm_printer
     std::string rtcm_dump_filename;
     rtcm_dump_filename = d_dump_filename;
     if (conf_.flag_rtcm_server or conf_.flag_rtcm_tty_port or conf_.rtcm_output_file_enabled)
         {
-            d_rtcm_printer = std::make_shared<Rtcm_Printer>(rtcm_dump_filename, conf_.rtcm_output_file_enabled, conf_.flag_rtcm_server, conf_.flag_rtcm_tty_port, conf_.rtcm_tcp_port, conf_.rtcm_station_id, conf_.rtcm_dump_devname, true, conf_.rtcm_output_file_path);
+            d_rtcm_printer = std::make_shared<Rtcm_Printer>(rtcm_dump_filename, conf_.rtcm_output_file_enabled, conf_.flag_rtcm_server, conf_.flag_rtcm_tty_port, conf_.rtcm_tcp_port, conf_.rtcm_station_id, conf_.rtcm_dump_devname, true, conf_.rtcm_output_file_path, conf_.rtcm_ntrip_mountpoint);
             std::map<int, int> rtcm_msg_rate_ms = conf_.rtcm_msg_rate_ms;
             if (rtcm_msg_rate_ms.find(1019) != rtcm_msg_rate_ms.end())
                 {
@@ -462,10 +589,18 @@ rtklib_pvt_cc::rtklib_pvt_cc(uint32_t nchannels,
         }
     d_rinexobs_rate_ms = conf_.rinexobs_rate_ms;
     d_rinexnav_rate_ms = conf_.rinexnav_rate_ms;
+    d_rinex_output_path = conf_.rinex_output_path;
+    d_rinex_rotation = conf_.rinex_rotation;
+    d_rinex_period = get_rinex_period();
+    if (b_rinex_output_enabled and (d_rinex_rotation != "none" or conf_.rinex_compress))
+        {
+            d_rinex_archiver = std::unique_ptr<Rinex_Archiver>(new Rinex_Archiver(conf_.rinex_compress));
+        }
 
     // XML printer
     d_xml_storage = conf_.xml_output_enabled;
-    if (d_xml_storage)
+    d_binary_storage = conf_.binary_output_enabled;
+    if (d_xml_storage or d_binary_storage)
         {
             xml_base_path = conf_.xml_output_path;
             boost::filesystem::path full_path(boost::filesystem::current_path());
@@ -502,6 +637,43 @@ rtklib_pvt_cc::rtklib_pvt_cc(uint32_t nchannels,
 
     d_pvt_solver = std::make_shared<rtklib_solver>(static_cast<int32_t>(nchannels), dump_ls_pvt_filename, d_dump, d_dump_mat, rtk);
     d_pvt_solver->set_averaging_depth(1);
+    publish_snapshot(d_gps_ephemeris_snapshot, d_pvt_solver->gps_ephemeris_map);
+    publish_snapshot(d_gps_almanac_snapshot, d_pvt_solver->gps_almanac_map);
+    publish_snapshot(d_galileo_ephemeris_snapshot, d_pvt_solver->galileo_ephemeris_map);
+    publish_snapshot(d_galileo_almanac_snapshot, d_pvt_solver->galileo_almanac_map);
+
+    d_monitor_pvt = Monitor_Pvt();
+    if (conf_.monitor_enabled)
+        {
+            d_udp_sink_ptr = std::unique_ptr<Pvt_Udp_Sink>(new Pvt_Udp_Sink(conf_.monitor_client_addresses, conf_.monitor_udp_port));
+        }
+    if (conf_.replay_log_enabled)
+        {
+            d_replay_log = std::unique_ptr<Pvt_Replay_Log_Writer>(new Pvt_Replay_Log_Writer(conf_.replay_log_filename, nchannels));
+        }
+    if (!conf_.rtcm_corrections_source.empty())
+        {
+            // before the precise solver thread takes over the RTK state
+            d_pvt_solver->enable_corrections_input(conf_.rtcm_corrections_source, conf_.rtcm_corrections_baud_rate);
+        }
+    if (conf_.precise_solver_queue_size > 0 and rtk.opt.mode != PMODE_SINGLE)
+        {
+            d_pvt_solver->enable_precise_solver_thread(conf_.precise_solver_queue_size);
+            std::string precise_filename = conf_.output_path + boost::filesystem::path::preferred_separator + "pvt_precise_solutions.txt";
+            d_precise_solutions_file.open(precise_filename, std::ios::out | std::ios::trunc);
+            if (d_precise_solutions_file.is_open())
+                {
+                    d_precise_solutions_file << "% GPS week, TOW [s], X [m], Y [m], Z [m], status, satellites, latency [ms]" << std::endl;
+                    d_precise_solutions_file << std::fixed;
+                    LOG(INFO) << "RTK/PPP solutions computed by their own thread, stored at " << precise_filename;
+                }
+            else
+                {
+                    LOG(WARNING) << "Cannot open " << precise_filename << ", the RTK/PPP solutions will not be stored";
+                }
+        }
+
+    d_end_to_end_latency = Gnss_Metrics::get_instance()->get_histogram("gnss_sdr_pvt_latency_seconds", "");
 
     d_rx_time = 0.0;
 
@@ -509,7 +681,7 @@ rtklib_pvt_cc::rtklib_pvt_cc(uint32_t nchannels,
 
     // Create Sys V message queue
     first_fix = true;
-    sysv_msg_key = 1101;
+    sysv_msg_key = conf_.ttff_msg_key;
     int msgflg = IPC_CREAT | 0666;
     if ((sysv_msqid = msgget(sysv_msg_key, msgflg)) == -1)
         {
@@ -522,6 +694,19 @@ rtklib_pvt_cc::rtklib_pvt_cc(uint32_t nchannels,
 
 rtklib_pvt_cc::~rtklib_pvt_cc()
 {
+    if (d_precise_solutions_file.is_open())
+        {
+            write_precise_solutions();
+            d_precise_solutions_file.close();
+        }
+    // print the queued solutions before the printers are destroyed
+    d_output_writer.reset();
+    if (d_rinex_archiver)
+        {
+            // close and compress the last RINEX files before returning
+            d_rinex_archiver->release(std::move(rp));
+            d_rinex_archiver.reset();
+        }
     msgctl(sysv_msqid, IPC_RMID, NULL);
     if (d_xml_storage)
         {
@@ -911,15 +1096,16 @@ bool rtklib_pvt_cc::get_latest_PVT(double* longitude_deg,
     double* course_over_ground_deg,
     time_t* UTC_time)
 {
-    gr::thread::scoped_lock lock(d_setlock);
-    if (d_pvt_solver->is_valid_position())
+    // read from the status snapshot, so that the caller never waits for work()
+    std::shared_ptr<const Pvt_Status> status = get_status();
+    if (status and status->valid_position)
         {
-            *latitude_deg = d_pvt_solver->get_latitude();
-            *longitude_deg = d_pvt_solver->get_longitude();
-            *height_m = d_pvt_solver->get_height();
-            *ground_speed_kmh = d_pvt_solver->get_speed_over_ground() * 3600.0 / 1000.0;
-            *course_over_ground_deg = d_pvt_solver->get_course_over_ground();
-            *UTC_time = to_time_t(d_pvt_solver->get_position_UTC_time());
+            *latitude_deg = status->latitude_deg;
+            *longitude_deg = status->longitude_deg;
+            *height_m = status->height_m;
+            *ground_speed_kmh = status->ground_speed_kmh;
+            *course_over_ground_deg = status->course_over_ground_deg;
+            *UTC_time = status->utc_time;
 
             return true;
         }
@@ -928,10 +1114,88 @@ bool rtklib_pvt_cc::get_latest_PVT(double* longitude_deg,
 }
 
 
+const Gnss_Synchro* const* rtklib_pvt_cc::epoch_observables(const gr_vector_const_void_star& input_items, int32_t epoch)
+{
+    for (uint32_t i = 0; i < d_nchannels; i++)
+        {
+            if (d_vector_observables)
+                {
+                    d_epoch_observables[i] = reinterpret_cast<const Gnss_Synchro*>(input_items[0]) + static_cast<size_t>(epoch) * d_nchannels + i;
+                }
+            else
+                {
+                    d_epoch_observables[i] = reinterpret_cast<const Gnss_Synchro*>(input_items[i]) + epoch;
+                }
+        }
+    return d_epoch_observables.data();
+}
+
+
+void rtklib_pvt_cc::publish_status(const Gnss_Synchro* const* in)
+{
+    std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+    if (now - d_last_status_time < std::chrono::milliseconds(STATUS_PERIOD_MS))
+        {
+            return;
+        }
+    d_last_status_time = now;
+    std::shared_ptr<Pvt_Status> status = std::make_shared<Pvt_Status>();
+    for (uint32_t i = 0; i < d_nchannels; i++)
+        {
+            const Gnss_Synchro& gnss_synchro = *in[i];
+            if (gnss_synchro.Flag_valid_pseudorange)
+                {
+                    Pvt_Channel_Status channel;
+                    channel.channel_id = gnss_synchro.Channel_ID;
+                    channel.system = gnss_synchro.System;
+                    channel.prn = gnss_synchro.PRN;
+                    channel.signal = std::string(gnss_synchro.Signal);
+                    channel.cn0_db_hz = gnss_synchro.CN0_dB_hz;
+                    channel.carrier_doppler_hz = gnss_synchro.Carrier_Doppler_hz;
+                    channel.used_in_pvt = std::binary_search(d_valid_channels.begin(), d_valid_channels.end(), i);
+                    status->rx_time_s = gnss_synchro.RX_time;
+                    status->channels.push_back(channel);
+                }
+        }
+    if (d_pvt_solver->is_valid_position())
+        {
+            status->valid_position = true;
+            status->latitude_deg = d_pvt_solver->get_latitude();
+            status->longitude_deg = d_pvt_solver->get_longitude();
+            status->height_m = d_pvt_solver->get_height();
+            status->ground_speed_kmh = d_pvt_solver->get_speed_over_ground() * 3600.0 / 1000.0;
+            status->course_over_ground_deg = d_pvt_solver->get_course_over_ground();
+            status->utc_time = to_time_t(d_pvt_solver->get_position_UTC_time());
+            status->valid_observations = d_pvt_solver->get_num_valid_observations();
+        }
+    std::atomic_store(&d_status_snapshot, std::shared_ptr<const Pvt_Status>(status));
+}
+
+
 int rtklib_pvt_cc::work(int noutput_items, gr_vector_const_void_star& input_items,
     gr_vector_void_star& output_items __attribute__((unused)))
 {
     gr::thread::scoped_lock l(d_setlock);
+    Gnss_Trace_Span span("pvt");
+    if (span.enabled())
+        {
+            // sample stamps of the first and last epochs, from any channel with a valid observation
+            uint64_t first_sample = 0;
+            uint64_t last_sample = 0;
+            const Gnss_Synchro* const* obs = epoch_observables(input_items, 0);
+            for (uint32_t i = 0; i < d_nchannels; i++)
+                {
+                    first_sample = std::max(first_sample, obs[i]->Tracking_sample_counter);
+                }
+            obs = epoch_observables(input_items, noutput_items - 1);
+            for (uint32_t i = 0; i < d_nchannels; i++)
+                {
+                    last_sample = std::max(last_sample, obs[i]->Tracking_sample_counter);
+                }
+            span.set_samples(first_sample, last_sample);
+        }
+    d_arrival_tags.clear();
+    get_tags_in_range(d_arrival_tags, 0, nitems_read(0), nitems_read(0) + noutput_items, pmt::mp("arrival_time"));
 
     for (int32_t epoch = 0; epoch < noutput_items; epoch++)
         {
@@ -945,26 +1209,33 @@ int rtklib_pvt_cc::work(int noutput_items, gr_vector_const_void_star& input_item
             bool flag_write_RINEX_nav_output = false;
 
             gnss_observables_map.clear();
-            const Gnss_Synchro** in = reinterpret_cast<const Gnss_Synchro**>(&input_items[0]);  // Get the input buffer pointer
+            d_valid_channels.clear();
+            const Gnss_Synchro* const* in = epoch_observables(input_items, epoch);  // observables of this epoch, by channel
             // ############ 1. READ PSEUDORANGES ####
             for (uint32_t i = 0; i < d_nchannels; i++)
                 {
-                    if (in[i][epoch].Flag_valid_pseudorange)
+                    if (in[i]->Flag_valid_pseudorange)
                         {
-                            std::map<int, Gps_Ephemeris>::const_iterator tmp_eph_iter_gps = d_pvt_solver->gps_ephemeris_map.find(in[i][epoch].PRN);
-                            std::map<int, Galileo_Ephemeris>::const_iterator tmp_eph_iter_gal = d_pvt_solver->galileo_ephemeris_map.find(in[i][epoch].PRN);
-                            std::map<int, Gps_CNAV_Ephemeris>::const_iterator tmp_eph_iter_cnav = d_pvt_solver->gps_cnav_ephemeris_map.find(in[i][epoch].PRN);
-                            std::map<int, Glonass_Gnav_Ephemeris>::const_iterator tmp_eph_iter_glo_gnav = d_pvt_solver->glonass_gnav_ephemeris_map.find(in[i][epoch].PRN);
-                            if (((tmp_eph_iter_gps->second.i_satellite_PRN == in[i][epoch].PRN) and (std::string(in[i][epoch].Signal) == "1C")) or
-                                ((tmp_eph_iter_cnav->second.i_satellite_PRN == in[i][epoch].PRN) and (std::string(in[i][epoch].Signal) == "2S")) or
-                                ((tmp_eph_iter_gal->second.i_satellite_PRN == in[i][epoch].PRN) and (std::string(in[i][epoch].Signal) == "1B")) or
-                                ((tmp_eph_iter_gal->second.i_satellite_PRN == in[i][epoch].PRN) and (std::string(in[i][epoch].Signal) == "5X")) or
-                                ((tmp_eph_iter_glo_gnav->second.i_satellite_PRN == in[i][epoch].PRN) and (std::string(in[i][epoch].Signal) == "1G")) or
-                                ((tmp_eph_iter_glo_gnav->second.i_satellite_PRN == in[i][epoch].PRN) and (std::string(in[i][epoch].Signal) == "2G")) or
-                                ((tmp_eph_iter_cnav->second.i_satellite_PRN == in[i][epoch].PRN) and (std::string(in[i][epoch].Signal) == "L5")))
+                            std::map<int, Gps_Ephemeris>::const_iterator tmp_eph_iter_gps = d_pvt_solver->gps_ephemeris_map.find(in[i]->PRN);
+                            std::map<int, Galileo_Ephemeris>::const_iterator tmp_eph_iter_gal = d_pvt_solver->galileo_ephemeris_map.find(in[i]->PRN);
+                            std::map<int, Gps_CNAV_Ephemeris>::const_iterator tmp_eph_iter_cnav = d_pvt_solver->gps_cnav_ephemeris_map.find(in[i]->PRN);
+                            std::map<int, Glonass_Gnav_Ephemeris>::const_iterator tmp_eph_iter_glo_gnav = d_pvt_solver->glonass_gnav_ephemeris_map.find(in[i]->PRN);
+                            const bool gps_eph_found = tmp_eph_iter_gps != d_pvt_solver->gps_ephemeris_map.cend();
+                            const bool gal_eph_found = tmp_eph_iter_gal != d_pvt_solver->galileo_ephemeris_map.cend();
+                            const bool cnav_eph_found = tmp_eph_iter_cnav != d_pvt_solver->gps_cnav_ephemeris_map.cend();
+                            const bool glo_gnav_eph_found = tmp_eph_iter_glo_gnav != d_pvt_solver->glonass_gnav_ephemeris_map.cend();
+                            const std::string signal(in[i]->Signal);
+                            if ((gps_eph_found and (signal == "1C")) or
+                                (cnav_eph_found and (signal == "2S")) or
+                                (gal_eph_found and (signal == "1B")) or
+                                (gal_eph_found and (signal == "5X")) or
+                                (glo_gnav_eph_found and (signal == "1G")) or
+                                (glo_gnav_eph_found and (signal == "2G")) or
+                                (cnav_eph_found and (signal == "L5")))
                                 {
-                                    // store valid observables in a map.
-                                    gnss_observables_map.insert(std::pair<int, Gnss_Synchro>(i, in[i][epoch]));
+                                    // store valid observables in the channel array
+                                    d_gnss_observables[i] = *in[i];
+                                    d_valid_channels.push_back(i);
                                 }
                             if (b_rtcm_enabled)
                                 {
@@ -974,28 +1245,28 @@ int rtklib_pvt_cc::work(int noutput_items, gr_vector_const_void_star& input_item
                                                 {
                                                     if (tmp_eph_iter_gps != d_pvt_solver->gps_ephemeris_map.cend())
                                                         {
-                                                            d_rtcm_printer->lock_time(d_pvt_solver->gps_ephemeris_map.find(in[i][epoch].PRN)->second, in[i][epoch].RX_time, in[i][epoch]);  // keep track of locking time
+                                                            d_rtcm_printer->lock_time(d_pvt_solver->gps_ephemeris_map.find(in[i]->PRN)->second, in[i]->RX_time, *in[i]);  // keep track of locking time
                                                         }
                                                 }
                                             if (d_pvt_solver->galileo_ephemeris_map.empty() == false)
                                                 {
                                                     if (tmp_eph_iter_gal != d_pvt_solver->galileo_ephemeris_map.cend())
                                                         {
-                                                            d_rtcm_printer->lock_time(d_pvt_solver->galileo_ephemeris_map.find(in[i][epoch].PRN)->second, in[i][epoch].RX_time, in[i][epoch]);  // keep track of locking time
+                                                            d_rtcm_printer->lock_time(d_pvt_solver->galileo_ephemeris_map.find(in[i]->PRN)->second, in[i]->RX_time, *in[i]);  // keep track of locking time
                                                         }
                                                 }
                                             if (d_pvt_solver->gps_cnav_ephemeris_map.empty() == false)
                                                 {
                                                     if (tmp_eph_iter_cnav != d_pvt_solver->gps_cnav_ephemeris_map.cend())
                                                         {
-                                                            d_rtcm_printer->lock_time(d_pvt_solver->gps_cnav_ephemeris_map.find(in[i][epoch].PRN)->second, in[i][epoch].RX_time, in[i][epoch]);  // keep track of locking time
+                                                            d_rtcm_printer->lock_time(d_pvt_solver->gps_cnav_ephemeris_map.find(in[i]->PRN)->second, in[i]->RX_time, *in[i]);  // keep track of locking time
                                                         }
                                                 }
                                             if (d_pvt_solver->glonass_gnav_ephemeris_map.empty() == false)
                                                 {
                                                     if (tmp_eph_iter_glo_gnav != d_pvt_solver->glonass_gnav_ephemeris_map.cend())
                                                         {
-                                                            d_rtcm_printer->lock_time(d_pvt_solver->glonass_gnav_ephemeris_map.find(in[i][epoch].PRN)->second, in[i][epoch].RX_time, in[i][epoch]);  // keep track of locking time
+                                                            d_rtcm_printer->lock_time(d_pvt_solver->glonass_gnav_ephemeris_map.find(in[i]->PRN)->second, in[i]->RX_time, *in[i]);  // keep track of locking time
                                                         }
                                                 }
                                         }
@@ -1014,9 +1285,13 @@ int rtklib_pvt_cc::work(int noutput_items, gr_vector_const_void_star& input_item
                 }
 
             // ############ 2 COMPUTE THE PVT ################################
-            if (gnss_observables_map.empty() == false)
+            if (d_valid_channels.empty() == false)
                 {
-                    double current_RX_time = gnss_observables_map.begin()->second.RX_time;
+                    if (d_replay_log)
+                        {
+                            d_replay_log->write_epoch(d_gnss_observables, d_valid_channels);
+                        }
+                    double current_RX_time = d_gnss_observables[d_valid_channels.front()].RX_time;
                     auto current_RX_time_ms = static_cast<uint32_t>(current_RX_time * 1000.0);
                     if (current_RX_time_ms % d_output_rate_ms == 0)
                         {
@@ -1038,8 +1313,29 @@ int rtklib_pvt_cc::work(int noutput_items, gr_vector_const_void_star& input_item
                             //        it->second.Pseudorange_m = it->second.Pseudorange_m - d_pvt_solver->get_time_offset_s() * GPS_C_m_s;
                             //    }
 
-                            if (d_pvt_solver->get_PVT(gnss_observables_map, false))
+                            if (d_precise_solutions_file.is_open())
                                 {
+                                    write_precise_solutions();
+                                }
+                            std::chrono::time_point<std::chrono::steady_clock> solver_start = std::chrono::steady_clock::now();
+                            if (d_pvt_solver->get_PVT(d_gnss_observables, d_valid_channels, false))
+                                {
+                                    double latency_s = end_to_end_latency_s(nitems_read(0) + epoch);
+                                    d_pvt_solver->set_latency_s(latency_s);
+                                    if (latency_s > 0.0)
+                                        {
+                                            d_end_to_end_latency->record(std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<double>(latency_s)));
+                                        }
+                                    if (d_udp_sink_ptr)
+                                        {
+                                            std::chrono::duration<double> solver_latency = std::chrono::steady_clock::now() - solver_start;
+                                            publish_monitor_pvt(solver_latency.count());
+                                        }
+                                    // the map of observables is only needed by the RINEX, RTCM and KML outputs of this epoch
+                                    for (uint32_t ch : d_valid_channels)
+                                        {
+                                            gnss_observables_map.insert(std::pair<int, Gnss_Synchro>(ch, d_gnss_observables[ch]));
+                                        }
                                     //Optional debug code: export observables snapshot for rtklib unit testing
                                     //std::cout << "step 1: save gnss_synchro map" << std::endl;
                                     //save_gnss_synchro_map_xml("./gnss_synchro_map.xml");
@@ -1121,10 +1417,18 @@ int rtklib_pvt_cc::work(int noutput_items, gr_vector_const_void_star& input_item
                                             send_sys_v_ttff_msg(ttff);
                                             first_fix = false;
                                         }
-                                    if (d_kml_output_enabled) d_kml_dump->print_position(d_pvt_solver, false);
-                                    if (d_gpx_output_enabled) d_gpx_dump->print_position(d_pvt_solver, false);
-                                    if (d_geojson_output_enabled) d_geojson_printer->print_position(d_pvt_solver, false);
-                                    if (d_nmea_output_file_enabled) d_nmea_printer->Print_Nmea_Line(d_pvt_solver, false);
+                                    if (d_position_outputs_suspended.load(std::memory_order_relaxed))
+                                        {
+                                            DLOG(INFO) << "Position outputs suspended";
+                                        }
+                                    else if (d_output_writer)
+                                        {
+                                            d_output_writer->push(d_pvt_solver->get_output_solution());
+                                        }
+                                    else
+                                        {
+                                            print_position_outputs(d_pvt_solver->get_output_solution());
+                                        }
 
                                     /*
                                      *   TYPE  |  RECEIVER
@@ -1163,6 +1467,7 @@ int rtklib_pvt_cc::work(int noutput_items, gr_vector_const_void_star& input_item
                                      *    32   |  GPS L1 C/A + Galileo E1B + GPS L5 + Galileo E5a
                                      */
 
+                                    Gnss_Profile_Scope profile("rinex_rtcm_printers");
                                     // ####################### RINEX FILES #################
                                     if (b_rinex_output_enabled)
                                         {
@@ -1170,6 +1475,10 @@ int rtklib_pvt_cc::work(int noutput_items, gr_vector_const_void_star& input_item
                                             std::map<int, Gps_Ephemeris>::const_iterator gps_ephemeris_iter;
                                             std::map<int, Gps_CNAV_Ephemeris>::const_iterator gps_cnav_ephemeris_iter;
                                             std::map<int, Glonass_Gnav_Ephemeris>::const_iterator glonass_gnav_ephemeris_iter;
+                                            if (b_rinex_header_written and d_rinex_rotation != "none" and get_rinex_period() != d_rinex_period)
+                                                {
+                                                    rotate_rinex_files();
+                                                }
                                             if (!b_rinex_header_written)  //  & we have utc data in nav message!
                                                 {
                                                     galileo_ephemeris_iter = d_pvt_solver->galileo_ephemeris_map.cbegin();
@@ -2917,6 +3226,7 @@ int rtklib_pvt_cc::work(int noutput_items, gr_vector_const_void_star& input_item
                                          << " GDOP = " << d_pvt_solver->get_gdop() << std::endl; */
                         }
                 }
+            publish_status(in);
         }
 
     return noutput_items;
@@ -5,7 +5,7 @@
  *
  * -------------------------------------------------------------------------
  *
- * Copyright (C) 2010-2018  (see AUTHORS file for a list of contributors)
+ * Copyright (C) 2010-2019  (see AUTHORS file for a list of contributors)
  *
  * GNSS-SDR is a software defined Global Navigation
  *          Satellite Systems receiver
@@ -32,25 +32,40 @@
 #define GNSS_SDR_RTKLIB_PVT_CC_H
 
 #include "geojson_printer.h"
+#include "gnss_metrics.h"
+#include "gnss_sdr_binary_store.h"
 #include "gps_ephemeris.h"
 #include "gpx_printer.h"
 #include "kml_printer.h"
 #include "nmea_printer.h"
+#include "pvt_output_writer.h"
+#include "pvt_replay_log.h"
+#include "pvt_udp_sink.h"
 #include "pvt_conf.h"
+#include "pvt_status.h"
+#include "rinex_archiver.h"
 #include "rinex_printer.h"
 #include "rtcm_printer.h"
 #include "rtklib_solver.h"
+#include <boost/any.hpp>
 #include <boost/date_time/gregorian/gregorian.hpp>
 #include <boost/date_time/posix_time/posix_time.hpp>
 #include <gnuradio/sync_block.h>
+#include <atomic>
 #include <chrono>
 #include <cstdint>
 #include <fstream>
+#include <functional>
+#include <map>
+#include <memory>
 #include <string>
 #include <sys/ipc.h>
 #include <sys/msg.h>
 #include <sys/types.h>
+#include <typeindex>
+#include <unordered_map>
 #include <utility>
+#include <vector>
 
 
 class rtklib_pvt_cc;
@@ -73,6 +88,24 @@ private:
 
     void msg_handler_telemetry(pmt::pmt_t msg);
 
+    // dispatch table of the telemetry messages, indexed by the type of the shared_ptr they carry
+    std::unordered_map<std::type_index, std::function<void(const boost::any&)>> d_telemetry_handlers;
+    void init_telemetry_handlers();
+
+    template <typename T>
+    void add_telemetry_handler(const std::function<void(const std::shared_ptr<T>&)>& handler)
+    {
+        // the table lookup already checked the type: skip the checked cast
+        d_telemetry_handlers[std::type_index(typeid(std::shared_ptr<T>))] = [this, handler](const boost::any& telemetry) {
+            const std::shared_ptr<T>& data = *boost::unsafe_any_cast<std::shared_ptr<T>>(&telemetry);
+            if (d_replay_log)
+                {
+                    d_replay_log->write_navigation(*data);
+                }
+            handler(data);
+        };
+    }
+
     bool d_dump;
     bool d_dump_mat;
     bool b_rinex_output_enabled;
@@ -81,6 +114,12 @@ private:
     double d_rinex_version;
     int32_t d_rinexobs_rate_ms;
     int32_t d_rinexnav_rate_ms;
+    std::string d_rinex_output_path;
+    std::string d_rinex_rotation;
+    int64_t d_rinex_period;  // rotation period the current RINEX files belong to
+    int64_t get_rinex_period() const;
+    void rotate_rinex_files();
+    std::unique_ptr<Rinex_Archiver> d_rinex_archiver;  // null if the RINEX files are neither rotated nor compressed
 
     bool b_rtcm_writing_started;
     bool b_rtcm_enabled;
@@ -112,10 +151,54 @@ private:
     bool d_gpx_output_enabled;
     bool d_kml_output_enabled;
     bool d_nmea_output_file_enabled;
+    std::atomic<bool> d_position_outputs_suspended;
 
     std::shared_ptr<rtklib_solver> d_pvt_solver;
+    void print_position_outputs(const Pvt_Output_Solution& solution);
+    std::unique_ptr<Pvt_Output_Writer> d_output_writer;  // null if the position outputs are printed synchronously
+
+    // RTK/PPP solutions computed by the precise solver thread, if enabled
+    std::ofstream d_precise_solutions_file;
+    void write_precise_solutions();
+
+    // PVT monitor, null if disabled
+    std::unique_ptr<Pvt_Udp_Sink> d_udp_sink_ptr;
+    Monitor_Pvt d_monitor_pvt;
+    void publish_monitor_pvt(double latency_s);
+
+    // latency from the arrival of the samples ("arrival_time" tags of the observables) to the solution
+    std::shared_ptr<Gnss_Duration_Histogram> d_end_to_end_latency;
+    std::vector<gr::tag_t> d_arrival_tags;
+    double end_to_end_latency_s(uint64_t item) const;
+
+    // solver inputs logged for offline reprocessing, null if disabled
+    std::unique_ptr<Pvt_Replay_Log_Writer> d_replay_log;
+
+    // copies of the navigation data maps for the control thread, never modified once published
+    std::shared_ptr<const std::map<int, Gps_Ephemeris>> d_gps_ephemeris_snapshot;
+    std::shared_ptr<const std::map<int, Gps_Almanac>> d_gps_almanac_snapshot;
+    std::shared_ptr<const std::map<int, Galileo_Ephemeris>> d_galileo_ephemeris_snapshot;
+    std::shared_ptr<const std::map<int, Galileo_Almanac>> d_galileo_almanac_snapshot;
+    template <class T>
+    void publish_snapshot(std::shared_ptr<const std::map<int, T>>& snapshot, const std::map<int, T>& data)
+    {
+        std::shared_ptr<const std::map<int, T>> copy = std::make_shared<std::map<int, T>>(data);
+        std::atomic_store(&snapshot, copy);
+    }
+
+    // channels and position for the telecommand interface, replaced every STATUS_PERIOD_MS
+    std::shared_ptr<const Pvt_Status> d_status_snapshot;
+    std::chrono::steady_clock::time_point d_last_status_time;
+    void publish_status(const Gnss_Synchro* const* in);
+
+    // observables of each channel in the given input epoch, whether they come in one port per channel or in a single item
+    const Gnss_Synchro* const* epoch_observables(const gr_vector_const_void_star& input_items, int32_t epoch);
+    bool d_vector_observables;
+    std::vector<const Gnss_Synchro*> d_epoch_observables;
 
     std::map<int, Gnss_Synchro> gnss_observables_map;
+    std::vector<Gnss_Synchro> d_gnss_observables;  // observables of the current epoch, indexed by channel
+    std::vector<uint32_t> d_valid_channels;        // channels of d_gnss_observables used in the PVT, in ascending order
     bool observables_pairCompare_min(const std::pair<int, Gnss_Synchro>& a, const std::pair<int, Gnss_Synchro>& b);
 
     uint32_t type_of_rx;
@@ -138,6 +221,17 @@ private:
     bool d_xml_storage;
     std::string xml_base_path;
 
+    // binary stores for a fast warm start, rewritten whenever their contents change
+    bool d_binary_storage;
+    template <typename T>
+    void save_binary_store(const std::string& name, const std::string& tag, const T& data)
+    {
+        if (d_binary_storage)
+            {
+                gnss_sdr_save_binary_store(xml_base_path + name + ".bin", tag, data);
+            }
+    }
+
     inline std::time_t to_time_t(boost::posix_time::ptime pt)
     {
         return (pt - boost::posix_time::ptime(boost::gregorian::date(1970, 1, 1))).total_seconds();
@@ -150,16 +244,17 @@ public:
         const rtk_t& rtk);
 
     /*!
-     * \brief Get latest set of ephemeris from PVT block
-     *
+     * \brief Get latest set of ephemeris from PVT block.
+     * The snapshot is immutable: it can be read from any thread, and it is
+     * replaced (not modified) when new navigation data arrive.
      */
-    std::map<int, Gps_Ephemeris> get_gps_ephemeris_map() const;
+    std::shared_ptr<const std::map<int, Gps_Ephemeris>> get_gps_ephemeris_map() const;
 
-    std::map<int, Gps_Almanac> get_gps_almanac_map() const;
+    std::shared_ptr<const std::map<int, Gps_Almanac>> get_gps_almanac_map() const;
 
-    std::map<int, Galileo_Ephemeris> get_galileo_ephemeris_map() const;
+    std::shared_ptr<const std::map<int, Galileo_Ephemeris>> get_galileo_ephemeris_map() const;
 
-    std::map<int, Galileo_Almanac> get_galileo_almanac_map() const;
+    std::shared_ptr<const std::map<int, Galileo_Almanac>> get_galileo_almanac_map() const;
 
     /*!
      * \brief Clear all ephemeris information and the almanacs for GPS and Galileo
@@ -177,6 +272,17 @@ public:
         double* course_over_ground_deg,
         time_t* UTC_time);
 
+    /*!
+     * \brief Stops (or resumes) writing the KML, GPX, GeoJSON and NMEA outputs, e.g. to shed load
+     */
+    void suspend_position_outputs(bool suspend);
+
+    /*!
+     * \brief Gets the latest status of the channels and of the position.
+     * Like the navigation data maps, it can be read from any thread.
+     */
+    std::shared_ptr<const Pvt_Status> get_status() const;
+
     ~rtklib_pvt_cc();  //!< Default destructor
 
     int work(int noutput_items, gr_vector_const_void_star& input_items,
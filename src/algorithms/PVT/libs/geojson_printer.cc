@@ -77,6 +77,12 @@ GeoJSON_Printer::GeoJSON_Printer(const std::string& base_path)
 }
 
 
+void GeoJSON_Printer::set_flush_policy(std::size_t flush_bytes, int32_t flush_interval_ms)
+{
+    geojson_file.set_flush_policy(flush_bytes, flush_interval_ms);
+}
+
+
 GeoJSON_Printer::~GeoJSON_Printer()
 {
     GeoJSON_Printer::close_file();
@@ -140,7 +146,7 @@ bool GeoJSON_Printer::set_headers(const std::string& filename, bool time_tag_nam
             DLOG(INFO) << "GeoJSON printer writing on " << filename.c_str();
 
             // Set iostream numeric format and precision
-            geojson_file.setf(geojson_file.std::ofstream::fixed, geojson_file.std::ofstream::floatfield);
+            geojson_file.setf(std::ios::fixed, std::ios::floatfield);
             geojson_file << std::setprecision(14);
 
             // Writing the header
@@ -161,25 +167,23 @@ bool GeoJSON_Printer::set_headers(const std::string& filename, bool time_tag_nam
 }
 
 
-bool GeoJSON_Printer::print_position(const std::shared_ptr<Pvt_Solution>& position, bool print_average_values)
+bool GeoJSON_Printer::print_position(const Pvt_Output_Solution& position, bool print_average_values)
 {
     double latitude;
     double longitude;
     double height;
 
-    const std::shared_ptr<Pvt_Solution>& position_ = position;
-
     if (print_average_values == false)
         {
-            latitude = position_->get_latitude();
-            longitude = position_->get_longitude();
-            height = position_->get_height();
+            latitude = position.latitude_d;
+            longitude = position.longitude_d;
+            height = position.height_m;
         }
     else
         {
-            latitude = position_->get_avg_latitude();
-            longitude = position_->get_avg_longitude();
-            height = position_->get_avg_height();
+            latitude = position.avg_latitude_d;
+            longitude = position.avg_longitude_d;
+            height = position.avg_height_m;
         }
 
     if (geojson_file.is_open())
@@ -33,8 +33,10 @@
 #ifndef GNSS_SDR_GEOJSON_PRINTER_H_
 #define GNSS_SDR_GEOJSON_PRINTER_H_
 
-#include "pvt_solution.h"
-#include <fstream>
+#include "pvt_buffered_writer.h"
+#include "rtklib_solver.h"
+#include <cstddef>
+#include <cstdint>
 #include <memory>
 #include <string>
 
@@ -47,7 +49,7 @@
 class GeoJSON_Printer
 {
 private:
-    std::ofstream geojson_file;
+    Pvt_Buffered_File geojson_file;
     bool first_pos;
     std::string filename_;
     std::string geojson_base_path;
@@ -56,8 +58,13 @@ public:
     GeoJSON_Printer(const std::string& base_path = ".");
     ~GeoJSON_Printer();
     bool set_headers(const std::string& filename, bool time_tag_name = true);
-    bool print_position(const std::shared_ptr<Pvt_Solution>& position, bool print_average_values);
+    bool print_position(const Pvt_Output_Solution& position, bool print_average_values);
     bool close_file();
+
+    /*!
+     * \brief Sets the size of the output buffer and the minimum time between two writes to the file
+     */
+    void set_flush_policy(std::size_t flush_bytes, int32_t flush_interval_ms);
 };
 
 #endif
@@ -134,7 +134,7 @@ bool Gpx_Printer::set_headers(const std::string& filename, bool time_tag_name)
         {
             DLOG(INFO) << "GPX printer writing on " << filename.c_str();
             // Set iostream numeric format and precision
-            gpx_file.setf(gpx_file.std::ofstream::fixed, gpx_file.std::ofstream::floatfield);
+            gpx_file.setf(std::ios::fixed, std::ios::floatfield);
             gpx_file << std::setprecision(14);
             gpx_file << R"(<?xml version="1.0" encoding="UTF-8"?>)" << std::endl
                      << R"(<gpx version="1.1" creator="GNSS-SDR")" << std::endl
@@ -154,37 +154,36 @@ bool Gpx_Printer::set_headers(const std::string& filename, bool time_tag_name)
 }
 
 
-bool Gpx_Printer::print_position(const std::shared_ptr<rtklib_solver>& position, bool print_average_values)
+bool Gpx_Printer::print_position(const Pvt_Output_Solution& position, bool print_average_values)
 {
     double latitude;
     double longitude;
     double height;
 
     positions_printed = true;
-    const std::shared_ptr<rtklib_solver>& position_ = position;
 
-    double speed_over_ground = position_->get_speed_over_ground();    // expressed in m/s
-    double course_over_ground = position_->get_course_over_ground();  // expressed in deg
+    double speed_over_ground = position.speed_over_ground_m_s;  // expressed in m/s
+    double course_over_ground = position.course_over_ground_d;  // expressed in deg
 
-    double hdop = position_->get_hdop();
-    double vdop = position_->get_vdop();
-    double pdop = position_->get_pdop();
-    std::string utc_time = to_iso_extended_string(position_->get_position_UTC_time());
+    double hdop = position.dop[2];
+    double vdop = position.dop[3];
+    double pdop = position.dop[1];
+    std::string utc_time = to_iso_extended_string(position.position_UTC_time);
     if (utc_time.length() < 23) utc_time += ".";
     utc_time.resize(23, '0');  // time up to ms
     utc_time.append("Z");      // UTC time zone
 
     if (print_average_values == false)
         {
-            latitude = position_->get_latitude();
-            longitude = position_->get_longitude();
-            height = position_->get_height();
+            latitude = position.latitude_d;
+            longitude = position.longitude_d;
+            height = position.height_m;
         }
     else
         {
-            latitude = position_->get_avg_latitude();
-            longitude = position_->get_avg_longitude();
-            height = position_->get_avg_height();
+            latitude = position.avg_latitude_d;
+            longitude = position.avg_longitude_d;
+            height = position.avg_height_m;
         }
 
     if (gpx_file.is_open())
@@ -216,6 +215,12 @@ bool Gpx_Printer::close_file()
 }
 
 
+void Gpx_Printer::set_flush_policy(std::size_t flush_bytes, int32_t flush_interval_ms)
+{
+    gpx_file.set_flush_policy(flush_bytes, flush_interval_ms);
+}
+
+
 Gpx_Printer::~Gpx_Printer()
 {
     close_file();
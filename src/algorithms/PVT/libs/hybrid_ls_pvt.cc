@@ -48,6 +48,10 @@ hybrid_ls_pvt::hybrid_ls_pvt(int nchannels, std::string dump_filename, bool flag
     d_flag_dump_enabled = flag_dump_to_file;
     d_galileo_current_time = 0;
     count_valid_position = 0;
+    d_W.set_size(d_nchannels);
+    d_obs.set_size(d_nchannels);
+    d_satpos.set_size(3, d_nchannels);
+    this->reserve_workspace(d_nchannels);
     this->set_averaging_flag(false);
     // ############# ENABLE DATA FILE LOG #################
     if (d_flag_dump_enabled == true)
@@ -85,17 +89,26 @@ hybrid_ls_pvt::~hybrid_ls_pvt()
 }
 
 
-bool hybrid_ls_pvt::get_PVT(std::map<int, Gnss_Synchro> gnss_observables_map, double hybrid_current_time, bool flag_averaging)
+void hybrid_ls_pvt::add_observation(int valid_obs)
 {
-    std::map<int, Gnss_Synchro>::iterator gnss_observables_iter;
+    // More observations than channels: grow the buffers (only happens once)
+    if (valid_obs >= static_cast<int>(d_obs.n_elem))
+        {
+            d_W.resize(valid_obs + 1);
+            d_obs.resize(valid_obs + 1);
+            d_satpos.resize(3, valid_obs + 1);
+            this->reserve_workspace(valid_obs + 1);
+        }
+}
+
+
+bool hybrid_ls_pvt::get_PVT(const std::map<int, Gnss_Synchro>& gnss_observables_map, double hybrid_current_time, bool flag_averaging)
+{
+    std::map<int, Gnss_Synchro>::const_iterator gnss_observables_iter;
     std::map<int, Galileo_Ephemeris>::iterator galileo_ephemeris_iter;
     std::map<int, Gps_Ephemeris>::iterator gps_ephemeris_iter;
     std::map<int, Gps_CNAV_Ephemeris>::iterator gps_cnav_ephemeris_iter;
 
-    arma::vec W;       // channels weight vector
-    arma::vec obs;     // pseudoranges observation vector
-    arma::mat satpos;  // satellite positions matrix
-
     int Galileo_week_number = 0;
     int GPS_week = 0;
     double utc = 0.0;
@@ -128,8 +141,8 @@ bool hybrid_ls_pvt::get_PVT(std::map<int, Gnss_Synchro> gnss_observables_map, do
                                 /*!
                              * \todo Place here the satellite CN0 (power level, or weight factor)
                              */
-                                W.resize(valid_obs + 1, 1);
-                                W(valid_obs) = 1;
+                                add_observation(valid_obs);
+                                d_W(valid_obs) = 1;
 
                                 // COMMON RX TIME PVT ALGORITHM
                                 double Rx_time = hybrid_current_time;
@@ -143,14 +156,12 @@ bool hybrid_ls_pvt::get_PVT(std::map<int, Gnss_Synchro> gnss_observables_map, do
                                 galileo_ephemeris_iter->second.satellitePosition(TX_time_corrected_s);
 
                                 //store satellite positions in a matrix
-                                satpos.resize(3, valid_obs + 1);
-                                satpos(0, valid_obs) = galileo_ephemeris_iter->second.d_satpos_X;
-                                satpos(1, valid_obs) = galileo_ephemeris_iter->second.d_satpos_Y;
-                                satpos(2, valid_obs) = galileo_ephemeris_iter->second.d_satpos_Z;
+                                d_satpos(0, valid_obs) = galileo_ephemeris_iter->second.d_satpos_X;
+                                d_satpos(1, valid_obs) = galileo_ephemeris_iter->second.d_satpos_Y;
+                                d_satpos(2, valid_obs) = galileo_ephemeris_iter->second.d_satpos_Z;
 
                                 // 4- fill the observations vector with the corrected observables
-                                obs.resize(valid_obs + 1, 1);
-                                obs(valid_obs) = gnss_observables_iter->second.Pseudorange_m + SV_clock_bias_s * GALILEO_C_m_s - this->get_time_offset_s() * GALILEO_C_m_s;
+                                d_obs(valid_obs) = gnss_observables_iter->second.Pseudorange_m + SV_clock_bias_s * GALILEO_C_m_s - this->get_time_offset_s() * GALILEO_C_m_s;
 
                                 Galileo_week_number = galileo_ephemeris_iter->second.WN_5;  //for GST
                                 GST = galileo_ephemeris_iter->second.Galileo_System_Time(Galileo_week_number, hybrid_current_time);
@@ -160,7 +171,7 @@ bool hybrid_ls_pvt::get_PVT(std::map<int, Gnss_Synchro> gnss_observables_map, do
                                            << " X=" << galileo_ephemeris_iter->second.d_satpos_X
                                            << " [m] Y=" << galileo_ephemeris_iter->second.d_satpos_Y
                                            << " [m] Z=" << galileo_ephemeris_iter->second.d_satpos_Z
-                                           << " [m] PR_obs=" << obs(valid_obs) << " [m]";
+                                           << " [m] PR_obs=" << d_obs(valid_obs) << " [m]";
 
                                 valid_obs++;
                             }
@@ -182,8 +193,8 @@ bool hybrid_ls_pvt::get_PVT(std::map<int, Gnss_Synchro> gnss_observables_map, do
                                         /*!
                                      * \todo Place here the satellite CN0 (power level, or weight factor)
                                      */
-                                        W.resize(valid_obs + 1, 1);
-                                        W(valid_obs) = 1;
+                                        add_observation(valid_obs);
+                                        d_W(valid_obs) = 1;
 
                                         // COMMON RX TIME PVT ALGORITHM MODIFICATION (Like RINEX files)
                                         // first estimate of transmit time
@@ -198,10 +209,9 @@ bool hybrid_ls_pvt::get_PVT(std::map<int, Gnss_Synchro> gnss_observables_map, do
                                         double dtr = gps_ephemeris_iter->second.satellitePosition(TX_time_corrected_s);
 
                                         //store satellite positions in a matrix
-                                        satpos.resize(3, valid_obs + 1);
-                                        satpos(0, valid_obs) = gps_ephemeris_iter->second.d_satpos_X;
-                                        satpos(1, valid_obs) = gps_ephemeris_iter->second.d_satpos_Y;
-                                        satpos(2, valid_obs) = gps_ephemeris_iter->second.d_satpos_Z;
+                                        d_satpos(0, valid_obs) = gps_ephemeris_iter->second.d_satpos_X;
+                                        d_satpos(1, valid_obs) = gps_ephemeris_iter->second.d_satpos_Y;
+                                        d_satpos(2, valid_obs) = gps_ephemeris_iter->second.d_satpos_Z;
 
                                         // 4- fill the observations vector with the corrected pseudoranges
                                         // compute code bias: TGD for single frequency
@@ -210,15 +220,14 @@ bool hybrid_ls_pvt::get_PVT(std::map<int, Gnss_Synchro> gnss_observables_map, do
                                         double Gamma = sqrt_Gamma * sqrt_Gamma;
                                         double P1_P2 = (1.0 - Gamma) * (gps_ephemeris_iter->second.d_TGD * GPS_C_m_s);
                                         double Code_bias_m = P1_P2 / (1.0 - Gamma);
-                                        obs.resize(valid_obs + 1, 1);
-                                        obs(valid_obs) = gnss_observables_iter->second.Pseudorange_m + dtr * GPS_C_m_s - Code_bias_m - this->get_time_offset_s() * GPS_C_m_s;
+                                        d_obs(valid_obs) = gnss_observables_iter->second.Pseudorange_m + dtr * GPS_C_m_s - Code_bias_m - this->get_time_offset_s() * GPS_C_m_s;
 
                                         // SV ECEF DEBUG OUTPUT
                                         LOG(INFO) << "(new)ECEF GPS L1 CA satellite SV ID=" << gps_ephemeris_iter->second.i_satellite_PRN
                                                   << " TX Time corrected=" << TX_time_corrected_s << " X=" << gps_ephemeris_iter->second.d_satpos_X
                                                   << " [m] Y=" << gps_ephemeris_iter->second.d_satpos_Y
                                                   << " [m] Z=" << gps_ephemeris_iter->second.d_satpos_Z
-                                                  << " [m] PR_obs=" << obs(valid_obs) << " [m]";
+                                                  << " [m] PR_obs=" << d_obs(valid_obs) << " [m]";
 
                                         valid_obs++;
                                         // compute the UTC time for this SV (just to print the associated UTC timestamp)
@@ -237,8 +246,8 @@ bool hybrid_ls_pvt::get_PVT(std::map<int, Gnss_Synchro> gnss_observables_map, do
                                         /*!
                                      * \todo Place here the satellite CN0 (power level, or weight factor)
                                      */
-                                        W.resize(valid_obs + 1, 1);
-                                        W(valid_obs) = 1;
+                                        add_observation(valid_obs);
+                                        d_W(valid_obs) = 1;
 
                                         // COMMON RX TIME PVT ALGORITHM MODIFICATION (Like RINEX files)
                                         // first estimate of transmit time
@@ -254,14 +263,12 @@ bool hybrid_ls_pvt::get_PVT(std::map<int, Gnss_Synchro> gnss_observables_map, do
                                         double dtr = gps_cnav_ephemeris_iter->second.satellitePosition(TX_time_corrected_s);
 
                                         //store satellite positions in a matrix
-                                        satpos.resize(3, valid_obs + 1);
-                                        satpos(0, valid_obs) = gps_cnav_ephemeris_iter->second.d_satpos_X;
-                                        satpos(1, valid_obs) = gps_cnav_ephemeris_iter->second.d_satpos_Y;
-                                        satpos(2, valid_obs) = gps_cnav_ephemeris_iter->second.d_satpos_Z;
+                                        d_satpos(0, valid_obs) = gps_cnav_ephemeris_iter->second.d_satpos_X;
+                                        d_satpos(1, valid_obs) = gps_cnav_ephemeris_iter->second.d_satpos_Y;
+                                        d_satpos(2, valid_obs) = gps_cnav_ephemeris_iter->second.d_satpos_Z;
 
                                         // 4- fill the observations vector with the corrected observables
-                                        obs.resize(valid_obs + 1, 1);
-                                        obs(valid_obs) = gnss_observables_iter->second.Pseudorange_m + dtr * GPS_C_m_s + SV_clock_bias_s * GPS_C_m_s;
+                                        d_obs(valid_obs) = gnss_observables_iter->second.Pseudorange_m + dtr * GPS_C_m_s + SV_clock_bias_s * GPS_C_m_s;
 
                                         GPS_week = gps_cnav_ephemeris_iter->second.i_GPS_week;
                                         GPS_week = GPS_week % 1024;  //Necessary due to the increase of WN bits in CNAV message (10 in GPS NAV and 13 in CNAV)
@@ -272,7 +279,7 @@ bool hybrid_ls_pvt::get_PVT(std::map<int, Gnss_Synchro> gnss_observables_map, do
                                                   << " X=" << gps_cnav_ephemeris_iter->second.d_satpos_X
                                                   << " [m] Y=" << gps_cnav_ephemeris_iter->second.d_satpos_Y
                                                   << " [m] Z=" << gps_cnav_ephemeris_iter->second.d_satpos_Z
-                                                  << " [m] PR_obs=" << obs(valid_obs) << " [m]";
+                                                  << " [m] PR_obs=" << d_obs(valid_obs) << " [m]";
 
                                         valid_obs++;
                                     }
@@ -298,6 +305,10 @@ bool hybrid_ls_pvt::get_PVT(std::map<int, Gnss_Synchro> gnss_observables_map, do
 
     if (valid_obs >= 4)
         {
+            // Views of the first valid_obs observations, without copying them
+            arma::mat satpos(d_satpos.memptr(), 3, valid_obs, false, true);
+            arma::vec obs(d_obs.memptr(), valid_obs, false, true);
+            arma::vec W(d_W.memptr(), valid_obs, false, true);
             arma::vec rx_position_and_time;
             DLOG(INFO) << "satpos=" << satpos;
             DLOG(INFO) << "obs=" << obs;
@@ -55,12 +55,16 @@ private:
     std::ofstream d_dump_file;
     int d_nchannels;  // Number of available channels for positioning
     double d_galileo_current_time;
+    arma::vec d_W;       // channels weight vector, sized for d_nchannels
+    arma::vec d_obs;     // pseudoranges observation vector, sized for d_nchannels
+    arma::mat d_satpos;  // satellite positions matrix, sized for d_nchannels
+    void add_observation(int valid_obs);  // makes room for observation number valid_obs
 
 public:
     hybrid_ls_pvt(int nchannels, std::string dump_filename, bool flag_dump_to_file);
     ~hybrid_ls_pvt();
 
-    bool get_PVT(std::map<int, Gnss_Synchro> gnss_observables_map, double Rx_time, bool flag_averaging);
+    bool get_PVT(const std::map<int, Gnss_Synchro>& gnss_observables_map, double Rx_time, bool flag_averaging);
 
     std::map<int, Galileo_Ephemeris> galileo_ephemeris_map;  //!< Map storing new Galileo_Ephemeris
     std::map<int, Gps_Ephemeris> gps_ephemeris_map;          //!< Map storing new GPS_Ephemeris
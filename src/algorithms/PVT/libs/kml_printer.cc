@@ -36,6 +36,7 @@
 #include <boost/filesystem/path.hpp>         // for path, operator<<
 #include <boost/filesystem/path_traits.hpp>  // for filesystem
 #include <glog/logging.h>
+#include <fstream>
 #include <sstream>
 
 using google::LogMessage;
@@ -143,10 +144,10 @@ bool Kml_Printer::set_headers(const std::string& filename, bool time_tag_name)
         {
             DLOG(INFO) << "KML printer writing on " << filename.c_str();
             // Set iostream numeric format and precision
-            kml_file.setf(kml_file.std::ofstream::fixed, kml_file.std::ofstream::floatfield);
+            kml_file.setf(std::ios::fixed, std::ios::floatfield);
             kml_file << std::setprecision(14);
 
-            tmp_file.setf(tmp_file.std::ofstream::fixed, tmp_file.std::ofstream::floatfield);
+            tmp_file.setf(std::ios::fixed, std::ios::floatfield);
             tmp_file << std::setprecision(14);
 
             kml_file << R"(<?xml version="1.0" encoding="UTF-8"?>)" << std::endl
@@ -211,7 +212,7 @@ bool Kml_Printer::set_headers(const std::string& filename, bool time_tag_name)
 }
 
 
-bool Kml_Printer::print_position(const std::shared_ptr<rtklib_solver>& position, bool print_average_values)
+bool Kml_Printer::print_position(const Pvt_Output_Solution& position, bool print_average_values)
 {
     double latitude;
     double longitude;
@@ -219,30 +220,28 @@ bool Kml_Printer::print_position(const std::shared_ptr<rtklib_solver>& position,
 
     positions_printed = true;
 
-    const std::shared_ptr<rtklib_solver>& position_ = position;
+    double speed_over_ground = position.speed_over_ground_m_s;  // expressed in m/s
+    double course_over_ground = position.course_over_ground_d;  // expressed in deg
 
-    double speed_over_ground = position_->get_speed_over_ground();    // expressed in m/s
-    double course_over_ground = position_->get_course_over_ground();  // expressed in deg
-
-    double hdop = position_->get_hdop();
-    double vdop = position_->get_vdop();
-    double pdop = position_->get_pdop();
-    std::string utc_time = to_iso_extended_string(position_->get_position_UTC_time());
+    double hdop = position.dop[2];
+    double vdop = position.dop[3];
+    double pdop = position.dop[1];
+    std::string utc_time = to_iso_extended_string(position.position_UTC_time);
     if (utc_time.length() < 23) utc_time += ".";
     utc_time.resize(23, '0');  // time up to ms
     utc_time.append("Z");      // UTC time zone
 
     if (print_average_values == false)
         {
-            latitude = position_->get_latitude();
-            longitude = position_->get_longitude();
-            height = position_->get_height();
+            latitude = position.latitude_d;
+            longitude = position.longitude_d;
+            height = position.height_m;
         }
     else
         {
-            latitude = position_->get_avg_latitude();
-            longitude = position_->get_avg_longitude();
-            height = position_->get_avg_height();
+            latitude = position.avg_latitude_d;
+            longitude = position.avg_longitude_d;
+            height = position.avg_height_m;
         }
 
     if (kml_file.is_open() && tmp_file.is_open())
@@ -317,6 +316,13 @@ bool Kml_Printer::close_file()
 }
 
 
+void Kml_Printer::set_flush_policy(std::size_t flush_bytes, int32_t flush_interval_ms)
+{
+    kml_file.set_flush_policy(flush_bytes, flush_interval_ms);
+    tmp_file.set_flush_policy(flush_bytes, flush_interval_ms);
+}
+
+
 Kml_Printer::~Kml_Printer()
 {
     close_file();
@@ -33,9 +33,11 @@
 #ifndef GNSS_SDR_KML_PRINTER_H_
 #define GNSS_SDR_KML_PRINTER_H_
 
+#include "pvt_buffered_writer.h"
 #include "pvt_solution.h"
 #include "rtklib_solver.h"
-#include <fstream>
+#include <cstddef>
+#include <cstdint>
 #include <memory>
 #include <string>
 
@@ -48,8 +50,8 @@
 class Kml_Printer
 {
 private:
-    std::ofstream kml_file;
-    std::ofstream tmp_file;
+    Pvt_Buffered_File kml_file;
+    Pvt_Buffered_File tmp_file;
     bool positions_printed;
     std::string kml_filename;
     std::string kml_base_path;
@@ -61,8 +63,13 @@ public:
     Kml_Printer(const std::string& base_path = std::string("."));
     ~Kml_Printer();
     bool set_headers(const std::string& filename, bool time_tag_name = true);
-    bool print_position(const std::shared_ptr<rtklib_solver>& position, bool print_average_values);
+    bool print_position(const Pvt_Output_Solution& position, bool print_average_values);
     bool close_file();
+
+    /*!
+     * \brief Sets the size of the output buffer and the minimum time between two writes to the file
+     */
+    void set_flush_policy(std::size_t flush_bytes, int32_t flush_interval_ms);
 };
 
 #endif
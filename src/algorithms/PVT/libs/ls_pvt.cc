@@ -45,6 +45,16 @@ Ls_Pvt::Ls_Pvt() : Pvt_Solution()
 }
 
 
+void Ls_Pvt::reserve_workspace(int max_observations)
+{
+    if (static_cast<int>(d_ls_A.n_rows) < max_observations)
+        {
+            d_ls_A.set_size(max_observations, 4);
+            d_ls_omc.set_size(max_observations);
+        }
+}
+
+
 arma::vec Ls_Pvt::bancroftPos(const arma::mat& satpos, const arma::vec& obs)
 {
     // BANCROFT Calculation of preliminary coordinates for a GPS receiver based on pseudoranges
@@ -189,24 +199,23 @@ arma::vec Ls_Pvt::leastSquarePos(const arma::mat& satpos, const arma::vec& obs,
     int nmbOfIterations = 10;  // TODO: include in config
     int nmbOfSatellites;
     nmbOfSatellites = satpos.n_cols;  // Armadillo
-    arma::mat w = arma::zeros(nmbOfSatellites, nmbOfSatellites);
-    w.diag() = w_vec;  //diagonal weight matrix
+    this->reserve_workspace(nmbOfSatellites);  // no allocation once sized for the number of channels
 
+    // Small vectors and matrices (up to 16 elements) live in Armadillo's local storage
     arma::vec rx_pos = this->get_rx_pos();
     arma::vec pos = {rx_pos(0), rx_pos(1), rx_pos(2), 0};  // time error in METERS (time x speed)
-    arma::mat A;
-    arma::mat omc;
-    A = arma::zeros(nmbOfSatellites, 4);
-    omc = arma::zeros(nmbOfSatellites, 1);
-    arma::mat X = satpos;
     arma::vec Rot_X;
+    arma::vec x = arma::zeros(4);
+    arma::mat N = arma::zeros(4, 4);
     double rho2;
     double traveltime;
     double trop = 0.0;
     double dlambda;
     double dphi;
     double h;
-    arma::vec x;
+    double azim;
+    double elev;
+    double dist;
 
     //=== Iteratively find receiver position ===================================
     for (int iter = 0; iter < nmbOfIterations; iter++)
@@ -216,28 +225,25 @@ arma::vec Ls_Pvt::leastSquarePos(const arma::mat& satpos, const arma::vec& obs,
                     if (iter == 0)
                         {
                             //--- Initialize variables at the first iteration --------------
-                            Rot_X = X.col(i);  //Armadillo
+                            Rot_X = satpos.col(i);  //Armadillo
                             trop = 0.0;
                         }
                     else
                         {
                             //--- Update equations -----------------------------------------
-                            rho2 = (X(0, i) - pos(0)) *
-                                       (X(0, i) - pos(0)) +
-                                   (X(1, i) - pos(1)) *
-                                       (X(1, i) - pos(1)) +
-                                   (X(2, i) - pos(2)) *
-                                       (X(2, i) - pos(2));
+                            rho2 = (satpos(0, i) - pos(0)) *
+                                       (satpos(0, i) - pos(0)) +
+                                   (satpos(1, i) - pos(1)) *
+                                       (satpos(1, i) - pos(1)) +
+                                   (satpos(2, i) - pos(2)) *
+                                       (satpos(2, i) - pos(2));
                             traveltime = sqrt(rho2) / GPS_C_m_s;
 
                             //--- Correct satellite position (do to earth rotation) --------
-                            Rot_X = Ls_Pvt::rotateSatellite(traveltime, X.col(i));  //armadillo
+                            Rot_X = Ls_Pvt::rotateSatellite(traveltime, satpos.col(i));  //armadillo
 
                             //--- Find DOA and range of satellites
-                            double* azim = nullptr;
-                            double* elev = nullptr;
-                            double* dist = nullptr;
-                            topocent(azim, elev, dist, pos.subvec(0, 2), Rot_X - pos.subvec(0, 2));
+                            topocent(&azim, &elev, &dist, pos.subvec(0, 2), Rot_X - pos.subvec(0, 2));
 
                             if (traveltime < 0.1 && nmbOfSatellites > 3)
                                 {
@@ -252,27 +258,73 @@ arma::vec Ls_Pvt::leastSquarePos(const arma::mat& satpos, const arma::vec& obs,
                                     else
                                         {
                                             //--- Find delay due to troposphere (in meters)
-                                            Ls_Pvt::tropo(&trop, sin(*elev * GPS_PI / 180.0), h / 1000.0, 1013.0, 293.0, 50.0, 0.0, 0.0, 0.0);
+                                            Ls_Pvt::tropo(&trop, sin(elev * GPS_PI / 180.0), h / 1000.0, 1013.0, 293.0, 50.0, 0.0, 0.0, 0.0);
                                             if (trop > 5.0) trop = 0.0;  //check for erratic values
                                         }
                                 }
                         }
                     //--- Apply the corrections ----------------------------------------
-                    omc(i) = (obs(i) - norm(Rot_X - pos.subvec(0, 2), 2) - pos(3) - trop);  // Armadillo
+                    double dx = Rot_X(0) - pos(0);
+                    double dy = Rot_X(1) - pos(1);
+                    double dz = Rot_X(2) - pos(2);
+                    d_ls_omc(i) = (obs(i) - sqrt(dx * dx + dy * dy + dz * dz) - pos(3) - trop);
 
                     //--- Construct the A matrix ---------------------------------------
-                    //Armadillo
-                    A(i, 0) = (-(Rot_X(0) - pos(0))) / obs(i);
-                    A(i, 1) = (-(Rot_X(1) - pos(1))) / obs(i);
-                    A(i, 2) = (-(Rot_X(2) - pos(2))) / obs(i);
-                    A(i, 3) = 1.0;
+                    d_ls_A(i, 0) = -dx / obs(i);
+                    d_ls_A(i, 1) = -dy / obs(i);
+                    d_ls_A(i, 2) = -dz / obs(i);
+                    d_ls_A(i, 3) = 1.0;
                 }
 
             //--- Find position update ---------------------------------------------
-            x = arma::solve(w * A, w * omc);  // Armadillo
+            // Weighted normal equations (A' W^2 A) x = A' W^2 omc, which give the
+            // same solution as solving W A x = W omc in the least squares sense
+            N.zeros();
+            x.zeros();
+            for (int i = 0; i < nmbOfSatellites; i++)
+                {
+                    double w2 = w_vec(i) * w_vec(i);
+                    for (int r = 0; r < 4; r++)
+                        {
+                            double wa = w2 * d_ls_A(i, r);
+                            x(r) += wa * d_ls_omc(i);
+                            for (int c = 0; c <= r; c++)
+                                {
+                                    N(r, c) += wa * d_ls_A(i, c);
+                                }
+                        }
+                }
+
+            // In-place Cholesky factorization N = L L' (lower triangle) and substitutions
+            for (int c = 0; c < 4; c++)
+                {
+                    double d = N(c, c);
+                    for (int k = 0; k < c; k++) d -= N(c, k) * N(c, k);
+                    if (d <= 0.0)
+                        {
+                            throw std::runtime_error("Singular geometry in the least squares solution");
+                        }
+                    N(c, c) = sqrt(d);
+                    for (int r = c + 1; r < 4; r++)
+                        {
+                            double v = N(r, c);
+                            for (int k = 0; k < c; k++) v -= N(r, k) * N(c, k);
+                            N(r, c) = v / N(c, c);
+                        }
+                }
+            for (int r = 0; r < 4; r++)
+                {
+                    for (int k = 0; k < r; k++) x(r) -= N(r, k) * x(k);
+                    x(r) /= N(r, r);
+                }
+            for (int r = 3; r >= 0; r--)
+                {
+                    for (int k = r + 1; k < 4; k++) x(r) -= N(k, r) * x(k);
+                    x(r) /= N(r, r);
+                }
 
             //--- Apply position update --------------------------------------------
-            pos = pos + x;
+            pos += x;
             if (arma::norm(x, 2) < 1e-4)
                 {
                     break;  // exit the loop because we assume that the LS algorithm has converged (err < 0.1 cm)
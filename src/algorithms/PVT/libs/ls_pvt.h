@@ -47,6 +47,16 @@ private:
      */
     double lorentz(const arma::vec& x, const arma::vec& y);
 
+    arma::mat d_ls_A;    // design matrix workspace
+    arma::vec d_ls_omc;  // observed minus computed workspace
+
+protected:
+    /*!
+     * \brief Sizes the least squares workspace for up to \p max_observations
+     * satellites, so that leastSquarePos() does not allocate memory
+     */
+    void reserve_workspace(int max_observations);
+
 public:
     Ls_Pvt();
 
@@ -42,6 +42,8 @@
 #include <glog/logging.h>
 #include <cstdint>
 #include <fcntl.h>
+#include <iomanip>
+#include <sstream>
 #include <termios.h>
 
 
@@ -50,6 +52,8 @@ using google::LogMessage;
 
 Nmea_Printer::Nmea_Printer(const std::string& filename, bool flag_nmea_output_file, bool flag_nmea_tty_port, std::string nmea_dump_devname, const std::string& base_path)
 {
+    d_PVT_data = nullptr;
+    d_ssat = std::vector<ssat_t>(MAXSAT, ssat_t());
     nmea_base_path = base_path;
     d_flag_nmea_output_file = flag_nmea_output_file;
     if (d_flag_nmea_output_file == true)
@@ -88,7 +92,7 @@ Nmea_Printer::Nmea_Printer(const std::string& filename, bool flag_nmea_output_fi
 
             nmea_filename = nmea_base_path + filename;
 
-            nmea_file_descriptor.open(nmea_filename.c_str(), std::ios::out);
+            nmea_file_descriptor.open(nmea_filename);
             if (nmea_file_descriptor.is_open())
                 {
                     DLOG(INFO) << "NMEA printer writing on " << nmea_filename.c_str();
@@ -105,6 +109,7 @@ Nmea_Printer::Nmea_Printer(const std::string& filename, bool flag_nmea_output_fi
             nmea_dev_descriptor = init_serial(nmea_devname);
             if (nmea_dev_descriptor != -1)
                 {
+                    nmea_dev_writer.set_descriptor(nmea_dev_descriptor);
                     DLOG(INFO) << "NMEA printer writing on " << nmea_devname.c_str();
                 }
         }
@@ -113,6 +118,7 @@ Nmea_Printer::Nmea_Printer(const std::string& filename, bool flag_nmea_output_fi
             nmea_dev_descriptor = -1;
         }
     print_avg_pos = false;
+    d_print_latency = false;
 }
 
 
@@ -174,16 +180,29 @@ void Nmea_Printer::close_serial()
 }
 
 
-bool Nmea_Printer::Print_Nmea_Line(const std::shared_ptr<rtklib_solver>& pvt_data, bool print_average_values)
+bool Nmea_Printer::Print_Nmea_Line(const Pvt_Output_Solution& pvt_data, bool print_average_values)
 {
     std::string GPRMC;
     std::string GPGGA;
     std::string GPGSA;
     std::string GPGSV;
+    std::string PGSDR;
 
     // set the new PVT data
-    d_PVT_data = pvt_data;
+    d_PVT_data = &pvt_data;
     print_avg_pos = print_average_values;
+    for (auto& ssat : d_ssat)
+        {
+            ssat.vs = 0;
+        }
+    for (const auto& satellite : pvt_data.satellites)
+        {
+            ssat_t& ssat = d_ssat[satellite.sat - 1];
+            ssat.vs = 1;
+            ssat.azel[0] = satellite.azel[0];
+            ssat.azel[1] = satellite.azel[1];
+            ssat.snr[0] = satellite.snr;
+        }
 
     // generate the NMEA sentences
 
@@ -195,20 +214,23 @@ bool Nmea_Printer::Print_Nmea_Line(const std::shared_ptr<rtklib_solver>& pvt_dat
     GPGSA = get_GPGSA();
     // GPGSV
     GPGSV = get_GPGSV();
+    // PGSDR,LAT (proprietary, only if the latency of the solution is known)
+    if (d_print_latency and (d_PVT_data->latency_s > 0.0))
+        {
+            PGSDR = get_latency_sentence();
+        }
+
+    // all the sentences of the epoch, in a single buffer
+    std::string epoch;
+    epoch.reserve(GPRMC.length() + GPGGA.length() + GPGSA.length() + GPGSV.length() + PGSDR.length());
+    epoch.append(GPRMC).append(GPGGA).append(GPGSA).append(GPGSV).append(PGSDR);
 
     // write to log file
     if (d_flag_nmea_output_file)
         {
             try
                 {
-                    // GPRMC
-                    nmea_file_descriptor << GPRMC;
-                    // GPGGA (Global Positioning System Fixed Data)
-                    nmea_file_descriptor << GPGGA;
-                    // GPGSA
-                    nmea_file_descriptor << GPGSA;
-                    // GPGSV
-                    nmea_file_descriptor << GPGSV;
+                    nmea_file_descriptor << epoch;
                 }
             catch (const std::exception& ex)
                 {
@@ -219,22 +241,7 @@ bool Nmea_Printer::Print_Nmea_Line(const std::shared_ptr<rtklib_solver>& pvt_dat
     // write to serial device
     if (nmea_dev_descriptor != -1)
         {
-            if (write(nmea_dev_descriptor, GPRMC.c_str(), GPRMC.length()) == -1)
-                {
-                    DLOG(INFO) << "NMEA printer cannot write on serial device" << nmea_devname.c_str();
-                    return false;
-                }
-            if (write(nmea_dev_descriptor, GPGGA.c_str(), GPGGA.length()) == -1)
-                {
-                    DLOG(INFO) << "NMEA printer cannot write on serial device" << nmea_devname.c_str();
-                    return false;
-                }
-            if (write(nmea_dev_descriptor, GPGSA.c_str(), GPGSA.length()) == -1)
-                {
-                    DLOG(INFO) << "NMEA printer cannot write on serial device" << nmea_devname.c_str();
-                    return false;
-                }
-            if (write(nmea_dev_descriptor, GPGSV.c_str(), GPGSV.length()) == -1)
+            if (!nmea_dev_writer.write_epoch(epoch))
                 {
                     DLOG(INFO) << "NMEA printer cannot write on serial device" << nmea_devname.c_str();
                     return false;
@@ -244,6 +251,37 @@ bool Nmea_Printer::Print_Nmea_Line(const std::shared_ptr<rtklib_solver>& pvt_dat
 }
 
 
+void Nmea_Printer::set_latency_sentence(bool print_latency)
+{
+    d_print_latency = print_latency;
+}
+
+
+void Nmea_Printer::set_flush_policy(std::size_t flush_bytes, int32_t flush_interval_ms)
+{
+    nmea_file_descriptor.set_flush_policy(flush_bytes, flush_interval_ms);
+}
+
+
+void Nmea_Printer::set_serial_overflow_policy(std::size_t max_pending_bytes, bool drop_oldest)
+{
+    nmea_dev_writer.set_overflow_policy(max_pending_bytes, drop_oldest);
+}
+
+
+std::string Nmea_Printer::get_latency_sentence()
+{
+    // $PGSDR,LAT,215.3*20
+    // Latency from the arrival of the samples to the solution, in milliseconds
+    std::stringstream body;
+    body << "PGSDR,LAT," << std::fixed << std::setprecision(1) << d_PVT_data->latency_s * 1e3;
+    std::stringstream sentence_str;
+    sentence_str << "$" << body.str() << "*" << std::uppercase << std::hex << std::setw(2) << std::setfill('0')
+                 << static_cast<int>(static_cast<unsigned char>(checkSum(body.str()))) << "\r\n";
+    return sentence_str.str();
+}
+
+
 char Nmea_Printer::checkSum(std::string sentence)
 {
     char check = 0;
@@ -393,7 +431,7 @@ std::string Nmea_Printer::get_GPGSA()
     // GSA-GNSS DOP and Active Satellites
     std::stringstream sentence_str;
     unsigned char buff[1024] = {0};
-    outnmea_gsa(buff, &d_PVT_data->pvt_sol, d_PVT_data->pvt_ssat);
+    outnmea_gsa(buff, &d_PVT_data->pvt_sol, d_ssat.data());
     sentence_str << buff;
     return sentence_str.str();
 }
@@ -406,7 +444,7 @@ std::string Nmea_Printer::get_GPGSV()
     // Notice that NMEA 2.1 only supports 12 channels
     std::stringstream sentence_str;
     unsigned char buff[1024] = {0};
-    outnmea_gsv(buff, &d_PVT_data->pvt_sol, d_PVT_data->pvt_ssat);
+    outnmea_gsv(buff, &d_PVT_data->pvt_sol, d_ssat.data());
     sentence_str << buff;
     return sentence_str.str();
 }
@@ -36,9 +36,12 @@
 #ifndef GNSS_SDR_NMEA_PRINTER_H_
 #define GNSS_SDR_NMEA_PRINTER_H_
 
+#include "pvt_buffered_writer.h"
 #include "rtklib_solver.h"
-#include <fstream>
+#include <cstddef>
+#include <cstdint>
 #include <string>
+#include <vector>
 
 
 /*!
@@ -58,7 +61,23 @@ public:
     /*!
      * \brief Print NMEA PVT and satellite info to the initialized device
      */
-    bool Print_Nmea_Line(const std::shared_ptr<rtklib_solver>& pvt_data, bool print_average_values);
+    bool Print_Nmea_Line(const Pvt_Output_Solution& pvt_data, bool print_average_values);
+
+    /*!
+     * \brief Adds the proprietary $PGSDR,LAT sentence, with the latency of the solution, after each epoch
+     */
+    void set_latency_sentence(bool print_latency);
+
+    /*!
+     * \brief Sets the size of the output buffer and the minimum time between two writes to the log file
+     */
+    void set_flush_policy(std::size_t flush_bytes, int32_t flush_interval_ms);
+
+    /*!
+     * \brief Sets the maximum number of bytes waiting for the serial port, and
+     * whether the oldest or the newest epochs are dropped when it is exceeded
+     */
+    void set_serial_overflow_policy(std::size_t max_pending_bytes, bool drop_oldest);
 
     /*!
      * \brief Default destructor.
@@ -68,22 +87,26 @@ public:
 private:
     std::string nmea_filename;  // String with the NMEA log filename
     std::string nmea_base_path;
-    std::ofstream nmea_file_descriptor;  // Output file stream for NMEA log file
+    Pvt_Buffered_File nmea_file_descriptor;  // Output file stream for NMEA log file
     std::string nmea_devname;
     int nmea_dev_descriptor;  // NMEA serial device descriptor (i.e. COM port)
-    std::shared_ptr<rtklib_solver> d_PVT_data;
+    Pvt_Serial_Writer nmea_dev_writer;  // one write per epoch to the serial device
+    const Pvt_Output_Solution* d_PVT_data;  // solution being printed
+    std::vector<ssat_t> d_ssat;               // satellites of d_PVT_data in view, as RTKLIB prints them
     int init_serial(const std::string& serial_device);  //serial port control
     void close_serial();
-    std::string get_GPGGA();  // fix data
-    std::string get_GPGSV();  // satellite data
-    std::string get_GPGSA();  // overall satellite reception data
-    std::string get_GPRMC();  // minimum recommended data
+    std::string get_GPGGA();             // fix data
+    std::string get_GPGSV();             // satellite data
+    std::string get_GPGSA();             // overall satellite reception data
+    std::string get_GPRMC();             // minimum recommended data
+    std::string get_latency_sentence();  // latency from the arrival of the samples to the solution
     std::string get_UTC_NMEA_time(boost::posix_time::ptime d_position_UTC_time);
     std::string longitude_to_hm(double longitude);
     std::string latitude_to_hm(double lat);
     char checkSum(std::string sentence);
     bool print_avg_pos;
     bool d_flag_nmea_output_file;
+    bool d_print_latency;
 };
 
 #endif
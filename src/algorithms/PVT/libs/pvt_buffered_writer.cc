@@ -0,0 +1,311 @@
+/*!
+ * \file pvt_buffered_writer.cc
+ * \brief Buffered file and serial port writers shared by the position
+ * output printers (KML, GPX, GeoJSON and NMEA).
+ *
+ * -------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2019  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *          Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------
+ */
+
+#include "pvt_buffered_writer.h"
+#include <glog/logging.h>
+#include <algorithm>
+#include <cerrno>
+#include <fcntl.h>
+#include <unistd.h>
+
+
+Pvt_File_Buffer::Pvt_File_Buffer()
+{
+    d_fd = -1;
+    d_error = false;
+    set_flush_policy(65536, 1000);
+}
+
+
+Pvt_File_Buffer::~Pvt_File_Buffer()
+{
+    close();
+}
+
+
+bool Pvt_File_Buffer::open(const std::string& filename)
+{
+    close();
+    d_fd = ::open(filename.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0666);
+    d_error = (d_fd == -1);
+    d_last_write = std::chrono::steady_clock::now();
+    return !d_error;
+}
+
+
+bool Pvt_File_Buffer::is_open() const
+{
+    return d_fd != -1;
+}
+
+
+bool Pvt_File_Buffer::close()
+{
+    if (d_fd == -1)
+        {
+            return false;
+        }
+    bool ok = write_buffer();
+    if (fsync(d_fd) == -1)
+        {
+            ok = false;
+        }
+    if (::close(d_fd) == -1)
+        {
+            ok = false;
+        }
+    d_fd = -1;
+    return ok;
+}
+
+
+void Pvt_File_Buffer::set_flush_policy(std::size_t flush_bytes, int32_t flush_interval_ms)
+{
+    write_buffer();
+    d_buffer.assign(std::max<std::size_t>(flush_bytes, 1), 0);
+    setp(d_buffer.data(), d_buffer.data() + d_buffer.size());
+    d_flush_interval = std::chrono::milliseconds(std::max(flush_interval_ms, 0));
+}
+
+
+bool Pvt_File_Buffer::write_buffer()
+{
+    const char* data = pbase();
+    std::size_t remaining = pptr() - pbase();
+    while ((remaining > 0) and (d_fd != -1) and !d_error)
+        {
+            ssize_t n = ::write(d_fd, data, remaining);
+            if (n == -1)
+                {
+                    if (errno == EINTR)
+                        {
+                            continue;
+                        }
+                    LOG(WARNING) << "Error writing an output file, errno " << errno;
+                    d_error = true;
+                    break;
+                }
+            data += n;
+            remaining -= n;
+        }
+    setp(d_buffer.data(), d_buffer.data() + d_buffer.size());
+    d_last_write = std::chrono::steady_clock::now();
+    return !d_error;
+}
+
+
+Pvt_File_Buffer::int_type Pvt_File_Buffer::overflow(int_type c)
+{
+    if ((d_fd == -1) or !write_buffer())
+        {
+            return traits_type::eof();
+        }
+    if (!traits_type::eq_int_type(c, traits_type::eof()))
+        {
+            *pptr() = traits_type::to_char_type(c);
+            pbump(1);
+        }
+    return traits_type::not_eof(c);
+}
+
+
+int Pvt_File_Buffer::sync()
+{
+    if (d_fd == -1)
+        {
+            return -1;
+        }
+    // std::endl and std::flush only write the buffer once per flush interval
+    if ((pptr() != pbase()) and (std::chrono::steady_clock::now() - d_last_write >= d_flush_interval))
+        {
+            return write_buffer() ? 0 : -1;
+        }
+    return d_error ? -1 : 0;
+}
+
+
+Pvt_Buffered_File::Pvt_Buffered_File() : std::ostream(nullptr)
+{
+    rdbuf(&d_file_buffer);
+}
+
+
+Pvt_Buffered_File::~Pvt_Buffered_File()
+{
+    d_file_buffer.close();
+}
+
+
+void Pvt_Buffered_File::open(const std::string& filename)
+{
+    if (d_file_buffer.open(filename))
+        {
+            clear();
+        }
+    else
+        {
+            setstate(std::ios_base::failbit);
+        }
+}
+
+
+bool Pvt_Buffered_File::is_open() const
+{
+    return d_file_buffer.is_open();
+}
+
+
+void Pvt_Buffered_File::close()
+{
+    if (!d_file_buffer.close())
+        {
+            setstate(std::ios_base::failbit);
+        }
+}
+
+
+void Pvt_Buffered_File::set_flush_policy(std::size_t flush_bytes, int32_t flush_interval_ms)
+{
+    d_file_buffer.set_flush_policy(flush_bytes, flush_interval_ms);
+}
+
+
+Pvt_Serial_Writer::Pvt_Serial_Writer()
+{
+    d_fd = -1;
+    d_max_pending_bytes = 4096;
+    d_drop_oldest = true;
+    d_head_started = false;
+    d_dropped_epochs = 0ULL;
+}
+
+
+void Pvt_Serial_Writer::set_descriptor(int fd)
+{
+    d_fd = fd;
+    d_pending.clear();
+    d_epoch_sizes.clear();
+    d_head_started = false;
+    if (d_fd != -1)
+        {
+            int flags = fcntl(d_fd, F_GETFL, 0);
+            if ((flags == -1) or (fcntl(d_fd, F_SETFL, flags | O_NONBLOCK) == -1))
+                {
+                    LOG(WARNING) << "Cannot set the serial port in non-blocking mode";
+                }
+        }
+}
+
+
+void Pvt_Serial_Writer::set_overflow_policy(std::size_t max_pending_bytes, bool drop_oldest)
+{
+    d_max_pending_bytes = max_pending_bytes;
+    d_drop_oldest = drop_oldest;
+}
+
+
+bool Pvt_Serial_Writer::write_epoch(const std::string& epoch)
+{
+    if (d_fd == -1)
+        {
+            return false;
+        }
+    bool dropped = false;
+    if (d_pending.size() + epoch.size() > d_max_pending_bytes)
+        {
+            if (d_drop_oldest)
+                {
+                    // an epoch that started to be sent is kept, so the port does not get a truncated sentence
+                    std::size_t first = d_head_started ? 1 : 0;
+                    std::size_t offset = d_head_started ? d_epoch_sizes.front() : 0;
+                    while ((d_epoch_sizes.size() > first) and (d_pending.size() + epoch.size() > d_max_pending_bytes))
+                        {
+                            d_pending.erase(offset, d_epoch_sizes[first]);
+                            d_epoch_sizes.erase(d_epoch_sizes.begin() + first);
+                            d_dropped_epochs++;
+                            dropped = true;
+                        }
+                }
+            if (d_pending.size() + epoch.size() > d_max_pending_bytes)
+                {
+                    d_dropped_epochs++;
+                    DLOG(INFO) << "Serial port busy, NMEA epoch dropped (" << d_dropped_epochs << " so far)";
+                    write_pending();
+                    return false;
+                }
+            DLOG(INFO) << "Serial port busy, old NMEA epochs dropped (" << d_dropped_epochs << " so far)";
+        }
+    d_pending.append(epoch);
+    d_epoch_sizes.push_back(epoch.size());
+    return write_pending() and !dropped;
+}
+
+
+bool Pvt_Serial_Writer::write_pending()
+{
+    if (d_pending.empty())
+        {
+            return true;
+        }
+    ssize_t n = write(d_fd, d_pending.data(), d_pending.size());
+    if (n == -1)
+        {
+            if ((errno == EAGAIN) or (errno == EWOULDBLOCK) or (errno == EINTR))
+                {
+                    return true;  // port busy, try again with the next epoch
+                }
+            DLOG(INFO) << "Error writing on the serial port, errno " << errno;
+            return false;
+        }
+    d_pending.erase(0, n);
+    auto sent = static_cast<std::size_t>(n);
+    while (sent > 0)
+        {
+            if (sent >= d_epoch_sizes.front())
+                {
+                    sent -= d_epoch_sizes.front();
+                    d_epoch_sizes.pop_front();
+                    d_head_started = false;
+                }
+            else
+                {
+                    d_epoch_sizes.front() -= sent;
+                    d_head_started = true;
+                    sent = 0;
+                }
+        }
+    return true;
+}
+
+
+uint64_t Pvt_Serial_Writer::get_dropped_epochs() const
+{
+    return d_dropped_epochs;
+}
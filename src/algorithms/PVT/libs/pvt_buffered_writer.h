@@ -0,0 +1,144 @@
+/*!
+ * \file pvt_buffered_writer.h
+ * \brief Buffered file and serial port writers shared by the position
+ * output printers (KML, GPX, GeoJSON and NMEA).
+ *
+ * -------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2019  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *          Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_PVT_BUFFERED_WRITER_H_
+#define GNSS_SDR_PVT_BUFFERED_WRITER_H_
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <ostream>
+#include <streambuf>
+#include <string>
+#include <vector>
+
+
+/*!
+ * \brief Output buffer of a Pvt_Buffered_File.
+ *
+ * The characters are copied to a buffer of flush_bytes bytes, which is
+ * written to the file with a single system call when it is full, or when
+ * the stream is flushed (e.g., by std::endl) and the last write was more
+ * than flush_interval_ms milliseconds ago. A flush interval of 0 writes on
+ * every flush, as std::ofstream.
+ */
+class Pvt_File_Buffer : public std::streambuf
+{
+public:
+    Pvt_File_Buffer();
+    ~Pvt_File_Buffer() override;
+
+    bool open(const std::string& filename);
+    bool is_open() const;
+
+    /*!
+     * \brief Writes the buffer, synchronizes the file with the disk (fsync)
+     * and closes it, so a closed file is complete even after a power loss.
+     */
+    bool close();
+
+    void set_flush_policy(std::size_t flush_bytes, int32_t flush_interval_ms);
+
+protected:
+    int_type overflow(int_type c) override;
+    int sync() override;
+
+private:
+    bool write_buffer();
+
+    int d_fd;
+    std::vector<char> d_buffer;
+    std::chrono::steady_clock::duration d_flush_interval;
+    std::chrono::steady_clock::time_point d_last_write;
+    bool d_error;
+};
+
+
+/*!
+ * \brief Output file stream with the interface of the std::ofstream
+ * members used by the printers, writing through a Pvt_File_Buffer.
+ */
+class Pvt_Buffered_File : public std::ostream
+{
+public:
+    Pvt_Buffered_File();
+    ~Pvt_Buffered_File() override;
+
+    void open(const std::string& filename);
+    bool is_open() const;
+    void close();
+
+    void set_flush_policy(std::size_t flush_bytes, int32_t flush_interval_ms);
+
+private:
+    Pvt_File_Buffer d_file_buffer;
+};
+
+
+/*!
+ * \brief Writes the output of each epoch to a serial port with a single
+ * system call, without blocking the caller.
+ *
+ * The port is set to non-blocking mode. The bytes that the port cannot take
+ * yet are kept, up to max_pending_bytes, and sent before the next epoch.
+ * When an epoch does not fit, either the oldest pending epochs that have not
+ * started to be sent, or the new epoch, are dropped, so the receiving device
+ * only gets complete sentences.
+ */
+class Pvt_Serial_Writer
+{
+public:
+    Pvt_Serial_Writer();
+
+    void set_descriptor(int fd);
+    void set_overflow_policy(std::size_t max_pending_bytes, bool drop_oldest);
+
+    /*!
+     * \brief Queues the output of an epoch and writes what the port accepts
+     * \return false if an epoch was dropped or the port returned an error
+     */
+    bool write_epoch(const std::string& epoch);
+
+    uint64_t get_dropped_epochs() const;  //!< Number of epochs dropped so far
+
+private:
+    bool write_pending();
+
+    int d_fd;
+    std::size_t d_max_pending_bytes;
+    bool d_drop_oldest;
+    std::string d_pending;
+    std::deque<std::size_t> d_epoch_sizes;  // unsent bytes of each pending epoch, oldest first
+    bool d_head_started;                    // the oldest pending epoch was partially sent
+    uint64_t d_dropped_epochs;
+};
+
+#endif
@@ -5,7 +5,7 @@
  *
  * -------------------------------------------------------------------------
  *
- * Copyright (C) 2010-2018  (see AUTHORS file for a list of contributors)
+ * Copyright (C) 2010-2019  (see AUTHORS file for a list of contributors)
  *
  * GNSS-SDR is a software defined Global Navigation
  *          Satellite Systems receiver
@@ -39,11 +39,14 @@ Pvt_Conf::Pvt_Conf()
     rinex_version = 0;
     rinexobs_rate_ms = 0;
     rinexnav_rate_ms = 0;
+    rinex_rotation = std::string("none");
+    rinex_compress = false;
 
     dump = false;
     dump_mat = true;
 
     flag_nmea_tty_port = false;
+    nmea_latency_sentence = false;
 
     flag_rtcm_server = false;
     flag_rtcm_tty_port = false;
@@ -57,6 +60,7 @@ Pvt_Conf::Pvt_Conf()
     nmea_output_file_enabled = true;
     kml_output_enabled = true;
     xml_output_enabled = true;
+    binary_output_enabled = false;
     rtcm_output_file_enabled = true;
 
     output_path = std::string(".");
@@ -67,4 +71,23 @@ Pvt_Conf::Pvt_Conf()
     kml_output_path = std::string(".");
     xml_output_path = std::string(".");
     rtcm_output_file_path = std::string(".");
+
+    rtcm_corrections_baud_rate = 115200U;
+
+    output_queue_size = 16U;
+    output_drop_oldest = false;
+    output_flush_bytes = 65536U;
+    output_flush_interval_ms = 1000;
+    nmea_tty_max_pending_bytes = 4096U;
+    nmea_tty_drop_oldest = true;
+
+    precise_solver_queue_size = 0U;
+
+    monitor_enabled = false;
+    monitor_udp_port = 1234U;
+
+    replay_log_enabled = false;
+    vector_observables = false;
+    ttff_msg_key = 1101;
+    replay_log_filename = std::string("./pvt_replay.log");
 }
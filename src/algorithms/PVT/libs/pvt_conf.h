@@ -5,7 +5,7 @@
  *
  * -------------------------------------------------------------------------
  *
- * Copyright (C) 2010-2018  (see AUTHORS file for a list of contributors)
+ * Copyright (C) 2010-2019  (see AUTHORS file for a list of contributors)
  *
  * GNSS-SDR is a software defined Global Navigation
  *          Satellite Systems receiver
@@ -35,6 +35,7 @@
 #include <cstdint>
 #include <map>
 #include <string>
+#include <vector>
 
 class Pvt_Conf
 {
@@ -46,6 +47,8 @@ public:
     int32_t rinex_version;
     int32_t rinexobs_rate_ms;
     int32_t rinexnav_rate_ms;
+    std::string rinex_rotation;  // "none", "hourly" or "daily" (local time, as the RINEX file names)
+    bool rinex_compress;         // gzip the RINEX files once they are closed
     std::map<int, int> rtcm_msg_rate_ms;
 
     bool dump;
@@ -55,12 +58,19 @@ public:
     bool flag_nmea_tty_port;
     std::string nmea_dump_filename;
     std::string nmea_dump_devname;
+    bool nmea_latency_sentence;  // proprietary $PGSDR,LAT sentence with the latency of each solution
 
     bool flag_rtcm_server;
     bool flag_rtcm_tty_port;
     uint16_t rtcm_tcp_port;
     uint16_t rtcm_station_id;
     std::string rtcm_dump_devname;
+    std::string rtcm_ntrip_mountpoint;  // if not empty, the RTCM server works as an NTRIP caster
+
+    // RTCM 3 corrections of a base station for the Static and Kinematic modes:
+    // a serial device, or an NTRIP caster as [user[:password]@]host[:port]/mountpoint
+    std::string rtcm_corrections_source;
+    uint32_t rtcm_corrections_baud_rate;
 
     bool output_enabled;
     bool rinex_output_enabled;
@@ -69,6 +79,7 @@ public:
     bool nmea_output_file_enabled;
     bool kml_output_enabled;
     bool xml_output_enabled;
+    bool binary_output_enabled;  // binary stores of the navigation data, next to the XML files
     bool rtcm_output_file_enabled;
 
     std::string output_path;
@@ -80,6 +91,36 @@ public:
     std::string xml_output_path;
     std::string rtcm_output_file_path;
 
+    // KML, GPX, GeoJSON and NMEA outputs are printed from a queue of solutions by their own thread
+    uint32_t output_queue_size;  // 0 prints them synchronously
+    bool output_drop_oldest;     // when the queue is full, drop the oldest solution instead of the new one
+
+    // the KML, GPX, GeoJSON and NMEA files are written when their buffer is full or once per flush interval
+    uint32_t output_flush_bytes;
+    int32_t output_flush_interval_ms;  // 0 writes every line, as before
+
+    // bytes waiting for the NMEA serial port, and which epochs are dropped when exceeded
+    uint32_t nmea_tty_max_pending_bytes;
+    bool nmea_tty_drop_oldest;
+
+    // RTK/PPP epochs solved by their own thread, the block keeps computing single point solutions
+    uint32_t precise_solver_queue_size;  // 0 solves them synchronously
+
+    // every solution published as a Monitor_Pvt binary record over UDP
+    bool monitor_enabled;
+    std::vector<std::string> monitor_client_addresses;
+    uint16_t monitor_udp_port;
+
+    // observables and navigation data handed to the solver, logged for the pvt-replay tool
+    bool replay_log_enabled;
+    std::string replay_log_filename;
+
+    // all the channels of an epoch in a single input item (GNSS-SDR.vector_observables)
+    bool vector_observables;
+
+    // SysV message queue where the time to first fix is sent (GNSS-SDR.ttff_msg_key)
+    int32_t ttff_msg_key;
+
     Pvt_Conf();
 };
 
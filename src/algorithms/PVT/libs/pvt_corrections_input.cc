@@ -0,0 +1,351 @@
+/*!
+ * \file pvt_corrections_input.cc
+ * \brief Thread that receives the RTCM 3 corrections of a base station from
+ * an NTRIP caster or a serial port, for the RTK modes of the PVT block.
+ *
+ * -------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2019  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *          Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------
+ */
+
+#include "pvt_corrections_input.h"
+#include "rtklib_rtcm.h"
+#include "rtklib_rtkcmn.h"
+#include <boost/bind.hpp>
+#include <glog/logging.h>
+#include <cmath>
+#include <istream>
+#include <utility>
+
+
+namespace
+{
+const int CORRECTIONS_RETRY_S = 5;             // time between two connection attempts
+const std::size_t CORRECTIONS_QUEUE_SIZE = 32;  // base epochs not read yet by the PVT thread
+const std::size_t CORRECTIONS_RECENT_EPOCHS = 16;
+
+std::string base64_encode(const std::string& input)
+{
+    const char* table = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+    std::string output;
+    uint32_t bits = 0;
+    int n_bits = 0;
+    for (unsigned char c : input)
+        {
+            bits = (bits << 8) | c;
+            n_bits += 8;
+            while (n_bits >= 6)
+                {
+                    n_bits -= 6;
+                    output.push_back(table[(bits >> n_bits) & 0x3F]);
+                }
+        }
+    if (n_bits > 0)
+        {
+            output.push_back(table[(bits << (6 - n_bits)) & 0x3F]);
+        }
+    while (output.size() % 4 != 0)
+        {
+            output.push_back('=');
+        }
+    return output;
+}
+}  // namespace
+
+
+Pvt_Corrections_Input::Pvt_Corrections_Input(const std::string& source, uint32_t baud_rate) : d_resolver(d_io_service),
+                                                                                               d_socket(d_io_service),
+                                                                                               d_serial_port(d_io_service),
+                                                                                               d_retry_timer(d_io_service),
+                                                                                               d_queue(CORRECTIONS_QUEUE_SIZE)
+{
+    d_serial = (!source.empty() and source[0] == '/');
+    d_baud_rate = baud_rate;
+    if (d_serial)
+        {
+            d_device = source;
+        }
+    else
+        {
+            // [user[:password]@]host[:port]/mountpoint
+            std::string address = source;
+            std::string credentials;
+            std::size_t at = address.rfind('@');
+            if (at != std::string::npos)
+                {
+                    credentials = address.substr(0, at);
+                    address = address.substr(at + 1);
+                }
+            std::string mountpoint;
+            std::size_t slash = address.find('/');
+            if (slash != std::string::npos)
+                {
+                    mountpoint = address.substr(slash + 1);
+                    address = address.substr(0, slash);
+                }
+            std::size_t colon = address.find(':');
+            d_host = address.substr(0, colon);
+            d_port = (colon != std::string::npos) ? address.substr(colon + 1) : std::string("2101");
+            d_request = "GET /" + mountpoint + " HTTP/1.0\r\nUser-Agent: NTRIP GNSS-SDR\r\n";
+            if (!credentials.empty())
+                {
+                    d_request += "Authorization: Basic " + base64_encode(credentials) + "\r\n";
+                }
+            d_request += "\r\n";
+        }
+
+    d_rtcm = std::unique_ptr<rtcm_t>(new rtcm_t());
+    init_rtcm(d_rtcm.get());
+    d_base_position = {0.0, 0.0, 0.0};
+    d_base_position_valid = false;
+    d_decoded_epochs = 0ULL;
+    d_dropped_epochs = 0ULL;
+
+    d_thread = std::thread(&Pvt_Corrections_Input::run, this);
+}
+
+
+Pvt_Corrections_Input::~Pvt_Corrections_Input()
+{
+    d_io_service.stop();
+    if (d_thread.joinable())
+        {
+            d_thread.join();
+        }
+    free_rtcm(d_rtcm.get());
+    if (d_dropped_epochs > 0)
+        {
+            LOG(WARNING) << "The PVT block did not read " << d_dropped_epochs << " epochs of base station corrections";
+        }
+}
+
+
+void Pvt_Corrections_Input::run()
+{
+    connect();
+    boost::asio::io_service::work work(d_io_service);
+    d_io_service.run();
+}
+
+
+void Pvt_Corrections_Input::connect()
+{
+    if (d_serial)
+        {
+            boost::system::error_code error;
+            d_serial_port.open(d_device, error);
+            if (!error)
+                {
+                    d_serial_port.set_option(boost::asio::serial_port_base::baud_rate(d_baud_rate), error);
+                }
+            if (error)
+                {
+                    LOG(WARNING) << "Cannot open the corrections serial port " << d_device << ": " << error.message();
+                    retry();
+                    return;
+                }
+            LOG(INFO) << "Reading RTCM corrections from " << d_device;
+            read_stream();
+            return;
+        }
+
+    // NTRIP caster, without blocking the thread so that the destructor can stop it at any time
+    d_resolver.async_resolve(boost::asio::ip::tcp::resolver::query(d_host, d_port),
+        [this](const boost::system::error_code& resolve_error, boost::asio::ip::tcp::resolver::iterator endpoint) {
+            if (resolve_error)
+                {
+                    LOG(WARNING) << "Cannot resolve the NTRIP caster " << d_host << ": " << resolve_error.message();
+                    retry();
+                    return;
+                }
+            boost::asio::async_connect(d_socket, endpoint,
+                [this](const boost::system::error_code& connect_error, boost::asio::ip::tcp::resolver::iterator /*connected*/) {
+                    if (connect_error)
+                        {
+                            LOG(WARNING) << "Cannot connect to the NTRIP caster " << d_host << ":" << d_port << ": " << connect_error.message();
+                            retry();
+                            return;
+                        }
+                    boost::asio::async_write(d_socket, boost::asio::buffer(d_request),
+                        [this](const boost::system::error_code& write_error, std::size_t /*length*/) {
+                            if (write_error)
+                                {
+                                    LOG(WARNING) << "Cannot send the request to the NTRIP caster: " << write_error.message();
+                                    retry();
+                                    return;
+                                }
+                            boost::asio::async_read_until(d_socket, d_response, "\r\n",
+                                boost::bind(&Pvt_Corrections_Input::on_ntrip_response, this, boost::asio::placeholders::error));
+                        });
+                });
+        });
+}
+
+
+void Pvt_Corrections_Input::retry()
+{
+    boost::system::error_code ignored;
+    d_socket.close(ignored);
+    d_serial_port.close(ignored);
+    d_response.consume(d_response.size());
+    d_retry_timer.expires_from_now(boost::posix_time::seconds(CORRECTIONS_RETRY_S));
+    d_retry_timer.async_wait([this](const boost::system::error_code& error) {
+        if (!error)
+            {
+                connect();
+            }
+    });
+}
+
+
+void Pvt_Corrections_Input::on_ntrip_response(const boost::system::error_code& error)
+{
+    if (error)
+        {
+            LOG(WARNING) << "No response from the NTRIP caster: " << error.message();
+            retry();
+            return;
+        }
+    std::istream response(&d_response);
+    std::string status;
+    std::getline(response, status);
+    // NTRIP 1.0 casters answer "ICY 200 OK"
+    if (status.find(" 200") == std::string::npos)
+        {
+            LOG(WARNING) << "NTRIP caster " << d_host << " refused the request: " << status;
+            retry();
+            return;
+        }
+    LOG(INFO) << "Receiving RTCM corrections from " << d_host << ":" << d_port;
+
+    // the stream may have started in the same read as the response
+    std::vector<unsigned char> pending(d_response.size());
+    response.read(reinterpret_cast<char*>(pending.data()), pending.size());
+    decode(pending.data(), pending.size());
+    read_stream();
+}
+
+
+void Pvt_Corrections_Input::read_stream()
+{
+    auto handler = [this](const boost::system::error_code& error, std::size_t length) {
+        if (error)
+            {
+                LOG(WARNING) << "RTCM corrections stream interrupted: " << error.message();
+                retry();
+                return;
+            }
+        decode(d_read_buffer.data(), length);
+        read_stream();
+    };
+    if (d_serial)
+        {
+            d_serial_port.async_read_some(boost::asio::buffer(d_read_buffer), handler);
+        }
+    else
+        {
+            d_socket.async_read_some(boost::asio::buffer(d_read_buffer), handler);
+        }
+}
+
+
+void Pvt_Corrections_Input::decode(const unsigned char* data, std::size_t length)
+{
+    for (std::size_t i = 0; i < length; i++)
+        {
+            int ret = input_rtcm3(d_rtcm.get(), data[i]);
+            if (ret == 5)
+                {
+                    // station position
+                    for (int j = 0; j < 3; j++)
+                        {
+                            d_base_position[j] = d_rtcm->sta.pos[j];
+                        }
+                    d_base_position_valid = (norm_rtk(d_rtcm->sta.pos, 3) > 0.0);
+                }
+            else if ((ret == 1) and (d_rtcm->obs.n > 0))
+                {
+                    Pvt_Base_Epoch epoch;
+                    epoch.time = d_rtcm->obs.data[0].time;
+                    epoch.obs.assign(d_rtcm->obs.data, d_rtcm->obs.data + d_rtcm->obs.n);
+                    for (auto& obs : epoch.obs)
+                        {
+                            obs.rcv = 2;
+                        }
+                    epoch.position_ecef = d_base_position;
+                    epoch.position_valid = d_base_position_valid;
+                    d_decoded_epochs++;
+                    if (!d_queue.push(std::move(epoch)))
+                        {
+                            d_dropped_epochs++;
+                        }
+                }
+        }
+}
+
+
+bool Pvt_Corrections_Input::get_base_epoch(gtime_t rover_time, double max_age_s, Pvt_Base_Epoch& epoch)
+{
+    Pvt_Base_Epoch received;
+    while (d_queue.try_pop(received))
+        {
+            d_recent_epochs.push_back(std::move(received));
+            if (d_recent_epochs.size() > CORRECTIONS_RECENT_EPOCHS)
+                {
+                    d_recent_epochs.pop_front();
+                }
+        }
+
+    // the base epochs arrive in time order: look for the closest one to the rover epoch
+    std::size_t best = d_recent_epochs.size();
+    double best_dt = max_age_s;
+    for (std::size_t i = 0; i < d_recent_epochs.size(); i++)
+        {
+            double dt = std::fabs(timediff(d_recent_epochs[i].time, rover_time));
+            if (dt <= best_dt)
+                {
+                    best = i;
+                    best_dt = dt;
+                }
+        }
+    if (best == d_recent_epochs.size())
+        {
+            return false;
+        }
+    // the next rover epochs are later, so the older base epochs are not needed anymore
+    d_recent_epochs.erase(d_recent_epochs.begin(), d_recent_epochs.begin() + best);
+    epoch = d_recent_epochs.front();
+    return true;
+}
+
+
+uint64_t Pvt_Corrections_Input::get_decoded_epochs() const
+{
+    return d_decoded_epochs;
+}
+
+
+uint64_t Pvt_Corrections_Input::get_dropped_epochs() const
+{
+    return d_dropped_epochs;
+}
@@ -0,0 +1,127 @@
+/*!
+ * \file pvt_corrections_input.h
+ * \brief Thread that receives the RTCM 3 corrections of a base station from
+ * an NTRIP caster or a serial port, for the RTK modes of the PVT block.
+ *
+ * -------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2019  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *          Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_PVT_CORRECTIONS_INPUT_H_
+#define GNSS_SDR_PVT_CORRECTIONS_INPUT_H_
+
+#include "concurrent_ring_queue.h"
+#include "rtklib.h"
+#include <boost/asio.hpp>
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+
+/*!
+ * \brief Observations of the base station at one epoch
+ */
+struct Pvt_Base_Epoch
+{
+    gtime_t time;
+    std::vector<obsd_t> obs;             // rcv = 2, as expected by rtkpos()
+    std::array<double, 3> position_ecef;  // antenna reference point (MT1005/MT1006)
+    bool position_valid;
+};
+
+
+/*!
+ * \brief Receives and decodes the RTCM 3 stream of a base station with
+ * Boost.Asio in its own thread, and hands the decoded epochs to the PVT
+ * thread through a lock-free queue.
+ *
+ * The source is either a serial device (a path starting with '/') or an
+ * NTRIP caster, given as in RTKLIB: [user[:password]@]host[:port]/mountpoint.
+ * The connection is retried every few seconds when it fails or drops.
+ */
+class Pvt_Corrections_Input
+{
+public:
+    Pvt_Corrections_Input(const std::string& source, uint32_t baud_rate);
+
+    /*!
+     * \brief Stops the thread and closes the connection.
+     */
+    ~Pvt_Corrections_Input();
+
+    /*!
+     * \brief Returns the base epoch closest to \p rover_time, if it is not
+     * older than \p max_age_s. Never blocks. Only the PVT thread calls it.
+     */
+    bool get_base_epoch(gtime_t rover_time, double max_age_s, Pvt_Base_Epoch& epoch);
+
+    uint64_t get_decoded_epochs() const;  //!< Number of base epochs decoded so far
+    uint64_t get_dropped_epochs() const;  //!< Epochs lost because the PVT thread did not read them
+
+private:
+    void run();
+    void connect();
+    void retry();
+    void on_ntrip_response(const boost::system::error_code& error);
+    void read_stream();
+    void decode(const unsigned char* data, std::size_t length);
+
+    // NTRIP caster or serial port
+    bool d_serial;
+    std::string d_device;
+    uint32_t d_baud_rate;
+    std::string d_host;
+    std::string d_port;
+    std::string d_request;
+
+    boost::asio::io_service d_io_service;
+    boost::asio::ip::tcp::resolver d_resolver;
+    boost::asio::ip::tcp::socket d_socket;
+    boost::asio::serial_port d_serial_port;
+    boost::asio::deadline_timer d_retry_timer;
+    boost::asio::streambuf d_response;
+    std::array<unsigned char, 4096> d_read_buffer;
+
+    // owned by the input thread
+    std::unique_ptr<rtcm_t> d_rtcm;
+    std::array<double, 3> d_base_position;
+    bool d_base_position_valid;
+
+    // from the input thread to the PVT thread
+    concurrent_ring_queue<Pvt_Base_Epoch> d_queue;
+    std::atomic<uint64_t> d_decoded_epochs;
+    std::atomic<uint64_t> d_dropped_epochs;
+
+    // owned by the PVT thread
+    std::deque<Pvt_Base_Epoch> d_recent_epochs;
+
+    std::thread d_thread;
+};
+
+#endif
@@ -0,0 +1,120 @@
+/*!
+ * \file pvt_output_writer.cc
+ * \brief Thread that runs the position output printers of the PVT block.
+ *
+ * -------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2018  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *          Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------
+ */
+
+#include "pvt_output_writer.h"
+#include <glog/logging.h>
+#include <algorithm>
+#include <exception>
+#include <utility>
+
+
+Pvt_Output_Writer::Pvt_Output_Writer(std::function<void(const Pvt_Output_Solution&)> print, uint32_t queue_size, bool drop_oldest)
+{
+    d_print = std::move(print);
+    d_queue_size = std::max(queue_size, 1U);
+    d_drop_oldest = drop_oldest;
+    d_stalls = 0ULL;
+    d_stop = false;
+    d_thread = std::thread(&Pvt_Output_Writer::run, this);
+}
+
+
+Pvt_Output_Writer::~Pvt_Output_Writer()
+{
+    {
+        std::lock_guard<std::mutex> lock(d_mutex);
+        d_stop = true;
+    }
+    d_cond.notify_all();
+    if (d_thread.joinable())
+        {
+            d_thread.join();
+        }
+    if (d_stalls > 0)
+        {
+            LOG(WARNING) << "The PVT outputs dropped " << d_stalls << " solutions because the printers could not keep up";
+        }
+}
+
+
+bool Pvt_Output_Writer::push(Pvt_Output_Solution snapshot)
+{
+    bool queued = true;
+    {
+        std::lock_guard<std::mutex> lock(d_mutex);
+        if (d_queue.size() >= d_queue_size)
+            {
+                d_stalls++;
+                queued = false;
+                LOG_EVERY_N(WARNING, 100) << "PVT output queue full, solution dropped";
+                if (!d_drop_oldest)
+                    {
+                        return false;
+                    }
+                d_queue.pop_front();
+            }
+        d_queue.push_back(std::move(snapshot));
+    }
+    d_cond.notify_one();
+    return queued;
+}
+
+
+uint64_t Pvt_Output_Writer::get_stalls() const
+{
+    std::lock_guard<std::mutex> lock(d_mutex);
+    return d_stalls;
+}
+
+
+void Pvt_Output_Writer::run()
+{
+    while (true)
+        {
+            Pvt_Output_Solution snapshot;
+            {
+                std::unique_lock<std::mutex> lock(d_mutex);
+                d_cond.wait(lock, [this] { return d_stop or !d_queue.empty(); });
+                if (d_queue.empty())
+                    {
+                        return;  // stopped, and everything has been printed
+                    }
+                snapshot = std::move(d_queue.front());
+                d_queue.pop_front();
+            }
+            try
+                {
+                    d_print(snapshot);
+                }
+            catch (const std::exception& e)
+                {
+                    LOG(WARNING) << "Exception printing the PVT outputs " << e.what();
+                }
+        }
+}
@@ -0,0 +1,85 @@
+/*!
+ * \file pvt_output_writer.h
+ * \brief Thread that runs the position output printers of the PVT block.
+ *
+ * The PVT block publishes a snapshot of each solution into a bounded queue,
+ * and a dedicated thread hands them to the printers, so a slow disk or
+ * serial port does not stall the signal processing chain.
+ *
+ * -------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2018  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *          Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_PVT_OUTPUT_WRITER_H_
+#define GNSS_SDR_PVT_OUTPUT_WRITER_H_
+
+#include "rtklib_solver.h"
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+
+/*!
+ * \brief Runs a printing function on queued solution snapshots from its own thread.
+ *
+ * When the queue is full, either the new snapshot or the oldest queued one
+ * is dropped, and the stall is counted.
+ */
+class Pvt_Output_Writer
+{
+public:
+    Pvt_Output_Writer(std::function<void(const Pvt_Output_Solution&)> print, uint32_t queue_size, bool drop_oldest);
+
+    /*!
+     * \brief Prints the snapshots still queued and stops the thread.
+     */
+    ~Pvt_Output_Writer();
+
+    /*!
+     * \brief Queues the values of a solution to be printed.
+     * \return false if a snapshot was dropped because the queue was full.
+     */
+    bool push(Pvt_Output_Solution snapshot);
+
+    uint64_t get_stalls() const;  //!< Number of snapshots dropped so far
+
+private:
+    void run();
+
+    std::function<void(const Pvt_Output_Solution&)> d_print;
+    uint32_t d_queue_size;
+    bool d_drop_oldest;
+    uint64_t d_stalls;
+    std::deque<Pvt_Output_Solution> d_queue;
+    mutable std::mutex d_mutex;
+    std::condition_variable d_cond;
+    bool d_stop;
+    std::thread d_thread;
+};
+
+#endif
@@ -0,0 +1,161 @@
+/*!
+ * \file pvt_precise_solver.cc
+ * \brief Thread that runs the RTKLIB RTK/PPP solver apart from the PVT block.
+ *
+ * -------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2018  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *          Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------
+ */
+
+#include "pvt_precise_solver.h"
+#include "rtklib_rtkpos.h"
+#include <glog/logging.h>
+#include <algorithm>
+#include <utility>
+
+
+Pvt_Precise_Solver::Pvt_Precise_Solver(const rtk_t& rtk, const nav_t& nav, uint32_t queue_size)
+{
+    d_rtk = rtk;
+    d_nav = nav;
+    d_nav.eph = nullptr;
+    d_nav.geph = nullptr;
+    d_nav.n = 0;
+    d_nav.ng = 0;
+    d_queue_size = std::max(queue_size, 1U);
+    d_dropped_epochs = 0ULL;
+    d_stop = false;
+    d_thread = std::thread(&Pvt_Precise_Solver::run, this);
+}
+
+
+Pvt_Precise_Solver::~Pvt_Precise_Solver()
+{
+    {
+        std::lock_guard<std::mutex> lock(d_mutex);
+        d_stop = true;
+        d_epochs.clear();  // do not wait for the solutions nobody will read
+    }
+    d_cond.notify_all();
+    if (d_thread.joinable())
+        {
+            d_thread.join();
+        }
+    if (d_dropped_epochs > 0)
+        {
+            LOG(WARNING) << "The RTK/PPP solver dropped " << d_dropped_epochs << " epochs because it could not keep up";
+        }
+}
+
+
+bool Pvt_Precise_Solver::push(const obsd_t* obs, int n, const eph_t* eph, int neph, const geph_t* geph, int ngeph, const double* base_position)
+{
+    Epoch epoch;
+    epoch.obs.assign(obs, obs + n);
+    epoch.eph.assign(eph, eph + neph);
+    epoch.geph.assign(geph, geph + ngeph);
+    epoch.base_position_valid = (base_position != nullptr);
+    for (int i = 0; i < 3; i++)
+        {
+            epoch.base_position[i] = epoch.base_position_valid ? base_position[i] : 0.0;
+        }
+    epoch.queued = std::chrono::steady_clock::now();
+    bool queued = true;
+    {
+        std::lock_guard<std::mutex> lock(d_mutex);
+        if (d_epochs.size() >= d_queue_size)
+            {
+                d_epochs.pop_front();
+                d_dropped_epochs++;
+                queued = false;
+                LOG_EVERY_N(WARNING, 100) << "RTK/PPP solver queue full, epoch dropped";
+            }
+        d_epochs.push_back(std::move(epoch));
+    }
+    d_cond.notify_one();
+    return queued;
+}
+
+
+bool Pvt_Precise_Solver::pop_solution(Pvt_Precise_Solution& solution)
+{
+    std::lock_guard<std::mutex> lock(d_mutex);
+    if (d_solutions.empty())
+        {
+            return false;
+        }
+    solution = d_solutions.front();
+    d_solutions.pop_front();
+    return true;
+}
+
+
+uint64_t Pvt_Precise_Solver::get_dropped_epochs() const
+{
+    std::lock_guard<std::mutex> lock(d_mutex);
+    return d_dropped_epochs;
+}
+
+
+void Pvt_Precise_Solver::run()
+{
+    while (true)
+        {
+            Epoch epoch;
+            {
+                std::unique_lock<std::mutex> lock(d_mutex);
+                d_cond.wait(lock, [this] { return d_stop or !d_epochs.empty(); });
+                if (d_stop)
+                    {
+                        return;
+                    }
+                epoch = std::move(d_epochs.front());
+                d_epochs.pop_front();
+            }
+            d_nav.eph = epoch.eph.data();
+            d_nav.geph = epoch.geph.data();
+            d_nav.n = static_cast<int>(epoch.eph.size());
+            d_nav.ng = static_cast<int>(epoch.geph.size());
+            if (epoch.base_position_valid)
+                {
+                    for (int i = 0; i < 3; i++)
+                        {
+                            d_rtk.opt.rb[i] = epoch.base_position[i];
+                        }
+                }
+            if (rtkpos(&d_rtk, epoch.obs.data(), static_cast<int>(epoch.obs.size()), &d_nav) == 0)
+                {
+                    DLOG(INFO) << "RTKLIB rtkpos error message: " << d_rtk.errbuf;
+                    continue;
+                }
+            Pvt_Precise_Solution solution;
+            solution.sol = d_rtk.sol;
+            solution.latency_s = std::chrono::duration<double>(std::chrono::steady_clock::now() - epoch.queued).count();
+            std::lock_guard<std::mutex> lock(d_mutex);
+            if (d_solutions.size() >= d_queue_size)
+                {
+                    d_solutions.pop_front();
+                }
+            d_solutions.push_back(solution);
+        }
+}
@@ -0,0 +1,112 @@
+/*!
+ * \file pvt_precise_solver.h
+ * \brief Thread that runs the RTKLIB RTK/PPP solver apart from the PVT block.
+ *
+ * An RTK or PPP epoch with many satellites and an ambiguity search can
+ * take tens of milliseconds. The PVT block queues the epochs for this
+ * thread and keeps computing single point solutions on its fast path,
+ * reading the precise solutions back, tagged with their latency.
+ *
+ * -------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2018  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *          Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_PVT_PRECISE_SOLVER_H_
+#define GNSS_SDR_PVT_PRECISE_SOLVER_H_
+
+#include "rtklib.h"
+#include <array>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+
+/*!
+ * \brief RTK/PPP solution of one epoch
+ */
+struct Pvt_Precise_Solution
+{
+    sol_t sol;         // RTKLIB solution, sol.time is the epoch
+    double latency_s;  // from the epoch being queued to its solution
+};
+
+
+/*!
+ * \brief Solves the queued epochs with rtkpos() from its own thread.
+ *
+ * When the epoch queue is full the oldest epoch is dropped (the filter
+ * copes with the gap), and so is the oldest solution not yet read.
+ */
+class Pvt_Precise_Solver
+{
+public:
+    /*!
+     * \brief The solver takes over the state of \p rtk, which must not be
+     * used by the caller anymore.
+     */
+    Pvt_Precise_Solver(const rtk_t& rtk, const nav_t& nav, uint32_t queue_size);
+    ~Pvt_Precise_Solver();
+
+    /*!
+     * \brief Queues a copy of the observations and ephemerides of one epoch.
+     * \return false if an older epoch was dropped because the queue was full.
+     */
+    bool push(const obsd_t* obs, int n, const eph_t* eph, int neph, const geph_t* geph, int ngeph, const double* base_position = nullptr);
+
+    /*!
+     * \brief Pops the oldest solution not read yet, if any.
+     */
+    bool pop_solution(Pvt_Precise_Solution& solution);
+
+    uint64_t get_dropped_epochs() const;  //!< Number of epochs dropped so far
+
+private:
+    struct Epoch
+    {
+        std::vector<obsd_t> obs;
+        std::vector<eph_t> eph;
+        std::vector<geph_t> geph;
+        std::array<double, 3> base_position;  // ECEF, if broadcast with the base observations
+        bool base_position_valid;
+        std::chrono::steady_clock::time_point queued;
+    };
+    void run();
+
+    rtk_t d_rtk;
+    nav_t d_nav;
+    uint32_t d_queue_size;
+    uint64_t d_dropped_epochs;
+    std::deque<Epoch> d_epochs;
+    std::deque<Pvt_Precise_Solution> d_solutions;
+    mutable std::mutex d_mutex;
+    std::condition_variable d_cond;
+    bool d_stop;
+    std::thread d_thread;
+};
+
+#endif
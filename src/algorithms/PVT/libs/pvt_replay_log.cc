@@ -0,0 +1,413 @@
+/*!
+ * \file pvt_replay_log.cc
+ * \brief Log of the inputs of the PVT solver, for offline reprocessing.
+ *
+ * -------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2018  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *          Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------
+ */
+
+#include "pvt_replay_log.h"
+#include "GPS_L1_CA.h"
+#include "rtklib_solver.h"
+#include <boost/archive/binary_iarchive.hpp>
+#include <glog/logging.h>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <exception>
+#include <map>
+#include <memory>
+#include <streambuf>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+
+namespace
+{
+const size_t HEADER_SIZE = 4 * sizeof(uint32_t);
+const size_t RECORD_HEADER_SIZE = 2 * sizeof(uint32_t);
+const double SEAM_TOLERANCE_S = 0.0005;  // epochs of two segments closer than this are the same epoch
+const double HALF_WEEK_S = 302400.0;
+
+
+// t - reference [s], for receiver times that may be in consecutive GPS weeks
+double seconds_after(double t, double reference)
+{
+    double dt = t - reference;
+    if (dt < -HALF_WEEK_S)
+        {
+            dt += 2.0 * HALF_WEEK_S;
+        }
+    else if (dt >= HALF_WEEK_S)
+        {
+            dt -= 2.0 * HALF_WEEK_S;
+        }
+    return dt;
+}
+
+
+// identifies a signal of a satellite within an epoch
+uint64_t signal_key(const Gnss_Synchro& obs)
+{
+    return (static_cast<uint64_t>(static_cast<uint8_t>(obs.System)) << 48) |
+           (static_cast<uint64_t>(static_cast<uint8_t>(obs.Signal[0])) << 40) |
+           (static_cast<uint64_t>(static_cast<uint8_t>(obs.Signal[1])) << 32) |
+           obs.PRN;
+}
+
+// read-only stream buffer over a record payload
+class Payload_Streambuf : public std::streambuf
+{
+public:
+    Payload_Streambuf(const char* data, size_t size)
+    {
+        char* begin = const_cast<char*>(data);
+        setg(begin, begin, begin + size);
+    }
+};
+
+
+template <class T>
+bool load_payload(const char* payload, size_t size, T& data)
+{
+    try
+        {
+            Payload_Streambuf buffer(payload, size);
+            boost::archive::binary_iarchive archive(buffer, boost::archive::no_header);
+            archive >> data;
+        }
+    catch (const std::exception& e)
+        {
+            LOG(WARNING) << "PVT replay: corrupted navigation record: " << e.what();
+            return false;
+        }
+    return true;
+}
+}  // namespace
+
+
+Pvt_Replay_Log_Writer::Pvt_Replay_Log_Writer(const std::string& file_name, uint32_t nchannels)
+{
+    d_file.open(file_name.c_str(), std::ios::out | std::ios::binary | std::ios::trunc);
+    if (!d_file.is_open())
+        {
+            LOG(WARNING) << "Cannot open the PVT replay log " << file_name;
+            return;
+        }
+    const uint32_t header[4] = {PVT_REPLAY_LOG_MAGIC, PVT_REPLAY_LOG_VERSION, static_cast<uint32_t>(sizeof(Gnss_Synchro)), nchannels};
+    d_file.write(reinterpret_cast<const char*>(header), sizeof(header));
+    LOG(INFO) << "PVT replay log enabled: " << file_name;
+}
+
+
+Pvt_Replay_Log_Writer::~Pvt_Replay_Log_Writer()
+{
+    if (d_file.is_open())
+        {
+            d_file.close();
+        }
+}
+
+
+void Pvt_Replay_Log_Writer::write_record(uint32_t type, const char* payload, size_t size)
+{
+    const uint32_t record_header[2] = {type, static_cast<uint32_t>(size)};
+    d_file.write(reinterpret_cast<const char*>(record_header), sizeof(record_header));
+    d_file.write(payload, size);
+}
+
+
+void Pvt_Replay_Log_Writer::write_epoch(const std::vector<Gnss_Synchro>& gnss_observables, const std::vector<uint32_t>& valid_channels)
+{
+    if (!d_file.is_open() or valid_channels.empty())
+        {
+            return;
+        }
+    d_epoch.clear();
+    for (uint32_t ch : valid_channels)
+        {
+            d_epoch.push_back(gnss_observables[ch]);
+        }
+    write_record(PVT_REPLAY_EPOCH, reinterpret_cast<const char*>(d_epoch.data()), d_epoch.size() * sizeof(Gnss_Synchro));
+}
+
+
+Pvt_Replay_Log_Reader::Pvt_Replay_Log_Reader(const std::string& file_name) : d_data(nullptr), d_size(0), d_offset(HEADER_SIZE), d_nchannels(0)
+{
+    int fd = open(file_name.c_str(), O_RDONLY);
+    if (fd < 0)
+        {
+            LOG(WARNING) << "Cannot open the PVT replay log " << file_name;
+            return;
+        }
+    struct stat file_stat;
+    if (fstat(fd, &file_stat) != 0 or static_cast<size_t>(file_stat.st_size) < HEADER_SIZE)
+        {
+            close(fd);
+            LOG(WARNING) << "Empty PVT replay log " << file_name;
+            return;
+        }
+    d_size = static_cast<size_t>(file_stat.st_size);
+    void* map = mmap(nullptr, d_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (map == MAP_FAILED)
+        {
+            d_size = 0;
+            return;
+        }
+    // the log is read once from the beginning to the end
+    madvise(map, d_size, MADV_SEQUENTIAL);
+    uint32_t header[4];
+    std::memcpy(header, map, sizeof(header));
+    if (header[0] != PVT_REPLAY_LOG_MAGIC or header[1] != PVT_REPLAY_LOG_VERSION or header[2] != sizeof(Gnss_Synchro))
+        {
+            LOG(WARNING) << file_name << " is not a PVT replay log of this version of GNSS-SDR";
+            munmap(map, d_size);
+            d_size = 0;
+            return;
+        }
+    d_nchannels = header[3];
+    d_data = static_cast<const char*>(map);
+}
+
+
+Pvt_Replay_Log_Reader::~Pvt_Replay_Log_Reader()
+{
+    if (d_data != nullptr)
+        {
+            munmap(const_cast<char*>(d_data), d_size);
+        }
+}
+
+
+bool Pvt_Replay_Log_Reader::next_record(uint32_t& type, const char*& payload, size_t& size)
+{
+    if (d_data == nullptr or d_offset + RECORD_HEADER_SIZE > d_size)
+        {
+            return false;
+        }
+    uint32_t record_header[2];
+    std::memcpy(record_header, d_data + d_offset, sizeof(record_header));
+    if (d_offset + RECORD_HEADER_SIZE + record_header[1] > d_size)
+        {
+            // truncated last record, the receiver was stopped while writing it
+            return false;
+        }
+    type = record_header[0];
+    payload = d_data + d_offset + RECORD_HEADER_SIZE;
+    size = record_header[1];
+    d_offset += RECORD_HEADER_SIZE + size;
+    return true;
+}
+
+
+bool Pvt_Replay_Log_Reader::next_epoch(rtklib_solver& solver, std::vector<Gnss_Synchro>& gnss_observables, std::vector<uint32_t>& valid_channels)
+{
+    uint32_t type;
+    const char* payload;
+    size_t size;
+    while (next_record(type, payload, size))
+        {
+            if (type == PVT_REPLAY_EPOCH)
+                {
+                    const size_t n = size / sizeof(Gnss_Synchro);
+                    gnss_observables.resize(n);
+                    std::memcpy(gnss_observables.data(), payload, n * sizeof(Gnss_Synchro));
+                    valid_channels.resize(n);
+                    for (size_t i = 0; i < n; i++)
+                        {
+                            valid_channels[i] = static_cast<uint32_t>(i);
+                        }
+                    return true;
+                }
+            apply_navigation(solver, type, payload, size);
+        }
+    return false;
+}
+
+
+bool Pvt_Replay_Log_Reader::apply_navigation(rtklib_solver& solver, uint32_t type, const char* payload, size_t size)
+{
+    switch (type)
+        {
+        case PVT_REPLAY_GPS_EPHEMERIS:
+            {
+                Gps_Ephemeris gps_eph;
+                if (!load_payload(payload, size, gps_eph)) return false;
+                solver.gps_ephemeris_map[gps_eph.i_satellite_PRN] = gps_eph;
+                break;
+            }
+        case PVT_REPLAY_GPS_IONO:
+            return load_payload(payload, size, solver.gps_iono);
+        case PVT_REPLAY_GPS_UTC_MODEL:
+            return load_payload(payload, size, solver.gps_utc_model);
+        case PVT_REPLAY_GPS_CNAV_EPHEMERIS:
+            {
+                Gps_CNAV_Ephemeris gps_cnav_eph;
+                if (!load_payload(payload, size, gps_cnav_eph)) return false;
+                solver.gps_cnav_ephemeris_map[gps_cnav_eph.i_satellite_PRN] = gps_cnav_eph;
+                break;
+            }
+        case PVT_REPLAY_GPS_CNAV_IONO:
+            return load_payload(payload, size, solver.gps_cnav_iono);
+        case PVT_REPLAY_GPS_CNAV_UTC_MODEL:
+            return load_payload(payload, size, solver.gps_cnav_utc_model);
+        case PVT_REPLAY_GALILEO_EPHEMERIS:
+            {
+                Galileo_Ephemeris gal_eph;
+                if (!load_payload(payload, size, gal_eph)) return false;
+                solver.galileo_ephemeris_map[gal_eph.i_satellite_PRN] = gal_eph;
+                break;
+            }
+        case PVT_REPLAY_GALILEO_IONO:
+            return load_payload(payload, size, solver.galileo_iono);
+        case PVT_REPLAY_GALILEO_UTC_MODEL:
+            return load_payload(payload, size, solver.galileo_utc_model);
+        case PVT_REPLAY_GLONASS_GNAV_EPHEMERIS:
+            {
+                Glonass_Gnav_Ephemeris glo_gnav_eph;
+                if (!load_payload(payload, size, glo_gnav_eph)) return false;
+                solver.glonass_gnav_ephemeris_map[glo_gnav_eph.i_satellite_PRN] = glo_gnav_eph;
+                break;
+            }
+        case PVT_REPLAY_GLONASS_GNAV_UTC_MODEL:
+            return load_payload(payload, size, solver.glonass_gnav_utc_model);
+        default:
+            // record of a newer version, skip it
+            return false;
+        }
+    return true;
+}
+
+
+bool merge_pvt_replay_logs(const std::vector<std::string>& segment_files, const std::string& output_file, Pvt_Replay_Merge_Statistics& statistics)
+{
+    statistics = Pvt_Replay_Merge_Statistics();
+    std::vector<std::unique_ptr<Pvt_Replay_Log_Reader>> readers;
+    uint32_t nchannels = 0;
+    for (const auto& file : segment_files)
+        {
+            readers.emplace_back(new Pvt_Replay_Log_Reader(file));
+            if (!readers.back()->is_open())
+                {
+                    return false;
+                }
+            nchannels = std::max(nchannels, readers.back()->nchannels());
+        }
+    Pvt_Replay_Log_Writer writer(output_file, nchannels);
+    if (readers.empty() or !writer.is_open())
+        {
+            return false;
+        }
+
+    std::vector<Gnss_Synchro> epoch;
+    std::vector<Gnss_Synchro> last_epoch;  // last epoch written, as written
+    std::vector<uint32_t> valid_channels;
+    for (size_t s = 0; s < readers.size(); s++)
+        {
+            bool at_seam = !last_epoch.empty();
+            bool aligned = false;
+            std::map<uint64_t, double> phase_offset_rads;
+            int64_t sample_counter_offset = 0;
+            uint32_t type;
+            const char* payload;
+            size_t size;
+            while (readers[s]->next_record(type, payload, size))
+                {
+                    if (type != PVT_REPLAY_EPOCH)
+                        {
+                            // navigation data decoded in the overlap are those already logged, or newer
+                            writer.write_record(type, payload, size);
+                            continue;
+                        }
+                    const size_t n = size / sizeof(Gnss_Synchro);
+                    if (n == 0)
+                        {
+                            continue;
+                        }
+                    epoch.resize(n);
+                    std::memcpy(epoch.data(), payload, n * sizeof(Gnss_Synchro));
+                    if (at_seam)
+                        {
+                            double dt = seconds_after(epoch.front().RX_time, last_epoch.front().RX_time);
+                            if (dt < SEAM_TOLERANCE_S)
+                                {
+                                    if (dt > -SEAM_TOLERANCE_S)
+                                        {
+                                            // the common epoch: align this segment to the merged log
+                                            sample_counter_offset = static_cast<int64_t>(last_epoch.front().Tracking_sample_counter - epoch.front().Tracking_sample_counter);
+                                            for (const auto& obs : epoch)
+                                                {
+                                                    for (const auto& previous : last_epoch)
+                                                        {
+                                                            if (signal_key(previous) != signal_key(obs))
+                                                                {
+                                                                    continue;
+                                                                }
+                                                            double cycles = (previous.Carrier_phase_rads - obs.Carrier_phase_rads) / GPS_TWO_PI;
+                                                            double whole_cycles = std::round(cycles);
+                                                            if (std::fabs(cycles - whole_cycles) < 0.25)
+                                                                {
+                                                                    phase_offset_rads[signal_key(obs)] = whole_cycles * GPS_TWO_PI;
+                                                                    statistics.aligned_signals++;
+                                                                }
+                                                            else
+                                                                {
+                                                                    statistics.unaligned_signals++;
+                                                                }
+                                                        }
+                                                }
+                                            aligned = true;
+                                        }
+                                    statistics.overlap_epochs++;
+                                    continue;
+                                }
+                            if (!aligned)
+                                {
+                                    LOG(WARNING) << segment_files[s] << " does not overlap the previous segment, its carrier phases are not aligned";
+                                }
+                            statistics.seams++;
+                            at_seam = false;
+                        }
+                    valid_channels.resize(n);
+                    for (size_t i = 0; i < n; i++)
+                        {
+                            Gnss_Synchro& obs = epoch[i];
+                            obs.Tracking_sample_counter = static_cast<uint64_t>(static_cast<int64_t>(obs.Tracking_sample_counter) + sample_counter_offset);
+                            auto offset = phase_offset_rads.find(signal_key(obs));
+                            if (offset != phase_offset_rads.end())
+                                {
+                                    obs.Carrier_phase_rads += offset->second;
+                                }
+                            valid_channels[i] = static_cast<uint32_t>(i);
+                        }
+                    writer.write_epoch(epoch, valid_channels);
+                    last_epoch.swap(epoch);
+                    statistics.epochs++;
+                }
+        }
+    return true;
+}
@@ -0,0 +1,249 @@
+/*!
+ * \file pvt_replay_log.h
+ * \brief Log of the inputs of the PVT solver, for offline reprocessing.
+ *
+ * The PVT block can record the observables it hands to the solver at each
+ * epoch, interleaved with the navigation data received from the telemetry
+ * decoders. Replaying the log into an rtklib_solver reproduces the solver
+ * inputs of the original run, so PVT settings can be tried again without
+ * processing the signal.
+ *
+ * -------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2018  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *          Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_PVT_REPLAY_LOG_H_
+#define GNSS_SDR_PVT_REPLAY_LOG_H_
+
+#include "galileo_ephemeris.h"
+#include "galileo_iono.h"
+#include "galileo_utc_model.h"
+#include "glonass_gnav_ephemeris.h"
+#include "glonass_gnav_utc_model.h"
+#include "gnss_synchro.h"
+#include "gps_cnav_ephemeris.h"
+#include "gps_cnav_iono.h"
+#include "gps_cnav_utc_model.h"
+#include "gps_ephemeris.h"
+#include "gps_iono.h"
+#include "gps_utc_model.h"
+#include <boost/archive/binary_oarchive.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+class rtklib_solver;
+
+/*!
+ * File layout: a header with PVT_REPLAY_LOG_MAGIC, PVT_REPLAY_LOG_VERSION,
+ * sizeof(Gnss_Synchro) and the number of channels (uint32 each), followed
+ * by records made of their type, the size of their payload (uint32 each)
+ * and the payload. An epoch carries the Gnss_Synchro of its valid channels
+ * as they are in memory, navigation data carry a boost binary archive of
+ * the object. Like the binary stores, the log uses the byte order and the
+ * class layouts of the machine that wrote it.
+ */
+const uint32_t PVT_REPLAY_LOG_MAGIC = 0x50525347;  // "GSRP" in little-endian order
+const uint32_t PVT_REPLAY_LOG_VERSION = 1;
+
+enum Pvt_Replay_Record_Type : uint32_t
+{
+    PVT_REPLAY_NONE = 0,
+    PVT_REPLAY_EPOCH,
+    PVT_REPLAY_GPS_EPHEMERIS,
+    PVT_REPLAY_GPS_IONO,
+    PVT_REPLAY_GPS_UTC_MODEL,
+    PVT_REPLAY_GPS_CNAV_EPHEMERIS,
+    PVT_REPLAY_GPS_CNAV_IONO,
+    PVT_REPLAY_GPS_CNAV_UTC_MODEL,
+    PVT_REPLAY_GALILEO_EPHEMERIS,
+    PVT_REPLAY_GALILEO_IONO,
+    PVT_REPLAY_GALILEO_UTC_MODEL,
+    PVT_REPLAY_GLONASS_GNAV_EPHEMERIS,
+    PVT_REPLAY_GLONASS_GNAV_UTC_MODEL
+};
+
+/*!
+ * \brief Record type of each kind of navigation data used by the solver.
+ * Other telemetry (almanacs) is not logged.
+ */
+template <class T>
+struct Pvt_Replay_Navigation_Record
+{
+    static const uint32_t type = PVT_REPLAY_NONE;
+};
+
+#define PVT_REPLAY_NAVIGATION_RECORD(T, record_type) \
+    template <>                                      \
+    struct Pvt_Replay_Navigation_Record<T>           \
+    {                                                \
+        static const uint32_t type = record_type;    \
+    };
+
+PVT_REPLAY_NAVIGATION_RECORD(Gps_Ephemeris, PVT_REPLAY_GPS_EPHEMERIS)
+PVT_REPLAY_NAVIGATION_RECORD(Gps_Iono, PVT_REPLAY_GPS_IONO)
+PVT_REPLAY_NAVIGATION_RECORD(Gps_Utc_Model, PVT_REPLAY_GPS_UTC_MODEL)
+PVT_REPLAY_NAVIGATION_RECORD(Gps_CNAV_Ephemeris, PVT_REPLAY_GPS_CNAV_EPHEMERIS)
+PVT_REPLAY_NAVIGATION_RECORD(Gps_CNAV_Iono, PVT_REPLAY_GPS_CNAV_IONO)
+PVT_REPLAY_NAVIGATION_RECORD(Gps_CNAV_Utc_Model, PVT_REPLAY_GPS_CNAV_UTC_MODEL)
+PVT_REPLAY_NAVIGATION_RECORD(Galileo_Ephemeris, PVT_REPLAY_GALILEO_EPHEMERIS)
+PVT_REPLAY_NAVIGATION_RECORD(Galileo_Iono, PVT_REPLAY_GALILEO_IONO)
+PVT_REPLAY_NAVIGATION_RECORD(Galileo_Utc_Model, PVT_REPLAY_GALILEO_UTC_MODEL)
+PVT_REPLAY_NAVIGATION_RECORD(Glonass_Gnav_Ephemeris, PVT_REPLAY_GLONASS_GNAV_EPHEMERIS)
+PVT_REPLAY_NAVIGATION_RECORD(Glonass_Gnav_Utc_Model, PVT_REPLAY_GLONASS_GNAV_UTC_MODEL)
+
+#undef PVT_REPLAY_NAVIGATION_RECORD
+
+
+/*!
+ * \brief Writes the replay log of a PVT block
+ */
+class Pvt_Replay_Log_Writer
+{
+public:
+    Pvt_Replay_Log_Writer(const std::string& file_name, uint32_t nchannels);
+    ~Pvt_Replay_Log_Writer();
+
+    bool is_open() const { return d_file.is_open(); }
+
+    /*!
+     * \brief Logs the observables of the channels listed in valid_channels
+     */
+    void write_epoch(const std::vector<Gnss_Synchro>& gnss_observables, const std::vector<uint32_t>& valid_channels);
+
+    /*!
+     * \brief Logs navigation data, if it is of a kind used by the solver
+     */
+    template <class T>
+    void write_navigation(const T& data)
+    {
+        write_navigation(data, std::integral_constant<bool, Pvt_Replay_Navigation_Record<T>::type != PVT_REPLAY_NONE>());
+    }
+
+    /*!
+     * \brief Logs a record as read by Pvt_Replay_Log_Reader::next_record
+     */
+    void write_record(uint32_t type, const char* payload, size_t size);
+
+private:
+    template <class T>
+    void write_navigation(const T& data, std::true_type)
+    {
+        if (!d_file.is_open())
+            {
+                return;
+            }
+        d_archive_buffer.str(std::string());
+        {
+            boost::archive::binary_oarchive archive(d_archive_buffer, boost::archive::no_header);
+            archive << data;
+        }
+        const std::string payload = d_archive_buffer.str();
+        write_record(Pvt_Replay_Navigation_Record<T>::type, payload.data(), payload.size());
+    }
+
+    template <class T>
+    void write_navigation(const T&, std::false_type)
+    {
+    }
+
+    std::ofstream d_file;
+    std::ostringstream d_archive_buffer;
+    std::vector<Gnss_Synchro> d_epoch;
+};
+
+
+/*!
+ * \brief Reads a replay log, which is memory-mapped. Each reader keeps its
+ * own position, so several solvers can replay the same log in parallel.
+ */
+class Pvt_Replay_Log_Reader
+{
+public:
+    explicit Pvt_Replay_Log_Reader(const std::string& file_name);
+    ~Pvt_Replay_Log_Reader();
+
+    bool is_open() const { return d_data != nullptr; }
+    uint32_t nchannels() const { return d_nchannels; }
+    size_t size() const { return d_size; }
+
+    /*!
+     * \brief Hands the navigation data found up to the next epoch to
+     * \p solver, as the PVT block does when they arrive, and returns the
+     * observables of that epoch. The valid channels are 0 to the size of
+     * \p gnss_observables minus one.
+     * \return false at the end of the log
+     */
+    bool next_epoch(rtklib_solver& solver, std::vector<Gnss_Synchro>& gnss_observables, std::vector<uint32_t>& valid_channels);
+
+    /*!
+     * \brief Returns the next record, whatever its type. \p payload points
+     * into the mapping of the log and is valid while the reader exists.
+     * \return false at the end of the log
+     */
+    bool next_record(uint32_t& type, const char*& payload, size_t& size);
+
+private:
+    bool apply_navigation(rtklib_solver& solver, uint32_t type, const char* payload, size_t size);
+
+    const char* d_data;
+    size_t d_size;
+    size_t d_offset;
+    uint32_t d_nchannels;
+};
+
+
+/*!
+ * \brief Counters of merge_pvt_replay_logs
+ */
+struct Pvt_Replay_Merge_Statistics
+{
+    uint64_t epochs = 0;             //!< epochs in the merged log
+    uint64_t overlap_epochs = 0;     //!< epochs dropped because an earlier segment already had them
+    uint32_t seams = 0;              //!< joins between consecutive segments
+    uint32_t aligned_signals = 0;    //!< carrier phases made continuous across a seam
+    uint32_t unaligned_signals = 0;  //!< carrier phases left with a jump at a seam
+};
+
+/*!
+ * \brief Joins the replay logs of consecutive, overlapping time segments of
+ * one recording, each processed by its own receiver, into \p output_file.
+ *
+ * The segments are given in time order. Each one is taken from the end of
+ * the previous one: its epochs up to the last epoch already written are
+ * dropped, so the overlap should be long enough for the receiver of the
+ * later segment to have its solution ready by then (tracking, telemetry and
+ * ephemeris). At the common epoch, the carrier phase of each signal tracked
+ * by both receivers is shifted by the whole number of cycles that makes it
+ * continuous, as is the sample counter, so a solver replaying the merged log
+ * sees no cycle slip at the seam.
+ * \return false if a log cannot be read or written
+ */
+bool merge_pvt_replay_logs(const std::vector<std::string>& segment_files, const std::string& output_file, Pvt_Replay_Merge_Statistics& statistics);
+
+#endif
@@ -33,6 +33,7 @@
 #include "GPS_L1_CA.h"
 #include "geofunctions.h"
 #include <glog/logging.h>
+#include <algorithm>
 #include <exception>
 
 
@@ -52,7 +53,10 @@ Pvt_Solution::Pvt_Solution()
     d_flag_averaging = false;
     b_valid_position = false;
     d_averaging_depth = 0;
+    d_updates_since_resum = 0;
+    d_smoothing_factor = 0.0;
     d_valid_observations = 0;
+    d_latency_s = 0.0;
     d_rx_pos = arma::zeros(3, 1);
     d_rx_dt_s = 0.0;
 }
@@ -253,45 +257,92 @@ void Pvt_Solution::set_averaging_flag(bool flag)
 }
 
 
+void Pvt_Solution::set_averaging_smoothing(double alpha)
+{
+    d_smoothing_factor = (alpha > 0.0 and alpha <= 1.0) ? alpha : 0.0;
+}
+
+
+void Pvt_Solution::reset_running_sums()
+{
+    d_sum_latitude_d = Running_Sum();
+    d_sum_longitude_d = Running_Sum();
+    d_sum_height_m = Running_Sum();
+    for (unsigned int i = 0; i < d_hist_longitude_d.size(); i++)
+        {
+            d_sum_latitude_d.add(d_hist_latitude_d[i]);
+            d_sum_longitude_d.add(d_hist_longitude_d[i]);
+            d_sum_height_m.add(d_hist_height_m[i]);
+        }
+    d_updates_since_resum = 0;
+}
+
+
 void Pvt_Solution::perform_pos_averaging()
 {
     // MOVING AVERAGE PVT
     bool avg = d_flag_averaging;
     if (avg == true)
         {
-            if (d_hist_longitude_d.size() == static_cast<unsigned int>(d_averaging_depth))
+            const auto depth = static_cast<unsigned int>(std::max(d_averaging_depth, 1));
+            if (d_smoothing_factor > 0.0)
+                {
+                    // exponential smoothing, the window only counts the positions seen
+                    if (d_hist_longitude_d.empty())
+                        {
+                            d_avg_latitude_d = d_latitude_d;
+                            d_avg_longitude_d = d_longitude_d;
+                            d_avg_height_m = d_height_m;
+                        }
+                    else
+                        {
+                            d_avg_latitude_d += d_smoothing_factor * (d_latitude_d - d_avg_latitude_d);
+                            d_avg_longitude_d += d_smoothing_factor * (d_longitude_d - d_avg_longitude_d);
+                            d_avg_height_m += d_smoothing_factor * (d_height_m - d_avg_height_m);
+                        }
+                    if (d_hist_longitude_d.size() < depth)
+                        {
+                            d_hist_longitude_d.push_front(d_longitude_d);
+                            d_hist_latitude_d.push_front(d_latitude_d);
+                            d_hist_height_m.push_front(d_height_m);
+                        }
+                    b_valid_position = d_hist_longitude_d.size() == depth;
+                    return;
+                }
+
+            const bool window_full = d_hist_longitude_d.size() >= depth;
+            while (d_hist_longitude_d.size() >= depth)
                 {
                     // Pop oldest value
+                    d_sum_latitude_d.add(-d_hist_latitude_d.back());
+                    d_sum_longitude_d.add(-d_hist_longitude_d.back());
+                    d_sum_height_m.add(-d_hist_height_m.back());
                     d_hist_longitude_d.pop_back();
                     d_hist_latitude_d.pop_back();
                     d_hist_height_m.pop_back();
-                    // Push new values
-                    d_hist_longitude_d.push_front(d_longitude_d);
-                    d_hist_latitude_d.push_front(d_latitude_d);
-                    d_hist_height_m.push_front(d_height_m);
-
-                    d_avg_latitude_d = 0.0;
-                    d_avg_longitude_d = 0.0;
-                    d_avg_height_m = 0.0;
-                    for (unsigned int i = 0; i < d_hist_longitude_d.size(); i++)
-                        {
-                            d_avg_latitude_d = d_avg_latitude_d + d_hist_latitude_d.at(i);
-                            d_avg_longitude_d = d_avg_longitude_d + d_hist_longitude_d.at(i);
-                            d_avg_height_m = d_avg_height_m + d_hist_height_m.at(i);
-                        }
-                    d_avg_latitude_d = d_avg_latitude_d / static_cast<double>(d_averaging_depth);
-                    d_avg_longitude_d = d_avg_longitude_d / static_cast<double>(d_averaging_depth);
-                    d_avg_height_m = d_avg_height_m / static_cast<double>(d_averaging_depth);
+                }
+            // Push new values
+            d_hist_longitude_d.push_front(d_longitude_d);
+            d_hist_latitude_d.push_front(d_latitude_d);
+            d_hist_height_m.push_front(d_height_m);
+            d_sum_latitude_d.add(d_latitude_d);
+            d_sum_longitude_d.add(d_longitude_d);
+            d_sum_height_m.add(d_height_m);
+            // the removals make the rounding errors drift: start again from the window once per window length
+            if (++d_updates_since_resum >= static_cast<int>(depth))
+                {
+                    reset_running_sums();
+                }
+
+            if (window_full)
+                {
+                    d_avg_latitude_d = d_sum_latitude_d.sum / static_cast<double>(depth);
+                    d_avg_longitude_d = d_sum_longitude_d.sum / static_cast<double>(depth);
+                    d_avg_height_m = d_sum_height_m.sum / static_cast<double>(depth);
                     b_valid_position = true;
                 }
             else
                 {
-                    //int current_depth=d_hist_longitude_d.size();
-                    // Push new values
-                    d_hist_longitude_d.push_front(d_longitude_d);
-                    d_hist_latitude_d.push_front(d_latitude_d);
-                    d_hist_height_m.push_front(d_height_m);
-
                     d_avg_latitude_d = d_latitude_d;
                     d_avg_longitude_d = d_longitude_d;
                     d_avg_height_m = d_height_m;
@@ -432,3 +483,15 @@ void Pvt_Solution::set_num_valid_observations(int num)
 {
     d_valid_observations = num;
 }
+
+
+double Pvt_Solution::get_latency_s() const
+{
+    return d_latency_s;
+}
+
+
+void Pvt_Solution::set_latency_s(double latency_s)
+{
+    d_latency_s = latency_s;
+}
@@ -68,9 +68,30 @@ private:
     bool d_flag_averaging;
     int d_averaging_depth;  // Length of averaging window
 
+    // Kahan-compensated running sum of the values in the averaging window
+    struct Running_Sum
+    {
+        double sum = 0.0;
+        double compensation = 0.0;
+        void add(double value)
+        {
+            const double y = value - compensation;
+            const double t = sum + y;
+            compensation = (t - sum) - y;
+            sum = t;
+        }
+    };
+    Running_Sum d_sum_latitude_d;
+    Running_Sum d_sum_longitude_d;
+    Running_Sum d_sum_height_m;
+    int d_updates_since_resum;  // the sums are recomputed from the window once per window length
+    double d_smoothing_factor;  // exponential smoothing instead of a window if > 0
+    void reset_running_sums();
+
     arma::vec d_rx_pos;
     boost::posix_time::ptime d_position_UTC_time;
     int d_valid_observations;
+    double d_latency_s;
 
 public:
     Pvt_Solution();
@@ -104,9 +125,18 @@ public:
     int get_num_valid_observations() const;    //!< Get the number of valid pseudorange observations (valid satellites)
     void set_num_valid_observations(int num);  //!< Set the number of valid pseudorange observations (valid satellites)
 
+    double get_latency_s() const;          //!< Get the latency from the arrival of the samples to the solution [s], 0 if unknown
+    void set_latency_s(double latency_s);  //!< Set the latency from the arrival of the samples to the solution [s]
+
     //averaging
     void perform_pos_averaging();
     void set_averaging_depth(int depth);  //!< Set length of averaging window
+    /*!
+     * \brief Replaces the moving average by exponential smoothing with factor
+     * \p alpha in (0, 1] (weight of the new position). The position is valid
+     * once the averaging depth is reached. 0 goes back to the moving average.
+     */
+    void set_averaging_smoothing(double alpha);
     bool is_averaging() const;
     void set_averaging_flag(bool flag);
 
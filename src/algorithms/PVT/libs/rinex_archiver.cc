@@ -0,0 +1,188 @@
+/*!
+ * \file rinex_archiver.cc
+ * \brief Thread that closes and compresses the RINEX files of the PVT block.
+ *
+ * -------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2018  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *          Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------
+ */
+
+#include "rinex_archiver.h"
+#include <glog/logging.h>
+#include <cstdio>
+#include <exception>
+#include <fstream>
+#include <utility>
+#include <vector>
+#if HAVE_ZLIB
+#include <zlib.h>
+#endif
+
+
+Rinex_Archiver::Rinex_Archiver(bool compress)
+{
+#if HAVE_ZLIB
+    d_compress = compress;
+#else
+    if (compress)
+        {
+            LOG(WARNING) << "GNSS-SDR was built without zlib, the RINEX files will not be compressed";
+        }
+    d_compress = false;
+#endif
+    d_stop = false;
+    d_thread = std::thread(&Rinex_Archiver::run, this);
+}
+
+
+Rinex_Archiver::~Rinex_Archiver()
+{
+    {
+        std::lock_guard<std::mutex> lock(d_mutex);
+        d_stop = true;
+    }
+    d_cond.notify_all();
+    if (d_thread.joinable())
+        {
+            d_thread.join();
+        }
+}
+
+
+void Rinex_Archiver::release(std::shared_ptr<Rinex_Printer> printer)
+{
+    if (!printer)
+        {
+            return;
+        }
+    {
+        std::lock_guard<std::mutex> lock(d_mutex);
+        d_queue.push_back(std::move(printer));
+    }
+    d_cond.notify_one();
+}
+
+
+void Rinex_Archiver::run()
+{
+    while (true)
+        {
+            std::shared_ptr<Rinex_Printer> printer;
+            {
+                std::unique_lock<std::mutex> lock(d_mutex);
+                d_cond.wait(lock, [this] { return d_stop or !d_queue.empty(); });
+                if (d_queue.empty())
+                    {
+                        return;  // stopped, and everything has been archived
+                    }
+                printer = std::move(d_queue.front());
+                d_queue.pop_front();
+            }
+            try
+                {
+                    archive(std::move(printer));
+                }
+            catch (const std::exception& e)
+                {
+                    LOG(WARNING) << "Exception archiving the RINEX files " << e.what();
+                }
+        }
+}
+
+
+void Rinex_Archiver::archive(std::shared_ptr<Rinex_Printer> printer)
+{
+    const std::vector<std::string> filenames = {printer->obsfilename,
+        printer->navfilename,
+        printer->sbsfilename,
+        printer->navGalfilename,
+        printer->navGlofilename,
+        printer->navMixfilename};
+
+    // the destructor closes the files, and removes the empty ones
+    printer.reset();
+
+    if (!d_compress)
+        {
+            return;
+        }
+    for (const auto& filename : filenames)
+        {
+            std::ifstream exists(filename);
+            if (!exists.good())
+                {
+                    continue;
+                }
+            exists.close();
+            if (compress_file(filename))
+                {
+                    if (std::remove(filename.c_str()) != 0)
+                        {
+                            LOG(WARNING) << "Error deleting " << filename << " after compressing it";
+                        }
+                }
+        }
+}
+
+
+bool Rinex_Archiver::compress_file(const std::string& filename)
+{
+#if HAVE_ZLIB
+    std::ifstream in(filename, std::ios::in | std::ios::binary);
+    gzFile out = gzopen((filename + ".gz").c_str(), "wb6");
+    if (!in.is_open() or out == nullptr)
+        {
+            LOG(WARNING) << "Unable to compress the RINEX file " << filename;
+            if (out != nullptr)
+                {
+                    gzclose(out);
+                }
+            return false;
+        }
+    std::vector<char> buffer(1 << 16);
+    bool ok = true;
+    while (in)
+        {
+            in.read(buffer.data(), buffer.size());
+            const std::streamsize bytes = in.gcount();
+            if (bytes > 0 and gzwrite(out, buffer.data(), static_cast<unsigned>(bytes)) != static_cast<int>(bytes))
+                {
+                    ok = false;
+                    break;
+                }
+        }
+    if (gzclose(out) != Z_OK)
+        {
+            ok = false;
+        }
+    if (!ok)
+        {
+            LOG(WARNING) << "Error compressing the RINEX file " << filename;
+            std::remove((filename + ".gz").c_str());
+        }
+    return ok;
+#else
+    LOG(WARNING) << "Unable to compress the RINEX file " << filename << ", zlib not available";
+    return false;
+#endif
+}
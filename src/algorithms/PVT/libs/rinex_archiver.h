@@ -0,0 +1,79 @@
+/*!
+ * \file rinex_archiver.h
+ * \brief Thread that closes and compresses the RINEX files of the PVT block.
+ *
+ * When the RINEX files are rotated, the PVT block hands the old
+ * Rinex_Printer to this thread, which closes its files and optionally
+ * gzips them, so the signal processing chain does not wait for the disk.
+ *
+ * -------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2018  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *          Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_RINEX_ARCHIVER_H_
+#define GNSS_SDR_RINEX_ARCHIVER_H_
+
+#include "rinex_printer.h"
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+
+
+/*!
+ * \brief Closes released RINEX printers from its own thread, and gzips
+ * their files if requested.
+ */
+class Rinex_Archiver
+{
+public:
+    explicit Rinex_Archiver(bool compress);
+
+    /*!
+     * \brief Archives the printers still queued and stops the thread.
+     */
+    ~Rinex_Archiver();
+
+    /*!
+     * \brief Queues a printer to be closed. The caller must not keep other
+     * references to it, so its files are closed by this thread.
+     */
+    void release(std::shared_ptr<Rinex_Printer> printer);
+
+private:
+    void run();
+    void archive(std::shared_ptr<Rinex_Printer> printer);
+    static bool compress_file(const std::string& filename);
+
+    bool d_compress;
+    std::deque<std::shared_ptr<Rinex_Printer>> d_queue;
+    std::mutex d_mutex;
+    std::condition_variable d_cond;
+    bool d_stop;
+    std::thread d_thread;
+};
+
+#endif
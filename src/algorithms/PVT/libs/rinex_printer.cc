@@ -254,6 +254,54 @@ void Rinex_Printer::lengthCheck(const std::string& line)
 }
 
 
+void Rinex_Printer::rewrite_header(std::fstream& out, const std::string& filename, const std::vector<std::string>& header, int64_t header_bytes)
+{
+    std::string new_header;
+    for (const auto& line : header)
+        {
+            new_header += line;
+            new_header += '\n';
+        }
+    out.close();
+
+    std::string body;
+    if (header_bytes < 0)
+        {
+            // END OF HEADER not found, the whole file is the header
+            if (!header.empty() and header.back().empty())
+                {
+                    new_header.pop_back();
+                }
+        }
+    else if (new_header.size() == static_cast<uint64_t>(header_bytes))
+        {
+            // same length: patch the header in place, the body is not touched
+            std::fstream patch(filename, std::ios::in | std::ios::out | std::ios::binary);
+            patch.seekp(0);
+            patch.write(new_header.data(), new_header.size());
+            patch.close();
+            out.open(filename, std::ios::out | std::ios::in | std::ios::app);
+            out.seekp(0, std::ios_base::end);
+            return;
+        }
+    else
+        {
+            // the header changed its length: the body has to be moved
+            std::ifstream in(filename, std::ios::in | std::ios::binary);
+            in.seekg(header_bytes);
+            body.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+            in.close();
+        }
+
+    std::ofstream rewritten(filename, std::ios::out | std::ios::trunc | std::ios::binary);
+    rewritten.write(new_header.data(), new_header.size());
+    rewritten.write(body.data(), body.size());
+    rewritten.close();
+    out.open(filename, std::ios::out | std::ios::in | std::ios::app);
+    out.seekp(0, std::ios_base::end);
+}
+
+
 std::string Rinex_Printer::createFilename(const std::string& type)
 {
     const std::string stationName = "GSDR";  // 4-character station name designator
@@ -1658,381 +1706,193 @@ void Rinex_Printer::update_nav_header(std::fstream& out, const Glonass_Gnav_Utc_
     std::vector<std::string> data;
     std::string line_aux;
 
-    int64_t pos = out.tellp();
     out.seekp(0);
     data.clear();
 
     bool no_more_finds = false;
     std::string line_str;
 
-    while (!out.eof())
+    // only the header is read, it ends at END OF HEADER
+    while (!no_more_finds and !out.eof())
         {
             std::getline(out, line_str);
 
-            if (!no_more_finds)
-                {
-                    line_aux.clear();
+            line_aux.clear();
 
-                    if ((line_str.find("GLUT", 0) != std::string::npos) && (line_str.find("TIME SYSTEM CORR", 59) != std::string::npos))
-                        {
-                            line_aux += std::string("GLUT");
-                            line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(glonass_gnav_utc_model.d_tau_c, 16, 2), 18);
-                            line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(0.0, 15, 2), 16);
-                            line_aux += Rinex_Printer::rightJustify(std::to_string(0.0), 7);
-                            line_aux += Rinex_Printer::rightJustify(std::to_string(0.0), 5);
-                            line_aux += std::string(10, ' ');
-                            line_aux += Rinex_Printer::leftJustify("TIME SYSTEM CORR", 20);
-                            data.push_back(line_aux);
-                        }
-                    else if ((line_str.find("GLGP", 0) != std::string::npos) && (line_str.find("TIME SYSTEM CORR", 59) != std::string::npos))
-                        {
-                            line_aux += std::string("GLGP");
-                            line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(glonass_gnav_utc_model.d_tau_gps, 16, 2), 18);
-                            line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(0.0, 15, 2), 16);
-                            line_aux += Rinex_Printer::rightJustify(std::to_string(0.0), 7);
-                            line_aux += Rinex_Printer::rightJustify(std::to_string(0.0), 5);
-                            line_aux += std::string(10, ' ');
-                            line_aux += Rinex_Printer::leftJustify("TIME SYSTEM CORR", 20);
-                            data.push_back(line_aux);
-                        }
-                    else if (line_str.find("END OF HEADER", 59) != std::string::npos)
-                        {
-                            data.push_back(line_str);
-                            no_more_finds = true;
-                        }
-                    else
-                        {
-                            data.push_back(line_str);
-                        }
+            if ((line_str.find("GLUT", 0) != std::string::npos) && (line_str.find("TIME SYSTEM CORR", 59) != std::string::npos))
+                {
+                    line_aux += std::string("GLUT");
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(glonass_gnav_utc_model.d_tau_c, 16, 2), 18);
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(0.0, 15, 2), 16);
+                    line_aux += Rinex_Printer::rightJustify(std::to_string(0.0), 7);
+                    line_aux += Rinex_Printer::rightJustify(std::to_string(0.0), 5);
+                    line_aux += std::string(10, ' ');
+                    line_aux += Rinex_Printer::leftJustify("TIME SYSTEM CORR", 20);
+                    data.push_back(line_aux);
                 }
-            else
+            else if ((line_str.find("GLGP", 0) != std::string::npos) && (line_str.find("TIME SYSTEM CORR", 59) != std::string::npos))
                 {
-                    data.push_back(line_str);
+                    line_aux += std::string("GLGP");
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(glonass_gnav_utc_model.d_tau_gps, 16, 2), 18);
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(0.0, 15, 2), 16);
+                    line_aux += Rinex_Printer::rightJustify(std::to_string(0.0), 7);
+                    line_aux += Rinex_Printer::rightJustify(std::to_string(0.0), 5);
+                    line_aux += std::string(10, ' ');
+                    line_aux += Rinex_Printer::leftJustify("TIME SYSTEM CORR", 20);
+                    data.push_back(line_aux);
                 }
-        }
-
-    out.close();
-    out.open(navGlofilename, std::ios::out | std::ios::trunc);
-    out.seekp(0);
-    for (int32_t i = 0; i < static_cast<int32_t>(data.size()) - 1; i++)
-        {
-            out << data[i] << std::endl;
-        }
-    out.close();
-    out.open(navGlofilename, std::ios::out | std::ios::app);
-    out.seekp(pos);
-    std::cout << "The RINEX Navigation file header has been updated with UTC info." << std::endl;
-}
-
-
-void Rinex_Printer::update_nav_header(std::fstream& out, const Galileo_Iono& galileo_iono, const Galileo_Utc_Model& utc_model)
-{
-    std::vector<std::string> data;
-    std::string line_aux;
-
-    int64_t pos = out.tellp();
-    out.seekp(0);
-    data.clear();
-
-    bool no_more_finds = false;
-    std::string line_str;
-
-    while (!out.eof())
-        {
-            std::getline(out, line_str);
-
-            if (!no_more_finds)
+            else if (line_str.find("END OF HEADER", 59) != std::string::npos)
                 {
-                    line_aux.clear();
-
-                    if ((line_str.find("GAL", 0) != std::string::npos) && (line_str.find("IONOSPHERIC CORR", 59) != std::string::npos))
-                        {
-                            line_aux += std::string("GAL ");
-                            line_aux += std::string(1, ' ');
-                            line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(galileo_iono.ai0_5, 10, 2), 12);
-                            line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(galileo_iono.ai1_5, 10, 2), 12);
-                            line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(galileo_iono.ai2_5, 10, 2), 12);
-                            double zero = 0.0;
-                            line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(zero, 10, 2), 12);
-                            line_aux += std::string(7, ' ');
-                            line_aux += Rinex_Printer::leftJustify("IONOSPHERIC CORR", 20);
-                            data.push_back(line_aux);
-                        }
-                    else if ((line_str.find("GAUT", 0) != std::string::npos) && (line_str.find("TIME SYSTEM CORR", 59) != std::string::npos))
-                        {
-                            line_aux += std::string("GAUT");
-                            line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(utc_model.A0_6, 16, 2), 18);
-                            line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(utc_model.A1_6, 15, 2), 16);
-                            line_aux += Rinex_Printer::rightJustify(std::to_string(utc_model.t0t_6), 7);
-                            line_aux += Rinex_Printer::rightJustify(std::to_string(utc_model.WNot_6), 5);
-                            line_aux += std::string(10, ' ');
-                            line_aux += Rinex_Printer::leftJustify("TIME SYSTEM CORR", 20);
-                            data.push_back(line_aux);
-                        }
-                    else if ((line_str.find("GPGA", 0) != std::string::npos) && (line_str.find("TIME SYSTEM CORR", 59) != std::string::npos))
-                        {
-                            line_aux += std::string("GPGA");
-                            line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(utc_model.A_0G_10, 16, 2), 18);
-                            line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(utc_model.A_1G_10, 15, 2), 16);
-                            line_aux += Rinex_Printer::rightJustify(std::to_string(utc_model.t_0G_10), 7);
-                            line_aux += Rinex_Printer::rightJustify(std::to_string(utc_model.WN_0G_10), 5);
-                            line_aux += std::string(10, ' ');
-                            line_aux += Rinex_Printer::leftJustify("TIME SYSTEM CORR", 20);
-                            data.push_back(line_aux);
-                        }
-                    else if (line_str.find("LEAP SECONDS", 59) != std::string::npos)
-                        {
-                            line_aux += Rinex_Printer::rightJustify(std::to_string(utc_model.Delta_tLS_6), 6);
-                            line_aux += Rinex_Printer::rightJustify(std::to_string(utc_model.Delta_tLSF_6), 6);
-                            line_aux += Rinex_Printer::rightJustify(std::to_string(utc_model.WN_LSF_6), 6);
-                            line_aux += Rinex_Printer::rightJustify(std::to_string(utc_model.DN_6), 6);
-                            line_aux += std::string(36, ' ');
-                            line_aux += Rinex_Printer::leftJustify("LEAP SECONDS", 20);
-                            data.push_back(line_aux);
-                        }
-                    else if (line_str.find("END OF HEADER", 59) != std::string::npos)
-                        {
-                            data.push_back(line_str);
-                            no_more_finds = true;
-                        }
-                    else
-                        {
-                            data.push_back(line_str);
-                        }
+                    data.push_back(line_str);
+                    no_more_finds = true;
                 }
             else
                 {
                     data.push_back(line_str);
                 }
         }
-
-    out.close();
-    out.open(navGalfilename, std::ios::out | std::ios::trunc);
-    out.seekp(0);
-    for (int32_t i = 0; i < static_cast<int32_t>(data.size()) - 1; i++)
-        {
-            out << data[i] << std::endl;
-        }
-    out.close();
-    out.open(navGalfilename, std::ios::out | std::ios::app);
-    out.seekp(pos);
-    std::cout << "The RINEX Navigation file header has been updated with UTC and IONO info." << std::endl;
+    int64_t header_bytes = out.tellg();
+    rewrite_header(out, navGlofilename, data, header_bytes);
+    std::cout << "The RINEX Navigation file header has been updated with UTC info." << std::endl;
 }
 
 
-void Rinex_Printer::update_nav_header(std::fstream& out, const Gps_Utc_Model& utc_model, const Gps_Iono& iono)
+void Rinex_Printer::update_nav_header(std::fstream& out, const Galileo_Iono& galileo_iono, const Galileo_Utc_Model& utc_model)
 {
     std::vector<std::string> data;
     std::string line_aux;
 
-    int64_t pos = out.tellp();
     out.seekp(0);
     data.clear();
 
     bool no_more_finds = false;
     std::string line_str;
 
-    while (!out.eof())
+    // only the header is read, it ends at END OF HEADER
+    while (!no_more_finds and !out.eof())
         {
             std::getline(out, line_str);
 
-            if (!no_more_finds)
+            line_aux.clear();
+
+            if ((line_str.find("GAL", 0) != std::string::npos) && (line_str.find("IONOSPHERIC CORR", 59) != std::string::npos))
+                {
+                    line_aux += std::string("GAL ");
+                    line_aux += std::string(1, ' ');
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(galileo_iono.ai0_5, 10, 2), 12);
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(galileo_iono.ai1_5, 10, 2), 12);
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(galileo_iono.ai2_5, 10, 2), 12);
+                    double zero = 0.0;
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(zero, 10, 2), 12);
+                    line_aux += std::string(7, ' ');
+                    line_aux += Rinex_Printer::leftJustify("IONOSPHERIC CORR", 20);
+                    data.push_back(line_aux);
+                }
+            else if ((line_str.find("GAUT", 0) != std::string::npos) && (line_str.find("TIME SYSTEM CORR", 59) != std::string::npos))
+                {
+                    line_aux += std::string("GAUT");
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(utc_model.A0_6, 16, 2), 18);
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(utc_model.A1_6, 15, 2), 16);
+                    line_aux += Rinex_Printer::rightJustify(std::to_string(utc_model.t0t_6), 7);
+                    line_aux += Rinex_Printer::rightJustify(std::to_string(utc_model.WNot_6), 5);
+                    line_aux += std::string(10, ' ');
+                    line_aux += Rinex_Printer::leftJustify("TIME SYSTEM CORR", 20);
+                    data.push_back(line_aux);
+                }
+            else if ((line_str.find("GPGA", 0) != std::string::npos) && (line_str.find("TIME SYSTEM CORR", 59) != std::string::npos))
+                {
+                    line_aux += std::string("GPGA");
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(utc_model.A_0G_10, 16, 2), 18);
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(utc_model.A_1G_10, 15, 2), 16);
+                    line_aux += Rinex_Printer::rightJustify(std::to_string(utc_model.t_0G_10), 7);
+                    line_aux += Rinex_Printer::rightJustify(std::to_string(utc_model.WN_0G_10), 5);
+                    line_aux += std::string(10, ' ');
+                    line_aux += Rinex_Printer::leftJustify("TIME SYSTEM CORR", 20);
+                    data.push_back(line_aux);
+                }
+            else if (line_str.find("LEAP SECONDS", 59) != std::string::npos)
+                {
+                    line_aux += Rinex_Printer::rightJustify(std::to_string(utc_model.Delta_tLS_6), 6);
+                    line_aux += Rinex_Printer::rightJustify(std::to_string(utc_model.Delta_tLSF_6), 6);
+                    line_aux += Rinex_Printer::rightJustify(std::to_string(utc_model.WN_LSF_6), 6);
+                    line_aux += Rinex_Printer::rightJustify(std::to_string(utc_model.DN_6), 6);
+                    line_aux += std::string(36, ' ');
+                    line_aux += Rinex_Printer::leftJustify("LEAP SECONDS", 20);
+                    data.push_back(line_aux);
+                }
+            else if (line_str.find("END OF HEADER", 59) != std::string::npos)
                 {
-                    line_aux.clear();
-
-                    if (version == 2)
-                        {
-                            if (line_str.find("ION ALPHA", 59) != std::string::npos)
-                                {
-                                    line_aux += std::string(2, ' ');
-                                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(iono.d_alpha0, 10, 2), 12);
-                                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(iono.d_alpha1, 10, 2), 12);
-                                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(iono.d_alpha2, 10, 2), 12);
-                                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(iono.d_alpha3, 10, 2), 12);
-                                    line_aux += std::string(10, ' ');
-                                    line_aux += Rinex_Printer::leftJustify("ION ALPHA", 20);
-                                    data.push_back(line_aux);
-                                }
-                            else if (line_str.find("ION BETA", 59) != std::string::npos)
-                                {
-                                    line_aux += std::string(2, ' ');
-                                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(iono.d_beta0, 10, 2), 12);
-                                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(iono.d_beta1, 10, 2), 12);
-                                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(iono.d_beta2, 10, 2), 12);
-                                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(iono.d_beta3, 10, 2), 12);
-                                    line_aux += std::string(10, ' ');
-                                    line_aux += Rinex_Printer::leftJustify("ION BETA", 20);
-                                    data.push_back(line_aux);
-                                }
-                            else if (line_str.find("DELTA-UTC", 59) != std::string::npos)
-                                {
-                                    line_aux += std::string(3, ' ');
-                                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(utc_model.d_A0, 18, 2), 19);
-                                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(utc_model.d_A1, 18, 2), 19);
-                                    line_aux += Rinex_Printer::rightJustify(std::to_string(utc_model.d_t_OT), 9);
-                                    line_aux += Rinex_Printer::rightJustify(std::to_string(utc_model.i_WN_T + 1024), 9);  // valid until 2019
-                                    line_aux += std::string(1, ' ');
-                                    line_aux += Rinex_Printer::leftJustify("DELTA-UTC: A0,A1,T,W", 20);
-                                    data.push_back(line_aux);
-                                }
-                            else if (line_str.find("LEAP SECONDS", 59) != std::string::npos)
-                                {
-                                    line_aux += Rinex_Printer::rightJustify(std::to_string(utc_model.d_DeltaT_LS), 6);
-                                    line_aux += std::string(54, ' ');
-                                    line_aux += Rinex_Printer::leftJustify("LEAP SECONDS", 20);
-                                    data.push_back(line_aux);
-                                }
-                            else if (line_str.find("END OF HEADER", 59) != std::string::npos)
-                                {
-                                    data.push_back(line_str);
-                                    no_more_finds = true;
-                                }
-                            else
-                                {
-                                    data.push_back(line_str);
-                                }
-                        }
-
-                    if (version == 3)
-                        {
-                            if (line_str.find("GPSA", 0) != std::string::npos)
-                                {
-                                    line_aux += std::string("GPSA");
-                                    line_aux += std::string(1, ' ');
-                                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(iono.d_alpha0, 10, 2), 12);
-                                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(iono.d_alpha1, 10, 2), 12);
-                                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(iono.d_alpha2, 10, 2), 12);
-                                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(iono.d_alpha3, 10, 2), 12);
-                                    line_aux += std::string(7, ' ');
-                                    line_aux += Rinex_Printer::leftJustify("IONOSPHERIC CORR", 20);
-                                    data.push_back(line_aux);
-                                }
-                            else if (line_str.find("GPSB", 0) != std::string::npos)
-                                {
-                                    line_aux += std::string("GPSB");
-                                    line_aux += std::string(1, ' ');
-                                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(iono.d_beta0, 10, 2), 12);
-                                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(iono.d_beta1, 10, 2), 12);
-                                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(iono.d_beta2, 10, 2), 12);
-                                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(iono.d_beta3, 10, 2), 12);
-                                    line_aux += std::string(7, ' ');
-                                    line_aux += Rinex_Printer::leftJustify("IONOSPHERIC CORR", 20);
-                                    data.push_back(line_aux);
-                                }
-                            else if (line_str.find("GPUT", 0) != std::string::npos)
-                                {
-                                    line_aux += std::string("GPUT");
-                                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(utc_model.d_A0, 16, 2), 18);
-                                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(utc_model.d_A1, 15, 2), 16);
-                                    line_aux += Rinex_Printer::rightJustify(std::to_string(utc_model.d_t_OT), 7);
-                                    line_aux += Rinex_Printer::rightJustify(std::to_string(utc_model.i_WN_T + 1024), 5);  // valid until 2019
-                                    line_aux += std::string(10, ' ');
-                                    line_aux += Rinex_Printer::leftJustify("TIME SYSTEM CORR", 20);
-                                    data.push_back(line_aux);
-                                }
-                            else if (line_str.find("LEAP SECONDS", 59) != std::string::npos)
-                                {
-                                    line_aux += Rinex_Printer::rightJustify(std::to_string(utc_model.d_DeltaT_LS), 6);
-                                    line_aux += Rinex_Printer::rightJustify(std::to_string(utc_model.d_DeltaT_LSF), 6);
-                                    line_aux += Rinex_Printer::rightJustify(std::to_string(utc_model.i_WN_LSF), 6);
-                                    line_aux += Rinex_Printer::rightJustify(std::to_string(utc_model.i_DN), 6);
-                                    line_aux += std::string(36, ' ');
-                                    line_aux += Rinex_Printer::leftJustify("LEAP SECONDS", 20);
-                                    data.push_back(line_aux);
-                                }
-                            else if (line_str.find("END OF HEADER", 59) != std::string::npos)
-                                {
-                                    data.push_back(line_str);
-                                    no_more_finds = true;
-                                }
-                            else
-                                {
-                                    data.push_back(line_str);
-                                }
-                        }
+                    data.push_back(line_str);
+                    no_more_finds = true;
                 }
             else
                 {
                     data.push_back(line_str);
                 }
         }
-
-    out.close();
-    out.open(navfilename, std::ios::out | std::ios::trunc);
-    out.seekp(0);
-    for (int32_t i = 0; i < static_cast<int32_t>(data.size()) - 1; i++)
-        {
-            out << data[i] << std::endl;
-        }
-    out.close();
-    out.open(navfilename, std::ios::out | std::ios::app);
-    out.seekp(pos);
+    int64_t header_bytes = out.tellg();
+    rewrite_header(out, navGalfilename, data, header_bytes);
     std::cout << "The RINEX Navigation file header has been updated with UTC and IONO info." << std::endl;
 }
 
 
-void Rinex_Printer::update_nav_header(std::fstream& out, const Gps_CNAV_Utc_Model& utc_model, const Gps_CNAV_Iono& iono)
+void Rinex_Printer::update_nav_header(std::fstream& out, const Gps_Utc_Model& utc_model, const Gps_Iono& iono)
 {
     std::vector<std::string> data;
     std::string line_aux;
 
-    int64_t pos = out.tellp();
     out.seekp(0);
     data.clear();
 
     bool no_more_finds = false;
     std::string line_str;
 
-    while (!out.eof())
+    // only the header is read, it ends at END OF HEADER
+    while (!no_more_finds and !out.eof())
         {
             std::getline(out, line_str);
 
-            if (!no_more_finds)
-                {
-                    line_aux.clear();
+            line_aux.clear();
 
-                    if (line_str.find("GPSA", 0) != std::string::npos)
+            if (version == 2)
+                {
+                    if (line_str.find("ION ALPHA", 59) != std::string::npos)
                         {
-                            line_aux += std::string("GPSA");
-                            line_aux += std::string(1, ' ');
+                            line_aux += std::string(2, ' ');
                             line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(iono.d_alpha0, 10, 2), 12);
                             line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(iono.d_alpha1, 10, 2), 12);
                             line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(iono.d_alpha2, 10, 2), 12);
                             line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(iono.d_alpha3, 10, 2), 12);
-                            line_aux += std::string(7, ' ');
-                            line_aux += Rinex_Printer::leftJustify("IONOSPHERIC CORR", 20);
+                            line_aux += std::string(10, ' ');
+                            line_aux += Rinex_Printer::leftJustify("ION ALPHA", 20);
                             data.push_back(line_aux);
                         }
-                    else if (line_str.find("GPSB", 0) != std::string::npos)
+                    else if (line_str.find("ION BETA", 59) != std::string::npos)
                         {
-                            line_aux += std::string("GPSB");
-                            line_aux += std::string(1, ' ');
+                            line_aux += std::string(2, ' ');
                             line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(iono.d_beta0, 10, 2), 12);
                             line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(iono.d_beta1, 10, 2), 12);
                             line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(iono.d_beta2, 10, 2), 12);
                             line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(iono.d_beta3, 10, 2), 12);
-                            line_aux += std::string(7, ' ');
-                            line_aux += Rinex_Printer::leftJustify("IONOSPHERIC CORR", 20);
+                            line_aux += std::string(10, ' ');
+                            line_aux += Rinex_Printer::leftJustify("ION BETA", 20);
                             data.push_back(line_aux);
                         }
-                    else if (line_str.find("GPUT", 0) != std::string::npos)
+                    else if (line_str.find("DELTA-UTC", 59) != std::string::npos)
                         {
-                            line_aux += std::string("GPUT");
-                            line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(utc_model.d_A0, 16, 2), 18);
-                            line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(utc_model.d_A1, 15, 2), 16);
-                            line_aux += Rinex_Printer::rightJustify(std::to_string(utc_model.d_t_OT), 7);
-                            line_aux += Rinex_Printer::rightJustify(std::to_string(utc_model.i_WN_T + 1024), 5);  // valid until 2019
-                            line_aux += std::string(10, ' ');
-                            line_aux += Rinex_Printer::leftJustify("TIME SYSTEM CORR", 20);
+                            line_aux += std::string(3, ' ');
+                            line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(utc_model.d_A0, 18, 2), 19);
+                            line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(utc_model.d_A1, 18, 2), 19);
+                            line_aux += Rinex_Printer::rightJustify(std::to_string(utc_model.d_t_OT), 9);
+                            line_aux += Rinex_Printer::rightJustify(std::to_string(utc_model.i_WN_T + 1024), 9);  // valid until 2019
+                            line_aux += std::string(1, ' ');
+                            line_aux += Rinex_Printer::leftJustify("DELTA-UTC: A0,A1,T,W", 20);
                             data.push_back(line_aux);
                         }
                     else if (line_str.find("LEAP SECONDS", 59) != std::string::npos)
                         {
                             line_aux += Rinex_Printer::rightJustify(std::to_string(utc_model.d_DeltaT_LS), 6);
-                            line_aux += Rinex_Printer::rightJustify(std::to_string(utc_model.d_DeltaT_LSF), 6);
-                            line_aux += Rinex_Printer::rightJustify(std::to_string(utc_model.i_WN_LSF), 6);
-                            line_aux += Rinex_Printer::rightJustify(std::to_string(utc_model.i_DN), 6);
-                            line_aux += std::string(36, ' ');
+                            line_aux += std::string(54, ' ');
                             line_aux += Rinex_Printer::leftJustify("LEAP SECONDS", 20);
                             data.push_back(line_aux);
                         }
@@ -2046,59 +1906,10 @@ void Rinex_Printer::update_nav_header(std::fstream& out, const Gps_CNAV_Utc_Mode
                             data.push_back(line_str);
                         }
                 }
-            else
-                {
-                    data.push_back(line_str);
-                }
-        }
-
-    out.close();
-    out.open(navfilename, std::ios::out | std::ios::trunc);
-    out.seekp(0);
-    for (int32_t i = 0; i < static_cast<int32_t>(data.size()) - 1; i++)
-        {
-            out << data[i] << std::endl;
-        }
-    out.close();
-    out.open(navfilename, std::ios::out | std::ios::app);
-    out.seekp(pos);
-    std::cout << "The RINEX Navigation file header has been updated with UTC and IONO info." << std::endl;
-}
-
-
-void Rinex_Printer::update_nav_header(std::fstream& out, const Gps_CNAV_Utc_Model& utc_model, const Gps_CNAV_Iono& iono, const Galileo_Iono& galileo_iono, const Galileo_Utc_Model& galileo_utc_model)
-{
-    std::vector<std::string> data;
-    std::string line_aux;
-
-    int64_t pos = out.tellp();
-    out.seekp(0);
-    data.clear();
-
-    bool no_more_finds = false;
-    std::string line_str;
 
-    while (!out.eof())
-        {
-            std::getline(out, line_str);
-
-            if (!no_more_finds)
+            if (version == 3)
                 {
-                    line_aux.clear();
-                    if ((line_str.find("GAL", 0) != std::string::npos) && (line_str.find("IONOSPHERIC CORR", 59) != std::string::npos))
-                        {
-                            line_aux += std::string("GAL ");
-                            line_aux += std::string(1, ' ');
-                            line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(galileo_iono.ai0_5, 10, 2), 12);
-                            line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(galileo_iono.ai1_5, 10, 2), 12);
-                            line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(galileo_iono.ai2_5, 10, 2), 12);
-                            double zero = 0.0;
-                            line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(zero, 10, 2), 12);
-                            line_aux += std::string(7, ' ');
-                            line_aux += Rinex_Printer::leftJustify("IONOSPHERIC CORR", 20);
-                            data.push_back(line_aux);
-                        }
-                    else if ((line_str.find("GPSA", 0) != std::string::npos) && (line_str.find("IONOSPHERIC CORR", 59) != std::string::npos))
+                    if (line_str.find("GPSA", 0) != std::string::npos)
                         {
                             line_aux += std::string("GPSA");
                             line_aux += std::string(1, ' ');
@@ -2110,7 +1921,7 @@ void Rinex_Printer::update_nav_header(std::fstream& out, const Gps_CNAV_Utc_Mode
                             line_aux += Rinex_Printer::leftJustify("IONOSPHERIC CORR", 20);
                             data.push_back(line_aux);
                         }
-                    else if ((line_str.find("GPSB", 0) != std::string::npos) && (line_str.find("IONOSPHERIC CORR", 59) != std::string::npos))
+                    else if (line_str.find("GPSB", 0) != std::string::npos)
                         {
                             line_aux += std::string("GPSB");
                             line_aux += std::string(1, ' ');
@@ -2122,29 +1933,6 @@ void Rinex_Printer::update_nav_header(std::fstream& out, const Gps_CNAV_Utc_Mode
                             line_aux += Rinex_Printer::leftJustify("IONOSPHERIC CORR", 20);
                             data.push_back(line_aux);
                         }
-
-                    else if ((line_str.find("GAUT", 0) != std::string::npos) && (line_str.find("TIME SYSTEM CORR", 59) != std::string::npos))
-                        {
-                            line_aux += std::string("GAUT");
-                            line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(galileo_utc_model.A0_6, 16, 2), 18);
-                            line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(galileo_utc_model.A1_6, 15, 2), 16);
-                            line_aux += Rinex_Printer::rightJustify(std::to_string(galileo_utc_model.t0t_6), 7);
-                            line_aux += Rinex_Printer::rightJustify(std::to_string(galileo_utc_model.WNot_6), 5);
-                            line_aux += std::string(10, ' ');
-                            line_aux += Rinex_Printer::leftJustify("TIME SYSTEM CORR", 20);
-                            data.push_back(line_aux);
-                        }
-                    else if ((line_str.find("GPGA", 0) != std::string::npos) && (line_str.find("TIME SYSTEM CORR", 59) != std::string::npos))
-                        {
-                            line_aux += std::string("GPGA");
-                            line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(galileo_utc_model.A_0G_10, 16, 2), 18);
-                            line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(galileo_utc_model.A_1G_10, 15, 2), 16);
-                            line_aux += Rinex_Printer::rightJustify(std::to_string(galileo_utc_model.t_0G_10), 7);
-                            line_aux += Rinex_Printer::rightJustify(std::to_string(galileo_utc_model.WN_0G_10), 5);
-                            line_aux += std::string(10, ' ');
-                            line_aux += Rinex_Printer::leftJustify("TIME SYSTEM CORR", 20);
-                            data.push_back(line_aux);
-                        }
                     else if (line_str.find("GPUT", 0) != std::string::npos)
                         {
                             line_aux += std::string("GPUT");
@@ -2176,259 +1964,408 @@ void Rinex_Printer::update_nav_header(std::fstream& out, const Gps_CNAV_Utc_Mode
                             data.push_back(line_str);
                         }
                 }
-            else
-                {
-                    data.push_back(line_str);
-                }
-        }
-    out.close();
-    out.open(navfilename, std::ios::out | std::ios::trunc);
-    out.seekp(0);
-    for (int32_t i = 0; i < static_cast<int32_t>(data.size()) - 1; i++)
-        {
-            out << data[i] << std::endl;
         }
-    out.close();
-    out.open(navfilename, std::ios::out | std::ios::app);
-    out.seekp(pos);
+    int64_t header_bytes = out.tellg();
+    rewrite_header(out, navfilename, data, header_bytes);
     std::cout << "The RINEX Navigation file header has been updated with UTC and IONO info." << std::endl;
 }
 
 
-void Rinex_Printer::update_nav_header(std::fstream& out, const Gps_Iono& gps_iono, const Gps_Utc_Model& gps_utc_model, const Galileo_Iono& galileo_iono, const Galileo_Utc_Model& galileo_utc_model)
+void Rinex_Printer::update_nav_header(std::fstream& out, const Gps_CNAV_Utc_Model& utc_model, const Gps_CNAV_Iono& iono)
 {
     std::vector<std::string> data;
     std::string line_aux;
 
-    int64_t pos = out.tellp();
     out.seekp(0);
     data.clear();
 
     bool no_more_finds = false;
     std::string line_str;
 
-    while (!out.eof())
+    // only the header is read, it ends at END OF HEADER
+    while (!no_more_finds and !out.eof())
         {
             std::getline(out, line_str);
 
-            if (!no_more_finds)
+            line_aux.clear();
+
+            if (line_str.find("GPSA", 0) != std::string::npos)
+                {
+                    line_aux += std::string("GPSA");
+                    line_aux += std::string(1, ' ');
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(iono.d_alpha0, 10, 2), 12);
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(iono.d_alpha1, 10, 2), 12);
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(iono.d_alpha2, 10, 2), 12);
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(iono.d_alpha3, 10, 2), 12);
+                    line_aux += std::string(7, ' ');
+                    line_aux += Rinex_Printer::leftJustify("IONOSPHERIC CORR", 20);
+                    data.push_back(line_aux);
+                }
+            else if (line_str.find("GPSB", 0) != std::string::npos)
+                {
+                    line_aux += std::string("GPSB");
+                    line_aux += std::string(1, ' ');
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(iono.d_beta0, 10, 2), 12);
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(iono.d_beta1, 10, 2), 12);
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(iono.d_beta2, 10, 2), 12);
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(iono.d_beta3, 10, 2), 12);
+                    line_aux += std::string(7, ' ');
+                    line_aux += Rinex_Printer::leftJustify("IONOSPHERIC CORR", 20);
+                    data.push_back(line_aux);
+                }
+            else if (line_str.find("GPUT", 0) != std::string::npos)
+                {
+                    line_aux += std::string("GPUT");
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(utc_model.d_A0, 16, 2), 18);
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(utc_model.d_A1, 15, 2), 16);
+                    line_aux += Rinex_Printer::rightJustify(std::to_string(utc_model.d_t_OT), 7);
+                    line_aux += Rinex_Printer::rightJustify(std::to_string(utc_model.i_WN_T + 1024), 5);  // valid until 2019
+                    line_aux += std::string(10, ' ');
+                    line_aux += Rinex_Printer::leftJustify("TIME SYSTEM CORR", 20);
+                    data.push_back(line_aux);
+                }
+            else if (line_str.find("LEAP SECONDS", 59) != std::string::npos)
+                {
+                    line_aux += Rinex_Printer::rightJustify(std::to_string(utc_model.d_DeltaT_LS), 6);
+                    line_aux += Rinex_Printer::rightJustify(std::to_string(utc_model.d_DeltaT_LSF), 6);
+                    line_aux += Rinex_Printer::rightJustify(std::to_string(utc_model.i_WN_LSF), 6);
+                    line_aux += Rinex_Printer::rightJustify(std::to_string(utc_model.i_DN), 6);
+                    line_aux += std::string(36, ' ');
+                    line_aux += Rinex_Printer::leftJustify("LEAP SECONDS", 20);
+                    data.push_back(line_aux);
+                }
+            else if (line_str.find("END OF HEADER", 59) != std::string::npos)
                 {
-                    line_aux.clear();
-
-                    if (line_str.find("GPSA", 0) != std::string::npos)
-                        {
-                            line_aux += std::string("GPSA");
-                            line_aux += std::string(1, ' ');
-                            line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(gps_iono.d_alpha0, 10, 2), 12);
-                            line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(gps_iono.d_alpha1, 10, 2), 12);
-                            line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(gps_iono.d_alpha2, 10, 2), 12);
-                            line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(gps_iono.d_alpha3, 10, 2), 12);
-                            line_aux += std::string(7, ' ');
-                            line_aux += Rinex_Printer::leftJustify("IONOSPHERIC CORR", 20);
-                            data.push_back(line_aux);
-                        }
-                    else if ((line_str.find("GAL", 0) != std::string::npos) && (line_str.find("IONOSPHERIC CORR", 59) != std::string::npos))
-                        {
-                            line_aux += std::string("GAL ");
-                            line_aux += std::string(1, ' ');
-                            line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(galileo_iono.ai0_5, 10, 2), 12);
-                            line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(galileo_iono.ai1_5, 10, 2), 12);
-                            line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(galileo_iono.ai2_5, 10, 2), 12);
-                            double zero = 0.0;
-                            line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(zero, 10, 2), 12);
-                            line_aux += std::string(7, ' ');
-                            line_aux += Rinex_Printer::leftJustify("IONOSPHERIC CORR", 20);
-                            data.push_back(line_aux);
-                        }
-                    else if ((line_str.find("GPSB", 0) != std::string::npos) && (line_str.find("IONOSPHERIC CORR", 59) != std::string::npos))
-                        {
-                            line_aux += std::string("GPSB");
-                            line_aux += std::string(1, ' ');
-                            line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(gps_iono.d_beta0, 10, 2), 12);
-                            line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(gps_iono.d_beta1, 10, 2), 12);
-                            line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(gps_iono.d_beta2, 10, 2), 12);
-                            line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(gps_iono.d_beta3, 10, 2), 12);
-                            line_aux += std::string(7, ' ');
-                            line_aux += Rinex_Printer::leftJustify("IONOSPHERIC CORR", 20);
-                            data.push_back(line_aux);
-                        }
-                    else if ((line_str.find("GPUT", 0) != std::string::npos) && (line_str.find("TIME SYSTEM CORR", 59) != std::string::npos))
-                        {
-                            line_aux += std::string("GPUT");
-                            line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(gps_utc_model.d_A0, 16, 2), 18);
-                            line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(gps_utc_model.d_A1, 15, 2), 16);
-                            line_aux += Rinex_Printer::rightJustify(std::to_string(gps_utc_model.d_t_OT), 7);
-                            line_aux += Rinex_Printer::rightJustify(std::to_string(gps_utc_model.i_WN_T + 1024), 5);  // valid until 2019
-                            line_aux += std::string(10, ' ');
-                            line_aux += Rinex_Printer::leftJustify("TIME SYSTEM CORR", 20);
-                            data.push_back(line_aux);
-                        }
-                    else if ((line_str.find("GAUT", 0) != std::string::npos) && (line_str.find("TIME SYSTEM CORR", 59) != std::string::npos))
-                        {
-                            line_aux += std::string("GAUT");
-                            line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(galileo_utc_model.A0_6, 16, 2), 18);
-                            line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(galileo_utc_model.A1_6, 15, 2), 16);
-                            line_aux += Rinex_Printer::rightJustify(std::to_string(galileo_utc_model.t0t_6), 7);
-                            line_aux += Rinex_Printer::rightJustify(std::to_string(galileo_utc_model.WNot_6), 5);
-                            line_aux += std::string(10, ' ');
-                            line_aux += Rinex_Printer::leftJustify("TIME SYSTEM CORR", 20);
-                            data.push_back(line_aux);
-                        }
-                    else if ((line_str.find("GPGA", 0) != std::string::npos) && (line_str.find("TIME SYSTEM CORR", 59) != std::string::npos))
-                        {
-                            line_aux += std::string("GPGA");
-                            line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(galileo_utc_model.A_0G_10, 16, 2), 18);
-                            line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(galileo_utc_model.A_1G_10, 15, 2), 16);
-                            line_aux += Rinex_Printer::rightJustify(std::to_string(galileo_utc_model.t_0G_10), 7);
-                            line_aux += Rinex_Printer::rightJustify(std::to_string(galileo_utc_model.WN_0G_10), 5);
-                            line_aux += std::string(10, ' ');
-                            line_aux += Rinex_Printer::leftJustify("TIME SYSTEM CORR", 20);
-                            data.push_back(line_aux);
-                        }
-                    else if (line_str.find("LEAP SECONDS", 59) != std::string::npos)
-                        {
-                            line_aux += Rinex_Printer::rightJustify(std::to_string(gps_utc_model.d_DeltaT_LS), 6);
-                            line_aux += Rinex_Printer::rightJustify(std::to_string(gps_utc_model.d_DeltaT_LSF), 6);
-                            line_aux += Rinex_Printer::rightJustify(std::to_string(gps_utc_model.i_WN_LSF), 6);
-                            line_aux += Rinex_Printer::rightJustify(std::to_string(gps_utc_model.i_DN), 6);
-                            line_aux += std::string(36, ' ');
-                            line_aux += Rinex_Printer::leftJustify("LEAP SECONDS", 20);
-                            data.push_back(line_aux);
-                        }
-                    else if (line_str.find("END OF HEADER", 59) != std::string::npos)
-                        {
-                            data.push_back(line_str);
-                            no_more_finds = true;
-                        }
-                    else
-                        {
-                            data.push_back(line_str);
-                        }
+                    data.push_back(line_str);
+                    no_more_finds = true;
                 }
             else
                 {
                     data.push_back(line_str);
                 }
         }
-
-    out.close();
-    out.open(navMixfilename, std::ios::out | std::ios::trunc);
-    out.seekp(0);
-    for (int32_t i = 0; i < static_cast<int32_t>(data.size()) - 1; i++)
-        {
-            out << data[i] << std::endl;
-        }
-    out.close();
-    out.open(navMixfilename, std::ios::out | std::ios::app);
-    out.seekp(pos);
+    int64_t header_bytes = out.tellg();
+    rewrite_header(out, navfilename, data, header_bytes);
     std::cout << "The RINEX Navigation file header has been updated with UTC and IONO info." << std::endl;
 }
 
 
-void Rinex_Printer::update_nav_header(std::fstream& out, const Gps_Iono& gps_iono, const Gps_Utc_Model& gps_utc_model, const Glonass_Gnav_Utc_Model& glonass_gnav_utc_model, const Glonass_Gnav_Almanac& glonass_gnav_almanac)
+void Rinex_Printer::update_nav_header(std::fstream& out, const Gps_CNAV_Utc_Model& utc_model, const Gps_CNAV_Iono& iono, const Galileo_Iono& galileo_iono, const Galileo_Utc_Model& galileo_utc_model)
 {
-    if (glonass_gnav_almanac.i_satellite_freq_channel)
-        {
-        }  //Avoid compiler warning
     std::vector<std::string> data;
     std::string line_aux;
 
-    int64_t pos = out.tellp();
     out.seekp(0);
     data.clear();
 
     bool no_more_finds = false;
     std::string line_str;
 
-    while (!out.eof())
+    // only the header is read, it ends at END OF HEADER
+    while (!no_more_finds and !out.eof())
         {
             std::getline(out, line_str);
 
-            if (!no_more_finds)
+            line_aux.clear();
+            if ((line_str.find("GAL", 0) != std::string::npos) && (line_str.find("IONOSPHERIC CORR", 59) != std::string::npos))
+                {
+                    line_aux += std::string("GAL ");
+                    line_aux += std::string(1, ' ');
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(galileo_iono.ai0_5, 10, 2), 12);
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(galileo_iono.ai1_5, 10, 2), 12);
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(galileo_iono.ai2_5, 10, 2), 12);
+                    double zero = 0.0;
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(zero, 10, 2), 12);
+                    line_aux += std::string(7, ' ');
+                    line_aux += Rinex_Printer::leftJustify("IONOSPHERIC CORR", 20);
+                    data.push_back(line_aux);
+                }
+            else if ((line_str.find("GPSA", 0) != std::string::npos) && (line_str.find("IONOSPHERIC CORR", 59) != std::string::npos))
+                {
+                    line_aux += std::string("GPSA");
+                    line_aux += std::string(1, ' ');
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(iono.d_alpha0, 10, 2), 12);
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(iono.d_alpha1, 10, 2), 12);
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(iono.d_alpha2, 10, 2), 12);
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(iono.d_alpha3, 10, 2), 12);
+                    line_aux += std::string(7, ' ');
+                    line_aux += Rinex_Printer::leftJustify("IONOSPHERIC CORR", 20);
+                    data.push_back(line_aux);
+                }
+            else if ((line_str.find("GPSB", 0) != std::string::npos) && (line_str.find("IONOSPHERIC CORR", 59) != std::string::npos))
+                {
+                    line_aux += std::string("GPSB");
+                    line_aux += std::string(1, ' ');
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(iono.d_beta0, 10, 2), 12);
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(iono.d_beta1, 10, 2), 12);
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(iono.d_beta2, 10, 2), 12);
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(iono.d_beta3, 10, 2), 12);
+                    line_aux += std::string(7, ' ');
+                    line_aux += Rinex_Printer::leftJustify("IONOSPHERIC CORR", 20);
+                    data.push_back(line_aux);
+                }
+
+            else if ((line_str.find("GAUT", 0) != std::string::npos) && (line_str.find("TIME SYSTEM CORR", 59) != std::string::npos))
+                {
+                    line_aux += std::string("GAUT");
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(galileo_utc_model.A0_6, 16, 2), 18);
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(galileo_utc_model.A1_6, 15, 2), 16);
+                    line_aux += Rinex_Printer::rightJustify(std::to_string(galileo_utc_model.t0t_6), 7);
+                    line_aux += Rinex_Printer::rightJustify(std::to_string(galileo_utc_model.WNot_6), 5);
+                    line_aux += std::string(10, ' ');
+                    line_aux += Rinex_Printer::leftJustify("TIME SYSTEM CORR", 20);
+                    data.push_back(line_aux);
+                }
+            else if ((line_str.find("GPGA", 0) != std::string::npos) && (line_str.find("TIME SYSTEM CORR", 59) != std::string::npos))
+                {
+                    line_aux += std::string("GPGA");
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(galileo_utc_model.A_0G_10, 16, 2), 18);
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(galileo_utc_model.A_1G_10, 15, 2), 16);
+                    line_aux += Rinex_Printer::rightJustify(std::to_string(galileo_utc_model.t_0G_10), 7);
+                    line_aux += Rinex_Printer::rightJustify(std::to_string(galileo_utc_model.WN_0G_10), 5);
+                    line_aux += std::string(10, ' ');
+                    line_aux += Rinex_Printer::leftJustify("TIME SYSTEM CORR", 20);
+                    data.push_back(line_aux);
+                }
+            else if (line_str.find("GPUT", 0) != std::string::npos)
+                {
+                    line_aux += std::string("GPUT");
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(utc_model.d_A0, 16, 2), 18);
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(utc_model.d_A1, 15, 2), 16);
+                    line_aux += Rinex_Printer::rightJustify(std::to_string(utc_model.d_t_OT), 7);
+                    line_aux += Rinex_Printer::rightJustify(std::to_string(utc_model.i_WN_T + 1024), 5);  // valid until 2019
+                    line_aux += std::string(10, ' ');
+                    line_aux += Rinex_Printer::leftJustify("TIME SYSTEM CORR", 20);
+                    data.push_back(line_aux);
+                }
+            else if (line_str.find("LEAP SECONDS", 59) != std::string::npos)
+                {
+                    line_aux += Rinex_Printer::rightJustify(std::to_string(utc_model.d_DeltaT_LS), 6);
+                    line_aux += Rinex_Printer::rightJustify(std::to_string(utc_model.d_DeltaT_LSF), 6);
+                    line_aux += Rinex_Printer::rightJustify(std::to_string(utc_model.i_WN_LSF), 6);
+                    line_aux += Rinex_Printer::rightJustify(std::to_string(utc_model.i_DN), 6);
+                    line_aux += std::string(36, ' ');
+                    line_aux += Rinex_Printer::leftJustify("LEAP SECONDS", 20);
+                    data.push_back(line_aux);
+                }
+            else if (line_str.find("END OF HEADER", 59) != std::string::npos)
                 {
-                    line_aux.clear();
+                    data.push_back(line_str);
+                    no_more_finds = true;
+                }
+            else
+                {
+                    data.push_back(line_str);
+                }
+        }
+    int64_t header_bytes = out.tellg();
+    rewrite_header(out, navfilename, data, header_bytes);
+    std::cout << "The RINEX Navigation file header has been updated with UTC and IONO info." << std::endl;
+}
 
-                    if (line_str.find("GPSA", 0) != std::string::npos)
-                        {
-                            line_aux += std::string("GPSA");
-                            line_aux += std::string(1, ' ');
-                            line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(gps_iono.d_alpha0, 10, 2), 12);
-                            line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(gps_iono.d_alpha1, 10, 2), 12);
-                            line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(gps_iono.d_alpha2, 10, 2), 12);
-                            line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(gps_iono.d_alpha3, 10, 2), 12);
-                            line_aux += std::string(7, ' ');
-                            line_aux += Rinex_Printer::leftJustify("IONOSPHERIC CORR", 20);
-                            data.push_back(line_aux);
-                        }
-                    else if ((line_str.find("GPUT", 0) != std::string::npos) && (line_str.find("TIME SYSTEM CORR", 59) != std::string::npos))
-                        {
-                            line_aux += std::string("GPUT");
-                            line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(gps_utc_model.d_A0, 16, 2), 18);
-                            line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(gps_utc_model.d_A1, 15, 2), 16);
-                            line_aux += Rinex_Printer::rightJustify(std::to_string(gps_utc_model.d_t_OT), 7);
-                            line_aux += Rinex_Printer::rightJustify(std::to_string(gps_utc_model.i_WN_T + 1024), 5);  // valid until 2019
-                            line_aux += std::string(10, ' ');
-                            line_aux += Rinex_Printer::leftJustify("TIME SYSTEM CORR", 20);
-                            data.push_back(line_aux);
-                        }
-                    else if ((line_str.find("GLUT", 0) != std::string::npos) && (line_str.find("TIME SYSTEM CORR", 59) != std::string::npos))
-                        {
-                            line_aux += std::string("GLUT");
-                            line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(glonass_gnav_utc_model.d_tau_c, 16, 2), 18);
-                            line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(0.0, 15, 2), 16);
-                            line_aux += Rinex_Printer::rightJustify(std::to_string(0.0), 7);
-                            line_aux += Rinex_Printer::rightJustify(std::to_string(0.0), 5);
-                            line_aux += std::string(10, ' ');
-                            line_aux += Rinex_Printer::leftJustify("TIME SYSTEM CORR", 20);
-                            data.push_back(line_aux);
-                        }
-                    else if ((line_str.find("GLGP", 0) != std::string::npos) && (line_str.find("TIME SYSTEM CORR", 59) != std::string::npos))
-                        {
-                            line_aux += std::string("GLGP");
-                            line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(glonass_gnav_utc_model.d_tau_gps, 16, 2), 18);
-                            line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(0.0, 15, 2), 16);
-                            line_aux += Rinex_Printer::rightJustify(std::to_string(0.0), 7);
-                            line_aux += Rinex_Printer::rightJustify(std::to_string(0.0), 5);
-                            line_aux += std::string(10, ' ');
-                            line_aux += Rinex_Printer::leftJustify("TIME SYSTEM CORR", 20);
-                            data.push_back(line_aux);
-                        }
-                    else if (line_str.find("LEAP SECONDS", 59) != std::string::npos)
-                        {
-                            line_aux += Rinex_Printer::rightJustify(std::to_string(gps_utc_model.d_DeltaT_LS), 6);
-                            line_aux += Rinex_Printer::rightJustify(std::to_string(gps_utc_model.d_DeltaT_LSF), 6);
-                            line_aux += Rinex_Printer::rightJustify(std::to_string(gps_utc_model.i_WN_LSF), 6);
-                            line_aux += Rinex_Printer::rightJustify(std::to_string(gps_utc_model.i_DN), 6);
-                            line_aux += std::string(36, ' ');
-                            line_aux += Rinex_Printer::leftJustify("LEAP SECONDS", 20);
-                            data.push_back(line_aux);
-                        }
-                    else if (line_str.find("END OF HEADER", 59) != std::string::npos)
-                        {
-                            data.push_back(line_str);
-                            no_more_finds = true;
-                        }
-                    else
-                        {
-                            data.push_back(line_str);
-                        }
+
+void Rinex_Printer::update_nav_header(std::fstream& out, const Gps_Iono& gps_iono, const Gps_Utc_Model& gps_utc_model, const Galileo_Iono& galileo_iono, const Galileo_Utc_Model& galileo_utc_model)
+{
+    std::vector<std::string> data;
+    std::string line_aux;
+
+    out.seekp(0);
+    data.clear();
+
+    bool no_more_finds = false;
+    std::string line_str;
+
+    // only the header is read, it ends at END OF HEADER
+    while (!no_more_finds and !out.eof())
+        {
+            std::getline(out, line_str);
+
+            line_aux.clear();
+
+            if (line_str.find("GPSA", 0) != std::string::npos)
+                {
+                    line_aux += std::string("GPSA");
+                    line_aux += std::string(1, ' ');
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(gps_iono.d_alpha0, 10, 2), 12);
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(gps_iono.d_alpha1, 10, 2), 12);
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(gps_iono.d_alpha2, 10, 2), 12);
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(gps_iono.d_alpha3, 10, 2), 12);
+                    line_aux += std::string(7, ' ');
+                    line_aux += Rinex_Printer::leftJustify("IONOSPHERIC CORR", 20);
+                    data.push_back(line_aux);
+                }
+            else if ((line_str.find("GAL", 0) != std::string::npos) && (line_str.find("IONOSPHERIC CORR", 59) != std::string::npos))
+                {
+                    line_aux += std::string("GAL ");
+                    line_aux += std::string(1, ' ');
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(galileo_iono.ai0_5, 10, 2), 12);
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(galileo_iono.ai1_5, 10, 2), 12);
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(galileo_iono.ai2_5, 10, 2), 12);
+                    double zero = 0.0;
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(zero, 10, 2), 12);
+                    line_aux += std::string(7, ' ');
+                    line_aux += Rinex_Printer::leftJustify("IONOSPHERIC CORR", 20);
+                    data.push_back(line_aux);
+                }
+            else if ((line_str.find("GPSB", 0) != std::string::npos) && (line_str.find("IONOSPHERIC CORR", 59) != std::string::npos))
+                {
+                    line_aux += std::string("GPSB");
+                    line_aux += std::string(1, ' ');
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(gps_iono.d_beta0, 10, 2), 12);
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(gps_iono.d_beta1, 10, 2), 12);
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(gps_iono.d_beta2, 10, 2), 12);
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(gps_iono.d_beta3, 10, 2), 12);
+                    line_aux += std::string(7, ' ');
+                    line_aux += Rinex_Printer::leftJustify("IONOSPHERIC CORR", 20);
+                    data.push_back(line_aux);
+                }
+            else if ((line_str.find("GPUT", 0) != std::string::npos) && (line_str.find("TIME SYSTEM CORR", 59) != std::string::npos))
+                {
+                    line_aux += std::string("GPUT");
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(gps_utc_model.d_A0, 16, 2), 18);
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(gps_utc_model.d_A1, 15, 2), 16);
+                    line_aux += Rinex_Printer::rightJustify(std::to_string(gps_utc_model.d_t_OT), 7);
+                    line_aux += Rinex_Printer::rightJustify(std::to_string(gps_utc_model.i_WN_T + 1024), 5);  // valid until 2019
+                    line_aux += std::string(10, ' ');
+                    line_aux += Rinex_Printer::leftJustify("TIME SYSTEM CORR", 20);
+                    data.push_back(line_aux);
+                }
+            else if ((line_str.find("GAUT", 0) != std::string::npos) && (line_str.find("TIME SYSTEM CORR", 59) != std::string::npos))
+                {
+                    line_aux += std::string("GAUT");
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(galileo_utc_model.A0_6, 16, 2), 18);
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(galileo_utc_model.A1_6, 15, 2), 16);
+                    line_aux += Rinex_Printer::rightJustify(std::to_string(galileo_utc_model.t0t_6), 7);
+                    line_aux += Rinex_Printer::rightJustify(std::to_string(galileo_utc_model.WNot_6), 5);
+                    line_aux += std::string(10, ' ');
+                    line_aux += Rinex_Printer::leftJustify("TIME SYSTEM CORR", 20);
+                    data.push_back(line_aux);
+                }
+            else if ((line_str.find("GPGA", 0) != std::string::npos) && (line_str.find("TIME SYSTEM CORR", 59) != std::string::npos))
+                {
+                    line_aux += std::string("GPGA");
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(galileo_utc_model.A_0G_10, 16, 2), 18);
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(galileo_utc_model.A_1G_10, 15, 2), 16);
+                    line_aux += Rinex_Printer::rightJustify(std::to_string(galileo_utc_model.t_0G_10), 7);
+                    line_aux += Rinex_Printer::rightJustify(std::to_string(galileo_utc_model.WN_0G_10), 5);
+                    line_aux += std::string(10, ' ');
+                    line_aux += Rinex_Printer::leftJustify("TIME SYSTEM CORR", 20);
+                    data.push_back(line_aux);
+                }
+            else if (line_str.find("LEAP SECONDS", 59) != std::string::npos)
+                {
+                    line_aux += Rinex_Printer::rightJustify(std::to_string(gps_utc_model.d_DeltaT_LS), 6);
+                    line_aux += Rinex_Printer::rightJustify(std::to_string(gps_utc_model.d_DeltaT_LSF), 6);
+                    line_aux += Rinex_Printer::rightJustify(std::to_string(gps_utc_model.i_WN_LSF), 6);
+                    line_aux += Rinex_Printer::rightJustify(std::to_string(gps_utc_model.i_DN), 6);
+                    line_aux += std::string(36, ' ');
+                    line_aux += Rinex_Printer::leftJustify("LEAP SECONDS", 20);
+                    data.push_back(line_aux);
+                }
+            else if (line_str.find("END OF HEADER", 59) != std::string::npos)
+                {
+                    data.push_back(line_str);
+                    no_more_finds = true;
                 }
             else
                 {
                     data.push_back(line_str);
                 }
         }
+    int64_t header_bytes = out.tellg();
+    rewrite_header(out, navMixfilename, data, header_bytes);
+    std::cout << "The RINEX Navigation file header has been updated with UTC and IONO info." << std::endl;
+}
+
+
+void Rinex_Printer::update_nav_header(std::fstream& out, const Gps_Iono& gps_iono, const Gps_Utc_Model& gps_utc_model, const Glonass_Gnav_Utc_Model& glonass_gnav_utc_model, const Glonass_Gnav_Almanac& glonass_gnav_almanac)
+{
+    if (glonass_gnav_almanac.i_satellite_freq_channel)
+        {
+        }  //Avoid compiler warning
+    std::vector<std::string> data;
+    std::string line_aux;
 
-    out.close();
-    out.open(navMixfilename, std::ios::out | std::ios::trunc);
     out.seekp(0);
-    for (int32_t i = 0; i < static_cast<int32_t>(data.size()) - 1; i++)
+    data.clear();
+
+    bool no_more_finds = false;
+    std::string line_str;
+
+    // only the header is read, it ends at END OF HEADER
+    while (!no_more_finds and !out.eof())
         {
-            out << data[i] << std::endl;
+            std::getline(out, line_str);
+
+            line_aux.clear();
+
+            if (line_str.find("GPSA", 0) != std::string::npos)
+                {
+                    line_aux += std::string("GPSA");
+                    line_aux += std::string(1, ' ');
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(gps_iono.d_alpha0, 10, 2), 12);
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(gps_iono.d_alpha1, 10, 2), 12);
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(gps_iono.d_alpha2, 10, 2), 12);
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(gps_iono.d_alpha3, 10, 2), 12);
+                    line_aux += std::string(7, ' ');
+                    line_aux += Rinex_Printer::leftJustify("IONOSPHERIC CORR", 20);
+                    data.push_back(line_aux);
+                }
+            else if ((line_str.find("GPUT", 0) != std::string::npos) && (line_str.find("TIME SYSTEM CORR", 59) != std::string::npos))
+                {
+                    line_aux += std::string("GPUT");
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(gps_utc_model.d_A0, 16, 2), 18);
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(gps_utc_model.d_A1, 15, 2), 16);
+                    line_aux += Rinex_Printer::rightJustify(std::to_string(gps_utc_model.d_t_OT), 7);
+                    line_aux += Rinex_Printer::rightJustify(std::to_string(gps_utc_model.i_WN_T + 1024), 5);  // valid until 2019
+                    line_aux += std::string(10, ' ');
+                    line_aux += Rinex_Printer::leftJustify("TIME SYSTEM CORR", 20);
+                    data.push_back(line_aux);
+                }
+            else if ((line_str.find("GLUT", 0) != std::string::npos) && (line_str.find("TIME SYSTEM CORR", 59) != std::string::npos))
+                {
+                    line_aux += std::string("GLUT");
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(glonass_gnav_utc_model.d_tau_c, 16, 2), 18);
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(0.0, 15, 2), 16);
+                    line_aux += Rinex_Printer::rightJustify(std::to_string(0.0), 7);
+                    line_aux += Rinex_Printer::rightJustify(std::to_string(0.0), 5);
+                    line_aux += std::string(10, ' ');
+                    line_aux += Rinex_Printer::leftJustify("TIME SYSTEM CORR", 20);
+                    data.push_back(line_aux);
+                }
+            else if ((line_str.find("GLGP", 0) != std::string::npos) && (line_str.find("TIME SYSTEM CORR", 59) != std::string::npos))
+                {
+                    line_aux += std::string("GLGP");
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(glonass_gnav_utc_model.d_tau_gps, 16, 2), 18);
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(0.0, 15, 2), 16);
+                    line_aux += Rinex_Printer::rightJustify(std::to_string(0.0), 7);
+                    line_aux += Rinex_Printer::rightJustify(std::to_string(0.0), 5);
+                    line_aux += std::string(10, ' ');
+                    line_aux += Rinex_Printer::leftJustify("TIME SYSTEM CORR", 20);
+                    data.push_back(line_aux);
+                }
+            else if (line_str.find("LEAP SECONDS", 59) != std::string::npos)
+                {
+                    line_aux += Rinex_Printer::rightJustify(std::to_string(gps_utc_model.d_DeltaT_LS), 6);
+                    line_aux += Rinex_Printer::rightJustify(std::to_string(gps_utc_model.d_DeltaT_LSF), 6);
+                    line_aux += Rinex_Printer::rightJustify(std::to_string(gps_utc_model.i_WN_LSF), 6);
+                    line_aux += Rinex_Printer::rightJustify(std::to_string(gps_utc_model.i_DN), 6);
+                    line_aux += std::string(36, ' ');
+                    line_aux += Rinex_Printer::leftJustify("LEAP SECONDS", 20);
+                    data.push_back(line_aux);
+                }
+            else if (line_str.find("END OF HEADER", 59) != std::string::npos)
+                {
+                    data.push_back(line_str);
+                    no_more_finds = true;
+                }
+            else
+                {
+                    data.push_back(line_str);
+                }
         }
-    out.close();
-    out.open(navMixfilename, std::ios::out | std::ios::app);
-    out.seekp(pos);
+    int64_t header_bytes = out.tellg();
+    rewrite_header(out, navMixfilename, data, header_bytes);
     std::cout << "The RINEX Navigation file header has been updated with UTC and IONO info." << std::endl;
 }
 
@@ -2441,102 +2378,86 @@ void Rinex_Printer::update_nav_header(std::fstream& out, const Gps_CNAV_Iono& gp
     std::vector<std::string> data;
     std::string line_aux;
 
-    int64_t pos = out.tellp();
     out.seekp(0);
     data.clear();
 
     bool no_more_finds = false;
     std::string line_str;
 
-    while (!out.eof())
+    // only the header is read, it ends at END OF HEADER
+    while (!no_more_finds and !out.eof())
         {
             std::getline(out, line_str);
 
-            if (!no_more_finds)
+            line_aux.clear();
+
+            if (line_str.find("GPSA", 0) != std::string::npos)
+                {
+                    line_aux += std::string("GPSA");
+                    line_aux += std::string(1, ' ');
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(gps_iono.d_alpha0, 10, 2), 12);
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(gps_iono.d_alpha1, 10, 2), 12);
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(gps_iono.d_alpha2, 10, 2), 12);
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(gps_iono.d_alpha3, 10, 2), 12);
+                    line_aux += std::string(7, ' ');
+                    line_aux += Rinex_Printer::leftJustify("IONOSPHERIC CORR", 20);
+                    data.push_back(line_aux);
+                }
+            else if ((line_str.find("GPUT", 0) != std::string::npos) && (line_str.find("TIME SYSTEM CORR", 59) != std::string::npos))
+                {
+                    line_aux += std::string("GPUT");
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(gps_utc_model.d_A0, 16, 2), 18);
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(gps_utc_model.d_A1, 15, 2), 16);
+                    line_aux += Rinex_Printer::rightJustify(std::to_string(gps_utc_model.d_t_OT), 7);
+                    line_aux += Rinex_Printer::rightJustify(std::to_string(gps_utc_model.i_WN_T + 1024), 5);  // valid until 2019
+                    line_aux += std::string(10, ' ');
+                    line_aux += Rinex_Printer::leftJustify("TIME SYSTEM CORR", 20);
+                    data.push_back(line_aux);
+                }
+            else if ((line_str.find("GLUT", 0) != std::string::npos) && (line_str.find("TIME SYSTEM CORR", 59) != std::string::npos))
+                {
+                    line_aux += std::string("GLUT");
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(glonass_gnav_utc_model.d_tau_c, 16, 2), 18);
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(0.0, 15, 2), 16);
+                    line_aux += Rinex_Printer::rightJustify(std::to_string(0.0), 7);
+                    line_aux += Rinex_Printer::rightJustify(std::to_string(0.0), 5);
+                    line_aux += std::string(10, ' ');
+                    line_aux += Rinex_Printer::leftJustify("TIME SYSTEM CORR", 20);
+                    data.push_back(line_aux);
+                }
+            else if ((line_str.find("GLGP", 0) != std::string::npos) && (line_str.find("TIME SYSTEM CORR", 59) != std::string::npos))
+                {
+                    line_aux += std::string("GLGP");
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(glonass_gnav_utc_model.d_tau_gps, 16, 2), 18);
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(0.0, 15, 2), 16);
+                    line_aux += Rinex_Printer::rightJustify(std::to_string(0.0), 7);
+                    line_aux += Rinex_Printer::rightJustify(std::to_string(0.0), 5);
+                    line_aux += std::string(10, ' ');
+                    line_aux += Rinex_Printer::leftJustify("TIME SYSTEM CORR", 20);
+                    data.push_back(line_aux);
+                }
+            else if (line_str.find("LEAP SECONDS", 59) != std::string::npos)
+                {
+                    line_aux += Rinex_Printer::rightJustify(std::to_string(gps_utc_model.d_DeltaT_LS), 6);
+                    line_aux += Rinex_Printer::rightJustify(std::to_string(gps_utc_model.d_DeltaT_LSF), 6);
+                    line_aux += Rinex_Printer::rightJustify(std::to_string(gps_utc_model.i_WN_LSF), 6);
+                    line_aux += Rinex_Printer::rightJustify(std::to_string(gps_utc_model.i_DN), 6);
+                    line_aux += std::string(36, ' ');
+                    line_aux += Rinex_Printer::leftJustify("LEAP SECONDS", 20);
+                    data.push_back(line_aux);
+                }
+            else if (line_str.find("END OF HEADER", 59) != std::string::npos)
                 {
-                    line_aux.clear();
-
-                    if (line_str.find("GPSA", 0) != std::string::npos)
-                        {
-                            line_aux += std::string("GPSA");
-                            line_aux += std::string(1, ' ');
-                            line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(gps_iono.d_alpha0, 10, 2), 12);
-                            line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(gps_iono.d_alpha1, 10, 2), 12);
-                            line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(gps_iono.d_alpha2, 10, 2), 12);
-                            line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(gps_iono.d_alpha3, 10, 2), 12);
-                            line_aux += std::string(7, ' ');
-                            line_aux += Rinex_Printer::leftJustify("IONOSPHERIC CORR", 20);
-                            data.push_back(line_aux);
-                        }
-                    else if ((line_str.find("GPUT", 0) != std::string::npos) && (line_str.find("TIME SYSTEM CORR", 59) != std::string::npos))
-                        {
-                            line_aux += std::string("GPUT");
-                            line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(gps_utc_model.d_A0, 16, 2), 18);
-                            line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(gps_utc_model.d_A1, 15, 2), 16);
-                            line_aux += Rinex_Printer::rightJustify(std::to_string(gps_utc_model.d_t_OT), 7);
-                            line_aux += Rinex_Printer::rightJustify(std::to_string(gps_utc_model.i_WN_T + 1024), 5);  // valid until 2019
-                            line_aux += std::string(10, ' ');
-                            line_aux += Rinex_Printer::leftJustify("TIME SYSTEM CORR", 20);
-                            data.push_back(line_aux);
-                        }
-                    else if ((line_str.find("GLUT", 0) != std::string::npos) && (line_str.find("TIME SYSTEM CORR", 59) != std::string::npos))
-                        {
-                            line_aux += std::string("GLUT");
-                            line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(glonass_gnav_utc_model.d_tau_c, 16, 2), 18);
-                            line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(0.0, 15, 2), 16);
-                            line_aux += Rinex_Printer::rightJustify(std::to_string(0.0), 7);
-                            line_aux += Rinex_Printer::rightJustify(std::to_string(0.0), 5);
-                            line_aux += std::string(10, ' ');
-                            line_aux += Rinex_Printer::leftJustify("TIME SYSTEM CORR", 20);
-                            data.push_back(line_aux);
-                        }
-                    else if ((line_str.find("GLGP", 0) != std::string::npos) && (line_str.find("TIME SYSTEM CORR", 59) != std::string::npos))
-                        {
-                            line_aux += std::string("GLGP");
-                            line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(glonass_gnav_utc_model.d_tau_gps, 16, 2), 18);
-                            line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(0.0, 15, 2), 16);
-                            line_aux += Rinex_Printer::rightJustify(std::to_string(0.0), 7);
-                            line_aux += Rinex_Printer::rightJustify(std::to_string(0.0), 5);
-                            line_aux += std::string(10, ' ');
-                            line_aux += Rinex_Printer::leftJustify("TIME SYSTEM CORR", 20);
-                            data.push_back(line_aux);
-                        }
-                    else if (line_str.find("LEAP SECONDS", 59) != std::string::npos)
-                        {
-                            line_aux += Rinex_Printer::rightJustify(std::to_string(gps_utc_model.d_DeltaT_LS), 6);
-                            line_aux += Rinex_Printer::rightJustify(std::to_string(gps_utc_model.d_DeltaT_LSF), 6);
-                            line_aux += Rinex_Printer::rightJustify(std::to_string(gps_utc_model.i_WN_LSF), 6);
-                            line_aux += Rinex_Printer::rightJustify(std::to_string(gps_utc_model.i_DN), 6);
-                            line_aux += std::string(36, ' ');
-                            line_aux += Rinex_Printer::leftJustify("LEAP SECONDS", 20);
-                            data.push_back(line_aux);
-                        }
-                    else if (line_str.find("END OF HEADER", 59) != std::string::npos)
-                        {
-                            data.push_back(line_str);
-                            no_more_finds = true;
-                        }
-                    else
-                        {
-                            data.push_back(line_str);
-                        }
+                    data.push_back(line_str);
+                    no_more_finds = true;
                 }
             else
                 {
                     data.push_back(line_str);
                 }
         }
-
-    out.close();
-    out.open(navMixfilename, std::ios::out | std::ios::trunc);
-    out.seekp(0);
-    for (int32_t i = 0; i < static_cast<int32_t>(data.size()) - 1; i++)
-        {
-            out << data[i] << std::endl;
-        }
-    out.close();
-    out.open(navMixfilename, std::ios::out | std::ios::app);
-    out.seekp(pos);
+    int64_t header_bytes = out.tellg();
+    rewrite_header(out, navMixfilename, data, header_bytes);
     std::cout << "The RINEX Navigation file header has been updated with UTC and IONO info." << std::endl;
 }
 
@@ -2553,92 +2474,76 @@ void Rinex_Printer::update_nav_header(std::fstream& out, const Galileo_Iono& gal
     std::vector<std::string> data;
     std::string line_aux;
 
-    int64_t pos = out.tellp();
     out.seekp(0);
     data.clear();
 
     bool no_more_finds = false;
     std::string line_str;
 
-    while (!out.eof())
+    // only the header is read, it ends at END OF HEADER
+    while (!no_more_finds and !out.eof())
         {
             std::getline(out, line_str);
 
-            if (!no_more_finds)
+            line_aux.clear();
+
+            if ((line_str.find("GAL", 0) != std::string::npos) && (line_str.find("IONOSPHERIC CORR", 59) != std::string::npos))
+                {
+                    line_aux += std::string("GAL ");
+                    line_aux += std::string(1, ' ');
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(galileo_iono.ai0_5, 10, 2), 12);
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(galileo_iono.ai1_5, 10, 2), 12);
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(galileo_iono.ai2_5, 10, 2), 12);
+                    double zero = 0.0;
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(zero, 10, 2), 12);
+                    line_aux += std::string(7, ' ');
+                    line_aux += Rinex_Printer::leftJustify("IONOSPHERIC CORR", 20);
+                    data.push_back(line_aux);
+                }
+            else if ((line_str.find("GAUT", 0) != std::string::npos) && (line_str.find("TIME SYSTEM CORR", 59) != std::string::npos))
+                {
+                    line_aux += std::string("GAUT");
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(galileo_utc_model.A0_6, 16, 2), 18);
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(galileo_utc_model.A1_6, 15, 2), 16);
+                    line_aux += Rinex_Printer::rightJustify(std::to_string(galileo_utc_model.t0t_6), 7);
+                    line_aux += Rinex_Printer::rightJustify(std::to_string(galileo_utc_model.WNot_6), 5);
+                    line_aux += std::string(10, ' ');
+                    line_aux += Rinex_Printer::leftJustify("TIME SYSTEM CORR", 20);
+                    data.push_back(line_aux);
+                }
+            else if ((line_str.find("GLUT", 0) != std::string::npos) && (line_str.find("TIME SYSTEM CORR", 59) != std::string::npos))
+                {
+                    line_aux += std::string("GLUT");
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(glonass_gnav_utc_model.d_tau_c, 16, 2), 18);
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(0.0, 15, 2), 16);
+                    line_aux += Rinex_Printer::rightJustify(std::to_string(0.0), 7);
+                    line_aux += Rinex_Printer::rightJustify(std::to_string(0.0), 5);
+                    line_aux += std::string(10, ' ');
+                    line_aux += Rinex_Printer::leftJustify("TIME SYSTEM CORR", 20);
+                    data.push_back(line_aux);
+                }
+            else if (line_str.find("LEAP SECONDS", 59) != std::string::npos)
+                {
+                    line_aux += Rinex_Printer::rightJustify(std::to_string(galileo_utc_model.Delta_tLS_6), 6);
+                    line_aux += Rinex_Printer::rightJustify(std::to_string(galileo_utc_model.Delta_tLSF_6), 6);
+                    line_aux += Rinex_Printer::rightJustify(std::to_string(galileo_utc_model.WN_LSF_6), 6);
+                    line_aux += Rinex_Printer::rightJustify(std::to_string(galileo_utc_model.DN_6), 6);
+                    line_aux += std::string(36, ' ');
+                    line_aux += Rinex_Printer::leftJustify("LEAP SECONDS", 20);
+                    data.push_back(line_aux);
+                }
+            else if (line_str.find("END OF HEADER", 59) != std::string::npos)
                 {
-                    line_aux.clear();
-
-                    if ((line_str.find("GAL", 0) != std::string::npos) && (line_str.find("IONOSPHERIC CORR", 59) != std::string::npos))
-                        {
-                            line_aux += std::string("GAL ");
-                            line_aux += std::string(1, ' ');
-                            line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(galileo_iono.ai0_5, 10, 2), 12);
-                            line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(galileo_iono.ai1_5, 10, 2), 12);
-                            line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(galileo_iono.ai2_5, 10, 2), 12);
-                            double zero = 0.0;
-                            line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(zero, 10, 2), 12);
-                            line_aux += std::string(7, ' ');
-                            line_aux += Rinex_Printer::leftJustify("IONOSPHERIC CORR", 20);
-                            data.push_back(line_aux);
-                        }
-                    else if ((line_str.find("GAUT", 0) != std::string::npos) && (line_str.find("TIME SYSTEM CORR", 59) != std::string::npos))
-                        {
-                            line_aux += std::string("GAUT");
-                            line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(galileo_utc_model.A0_6, 16, 2), 18);
-                            line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(galileo_utc_model.A1_6, 15, 2), 16);
-                            line_aux += Rinex_Printer::rightJustify(std::to_string(galileo_utc_model.t0t_6), 7);
-                            line_aux += Rinex_Printer::rightJustify(std::to_string(galileo_utc_model.WNot_6), 5);
-                            line_aux += std::string(10, ' ');
-                            line_aux += Rinex_Printer::leftJustify("TIME SYSTEM CORR", 20);
-                            data.push_back(line_aux);
-                        }
-                    else if ((line_str.find("GLUT", 0) != std::string::npos) && (line_str.find("TIME SYSTEM CORR", 59) != std::string::npos))
-                        {
-                            line_aux += std::string("GLUT");
-                            line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(glonass_gnav_utc_model.d_tau_c, 16, 2), 18);
-                            line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(0.0, 15, 2), 16);
-                            line_aux += Rinex_Printer::rightJustify(std::to_string(0.0), 7);
-                            line_aux += Rinex_Printer::rightJustify(std::to_string(0.0), 5);
-                            line_aux += std::string(10, ' ');
-                            line_aux += Rinex_Printer::leftJustify("TIME SYSTEM CORR", 20);
-                            data.push_back(line_aux);
-                        }
-                    else if (line_str.find("LEAP SECONDS", 59) != std::string::npos)
-                        {
-                            line_aux += Rinex_Printer::rightJustify(std::to_string(galileo_utc_model.Delta_tLS_6), 6);
-                            line_aux += Rinex_Printer::rightJustify(std::to_string(galileo_utc_model.Delta_tLSF_6), 6);
-                            line_aux += Rinex_Printer::rightJustify(std::to_string(galileo_utc_model.WN_LSF_6), 6);
-                            line_aux += Rinex_Printer::rightJustify(std::to_string(galileo_utc_model.DN_6), 6);
-                            line_aux += std::string(36, ' ');
-                            line_aux += Rinex_Printer::leftJustify("LEAP SECONDS", 20);
-                            data.push_back(line_aux);
-                        }
-                    else if (line_str.find("END OF HEADER", 59) != std::string::npos)
-                        {
-                            data.push_back(line_str);
-                            no_more_finds = true;
-                        }
-                    else
-                        {
-                            data.push_back(line_str);
-                        }
+                    data.push_back(line_str);
+                    no_more_finds = true;
                 }
             else
                 {
                     data.push_back(line_str);
                 }
         }
-
-    out.close();
-    out.open(navMixfilename, std::ios::out | std::ios::trunc);
-    out.seekp(0);
-    for (int32_t i = 0; i < static_cast<int32_t>(data.size()) - 1; i++)
-        {
-            out << data[i] << std::endl;
-        }
-    out.close();
-    out.open(navMixfilename, std::ios::out | std::ios::app);
-    out.seekp(pos);
+    int64_t header_bytes = out.tellg();
+    rewrite_header(out, navMixfilename, data, header_bytes);
     std::cout << "The RINEX Navigation file header has been updated with UTC and IONO info." << std::endl;
 }
 
@@ -6861,96 +6766,36 @@ void Rinex_Printer::update_obs_header(std::fstream& out, const Gps_Utc_Model& ut
     bool no_more_finds = false;
     std::string line_str;
 
-    while (!out.eof())
+    // only the header is read, it ends at END OF HEADER
+    while (!no_more_finds and !out.eof())
         {
             std::getline(out, line_str);
 
-            if (!no_more_finds)
-                {
-                    line_aux.clear();
+            line_aux.clear();
 
-                    if (version == 2)
+            if (version == 2)
+                {
+                    if (line_str.find("TIME OF FIRST OBS", 59) != std::string::npos)  // TIME OF FIRST OBS last header annotation might change in the future
                         {
-                            if (line_str.find("TIME OF FIRST OBS", 59) != std::string::npos)  // TIME OF FIRST OBS last header annotation might change in the future
-                                {
-                                    data.push_back(line_str);
-                                    line_aux += Rinex_Printer::rightJustify(std::to_string(utc_model.d_DeltaT_LS), 6);
-                                    line_aux += std::string(54, ' ');
-                                    line_aux += Rinex_Printer::leftJustify("LEAP SECONDS", 20);
-                                    data.push_back(line_aux);
-                                }
-                            else if (line_str.find("END OF HEADER", 59) != std::string::npos)
-                                {
-                                    data.push_back(line_str);
-                                    no_more_finds = true;
-                                }
-                            else
-                                {
-                                    data.push_back(line_str);
-                                }
+                            data.push_back(line_str);
+                            line_aux += Rinex_Printer::rightJustify(std::to_string(utc_model.d_DeltaT_LS), 6);
+                            line_aux += std::string(54, ' ');
+                            line_aux += Rinex_Printer::leftJustify("LEAP SECONDS", 20);
+                            data.push_back(line_aux);
                         }
-
-                    if (version == 3)
+                    else if (line_str.find("END OF HEADER", 59) != std::string::npos)
                         {
-                            if (line_str.find("TIME OF FIRST OBS", 59) != std::string::npos)
-                                {
-                                    data.push_back(line_str);
-                                    line_aux += Rinex_Printer::rightJustify(std::to_string(utc_model.d_DeltaT_LS), 6);
-                                    line_aux += Rinex_Printer::rightJustify(std::to_string(utc_model.d_DeltaT_LSF), 6);
-                                    line_aux += Rinex_Printer::rightJustify(std::to_string(utc_model.i_WN_LSF), 6);
-                                    line_aux += Rinex_Printer::rightJustify(std::to_string(utc_model.i_DN), 6);
-                                    line_aux += std::string(36, ' ');
-                                    line_aux += Rinex_Printer::leftJustify("LEAP SECONDS", 20);
-                                    data.push_back(line_aux);
-                                }
-                            else if (line_str.find("END OF HEADER", 59) != std::string::npos)
-                                {
-                                    data.push_back(line_str);
-                                    no_more_finds = true;
-                                }
-                            else
-                                {
-                                    data.push_back(line_str);
-                                }
+                            data.push_back(line_str);
+                            no_more_finds = true;
+                        }
+                    else
+                        {
+                            data.push_back(line_str);
                         }
                 }
-            else
-                {
-                    data.push_back(line_str);
-                }
-        }
-
-    out.close();
-    out.open(obsfilename, std::ios::out | std::ios::trunc);
-    out.seekp(0);
-    for (int32_t i = 0; i < static_cast<int32_t>(data.size()) - 1; i++)
-        {
-            out << data[i] << std::endl;
-        }
-    out.close();
-    out.open(obsfilename, std::ios::out | std::ios::in | std::ios::app);
-    out.seekp(0, std::ios_base::end);
-}
-
-
-void Rinex_Printer::update_obs_header(std::fstream& out, const Gps_CNAV_Utc_Model& utc_model)
-{
-    std::vector<std::string> data;
-    std::string line_aux;
-
-    out.seekp(0);
-    data.clear();
 
-    bool no_more_finds = false;
-    std::string line_str;
-
-    while (!out.eof())
-        {
-            std::getline(out, line_str);
-
-            if (!no_more_finds)
+            if (version == 3)
                 {
-                    line_aux.clear();
                     if (line_str.find("TIME OF FIRST OBS", 59) != std::string::npos)
                         {
                             data.push_back(line_str);
@@ -6972,22 +6817,52 @@ void Rinex_Printer::update_obs_header(std::fstream& out, const Gps_CNAV_Utc_Mode
                             data.push_back(line_str);
                         }
                 }
-            else
-                {
-                    data.push_back(line_str);
-                }
         }
+    int64_t header_bytes = out.tellg();
+    rewrite_header(out, obsfilename, data, header_bytes);
+}
+
+
+void Rinex_Printer::update_obs_header(std::fstream& out, const Gps_CNAV_Utc_Model& utc_model)
+{
+    std::vector<std::string> data;
+    std::string line_aux;
 
-    out.close();
-    out.open(obsfilename, std::ios::out | std::ios::trunc);
     out.seekp(0);
-    for (int32_t i = 0; i < static_cast<int32_t>(data.size()) - 1; i++)
+    data.clear();
+
+    bool no_more_finds = false;
+    std::string line_str;
+
+    // only the header is read, it ends at END OF HEADER
+    while (!no_more_finds and !out.eof())
         {
-            out << data[i] << std::endl;
+            std::getline(out, line_str);
+
+            line_aux.clear();
+            if (line_str.find("TIME OF FIRST OBS", 59) != std::string::npos)
+                {
+                    data.push_back(line_str);
+                    line_aux += Rinex_Printer::rightJustify(std::to_string(utc_model.d_DeltaT_LS), 6);
+                    line_aux += Rinex_Printer::rightJustify(std::to_string(utc_model.d_DeltaT_LSF), 6);
+                    line_aux += Rinex_Printer::rightJustify(std::to_string(utc_model.i_WN_LSF), 6);
+                    line_aux += Rinex_Printer::rightJustify(std::to_string(utc_model.i_DN), 6);
+                    line_aux += std::string(36, ' ');
+                    line_aux += Rinex_Printer::leftJustify("LEAP SECONDS", 20);
+                    data.push_back(line_aux);
+                }
+            else if (line_str.find("END OF HEADER", 59) != std::string::npos)
+                {
+                    data.push_back(line_str);
+                    no_more_finds = true;
+                }
+            else
+                {
+                    data.push_back(line_str);
+                }
         }
-    out.close();
-    out.open(obsfilename, std::ios::out | std::ios::in | std::ios::app);
-    out.seekp(0, std::ios_base::end);
+    int64_t header_bytes = out.tellg();
+    rewrite_header(out, obsfilename, data, header_bytes);
 }
 
 
@@ -7002,56 +6877,42 @@ void Rinex_Printer::update_obs_header(std::fstream& out, const Galileo_Utc_Model
     bool no_more_finds = false;
     std::string line_str;
 
-    while (!out.eof())
+    // only the header is read, it ends at END OF HEADER
+    while (!no_more_finds and !out.eof())
         {
             std::getline(out, line_str);
 
-            if (!no_more_finds)
-                {
-                    line_aux.clear();
+            line_aux.clear();
 
-                    if (line_str.find("TIME OF FIRST OBS", 59) != std::string::npos)
-                        {
-                            data.push_back(line_str);
-                            line_aux += Rinex_Printer::rightJustify(std::to_string(galileo_utc_model.Delta_tLS_6), 6);
-                            line_aux += Rinex_Printer::rightJustify(std::to_string(galileo_utc_model.Delta_tLSF_6), 6);
-                            line_aux += Rinex_Printer::rightJustify(std::to_string(galileo_utc_model.WN_LSF_6), 6);
-                            line_aux += Rinex_Printer::rightJustify(std::to_string(galileo_utc_model.DN_6), 6);
-                            line_aux += std::string(36, ' ');
-                            line_aux += Rinex_Printer::leftJustify("LEAP SECONDS", 20);
-                            data.push_back(line_aux);
-                        }
-                    else if (line_str.find("END OF HEADER", 59) != std::string::npos)
-                        {
-                            data.push_back(line_str);
-                            no_more_finds = true;
-                        }
-                    else
-                        {
-                            data.push_back(line_str);
-                        }
+            if (line_str.find("TIME OF FIRST OBS", 59) != std::string::npos)
+                {
+                    data.push_back(line_str);
+                    line_aux += Rinex_Printer::rightJustify(std::to_string(galileo_utc_model.Delta_tLS_6), 6);
+                    line_aux += Rinex_Printer::rightJustify(std::to_string(galileo_utc_model.Delta_tLSF_6), 6);
+                    line_aux += Rinex_Printer::rightJustify(std::to_string(galileo_utc_model.WN_LSF_6), 6);
+                    line_aux += Rinex_Printer::rightJustify(std::to_string(galileo_utc_model.DN_6), 6);
+                    line_aux += std::string(36, ' ');
+                    line_aux += Rinex_Printer::leftJustify("LEAP SECONDS", 20);
+                    data.push_back(line_aux);
+                }
+            else if (line_str.find("END OF HEADER", 59) != std::string::npos)
+                {
+                    data.push_back(line_str);
+                    no_more_finds = true;
                 }
             else
                 {
                     data.push_back(line_str);
                 }
         }
-
-    out.close();
-    out.open(obsfilename, std::ios::out | std::ios::trunc);
-    out.seekp(0);
-    for (int32_t i = 0; i < static_cast<int32_t>(data.size()) - 1; i++)
-        {
-            out << data[i] << std::endl;
-        }
-    out.close();
-    out.open(obsfilename, std::ios::out | std::ios::in | std::ios::app);
-    out.seekp(0, std::ios_base::end);
+    int64_t header_bytes = out.tellg();
+    rewrite_header(out, obsfilename, data, header_bytes);
 }
 
 
 void Rinex_Printer::log_rinex_obs(std::fstream& out, const Glonass_Gnav_Ephemeris& eph, const double obs_time, const std::map<int32_t, Gnss_Synchro>& observables, const std::string& glonass_band)
 {
+    obs_record.clear();
     // RINEX observations timestamps are GPS timestamps.
     std::string line;
     double int_sec = 0;
@@ -7133,7 +6994,8 @@ void Rinex_Printer::log_rinex_obs(std::fstream& out, const Glonass_Gnav_Ephemeri
             //line += rightJustify(asString(clockOffset, 12), 15);
             line += std::string(80 - line.size(), ' ');
             Rinex_Printer::lengthCheck(line);
-            out << line << std::endl;
+            obs_record += line;
+            obs_record += '\n';
 
             for (observables_iter = observables.cbegin();
                  observables_iter != observables.cend();
@@ -7144,7 +7006,7 @@ void Rinex_Printer::log_rinex_obs(std::fstream& out, const Glonass_Gnav_Ephemeri
                     line.clear();
                     // GLONASS L1 PSEUDORANGE
                     line += std::string(2, ' ');
-                    lineObs += Rinex_Printer::rightJustify(asString(observables_iter->second.Pseudorange_m, 3), 14);
+                    Rinex_Printer::appendFixed(lineObs, observables_iter->second.Pseudorange_m, 3, 14);
 
                     //Loss of lock indicator (LLI)
                     int32_t lli = 0;  // Include in the observation!!
@@ -7159,9 +7021,9 @@ void Rinex_Printer::log_rinex_obs(std::fstream& out, const Glonass_Gnav_Ephemeri
 
                     // Signal Strength Indicator (SSI)
                     int32_t ssi = Rinex_Printer::signalStrength(observables_iter->second.CN0_dB_hz);
-                    lineObs += Rinex_Printer::rightJustify(Rinex_Printer::asString<int32_t>(ssi), 1);
+                    lineObs += static_cast<char>('0' + ssi);
                     // GLONASS L1 CA PHASE
-                    lineObs += Rinex_Printer::rightJustify(asString(observables_iter->second.Carrier_phase_rads / GLONASS_TWO_PI, 3), 14);
+                    Rinex_Printer::appendFixed(lineObs, observables_iter->second.Carrier_phase_rads / GLONASS_TWO_PI, 3, 14);
                     if (lli == 0)
                         {
                             lineObs += std::string(1, ' ');
@@ -7170,9 +7032,9 @@ void Rinex_Printer::log_rinex_obs(std::fstream& out, const Glonass_Gnav_Ephemeri
                     //    {
                     //        lineObs += Rinex_Printer::rightJustify(Rinex_Printer::asString<short>(lli), 1);
                     //    }
-                    lineObs += Rinex_Printer::rightJustify(Rinex_Printer::asString<int32_t>(ssi), 1);
+                    lineObs += static_cast<char>('0' + ssi);
                     // GLONASS L1 CA DOPPLER
-                    lineObs += Rinex_Printer::rightJustify(asString(observables_iter->second.Carrier_Doppler_hz, 3), 14);
+                    Rinex_Printer::appendFixed(lineObs, observables_iter->second.Carrier_Doppler_hz, 3, 14);
                     if (lli == 0)
                         {
                             lineObs += std::string(1, ' ');
@@ -7181,11 +7043,12 @@ void Rinex_Printer::log_rinex_obs(std::fstream& out, const Glonass_Gnav_Ephemeri
                     //    {
                     //        lineObs += Rinex_Printer::rightJustify(Rinex_Printer::asString<short>(lli), 1);
                     //    }
-                    lineObs += Rinex_Printer::rightJustify(Rinex_Printer::asString<int32_t>(ssi), 1);
+                    lineObs += static_cast<char>('0' + ssi);
                     //GLONASS L1 SIGNAL STRENGTH
-                    lineObs += Rinex_Printer::rightJustify(asString(observables_iter->second.CN0_dB_hz, 3), 14);
+                    Rinex_Printer::appendFixed(lineObs, observables_iter->second.CN0_dB_hz, 3, 14);
                     if (lineObs.size() < 80) lineObs += std::string(80 - lineObs.size(), ' ');
-                    out << lineObs << std::endl;
+                    obs_record += lineObs;
+                    obs_record += '\n';
                 }
         }
 
@@ -7231,7 +7094,8 @@ void Rinex_Printer::log_rinex_obs(std::fstream& out, const Glonass_Gnav_Ephemeri
 
             line += std::string(80 - line.size(), ' ');
             Rinex_Printer::lengthCheck(line);
-            out << line << std::endl;
+            obs_record += line;
+            obs_record += '\n';
 
             for (observables_iter = observables.cbegin();
                  observables_iter != observables.cend();
@@ -7243,7 +7107,7 @@ void Rinex_Printer::log_rinex_obs(std::fstream& out, const Glonass_Gnav_Ephemeri
                     if (static_cast<int32_t>(observables_iter->second.PRN) < 10) lineObs += std::string(1, '0');
                     lineObs += std::to_string(static_cast<int32_t>(observables_iter->second.PRN));
                     //lineObs += std::string(2, ' ');
-                    lineObs += Rinex_Printer::rightJustify(asString(observables_iter->second.Pseudorange_m, 3), 14);
+                    Rinex_Printer::appendFixed(lineObs, observables_iter->second.Pseudorange_m, 3, 14);
 
                     //Loss of lock indicator (LLI)
                     int32_t lli = 0;  // Include in the observation!!
@@ -7258,10 +7122,10 @@ void Rinex_Printer::log_rinex_obs(std::fstream& out, const Glonass_Gnav_Ephemeri
 
                     // Signal Strength Indicator (SSI)
                     int32_t ssi = Rinex_Printer::signalStrength(observables_iter->second.CN0_dB_hz);
-                    lineObs += Rinex_Printer::rightJustify(Rinex_Printer::asString<int32_t>(ssi), 1);
+                    lineObs += static_cast<char>('0' + ssi);
 
                     // GLONASS L1 CA PHASE
-                    lineObs += Rinex_Printer::rightJustify(asString(observables_iter->second.Carrier_phase_rads / GLONASS_TWO_PI, 3), 14);
+                    Rinex_Printer::appendFixed(lineObs, observables_iter->second.Carrier_phase_rads / GLONASS_TWO_PI, 3, 14);
                     if (lli == 0)
                         {
                             lineObs += std::string(1, ' ');
@@ -7270,10 +7134,10 @@ void Rinex_Printer::log_rinex_obs(std::fstream& out, const Glonass_Gnav_Ephemeri
                     //    {
                     //        lineObs += Rinex_Printer::rightJustify(Rinex_Printer::asString<short>(lli), 1);
                     //    }
-                    lineObs += Rinex_Printer::rightJustify(Rinex_Printer::asString<int32_t>(ssi), 1);
+                    lineObs += static_cast<char>('0' + ssi);
 
                     // GLONASS L1 CA DOPPLER
-                    lineObs += Rinex_Printer::rightJustify(asString(observables_iter->second.Carrier_Doppler_hz, 3), 14);
+                    Rinex_Printer::appendFixed(lineObs, observables_iter->second.Carrier_Doppler_hz, 3, 14);
                     if (lli == 0)
                         {
                             lineObs += std::string(1, ' ');
@@ -7283,20 +7147,25 @@ void Rinex_Printer::log_rinex_obs(std::fstream& out, const Glonass_Gnav_Ephemeri
                     //        lineObs += Rinex_Printer::rightJustify(Rinex_Printer::asString<short>(lli), 1);
                     //    }
 
-                    lineObs += Rinex_Printer::rightJustify(Rinex_Printer::asString<int32_t>(ssi), 1);
+                    lineObs += static_cast<char>('0' + ssi);
 
                     //GLONASS L1 SIGNAL STRENGTH
-                    lineObs += Rinex_Printer::rightJustify(asString(observables_iter->second.CN0_dB_hz, 3), 14);
+                    Rinex_Printer::appendFixed(lineObs, observables_iter->second.CN0_dB_hz, 3, 14);
 
                     if (lineObs.size() < 80) lineObs += std::string(80 - lineObs.size(), ' ');
-                    out << lineObs << std::endl;
+                    obs_record += lineObs;
+                    obs_record += '\n';
                 }
         }
+    // the whole epoch is written at once
+    out.write(obs_record.data(), obs_record.size());
+    out.flush();
 }
 
 
 void Rinex_Printer::log_rinex_obs(std::fstream& out, const Gps_Ephemeris& gps_eph, const Glonass_Gnav_Ephemeris& glonass_gnav_eph, double gps_obs_time, const std::map<int32_t, Gnss_Synchro>& observables)
 {
+    obs_record.clear();
     if (glonass_gnav_eph.d_m)
         {
         }  // avoid warning, not needed
@@ -7475,7 +7344,8 @@ void Rinex_Printer::log_rinex_obs(std::fstream& out, const Gps_Ephemeris& gps_ep
         }
     line += std::string(80 - line.size(), ' ');
     Rinex_Printer::lengthCheck(line);
-    out << line << std::endl;
+    obs_record += line;
+    obs_record += '\n';
 
     // -------- OBSERVATION record
     std::string s;
@@ -7497,7 +7367,7 @@ void Rinex_Printer::log_rinex_obs(std::fstream& out, const Gps_Ephemeris& gps_ep
                 }
 
             // Pseudorange Measurements
-            lineObs += Rinex_Printer::rightJustify(asString(observables_iter->second.Pseudorange_m, 3), 14);
+            Rinex_Printer::appendFixed(lineObs, observables_iter->second.Pseudorange_m, 3, 14);
 
             //Loss of lock indicator (LLI)
             int32_t lli = 0;  // Include in the observation!!
@@ -7512,10 +7382,10 @@ void Rinex_Printer::log_rinex_obs(std::fstream& out, const Gps_Ephemeris& gps_ep
 
             // Signal Strength Indicator (SSI)
             int32_t ssi = Rinex_Printer::signalStrength(observables_iter->second.CN0_dB_hz);
-            lineObs += Rinex_Printer::rightJustify(Rinex_Printer::asString<int32_t>(ssi), 1);
+            lineObs += static_cast<char>('0' + ssi);
 
             // PHASE
-            lineObs += Rinex_Printer::rightJustify(asString(observables_iter->second.Carrier_phase_rads / GPS_TWO_PI, 3), 14);
+            Rinex_Printer::appendFixed(lineObs, observables_iter->second.Carrier_phase_rads / GPS_TWO_PI, 3, 14);
             if (lli == 0)
                 {
                     lineObs += std::string(1, ' ');
@@ -7524,10 +7394,10 @@ void Rinex_Printer::log_rinex_obs(std::fstream& out, const Gps_Ephemeris& gps_ep
             //    {
             //        lineObs += Rinex_Printer::rightJustify(Rinex_Printer::asString<short>(lli), 1);
             //    }
-            lineObs += Rinex_Printer::rightJustify(Rinex_Printer::asString<int32_t>(ssi), 1);
+            lineObs += static_cast<char>('0' + ssi);
 
             // DOPPLER
-            lineObs += Rinex_Printer::rightJustify(asString(observables_iter->second.Carrier_Doppler_hz, 3), 14);
+            Rinex_Printer::appendFixed(lineObs, observables_iter->second.Carrier_Doppler_hz, 3, 14);
             if (lli == 0)
                 {
                     lineObs += std::string(1, ' ');
@@ -7536,13 +7406,14 @@ void Rinex_Printer::log_rinex_obs(std::fstream& out, const Gps_Ephemeris& gps_ep
             //    {
             //        lineObs += Rinex_Printer::rightJustify(Rinex_Printer::asString<short>(lli), 1);
             //    }
-            lineObs += Rinex_Printer::rightJustify(Rinex_Printer::asString<int32_t>(ssi), 1);
+            lineObs += static_cast<char>('0' + ssi);
 
             // SIGNAL STRENGTH
-            lineObs += Rinex_Printer::rightJustify(asString(observables_iter->second.CN0_dB_hz, 3), 14);
+            Rinex_Printer::appendFixed(lineObs, observables_iter->second.CN0_dB_hz, 3, 14);
 
             if (lineObs.size() < 80) lineObs += std::string(80 - lineObs.size(), ' ');
-            out << lineObs << std::endl;
+            obs_record += lineObs;
+            obs_record += '\n';
         }
 
     std::pair<std::multimap<uint32_t, Gnss_Synchro>::iterator, std::multimap<uint32_t, Gnss_Synchro>::iterator> ret;
@@ -7562,7 +7433,7 @@ void Rinex_Printer::log_rinex_obs(std::fstream& out, const Gps_Ephemeris& gps_ep
                 {
                     /// \todo Need to account for pseudorange correction for glonass
                     //double leap_seconds = Rinex_Printer::get_leap_second(glonass_gnav_eph, gps_obs_time);
-                    lineObs += Rinex_Printer::rightJustify(asString(iter->second.Pseudorange_m, 3), 14);
+                    Rinex_Printer::appendFixed(lineObs, iter->second.Pseudorange_m, 3, 14);
 
                     //Loss of lock indicator (LLI)
                     int32_t lli = 0;  // Include in the observation!!
@@ -7577,10 +7448,10 @@ void Rinex_Printer::log_rinex_obs(std::fstream& out, const Gps_Ephemeris& gps_ep
 
                     // Signal Strength Indicator (SSI)
                     int32_t ssi = Rinex_Printer::signalStrength(iter->second.CN0_dB_hz);
-                    lineObs += Rinex_Printer::rightJustify(Rinex_Printer::asString<int32_t>(ssi), 1);
+                    lineObs += static_cast<char>('0' + ssi);
 
                     // GLONASS CARRIER PHASE
-                    lineObs += Rinex_Printer::rightJustify(asString(iter->second.Carrier_phase_rads / (GLONASS_TWO_PI), 3), 14);
+                    Rinex_Printer::appendFixed(lineObs, iter->second.Carrier_phase_rads / (GLONASS_TWO_PI), 3, 14);
                     if (lli == 0)
                         {
                             lineObs += std::string(1, ' ');
@@ -7589,10 +7460,10 @@ void Rinex_Printer::log_rinex_obs(std::fstream& out, const Gps_Ephemeris& gps_ep
                     //    {
                     //        lineObs += Rinex_Printer::rightJustify(Rinex_Printer::asString<short>(lli), 1);
                     //    }
-                    lineObs += Rinex_Printer::rightJustify(Rinex_Printer::asString<int32_t>(ssi), 1);
+                    lineObs += static_cast<char>('0' + ssi);
 
                     // GLONASS  DOPPLER
-                    lineObs += Rinex_Printer::rightJustify(asString(iter->second.Carrier_Doppler_hz, 3), 14);
+                    Rinex_Printer::appendFixed(lineObs, iter->second.Carrier_Doppler_hz, 3, 14);
                     if (lli == 0)
                         {
                             lineObs += std::string(1, ' ');
@@ -7601,20 +7472,25 @@ void Rinex_Printer::log_rinex_obs(std::fstream& out, const Gps_Ephemeris& gps_ep
                     //    {
                     //        lineObs += Rinex_Printer::rightJustify(Rinex_Printer::asString<short>(lli), 1);
                     //    }
-                    lineObs += Rinex_Printer::rightJustify(Rinex_Printer::asString<int32_t>(ssi), 1);
+                    lineObs += static_cast<char>('0' + ssi);
 
                     // GLONASS SIGNAL STRENGTH
-                    lineObs += Rinex_Printer::rightJustify(asString(iter->second.CN0_dB_hz, 3), 14);
+                    Rinex_Printer::appendFixed(lineObs, iter->second.CN0_dB_hz, 3, 14);
                 }
 
             if (lineObs.size() < 80) lineObs += std::string(80 - lineObs.size(), ' ');
-            out << lineObs << std::endl;
+            obs_record += lineObs;
+            obs_record += '\n';
         }
+    // the whole epoch is written at once
+    out.write(obs_record.data(), obs_record.size());
+    out.flush();
 }
 
 
 void Rinex_Printer::log_rinex_obs(std::fstream& out, const Gps_CNAV_Ephemeris& gps_eph, const Glonass_Gnav_Ephemeris& glonass_gnav_eph, double gps_obs_time, const std::map<int32_t, Gnss_Synchro>& observables)
 {
+    obs_record.clear();
     if (glonass_gnav_eph.d_m)
         {
         }  // avoid warning, not needed
@@ -7720,7 +7596,8 @@ void Rinex_Printer::log_rinex_obs(std::fstream& out, const Gps_CNAV_Ephemeris& g
 
     line += std::string(80 - line.size(), ' ');
     Rinex_Printer::lengthCheck(line);
-    out << line << std::endl;
+    obs_record += line;
+    obs_record += '\n';
 
     // -------- OBSERVATION record
     std::string s;
@@ -7739,7 +7616,7 @@ void Rinex_Printer::log_rinex_obs(std::fstream& out, const Gps_CNAV_Ephemeris& g
             lineObs += std::to_string(static_cast<int32_t>(observables_iter->second.PRN));
 
             // Pseudorange Measurements
-            lineObs += Rinex_Printer::rightJustify(asString(observables_iter->second.Pseudorange_m, 3), 14);
+            Rinex_Printer::appendFixed(lineObs, observables_iter->second.Pseudorange_m, 3, 14);
 
             //Loss of lock indicator (LLI)
             int32_t lli = 0;  // Include in the observation!!
@@ -7754,10 +7631,10 @@ void Rinex_Printer::log_rinex_obs(std::fstream& out, const Gps_CNAV_Ephemeris& g
 
             // Signal Strength Indicator (SSI)
             int32_t ssi = Rinex_Printer::signalStrength(observables_iter->second.CN0_dB_hz);
-            lineObs += Rinex_Printer::rightJustify(Rinex_Printer::asString<int32_t>(ssi), 1);
+            lineObs += static_cast<char>('0' + ssi);
 
             // PHASE
-            lineObs += Rinex_Printer::rightJustify(asString(observables_iter->second.Carrier_phase_rads / GPS_TWO_PI, 3), 14);
+            Rinex_Printer::appendFixed(lineObs, observables_iter->second.Carrier_phase_rads / GPS_TWO_PI, 3, 14);
             if (lli == 0)
                 {
                     lineObs += std::string(1, ' ');
@@ -7766,10 +7643,10 @@ void Rinex_Printer::log_rinex_obs(std::fstream& out, const Gps_CNAV_Ephemeris& g
             //    {
             //        lineObs += Rinex_Printer::rightJustify(Rinex_Printer::asString<short>(lli), 1);
             //    }
-            lineObs += Rinex_Printer::rightJustify(Rinex_Printer::asString<int32_t>(ssi), 1);
+            lineObs += static_cast<char>('0' + ssi);
 
             // DOPPLER
-            lineObs += Rinex_Printer::rightJustify(asString(observables_iter->second.Carrier_Doppler_hz, 3), 14);
+            Rinex_Printer::appendFixed(lineObs, observables_iter->second.Carrier_Doppler_hz, 3, 14);
             if (lli == 0)
                 {
                     lineObs += std::string(1, ' ');
@@ -7778,13 +7655,14 @@ void Rinex_Printer::log_rinex_obs(std::fstream& out, const Gps_CNAV_Ephemeris& g
             //    {
             //        lineObs += Rinex_Printer::rightJustify(Rinex_Printer::asString<short>(lli), 1);
             //    }
-            lineObs += Rinex_Printer::rightJustify(Rinex_Printer::asString<int32_t>(ssi), 1);
+            lineObs += static_cast<char>('0' + ssi);
 
             // SIGNAL STRENGTH
-            lineObs += Rinex_Printer::rightJustify(asString(observables_iter->second.CN0_dB_hz, 3), 14);
+            Rinex_Printer::appendFixed(lineObs, observables_iter->second.CN0_dB_hz, 3, 14);
 
             if (lineObs.size() < 80) lineObs += std::string(80 - lineObs.size(), ' ');
-            out << lineObs << std::endl;
+            obs_record += lineObs;
+            obs_record += '\n';
         }
 
     std::pair<std::multimap<uint32_t, Gnss_Synchro>::iterator, std::multimap<uint32_t, Gnss_Synchro>::iterator> ret;
@@ -7802,7 +7680,7 @@ void Rinex_Printer::log_rinex_obs(std::fstream& out, const Gps_CNAV_Ephemeris& g
                 {
                     /// \todo Need to account for pseudorange correction for glonass
                     //double leap_seconds = Rinex_Printer::get_leap_second(glonass_gnav_eph, gps_obs_time);
-                    lineObs += Rinex_Printer::rightJustify(asString(iter->second.Pseudorange_m, 3), 14);
+                    Rinex_Printer::appendFixed(lineObs, iter->second.Pseudorange_m, 3, 14);
 
                     //Loss of lock indicator (LLI)
                     int32_t lli = 0;  // Include in the observation!!
@@ -7817,10 +7695,10 @@ void Rinex_Printer::log_rinex_obs(std::fstream& out, const Gps_CNAV_Ephemeris& g
 
                     // Signal Strength Indicator (SSI)
                     int32_t ssi = Rinex_Printer::signalStrength(iter->second.CN0_dB_hz);
-                    lineObs += Rinex_Printer::rightJustify(Rinex_Printer::asString<int32_t>(ssi), 1);
+                    lineObs += static_cast<char>('0' + ssi);
 
                     // GLONASS CARRIER PHASE
-                    lineObs += Rinex_Printer::rightJustify(asString(iter->second.Carrier_phase_rads / (GLONASS_TWO_PI), 3), 14);
+                    Rinex_Printer::appendFixed(lineObs, iter->second.Carrier_phase_rads / (GLONASS_TWO_PI), 3, 14);
                     if (lli == 0)
                         {
                             lineObs += std::string(1, ' ');
@@ -7829,10 +7707,10 @@ void Rinex_Printer::log_rinex_obs(std::fstream& out, const Gps_CNAV_Ephemeris& g
                     //    {
                     //        lineObs += Rinex_Printer::rightJustify(Rinex_Printer::asString<short>(lli), 1);
                     //    }
-                    lineObs += Rinex_Printer::rightJustify(Rinex_Printer::asString<int32_t>(ssi), 1);
+                    lineObs += static_cast<char>('0' + ssi);
 
                     // GLONASS  DOPPLER
-                    lineObs += Rinex_Printer::rightJustify(asString(iter->second.Carrier_Doppler_hz, 3), 14);
+                    Rinex_Printer::appendFixed(lineObs, iter->second.Carrier_Doppler_hz, 3, 14);
                     if (lli == 0)
                         {
                             lineObs += std::string(1, ' ');
@@ -7841,20 +7719,25 @@ void Rinex_Printer::log_rinex_obs(std::fstream& out, const Gps_CNAV_Ephemeris& g
                     //    {
                     //        lineObs += Rinex_Printer::rightJustify(Rinex_Printer::asString<short>(lli), 1);
                     //    }
-                    lineObs += Rinex_Printer::rightJustify(Rinex_Printer::asString<int32_t>(ssi), 1);
+                    lineObs += static_cast<char>('0' + ssi);
 
                     // GLONASS SIGNAL STRENGTH
-                    lineObs += Rinex_Printer::rightJustify(asString(iter->second.CN0_dB_hz, 3), 14);
+                    Rinex_Printer::appendFixed(lineObs, iter->second.CN0_dB_hz, 3, 14);
                 }
 
             if (lineObs.size() < 80) lineObs += std::string(80 - lineObs.size(), ' ');
-            out << lineObs << std::endl;
+            obs_record += lineObs;
+            obs_record += '\n';
         }
+    // the whole epoch is written at once
+    out.write(obs_record.data(), obs_record.size());
+    out.flush();
 }
 
 
 void Rinex_Printer::log_rinex_obs(std::fstream& out, const Galileo_Ephemeris& galileo_eph, const Glonass_Gnav_Ephemeris& glonass_gnav_eph, double galileo_obs_time, const std::map<int32_t, Gnss_Synchro>& observables)
 {
+    obs_record.clear();
     if (glonass_gnav_eph.d_m)
         {
         }  // avoid warning, not needed
@@ -7962,7 +7845,8 @@ void Rinex_Printer::log_rinex_obs(std::fstream& out, const Galileo_Ephemeris& ga
 
     line += std::string(80 - line.size(), ' ');
     Rinex_Printer::lengthCheck(line);
-    out << line << std::endl;
+    obs_record += line;
+    obs_record += '\n';
 
     std::string s;
     std::string lineObs;
@@ -7977,7 +7861,7 @@ void Rinex_Printer::log_rinex_obs(std::fstream& out, const Galileo_Ephemeris& ga
             if (s == "R") lineObs += satelliteSystem["GLONASS"];  // should not happen
             if (static_cast<int32_t>(observables_iter->second.PRN) < 10) lineObs += std::string(1, '0');
             lineObs += std::to_string(static_cast<int32_t>(observables_iter->second.PRN));
-            lineObs += Rinex_Printer::rightJustify(asString(observables_iter->second.Pseudorange_m, 3), 14);
+            Rinex_Printer::appendFixed(lineObs, observables_iter->second.Pseudorange_m, 3, 14);
 
             //Loss of lock indicator (LLI)
             int32_t lli = 0;  // Include in the observation!!
@@ -7992,10 +7876,10 @@ void Rinex_Printer::log_rinex_obs(std::fstream& out, const Galileo_Ephemeris& ga
 
             // Signal Strength Indicator (SSI)
             int32_t ssi = Rinex_Printer::signalStrength(observables_iter->second.CN0_dB_hz);
-            lineObs += Rinex_Printer::rightJustify(Rinex_Printer::asString<int32_t>(ssi), 1);
+            lineObs += static_cast<char>('0' + ssi);
 
             // PHASE
-            lineObs += Rinex_Printer::rightJustify(asString(observables_iter->second.Carrier_phase_rads / GPS_TWO_PI, 3), 14);
+            Rinex_Printer::appendFixed(lineObs, observables_iter->second.Carrier_phase_rads / GPS_TWO_PI, 3, 14);
             if (lli == 0)
                 {
                     lineObs += std::string(1, ' ');
@@ -8004,10 +7888,10 @@ void Rinex_Printer::log_rinex_obs(std::fstream& out, const Galileo_Ephemeris& ga
             //    {
             //        lineObs += Rinex_Printer::rightJustify(Rinex_Printer::asString<short>(lli), 1);
             //    }
-            lineObs += Rinex_Printer::rightJustify(Rinex_Printer::asString<int32_t>(ssi), 1);
+            lineObs += static_cast<char>('0' + ssi);
 
             // DOPPLER
-            lineObs += Rinex_Printer::rightJustify(asString(observables_iter->second.Carrier_Doppler_hz, 3), 14);
+            Rinex_Printer::appendFixed(lineObs, observables_iter->second.Carrier_Doppler_hz, 3, 14);
             if (lli == 0)
                 {
                     lineObs += std::string(1, ' ');
@@ -8016,13 +7900,14 @@ void Rinex_Printer::log_rinex_obs(std::fstream& out, const Galileo_Ephemeris& ga
             //    {
             //        lineObs += Rinex_Printer::rightJustify(Rinex_Printer::asString<short>(lli), 1);
             //    }
-            lineObs += Rinex_Printer::rightJustify(Rinex_Printer::asString<int32_t>(ssi), 1);
+            lineObs += static_cast<char>('0' + ssi);
 
             // SIGNAL STRENGTH
-            lineObs += Rinex_Printer::rightJustify(asString(observables_iter->second.CN0_dB_hz, 3), 14);
+            Rinex_Printer::appendFixed(lineObs, observables_iter->second.CN0_dB_hz, 3, 14);
 
             if (lineObs.size() < 80) lineObs += std::string(80 - lineObs.size(), ' ');
-            out << lineObs << std::endl;
+            obs_record += lineObs;
+            obs_record += '\n';
         }
 
     std::pair<std::multimap<uint32_t, Gnss_Synchro>::iterator, std::multimap<uint32_t, Gnss_Synchro>::iterator> ret;
@@ -8037,7 +7922,7 @@ void Rinex_Printer::log_rinex_obs(std::fstream& out, const Galileo_Ephemeris& ga
             ret = total_glo_map.equal_range(*it);
             for (auto iter = ret.first; iter != ret.second; ++iter)
                 {
-                    lineObs += Rinex_Printer::rightJustify(asString(iter->second.Pseudorange_m, 3), 14);
+                    Rinex_Printer::appendFixed(lineObs, iter->second.Pseudorange_m, 3, 14);
 
                     //Loss of lock indicator (LLI)
                     int32_t lli = 0;  // Include in the observation!!
@@ -8052,10 +7937,10 @@ void Rinex_Printer::log_rinex_obs(std::fstream& out, const Galileo_Ephemeris& ga
 
                     // Signal Strength Indicator (SSI)
                     int32_t ssi = Rinex_Printer::signalStrength(iter->second.CN0_dB_hz);
-                    lineObs += Rinex_Printer::rightJustify(Rinex_Printer::asString<int32_t>(ssi), 1);
+                    lineObs += static_cast<char>('0' + ssi);
 
                     // GLONASS CARRIER PHASE
-                    lineObs += Rinex_Printer::rightJustify(asString(iter->second.Carrier_phase_rads / (GLONASS_TWO_PI), 3), 14);
+                    Rinex_Printer::appendFixed(lineObs, iter->second.Carrier_phase_rads / (GLONASS_TWO_PI), 3, 14);
                     if (lli == 0)
                         {
                             lineObs += std::string(1, ' ');
@@ -8064,10 +7949,10 @@ void Rinex_Printer::log_rinex_obs(std::fstream& out, const Galileo_Ephemeris& ga
                     //    {
                     //        lineObs += Rinex_Printer::rightJustify(Rinex_Printer::asString<short>(lli), 1);
                     //    }
-                    lineObs += Rinex_Printer::rightJustify(Rinex_Printer::asString<int32_t>(ssi), 1);
+                    lineObs += static_cast<char>('0' + ssi);
 
                     // GLONASS  DOPPLER
-                    lineObs += Rinex_Printer::rightJustify(asString(iter->second.Carrier_Doppler_hz, 3), 14);
+                    Rinex_Printer::appendFixed(lineObs, iter->second.Carrier_Doppler_hz, 3, 14);
                     if (lli == 0)
                         {
                             lineObs += std::string(1, ' ');
@@ -8076,20 +7961,25 @@ void Rinex_Printer::log_rinex_obs(std::fstream& out, const Galileo_Ephemeris& ga
                     //    {
                     //        lineObs += Rinex_Printer::rightJustify(Rinex_Printer::asString<short>(lli), 1);
                     //   }
-                    lineObs += Rinex_Printer::rightJustify(Rinex_Printer::asString<int32_t>(ssi), 1);
+                    lineObs += static_cast<char>('0' + ssi);
 
                     // GLONASS SIGNAL STRENGTH
-                    lineObs += Rinex_Printer::rightJustify(asString(iter->second.CN0_dB_hz, 3), 14);
+                    Rinex_Printer::appendFixed(lineObs, iter->second.CN0_dB_hz, 3, 14);
                 }
 
             if (lineObs.size() < 80) lineObs += std::string(80 - lineObs.size(), ' ');
-            out << lineObs << std::endl;
+            obs_record += lineObs;
+            obs_record += '\n';
         }
+    // the whole epoch is written at once
+    out.write(obs_record.data(), obs_record.size());
+    out.flush();
 }
 
 
 void Rinex_Printer::log_rinex_obs(std::fstream& out, const Gps_Ephemeris& eph, const double obs_time, const std::map<int32_t, Gnss_Synchro>& observables)
 {
+    obs_record.clear();
     // RINEX observations timestamps are GPS timestamps.
     std::string line;
 
@@ -8166,7 +8056,8 @@ void Rinex_Printer::log_rinex_obs(std::fstream& out, const Gps_Ephemeris& eph, c
             //line += rightJustify(asString(clockOffset, 12), 15);
             line += std::string(80 - line.size(), ' ');
             Rinex_Printer::lengthCheck(line);
-            out << line << std::endl;
+            obs_record += line;
+            obs_record += '\n';
 
             for (observables_iter = observables.cbegin();
                  observables_iter != observables.cend();
@@ -8177,7 +8068,7 @@ void Rinex_Printer::log_rinex_obs(std::fstream& out, const Gps_Ephemeris& eph, c
                     line.clear();
                     // GPS L1 PSEUDORANGE
                     line += std::string(2, ' ');
-                    lineObs += Rinex_Printer::rightJustify(asString(observables_iter->second.Pseudorange_m, 3), 14);
+                    Rinex_Printer::appendFixed(lineObs, observables_iter->second.Pseudorange_m, 3, 14);
 
                     //Loss of lock indicator (LLI)
                     int32_t lli = 0;  // Include in the observation!!
@@ -8192,9 +8083,9 @@ void Rinex_Printer::log_rinex_obs(std::fstream& out, const Gps_Ephemeris& eph, c
 
                     // Signal Strength Indicator (SSI)
                     int32_t ssi = Rinex_Printer::signalStrength(observables_iter->second.CN0_dB_hz);
-                    lineObs += Rinex_Printer::rightJustify(Rinex_Printer::asString<int32_t>(ssi), 1);
+                    lineObs += static_cast<char>('0' + ssi);
                     // GPS L1 CA PHASE
-                    lineObs += Rinex_Printer::rightJustify(asString(observables_iter->second.Carrier_phase_rads / GPS_TWO_PI, 3), 14);
+                    Rinex_Printer::appendFixed(lineObs, observables_iter->second.Carrier_phase_rads / GPS_TWO_PI, 3, 14);
                     if (lli == 0)
                         {
                             lineObs += std::string(1, ' ');
@@ -8203,9 +8094,9 @@ void Rinex_Printer::log_rinex_obs(std::fstream& out, const Gps_Ephemeris& eph, c
                     //    {
                     //        lineObs += Rinex_Printer::rightJustify(Rinex_Printer::asString<short>(lli), 1);
                     //    }
-                    lineObs += Rinex_Printer::rightJustify(Rinex_Printer::asString<int32_t>(ssi), 1);
+                    lineObs += static_cast<char>('0' + ssi);
                     // GPS L1 CA DOPPLER
-                    lineObs += Rinex_Printer::rightJustify(asString(observables_iter->second.Carrier_Doppler_hz, 3), 14);
+                    Rinex_Printer::appendFixed(lineObs, observables_iter->second.Carrier_Doppler_hz, 3, 14);
                     if (lli == 0)
                         {
                             lineObs += std::string(1, ' ');
@@ -8214,11 +8105,12 @@ void Rinex_Printer::log_rinex_obs(std::fstream& out, const Gps_Ephemeris& eph, c
                     //    {
                     //       lineObs += Rinex_Printer::rightJustify(Rinex_Printer::asString<short>(lli), 1);
                     //   }
-                    lineObs += Rinex_Printer::rightJustify(Rinex_Printer::asString<int32_t>(ssi), 1);
+                    lineObs += static_cast<char>('0' + ssi);
                     //GPS L1 SIGNAL STRENGTH
-                    lineObs += Rinex_Printer::rightJustify(asString(observables_iter->second.CN0_dB_hz, 3), 14);
+                    Rinex_Printer::appendFixed(lineObs, observables_iter->second.CN0_dB_hz, 3, 14);
                     if (lineObs.size() < 80) lineObs += std::string(80 - lineObs.size(), ' ');
-                    out << lineObs << std::endl;
+                    obs_record += lineObs;
+                    obs_record += '\n';
                 }
         }
 
@@ -8265,7 +8157,8 @@ void Rinex_Printer::log_rinex_obs(std::fstream& out, const Gps_Ephemeris& eph, c
 
             line += std::string(80 - line.size(), ' ');
             Rinex_Printer::lengthCheck(line);
-            out << line << std::endl;
+            obs_record += line;
+            obs_record += '\n';
 
             for (observables_iter = observables.cbegin();
                  observables_iter != observables.cend();
@@ -8277,7 +8170,7 @@ void Rinex_Printer::log_rinex_obs(std::fstream& out, const Gps_Ephemeris& eph, c
                     if (static_cast<int32_t>(observables_iter->second.PRN) < 10) lineObs += std::string(1, '0');
                     lineObs += std::to_string(static_cast<int32_t>(observables_iter->second.PRN));
                     //lineObs += std::string(2, ' ');
-                    lineObs += Rinex_Printer::rightJustify(asString(observables_iter->second.Pseudorange_m, 3), 14);
+                    Rinex_Printer::appendFixed(lineObs, observables_iter->second.Pseudorange_m, 3, 14);
 
                     //Loss of lock indicator (LLI)
                     int32_t lli = 0;  // Include in the observation!!
@@ -8292,10 +8185,10 @@ void Rinex_Printer::log_rinex_obs(std::fstream& out, const Gps_Ephemeris& eph, c
 
                     // Signal Strength Indicator (SSI)
                     int32_t ssi = Rinex_Printer::signalStrength(observables_iter->second.CN0_dB_hz);
-                    lineObs += Rinex_Printer::rightJustify(Rinex_Printer::asString<int32_t>(ssi), 1);
+                    lineObs += static_cast<char>('0' + ssi);
 
                     // GPS L1 CA PHASE
-                    lineObs += Rinex_Printer::rightJustify(asString(observables_iter->second.Carrier_phase_rads / GPS_TWO_PI, 3), 14);
+                    Rinex_Printer::appendFixed(lineObs, observables_iter->second.Carrier_phase_rads / GPS_TWO_PI, 3, 14);
                     if (lli == 0)
                         {
                             lineObs += std::string(1, ' ');
@@ -8304,10 +8197,10 @@ void Rinex_Printer::log_rinex_obs(std::fstream& out, const Gps_Ephemeris& eph, c
                     //    {
                     //        lineObs += Rinex_Printer::rightJustify(Rinex_Printer::asString<short>(lli), 1);
                     //    }
-                    lineObs += Rinex_Printer::rightJustify(Rinex_Printer::asString<int32_t>(ssi), 1);
+                    lineObs += static_cast<char>('0' + ssi);
 
                     // GPS L1 CA DOPPLER
-                    lineObs += Rinex_Printer::rightJustify(asString(observables_iter->second.Carrier_Doppler_hz, 3), 14);
+                    Rinex_Printer::appendFixed(lineObs, observables_iter->second.Carrier_Doppler_hz, 3, 14);
                     if (lli == 0)
                         {
                             lineObs += std::string(1, ' ');
@@ -8317,20 +8210,25 @@ void Rinex_Printer::log_rinex_obs(std::fstream& out, const Gps_Ephemeris& eph, c
                     //        lineObs += Rinex_Printer::rightJustify(Rinex_Printer::asString<short>(lli), 1);
                     //    }
 
-                    lineObs += Rinex_Printer::rightJustify(Rinex_Printer::asString<int32_t>(ssi), 1);
+                    lineObs += static_cast<char>('0' + ssi);
 
                     //GPS L1 SIGNAL STRENGTH
-                    lineObs += Rinex_Printer::rightJustify(asString(observables_iter->second.CN0_dB_hz, 3), 14);
+                    Rinex_Printer::appendFixed(lineObs, observables_iter->second.CN0_dB_hz, 3, 14);
 
                     if (lineObs.size() < 80) lineObs += std::string(80 - lineObs.size(), ' ');
-                    out << lineObs << std::endl;
+                    obs_record += lineObs;
+                    obs_record += '\n';
                 }
         }
+    // the whole epoch is written at once
+    out.write(obs_record.data(), obs_record.size());
+    out.flush();
 }
 
 
 void Rinex_Printer::log_rinex_obs(std::fstream& out, const Gps_CNAV_Ephemeris& eph, double obs_time, const std::map<int32_t, Gnss_Synchro>& observables)
 {
+    obs_record.clear();
     // RINEX observations timestamps are GPS timestamps.
     std::string line;
 
@@ -8386,7 +8284,8 @@ void Rinex_Printer::log_rinex_obs(std::fstream& out, const Gps_CNAV_Ephemeris& e
 
     line += std::string(80 - line.size(), ' ');
     Rinex_Printer::lengthCheck(line);
-    out << line << std::endl;
+    obs_record += line;
+    obs_record += '\n';
 
     for (observables_iter = observables.cbegin();
          observables_iter != observables.cend();
@@ -8399,7 +8298,7 @@ void Rinex_Printer::log_rinex_obs(std::fstream& out, const Gps_CNAV_Ephemeris& e
             lineObs += std::to_string(static_cast<int32_t>(observables_iter->second.PRN));
             //lineObs += std::string(2, ' ');
             //GPS L2 PSEUDORANGE
-            lineObs += Rinex_Printer::rightJustify(asString(observables_iter->second.Pseudorange_m, 3), 14);
+            Rinex_Printer::appendFixed(lineObs, observables_iter->second.Pseudorange_m, 3, 14);
 
             //Loss of lock indicator (LLI)
             int32_t lli = 0;  // Include in the observation!!
@@ -8414,10 +8313,10 @@ void Rinex_Printer::log_rinex_obs(std::fstream& out, const Gps_CNAV_Ephemeris& e
 
             // Signal Strength Indicator (SSI)
             int32_t ssi = Rinex_Printer::signalStrength(observables_iter->second.CN0_dB_hz);
-            lineObs += Rinex_Printer::rightJustify(Rinex_Printer::asString<int32_t>(ssi), 1);
+            lineObs += static_cast<char>('0' + ssi);
 
             // GPS L2 PHASE
-            lineObs += Rinex_Printer::rightJustify(asString(observables_iter->second.Carrier_phase_rads / GPS_TWO_PI, 3), 14);
+            Rinex_Printer::appendFixed(lineObs, observables_iter->second.Carrier_phase_rads / GPS_TWO_PI, 3, 14);
             if (lli == 0)
                 {
                     lineObs += std::string(1, ' ');
@@ -8426,10 +8325,10 @@ void Rinex_Printer::log_rinex_obs(std::fstream& out, const Gps_CNAV_Ephemeris& e
             //    {
             //        lineObs += Rinex_Printer::rightJustify(Rinex_Printer::asString<short>(lli), 1);
             //    }
-            lineObs += Rinex_Printer::rightJustify(Rinex_Printer::asString<int32_t>(ssi), 1);
+            lineObs += static_cast<char>('0' + ssi);
 
             // GPS L2 DOPPLER
-            lineObs += Rinex_Printer::rightJustify(asString(observables_iter->second.Carrier_Doppler_hz, 3), 14);
+            Rinex_Printer::appendFixed(lineObs, observables_iter->second.Carrier_Doppler_hz, 3, 14);
             if (lli == 0)
                 {
                     lineObs += std::string(1, ' ');
@@ -8439,19 +8338,24 @@ void Rinex_Printer::log_rinex_obs(std::fstream& out, const Gps_CNAV_Ephemeris& e
             //        lineObs += Rinex_Printer::rightJustify(Rinex_Printer::asString<short>(lli), 1);
             //   }
 
-            lineObs += Rinex_Printer::rightJustify(Rinex_Printer::asString<int32_t>(ssi), 1);
+            lineObs += static_cast<char>('0' + ssi);
 
             //GPS L2 SIGNAL STRENGTH
-            lineObs += Rinex_Printer::rightJustify(asString(observables_iter->second.CN0_dB_hz, 3), 14);
+            Rinex_Printer::appendFixed(lineObs, observables_iter->second.CN0_dB_hz, 3, 14);
 
             if (lineObs.size() < 80) lineObs += std::string(80 - lineObs.size(), ' ');
-            out << lineObs << std::endl;
+            obs_record += lineObs;
+            obs_record += '\n';
         }
+    // the whole epoch is written at once
+    out.write(obs_record.data(), obs_record.size());
+    out.flush();
 }
 
 
 void Rinex_Printer::log_rinex_obs(std::fstream& out, const Gps_Ephemeris& eph, const Gps_CNAV_Ephemeris& eph_cnav, double obs_time, const std::map<int32_t, Gnss_Synchro>& observables)
 {
+    obs_record.clear();
     if (eph_cnav.d_i_0)
         {
         }  // avoid warning, not needed
@@ -8603,7 +8507,8 @@ void Rinex_Printer::log_rinex_obs(std::fstream& out, const Gps_Ephemeris& eph, c
     //line += rightJustify(asString(clockOffset, 12), 15);
     line += std::string(80 - line.size(), ' ');
     Rinex_Printer::lengthCheck(line);
-    out << line << std::endl;
+    obs_record += line;
+    obs_record += '\n';
 
     std::string lineObs;
     std::pair<std::multimap<uint32_t, Gnss_Synchro>::iterator, std::multimap<uint32_t, Gnss_Synchro>::iterator> ret;
@@ -8618,7 +8523,7 @@ void Rinex_Printer::log_rinex_obs(std::fstream& out, const Gps_Ephemeris& eph, c
             ret = total_mmap.equal_range(*it);
             for (auto iter = ret.first; iter != ret.second; ++iter)
                 {
-                    lineObs += Rinex_Printer::rightJustify(asString(iter->second.Pseudorange_m, 3), 14);
+                    Rinex_Printer::appendFixed(lineObs, iter->second.Pseudorange_m, 3, 14);
 
                     //Loss of lock indicator (LLI)
                     int32_t lli = 0;  // Include in the observation!!
@@ -8633,10 +8538,10 @@ void Rinex_Printer::log_rinex_obs(std::fstream& out, const Gps_Ephemeris& eph, c
 
                     // Signal Strength Indicator (SSI)
                     int32_t ssi = Rinex_Printer::signalStrength(iter->second.CN0_dB_hz);
-                    lineObs += Rinex_Printer::rightJustify(Rinex_Printer::asString<int32_t>(ssi), 1);
+                    lineObs += static_cast<char>('0' + ssi);
 
                     // GPS CARRIER PHASE
-                    lineObs += Rinex_Printer::rightJustify(asString(iter->second.Carrier_phase_rads / (GALILEO_TWO_PI), 3), 14);
+                    Rinex_Printer::appendFixed(lineObs, iter->second.Carrier_phase_rads / (GALILEO_TWO_PI), 3, 14);
                     if (lli == 0)
                         {
                             lineObs += std::string(1, ' ');
@@ -8645,10 +8550,10 @@ void Rinex_Printer::log_rinex_obs(std::fstream& out, const Gps_Ephemeris& eph, c
                     //    {
                     //        lineObs += Rinex_Printer::rightJustify(Rinex_Printer::asString<short>(lli), 1);
                     //    }
-                    lineObs += Rinex_Printer::rightJustify(Rinex_Printer::asString<int32_t>(ssi), 1);
+                    lineObs += static_cast<char>('0' + ssi);
 
                     // GPS  DOPPLER
-                    lineObs += Rinex_Printer::rightJustify(asString(iter->second.Carrier_Doppler_hz, 3), 14);
+                    Rinex_Printer::appendFixed(lineObs, iter->second.Carrier_Doppler_hz, 3, 14);
                     if (lli == 0)
                         {
                             lineObs += std::string(1, ' ');
@@ -8657,20 +8562,25 @@ void Rinex_Printer::log_rinex_obs(std::fstream& out, const Gps_Ephemeris& eph, c
                     //    {
                     //        lineObs += Rinex_Printer::rightJustify(Rinex_Printer::asString<short>(lli), 1);
                     //    }
-                    lineObs += Rinex_Printer::rightJustify(Rinex_Printer::asString<int32_t>(ssi), 1);
+                    lineObs += static_cast<char>('0' + ssi);
 
                     // GPS SIGNAL STRENGTH
-                    lineObs += Rinex_Printer::rightJustify(asString(iter->second.CN0_dB_hz, 3), 14);
+                    Rinex_Printer::appendFixed(lineObs, iter->second.CN0_dB_hz, 3, 14);
                 }
 
             if (lineObs.size() < 80) lineObs += std::string(80 - lineObs.size(), ' ');
-            out << lineObs << std::endl;
+            obs_record += lineObs;
+            obs_record += '\n';
         }
+    // the whole epoch is written at once
+    out.write(obs_record.data(), obs_record.size());
+    out.flush();
 }
 
 
 void Rinex_Printer::log_rinex_obs(std::fstream& out, const Galileo_Ephemeris& eph, double obs_time, const std::map<int32_t, Gnss_Synchro>& observables, const std::string& galileo_bands)
 {
+    obs_record.clear();
     // RINEX observations timestamps are Galileo timestamps.
     // See http://gage14.upc.es/gLAB/HTML/Observation_Rinex_v3.01.html
     std::string line;
@@ -8843,7 +8753,8 @@ void Rinex_Printer::log_rinex_obs(std::fstream& out, const Galileo_Ephemeris& ep
     //line += rightJustify(asString(clockOffset, 12), 15);
     line += std::string(80 - line.size(), ' ');
     Rinex_Printer::lengthCheck(line);
-    out << line << std::endl;
+    obs_record += line;
+    obs_record += '\n';
 
     std::string lineObs;
     std::pair<std::multimap<uint32_t, Gnss_Synchro>::iterator, std::multimap<uint32_t, Gnss_Synchro>::iterator> ret;
@@ -8858,7 +8769,7 @@ void Rinex_Printer::log_rinex_obs(std::fstream& out, const Galileo_Ephemeris& ep
             ret = total_map.equal_range(*it);
             for (auto iter = ret.first; iter != ret.second; ++iter)
                 {
-                    lineObs += Rinex_Printer::rightJustify(asString(iter->second.Pseudorange_m, 3), 14);
+                    Rinex_Printer::appendFixed(lineObs, iter->second.Pseudorange_m, 3, 14);
 
                     //Loss of lock indicator (LLI)
                     int32_t lli = 0;  // Include in the observation!!
@@ -8873,10 +8784,10 @@ void Rinex_Printer::log_rinex_obs(std::fstream& out, const Galileo_Ephemeris& ep
 
                     // Signal Strength Indicator (SSI)
                     int32_t ssi = Rinex_Printer::signalStrength(iter->second.CN0_dB_hz);
-                    lineObs += Rinex_Printer::rightJustify(Rinex_Printer::asString<int32_t>(ssi), 1);
+                    lineObs += static_cast<char>('0' + ssi);
 
                     // Galileo CARRIER PHASE
-                    lineObs += Rinex_Printer::rightJustify(asString(iter->second.Carrier_phase_rads / (GALILEO_TWO_PI), 3), 14);
+                    Rinex_Printer::appendFixed(lineObs, iter->second.Carrier_phase_rads / (GALILEO_TWO_PI), 3, 14);
                     if (lli == 0)
                         {
                             lineObs += std::string(1, ' ');
@@ -8885,10 +8796,10 @@ void Rinex_Printer::log_rinex_obs(std::fstream& out, const Galileo_Ephemeris& ep
                     //    {
                     //        lineObs += Rinex_Printer::rightJustify(Rinex_Printer::asString<short>(lli), 1);
                     //    }
-                    lineObs += Rinex_Printer::rightJustify(Rinex_Printer::asString<int32_t>(ssi), 1);
+                    lineObs += static_cast<char>('0' + ssi);
 
                     // Galileo  DOPPLER
-                    lineObs += Rinex_Printer::rightJustify(asString(iter->second.Carrier_Doppler_hz, 3), 14);
+                    Rinex_Printer::appendFixed(lineObs, iter->second.Carrier_Doppler_hz, 3, 14);
                     if (lli == 0)
                         {
                             lineObs += std::string(1, ' ');
@@ -8897,20 +8808,25 @@ void Rinex_Printer::log_rinex_obs(std::fstream& out, const Galileo_Ephemeris& ep
                     //    {
                     //       lineObs += Rinex_Printer::rightJustify(Rinex_Printer::asString<short>(lli), 1);
                     //    }
-                    lineObs += Rinex_Printer::rightJustify(Rinex_Printer::asString<int32_t>(ssi), 1);
+                    lineObs += static_cast<char>('0' + ssi);
 
                     // Galileo SIGNAL STRENGTH
-                    lineObs += Rinex_Printer::rightJustify(asString(iter->second.CN0_dB_hz, 3), 14);
+                    Rinex_Printer::appendFixed(lineObs, iter->second.CN0_dB_hz, 3, 14);
                 }
 
             if (lineObs.size() < 80) lineObs += std::string(80 - lineObs.size(), ' ');
-            out << lineObs << std::endl;
+            obs_record += lineObs;
+            obs_record += '\n';
         }
+    // the whole epoch is written at once
+    out.write(obs_record.data(), obs_record.size());
+    out.flush();
 }
 
 
 void Rinex_Printer::log_rinex_obs(std::fstream& out, const Gps_Ephemeris& gps_eph, const Galileo_Ephemeris& galileo_eph, double gps_obs_time, const std::map<int32_t, Gnss_Synchro>& observables)
 {
+    obs_record.clear();
     if (galileo_eph.e_1)
         {
         }  // avoid warning, not needed
@@ -9037,7 +8953,8 @@ void Rinex_Printer::log_rinex_obs(std::fstream& out, const Gps_Ephemeris& gps_ep
 
     line += std::string(80 - line.size(), ' ');
     Rinex_Printer::lengthCheck(line);
-    out << line << std::endl;
+    obs_record += line;
+    obs_record += '\n';
 
     std::string s;
     std::string lineObs;
@@ -9052,7 +8969,7 @@ void Rinex_Printer::log_rinex_obs(std::fstream& out, const Gps_Ephemeris& gps_ep
             if (s == "E") lineObs += satelliteSystem["Galileo"];  // should not happen
             if (static_cast<int32_t>(observables_iter->second.PRN) < 10) lineObs += std::string(1, '0');
             lineObs += std::to_string(static_cast<int32_t>(observables_iter->second.PRN));
-            lineObs += Rinex_Printer::rightJustify(asString(observables_iter->second.Pseudorange_m, 3), 14);
+            Rinex_Printer::appendFixed(lineObs, observables_iter->second.Pseudorange_m, 3, 14);
 
             //Loss of lock indicator (LLI)
             int32_t lli = 0;  // Include in the observation!!
@@ -9067,10 +8984,10 @@ void Rinex_Printer::log_rinex_obs(std::fstream& out, const Gps_Ephemeris& gps_ep
 
             // Signal Strength Indicator (SSI)
             int32_t ssi = Rinex_Printer::signalStrength(observables_iter->second.CN0_dB_hz);
-            lineObs += Rinex_Printer::rightJustify(Rinex_Printer::asString<int32_t>(ssi), 1);
+            lineObs += static_cast<char>('0' + ssi);
 
             // PHASE
-            lineObs += Rinex_Printer::rightJustify(asString(observables_iter->second.Carrier_phase_rads / GPS_TWO_PI, 3), 14);
+            Rinex_Printer::appendFixed(lineObs, observables_iter->second.Carrier_phase_rads / GPS_TWO_PI, 3, 14);
             if (lli == 0)
                 {
                     lineObs += std::string(1, ' ');
@@ -9079,10 +8996,10 @@ void Rinex_Printer::log_rinex_obs(std::fstream& out, const Gps_Ephemeris& gps_ep
             //    {
             //        lineObs += Rinex_Printer::rightJustify(Rinex_Printer::asString<short>(lli), 1);
             //   }
-            lineObs += Rinex_Printer::rightJustify(Rinex_Printer::asString<int32_t>(ssi), 1);
+            lineObs += static_cast<char>('0' + ssi);
 
             // DOPPLER
-            lineObs += Rinex_Printer::rightJustify(asString(observables_iter->second.Carrier_Doppler_hz, 3), 14);
+            Rinex_Printer::appendFixed(lineObs, observables_iter->second.Carrier_Doppler_hz, 3, 14);
             if (lli == 0)
                 {
                     lineObs += std::string(1, ' ');
@@ -9091,13 +9008,14 @@ void Rinex_Printer::log_rinex_obs(std::fstream& out, const Gps_Ephemeris& gps_ep
             //    {
             //        lineObs += Rinex_Printer::rightJustify(Rinex_Printer::asString<short>(lli), 1);
             //    }
-            lineObs += Rinex_Printer::rightJustify(Rinex_Printer::asString<int32_t>(ssi), 1);
+            lineObs += static_cast<char>('0' + ssi);
 
             // SIGNAL STRENGTH
-            lineObs += Rinex_Printer::rightJustify(asString(observables_iter->second.CN0_dB_hz, 3), 14);
+            Rinex_Printer::appendFixed(lineObs, observables_iter->second.CN0_dB_hz, 3, 14);
 
             if (lineObs.size() < 80) lineObs += std::string(80 - lineObs.size(), ' ');
-            out << lineObs << std::endl;
+            obs_record += lineObs;
+            obs_record += '\n';
         }
 
     std::pair<std::multimap<uint32_t, Gnss_Synchro>::iterator, std::multimap<uint32_t, Gnss_Synchro>::iterator> ret;
@@ -9112,7 +9030,7 @@ void Rinex_Printer::log_rinex_obs(std::fstream& out, const Gps_Ephemeris& gps_ep
             ret = total_gal_map.equal_range(*it);
             for (auto iter = ret.first; iter != ret.second; ++iter)
                 {
-                    lineObs += Rinex_Printer::rightJustify(asString(iter->second.Pseudorange_m, 3), 14);
+                    Rinex_Printer::appendFixed(lineObs, iter->second.Pseudorange_m, 3, 14);
 
                     //Loss of lock indicator (LLI)
                     int32_t lli = 0;  // Include in the observation!!
@@ -9127,10 +9045,10 @@ void Rinex_Printer::log_rinex_obs(std::fstream& out, const Gps_Ephemeris& gps_ep
 
                     // Signal Strength Indicator (SSI)
                     int32_t ssi = Rinex_Printer::signalStrength(iter->second.CN0_dB_hz);
-                    lineObs += Rinex_Printer::rightJustify(Rinex_Printer::asString<int32_t>(ssi), 1);
+                    lineObs += static_cast<char>('0' + ssi);
 
                     // Galileo CARRIER PHASE
-                    lineObs += Rinex_Printer::rightJustify(asString(iter->second.Carrier_phase_rads / (GALILEO_TWO_PI), 3), 14);
+                    Rinex_Printer::appendFixed(lineObs, iter->second.Carrier_phase_rads / (GALILEO_TWO_PI), 3, 14);
                     if (lli == 0)
                         {
                             lineObs += std::string(1, ' ');
@@ -9139,10 +9057,10 @@ void Rinex_Printer::log_rinex_obs(std::fstream& out, const Gps_Ephemeris& gps_ep
                     //    {
                     //        lineObs += Rinex_Printer::rightJustify(Rinex_Printer::asString<short>(lli), 1);
                     //    }
-                    lineObs += Rinex_Printer::rightJustify(Rinex_Printer::asString<int32_t>(ssi), 1);
+                    lineObs += static_cast<char>('0' + ssi);
 
                     // Galileo  DOPPLER
-                    lineObs += Rinex_Printer::rightJustify(asString(iter->second.Carrier_Doppler_hz, 3), 14);
+                    Rinex_Printer::appendFixed(lineObs, iter->second.Carrier_Doppler_hz, 3, 14);
                     if (lli == 0)
                         {
                             lineObs += std::string(1, ' ');
@@ -9151,20 +9069,25 @@ void Rinex_Printer::log_rinex_obs(std::fstream& out, const Gps_Ephemeris& gps_ep
                     //    {
                     //        lineObs += Rinex_Printer::rightJustify(Rinex_Printer::asString<short>(lli), 1);
                     //    }
-                    lineObs += Rinex_Printer::rightJustify(Rinex_Printer::asString<int32_t>(ssi), 1);
+                    lineObs += static_cast<char>('0' + ssi);
 
                     // Galileo SIGNAL STRENGTH
-                    lineObs += Rinex_Printer::rightJustify(asString(iter->second.CN0_dB_hz, 3), 14);
+                    Rinex_Printer::appendFixed(lineObs, iter->second.CN0_dB_hz, 3, 14);
                 }
 
             if (lineObs.size() < 80) lineObs += std::string(80 - lineObs.size(), ' ');
-            out << lineObs << std::endl;
+            obs_record += lineObs;
+            obs_record += '\n';
         }
+    // the whole epoch is written at once
+    out.write(obs_record.data(), obs_record.size());
+    out.flush();
 }
 
 
 void Rinex_Printer::log_rinex_obs(std::fstream& out, const Gps_CNAV_Ephemeris& eph, const Galileo_Ephemeris& galileo_eph, double gps_obs_time, const std::map<int32_t, Gnss_Synchro>& observables)
 {
+    obs_record.clear();
     if (galileo_eph.e_1)
         {
         }  // avoid warning, not needed
@@ -9324,7 +9247,8 @@ void Rinex_Printer::log_rinex_obs(std::fstream& out, const Gps_CNAV_Ephemeris& e
 
     line += std::string(80 - line.size(), ' ');
     Rinex_Printer::lengthCheck(line);
-    out << line << std::endl;
+    obs_record += line;
+    obs_record += '\n';
 
     std::string s;
     std::string lineObs;
@@ -9341,7 +9265,7 @@ void Rinex_Printer::log_rinex_obs(std::fstream& out, const Gps_CNAV_Ephemeris& e
             ret = total_gps_map.equal_range(*it);
             for (auto iter = ret.first; iter != ret.second; ++iter)
                 {
-                    lineObs += Rinex_Printer::rightJustify(asString(iter->second.Pseudorange_m, 3), 14);
+                    Rinex_Printer::appendFixed(lineObs, iter->second.Pseudorange_m, 3, 14);
 
                     //Loss of lock indicator (LLI)
                     int32_t lli = 0;  // Include in the observation!!
@@ -9356,10 +9280,10 @@ void Rinex_Printer::log_rinex_obs(std::fstream& out, const Gps_CNAV_Ephemeris& e
 
                     // Signal Strength Indicator (SSI)
                     int32_t ssi = Rinex_Printer::signalStrength(iter->second.CN0_dB_hz);
-                    lineObs += Rinex_Printer::rightJustify(Rinex_Printer::asString<int32_t>(ssi), 1);
+                    lineObs += static_cast<char>('0' + ssi);
 
                     // CARRIER PHASE
-                    lineObs += Rinex_Printer::rightJustify(asString(iter->second.Carrier_phase_rads / (GALILEO_TWO_PI), 3), 14);
+                    Rinex_Printer::appendFixed(lineObs, iter->second.Carrier_phase_rads / (GALILEO_TWO_PI), 3, 14);
                     if (lli == 0)
                         {
                             lineObs += std::string(1, ' ');
@@ -9368,10 +9292,10 @@ void Rinex_Printer::log_rinex_obs(std::fstream& out, const Gps_CNAV_Ephemeris& e
                     //    {
                     //        lineObs += Rinex_Printer::rightJustify(Rinex_Printer::asString<short>(lli), 1);
                     //    }
-                    lineObs += Rinex_Printer::rightJustify(Rinex_Printer::asString<int32_t>(ssi), 1);
+                    lineObs += static_cast<char>('0' + ssi);
 
                     //  DOPPLER
-                    lineObs += Rinex_Printer::rightJustify(asString(iter->second.Carrier_Doppler_hz, 3), 14);
+                    Rinex_Printer::appendFixed(lineObs, iter->second.Carrier_Doppler_hz, 3, 14);
                     if (lli == 0)
                         {
                             lineObs += std::string(1, ' ');
@@ -9380,13 +9304,14 @@ void Rinex_Printer::log_rinex_obs(std::fstream& out, const Gps_CNAV_Ephemeris& e
                     //    {
                     //        lineObs += Rinex_Printer::rightJustify(Rinex_Printer::asString<short>(lli), 1);
                     //    }
-                    lineObs += Rinex_Printer::rightJustify(Rinex_Printer::asString<int32_t>(ssi), 1);
+                    lineObs += static_cast<char>('0' + ssi);
 
                     // SIGNAL STRENGTH
-                    lineObs += Rinex_Printer::rightJustify(asString(iter->second.CN0_dB_hz, 3), 14);
+                    Rinex_Printer::appendFixed(lineObs, iter->second.CN0_dB_hz, 3, 14);
                 }
 
-            out << lineObs << std::endl;
+            obs_record += lineObs;
+            obs_record += '\n';
         }
 
     for (it = available_gal_prns.begin();
@@ -9400,7 +9325,7 @@ void Rinex_Printer::log_rinex_obs(std::fstream& out, const Gps_CNAV_Ephemeris& e
             ret = total_gal_map.equal_range(*it);
             for (auto iter = ret.first; iter != ret.second; ++iter)
                 {
-                    lineObs += Rinex_Printer::rightJustify(asString(iter->second.Pseudorange_m, 3), 14);
+                    Rinex_Printer::appendFixed(lineObs, iter->second.Pseudorange_m, 3, 14);
 
                     //Loss of lock indicator (LLI)
                     int32_t lli = 0;  // Include in the observation!!
@@ -9415,10 +9340,10 @@ void Rinex_Printer::log_rinex_obs(std::fstream& out, const Gps_CNAV_Ephemeris& e
 
                     // Signal Strength Indicator (SSI)
                     int32_t ssi = Rinex_Printer::signalStrength(iter->second.CN0_dB_hz);
-                    lineObs += Rinex_Printer::rightJustify(Rinex_Printer::asString<int32_t>(ssi), 1);
+                    lineObs += static_cast<char>('0' + ssi);
 
                     // Galileo CARRIER PHASE
-                    lineObs += Rinex_Printer::rightJustify(asString(iter->second.Carrier_phase_rads / (GALILEO_TWO_PI), 3), 14);
+                    Rinex_Printer::appendFixed(lineObs, iter->second.Carrier_phase_rads / (GALILEO_TWO_PI), 3, 14);
                     if (lli == 0)
                         {
                             lineObs += std::string(1, ' ');
@@ -9427,10 +9352,10 @@ void Rinex_Printer::log_rinex_obs(std::fstream& out, const Gps_CNAV_Ephemeris& e
                     //    {
                     //        lineObs += Rinex_Printer::rightJustify(Rinex_Printer::asString<short>(lli), 1);
                     //    }
-                    lineObs += Rinex_Printer::rightJustify(Rinex_Printer::asString<int32_t>(ssi), 1);
+                    lineObs += static_cast<char>('0' + ssi);
 
                     // Galileo  DOPPLER
-                    lineObs += Rinex_Printer::rightJustify(asString(iter->second.Carrier_Doppler_hz, 3), 14);
+                    Rinex_Printer::appendFixed(lineObs, iter->second.Carrier_Doppler_hz, 3, 14);
                     if (lli == 0)
                         {
                             lineObs += std::string(1, ' ');
@@ -9439,20 +9364,25 @@ void Rinex_Printer::log_rinex_obs(std::fstream& out, const Gps_CNAV_Ephemeris& e
                     //    {
                     //        lineObs += Rinex_Printer::rightJustify(Rinex_Printer::asString<short>(lli), 1);
                     //    }
-                    lineObs += Rinex_Printer::rightJustify(Rinex_Printer::asString<int32_t>(ssi), 1);
+                    lineObs += static_cast<char>('0' + ssi);
 
                     // Galileo SIGNAL STRENGTH
-                    lineObs += Rinex_Printer::rightJustify(asString(iter->second.CN0_dB_hz, 3), 14);
+                    Rinex_Printer::appendFixed(lineObs, iter->second.CN0_dB_hz, 3, 14);
                 }
 
             //if (lineObs.size() < 80) lineObs += std::string(80 - lineObs.size(), ' ');
-            out << lineObs << std::endl;
+            obs_record += lineObs;
+            obs_record += '\n';
         }
+    // the whole epoch is written at once
+    out.write(obs_record.data(), obs_record.size());
+    out.flush();
 }
 
 
 void Rinex_Printer::log_rinex_obs(std::fstream& out, const Gps_Ephemeris& gps_eph, const Gps_CNAV_Ephemeris& gps_cnav_eph, const Galileo_Ephemeris& galileo_eph, double gps_obs_time, const std::map<int32_t, Gnss_Synchro>& observables)
 {
+    obs_record.clear();
     if (galileo_eph.e_1)
         {
         }  // avoid warning, not needed
@@ -9633,7 +9563,8 @@ void Rinex_Printer::log_rinex_obs(std::fstream& out, const Gps_Ephemeris& gps_ep
 
     line += std::string(80 - line.size(), ' ');
     Rinex_Printer::lengthCheck(line);
-    out << line << std::endl;
+    obs_record += line;
+    obs_record += '\n';
 
     std::string s;
     std::string lineObs;
@@ -9650,7 +9581,7 @@ void Rinex_Printer::log_rinex_obs(std::fstream& out, const Gps_Ephemeris& gps_ep
             ret = total_gps_map.equal_range(*it);
             for (auto iter = ret.first; iter != ret.second; ++iter)
                 {
-                    lineObs += Rinex_Printer::rightJustify(asString(iter->second.Pseudorange_m, 3), 14);
+                    Rinex_Printer::appendFixed(lineObs, iter->second.Pseudorange_m, 3, 14);
 
                     //Loss of lock indicator (LLI)
                     int32_t lli = 0;  // Include in the observation!!
@@ -9665,10 +9596,10 @@ void Rinex_Printer::log_rinex_obs(std::fstream& out, const Gps_Ephemeris& gps_ep
 
                     // Signal Strength Indicator (SSI)
                     int32_t ssi = Rinex_Printer::signalStrength(iter->second.CN0_dB_hz);
-                    lineObs += Rinex_Printer::rightJustify(Rinex_Printer::asString<int32_t>(ssi), 1);
+                    lineObs += static_cast<char>('0' + ssi);
 
                     // CARRIER PHASE
-                    lineObs += Rinex_Printer::rightJustify(asString(iter->second.Carrier_phase_rads / (GALILEO_TWO_PI), 3), 14);
+                    Rinex_Printer::appendFixed(lineObs, iter->second.Carrier_phase_rads / (GALILEO_TWO_PI), 3, 14);
                     if (lli == 0)
                         {
                             lineObs += std::string(1, ' ');
@@ -9677,10 +9608,10 @@ void Rinex_Printer::log_rinex_obs(std::fstream& out, const Gps_Ephemeris& gps_ep
                     //    {
                     //        lineObs += Rinex_Printer::rightJustify(Rinex_Printer::asString<short>(lli), 1);
                     //    }
-                    lineObs += Rinex_Printer::rightJustify(Rinex_Printer::asString<int32_t>(ssi), 1);
+                    lineObs += static_cast<char>('0' + ssi);
 
                     //  DOPPLER
-                    lineObs += Rinex_Printer::rightJustify(asString(iter->second.Carrier_Doppler_hz, 3), 14);
+                    Rinex_Printer::appendFixed(lineObs, iter->second.Carrier_Doppler_hz, 3, 14);
                     if (lli == 0)
                         {
                             lineObs += std::string(1, ' ');
@@ -9689,13 +9620,14 @@ void Rinex_Printer::log_rinex_obs(std::fstream& out, const Gps_Ephemeris& gps_ep
                     //    {
                     //        lineObs += Rinex_Printer::rightJustify(Rinex_Printer::asString<short>(lli), 1);
                     //    }
-                    lineObs += Rinex_Printer::rightJustify(Rinex_Printer::asString<int32_t>(ssi), 1);
+                    lineObs += static_cast<char>('0' + ssi);
 
                     // SIGNAL STRENGTH
-                    lineObs += Rinex_Printer::rightJustify(asString(iter->second.CN0_dB_hz, 3), 14);
+                    Rinex_Printer::appendFixed(lineObs, iter->second.CN0_dB_hz, 3, 14);
                 }
 
-            out << lineObs << std::endl;
+            obs_record += lineObs;
+            obs_record += '\n';
         }
 
     for (it = available_gal_prns.begin();
@@ -9709,7 +9641,7 @@ void Rinex_Printer::log_rinex_obs(std::fstream& out, const Gps_Ephemeris& gps_ep
             ret = total_gal_map.equal_range(*it);
             for (auto iter = ret.first; iter != ret.second; ++iter)
                 {
-                    lineObs += Rinex_Printer::rightJustify(asString(iter->second.Pseudorange_m, 3), 14);
+                    Rinex_Printer::appendFixed(lineObs, iter->second.Pseudorange_m, 3, 14);
 
                     //Loss of lock indicator (LLI)
                     int32_t lli = 0;  // Include in the observation!!
@@ -9724,10 +9656,10 @@ void Rinex_Printer::log_rinex_obs(std::fstream& out, const Gps_Ephemeris& gps_ep
 
                     // Signal Strength Indicator (SSI)
                     int32_t ssi = Rinex_Printer::signalStrength(iter->second.CN0_dB_hz);
-                    lineObs += Rinex_Printer::rightJustify(Rinex_Printer::asString<int32_t>(ssi), 1);
+                    lineObs += static_cast<char>('0' + ssi);
 
                     // Galileo CARRIER PHASE
-                    lineObs += Rinex_Printer::rightJustify(asString(iter->second.Carrier_phase_rads / (GALILEO_TWO_PI), 3), 14);
+                    Rinex_Printer::appendFixed(lineObs, iter->second.Carrier_phase_rads / (GALILEO_TWO_PI), 3, 14);
                     if (lli == 0)
                         {
                             lineObs += std::string(1, ' ');
@@ -9736,10 +9668,10 @@ void Rinex_Printer::log_rinex_obs(std::fstream& out, const Gps_Ephemeris& gps_ep
                     //    {
                     //        lineObs += Rinex_Printer::rightJustify(Rinex_Printer::asString<short>(lli), 1);
                     //    }
-                    lineObs += Rinex_Printer::rightJustify(Rinex_Printer::asString<int32_t>(ssi), 1);
+                    lineObs += static_cast<char>('0' + ssi);
 
                     // Galileo  DOPPLER
-                    lineObs += Rinex_Printer::rightJustify(asString(iter->second.Carrier_Doppler_hz, 3), 14);
+                    Rinex_Printer::appendFixed(lineObs, iter->second.Carrier_Doppler_hz, 3, 14);
                     if (lli == 0)
                         {
                             lineObs += std::string(1, ' ');
@@ -9748,15 +9680,19 @@ void Rinex_Printer::log_rinex_obs(std::fstream& out, const Gps_Ephemeris& gps_ep
                     //    {
                     //        lineObs += Rinex_Printer::rightJustify(Rinex_Printer::asString<short>(lli), 1);
                     //    }
-                    lineObs += Rinex_Printer::rightJustify(Rinex_Printer::asString<int32_t>(ssi), 1);
+                    lineObs += static_cast<char>('0' + ssi);
 
                     // Galileo SIGNAL STRENGTH
-                    lineObs += Rinex_Printer::rightJustify(asString(iter->second.CN0_dB_hz, 3), 14);
+                    Rinex_Printer::appendFixed(lineObs, iter->second.CN0_dB_hz, 3, 14);
                 }
 
             //if (lineObs.size() < 80) lineObs += std::string(80 - lineObs.size(), ' ');
-            out << lineObs << std::endl;
+            obs_record += lineObs;
+            obs_record += '\n';
         }
+    // the whole epoch is written at once
+    out.write(obs_record.data(), obs_record.size());
+    out.flush();
 }
 
 
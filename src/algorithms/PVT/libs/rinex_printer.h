@@ -60,12 +60,15 @@
 #include "gps_cnav_navigation_message.h"
 #include "gps_navigation_message.h"
 #include <boost/date_time/posix_time/posix_time.hpp>
+#include <algorithm>
 #include <cstdint>
+#include <cstdio>
 #include <fstream>
 #include <iomanip>  // for setprecision
 #include <map>
 #include <sstream>  // for stringstream
 #include <string>
+#include <vector>
 
 class Sbas_Raw_Msg;
 
@@ -418,6 +421,12 @@ private:
      */
     void lengthCheck(const std::string& line);
 
+    /*
+     * Writes back an updated header. Same-length headers are patched in
+     * place; otherwise the body that follows header_bytes is copied once.
+     */
+    void rewrite_header(std::fstream& out, const std::string& filename, const std::vector<std::string>& header, int64_t header_bytes);
+
     double fake_cnav_iode;
 
     /*
@@ -594,11 +603,50 @@ private:
     inline std::string asString(const X x);
 
     inline std::string asFixWidthString(const int x, const int width, char fill_digit);
+
+    /*
+     * Appends a double in fixed notation to line, right-justified in a field
+     * of the specified width. Same output as
+     * rightJustify(asString(x, precision), width), without going through a
+     * stringstream.
+     * @param line string the field is appended to.
+     * @param x double.
+     * @param precision the number of decimal places you want displayed.
+     * @param width length (in characters) of the field.
+     */
+    inline void appendFixed(std::string& line, const double x, const int precision, const std::string::size_type width);
+
+    std::string obs_record;  // reusable buffer with the observation records of one epoch
 };
 
 
 // Implementation of inline functions (modified versions from GPSTk http://www.gpstk.org)
 
+inline void Rinex_Printer::appendFixed(std::string& line,
+    const double x,
+    const int precision,
+    const std::string::size_type width)
+{
+    char buf[64];
+    int len = std::snprintf(buf, sizeof(buf), "%.*f", precision, x);
+    if (len < 0)
+        {
+            len = 0;
+        }
+    std::string::size_type n = std::min(static_cast<std::string::size_type>(len), sizeof(buf) - 1);
+    if (width < n)
+        {
+            // truncate from the left, as rightJustify does
+            line.append(buf + (n - width), width);
+        }
+    else
+        {
+            line.append(width - n, ' ');
+            line.append(buf, n);
+        }
+}
+
+
 inline std::string& Rinex_Printer::leftJustify(std::string& s,
     const std::string::size_type length,
     const char pad)
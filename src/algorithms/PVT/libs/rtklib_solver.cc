@@ -55,10 +55,14 @@
 #include "GLONASS_L1_L2_CA.h"
 #include "GPS_L1_CA.h"
 #include "Galileo_E1.h"
+#include "gnss_profiler.h"
 #include "rtklib_conversions.h"
 #include "rtklib_solution.h"
 #include <glog/logging.h>
 #include <matio.h>
+#include <algorithm>
+#include <cstring>
+#include <iterator>
 #include <utility>
 
 
@@ -68,6 +72,7 @@ rtklib_solver::rtklib_solver(int nchannels, std::string dump_filename, bool flag
 {
     // init empty ephemeris for all the available GNSS channels
     d_nchannels = nchannels;
+    d_corrections_max_age_s = 0.0;
     d_dump_filename = std::move(dump_filename);
     d_flag_dump_enabled = flag_dump_to_file;
     d_flag_dump_mat_enabled = flag_dump_to_mat;
@@ -75,6 +80,13 @@ rtklib_solver::rtklib_solver(int nchannels, std::string dump_filename, bool flag
     this->set_averaging_flag(false);
     rtk_ = rtk;
     for (double &i : dop_) i = 0.0;
+    std::memset(&d_nav_data, 0, sizeof(nav_t));
+    for (auto &i : d_nav_data.lam)
+        {
+            i[0] = SPEED_OF_LIGHT / FREQ1;  // L1/E1
+            i[1] = SPEED_OF_LIGHT / FREQ2;  // L2
+            i[2] = SPEED_OF_LIGHT / FREQ5;  // L5/E5
+        }
     pvt_sol = {{0, 0}, {0, 0, 0, 0, 0, 0}, {0, 0, 0, 0, 0, 0}, {0, 0, 0, 0, 0, 0}, '0', '0', '0', 0, 0, 0};
     ssat_t ssat0 = {0, 0, {0.0}, {0.0}, {0.0}, {'0'}, {'0'}, {'0'}, {'0'}, {'0'}, {}, {}, {}, {}, 0.0, 0.0, 0.0, 0.0, {{{0, 0}}, {{0, 0}}}, {{}, {}}};
     for (auto &i : pvt_ssat)
@@ -398,6 +410,11 @@ bool rtklib_solver::save_matfile()
 
 rtklib_solver::~rtklib_solver()
 {
+    if (d_precise_solver)
+        {
+            d_precise_solver.reset();
+            rtkfree(&d_rtk_single);
+        }
     if (d_dump_file.is_open() == true)
         {
             try
@@ -416,6 +433,69 @@ rtklib_solver::~rtklib_solver()
 }
 
 
+void rtklib_solver::enable_precise_solver_thread(uint32_t queue_size)
+{
+    if (rtk_.opt.mode == PMODE_SINGLE or d_precise_solver)
+        {
+            return;
+        }
+    prcopt_t single_opt = rtk_.opt;
+    single_opt.mode = PMODE_SINGLE;
+    rtkinit(&d_rtk_single, &single_opt);
+    // from now on rtk_ belongs to the solver thread
+    d_precise_solver = std::unique_ptr<Pvt_Precise_Solver>(new Pvt_Precise_Solver(rtk_, d_nav_data, queue_size));
+}
+
+
+void rtklib_solver::enable_corrections_input(const std::string& source, uint32_t baud_rate)
+{
+    // rtk_ must not belong to the precise solver thread yet
+    if (source.empty() or d_corrections or d_precise_solver or ((rtk_.opt.mode != PMODE_STATIC) and (rtk_.opt.mode != PMODE_KINEMA)))
+        {
+            return;
+        }
+    d_corrections_max_age_s = rtk_.opt.maxtdiff;
+    d_corrections = std::unique_ptr<Pvt_Corrections_Input>(new Pvt_Corrections_Input(source, baud_rate));
+}
+
+
+bool rtklib_solver::pop_precise_solution(Pvt_Precise_Solution& solution)
+{
+    if (!d_precise_solver)
+        {
+            return false;
+        }
+    return d_precise_solver->pop_solution(solution);
+}
+
+
+Pvt_Output_Solution rtklib_solver::get_output_solution() const
+{
+    Pvt_Output_Solution solution;
+    solution.latitude_d = get_latitude();
+    solution.longitude_d = get_longitude();
+    solution.height_m = get_height();
+    solution.avg_latitude_d = get_avg_latitude();
+    solution.avg_longitude_d = get_avg_longitude();
+    solution.avg_height_m = get_avg_height();
+    solution.speed_over_ground_m_s = get_speed_over_ground();
+    solution.course_over_ground_d = get_course_over_ground();
+    solution.dop = dop_;
+    solution.position_UTC_time = get_position_UTC_time();
+    solution.latency_s = get_latency_s();
+    solution.pvt_sol = pvt_sol;
+    for (int sat = 1; sat <= MAXSAT; sat++)
+        {
+            const ssat_t &ssat = pvt_ssat[sat - 1];
+            if (ssat.vs and (ssat.azel[1] > 0.0))
+                {
+                    solution.satellites.push_back({sat, {ssat.azel[0], ssat.azel[1]}, ssat.snr[0]});
+                }
+        }
+    return solution;
+}
+
+
 double rtklib_solver::get_gdop() const
 {
     return dop_[0];
@@ -440,9 +520,75 @@ double rtklib_solver::get_vdop() const
 }
 
 
+template <class T, class Conversion>
+const T &rtklib_solver::cached_ephemeris(std::vector<Rtklib_Ephemeris_Cache_Entry<T>> &cache, uint32_t prn, const std::array<double, 6> &key, Conversion convert)
+{
+    if (prn >= cache.size())
+        {
+            cache.resize(prn + 1);
+        }
+    Rtklib_Ephemeris_Cache_Entry<T> &entry = cache[prn];
+    if (!entry.valid or entry.key != key)
+        {
+            // a new ephemeris has been stored in the map since the last conversion
+            entry.eph = convert();
+            entry.key = key;
+            entry.valid = true;
+        }
+    return entry.eph;
+}
+
+
+const eph_t &rtklib_solver::rtklib_ephemeris(const Gps_Ephemeris &gps_eph)
+{
+    const std::array<double, 6> key = {{static_cast<double>(gps_eph.i_GPS_week), static_cast<double>(gps_eph.d_Toe), static_cast<double>(gps_eph.d_Toc),
+        static_cast<double>(gps_eph.d_TOW), static_cast<double>(gps_eph.d_IODE_SF2), static_cast<double>(gps_eph.d_IODC)}};
+    return cached_ephemeris(d_gps_eph_cache, gps_eph.i_satellite_PRN, key, [&gps_eph]() { return eph_to_rtklib(gps_eph); });
+}
+
+
+const eph_t &rtklib_solver::rtklib_ephemeris(const Gps_CNAV_Ephemeris &gps_cnav_eph)
+{
+    const std::array<double, 6> key = {{static_cast<double>(gps_cnav_eph.i_GPS_week), static_cast<double>(gps_cnav_eph.d_Toe1), static_cast<double>(gps_cnav_eph.d_Toe2),
+        static_cast<double>(gps_cnav_eph.d_Toc), static_cast<double>(gps_cnav_eph.d_TOW), 0.0}};
+    return cached_ephemeris(d_gps_cnav_eph_cache, gps_cnav_eph.i_satellite_PRN, key, [&gps_cnav_eph]() { return eph_to_rtklib(gps_cnav_eph); });
+}
+
+
+const eph_t &rtklib_solver::rtklib_ephemeris(const Galileo_Ephemeris &gal_eph)
+{
+    const std::array<double, 6> key = {{static_cast<double>(gal_eph.WN_5), static_cast<double>(gal_eph.t0e_1), static_cast<double>(gal_eph.t0c_4),
+        static_cast<double>(gal_eph.TOW_5), static_cast<double>(gal_eph.IOD_ephemeris), 0.0}};
+    return cached_ephemeris(d_galileo_eph_cache, gal_eph.i_satellite_PRN, key, [&gal_eph]() { return eph_to_rtklib(gal_eph); });
+}
+
+
+const geph_t &rtklib_solver::rtklib_ephemeris(const Glonass_Gnav_Ephemeris &glonass_gnav_eph, const Glonass_Gnav_Utc_Model &gnav_utc)
+{
+    const std::array<double, 6> key = {{glonass_gnav_eph.d_WN, glonass_gnav_eph.d_t_b, glonass_gnav_eph.d_t_k,
+        static_cast<double>(glonass_gnav_eph.i_satellite_slot_number), gnav_utc.d_tau_c, gnav_utc.d_tau_gps}};
+    return cached_ephemeris(d_glonass_gnav_eph_cache, glonass_gnav_eph.i_satellite_PRN, key, [&glonass_gnav_eph, &gnav_utc]() { return eph_to_rtklib(glonass_gnav_eph, gnav_utc); });
+}
+
+
 bool rtklib_solver::get_PVT(const std::map<int, Gnss_Synchro> &gnss_observables_map, bool flag_averaging)
 {
-    std::map<int, Gnss_Synchro>::const_iterator gnss_observables_iter;
+    std::vector<Gnss_Synchro> gnss_observables;
+    std::vector<uint32_t> valid_channels;
+    gnss_observables.reserve(gnss_observables_map.size());
+    valid_channels.reserve(gnss_observables_map.size());
+    for (const auto &observable : gnss_observables_map)
+        {
+            valid_channels.push_back(gnss_observables.size());
+            gnss_observables.push_back(observable.second);
+        }
+    return get_PVT(gnss_observables, valid_channels, flag_averaging);
+}
+
+
+bool rtklib_solver::get_PVT(const std::vector<Gnss_Synchro> &gnss_observables, const std::vector<uint32_t> &valid_channels, bool flag_averaging)
+{
+    Gnss_Profile_Scope profile("rtklib_solver::get_PVT");
     std::map<int, Galileo_Ephemeris>::const_iterator galileo_ephemeris_iter;
     std::map<int, Gps_Ephemeris>::const_iterator gps_ephemeris_iter;
     std::map<int, Gps_CNAV_Ephemeris>::const_iterator gps_cnav_ephemeris_iter;
@@ -457,7 +603,7 @@ bool rtklib_solver::get_PVT(const std::map<int, Gnss_Synchro> &gnss_observables_
     int valid_obs = 0;      // valid observations counter
     int glo_valid_obs = 0;  // GLONASS L1/L2 valid observations counter
 
-    obsd_t obs_data[MAXOBS];
+    obsd_t obs_data[2 * MAXOBS];  // rover, then base station observations
     eph_t eph_data[MAXOBS];
     geph_t geph_data[MAXOBS];
 
@@ -465,15 +611,14 @@ bool rtklib_solver::get_PVT(const std::map<int, Gnss_Synchro> &gnss_observables_
     bool gps_dual_band = false;
     bool band1 = false;
     bool band2 = false;
-    for (gnss_observables_iter = gnss_observables_map.cbegin();
-         gnss_observables_iter != gnss_observables_map.cend();
-         ++gnss_observables_iter)
+    for (uint32_t ch : valid_channels)
         {
-            switch (gnss_observables_iter->second.System)
+            const Gnss_Synchro &gnss_observable = gnss_observables[ch];
+            switch (gnss_observable.System)
                 {
                 case 'G':
                     {
-                        std::string sig_(gnss_observables_iter->second.Signal);
+                        std::string sig_(gnss_observable.Signal);
                         if (sig_ == "1C")
                             {
                                 band1 = true;
@@ -491,35 +636,34 @@ bool rtklib_solver::get_PVT(const std::map<int, Gnss_Synchro> &gnss_observables_
         }
     if (band1 == true and band2 == true) gps_dual_band = true;
 
-    for (gnss_observables_iter = gnss_observables_map.cbegin();
-         gnss_observables_iter != gnss_observables_map.cend();
-         ++gnss_observables_iter)  // CHECK INCONSISTENCY when combining GLONASS + other system
+    for (uint32_t ch : valid_channels)  // CHECK INCONSISTENCY when combining GLONASS + other system
         {
-            switch (gnss_observables_iter->second.System)
+            const Gnss_Synchro &gnss_observable = gnss_observables[ch];
+            switch (gnss_observable.System)
                 {
                 case 'E':
                     {
-                        std::string sig_(gnss_observables_iter->second.Signal);
+                        std::string sig_(gnss_observable.Signal);
                         // Galileo E1
                         if (sig_ == "1B")
                             {
                                 // 1 Gal - find the ephemeris for the current GALILEO SV observation. The SV PRN ID is the map key
-                                galileo_ephemeris_iter = galileo_ephemeris_map.find(gnss_observables_iter->second.PRN);
+                                galileo_ephemeris_iter = galileo_ephemeris_map.find(gnss_observable.PRN);
                                 if (galileo_ephemeris_iter != galileo_ephemeris_map.cend())
                                     {
                                         // convert ephemeris from GNSS-SDR class to RTKLIB structure
-                                        eph_data[valid_obs] = eph_to_rtklib(galileo_ephemeris_iter->second);
+                                        eph_data[valid_obs] = rtklib_ephemeris(galileo_ephemeris_iter->second);
                                         // convert observation from GNSS-SDR class to RTKLIB structure
                                         obsd_t newobs = {{0, 0}, '0', '0', {}, {}, {}, {}, {}, {}};
                                         obs_data[valid_obs + glo_valid_obs] = insert_obs_to_rtklib(newobs,
-                                            gnss_observables_iter->second,
+                                            gnss_observable,
                                             galileo_ephemeris_iter->second.WN_5,
                                             0);
                                         valid_obs++;
                                     }
                                 else  // the ephemeris are not available for this SV
                                     {
-                                        DLOG(INFO) << "No ephemeris data for SV " << gnss_observables_iter->second.PRN;
+                                        DLOG(INFO) << "No ephemeris data for SV " << gnss_observable.PRN;
                                     }
                             }
 
@@ -527,16 +671,16 @@ bool rtklib_solver::get_PVT(const std::map<int, Gnss_Synchro> &gnss_observables_
                         if (sig_ == "5X")
                             {
                                 // 1 Gal - find the ephemeris for the current GALILEO SV observation. The SV PRN ID is the map key
-                                galileo_ephemeris_iter = galileo_ephemeris_map.find(gnss_observables_iter->second.PRN);
+                                galileo_ephemeris_iter = galileo_ephemeris_map.find(gnss_observable.PRN);
                                 if (galileo_ephemeris_iter != galileo_ephemeris_map.cend())
                                     {
                                         bool found_E1_obs = false;
                                         for (int i = 0; i < valid_obs; i++)
                                             {
-                                                if (eph_data[i].sat == (static_cast<int>(gnss_observables_iter->second.PRN + NSATGPS + NSATGLO)))
+                                                if (eph_data[i].sat == (static_cast<int>(gnss_observable.PRN + NSATGPS + NSATGLO)))
                                                     {
                                                         obs_data[i + glo_valid_obs] = insert_obs_to_rtklib(obs_data[i + glo_valid_obs],
-                                                            gnss_observables_iter->second,
+                                                            gnss_observable,
                                                             galileo_ephemeris_iter->second.WN_5,
                                                             2);  // Band 3 (L5/E5)
                                                         found_E1_obs = true;
@@ -547,14 +691,14 @@ bool rtklib_solver::get_PVT(const std::map<int, Gnss_Synchro> &gnss_observables_
                                             {
                                                 // insert Galileo E5 obs as new obs and also insert its ephemeris
                                                 // convert ephemeris from GNSS-SDR class to RTKLIB structure
-                                                eph_data[valid_obs] = eph_to_rtklib(galileo_ephemeris_iter->second);
+                                                eph_data[valid_obs] = rtklib_ephemeris(galileo_ephemeris_iter->second);
                                                 // convert observation from GNSS-SDR class to RTKLIB structure
                                                 auto default_code_ = static_cast<unsigned char>(CODE_NONE);
                                                 obsd_t newobs = {{0, 0}, '0', '0', {}, {},
                                                     {default_code_, default_code_, default_code_},
                                                     {}, {0.0, 0.0, 0.0}, {}};
                                                 obs_data[valid_obs + glo_valid_obs] = insert_obs_to_rtklib(newobs,
-                                                    gnss_observables_iter->second,
+                                                    gnss_observable,
                                                     galileo_ephemeris_iter->second.WN_5,
                                                     2);  // Band 3 (L5/E5)
                                                 valid_obs++;
@@ -562,7 +706,7 @@ bool rtklib_solver::get_PVT(const std::map<int, Gnss_Synchro> &gnss_observables_
                                     }
                                 else  // the ephemeris are not available for this SV
                                     {
-                                        DLOG(INFO) << "No ephemeris data for SV " << gnss_observables_iter->second.PRN;
+                                        DLOG(INFO) << "No ephemeris data for SV " << gnss_observable.PRN;
                                     }
                             }
                         break;
@@ -571,35 +715,35 @@ bool rtklib_solver::get_PVT(const std::map<int, Gnss_Synchro> &gnss_observables_
                     {
                         // GPS L1
                         // 1 GPS - find the ephemeris for the current GPS SV observation. The SV PRN ID is the map key
-                        std::string sig_(gnss_observables_iter->second.Signal);
+                        std::string sig_(gnss_observable.Signal);
                         if (sig_ == "1C")
                             {
-                                gps_ephemeris_iter = gps_ephemeris_map.find(gnss_observables_iter->second.PRN);
+                                gps_ephemeris_iter = gps_ephemeris_map.find(gnss_observable.PRN);
                                 if (gps_ephemeris_iter != gps_ephemeris_map.cend())
                                     {
                                         // convert ephemeris from GNSS-SDR class to RTKLIB structure
-                                        eph_data[valid_obs] = eph_to_rtklib(gps_ephemeris_iter->second);
+                                        eph_data[valid_obs] = rtklib_ephemeris(gps_ephemeris_iter->second);
                                         // convert observation from GNSS-SDR class to RTKLIB structure
                                         obsd_t newobs = {{0, 0}, '0', '0', {}, {}, {}, {}, {}, {}};
                                         obs_data[valid_obs + glo_valid_obs] = insert_obs_to_rtklib(newobs,
-                                            gnss_observables_iter->second,
+                                            gnss_observable,
                                             gps_ephemeris_iter->second.i_GPS_week,
                                             0);
                                         valid_obs++;
                                     }
                                 else  // the ephemeris are not available for this SV
                                     {
-                                        DLOG(INFO) << "No ephemeris data for SV " << gnss_observables_iter->first;
+                                        DLOG(INFO) << "No ephemeris data for SV " << ch;
                                     }
                             }
                         // GPS L2 (todo: solve NAV/CNAV clash)
                         if ((sig_ == "2S") and (gps_dual_band == false))
                             {
-                                gps_cnav_ephemeris_iter = gps_cnav_ephemeris_map.find(gnss_observables_iter->second.PRN);
+                                gps_cnav_ephemeris_iter = gps_cnav_ephemeris_map.find(gnss_observable.PRN);
                                 if (gps_cnav_ephemeris_iter != gps_cnav_ephemeris_map.cend())
                                     {
                                         // 1. Find the same satellite in GPS L1 band
-                                        gps_ephemeris_iter = gps_ephemeris_map.find(gnss_observables_iter->second.PRN);
+                                        gps_ephemeris_iter = gps_ephemeris_map.find(gnss_observable.PRN);
                                         if (gps_ephemeris_iter != gps_ephemeris_map.cend())
                                             {
                                                 /* By the moment, GPS L2 observables are not used in pseudorange computations if GPS L1 is available
@@ -607,11 +751,11 @@ bool rtklib_solver::get_PVT(const std::map<int, Gnss_Synchro> &gnss_observables_
                                                 // (more precise!), and attach the L2 observation to the L1 observation in RTKLIB structure
                                                 for (int i = 0; i < valid_obs; i++)
                                                     {
-                                                        if (eph_data[i].sat == static_cast<int>(gnss_observables_iter->second.PRN))
+                                                        if (eph_data[i].sat == static_cast<int>(gnss_observable.PRN))
                                                             {
-                                                                eph_data[i] = eph_to_rtklib(gps_cnav_ephemeris_iter->second);
+                                                                eph_data[i] = rtklib_ephemeris(gps_cnav_ephemeris_iter->second);
                                                                 obs_data[i + glo_valid_obs] = insert_obs_to_rtklib(obs_data[i + glo_valid_obs],
-                                                                    gnss_observables_iter->second,
+                                                                    gnss_observable,
                                                                     eph_data[i].week,
                                                                     1);  // Band 2 (L2)
                                                                 break;
@@ -623,14 +767,14 @@ bool rtklib_solver::get_PVT(const std::map<int, Gnss_Synchro> &gnss_observables_
                                             {
                                                 // 3. If not found, insert the GPS L2 ephemeris and the observation
                                                 // convert ephemeris from GNSS-SDR class to RTKLIB structure
-                                                eph_data[valid_obs] = eph_to_rtklib(gps_cnav_ephemeris_iter->second);
+                                                eph_data[valid_obs] = rtklib_ephemeris(gps_cnav_ephemeris_iter->second);
                                                 // convert observation from GNSS-SDR class to RTKLIB structure
                                                 auto default_code_ = static_cast<unsigned char>(CODE_NONE);
                                                 obsd_t newobs = {{0, 0}, '0', '0', {}, {},
                                                     {default_code_, default_code_, default_code_},
                                                     {}, {0.0, 0.0, 0.0}, {}};
                                                 obs_data[valid_obs + glo_valid_obs] = insert_obs_to_rtklib(newobs,
-                                                    gnss_observables_iter->second,
+                                                    gnss_observable,
                                                     gps_cnav_ephemeris_iter->second.i_GPS_week,
                                                     1);  // Band 2 (L2)
                                                 valid_obs++;
@@ -638,28 +782,28 @@ bool rtklib_solver::get_PVT(const std::map<int, Gnss_Synchro> &gnss_observables_
                                     }
                                 else  // the ephemeris are not available for this SV
                                     {
-                                        DLOG(INFO) << "No ephemeris data for SV " << gnss_observables_iter->second.PRN;
+                                        DLOG(INFO) << "No ephemeris data for SV " << gnss_observable.PRN;
                                     }
                             }
                         // GPS L5
                         if (sig_ == "L5")
                             {
-                                gps_cnav_ephemeris_iter = gps_cnav_ephemeris_map.find(gnss_observables_iter->second.PRN);
+                                gps_cnav_ephemeris_iter = gps_cnav_ephemeris_map.find(gnss_observable.PRN);
                                 if (gps_cnav_ephemeris_iter != gps_cnav_ephemeris_map.cend())
                                     {
                                         // 1. Find the same satellite in GPS L1 band
-                                        gps_ephemeris_iter = gps_ephemeris_map.find(gnss_observables_iter->second.PRN);
+                                        gps_ephemeris_iter = gps_ephemeris_map.find(gnss_observable.PRN);
                                         if (gps_ephemeris_iter != gps_ephemeris_map.cend())
                                             {
                                                 // 2. If found, replace the existing GPS L1 ephemeris with the GPS L5 ephemeris
                                                 // (more precise!), and attach the L5 observation to the L1 observation in RTKLIB structure
                                                 for (int i = 0; i < valid_obs; i++)
                                                     {
-                                                        if (eph_data[i].sat == static_cast<int>(gnss_observables_iter->second.PRN))
+                                                        if (eph_data[i].sat == static_cast<int>(gnss_observable.PRN))
                                                             {
-                                                                eph_data[i] = eph_to_rtklib(gps_cnav_ephemeris_iter->second);
+                                                                eph_data[i] = rtklib_ephemeris(gps_cnav_ephemeris_iter->second);
                                                                 obs_data[i + glo_valid_obs] = insert_obs_to_rtklib(obs_data[i],
-                                                                    gnss_observables_iter->second,
+                                                                    gnss_observable,
                                                                     gps_cnav_ephemeris_iter->second.i_GPS_week,
                                                                     2);  // Band 3 (L5)
                                                                 break;
@@ -670,14 +814,14 @@ bool rtklib_solver::get_PVT(const std::map<int, Gnss_Synchro> &gnss_observables_
                                             {
                                                 // 3. If not found, insert the GPS L5 ephemeris and the observation
                                                 // convert ephemeris from GNSS-SDR class to RTKLIB structure
-                                                eph_data[valid_obs] = eph_to_rtklib(gps_cnav_ephemeris_iter->second);
+                                                eph_data[valid_obs] = rtklib_ephemeris(gps_cnav_ephemeris_iter->second);
                                                 // convert observation from GNSS-SDR class to RTKLIB structure
                                                 auto default_code_ = static_cast<unsigned char>(CODE_NONE);
                                                 obsd_t newobs = {{0, 0}, '0', '0', {}, {},
                                                     {default_code_, default_code_, default_code_},
                                                     {}, {0.0, 0.0, 0.0}, {}};
                                                 obs_data[valid_obs + glo_valid_obs] = insert_obs_to_rtklib(newobs,
-                                                    gnss_observables_iter->second,
+                                                    gnss_observable,
                                                     gps_cnav_ephemeris_iter->second.i_GPS_week,
                                                     2);  // Band 3 (L5)
                                                 valid_obs++;
@@ -685,50 +829,50 @@ bool rtklib_solver::get_PVT(const std::map<int, Gnss_Synchro> &gnss_observables_
                                     }
                                 else  // the ephemeris are not available for this SV
                                     {
-                                        DLOG(INFO) << "No ephemeris data for SV " << gnss_observables_iter->second.PRN;
+                                        DLOG(INFO) << "No ephemeris data for SV " << gnss_observable.PRN;
                                     }
                             }
                         break;
                     }
                 case 'R':  //TODO This should be using rtk lib nomenclature
                     {
-                        std::string sig_(gnss_observables_iter->second.Signal);
+                        std::string sig_(gnss_observable.Signal);
                         // GLONASS GNAV L1
                         if (sig_ == "1G")
                             {
                                 // 1 Glo - find the ephemeris for the current GLONASS SV observation. The SV Slot Number (PRN ID) is the map key
-                                glonass_gnav_ephemeris_iter = glonass_gnav_ephemeris_map.find(gnss_observables_iter->second.PRN);
+                                glonass_gnav_ephemeris_iter = glonass_gnav_ephemeris_map.find(gnss_observable.PRN);
                                 if (glonass_gnav_ephemeris_iter != glonass_gnav_ephemeris_map.cend())
                                     {
                                         // convert ephemeris from GNSS-SDR class to RTKLIB structure
-                                        geph_data[glo_valid_obs] = eph_to_rtklib(glonass_gnav_ephemeris_iter->second, gnav_utc);
+                                        geph_data[glo_valid_obs] = rtklib_ephemeris(glonass_gnav_ephemeris_iter->second, gnav_utc);
                                         // convert observation from GNSS-SDR class to RTKLIB structure
                                         obsd_t newobs = {{0, 0}, '0', '0', {}, {}, {}, {}, {}, {}};
                                         obs_data[valid_obs + glo_valid_obs] = insert_obs_to_rtklib(newobs,
-                                            gnss_observables_iter->second,
+                                            gnss_observable,
                                             glonass_gnav_ephemeris_iter->second.d_WN,
                                             0);  // Band 0 (L1)
                                         glo_valid_obs++;
                                     }
                                 else  // the ephemeris are not available for this SV
                                     {
-                                        DLOG(INFO) << "No ephemeris data for SV " << gnss_observables_iter->second.PRN;
+                                        DLOG(INFO) << "No ephemeris data for SV " << gnss_observable.PRN;
                                     }
                             }
                         // GLONASS GNAV L2
                         if (sig_ == "2G")
                             {
                                 // 1 GLONASS - find the ephemeris for the current GLONASS SV observation. The SV PRN ID is the map key
-                                glonass_gnav_ephemeris_iter = glonass_gnav_ephemeris_map.find(gnss_observables_iter->second.PRN);
+                                glonass_gnav_ephemeris_iter = glonass_gnav_ephemeris_map.find(gnss_observable.PRN);
                                 if (glonass_gnav_ephemeris_iter != glonass_gnav_ephemeris_map.cend())
                                     {
                                         bool found_L1_obs = false;
                                         for (int i = 0; i < glo_valid_obs; i++)
                                             {
-                                                if (geph_data[i].sat == (static_cast<int>(gnss_observables_iter->second.PRN + NSATGPS)))
+                                                if (geph_data[i].sat == (static_cast<int>(gnss_observable.PRN + NSATGPS)))
                                                     {
                                                         obs_data[i + valid_obs] = insert_obs_to_rtklib(obs_data[i + valid_obs],
-                                                            gnss_observables_iter->second,
+                                                            gnss_observable,
                                                             glonass_gnav_ephemeris_iter->second.d_WN,
                                                             1);  //Band 1 (L2)
                                                         found_L1_obs = true;
@@ -739,11 +883,11 @@ bool rtklib_solver::get_PVT(const std::map<int, Gnss_Synchro> &gnss_observables_
                                             {
                                                 // insert GLONASS GNAV L2 obs as new obs and also insert its ephemeris
                                                 // convert ephemeris from GNSS-SDR class to RTKLIB structure
-                                                geph_data[glo_valid_obs] = eph_to_rtklib(glonass_gnav_ephemeris_iter->second, gnav_utc);
+                                                geph_data[glo_valid_obs] = rtklib_ephemeris(glonass_gnav_ephemeris_iter->second, gnav_utc);
                                                 // convert observation from GNSS-SDR class to RTKLIB structure
                                                 obsd_t newobs = {{0, 0}, '0', '0', {}, {}, {}, {}, {}, {}};
                                                 obs_data[valid_obs + glo_valid_obs] = insert_obs_to_rtklib(newobs,
-                                                    gnss_observables_iter->second,
+                                                    gnss_observable,
                                                     glonass_gnav_ephemeris_iter->second.d_WN,
                                                     1);  // Band 1 (L2)
                                                 glo_valid_obs++;
@@ -751,7 +895,7 @@ bool rtklib_solver::get_PVT(const std::map<int, Gnss_Synchro> &gnss_observables_
                                     }
                                 else  // the ephemeris are not available for this SV
                                     {
-                                        DLOG(INFO) << "No ephemeris data for SV " << gnss_observables_iter->second.PRN;
+                                        DLOG(INFO) << "No ephemeris data for SV " << gnss_observable.PRN;
                                     }
                             }
                         break;
@@ -770,38 +914,58 @@ bool rtklib_solver::get_PVT(const std::map<int, Gnss_Synchro> &gnss_observables_
     if ((valid_obs + glo_valid_obs) > 3)
         {
             int result = 0;
-            nav_t nav_data;
+            // only the ephemerides of the satellites in view change from epoch to epoch
+            nav_t &nav_data = d_nav_data;
             nav_data.eph = eph_data;
             nav_data.geph = geph_data;
             nav_data.n = valid_obs;
             nav_data.ng = glo_valid_obs;
 
-            for (auto &i : nav_data.lam)
+            // observations of the base station closest in time, already decoded by the corrections thread
+            int rover_obs = valid_obs + glo_valid_obs;
+            int base_obs = 0;
+            const double *base_position = nullptr;
+            if (d_corrections and d_corrections->get_base_epoch(obs_data[0].time, d_corrections_max_age_s, d_base_epoch))
                 {
-                    i[0] = SPEED_OF_LIGHT / FREQ1;  // L1/E1
-                    i[1] = SPEED_OF_LIGHT / FREQ2;  // L2
-                    i[2] = SPEED_OF_LIGHT / FREQ5;  // L5/E5
+                    base_obs = std::min(static_cast<int>(d_base_epoch.obs.size()), MAXOBS);
+                    std::copy(d_base_epoch.obs.begin(), d_base_epoch.obs.begin() + base_obs, obs_data + rover_obs);
+                    if (d_base_epoch.position_valid)
+                        {
+                            base_position = d_base_epoch.position_ecef.data();
+                        }
                 }
 
-            result = rtkpos(&rtk_, obs_data, valid_obs + glo_valid_obs, &nav_data);
+            rtk_t *rtk = &rtk_;
+            if (d_precise_solver)
+                {
+                    // RTK/PPP in the background, single point solution on the fast path
+                    d_precise_solver->push(obs_data, rover_obs + base_obs, eph_data, valid_obs, geph_data, glo_valid_obs, base_position);
+                    rtk = &d_rtk_single;
+                    base_obs = 0;
+                }
+            else if (base_position)
+                {
+                    std::copy(base_position, base_position + 3, rtk_.opt.rb);
+                }
+            result = rtkpos(rtk, obs_data, rover_obs + base_obs, &nav_data);
 
             if (result == 0)
                 {
                     LOG(INFO) << "RTKLIB rtkpos error";
-                    DLOG(INFO) << "RTKLIB rtkpos error message: " << rtk_.errbuf;
+                    DLOG(INFO) << "RTKLIB rtkpos error message: " << rtk->errbuf;
                     this->set_time_offset_s(0.0);  // reset rx time estimation
                     this->set_num_valid_observations(0);
                 }
             else
                 {
-                    this->set_num_valid_observations(rtk_.sol.ns);  // record the number of valid satellites used by the PVT solver
-                    pvt_sol = rtk_.sol;
+                    this->set_num_valid_observations(rtk->sol.ns);  // record the number of valid satellites used by the PVT solver
+                    pvt_sol = rtk->sol;
                     // DOP computation
                     unsigned int used_sats = 0;
                     for (unsigned int i = 0; i < MAXSAT; i++)
                         {
-                            pvt_ssat[i] = rtk_.ssat[i];
-                            if (rtk_.ssat[i].vs == 1)
+                            pvt_ssat[i] = rtk->ssat[i];
+                            if (rtk->ssat[i].vs == 1)
                                 {
                                     used_sats++;
                                 }
@@ -810,7 +974,7 @@ bool rtklib_solver::get_PVT(const std::map<int, Gnss_Synchro> &gnss_observables_
                     std::vector<double> azel;
                     azel.reserve(used_sats * 2);
                     unsigned int index_aux = 0;
-                    for (auto &i : rtk_.ssat)
+                    for (auto &i : rtk->ssat)
                         {
                             if (i.vs == 1)
                                 {
@@ -828,7 +992,7 @@ bool rtklib_solver::get_PVT(const std::map<int, Gnss_Synchro> &gnss_observables_
                     rx_position_and_time(2) = pvt_sol.rr[2];  // [m]
 
                     //todo: fix this ambiguity in the RTKLIB units in receiver clock offset!
-                    if (rtk_.opt.mode == PMODE_SINGLE)
+                    if (rtk->opt.mode == PMODE_SINGLE)
                         {
                             rx_position_and_time(3) = pvt_sol.dtr[0];  // if the RTKLIB solver is set to SINGLE, the dtr is already expressed in [s]
                         }
@@ -858,13 +1022,13 @@ bool rtklib_solver::get_PVT(const std::map<int, Gnss_Synchro> &gnss_observables_
                     //this->set_time_offset_s(offset_s + (rx_position_and_time(3) / GPS_C_m_s));  // accumulate the rx time error for the next iteration [meters]->[seconds]
                     this->set_time_offset_s(rx_position_and_time(3));
 
-                    DLOG(INFO) << "RTKLIB Position at RX TOW = " << gnss_observables_map.begin()->second.RX_time
+                    DLOG(INFO) << "RTKLIB Position at RX TOW = " << gnss_observables[valid_channels.front()].RX_time
                                << " in ECEF (X,Y,Z,t[meters]) = " << rx_position_and_time;
 
                     boost::posix_time::ptime p_time;
                     // gtime_t rtklib_utc_time = gpst2utc(pvt_sol.time); //Corrected RX Time (Non integer multiply of 1 ms of granularity)
                     // Uncorrected RX Time (integer multiply of 1 ms and the same observables time reported in RTCM and RINEX)
-                    gtime_t rtklib_time = gpst2time(adjgpsweek(nav_data.eph[0].week), gnss_observables_map.begin()->second.RX_time);
+                    gtime_t rtklib_time = gpst2time(adjgpsweek(nav_data.eph[0].week), gnss_observables[valid_channels.front()].RX_time);
                     gtime_t rtklib_utc_time = gpst2utc(rtklib_time);
                     p_time = boost::posix_time::from_time_t(rtklib_utc_time.time);
                     p_time += boost::posix_time::microseconds(static_cast<long>(round(rtklib_utc_time.sec * 1e6)));  // NOLINT(google-runtime-int)
@@ -885,13 +1049,13 @@ bool rtklib_solver::get_PVT(const std::map<int, Gnss_Synchro> &gnss_observables_
                                     double tmp_double;
                                     uint32_t tmp_uint32;
                                     // TOW
-                                    tmp_uint32 = gnss_observables_map.begin()->second.TOW_at_current_symbol_ms;
+                                    tmp_uint32 = gnss_observables[valid_channels.front()].TOW_at_current_symbol_ms;
                                     d_dump_file.write(reinterpret_cast<char *>(&tmp_uint32), sizeof(uint32_t));
                                     // WEEK
                                     tmp_uint32 = adjgpsweek(nav_data.eph[0].week);
                                     d_dump_file.write(reinterpret_cast<char *>(&tmp_uint32), sizeof(uint32_t));
                                     // PVT GPS time
-                                    tmp_double = gnss_observables_map.begin()->second.RX_time;
+                                    tmp_double = gnss_observables[valid_channels.front()].RX_time;
                                     d_dump_file.write(reinterpret_cast<char *>(&tmp_double), sizeof(double));
                                     // User clock offset [s]
                                     tmp_double = rx_position_and_time(3);
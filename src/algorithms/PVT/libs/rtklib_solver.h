@@ -61,12 +61,49 @@
 #include "gnss_synchro.h"
 #include "gps_cnav_navigation_message.h"
 #include "gps_navigation_message.h"
+#include "pvt_corrections_input.h"
+#include "pvt_precise_solver.h"
 #include "pvt_solution.h"
 #include "rtklib_rtkpos.h"
 #include <array>
 #include <fstream>
 #include <map>
+#include <memory>
 #include <string>
+#include <vector>
+
+
+/*!
+ * \brief Satellite in view of a solution, as printed in the NMEA GSA and GSV sentences
+ */
+struct Pvt_Output_Satellite
+{
+    int sat;            // RTKLIB satellite number
+    double azel[2];     // azimuth and elevation [rad]
+    unsigned char snr;  // signal strength of the first frequency [0.25 dB-Hz]
+};
+
+
+/*!
+ * \brief Values of a solution printed by the position outputs (KML, GPX,
+ * GeoJSON and NMEA), copied so they can be printed from another thread
+ */
+struct Pvt_Output_Solution
+{
+    double latitude_d;
+    double longitude_d;
+    double height_m;
+    double avg_latitude_d;
+    double avg_longitude_d;
+    double avg_height_m;
+    double speed_over_ground_m_s;
+    double course_over_ground_d;
+    std::array<double, 4> dop;  // GDOP, PDOP, HDOP and VDOP
+    boost::posix_time::ptime position_UTC_time;
+    double latency_s;  // 0 if unknown
+    sol_t pvt_sol;
+    std::vector<Pvt_Output_Satellite> satellites;  // valid satellites above the horizon
+};
 
 
 /*!
@@ -85,6 +122,36 @@ private:
     int d_nchannels;  // Number of available channels for positioning
     std::array<double, 4> dop_;
 
+    // RTKLIB ephemerides, converted once per broadcast ephemeris and reused at every epoch
+    template <class T>
+    struct Rtklib_Ephemeris_Cache_Entry
+    {
+        bool valid;
+        std::array<double, 6> key;  // fields of the GNSS-SDR ephemeris that identify it
+        T eph;
+    };
+    template <class T, class Conversion>
+    const T& cached_ephemeris(std::vector<Rtklib_Ephemeris_Cache_Entry<T>>& cache, uint32_t prn, const std::array<double, 6>& key, Conversion convert);
+    const eph_t& rtklib_ephemeris(const Gps_Ephemeris& gps_eph);
+    const eph_t& rtklib_ephemeris(const Gps_CNAV_Ephemeris& gps_cnav_eph);
+    const eph_t& rtklib_ephemeris(const Galileo_Ephemeris& gal_eph);
+    const geph_t& rtklib_ephemeris(const Glonass_Gnav_Ephemeris& glonass_gnav_eph, const Glonass_Gnav_Utc_Model& gnav_utc);
+    // flat tables indexed by PRN
+    std::vector<Rtklib_Ephemeris_Cache_Entry<eph_t>> d_gps_eph_cache;
+    std::vector<Rtklib_Ephemeris_Cache_Entry<eph_t>> d_gps_cnav_eph_cache;
+    std::vector<Rtklib_Ephemeris_Cache_Entry<eph_t>> d_galileo_eph_cache;
+    std::vector<Rtklib_Ephemeris_Cache_Entry<geph_t>> d_glonass_gnav_eph_cache;
+    nav_t d_nav_data;
+
+    // RTK/PPP epochs solved by their own thread, single point solutions computed with d_rtk_single
+    std::unique_ptr<Pvt_Precise_Solver> d_precise_solver;
+    rtk_t d_rtk_single;
+
+    // base station observations for the relative (RTK) modes
+    std::unique_ptr<Pvt_Corrections_Input> d_corrections;
+    double d_corrections_max_age_s;
+    Pvt_Base_Epoch d_base_epoch;
+
 public:
     sol_t pvt_sol;
     ssat_t pvt_ssat[MAXSAT];
@@ -92,6 +159,34 @@ public:
     ~rtklib_solver();
 
     bool get_PVT(const std::map<int, Gnss_Synchro>& gnss_observables_map, bool flag_averaging);
+
+    /*!
+     * \brief Computes the PVT from the observables of the channels listed in valid_channels,
+     * which index gnss_observables and must be sorted in ascending order
+     */
+    bool get_PVT(const std::vector<Gnss_Synchro>& gnss_observables, const std::vector<uint32_t>& valid_channels, bool flag_averaging);
+    /*!
+     * \brief Returns the values of the current solution printed by the position outputs
+     */
+    Pvt_Output_Solution get_output_solution() const;
+
+    /*!
+     * \brief Hands the RTK/PPP epochs to a Pvt_Precise_Solver thread with a queue
+     * of \p queue_size epochs. get_PVT then computes single point solutions, and
+     * the precise ones are read with pop_precise_solution(). No effect in single mode.
+     */
+    void enable_precise_solver_thread(uint32_t queue_size);
+    bool pop_precise_solution(Pvt_Precise_Solution& solution);
+
+    /*!
+     * \brief Receives the RTCM 3 corrections of a base station from \p source
+     * (see Pvt_Corrections_Input) and adds its observations, and its position
+     * if broadcast, to the epochs solved in the relative modes (Static and
+     * Kinematic). No effect in the other modes, or after
+     * enable_precise_solver_thread().
+     */
+    void enable_corrections_input(const std::string& source, uint32_t baud_rate);
+
     double get_hdop() const;
     double get_vdop() const;
     double get_pdop() const;
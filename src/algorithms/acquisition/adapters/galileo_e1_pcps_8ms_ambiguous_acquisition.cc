@@ -92,7 +92,7 @@ GalileoE1Pcps8msAmbiguousAcquisition::GalileoE1Pcps8msAmbiguousAcquisition(
             item_size_ = sizeof(gr_complex);
             acquisition_cc_ = galileo_pcps_8ms_make_acquisition_cc(sampled_ms_, max_dwells_,
                 doppler_max_, fs_in_, samples_per_ms, code_length_,
-                dump_, dump_filename_);
+                gnss_fft_conf(configuration_, role), dump_, dump_filename_);
             stream_to_vector_ = gr::blocks::stream_to_vector::make(item_size_, vector_length_);
             DLOG(INFO) << "stream_to_vector("
                        << stream_to_vector_->unique_id() << ")";
@@ -106,6 +106,7 @@ GalileoE1Pcps8msAmbiguousAcquisition::GalileoE1Pcps8msAmbiguousAcquisition(
         }
 
     channel_ = 0;
+    cboc_ = false;
     threshold_ = 0.0;
     doppler_step_ = 0;
     gnss_synchro_ = nullptr;
@@ -134,6 +135,7 @@ void GalileoE1Pcps8msAmbiguousAcquisition::stop_acquisition()
 void GalileoE1Pcps8msAmbiguousAcquisition::set_channel(unsigned int channel)
 {
     channel_ = channel;
+    cboc_ = configuration_->property("Acquisition" + std::to_string(channel_) + ".cboc", false);
     if (item_type_ == "gr_complex")
         {
             acquisition_cc_->set_channel(channel_);
@@ -218,13 +220,10 @@ void GalileoE1Pcps8msAmbiguousAcquisition::set_local_code()
 {
     if (item_type_ == "gr_complex")
         {
-            bool cboc = configuration_->property(
-                "Acquisition" + std::to_string(channel_) + ".cboc", false);
-
             auto* code = new std::complex<float>[code_length_];
 
             galileo_e1_code_gen_complex_sampled(code, gnss_synchro_->Signal,
-                cboc, gnss_synchro_->PRN, fs_in_, 0, false);
+                cboc_, gnss_synchro_->PRN, fs_in_, 0, false);
 
             for (unsigned int i = 0; i < sampled_ms_ / 4; i++)
                 {
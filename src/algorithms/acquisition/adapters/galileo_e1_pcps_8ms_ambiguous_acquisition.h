@@ -143,6 +143,7 @@ private:
     unsigned int vector_length_;
     unsigned int code_length_;
     unsigned int channel_;
+    bool cboc_;
     float threshold_;
     unsigned int doppler_max_;
     unsigned int doppler_step_;
@@ -36,6 +36,7 @@
 #include "galileo_e1_signal_processing.h"
 #include "gnss_sdr_flags.h"
 #include <boost/math/distributions/exponential.hpp>
+#include <boost/math/distributions/gamma.hpp>
 #include <glog/logging.h>
 
 
@@ -74,14 +75,24 @@ GalileoE1PcpsAmbiguousAcquisition::GalileoE1PcpsAmbiguousAcquisition(
         }
     bit_transition_flag_ = configuration_->property(role + ".bit_transition_flag", false);
     acq_parameters_.bit_transition_flag = bit_transition_flag_;
+    acq_parameters_.overlap_save = configuration_->property(role + ".overlap_save", false);
     use_CFAR_algorithm_flag_ = configuration_->property(role + ".use_CFAR_algorithm", true);  //will be false in future versions
     acq_parameters_.use_CFAR_algorithm_flag = use_CFAR_algorithm_flag_;
     acquire_pilot_ = configuration_->property(role + ".acquire_pilot", false);  //will be true in future versions
+    acquire_data_pilot_ = configuration_->property(role + ".acquire_data_pilot", false);
+    if (acquire_data_pilot_ and acquire_pilot_)
+        {
+            LOG(WARNING) << role << ": acquire_data_pilot searches both components, acquire_pilot is ignored";
+            acquire_pilot_ = false;
+        }
     max_dwells_ = configuration_->property(role + ".max_dwells", 1);
     acq_parameters_.max_dwells = max_dwells_;
     dump_ = configuration_->property(role + ".dump", false);
     acq_parameters_.dump = dump_;
     acq_parameters_.dump_channel = configuration_->property(role + ".dump_channel", 0);
+    acq_parameters_.dump_queue_size = configuration_->property(role + ".dump_queue_size", 16);
+    acq_parameters_.dump_compression = configuration_->property(role + ".dump_compression", true);
+    acq_parameters_.dump_quantized_grid = configuration_->property(role + ".dump_quantized_grid", false);
     blocking_ = configuration_->property(role + ".blocking", true);
     acq_parameters_.blocking = blocking_;
     dump_filename_ = configuration_->property(role + ".dump_filename", default_dump_filename);
@@ -140,6 +151,23 @@ GalileoE1PcpsAmbiguousAcquisition::GalileoE1PcpsAmbiguousAcquisition(
     acq_parameters_.num_doppler_bins_step2 = configuration_->property(role + ".second_nbins", 4);
     acq_parameters_.doppler_step2 = configuration_->property(role + ".second_doppler_step", 125.0);
     acq_parameters_.make_2_steps = configuration_->property(role + ".make_two_steps", false);
+    acq_parameters_.fine_doppler_interpolation = configuration_->property(role + ".second_step_interpolation", false);
+    acq_parameters_.use_shared_fft = configuration_->property(role + ".use_shared_fft", false);
+    acq_parameters_.on_the_fly_wipeoff = configuration_->property(role + ".on_the_fly_wipeoff", false);
+    acq_parameters_.doppler_fft_shift = (configuration_->property(role + ".doppler_mode", std::string("time")) == "fft_shift");
+    acq_parameters_.doppler_threads = configuration_->property(role + ".doppler_threads", 1);
+    acq_parameters_.fft_conf = gnss_fft_conf(configuration_, role);
+    acq_parameters_.reduced_grid = configuration_->property(role + ".reduced_grid", false);
+    acq_parameters_.folding_factor = configuration_->property(role + ".folding_factor", 1);
+    acq_parameters_.release_buffers = configuration_->property(role + ".release_buffers", true);
+    acq_parameters_.doppler_aiding = configuration_->property(role + ".doppler_aiding", true);
+    acq_parameters_.use_cuda = configuration_->property(role + ".use_cuda", false);
+    if (acq_parameters_.use_cuda and acquire_data_pilot_)
+        {
+            LOG(WARNING) << role << ": CUDA acquisition does not search the data and pilot components together, using the CPU";
+            acq_parameters_.use_cuda = false;
+        }
+    acq_parameters_.cuda_batch_window_us = configuration_->property(role + ".cuda_batch_window_us", 200);
     acq_parameters_.blocking_on_standby = configuration_->property(role + ".blocking_on_standby", false);
     acquisition_ = pcps_make_acquisition(acq_parameters_);
     DLOG(INFO) << "acquisition(" << acquisition_->unique_id() << ")";
@@ -151,6 +179,7 @@ GalileoE1PcpsAmbiguousAcquisition::GalileoE1PcpsAmbiguousAcquisition(
         }
 
     channel_ = 0;
+    cboc_ = false;
     threshold_ = 0.0;
     doppler_step_ = 0;
     gnss_synchro_ = nullptr;
@@ -179,6 +208,7 @@ void GalileoE1PcpsAmbiguousAcquisition::stop_acquisition()
 void GalileoE1PcpsAmbiguousAcquisition::set_channel(unsigned int channel)
 {
     channel_ = channel;
+    cboc_ = configuration_->property("Acquisition" + std::to_string(channel_) + ".cboc", false);
     acquisition_->set_channel(channel_);
 }
 
@@ -243,8 +273,11 @@ void GalileoE1PcpsAmbiguousAcquisition::init()
 
 void GalileoE1PcpsAmbiguousAcquisition::set_local_code()
 {
-    bool cboc = configuration_->property(
-        "Acquisition" + std::to_string(channel_) + ".cboc", false);
+    std::string code_id = std::string(acquire_pilot_ ? "1C" : "1B") + (cboc_ ? "_cboc_" : "_") + std::to_string(gnss_synchro_->PRN) + "_" + std::to_string(acq_parameters_.use_automatic_resampler ? acq_parameters_.resampled_fs : fs_in_);
+    if (acquire_data_pilot_ ? acquisition_->load_local_code(code_id, std::string("1C") + code_id.substr(2)) : acquisition_->load_local_code(code_id))
+        {
+            return;
+        }
 
     auto* code = new std::complex<float>[code_length_];
 
@@ -255,12 +288,12 @@ void GalileoE1PcpsAmbiguousAcquisition::set_local_code()
             if (acq_parameters_.use_automatic_resampler)
                 {
                     galileo_e1_code_gen_complex_sampled(code, pilot_signal,
-                        cboc, gnss_synchro_->PRN, acq_parameters_.resampled_fs, 0, false);
+                        cboc_, gnss_synchro_->PRN, acq_parameters_.resampled_fs, 0, false);
                 }
             else
                 {
                     galileo_e1_code_gen_complex_sampled(code, pilot_signal,
-                        cboc, gnss_synchro_->PRN, fs_in_, 0, false);
+                        cboc_, gnss_synchro_->PRN, fs_in_, 0, false);
                 }
         }
     else
@@ -268,12 +301,12 @@ void GalileoE1PcpsAmbiguousAcquisition::set_local_code()
             if (acq_parameters_.use_automatic_resampler)
                 {
                     galileo_e1_code_gen_complex_sampled(code, gnss_synchro_->Signal,
-                        cboc, gnss_synchro_->PRN, acq_parameters_.resampled_fs, 0, false);
+                        cboc_, gnss_synchro_->PRN, acq_parameters_.resampled_fs, 0, false);
                 }
             else
                 {
                     galileo_e1_code_gen_complex_sampled(code, gnss_synchro_->Signal,
-                        cboc, gnss_synchro_->PRN, fs_in_, 0, false);
+                        cboc_, gnss_synchro_->PRN, fs_in_, 0, false);
                 }
         }
 
@@ -283,7 +316,25 @@ void GalileoE1PcpsAmbiguousAcquisition::set_local_code()
             memcpy(&(code_[i * code_length_]), code, sizeof(gr_complex) * code_length_);
         }
 
-    acquisition_->set_local_code(code_);
+    if (acquire_data_pilot_)
+        {
+            // the pilot component (1C) is searched with the same spectra of the input
+            std::string pilot_code_id = std::string("1C") + code_id.substr(2);
+            char pilot_signal[3] = "1C";
+            auto* pilot_code = new std::complex<float>[vector_length_];
+            galileo_e1_code_gen_complex_sampled(code, pilot_signal,
+                cboc_, gnss_synchro_->PRN, acq_parameters_.use_automatic_resampler ? acq_parameters_.resampled_fs : fs_in_, 0, false);
+            for (unsigned int i = 0; i < sampled_ms_ / 4; i++)
+                {
+                    memcpy(&(pilot_code[i * code_length_]), code, sizeof(gr_complex) * code_length_);
+                }
+            acquisition_->set_local_code(code_, code_id, pilot_code, pilot_code_id);
+            delete[] pilot_code;
+        }
+    else
+        {
+            acquisition_->set_local_code(code_, code_id);
+        }
     delete[] code;
 }
 
@@ -314,8 +365,18 @@ float GalileoE1PcpsAmbiguousAcquisition::calculate_threshold(float pfa)
     double exponent = 1 / static_cast<double>(ncells);
     double val = pow(1.0 - pfa, exponent);
     auto lambda = double(vector_length_);
-    boost::math::exponential_distribution<double> mydist(lambda);
-    auto threshold = static_cast<float>(quantile(mydist, val));
+    float threshold;
+    if (acquire_data_pilot_)
+        {
+            // sum of the squared magnitudes of two independent correlations
+            boost::math::gamma_distribution<double> mydist(2.0, 1.0 / lambda);
+            threshold = static_cast<float>(quantile(mydist, val));
+        }
+    else
+        {
+            boost::math::exponential_distribution<double> mydist(lambda);
+            threshold = static_cast<float>(quantile(mydist, val));
+        }
 
     return threshold;
 }
@@ -158,7 +158,9 @@ private:
     bool bit_transition_flag_;
     bool use_CFAR_algorithm_flag_;
     bool acquire_pilot_;
+    bool acquire_data_pilot_;
     unsigned int channel_;
+    bool cboc_;
     float threshold_;
     unsigned int doppler_max_;
     unsigned int doppler_step_;
@@ -112,6 +112,7 @@ GalileoE1PcpsAmbiguousAcquisitionFpga::GalileoE1PcpsAmbiguousAcquisitionFpga(
     //printf("acq adapter nsamples_total (= vector_length) = %d\n", vector_length);
     unsigned int select_queue_Fpga = configuration_->property(role + ".select_queue_Fpga", 0);
     acq_parameters.select_queue_Fpga = select_queue_Fpga;
+    acq_parameters.pipelined = configuration_->property(role + ".pipelined", false);
     std::string default_device_name = "/dev/uio0";
     std::string device_name = configuration_->property(role + ".devicename", default_device_name);
     acq_parameters.device_name = device_name;
@@ -313,6 +314,7 @@ GalileoE1PcpsAmbiguousAcquisitionFpga::~GalileoE1PcpsAmbiguousAcquisitionFpga()
 
 void GalileoE1PcpsAmbiguousAcquisitionFpga::stop_acquisition()
 {
+    acquisition_fpga_->stop_acquisition();
 }
 
 
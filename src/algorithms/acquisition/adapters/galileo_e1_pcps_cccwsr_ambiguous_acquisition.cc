@@ -93,7 +93,7 @@ GalileoE1PcpsCccwsrAmbiguousAcquisition::GalileoE1PcpsCccwsrAmbiguousAcquisition
             item_size_ = sizeof(gr_complex);
             acquisition_cc_ = pcps_cccwsr_make_acquisition_cc(sampled_ms_, max_dwells_,
                 doppler_max_, fs_in_, samples_per_ms, code_length_,
-                dump_, dump_filename_);
+                gnss_fft_conf(configuration_, role), dump_, dump_filename_);
             stream_to_vector_ = gr::blocks::stream_to_vector::make(item_size_, vector_length_);
             DLOG(INFO) << "stream_to_vector("
                        << stream_to_vector_->unique_id() << ")";
@@ -107,6 +107,7 @@ GalileoE1PcpsCccwsrAmbiguousAcquisition::GalileoE1PcpsCccwsrAmbiguousAcquisition
         }
 
     channel_ = 0;
+    cboc_ = false;
     threshold_ = 0.0;
     doppler_step_ = 0;
     gnss_synchro_ = nullptr;
@@ -136,6 +137,7 @@ void GalileoE1PcpsCccwsrAmbiguousAcquisition::stop_acquisition()
 void GalileoE1PcpsCccwsrAmbiguousAcquisition::set_channel(unsigned int channel)
 {
     channel_ = channel;
+    cboc_ = configuration_->property("Acquisition" + std::to_string(channel_) + ".cboc", false);
     if (item_type_ == "gr_complex")
         {
             acquisition_cc_->set_channel(channel_);
@@ -221,20 +223,17 @@ void GalileoE1PcpsCccwsrAmbiguousAcquisition::set_local_code()
 {
     if (item_type_ == "gr_complex")
         {
-            bool cboc = configuration_->property(
-                "Acquisition" + std::to_string(channel_) + ".cboc", false);
-
             char signal[3];
 
             strcpy(signal, "1B");
 
             galileo_e1_code_gen_complex_sampled(code_data_, signal,
-                cboc, gnss_synchro_->PRN, fs_in_, 0, false);
+                cboc_, gnss_synchro_->PRN, fs_in_, 0, false);
 
             strcpy(signal, "1C");
 
             galileo_e1_code_gen_complex_sampled(code_pilot_, signal,
-                cboc, gnss_synchro_->PRN, fs_in_, 0, false);
+                cboc_, gnss_synchro_->PRN, fs_in_, 0, false);
 
             acquisition_cc_->set_local_code(code_data_, code_pilot_);
         }
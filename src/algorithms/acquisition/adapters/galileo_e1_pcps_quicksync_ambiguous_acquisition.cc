@@ -125,7 +125,7 @@ GalileoE1PcpsQuickSyncAmbiguousAcquisition::GalileoE1PcpsQuickSyncAmbiguousAcqui
             acquisition_cc_ = pcps_quicksync_make_acquisition_cc(folding_factor_,
                 sampled_ms_, max_dwells_, doppler_max_, fs_in_,
                 samples_per_ms, code_length_, bit_transition_flag_,
-                dump_, dump_filename_);
+                gnss_fft_conf(configuration_, role), dump_, dump_filename_);
             stream_to_vector_ = gr::blocks::stream_to_vector::make(item_size_,
                 vector_length_);
             DLOG(INFO) << "stream_to_vector_quicksync("
@@ -140,6 +140,7 @@ GalileoE1PcpsQuickSyncAmbiguousAcquisition::GalileoE1PcpsQuickSyncAmbiguousAcqui
         }
 
     channel_ = 0;
+    cboc_ = false;
     threshold_ = 0.0;
     doppler_step_ = 0;
     gnss_synchro_ = nullptr;
@@ -168,6 +169,7 @@ void GalileoE1PcpsQuickSyncAmbiguousAcquisition::stop_acquisition()
 void GalileoE1PcpsQuickSyncAmbiguousAcquisition::set_channel(unsigned int channel)
 {
     channel_ = channel;
+    cboc_ = configuration_->property("Acquisition" + std::to_string(channel_) + ".cboc", false);
     if (item_type_ == "gr_complex")
         {
             acquisition_cc_->set_channel(channel_);
@@ -252,13 +254,10 @@ void GalileoE1PcpsQuickSyncAmbiguousAcquisition::set_local_code()
 {
     if (item_type_ == "gr_complex")
         {
-            bool cboc = configuration_->property(
-                "Acquisition" + std::to_string(channel_) + ".cboc", false);
-
             auto* code = new std::complex<float>[code_length_];
 
             galileo_e1_code_gen_complex_sampled(code, gnss_synchro_->Signal,
-                cboc, gnss_synchro_->PRN, fs_in_, 0, false);
+                cboc_, gnss_synchro_->PRN, fs_in_, 0, false);
 
 
             for (unsigned int i = 0; i < (sampled_ms_ / (folding_factor_ * 4)); i++)
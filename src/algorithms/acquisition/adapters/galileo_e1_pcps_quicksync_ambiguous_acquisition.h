@@ -147,6 +147,7 @@ private:
     unsigned int code_length_;
     bool bit_transition_flag_;
     unsigned int channel_;
+    bool cboc_;
     float threshold_;
     unsigned int doppler_max_;
     unsigned int doppler_step_;
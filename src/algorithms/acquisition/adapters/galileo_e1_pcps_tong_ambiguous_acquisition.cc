@@ -95,7 +95,7 @@ GalileoE1PcpsTongAmbiguousAcquisition::GalileoE1PcpsTongAmbiguousAcquisition(
             item_size_ = sizeof(gr_complex);
             acquisition_cc_ = pcps_tong_make_acquisition_cc(sampled_ms_, doppler_max_,
                 fs_in_, samples_per_ms, code_length_, tong_init_val_,
-                tong_max_val_, tong_max_dwells_, dump_, dump_filename_);
+                tong_max_val_, tong_max_dwells_, gnss_fft_conf(configuration_, role), dump_, dump_filename_);
 
             stream_to_vector_ = gr::blocks::stream_to_vector::make(item_size_, vector_length_);
             DLOG(INFO) << "stream_to_vector("
@@ -110,6 +110,7 @@ GalileoE1PcpsTongAmbiguousAcquisition::GalileoE1PcpsTongAmbiguousAcquisition(
         }
 
     channel_ = 0;
+    cboc_ = false;
     threshold_ = 0.0;
     doppler_step_ = 0;
     gnss_synchro_ = nullptr;
@@ -138,6 +139,7 @@ void GalileoE1PcpsTongAmbiguousAcquisition::stop_acquisition()
 void GalileoE1PcpsTongAmbiguousAcquisition::set_channel(unsigned int channel)
 {
     channel_ = channel;
+    cboc_ = configuration_->property("Acquisition" + std::to_string(channel_) + ".cboc", false);
     if (item_type_ == "gr_complex")
         {
             acquisition_cc_->set_channel(channel_);
@@ -222,13 +224,10 @@ void GalileoE1PcpsTongAmbiguousAcquisition::set_local_code()
 {
     if (item_type_ == "gr_complex")
         {
-            bool cboc = configuration_->property(
-                "Acquisition" + std::to_string(channel_) + ".cboc", false);
-
             auto* code = new std::complex<float>[code_length_];
 
             galileo_e1_code_gen_complex_sampled(code, gnss_synchro_->Signal,
-                cboc, gnss_synchro_->PRN, fs_in_, 0, false);
+                cboc_, gnss_synchro_->PRN, fs_in_, 0, false);
 
             for (unsigned int i = 0; i < sampled_ms_ / 4; i++)
                 {
@@ -98,6 +98,7 @@ GalileoE5aPcpsAcquisitionFpga::GalileoE5aPcpsAcquisitionFpga(ConfigurationInterf
     unsigned int select_queue_Fpga = configuration_->property(role + ".select_queue_Fpga", 1);
     //printf("select_queue_Fpga = %d\n", select_queue_Fpga);
     acq_parameters.select_queue_Fpga = select_queue_Fpga;
+    acq_parameters.pipelined = configuration_->property(role + ".pipelined", false);
     std::string default_device_name = "/dev/uio0";
     std::string device_name = configuration_->property(role + ".devicename", default_device_name);
     acq_parameters.device_name = device_name;
@@ -223,6 +224,7 @@ GalileoE5aPcpsAcquisitionFpga::~GalileoE5aPcpsAcquisitionFpga()
 
 void GalileoE5aPcpsAcquisitionFpga::stop_acquisition()
 {
+    acquisition_fpga_->stop_acquisition();
 }
 
 
@@ -68,6 +68,9 @@ GlonassL1CaPcpsAcquisition::GlonassL1CaPcpsAcquisition(
     dump_ = configuration_->property(role + ".dump", false);
     acq_parameters.dump = dump_;
     acq_parameters.dump_channel = configuration_->property(role + ".dump_channel", 0);
+    acq_parameters.dump_queue_size = configuration_->property(role + ".dump_queue_size", 16);
+    acq_parameters.dump_compression = configuration_->property(role + ".dump_compression", true);
+    acq_parameters.dump_quantized_grid = configuration_->property(role + ".dump_quantized_grid", false);
     blocking_ = configuration_->property(role + ".blocking", true);
     acq_parameters.blocking = blocking_;
     doppler_max_ = configuration_->property(role + ".doppler_max", 5000);
@@ -77,6 +80,7 @@ GlonassL1CaPcpsAcquisition::GlonassL1CaPcpsAcquisition(
     acq_parameters.sampled_ms = sampled_ms_;
     bit_transition_flag_ = configuration_->property(role + ".bit_transition_flag", false);
     acq_parameters.bit_transition_flag = bit_transition_flag_;
+    acq_parameters.overlap_save = configuration_->property(role + ".overlap_save", false);
     use_CFAR_algorithm_flag_ = configuration_->property(role + ".use_CFAR_algorithm", true);  //will be false in future versions
     acq_parameters.use_CFAR_algorithm_flag = use_CFAR_algorithm_flag_;
     max_dwells_ = configuration_->property(role + ".max_dwells", 1);
@@ -111,6 +115,18 @@ GlonassL1CaPcpsAcquisition::GlonassL1CaPcpsAcquisition(
     acq_parameters.num_doppler_bins_step2 = configuration_->property(role + ".second_nbins", 4);
     acq_parameters.doppler_step2 = configuration_->property(role + ".second_doppler_step", 125.0);
     acq_parameters.make_2_steps = configuration_->property(role + ".make_two_steps", false);
+    acq_parameters.fine_doppler_interpolation = configuration_->property(role + ".second_step_interpolation", false);
+    acq_parameters.use_shared_fft = configuration_->property(role + ".use_shared_fft", false);
+    acq_parameters.on_the_fly_wipeoff = configuration_->property(role + ".on_the_fly_wipeoff", false);
+    acq_parameters.doppler_fft_shift = (configuration_->property(role + ".doppler_mode", std::string("time")) == "fft_shift");
+    acq_parameters.doppler_threads = configuration_->property(role + ".doppler_threads", 1);
+    acq_parameters.fft_conf = gnss_fft_conf(configuration_, role);
+    acq_parameters.reduced_grid = configuration_->property(role + ".reduced_grid", false);
+    acq_parameters.folding_factor = configuration_->property(role + ".folding_factor", 1);
+    acq_parameters.release_buffers = configuration_->property(role + ".release_buffers", true);
+    acq_parameters.doppler_aiding = configuration_->property(role + ".doppler_aiding", true);
+    acq_parameters.use_cuda = configuration_->property(role + ".use_cuda", false);
+    acq_parameters.cuda_batch_window_us = configuration_->property(role + ".cuda_batch_window_us", 200);
     acq_parameters.blocking_on_standby = configuration_->property(role + ".blocking_on_standby", false);
     acquisition_ = pcps_make_acquisition(acq_parameters);
     DLOG(INFO) << "acquisition(" << acquisition_->unique_id() << ")";
@@ -213,6 +229,13 @@ void GlonassL1CaPcpsAcquisition::init()
 
 void GlonassL1CaPcpsAcquisition::set_local_code()
 {
+    // All GLONASS satellites share the same ranging code
+    std::string code_id = "1G_" + std::to_string(fs_in_);
+    if (acquisition_->load_local_code(code_id))
+        {
+            return;
+        }
+
     auto* code = new std::complex<float>[code_length_];
 
     glonass_l1_ca_code_gen_complex_sampled(code, /* gnss_synchro_->PRN,*/ fs_in_, 0);
@@ -223,7 +246,7 @@ void GlonassL1CaPcpsAcquisition::set_local_code()
                 sizeof(gr_complex) * code_length_);
         }
 
-    acquisition_->set_local_code(code_);
+    acquisition_->set_local_code(code_, code_id);
     delete[] code;
 }
 
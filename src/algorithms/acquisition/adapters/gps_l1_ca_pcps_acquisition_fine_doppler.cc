@@ -75,6 +75,7 @@ GpsL1CaPcpsAcquisitionFineDoppler::GpsL1CaPcpsAcquisitionFineDoppler(
     acq_parameters.max_dwells = max_dwells_;
 
     acq_parameters.blocking_on_standby = configuration->property(role + ".blocking_on_standby", false);
+    acq_parameters.fft_conf = gnss_fft_conf(configuration, role);
 
     //--- Find number of samples per spreading code -------------------------
     vector_length_ = round(fs_in_ / (GPS_L1_CA_CODE_RATE_HZ / GPS_L1_CA_CODE_LENGTH_CHIPS));
@@ -82,6 +82,7 @@ GpsL1CaPcpsAcquisitionFpga::GpsL1CaPcpsAcquisitionFpga(
     unsigned int vector_length = nsamples_total;
     unsigned int select_queue_Fpga = configuration_->property(role + ".select_queue_Fpga", 0);
     acq_parameters.select_queue_Fpga = select_queue_Fpga;
+    acq_parameters.pipelined = configuration_->property(role + ".pipelined", false);
     std::string default_device_name = "/dev/uio0";
     std::string device_name = configuration_->property(role + ".devicename", default_device_name);
     acq_parameters.device_name = device_name;
@@ -186,6 +187,7 @@ GpsL1CaPcpsAcquisitionFpga::~GpsL1CaPcpsAcquisitionFpga()
 
 void GpsL1CaPcpsAcquisitionFpga::stop_acquisition()
 {
+    acquisition_fpga_->stop_acquisition();
 }
 
 
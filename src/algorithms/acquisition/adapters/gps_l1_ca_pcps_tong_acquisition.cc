@@ -82,7 +82,7 @@ GpsL1CaPcpsTongAcquisition::GpsL1CaPcpsTongAcquisition(
             item_size_ = sizeof(gr_complex);
             acquisition_cc_ = pcps_tong_make_acquisition_cc(sampled_ms_, doppler_max_, fs_in_,
                 code_length_, code_length_, tong_init_val_, tong_max_val_, tong_max_dwells_,
-                dump_, dump_filename_);
+                gnss_fft_conf(configuration_, role), dump_, dump_filename_);
 
             stream_to_vector_ = gr::blocks::stream_to_vector::make(item_size_, vector_length_);
 
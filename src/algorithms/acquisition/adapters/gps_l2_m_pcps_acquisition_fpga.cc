@@ -95,6 +95,7 @@ GpsL2MPcpsAcquisitionFpga::GpsL2MPcpsAcquisitionFpga(
     unsigned int vector_length = nsamples_total;
     unsigned int select_queue_Fpga = configuration_->property(role + ".select_queue_Fpga", 0);
     acq_parameters.select_queue_Fpga = select_queue_Fpga;
+    acq_parameters.pipelined = configuration_->property(role + ".pipelined", false);
     std::string default_device_name = "/dev/uio0";
     std::string device_name = configuration_->property(role + ".devicename", default_device_name);
     acq_parameters.device_name = device_name;
@@ -209,6 +210,7 @@ GpsL2MPcpsAcquisitionFpga::~GpsL2MPcpsAcquisitionFpga()
 
 void GpsL2MPcpsAcquisitionFpga::stop_acquisition()
 {
+    acquisition_fpga_->stop_acquisition();
 }
 
 
@@ -66,6 +66,9 @@ GpsL5iPcpsAcquisition::GpsL5iPcpsAcquisition(
     dump_ = configuration_->property(role + ".dump", false);
     acq_parameters_.dump = dump_;
     acq_parameters_.dump_channel = configuration_->property(role + ".dump_channel", 0);
+    acq_parameters_.dump_queue_size = configuration_->property(role + ".dump_queue_size", 16);
+    acq_parameters_.dump_compression = configuration_->property(role + ".dump_compression", true);
+    acq_parameters_.dump_quantized_grid = configuration_->property(role + ".dump_quantized_grid", false);
     blocking_ = configuration_->property(role + ".blocking", true);
     acq_parameters_.blocking = blocking_;
     doppler_max_ = configuration->property(role + ".doppler_max", 5000);
@@ -73,6 +76,7 @@ GpsL5iPcpsAcquisition::GpsL5iPcpsAcquisition(
     acq_parameters_.doppler_max = doppler_max_;
     bit_transition_flag_ = configuration_->property(role + ".bit_transition_flag", false);
     acq_parameters_.bit_transition_flag = bit_transition_flag_;
+    acq_parameters_.overlap_save = configuration_->property(role + ".overlap_save", false);
     use_CFAR_algorithm_flag_ = configuration_->property(role + ".use_CFAR_algorithm", true);  //will be false in future versions
     acq_parameters_.use_CFAR_algorithm_flag = use_CFAR_algorithm_flag_;
     max_dwells_ = configuration_->property(role + ".max_dwells", 1);
@@ -96,6 +100,18 @@ GpsL5iPcpsAcquisition::GpsL5iPcpsAcquisition(
     acq_parameters_.num_doppler_bins_step2 = configuration_->property(role + ".second_nbins", 4);
     acq_parameters_.doppler_step2 = configuration_->property(role + ".second_doppler_step", 125.0);
     acq_parameters_.make_2_steps = configuration_->property(role + ".make_two_steps", false);
+    acq_parameters_.fine_doppler_interpolation = configuration_->property(role + ".second_step_interpolation", false);
+    acq_parameters_.use_shared_fft = configuration_->property(role + ".use_shared_fft", false);
+    acq_parameters_.on_the_fly_wipeoff = configuration_->property(role + ".on_the_fly_wipeoff", false);
+    acq_parameters_.doppler_fft_shift = (configuration_->property(role + ".doppler_mode", std::string("time")) == "fft_shift");
+    acq_parameters_.doppler_threads = configuration_->property(role + ".doppler_threads", 1);
+    acq_parameters_.fft_conf = gnss_fft_conf(configuration_, role);
+    acq_parameters_.reduced_grid = configuration_->property(role + ".reduced_grid", false);
+    acq_parameters_.folding_factor = configuration_->property(role + ".folding_factor", 1);
+    acq_parameters_.release_buffers = configuration_->property(role + ".release_buffers", true);
+    acq_parameters_.doppler_aiding = configuration_->property(role + ".doppler_aiding", true);
+    acq_parameters_.use_cuda = configuration_->property(role + ".use_cuda", false);
+    acq_parameters_.cuda_batch_window_us = configuration_->property(role + ".cuda_batch_window_us", 200);
     acq_parameters_.blocking_on_standby = configuration_->property(role + ".blocking_on_standby", false);
     acq_parameters_.use_automatic_resampler = configuration_->property("GNSS-SDR.use_acquisition_resampler", false);
     if (acq_parameters_.use_automatic_resampler == true and item_type_ != "gr_complex")
@@ -238,6 +254,12 @@ void GpsL5iPcpsAcquisition::init()
 
 void GpsL5iPcpsAcquisition::set_local_code()
 {
+    std::string code_id = "L5_" + std::to_string(gnss_synchro_->PRN) + "_" + std::to_string(acq_parameters_.use_automatic_resampler ? acq_parameters_.resampled_fs : fs_in_);
+    if (acquisition_->load_local_code(code_id))
+        {
+            return;
+        }
+
     auto* code = new std::complex<float>[code_length_];
 
 
@@ -256,7 +278,7 @@ void GpsL5iPcpsAcquisition::set_local_code()
                 sizeof(gr_complex) * code_length_);
         }
 
-    acquisition_->set_local_code(code_);
+    acquisition_->set_local_code(code_, code_id);
     delete[] code;
 }
 
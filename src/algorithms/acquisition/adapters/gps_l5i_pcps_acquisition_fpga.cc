@@ -97,6 +97,7 @@ GpsL5iPcpsAcquisitionFpga::GpsL5iPcpsAcquisitionFpga(
     unsigned int vector_length = nsamples_total;
     unsigned int select_queue_Fpga = configuration_->property(role + ".select_queue_Fpga", 1);
     acq_parameters.select_queue_Fpga = select_queue_Fpga;
+    acq_parameters.pipelined = configuration_->property(role + ".pipelined", false);
     std::string default_device_name = "/dev/uio0";
     std::string device_name = configuration_->property(role + ".devicename", default_device_name);
     acq_parameters.device_name = device_name;
@@ -222,6 +223,7 @@ GpsL5iPcpsAcquisitionFpga::~GpsL5iPcpsAcquisitionFpga()
 
 void GpsL5iPcpsAcquisitionFpga::stop_acquisition()
 {
+    acquisition_fpga_->stop_acquisition();
 }
 
 
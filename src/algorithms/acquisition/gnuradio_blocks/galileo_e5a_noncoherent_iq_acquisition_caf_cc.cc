@@ -52,6 +52,7 @@ galileo_e5a_noncoherentIQ_acquisition_caf_cc_sptr galileo_e5a_noncoherentIQ_make
     unsigned int doppler_max, int64_t fs_in,
     int samples_per_ms, int samples_per_code,
     bool bit_transition_flag,
+    const Gnss_Fft_Conf& fft_conf,
     bool dump,
     std::string dump_filename,
     bool both_signal_components_,
@@ -60,7 +61,7 @@ galileo_e5a_noncoherentIQ_acquisition_caf_cc_sptr galileo_e5a_noncoherentIQ_make
 {
     return galileo_e5a_noncoherentIQ_acquisition_caf_cc_sptr(
         new galileo_e5a_noncoherentIQ_acquisition_caf_cc(sampled_ms, max_dwells, doppler_max, fs_in, samples_per_ms,
-            samples_per_code, bit_transition_flag, dump, std::move(dump_filename), both_signal_components_, CAF_window_hz_, Zero_padding_));
+            samples_per_code, bit_transition_flag, fft_conf, dump, std::move(dump_filename), both_signal_components_, CAF_window_hz_, Zero_padding_));
 }
 
 
@@ -72,6 +73,7 @@ galileo_e5a_noncoherentIQ_acquisition_caf_cc::galileo_e5a_noncoherentIQ_acquisit
     int samples_per_ms,
     int samples_per_code,
     bool bit_transition_flag,
+    const Gnss_Fft_Conf& fft_conf,
     bool dump,
     std::string dump_filename,
     bool both_signal_components_,
@@ -146,10 +148,10 @@ galileo_e5a_noncoherentIQ_acquisition_caf_cc::galileo_e5a_noncoherentIQ_acquisit
         }
 
     // Direct FFT
-    d_fft_if = new gr::fft::fft_complex(d_fft_size, true);
+    d_fft_if = new Gnss_Fft(d_fft_size, true, fft_conf);
 
     // Inverse FFT
-    d_ifft = new gr::fft::fft_complex(d_fft_size, false);
+    d_ifft = new Gnss_Fft(d_fft_size, false, fft_conf);
 
     // For dumping samples into a file
     d_dump = dump;
@@ -272,6 +274,21 @@ void galileo_e5a_noncoherentIQ_acquisition_caf_cc::set_local_code(std::complex<f
 }
 
 
+float galileo_e5a_noncoherentIQ_acquisition_caf_cc::correlate(const gr_complex *fft_code, float *magnitude, uint32_t &index_max)
+{
+    // Multiply carrier wiped--off, Fourier transformed incoming signal
+    // with the local FFT'd code reference using SIMD operations with VOLK library
+    volk_32fc_x2_multiply_32fc(d_ifft->get_inbuf(), d_fft_if->get_outbuf(), fft_code, d_fft_size);
+
+    // compute the inverse FFT
+    d_ifft->execute();
+
+    // Squared magnitude and its maximum, in the same pass
+    volk_gnsssdr_32fc_magnitude_squared_acc_index_max_32f(magnitude, &index_max, d_ifft->get_outbuf(), 0, d_fft_size);
+    return magnitude[index_max];
+}
+
+
 void galileo_e5a_noncoherentIQ_acquisition_caf_cc::init()
 {
     d_gnss_synchro->Flag_valid_acquisition = false;
@@ -467,159 +484,54 @@ int galileo_e5a_noncoherentIQ_acquisition_caf_cc::general_work(int noutput_items
                         // Compute the FFT of the carrier wiped--off incoming signal
                         d_fft_if->execute();
 
-                        // CODE IA
-                        // Multiply carrier wiped--off, Fourier transformed incoming signal
-                        // with the local FFT'd code reference using SIMD operations with VOLK library
-                        volk_32fc_x2_multiply_32fc(d_ifft->get_inbuf(),
-                            d_fft_if->get_outbuf(), d_fft_code_I_A, d_fft_size);
-
-                        // compute the inverse FFT
-                        d_ifft->execute();
-
-                        // Search maximum
-                        volk_32fc_magnitude_squared_32f(d_magnitudeIA, d_ifft->get_outbuf(), d_fft_size);
-                        volk_gnsssdr_32f_index_max_32u(&indext_IA, d_magnitudeIA, d_fft_size);
-                        // Normalize the maximum value to correct the scale factor introduced by FFTW
-                        magt_IA = d_magnitudeIA[indext_IA] / (fft_normalization_factor * fft_normalization_factor);
-
-                        if (d_both_signal_components == true)
-                            {
-                                // REPEAT FOR ALL CODES. CODE_QA
-                                volk_32fc_x2_multiply_32fc(d_ifft->get_inbuf(),
-                                    d_fft_if->get_outbuf(), d_fft_code_Q_A, d_fft_size);
-                                d_ifft->execute();
-                                volk_32fc_magnitude_squared_32f(d_magnitudeQA, d_ifft->get_outbuf(), d_fft_size);
-                                volk_gnsssdr_32f_index_max_32u(&indext_QA, d_magnitudeQA, d_fft_size);
-                                magt_QA = d_magnitudeQA[indext_QA] / (fft_normalization_factor * fft_normalization_factor);
-                            }
-                        if (d_sampled_ms > 1)  // If Integration time > 1 code
+                        // Correlate with the primary code replicas. The squared magnitude of each
+                        // correlation and its maximum are obtained in a single pass.
+                        // With T_integration > 1 code, keep the best of the two combinations
+                        // of the secondary code (A: 1,1,1; B: 0,1,1)
+                        magt_IA = correlate(d_fft_code_I_A, d_magnitudeIA, indext_IA) / (fft_normalization_factor * fft_normalization_factor);
+                        float *magnitude_I = d_magnitudeIA;
+                        uint32_t index_I = indext_IA;
+                        if (d_sampled_ms > 1)
                             {
-                                // REPEAT FOR ALL CODES. CODE_IB
-                                volk_32fc_x2_multiply_32fc(d_ifft->get_inbuf(),
-                                    d_fft_if->get_outbuf(), d_fft_code_I_B, d_fft_size);
-                                d_ifft->execute();
-                                volk_32fc_magnitude_squared_32f(d_magnitudeIB, d_ifft->get_outbuf(), d_fft_size);
-                                volk_gnsssdr_32f_index_max_32u(&indext_IB, d_magnitudeIB, d_fft_size);
-                                magt_IB = d_magnitudeIB[indext_IB] / (fft_normalization_factor * fft_normalization_factor);
-
-                                if (d_both_signal_components == true)
+                                magt_IB = correlate(d_fft_code_I_B, d_magnitudeIB, indext_IB) / (fft_normalization_factor * fft_normalization_factor);
+                                if (magt_IA < magt_IB)
                                     {
-                                        // REPEAT FOR ALL CODES. CODE_QB
-                                        volk_32fc_x2_multiply_32fc(d_ifft->get_inbuf(),
-                                            d_fft_if->get_outbuf(), d_fft_code_Q_B, d_fft_size);
-                                        d_ifft->execute();
-                                        volk_32fc_magnitude_squared_32f(d_magnitudeQB, d_ifft->get_outbuf(), d_fft_size);
-                                        volk_gnsssdr_32f_index_max_32u(&indext_QB, d_magnitudeQB, d_fft_size);
-                                        magt_QB = d_magnitudeIB[indext_QB] / (fft_normalization_factor * fft_normalization_factor);
+                                        magnitude_I = d_magnitudeIB;
+                                        index_I = indext_IB;
                                     }
                             }
-
-                        // Integrate noncoherently the two best combinations (I² + Q²)
-                        // and store the result in the I channel.
                         // If CAF filter to resolve doppler ambiguity is needed,
                         // peak is stored before non-coherent integration.
-                        if (d_sampled_ms > 1)  // T_integration > 1 code
+                        if (d_CAF_window_hz > 0)
                             {
-                                if (magt_IA >= magt_IB)
+                                d_CAF_vector_I[doppler_index] = magnitude_I[index_I];
+                            }
+                        indext = index_I;
+
+                        if (d_both_signal_components)
+                            {
+                                magt_QA = correlate(d_fft_code_Q_A, d_magnitudeQA, indext_QA) / (fft_normalization_factor * fft_normalization_factor);
+                                float *magnitude_Q = d_magnitudeQA;
+                                uint32_t index_Q = indext_QA;
+                                if (d_sampled_ms > 1)
                                     {
-                                        // if (d_CAF_filter) {d_CAF_vector_I[doppler_index] = magt_IA;}
-                                        if (d_CAF_window_hz > 0)
-                                            {
-                                                d_CAF_vector_I[doppler_index] = d_magnitudeIA[indext_IA];
-                                            }
-                                        if (d_both_signal_components)
+                                        magt_QB = correlate(d_fft_code_Q_B, d_magnitudeQB, indext_QB) / (fft_normalization_factor * fft_normalization_factor);
+                                        if (magt_QA < magt_QB)
                                             {
-                                                // Integrate non-coherently I+Q
-                                                if (magt_QA >= magt_QB)
-                                                    {
-                                                        // if (d_CAF_filter) {d_CAF_vector_Q[doppler_index] = magt_QA;}
-                                                        if (d_CAF_window_hz > 0)
-                                                            {
-                                                                d_CAF_vector_Q[doppler_index] = d_magnitudeQA[indext_QA];
-                                                            }
-                                                        for (unsigned int i = 0; i < d_fft_size; i++)
-                                                            {
-                                                                d_magnitudeIA[i] += d_magnitudeQA[i];
-                                                            }
-                                                    }
-                                                else
-                                                    {
-                                                        // if (d_CAF_filter) {d_CAF_vector_Q[doppler_index] = magt_QB;}
-                                                        if (d_CAF_window_hz > 0)
-                                                            {
-                                                                d_CAF_vector_Q[doppler_index] = d_magnitudeQB[indext_QB];
-                                                            }
-                                                        for (unsigned int i = 0; i < d_fft_size; i++)
-                                                            {
-                                                                d_magnitudeIA[i] += d_magnitudeQB[i];
-                                                            }
-                                                    }
+                                                magnitude_Q = d_magnitudeQB;
+                                                index_Q = indext_QB;
                                             }
-                                        volk_gnsssdr_32f_index_max_32u(&indext, d_magnitudeIA, d_fft_size);
-                                        magt = d_magnitudeIA[indext] / (fft_normalization_factor * fft_normalization_factor);
                                     }
-                                else
-                                    {
-                                        // if (d_CAF_filter) {d_CAF_vector_I[doppler_index] = magt_IB;}
-                                        if (d_CAF_window_hz > 0)
-                                            {
-                                                d_CAF_vector_I[doppler_index] = d_magnitudeIB[indext_IB];
-                                            }
-                                        if (d_both_signal_components)
-                                            {
-                                                // Integrate non-coherently I+Q
-                                                if (magt_QA >= magt_QB)
-                                                    {
-                                                        //if (d_CAF_filter) {d_CAF_vector_Q[doppler_index] = magt_QA;}
-                                                        if (d_CAF_window_hz > 0)
-                                                            {
-                                                                d_CAF_vector_Q[doppler_index] = d_magnitudeQA[indext_QA];
-                                                            }
-                                                        for (unsigned int i = 0; i < d_fft_size; i++)
-                                                            {
-                                                                d_magnitudeIB[i] += d_magnitudeQA[i];
-                                                            }
-                                                    }
-                                                else
-                                                    {
-                                                        // if (d_CAF_filter) {d_CAF_vector_Q[doppler_index] = magt_QB;}
-                                                        if (d_CAF_window_hz > 0)
-                                                            {
-                                                                d_CAF_vector_Q[doppler_index] = d_magnitudeQB[indext_QB];
-                                                            }
-                                                        for (unsigned int i = 0; i < d_fft_size; i++)
-                                                            {
-                                                                d_magnitudeIB[i] += d_magnitudeQB[i];
-                                                            }
-                                                    }
-                                            }
-                                        volk_gnsssdr_32f_index_max_32u(&indext, d_magnitudeIB, d_fft_size);
-                                        magt = d_magnitudeIB[indext] / (fft_normalization_factor * fft_normalization_factor);
-                                    }
-                            }
-                        else
-                            {
-                                // if (d_CAF_filter) {d_CAF_vector_I[doppler_index] = magt_IA;}
                                 if (d_CAF_window_hz > 0)
                                     {
-                                        d_CAF_vector_I[doppler_index] = d_magnitudeIA[indext_IA];
-                                    }
-                                if (d_both_signal_components)
-                                    {
-                                        // if (d_CAF_filter) {d_CAF_vector_Q[doppler_index] = magt_QA;}
-                                        if (d_CAF_window_hz > 0)
-                                            {
-                                                d_CAF_vector_Q[doppler_index] = d_magnitudeQA[indext_QA];
-                                            }
-                                        // NON-Coherent integration of only 1 code
-                                        for (unsigned int i = 0; i < d_fft_size; i++)
-                                            {
-                                                d_magnitudeIA[i] += d_magnitudeQA[i];
-                                            }
+                                        d_CAF_vector_Q[doppler_index] = magnitude_Q[index_Q];
                                     }
-                                volk_gnsssdr_32f_index_max_32u(&indext, d_magnitudeIA, d_fft_size);
-                                magt = d_magnitudeIA[indext] / (fft_normalization_factor * fft_normalization_factor);
+                                // Integrate noncoherently the two best combinations (I² + Q²)
+                                // and store the result in the I channel.
+                                volk_32f_x2_add_32f(magnitude_I, magnitude_I, magnitude_Q, d_fft_size);
+                                volk_gnsssdr_32f_index_max_32u(&indext, magnitude_I, d_fft_size);
                             }
+                        magt = magnitude_I[indext] / (fft_normalization_factor * fft_normalization_factor);
 
                         // 4- record the maximum peak and the associated synchronization parameters
                         if (d_mag < magt)
@@ -652,21 +564,7 @@ int galileo_e5a_noncoherentIQ_acquisition_caf_cc::general_work(int noutput_items
                                 filename << "../data/test_statistics_E5a_sat_"
                                          << d_gnss_synchro->PRN << "_doppler_" << doppler << ".dat";
                                 d_dump_file.open(filename.str().c_str(), std::ios::out | std::ios::binary);
-                                if (d_sampled_ms > 1)  // If integration time > 1 code
-                                    {
-                                        if (magt_IA >= magt_IB)
-                                            {
-                                                d_dump_file.write(reinterpret_cast<char *>(d_magnitudeIA), n);
-                                            }
-                                        else
-                                            {
-                                                d_dump_file.write(reinterpret_cast<char *>(d_magnitudeIB), n);
-                                            }
-                                    }
-                                else
-                                    {
-                                        d_dump_file.write(reinterpret_cast<char *>(d_magnitudeIA), n);
-                                    }
+                                d_dump_file.write(reinterpret_cast<char *>(magnitude_I), n);
                                 d_dump_file.close();
                             }
                     }
@@ -675,7 +573,7 @@ int galileo_e5a_noncoherentIQ_acquisition_caf_cc::general_work(int noutput_items
                 if (d_CAF_window_hz > 0)
                     {
                         int CAF_bins_half;
-                        auto *accum = static_cast<float *>(volk_gnsssdr_malloc(sizeof(float), volk_gnsssdr_get_alignment()));
+                        float accum;
                         CAF_bins_half = d_CAF_window_hz / (2 * d_doppler_step);
                         float weighting_factor;
                         weighting_factor = 0.5 / static_cast<float>(CAF_bins_half);
@@ -694,15 +592,15 @@ int galileo_e5a_noncoherentIQ_acquisition_caf_cc::general_work(int noutput_items
                                 d_CAF_vector[doppler_index] /= 1 + CAF_bins_half + doppler_index - weighting_factor * CAF_bins_half * (CAF_bins_half + 1) / 2 - weighting_factor * doppler_index * (doppler_index + 1) / 2;  // triangles = [n*(n+1)/2]
                                 if (d_both_signal_components)
                                     {
-                                        accum[0] = 0;
-                                        // volk_32f_accumulator_s32f_a(&accum[0], d_CAF_vector_Q, CAF_bins_half+doppler_index+1);
+                                        accum = 0;
+                                        // volk_32f_accumulator_s32f_a(&accum, d_CAF_vector_Q, CAF_bins_half+doppler_index+1);
                                         for (int i = 0; i < CAF_bins_half + doppler_index + 1; i++)
                                             {
-                                                accum[0] += d_CAF_vector_Q[i] * (1 - weighting_factor * static_cast<unsigned int>(abs(doppler_index - i)));
+                                                accum += d_CAF_vector_Q[i] * (1 - weighting_factor * static_cast<unsigned int>(abs(doppler_index - i)));
                                             }
-                                        // accum[0] /= CAF_bins_half+doppler_index+1;
-                                        accum[0] /= 1 + CAF_bins_half + doppler_index - weighting_factor * CAF_bins_half * (CAF_bins_half + 1) / 2 - weighting_factor * doppler_index * (doppler_index + 1) / 2;  // triangles = [n*(n+1)/2]
-                                        d_CAF_vector[doppler_index] += accum[0];
+                                        // accum /= CAF_bins_half+doppler_index+1;
+                                        accum /= 1 + CAF_bins_half + doppler_index - weighting_factor * CAF_bins_half * (CAF_bins_half + 1) / 2 - weighting_factor * doppler_index * (doppler_index + 1) / 2;  // triangles = [n*(n+1)/2]
+                                        d_CAF_vector[doppler_index] += accum;
                                     }
                             }
                         // Body loop
@@ -718,15 +616,15 @@ int galileo_e5a_noncoherentIQ_acquisition_caf_cc::general_work(int noutput_items
                                 d_CAF_vector[doppler_index] /= 1 + 2 * CAF_bins_half - 2 * weighting_factor * CAF_bins_half * (CAF_bins_half + 1) / 2;
                                 if (d_both_signal_components)
                                     {
-                                        accum[0] = 0;
-                                        // volk_32f_accumulator_s32f_a(&accum[0], &d_CAF_vector_Q[doppler_index-CAF_bins_half], 2*CAF_bins_half);
+                                        accum = 0;
+                                        // volk_32f_accumulator_s32f_a(&accum, &d_CAF_vector_Q[doppler_index-CAF_bins_half], 2*CAF_bins_half);
                                         for (int i = doppler_index - CAF_bins_half; i < static_cast<int>(doppler_index + CAF_bins_half + 1); i++)
                                             {
-                                                accum[0] += d_CAF_vector_Q[i] * (1 - weighting_factor * static_cast<unsigned int>((doppler_index - i)));
+                                                accum += d_CAF_vector_Q[i] * (1 - weighting_factor * static_cast<unsigned int>((doppler_index - i)));
                                             }
-                                        // accum[0] /= 2*CAF_bins_half+1;
-                                        accum[0] /= 1 + 2 * CAF_bins_half - 2 * weighting_factor * CAF_bins_half * (CAF_bins_half + 1) / 2;
-                                        d_CAF_vector[doppler_index] += accum[0];
+                                        // accum /= 2*CAF_bins_half+1;
+                                        accum /= 1 + 2 * CAF_bins_half - 2 * weighting_factor * CAF_bins_half * (CAF_bins_half + 1) / 2;
+                                        d_CAF_vector[doppler_index] += accum;
                                     }
                             }
                         // Final iterations
@@ -742,15 +640,15 @@ int galileo_e5a_noncoherentIQ_acquisition_caf_cc::general_work(int noutput_items
                                 d_CAF_vector[doppler_index] /= 1 + CAF_bins_half + (d_num_doppler_bins - doppler_index - 1) - weighting_factor * CAF_bins_half * (CAF_bins_half + 1) / 2 - weighting_factor * (d_num_doppler_bins - doppler_index - 1) * (d_num_doppler_bins - doppler_index) / 2;
                                 if (d_both_signal_components)
                                     {
-                                        accum[0] = 0;
-                                        // volk_32f_accumulator_s32f_a(&accum[0], &d_CAF_vector_Q[doppler_index-CAF_bins_half], CAF_bins_half + (d_num_doppler_bins-doppler_index));
+                                        accum = 0;
+                                        // volk_32f_accumulator_s32f_a(&accum, &d_CAF_vector_Q[doppler_index-CAF_bins_half], CAF_bins_half + (d_num_doppler_bins-doppler_index));
                                         for (int i = doppler_index - CAF_bins_half; i < static_cast<int>(d_num_doppler_bins); i++)
                                             {
-                                                accum[0] += d_CAF_vector_Q[i] * (1 - weighting_factor * (abs(doppler_index - i)));
+                                                accum += d_CAF_vector_Q[i] * (1 - weighting_factor * (abs(doppler_index - i)));
                                             }
-                                        // accum[0] /= CAF_bins_half+(d_num_doppler_bins-doppler_index);
-                                        accum[0] /= 1 + CAF_bins_half + (d_num_doppler_bins - doppler_index - 1) - weighting_factor * CAF_bins_half * (CAF_bins_half + 1) / 2 - weighting_factor * (d_num_doppler_bins - doppler_index - 1) * (d_num_doppler_bins - doppler_index) / 2;
-                                        d_CAF_vector[doppler_index] += accum[0];
+                                        // accum /= CAF_bins_half+(d_num_doppler_bins-doppler_index);
+                                        accum /= 1 + CAF_bins_half + (d_num_doppler_bins - doppler_index - 1) - weighting_factor * CAF_bins_half * (CAF_bins_half + 1) / 2 - weighting_factor * (d_num_doppler_bins - doppler_index - 1) * (d_num_doppler_bins - doppler_index) / 2;
+                                        d_CAF_vector[doppler_index] += accum;
                                     }
                             }
 
@@ -769,7 +667,6 @@ int galileo_e5a_noncoherentIQ_acquisition_caf_cc::general_work(int noutput_items
                                 d_dump_file.write(reinterpret_cast<char *>(d_CAF_vector), n);
                                 d_dump_file.close();
                             }
-                        volk_gnsssdr_free(accum);
                     }
 
                 if (d_well_count == d_max_dwells)
@@ -38,9 +38,9 @@
 #ifndef GALILEO_E5A_NONCOHERENT_IQ_ACQUISITION_CAF_CC_H_
 #define GALILEO_E5A_NONCOHERENT_IQ_ACQUISITION_CAF_CC_H_
 
+#include "gnss_fft.h"
 #include "gnss_synchro.h"
 #include <gnuradio/block.h>
-#include <gnuradio/fft/fft.h>
 #include <gnuradio/gr_complex.h>
 #include <fstream>
 #include <string>
@@ -55,6 +55,7 @@ galileo_e5a_noncoherentIQ_make_acquisition_caf_cc(unsigned int sampled_ms,
     unsigned int doppler_max, int64_t fs_in,
     int samples_per_ms, int samples_per_code,
     bool bit_transition_flag,
+    const Gnss_Fft_Conf& fft_conf,
     bool dump,
     std::string dump_filename,
     bool both_signal_components_,
@@ -77,6 +78,7 @@ private:
         unsigned int doppler_max, int64_t fs_in,
         int samples_per_ms, int samples_per_code,
         bool bit_transition_flag,
+        const Gnss_Fft_Conf& fft_conf,
         bool dump,
         std::string dump_filename,
         bool both_signal_components_,
@@ -89,6 +91,7 @@ private:
         unsigned int doppler_max, int64_t fs_in,
         int samples_per_ms, int samples_per_code,
         bool bit_transition_flag,
+        const Gnss_Fft_Conf& fft_conf,
         bool dump,
         std::string dump_filename,
         bool both_signal_components_,
@@ -98,6 +101,7 @@ private:
     void calculate_magnitudes(gr_complex* fft_begin, int doppler_shift,
         int doppler_offset);
     float estimate_input_power(gr_complex* in);
+    float correlate(const gr_complex* fft_code, float* magnitude, uint32_t& index_max);
 
     int64_t d_fs_in;
     int d_samples_per_ms;
@@ -119,8 +123,8 @@ private:
     gr_complex* d_fft_code_Q_A;
     gr_complex* d_fft_code_Q_B;
     gr_complex* d_inbuffer;
-    gr::fft::fft_complex* d_fft_if;
-    gr::fft::fft_complex* d_ifft;
+    Gnss_Fft* d_fft_if;
+    Gnss_Fft* d_ifft;
     Gnss_Synchro* d_gnss_synchro;
     unsigned int d_code_phase;
     float d_doppler_freq;
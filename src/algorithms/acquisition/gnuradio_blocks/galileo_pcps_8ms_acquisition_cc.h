@@ -32,9 +32,9 @@
 #ifndef GNSS_SDR_PCPS_8MS_ACQUISITION_CC_H_
 #define GNSS_SDR_PCPS_8MS_ACQUISITION_CC_H_
 
+#include "gnss_fft.h"
 #include "gnss_synchro.h"
 #include <gnuradio/block.h>
-#include <gnuradio/fft/fft.h>
 #include <gnuradio/gr_complex.h>
 #include <fstream>
 #include <string>
@@ -50,6 +50,7 @@ galileo_pcps_8ms_make_acquisition_cc(uint32_t sampled_ms,
     int64_t fs_in,
     int32_t samples_per_ms,
     int32_t samples_per_code,
+    const Gnss_Fft_Conf& fft_conf,
     bool dump,
     std::string dump_filename);
 
@@ -68,6 +69,7 @@ private:
         int64_t fs_in,
         int32_t samples_per_ms,
         int32_t samples_per_code,
+        const Gnss_Fft_Conf& fft_conf,
         bool dump,
         std::string dump_filename);
 
@@ -78,6 +80,7 @@ private:
         int64_t fs_in,
         int32_t samples_per_ms,
         int32_t samples_per_code,
+        const Gnss_Fft_Conf& fft_conf,
         bool dump,
         std::string dump_filename);
 
@@ -103,8 +106,8 @@ private:
     uint32_t d_num_doppler_bins;
     gr_complex* d_fft_code_A;
     gr_complex* d_fft_code_B;
-    gr::fft::fft_complex* d_fft_if;
-    gr::fft::fft_complex* d_ifft;
+    Gnss_Fft* d_fft_if;
+    Gnss_Fft* d_ifft;
     Gnss_Synchro* d_gnss_synchro;
     uint32_t d_code_phase;
     float d_doppler_freq;
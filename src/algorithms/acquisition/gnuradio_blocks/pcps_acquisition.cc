@@ -10,7 +10,7 @@
  *
  * -------------------------------------------------------------------------
  *
- * Copyright (C) 2010-2018  (see AUTHORS file for a list of contributors)
+ * Copyright (C) 2010-2019  (see AUTHORS file for a list of contributors)
  *
  * GNSS-SDR is a software defined Global Navigation
  *          Satellite Systems receiver
@@ -36,13 +36,23 @@
 #include "pcps_acquisition.h"
 #include "GLONASS_L1_L2_CA.h"  // for GLONASS_TWO_PI
 #include "GPS_L1_CA.h"         // for GPS_TWO_PI
+#include "acq_code_cache.h"
+#if CUDA_GPU_ACCEL
+#include "acq_cuda_engine.h"
+#endif
+#include "acq_doppler_wipeoff_cache.h"
+#include "acq_dump_writer.h"
+#include "gnss_profiler.h"
 #include "gnss_sdr_create_directory.h"
 #include <boost/filesystem/path.hpp>
 #include <glog/logging.h>
 #include <gnuradio/io_signature.h>
-#include <matio.h>
 #include <volk_gnsssdr/volk_gnsssdr.h>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
 #include <cstring>
+#include <thread>
 
 
 using google::LogMessage;
@@ -55,7 +65,8 @@ pcps_acquisition_sptr pcps_make_acquisition(const Acq_Conf& conf_)
 
 pcps_acquisition::pcps_acquisition(const Acq_Conf& conf_) : gr::block("pcps_acquisition",
                                                                 gr::io_signature::make(1, 1, conf_.it_size),
-                                                                gr::io_signature::make(0, 0, conf_.it_size))
+                                                                gr::io_signature::make(0, 0, conf_.it_size)),
+                                                            d_memory("acquisition")
 {
     this->message_port_register_out(pmt::mp("events"));
 
@@ -79,6 +90,7 @@ pcps_acquisition::pcps_acquisition(const Acq_Conf& conf_) : gr::block("pcps_acqu
     d_mag = 0;
     d_input_power = 0.0;
     d_num_doppler_bins = 0U;
+    d_doppler_shift_bins = 0U;
     d_threshold = 0.0;
     d_doppler_step = 0U;
     d_doppler_center_step_two = 0.0;
@@ -103,37 +115,80 @@ pcps_acquisition::pcps_acquisition(const Acq_Conf& conf_) : gr::block("pcps_acqu
     //
     // We can avoid this by doing linear correlation, effectively doubling the
     // size of the input buffer and padding the code with zeros.
-    if (acq_parameters.bit_transition_flag)
+    //
+    // With overlap_save, the input buffer is not padded with zeros but
+    // holds the previous half block followed by the new half block. The
+    // valid lags are the same, the FFT length is halved and each dwell only
+    // consumes half a block, so several dwells slide over the signal.
+    d_overlap_save = (acq_parameters.bit_transition_flag and acq_parameters.overlap_save);
+
+    // The fine Doppler estimation replaces the second acquisition step
+    d_fine_doppler_interpolation = (acq_parameters.make_2_steps and acq_parameters.fine_doppler_interpolation);
+    if (d_fine_doppler_interpolation)
+        {
+            acq_parameters.make_2_steps = false;
+        }
+    if (d_overlap_save)
+        {
+            d_fft_size = d_consumed_samples;
+        }
+    else if (acq_parameters.bit_transition_flag)
         {
             d_fft_size = d_consumed_samples * 2;
             acq_parameters.max_dwells = 1;  // Activation of acq_parameters.bit_transition_flag invalidates the value of acq_parameters.max_dwells
         }
 
-    d_tmp_buffer = static_cast<float*>(volk_gnsssdr_malloc(d_fft_size * sizeof(float), volk_gnsssdr_get_alignment()));
-    d_fft_codes = static_cast<gr_complex*>(volk_gnsssdr_malloc(d_fft_size * sizeof(gr_complex), volk_gnsssdr_get_alignment()));
-    d_magnitude = static_cast<float*>(volk_gnsssdr_malloc(d_fft_size * sizeof(float), volk_gnsssdr_get_alignment()));
-    d_input_signal = static_cast<gr_complex*>(volk_gnsssdr_malloc(d_fft_size * sizeof(gr_complex), volk_gnsssdr_get_alignment()));
+    // The search buffers are allocated when the channel starts acquiring, see allocate_acquisition_buffers()
+    d_buffers_allocated = false;
+    d_tmp_buffer = nullptr;
+    d_magnitude = nullptr;
+    d_input_signal = nullptr;
+    d_input_signal_sc = nullptr;
 
     // Direct FFT
-    d_fft_if = new gr::fft::fft_complex(d_fft_size, true);
+    d_fft_if = new Gnss_Fft(d_fft_size, true, acq_parameters.fft_conf);
 
     // Inverse FFT
-    d_ifft = new gr::fft::fft_complex(d_fft_size, false);
+    d_ifft = new Gnss_Fft(d_fft_size, false, acq_parameters.fft_conf);
+
+    // Workers of the Doppler grid search. The first one has the FFT plans of the block, the
+    // rest get their own. They run on the acquisition thread and on the threads of a pool
+    // shared by all the channels, so the searches do not create threads
+    uint32_t max_threads = std::max(std::thread::hardware_concurrency(), 1U);
+    uint32_t doppler_threads = std::min(std::max(acq_parameters.doppler_threads, 1U), max_threads);
+    if (doppler_threads != acq_parameters.doppler_threads)
+        {
+            LOG(WARNING) << "Acquisition doppler_threads set to " << acq_parameters.doppler_threads << ", using " << doppler_threads << " threads instead";
+        }
+    d_doppler_workers.resize(doppler_threads);
+    d_doppler_workers[0].fft_if = d_fft_if;
+    d_doppler_workers[0].ifft = d_ifft;
+    for (uint32_t i = 1; i < doppler_threads; i++)
+        {
+            d_doppler_workers[i].fft_if = new Gnss_Fft(d_fft_size, true, acq_parameters.fft_conf);
+            d_doppler_workers[i].ifft = new Gnss_Fft(d_fft_size, false, acq_parameters.fft_conf);
+        }
+    for (auto& worker : d_doppler_workers)
+        {
+            worker.folded_fft = nullptr;
+            worker.folded_ifft = nullptr;
+            worker.wipeoff_sc = nullptr;
+            worker.magnitude = nullptr;
+        }
+    if (doppler_threads > 1)
+        {
+            d_doppler_pool = Acq_Doppler_Thread_Pool::get_instance();
+            d_search_bins = [this](uint32_t worker_index) {
+                search_doppler_bins(worker_index, d_doppler_search.in, d_doppler_search.fft_codes, d_doppler_search.pilot_codes, d_doppler_search.first_bin_spectrum, d_doppler_search.samp_count, d_doppler_search.effective_fft_size);
+            };
+        }
 
     d_gnss_synchro = nullptr;
-    d_grid_doppler_wipeoffs = nullptr;
     d_grid_doppler_wipeoffs_step_two = nullptr;
     d_magnitude_grid = nullptr;
     d_worker_active = false;
-    d_data_buffer = static_cast<gr_complex*>(volk_gnsssdr_malloc(d_consumed_samples * sizeof(gr_complex), volk_gnsssdr_get_alignment()));
-    if (d_cshort)
-        {
-            d_data_buffer_sc = static_cast<lv_16sc_t*>(volk_gnsssdr_malloc(d_consumed_samples * sizeof(lv_16sc_t), volk_gnsssdr_get_alignment()));
-        }
-    else
-        {
-            d_data_buffer_sc = nullptr;
-        }
+    d_data_buffer = nullptr;
+    d_data_buffer_sc = nullptr;
     grid_ = arma::fmat();
     narrow_grid_ = arma::fmat();
     d_step_two = false;
@@ -184,63 +239,306 @@ pcps_acquisition::pcps_acquisition(const Acq_Conf& conf_) : gr::block("pcps_acqu
                     std::cerr << "GNSS-SDR cannot create dump file for the Acquisition block. Wrong permissions?" << std::endl;
                     d_dump = false;
                 }
+            else
+                {
+                    d_dump_writer = Acq_Dump_Writer::get_instance(acq_parameters.dump_queue_size, acq_parameters.dump_compression);
+                }
         }
+
+    // The full magnitude grid is only needed for non-coherent integration and for dumping it
+    d_reduced_grid = (acq_parameters.reduced_grid and (acq_parameters.max_dwells == 1) and !d_dump);
+    d_doppler_first_bin = 0U;
+    d_doppler_last_bin = 0U;
+    d_cuda_slot = -1;
+    d_searched_on_cuda = false;
+    d_cuda_doppler_bins = 0U;
+    d_cuda_code = nullptr;
+    if (acq_parameters.use_cuda)
+        {
+#if CUDA_GPU_ACCEL
+            if (d_cshort or d_dump)
+                {
+                    LOG(WARNING) << "CUDA acquisition is not available for 16-bit samples or with dump enabled, using the CPU";
+                }
+            else
+                {
+                    d_cuda_engine = Acq_Cuda_Engine::get_instance(d_fft_size, acq_parameters.use_automatic_resampler ? acq_parameters.resampled_fs : acq_parameters.fs_in, acq_parameters.cuda_batch_window_us);
+                    if (!d_cuda_engine->ready())
+                        {
+                            d_cuda_engine.reset();
+                        }
+                }
+#else
+            LOG(WARNING) << "GNSS-SDR was built without CUDA support, acquisition will run on the CPU";
+#endif
+        }
+
+    // QuickSync folding of the first step: the wiped-off input is split into d_folding_factor
+    // blocks which are added up, so every Doppler bin costs two FFTs of d_fft_size / d_folding_factor
+    // points. The noise of the d_folding_factor blocks adds up too, about 10 log10(d_folding_factor) dB
+    // of sensitivity loss. The code phase found is resolved in the full length afterwards
+    d_folding_factor = 1U;
+    d_folded_fft_size = d_fft_size;
+    d_folded_codes = nullptr;
+    if (acq_parameters.folding_factor > 1U)
+        {
+            if (d_cshort or acq_parameters.bit_transition_flag or d_cuda_engine or (d_fft_size % acq_parameters.folding_factor != 0U))
+                {
+                    LOG(WARNING) << "Acquisition folding_factor=" << acq_parameters.folding_factor << " requires gr_complex samples, no bit_transition_flag, no CUDA "
+                                 << "and an FFT length multiple of it (it is " << d_fft_size << "). Searching without folding.";
+                }
+            else
+                {
+                    d_folding_factor = acq_parameters.folding_factor;
+                    d_folded_fft_size = d_fft_size / d_folding_factor;
+                    // The folded blocks are wiped off in the time domain, before they are added up
+                    acq_parameters.doppler_fft_shift = false;
+                    for (auto& worker : d_doppler_workers)
+                        {
+                            worker.folded_fft = new Gnss_Fft(d_folded_fft_size, true, acq_parameters.fft_conf);
+                            worker.folded_ifft = new Gnss_Fft(d_folded_fft_size, false, acq_parameters.fft_conf);
+                        }
+                }
+        }
+    // Input and output buffers of each plan
+    d_memory.set_bytes("fft", d_doppler_workers.size() * 4 * (d_fft_size + (d_folding_factor > 1U ? d_folded_fft_size : 0U)) * sizeof(gr_complex));
 }
 
 pcps_acquisition::~pcps_acquisition()
 {
-    if (d_num_doppler_bins > 0)
+#if CUDA_GPU_ACCEL
+    if (d_cuda_slot >= 0)
         {
-            for (uint32_t i = 0; i < d_num_doppler_bins; i++)
+            d_cuda_engine->remove_channel(d_cuda_slot);
+        }
+#endif
+    release_acquisition_buffers();
+    for (auto& worker : d_doppler_workers)
+        {
+            delete worker.folded_ifft;
+            delete worker.folded_fft;
+        }
+    for (uint32_t i = 1; i < d_doppler_workers.size(); i++)
+        {
+            delete d_doppler_workers[i].ifft;
+            delete d_doppler_workers[i].fft_if;
+        }
+    delete d_ifft;
+    delete d_fft_if;
+}
+
+
+/*
+ * Most of the time a channel is tracking, so the buffers of the Doppler
+ * search only exist from the start of an acquisition until it succeeds.
+ * The FFT plans are kept, since computing them again is expensive.
+ */
+void pcps_acquisition::allocate_acquisition_buffers()
+{
+    if (acq_parameters.make_2_steps)
+        {
+            d_grid_doppler_wipeoffs_step_two = new gr_complex*[d_num_doppler_bins_step2];
+        }
+    if (!d_reduced_grid)
+        {
+            d_magnitude_grid = new float*[d_num_doppler_bins];
+        }
+    // All the search arrays share a single buffer, released as a unit when the acquisition ends.
+    // The first pass sizes it, and the second one takes the arrays from it
+    take_acquisition_buffers();
+    d_arena.allocate();
+    take_acquisition_buffers();
+
+    if (d_cshort)
+        {
+            // 16-bit samples are kept as such until the FFT input.
+            // The padding is never written, so it is zeroed only once
+            std::fill_n(d_data_buffer_sc, d_fft_size, lv_16sc_t(0, 0));
+        }
+    else
+        {
+            std::fill_n(d_data_buffer, d_fft_size, gr_complex(0.0, 0.0));
+        }
+    if (d_reduced_grid)
+        {
+            for (auto& worker : d_doppler_workers)
                 {
-                    volk_gnsssdr_free(d_grid_doppler_wipeoffs[i]);
-                    volk_gnsssdr_free(d_magnitude_grid[i]);
+                    std::fill_n(worker.magnitude, d_fft_size, 0.0);
                 }
-            delete[] d_grid_doppler_wipeoffs;
-            delete[] d_magnitude_grid;
         }
-    if (acq_parameters.make_2_steps)
+    else
         {
-            for (uint32_t i = 0; i < d_num_doppler_bins_step2; i++)
+            for (uint32_t doppler_index = 0; doppler_index < d_num_doppler_bins; doppler_index++)
                 {
-                    volk_gnsssdr_free(d_grid_doppler_wipeoffs_step_two[i]);
+                    std::fill_n(d_magnitude_grid[doppler_index], d_fft_size, 0.0);
                 }
-            delete[] d_grid_doppler_wipeoffs_step_two;
         }
-    volk_gnsssdr_free(d_fft_codes);
-    volk_gnsssdr_free(d_magnitude);
-    volk_gnsssdr_free(d_tmp_buffer);
-    volk_gnsssdr_free(d_input_signal);
-    delete d_ifft;
-    delete d_fft_if;
-    volk_gnsssdr_free(d_data_buffer);
+    update_grid_doppler_wipeoffs();
+    d_buffers_allocated = true;
+
+    // The Doppler wipe-off tables and the FFT of the local codes are shared with other channels, and not accounted here
+    d_memory.set_bytes("volk", d_arena.bytes());
+}
+
+
+// In the order they are used by acquisition_core()
+void pcps_acquisition::take_acquisition_buffers()
+{
     if (d_cshort)
         {
-            volk_gnsssdr_free(d_data_buffer_sc);
+            d_data_buffer_sc = d_arena.take<lv_16sc_t>(d_fft_size);
+        }
+    else
+        {
+            d_data_buffer = d_arena.take<gr_complex>(d_fft_size);
+        }
+    if (d_folding_factor > 1U)
+        {
+            d_folded_codes = d_arena.take<gr_complex>(d_folded_fft_size);
+        }
+    for (auto& worker : d_doppler_workers)
+        {
+            if (d_cshort)
+                {
+                    worker.wipeoff_sc = d_arena.take<lv_16sc_t>(d_fft_size);
+                }
+            if (d_reduced_grid)
+                {
+                    worker.magnitude = d_arena.take<float>(d_fft_size);
+                }
+        }
+    if (!d_reduced_grid)
+        {
+            for (uint32_t doppler_index = 0; doppler_index < d_num_doppler_bins; doppler_index++)
+                {
+                    d_magnitude_grid[doppler_index] = d_arena.take<float>(d_fft_size);
+                }
+        }
+    d_magnitude = d_arena.take<float>(d_fft_size);
+    d_tmp_buffer = d_arena.take<float>(d_fft_size);
+    if (acq_parameters.make_2_steps)
+        {
+            for (uint32_t doppler_index = 0; doppler_index < d_num_doppler_bins_step2; doppler_index++)
+                {
+                    d_grid_doppler_wipeoffs_step_two[doppler_index] = d_arena.take<gr_complex>(d_fft_size);
+                }
         }
 }
 
 
+void pcps_acquisition::release_acquisition_buffers()
+{
+    d_arena.release();
+    delete[] d_magnitude_grid;
+    d_magnitude_grid = nullptr;
+    delete[] d_grid_doppler_wipeoffs_step_two;
+    d_grid_doppler_wipeoffs_step_two = nullptr;
+    for (auto& worker : d_doppler_workers)
+        {
+            worker.magnitude = nullptr;
+            worker.wipeoff_sc = nullptr;
+        }
+    d_magnitude = nullptr;
+    d_tmp_buffer = nullptr;
+    d_input_signal = nullptr;
+    d_input_signal_sc = nullptr;
+    d_data_buffer = nullptr;
+    d_data_buffer_sc = nullptr;
+    d_folded_codes = nullptr;
+    // The Doppler wipe-off tables are freed when no other channel is using them
+    d_grid_doppler_wipeoffs.clear();
+    d_buffer_count = 0U;
+    d_buffers_allocated = false;
+    d_memory.set_bytes("volk", 0);
+}
+
+
 void pcps_acquisition::set_resampler_latency(uint32_t latency_samples)
 {
     gr::thread::scoped_lock lock(d_setlock);  // require mutex with work function called by the scheduler
     acq_parameters.resampler_latency_samples = latency_samples;
 }
 
-void pcps_acquisition::set_local_code(std::complex<float>* code)
+void pcps_acquisition::update_intermediate_frequency()
 {
     // reset the intermediate frequency
     d_old_freq = 0LL;
     // This will check if it's fdma, if yes will update the intermediate frequency and the doppler grid
-    if (is_fdma())
+    if (is_fdma() and d_buffers_allocated)
         {
             update_grid_doppler_wipeoffs();
         }
+}
+
+
+std::string pcps_acquisition::local_code_key(const std::string& code_id) const
+{
+    // The zero padding of the local code only depends on the FFT and the block lengths
+    return code_id + "_" + std::to_string(d_fft_size) + "_" + std::to_string(d_consumed_samples);
+}
+
+
+bool pcps_acquisition::load_local_code(const std::string& code_id)
+{
+    std::shared_ptr<const gr_complex> fft_codes = Acq_Code_Cache::get_instance()->find(local_code_key(code_id));
+    if (!fft_codes)
+        {
+            return false;
+        }
+    update_intermediate_frequency();
+    gr::thread::scoped_lock lock(d_setlock);  // require mutex with work function called by the scheduler
+    d_fft_codes = fft_codes;
+    d_fft_codes_pilot.reset();
+    return true;
+}
+
+
+bool pcps_acquisition::load_local_code(const std::string& code_id, const std::string& pilot_code_id)
+{
+    std::shared_ptr<const gr_complex> fft_codes = Acq_Code_Cache::get_instance()->find(local_code_key(code_id));
+    std::shared_ptr<const gr_complex> fft_codes_pilot = Acq_Code_Cache::get_instance()->find(local_code_key(pilot_code_id));
+    if (!fft_codes or !fft_codes_pilot)
+        {
+            return false;
+        }
+    update_intermediate_frequency();
+    gr::thread::scoped_lock lock(d_setlock);  // require mutex with work function called by the scheduler
+    d_fft_codes = fft_codes;
+    d_fft_codes_pilot = fft_codes_pilot;
+    return true;
+}
+
+
+void pcps_acquisition::set_local_code(std::complex<float>* code)
+{
+    set_local_code(code, std::string());
+}
+
+
+void pcps_acquisition::set_local_code(std::complex<float>* code, const std::string& code_id)
+{
+    update_intermediate_frequency();
+    gr::thread::scoped_lock lock(d_setlock);  // require mutex with work function called by the scheduler
+    d_fft_codes = code_spectrum(code, code_id);
+    d_fft_codes_pilot.reset();
+}
+
+
+void pcps_acquisition::set_local_code(std::complex<float>* code, const std::string& code_id, std::complex<float>* pilot_code, const std::string& pilot_code_id)
+{
+    update_intermediate_frequency();
+    gr::thread::scoped_lock lock(d_setlock);  // require mutex with work function called by the scheduler
+    d_fft_codes = code_spectrum(code, code_id);
+    d_fft_codes_pilot = code_spectrum(pilot_code, pilot_code_id);
+}
+
+
+std::shared_ptr<const gr_complex> pcps_acquisition::code_spectrum(std::complex<float>* code, const std::string& code_id)
+{
     // COD
     // Here we want to create a buffer that looks like this:
     // [ 0 0 0 ... 0 c_0 c_1 ... c_L]
     // where c_i is the local code and there are L zeros and L chips
-    gr::thread::scoped_lock lock(d_setlock);  // require mutex with work function called by the scheduler
     if (acq_parameters.bit_transition_flag)
         {
             int32_t offset = d_fft_size / 2;
@@ -261,7 +559,14 @@ void pcps_acquisition::set_local_code(std::complex<float>* code)
         }
 
     d_fft_if->execute();  // We need the FFT of local code
-    volk_32fc_conjugate_32fc(d_fft_codes, d_fft_if->get_outbuf(), d_fft_size);
+    auto* fft_codes = static_cast<gr_complex*>(volk_gnsssdr_malloc(d_fft_size * sizeof(gr_complex), volk_gnsssdr_get_alignment()));
+    volk_32fc_conjugate_32fc(fft_codes, d_fft_if->get_outbuf(), d_fft_size);
+    std::shared_ptr<const gr_complex> spectrum(fft_codes, [](const gr_complex* p) { volk_gnsssdr_free(const_cast<gr_complex*>(p)); });
+    if (!code_id.empty())
+        {
+            spectrum = Acq_Code_Cache::get_instance()->insert(local_code_key(code_id), spectrum);
+        }
+    return spectrum;
 }
 
 
@@ -313,42 +618,36 @@ void pcps_acquisition::init()
     d_gnss_synchro->Acq_samplestamp_samples = 0ULL;
     d_mag = 0.0;
     d_input_power = 0.0;
+    d_signal_counters = Gnss_Metrics::get_instance()->get_signal_counters(std::string(d_gnss_synchro->Signal, 2));
 
-    d_num_doppler_bins = static_cast<uint32_t>(std::ceil(static_cast<double>(static_cast<int32_t>(acq_parameters.doppler_max) - static_cast<int32_t>(-acq_parameters.doppler_max)) / static_cast<double>(d_doppler_step)));
-
-    // Create the carrier Doppler wipeoff signals
-    if (d_grid_doppler_wipeoffs == nullptr) d_grid_doppler_wipeoffs = new gr_complex*[d_num_doppler_bins];
-    if (acq_parameters.make_2_steps && (d_grid_doppler_wipeoffs_step_two == nullptr))
+    // The buffers are sized for the Doppler grid, which may have changed
+    if (d_buffers_allocated)
         {
-            d_grid_doppler_wipeoffs_step_two = new gr_complex*[d_num_doppler_bins_step2];
-            for (uint32_t doppler_index = 0; doppler_index < d_num_doppler_bins_step2; doppler_index++)
-                {
-                    d_grid_doppler_wipeoffs_step_two[doppler_index] = static_cast<gr_complex*>(volk_gnsssdr_malloc(d_fft_size * sizeof(gr_complex), volk_gnsssdr_get_alignment()));
-                }
+            release_acquisition_buffers();
         }
+    d_num_doppler_bins = static_cast<uint32_t>(std::ceil(static_cast<double>(static_cast<int32_t>(acq_parameters.doppler_max) - static_cast<int32_t>(-acq_parameters.doppler_max)) / static_cast<double>(d_doppler_step)));
 
-    if (d_magnitude_grid == nullptr)
+    d_magnitude_grid_max.assign(std::max(d_num_doppler_bins, d_num_doppler_bins_step2), 0.0);
+    d_magnitude_grid_max_index.assign(std::max(d_num_doppler_bins, d_num_doppler_bins_step2), 0U);
+#if CUDA_GPU_ACCEL
+    if (d_cuda_engine and (d_magnitude_grid_max.size() > d_cuda_doppler_bins))
         {
-            d_magnitude_grid = new float*[d_num_doppler_bins];
-            for (uint32_t doppler_index = 0; doppler_index < d_num_doppler_bins; doppler_index++)
-                {
-                    d_grid_doppler_wipeoffs[doppler_index] = static_cast<gr_complex*>(volk_gnsssdr_malloc(d_fft_size * sizeof(gr_complex), volk_gnsssdr_get_alignment()));
-                    d_magnitude_grid[doppler_index] = static_cast<float*>(volk_gnsssdr_malloc(d_fft_size * sizeof(float), volk_gnsssdr_get_alignment()));
-                }
+            // The accumulation grid of the GPU slot holds the largest of both Doppler grids
+            d_cuda_engine->remove_channel(d_cuda_slot);
+            d_cuda_doppler_bins = d_magnitude_grid_max.size();
+            d_cuda_slot = d_cuda_engine->add_channel(d_cuda_doppler_bins);
+            d_cuda_code = nullptr;
         }
+#endif
+    update_doppler_shift_bins();
 
-    for (uint32_t doppler_index = 0; doppler_index < d_num_doppler_bins; doppler_index++)
+    d_worker_active = false;
+
+    if (acq_parameters.use_shared_fft)
         {
-            for (uint32_t k = 0; k < d_fft_size; k++)
-                {
-                    d_magnitude_grid[doppler_index][k] = 0.0;
-                }
-            int32_t doppler = -static_cast<int32_t>(acq_parameters.doppler_max) + d_doppler_step * doppler_index;
-            update_local_carrier(d_grid_doppler_wipeoffs[doppler_index], d_fft_size, d_old_freq + doppler);
+            d_spectrum_cache = Acq_Spectrum_Cache::get_instance(std::string(d_gnss_synchro->Signal, 2), acq_parameters.use_automatic_resampler ? acq_parameters.resampled_fs : acq_parameters.fs_in, d_fft_size);
         }
 
-    d_worker_active = false;
-
     if (d_dump)
         {
             uint32_t effective_fft_size = (acq_parameters.bit_transition_flag ? (d_fft_size / 2) : d_fft_size);
@@ -360,10 +659,42 @@ void pcps_acquisition::init()
 
 void pcps_acquisition::update_grid_doppler_wipeoffs()
 {
+    if (acq_parameters.on_the_fly_wipeoff or d_cshort)
+        {
+            // The carrier is generated in acquisition_core()
+            d_grid_doppler_wipeoffs.clear();
+            return;
+        }
+    // Tables are shared with all the other channels working with the same sampling rate and Doppler grid
+    int64_t fs = (acq_parameters.use_automatic_resampler ? acq_parameters.resampled_fs : acq_parameters.fs_in);
+    d_grid_doppler_wipeoffs.resize(d_num_doppler_bins);
     for (uint32_t doppler_index = 0; doppler_index < d_num_doppler_bins; doppler_index++)
         {
             int32_t doppler = -static_cast<int32_t>(acq_parameters.doppler_max) + d_doppler_step * doppler_index;
-            update_local_carrier(d_grid_doppler_wipeoffs[doppler_index], d_fft_size, d_old_freq + doppler);
+            d_grid_doppler_wipeoffs[doppler_index] = Acq_Doppler_Wipeoff_Cache::get_instance()->get(fs, d_fft_size, static_cast<float>(d_old_freq + doppler));
+        }
+}
+
+
+void pcps_acquisition::update_doppler_shift_bins()
+{
+    d_doppler_shift_bins = 0U;
+    if (!acq_parameters.doppler_fft_shift)
+        {
+            return;
+        }
+    // A Doppler shift multiple of the FFT bin width (1 / T_fft) is a circular shift of the input spectrum
+    double fs = static_cast<double>(acq_parameters.use_automatic_resampler ? acq_parameters.resampled_fs : acq_parameters.fs_in);
+    double fft_bin_hz = fs / static_cast<double>(d_fft_size);
+    double shift = static_cast<double>(d_doppler_step) / fft_bin_hz;
+    if ((shift >= 0.5) and (std::abs(shift - std::round(shift)) < 1e-3))
+        {
+            d_doppler_shift_bins = static_cast<uint32_t>(std::round(shift));
+        }
+    else
+        {
+            LOG(WARNING) << "Channel " << d_channel << ": doppler_mode=fft_shift requires a Doppler step multiple of "
+                         << fft_bin_hz << " Hz, but it is " << d_doppler_step << " Hz. Using time-domain Doppler wipe-off.";
         }
 }
 
@@ -405,6 +736,7 @@ void pcps_acquisition::set_state(int32_t state)
 
 void pcps_acquisition::send_positive_acquisition()
 {
+    d_gnss_synchro->CN0_dB_hz = estimated_cn0_db_hz();
     // Declare positive acquisition using a message port
     // 0=STOP_CHANNEL 1=ACQ_SUCCEES 2=ACQ_FAIL
     DLOG(INFO) << "positive acquisition"
@@ -417,6 +749,11 @@ void pcps_acquisition::send_positive_acquisition()
                << ", magnitude " << d_mag
                << ", input signal power " << d_input_power;
     d_positive_acq = 1;
+    if (d_signal_counters)
+        {
+            d_signal_counters->acquisitions.fetch_add(1, std::memory_order_relaxed);
+            d_signal_counters->positive_acquisitions.fetch_add(1, std::memory_order_relaxed);
+        }
     this->message_port_pub(pmt::mp("events"), pmt::from_long(1));
 }
 
@@ -435,6 +772,15 @@ void pcps_acquisition::send_negative_acquisition()
                << ", magnitude " << d_mag
                << ", input signal power " << d_input_power;
     d_positive_acq = 0;
+    if (d_signal_counters)
+        {
+            d_signal_counters->acquisitions.fetch_add(1, std::memory_order_relaxed);
+        }
+    if ((d_doppler_first_bin > 0U) or (d_doppler_last_bin + 1U < d_num_doppler_bins))
+        {
+            // The prediction may be wrong: search the whole grid in the next attempt
+            d_gnss_synchro->Acq_doppler_uncertainty_hz = 0.0;
+        }
     this->message_port_pub(pmt::mp("events"), pmt::from_long(2));
 }
 
@@ -456,89 +802,27 @@ void pcps_acquisition::dump_results(int32_t effective_fft_size)
     filename.append(std::to_string(d_gnss_synchro->PRN));
     filename.append(".mat");
 
-    mat_t* matfp = Mat_CreateVer(filename.c_str(), nullptr, MAT_FT_MAT73);
-    if (matfp == nullptr)
-        {
-            std::cout << "Unable to create or open Acquisition dump file" << std::endl;
-            //acq_parameters.dump = false;
-        }
-    else
+    // The record keeps copies of the grids, so they can be reset while the writer thread stores them
+    std::unique_ptr<Acq_Dump_Record> record(new Acq_Dump_Record(filename));
+    record->add_grid("acq_grid", grid_.memptr(), static_cast<size_t>(effective_fft_size), static_cast<size_t>(d_num_doppler_bins), acq_parameters.dump_quantized_grid);
+    record->add("doppler_max", acq_parameters.doppler_max);
+    record->add("doppler_step", d_doppler_step);
+    record->add("d_positive_acq", d_positive_acq);
+    record->add("acq_doppler_hz", static_cast<float>(d_gnss_synchro->Acq_doppler_hz));
+    record->add("acq_delay_samples", static_cast<float>(d_gnss_synchro->Acq_delay_samples));
+    record->add("test_statistic", d_test_statistics);
+    record->add("threshold", d_threshold);
+    record->add("input_power", d_input_power);
+    record->add("sample_counter", d_sample_counter);
+    record->add("PRN", d_gnss_synchro->PRN);
+    record->add("num_dwells", d_num_noncoherent_integrations_counter);
+    if (acq_parameters.make_2_steps)
         {
-            size_t dims[2] = {static_cast<size_t>(effective_fft_size), static_cast<size_t>(d_num_doppler_bins)};
-            matvar_t* matvar = Mat_VarCreate("acq_grid", MAT_C_SINGLE, MAT_T_SINGLE, 2, dims, grid_.memptr(), 0);
-            Mat_VarWrite(matfp, matvar, MAT_COMPRESSION_ZLIB);  // or MAT_COMPRESSION_NONE
-            Mat_VarFree(matvar);
-
-            dims[0] = static_cast<size_t>(1);
-            dims[1] = static_cast<size_t>(1);
-            matvar = Mat_VarCreate("doppler_max", MAT_C_UINT32, MAT_T_UINT32, 1, dims, &acq_parameters.doppler_max, 0);
-            Mat_VarWrite(matfp, matvar, MAT_COMPRESSION_ZLIB);  // or MAT_COMPRESSION_NONE
-            Mat_VarFree(matvar);
-
-            matvar = Mat_VarCreate("doppler_step", MAT_C_UINT32, MAT_T_UINT32, 1, dims, &d_doppler_step, 0);
-            Mat_VarWrite(matfp, matvar, MAT_COMPRESSION_ZLIB);  // or MAT_COMPRESSION_NONE
-            Mat_VarFree(matvar);
-
-            matvar = Mat_VarCreate("d_positive_acq", MAT_C_INT32, MAT_T_INT32, 1, dims, &d_positive_acq, 0);
-            Mat_VarWrite(matfp, matvar, MAT_COMPRESSION_ZLIB);  // or MAT_COMPRESSION_NONE
-            Mat_VarFree(matvar);
-
-            auto aux = static_cast<float>(d_gnss_synchro->Acq_doppler_hz);
-            matvar = Mat_VarCreate("acq_doppler_hz", MAT_C_SINGLE, MAT_T_SINGLE, 1, dims, &aux, 0);
-            Mat_VarWrite(matfp, matvar, MAT_COMPRESSION_ZLIB);  // or MAT_COMPRESSION_NONE
-            Mat_VarFree(matvar);
-
-            aux = static_cast<float>(d_gnss_synchro->Acq_delay_samples);
-            matvar = Mat_VarCreate("acq_delay_samples", MAT_C_SINGLE, MAT_T_SINGLE, 1, dims, &aux, 0);
-            Mat_VarWrite(matfp, matvar, MAT_COMPRESSION_ZLIB);  // or MAT_COMPRESSION_NONE
-            Mat_VarFree(matvar);
-
-            matvar = Mat_VarCreate("test_statistic", MAT_C_SINGLE, MAT_T_SINGLE, 1, dims, &d_test_statistics, 0);
-            Mat_VarWrite(matfp, matvar, MAT_COMPRESSION_ZLIB);  // or MAT_COMPRESSION_NONE
-            Mat_VarFree(matvar);
-
-            matvar = Mat_VarCreate("threshold", MAT_C_SINGLE, MAT_T_SINGLE, 1, dims, &d_threshold, 0);
-            Mat_VarWrite(matfp, matvar, MAT_COMPRESSION_ZLIB);  // or MAT_COMPRESSION_NONE
-            Mat_VarFree(matvar);
-
-            matvar = Mat_VarCreate("input_power", MAT_C_SINGLE, MAT_T_SINGLE, 1, dims, &d_input_power, 0);
-            Mat_VarWrite(matfp, matvar, MAT_COMPRESSION_ZLIB);  // or MAT_COMPRESSION_NONE
-            Mat_VarFree(matvar);
-
-            matvar = Mat_VarCreate("sample_counter", MAT_C_UINT64, MAT_T_UINT64, 1, dims, &d_sample_counter, 0);
-            Mat_VarWrite(matfp, matvar, MAT_COMPRESSION_ZLIB);  // or MAT_COMPRESSION_NONE
-            Mat_VarFree(matvar);
-
-            matvar = Mat_VarCreate("PRN", MAT_C_UINT32, MAT_T_UINT32, 1, dims, &d_gnss_synchro->PRN, 0);
-            Mat_VarWrite(matfp, matvar, MAT_COMPRESSION_ZLIB);  // or MAT_COMPRESSION_NONE
-            Mat_VarFree(matvar);
-
-            matvar = Mat_VarCreate("num_dwells", MAT_C_UINT32, MAT_T_UINT32, 1, dims, &d_num_noncoherent_integrations_counter, 0);
-            Mat_VarWrite(matfp, matvar, MAT_COMPRESSION_ZLIB);  // or MAT_COMPRESSION_NONE
-            Mat_VarFree(matvar);
-
-            if (acq_parameters.make_2_steps)
-                {
-                    dims[0] = static_cast<size_t>(effective_fft_size);
-                    dims[1] = static_cast<size_t>(d_num_doppler_bins_step2);
-                    matvar = Mat_VarCreate("acq_grid_narrow", MAT_C_SINGLE, MAT_T_SINGLE, 2, dims, narrow_grid_.memptr(), 0);
-                    Mat_VarWrite(matfp, matvar, MAT_COMPRESSION_ZLIB);  // or MAT_COMPRESSION_NONE
-                    Mat_VarFree(matvar);
-
-                    dims[0] = static_cast<size_t>(1);
-                    dims[1] = static_cast<size_t>(1);
-                    matvar = Mat_VarCreate("doppler_step_narrow", MAT_C_SINGLE, MAT_T_SINGLE, 1, dims, &acq_parameters.doppler_step2, 0);
-                    Mat_VarWrite(matfp, matvar, MAT_COMPRESSION_ZLIB);  // or MAT_COMPRESSION_NONE
-                    Mat_VarFree(matvar);
-
-                    aux = d_doppler_center_step_two - static_cast<float>(floor(d_num_doppler_bins_step2 / 2.0)) * acq_parameters.doppler_step2;
-                    matvar = Mat_VarCreate("doppler_grid_narrow_min", MAT_C_SINGLE, MAT_T_SINGLE, 1, dims, &aux, 0);
-                    Mat_VarWrite(matfp, matvar, MAT_COMPRESSION_ZLIB);  // or MAT_COMPRESSION_NONE
-                    Mat_VarFree(matvar);
-                }
-
-            Mat_Close(matfp);
+            record->add_grid("acq_grid_narrow", narrow_grid_.memptr(), static_cast<size_t>(effective_fft_size), static_cast<size_t>(d_num_doppler_bins_step2), acq_parameters.dump_quantized_grid);
+            record->add("doppler_step_narrow", acq_parameters.doppler_step2);
+            record->add("doppler_grid_narrow_min", d_doppler_center_step_two - static_cast<float>(floor(d_num_doppler_bins_step2 / 2.0)) * acq_parameters.doppler_step2);
         }
+    d_dump_writer->push(std::move(record));
 }
 
 
@@ -546,19 +830,17 @@ float pcps_acquisition::max_to_input_power_statistic(uint32_t& indext, int32_t&
 {
     float grid_maximum = 0.0;
     uint32_t index_doppler = 0U;
-    uint32_t tmp_intex_t = 0U;
     uint32_t index_time = 0U;
-    float fft_normalization_factor = static_cast<float>(d_fft_size) * static_cast<float>(d_fft_size);
+    float fft_normalization_factor = static_cast<float>(d_fft_size) * static_cast<float>(peak_search_size());
 
     // Find the correlation peak and the carrier frequency
     for (uint32_t i = 0; i < num_doppler_bins; i++)
         {
-            volk_gnsssdr_32f_index_max_32u(&tmp_intex_t, d_magnitude_grid[i], d_fft_size);
-            if (d_magnitude_grid[i][tmp_intex_t] > grid_maximum)
+            if (d_magnitude_grid_max[i] > grid_maximum)
                 {
-                    grid_maximum = d_magnitude_grid[i][tmp_intex_t];
+                    grid_maximum = d_magnitude_grid_max[i];
                     index_doppler = i;
-                    index_time = tmp_intex_t;
+                    index_time = d_magnitude_grid_max_index[i];
                 }
         }
     indext = index_time;
@@ -584,18 +866,16 @@ float pcps_acquisition::first_vs_second_peak_statistic(uint32_t& indext, int32_t
 
     float firstPeak = 0.0;
     uint32_t index_doppler = 0U;
-    uint32_t tmp_intex_t = 0U;
     uint32_t index_time = 0U;
 
     // Find the correlation peak and the carrier frequency
     for (uint32_t i = 0; i < num_doppler_bins; i++)
         {
-            volk_gnsssdr_32f_index_max_32u(&tmp_intex_t, d_magnitude_grid[i], d_fft_size);
-            if (d_magnitude_grid[i][tmp_intex_t] > firstPeak)
+            if (d_magnitude_grid_max[i] > firstPeak)
                 {
-                    firstPeak = d_magnitude_grid[i][tmp_intex_t];
+                    firstPeak = d_magnitude_grid_max[i];
                     index_doppler = i;
-                    index_time = tmp_intex_t;
+                    index_time = d_magnitude_grid_max_index[i];
                 }
         }
     indext = index_time;
@@ -609,6 +889,34 @@ float pcps_acquisition::first_vs_second_peak_statistic(uint32_t& indext, int32_t
             doppler = static_cast<int32_t>(d_doppler_center_step_two + (static_cast<float>(index_doppler) - static_cast<float>(floor(d_num_doppler_bins_step2 / 2.0))) * acq_parameters.doppler_step2);
         }
 
+    // Find the second highest correlation peak in the same freq. bin ---
+    float secondPeak = 0.0;
+    if (d_reduced_grid or d_searched_on_cuda)
+        {
+            // Already computed by the worker that searched that bin
+            for (const auto& worker : d_doppler_workers)
+                {
+                    if ((worker.doppler_index == index_doppler) and (worker.first_peak > 0.0))
+                        {
+                            secondPeak = worker.second_peak;
+                        }
+                }
+        }
+    else
+        {
+            memcpy(d_tmp_buffer, d_magnitude_grid[index_doppler], peak_search_size() * sizeof(float));
+            secondPeak = second_peak(d_tmp_buffer, index_time);
+        }
+
+    // Compute the test statistics and compare to the threshold
+    return firstPeak / secondPeak;
+}
+
+
+float pcps_acquisition::second_peak(float* magnitude, uint32_t index_time)
+{
+    auto size = static_cast<int32_t>(peak_search_size());
+
     // Find 1 chip wide code phase exclude range around the peak
     int32_t excludeRangeIndex1 = index_time - d_samplesPerChip;
     int32_t excludeRangeIndex2 = index_time + d_samplesPerChip;
@@ -616,57 +924,425 @@ float pcps_acquisition::first_vs_second_peak_statistic(uint32_t& indext, int32_t
     // Correct code phase exclude range if the range includes array boundaries
     if (excludeRangeIndex1 < 0)
         {
-            excludeRangeIndex1 = d_fft_size + excludeRangeIndex1;
+            excludeRangeIndex1 = size + excludeRangeIndex1;
         }
-    else if (excludeRangeIndex2 >= static_cast<int32_t>(d_fft_size))
+    else if (excludeRangeIndex2 >= size)
         {
-            excludeRangeIndex2 = excludeRangeIndex2 - d_fft_size;
+            excludeRangeIndex2 = excludeRangeIndex2 - size;
         }
 
     int32_t idx = excludeRangeIndex1;
-    memcpy(d_tmp_buffer, d_magnitude_grid[index_doppler], d_fft_size);
     do
         {
-            d_tmp_buffer[idx] = 0.0;
+            magnitude[idx] = 0.0;
             idx++;
-            if (idx == static_cast<int32_t>(d_fft_size)) idx = 0;
+            if (idx == size) idx = 0;
         }
     while (idx != excludeRangeIndex2);
 
-    // Find the second highest correlation peak in the same freq. bin ---
-    volk_gnsssdr_32f_index_max_32u(&tmp_intex_t, d_tmp_buffer, d_fft_size);
-    float secondPeak = d_tmp_buffer[tmp_intex_t];
+    uint32_t tmp_intex_t = 0U;
+    volk_gnsssdr_32f_index_max_32u(&tmp_intex_t, magnitude, size);
+    return magnitude[tmp_intex_t];
+}
 
-    // Compute the test statistics and compare to the threshold
-    return firstPeak / secondPeak;
+
+double pcps_acquisition::estimated_cn0_db_hz() const
+{
+    // The max_to_input_power statistic of the peak of one dwell of N samples is
+    // T = (C + sigma^2 / N) / (C + sigma^2), so C / sigma^2 = (T - 1 / N) / (1 - T),
+    // and the noise density is sigma^2 / fs. The losses of the Doppler and
+    // code phase grid and the maximum of the noise over the grid are ignored.
+    if (!d_use_CFAR_algorithm_flag or acq_parameters.bit_transition_flag or d_overlap_save or (d_folding_factor > 1U) or (d_num_noncoherent_integrations_counter == 0U))
+        {
+            return 0.0;
+        }
+    double statistic = static_cast<double>(d_test_statistics) / static_cast<double>(d_num_noncoherent_integrations_counter);
+    double snr = (statistic - 1.0 / static_cast<double>(d_fft_size)) / (1.0 - statistic);
+    if ((snr <= 0.0) or (statistic >= 1.0))
+        {
+            return 0.0;
+        }
+    double fs = static_cast<double>(acq_parameters.use_automatic_resampler ? acq_parameters.resampled_fs : acq_parameters.fs_in);
+    return 10.0 * std::log10(snr * fs);
 }
 
 
-void pcps_acquisition::acquisition_core(uint64_t samp_count)
+uint32_t pcps_acquisition::peak_search_size() const
 {
-    gr::thread::scoped_lock lk(d_setlock);
+    // Length of the rows of the magnitude grid searched in the current step
+    return ((d_folding_factor > 1U) and !d_step_two) ? d_folded_fft_size : d_fft_size;
+}
 
-    // Initialize acquisition algorithm
-    int32_t doppler = 0;
-    uint32_t indext = 0U;
-    int32_t effective_fft_size = (acq_parameters.bit_transition_flag ? d_fft_size / 2 : d_fft_size);
+
+uint32_t pcps_acquisition::resolve_folded_delay(const gr_complex* in, const gr_complex* fft_codes, int32_t doppler, uint32_t folded_index, uint64_t samp_count)
+{
+    // The folded search only finds the code phase modulo d_folded_fft_size. A single full-length
+    // correlation in the Doppler bin of the peak tells which of the d_folding_factor candidates it is
+    Doppler_Worker& worker = d_doppler_workers[0];
+    std::shared_ptr<const gr_complex> shared_spectrum;
+    auto doppler_index = static_cast<uint32_t>((doppler + static_cast<int32_t>(acq_parameters.doppler_max)) / static_cast<int32_t>(d_doppler_step));
+    const gr_complex* spectrum = wiped_off_spectrum(worker, in, d_grid_doppler_wipeoffs.empty() ? nullptr : d_grid_doppler_wipeoffs[doppler_index].get(), static_cast<float>(d_old_freq + doppler), samp_count, shared_spectrum);
+    volk_32fc_x2_multiply_32fc(worker.ifft->get_inbuf(), spectrum, fft_codes, d_fft_size);
+    worker.ifft->execute();
+
+    const gr_complex* correlation = worker.ifft->get_outbuf();
+    uint32_t index_time = folded_index;
+    float max_magnitude = -1.0;
+    for (uint32_t i = 0; i < d_folding_factor; i++)
+        {
+            uint32_t candidate = folded_index + i * d_folded_fft_size;
+            float magnitude = std::norm(correlation[candidate]);
+            if (magnitude > max_magnitude)
+                {
+                    max_magnitude = magnitude;
+                    index_time = candidate;
+                }
+        }
+    return index_time;
+}
+
+
+float pcps_acquisition::fine_doppler_offset(uint32_t index_doppler, uint32_t index_time)
+{
+    if ((index_doppler <= d_doppler_first_bin) or (index_doppler >= d_doppler_last_bin))
+        {
+            return 0.0;
+        }
+    // Correlation amplitudes of the peak and its neighbour bins. Without the
+    // full grid, the maxima of the neighbour bins are close enough
+    float amplitude[3];
+    for (uint32_t i = 0; i < 3; i++)
+        {
+            uint32_t bin = index_doppler + i - 1U;
+            bool full_grid = (!d_reduced_grid and !d_searched_on_cuda);
+            amplitude[i] = std::sqrt(full_grid ? d_magnitude_grid[bin][index_time] : d_magnitude_grid_max[bin]);
+        }
+    // Vertex of the parabola through the three points, in bins
+    float denominator = amplitude[0] - 2.0F * amplitude[1] + amplitude[2];
+    if (denominator >= 0.0)
+        {
+            return 0.0;
+        }
+    float offset = 0.5F * (amplitude[0] - amplitude[2]) / denominator;
+    return std::min(std::max(offset, -0.5F), 0.5F);
+}
+
+
+void pcps_acquisition::wipe_off_doppler(gr_complex* out, const gr_complex* in, const gr_complex* wipeoff, float doppler_hz)
+{
+    if (wipeoff != nullptr)
+        {
+            volk_32fc_x2_multiply_32fc(out, in, wipeoff, d_fft_size);
+        }
+    else
+        {
+            float fs = static_cast<float>(acq_parameters.use_automatic_resampler ? acq_parameters.resampled_fs : acq_parameters.fs_in);
+            float phase_step_rad = GPS_TWO_PI * doppler_hz / fs;
+            lv_32fc_t phase_increment = std::exp(lv_32fc_t(0.0, -phase_step_rad));
+            lv_32fc_t phase = lv_32fc_t(1.0, 0.0);
+            volk_32fc_s32fc_x2_rotator_32fc(out, in, phase_increment, &phase, d_fft_size);
+        }
+}
+
+
+const gr_complex* pcps_acquisition::wiped_off_spectrum(Doppler_Worker& worker, const gr_complex* in, const gr_complex* wipeoff, float doppler_hz, uint64_t samp_count, std::shared_ptr<const gr_complex>& holder)
+{
+    if (d_spectrum_cache)
+        {
+            // Another channel of the same signal could have already processed this block
+            holder = d_spectrum_cache->find(samp_count, doppler_hz);
+            if (holder)
+                {
+                    return holder.get();
+                }
+        }
+
+    // Remove Doppler
     if (d_cshort)
         {
-            volk_gnsssdr_16ic_convert_32fc(d_data_buffer, d_data_buffer_sc, d_consumed_samples);
+            // Wipe-off with 16-bit arithmetic, samples are converted to float only at the FFT input
+            float fs = static_cast<float>(acq_parameters.use_automatic_resampler ? acq_parameters.resampled_fs : acq_parameters.fs_in);
+            float phase_step_rad = GPS_TWO_PI * doppler_hz / fs;
+            lv_32fc_t phase_increment = std::exp(lv_32fc_t(0.0, -phase_step_rad));
+            lv_32fc_t phase = lv_32fc_t(1.0, 0.0);
+            volk_gnsssdr_16ic_s32fc_x2_rotator_16ic(worker.wipeoff_sc, d_input_signal_sc, phase_increment, &phase, d_fft_size);
+            volk_gnsssdr_16ic_convert_32fc(worker.fft_if->get_inbuf(), worker.wipeoff_sc, d_fft_size);
+        }
+    else
+        {
+            wipe_off_doppler(worker.fft_if->get_inbuf(), in, wipeoff, doppler_hz);
         }
-    memcpy(d_input_signal, d_data_buffer, d_consumed_samples * sizeof(gr_complex));
-    if (d_fft_size > d_consumed_samples)
+
+    // Perform the FFT-based convolution  (parallel time search)
+    // Compute the FFT of the carrier wiped--off incoming signal
+    worker.fft_if->execute();
+
+    if (d_spectrum_cache)
         {
-            for (uint32_t i = d_consumed_samples; i < d_fft_size; i++)
+            d_spectrum_cache->insert(samp_count, doppler_hz, worker.fft_if->get_outbuf());
+        }
+    return worker.fft_if->get_outbuf();
+}
+
+
+void pcps_acquisition::update_doppler_window()
+{
+    d_doppler_first_bin = 0U;
+    d_doppler_last_bin = d_num_doppler_bins - 1U;
+    if (acq_parameters.doppler_aiding and (d_gnss_synchro->Acq_doppler_uncertainty_hz > 0.0) and (d_doppler_step > 0U))
+        {
+            // Search only the bins within the predicted Doppler range
+            double doppler_max = static_cast<double>(acq_parameters.doppler_max);
+            double lowest = std::floor((d_gnss_synchro->Acq_doppler_aiding_hz - d_gnss_synchro->Acq_doppler_uncertainty_hz + doppler_max) / static_cast<double>(d_doppler_step));
+            double highest = std::ceil((d_gnss_synchro->Acq_doppler_aiding_hz + d_gnss_synchro->Acq_doppler_uncertainty_hz + doppler_max) / static_cast<double>(d_doppler_step));
+            if ((highest >= 0.0) and (lowest <= static_cast<double>(d_doppler_last_bin)))
                 {
-                    d_input_signal[i] = gr_complex(0.0, 0.0);
+                    d_doppler_first_bin = static_cast<uint32_t>(std::max(lowest, 0.0));
+                    d_doppler_last_bin = static_cast<uint32_t>(std::min(highest, static_cast<double>(d_doppler_last_bin)));
                 }
         }
-    const gr_complex* in = d_input_signal;  // Get the input samples pointer
+    // Bins outside the window do not compete for the maximum
+    std::fill(d_magnitude_grid_max.begin(), d_magnitude_grid_max.end(), 0.0);
+    std::fill(d_magnitude_grid_max_index.begin(), d_magnitude_grid_max_index.end(), 0U);
+    DLOG(INFO) << "Channel: " << d_channel << " , searching Doppler bins " << d_doppler_first_bin << " to " << d_doppler_last_bin << " of " << d_num_doppler_bins;
+}
+
+
+void pcps_acquisition::search_doppler_grid(const gr_complex* in, const gr_complex* fft_codes, const gr_complex* pilot_codes, const gr_complex* first_bin_spectrum, uint64_t samp_count, int32_t effective_fft_size)
+{
+    for (auto& worker : d_doppler_workers)
+        {
+            worker.first_peak = 0.0;
+            worker.second_peak = 0.0;
+            worker.doppler_index = 0U;
+        }
+    d_searched_on_cuda = false;
+#if CUDA_GPU_ACCEL
+    if ((d_cuda_slot >= 0) and (pilot_codes == nullptr))
+        {
+            if (search_doppler_grid_cuda(in, fft_codes, samp_count, effective_fft_size))
+                {
+                    d_searched_on_cuda = true;
+                    return;
+                }
+            LOG(WARNING) << "Channel " << d_channel << ": CUDA acquisition failed, using the CPU from now on";
+            d_cuda_engine->remove_channel(d_cuda_slot);
+            d_cuda_engine.reset();
+            d_cuda_slot = -1;
+        }
+#endif
+    if (d_doppler_workers.size() == 1)
+        {
+            search_doppler_bins(0, in, fft_codes, pilot_codes, first_bin_spectrum, samp_count, effective_fft_size);
+            return;
+        }
+    // Each worker takes one out of every d_doppler_workers.size() bins, so the load is balanced
+    d_doppler_search.in = in;
+    d_doppler_search.fft_codes = fft_codes;
+    d_doppler_search.pilot_codes = pilot_codes;
+    d_doppler_search.first_bin_spectrum = first_bin_spectrum;
+    d_doppler_search.samp_count = samp_count;
+    d_doppler_search.effective_fft_size = effective_fft_size;
+    d_doppler_pool->run(d_doppler_workers.size(), d_search_bins);
+}
+
+
+void pcps_acquisition::multiply_by_code(gr_complex* out, const gr_complex* spectrum, const gr_complex* first_bin_spectrum, uint32_t shift, const gr_complex* fft_codes)
+{
+    if (spectrum != nullptr)
+        {
+            volk_32fc_x2_multiply_32fc(out, spectrum, fft_codes, d_fft_size);
+            return;
+        }
+    // The spectrum of the bin is that of the first bin, circularly shifted
+    volk_32fc_x2_multiply_32fc(out, first_bin_spectrum + shift, fft_codes, d_fft_size - shift);
+    if (shift > 0U)
+        {
+            volk_32fc_x2_multiply_32fc(out + d_fft_size - shift, first_bin_spectrum, fft_codes + d_fft_size - shift, shift);
+        }
+}
+
+
+void pcps_acquisition::search_doppler_bins(uint32_t worker_index, const gr_complex* in, const gr_complex* fft_codes, const gr_complex* pilot_codes, const gr_complex* first_bin_spectrum, uint64_t samp_count, int32_t effective_fft_size)
+{
+    Doppler_Worker& worker = d_doppler_workers[worker_index];
+    std::shared_ptr<const gr_complex> shared_spectrum;
+    uint32_t first_doppler_bin = (d_step_two ? 0U : d_doppler_first_bin);
+    uint32_t num_doppler_bins = (d_step_two ? d_num_doppler_bins_step2 : d_doppler_last_bin + 1U);
+    auto num_workers = static_cast<uint32_t>(d_doppler_workers.size());
+    size_t offset = (acq_parameters.bit_transition_flag ? effective_fft_size : 0);
+    bool folded = ((d_folding_factor > 1U) and !d_step_two);
+    Gnss_Fft* ifft = (folded ? worker.folded_ifft : worker.ifft);
+
+    if (folded and (pilot_codes != nullptr) and (worker_index == 0U))
+        {
+            DLOG(INFO) << "Channel: " << d_channel << " , folded search of the data component only";
+        }
+
+    for (uint32_t doppler_index = first_doppler_bin + worker_index; doppler_index < num_doppler_bins; doppler_index += num_workers)
+        {
+            const gr_complex* spectrum = nullptr;
+            uint32_t shift = 0U;
+            if (d_step_two)
+                {
+                    float doppler_hz = d_doppler_center_step_two + (static_cast<float>(doppler_index) - static_cast<float>(floor(d_num_doppler_bins_step2 / 2.0))) * acq_parameters.doppler_step2;
+                    spectrum = wiped_off_spectrum(worker, in, d_grid_doppler_wipeoffs_step_two[doppler_index], doppler_hz, samp_count, shared_spectrum);
+
+                    // Multiply carrier wiped--off, Fourier transformed incoming signal
+                    // with the local FFT'd code reference using SIMD operations with VOLK library
+                    multiply_by_code(worker.ifft->get_inbuf(), spectrum, nullptr, 0U, fft_codes);
+                }
+            else if (d_doppler_shift_bins > 0U)
+                {
+                    // Multiply the shifted spectrum with the local FFT'd code reference
+                    shift = (doppler_index * d_doppler_shift_bins) % d_fft_size;
+                    multiply_by_code(worker.ifft->get_inbuf(), nullptr, first_bin_spectrum, shift, fft_codes);
+                }
+            else if (folded)
+                {
+                    // Remove Doppler, then add up the blocks of the wiped-off signal (QuickSync folding).
+                    // The folded signal is correlated with the decimated spectrum of the code
+                    int32_t doppler_hz = -static_cast<int32_t>(acq_parameters.doppler_max) + d_doppler_step * doppler_index;
+                    gr_complex* wiped_off = worker.fft_if->get_inbuf();
+                    wipe_off_doppler(wiped_off, in, d_grid_doppler_wipeoffs.empty() ? nullptr : d_grid_doppler_wipeoffs[doppler_index].get(), static_cast<float>(d_old_freq + doppler_hz));
+                    gr_complex* folded_signal = worker.folded_fft->get_inbuf();
+                    memcpy(folded_signal, wiped_off, d_folded_fft_size * sizeof(gr_complex));
+                    for (uint32_t i = 1; i < d_folding_factor; i++)
+                        {
+                            volk_32f_x2_add_32f(reinterpret_cast<float*>(folded_signal), reinterpret_cast<const float*>(folded_signal), reinterpret_cast<const float*>(wiped_off + i * d_folded_fft_size), 2 * d_folded_fft_size);
+                        }
+                    worker.folded_fft->execute();
+                    volk_32fc_x2_multiply_32fc(worker.folded_ifft->get_inbuf(), worker.folded_fft->get_outbuf(), d_folded_codes, d_folded_fft_size);
+                }
+            else
+                {
+                    // Remove Doppler and compute the FFT of the carrier wiped--off incoming signal
+                    int32_t doppler_hz = -static_cast<int32_t>(acq_parameters.doppler_max) + d_doppler_step * doppler_index;
+                    spectrum = wiped_off_spectrum(worker, in, d_grid_doppler_wipeoffs.empty() ? nullptr : d_grid_doppler_wipeoffs[doppler_index].get(), static_cast<float>(d_old_freq + doppler_hz), samp_count, shared_spectrum);
+
+                    // Multiply carrier wiped--off, Fourier transformed incoming signal with the local FFT'd code reference
+                    multiply_by_code(worker.ifft->get_inbuf(), spectrum, nullptr, 0U, fft_codes);
+                }
+
+            // Compute the inverse FFT
+            ifft->execute();
+
+            // Compute squared magnitude (and accumulate in case of non-coherent integration),
+            // and find the maximum of the resulting row in the same pass
+            float* magnitude = (d_reduced_grid ? worker.magnitude : d_magnitude_grid[doppler_index]);
+            uint32_t max_index = 0U;
+            volk_gnsssdr_32fc_magnitude_squared_acc_index_max_32f(magnitude, &max_index,
+                ifft->get_outbuf() + offset, (d_num_noncoherent_integrations_counter == 1 ? 0 : 1), effective_fft_size);
+            if ((pilot_codes != nullptr) and !folded)
+                {
+                    // The same spectrum against the pilot code: one more inverse FFT, and its
+                    // squared magnitude is added to the row (data bits and pilot secondary code
+                    // do not matter, and the row maximum is that of the sum)
+                    multiply_by_code(ifft->get_inbuf(), spectrum, first_bin_spectrum, shift, pilot_codes);
+                    ifft->execute();
+                    volk_gnsssdr_32fc_magnitude_squared_acc_index_max_32f(magnitude, &max_index,
+                        ifft->get_outbuf() + offset, 1, effective_fft_size);
+                }
+            d_magnitude_grid_max[doppler_index] = magnitude[max_index];
+            d_magnitude_grid_max_index[doppler_index] = max_index;
+
+            if (d_reduced_grid)
+                {
+                    // The row is not stored, so get the second peak now if this is the best bin so far
+                    if (magnitude[max_index] > worker.first_peak)
+                        {
+                            worker.first_peak = magnitude[max_index];
+                            worker.doppler_index = doppler_index;
+                            if (!d_use_CFAR_algorithm_flag)
+                                {
+                                    worker.second_peak = second_peak(magnitude, max_index);
+                                }
+                        }
+                }
+            // Record results to file if required
+            else if (d_dump and d_channel == d_dump_channel)
+                {
+                    memcpy((d_step_two ? narrow_grid_ : grid_).colptr(doppler_index), d_magnitude_grid[doppler_index], sizeof(float) * effective_fft_size);
+                }
+        }
+}
+
+
+bool pcps_acquisition::search_doppler_grid_cuda(const gr_complex* in, const gr_complex* fft_codes, uint64_t samp_count, int32_t effective_fft_size)
+{
+#if CUDA_GPU_ACCEL
+    if (fft_codes != d_cuda_code)
+        {
+            if (!d_cuda_engine->set_local_code(d_cuda_slot, fft_codes))
+                {
+                    return false;
+                }
+            d_cuda_code = fft_codes;
+        }
+
+    // Same Doppler bins as the CPU search
+    uint32_t first_doppler_bin = (d_step_two ? 0U : d_doppler_first_bin);
+    uint32_t num_doppler_bins = (d_step_two ? d_num_doppler_bins_step2 : d_doppler_last_bin + 1U);
+    d_cuda_doppler_hz.clear();
+    for (uint32_t doppler_index = first_doppler_bin; doppler_index < num_doppler_bins; doppler_index++)
+        {
+            if (d_step_two)
+                {
+                    d_cuda_doppler_hz.push_back(d_doppler_center_step_two + (static_cast<float>(doppler_index) - static_cast<float>(floor(d_num_doppler_bins_step2 / 2.0))) * acq_parameters.doppler_step2);
+                }
+            else
+                {
+                    d_cuda_doppler_hz.push_back(static_cast<float>(d_old_freq - static_cast<int32_t>(acq_parameters.doppler_max) + static_cast<int32_t>(d_doppler_step * doppler_index)));
+                }
+        }
+
+    uint32_t offset = (acq_parameters.bit_transition_flag ? effective_fft_size : 0);
+    if (!d_cuda_engine->search(d_cuda_slot, std::string(d_gnss_synchro->Signal, 2), samp_count, in, d_cuda_doppler_hz,
+            d_num_noncoherent_integrations_counter != 1, offset, effective_fft_size,
+            &d_magnitude_grid_max[first_doppler_bin], &d_magnitude_grid_max_index[first_doppler_bin], d_magnitude))
+        {
+            return false;
+        }
+
+    // The GPU only returns the row of the highest peak, so the second peak is computed here
+    Doppler_Worker& worker = d_doppler_workers[0];
+    std::fill_n(d_magnitude + effective_fft_size, d_fft_size - effective_fft_size, 0.0);
+    auto best = std::max_element(d_magnitude_grid_max.begin() + first_doppler_bin, d_magnitude_grid_max.begin() + num_doppler_bins);
+    worker.doppler_index = static_cast<uint32_t>(best - d_magnitude_grid_max.begin());
+    worker.first_peak = *best;
+    if (!d_use_CFAR_algorithm_flag)
+        {
+            worker.second_peak = second_peak(d_magnitude, d_magnitude_grid_max_index[worker.doppler_index]);
+        }
+    return true;
+#else
+    return false;
+#endif
+}
+
+
+void pcps_acquisition::acquisition_core(uint64_t samp_count)
+{
+    gr::thread::scoped_lock lk(d_setlock);
+    Gnss_Profile_Scope profile("acquisition_core");
+    const auto start_time = std::chrono::steady_clock::now();
+
+    // Initialize acquisition algorithm
+    int32_t doppler = 0;
+    uint32_t indext = 0U;
+    int32_t effective_fft_size = (acq_parameters.bit_transition_flag ? d_fft_size / 2 : d_fft_size);
+    const gr_complex* in = d_input_signal;  // Get the input samples pointer (nullptr for 16-bit samples, read from d_input_signal_sc)
+    std::shared_ptr<const gr_complex> shared_spectrum;  // keeps alive the spectrum of the first bin in fft_shift mode
+    std::shared_ptr<const gr_complex> fft_codes = d_fft_codes;
+    std::shared_ptr<const gr_complex> pilot_codes = d_fft_codes_pilot;
 
     d_input_power = 0.0;
     d_mag = 0.0;
     d_num_noncoherent_integrations_counter++;
+    if (!d_step_two and d_num_noncoherent_integrations_counter == 1)
+        {
+            update_doppler_window();
+        }
 
     DLOG(INFO) << "Channel: " << d_channel
                << " , doing acquisition of satellite: " << d_gnss_synchro->System << " " << d_gnss_synchro->PRN
@@ -680,46 +1356,44 @@ void pcps_acquisition::acquisition_core(uint64_t samp_count)
     if (d_use_CFAR_algorithm_flag or acq_parameters.bit_transition_flag)
         {
             // Compute the input signal power estimation
-            volk_32fc_magnitude_squared_32f(d_tmp_buffer, in, d_fft_size);
-            volk_32f_accumulator_s32f(&d_input_power, d_tmp_buffer, d_fft_size);
+            if (d_cshort)
+                {
+                    for (uint32_t i = 0; i < d_fft_size; i++)
+                        {
+                            float re = static_cast<float>(d_input_signal_sc[i].real());
+                            float im = static_cast<float>(d_input_signal_sc[i].imag());
+                            d_input_power += re * re + im * im;
+                        }
+                }
+            else
+                {
+                    volk_32fc_magnitude_squared_32f(d_tmp_buffer, in, d_fft_size);
+                    volk_32f_accumulator_s32f(&d_input_power, d_tmp_buffer, d_fft_size);
+                }
             d_input_power /= static_cast<float>(d_fft_size);
         }
 
     // Doppler frequency grid loop
     if (!d_step_two)
         {
-            for (uint32_t doppler_index = 0; doppler_index < d_num_doppler_bins; doppler_index++)
+            const gr_complex* first_bin_spectrum = nullptr;
+            if (d_doppler_shift_bins > 0U)
                 {
-                    // Remove Doppler
-                    volk_32fc_x2_multiply_32fc(d_fft_if->get_inbuf(), in, d_grid_doppler_wipeoffs[doppler_index], d_fft_size);
-
-                    // Perform the FFT-based convolution  (parallel time search)
-                    // Compute the FFT of the carrier wiped--off incoming signal
-                    d_fft_if->execute();
-
-                    // Multiply carrier wiped--off, Fourier transformed incoming signal with the local FFT'd code reference
-                    volk_32fc_x2_multiply_32fc(d_ifft->get_inbuf(), d_fft_if->get_outbuf(), d_fft_codes, d_fft_size);
-
-                    // Compute the inverse FFT
-                    d_ifft->execute();
-
-                    // Compute squared magnitude (and accumulate in case of non-coherent integration)
-                    size_t offset = (acq_parameters.bit_transition_flag ? effective_fft_size : 0);
-                    if (d_num_noncoherent_integrations_counter == 1)
-                        {
-                            volk_32fc_magnitude_squared_32f(d_magnitude_grid[doppler_index], d_ifft->get_outbuf() + offset, effective_fft_size);
-                        }
-                    else
-                        {
-                            volk_32fc_magnitude_squared_32f(d_tmp_buffer, d_ifft->get_outbuf() + offset, effective_fft_size);
-                            volk_32f_x2_add_32f(d_magnitude_grid[doppler_index], d_magnitude_grid[doppler_index], d_tmp_buffer, effective_fft_size);
-                        }
-                    // Record results to file if required
-                    if (d_dump and d_channel == d_dump_channel)
+                    // Only the first bin is wiped off in the time domain, the rest are circular shifts of its spectrum
+                    first_bin_spectrum = wiped_off_spectrum(d_doppler_workers[0], in, d_grid_doppler_wipeoffs.empty() ? nullptr : d_grid_doppler_wipeoffs[0].get(), static_cast<float>(d_old_freq - static_cast<int32_t>(acq_parameters.doppler_max)), samp_count, shared_spectrum);
+                }
+            int32_t search_size = effective_fft_size;
+            if (d_folding_factor > 1U)
+                {
+                    // Folding the input by d_folding_factor decimates its spectrum by the same
+                    // factor, so the folded code spectrum is every d_folding_factor-th bin of the code FFT
+                    for (uint32_t k = 0; k < d_folded_fft_size; k++)
                         {
-                            memcpy(grid_.colptr(doppler_index), d_magnitude_grid[doppler_index], sizeof(float) * effective_fft_size);
+                            d_folded_codes[k] = fft_codes.get()[k * d_folding_factor];
                         }
+                    search_size = static_cast<int32_t>(d_folded_fft_size);
                 }
+            search_doppler_grid(in, fft_codes.get(), pilot_codes.get(), first_bin_spectrum, samp_count, search_size);
 
             // Compute the test statistic
             if (d_use_CFAR_algorithm_flag)
@@ -730,54 +1404,35 @@ void pcps_acquisition::acquisition_core(uint64_t samp_count)
                 {
                     d_test_statistics = first_vs_second_peak_statistic(indext, doppler, d_num_doppler_bins, acq_parameters.doppler_max, d_doppler_step);
                 }
+            auto doppler_hz = static_cast<double>(doppler);
+            if (d_fine_doppler_interpolation)
+                {
+                    auto index_doppler = static_cast<uint32_t>((doppler + static_cast<int32_t>(acq_parameters.doppler_max)) / static_cast<int32_t>(d_doppler_step));
+                    doppler_hz += static_cast<double>(fine_doppler_offset(index_doppler, indext)) * static_cast<double>(d_doppler_step);
+                    d_gnss_synchro->Acq_doppler_step = acq_parameters.doppler_step2;
+                }
+            if (d_folding_factor > 1U)
+                {
+                    indext = resolve_folded_delay(in, fft_codes.get(), doppler, indext, samp_count);
+                }
             if (acq_parameters.use_automatic_resampler)
                 {
                     //take into account the acquisition resampler ratio
                     d_gnss_synchro->Acq_delay_samples = static_cast<double>(std::fmod(static_cast<float>(indext), acq_parameters.samples_per_code)) * acq_parameters.resampler_ratio;
                     d_gnss_synchro->Acq_delay_samples -= static_cast<double>(acq_parameters.resampler_latency_samples);  //account the resampler filter latency
-                    d_gnss_synchro->Acq_doppler_hz = static_cast<double>(doppler);
+                    d_gnss_synchro->Acq_doppler_hz = doppler_hz;
                     d_gnss_synchro->Acq_samplestamp_samples = rint(static_cast<double>(samp_count) * acq_parameters.resampler_ratio);
                 }
             else
                 {
                     d_gnss_synchro->Acq_delay_samples = static_cast<double>(std::fmod(static_cast<float>(indext), acq_parameters.samples_per_code));
-                    d_gnss_synchro->Acq_doppler_hz = static_cast<double>(doppler);
+                    d_gnss_synchro->Acq_doppler_hz = doppler_hz;
                     d_gnss_synchro->Acq_samplestamp_samples = samp_count;
                 }
         }
     else
         {
-            for (uint32_t doppler_index = 0; doppler_index < d_num_doppler_bins_step2; doppler_index++)
-                {
-                    volk_32fc_x2_multiply_32fc(d_fft_if->get_inbuf(), in, d_grid_doppler_wipeoffs_step_two[doppler_index], d_fft_size);
-
-                    // Perform the FFT-based convolution  (parallel time search)
-                    // Compute the FFT of the carrier wiped--off incoming signal
-                    d_fft_if->execute();
-
-                    // Multiply carrier wiped--off, Fourier transformed incoming signal
-                    // with the local FFT'd code reference using SIMD operations with VOLK library
-                    volk_32fc_x2_multiply_32fc(d_ifft->get_inbuf(), d_fft_if->get_outbuf(), d_fft_codes, d_fft_size);
-
-                    // compute the inverse FFT
-                    d_ifft->execute();
-
-                    size_t offset = (acq_parameters.bit_transition_flag ? effective_fft_size : 0);
-                    if (d_num_noncoherent_integrations_counter == 1)
-                        {
-                            volk_32fc_magnitude_squared_32f(d_magnitude_grid[doppler_index], d_ifft->get_outbuf() + offset, effective_fft_size);
-                        }
-                    else
-                        {
-                            volk_32fc_magnitude_squared_32f(d_tmp_buffer, d_ifft->get_outbuf() + offset, effective_fft_size);
-                            volk_32f_x2_add_32f(d_magnitude_grid[doppler_index], d_magnitude_grid[doppler_index], d_tmp_buffer, effective_fft_size);
-                        }
-                    // Record results to file if required
-                    if (d_dump and d_channel == d_dump_channel)
-                        {
-                            memcpy(narrow_grid_.colptr(doppler_index), d_magnitude_grid[doppler_index], sizeof(float) * effective_fft_size);
-                        }
-                }
+            search_doppler_grid(in, fft_codes.get(), pilot_codes.get(), nullptr, samp_count, effective_fft_size);
             // Compute the test statistic
             if (d_use_CFAR_algorithm_flag)
                 {
@@ -807,7 +1462,7 @@ void pcps_acquisition::acquisition_core(uint64_t samp_count)
         }
 
     lk.lock();
-    if (!acq_parameters.bit_transition_flag)
+    if (!acq_parameters.bit_transition_flag or d_overlap_save)
         {
             if (d_test_statistics > d_threshold)
                 {
@@ -836,7 +1491,7 @@ void pcps_acquisition::acquisition_core(uint64_t samp_count)
                 }
             else
                 {
-                    d_buffer_count = 0;
+                    d_buffer_count = (d_overlap_save ? d_consumed_samples / 2 : 0U);
                     d_state = 1;
                 }
 
@@ -881,6 +1536,18 @@ void pcps_acquisition::acquisition_core(uint64_t samp_count)
                     send_negative_acquisition();
                 }
         }
+    if (d_overlap_save)
+        {
+            // Keep the new half block, it will be the first half of the next one
+            if (d_cshort)
+                {
+                    memmove(d_data_buffer_sc, d_data_buffer_sc + d_consumed_samples / 2, d_consumed_samples / 2 * sizeof(lv_16sc_t));
+                }
+            else
+                {
+                    memmove(d_data_buffer, d_data_buffer + d_consumed_samples / 2, d_consumed_samples / 2 * sizeof(gr_complex));
+                }
+        }
     d_worker_active = false;
 
     if ((d_num_noncoherent_integrations_counter == acq_parameters.max_dwells) or (d_positive_acq == 1))
@@ -891,15 +1558,27 @@ void pcps_acquisition::acquisition_core(uint64_t samp_count)
                     pcps_acquisition::dump_results(effective_fft_size);
                 }
             d_num_noncoherent_integrations_counter = 0U;
-            d_positive_acq = 0;
-            // Reset grid
-            for (uint32_t i = 0; i < d_num_doppler_bins; i++)
+            if ((d_positive_acq == 1) and acq_parameters.release_buffers)
+                {
+                    // The channel moves on to tracking, the buffers are allocated again in the next acquisition
+                    release_acquisition_buffers();
+                }
+            else if (!d_reduced_grid)
                 {
-                    for (uint32_t k = 0; k < d_fft_size; k++)
+                    // Reset grid
+                    for (uint32_t i = 0; i < d_num_doppler_bins; i++)
                         {
-                            d_magnitude_grid[i][k] = 0.0;
+                            for (uint32_t k = 0; k < d_fft_size; k++)
+                                {
+                                    d_magnitude_grid[i][k] = 0.0;
+                                }
                         }
                 }
+            d_positive_acq = 0;
+        }
+    if (d_acquisition_time)
+        {
+            d_acquisition_time->record(std::chrono::steady_clock::now() - start_time);
         }
 }
 
@@ -941,6 +1620,10 @@ int pcps_acquisition::general_work(int noutput_items __attribute__((unused)),
                 }
             return 0;
         }
+    if (!d_buffers_allocated)
+        {
+            allocate_acquisition_buffers();
+        }
 
     switch (d_state)
         {
@@ -966,6 +1649,39 @@ int pcps_acquisition::general_work(int noutput_items __attribute__((unused)),
         case 1:
             {
                 uint32_t buff_increment;
+                if (acq_parameters.use_shared_fft and (d_buffer_count == 0U))
+                    {
+                        // Start the capture at a block boundary, so all the channels
+                        // of the same signal process the same blocks of samples
+                        auto misalignment = static_cast<uint32_t>(d_sample_counter % d_consumed_samples);
+                        if (misalignment != 0U)
+                            {
+                                uint32_t skip = std::min(static_cast<uint32_t>(ninput_items[0]), d_consumed_samples - misalignment);
+                                d_sample_counter += static_cast<uint64_t>(skip);
+                                consume_each(skip);
+                                break;
+                            }
+                    }
+                if (acq_parameters.blocking and (d_buffer_count == 0U) and !d_overlap_save and (d_fft_size == d_consumed_samples) and (ninput_items[0] >= static_cast<int>(d_consumed_samples)))
+                    {
+                        // The whole block is already in the input buffer, and it does not need padding:
+                        // it is searched in place, and consumed when the search is done
+                        if (d_cshort)
+                            {
+                                d_input_signal_sc = reinterpret_cast<const lv_16sc_t*>(input_items[0]);
+                            }
+                        else
+                            {
+                                d_input_signal = reinterpret_cast<const gr_complex*>(input_items[0]);
+                            }
+                        d_sample_counter += static_cast<uint64_t>(d_consumed_samples);
+                        lk.unlock();
+                        acquisition_core(d_sample_counter);
+                        consume_each(d_consumed_samples);
+                        break;
+                    }
+                d_input_signal = d_data_buffer;
+                d_input_signal_sc = d_data_buffer_sc;
                 if (d_cshort)
                     {
                         const auto* in = reinterpret_cast<const lv_16sc_t*>(input_items[0]);  // Get the input samples pointer
@@ -1017,7 +1733,7 @@ int pcps_acquisition::general_work(int noutput_items __attribute__((unused)),
                         d_worker_active = true;
                     }
                 consume_each(0);
-                d_buffer_count = 0U;
+                d_buffer_count = (d_overlap_save ? d_consumed_samples / 2 : 0U);
                 break;
             }
         }
@@ -26,7 +26,7 @@
  *
  * -------------------------------------------------------------------------
  *
- * Copyright (C) 2010-2018  (see AUTHORS file for a list of contributors)
+ * Copyright (C) 2010-2019  (see AUTHORS file for a list of contributors)
  *
  * GNSS-SDR is a software defined Global Navigation
  *          Satellite Systems receiver
@@ -53,14 +53,24 @@
 #define GNSS_SDR_PCPS_ACQUISITION_H_
 
 #include "acq_conf.h"
+#include "acq_doppler_thread_pool.h"
+#include "acq_spectrum_cache.h"
+#include "gnss_arena.h"
+#include "gnss_fft.h"
+#include "gnss_memory_accounting.h"
+#include "gnss_metrics.h"
 #include "gnss_synchro.h"
 #include <armadillo>
 #include <gnuradio/block.h>
-#include <gnuradio/fft/fft.h>
 #include <volk/volk.h>
+#include <functional>
+#include <memory>
 #include <string>
+#include <vector>
 
 
+class Acq_Cuda_Engine;
+class Acq_Dump_Writer;
 class pcps_acquisition;
 
 typedef boost::shared_ptr<pcps_acquisition> pcps_acquisition_sptr;
@@ -82,13 +92,62 @@ private:
 
     pcps_acquisition(const Acq_Conf& conf_);
 
+    /*!
+     * \brief Resources owned by each of the threads sharing the Doppler grid search.
+     */
+    struct Doppler_Worker
+    {
+        Gnss_Fft* fft_if;
+        Gnss_Fft* ifft;
+        Gnss_Fft* folded_fft;  // plans of d_folded_fft_size points, only with folding
+        Gnss_Fft* folded_ifft;
+        lv_16sc_t* wipeoff_sc;  // Doppler wiped-off 16-bit samples, only for cshort inputs
+        float* magnitude;       // magnitude of the last searched bin, only with reduced_grid
+        float first_peak;       // best peak found by this worker, only with reduced_grid
+        float second_peak;      // second peak in the bin of first_peak, only with reduced_grid
+        uint32_t doppler_index;
+    };
+
+    /*!
+     * \brief Arguments of the Doppler grid search of the current dwell, shared by its workers.
+     */
+    struct Doppler_Search
+    {
+        const gr_complex* in;
+        const gr_complex* fft_codes;
+        const gr_complex* pilot_codes;
+        const gr_complex* first_bin_spectrum;
+        uint64_t samp_count;
+        int32_t effective_fft_size;
+    };
+
+    void allocate_acquisition_buffers();
+    void release_acquisition_buffers();
+    void take_acquisition_buffers();
     void update_local_carrier(gr_complex* carrier_vector, int32_t correlator_length_samples, float freq);
+    void update_intermediate_frequency();
+    std::string local_code_key(const std::string& code_id) const;
     void update_grid_doppler_wipeoffs();
+    void update_doppler_shift_bins();
     void update_grid_doppler_wipeoffs_step2();
+    void update_doppler_window();
+    float fine_doppler_offset(uint32_t index_doppler, uint32_t index_time);
+    uint32_t peak_search_size() const;
+    double estimated_cn0_db_hz() const;  // from the test statistic, 0 if it is not available
+    uint32_t resolve_folded_delay(const gr_complex* in, const gr_complex* fft_codes, int32_t doppler, uint32_t folded_index, uint64_t samp_count);
     bool is_fdma();
 
     void acquisition_core(uint64_t samp_count);
 
+    void search_doppler_grid(const gr_complex* in, const gr_complex* fft_codes, const gr_complex* pilot_codes, const gr_complex* first_bin_spectrum, uint64_t samp_count, int32_t effective_fft_size);
+    void search_doppler_bins(uint32_t worker_index, const gr_complex* in, const gr_complex* fft_codes, const gr_complex* pilot_codes, const gr_complex* first_bin_spectrum, uint64_t samp_count, int32_t effective_fft_size);
+    void multiply_by_code(gr_complex* out, const gr_complex* spectrum, const gr_complex* first_bin_spectrum, uint32_t shift, const gr_complex* fft_codes);
+    std::shared_ptr<const gr_complex> code_spectrum(std::complex<float>* code, const std::string& code_id);
+    bool search_doppler_grid_cuda(const gr_complex* in, const gr_complex* fft_codes, uint64_t samp_count, int32_t effective_fft_size);
+
+    void wipe_off_doppler(gr_complex* out, const gr_complex* in, const gr_complex* wipeoff, float doppler_hz);
+    const gr_complex* wiped_off_spectrum(Doppler_Worker& worker, const gr_complex* in, const gr_complex* wipeoff, float doppler_hz, uint64_t samp_count, std::shared_ptr<const gr_complex>& holder);
+
     void send_negative_acquisition();
 
     void send_positive_acquisition();
@@ -96,6 +155,7 @@ private:
     void dump_results(int32_t effective_fft_size);
 
     float first_vs_second_peak_statistic(uint32_t& indext, int32_t& doppler, uint32_t num_doppler_bins, int32_t doppler_max, int32_t doppler_step);
+    float second_peak(float* magnitude, uint32_t index_time);
     float max_to_input_power_statistic(uint32_t& indext, int32_t& doppler, float input_power, uint32_t num_doppler_bins, int32_t doppler_max, int32_t doppler_step);
 
     bool start();
@@ -104,9 +164,13 @@ private:
     Acq_Conf acq_parameters;
     bool d_active;
     bool d_worker_active;
+    bool d_buffers_allocated;  // the search buffers only exist while the channel is acquiring
     bool d_cshort;
     bool d_step_two;
     bool d_use_CFAR_algorithm_flag;
+    bool d_reduced_grid;
+    bool d_overlap_save;                // slide the bit transition search windows by half a block
+    bool d_fine_doppler_interpolation;  // refine the Doppler of the peak from its neighbour bins instead of a second step
     int32_t d_positive_acq;
     float d_threshold;
     float d_mag;
@@ -114,26 +178,51 @@ private:
     float d_test_statistics;
     float* d_magnitude;
     float** d_magnitude_grid;
+    std::vector<float> d_magnitude_grid_max;           // maximum of each row of d_magnitude_grid
+    std::vector<uint32_t> d_magnitude_grid_max_index;  // position of the maximum of each row of d_magnitude_grid
     float* d_tmp_buffer;
-    gr_complex* d_input_signal;
+    const gr_complex* d_input_signal;    // samples searched by acquisition_core(): d_data_buffer, or the input buffer of the block
+    const lv_16sc_t* d_input_signal_sc;  // same, for 16-bit samples
     uint32_t d_samplesPerChip;
     int64_t d_old_freq;
     int32_t d_state;
     uint32_t d_channel;
+    std::shared_ptr<Gnss_Duration_Histogram> d_acquisition_time;  // duration of each run of acquisition_core()
+    std::shared_ptr<Gnss_Signal_Counters> d_signal_counters;
+    Gnss_Memory_Account d_memory;  // FFT plans and search buffers of this channel
+    Gnss_Arena d_arena;            // search buffers, while the channel is acquiring
     uint32_t d_doppler_step;
     float d_doppler_center_step_two;
     uint32_t d_num_noncoherent_integrations_counter;
     uint32_t d_fft_size;
+    uint32_t d_folding_factor;   // number of blocks added up before the first step search, 1 if folding is disabled
+    uint32_t d_folded_fft_size;  // d_fft_size / d_folding_factor
+    gr_complex* d_folded_codes;  // spectrum of the folded local code, taken from every d_folding_factor-th bin of the code FFT
     uint32_t d_consumed_samples;
     uint32_t d_num_doppler_bins;
+    uint32_t d_doppler_shift_bins;
+    uint32_t d_doppler_first_bin;  // first Doppler bin searched in the first step
+    uint32_t d_doppler_last_bin;   // last Doppler bin searched in the first step
     uint64_t d_sample_counter;
-    gr_complex** d_grid_doppler_wipeoffs;
+    std::vector<std::shared_ptr<const gr_complex> > d_grid_doppler_wipeoffs;
     gr_complex** d_grid_doppler_wipeoffs_step_two;
-    gr_complex* d_fft_codes;
-    gr_complex* d_data_buffer;
+    std::shared_ptr<const gr_complex> d_fft_codes;
+    std::shared_ptr<const gr_complex> d_fft_codes_pilot;  // second component searched with the same spectra, if any
+    gr_complex* d_data_buffer;     // d_consumed_samples gathered from the input, followed by the zero padding up to d_fft_size
     lv_16sc_t* d_data_buffer_sc;
-    gr::fft::fft_complex* d_fft_if;
-    gr::fft::fft_complex* d_ifft;
+    Gnss_Fft* d_fft_if;
+    Gnss_Fft* d_ifft;
+    std::vector<Doppler_Worker> d_doppler_workers;
+    std::shared_ptr<Acq_Doppler_Thread_Pool> d_doppler_pool;  // only with more than one Doppler worker
+    Doppler_Search d_doppler_search;
+    std::function<void(uint32_t)> d_search_bins;  // search_doppler_bins() of a worker, with the arguments in d_doppler_search
+    std::shared_ptr<Acq_Spectrum_Cache> d_spectrum_cache;
+    std::shared_ptr<Acq_Cuda_Engine> d_cuda_engine;
+    int32_t d_cuda_slot;                // slot of this channel in d_cuda_engine, -1 if the search runs on the CPU
+    bool d_searched_on_cuda;            // the last dwell ran on the GPU, which only returns the peaks of each bin
+    uint32_t d_cuda_doppler_bins;       // number of Doppler bins reserved in the slot
+    const gr_complex* d_cuda_code;      // local code currently uploaded to the slot
+    std::vector<float> d_cuda_doppler_hz;
     Gnss_Synchro* d_gnss_synchro;
     arma::fmat grid_;
     arma::fmat narrow_grid_;
@@ -143,6 +232,7 @@ private:
     uint32_t d_buffer_count;
     bool d_dump;
     std::string d_dump_filename;
+    std::shared_ptr<Acq_Dump_Writer> d_dump_writer;
 
 public:
     ~pcps_acquisition();
@@ -177,6 +267,39 @@ public:
       */
     void set_local_code(std::complex<float>* code);
 
+    /*!
+      * \brief Sets local code for PCPS acquisition algorithm, and stores
+      * its FFT in the process-wide code cache.
+      * \param code - Pointer to the PRN code.
+      * \param code_id - Identifier of the code replica (signal, PRN and
+      * sampling rate), as passed to load_local_code().
+      */
+    void set_local_code(std::complex<float>* code, const std::string& code_id);
+
+    /*!
+      * \brief Sets the local code from the process-wide code cache.
+      * \param code_id - Identifier of the code replica.
+      * \return false if the code is not in the cache. In that case, the
+      * code has to be generated and passed to set_local_code().
+      */
+    bool load_local_code(const std::string& code_id);
+
+    /*!
+      * \brief Sets the local codes of the data and pilot components of a
+      * signal, searched together: each Doppler bin of the input is Fourier
+      * transformed once and correlated with both codes, and the squared
+      * magnitudes of both correlations are added (non-coherently, so the
+      * data bits do not matter). The folded search looks for the data
+      * component only, and these channels do not use the GPU.
+      */
+    void set_local_code(std::complex<float>* code, const std::string& code_id, std::complex<float>* pilot_code, const std::string& pilot_code_id);
+
+    /*!
+      * \brief Sets the local codes of the data and pilot components from
+      * the process-wide code cache, as load_local_code().
+      */
+    bool load_local_code(const std::string& code_id, const std::string& pilot_code_id);
+
     /*!
       * \brief Starts acquisition algorithm, turning from standby mode to
       * active mode
@@ -203,6 +326,8 @@ public:
     {
         gr::thread::scoped_lock lock(d_setlock);  // require mutex with work function called by the scheduler
         d_channel = channel;
+        d_acquisition_time = Gnss_Metrics::get_instance()->get_histogram("gnss_sdr_acquisition_seconds", "channel=\"" + std::to_string(channel) + "\"");
+        d_memory.set_channel(static_cast<int32_t>(channel));
     }
 
     /*!
@@ -32,6 +32,7 @@
 
 #include "pcps_acquisition_fine_doppler_cc.h"
 #include "GPS_L1_CA.h"
+#include "acq_doppler_wipeoff_cache.h"
 #include "control_message_factory.h"
 #include "gnss_sdr_create_directory.h"
 #include "gps_sdr_signal_processing.h"
@@ -78,10 +79,10 @@ pcps_acquisition_fine_doppler_cc::pcps_acquisition_fine_doppler_cc(const Acq_Con
     d_10_ms_buffer = static_cast<gr_complex *>(volk_gnsssdr_malloc(50 * d_samples_per_ms * sizeof(gr_complex), volk_gnsssdr_get_alignment()));
 
     // Direct FFT
-    d_fft_if = new gr::fft::fft_complex(d_fft_size, true);
+    d_fft_if = new Gnss_Fft(d_fft_size, true, acq_parameters.fft_conf);
 
     // Inverse FFT
-    d_ifft = new gr::fft::fft_complex(d_fft_size, false);
+    d_ifft = new Gnss_Fft(d_fft_size, false, acq_parameters.fft_conf);
 
     // For dumping samples into a file
     d_dump = conf_.dump;
@@ -124,7 +125,6 @@ pcps_acquisition_fine_doppler_cc::pcps_acquisition_fine_doppler_cc(const Acq_Con
     d_num_doppler_points = 0;
     d_doppler_step = 0;
     d_grid_data = nullptr;
-    d_grid_doppler_wipeoffs = nullptr;
     d_gnss_synchro = nullptr;
     d_code_phase = 0;
     d_doppler_freq = 0;
@@ -180,10 +180,9 @@ void pcps_acquisition_fine_doppler_cc::free_grid_memory()
     for (int i = 0; i < d_num_doppler_points; i++)
         {
             volk_gnsssdr_free(d_grid_data[i]);
-            delete[] d_grid_doppler_wipeoffs[i];
         }
     delete d_grid_data;
-    delete d_grid_doppler_wipeoffs;
+    d_grid_doppler_wipeoffs.clear();
 }
 
 
@@ -248,20 +247,13 @@ void pcps_acquisition_fine_doppler_cc::reset_grid()
 
 void pcps_acquisition_fine_doppler_cc::update_carrier_wipeoff()
 {
-    // create the carrier Doppler wipeoff signals
+    // Tables are shared with all the other instances working with the same sampling rate and Doppler grid
     int doppler_hz;
-    float phase_step_rad;
-    d_grid_doppler_wipeoffs = new gr_complex *[d_num_doppler_points];
+    d_grid_doppler_wipeoffs.resize(d_num_doppler_points);
     for (int doppler_index = 0; doppler_index < d_num_doppler_points; doppler_index++)
         {
             doppler_hz = d_doppler_step * doppler_index - d_config_doppler_max;
-            // doppler search steps
-            // compute the carrier doppler wipe-off signal and store it
-            phase_step_rad = static_cast<float>(GPS_TWO_PI) * doppler_hz / static_cast<float>(d_fs_in);
-            d_grid_doppler_wipeoffs[doppler_index] = new gr_complex[d_fft_size];
-            float _phase[1];
-            _phase[0] = 0;
-            volk_gnsssdr_s32f_sincos_32fc(d_grid_doppler_wipeoffs[doppler_index], -phase_step_rad, _phase, d_fft_size);
+            d_grid_doppler_wipeoffs[doppler_index] = Acq_Doppler_Wipeoff_Cache::get_instance()->get(d_fs_in, d_fft_size, static_cast<float>(doppler_hz));
         }
 }
 
@@ -365,7 +357,7 @@ int pcps_acquisition_fine_doppler_cc::compute_and_accumulate_grid(gr_vector_cons
         {
             // doppler search steps
             // Perform the carrier wipe-off
-            volk_32fc_x2_multiply_32fc(d_fft_if->get_inbuf(), in, d_grid_doppler_wipeoffs[doppler_index], d_fft_size);
+            volk_32fc_x2_multiply_32fc(d_fft_if->get_inbuf(), in, d_grid_doppler_wipeoffs[doppler_index].get(), d_fft_size);
 
             // 3- Perform the FFT-based convolution  (parallel time search)
             // Compute the FFT of the carrier wiped--off incoming signal
@@ -405,7 +397,7 @@ int pcps_acquisition_fine_doppler_cc::estimate_Doppler()
     int signal_samples = prn_replicas * d_fft_size;
     //int fft_size_extended = nextPowerOf2(signal_samples * zero_padding_factor);
     int fft_size_extended = signal_samples * zero_padding_factor;
-    auto *fft_operator = new gr::fft::fft_complex(fft_size_extended, true);
+    auto *fft_operator = new Gnss_Fft(fft_size_extended, true, acq_parameters.fft_conf);
     //zero padding the entire vector
     std::fill_n(fft_operator->get_inbuf(), fft_size_extended, gr_complex(0.0, 0.0));
 
@@ -50,13 +50,15 @@
 #define GNSS_SDR_PCPS_ACQUISITION_FINE_DOPPLER_CC_H_
 
 #include "acq_conf.h"
+#include "gnss_fft.h"
 #include "gnss_synchro.h"
 #include <armadillo>
 #include <gnuradio/block.h>
-#include <gnuradio/fft/fft.h>
 #include <gnuradio/gr_complex.h>
 #include <fstream>
+#include <memory>
 #include <string>
+#include <vector>
 
 class pcps_acquisition_fine_doppler_cc;
 
@@ -105,10 +107,10 @@ private:
     float* d_magnitude;
 
     float** d_grid_data;
-    gr_complex** d_grid_doppler_wipeoffs;
+    std::vector<std::shared_ptr<const gr_complex> > d_grid_doppler_wipeoffs;
 
-    gr::fft::fft_complex* d_fft_if;
-    gr::fft::fft_complex* d_ifft;
+    Gnss_Fft* d_fft_if;
+    Gnss_Fft* d_ifft;
     Gnss_Synchro* d_gnss_synchro;
     unsigned int d_code_phase;
     float d_doppler_freq;
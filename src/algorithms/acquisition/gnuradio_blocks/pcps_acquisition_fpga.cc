@@ -104,6 +104,7 @@ pcps_acquisition_fpga::pcps_acquisition_fpga(pcpsconf_fpga_t conf_) : gr::block(
 pcps_acquisition_fpga::~pcps_acquisition_fpga()
 {
     //  printf("acq destructor start\n");
+    acquisition_fpga->cancel_acquisitions();
     acquisition_fpga->free();
     //  printf("acq destructor end\n");
 }
@@ -112,7 +113,11 @@ pcps_acquisition_fpga::~pcps_acquisition_fpga()
 void pcps_acquisition_fpga::set_local_code()
 {
     //   printf("acq set local code start\n");
-    acquisition_fpga->set_local_code(d_gnss_synchro->PRN);
+    if (!acq_parameters.pipelined)
+        {
+            // Otherwise, it is written by the queued job, right before the search
+            acquisition_fpga->set_local_code(d_gnss_synchro->PRN);
+        }
     //   printf("acq set local code end\n");
 }
 
@@ -131,7 +136,10 @@ void pcps_acquisition_fpga::init()
     d_input_power = 0.0;
     d_num_doppler_bins = static_cast<uint32_t>(std::ceil(static_cast<double>(static_cast<int32_t>(acq_parameters.doppler_max) - static_cast<int32_t>(-acq_parameters.doppler_max)) / static_cast<double>(d_doppler_step)));
 
-    acquisition_fpga->init();
+    if (!acq_parameters.pipelined)
+        {
+            acquisition_fpga->init();
+        }
     //  printf("acq init end\n");
 }
 
@@ -208,8 +216,6 @@ void pcps_acquisition_fpga::set_active(bool active)
     d_active = active;
 
     // initialize acquisition algorithm
-    uint32_t indext = 0U;
-    float magt = 0.0;
     float fft_normalization_factor = static_cast<float>(d_fft_size) * static_cast<float>(d_fft_size);
 
     d_input_power = 0.0;
@@ -223,7 +229,6 @@ void pcps_acquisition_fpga::set_active(bool active)
                // no CFAR algorithm in the FPGA
                << ", use_CFAR_algorithm_flag: false";
 
-    uint64_t initial_sample;
     float input_power_all = 0.0;
     float input_power_computed = 0.0;
 
@@ -268,68 +273,54 @@ void pcps_acquisition_fpga::set_active(bool active)
     // debug
     //acquisition_fpga->block_samples();
 
+    if (acq_parameters.pipelined)
+        {
+            // The search is queued with the ones of the rest of channels, and the results are processed on completion
+            acquisition_fpga->post_acquisition(d_gnss_synchro->PRN, d_num_doppler_bins,
+                [this](const Fpga_Acquisition_Result& result) { process_acquisition_results(result); });
+            return;
+        }
+
     // run loop in hw
     //printf("LAUNCH ACQ\n");
+    Fpga_Acquisition_Result result;
     acquisition_fpga->set_doppler_sweep(d_num_doppler_bins);
     acquisition_fpga->run_acquisition();
-    acquisition_fpga->read_acquisition_results(&indext, &magt,
-        &initial_sample, &d_input_power, &d_doppler_index);
+    acquisition_fpga->read_acquisition_results(&result.max_index, &result.max_magnitude,
+        &result.initial_sample, &result.power_sum, &result.doppler_index);
     //printf("READ ACQ RESULTS\n");
 
     // debug
     //acquisition_fpga->unblock_samples();
 
-    d_mag = magt;
+    process_acquisition_results(result);
+    //   printf("acq set active end\n");
+}
 
 
+void pcps_acquisition_fpga::process_acquisition_results(const Fpga_Acquisition_Result& result)
+{
+    d_mag = result.max_magnitude;
+    d_input_power = result.power_sum;
+    d_doppler_index = result.doppler_index;
+
     // debug
-    debug_d_max_absolute = magt;
+    debug_d_max_absolute = d_mag;
     debug_d_input_power_absolute = d_input_power;
-    debug_indext = indext;
+    debug_indext = result.max_index;
     debug_doppler_index = d_doppler_index;
 
-    //  temp_d_input_power = d_input_power;
-
     d_input_power = (d_input_power - d_mag) / (d_fft_size - 1);
     int32_t doppler = -static_cast<int32_t>(acq_parameters.doppler_max) + d_doppler_step * d_doppler_index;
-    //d_gnss_synchro->Acq_delay_samples = static_cast<double>(2*(indext % (2*acq_parameters.samples_per_code)));
-    d_gnss_synchro->Acq_delay_samples = static_cast<double>(indext % acq_parameters.samples_per_code);
+    d_gnss_synchro->Acq_delay_samples = static_cast<double>(result.max_index % acq_parameters.samples_per_code);
     d_gnss_synchro->Acq_doppler_hz = static_cast<double>(doppler);
-    d_sample_counter = initial_sample;
-    //d_gnss_synchro->Acq_samplestamp_samples = 2*d_sample_counter - 81; // delay due to the downsampling filter in the acquisition
-    //d_gnss_synchro->Acq_samplestamp_samples = d_sample_counter - 40; // delay due to the downsampling filter in the acquisition
+    d_sample_counter = result.initial_sample;
     d_gnss_synchro->Acq_samplestamp_samples = d_sample_counter;  // delay due to the downsampling filter in the acquisition
     d_test_statistics = (d_mag / d_input_power);                 //* correction_factor;
 
-    // debug
-    //    if (d_gnss_synchro->Acq_delay_samples > acq_parameters.code_length)
-    //        {
-    //            printf("d_gnss_synchro->Acq_samplestamp_samples = %d\n", d_gnss_synchro->Acq_samplestamp_samples);
-    //            printf("d_gnss_synchro->Acq_delay_samples = %f\n", d_gnss_synchro->Acq_delay_samples);
-    //        }
-
-    // if (temp_d_input_power > debug_d_input_power_absolute)
-    //     {
-    //         debug_d_max_absolute = d_mag;
-    //         debug_d_input_power_absolute = temp_d_input_power;
-    //     }
-    // printf ("max debug_d_max_absolute = %f\n", debug_d_max_absolute);
-    // printf ("debug_d_input_power_absolute = %f\n", debug_d_input_power_absolute);
-
-    //    printf("&&&&& d_test_statistics = %f\n", d_test_statistics);
-    //    printf("&&&&& debug_d_max_absolute =%f\n",debug_d_max_absolute);
-    //    printf("&&&&& debug_d_input_power_absolute =%f\n",debug_d_input_power_absolute);
-    //    printf("&&&&& debug_indext = %d\n",debug_indext);
-    //    printf("&&&&& debug_doppler_index = %d\n",debug_doppler_index);
-
     if (d_test_statistics > d_threshold)
         {
             d_active = false;
-            //            printf("##### d_test_statistics = %f\n", d_test_statistics);
-            //            printf("##### debug_d_max_absolute =%f\n",debug_d_max_absolute);
-            //            printf("##### debug_d_input_power_absolute =%f\n",debug_d_input_power_absolute);
-            //            printf("##### initial_sample = %llu\n",initial_sample);
-            //            printf("##### debug_doppler_index = %d\n",debug_doppler_index);
             send_positive_acquisition();
             d_state = 0;  // Positive acquisition
         }
@@ -339,8 +330,17 @@ void pcps_acquisition_fpga::set_active(bool active)
             d_active = false;
             send_negative_acquisition();
         }
+}
 
-    //   printf("acq set active end\n");
+
+void pcps_acquisition_fpga::stop_acquisition()
+{
+    if (acq_parameters.pipelined)
+        {
+            // Discard the queued search, if any
+            acquisition_fpga->cancel_acquisitions();
+        }
+    d_active = false;
 }
 
 
@@ -73,6 +73,7 @@ typedef struct
     uint32_t select_queue_Fpga;
     std::string device_name;
     lv_16sc_t* all_fft_codes;  // memory that contains all the code ffts
+    bool pipelined;            // queue the searches in the engine shared by all the channels, without waiting for them
 
 } pcpsconf_fpga_t;
 
@@ -102,6 +103,8 @@ private:
 
     void send_positive_acquisition();
 
+    void process_acquisition_results(const Fpga_Acquisition_Result& result);
+
     pcpsconf_fpga_t acq_parameters;
     bool d_active;
     float d_threshold;
@@ -174,6 +177,12 @@ public:
       */
     void set_active(bool active);
 
+    /*!
+      * \brief Stops the acquisition. With pipelined searches, the
+      * search posted by this channel is discarded.
+      */
+    void stop_acquisition();
+
     /*!
       * \brief Set acquisition channel unique ID
       * \param channel - receiver channel.
@@ -48,18 +48,18 @@ using google::LogMessage;
 
 pcps_assisted_acquisition_cc_sptr pcps_make_assisted_acquisition_cc(
     int32_t max_dwells, uint32_t sampled_ms, int32_t doppler_max, int32_t doppler_min,
-    int64_t fs_in, int32_t samples_per_ms, bool dump,
+    int64_t fs_in, int32_t samples_per_ms, const Gnss_Fft_Conf& fft_conf, bool dump,
     std::string dump_filename)
 {
     return pcps_assisted_acquisition_cc_sptr(
         new pcps_assisted_acquisition_cc(max_dwells, sampled_ms, doppler_max, doppler_min,
-            fs_in, samples_per_ms, dump, std::move(dump_filename)));
+            fs_in, samples_per_ms, fft_conf, dump, std::move(dump_filename)));
 }
 
 
 pcps_assisted_acquisition_cc::pcps_assisted_acquisition_cc(
     int32_t max_dwells, uint32_t sampled_ms, int32_t doppler_max, int32_t doppler_min,
-    int64_t fs_in, int32_t samples_per_ms, bool dump,
+    int64_t fs_in, int32_t samples_per_ms, const Gnss_Fft_Conf& fft_conf, bool dump,
     std::string dump_filename) : gr::block("pcps_assisted_acquisition_cc",
                                      gr::io_signature::make(1, 1, sizeof(gr_complex)),
                                      gr::io_signature::make(0, 0, sizeof(gr_complex)))
@@ -83,10 +83,10 @@ pcps_assisted_acquisition_cc::pcps_assisted_acquisition_cc(
     d_carrier = static_cast<gr_complex *>(volk_gnsssdr_malloc(d_fft_size * sizeof(gr_complex), volk_gnsssdr_get_alignment()));
 
     // Direct FFT
-    d_fft_if = new gr::fft::fft_complex(d_fft_size, true);
+    d_fft_if = new Gnss_Fft(d_fft_size, true, fft_conf);
 
     // Inverse FFT
-    d_ifft = new gr::fft::fft_complex(d_fft_size, false);
+    d_ifft = new Gnss_Fft(d_fft_size, false, fft_conf);
 
     // For dumping samples into a file
     d_dump = dump;
@@ -48,9 +48,9 @@
 #ifndef GNSS_SDR_PCPS_ASSISTED_ACQUISITION_CC_H_
 #define GNSS_SDR_PCPS_ASSISTED_ACQUISITION_CC_H_
 
+#include "gnss_fft.h"
 #include "gnss_synchro.h"
 #include <gnuradio/block.h>
-#include <gnuradio/fft/fft.h>
 #include <gnuradio/gr_complex.h>
 #include <fstream>
 #include <string>
@@ -68,7 +68,7 @@ pcps_make_assisted_acquisition_cc(
     int32_t doppler_min,
     int64_t fs_in,
     int32_t samples_per_ms,
-    bool dump, std::string dump_filename);
+    const Gnss_Fft_Conf& fft_conf, bool dump, std::string dump_filename);
 
 /*!
  * \brief This class implements a Parallel Code Phase Search Acquisition.
@@ -82,12 +82,12 @@ private:
     friend pcps_assisted_acquisition_cc_sptr
     pcps_make_assisted_acquisition_cc(int32_t max_dwells, uint32_t sampled_ms,
         int32_t doppler_max, int32_t doppler_min, int64_t fs_in,
-        int32_t samples_per_ms, bool dump,
+        int32_t samples_per_ms, const Gnss_Fft_Conf& fft_conf, bool dump,
         std::string dump_filename);
 
     pcps_assisted_acquisition_cc(int32_t max_dwells, uint32_t sampled_ms,
         int32_t doppler_max, int32_t doppler_min, int64_t fs_in,
-        int32_t samples_per_ms, bool dump,
+        int32_t samples_per_ms, const Gnss_Fft_Conf& fft_conf, bool dump,
         std::string dump_filename);
 
     void calculate_magnitudes(gr_complex* fft_begin, int32_t doppler_shift,
@@ -124,8 +124,8 @@ private:
     float** d_grid_data;
     gr_complex** d_grid_doppler_wipeoffs;
 
-    gr::fft::fft_complex* d_fft_if;
-    gr::fft::fft_complex* d_ifft;
+    Gnss_Fft* d_fft_if;
+    Gnss_Fft* d_ifft;
     Gnss_Synchro* d_gnss_synchro;
     uint32_t d_code_phase;
     float d_doppler_freq;
@@ -53,11 +53,11 @@ pcps_cccwsr_acquisition_cc_sptr pcps_cccwsr_make_acquisition_cc(
     int64_t fs_in,
     int32_t samples_per_ms,
     int32_t samples_per_code,
-    bool dump, std::string dump_filename)
+    const Gnss_Fft_Conf& fft_conf, bool dump, std::string dump_filename)
 {
     return pcps_cccwsr_acquisition_cc_sptr(
         new pcps_cccwsr_acquisition_cc(sampled_ms, max_dwells, doppler_max, fs_in,
-            samples_per_ms, samples_per_code, dump, std::move(dump_filename)));
+            samples_per_ms, samples_per_code, fft_conf, dump, std::move(dump_filename)));
 }
 
 
@@ -68,6 +68,7 @@ pcps_cccwsr_acquisition_cc::pcps_cccwsr_acquisition_cc(
     int64_t fs_in,
     int32_t samples_per_ms,
     int32_t samples_per_code,
+    const Gnss_Fft_Conf& fft_conf,
     bool dump,
     std::string dump_filename) : gr::block("pcps_cccwsr_acquisition_cc",
                                      gr::io_signature::make(1, 1, sizeof(gr_complex) * sampled_ms * samples_per_ms),
@@ -98,10 +99,10 @@ pcps_cccwsr_acquisition_cc::pcps_cccwsr_acquisition_cc(
     d_magnitude = static_cast<float *>(volk_gnsssdr_malloc(d_fft_size * sizeof(float), volk_gnsssdr_get_alignment()));
 
     // Direct FFT
-    d_fft_if = new gr::fft::fft_complex(d_fft_size, true);
+    d_fft_if = new Gnss_Fft(d_fft_size, true, fft_conf);
 
     // Inverse FFT
-    d_ifft = new gr::fft::fft_complex(d_fft_size, false);
+    d_ifft = new Gnss_Fft(d_fft_size, false, fft_conf);
 
     // For dumping samples into a file
     d_dump = dump;
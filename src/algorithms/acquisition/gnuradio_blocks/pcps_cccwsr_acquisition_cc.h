@@ -37,9 +37,9 @@
 #ifndef GNSS_SDR_PCPS_CCCWSR_ACQUISITION_CC_H_
 #define GNSS_SDR_PCPS_CCCWSR_ACQUISITION_CC_H_
 
+#include "gnss_fft.h"
 #include "gnss_synchro.h"
 #include <gnuradio/block.h>
-#include <gnuradio/fft/fft.h>
 #include <gnuradio/gr_complex.h>
 #include <fstream>
 #include <string>
@@ -57,6 +57,7 @@ pcps_cccwsr_make_acquisition_cc(
     int64_t fs_in,
     int32_t samples_per_ms,
     int32_t samples_per_code,
+    const Gnss_Fft_Conf& fft_conf,
     bool dump,
     std::string dump_filename);
 
@@ -71,12 +72,12 @@ private:
     pcps_cccwsr_make_acquisition_cc(uint32_t sampled_ms, uint32_t max_dwells,
         uint32_t doppler_max, int64_t fs_in,
         int32_t samples_per_ms, int32_t samples_per_code,
-        bool dump, std::string dump_filename);
+        const Gnss_Fft_Conf& fft_conf, bool dump, std::string dump_filename);
 
     pcps_cccwsr_acquisition_cc(uint32_t sampled_ms, uint32_t max_dwells,
         uint32_t doppler_max, int64_t fs_in,
         int32_t samples_per_ms, int32_t samples_per_code,
-        bool dump, std::string dump_filename);
+        const Gnss_Fft_Conf& fft_conf, bool dump, std::string dump_filename);
 
     void calculate_magnitudes(gr_complex* fft_begin, int32_t doppler_shift,
         int32_t doppler_offset);
@@ -98,8 +99,8 @@ private:
     uint32_t d_num_doppler_bins;
     gr_complex* d_fft_code_data;
     gr_complex* d_fft_code_pilot;
-    gr::fft::fft_complex* d_fft_if;
-    gr::fft::fft_complex* d_ifft;
+    Gnss_Fft* d_fft_if;
+    Gnss_Fft* d_ifft;
     Gnss_Synchro* d_gnss_synchro;
     uint32_t d_code_phase;
     float d_doppler_freq;
@@ -58,6 +58,7 @@
 #include <volk/volk.h>
 #include <volk_gnsssdr/volk_gnsssdr.h>
 #include <algorithm>
+#include <cstring>
 #include <fstream>
 #include <iostream>
 #include <sstream>
@@ -66,6 +67,84 @@
 
 using google::LogMessage;
 
+/*
+ * Kernels of the batched Doppler search. Every Doppler bin is a row of
+ * d_fft_size_pow2 points of a single device buffer, so the whole grid is
+ * wiped off, transformed and reduced to its peaks without host transfers.
+ */
+static const char *opencl_acquisition_batch_kernels = R"(
+__kernel void doppler_wipeoff_batch(__global const float2 *in, __global float2 *grid,
+    const uint size, const uint stride, const float doppler_min_hz, const float doppler_step_hz, const float fs_hz)
+{
+    uint n = get_global_id(0);
+    uint bin = get_global_id(1);
+    float2 value = (float2)(0.0f, 0.0f);
+    if (n < size)
+        {
+            // The phase is wrapped in cycles before scaling, to keep the float precision
+            float cycles = (doppler_min_hz + doppler_step_hz * (float)bin) * (float)n / fs_hz;
+            float c;
+            float s = sincos(-2.0f * M_PI_F * (cycles - floor(cycles)), &c);
+            float2 x = in[n];
+            value = (float2)(x.x * c - x.y * s, x.x * s + x.y * c);
+        }
+    grid[bin * stride + n] = value;  // the rest of the row is the zero padding
+}
+
+__kernel void mult_codes_batch(__global float2 *grid, __global const float2 *codes, const uint stride)
+{
+    uint k = get_global_id(0);
+    uint bin = get_global_id(1);
+    float2 a = grid[bin * stride + k];
+    float2 b = codes[k];
+    grid[bin * stride + k] = (float2)(a.x * b.x - a.y * b.y, a.x * b.y + a.y * b.x);
+}
+
+__kernel void magnitude_max_batch(__global const float2 *grid, __global float *max_value, __global uint *max_index,
+    const uint size, const uint stride)
+{
+    // One work group per bin, of at most 256 work items
+    __local float values[256];
+    __local uint indexes[256];
+    uint bin = get_group_id(0);
+    uint lid = get_local_id(0);
+    uint lsize = get_local_size(0);
+    float best = -1.0f;
+    uint best_index = 0;
+    for (uint i = lid; i < size; i += lsize)
+        {
+            float2 x = grid[bin * stride + i];
+            float magnitude = x.x * x.x + x.y * x.y;
+            if (magnitude > best)
+                {
+                    best = magnitude;
+                    best_index = i;
+                }
+        }
+    values[lid] = best;
+    indexes[lid] = best_index;
+    barrier(CLK_LOCAL_MEM_FENCE);
+    for (uint half_size = lsize / 2; half_size > 0; half_size >>= 1)
+        {
+            if (lid < half_size)
+                {
+                    // Ties go to the lowest index, as in volk_gnsssdr_32f_index_max_32u
+                    if ((values[lid + half_size] > values[lid]) || ((values[lid + half_size] == values[lid]) && (indexes[lid + half_size] < indexes[lid])))
+                        {
+                            values[lid] = values[lid + half_size];
+                            indexes[lid] = indexes[lid + half_size];
+                        }
+                }
+            barrier(CLK_LOCAL_MEM_FENCE);
+        }
+    if (lid == 0)
+        {
+            max_value[bin] = values[0];
+            max_index[bin] = indexes[0];
+        }
+}
+)";
+
 pcps_opencl_acquisition_cc_sptr pcps_make_opencl_acquisition_cc(
     uint32_t sampled_ms, uint32_t max_dwells,
     uint32_t doppler_max, int64_t fs_in,
@@ -113,6 +192,11 @@ pcps_opencl_acquisition_cc::pcps_opencl_acquisition_cc(
     d_bit_transition_flag = bit_transition_flag;
     d_in_dwell_count = 0;
     d_cl_fft_batch_size = 1;
+    d_cl_local_size = 1;
+    d_grid_doppler_wipeoffs = nullptr;
+    d_cl_buffer_grid = nullptr;
+    d_cl_buffer_max_value = nullptr;
+    d_cl_buffer_max_index = nullptr;
 
     d_in_buffer = new gr_complex *[d_max_dwells];
     for (uint32_t i = 0; i < d_max_dwells; i++)
@@ -147,7 +231,7 @@ pcps_opencl_acquisition_cc::pcps_opencl_acquisition_cc(
 
 pcps_opencl_acquisition_cc::~pcps_opencl_acquisition_cc()
 {
-    if (d_num_doppler_bins > 0)
+    if (d_grid_doppler_wipeoffs != nullptr)
         {
             for (uint32_t i = 0; i < d_num_doppler_bins; i++)
                 {
@@ -170,14 +254,11 @@ pcps_opencl_acquisition_cc::~pcps_opencl_acquisition_cc()
         {
             delete d_cl_queue;
             delete d_cl_buffer_in;
-            delete d_cl_buffer_1;
             delete d_cl_buffer_2;
-            delete d_cl_buffer_magnitude;
             delete d_cl_buffer_fft_codes;
-            if (d_num_doppler_bins > 0)
-                {
-                    delete[] d_cl_buffer_grid_doppler_wipeoffs;
-                }
+            delete d_cl_buffer_grid;
+            delete d_cl_buffer_max_value;
+            delete d_cl_buffer_max_index;
 
             clFFT_DestroyPlan(d_cl_fft_plan);
         }
@@ -240,6 +321,7 @@ int pcps_opencl_acquisition_cc::init_opencl_environment(const std::string &kerne
     cl::Program::Sources sources;
 
     sources.push_back({kernel_code.c_str(), kernel_code.length()});
+    sources.push_back({opencl_acquisition_batch_kernels, std::strlen(opencl_acquisition_batch_kernels)});
 
     cl::Program program(context, sources);
     if (program.build(device) != CL_SUCCESS)
@@ -254,9 +336,15 @@ int pcps_opencl_acquisition_cc::init_opencl_environment(const std::string &kerne
     // create buffers on the device
     d_cl_buffer_in = new cl::Buffer(d_cl_context, CL_MEM_READ_WRITE, sizeof(gr_complex) * d_fft_size);
     d_cl_buffer_fft_codes = new cl::Buffer(d_cl_context, CL_MEM_READ_WRITE, sizeof(gr_complex) * d_fft_size_pow2);
-    d_cl_buffer_1 = new cl::Buffer(d_cl_context, CL_MEM_READ_WRITE, sizeof(gr_complex) * d_fft_size_pow2);
     d_cl_buffer_2 = new cl::Buffer(d_cl_context, CL_MEM_READ_WRITE, sizeof(gr_complex) * d_fft_size_pow2);
-    d_cl_buffer_magnitude = new cl::Buffer(d_cl_context, CL_MEM_READ_WRITE, sizeof(float) * d_fft_size);
+
+    // Power of two work group size for the peak search, see magnitude_max_batch
+    auto max_work_group_size = d_cl_device.getInfo<CL_DEVICE_MAX_WORK_GROUP_SIZE>();
+    d_cl_local_size = 256;
+    while (d_cl_local_size > max_work_group_size)
+        {
+            d_cl_local_size /= 2;
+        }
 
     //create queue to which we will push commands for the device.
     d_cl_queue = new cl::CommandQueue(d_cl_context, d_cl_device);
@@ -272,9 +360,7 @@ int pcps_opencl_acquisition_cc::init_opencl_environment(const std::string &kerne
         {
             delete d_cl_queue;
             delete d_cl_buffer_in;
-            delete d_cl_buffer_1;
             delete d_cl_buffer_2;
-            delete d_cl_buffer_magnitude;
             delete d_cl_buffer_fft_codes;
 
             std::cout << "Error creating OpenCL FFT plan." << std::endl;
@@ -307,13 +393,23 @@ void pcps_opencl_acquisition_cc::init()
             d_num_doppler_bins++;
         }
 
-    // Create the carrier Doppler wipeoff signals
-    d_grid_doppler_wipeoffs = new gr_complex *[d_num_doppler_bins];
     if (d_opencl == 0)
         {
-            d_cl_buffer_grid_doppler_wipeoffs = new cl::Buffer *[d_num_doppler_bins];
+            // The Doppler wipe-off is generated on the device. The grid buffer holds all the
+            // bins, and stays on the device between dwells
+            delete d_cl_buffer_grid;
+            delete d_cl_buffer_max_value;
+            delete d_cl_buffer_max_index;
+            d_cl_buffer_grid = new cl::Buffer(d_cl_context, CL_MEM_READ_WRITE, sizeof(gr_complex) * d_fft_size_pow2 * d_num_doppler_bins);
+            d_cl_buffer_max_value = new cl::Buffer(d_cl_context, CL_MEM_READ_WRITE, sizeof(float) * d_num_doppler_bins);
+            d_cl_buffer_max_index = new cl::Buffer(d_cl_context, CL_MEM_READ_WRITE, sizeof(cl_uint) * d_num_doppler_bins);
+            d_max_value.resize(d_num_doppler_bins);
+            d_max_index.resize(d_num_doppler_bins);
+            return;
         }
 
+    // Create the carrier Doppler wipeoff signals
+    d_grid_doppler_wipeoffs = new gr_complex *[d_num_doppler_bins];
     for (uint32_t doppler_index = 0; doppler_index < d_num_doppler_bins; doppler_index++)
         {
             d_grid_doppler_wipeoffs[doppler_index] = static_cast<gr_complex *>(volk_gnsssdr_malloc(d_fft_size * sizeof(gr_complex), volk_gnsssdr_get_alignment()));
@@ -323,23 +419,6 @@ void pcps_opencl_acquisition_cc::init()
             float _phase[1];
             _phase[0] = 0;
             volk_gnsssdr_s32f_sincos_32fc(d_grid_doppler_wipeoffs[doppler_index], -phase_step_rad, _phase, d_fft_size);
-
-            if (d_opencl == 0)
-                {
-                    d_cl_buffer_grid_doppler_wipeoffs[doppler_index] =
-                        new cl::Buffer(d_cl_context, CL_MEM_READ_WRITE, sizeof(gr_complex) * d_fft_size);
-
-                    d_cl_queue->enqueueWriteBuffer(*(d_cl_buffer_grid_doppler_wipeoffs[doppler_index]),
-                        CL_TRUE, 0, sizeof(gr_complex) * d_fft_size,
-                        d_grid_doppler_wipeoffs[doppler_index]);
-                }
-        }
-
-    // zero padding in buffer_1 (FFT input)
-    if (d_opencl == 0)
-        {
-            d_cl_queue->enqueueWriteBuffer(*d_cl_buffer_1, CL_TRUE, sizeof(gr_complex) * d_fft_size,
-                sizeof(gr_complex) * (d_fft_size_pow2 - d_fft_size), d_zero_vector);
         }
 }
 
@@ -517,8 +596,8 @@ void pcps_opencl_acquisition_cc::acquisition_core_opencl()
     d_input_power = 0.0;
     d_mag = 0.0;
 
-    // write input vector in buffer of OpenCL device
-    d_cl_queue->enqueueWriteBuffer(*d_cl_buffer_in, CL_TRUE, 0, sizeof(gr_complex) * d_fft_size, in);
+    // write input vector in buffer of OpenCL device. The host buffer is not modified until the peaks are read back
+    d_cl_queue->enqueueWriteBuffer(*d_cl_buffer_in, CL_FALSE, 0, sizeof(gr_complex) * d_fft_size, in);
 
     d_well_count++;
 
@@ -540,63 +619,60 @@ void pcps_opencl_acquisition_cc::acquisition_core_opencl()
     volk_32f_accumulator_s32f(&d_input_power, d_magnitude, d_fft_size);
     d_input_power /= static_cast<float>(d_fft_size);
 
-    cl::Kernel kernel;
+    cl_uint size = d_fft_size;
+    cl_uint stride = d_fft_size_pow2;
+
+    // 2- Doppler wipe-off of all the bins, from the input uploaded once per dwell
+    cl::Kernel kernel = cl::Kernel(d_cl_program, "doppler_wipeoff_batch");
+    kernel.setArg(0, *d_cl_buffer_in);
+    kernel.setArg(1, *d_cl_buffer_grid);
+    kernel.setArg(2, size);
+    kernel.setArg(3, stride);
+    kernel.setArg(4, -static_cast<float>(d_doppler_max));
+    kernel.setArg(5, static_cast<float>(d_doppler_step));
+    kernel.setArg(6, static_cast<float>(d_fs_in));
+    d_cl_queue->enqueueNDRangeKernel(kernel, cl::NullRange, cl::NDRange(d_fft_size_pow2, d_num_doppler_bins), cl::NullRange);
+
+    // 3- Perform the FFT-based convolution  (parallel time search) of all the bins as one batch
+    clFFT_ExecuteInterleaved((*d_cl_queue)(), d_cl_fft_plan, static_cast<cl_int>(d_num_doppler_bins),
+        clFFT_Forward, (*d_cl_buffer_grid)(), (*d_cl_buffer_grid)(),
+        0, nullptr, nullptr);
+
+    // Multiply carrier wiped--off, Fourier transformed incoming signal
+    // with the local FFT'd code reference
+    kernel = cl::Kernel(d_cl_program, "mult_codes_batch");
+    kernel.setArg(0, *d_cl_buffer_grid);
+    kernel.setArg(1, *d_cl_buffer_fft_codes);
+    kernel.setArg(2, stride);
+    d_cl_queue->enqueueNDRangeKernel(kernel, cl::NullRange, cl::NDRange(d_fft_size_pow2, d_num_doppler_bins), cl::NullRange);
+
+    // compute the inverse FFT
+    clFFT_ExecuteInterleaved((*d_cl_queue)(), d_cl_fft_plan, static_cast<cl_int>(d_num_doppler_bins),
+        clFFT_Inverse, (*d_cl_buffer_grid)(), (*d_cl_buffer_grid)(),
+        0, nullptr, nullptr);
+
+    // Search the maximum of each bin on the device
+    kernel = cl::Kernel(d_cl_program, "magnitude_max_batch");
+    kernel.setArg(0, *d_cl_buffer_grid);
+    kernel.setArg(1, *d_cl_buffer_max_value);
+    kernel.setArg(2, *d_cl_buffer_max_index);
+    kernel.setArg(3, size);
+    kernel.setArg(4, stride);
+    d_cl_queue->enqueueNDRangeKernel(kernel, cl::NullRange, cl::NDRange(d_cl_local_size * d_num_doppler_bins), cl::NDRange(d_cl_local_size));
+
+    // Only the peaks are read back. The last read blocks this thread until all
+    // previously enqueued OpenCL commands are completed.
+    d_cl_queue->enqueueReadBuffer(*d_cl_buffer_max_value, CL_FALSE, 0, sizeof(float) * d_num_doppler_bins, d_max_value.data());
+    d_cl_queue->enqueueReadBuffer(*d_cl_buffer_max_index, CL_TRUE, 0, sizeof(cl_uint) * d_num_doppler_bins, d_max_index.data());
 
-    // 2- Doppler frequency search loop
     for (uint32_t doppler_index = 0; doppler_index < d_num_doppler_bins; doppler_index++)
         {
             // doppler search steps
-
             doppler = -static_cast<int>(d_doppler_max) + d_doppler_step * doppler_index;
-
-            //Multiply input signal with doppler wipe-off
-            kernel = cl::Kernel(d_cl_program, "mult_vectors");
-            kernel.setArg(0, *d_cl_buffer_in);                                    //input 1
-            kernel.setArg(1, *d_cl_buffer_grid_doppler_wipeoffs[doppler_index]);  //input 2
-            kernel.setArg(2, *d_cl_buffer_1);                                     //output
-            d_cl_queue->enqueueNDRangeKernel(kernel, cl::NullRange, cl::NDRange(d_fft_size),
-                cl::NullRange);
-
-            // In the previous operation, we store the result in the first d_fft_size positions
-            // of d_cl_buffer_1. The rest d_fft_size_pow2-d_fft_size already have zeros
-            // (zero-padding is made in init() for optimization purposes).
-
-            clFFT_ExecuteInterleaved((*d_cl_queue)(), d_cl_fft_plan, d_cl_fft_batch_size,
-                clFFT_Forward, (*d_cl_buffer_1)(), (*d_cl_buffer_2)(),
-                0, nullptr, nullptr);
-
-            // Multiply carrier wiped--off, Fourier transformed incoming signal
-            // with the local FFT'd code reference
-            kernel = cl::Kernel(d_cl_program, "mult_vectors");
-            kernel.setArg(0, *d_cl_buffer_2);          //input 1
-            kernel.setArg(1, *d_cl_buffer_fft_codes);  //input 2
-            kernel.setArg(2, *d_cl_buffer_2);          //output
-            d_cl_queue->enqueueNDRangeKernel(kernel, cl::NullRange, cl::NDRange(d_fft_size_pow2),
-                cl::NullRange);
-
-            // compute the inverse FFT
-            clFFT_ExecuteInterleaved((*d_cl_queue)(), d_cl_fft_plan, d_cl_fft_batch_size,
-                clFFT_Inverse, (*d_cl_buffer_2)(), (*d_cl_buffer_2)(),
-                0, nullptr, nullptr);
-
-            // Compute magnitude
-            kernel = cl::Kernel(d_cl_program, "magnitude_squared");
-            kernel.setArg(0, *d_cl_buffer_2);          //input 1
-            kernel.setArg(1, *d_cl_buffer_magnitude);  //output
-            d_cl_queue->enqueueNDRangeKernel(kernel, cl::NullRange, cl::NDRange(d_fft_size),
-                cl::NullRange);
-
-            // This is the only function that blocks this thread until all previously enqueued
-            // OpenCL commands are completed.
-            d_cl_queue->enqueueReadBuffer(*d_cl_buffer_magnitude, CL_TRUE, 0,
-                sizeof(float) * d_fft_size, d_magnitude);
-
-            // Search maximum
-            // @TODO: find an efficient way to search the maximum with OpenCL in the GPU.
-            volk_gnsssdr_32f_index_max_32u(&indext, d_magnitude, d_fft_size);
+            indext = d_max_index[doppler_index];
 
             // Normalize the maximum value to correct the scale factor introduced by FFTW
-            magt = d_magnitude[indext] / (fft_normalization_factor * fft_normalization_factor);
+            magt = d_max_value[doppler_index] / (fft_normalization_factor * fft_normalization_factor);
 
             // 4- record the maximum peak and the associated synchronization parameters
             if (d_mag < magt)
@@ -626,6 +702,9 @@ void pcps_opencl_acquisition_cc::acquisition_core_opencl()
             // Record results to file if required
             if (d_dump)
                 {
+                    std::vector<gr_complex> correlation(d_fft_size);
+                    d_cl_queue->enqueueReadBuffer(*d_cl_buffer_grid, CL_TRUE, sizeof(gr_complex) * d_fft_size_pow2 * doppler_index,
+                        sizeof(gr_complex) * d_fft_size, correlation.data());
                     std::stringstream filename;
                     std::streamsize n = 2 * sizeof(float) * (d_fft_size);  // complex file write
                     filename.str("");
@@ -633,7 +712,7 @@ void pcps_opencl_acquisition_cc::acquisition_core_opencl()
                              << "_" << d_gnss_synchro->Signal << "_sat_"
                              << d_gnss_synchro->PRN << "_doppler_" << doppler << ".dat";
                     d_dump_file.open(filename.str().c_str(), std::ios::out | std::ios::binary);
-                    d_dump_file.write(reinterpret_cast<char *>(d_ifft->get_outbuf()), n);  //write directly |abs(x)|^2 in this Doppler bin?
+                    d_dump_file.write(reinterpret_cast<char *>(correlation.data()), n);
                     d_dump_file.close();
                 }
         }
@@ -154,13 +154,16 @@ private:
     cl::Program d_cl_program;
     cl::Buffer* d_cl_buffer_in;
     cl::Buffer* d_cl_buffer_fft_codes;
-    cl::Buffer* d_cl_buffer_1;
     cl::Buffer* d_cl_buffer_2;
-    cl::Buffer* d_cl_buffer_magnitude;
-    cl::Buffer** d_cl_buffer_grid_doppler_wipeoffs;
+    cl::Buffer* d_cl_buffer_grid;       // Doppler wiped-off input of every bin, then its correlation with the code
+    cl::Buffer* d_cl_buffer_max_value;  // peak of the correlation of each bin
+    cl::Buffer* d_cl_buffer_max_index;  // position of that peak
     cl::CommandQueue* d_cl_queue;
     clFFT_Plan d_cl_fft_plan;
     cl_int d_cl_fft_batch_size;
+    size_t d_cl_local_size;  // work items reducing each bin to its peak
+    std::vector<float> d_max_value;
+    std::vector<cl_uint> d_max_index;
 
     int d_opencl;
 
@@ -51,6 +51,7 @@ pcps_quicksync_acquisition_cc_sptr pcps_quicksync_make_acquisition_cc(
     int32_t samples_per_ms,
     int32_t samples_per_code,
     bool bit_transition_flag,
+    const Gnss_Fft_Conf& fft_conf,
     bool dump,
     std::string dump_filename)
 {
@@ -61,7 +62,7 @@ pcps_quicksync_acquisition_cc_sptr pcps_quicksync_make_acquisition_cc(
             fs_in, samples_per_ms,
             samples_per_code,
             bit_transition_flag,
-            dump, std::move(dump_filename)));
+            fft_conf, dump, std::move(dump_filename)));
 }
 
 
@@ -71,6 +72,7 @@ pcps_quicksync_acquisition_cc::pcps_quicksync_acquisition_cc(
     uint32_t doppler_max, int64_t fs_in,
     int32_t samples_per_ms, int32_t samples_per_code,
     bool bit_transition_flag,
+    const Gnss_Fft_Conf& fft_conf,
     bool dump,
     std::string dump_filename) : gr::block("pcps_quicksync_acquisition_cc",
                                      gr::io_signature::make(1, 1, (sizeof(gr_complex) * sampled_ms * samples_per_ms)),
@@ -108,9 +110,9 @@ pcps_quicksync_acquisition_cc::pcps_quicksync_acquisition_cc(
     d_code = new gr_complex[d_samples_per_code]();
 
     // Direct FFT
-    d_fft_if = new gr::fft::fft_complex(d_fft_size, true);
+    d_fft_if = new Gnss_Fft(d_fft_size, true, fft_conf);
     // Inverse FFT
-    d_ifft = new gr::fft::fft_complex(d_fft_size, false);
+    d_ifft = new Gnss_Fft(d_fft_size, false, fft_conf);
 
     // For dumping samples into a file
     d_dump = dump;
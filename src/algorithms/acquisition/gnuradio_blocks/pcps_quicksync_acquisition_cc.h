@@ -51,9 +51,9 @@
 #ifndef GNSS_SDR_PCPS_QUICKSYNC_ACQUISITION_CC_H_
 #define GNSS_SDR_PCPS_QUICKSYNC_ACQUISITION_CC_H_
 
+#include "gnss_fft.h"
 #include "gnss_synchro.h"
 #include <gnuradio/block.h>
-#include <gnuradio/fft/fft.h>
 #include <gnuradio/gr_complex.h>
 #include <algorithm>
 #include <cassert>
@@ -76,6 +76,7 @@ pcps_quicksync_make_acquisition_cc(
     int32_t samples_per_ms,
     int32_t samples_per_code,
     bool bit_transition_flag,
+    const Gnss_Fft_Conf& fft_conf,
     bool dump,
     std::string dump_filename);
 
@@ -95,6 +96,7 @@ private:
         uint32_t doppler_max, int64_t fs_in,
         int32_t samples_per_ms, int32_t samples_per_code,
         bool bit_transition_flag,
+        const Gnss_Fft_Conf& fft_conf,
         bool dump,
         std::string dump_filename);
 
@@ -103,6 +105,7 @@ private:
         uint32_t doppler_max, int64_t fs_in,
         int32_t samples_per_ms, int32_t samples_per_code,
         bool bit_transition_flag,
+        const Gnss_Fft_Conf& fft_conf,
         bool dump,
         std::string dump_filename);
 
@@ -135,9 +138,9 @@ private:
     gr_complex** d_grid_doppler_wipeoffs;
     uint32_t d_num_doppler_bins;
     gr_complex* d_fft_codes;
-    gr::fft::fft_complex* d_fft_if;
-    gr::fft::fft_complex* d_fft_if2;
-    gr::fft::fft_complex* d_ifft;
+    Gnss_Fft* d_fft_if;
+    Gnss_Fft* d_fft_if2;
+    Gnss_Fft* d_ifft;
     Gnss_Synchro* d_gnss_synchro;
     uint32_t d_code_phase;
     float d_doppler_freq;
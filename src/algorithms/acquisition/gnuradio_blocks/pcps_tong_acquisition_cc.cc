@@ -69,11 +69,11 @@ pcps_tong_acquisition_cc_sptr pcps_tong_make_acquisition_cc(
     uint32_t tong_init_val,
     uint32_t tong_max_val,
     uint32_t tong_max_dwells,
-    bool dump, std::string dump_filename)
+    const Gnss_Fft_Conf& fft_conf, bool dump, std::string dump_filename)
 {
     return pcps_tong_acquisition_cc_sptr(
         new pcps_tong_acquisition_cc(sampled_ms, doppler_max, fs_in, samples_per_ms, samples_per_code,
-            tong_init_val, tong_max_val, tong_max_dwells, dump, std::move(dump_filename)));
+            tong_init_val, tong_max_val, tong_max_dwells, fft_conf, dump, std::move(dump_filename)));
 }
 
 pcps_tong_acquisition_cc::pcps_tong_acquisition_cc(
@@ -85,6 +85,7 @@ pcps_tong_acquisition_cc::pcps_tong_acquisition_cc(
     uint32_t tong_init_val,
     uint32_t tong_max_val,
     uint32_t tong_max_dwells,
+    const Gnss_Fft_Conf& fft_conf,
     bool dump,
     std::string dump_filename) : gr::block("pcps_tong_acquisition_cc",
                                      gr::io_signature::make(1, 1, sizeof(gr_complex) * sampled_ms * samples_per_ms),
@@ -113,10 +114,10 @@ pcps_tong_acquisition_cc::pcps_tong_acquisition_cc(
     d_magnitude = static_cast<float *>(volk_gnsssdr_malloc(d_fft_size * sizeof(float), volk_gnsssdr_get_alignment()));
 
     // Direct FFT
-    d_fft_if = new gr::fft::fft_complex(d_fft_size, true);
+    d_fft_if = new Gnss_Fft(d_fft_size, true, fft_conf);
 
     // Inverse FFT
-    d_ifft = new gr::fft::fft_complex(d_fft_size, false);
+    d_ifft = new Gnss_Fft(d_fft_size, false, fft_conf);
 
     // For dumping samples into a file
     d_dump = dump;
@@ -51,9 +51,9 @@
 #ifndef GNSS_SDR_PCPS_TONG_ACQUISITION_CC_H_
 #define GNSS_SDR_PCPS_TONG_ACQUISITION_CC_H_
 
+#include "gnss_fft.h"
 #include "gnss_synchro.h"
 #include <gnuradio/block.h>
-#include <gnuradio/fft/fft.h>
 #include <gnuradio/gr_complex.h>
 #include <fstream>
 #include <string>
@@ -73,6 +73,7 @@ pcps_tong_make_acquisition_cc(
     uint32_t tong_init_val,
     uint32_t tong_max_val,
     uint32_t tong_max_dwells,
+    const Gnss_Fft_Conf& fft_conf,
     bool dump,
     std::string dump_filename);
 
@@ -88,13 +89,13 @@ private:
         int64_t fs_in, int32_t samples_per_ms,
         int32_t samples_per_code, uint32_t tong_init_val,
         uint32_t tong_max_val, uint32_t tong_max_dwells,
-        bool dump, std::string dump_filename);
+        const Gnss_Fft_Conf& fft_conf, bool dump, std::string dump_filename);
 
     pcps_tong_acquisition_cc(uint32_t sampled_ms, uint32_t doppler_max,
         int64_t fs_in, int32_t samples_per_ms,
         int32_t samples_per_code, uint32_t tong_init_val,
         uint32_t tong_max_val, uint32_t tong_max_dwells,
-        bool dump, std::string dump_filename);
+        const Gnss_Fft_Conf& fft_conf, bool dump, std::string dump_filename);
 
     void calculate_magnitudes(gr_complex* fft_begin, int32_t doppler_shift,
         int32_t doppler_offset);
@@ -119,8 +120,8 @@ private:
     uint32_t d_num_doppler_bins;
     gr_complex* d_fft_codes;
     float** d_grid_data;
-    gr::fft::fft_complex* d_fft_if;
-    gr::fft::fft_complex* d_ifft;
+    Gnss_Fft* d_fft_if;
+    Gnss_Fft* d_ifft;
     Gnss_Synchro* d_gnss_synchro;
     uint32_t d_code_phase;
     float d_doppler_freq;
@@ -0,0 +1,79 @@
+/*!
+ * \file acq_code_cache.h
+ * \brief Process-wide, read-only cache of the FFT'd local codes used by
+ * the PCPS acquisition blocks.
+ *
+ * Each entry holds the conjugated FFT of a zero-padded local code replica.
+ * It is filled lazily, the first time a channel looks for a given
+ * satellite, and it is never modified afterwards, so reassigning a
+ * satellite to a channel just swaps a pointer.
+ *
+ * -------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2018  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *          Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_ACQ_CODE_CACHE_H_
+#define GNSS_SDR_ACQ_CODE_CACHE_H_
+
+#include <gnuradio/gr_complex.h>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+
+
+/*!
+ * \brief Thread-safe store of frequency-domain local code replicas.
+ *
+ * Keys are built by the acquisition blocks from the signal, PRN, sampling
+ * rate and FFT length, so entries can be shared by all the channels of
+ * a receiver.
+ */
+class Acq_Code_Cache
+{
+public:
+    /*!
+     * \brief Returns the process-wide instance of the cache.
+     */
+    static std::shared_ptr<Acq_Code_Cache> get_instance();
+
+    /*!
+     * \brief Returns the cached spectrum for \p key, or nullptr if it is not available.
+     */
+    std::shared_ptr<const gr_complex> find(const std::string& key);
+
+    /*!
+     * \brief Stores \p fft_codes under \p key. If another channel already
+     * stored an entry with the same key, that entry is kept and returned.
+     */
+    std::shared_ptr<const gr_complex> insert(const std::string& key, const std::shared_ptr<const gr_complex>& fft_codes);
+
+    size_t size();
+
+private:
+    std::map<std::string, std::shared_ptr<const gr_complex> > d_codes;
+    std::mutex d_mutex;
+};
+
+#endif
@@ -49,8 +49,23 @@ Acq_Conf::Acq_Conf()
     dump = false;
     blocking = false;
     make_2_steps = false;
+    fine_doppler_interpolation = false;
+    use_shared_fft = false;
+    on_the_fly_wipeoff = false;
+    doppler_fft_shift = false;
+    doppler_threads = 1U;
+    reduced_grid = false;
+    folding_factor = 1U;
+    release_buffers = true;
+    doppler_aiding = true;
+    overlap_save = false;
+    use_cuda = false;
+    cuda_batch_window_us = 200U;
     dump_filename = "";
     dump_channel = 0U;
+    dump_queue_size = 16U;
+    dump_compression = true;
+    dump_quantized_grid = false;
     it_size = sizeof(char);
     blocking_on_standby = false;
     use_automatic_resampler = false;
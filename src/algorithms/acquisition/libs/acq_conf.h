@@ -32,6 +32,7 @@
 #ifndef GNSS_SDR_ACQ_CONF_H_
 #define GNSS_SDR_ACQ_CONF_H_
 
+#include "gnss_fft.h"
 #include <cstddef>
 #include <cstdint>
 #include <string>
@@ -56,12 +57,28 @@ public:
     bool blocking;
     bool blocking_on_standby;  // enable it only for unit testing to avoid sample consume on idle status
     bool make_2_steps;
+    bool fine_doppler_interpolation;  // with make_2_steps, interpolate the step one grid instead of searching again
+    bool use_shared_fft;  // share the Doppler wiped-off input spectra among the channels of the same signal
+    bool on_the_fly_wipeoff;  // generate the Doppler wipe-off with a rotator instead of storing the tables
+    bool doppler_fft_shift;   // get the Doppler bins by circular shifts of a single input spectrum
+    uint32_t doppler_threads;  // number of threads sharing the Doppler grid search
+    Gnss_Fft_Conf fft_conf;    // FFT backend, threads per FFT and planning effort
+    bool reduced_grid;         // keep only the peaks of each Doppler bin instead of the whole search grid
+    uint32_t folding_factor;   // fold the first step search into blocks this many times shorter (QuickSync), 1 disables it
+    bool release_buffers;      // free the search buffers while the channel is tracking
+    bool doppler_aiding;       // search only around the Doppler predicted by the flowgraph, if any
+    bool overlap_save;         // with bit_transition_flag, reuse the last half block in the next dwell
+    bool use_cuda;                  // run the grid search on the CUDA GPU, batched with the rest of channels
+    uint32_t cuda_batch_window_us;  // time the GPU waits for the requests of other channels before running a batch
     bool use_automatic_resampler;
     float resampler_ratio;
     int64_t resampled_fs;
     uint32_t resampler_latency_samples;
     std::string dump_filename;
     uint32_t dump_channel;
+    uint32_t dump_queue_size;   // maximum number of dumps waiting for the writer thread
+    bool dump_compression;      // compress the dump files, trading disk I/O for CPU
+    bool dump_quantized_grid;   // store the grids as uint16 plus a scale factor
     size_t it_size;
 
     Acq_Conf();
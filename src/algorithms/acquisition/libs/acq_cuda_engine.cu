@@ -0,0 +1,544 @@
+/*!
+ * \file acq_cuda_engine.cu
+ * \brief Class that runs the PCPS acquisition grid searches of many channels
+ * on a NVIDIA CUDA GPU, batching the FFTs of all the pending requests.
+ *
+ * -------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2018  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *          Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------
+ */
+
+#include "acq_cuda_engine.h"
+#include <cuComplex.h>
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+
+#define ACQ_CUDA_THREADS_PER_BLOCK 256
+
+
+// Wipes off the Doppler of spectra row blockIdx.y from its input block
+__global__ void acq_doppler_wipeoff_kernel(cufftComplex* spectra, const cufftComplex* input, const uint32_t* input_row, const float* doppler_hz, uint32_t n, double fs_hz)
+{
+    uint32_t bin = blockIdx.y;
+    const cufftComplex* in = input + static_cast<size_t>(input_row[bin]) * n;
+    cufftComplex* out = spectra + static_cast<size_t>(bin) * n;
+    for (uint32_t k = blockIdx.x * blockDim.x + threadIdx.x; k < n; k += blockDim.x * gridDim.x)
+        {
+            // Keep only the fractional part of the phase (in cycles) before going to single precision
+            double cycles = static_cast<double>(doppler_hz[bin]) * static_cast<double>(k) / fs_hz;
+            cycles -= floor(cycles);
+            float s, c;
+            sincospif(-2.0f * static_cast<float>(cycles), &s, &c);
+            out[k] = cuCmulf(in[k], make_cuFloatComplex(c, s));
+        }
+}
+
+
+// Multiplies the spectrum of row spectra_row[blockIdx.y] by the local code of its channel
+__global__ void acq_code_multiply_kernel(cufftComplex* products, const cufftComplex* spectra, const uint32_t* spectra_row, cufftComplex* const* codes, uint32_t n)
+{
+    uint32_t row = blockIdx.y;
+    const cufftComplex* spectrum = spectra + static_cast<size_t>(spectra_row[row]) * n;
+    const cufftComplex* code = codes[row];
+    cufftComplex* out = products + static_cast<size_t>(row) * n;
+    for (uint32_t k = blockIdx.x * blockDim.x + threadIdx.x; k < n; k += blockDim.x * gridDim.x)
+        {
+            out[k] = cuCmulf(spectrum[k], code[k]);
+        }
+}
+
+
+// Squared magnitude (accumulated in the channel grid) and maximum of one row per block
+__global__ void acq_magnitude_max_kernel(float* const* grid_rows, const cufftComplex* products, uint32_t n, uint32_t offset, uint32_t length, const uint8_t* accumulate, float* row_max, uint32_t* row_max_index)
+{
+    __shared__ float best_value[ACQ_CUDA_THREADS_PER_BLOCK];
+    __shared__ uint32_t best_index[ACQ_CUDA_THREADS_PER_BLOCK];
+    uint32_t row = blockIdx.x;
+    const cufftComplex* in = products + static_cast<size_t>(row) * n + offset;
+    float* grid = grid_rows[row];
+    float value = -1.0f;
+    uint32_t index = 0;
+    for (uint32_t k = threadIdx.x; k < length; k += blockDim.x)
+        {
+            float mag = in[k].x * in[k].x + in[k].y * in[k].y;
+            if (accumulate[row])
+                {
+                    mag += grid[k];
+                }
+            grid[k] = mag;
+            if (mag > value)
+                {
+                    value = mag;
+                    index = k;
+                }
+        }
+    best_value[threadIdx.x] = value;
+    best_index[threadIdx.x] = index;
+    __syncthreads();
+    for (uint32_t stride = blockDim.x / 2; stride > 0; stride >>= 1)
+        {
+            if (threadIdx.x < stride)
+                {
+                    // on ties, keep the first position, as the CPU implementation does
+                    float other = best_value[threadIdx.x + stride];
+                    if ((other > best_value[threadIdx.x]) or ((other == best_value[threadIdx.x]) and (best_index[threadIdx.x + stride] < best_index[threadIdx.x])))
+                        {
+                            best_value[threadIdx.x] = other;
+                            best_index[threadIdx.x] = best_index[threadIdx.x + stride];
+                        }
+                }
+            __syncthreads();
+        }
+    if (threadIdx.x == 0)
+        {
+            row_max[row] = best_value[0];
+            row_max_index[row] = best_index[0];
+        }
+}
+
+
+static bool cuda_check(cudaError_t error, const char* what)
+{
+    if (error != cudaSuccess)
+        {
+            std::cerr << "CUDA acquisition: " << what << " failed: " << cudaGetErrorString(error) << std::endl;
+            return false;
+        }
+    return true;
+}
+
+
+std::shared_ptr<Acq_Cuda_Engine> Acq_Cuda_Engine::get_instance(uint32_t fft_size, int64_t fs_hz, uint32_t batch_window_us)
+{
+    static std::mutex registry_mutex;
+    static std::map<std::string, std::weak_ptr<Acq_Cuda_Engine> > registry;
+
+    std::string key = std::to_string(fs_hz) + "_" + std::to_string(fft_size);
+    std::lock_guard<std::mutex> lock(registry_mutex);
+    std::shared_ptr<Acq_Cuda_Engine> engine = registry[key].lock();
+    if (!engine)
+        {
+            engine = std::make_shared<Acq_Cuda_Engine>(fft_size, fs_hz, batch_window_us);
+            registry[key] = engine;
+        }
+    return engine;
+}
+
+
+Acq_Cuda_Engine::Acq_Cuda_Engine(uint32_t fft_size, int64_t fs_hz, uint32_t batch_window_us)
+{
+    d_fft_size = fft_size;
+    d_fs_hz = fs_hz;
+    d_batch_window_us = batch_window_us;
+    d_stop = false;
+    d_input = nullptr;
+    d_spectra = nullptr;
+    d_products = nullptr;
+    d_doppler_hz = nullptr;
+    d_input_row = nullptr;
+    d_spectra_row = nullptr;
+    d_code_row = nullptr;
+    d_grid_row = nullptr;
+    d_accumulate_row = nullptr;
+    d_row_max = nullptr;
+    d_row_max_index = nullptr;
+    d_input_rows = 0;
+    d_spectra_rows = 0;
+    d_product_rows = 0;
+    d_stream = nullptr;
+
+    int num_devices = 0;
+    d_ready = (cudaGetDeviceCount(&num_devices) == cudaSuccess) and (num_devices > 0);
+    if (d_ready)
+        {
+            d_ready = cuda_check(cudaStreamCreate(&d_stream), "stream creation");
+        }
+    if (!d_ready)
+        {
+            std::cerr << "CUDA acquisition: no CUDA device available, acquisition will run on the CPU" << std::endl;
+            return;
+        }
+    d_thread = std::thread(&Acq_Cuda_Engine::dispatcher, this);
+}
+
+
+Acq_Cuda_Engine::~Acq_Cuda_Engine()
+{
+    if (d_thread.joinable())
+        {
+            {
+                std::lock_guard<std::mutex> lock(d_mutex);
+                d_stop = true;
+            }
+            d_request_cond.notify_all();
+            d_thread.join();
+        }
+    for (auto& slot : d_slots)
+        {
+            cudaFree(slot.code);
+            cudaFree(slot.grid);
+        }
+    for (auto& plan : d_plans)
+        {
+            cufftDestroy(plan.second);
+        }
+    cudaFree(d_input);
+    cudaFree(d_spectra);
+    cudaFree(d_products);
+    cudaFree(d_doppler_hz);
+    cudaFree(d_input_row);
+    cudaFree(d_spectra_row);
+    cudaFree(d_code_row);
+    cudaFree(d_grid_row);
+    cudaFree(d_accumulate_row);
+    cudaFree(d_row_max);
+    cudaFree(d_row_max_index);
+    if (d_stream != nullptr)
+        {
+            cudaStreamDestroy(d_stream);
+        }
+}
+
+
+int32_t Acq_Cuda_Engine::add_channel(uint32_t max_doppler_bins)
+{
+    if (!d_ready or (max_doppler_bins == 0))
+        {
+            return -1;
+        }
+    Channel_Slot slot;
+    slot.max_doppler_bins = max_doppler_bins;
+    slot.code = nullptr;
+    slot.grid = nullptr;
+    if (!cuda_check(cudaMalloc(&slot.code, d_fft_size * sizeof(cufftComplex)), "code allocation") or
+        !cuda_check(cudaMalloc(&slot.grid, static_cast<size_t>(max_doppler_bins) * d_fft_size * sizeof(float)), "grid allocation"))
+        {
+            cudaFree(slot.code);
+            return -1;
+        }
+    cudaMemset(slot.grid, 0, static_cast<size_t>(max_doppler_bins) * d_fft_size * sizeof(float));
+
+    std::lock_guard<std::mutex> lock(d_mutex);
+    for (uint32_t i = 0; i < d_slots.size(); i++)
+        {
+            if (d_slots[i].code == nullptr)
+                {
+                    d_slots[i] = slot;
+                    return static_cast<int32_t>(i);
+                }
+        }
+    d_slots.push_back(slot);
+    return static_cast<int32_t>(d_slots.size() - 1);
+}
+
+
+void Acq_Cuda_Engine::remove_channel(int32_t slot)
+{
+    std::lock_guard<std::mutex> lock(d_mutex);
+    if ((slot < 0) or (slot >= static_cast<int32_t>(d_slots.size())))
+        {
+            return;
+        }
+    cudaFree(d_slots[slot].code);
+    cudaFree(d_slots[slot].grid);
+    d_slots[slot].code = nullptr;
+    d_slots[slot].grid = nullptr;
+}
+
+
+bool Acq_Cuda_Engine::set_local_code(int32_t slot, const std::complex<float>* fft_code)
+{
+    cufftComplex* code = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(d_mutex);
+        if ((slot < 0) or (slot >= static_cast<int32_t>(d_slots.size())))
+            {
+                return false;
+            }
+        code = d_slots[slot].code;
+    }
+    return cuda_check(cudaMemcpy(code, fft_code, d_fft_size * sizeof(cufftComplex), cudaMemcpyHostToDevice), "code upload");
+}
+
+
+bool Acq_Cuda_Engine::search(int32_t slot, const std::string& input_key, uint64_t sample_stamp, const std::complex<float>* in,
+    const std::vector<float>& doppler_hz, bool accumulate, uint32_t offset, uint32_t length,
+    float* bin_max, uint32_t* bin_max_index, float* best_row)
+{
+    Request request;
+    request.slot = slot;
+    request.input_key = input_key;
+    request.sample_stamp = sample_stamp;
+    request.in = in;
+    request.doppler_hz = &doppler_hz;
+    request.accumulate = accumulate;
+    request.offset = offset;
+    request.length = std::min(length, d_fft_size - std::min(offset, d_fft_size));
+    request.bin_max = bin_max;
+    request.bin_max_index = bin_max_index;
+    request.best_row = best_row;
+    request.done = false;
+    request.result = false;
+
+    std::unique_lock<std::mutex> lock(d_mutex);
+    if (!d_ready or (slot < 0) or (slot >= static_cast<int32_t>(d_slots.size())) or doppler_hz.empty() or
+        (doppler_hz.size() > d_slots[slot].max_doppler_bins) or (request.length == 0))
+        {
+            return false;
+        }
+    request.code = d_slots[slot].code;
+    request.grid = d_slots[slot].grid;
+    d_pending.push_back(&request);
+    d_request_cond.notify_all();
+    d_done_cond.wait(lock, [&request] { return request.done; });
+    return request.result;
+}
+
+
+void Acq_Cuda_Engine::dispatcher()
+{
+    std::unique_lock<std::mutex> lock(d_mutex);
+    while (!d_stop)
+        {
+            if (d_pending.empty())
+                {
+                    d_request_cond.wait(lock);
+                    continue;
+                }
+            // Give the rest of the channels the chance to join the batch
+            auto deadline = std::chrono::steady_clock::now() + std::chrono::microseconds(d_batch_window_us);
+            size_t active_channels = std::count_if(d_slots.begin(), d_slots.end(), [](const Channel_Slot& s) { return s.code != nullptr; });
+            while (!d_stop and (d_pending.size() < active_channels))
+                {
+                    if (d_request_cond.wait_until(lock, deadline) == std::cv_status::timeout)
+                        {
+                            break;
+                        }
+                }
+            std::vector<Request*> batch;
+            batch.swap(d_pending);
+            lock.unlock();
+            bool result = run_batch(batch);
+            lock.lock();
+            for (auto* request : batch)
+                {
+                    request->result = result;
+                    request->done = true;
+                }
+            d_done_cond.notify_all();
+        }
+    // Nobody is going to process the requests left
+    for (auto* request : d_pending)
+        {
+            request->done = true;
+        }
+    d_pending.clear();
+    d_done_cond.notify_all();
+}
+
+
+bool Acq_Cuda_Engine::reserve(uint32_t input_rows, uint32_t spectra_rows, uint32_t product_rows)
+{
+    bool ok = true;
+    if (input_rows > d_input_rows)
+        {
+            cudaFree(d_input);
+            d_input = nullptr;
+            ok = cuda_check(cudaMalloc(&d_input, static_cast<size_t>(input_rows) * d_fft_size * sizeof(cufftComplex)), "input allocation");
+            d_input_rows = (ok ? input_rows : 0);
+        }
+    if (ok and (spectra_rows > d_spectra_rows))
+        {
+            cudaFree(d_spectra);
+            cudaFree(d_doppler_hz);
+            cudaFree(d_input_row);
+            d_spectra = nullptr;
+            d_doppler_hz = nullptr;
+            d_input_row = nullptr;
+            ok = cuda_check(cudaMalloc(&d_spectra, static_cast<size_t>(spectra_rows) * d_fft_size * sizeof(cufftComplex)), "spectra allocation") and
+                 cuda_check(cudaMalloc(&d_doppler_hz, spectra_rows * sizeof(float)), "Doppler grid allocation") and
+                 cuda_check(cudaMalloc(&d_input_row, spectra_rows * sizeof(uint32_t)), "Doppler grid allocation");
+            d_spectra_rows = (ok ? spectra_rows : 0);
+        }
+    if (ok and (product_rows > d_product_rows))
+        {
+            cudaFree(d_products);
+            cudaFree(d_spectra_row);
+            cudaFree(d_code_row);
+            cudaFree(d_grid_row);
+            cudaFree(d_accumulate_row);
+            cudaFree(d_row_max);
+            cudaFree(d_row_max_index);
+            d_products = nullptr;
+            d_spectra_row = nullptr;
+            d_code_row = nullptr;
+            d_grid_row = nullptr;
+            d_accumulate_row = nullptr;
+            d_row_max = nullptr;
+            d_row_max_index = nullptr;
+            ok = cuda_check(cudaMalloc(&d_products, static_cast<size_t>(product_rows) * d_fft_size * sizeof(cufftComplex)), "products allocation") and
+                 cuda_check(cudaMalloc(&d_spectra_row, product_rows * sizeof(uint32_t)), "row allocation") and
+                 cuda_check(cudaMalloc(&d_code_row, product_rows * sizeof(cufftComplex*)), "row allocation") and
+                 cuda_check(cudaMalloc(&d_grid_row, product_rows * sizeof(float*)), "row allocation") and
+                 cuda_check(cudaMalloc(&d_accumulate_row, product_rows * sizeof(uint8_t)), "row allocation") and
+                 cuda_check(cudaMalloc(&d_row_max, product_rows * sizeof(float)), "maxima allocation") and
+                 cuda_check(cudaMalloc(&d_row_max_index, product_rows * sizeof(uint32_t)), "maxima allocation");
+            d_product_rows = (ok ? product_rows : 0);
+        }
+    return ok;
+}
+
+
+bool Acq_Cuda_Engine::plan(uint32_t batch, cufftHandle& handle)
+{
+    auto it = d_plans.find(batch);
+    if (it != d_plans.end())
+        {
+            handle = it->second;
+            return true;
+        }
+    if ((cufftPlan1d(&handle, d_fft_size, CUFFT_C2C, batch) != CUFFT_SUCCESS) or (cufftSetStream(handle, d_stream) != CUFFT_SUCCESS))
+        {
+            std::cerr << "CUDA acquisition: cannot create a batched FFT plan of " << batch << " x " << d_fft_size << " points" << std::endl;
+            return false;
+        }
+    d_plans[batch] = handle;
+    return true;
+}
+
+
+bool Acq_Cuda_Engine::run_batch(const std::vector<Request*>& batch)
+{
+    // Requests with the same input block and Doppler grid share the wipe-off and the forward FFTs
+    std::vector<Request*> group_head;
+    std::vector<uint32_t> request_group(batch.size());
+    std::vector<uint32_t> group_first_row;
+    uint32_t spectra_rows = 0;
+    uint32_t product_rows = 0;
+    for (uint32_t r = 0; r < batch.size(); r++)
+        {
+            const Request* request = batch[r];
+            uint32_t g = 0;
+            while ((g < group_head.size()) and !((group_head[g]->input_key == request->input_key) and
+                                                    (group_head[g]->sample_stamp == request->sample_stamp) and
+                                                    (*group_head[g]->doppler_hz == *request->doppler_hz)))
+                {
+                    g++;
+                }
+            if (g == group_head.size())
+                {
+                    group_head.push_back(batch[r]);
+                    group_first_row.push_back(spectra_rows);
+                    spectra_rows += request->doppler_hz->size();
+                }
+            request_group[r] = g;
+            product_rows += request->doppler_hz->size();
+        }
+    if (!reserve(group_head.size(), spectra_rows, product_rows))
+        {
+            return false;
+        }
+
+    // Per-row parameters of the kernels
+    std::vector<float> doppler_hz;
+    std::vector<uint32_t> input_row;
+    for (uint32_t g = 0; g < group_head.size(); g++)
+        {
+            doppler_hz.insert(doppler_hz.end(), group_head[g]->doppler_hz->begin(), group_head[g]->doppler_hz->end());
+            input_row.insert(input_row.end(), group_head[g]->doppler_hz->size(), g);
+        }
+    std::vector<uint32_t> spectra_row;
+    std::vector<cufftComplex*> code_row;
+    std::vector<float*> grid_row;
+    std::vector<uint8_t> accumulate_row;
+    for (uint32_t r = 0; r < batch.size(); r++)
+        {
+            for (uint32_t bin = 0; bin < batch[r]->doppler_hz->size(); bin++)
+                {
+                    spectra_row.push_back(group_first_row[request_group[r]] + bin);
+                    code_row.push_back(batch[r]->code);
+                    grid_row.push_back(batch[r]->grid + static_cast<size_t>(bin) * d_fft_size);
+                    accumulate_row.push_back(batch[r]->accumulate ? 1 : 0);
+                }
+        }
+
+    bool ok = true;
+    for (uint32_t g = 0; g < group_head.size(); g++)
+        {
+            ok = ok and cuda_check(cudaMemcpyAsync(d_input + static_cast<size_t>(g) * d_fft_size, group_head[g]->in, d_fft_size * sizeof(cufftComplex), cudaMemcpyHostToDevice, d_stream), "input upload");
+        }
+    ok = ok and cuda_check(cudaMemcpyAsync(d_doppler_hz, doppler_hz.data(), spectra_rows * sizeof(float), cudaMemcpyHostToDevice, d_stream), "Doppler grid upload");
+    ok = ok and cuda_check(cudaMemcpyAsync(d_input_row, input_row.data(), spectra_rows * sizeof(uint32_t), cudaMemcpyHostToDevice, d_stream), "Doppler grid upload");
+    ok = ok and cuda_check(cudaMemcpyAsync(d_spectra_row, spectra_row.data(), product_rows * sizeof(uint32_t), cudaMemcpyHostToDevice, d_stream), "row upload");
+    ok = ok and cuda_check(cudaMemcpyAsync(d_code_row, code_row.data(), product_rows * sizeof(cufftComplex*), cudaMemcpyHostToDevice, d_stream), "row upload");
+    ok = ok and cuda_check(cudaMemcpyAsync(d_grid_row, grid_row.data(), product_rows * sizeof(float*), cudaMemcpyHostToDevice, d_stream), "row upload");
+    ok = ok and cuda_check(cudaMemcpyAsync(d_accumulate_row, accumulate_row.data(), product_rows * sizeof(uint8_t), cudaMemcpyHostToDevice, d_stream), "row upload");
+    if (!ok)
+        {
+            return false;
+        }
+
+    // Doppler wipe-off and forward FFT of every (input block, Doppler bin) pair
+    uint32_t blocks_per_row = std::min((d_fft_size + ACQ_CUDA_THREADS_PER_BLOCK - 1) / ACQ_CUDA_THREADS_PER_BLOCK, 64U);
+    acq_doppler_wipeoff_kernel<<<dim3(blocks_per_row, spectra_rows), ACQ_CUDA_THREADS_PER_BLOCK, 0, d_stream>>>(d_spectra, d_input, d_input_row, d_doppler_hz, d_fft_size, static_cast<double>(d_fs_hz));
+    cufftHandle forward;
+    if (!plan(spectra_rows, forward) or (cufftExecC2C(forward, d_spectra, d_spectra, CUFFT_FORWARD) != CUFFT_SUCCESS))
+        {
+            return false;
+        }
+
+    // Correlation with the local codes of all the channels, in a single batched inverse FFT
+    acq_code_multiply_kernel<<<dim3(blocks_per_row, product_rows), ACQ_CUDA_THREADS_PER_BLOCK, 0, d_stream>>>(d_products, d_spectra, d_spectra_row, d_code_row, d_fft_size);
+    cufftHandle inverse;
+    if (!plan(product_rows, inverse) or (cufftExecC2C(inverse, d_products, d_products, CUFFT_INVERSE) != CUFFT_SUCCESS))
+        {
+            return false;
+        }
+
+    // All the requests of a batch share the code phase range, except for bit_transition_flag channels
+    uint32_t row = 0;
+    for (const auto* request : batch)
+        {
+            uint32_t rows = request->doppler_hz->size();
+            acq_magnitude_max_kernel<<<rows, ACQ_CUDA_THREADS_PER_BLOCK, 0, d_stream>>>(d_grid_row + row, d_products + static_cast<size_t>(row) * d_fft_size, d_fft_size,
+                request->offset, request->length, d_accumulate_row + row, d_row_max + row, d_row_max_index + row);
+            ok = ok and cuda_check(cudaMemcpyAsync(request->bin_max, d_row_max + row, rows * sizeof(float), cudaMemcpyDeviceToHost, d_stream), "maxima download");
+            ok = ok and cuda_check(cudaMemcpyAsync(request->bin_max_index, d_row_max_index + row, rows * sizeof(uint32_t), cudaMemcpyDeviceToHost, d_stream), "maxima download");
+            row += rows;
+        }
+    ok = ok and cuda_check(cudaStreamSynchronize(d_stream), "grid search");
+    if (!ok)
+        {
+            return false;
+        }
+
+    // The row of the highest peak is needed for the second peak statistic
+    for (const auto* request : batch)
+        {
+            uint32_t rows = request->doppler_hz->size();
+            uint32_t best = std::max_element(request->bin_max, request->bin_max + rows) - request->bin_max;
+            ok = ok and cuda_check(cudaMemcpyAsync(request->best_row, request->grid + static_cast<size_t>(best) * d_fft_size, request->length * sizeof(float), cudaMemcpyDeviceToHost, d_stream), "row download");
+        }
+    return ok and cuda_check(cudaStreamSynchronize(d_stream), "row download");
+}
@@ -0,0 +1,174 @@
+/*!
+ * \file acq_cuda_engine.h
+ * \brief Class that runs the PCPS acquisition grid searches of many channels
+ * on a NVIDIA CUDA GPU, batching the FFTs of all the pending requests.
+ *
+ * Every PCPS acquisition channel with use_cuda enabled submits its grid
+ * searches here. Requests arriving within a short batching window are
+ * processed together: channels that share the same input block and
+ * Doppler grid share the Doppler wipe-off and the forward FFTs, and all
+ * the inverse FFTs (PRNs x Doppler bins) are executed in a single batched
+ * cuFFT call.
+ *
+ * -------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2018  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *          Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_ACQ_CUDA_ENGINE_H_
+#define GNSS_SDR_ACQ_CUDA_ENGINE_H_
+
+#include <cuda_runtime.h>
+#include <cufft.h>
+#include <condition_variable>
+#include <complex>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+
+/*!
+ * \brief Shared GPU back-end for the PCPS acquisition grid search.
+ *
+ * Each channel owns a slot holding its FFT'd local code and its
+ * non-coherent accumulation grid in device memory. search() blocks the
+ * calling channel until its request has been processed by the batch
+ * dispatcher thread.
+ */
+class Acq_Cuda_Engine
+{
+public:
+    /*!
+     * \brief Returns the engine shared by all the channels with FFT length
+     * \p fft_size working at sampling rate \p fs_hz. It is created on the
+     * first request, and released when the last channel using it is destroyed.
+     */
+    static std::shared_ptr<Acq_Cuda_Engine> get_instance(uint32_t fft_size, int64_t fs_hz, uint32_t batch_window_us);
+
+    Acq_Cuda_Engine(uint32_t fft_size, int64_t fs_hz, uint32_t batch_window_us);
+    ~Acq_Cuda_Engine();
+
+    /*!
+     * \brief Returns false if no CUDA device could be initialized.
+     */
+    inline bool ready() const
+    {
+        return d_ready;
+    }
+
+    /*!
+     * \brief Reserves a slot for a channel searching up to \p max_doppler_bins bins.
+     * \return the slot identifier, or -1 in case of failure.
+     */
+    int32_t add_channel(uint32_t max_doppler_bins);
+
+    void remove_channel(int32_t slot);
+
+    /*!
+     * \brief Uploads the FFT'd (and conjugated) local code of a channel.
+     */
+    bool set_local_code(int32_t slot, const std::complex<float>* fft_code);
+
+    /*!
+     * \brief Searches the Doppler bins \p doppler_hz of the input block \p in.
+     *
+     * \param input_key - Identifier of the sample stream. Requests with the
+     * same key, sample stamp and Doppler grid share the forward FFTs.
+     * \param accumulate - Adds the squared magnitudes to the ones of the previous dwell.
+     * \param offset, length - Range of code phases where the peaks are searched.
+     * \param bin_max, bin_max_index - Maximum and its position for each Doppler bin.
+     * \param best_row - Accumulated squared magnitude of the bin with the highest peak.
+     */
+    bool search(int32_t slot, const std::string& input_key, uint64_t sample_stamp, const std::complex<float>* in,
+        const std::vector<float>& doppler_hz, bool accumulate, uint32_t offset, uint32_t length,
+        float* bin_max, uint32_t* bin_max_index, float* best_row);
+
+private:
+    struct Channel_Slot
+    {
+        cufftComplex* code;  // FFT'd local code
+        float* grid;         // non-coherent accumulation of the squared magnitudes
+        uint32_t max_doppler_bins;
+    };
+
+    struct Request
+    {
+        int32_t slot;
+        std::string input_key;
+        uint64_t sample_stamp;
+        const std::complex<float>* in;
+        const std::vector<float>* doppler_hz;
+        bool accumulate;
+        uint32_t offset;
+        uint32_t length;
+        float* bin_max;
+        uint32_t* bin_max_index;
+        float* best_row;
+        cufftComplex* code;
+        float* grid;
+        bool done;
+        bool result;
+    };
+
+    void dispatcher();
+    bool run_batch(const std::vector<Request*>& batch);
+    bool reserve(uint32_t input_rows, uint32_t spectra_rows, uint32_t product_rows);
+    bool plan(uint32_t batch, cufftHandle& handle);
+
+    uint32_t d_fft_size;
+    int64_t d_fs_hz;
+    uint32_t d_batch_window_us;
+    bool d_ready;
+    bool d_stop;
+
+    // Device buffers, reused by all the batches
+    cufftComplex* d_input;
+    cufftComplex* d_spectra;
+    cufftComplex* d_products;
+    float* d_doppler_hz;        // Doppler shift of each spectra row
+    uint32_t* d_input_row;      // input block of each spectra row
+    uint32_t* d_spectra_row;    // spectrum of each product row
+    cufftComplex** d_code_row;  // local code of each product row
+    float** d_grid_row;         // accumulation grid row of each product row
+    uint8_t* d_accumulate_row;  // non-coherent accumulation flag of each product row
+    float* d_row_max;
+    uint32_t* d_row_max_index;
+    uint32_t d_input_rows;
+    uint32_t d_spectra_rows;
+    uint32_t d_product_rows;
+    std::map<uint32_t, cufftHandle> d_plans;  // batched FFT plans, indexed by batch size
+    cudaStream_t d_stream;
+
+    std::vector<Channel_Slot> d_slots;
+    std::vector<Request*> d_pending;
+    std::mutex d_mutex;
+    std::condition_variable d_request_cond;
+    std::condition_variable d_done_cond;
+    std::thread d_thread;
+};
+
+#endif
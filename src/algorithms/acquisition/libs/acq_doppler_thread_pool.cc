@@ -0,0 +1,149 @@
+/*!
+ * \file acq_doppler_thread_pool.cc
+ * \brief Threads shared by all the PCPS acquisition channels to search
+ * the bins of their Doppler grids in parallel.
+ *
+ * -------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2019  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *          Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------
+ */
+
+#include "acq_doppler_thread_pool.h"
+#include <algorithm>
+
+
+std::shared_ptr<Acq_Doppler_Thread_Pool> Acq_Doppler_Thread_Pool::get_instance()
+{
+    static std::mutex instance_mutex;
+    static std::weak_ptr<Acq_Doppler_Thread_Pool> instance;
+
+    std::lock_guard<std::mutex> lock(instance_mutex);
+    std::shared_ptr<Acq_Doppler_Thread_Pool> pool = instance.lock();
+    if (!pool)
+        {
+            // The acquisition threads of the channels search too
+            uint32_t hardware_threads = std::max(std::thread::hardware_concurrency(), 1U);
+            pool = std::make_shared<Acq_Doppler_Thread_Pool>(hardware_threads - 1U);
+            instance = pool;
+        }
+    return pool;
+}
+
+
+Acq_Doppler_Thread_Pool::Acq_Doppler_Thread_Pool(uint32_t threads)
+{
+    d_stop = false;
+    for (uint32_t i = 0; i < threads; i++)
+        {
+            d_threads.emplace_back(&Acq_Doppler_Thread_Pool::work, this);
+        }
+}
+
+
+Acq_Doppler_Thread_Pool::~Acq_Doppler_Thread_Pool()
+{
+    {
+        std::lock_guard<std::mutex> lock(d_mutex);
+        d_stop = true;
+    }
+    d_job_posted.notify_all();
+    for (auto& thread : d_threads)
+        {
+            thread.join();
+        }
+}
+
+
+void Acq_Doppler_Thread_Pool::run(uint32_t tasks, const std::function<void(uint32_t)>& task)
+{
+    Job job;
+    job.task = &task;
+    job.tasks = tasks;
+    job.next = 0;
+    job.done = 0;
+
+    std::unique_lock<std::mutex> lock(d_mutex);
+    if ((tasks > 1) and !d_threads.empty())
+        {
+            d_jobs.push_back(&job);
+            for (uint32_t i = 1; i < std::min(tasks, size() + 1U); i++)
+                {
+                    d_job_posted.notify_one();
+                }
+        }
+    uint32_t index;
+    while (take(job, index))
+        {
+            lock.unlock();
+            task(index);
+            lock.lock();
+            job.done++;
+        }
+    // All the tasks have started, and the job is out of the queue
+    d_task_done.wait(lock, [&job] { return job.done == job.tasks; });
+}
+
+
+bool Acq_Doppler_Thread_Pool::take(Job& job, uint32_t& index)
+{
+    if (job.next == job.tasks)
+        {
+            return false;
+        }
+    index = job.next++;
+    if (job.next == job.tasks)
+        {
+            auto queued = std::find(d_jobs.begin(), d_jobs.end(), &job);
+            if (queued != d_jobs.end())
+                {
+                    d_jobs.erase(queued);
+                }
+        }
+    return true;
+}
+
+
+void Acq_Doppler_Thread_Pool::work()
+{
+    std::unique_lock<std::mutex> lock(d_mutex);
+    while (true)
+        {
+            d_job_posted.wait(lock, [this] { return d_stop or !d_jobs.empty(); });
+            if (d_stop)
+                {
+                    return;
+                }
+            // A queued job always has tasks not started yet
+            Job* job = d_jobs.front();
+            uint32_t index;
+            take(*job, index);
+            lock.unlock();
+            (*job->task)(index);
+            lock.lock();
+            job->done++;
+            if (job->done == job->tasks)
+                {
+                    d_task_done.notify_all();
+                }
+        }
+}
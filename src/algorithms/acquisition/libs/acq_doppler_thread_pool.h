@@ -0,0 +1,99 @@
+/*!
+ * \file acq_doppler_thread_pool.h
+ * \brief Threads shared by all the PCPS acquisition channels to search
+ * the bins of their Doppler grids in parallel.
+ *
+ * -------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2019  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *          Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_ACQ_DOPPLER_THREAD_POOL_H_
+#define GNSS_SDR_ACQ_DOPPLER_THREAD_POOL_H_
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+
+/*!
+ * \brief Fixed set of threads that run the Doppler grid searches of all
+ * the channels. The threads are started once, so a dwell does not create
+ * any, and their number does not grow with the number of channels.
+ *
+ * The calling thread takes part in its own search: if all the threads of
+ * the pool are busy with other channels, it runs the whole search itself.
+ */
+class Acq_Doppler_Thread_Pool
+{
+public:
+    /*!
+     * \brief Returns the pool shared by all the channels, with one thread
+     * less than the hardware threads. The pool is created on the first
+     * request, and it is released when the last channel using it is destroyed.
+     */
+    static std::shared_ptr<Acq_Doppler_Thread_Pool> get_instance();
+
+    explicit Acq_Doppler_Thread_Pool(uint32_t threads);
+    ~Acq_Doppler_Thread_Pool();
+
+    /*!
+     * \brief Runs task(0), ..., task(tasks - 1), each one once, on the calling
+     * thread and on the idle threads of the pool, and returns when all of them
+     * have finished. The tasks may run concurrently.
+     */
+    void run(uint32_t tasks, const std::function<void(uint32_t)>& task);
+
+    inline uint32_t size() const
+    {
+        return d_threads.size();
+    }
+
+private:
+    struct Job
+    {
+        const std::function<void(uint32_t)>* task;
+        uint32_t tasks;
+        uint32_t next;  // next task to start
+        uint32_t done;  // finished tasks
+    };
+
+    void work();
+
+    // Takes the next task of job, or returns false if all of them have started
+    bool take(Job& job, uint32_t& index);
+
+    bool d_stop;
+    std::deque<Job*> d_jobs;  // jobs with tasks not started yet, in arrival order
+    std::mutex d_mutex;
+    std::condition_variable d_job_posted;
+    std::condition_variable d_task_done;
+    std::vector<std::thread> d_threads;
+};
+
+#endif
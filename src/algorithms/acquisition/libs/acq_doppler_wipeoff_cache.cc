@@ -0,0 +1,90 @@
+/*!
+ * \file acq_doppler_wipeoff_cache.cc
+ * \brief Process-wide store of immutable, reference-counted carrier
+ * Doppler wipe-off tables shared by the PCPS acquisition channels.
+ *
+ * -------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2018  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *          Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------
+ */
+
+#include "acq_doppler_wipeoff_cache.h"
+#include "GPS_L1_CA.h"  // for GPS_TWO_PI
+#include <volk_gnsssdr/volk_gnsssdr.h>
+#include <cmath>
+
+
+std::shared_ptr<Acq_Doppler_Wipeoff_Cache> Acq_Doppler_Wipeoff_Cache::get_instance()
+{
+    static std::shared_ptr<Acq_Doppler_Wipeoff_Cache> instance = std::make_shared<Acq_Doppler_Wipeoff_Cache>();
+    return instance;
+}
+
+
+std::shared_ptr<const gr_complex> Acq_Doppler_Wipeoff_Cache::get(int64_t fs, uint32_t length, float doppler_hz)
+{
+    Table_Key key = std::make_tuple(fs, length, static_cast<int64_t>(std::round(static_cast<double>(doppler_hz) * 1000.0)));
+    std::lock_guard<std::mutex> lock(d_mutex);
+    std::shared_ptr<const gr_complex> table = d_tables[key].lock();
+    if (table)
+        {
+            return table;
+        }
+
+    // Forget the tables that nobody is using anymore
+    for (auto it = d_tables.begin(); it != d_tables.end();)
+        {
+            if (it->second.expired())
+                {
+                    it = d_tables.erase(it);
+                }
+            else
+                {
+                    ++it;
+                }
+        }
+
+    auto* carrier = static_cast<gr_complex*>(volk_gnsssdr_malloc(length * sizeof(gr_complex), volk_gnsssdr_get_alignment()));
+    float phase_step_rad = GPS_TWO_PI * doppler_hz / static_cast<float>(fs);
+    float _phase[1];
+    _phase[0] = 0.0;
+    volk_gnsssdr_s32f_sincos_32fc(carrier, -phase_step_rad, _phase, length);
+    table = std::shared_ptr<const gr_complex>(carrier, [](const gr_complex* p) { volk_gnsssdr_free(const_cast<gr_complex*>(p)); });
+    d_tables[key] = table;
+    return table;
+}
+
+
+size_t Acq_Doppler_Wipeoff_Cache::size()
+{
+    std::lock_guard<std::mutex> lock(d_mutex);
+    size_t alive = 0;
+    for (const auto& table : d_tables)
+        {
+            if (!table.second.expired())
+                {
+                    alive++;
+                }
+        }
+    return alive;
+}
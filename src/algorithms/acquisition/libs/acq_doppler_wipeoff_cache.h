@@ -0,0 +1,78 @@
+/*!
+ * \file acq_doppler_wipeoff_cache.h
+ * \brief Process-wide store of immutable, reference-counted carrier
+ * Doppler wipe-off tables shared by the PCPS acquisition channels.
+ *
+ * The wipe-off table of a Doppler bin only depends on the sampling rate,
+ * the table length and the bin frequency, so all the channels with the
+ * same configuration can use the same copy instead of allocating their
+ * own grid. Tables are released when the last channel using them drops
+ * its reference.
+ *
+ * -------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2018  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *          Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_ACQ_DOPPLER_WIPEOFF_CACHE_H_
+#define GNSS_SDR_ACQ_DOPPLER_WIPEOFF_CACHE_H_
+
+#include <gnuradio/gr_complex.h>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <tuple>
+
+
+/*!
+ * \brief Thread-safe registry of carrier wipe-off tables, indexed by
+ * sampling rate, length and Doppler frequency.
+ */
+class Acq_Doppler_Wipeoff_Cache
+{
+public:
+    /*!
+     * \brief Returns the process-wide instance of the registry.
+     */
+    static std::shared_ptr<Acq_Doppler_Wipeoff_Cache> get_instance();
+
+    /*!
+     * \brief Returns the table exp(-j*2*pi*doppler_hz*n/fs), n = 0, ..., length - 1,
+     * creating it if no other channel is holding it.
+     */
+    std::shared_ptr<const gr_complex> get(int64_t fs, uint32_t length, float doppler_hz);
+
+    /*!
+     * \brief Number of tables currently alive.
+     */
+    size_t size();
+
+private:
+    typedef std::tuple<int64_t, uint32_t, int64_t> Table_Key;
+
+    std::map<Table_Key, std::weak_ptr<const gr_complex> > d_tables;
+    std::mutex d_mutex;
+};
+
+#endif
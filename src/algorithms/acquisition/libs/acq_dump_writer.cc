@@ -0,0 +1,241 @@
+/*!
+ * \file acq_dump_writer.cc
+ * \brief Class that writes the acquisition grid dumps from a background
+ * thread, so the acquisition channels do not wait for the disk.
+ *
+ *
+ * -------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2018  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *          Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------
+ */
+
+#include "acq_dump_writer.h"
+#include <glog/logging.h>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <iostream>
+#include <limits>
+#include <map>
+#include <utility>
+
+
+Acq_Dump_Record::Acq_Dump_Record(const std::string& filename)
+{
+    d_filename = filename;
+}
+
+
+void Acq_Dump_Record::add_variable(const std::string& name, matio_classes class_type, matio_types data_type, size_t rows, size_t cols, const void* data, size_t item_size)
+{
+    Variable variable;
+    variable.name = name;
+    variable.class_type = class_type;
+    variable.data_type = data_type;
+    variable.dims[0] = rows;
+    variable.dims[1] = cols;
+    variable.data.resize(rows * cols * item_size);
+    memcpy(variable.data.data(), data, variable.data.size());
+    d_variables.push_back(std::move(variable));
+}
+
+
+void Acq_Dump_Record::add(const std::string& name, float value)
+{
+    add_variable(name, MAT_C_SINGLE, MAT_T_SINGLE, 1, 1, &value, sizeof(float));
+}
+
+
+void Acq_Dump_Record::add(const std::string& name, int32_t value)
+{
+    add_variable(name, MAT_C_INT32, MAT_T_INT32, 1, 1, &value, sizeof(int32_t));
+}
+
+
+void Acq_Dump_Record::add(const std::string& name, uint32_t value)
+{
+    add_variable(name, MAT_C_UINT32, MAT_T_UINT32, 1, 1, &value, sizeof(uint32_t));
+}
+
+
+void Acq_Dump_Record::add(const std::string& name, uint64_t value)
+{
+    add_variable(name, MAT_C_UINT64, MAT_T_UINT64, 1, 1, &value, sizeof(uint64_t));
+}
+
+
+void Acq_Dump_Record::add_grid(const std::string& name, const float* grid, size_t rows, size_t cols, bool quantize)
+{
+    if (!quantize)
+        {
+            add_variable(name, MAT_C_SINGLE, MAT_T_SINGLE, rows, cols, grid, sizeof(float));
+            return;
+        }
+    size_t n = rows * cols;
+    float grid_max = 0.0;
+    for (size_t i = 0; i < n; i++)
+        {
+            grid_max = std::max(grid_max, grid[i]);
+        }
+    float scale = (grid_max > 0.0 ? grid_max / static_cast<float>(std::numeric_limits<uint16_t>::max()) : 1.0);
+    std::vector<uint16_t> quantized(n);
+    for (size_t i = 0; i < n; i++)
+        {
+            quantized[i] = static_cast<uint16_t>(std::round(std::max(grid[i], 0.0F) / scale));
+        }
+    add_variable(name, MAT_C_UINT16, MAT_T_UINT16, rows, cols, quantized.data(), sizeof(uint16_t));
+    add(name + "_scale", scale);
+}
+
+
+bool Acq_Dump_Record::write(bool compression) const
+{
+    mat_t* matfp = Mat_CreateVer(d_filename.c_str(), nullptr, MAT_FT_MAT73);
+    if (matfp == nullptr)
+        {
+            return false;
+        }
+    for (const auto& variable : d_variables)
+        {
+            size_t dims[2] = {variable.dims[0], variable.dims[1]};
+            matvar_t* matvar = Mat_VarCreate(variable.name.c_str(), variable.class_type, variable.data_type, 2, dims, const_cast<uint8_t*>(variable.data.data()), 0);
+            Mat_VarWrite(matfp, matvar, compression ? MAT_COMPRESSION_ZLIB : MAT_COMPRESSION_NONE);
+            Mat_VarFree(matvar);
+        }
+    Mat_Close(matfp);
+    return true;
+}
+
+
+std::shared_ptr<Acq_Dump_Writer> Acq_Dump_Writer::get_instance(uint32_t queue_size, bool compression)
+{
+    static std::mutex registry_mutex;
+    static std::map<std::pair<uint32_t, bool>, std::weak_ptr<Acq_Dump_Writer> > registry;
+
+    std::pair<uint32_t, bool> key(queue_size, compression);
+    std::lock_guard<std::mutex> lock(registry_mutex);
+    std::shared_ptr<Acq_Dump_Writer> writer = registry[key].lock();
+    if (!writer)
+        {
+            writer = std::make_shared<Acq_Dump_Writer>(queue_size, compression);
+            registry[key] = writer;
+        }
+    return writer;
+}
+
+
+Acq_Dump_Writer::Acq_Dump_Writer(uint32_t queue_size, bool compression)
+{
+    d_queue_size = (queue_size > 0U ? queue_size : 1U);
+    d_compression = compression;
+    d_stop = false;
+    d_written = 0ULL;
+    d_dropped = 0ULL;
+    d_failed = 0ULL;
+    d_thread = std::thread(&Acq_Dump_Writer::run, this);
+}
+
+
+Acq_Dump_Writer::~Acq_Dump_Writer()
+{
+    {
+        std::lock_guard<std::mutex> lock(d_mutex);
+        d_stop = true;
+    }
+    d_cond.notify_one();
+    d_thread.join();
+    if (d_dropped > 0ULL)
+        {
+            LOG(WARNING) << d_dropped << " acquisition dumps were dropped because the writer could not keep up";
+        }
+}
+
+
+bool Acq_Dump_Writer::push(std::unique_ptr<Acq_Dump_Record> record)
+{
+    {
+        std::lock_guard<std::mutex> lock(d_mutex);
+        if (d_queue.size() >= d_queue_size)
+            {
+                d_dropped++;
+                LOG(WARNING) << "Acquisition dump queue full, " << record->filename() << " dropped (" << d_dropped << " dropped so far)";
+                return false;
+            }
+        d_queue.push_back(std::move(record));
+    }
+    d_cond.notify_one();
+    return true;
+}
+
+
+void Acq_Dump_Writer::run()
+{
+    std::unique_lock<std::mutex> lock(d_mutex);
+    while (true)
+        {
+            d_cond.wait(lock, [this] { return d_stop or !d_queue.empty(); });
+            if (d_queue.empty())
+                {
+                    // stopped, and all the pending records are already written
+                    return;
+                }
+            std::unique_ptr<Acq_Dump_Record> record = std::move(d_queue.front());
+            d_queue.pop_front();
+            lock.unlock();
+            bool result = record->write(d_compression);
+            if (!result)
+                {
+                    std::cout << "Unable to create or open Acquisition dump file" << std::endl;
+                }
+            lock.lock();
+            if (result)
+                {
+                    d_written++;
+                }
+            else
+                {
+                    d_failed++;
+                }
+        }
+}
+
+
+uint64_t Acq_Dump_Writer::written()
+{
+    std::lock_guard<std::mutex> lock(d_mutex);
+    return d_written;
+}
+
+
+uint64_t Acq_Dump_Writer::dropped()
+{
+    std::lock_guard<std::mutex> lock(d_mutex);
+    return d_dropped;
+}
+
+
+uint64_t Acq_Dump_Writer::failed()
+{
+    std::lock_guard<std::mutex> lock(d_mutex);
+    return d_failed;
+}
@@ -0,0 +1,138 @@
+/*!
+ * \file acq_dump_writer.h
+ * \brief Class that writes the acquisition grid dumps from a background
+ * thread, so the acquisition channels do not wait for the disk.
+ *
+ * The channels fill a Acq_Dump_Record with copies of the variables to be
+ * stored and push it to a bounded queue. A single writer thread creates the
+ * .mat files. When the queue is full, the new records are dropped and
+ * counted, instead of blocking the signal processing.
+ *
+ *
+ * -------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2018  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *          Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_ACQ_DUMP_WRITER_H_
+#define GNSS_SDR_ACQ_DUMP_WRITER_H_
+
+#include <matio.h>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+
+/*!
+ * \brief Contents of one acquisition dump file.
+ */
+class Acq_Dump_Record
+{
+public:
+    explicit Acq_Dump_Record(const std::string& filename);
+
+    void add(const std::string& name, float value);
+    void add(const std::string& name, int32_t value);
+    void add(const std::string& name, uint32_t value);
+    void add(const std::string& name, uint64_t value);
+
+    /*!
+     * \brief Adds a copy of a \p rows x \p cols column-major matrix.
+     * If \p quantize is true, it is stored as uint16 scaled to its maximum,
+     * and the scale factor is stored as name + "_scale", that is,
+     * name = double(name) * name_scale.
+     */
+    void add_grid(const std::string& name, const float* grid, size_t rows, size_t cols, bool quantize);
+
+    inline const std::string& filename() const
+    {
+        return d_filename;
+    }
+
+    bool write(bool compression) const;
+
+private:
+    struct Variable
+    {
+        std::string name;
+        matio_classes class_type;
+        matio_types data_type;
+        size_t dims[2];
+        std::vector<uint8_t> data;
+    };
+
+    void add_variable(const std::string& name, matio_classes class_type, matio_types data_type, size_t rows, size_t cols, const void* data, size_t item_size);
+
+    std::string d_filename;
+    std::vector<Variable> d_variables;
+};
+
+
+/*!
+ * \brief Bounded queue of dump records, emptied by a dedicated writer thread.
+ */
+class Acq_Dump_Writer
+{
+public:
+    /*!
+     * \brief Returns the writer shared by all the channels with the same
+     * \p queue_size and \p compression settings. It is created on the first
+     * request, and released (after writing all the pending records) when the
+     * last channel using it is destroyed.
+     */
+    static std::shared_ptr<Acq_Dump_Writer> get_instance(uint32_t queue_size, bool compression);
+
+    Acq_Dump_Writer(uint32_t queue_size, bool compression);
+    ~Acq_Dump_Writer();
+
+    /*!
+     * \brief Queues a record for writing.
+     * \return false if the queue is full and the record has been dropped.
+     */
+    bool push(std::unique_ptr<Acq_Dump_Record> record);
+
+    uint64_t written();
+    uint64_t dropped();
+    uint64_t failed();
+
+private:
+    void run();
+
+    uint32_t d_queue_size;
+    bool d_compression;
+    bool d_stop;
+    uint64_t d_written;
+    uint64_t d_dropped;
+    uint64_t d_failed;
+    std::deque<std::unique_ptr<Acq_Dump_Record> > d_queue;
+    std::mutex d_mutex;
+    std::condition_variable d_cond;
+    std::thread d_thread;
+};
+
+#endif
@@ -0,0 +1,120 @@
+/*!
+ * \file acq_spectrum_cache.cc
+ * \brief Class that stores the spectra of the Doppler wiped-off input
+ * signal, so they can be shared among all the PCPS acquisition channels
+ * processing the same signal.
+ *
+ * -------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2018  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *          Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------
+ */
+
+#include "acq_spectrum_cache.h"
+#include <volk_gnsssdr/volk_gnsssdr.h>
+#include <cmath>
+#include <cstring>
+
+
+std::shared_ptr<Acq_Spectrum_Cache> Acq_Spectrum_Cache::get_instance(const std::string& signal, int64_t fs_in, uint32_t fft_size)
+{
+    static std::mutex registry_mutex;
+    static std::map<std::string, std::weak_ptr<Acq_Spectrum_Cache> > registry;
+
+    std::string key = signal + "_" + std::to_string(fs_in) + "_" + std::to_string(fft_size);
+    std::lock_guard<std::mutex> lock(registry_mutex);
+    std::shared_ptr<Acq_Spectrum_Cache> cache = registry[key].lock();
+    if (!cache)
+        {
+            cache = std::make_shared<Acq_Spectrum_Cache>(fft_size);
+            registry[key] = cache;
+        }
+    return cache;
+}
+
+
+Acq_Spectrum_Cache::Acq_Spectrum_Cache(uint32_t fft_size, uint32_t max_blocks)
+{
+    d_fft_size = fft_size;
+    d_max_blocks = (max_blocks > 0U ? max_blocks : 1U);
+    d_hits = 0ULL;
+    d_misses = 0ULL;
+}
+
+
+int64_t Acq_Spectrum_Cache::doppler_key(float doppler_hz)
+{
+    // Doppler bins are indexed in mHz, so the fractional steps of the second acquisition step can be told apart
+    return static_cast<int64_t>(std::round(static_cast<double>(doppler_hz) * 1000.0));
+}
+
+
+std::shared_ptr<const gr_complex> Acq_Spectrum_Cache::find(uint64_t sample_stamp, float doppler_hz)
+{
+    std::lock_guard<std::mutex> lock(d_mutex);
+    auto block = d_blocks.find(sample_stamp);
+    if (block != d_blocks.end())
+        {
+            auto spectrum = block->second.find(doppler_key(doppler_hz));
+            if (spectrum != block->second.end())
+                {
+                    d_hits++;
+                    return spectrum->second;
+                }
+        }
+    d_misses++;
+    return nullptr;
+}
+
+
+void Acq_Spectrum_Cache::insert(uint64_t sample_stamp, float doppler_hz, const gr_complex* spectrum)
+{
+    auto* buffer = static_cast<gr_complex*>(volk_gnsssdr_malloc(d_fft_size * sizeof(gr_complex), volk_gnsssdr_get_alignment()));
+    memcpy(buffer, spectrum, d_fft_size * sizeof(gr_complex));
+    std::shared_ptr<const gr_complex> stored(buffer, [](const gr_complex* p) { volk_gnsssdr_free(const_cast<gr_complex*>(p)); });
+
+    std::lock_guard<std::mutex> lock(d_mutex);
+    if ((d_blocks.size() >= d_max_blocks) and (d_blocks.find(sample_stamp) == d_blocks.end()))
+        {
+            if (sample_stamp < d_blocks.begin()->first)
+                {
+                    // Older than anything we keep: nobody else is going to ask for it
+                    return;
+                }
+            d_blocks.erase(d_blocks.begin());
+        }
+    d_blocks[sample_stamp][doppler_key(doppler_hz)] = stored;
+}
+
+
+uint64_t Acq_Spectrum_Cache::hits()
+{
+    std::lock_guard<std::mutex> lock(d_mutex);
+    return d_hits;
+}
+
+
+uint64_t Acq_Spectrum_Cache::misses()
+{
+    std::lock_guard<std::mutex> lock(d_mutex);
+    return d_misses;
+}
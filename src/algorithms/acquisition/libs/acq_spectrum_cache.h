@@ -0,0 +1,101 @@
+/*!
+ * \file acq_spectrum_cache.h
+ * \brief Class that stores the spectra of the Doppler wiped-off input
+ * signal, so they can be shared among all the PCPS acquisition channels
+ * processing the same signal.
+ *
+ * All the acquisition channels of a given band see exactly the same input
+ * samples. When their captures are aligned in time, the Doppler wipe-off and
+ * the forward FFT of each Doppler bin only need to be computed once per
+ * sample block. The first channel that processes a block stores the
+ * resulting spectra here, and the rest of channels just multiply them by
+ * their own FFT'd local code.
+ *
+ * -------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2018  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *          Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_ACQ_SPECTRUM_CACHE_H_
+#define GNSS_SDR_ACQ_SPECTRUM_CACHE_H_
+
+#include <gnuradio/gr_complex.h>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+
+
+/*!
+ * \brief Thread-safe store of Doppler wiped-off input spectra, indexed by
+ * sample stamp and Doppler frequency.
+ *
+ * Only the spectra of the last \p max_blocks sample blocks are retained.
+ * Stored spectra are immutable and reference-counted, so a channel can keep
+ * using a spectrum while other channels insert new blocks.
+ */
+class Acq_Spectrum_Cache
+{
+public:
+    /*!
+     * \brief Returns the cache shared by all the channels of signal \p signal
+     * working at sampling rate \p fs_in with FFT length \p fft_size.
+     * The cache is created on the first request, and it is released when
+     * the last channel using it is destroyed.
+     */
+    static std::shared_ptr<Acq_Spectrum_Cache> get_instance(const std::string& signal, int64_t fs_in, uint32_t fft_size);
+
+    explicit Acq_Spectrum_Cache(uint32_t fft_size, uint32_t max_blocks = 4);
+
+    /*!
+     * \brief Returns the spectrum of the block ending at \p sample_stamp,
+     * wiped off at \p doppler_hz, or nullptr if it is not available.
+     */
+    std::shared_ptr<const gr_complex> find(uint64_t sample_stamp, float doppler_hz);
+
+    /*!
+     * \brief Stores a copy of \p spectrum (fft_size() samples).
+     */
+    void insert(uint64_t sample_stamp, float doppler_hz, const gr_complex* spectrum);
+
+    inline uint32_t fft_size() const
+    {
+        return d_fft_size;
+    }
+
+    uint64_t hits();
+    uint64_t misses();
+
+private:
+    static int64_t doppler_key(float doppler_hz);
+
+    uint32_t d_fft_size;
+    uint32_t d_max_blocks;
+    uint64_t d_hits;
+    uint64_t d_misses;
+    std::map<uint64_t, std::map<int64_t, std::shared_ptr<const gr_complex> > > d_blocks;
+    std::mutex d_mutex;
+};
+
+#endif
@@ -39,6 +39,7 @@
 #include <glog/logging.h>
 #include <fcntl.h>  // libraries used by the GIPO
 #include <iostream>
+#include <map>
 #include <sys/mman.h>  // libraries used by the GIPO
 #include <utility>
 
@@ -69,6 +70,79 @@
 #define SHL_16_BITS 65536
 
 
+std::shared_ptr<Fpga_Acquisition_Dispatcher> Fpga_Acquisition_Dispatcher::get_instance(const std::string &device_name)
+{
+    // The dispatchers are kept until the end of the program: the last
+    // reference to a channel engine can be released by its own job
+    static std::mutex registry_mutex;
+    static std::map<std::string, std::shared_ptr<Fpga_Acquisition_Dispatcher> > registry;
+
+    std::lock_guard<std::mutex> lock(registry_mutex);
+    std::shared_ptr<Fpga_Acquisition_Dispatcher> dispatcher = registry[device_name];
+    if (!dispatcher)
+        {
+            dispatcher = std::make_shared<Fpga_Acquisition_Dispatcher>();
+            registry[device_name] = dispatcher;
+        }
+    return dispatcher;
+}
+
+
+Fpga_Acquisition_Dispatcher::Fpga_Acquisition_Dispatcher()
+{
+    d_stop = false;
+    d_thread = std::thread(&Fpga_Acquisition_Dispatcher::run, this);
+}
+
+
+Fpga_Acquisition_Dispatcher::~Fpga_Acquisition_Dispatcher()
+{
+    {
+        std::lock_guard<std::mutex> lock(d_mutex);
+        d_stop = true;
+        d_jobs.clear();
+    }
+    d_cond.notify_one();
+    d_thread.join();
+}
+
+
+void Fpga_Acquisition_Dispatcher::post(std::function<void()> job)
+{
+    {
+        std::lock_guard<std::mutex> lock(d_mutex);
+        d_jobs.push_back(std::move(job));
+    }
+    d_cond.notify_one();
+}
+
+
+size_t Fpga_Acquisition_Dispatcher::pending()
+{
+    std::lock_guard<std::mutex> lock(d_mutex);
+    return d_jobs.size();
+}
+
+
+void Fpga_Acquisition_Dispatcher::run()
+{
+    std::unique_lock<std::mutex> lock(d_mutex);
+    while (true)
+        {
+            d_cond.wait(lock, [this] { return d_stop or !d_jobs.empty(); });
+            if (d_stop)
+                {
+                    return;
+                }
+            std::function<void()> job = std::move(d_jobs.front());
+            d_jobs.pop_front();
+            lock.unlock();
+            job();
+            lock.lock();
+        }
+}
+
+
 bool fpga_acquisition::init()
 {
     // configure the acquisition with the main initialization values
@@ -112,6 +186,7 @@ fpga_acquisition::fpga_acquisition(std::string device_name,
     d_nsamples_total = nsamples_total;
     d_doppler_max = doppler_max;
     d_doppler_step = 0;
+    d_job_generation = 0ULL;
     d_fd = 0;              // driver descriptor
     d_map_base = nullptr;  // driver memory map
     d_all_fft_codes = all_fft_codes;
@@ -145,6 +220,7 @@ fpga_acquisition::fpga_acquisition(std::string device_name,
             //std::cout << "Acquisition test register sanity check success!" << std::endl;
         }
     fpga_acquisition::reset_acquisition();
+    d_dispatcher = Fpga_Acquisition_Dispatcher::get_instance(d_device_name);
     DLOG(INFO) << "Acquisition FPGA class created";
 }
 
@@ -155,6 +231,41 @@ fpga_acquisition::~fpga_acquisition()
 }
 
 
+void fpga_acquisition::post_acquisition(uint32_t PRN, uint32_t num_sweeps, std::function<void(const Fpga_Acquisition_Result &)> done)
+{
+    uint64_t generation;
+    {
+        std::lock_guard<std::mutex> lock(d_job_mutex);
+        generation = d_job_generation;
+    }
+    std::shared_ptr<fpga_acquisition> self = shared_from_this();
+    d_dispatcher->post([self, PRN, num_sweeps, done, generation]() {
+        // Held until the callback returns, so cancel_acquisitions() waits for it
+        std::lock_guard<std::mutex> lock(self->d_job_mutex);
+        if (self->d_job_generation != generation)
+            {
+                return;
+            }
+        // Other channels could have used the engine since this job was posted
+        self->configure_acquisition();
+        self->set_local_code(PRN);
+        self->set_doppler_sweep(num_sweeps);
+        self->run_acquisition();
+        Fpga_Acquisition_Result result;
+        self->read_acquisition_results(&result.max_index, &result.max_magnitude,
+            &result.initial_sample, &result.power_sum, &result.doppler_index);
+        done(result);
+    });
+}
+
+
+void fpga_acquisition::cancel_acquisitions()
+{
+    std::lock_guard<std::mutex> lock(d_job_mutex);
+    d_job_generation++;
+}
+
+
 bool fpga_acquisition::free()
 {
     return true;
@@ -38,12 +38,64 @@
 
 #include <gnuradio/fft/fft.h>
 #include <volk/volk.h>
+#include <condition_variable>
 #include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+
+
+/*!
+ * \brief Results of a Doppler sweep in the FPGA acquisition engine.
+ */
+struct Fpga_Acquisition_Result
+{
+    uint32_t max_index;
+    float max_magnitude;
+    uint64_t initial_sample;
+    float power_sum;
+    uint32_t doppler_index;
+};
+
+
+/*!
+ * \brief Queue of acquisition jobs of all the channels sharing an FPGA
+ * acquisition device. A dedicated thread runs them back to back, so the
+ * engine does not wait for the channels between searches.
+ */
+class Fpga_Acquisition_Dispatcher
+{
+public:
+    static std::shared_ptr<Fpga_Acquisition_Dispatcher> get_instance(const std::string& device_name);
+
+    Fpga_Acquisition_Dispatcher();
+    ~Fpga_Acquisition_Dispatcher();
+
+    void post(std::function<void()> job);
+
+    /*!
+     * \brief Number of jobs waiting for the engine.
+     */
+    size_t pending();
+
+private:
+    void run();
+
+    bool d_stop;
+    std::deque<std::function<void()> > d_jobs;
+    std::mutex d_mutex;
+    std::condition_variable d_cond;
+    std::thread d_thread;
+};
+
 
 /*!
  * \brief Class that implements carrier wipe-off and correlators.
  */
-class fpga_acquisition
+class fpga_acquisition : public std::enable_shared_from_this<fpga_acquisition>
 {
 public:
     fpga_acquisition(std::string device_name,
@@ -68,6 +120,21 @@ public:
     void block_samples();
     void unblock_samples();
 
+    /*!
+     * \brief Queues a search of satellite \p PRN over \p num_sweeps Doppler
+     * bins, and returns immediately. The engine configuration and the local
+     * code are written right before the search is launched, so the jobs of
+     * different channels can be interleaved. \p done is called from the
+     * dispatcher thread, unless the job is cancelled before.
+     */
+    void post_acquisition(uint32_t PRN, uint32_t num_sweeps, std::function<void(const Fpga_Acquisition_Result &)> done);
+
+    /*!
+     * \brief Cancels the jobs posted by this object. When it returns, no
+     * completion callback of those jobs is running or will be called.
+     */
+    void cancel_acquisitions();
+
     /*!
      * \brief Set maximum Doppler grid search
      * \param doppler_max - Maximum Doppler shift considered in the grid search [Hz].
@@ -99,6 +166,9 @@ private:
     std::string d_device_name;      // HW device name
     uint32_t d_doppler_max;         // max doppler
     uint32_t d_doppler_step;        // doppler step
+    std::shared_ptr<Fpga_Acquisition_Dispatcher> d_dispatcher;  // engine queue shared with the rest of channels
+    uint64_t d_job_generation;                                  // incremented to cancel the posted jobs
+    std::mutex d_job_mutex;
     // FPGA private functions
     uint32_t fpga_acquisition_test_register(uint32_t writeval);
     void fpga_configure_acquisition_local_code(lv_16sc_t fft_local_code[]);
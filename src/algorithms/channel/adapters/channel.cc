@@ -6,7 +6,7 @@
  *
  * -------------------------------------------------------------------------
  *
- * Copyright (C) 2010-2018  (see AUTHORS file for a list of contributors)
+ * Copyright (C) 2010-2019  (see AUTHORS file for a list of contributors)
  *
  * GNSS-SDR is a software defined Global Navigation
  *          Satellite Systems receiver
@@ -32,8 +32,10 @@
 #include "channel.h"
 #include "configuration_interface.h"
 #include "gnss_sdr_flags.h"
+#include "telemetry_symbol_processor.h"
 #include <glog/logging.h>
 #include <cstdint>
+#include <utility>
 
 using google::LogMessage;
 
@@ -98,6 +100,24 @@ Channel::Channel(ConfigurationInterface* configuration, uint32_t channel, std::s
 
     connected_ = false;
 
+    // Optionally, the tracking block runs the telemetry decoder on each symbol, saving a block and a buffer per channel
+    fused_ = false;
+    if (configuration->property("Channel.fuse_telemetry", false))
+        {
+            auto fused_trk = boost::dynamic_pointer_cast<TelemetryFusedTracking>(trk_->get_right_block());
+            auto decoder = boost::dynamic_pointer_cast<TelemetrySymbolProcessor>(nav_->get_left_block());
+            if (fused_trk and decoder)
+                {
+                    fused_trk->fuse_telemetry_decoder(nav_->get_left_block(), decoder.get());
+                    fused_ = true;
+                    DLOG(INFO) << "Channel " << channel_ << " decodes the telemetry in the tracking block";
+                }
+            else
+                {
+                    LOG(WARNING) << "Channel " << channel_ << ": the tracking block cannot run the telemetry decoder, keeping them apart";
+                }
+        }
+
     gnss_signal_ = Gnss_Signal(implementation_);
 
     channel_msg_rx = channel_msg_receiver_make_cc(channel_fsm_, repeat_);
@@ -115,8 +135,11 @@ void Channel::connect(gr::top_block_sptr top_block)
     nav_->connect(top_block);
 
     //Synchronous ports
-    top_block->connect(trk_->get_right_block(), 0, nav_->get_left_block(), 0);
-    DLOG(INFO) << "tracking -> telemetry_decoder";
+    if (!fused_)
+        {
+            top_block->connect(trk_->get_right_block(), 0, nav_->get_left_block(), 0);
+            DLOG(INFO) << "tracking -> telemetry_decoder";
+        }
 
     // Message ports
     top_block->msg_connect(acq_->get_right_block(), pmt::mp("events"), channel_msg_rx, pmt::mp("events"));
@@ -134,7 +157,10 @@ void Channel::disconnect(gr::top_block_sptr top_block)
             return;
         }
 
-    top_block->disconnect(trk_->get_right_block(), 0, nav_->get_left_block(), 0);
+    if (!fused_)
+        {
+            top_block->disconnect(trk_->get_right_block(), 0, nav_->get_left_block(), 0);
+        }
 
     acq_->disconnect(top_block);
     trk_->disconnect(top_block);
@@ -161,6 +187,10 @@ gr::basic_block_sptr Channel::get_left_block_acq()
 
 gr::basic_block_sptr Channel::get_right_block()
 {
+    if (fused_)
+        {
+            return trk_->get_right_block();
+        }
     return nav_->get_right_block();
 }
 
@@ -180,6 +210,20 @@ void Channel::set_signal(const Gnss_Signal& gnss_signal)
 }
 
 
+void Channel::set_doppler_aiding(double doppler_hz, double uncertainty_hz)
+{
+    std::lock_guard<std::mutex> lk(mx);
+    gnss_synchro_.Acq_doppler_aiding_hz = doppler_hz;
+    gnss_synchro_.Acq_doppler_uncertainty_hz = uncertainty_hz;
+}
+
+
+void Channel::set_event_queue(std::shared_ptr<concurrent_ring_queue<ControlMessage>> event_queue)
+{
+    channel_fsm_->set_event_queue(std::move(event_queue));
+}
+
+
 void Channel::stop_channel()
 {
     std::lock_guard<std::mutex> lk(mx);
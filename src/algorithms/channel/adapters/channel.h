@@ -9,7 +9,7 @@
  *
  * -------------------------------------------------------------------------
  *
- * Copyright (C) 2010-2018  (see AUTHORS file for a list of contributors)
+ * Copyright (C) 2010-2019  (see AUTHORS file for a list of contributors)
  *
  * GNSS-SDR is a software defined Global Navigation
  *          Satellite Systems receiver
@@ -78,9 +78,11 @@ public:
     inline std::string implementation() override { return implementation_; }
     inline size_t item_size() override { return 0; }
     inline Gnss_Signal get_signal() const override { return gnss_signal_; }
-    void start_acquisition() override;                          //!< Start the State Machine
-    void stop_channel() override;                               //!< Stop the State Machine
-    void set_signal(const Gnss_Signal& gnss_signal_) override;  //!< Sets the channel GNSS signal
+    void start_acquisition() override;                                           //!< Start the State Machine
+    void stop_channel() override;                                                //!< Stop the State Machine
+    void set_signal(const Gnss_Signal& gnss_signal_) override;                   //!< Sets the channel GNSS signal
+    void set_doppler_aiding(double doppler_hz, double uncertainty_hz) override;  //!< Sets the predicted Doppler of the next acquisition
+    void set_event_queue(std::shared_ptr<concurrent_ring_queue<ControlMessage>> event_queue) override;  //!< Sends the channel events through a lock-free queue
 
     inline std::shared_ptr<AcquisitionInterface> acquisition() { return acq_; }
     inline std::shared_ptr<TrackingInterface> tracking() { return trk_; }
@@ -99,6 +101,7 @@ private:
     Gnss_Synchro gnss_synchro_;
     Gnss_Signal gnss_signal_;
     bool connected_;
+    bool fused_;  // the telemetry decoder runs inside the tracking block
     bool repeat_;
     std::shared_ptr<ChannelFsm> channel_fsm_;
     gr::msg_queue::sptr queue_;
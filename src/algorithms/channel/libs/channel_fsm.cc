@@ -165,6 +165,13 @@ void ChannelFsm::set_queue(gr::msg_queue::sptr queue)
 }
 
 
+void ChannelFsm::set_event_queue(std::shared_ptr<concurrent_ring_queue<ControlMessage>> event_queue)
+{
+    std::lock_guard<std::mutex> lk(mx);
+    event_queue_ = std::move(event_queue);
+}
+
+
 void ChannelFsm::set_channel(uint32_t channel)
 {
     std::lock_guard<std::mutex> lk(mx);
@@ -192,29 +199,34 @@ void ChannelFsm::start_acquisition()
 void ChannelFsm::start_tracking()
 {
     trk_->start_tracking();
-    std::unique_ptr<ControlMessageFactory> cmf(new ControlMessageFactory());
-    if (queue_ != gr::msg_queue::make())
-        {
-            queue_->handle(cmf->GetQueueMessage(channel_, 1));
-        }
+    notify(1);
 }
 
 
 void ChannelFsm::request_satellite()
 {
-    std::unique_ptr<ControlMessageFactory> cmf(new ControlMessageFactory());
-    if (queue_ != gr::msg_queue::make())
-        {
-            queue_->handle(cmf->GetQueueMessage(channel_, 0));
-        }
+    notify(0);
 }
 
 
 void ChannelFsm::notify_stop_tracking()
 {
+    notify(2);
+}
+
+
+void ChannelFsm::notify(uint32_t what)
+{
+    ControlMessage event;
+    event.who = channel_;
+    event.what = what;
+    if ((event_queue_ != nullptr) and event_queue_->push(std::move(event)))
+        {
+            return;
+        }
     std::unique_ptr<ControlMessageFactory> cmf(new ControlMessageFactory());
     if (queue_ != gr::msg_queue::make())
         {
-            queue_->handle(cmf->GetQueueMessage(channel_, 2));
+            queue_->handle(cmf->GetQueueMessage(channel_, what));
         }
 }
@@ -33,6 +33,8 @@
 #define GNSS_SDR_CHANNEL_FSM_H
 
 #include "acquisition_interface.h"
+#include "concurrent_ring_queue.h"
+#include "control_message_factory.h"
 #include "telemetry_decoder_interface.h"
 #include "tracking_interface.h"
 #include <gnuradio/msg_queue.h>
@@ -53,6 +55,7 @@ public:
     void set_acquisition(std::shared_ptr<AcquisitionInterface> acquisition);
     void set_tracking(std::shared_ptr<TrackingInterface> tracking);
     void set_queue(gr::msg_queue::sptr queue);
+    void set_event_queue(std::shared_ptr<concurrent_ring_queue<ControlMessage>> event_queue);  //!< Lock-free path for the events, used instead of the message queue when set
     void set_channel(uint32_t channel);
 
     //FSM EVENTS
@@ -70,10 +73,12 @@ private:
     void stop_tracking();
     void request_satellite();
     void notify_stop_tracking();
+    void notify(uint32_t what);
 
     std::shared_ptr<AcquisitionInterface> acq_;
     std::shared_ptr<TrackingInterface> trk_;
     gr::msg_queue::sptr queue_;
+    std::shared_ptr<concurrent_ring_queue<ControlMessage>> event_queue_;
     uint32_t channel_;
     uint32_t d_state;
     std::mutex mx;
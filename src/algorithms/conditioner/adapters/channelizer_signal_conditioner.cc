@@ -0,0 +1,188 @@
+/*!
+ * \file channelizer_signal_conditioner.cc
+ * \brief Signal conditioner that splits a wideband input into several
+ * sub-bands with a polyphase filter bank channelizer
+ *
+ * -------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2019  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *          Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------
+ */
+
+#include "channelizer_signal_conditioner.h"
+#include "configuration_interface.h"
+#include <glog/logging.h>
+#include <gnuradio/blocks/file_sink.h>
+#include <gnuradio/blocks/null_sink.h>
+#include <gnuradio/filter/firdes.h>
+#include <cmath>
+#include <iostream>
+#include <limits>
+
+
+using google::LogMessage;
+
+ChannelizerSignalConditioner::ChannelizerSignalConditioner(ConfigurationInterface* configuration,
+    const std::string& role, unsigned int in_stream,
+    unsigned int out_stream) : role_(role), in_stream_(in_stream), out_stream_(out_stream)
+{
+    std::string default_item_type = "gr_complex";
+    std::string default_dump_file = "./data/signal_conditioner.dat";
+    double fs_in_deprecated, fs_in;
+    fs_in_deprecated = configuration->property("GNSS-SDR.internal_fs_hz", 2048000.0);
+    fs_in = configuration->property("GNSS-SDR.internal_fs_sps", fs_in_deprecated);
+    bins_ = configuration->property(role_ + ".bins", 4);
+    unsigned int oversample = configuration->property(role_ + ".oversample", 1);
+    if (bins_ < 2)
+        {
+            LOG(WARNING) << role_ << ".bins must be at least 2, using 2";
+            bins_ = 2;
+        }
+    if (oversample < 1 || bins_ % oversample != 0)
+        {
+            LOG(WARNING) << role_ << ".oversample must divide " << role_ << ".bins, using 1";
+            oversample = 1;
+        }
+    sample_freq_in_ = configuration->property(role_ + ".sample_freq_in", fs_in * bins_ / oversample);
+    double spacing = sample_freq_in_ / bins_;
+    double sample_freq_out = spacing * oversample;
+    if (std::fabs(fs_in - sample_freq_out) > std::numeric_limits<double>::epsilon())
+        {
+            std::string aux_warn = "CONFIGURATION WARNING: Parameter GNSS-SDR.internal_fs_sps is not set to " + role_ + ".sample_freq_in * " + role_ + ".oversample / " + role_ + ".bins!";
+            LOG(WARNING) << aux_warn;
+            std::cout << aux_warn << std::endl;
+        }
+    item_type_ = configuration->property(role_ + ".item_type", default_item_type);
+    if (item_type_ != "gr_complex")
+        {
+            LOG(WARNING) << item_type_ << " unrecognized item type for the channelizer, using gr_complex";
+            item_type_ = default_item_type;
+        }
+    dump_ = configuration->property(role_ + ".dump", false);
+    DLOG(INFO) << "dump_ is " << dump_;
+    dump_filename_ = configuration->property(role_ + ".dump_filename", default_dump_file);
+
+    // Every sub-band is a bin of the filter bank, so its centre is rounded to
+    // the nearest multiple of the bin spacing
+    sub_bands_ = configuration->property(role_ + ".sub_bands", 1);
+    for (unsigned int k = 0; k < sub_bands_; k++)
+        {
+            double freq = configuration->property(role_ + ".sub_band" + std::to_string(k) + "_freq", 0.0);
+            long bin = std::lround(freq / spacing);
+            if (std::fabs(freq - static_cast<double>(bin) * spacing) > 1.0)
+                {
+                    std::string aux_warn = "CONFIGURATION WARNING: " + role_ + ".sub_band" + std::to_string(k) + "_freq is not a multiple of " + role_ + ".sample_freq_in / " + role_ + ".bins, using " + std::to_string(static_cast<double>(bin) * spacing) + " Hz";
+                    LOG(WARNING) << aux_warn;
+                    std::cout << aux_warn << std::endl;
+                }
+            bin %= static_cast<long>(bins_);
+            if (bin < 0)
+                {
+                    bin += bins_;
+                }
+            channel_map_.push_back(static_cast<int>(bin));
+            DLOG(INFO) << "sub-band " << k << " at " << freq << " Hz is bin " << bin;
+        }
+
+    // Prototype filter at the input rate, with its stop band at the edge of the bin
+    double bandwidth = configuration->property(role_ + ".bandwidth", 0.8);
+    double attenuation_dB = configuration->property(role_ + ".attenuation_dB", 60.0);
+    std::vector<float> taps = gr::filter::firdes::low_pass_2(1.0, sample_freq_in_,
+        bandwidth * spacing / 2.0, (1.0 - bandwidth) * spacing / 2.0, attenuation_dB,
+        gr::filter::firdes::WIN_BLACKMAN_hARRIS);
+
+    stream_to_streams_ = gr::blocks::stream_to_streams::make(sizeof(gr_complex), bins_);
+    channelizer_ = gr::filter::pfb_channelizer_ccf::make(bins_, taps, static_cast<float>(oversample));
+    channelizer_->set_channel_map(channel_map_);
+    DLOG(INFO) << "stream_to_streams(" << stream_to_streams_->unique_id() << ")";
+    DLOG(INFO) << "channelizer(" << channelizer_->unique_id() << ") with " << taps.size() << " taps and " << bins_ << " bins";
+
+    // Sub-bands that no channel uses still need a consumer
+    for (unsigned int k = 0; k < sub_bands_; k++)
+        {
+            null_sinks_.push_back(gr::blocks::null_sink::make(sizeof(gr_complex)));
+            if (dump_)
+                {
+                    std::string filename = dump_filename_ + "_" + std::to_string(k);
+                    DLOG(INFO) << "Dumping sub-band " << k << " into file " << filename;
+                    file_sinks_.push_back(gr::blocks::file_sink::make(sizeof(gr_complex), filename.c_str()));
+                }
+        }
+    if (in_stream_ > 1)
+        {
+            LOG(ERROR) << "This implementation only supports one input stream";
+        }
+    if (out_stream_ > 1)
+        {
+            LOG(ERROR) << "This implementation delivers its sub-bands on the output ports of a single block";
+        }
+}
+
+
+ChannelizerSignalConditioner::~ChannelizerSignalConditioner() = default;
+
+
+void ChannelizerSignalConditioner::connect(gr::top_block_sptr top_block)
+{
+    for (unsigned int k = 0; k < bins_; k++)
+        {
+            top_block->connect(stream_to_streams_, k, channelizer_, k);
+        }
+    for (unsigned int k = 0; k < sub_bands_; k++)
+        {
+            top_block->connect(channelizer_, k, null_sinks_.at(k), 0);
+            if (dump_)
+                {
+                    top_block->connect(channelizer_, k, file_sinks_.at(k), 0);
+                }
+        }
+    DLOG(INFO) << "connected stream_to_streams to channelizer";
+}
+
+
+void ChannelizerSignalConditioner::disconnect(gr::top_block_sptr top_block)
+{
+    for (unsigned int k = 0; k < bins_; k++)
+        {
+            top_block->disconnect(stream_to_streams_, k, channelizer_, k);
+        }
+    for (unsigned int k = 0; k < sub_bands_; k++)
+        {
+            top_block->disconnect(channelizer_, k, null_sinks_.at(k), 0);
+            if (dump_)
+                {
+                    top_block->disconnect(channelizer_, k, file_sinks_.at(k), 0);
+                }
+        }
+}
+
+
+gr::basic_block_sptr ChannelizerSignalConditioner::get_left_block()
+{
+    return stream_to_streams_;
+}
+
+
+gr::basic_block_sptr ChannelizerSignalConditioner::get_right_block()
+{
+    return channelizer_;
+}
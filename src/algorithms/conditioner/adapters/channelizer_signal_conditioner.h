@@ -0,0 +1,90 @@
+/*!
+ * \file channelizer_signal_conditioner.h
+ * \brief Signal conditioner that splits a wideband input into several
+ * sub-bands with a polyphase filter bank channelizer
+ *
+ * -------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2019  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *          Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_CHANNELIZER_SIGNAL_CONDITIONER_H_
+#define GNSS_SDR_CHANNELIZER_SIGNAL_CONDITIONER_H_
+
+#include "gnss_block_interface.h"
+#include <gnuradio/blocks/stream_to_streams.h>
+#include <gnuradio/filter/pfb_channelizer_ccf.h>
+#include <string>
+#include <vector>
+
+class ConfigurationInterface;
+
+/*!
+ * \brief Splits a wideband gr_complex stream into sub-bands in a single
+ * polyphase filter bank and FFT pass, instead of one full-rate
+ * freq_xlating_fir_filter per signal.
+ *
+ * The input band is divided into "bins" channels spaced sample_freq_in / bins,
+ * and output port k of get_right_block() delivers the bin nearest to
+ * sub_band<k>_freq at sample_freq_in * oversample / bins. GNSSFlowgraph
+ * connects each channel to the port whose sub_band<k>_signal matches the
+ * channel signal, or to Channel<i>.sub_band if that is set.
+ */
+class ChannelizerSignalConditioner : public GNSSBlockInterface
+{
+public:
+    ChannelizerSignalConditioner(ConfigurationInterface* configuration,
+        const std::string& role, unsigned int in_stream,
+        unsigned int out_stream);
+
+    virtual ~ChannelizerSignalConditioner();
+
+    inline std::string role() override { return role_; }
+
+    inline std::string implementation() override { return "Channelizer_Signal_Conditioner"; }  //!< Returns "Channelizer_Signal_Conditioner"
+
+    inline size_t item_size() override { return sizeof(gr_complex); }
+
+    void connect(gr::top_block_sptr top_block) override;
+    void disconnect(gr::top_block_sptr top_block) override;
+    gr::basic_block_sptr get_left_block() override;
+    gr::basic_block_sptr get_right_block() override;
+
+private:
+    std::string role_;
+    unsigned int in_stream_;
+    unsigned int out_stream_;
+    std::string item_type_;
+    bool dump_;
+    std::string dump_filename_;
+    double sample_freq_in_;
+    unsigned int bins_;
+    unsigned int sub_bands_;
+    std::vector<int> channel_map_;
+    gr::blocks::stream_to_streams::sptr stream_to_streams_;
+    gr::filter::pfb_channelizer_ccf::sptr channelizer_;
+    std::vector<gr::block_sptr> null_sinks_;
+    std::vector<gr::block_sptr> file_sinks_;
+};
+
+#endif /*GNSS_SDR_CHANNELIZER_SIGNAL_CONDITIONER_H_*/
@@ -0,0 +1,147 @@
+/*!
+ * \file fused_signal_conditioner.cc
+ * \brief Signal conditioner that does the work of the data type adapter,
+ * the input filter and the resampler in a single block
+ *
+ * -------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2019  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *          Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------
+ */
+
+#include "fused_signal_conditioner.h"
+#include "configuration_interface.h"
+#include "fused_conditioner.h"
+#include "polyphase_filter_bank.h"
+#include <glog/logging.h>
+#include <gnuradio/blocks/file_sink.h>
+#include <cmath>
+#include <iostream>
+#include <limits>
+
+
+using google::LogMessage;
+
+FusedSignalConditioner::FusedSignalConditioner(ConfigurationInterface* configuration,
+    const std::string& role, unsigned int in_stream,
+    unsigned int out_stream) : role_(role), in_stream_(in_stream), out_stream_(out_stream)
+{
+    std::string default_item_type = "gr_complex";
+    std::string default_dump_file = "./data/signal_conditioner.dat";
+    std::string default_quality = "balanced";
+    double fs_in_deprecated, fs_in;
+    fs_in_deprecated = configuration->property("GNSS-SDR.internal_fs_hz", 2048000.0);
+    fs_in = configuration->property("GNSS-SDR.internal_fs_sps", fs_in_deprecated);
+    sample_freq_in_ = configuration->property(role_ + ".sample_freq_in", fs_in);
+    sample_freq_out_ = configuration->property(role_ + ".sample_freq_out", fs_in);
+    if (std::fabs(fs_in - sample_freq_out_) > std::numeric_limits<double>::epsilon())
+        {
+            std::string aux_warn = "CONFIGURATION WARNING: Parameters GNSS-SDR.internal_fs_sps and " + role_ + ".sample_freq_out are not set to the same value!";
+            LOG(WARNING) << aux_warn;
+            std::cout << aux_warn << std::endl;
+        }
+    intermediate_freq_ = configuration->property(role_ + ".IF", 0.0);
+    item_type_ = configuration->property(role_ + ".item_type", default_item_type);
+    dump_ = configuration->property(role_ + ".dump", false);
+    DLOG(INFO) << "dump_ is " << dump_;
+    dump_filename_ = configuration->property(role_ + ".dump_filename", default_dump_file);
+
+    std::string quality = configuration->property(role_ + ".quality", default_quality);
+    uint32_t default_taps_per_phase;
+    uint32_t default_phases;
+    double default_bandwidth;
+    if (!PolyphaseFilterBank::preset(quality, default_taps_per_phase, default_phases, default_bandwidth))
+        {
+            LOG(WARNING) << quality << " unrecognized quality for " << role_ << ", using balanced";
+        }
+    uint32_t taps_per_phase = configuration->property(role_ + ".taps_per_phase", default_taps_per_phase);
+    uint32_t phases = configuration->property(role_ + ".phases", default_phases);
+    double bandwidth = configuration->property(role_ + ".bandwidth", default_bandwidth);
+
+    if (item_type_ != "gr_complex" && item_type_ != "cshort" && item_type_ != "ishort" && item_type_ != "cbyte" && item_type_ != "ibyte")
+        {
+            LOG(WARNING) << item_type_ << " unrecognized item type for the signal conditioner, using gr_complex";
+            item_type_ = default_item_type;
+        }
+    fused_conditioner_sptr conditioner = make_fused_conditioner(item_type_, sample_freq_in_, sample_freq_out_,
+        intermediate_freq_, taps_per_phase, phases, bandwidth);
+    DLOG(INFO) << "Conditioner taps " << conditioner->bank().taps() << ", phases " << conditioner->bank().phases()
+               << ", stopband " << conditioner->bank().stopband_attenuation_db() << " dB";
+    conditioner_ = conditioner;
+    DLOG(INFO) << "sample_freq_in " << sample_freq_in_;
+    DLOG(INFO) << "sample_freq_out " << sample_freq_out_;
+    DLOG(INFO) << "IF " << intermediate_freq_;
+    DLOG(INFO) << "conditioner(" << conditioner_->unique_id() << ")";
+
+    if (dump_)
+        {
+            DLOG(INFO) << "Dumping output into file " << dump_filename_;
+            file_sink_ = gr::blocks::file_sink::make(sizeof(gr_complex), dump_filename_.c_str());
+            DLOG(INFO) << "file_sink(" << file_sink_->unique_id() << ")";
+        }
+    if (in_stream_ > 1)
+        {
+            LOG(ERROR) << "This implementation only supports one input stream";
+        }
+    if (out_stream_ > 1)
+        {
+            LOG(ERROR) << "This implementation only supports one output stream";
+        }
+}
+
+
+FusedSignalConditioner::~FusedSignalConditioner() = default;
+
+
+void FusedSignalConditioner::connect(gr::top_block_sptr top_block)
+{
+    if (dump_)
+        {
+            top_block->connect(conditioner_, 0, file_sink_, 0);
+            DLOG(INFO) << "connected conditioner to file sink";
+        }
+    else
+        {
+            DLOG(INFO) << "nothing to connect internally";
+        }
+}
+
+
+void FusedSignalConditioner::disconnect(gr::top_block_sptr top_block)
+{
+    if (dump_)
+        {
+            top_block->disconnect(conditioner_, 0, file_sink_, 0);
+        }
+}
+
+
+gr::basic_block_sptr FusedSignalConditioner::get_left_block()
+{
+    return conditioner_;
+}
+
+
+gr::basic_block_sptr FusedSignalConditioner::get_right_block()
+{
+    return conditioner_;
+}
@@ -0,0 +1,85 @@
+/*!
+ * \file fused_signal_conditioner.h
+ * \brief Signal conditioner that does the work of the data type adapter,
+ * the input filter and the resampler in a single block
+ *
+ * -------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2019  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *          Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_FUSED_SIGNAL_CONDITIONER_H_
+#define GNSS_SDR_FUSED_SIGNAL_CONDITIONER_H_
+
+#include "gnss_block_interface.h"
+#include <gnuradio/block.h>
+#include <cstdint>
+#include <string>
+
+class ConfigurationInterface;
+
+/*!
+ * \brief Converts the input to gr_complex, moves it from IF to baseband,
+ * low pass filters it and resamples it in one GNU Radio block, instead of
+ * the three blocks chained by SignalConditioner.
+ *
+ * It takes its parameters from its own role (e.g. SignalConditioner.IF),
+ * and ignores the DataTypeAdapter, InputFilter and Resampler sections.
+ * The filter is the one of Polyphase_Resampler, with the same quality
+ * presets.
+ */
+class FusedSignalConditioner : public GNSSBlockInterface
+{
+public:
+    FusedSignalConditioner(ConfigurationInterface* configuration,
+        const std::string& role, unsigned int in_stream,
+        unsigned int out_stream);
+
+    virtual ~FusedSignalConditioner();
+
+    inline std::string role() override { return role_; }
+
+    inline std::string implementation() override { return "Fused_Signal_Conditioner"; }  //!< Returns "Fused_Signal_Conditioner"
+
+    inline size_t item_size() override { return sizeof(gr_complex); }
+
+    void connect(gr::top_block_sptr top_block) override;
+    void disconnect(gr::top_block_sptr top_block) override;
+    gr::basic_block_sptr get_left_block() override;
+    gr::basic_block_sptr get_right_block() override;
+
+private:
+    std::string role_;
+    unsigned int in_stream_;
+    unsigned int out_stream_;
+    std::string item_type_;
+    bool dump_;
+    std::string dump_filename_;
+    double sample_freq_in_;
+    double sample_freq_out_;
+    double intermediate_freq_;
+    gr::block_sptr conditioner_;
+    gr::block_sptr file_sink_;
+};
+
+#endif /*GNSS_SDR_FUSED_SIGNAL_CONDITIONER_H_*/
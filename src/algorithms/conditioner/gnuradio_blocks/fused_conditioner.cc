@@ -0,0 +1,173 @@
+/*!
+ * \file fused_conditioner.cc
+ * \brief Signal conditioner that converts, translates, filters and
+ * resamples the input samples in a single block
+ *
+ * -------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2019  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *          Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------
+ */
+
+#include "fused_conditioner.h"
+#include <gnuradio/io_signature.h>
+#include <volk/volk.h>
+#include <volk_gnsssdr/volk_gnsssdr.h>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <stdexcept>
+
+// Input samples converted at once: 32 KB of gr_complex, which stays in the L1
+// or L2 cache while it is filtered
+const int TILE_SAMPLES = 4096;
+
+fused_conditioner_sptr make_fused_conditioner(const std::string &item_type,
+    double sample_freq_in, double sample_freq_out, double intermediate_freq,
+    uint32_t taps_per_phase, uint32_t phases, double bandwidth)
+{
+    size_t item_size;
+    if (item_type == "gr_complex")
+        {
+            item_size = sizeof(gr_complex);
+        }
+    else if (item_type == "cshort" || item_type == "ishort")
+        {
+            item_size = sizeof(lv_16sc_t);
+        }
+    else if (item_type == "cbyte" || item_type == "ibyte")
+        {
+            item_size = sizeof(lv_8sc_t);
+        }
+    else
+        {
+            throw std::invalid_argument("fused_conditioner: unsupported item type " + item_type);
+        }
+    return fused_conditioner_sptr(new fused_conditioner(item_size, sample_freq_in, sample_freq_out,
+        intermediate_freq, taps_per_phase, phases, bandwidth));
+}
+
+
+fused_conditioner::fused_conditioner(size_t item_size,
+    double sample_freq_in, double sample_freq_out, double intermediate_freq,
+    uint32_t taps_per_phase, uint32_t phases, double bandwidth) : gr::block("fused_conditioner",
+                                                                      gr::io_signature::make(1, 1, item_size),
+                                                                      gr::io_signature::make(1, 1, sizeof(gr_complex))),
+                                                                  d_item_size(item_size),
+                                                                  d_bank(sample_freq_in, sample_freq_out, taps_per_phase, phases, bandwidth),
+                                                                  d_position(0),
+                                                                  d_fill(0)
+{
+    d_translate = std::fabs(intermediate_freq) > 0.0;
+    d_phase_inc = std::exp(gr_complex(0.0, static_cast<float>(-2.0 * M_PI * intermediate_freq / sample_freq_in)));
+    d_phase = gr_complex(1.0, 0.0);
+    d_step = static_cast<uint64_t>(std::llround(4294967296.0 * sample_freq_in / sample_freq_out));
+    d_buffer.resize(TILE_SAMPLES + d_bank.taps());
+    set_relative_rate(sample_freq_out / sample_freq_in);
+}
+
+
+fused_conditioner::~fused_conditioner() = default;
+
+
+void fused_conditioner::forecast(int noutput_items,
+    gr_vector_int &ninput_items_required)
+{
+    const uint64_t needed = ((d_position + static_cast<uint64_t>(noutput_items) * d_step) >> 32) + d_bank.taps();
+    ninput_items_required[0] = (needed > d_fill) ? static_cast<int>(needed - d_fill) : 0;
+}
+
+
+void fused_conditioner::convert_tile(const void *in, gr_complex *out, int samples)
+{
+    if (d_item_size == sizeof(gr_complex))
+        {
+            std::memcpy(out, in, samples * sizeof(gr_complex));
+        }
+    else if (d_item_size == sizeof(lv_16sc_t))
+        {
+            volk_gnsssdr_16ic_convert_32fc(out, static_cast<const lv_16sc_t *>(in), samples);
+        }
+    else
+        {
+            volk_gnsssdr_8ic_deinterleave_32fc_xn(&out, static_cast<const lv_8sc_t *>(in), 0, 1, samples);
+        }
+    if (d_translate)
+        {
+            volk_32fc_s32fc_x2_rotator_32fc(out, out, d_phase_inc, &d_phase, samples);
+        }
+}
+
+
+int fused_conditioner::general_work(int noutput_items,
+    gr_vector_int &ninput_items, gr_vector_const_void_star &input_items,
+    gr_vector_void_star &output_items)
+{
+    const auto *in = static_cast<const uint8_t *>(input_items[0]);
+    auto *out = reinterpret_cast<gr_complex *>(output_items[0]);
+    const uint32_t taps = d_bank.taps();
+    const uint32_t shift = 32 - d_bank.phase_bits();
+    const uint64_t round_half = (static_cast<uint64_t>(1) << shift) >> 1;
+
+    int produced = 0;
+    int consumed = 0;
+    while (produced < noutput_items)
+        {
+            // Filter and resample what the buffer holds
+            while (produced < noutput_items)
+                {
+                    const uint64_t index = d_position >> 32;
+                    if (index + taps > d_fill)
+                        {
+                            break;
+                        }
+                    const auto phase = static_cast<uint32_t>(((d_position & 0xFFFFFFFF) + round_half) >> shift);
+                    volk_32fc_32f_dot_prod_32fc(&out[produced], d_buffer.data() + index, d_bank.branch(phase), taps);
+                    d_position += d_step;
+                    produced++;
+                }
+            if (produced == noutput_items)
+                {
+                    break;
+                }
+
+            // Keep only the filter history and bring in the next tile
+            const uint64_t index = std::min(d_position >> 32, d_fill);
+            if (index > 0)
+                {
+                    std::memmove(d_buffer.data(), d_buffer.data() + index, (d_fill - index) * sizeof(gr_complex));
+                    d_fill -= index;
+                    d_position -= index << 32;
+                }
+            const int samples = std::min(ninput_items[0] - consumed, TILE_SAMPLES);
+            if (samples <= 0)
+                {
+                    break;
+                }
+            convert_tile(in + consumed * d_item_size, d_buffer.data() + d_fill, samples);
+            d_fill += samples;
+            consumed += samples;
+        }
+
+    consume_each(consumed);
+    return produced;
+}
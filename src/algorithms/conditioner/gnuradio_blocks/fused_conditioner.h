@@ -0,0 +1,91 @@
+/*!
+ * \file fused_conditioner.h
+ * \brief Signal conditioner that converts, translates, filters and
+ * resamples the input samples in a single block
+ *
+ * The input is processed in tiles small enough to stay in cache. Each tile
+ * is converted to gr_complex, moved from the intermediate frequency to
+ * baseband, and then filtered and resampled with a polyphase filter bank,
+ * so the full-rate signal is only read once from memory.
+ *
+ * -------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2019  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *          Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_FUSED_CONDITIONER_H_
+#define GNSS_SDR_FUSED_CONDITIONER_H_
+
+#include "polyphase_filter_bank.h"
+#include <gnuradio/block.h>
+#include <gnuradio/gr_complex.h>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+class fused_conditioner;
+typedef boost::shared_ptr<fused_conditioner> fused_conditioner_sptr;
+
+/*!
+ * \brief Makes a fused conditioner. item_type is the input type: gr_complex,
+ * cshort (or ishort) or cbyte (or ibyte). The output is always gr_complex.
+ */
+fused_conditioner_sptr make_fused_conditioner(const std::string &item_type,
+    double sample_freq_in, double sample_freq_out, double intermediate_freq,
+    uint32_t taps_per_phase, uint32_t phases, double bandwidth);
+
+class fused_conditioner : public gr::block
+{
+private:
+    friend fused_conditioner_sptr make_fused_conditioner(const std::string &item_type,
+        double sample_freq_in, double sample_freq_out, double intermediate_freq,
+        uint32_t taps_per_phase, uint32_t phases, double bandwidth);
+    fused_conditioner(size_t item_size,
+        double sample_freq_in, double sample_freq_out, double intermediate_freq,
+        uint32_t taps_per_phase, uint32_t phases, double bandwidth);
+
+    void convert_tile(const void *in, gr_complex *out, int samples);
+
+    size_t d_item_size;
+    PolyphaseFilterBank d_bank;
+    bool d_translate;
+    gr_complex d_phase_inc;
+    gr_complex d_phase;
+    uint64_t d_step;      // Input samples per output sample, 32.32 fixed point
+    uint64_t d_position;  // Position of the next output sample in d_buffer, 32.32 fixed point
+    std::vector<gr_complex> d_buffer;
+    uint64_t d_fill;  // Converted samples held in d_buffer
+
+public:
+    ~fused_conditioner();
+
+    inline const PolyphaseFilterBank &bank() const { return d_bank; }
+
+    void forecast(int noutput_items, gr_vector_int &ninput_items_required);
+
+    int general_work(int noutput_items, gr_vector_int &ninput_items,
+        gr_vector_const_void_star &input_items,
+        gr_vector_void_star &output_items);
+};
+
+#endif  // GNSS_SDR_FUSED_CONDITIONER_H_
@@ -32,6 +32,7 @@
 #include "interleaved_byte_to_complex_byte.h"
 #include <gnuradio/io_signature.h>
 #include <volk/volk.h>
+#include <cstring>
 
 
 interleaved_byte_to_complex_byte_sptr make_interleaved_byte_to_complex_byte()
@@ -56,15 +57,7 @@ int interleaved_byte_to_complex_byte::work(int noutput_items,
 {
     const auto *in = reinterpret_cast<const int8_t *>(input_items[0]);
     auto *out = reinterpret_cast<lv_8sc_t *>(output_items[0]);
-    // This could be put into a Volk kernel
-    int8_t real_part;
-    int8_t imag_part;
-    for (int number = 0; number < noutput_items; number++)
-        {
-            // lv_cmake(r, i) defined at volk/volk_complex.h
-            real_part = *in++;
-            imag_part = *in++;
-            *out++ = lv_cmake(real_part, imag_part);
-        }
+    // std::complex<signed char> has the layout of the interleaved bytes
+    std::memcpy(out, in, noutput_items * sizeof(lv_8sc_t));
     return noutput_items;
 }
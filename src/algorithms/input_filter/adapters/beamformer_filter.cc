@@ -33,6 +33,7 @@
 #include "configuration_interface.h"
 #include <glog/logging.h>
 #include <gnuradio/blocks/file_sink.h>
+#include <cstdint>
 
 
 using google::LogMessage;
@@ -47,11 +48,20 @@ BeamformerFilter::BeamformerFilter(
     dump_ = configuration->property(role + ".dump", false);
     DLOG(INFO) << "dump_ is " << dump_;
     dump_filename_ = configuration->property(role + ".dump_filename", default_dump_file);
+    channels_ = configuration->property(role + ".channels", 8);
+    bool adaptive = configuration->property(role + ".adaptive", false);
+    uint64_t adapt_period = 0;
+    if (adaptive)
+        {
+            adapt_period = configuration->property(role + ".adapt_period", static_cast<uint64_t>(4000000));
+        }
+    int32_t snapshot_samples = configuration->property(role + ".snapshot_samples", 8192);
+    int32_t reference_element = configuration->property(role + ".reference_element", 0);
 
     if (item_type_ == "gr_complex")
         {
             item_size_ = sizeof(gr_complex);
-            beamformer_ = make_beamformer();
+            beamformer_ = make_beamformer(channels_, adapt_period, snapshot_samples, reference_element);
             DLOG(INFO) << "Item size " << item_size_;
             DLOG(INFO) << "resampler(" << beamformer_->unique_id() << ")";
         }
@@ -68,9 +78,10 @@ BeamformerFilter::BeamformerFilter(
             DLOG(INFO) << "file_sink(" << file_sink_->unique_id() << ")";
         }
     samples_ = 0;
-    if (in_stream_ > 8)
+    DLOG(INFO) << "Array elements " << channels_ << (adaptive ? ", adaptive weights" : "");
+    if (in_stream_ > static_cast<unsigned int>(channels_))
         {
-            LOG(ERROR) << "This implementation only supports eight input streams";
+            LOG(ERROR) << "This implementation only supports " << channels_ << " input streams";
         }
     if (out_stream_ > 1)
         {
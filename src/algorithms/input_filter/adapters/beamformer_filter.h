@@ -78,6 +78,7 @@ private:
     unsigned int out_stream_;
     std::string item_type_;
     size_t item_size_;
+    int channels_;
     unsigned long long samples_;
     bool dump_;
     std::string dump_filename_;
@@ -47,7 +47,14 @@ FirFilter::FirFilter(ConfigurationInterface* configuration, std::string role,
     if ((taps_item_type_ == "float") && (input_item_type_ == "gr_complex") && (output_item_type_ == "gr_complex"))
         {
             item_size = sizeof(gr_complex);
-            fir_filter_ccf_ = gr::filter::fir_filter_ccf::make(1, taps_);
+            if (use_fft_)
+                {
+                    fir_filter_ccf_ = gr::filter::fft_filter_ccf::make(1, taps_);
+                }
+            else
+                {
+                    fir_filter_ccf_ = gr::filter::fir_filter_ccf::make(1, taps_);
+                }
             DLOG(INFO) << "input_filter(" << fir_filter_ccf_->unique_id() << ")";
             if (dump_)
                 {
@@ -59,8 +66,7 @@ FirFilter::FirFilter(ConfigurationInterface* configuration, std::string role,
         {
             item_size = sizeof(lv_16sc_t);
             cshort_to_float_x2_ = make_cshort_to_float_x2();
-            fir_filter_fff_1_ = gr::filter::fir_filter_fff::make(1, taps_);
-            fir_filter_fff_2_ = gr::filter::fir_filter_fff::make(1, taps_);
+            make_fff_filters();
             DLOG(INFO) << "I input_filter(" << fir_filter_fff_1_->unique_id() << ")";
             DLOG(INFO) << "Q input_filter(" << fir_filter_fff_2_->unique_id() << ")";
             float_to_short_1_ = gr::blocks::float_to_short::make();
@@ -76,8 +82,7 @@ FirFilter::FirFilter(ConfigurationInterface* configuration, std::string role,
         {
             item_size = sizeof(gr_complex);
             cshort_to_float_x2_ = make_cshort_to_float_x2();
-            fir_filter_fff_1_ = gr::filter::fir_filter_fff::make(1, taps_);
-            fir_filter_fff_2_ = gr::filter::fir_filter_fff::make(1, taps_);
+            make_fff_filters();
             DLOG(INFO) << "I input_filter(" << fir_filter_fff_1_->unique_id() << ")";
             DLOG(INFO) << "Q input_filter(" << fir_filter_fff_2_->unique_id() << ")";
             float_to_complex_ = gr::blocks::float_to_complex::make();
@@ -93,8 +98,7 @@ FirFilter::FirFilter(ConfigurationInterface* configuration, std::string role,
             item_size = sizeof(gr_complex);
             cbyte_to_float_x2_ = make_complex_byte_to_float_x2();
 
-            fir_filter_fff_1_ = gr::filter::fir_filter_fff::make(1, taps_);
-            fir_filter_fff_2_ = gr::filter::fir_filter_fff::make(1, taps_);
+            make_fff_filters();
             DLOG(INFO) << "I input_filter(" << fir_filter_fff_1_->unique_id() << ")";
             DLOG(INFO) << "Q input_filter(" << fir_filter_fff_2_->unique_id() << ")";
 
@@ -111,8 +115,7 @@ FirFilter::FirFilter(ConfigurationInterface* configuration, std::string role,
             item_size = sizeof(lv_8sc_t);
             cbyte_to_float_x2_ = make_complex_byte_to_float_x2();
 
-            fir_filter_fff_1_ = gr::filter::fir_filter_fff::make(1, taps_);
-            fir_filter_fff_2_ = gr::filter::fir_filter_fff::make(1, taps_);
+            make_fff_filters();
             DLOG(INFO) << "I input_filter(" << fir_filter_fff_1_->unique_id() << ")";
             DLOG(INFO) << "Q input_filter(" << fir_filter_fff_2_->unique_id() << ")";
 
@@ -402,4 +405,26 @@ void FirFilter::init()
         {
             taps_.push_back(float(it));
         }
+
+    // Long filters are cheaper in the frequency domain (overlap-save), which
+    // costs O(log(taps)) per sample instead of O(taps)
+    int default_fft_threshold = 128;
+    int fft_threshold = config_->property(role_ + ".fft_threshold", default_fft_threshold);
+    use_fft_ = (fft_threshold > 0) && (static_cast<int>(taps_.size()) >= fft_threshold);
+    DLOG(INFO) << taps_.size() << " taps, " << (use_fft_ ? "FFT" : "time domain") << " filtering";
+}
+
+
+void FirFilter::make_fff_filters()
+{
+    if (use_fft_)
+        {
+            fir_filter_fff_1_ = gr::filter::fft_filter_fff::make(1, taps_);
+            fir_filter_fff_2_ = gr::filter::fft_filter_fff::make(1, taps_);
+        }
+    else
+        {
+            fir_filter_fff_1_ = gr::filter::fir_filter_fff::make(1, taps_);
+            fir_filter_fff_2_ = gr::filter::fir_filter_fff::make(1, taps_);
+        }
 }
@@ -49,6 +49,8 @@
 #include <gnuradio/filter/fir_filter_ccf.h>
 #include <gnuradio/filter/fir_filter_fff.h>
 #endif
+#include <gnuradio/filter/fft_filter_ccf.h>
+#include <gnuradio/filter/fft_filter_fff.h>
 #include <cmath>
 #include <string>
 #include <vector>
@@ -97,7 +99,7 @@ public:
     gr::basic_block_sptr get_right_block() override;
 
 private:
-    gr::filter::fir_filter_ccf::sptr fir_filter_ccf_;
+    gr::block_sptr fir_filter_ccf_;  // time domain or FFT filter, see use_fft_
     ConfigurationInterface* config_;
     bool dump_;
     std::string dump_filename_;
@@ -105,14 +107,16 @@ private:
     std::string output_item_type_;
     std::string taps_item_type_;
     std::vector<float> taps_;
+    bool use_fft_;
     std::string role_;
     unsigned int in_streams_;
     unsigned int out_streams_;
     gr::blocks::file_sink::sptr file_sink_;
     void init();
+    void make_fff_filters();
     complex_byte_to_float_x2_sptr cbyte_to_float_x2_;
-    gr::filter::fir_filter_fff::sptr fir_filter_fff_1_;
-    gr::filter::fir_filter_fff::sptr fir_filter_fff_2_;
+    gr::block_sptr fir_filter_fff_1_;
+    gr::block_sptr fir_filter_fff_2_;
     gr::blocks::float_to_char::sptr float_to_char_1_;
     gr::blocks::float_to_char::sptr float_to_char_2_;
     byte_x2_to_complex_byte_sptr char_x2_cbyte_;
@@ -36,6 +36,7 @@
 #include <gnuradio/filter/firdes.h>
 #include <gnuradio/filter/pm_remez.h>
 #include <volk/volk.h>
+#include <cmath>
 #include <utility>
 
 using google::LogMessage;
@@ -121,14 +122,42 @@ FreqXlatingFirFilter::FreqXlatingFirFilter(ConfigurationInterface* configuration
             taps_ = gr::filter::firdes::low_pass(1.0, sampling_freq_, bw_, tw_);
         }
 
+    // Long filters are cheaper in the frequency domain (overlap-save), which
+    // costs O(log(taps)) per sample instead of O(taps)
+    int default_fft_threshold = 128;
+    int fft_threshold = config_->property(role_ + ".fft_threshold", default_fft_threshold);
+    use_fft_ = (fft_threshold > 0) && (static_cast<int>(taps_.size()) >= fft_threshold);
+    DLOG(INFO) << taps_.size() << " taps, " << (use_fft_ ? "FFT" : "time domain") << " filtering";
+
     size_t item_size;
 
     if ((taps_item_type_ == "float") && (input_item_type_ == "gr_complex") && (output_item_type_ == "gr_complex"))
         {
             item_size = sizeof(gr_complex);    //output
             input_size_ = sizeof(gr_complex);  //input
-            freq_xlating_fir_filter_ccf_ = gr::filter::freq_xlating_fir_filter_ccf::make(decimation_factor_, taps_, intermediate_freq_, sampling_freq_);
-            DLOG(INFO) << "input_filter(" << freq_xlating_fir_filter_ccf_->unique_id() << ")";
+            if (use_fft_)
+                {
+                    // Same operation as freq_xlating_fir_filter_ccf: the taps are moved
+                    // to the IF band, and the output is brought to baseband at the
+                    // decimated rate
+                    std::vector<gr_complex> bandpass_taps(taps_.size());
+                    const double w = 2.0 * M_PI * intermediate_freq_ / sampling_freq_;
+                    for (size_t k = 0; k < taps_.size(); k++)
+                        {
+                            bandpass_taps[k] = taps_[k] * gr_complex(std::cos(w * k), std::sin(w * k));
+                        }
+                    fft_filter_ccc_ = gr::filter::fft_filter_ccc::make(decimation_factor_, bandpass_taps);
+                    DLOG(INFO) << "input_filter(" << fft_filter_ccc_->unique_id() << ")";
+                    if (std::abs(intermediate_freq_) > 0.0)
+                        {
+                            rotator_ = gr::blocks::rotator_cc::make(-w * decimation_factor_);
+                        }
+                }
+            else
+                {
+                    freq_xlating_fir_filter_ccf_ = gr::filter::freq_xlating_fir_filter_ccf::make(decimation_factor_, taps_, intermediate_freq_, sampling_freq_);
+                    DLOG(INFO) << "input_filter(" << freq_xlating_fir_filter_ccf_->unique_id() << ")";
+                }
         }
     else if ((taps_item_type_ == "float") && (input_item_type_ == "float") && (output_item_type_ == "gr_complex"))
         {
@@ -203,9 +232,13 @@ void FreqXlatingFirFilter::connect(gr::top_block_sptr top_block)
 {
     if ((taps_item_type_ == "float") && (input_item_type_ == "gr_complex") && (output_item_type_ == "gr_complex"))
         {
+            if (rotator_)
+                {
+                    top_block->connect(fft_filter_ccc_, 0, rotator_, 0);
+                }
             if (dump_)
                 {
-                    top_block->connect(freq_xlating_fir_filter_ccf_, 0, file_sink_, 0);
+                    top_block->connect(get_right_block(), 0, file_sink_, 0);
                 }
         }
     else if ((taps_item_type_ == "float") && (input_item_type_ == "float") && (output_item_type_ == "gr_complex"))
@@ -262,9 +295,13 @@ void FreqXlatingFirFilter::disconnect(gr::top_block_sptr top_block)
 {
     if ((taps_item_type_ == "float") && (input_item_type_ == "gr_complex") && (output_item_type_ == "gr_complex"))
         {
+            if (rotator_)
+                {
+                    top_block->disconnect(fft_filter_ccc_, 0, rotator_, 0);
+                }
             if (dump_)
                 {
-                    top_block->disconnect(freq_xlating_fir_filter_ccf_, 0, file_sink_, 0);
+                    top_block->disconnect(get_right_block(), 0, file_sink_, 0);
                 }
         }
     else if ((taps_item_type_ == "float") && (input_item_type_ == "float") && (output_item_type_ == "gr_complex"))
@@ -321,6 +358,10 @@ gr::basic_block_sptr FreqXlatingFirFilter::get_left_block()
 {
     if ((taps_item_type_ == "float") && (input_item_type_ == "gr_complex") && (output_item_type_ == "gr_complex"))
         {
+            if (use_fft_)
+                {
+                    return fft_filter_ccc_;
+                }
             return freq_xlating_fir_filter_ccf_;
         }
     if ((taps_item_type_ == "float") && (input_item_type_ == "float") && (output_item_type_ == "gr_complex"))
@@ -355,6 +396,14 @@ gr::basic_block_sptr FreqXlatingFirFilter::get_right_block()
 {
     if ((taps_item_type_ == "float") && (input_item_type_ == "gr_complex") && (output_item_type_ == "gr_complex"))
         {
+            if (rotator_)
+                {
+                    return rotator_;
+                }
+            if (use_fft_)
+                {
+                    return fft_filter_ccc_;
+                }
             return freq_xlating_fir_filter_ccf_;
         }
     if ((taps_item_type_ == "float") && (input_item_type_ == "float") && (output_item_type_ == "gr_complex"))
@@ -47,6 +47,8 @@
 #include <gnuradio/blocks/complex_to_float.h>
 #include <gnuradio/blocks/file_sink.h>
 #include <gnuradio/blocks/float_to_short.h>
+#include <gnuradio/blocks/rotator_cc.h>
+#include <gnuradio/filter/fft_filter_ccc.h>
 #include <string>
 #include <vector>
 
@@ -63,6 +65,10 @@ class ConfigurationInterface;
  * Calculates the optimal (in the Chebyshev/minimax sense) FIR filter impulse response
  * given a set of band edges, the desired response on those bands, and the weight given
  * to the error in those bands.
+ *
+ * For gr_complex input and output, filters with fft_threshold taps or more
+ * are run in the frequency domain instead (overlap-save), with the
+ * translation moved into the taps and a rotator at the output rate.
  */
 class FreqXlatingFirFilter : public GNSSBlockInterface
 {
@@ -98,6 +104,9 @@ private:
     gr::filter::freq_xlating_fir_filter_ccf::sptr freq_xlating_fir_filter_ccf_;
     gr::filter::freq_xlating_fir_filter_fcf::sptr freq_xlating_fir_filter_fcf_;
     gr::filter::freq_xlating_fir_filter_scf::sptr freq_xlating_fir_filter_scf_;
+    gr::filter::fft_filter_ccc::sptr fft_filter_ccc_;
+    gr::blocks::rotator_cc::sptr rotator_;
+    bool use_fft_;
     ConfigurationInterface* config_;
     int decimation_factor_;
     bool dump_;
@@ -63,10 +63,12 @@ NotchFilter::NotchFilter(ConfigurationInterface* configuration, const std::strin
     length_ = configuration->property(role + ".length", default_length_);
     n_segments_est = configuration->property(role + ".segments_est", default_n_segments_est);
     n_segments_reset = configuration->property(role + ".segments_reset", default_n_segments_reset);
+    int monitor_segments = configuration->property(role + ".monitor_segments", 0);
+    int monitor_decimation = configuration->property(role + ".monitor_decimation", 1);
     if (item_type_ == "gr_complex")
         {
             item_size_ = sizeof(gr_complex);
-            notch_filter_ = make_notch_filter(pfa, p_c_factor, length_, n_segments_est, n_segments_reset);
+            notch_filter_ = make_notch_filter(pfa, p_c_factor, length_, n_segments_est, n_segments_reset, monitor_segments, monitor_decimation);
             DLOG(INFO) << "Item size " << item_size_;
             DLOG(INFO) << "input filter(" << notch_filter_->unique_id() << ")";
         }
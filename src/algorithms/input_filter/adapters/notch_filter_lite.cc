@@ -68,12 +68,14 @@ NotchFilterLite::NotchFilterLite(ConfigurationInterface* configuration, const st
     length_ = configuration->property(role + ".length", default_length_);
     n_segments_est = configuration->property(role + ".segments_est", default_n_segments_est);
     n_segments_reset = configuration->property(role + ".segments_reset", default_n_segments_reset);
+    int monitor_segments = configuration->property(role + ".monitor_segments", 0);
+    int monitor_decimation = configuration->property(role + ".monitor_decimation", 1);
     int n_segments_coeff = static_cast<int>((samp_freq / coeff_rate) / static_cast<float>(length_));
     n_segments_coeff = std::max(1, n_segments_coeff);
     if (item_type_ == "gr_complex")
         {
             item_size_ = sizeof(gr_complex);
-            notch_filter_lite_ = make_notch_filter_lite(p_c_factor, pfa, length_, n_segments_est, n_segments_reset, n_segments_coeff);
+            notch_filter_lite_ = make_notch_filter_lite(p_c_factor, pfa, length_, n_segments_est, n_segments_reset, n_segments_coeff, monitor_segments, monitor_decimation);
             DLOG(INFO) << "Item size " << item_size_;
             DLOG(INFO) << "input filter(" << notch_filter_lite_->unique_id() << ")";
         }
@@ -33,6 +33,7 @@
 #include <boost/lexical_cast.hpp>
 #include <glog/logging.h>
 #include <gnuradio/filter/firdes.h>
+#include <algorithm>
 #include <cmath>
 #include <utility>
 #include <vector>
@@ -62,11 +63,26 @@ PulseBlankingFilter::PulseBlankingFilter(ConfigurationInterface* configuration,
     int n_segments_est = config_->property(role_ + ".segments_est", default_n_segments_est);
     int default_n_segments_reset = 5000000;
     int n_segments_reset = config_->property(role_ + ".segments_reset", default_n_segments_reset);
+    int monitor_segments = config_->property(role_ + ".monitor_segments", 0);
+    int monitor_decimation = config_->property(role_ + ".monitor_decimation", 1);
+    std::string default_noise_estimator = "reset";
+    std::string noise_estimator = config_->property(role_ + ".noise_estimator", default_noise_estimator);
+    float ewma_alpha = 0.0;
+    if (noise_estimator == "ewma")
+        {
+            // By default, the average forgets with the same time constant used for the first estimation
+            float default_ewma_alpha = 1.0 / static_cast<float>(std::max(n_segments_est, 1));
+            ewma_alpha = config_->property(role_ + ".ewma_alpha", default_ewma_alpha);
+        }
+    else if (noise_estimator != "reset")
+        {
+            LOG(WARNING) << noise_estimator << " unrecognized noise estimator for " << role_ << ", using reset";
+        }
     if (input_item_type_ == "gr_complex")
         {
             item_size = sizeof(gr_complex);    //output
             input_size_ = sizeof(gr_complex);  //input
-            pulse_blanking_cc_ = make_pulse_blanking_cc(pfa, length_, n_segments_est, n_segments_reset);
+            pulse_blanking_cc_ = make_pulse_blanking_cc(pfa, length_, n_segments_est, n_segments_reset, ewma_alpha, monitor_segments, monitor_decimation);
         }
     else
         {
@@ -30,39 +30,179 @@
 
 
 #include "beamformer.h"
+#include <glog/logging.h>
 #include <gnuradio/io_signature.h>
-#include <sstream>
+#include <volk/volk.h>
+#include <volk_gnsssdr/volk_gnsssdr.h>
+#include <algorithm>
+#include <complex>
+#include <cstring>
 
 
-#define GNSS_SDR_BEAMFORMER_CHANNELS 8
+// Samples of each element combined at once, so the partial sums stay in cache
+const int BEAMFORMER_TILE_SAMPLES = 2048;
 
-beamformer_sptr make_beamformer()
+beamformer_sptr make_beamformer(int32_t channels, uint64_t adapt_period,
+    int32_t snapshot_samples, int32_t reference_element)
 {
-    return beamformer_sptr(new beamformer());
+    return beamformer_sptr(new beamformer(channels, adapt_period, snapshot_samples, reference_element));
 }
 
 
-beamformer::beamformer()
+beamformer::beamformer(int32_t channels, uint64_t adapt_period,
+    int32_t snapshot_samples, int32_t reference_element)
     : gr::sync_block("beamformer",
-          gr::io_signature::make(GNSS_SDR_BEAMFORMER_CHANNELS, GNSS_SDR_BEAMFORMER_CHANNELS, sizeof(gr_complex)),
-          gr::io_signature::make(1, 1, sizeof(gr_complex)))
+          gr::io_signature::make(channels, channels, sizeof(gr_complex)),
+          gr::io_signature::make(1, 1, sizeof(gr_complex))),
+      d_channels(channels),
+      d_adapt_period(adapt_period),
+      d_snapshot_samples(std::max(snapshot_samples, channels)),
+      d_reference_element(std::min(std::max(reference_element, 0), channels - 1)),
+      d_new_weights_ready(false),
+      d_snapshot_full(false),
+      d_samples_since_snapshot(0),
+      d_snapshot_fill(0),
+      d_running(false)
 {
     //initialize weight vector
+    weight_vector = static_cast<gr_complex *>(volk_gnsssdr_malloc(d_channels * sizeof(gr_complex), volk_gnsssdr_get_alignment()));
+    for (int32_t i = 0; i < d_channels; i++)
+        {
+            weight_vector[i] = gr_complex(1, 0);
+        }
+    d_tile = static_cast<gr_complex *>(volk_gnsssdr_malloc(BEAMFORMER_TILE_SAMPLES * sizeof(gr_complex), volk_gnsssdr_get_alignment()));
+    if (d_adapt_period > 0)
+        {
+            d_snapshot.resize(static_cast<size_t>(d_channels) * d_snapshot_samples);
+        }
+}
+
+
+beamformer::~beamformer()
+{
+    stop();
+    volk_gnsssdr_free(d_tile);
+    volk_gnsssdr_free(weight_vector);
+}
+
 
-    if (posix_memalign(reinterpret_cast<void **>(&weight_vector), 16, GNSS_SDR_BEAMFORMER_CHANNELS * sizeof(gr_complex)) == 0)
+void beamformer::set_weights(const std::vector<gr_complex> &weights)
+{
+    std::lock_guard<std::mutex> lock(d_weights_mutex);
+    d_new_weights = weights;
+    d_new_weights.resize(d_channels, gr_complex(0, 0));
+    d_new_weights_ready = true;
+}
+
+
+bool beamformer::start()
+{
+    if (d_adapt_period > 0 && !d_running)
         {
-        };
+            d_running = true;
+            d_thread = std::thread(&beamformer::adapt_weights, this);
+        }
+    return true;
+}
+
 
-    for (int i = 0; i < GNSS_SDR_BEAMFORMER_CHANNELS; i++)
+bool beamformer::stop()
+{
+    if (d_running)
         {
-            weight_vector[i] = gr_complex(1, 0);
+            {
+                std::lock_guard<std::mutex> lock(d_snapshot_mutex);
+                d_running = false;
+            }
+            d_snapshot_cond.notify_all();
+            d_thread.join();
         }
+    return true;
 }
 
 
-beamformer::~beamformer()
+void beamformer::adapt_weights()
 {
-    free(weight_vector);
+    const int32_t n = d_channels;
+    const int32_t k_samples = d_snapshot_samples;
+    std::vector<std::complex<double>> r(n * (n + 1));
+    std::vector<gr_complex> weights(n);
+    while (true)
+        {
+            {
+                std::unique_lock<std::mutex> lock(d_snapshot_mutex);
+                d_snapshot_cond.wait(lock, [this] { return !d_running || d_snapshot_full.load(std::memory_order_acquire); });
+                if (!d_running)
+                    {
+                        return;
+                    }
+            }
+
+            // Sample covariance R = X X^H / K, augmented with the reference steering vector
+            double trace = 0.0;
+            for (int32_t i = 0; i < n; i++)
+                {
+                    const gr_complex *xi = d_snapshot.data() + static_cast<size_t>(i) * k_samples;
+                    for (int32_t j = i; j < n; j++)
+                        {
+                            const gr_complex *xj = d_snapshot.data() + static_cast<size_t>(j) * k_samples;
+                            lv_32fc_t acc;
+                            volk_32fc_x2_conjugate_dot_prod_32fc(&acc, xi, xj, k_samples);
+                            r[i * (n + 1) + j] = std::complex<double>(acc) / static_cast<double>(k_samples);
+                            r[j * (n + 1) + i] = std::conj(r[i * (n + 1) + j]);
+                        }
+                    trace += r[i * (n + 1) + i].real();
+                    r[i * (n + 1) + n] = (i == d_reference_element) ? 1.0 : 0.0;
+                }
+            d_snapshot_full.store(false, std::memory_order_release);
+
+            // Diagonal loading keeps the solution stable with few samples or a quiet array
+            for (int32_t i = 0; i < n; i++)
+                {
+                    r[i * (n + 1) + i] += 1e-3 * trace / static_cast<double>(n) + 1e-20;
+                }
+
+            // Solve R a = e_ref by Gauss-Jordan elimination with partial pivoting
+            for (int32_t c = 0; c < n; c++)
+                {
+                    int32_t pivot = c;
+                    for (int32_t i = c + 1; i < n; i++)
+                        {
+                            if (std::abs(r[i * (n + 1) + c]) > std::abs(r[pivot * (n + 1) + c]))
+                                {
+                                    pivot = i;
+                                }
+                        }
+                    if (pivot != c)
+                        {
+                            std::swap_ranges(r.begin() + c * (n + 1), r.begin() + (c + 1) * (n + 1), r.begin() + pivot * (n + 1));
+                        }
+                    const std::complex<double> inv = 1.0 / r[c * (n + 1) + c];
+                    for (int32_t j = c; j <= n; j++)
+                        {
+                            r[c * (n + 1) + j] *= inv;
+                        }
+                    for (int32_t i = 0; i < n; i++)
+                        {
+                            const std::complex<double> f = r[i * (n + 1) + c];
+                            if (i != c && f != 0.0)
+                                {
+                                    for (int32_t j = c; j <= n; j++)
+                                        {
+                                            r[i * (n + 1) + j] -= f * r[c * (n + 1) + j];
+                                        }
+                                }
+                        }
+                }
+
+            // MVDR weights u = a / (e_ref^H a) give y = u^H x; work() computes sum(w x), so w = conj(u)
+            const std::complex<double> gain = r[d_reference_element * (n + 1) + n];
+            for (int32_t i = 0; i < n; i++)
+                {
+                    weights[i] = gr_complex(std::conj(r[i * (n + 1) + n] / gain));
+                }
+            set_weights(weights);
+        }
 }
 
 
@@ -70,27 +210,55 @@ int beamformer::work(int noutput_items, gr_vector_const_void_star &input_items,
     gr_vector_void_star &output_items)
 {
     auto *out = reinterpret_cast<gr_complex *>(output_items[0]);
-    // channel output buffers
-    //  gr_complex *ch1 = (gr_complex *) input_items[0];
-    //  gr_complex *ch2 = (gr_complex *) input_items[1];
-    //  gr_complex *ch3 = (gr_complex *) input_items[2];
-    //  gr_complex *ch4 = (gr_complex *) input_items[3];
-    //  gr_complex *ch5 = (gr_complex *) input_items[4];
-    //  gr_complex *ch6 = (gr_complex *) input_items[5];
-    //  gr_complex *ch7 = (gr_complex *) input_items[6];
-    //  gr_complex *ch8 = (gr_complex *) input_items[7];
-
-    // NON-VOLK beamforming operation
-    //TODO: Implement VOLK SIMD-accelerated beamformer!
-    gr_complex sum;
-    for (int n = 0; n < noutput_items; n++)
+
+    if (d_new_weights_ready)
+        {
+            std::lock_guard<std::mutex> lock(d_weights_mutex);
+            std::copy(d_new_weights.begin(), d_new_weights.end(), weight_vector);
+            d_new_weights_ready = false;
+        }
+
+    // out = sum(w_i * x_i), one element at a time over each tile
+    for (int start = 0; start < noutput_items; start += BEAMFORMER_TILE_SAMPLES)
+        {
+            const int len = std::min(BEAMFORMER_TILE_SAMPLES, noutput_items - start);
+            gr_complex *out_tile = out + start;
+            volk_32fc_s32fc_multiply_32fc(out_tile, reinterpret_cast<const gr_complex *>(input_items[0]) + start, weight_vector[0], len);
+            for (int32_t i = 1; i < d_channels; i++)
+                {
+                    if (weight_vector[i] == gr_complex(0, 0))
+                        {
+                            continue;
+                        }
+                    volk_32fc_s32fc_multiply_32fc(d_tile, reinterpret_cast<const gr_complex *>(input_items[i]) + start, weight_vector[i], len);
+                    volk_32f_x2_add_32f(reinterpret_cast<float *>(out_tile), reinterpret_cast<const float *>(out_tile), reinterpret_cast<const float *>(d_tile), 2 * len);
+                }
+        }
+
+    // Hand a snapshot of the array to the adaptation thread every d_adapt_period samples
+    if (d_adapt_period > 0)
         {
-            sum = gr_complex(0, 0);
-            for (int i = 0; i < GNSS_SDR_BEAMFORMER_CHANNELS; i++)
+            d_samples_since_snapshot += noutput_items;
+            if (d_samples_since_snapshot >= d_adapt_period && !d_snapshot_full.load(std::memory_order_acquire))
                 {
-                    sum = sum + (reinterpret_cast<const gr_complex *>(input_items[i]))[n] * weight_vector[i];
+                    const int32_t count = std::min(noutput_items, d_snapshot_samples - d_snapshot_fill);
+                    for (int32_t i = 0; i < d_channels; i++)
+                        {
+                            memcpy(d_snapshot.data() + static_cast<size_t>(i) * d_snapshot_samples + d_snapshot_fill,
+                                input_items[i], count * sizeof(gr_complex));
+                        }
+                    d_snapshot_fill += count;
+                    if (d_snapshot_fill == d_snapshot_samples)
+                        {
+                            d_snapshot_fill = 0;
+                            d_samples_since_snapshot = 0;
+                            {
+                                std::lock_guard<std::mutex> lock(d_snapshot_mutex);
+                                d_snapshot_full.store(true, std::memory_order_release);
+                            }
+                            d_snapshot_cond.notify_one();
+                        }
                 }
-            out[n] = sum;
         }
 
     return noutput_items;
@@ -3,6 +3,12 @@
  *
  * \brief Simple spatial filter using RAW array input and beamforming coefficients
  * \author Javier Arribas jarribas (at) cttc.es
+ *
+ * The output is the weighted sum of the array elements, computed with VOLK
+ * over tiles of samples. Optionally, the weights are adapted at a low rate
+ * by a thread of the block, which minimizes the output power while keeping
+ * the gain of a reference element (power inversion, that is, MVDR with the
+ * steering vector of that element).
  * -------------------------------------------------------------------------
  *
  * Copyright (C) 2010-2018  (see AUTHORS file for a list of contributors)
@@ -32,11 +38,23 @@
 #define GNSS_SDR_BEAMFORMER_H
 
 #include <gnuradio/sync_block.h>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
 
 class beamformer;
 typedef boost::shared_ptr<beamformer> beamformer_sptr;
 
-beamformer_sptr make_beamformer();
+/*!
+ * \brief Makes a beamformer for an array of channels elements. With
+ * adapt_period > 0, the weights are computed again every adapt_period
+ * samples from the covariance of snapshot_samples samples.
+ */
+beamformer_sptr make_beamformer(int32_t channels = 8, uint64_t adapt_period = 0,
+    int32_t snapshot_samples = 8192, int32_t reference_element = 0);
 
 /*!
  * \brief This class implements a real-time software-defined spatial filter using the CTTC GNSS experimental antenna array input and a set of dynamically reloadable weights
@@ -45,13 +63,44 @@ class beamformer : public gr::sync_block
 {
 private:
     friend beamformer_sptr
-    make_beamformer_sptr();
+    make_beamformer(int32_t channels, uint64_t adapt_period,
+        int32_t snapshot_samples, int32_t reference_element);
+
+    beamformer(int32_t channels, uint64_t adapt_period,
+        int32_t snapshot_samples, int32_t reference_element);
+
+    void adapt_weights();
 
-    gr_complex *weight_vector;
+    int32_t d_channels;
+    uint64_t d_adapt_period;
+    int32_t d_snapshot_samples;
+    int32_t d_reference_element;
+
+    gr_complex *weight_vector;  // weights in use by work()
+    gr_complex *d_tile;
+    std::vector<gr_complex> d_new_weights;
+    std::mutex d_weights_mutex;
+    std::atomic<bool> d_new_weights_ready;
+
+    // Snapshot of the array, one row per element, handed to the adaptation thread
+    std::vector<gr_complex> d_snapshot;
+    std::atomic<bool> d_snapshot_full;
+    uint64_t d_samples_since_snapshot;
+    int32_t d_snapshot_fill;
+    std::mutex d_snapshot_mutex;
+    std::condition_variable d_snapshot_cond;
+    bool d_running;
+    std::thread d_thread;
 
 public:
-    beamformer();
     ~beamformer();
+
+    //! Replaces the weights; they are applied from the next call to work()
+    void set_weights(const std::vector<gr_complex> &weights);
+
+    bool start();
+    bool stop();
+
     int work(int noutput_items, gr_vector_const_void_star &input_items,
         gr_vector_void_star &output_items);
 };
@@ -39,9 +39,10 @@
 using google::LogMessage;
 
 notch_sptr make_notch_filter(float pfa, float p_c_factor,
-    int32_t length_, int32_t n_segments_est, int32_t n_segments_reset)
+    int32_t length_, int32_t n_segments_est, int32_t n_segments_reset,
+    int32_t monitor_segments, int32_t monitor_decimation)
 {
-    return notch_sptr(new Notch(pfa, p_c_factor, length_, n_segments_est, n_segments_reset));
+    return notch_sptr(new Notch(pfa, p_c_factor, length_, n_segments_est, n_segments_reset, monitor_segments, monitor_decimation));
 }
 
 
@@ -49,9 +50,12 @@ Notch::Notch(float pfa,
     float p_c_factor,
     int32_t length_,
     int32_t n_segments_est,
-    int32_t n_segments_reset) : gr::block("Notch",
-                                    gr::io_signature::make(1, 1, sizeof(gr_complex)),
-                                    gr::io_signature::make(1, 1, sizeof(gr_complex)))
+    int32_t n_segments_reset,
+    int32_t monitor_segments,
+    int32_t monitor_decimation) : gr::block("Notch",
+                                      gr::io_signature::make(1, 1, sizeof(gr_complex)),
+                                      gr::io_signature::make(1, 1, sizeof(gr_complex))),
+                                  d_analysis(length_, monitor_segments, monitor_decimation)
 {
     const int32_t alignment_multiple = volk_get_alignment() / sizeof(gr_complex);
     set_alignment(std::max(1, alignment_multiple));
@@ -70,9 +74,7 @@ Notch::Notch(float pfa,
     thres_ = boost::math::quantile(boost::math::complement(my_dist_, pfa));
     c_samples = static_cast<gr_complex *>(volk_malloc(length_ * sizeof(gr_complex), volk_get_alignment()));
     angle_ = static_cast<float *>(volk_malloc(length_ * sizeof(float), volk_get_alignment()));
-    power_spect = static_cast<float *>(volk_malloc(length_ * sizeof(float), volk_get_alignment()));
     last_out = gr_complex(0.0, 0.0);
-    d_fft = std::unique_ptr<gr::fft::fft_complex>(new gr::fft::fft_complex(length_, true));
 }
 
 
@@ -80,7 +82,6 @@ Notch::~Notch()
 {
     volk_free(c_samples);
     volk_free(angle_);
-    volk_free(power_spect);
 }
 
 
@@ -97,28 +98,23 @@ int Notch::general_work(int noutput_items, gr_vector_int &ninput_items __attribu
     gr_vector_const_void_star &input_items, gr_vector_void_star &output_items)
 {
     int32_t index_out = 0;
-    float sig2dB = 0.0;
     float sig2lin = 0.0;
-    lv_32fc_t dot_prod_;
     const auto *in = reinterpret_cast<const gr_complex *>(input_items[0]);
     auto *out = reinterpret_cast<gr_complex *>(output_items[0]);
     in++;
     while ((index_out + length_) < noutput_items)
         {
+            // The FFT and the energy of the segment are computed once, for the detector and the monitor
+            d_analysis.new_segment(in);
             if ((n_segments < n_segments_est) && (filter_state_ == false))
                 {
-                    memcpy(d_fft->get_inbuf(), in, sizeof(gr_complex) * length_);
-                    d_fft->execute();
-                    volk_32fc_s32f_power_spectrum_32f(power_spect, d_fft->get_outbuf(), 1.0, length_);
-                    volk_32f_s32f_calc_spectral_noise_floor_32f(&sig2dB, power_spect, 15.0, length_);
-                    sig2lin = std::pow(10.0, (sig2dB / 10.0)) / (static_cast<float>(n_deg_fred));
+                    sig2lin = std::pow(10.0, (d_analysis.noise_floor_db() / 10.0)) / (static_cast<float>(n_deg_fred));
                     noise_pow_est = (static_cast<float>(n_segments) * noise_pow_est + sig2lin) / (static_cast<float>(n_segments + 1));
                     memcpy(out, in, sizeof(gr_complex) * length_);
                 }
             else
                 {
-                    volk_32fc_x2_conjugate_dot_prod_32fc(&dot_prod_, in, in, length_);
-                    if ((lv_creal(dot_prod_) / noise_pow_est) > thres_)
+                    if ((d_analysis.energy() / noise_pow_est) > thres_)
                         {
                             if (filter_state_ == false)
                                 {
@@ -144,6 +140,10 @@ int Notch::general_work(int noutput_items, gr_vector_int &ninput_items __attribu
                             memcpy(out, in, sizeof(gr_complex) * length_);
                         }
                 }
+            if (d_analysis.end_segment())
+                {
+                    add_item_tag(0, nitems_written(0) + index_out, pmt::mp(INTERFERENCE_MONITOR_TAG), d_analysis.monitor_value());
+                }
             index_out += length_;
             n_segments++;
             in += length_;
@@ -32,17 +32,22 @@
 #define GNSS_SDR_NOTCH_H_
 
 #include <boost/shared_ptr.hpp>
+#include "spectral_analysis.h"
 #include <gnuradio/block.h>
-#include <gnuradio/fft/fft.h>
 #include <cstdint>
-#include <memory>
 
 class Notch;
 
 typedef boost::shared_ptr<Notch> notch_sptr;
 
+/*!
+ * \brief Makes a notch filter. With monitor_segments > 0, the averaged
+ * spectrum of the input (see Spectral_Analysis) is published in a stream tag
+ * every monitor_segments analysed segments.
+ */
 notch_sptr make_notch_filter(float pfa, float p_c_factor,
-    int32_t length_, int32_t n_segments_est, int32_t n_segments_reset);
+    int32_t length_, int32_t n_segments_est, int32_t n_segments_reset,
+    int32_t monitor_segments = 0, int32_t monitor_decimation = 1);
 
 /*!
  * \brief This class implements a real-time software-defined multi state notch filter
@@ -65,11 +70,10 @@ private:
     gr_complex p_c_factor;
     gr_complex *c_samples;
     float *angle_;
-    float *power_spect;
-    std::unique_ptr<gr::fft::fft_complex> d_fft;
+    Spectral_Analysis d_analysis;
 
 public:
-    Notch(float pfa, float p_c_factor, int32_t length_, int32_t n_segments_est, int32_t n_segments_reset);
+    Notch(float pfa, float p_c_factor, int32_t length_, int32_t n_segments_est, int32_t n_segments_reset, int32_t monitor_segments, int32_t monitor_decimation);
 
     ~Notch();
 
@@ -32,16 +32,21 @@
 #define GNSS_SDR_NOTCH_LITE_H_
 
 #include <boost/shared_ptr.hpp>
+#include "spectral_analysis.h"
 #include <gnuradio/block.h>
-#include <gnuradio/fft/fft.h>
 #include <cstdint>
-#include <memory>
 
 class NotchLite;
 
 typedef boost::shared_ptr<NotchLite> notch_lite_sptr;
 
-notch_lite_sptr make_notch_filter_lite(float p_c_factor, float pfa, int32_t length_, int32_t n_segments_est, int32_t n_segments_reset, int32_t n_segments_coeff);
+/*!
+ * \brief Makes a notch filter (light version). With monitor_segments > 0,
+ * the averaged spectrum of the input (see Spectral_Analysis) is published in
+ * a stream tag every monitor_segments analysed segments.
+ */
+notch_lite_sptr make_notch_filter_lite(float p_c_factor, float pfa, int32_t length_, int32_t n_segments_est, int32_t n_segments_reset, int32_t n_segments_coeff,
+    int32_t monitor_segments = 0, int32_t monitor_decimation = 1);
 
 /*!
  * \brief This class implements a real-time software-defined multi state notch filter light version
@@ -68,11 +73,10 @@ private:
     gr_complex c_samples2;
     float angle1;
     float angle2;
-    float *power_spect;
-    std::unique_ptr<gr::fft::fft_complex> d_fft;
+    Spectral_Analysis d_analysis;
 
 public:
-    NotchLite(float p_c_factor, float pfa, int32_t length_, int32_t n_segments_est, int32_t n_segments_reset, int32_t n_segments_coeff);
+    NotchLite(float p_c_factor, float pfa, int32_t length_, int32_t n_segments_est, int32_t n_segments_reset, int32_t n_segments_coeff, int32_t monitor_segments, int32_t monitor_decimation);
 
     ~NotchLite();
 
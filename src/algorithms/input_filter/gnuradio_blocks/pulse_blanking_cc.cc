@@ -33,23 +33,30 @@
 #include <glog/logging.h>
 #include <gnuradio/io_signature.h>
 #include <volk/volk.h>
+#include <algorithm>
 #include <cmath>
+#include <cstring>
 
 using google::LogMessage;
 
 pulse_blanking_cc_sptr make_pulse_blanking_cc(float pfa, int32_t length_,
-    int32_t n_segments_est, int32_t n_segments_reset)
+    int32_t n_segments_est, int32_t n_segments_reset, float ewma_alpha,
+    int32_t monitor_segments, int32_t monitor_decimation)
 {
-    return pulse_blanking_cc_sptr(new pulse_blanking_cc(pfa, length_, n_segments_est, n_segments_reset));
+    return pulse_blanking_cc_sptr(new pulse_blanking_cc(pfa, length_, n_segments_est, n_segments_reset, ewma_alpha, monitor_segments, monitor_decimation));
 }
 
 
 pulse_blanking_cc::pulse_blanking_cc(float pfa,
     int32_t length_,
     int32_t n_segments_est,
-    int32_t n_segments_reset) : gr::block("pulse_blanking_cc",
-                                    gr::io_signature::make(1, 1, sizeof(gr_complex)),
-                                    gr::io_signature::make(1, 1, sizeof(gr_complex)))
+    int32_t n_segments_reset,
+    float ewma_alpha,
+    int32_t monitor_segments,
+    int32_t monitor_decimation) : gr::block("pulse_blanking_cc",
+                                      gr::io_signature::make(1, 1, sizeof(gr_complex)),
+                                      gr::io_signature::make(1, 1, sizeof(gr_complex))),
+                                  d_analysis(length_, monitor_segments, monitor_decimation)
 {
     const int32_t alignment_multiple = volk_get_alignment() / sizeof(gr_complex);
     set_alignment(std::max(1, alignment_multiple));
@@ -59,22 +66,16 @@ pulse_blanking_cc::pulse_blanking_cc(float pfa,
     n_segments = 0;
     this->n_segments_est = n_segments_est;
     this->n_segments_reset = n_segments_reset;
+    this->ewma_alpha = ewma_alpha;
     noise_power_estimation = 0.0;
     n_deg_fred = 2 * length_;
     boost::math::chi_squared_distribution<float> my_dist_(n_deg_fred);
     thres_ = boost::math::quantile(boost::math::complement(my_dist_, pfa));
-    zeros_ = static_cast<gr_complex *>(volk_malloc(length_ * sizeof(gr_complex), volk_get_alignment()));
-    for (int32_t aux = 0; aux < length_; aux++)
-        {
-            zeros_[aux] = gr_complex(0.0, 0.0);
-        }
+    set_output_multiple(length_);
 }
 
 
-pulse_blanking_cc::~pulse_blanking_cc()
-{
-    volk_free(zeros_);
-}
+pulse_blanking_cc::~pulse_blanking_cc() = default;
 
 
 void pulse_blanking_cc::forecast(int noutput_items __attribute__((unused)), gr_vector_int &ninput_items_required)
@@ -86,18 +87,20 @@ void pulse_blanking_cc::forecast(int noutput_items __attribute__((unused)), gr_v
 }
 
 
-int pulse_blanking_cc::general_work(int noutput_items, gr_vector_int &ninput_items __attribute__((unused)),
+int pulse_blanking_cc::general_work(int noutput_items, gr_vector_int &ninput_items,
     gr_vector_const_void_star &input_items, gr_vector_void_star &output_items)
 {
     const auto *in = reinterpret_cast<const gr_complex *>(input_items[0]);
     auto *out = reinterpret_cast<gr_complex *>(output_items[0]);
-    auto *magnitude = static_cast<float *>(volk_malloc(noutput_items * sizeof(float), volk_get_alignment()));
-    volk_32fc_magnitude_squared_32f(magnitude, in, noutput_items);
+    const int32_t items = std::min(noutput_items, ninput_items[0]);
     int32_t sample_index = 0;
     float segment_energy;
-    while ((sample_index + length_) < noutput_items)
+    while ((sample_index + length_) <= items)
         {
-            volk_32f_accumulator_s32f(&segment_energy, (magnitude + sample_index), length_);
+            // The energy of the segment is read straight from the input, with no magnitude buffer,
+            // and computed once for the detector and the monitor
+            d_analysis.new_segment(in);
+            segment_energy = d_analysis.energy();
             if ((n_segments < n_segments_est) && (last_filtered == false))
                 {
                     noise_power_estimation = (static_cast<float>(n_segments) * noise_power_estimation + segment_energy / static_cast<float>(n_deg_fred)) / static_cast<float>(n_segments + 1);
@@ -107,25 +110,38 @@ int pulse_blanking_cc::general_work(int noutput_items, gr_vector_int &ninput_ite
                 {
                     if ((segment_energy / noise_power_estimation) > thres_)
                         {
-                            memcpy(out, zeros_, sizeof(gr_complex) * length_);
+                            memset(out, 0, sizeof(gr_complex) * length_);
                             last_filtered = true;
                         }
                     else
                         {
                             memcpy(out, in, sizeof(gr_complex) * length_);
                             last_filtered = false;
-                            if (n_segments > n_segments_reset)
+                            if ((ewma_alpha <= 0.0) && (n_segments > n_segments_reset))
                                 {
                                     n_segments = 0;
                                 }
                         }
+                    if (ewma_alpha > 0.0)
+                        {
+                            // Blanked segments are clipped to the threshold, so pulses barely bias the
+                            // estimation but a rise of the noise floor is still followed
+                            const float clipped_energy = std::min(segment_energy, thres_ * noise_power_estimation);
+                            noise_power_estimation += ewma_alpha * (clipped_energy / static_cast<float>(n_deg_fred) - noise_power_estimation);
+                        }
+                }
+            if (d_analysis.end_segment())
+                {
+                    add_item_tag(0, nitems_written(0) + sample_index, pmt::mp(INTERFERENCE_MONITOR_TAG), d_analysis.monitor_value());
                 }
             in += length_;
             out += length_;
             sample_index += length_;
-            n_segments++;
+            if (n_segments < n_segments_est || ewma_alpha <= 0.0)
+                {
+                    n_segments++;
+                }
         }
-    volk_free(magnitude);
     consume_each(sample_index);
     return sample_index;
 }
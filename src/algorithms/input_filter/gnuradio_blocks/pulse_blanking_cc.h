@@ -32,6 +32,7 @@
 #define GNSS_SDR_PULSE_BLANKING_H_
 
 #include <boost/shared_ptr.hpp>
+#include "spectral_analysis.h"
 #include <gnuradio/block.h>
 #include <cstdint>
 
@@ -39,7 +40,17 @@ class pulse_blanking_cc;
 
 typedef boost::shared_ptr<pulse_blanking_cc> pulse_blanking_cc_sptr;
 
-pulse_blanking_cc_sptr make_pulse_blanking_cc(float pfa, int32_t length_, int32_t n_segments_est, int32_t n_segments_reset);
+/*!
+ * \brief Makes a pulse blanking block. With ewma_alpha > 0, the noise power
+ * keeps being tracked after the first n_segments_est segments with an
+ * exponentially weighted average of the segment energies, clipped to the
+ * blanking threshold, instead of being estimated again every
+ * n_segments_reset segments. With monitor_segments > 0, the averaged
+ * spectrum of the input (see Spectral_Analysis) is published in a stream tag
+ * every monitor_segments analysed segments.
+ */
+pulse_blanking_cc_sptr make_pulse_blanking_cc(float pfa, int32_t length_, int32_t n_segments_est, int32_t n_segments_reset, float ewma_alpha = 0.0,
+    int32_t monitor_segments = 0, int32_t monitor_decimation = 1);
 
 
 class pulse_blanking_cc : public gr::block
@@ -54,14 +65,15 @@ private:
     float noise_power_estimation;
     float thres_;
     float pfa;
-    gr_complex *zeros_;
+    float ewma_alpha;
+    Spectral_Analysis d_analysis;
 
 public:
-    pulse_blanking_cc(float pfa, int32_t length_, int32_t n_segments_est, int32_t n_segments_reset);
+    pulse_blanking_cc(float pfa, int32_t length_, int32_t n_segments_est, int32_t n_segments_reset, float ewma_alpha, int32_t monitor_segments, int32_t monitor_decimation);
 
     ~pulse_blanking_cc();
 
-    int general_work(int noutput_items __attribute__((unused)), gr_vector_int &ninput_items __attribute__((unused)),
+    int general_work(int noutput_items, gr_vector_int &ninput_items,
         gr_vector_const_void_star &input_items, gr_vector_void_star &output_items);
 
     void forecast(int noutput_items, gr_vector_int &ninput_items_required);
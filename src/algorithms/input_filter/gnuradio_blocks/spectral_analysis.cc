@@ -0,0 +1,145 @@
+/*!
+ * \file spectral_analysis.cc
+ * \brief Power and spectrum of the segments of an input filter, computed
+ * once and shared by the mitigation and the interference monitor
+ *
+ * -------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2019  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *          Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------
+ */
+
+#include "spectral_analysis.h"
+#include <glog/logging.h>
+#include <volk/volk.h>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+
+Spectral_Analysis::Spectral_Analysis(int32_t length,
+    int32_t monitor_segments,
+    int32_t monitor_decimation) : d_length(length),
+                                  d_monitor_segments(std::max(monitor_segments, 0)),
+                                  d_monitor_decimation(std::max(monitor_decimation, 1)),
+                                  d_in(nullptr),
+                                  d_energy_ready(false),
+                                  d_spectrum_ready(false),
+                                  d_energy(0.0),
+                                  d_segment_count(0),
+                                  d_averaged(0),
+                                  d_power_acc(0.0),
+                                  d_monitor_power(0.0)
+{
+    d_power_spect = static_cast<float*>(volk_malloc(d_length * sizeof(float), volk_get_alignment()));
+    d_magnitude = static_cast<float*>(volk_malloc(d_length * sizeof(float), volk_get_alignment()));
+    d_fft = std::unique_ptr<gr::fft::fft_complex>(new gr::fft::fft_complex(d_length, true));
+    if (d_monitor_segments > 0)
+        {
+            d_spectrum_acc.assign(d_length, 0.0);
+            d_monitor_spectrum.assign(d_length, 0.0);
+        }
+}
+
+
+Spectral_Analysis::~Spectral_Analysis()
+{
+    volk_free(d_power_spect);
+    volk_free(d_magnitude);
+}
+
+
+void Spectral_Analysis::new_segment(const gr_complex* in)
+{
+    d_in = in;
+    d_energy_ready = false;
+    d_spectrum_ready = false;
+}
+
+
+float Spectral_Analysis::energy()
+{
+    if (!d_energy_ready)
+        {
+            lv_32fc_t dot_prod_;
+            volk_32fc_x2_conjugate_dot_prod_32fc(&dot_prod_, d_in, d_in, d_length);
+            d_energy = lv_creal(dot_prod_);
+            d_energy_ready = true;
+        }
+    return d_energy;
+}
+
+
+const gr_complex* Spectral_Analysis::spectrum()
+{
+    if (!d_spectrum_ready)
+        {
+            memcpy(d_fft->get_inbuf(), d_in, sizeof(gr_complex) * d_length);
+            d_fft->execute();
+            d_spectrum_ready = true;
+        }
+    return d_fft->get_outbuf();
+}
+
+
+float Spectral_Analysis::noise_floor_db()
+{
+    float sig2dB = 0.0;
+    volk_32fc_s32f_power_spectrum_32f(d_power_spect, spectrum(), 1.0, d_length);
+    volk_32f_s32f_calc_spectral_noise_floor_32f(&sig2dB, d_power_spect, 15.0, d_length);
+    return sig2dB;
+}
+
+
+bool Spectral_Analysis::end_segment()
+{
+    if ((d_monitor_segments == 0) or ((d_segment_count++ % static_cast<uint64_t>(d_monitor_decimation)) != 0))
+        {
+            return false;
+        }
+    volk_32fc_magnitude_squared_32f(d_magnitude, spectrum(), d_length);
+    volk_32f_x2_add_32f(d_spectrum_acc.data(), d_spectrum_acc.data(), d_magnitude, d_length);
+    d_power_acc += energy();
+    if (++d_averaged < d_monitor_segments)
+        {
+            return false;
+        }
+
+    // the power of a bin is |X_k|^2 / length, and its mean over the segments
+    const float scale = 1.0 / (static_cast<float>(d_length) * static_cast<float>(d_averaged));
+    volk_32f_s32f_multiply_32f(d_monitor_spectrum.data(), d_spectrum_acc.data(), scale, d_length);
+    d_monitor_power = d_power_acc / (static_cast<double>(d_length) * static_cast<double>(d_averaged));
+    std::fill(d_spectrum_acc.begin(), d_spectrum_acc.end(), 0.0);
+    d_power_acc = 0.0;
+    d_averaged = 0;
+
+    auto peak = std::max_element(d_monitor_spectrum.cbegin(), d_monitor_spectrum.cend());
+    DLOG(INFO) << "Interference monitor: mean power " << d_monitor_power << ", highest bin " << (peak - d_monitor_spectrum.cbegin())
+               << " at " << 10.0 * std::log10(*peak / std::max(d_monitor_power, 1e-30)) << " dB over the mean";
+    return true;
+}
+
+
+pmt::pmt_t Spectral_Analysis::monitor_value() const
+{
+    return pmt::cons(pmt::from_double(d_monitor_power), pmt::init_f32vector(d_monitor_spectrum.size(), d_monitor_spectrum));
+}
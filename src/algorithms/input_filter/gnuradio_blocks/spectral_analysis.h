@@ -0,0 +1,116 @@
+/*!
+ * \file spectral_analysis.h
+ * \brief Power and spectrum of the segments of an input filter, computed
+ * once and shared by the mitigation and the interference monitor
+ *
+ * -------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2019  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *          Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_SPECTRAL_ANALYSIS_H_
+#define GNSS_SDR_SPECTRAL_ANALYSIS_H_
+
+#include <gnuradio/fft/fft.h>
+#include <gnuradio/gr_complex.h>
+#include <pmt/pmt.h>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+/*!
+ * \brief Key of the stream tags with the interference monitor output
+ */
+const char INTERFERENCE_MONITOR_TAG[] = "interference_spectrum";
+
+/*!
+ * \brief Analysis of the segments of length samples of the notch and pulse
+ * blanking filters. The energy and the FFT of a segment are computed on the
+ * first request and reused by every later one, so the detector of the filter
+ * and the interference monitor pay for them once.
+ *
+ * With monitor_segments > 0, one out of every monitor_decimation segments
+ * goes into an averaged periodogram (Welch's method with a rectangular window
+ * and no overlap, so that the FFT of the detector serves it as it is). Every
+ * monitor_segments of them, the average is ready to be published.
+ */
+class Spectral_Analysis
+{
+public:
+    Spectral_Analysis(int32_t length, int32_t monitor_segments, int32_t monitor_decimation);
+    ~Spectral_Analysis();
+
+    /*!
+     * \brief Starts the analysis of the segment at \p in
+     */
+    void new_segment(const gr_complex* in);
+
+    /*!
+     * \brief Sum of the squared magnitudes of the samples of the segment
+     */
+    float energy();
+
+    /*!
+     * \brief FFT of the segment
+     */
+    const gr_complex* spectrum();
+
+    /*!
+     * \brief Noise floor of the power spectrum of the segment, in dB
+     */
+    float noise_floor_db();
+
+    /*!
+     * \brief Adds the segment to the interference monitor if it is due.
+     * Returns true when an averaged spectrum is ready, see monitor_value().
+     */
+    bool end_segment();
+
+    /*!
+     * \brief The last averaged spectrum, as a pair: the mean power per
+     * sample (double) and the mean power of each FFT bin (f32vector, in FFT
+     * order, with the DC bin first)
+     */
+    pmt::pmt_t monitor_value() const;
+
+private:
+    int32_t d_length;
+    int32_t d_monitor_segments;
+    int32_t d_monitor_decimation;
+    const gr_complex* d_in;
+    bool d_energy_ready;
+    bool d_spectrum_ready;
+    float d_energy;
+    float* d_power_spect;
+    std::unique_ptr<gr::fft::fft_complex> d_fft;
+
+    uint64_t d_segment_count;
+    int32_t d_averaged;
+    double d_power_acc;
+    std::vector<float> d_spectrum_acc;
+    float* d_magnitude;
+    double d_monitor_power;
+    std::vector<float> d_monitor_spectrum;
+};
+
+#endif  // GNSS_SDR_SPECTRAL_ANALYSIS_H_
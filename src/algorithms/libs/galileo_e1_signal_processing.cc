@@ -32,121 +32,91 @@
 
 #include "galileo_e1_signal_processing.h"
 #include "Galileo_E1.h"
+#include "gnss_code_table.h"
 #include "gnss_signal_processing.h"
 #include <volk_gnsssdr/volk_gnsssdr.h>
+#include <algorithm>
+#include <cmath>
 #include <string>
+#include <vector>
 
 
-void galileo_e1_code_gen_int(int* _dest, char _Signal[3], int32_t _prn)
+Gnss_Code_Table make_galileo_e1_code_table(const std::string* hex_codes)
 {
-    std::string _galileo_signal = _Signal;
-    int32_t prn = _prn - 1;
-    int32_t index = 0;
-
-    // A simple error check
-    if ((_prn < 1) || (_prn > 50))
-        {
-            return;
-        }
-
-    if (_galileo_signal.rfind("1B") != std::string::npos && _galileo_signal.length() >= 2)
+    Gnss_Code_Table table(Galileo_E1_NUMBER_OF_CODES, static_cast<uint32_t>(Galileo_E1_B_CODE_LENGTH_CHIPS));
+    for (int32_t prn = 0; prn < Galileo_E1_NUMBER_OF_CODES; prn++)
         {
-            for (char i : Galileo_E1_B_PRIMARY_CODE[prn])
-                {
-                    hex_to_binary_converter(&_dest[index], i);
-                    index += 4;
-                }
-        }
-    else if (_galileo_signal.rfind("1C") != std::string::npos && _galileo_signal.length() >= 2)
-        {
-            for (char i : Galileo_E1_C_PRIMARY_CODE[prn])
-                {
-                    hex_to_binary_converter(&_dest[index], i);
-                    index += 4;
-                }
+            table.set_hex(prn, hex_codes[prn]);
         }
+    return table;
 }
 
 
-void galileo_e1_sinboc_11_gen_int(int* _dest, const int* _prn, uint32_t _length_out)
+// The hexadecimal codes are converted once, the first time a code is requested
+const Gnss_Code_Table& galileo_e1_b_code_table()
 {
-    const uint32_t _length_in = Galileo_E1_B_CODE_LENGTH_CHIPS;
-    auto _period = static_cast<uint32_t>(_length_out / _length_in);
-    for (uint32_t i = 0; i < _length_in; i++)
-        {
-            for (uint32_t j = 0; j < (_period / 2); j++)
-                {
-                    _dest[i * _period + j] = _prn[i];
-                }
-            for (uint32_t j = (_period / 2); j < _period; j++)
-                {
-                    _dest[i * _period + j] = -_prn[i];
-                }
-        }
+    static const Gnss_Code_Table table = make_galileo_e1_code_table(Galileo_E1_B_PRIMARY_CODE);
+    return table;
 }
 
 
-void galileo_e1_sinboc_61_gen_int(int* _dest, const int* _prn, uint32_t _length_out)
+const Gnss_Code_Table& galileo_e1_c_code_table()
 {
-    const uint32_t _length_in = Galileo_E1_B_CODE_LENGTH_CHIPS;
-    auto _period = static_cast<uint32_t>(_length_out / _length_in);
-
-    for (uint32_t i = 0; i < _length_in; i++)
-        {
-            for (uint32_t j = 0; j < _period; j += 2)
-                {
-                    _dest[i * _period + j] = _prn[i];
-                }
-            for (uint32_t j = 1; j < _period; j += 2)
-                {
-                    _dest[i * _period + j] = -_prn[i];
-                }
-        }
+    static const Gnss_Code_Table table = make_galileo_e1_code_table(Galileo_E1_C_PRIMARY_CODE);
+    return table;
 }
 
 
-void galileo_e1_code_gen_sinboc11_float(float* _dest, char _Signal[3], uint32_t _prn)
+// Code table of the component named in _Signal, or nullptr if there is no such component or PRN
+const Gnss_Code_Table* galileo_e1_code_table(const std::string& _galileo_signal, uint32_t _prn)
 {
-    std::string _galileo_signal = _Signal;
-    const auto _codeLength = static_cast<uint32_t>(Galileo_E1_B_CODE_LENGTH_CHIPS);
-    int32_t primary_code_E1_chips[4092];                            // _codeLength not accepted by Clang
-    galileo_e1_code_gen_int(primary_code_E1_chips, _Signal, _prn);  //generate Galileo E1 code, 1 sample per chip
-    for (uint32_t i = 0; i < _codeLength; i++)
+    // A simple error check
+    if ((_prn < 1) || (_prn > 50))
         {
-            _dest[2 * i] = static_cast<float>(primary_code_E1_chips[i]);
-            _dest[2 * i + 1] = -_dest[2 * i];
+            return nullptr;
         }
+    if (_galileo_signal.rfind("1B") != std::string::npos && _galileo_signal.length() >= 2)
+        {
+            return &galileo_e1_b_code_table();
+        }
+    if (_galileo_signal.rfind("1C") != std::string::npos && _galileo_signal.length() >= 2)
+        {
+            return &galileo_e1_c_code_table();
+        }
+    return nullptr;
 }
 
 
-void galileo_e1_gen_float(float* _dest, int* _prn, char _Signal[3])
+// One chip of the sinboc(1,1) subcarrier, 2 samples per chip
+const float GALILEO_E1_SINBOC_11[2] = {1.0, -1.0};
+
+
+/*
+ * One chip of the CBOC subcarrier of E1B (alpha * sinboc(1,1) + beta * sinboc(6,1))
+ * or E1C (alpha * sinboc(1,1) - beta * sinboc(6,1)), 12 samples per chip
+ */
+std::vector<float> galileo_e1_cboc_subcarrier(const std::string& _galileo_signal)
 {
-    std::string _galileo_signal = _Signal;
-    const uint32_t _codeLength = 12 * Galileo_E1_B_CODE_LENGTH_CHIPS;
     const float alpha = sqrt(10.0 / 11.0);
     const float beta = sqrt(1.0 / 11.0);
-
-    int32_t sinboc_11[12 * 4092] = {0};  //  _codeLength not accepted by Clang
-    int32_t sinboc_61[12 * 4092] = {0};
-
-    galileo_e1_sinboc_11_gen_int(sinboc_11, _prn, _codeLength);  //generate sinboc(1,1) 12 samples per chip
-    galileo_e1_sinboc_61_gen_int(sinboc_61, _prn, _codeLength);  //generate sinboc(6,1) 12 samples per chip
-
-    if (_galileo_signal.rfind("1B") != std::string::npos && _galileo_signal.length() >= 2)
+    const float beta_sign = (_galileo_signal.rfind("1B") != std::string::npos) ? 1.0 : -1.0;
+    std::vector<float> subcarrier(12);
+    for (uint32_t k = 0; k < 12; k++)
         {
-            for (uint32_t i = 0; i < _codeLength; i++)
-                {
-                    _dest[i] = alpha * static_cast<float>(sinboc_11[i]) +
-                               beta * static_cast<float>(sinboc_61[i]);
-                }
+            const float sinboc_11 = (k < 6) ? 1.0 : -1.0;
+            const float sinboc_61 = (k % 2 == 0) ? 1.0 : -1.0;
+            subcarrier[k] = alpha * sinboc_11 + beta_sign * beta * sinboc_61;
         }
-    else if (_galileo_signal.rfind("1C") != std::string::npos && _galileo_signal.length() >= 2)
+    return subcarrier;
+}
+
+
+void galileo_e1_code_gen_sinboc11_float(float* _dest, char _Signal[3], uint32_t _prn)
+{
+    const Gnss_Code_Table* codes = galileo_e1_code_table(_Signal, _prn);
+    if (codes != nullptr)
         {
-            for (uint32_t i = 0; i < _codeLength; i++)
-                {
-                    _dest[i] = alpha * static_cast<float>(sinboc_11[i]) -
-                               beta * static_cast<float>(sinboc_61[i]);
-                }
+            codes->unpack_modulated(_dest, _prn - 1, GALILEO_E1_SINBOC_11, 2);
         }
 }
 
@@ -160,34 +130,29 @@ void galileo_e1_code_gen_float_sampled(float* _dest, char _Signal[3],
     uint32_t _samplesPerCode;
     const int32_t _codeFreqBasis = Galileo_E1_CODE_CHIP_RATE_HZ;  // Hz
     auto _codeLength = static_cast<uint32_t>(Galileo_E1_B_CODE_LENGTH_CHIPS);
-    auto* primary_code_E1_chips = static_cast<int32_t*>(volk_gnsssdr_malloc(static_cast<uint32_t>(Galileo_E1_B_CODE_LENGTH_CHIPS) * sizeof(int32_t), volk_gnsssdr_get_alignment()));
 
     _samplesPerCode = static_cast<uint32_t>(static_cast<double>(_fs) / (static_cast<double>(_codeFreqBasis) / static_cast<double>(_codeLength)));
     const int32_t _samplesPerChip = (_cboc == true) ? 12 : 2;
 
     const uint32_t delay = ((static_cast<int32_t>(Galileo_E1_B_CODE_LENGTH_CHIPS) - _chip_shift) % static_cast<int32_t>(Galileo_E1_B_CODE_LENGTH_CHIPS)) * _samplesPerCode / Galileo_E1_B_CODE_LENGTH_CHIPS;
 
-    galileo_e1_code_gen_int(primary_code_E1_chips, _Signal, _prn);  // generate Galileo E1 code, 1 sample per chip
-
     float* _signal_E1;
 
     _codeLength = _samplesPerChip * Galileo_E1_B_CODE_LENGTH_CHIPS;
-    _signal_E1 = new float[_codeLength];
+    _signal_E1 = new float[_codeLength]();
 
-    if (_cboc == true)
+    // cboc or sinboc(1,1), straight from the bits of the primary code
+    const Gnss_Code_Table* codes = galileo_e1_code_table(_galileo_signal, _prn);
+    if (codes != nullptr)
         {
-            galileo_e1_gen_float(_signal_E1, primary_code_E1_chips, _Signal);  // generate cboc 12 samples per chip
-        }
-    else
-        {
-            auto* _signal_E1_int = static_cast<int32_t*>(volk_gnsssdr_malloc(_codeLength * sizeof(int32_t), volk_gnsssdr_get_alignment()));
-            galileo_e1_sinboc_11_gen_int(_signal_E1_int, primary_code_E1_chips, _codeLength);  // generate sinboc(1,1) 2 samples per chip
-
-            for (uint32_t ii = 0; ii < _codeLength; ++ii)
+            if (_cboc == true)
                 {
-                    _signal_E1[ii] = static_cast<float>(_signal_E1_int[ii]);
+                    codes->unpack_modulated(_signal_E1, _prn - 1, galileo_e1_cboc_subcarrier(_galileo_signal).data(), _samplesPerChip);
+                }
+            else
+                {
+                    codes->unpack_modulated(_signal_E1, _prn - 1, GALILEO_E1_SINBOC_11, _samplesPerChip);
                 }
-            volk_gnsssdr_free(_signal_E1_int);
         }
 
     if (_fs != _samplesPerChip * _codeFreqBasis)
@@ -207,9 +172,10 @@ void galileo_e1_code_gen_float_sampled(float* _dest, char _Signal[3],
 
             for (uint32_t i = 0; i < static_cast<uint32_t>(Galileo_E1_C_SECONDARY_CODE_LENGTH); i++)
                 {
+                    const float secondary_chip = (Galileo_E1_C_SECONDARY_CODE.at(i) == '0' ? 1.0f : -1.0f);
                     for (unsigned k = 0; k < _samplesPerCode; k++)
                         {
-                            _signal_E1C_secondary[i * _samplesPerCode + k] = _signal_E1[k] * (Galileo_E1_C_SECONDARY_CODE.at(i) == '0' ? 1.0f : -1.0f);
+                            _signal_E1C_secondary[i * _samplesPerCode + k] = _signal_E1[k] * secondary_chip;
                         }
                 }
 
@@ -219,13 +185,11 @@ void galileo_e1_code_gen_float_sampled(float* _dest, char _Signal[3],
             _signal_E1 = _signal_E1C_secondary;
         }
 
-    for (uint32_t i = 0; i < _samplesPerCode; i++)
-        {
-            _dest[(i + delay) % _samplesPerCode] = _signal_E1[i];
-        }
+    // _dest[(i + delay) % _samplesPerCode] = _signal_E1[i], without a modulo per sample
+    std::copy(_signal_E1, _signal_E1 + _samplesPerCode - delay, _dest + delay);
+    std::copy(_signal_E1 + _samplesPerCode - delay, _signal_E1 + _samplesPerCode, _dest);
 
     delete[] _signal_E1;
-    volk_gnsssdr_free(primary_code_E1_chips);
 }
 
 
@@ -33,69 +33,70 @@
 
 #include "galileo_e5_signal_processing.h"
 #include "Galileo_E5a.h"
+#include "gnss_code_table.h"
 #include "gnss_signal_processing.h"
 #include <gnuradio/gr_complex.h>
+#include <algorithm>
+
+
+Gnss_Code_Table make_galileo_e5a_code_table(const std::string* hex_codes)
+{
+    // the last hexadecimal character holds the last 2 chips, the rest is filled up with zeros
+    Gnss_Code_Table table(Galileo_E5a_NUMBER_OF_CODES, Galileo_E5a_CODE_LENGTH_CHIPS);
+    for (int32_t prn = 0; prn < Galileo_E5a_NUMBER_OF_CODES; prn++)
+        {
+            table.set_hex(prn, hex_codes[prn]);
+        }
+    return table;
+}
+
+
+// The hexadecimal codes are converted once, the first time a code is requested
+const Gnss_Code_Table& galileo_e5a_i_code_table()
+{
+    static const Gnss_Code_Table table = make_galileo_e5a_code_table(Galileo_E5a_I_PRIMARY_CODE);
+    return table;
+}
+
+
+const Gnss_Code_Table& galileo_e5a_q_code_table()
+{
+    static const Gnss_Code_Table table = make_galileo_e5a_code_table(Galileo_E5a_Q_PRIMARY_CODE);
+    return table;
+}
 
 
 void galileo_e5_a_code_gen_complex_primary(std::complex<float>* _dest, int32_t _prn, const char _Signal[3])
 {
     uint32_t prn = _prn - 1;
-    uint32_t index = 0;
-    int32_t a[4];
     if ((_prn < 1) || (_prn > 50))
         {
             return;
         }
     if (_Signal[0] == '5' && _Signal[1] == 'Q')
         {
-            for (size_t i = 0; i < Galileo_E5a_Q_PRIMARY_CODE[prn].length() - 1; i++)
+            const Gnss_Code_Table& q_codes = galileo_e5a_q_code_table();
+            for (uint32_t n = 0; n < q_codes.length_chips(); n++)
                 {
-                    hex_to_binary_converter(a, Galileo_E5a_Q_PRIMARY_CODE[prn].at(i));
-                    _dest[index] = std::complex<float>(0.0, float(a[0]));
-                    _dest[index + 1] = std::complex<float>(0.0, float(a[1]));
-                    _dest[index + 2] = std::complex<float>(0.0, float(a[2]));
-                    _dest[index + 3] = std::complex<float>(0.0, float(a[3]));
-                    index = index + 4;
+                    _dest[n] = std::complex<float>(0.0, static_cast<float>(q_codes.chip(prn, n)));
                 }
-            // last 2 bits are filled up zeros
-            hex_to_binary_converter(a, Galileo_E5a_Q_PRIMARY_CODE[prn].at(Galileo_E5a_Q_PRIMARY_CODE[prn].length() - 1));
-            _dest[index] = std::complex<float>(float(0.0), a[0]);
-            _dest[index + 1] = std::complex<float>(float(0.0), a[1]);
         }
     else if (_Signal[0] == '5' && _Signal[1] == 'I')
         {
-            for (size_t i = 0; i < Galileo_E5a_I_PRIMARY_CODE[prn].length() - 1; i++)
+            const Gnss_Code_Table& i_codes = galileo_e5a_i_code_table();
+            for (uint32_t n = 0; n < i_codes.length_chips(); n++)
                 {
-                    hex_to_binary_converter(a, Galileo_E5a_I_PRIMARY_CODE[prn].at(i));
-                    _dest[index] = std::complex<float>(float(a[0]), 0.0);
-                    _dest[index + 1] = std::complex<float>(float(a[1]), 0.0);
-                    _dest[index + 2] = std::complex<float>(float(a[2]), 0.0);
-                    _dest[index + 3] = std::complex<float>(float(a[3]), 0.0);
-                    index = index + 4;
+                    _dest[n] = std::complex<float>(static_cast<float>(i_codes.chip(prn, n)), 0.0);
                 }
-            // last 2 bits are filled up zeros
-            hex_to_binary_converter(a, Galileo_E5a_I_PRIMARY_CODE[prn].at(Galileo_E5a_I_PRIMARY_CODE[prn].length() - 1));
-            _dest[index] = std::complex<float>(float(a[0]), 0.0);
-            _dest[index + 1] = std::complex<float>(float(a[1]), 0.0);
         }
     else if (_Signal[0] == '5' && _Signal[1] == 'X')
         {
-            int32_t b[4];
-            for (size_t i = 0; i < Galileo_E5a_I_PRIMARY_CODE[prn].length() - 1; i++)
+            const Gnss_Code_Table& i_codes = galileo_e5a_i_code_table();
+            const Gnss_Code_Table& q_codes = galileo_e5a_q_code_table();
+            for (uint32_t n = 0; n < i_codes.length_chips(); n++)
                 {
-                    hex_to_binary_converter(a, Galileo_E5a_I_PRIMARY_CODE[prn].at(i));
-                    hex_to_binary_converter(b, Galileo_E5a_Q_PRIMARY_CODE[prn].at(i));
-                    _dest[index] = std::complex<float>(float(a[0]), float(b[0]));
-                    _dest[index + 1] = std::complex<float>(float(a[1]), float(b[1]));
-                    _dest[index + 2] = std::complex<float>(float(a[2]), float(b[2]));
-                    _dest[index + 3] = std::complex<float>(float(a[3]), float(b[3]));
-                    index = index + 4;
+                    _dest[n] = std::complex<float>(static_cast<float>(i_codes.chip(prn, n)), static_cast<float>(q_codes.chip(prn, n)));
                 }
-            // last 2 bits are filled up zeros
-            hex_to_binary_converter(a, Galileo_E5a_I_PRIMARY_CODE[prn].at(Galileo_E5a_I_PRIMARY_CODE[prn].length() - 1));
-            hex_to_binary_converter(b, Galileo_E5a_Q_PRIMARY_CODE[prn].at(Galileo_E5a_Q_PRIMARY_CODE[prn].length() - 1));
-            _dest[index] = std::complex<float>(float(a[0]), float(b[0]));
-            _dest[index + 1] = std::complex<float>(float(a[1]), float(b[1]));
         }
 }
 
@@ -118,19 +119,15 @@ void galileo_e5_a_code_gen_complex_sampled(std::complex<float>* _dest, char _Sig
 
     if (_fs != _codeFreqBasis)
         {
-            std::complex<float>* _resampled_signal;
-            if (posix_memalign(reinterpret_cast<void**>(&_resampled_signal), 16, _samplesPerCode * sizeof(gr_complex)) == 0)
-                {
-                };
+            auto* _resampled_signal = new std::complex<float>[_samplesPerCode];
             resampler(_code, _resampled_signal, _codeFreqBasis, _fs, _codeLength, _samplesPerCode);  // resamples code to fs
             delete[] _code;
             _code = _resampled_signal;
         }
 
-    for (uint32_t i = 0; i < _samplesPerCode; i++)
-        {
-            _dest[(i + delay) % _samplesPerCode] = _code[i];
-        }
+    // _dest[(i + delay) % _samplesPerCode] = _code[i], without a modulo per sample
+    std::copy(_code, _code + _samplesPerCode - delay, _dest + delay);
+    std::copy(_code + _samplesPerCode - delay, _code + _samplesPerCode, _dest);
 
     delete[] _code;
 }
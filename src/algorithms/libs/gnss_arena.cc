@@ -0,0 +1,92 @@
+/*!
+ * \file gnss_arena.cc
+ * \brief Single aligned buffer holding the working arrays of a channel
+ *
+ * -------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2019  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *          Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------
+ */
+
+#include "gnss_arena.h"
+#include "gnss_sdr_memory_policy.h"
+#include <glog/logging.h>
+#include <volk_gnsssdr/volk_gnsssdr.h>
+#include <algorithm>
+
+
+Gnss_Arena::Gnss_Arena()
+{
+    d_buffer = nullptr;
+    d_bytes = 0;
+    d_used = 0;
+    // a cache line at least, so that two arrays never share one
+    d_alignment = std::max(volk_gnsssdr_get_alignment(), static_cast<size_t>(64));
+}
+
+
+Gnss_Arena::~Gnss_Arena()
+{
+    release();
+}
+
+
+void* Gnss_Arena::take_bytes(size_t bytes)
+{
+    size_t first = d_used;
+    d_used += (bytes + d_alignment - 1) / d_alignment * d_alignment;
+    if (d_buffer == nullptr)
+        {
+            d_bytes = d_used;
+            return nullptr;
+        }
+    if (d_used > d_bytes)
+        {
+            LOG(FATAL) << "Gnss_Arena: the arrays take " << d_used << " bytes, but " << d_bytes << " were allocated";
+        }
+    return d_buffer + first;
+}
+
+
+bool Gnss_Arena::allocate()
+{
+    release();
+    d_used = 0;
+    if (d_bytes == 0)
+        {
+            return true;
+        }
+    // large arenas (e.g., an acquisition grid) get huge pages and the NUMA node of the memory policy
+    d_buffer = static_cast<uint8_t*>(gnss_sdr_large_malloc(d_bytes, d_alignment));
+    return d_buffer != nullptr;
+}
+
+
+void Gnss_Arena::release()
+{
+    if (d_buffer != nullptr)
+        {
+            gnss_sdr_large_free(d_buffer);
+            d_buffer = nullptr;
+        }
+    d_used = 0;
+}
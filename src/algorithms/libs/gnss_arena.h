@@ -0,0 +1,103 @@
+/*!
+ * \file gnss_arena.h
+ * \brief Single aligned buffer holding the working arrays of a channel
+ *
+ * -------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2019  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *          Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_GNSS_ARENA_H_
+#define GNSS_SDR_GNSS_ARENA_H_
+
+#include <cstddef>
+#include <cstdint>
+
+/*!
+ * \brief Lays out the arrays that a channel touches on every epoch one after
+ * the other, in the order they are used, in a single aligned buffer.
+ *
+ * The layout is done twice with the same calls to take(): before allocate()
+ * they only add up the size and return nullptr, after it they return the
+ * arrays. release() frees all of them at once, and the next layout starts
+ * again from the beginning:
+ *
+ * \code
+ * arena.take<float>(n); ...            // sizing
+ * arena.allocate();
+ * float* a = arena.take<float>(n); ... // binding
+ * \endcode
+ *
+ * The size is kept after release(), so the same layout can be allocated
+ * again without the sizing pass.
+ */
+class Gnss_Arena
+{
+public:
+    Gnss_Arena();
+    ~Gnss_Arena();
+
+    Gnss_Arena(const Gnss_Arena&) = delete;
+    Gnss_Arena& operator=(const Gnss_Arena&) = delete;
+
+    /*!
+     * \brief Next \p n_items items of type T, aligned for the volk_gnsssdr
+     * kernels. Returns nullptr while sizing.
+     */
+    template <typename T>
+    T* take(size_t n_items)
+    {
+        return static_cast<T*>(take_bytes(n_items * sizeof(T)));
+    }
+
+    /*!
+     * \brief Allocates the size added up so far, and starts binding the
+     * arrays. Returns false if the allocation failed.
+     */
+    bool allocate();
+
+    /*!
+     * \brief Frees the buffer. The arrays taken from it are no longer valid.
+     */
+    void release();
+
+    inline bool allocated() const
+    {
+        return d_buffer != nullptr;
+    }
+
+    inline size_t bytes() const
+    {
+        return d_bytes;
+    }
+
+private:
+    void* take_bytes(size_t bytes);
+
+    uint8_t* d_buffer;
+    size_t d_bytes;      // of the buffer, or of the layout while sizing
+    size_t d_used;       // bytes already taken
+    size_t d_alignment;  // of each array
+};
+
+#endif
@@ -1,6 +1,6 @@
 /*!
  * \file gnss_circular_deque.h
- * \brief This class implements a circular deque for Gnss_Synchro
+ * \brief This class implements a set of circular deques, one per channel
  *
  * \author Antonio Ramos, 2018. antonio.ramosdet(at)gmail.com
  *
@@ -34,19 +34,30 @@
 #ifndef GNSS_SDR_CIRCULAR_DEQUE_H_
 #define GNSS_SDR_CIRCULAR_DEQUE_H_
 
-#include <boost/circular_buffer.hpp>
+#include <cstddef>
 #include <vector>
 
+/*!
+ * \brief Set of fixed capacity deques, one per channel, in a single contiguous
+ * allocation.
+ *
+ * The storage of each channel has a power of two size, and element k is
+ * mirrored at k + that size, so the elements of a channel from the oldest to
+ * the newest are always an array that starts at data(ch). Once a channel holds
+ * max_size elements, each push_back() drops its oldest element, like
+ * boost::circular_buffer. Channel and position indexes are not checked.
+ */
 template <class T>
 class Gnss_circular_deque
 {
 public:
     Gnss_circular_deque();                                                        // Default constructor
     Gnss_circular_deque(const unsigned int max_size, const unsigned int nchann);  // nchann = number of channels; max_size = channel capacity
-    unsigned int size(const unsigned int ch);                                     // Returns the number of available elements in a channel
-    T& at(const unsigned int ch, const unsigned int pos);                         // Returns a reference to an element
-    T& front(const unsigned int ch);                                              // Returns a reference to the first element in the deque
-    T& back(const unsigned int ch);                                               // Returns a reference to the last element in the deque
+    unsigned int size(const unsigned int ch) const;                               // Returns the number of available elements in a channel
+    const T& at(const unsigned int ch, const unsigned int pos) const;             // Returns a reference to an element
+    const T& front(const unsigned int ch) const;                                  // Returns a reference to the first element in the deque
+    const T& back(const unsigned int ch) const;                                   // Returns a reference to the last element in the deque
+    const T* data(const unsigned int ch) const;                                   // Returns a pointer to the first element, followed by the others up to the last one
     void push_back(const unsigned int ch, const T& new_data);                     // Inserts an element at the end of the deque
     void pop_front(const unsigned int ch);                                        // Removes the first element of the deque
     void clear(const unsigned int ch);                                            // Removes all the elements of the deque (Sets size to 0). Capacity is not modified
@@ -54,7 +65,11 @@ public:
     void reset();                                                                 // Removes all the channels (Sets nchann to 0)
 
 private:
-    std::vector<boost::circular_buffer<T>> d_data;
+    unsigned int d_max_size;            // capacity of each channel
+    unsigned int d_storage_size;        // power of two not less than d_max_size
+    std::vector<unsigned int> d_first;  // storage index of the first element of each channel
+    std::vector<unsigned int> d_size;
+    std::vector<T> d_data;  // 2 * d_storage_size elements per channel
 };
 
 
@@ -71,66 +86,97 @@ Gnss_circular_deque<T>::Gnss_circular_deque(const unsigned int max_size, const u
 }
 
 template <class T>
-unsigned int Gnss_circular_deque<T>::size(const unsigned int ch)
+inline unsigned int Gnss_circular_deque<T>::size(const unsigned int ch) const
+{
+    return d_size[ch];
+}
+
+template <class T>
+inline const T* Gnss_circular_deque<T>::data(const unsigned int ch) const
 {
-    return d_data.at(ch).size();
+    return &d_data[2 * d_storage_size * ch + d_first[ch]];
 }
 
 template <class T>
-T& Gnss_circular_deque<T>::back(const unsigned int ch)
+inline const T& Gnss_circular_deque<T>::back(const unsigned int ch) const
 {
-    return d_data.at(ch).back();
+    return data(ch)[d_size[ch] - 1];
 }
 
 
 template <class T>
-T& Gnss_circular_deque<T>::front(const unsigned int ch)
+inline const T& Gnss_circular_deque<T>::front(const unsigned int ch) const
 {
-    return d_data.at(ch).front();
+    return data(ch)[0];
 }
 
 
 template <class T>
-T& Gnss_circular_deque<T>::at(const unsigned int ch, const unsigned int pos)
+inline const T& Gnss_circular_deque<T>::at(const unsigned int ch, const unsigned int pos) const
 {
-    return d_data.at(ch).at(pos);
+    return data(ch)[pos];
 }
 
 template <class T>
 void Gnss_circular_deque<T>::clear(const unsigned int ch)
 {
-    d_data.at(ch).clear();
+    d_first[ch] = 0;
+    d_size[ch] = 0;
 }
 
 template <class T>
 void Gnss_circular_deque<T>::reset(const unsigned int max_size, const unsigned int nchann)
 {
-    d_data.clear();
+    reset();
     if (max_size > 0 and nchann > 0)
         {
-            for (unsigned int i = 0; i < nchann; i++)
+            d_max_size = max_size;
+            d_storage_size = 1;
+            while (d_storage_size < max_size)
                 {
-                    d_data.push_back(boost::circular_buffer<T>(max_size));
+                    d_storage_size <<= 1;
                 }
+            d_first.assign(nchann, 0);
+            d_size.assign(nchann, 0);
+            d_data.assign(static_cast<size_t>(2 * d_storage_size) * nchann, T());
         }
 }
 
 template <class T>
 void Gnss_circular_deque<T>::reset()
 {
+    d_max_size = 0;
+    d_storage_size = 0;
+    d_first.clear();
+    d_size.clear();
     d_data.clear();
 }
 
 template <class T>
-void Gnss_circular_deque<T>::pop_front(const unsigned int ch)
+inline void Gnss_circular_deque<T>::pop_front(const unsigned int ch)
 {
-    d_data.at(ch).pop_front();
+    if (d_size[ch] > 0)
+        {
+            d_first[ch] = (d_first[ch] + 1) & (d_storage_size - 1);
+            d_size[ch]--;
+        }
 }
 
 template <class T>
-void Gnss_circular_deque<T>::push_back(const unsigned int ch, const T& new_data)
+inline void Gnss_circular_deque<T>::push_back(const unsigned int ch, const T& new_data)
 {
-    d_data.at(ch).push_back(new_data);
+    const size_t base = 2 * d_storage_size * ch;
+    const unsigned int last = (d_first[ch] + d_size[ch]) & (d_storage_size - 1);
+    d_data[base + last] = new_data;
+    d_data[base + last + d_storage_size] = new_data;
+    if (d_size[ch] < d_max_size)
+        {
+            d_size[ch]++;
+        }
+    else
+        {
+            d_first[ch] = (d_first[ch] + 1) & (d_storage_size - 1);
+        }
 }
 
 #endif /* GNSS_SDR_CIRCULAR_DEQUE_H_ */
@@ -0,0 +1,68 @@
+/*!
+ * \file gnss_code_table.cc
+ * \brief Bit-packed table of the primary codes of a signal, one code per PRN.
+ *
+ * -------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2019  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *          Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------
+ */
+
+#include "gnss_code_table.h"
+
+
+Gnss_Code_Table::Gnss_Code_Table(uint32_t n_codes, uint32_t length_chips)
+{
+    d_n_codes = n_codes;
+    d_length_chips = length_chips;
+    d_words_per_code = (length_chips + 63) / 64;
+    d_bits.assign(static_cast<size_t>(n_codes) * d_words_per_code, 0);
+}
+
+
+void Gnss_Code_Table::set_chip(uint32_t code, uint32_t chip, bool minus_one)
+{
+    uint64_t& word = d_bits[code * d_words_per_code + (chip >> 6)];
+    const uint64_t mask = static_cast<uint64_t>(1) << (chip & 63);
+    if (minus_one)
+        {
+            word |= mask;
+        }
+    else
+        {
+            word &= ~mask;
+        }
+}
+
+
+void Gnss_Code_Table::set_hex(uint32_t code, const std::string& hex)
+{
+    uint32_t chip = 0;
+    for (char c : hex)
+        {
+            uint32_t value = (c >= 'A') ? static_cast<uint32_t>(c - 'A' + 10) : static_cast<uint32_t>(c - '0');
+            for (int32_t bit = 3; (bit >= 0) and (chip < d_length_chips); bit--)
+                {
+                    set_chip(code, chip++, ((value >> bit) & 1) != 0);
+                }
+        }
+}
@@ -0,0 +1,127 @@
+/*!
+ * \file gnss_code_table.h
+ * \brief Bit-packed table of the primary codes of a signal, one code per PRN.
+ *
+ * -------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2019  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *          Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_GNSS_CODE_TABLE_H_
+#define GNSS_SDR_GNSS_CODE_TABLE_H_
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+
+/*!
+ * \brief Holds the chips of a set of codes as bits, one bit per chip, set
+ * when the chip is -1.
+ *
+ * The code generators fill a table once per process, the first time a code
+ * of the signal is requested, and from then on produce the codes by
+ * expanding its bits.
+ */
+class Gnss_Code_Table
+{
+public:
+    /*!
+     * \brief Makes a table of \p n_codes codes of \p length_chips chips, all of them +1.
+     */
+    Gnss_Code_Table(uint32_t n_codes, uint32_t length_chips);
+
+    /*!
+     * \brief Sets chip \p chip of code \p code to -1 if \p minus_one, to +1 otherwise.
+     */
+    void set_chip(uint32_t code, uint32_t chip, bool minus_one);
+
+    /*!
+     * \brief Sets the chips of code \p code from its hexadecimal representation,
+     * four chips per character, the most significant bit first. The bits beyond
+     * the length of the code are ignored.
+     */
+    void set_hex(uint32_t code, const std::string& hex);
+
+    /*!
+     * \brief Returns chip \p chip of code \p code, +1 or -1.
+     */
+    inline int32_t chip(uint32_t code, uint32_t chip) const
+    {
+        return 1 - 2 * static_cast<int32_t>((d_bits[code * d_words_per_code + (chip >> 6)] >> (chip & 63)) & 1);
+    }
+
+    /*!
+     * \brief Writes the chips of code \p code to \p dest as +1 or -1, starting
+     * with chip \p chip_shift and wrapping around at the end of the code.
+     */
+    template <typename T>
+    void unpack(T* dest, uint32_t code, uint32_t chip_shift = 0) const
+    {
+        uint32_t first = chip_shift % d_length_chips;
+        unpack_range(dest, code, first, d_length_chips - first);
+        unpack_range(dest + d_length_chips - first, code, 0, first);
+    }
+
+    /*!
+     * \brief Writes the chips of code \p code to \p dest, \p samples_per_chip
+     * samples per chip, each one the chip times the corresponding sample of
+     * \p subcarrier. A BOC or CBOC replica is made in a single pass.
+     */
+    template <typename T>
+    void unpack_modulated(T* dest, uint32_t code, const T* subcarrier, uint32_t samples_per_chip) const
+    {
+        const uint64_t* bits = d_bits.data() + code * d_words_per_code;
+        for (uint32_t chip = 0; chip < d_length_chips; chip++)
+            {
+                const T sign = static_cast<T>(1 - 2 * static_cast<int32_t>((bits[chip >> 6] >> (chip & 63)) & 1));
+                T* samples = dest + chip * samples_per_chip;
+                for (uint32_t k = 0; k < samples_per_chip; k++)
+                    {
+                        samples[k] = sign * subcarrier[k];
+                    }
+            }
+    }
+
+    inline uint32_t n_codes() const { return d_n_codes; }
+    inline uint32_t length_chips() const { return d_length_chips; }
+
+private:
+    template <typename T>
+    void unpack_range(T* dest, uint32_t code, uint32_t first, uint32_t count) const
+    {
+        const uint64_t* bits = d_bits.data() + code * d_words_per_code;
+        for (uint32_t n = 0; n < count; n++)
+            {
+                uint32_t chip = first + n;
+                dest[n] = static_cast<T>(1 - 2 * static_cast<int32_t>((bits[chip >> 6] >> (chip & 63)) & 1));
+            }
+    }
+
+    uint32_t d_n_codes;
+    uint32_t d_length_chips;
+    uint32_t d_words_per_code;
+    std::vector<uint64_t> d_bits;
+};
+
+#endif
@@ -0,0 +1,263 @@
+/*!
+ * \file gnss_dump_policy.cc
+ * \brief Decimation, channel and PRN filters and event-triggered mode of the
+ * dump files of the tracking, telemetry decoder and observables blocks
+ *
+ * -------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2019  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *          Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------
+ */
+
+#include "gnss_dump_policy.h"
+#include "configuration_interface.h"
+#include <glog/logging.h>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <sstream>
+#include <utility>
+
+
+namespace
+{
+const double CN0_AVERAGE_ALPHA = 0.05;  // weight of a new C/N0 estimation in the recent average
+
+// List of numbers and ranges, e.g. "0,2,4-7"
+template <typename T>
+std::vector<T> parse_list(const std::string& list, const std::string& what)
+{
+    std::vector<T> values;
+    std::stringstream ss(list);
+    std::string item;
+    while (std::getline(ss, item, ','))
+        {
+            if (item.empty())
+                {
+                    continue;
+                }
+            try
+                {
+                    size_t dash = item.find('-', 1);
+                    int64_t first = std::stoll(item.substr(0, dash));
+                    int64_t last = (dash == std::string::npos) ? first : std::stoll(item.substr(dash + 1));
+                    for (int64_t value = first; value <= last; value++)
+                        {
+                            values.push_back(static_cast<T>(value));
+                        }
+                }
+            catch (const std::exception& e)
+                {
+                    LOG(WARNING) << "Malformed " << what << " list " << list << ": " << e.what() << ", dumping all of them";
+                    return std::vector<T>();
+                }
+        }
+    return values;
+}
+}  // namespace
+
+
+std::atomic<uint64_t> Gnss_Dump_Policy::operator_triggers(0);
+
+
+Gnss_Dump_Policy_Conf::Gnss_Dump_Policy_Conf()
+{
+    decimation = 1;
+    triggered = false;
+    pre_trigger_s = 10.0;
+    post_trigger_s = 10.0;
+    cn0_drop_db = 0.0;
+}
+
+
+Gnss_Dump_Policy_Conf gnss_dump_policy_conf(ConfigurationInterface* configuration, const std::string& role)
+{
+    Gnss_Dump_Policy_Conf conf;
+    conf.decimation = static_cast<uint32_t>(std::max(configuration->property(role + ".dump_decimation", 1), 1));
+    conf.channels = parse_list<int32_t>(configuration->property(role + ".dump_channels", std::string("")), "channel");
+    conf.prns = parse_list<uint32_t>(configuration->property(role + ".dump_prns", std::string("")), "PRN");
+    std::string mode = configuration->property(role + ".dump_mode", std::string("continuous"));
+    if (mode == "triggered")
+        {
+            conf.triggered = true;
+        }
+    else if (mode != "continuous")
+        {
+            LOG(WARNING) << mode << " unrecognized dump mode for " << role << ", using continuous";
+        }
+    conf.pre_trigger_s = std::max(configuration->property(role + ".dump_pre_trigger_s", conf.pre_trigger_s), 0.0);
+    conf.post_trigger_s = std::max(configuration->property(role + ".dump_post_trigger_s", conf.post_trigger_s), 0.0);
+    conf.cn0_drop_db = configuration->property(role + ".dump_cn0_drop_db", conf.cn0_drop_db);
+    return conf;
+}
+
+
+Gnss_Dump_Policy::Gnss_Dump_Policy(const Gnss_Dump_Policy_Conf& conf) : d_conf(conf),
+                                                                         d_record_bytes(0),
+                                                                         d_channel_selected(true),
+                                                                         d_count(0),
+                                                                         d_ring_records(0),
+                                                                         d_ring_head(0),
+                                                                         d_ring_size(0),
+                                                                         d_write_until_s(-1.0),
+                                                                         d_operator_triggers(operator_triggers.load()),
+                                                                         d_cn0_prn(0),
+                                                                         d_cn0_average(0.0),
+                                                                         d_cn0_drop(false)
+{
+    d_conf.decimation = std::max(d_conf.decimation, 1U);
+}
+
+
+void Gnss_Dump_Policy::set_writer(const std::string& name, size_t record_bytes, double records_per_second, std::function<void(const char*)> writer)
+{
+    d_name = name;
+    d_record_bytes = record_bytes;
+    d_writer = std::move(writer);
+    if (d_conf.triggered)
+        {
+            d_ring_records = ring_records(records_per_second);
+            d_ring.assign(d_ring_records * d_record_bytes, 0);
+            d_ring_time.assign(d_ring_records, 0.0);
+            d_ring_head = 0;
+            d_ring_size = 0;
+        }
+}
+
+
+bool Gnss_Dump_Policy::channel_selected(int32_t channel) const
+{
+    return d_conf.channels.empty() or (std::find(d_conf.channels.cbegin(), d_conf.channels.cend(), channel) != d_conf.channels.cend());
+}
+
+
+void Gnss_Dump_Policy::dump(const void* record, double time_s, uint32_t prn)
+{
+    if (!d_channel_selected or !d_writer)
+        {
+            return;
+        }
+    if ((prn != 0) and !d_conf.prns.empty() and (std::find(d_conf.prns.cbegin(), d_conf.prns.cend(), prn) == d_conf.prns.cend()))
+        {
+            return;
+        }
+    if ((d_count++ % d_conf.decimation) != 0)
+        {
+            return;
+        }
+    if (!d_conf.triggered)
+        {
+            d_writer(static_cast<const char*>(record));
+            return;
+        }
+
+    uint64_t triggers = operator_triggers.load(std::memory_order_relaxed);
+    if (triggers != d_operator_triggers)
+        {
+            d_operator_triggers = triggers;
+            trigger("operator command", time_s);
+        }
+    if (time_s <= d_write_until_s)
+        {
+            d_writer(static_cast<const char*>(record));
+            return;
+        }
+    memcpy(&d_ring[d_ring_head * d_record_bytes], record, d_record_bytes);
+    d_ring_time[d_ring_head] = time_s;
+    d_ring_head = (d_ring_head + 1) % d_ring_records;
+    d_ring_size = std::min(d_ring_size + 1, d_ring_records);
+}
+
+
+void Gnss_Dump_Policy::flush_ring(double from_s)
+{
+    size_t first = (d_ring_head + d_ring_records - d_ring_size) % d_ring_records;
+    for (size_t n = 0; n < d_ring_size; n++)
+        {
+            size_t index = (first + n) % d_ring_records;
+            if (d_ring_time[index] >= from_s)
+                {
+                    d_writer(&d_ring[index * d_record_bytes]);
+                }
+        }
+    d_ring_size = 0;
+}
+
+
+void Gnss_Dump_Policy::trigger(const std::string& reason, double time_s)
+{
+    if (!d_conf.triggered or !d_channel_selected or !d_writer)
+        {
+            return;
+        }
+    LOG(INFO) << "Dump of " << d_name << " triggered at " << time_s << " s: " << reason;
+    flush_ring(time_s - d_conf.pre_trigger_s);
+    d_write_until_s = std::max(d_write_until_s, time_s + d_conf.post_trigger_s);
+}
+
+
+void Gnss_Dump_Policy::check_cn0(double cn0_db_hz, double time_s, uint32_t prn)
+{
+    if (!d_conf.triggered or (d_conf.cn0_drop_db <= 0.0))
+        {
+            return;
+        }
+    if (prn != d_cn0_prn)
+        {
+            // a new satellite
+            d_cn0_prn = prn;
+            d_cn0_average = cn0_db_hz;
+            d_cn0_drop = false;
+            return;
+        }
+    bool drop = (d_cn0_average - cn0_db_hz) > d_conf.cn0_drop_db;
+    if (drop and !d_cn0_drop)
+        {
+            std::stringstream reason;
+            reason << "C/N0 drop to " << cn0_db_hz << " dB-Hz from " << d_cn0_average << " dB-Hz";
+            trigger(reason.str(), time_s);
+        }
+    d_cn0_drop = drop;
+    d_cn0_average += CN0_AVERAGE_ALPHA * (cn0_db_hz - d_cn0_average);
+}
+
+
+size_t Gnss_Dump_Policy::ring_records(double records_per_second) const
+{
+    if (!d_conf.triggered)
+        {
+            return 0;
+        }
+    return static_cast<size_t>(std::ceil(d_conf.pre_trigger_s * records_per_second / static_cast<double>(d_conf.decimation))) + 1;
+}
+
+
+size_t Gnss_Dump_Policy::ring_bytes() const
+{
+    return d_ring.size() + d_ring_time.size() * sizeof(double);
+}
+
+
+void Gnss_Dump_Policy::trigger_all()
+{
+    operator_triggers.fetch_add(1);
+}
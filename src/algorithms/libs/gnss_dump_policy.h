@@ -0,0 +1,172 @@
+/*!
+ * \file gnss_dump_policy.h
+ * \brief Decimation, channel and PRN filters and event-triggered mode of the
+ * dump files of the tracking, telemetry decoder and observables blocks
+ *
+ * -------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2019  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *          Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_GNSS_DUMP_POLICY_H_
+#define GNSS_SDR_GNSS_DUMP_POLICY_H_
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+class ConfigurationInterface;
+
+
+/*!
+ * \brief Which dump records are written, read from role.dump_decimation,
+ * role.dump_channels, role.dump_prns, role.dump_mode, role.dump_pre_trigger_s,
+ * role.dump_post_trigger_s and role.dump_cn0_drop_db
+ */
+struct Gnss_Dump_Policy_Conf
+{
+    uint32_t decimation;            // one out of every decimation records
+    std::vector<int32_t> channels;  // only these channels, all if empty
+    std::vector<uint32_t> prns;     // only these satellites, all if empty
+    bool triggered;                 // keep the last records in memory, and write them only on events
+    double pre_trigger_s;           // time kept in memory before an event
+    double post_trigger_s;          // time written after an event
+    double cn0_drop_db;             // a C/N0 drop larger than this is an event (0: disabled)
+
+    Gnss_Dump_Policy_Conf();
+};
+
+/*!
+ * \brief Reads the dump policy of the block with role \p role
+ */
+Gnss_Dump_Policy_Conf gnss_dump_policy_conf(ConfigurationInterface* configuration, const std::string& role);
+
+
+/*!
+ * \brief Decides which dump records of a block reach the disk.
+ *
+ * By default, all of them are written, as before. With a decimation, one out
+ * of every decimation records of the selected channels and satellites is.
+ * In the triggered mode, the records go to a ring in memory with the last
+ * pre_trigger_s seconds, and nothing is written until an event: then the ring
+ * is written, followed by the records of the next post_trigger_s seconds.
+ * The events are raised by the block (loss of lock, cycle slip, loss of the
+ * frame sync), by a drop of the C/N0, or by the operator with
+ * trigger_all() (the dump_trigger command of the TCP command interface).
+ *
+ * A policy is used by the thread of its block only.
+ */
+class Gnss_Dump_Policy
+{
+public:
+    explicit Gnss_Dump_Policy(const Gnss_Dump_Policy_Conf& conf = Gnss_Dump_Policy_Conf());
+
+    /*!
+     * \brief Sets the function that writes a record of \p record_bytes
+     * bytes, and the highest rate of the records (it sizes the ring).
+     * \p name identifies the dump in the log.
+     */
+    void set_writer(const std::string& name, size_t record_bytes, double records_per_second, std::function<void(const char*)> writer);
+
+    /*!
+     * \brief False if the records of \p channel are never written
+     */
+    bool channel_selected(int32_t channel) const;
+
+    /*!
+     * \brief Sets the channel of the next records
+     */
+    inline void set_channel(int32_t channel)
+    {
+        d_channel_selected = channel_selected(channel);
+    }
+
+    /*!
+     * \brief Passes a record, from the satellite \p prn (0 if the record is
+     * not about a single satellite) at receiver time \p time_s, to the writer
+     * if the policy lets it through
+     */
+    void dump(const void* record, double time_s, uint32_t prn = 0);
+
+    /*!
+     * \brief Event of the block, at receiver time \p time_s
+     */
+    void trigger(const std::string& reason, double time_s);
+
+    /*!
+     * \brief Raises an event if the C/N0 drops more than cn0_drop_db below
+     * its recent average
+     */
+    void check_cn0(double cn0_db_hz, double time_s, uint32_t prn);
+
+    inline bool triggered_mode() const
+    {
+        return d_conf.triggered;
+    }
+
+    /*!
+     * \brief Records kept in the pre-trigger ring for records arriving at
+     * \p records_per_second (0 if the mode is not triggered)
+     */
+    size_t ring_records(double records_per_second) const;
+
+    /*!
+     * \brief Bytes of the pre-trigger ring
+     */
+    size_t ring_bytes() const;
+
+    /*!
+     * \brief Raises an event in all the dumps, on their next record
+     */
+    static void trigger_all();
+
+private:
+    void flush_ring(double from_s);
+
+    Gnss_Dump_Policy_Conf d_conf;
+    std::string d_name;
+    size_t d_record_bytes;
+    std::function<void(const char*)> d_writer;
+    bool d_channel_selected;
+    uint64_t d_count;
+
+    // pre-trigger ring
+    std::vector<char> d_ring;
+    std::vector<double> d_ring_time;
+    size_t d_ring_records;
+    size_t d_ring_head;  // next record
+    size_t d_ring_size;  // records in the ring
+    double d_write_until_s;
+    uint64_t d_operator_triggers;
+
+    uint32_t d_cn0_prn;
+    double d_cn0_average;
+    bool d_cn0_drop;
+
+    static std::atomic<uint64_t> operator_triggers;
+};
+
+#endif
@@ -0,0 +1,161 @@
+/*!
+ * \file gnss_fft.cc
+ * \brief FFT backends of the acquisition blocks
+ *
+ * -------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2019  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *          Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------
+ */
+
+#include "gnss_fft.h"
+#include "configuration_interface.h"
+#include <glog/logging.h>
+#include <gnuradio/fft/fft.h>
+#include <fftw3.h>
+#include <algorithm>
+#include <new>
+#include <stdexcept>
+
+
+Gnss_Fft_Conf::Gnss_Fft_Conf()
+{
+    backend = "gnuradio";
+    threads = 1;
+    plan_effort = "measure";
+}
+
+
+Gnss_Fft_Conf gnss_fft_conf(ConfigurationInterface* configuration, const std::string& role)
+{
+    Gnss_Fft_Conf conf;
+    conf.backend = configuration->property(role + ".fft_backend", conf.backend);
+    if (conf.backend != "gnuradio" and conf.backend != "fftw")
+        {
+            LOG(WARNING) << conf.backend << " unrecognized FFT backend for " << role << ", using gnuradio";
+            conf.backend = "gnuradio";
+        }
+    conf.threads = std::max(configuration->property(role + ".fft_threads", conf.threads), 1);
+    conf.plan_effort = configuration->property(role + ".fft_plan_effort", conf.plan_effort);
+    if (conf.plan_effort != "estimate" and conf.plan_effort != "measure" and conf.plan_effort != "patient" and conf.plan_effort != "exhaustive")
+        {
+            LOG(WARNING) << conf.plan_effort << " unrecognized FFT plan effort for " << role << ", using measure";
+            conf.plan_effort = "measure";
+        }
+    return conf;
+}
+
+
+Gnss_Fft::Gnss_Fft(int32_t fft_size, bool forward, const Gnss_Fft_Conf& conf) : d_fft_size(fft_size),
+                                                                                   d_plan(nullptr),
+                                                                                   d_inbuf(nullptr),
+                                                                                   d_outbuf(nullptr)
+{
+    int32_t threads = std::max(conf.threads, 1);
+    if (conf.backend != "fftw")
+        {
+            d_gr_fft = std::unique_ptr<gr::fft::fft_complex>(new gr::fft::fft_complex(fft_size, forward, threads));
+            d_inbuf = d_gr_fft->get_inbuf();
+            d_outbuf = d_gr_fft->get_outbuf();
+            return;
+        }
+
+    unsigned flags = FFTW_MEASURE;
+    if (conf.plan_effort == "estimate")
+        {
+            flags = FFTW_ESTIMATE;
+        }
+    else if (conf.plan_effort == "patient")
+        {
+            flags = FFTW_PATIENT;
+        }
+    else if (conf.plan_effort == "exhaustive")
+        {
+            flags = FFTW_EXHAUSTIVE;
+        }
+    d_inbuf = reinterpret_cast<gr_complex*>(fftwf_malloc(sizeof(fftwf_complex) * fft_size));
+    d_outbuf = reinterpret_cast<gr_complex*>(fftwf_malloc(sizeof(fftwf_complex) * fft_size));
+    if (d_inbuf == nullptr or d_outbuf == nullptr)
+        {
+            fftwf_free(d_inbuf);
+            fftwf_free(d_outbuf);
+            throw std::bad_alloc();
+        }
+
+    // The FFTW planner is not thread-safe, share the GNU Radio lock with the fft_complex constructors
+    gr::fft::planner::scoped_lock lock(gr::fft::planner::mutex());
+#if HAVE_FFTW3F_THREADS
+    static bool threads_initialized = false;
+    if (!threads_initialized)
+        {
+            fftwf_init_threads();
+            threads_initialized = true;
+        }
+    fftwf_plan_with_nthreads(threads);
+#else
+    if (threads > 1)
+        {
+            LOG(WARNING) << "This build has no multithreaded FFTW, the fftw backend uses one thread per FFT";
+        }
+#endif
+    // Planning with a measuring effort overwrites the buffers, they are filled afterwards
+    d_plan = fftwf_plan_dft_1d(fft_size,
+        reinterpret_cast<fftwf_complex*>(d_inbuf),
+        reinterpret_cast<fftwf_complex*>(d_outbuf),
+        forward ? FFTW_FORWARD : FFTW_BACKWARD,
+        flags);
+#if HAVE_FFTW3F_THREADS
+    fftwf_plan_with_nthreads(1);
+#endif
+    if (d_plan == nullptr)
+        {
+            fftwf_free(d_inbuf);
+            fftwf_free(d_outbuf);
+            throw std::runtime_error("Unable to create the FFTW plan of " + std::to_string(fft_size) + " points");
+        }
+    std::fill_n(d_inbuf, fft_size, gr_complex(0.0, 0.0));
+}
+
+
+Gnss_Fft::~Gnss_Fft()
+{
+    if (d_plan != nullptr)
+        {
+            gr::fft::planner::scoped_lock lock(gr::fft::planner::mutex());
+            fftwf_destroy_plan(static_cast<fftwf_plan>(d_plan));
+            fftwf_free(d_inbuf);
+            fftwf_free(d_outbuf);
+        }
+}
+
+
+void Gnss_Fft::execute()
+{
+    if (d_gr_fft)
+        {
+            d_gr_fft->execute();
+        }
+    else
+        {
+            fftwf_execute(static_cast<fftwf_plan>(d_plan));
+        }
+}
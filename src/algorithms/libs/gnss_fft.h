@@ -0,0 +1,118 @@
+/*!
+ * \file gnss_fft.h
+ * \brief FFT backends of the acquisition blocks
+ *
+ * -------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2019  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *          Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_GNSS_FFT_H_
+#define GNSS_SDR_GNSS_FFT_H_
+
+#include <gnuradio/gr_complex.h>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+namespace gr
+{
+namespace fft
+{
+class fft_complex;
+}
+}  // namespace gr
+
+class ConfigurationInterface;
+
+
+/*!
+ * \brief FFT backend of a block, read from role.fft_backend, role.fft_threads
+ * and role.fft_plan_effort
+ */
+struct Gnss_Fft_Conf
+{
+    std::string backend;      // "gnuradio" (gr::fft::fft_complex) or "fftw" (FFTW plans made by GNSS-SDR)
+    int32_t threads;          // threads of each transform
+    std::string plan_effort;  // "estimate", "measure", "patient" or "exhaustive", only with the fftw backend
+
+    Gnss_Fft_Conf();
+};
+
+/*!
+ * \brief Reads the FFT backend of the block with role \p role
+ */
+Gnss_Fft_Conf gnss_fft_conf(ConfigurationInterface* configuration, const std::string& role);
+
+
+/*!
+ * \brief Complex FFT of a fixed size, with the interface of gr::fft::fft_complex.
+ *
+ * The gnuradio backend, the default one, is a gr::fft::fft_complex, planned by
+ * GNU Radio with FFTW_MEASURE. The fftw backend plans the transform with the
+ * effort of the configuration: "estimate" starts at once and keeps no measured
+ * plans in memory, which suits small targets, while "patient" and "exhaustive"
+ * find faster plans for the long FFTs of long coherent integrations, at the
+ * cost of a longer start (the FFTW wisdom file keeps them for the next runs).
+ * Both backends can split each transform among several threads, which pays off
+ * only for FFTs of tens of thousands of points or more. A build linked to an
+ * FFTW-compatible library, such as the FFTW3 interface of Intel MKL, uses it
+ * through both backends.
+ */
+class Gnss_Fft
+{
+public:
+    Gnss_Fft(int32_t fft_size, bool forward, const Gnss_Fft_Conf& conf = Gnss_Fft_Conf());
+    ~Gnss_Fft();
+
+    Gnss_Fft(const Gnss_Fft&) = delete;
+    Gnss_Fft& operator=(const Gnss_Fft&) = delete;
+
+    inline gr_complex* get_inbuf() const
+    {
+        return d_inbuf;
+    }
+    inline gr_complex* get_outbuf() const
+    {
+        return d_outbuf;
+    }
+    inline int32_t inbuf_length() const
+    {
+        return d_fft_size;
+    }
+    inline int32_t outbuf_length() const
+    {
+        return d_fft_size;
+    }
+
+    void execute();
+
+private:
+    int32_t d_fft_size;
+    std::unique_ptr<gr::fft::fft_complex> d_gr_fft;  // gnuradio backend
+    void* d_plan;                                    // fftwf_plan of the fftw backend
+    gr_complex* d_inbuf;
+    gr_complex* d_outbuf;
+};
+
+#endif  // GNSS_SDR_GNSS_FFT_H_
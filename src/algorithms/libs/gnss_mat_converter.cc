@@ -0,0 +1,316 @@
+/*!
+ * \file gnss_mat_converter.cc
+ * \brief Converts the binary dump files of the processing blocks into
+ * MATLAB .mat files, in chunks and from a background thread.
+ *
+ * -------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2019  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *          Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------
+ */
+
+#include "gnss_mat_converter.h"
+#include <glog/logging.h>
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <utility>
+#if HAVE_ZLIB
+#include <zlib.h>
+#endif
+
+// Appending to the variables of a MAT v7.3 file needs matio 1.5.12
+#if defined(MATIO_VERSION) && (MATIO_VERSION >= 1512)
+#define GNSS_MAT_CONVERTER_APPEND 1
+#else
+#define GNSS_MAT_CONVERTER_APPEND 0
+#endif
+
+
+namespace
+{
+// Plain or (if zlib is available) gzip compressed dump file
+class Dump_Reader
+{
+public:
+    explicit Dump_Reader(const std::string& filename)
+    {
+#if HAVE_ZLIB
+        // gzread() also reads the files that are not compressed
+        d_gz_file = gzopen(filename.c_str(), "rb");
+#else
+        d_file.open(filename.c_str(), std::ios::in | std::ios::binary);
+#endif
+    }
+
+    ~Dump_Reader()
+    {
+#if HAVE_ZLIB
+        if (d_gz_file != nullptr)
+            {
+                gzclose(d_gz_file);
+            }
+#endif
+    }
+
+    bool is_open() const
+    {
+#if HAVE_ZLIB
+        return d_gz_file != nullptr;
+#else
+        return d_file.is_open();
+#endif
+    }
+
+    // Returns the number of bytes read, less than requested only at the end of the file
+    size_t read(char* data, size_t bytes)
+    {
+        size_t total = 0;
+#if HAVE_ZLIB
+        while (total < bytes)
+            {
+                int n = gzread(d_gz_file, data + total, static_cast<unsigned>(std::min<size_t>(bytes - total, 1U << 30U)));
+                if (n <= 0)
+                    {
+                        break;
+                    }
+                total += static_cast<size_t>(n);
+            }
+#else
+        d_file.read(data, bytes);
+        total = static_cast<size_t>(d_file.gcount());
+#endif
+        return total;
+    }
+
+    void rewind()
+    {
+#if HAVE_ZLIB
+        gzrewind(d_gz_file);
+#else
+        d_file.clear();
+        d_file.seekg(0, std::ios::beg);
+#endif
+    }
+
+private:
+#if HAVE_ZLIB
+    gzFile d_gz_file;
+#else
+    std::ifstream d_file;
+#endif
+};
+
+
+// Copies the values of field f of n records, in column-major order (groups x n)
+void extract_field(const std::vector<char>& records, size_t n, size_t record_bytes, size_t group_bytes, size_t groups, size_t offset, size_t bytes, char* column)
+{
+    for (size_t r = 0; r < n; r++)
+        {
+            const char* record = records.data() + r * record_bytes + offset;
+            for (size_t g = 0; g < groups; g++)
+                {
+                    std::memcpy(column, record + g * group_bytes, bytes);
+                    column += bytes;
+                }
+        }
+}
+
+
+bool write_variable(mat_t* matfp, const Gnss_Mat_Converter::Field& field, size_t groups, size_t n, char* data, bool append)
+{
+    size_t dims[2] = {groups, n};
+    matvar_t* matvar = Mat_VarCreate(field.name.c_str(), field.class_type, field.data_type, 2, dims, data, MAT_F_DONT_COPY_DATA);
+    if (matvar == nullptr)
+        {
+            return false;
+        }
+#if GNSS_MAT_CONVERTER_APPEND
+    int result = append ? Mat_VarWriteAppend(matfp, matvar, MAT_COMPRESSION_ZLIB, 2) : Mat_VarWrite(matfp, matvar, MAT_COMPRESSION_ZLIB);
+#else
+    (void)append;
+    int result = Mat_VarWrite(matfp, matvar, MAT_COMPRESSION_ZLIB);
+#endif
+    Mat_VarFree(matvar);
+    return result == 0;
+}
+}  // namespace
+
+
+std::shared_ptr<Gnss_Mat_Converter> Gnss_Mat_Converter::get_instance()
+{
+    static std::mutex registry_mutex;
+    static std::weak_ptr<Gnss_Mat_Converter> registry;
+
+    std::lock_guard<std::mutex> lock(registry_mutex);
+    std::shared_ptr<Gnss_Mat_Converter> converter = registry.lock();
+    if (!converter)
+        {
+            converter = std::make_shared<Gnss_Mat_Converter>();
+            registry = converter;
+        }
+    return converter;
+}
+
+
+Gnss_Mat_Converter::Gnss_Mat_Converter()
+{
+    d_stop = false;
+    d_thread = std::thread(&Gnss_Mat_Converter::run, this);
+}
+
+
+Gnss_Mat_Converter::~Gnss_Mat_Converter()
+{
+    {
+        std::lock_guard<std::mutex> lock(d_mutex);
+        d_stop = true;
+    }
+    d_cond.notify_one();
+    d_thread.join();
+}
+
+
+void Gnss_Mat_Converter::convert(const std::string& dump_filename, const std::string& mat_filename, const std::vector<Field>& fields, size_t groups)
+{
+    {
+        std::lock_guard<std::mutex> lock(d_mutex);
+        d_jobs.push_back(Job{dump_filename, mat_filename, fields, groups});
+    }
+    d_cond.notify_one();
+}
+
+
+void Gnss_Mat_Converter::run()
+{
+    std::unique_lock<std::mutex> lock(d_mutex);
+    while (true)
+        {
+            d_cond.wait(lock, [this] { return d_stop or !d_jobs.empty(); });
+            if (d_jobs.empty())
+                {
+                    // stopped, and all the pending files are already converted
+                    return;
+                }
+            Job job = std::move(d_jobs.front());
+            d_jobs.pop_front();
+            lock.unlock();
+            if (convert_file(job.dump_filename, job.mat_filename, job.fields, job.groups))
+                {
+                    LOG(INFO) << "Generated " << job.mat_filename;
+                }
+            else
+                {
+                    std::cerr << "Problem generating " << job.mat_filename << " from " << job.dump_filename << std::endl;
+                }
+            lock.lock();
+        }
+}
+
+
+bool Gnss_Mat_Converter::convert_file(const std::string& dump_filename, const std::string& mat_filename, const std::vector<Field>& fields, size_t groups, size_t chunk_records)
+{
+    std::vector<size_t> offsets;
+    size_t group_bytes = 0;
+    for (const auto& field : fields)
+        {
+            offsets.push_back(group_bytes);
+            group_bytes += field.bytes;
+        }
+    size_t record_bytes = group_bytes * groups;
+    if ((record_bytes == 0) or (chunk_records == 0))
+        {
+            return false;
+        }
+    Dump_Reader dump_file(dump_filename);
+    if (!dump_file.is_open())
+        {
+            return false;
+        }
+    mat_t* matfp = Mat_CreateVer(mat_filename.c_str(), nullptr, MAT_FT_MAT73);
+    if (matfp == nullptr)
+        {
+            return false;
+        }
+
+    bool ok = true;
+    std::vector<char> records(chunk_records * record_bytes);
+#if GNSS_MAT_CONVERTER_APPEND
+    // A single pass, appending each chunk of records to all the variables
+    std::vector<std::vector<char> > columns;
+    for (const auto& field : fields)
+        {
+            columns.emplace_back(chunk_records * groups * field.bytes);
+        }
+    size_t total = 0;
+    size_t n = 0;
+    do
+        {
+            n = dump_file.read(records.data(), records.size()) / record_bytes;
+            if ((n == 0) and (total > 0))
+                {
+                    break;
+                }
+            // an empty dump still gets its (empty) variables, that cannot be appended to
+            for (size_t f = 0; f < fields.size() and ok; f++)
+                {
+                    extract_field(records, n, record_bytes, group_bytes, groups, offsets[f], fields[f].bytes, columns[f].data());
+                    ok = write_variable(matfp, fields[f], groups, n, columns[f].data(), n > 0);
+                }
+            total += n;
+        }
+    while ((n == chunk_records) and ok);
+#else
+    // Without appending, one pass per variable, holding only that variable
+    size_t total = 0;
+    size_t n = 0;
+    while ((n = dump_file.read(records.data(), records.size()) / record_bytes) > 0)
+        {
+            total += n;
+            if (n < chunk_records)
+                {
+                    break;
+                }
+        }
+    for (size_t f = 0; f < fields.size() and ok; f++)
+        {
+            std::vector<char> column(total * groups * fields[f].bytes);
+            dump_file.rewind();
+            size_t done = 0;
+            while (done < total)
+                {
+                    n = std::min(dump_file.read(records.data(), records.size()) / record_bytes, total - done);
+                    if (n == 0)
+                        {
+                            break;
+                        }
+                    extract_field(records, n, record_bytes, group_bytes, groups, offsets[f], fields[f].bytes, column.data() + done * groups * fields[f].bytes);
+                    done += n;
+                }
+            ok = write_variable(matfp, fields[f], groups, total, column.data(), false);
+        }
+#endif
+    Mat_Close(matfp);
+    DLOG(INFO) << total << " records of " << dump_filename << " converted";
+    return ok;
+}
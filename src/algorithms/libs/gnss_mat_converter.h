@@ -0,0 +1,104 @@
+/*!
+ * \file gnss_mat_converter.h
+ * \brief Converts the binary dump files of the processing blocks into
+ * MATLAB .mat files, in chunks and from a background thread.
+ *
+ * -------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2019  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *          Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_GNSS_MAT_CONVERTER_H_
+#define GNSS_SDR_GNSS_MAT_CONVERTER_H_
+
+#include <matio.h>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+
+/*!
+ * \brief Converts dump files made of fixed-size records into MAT v7.3 files.
+ *
+ * Each record holds \p groups consecutive groups of fields (e.g., one group
+ * per channel), and each field becomes a groups x records variable. The dump
+ * is read a chunk of records at a time, and each chunk is appended to the
+ * variables, so the memory needed does not depend on the length of the dump.
+ * Dumps in gzip format are also accepted when GNSS-SDR is built with zlib.
+ */
+class Gnss_Mat_Converter
+{
+public:
+    struct Field
+    {
+        std::string name;
+        matio_classes class_type;
+        matio_types data_type;
+        size_t bytes;  // size of the value in the record
+    };
+
+    /*!
+     * \brief Returns the converter shared by all the blocks. It is created on
+     * the first request, and released (after converting all the pending
+     * files) when the last block using it is destroyed.
+     */
+    static std::shared_ptr<Gnss_Mat_Converter> get_instance();
+
+    Gnss_Mat_Converter();
+    ~Gnss_Mat_Converter();
+
+    /*!
+     * \brief Queues the conversion of \p dump_filename into \p mat_filename.
+     */
+    void convert(const std::string& dump_filename, const std::string& mat_filename, const std::vector<Field>& fields, size_t groups = 1);
+
+    /*!
+     * \brief Converts \p dump_filename into \p mat_filename in the calling
+     * thread, reading \p chunk_records records at a time.
+     */
+    static bool convert_file(const std::string& dump_filename, const std::string& mat_filename, const std::vector<Field>& fields, size_t groups = 1, size_t chunk_records = 65536);
+
+private:
+    struct Job
+    {
+        std::string dump_filename;
+        std::string mat_filename;
+        std::vector<Field> fields;
+        size_t groups;
+    };
+
+    void run();
+
+    bool d_stop;
+    std::deque<Job> d_jobs;
+    std::mutex d_mutex;
+    std::condition_variable d_cond;
+    std::thread d_thread;
+};
+
+#endif
@@ -0,0 +1,197 @@
+/*!
+ * \file gnss_memory_accounting.cc
+ * \brief Process-wide accounting of the major memory allocations of the
+ * processing blocks, per block role and channel.
+ *
+ * -------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2019  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *          Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------
+ */
+
+#include "gnss_memory_accounting.h"
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <unistd.h>
+#if defined(__GLIBC__)
+#include <malloc.h>
+#endif
+
+
+std::shared_ptr<Gnss_Memory_Accounting> Gnss_Memory_Accounting::get_instance()
+{
+    static std::shared_ptr<Gnss_Memory_Accounting> instance = std::make_shared<Gnss_Memory_Accounting>();
+    return instance;
+}
+
+
+Gnss_Memory_Accounting::Gnss_Memory_Accounting()
+{
+    d_next_id = 0;
+}
+
+
+uint64_t Gnss_Memory_Accounting::add_block(const std::string& block)
+{
+    std::lock_guard<std::mutex> lock(d_mutex);
+    uint64_t id = d_next_id++;
+    Entry& entry = d_entries[id];
+    entry.block = block;
+    entry.channel = -1;
+    return id;
+}
+
+
+void Gnss_Memory_Accounting::remove_block(uint64_t id)
+{
+    std::lock_guard<std::mutex> lock(d_mutex);
+    d_entries.erase(id);
+}
+
+
+void Gnss_Memory_Accounting::set_channel(uint64_t id, int32_t channel)
+{
+    std::lock_guard<std::mutex> lock(d_mutex);
+    d_entries[id].channel = channel;
+}
+
+
+void Gnss_Memory_Accounting::set_bytes(uint64_t id, const std::string& category, size_t bytes)
+{
+    std::lock_guard<std::mutex> lock(d_mutex);
+    d_entries[id].bytes[category] = bytes;
+}
+
+
+std::map<std::string, std::map<std::string, size_t>> Gnss_Memory_Accounting::get_bytes()
+{
+    std::map<std::string, std::map<std::string, size_t>> bytes;
+    std::lock_guard<std::mutex> lock(d_mutex);
+    for (const auto& entry : d_entries)
+        {
+            std::string labels = "block=\"" + entry.second.block + "\"";
+            if (entry.second.channel >= 0)
+                {
+                    labels += ",channel=\"" + std::to_string(entry.second.channel) + "\"";
+                }
+            for (const auto& category : entry.second.bytes)
+                {
+                    bytes[labels][category.first] += category.second;
+                }
+        }
+    return bytes;
+}
+
+
+std::string Gnss_Memory_Accounting::report(const std::map<std::string, std::map<std::string, size_t>>& other_bytes)
+{
+    std::map<std::string, std::map<std::string, size_t>> bytes = get_bytes();
+    for (const auto& block : other_bytes)
+        {
+            for (const auto& category : block.second)
+                {
+                    bytes[block.first][category.first] += category.second;
+                }
+        }
+
+    auto kib = [](size_t b) { return static_cast<double>(b) / 1024.0; };
+    std::stringstream report;
+    report << std::fixed << std::setprecision(1);
+    report << "Memory footprint of the blocks, in KiB:\n";
+    std::map<std::string, size_t> totals;
+    size_t total = 0;
+    for (const auto& block : bytes)
+        {
+            size_t block_total = 0;
+            report << "  " << block.first << ":";
+            for (const auto& category : block.second)
+                {
+                    report << " " << category.first << " " << kib(category.second);
+                    totals[category.first] += category.second;
+                    block_total += category.second;
+                }
+            report << " (total " << kib(block_total) << ")\n";
+            total += block_total;
+        }
+    report << "  All the blocks:";
+    for (const auto& category : totals)
+        {
+            report << " " << category.first << " " << kib(category.second);
+        }
+    report << " (total " << kib(total) << ")\n";
+    report << "Resident set size of the process: " << kib(resident_set_bytes()) << " KiB, heap in use: " << kib(heap_in_use_bytes()) << " KiB\n";
+    return report.str();
+}
+
+
+size_t Gnss_Memory_Accounting::resident_set_bytes()
+{
+    // Second field of /proc/self/statm, in pages
+    std::ifstream statm("/proc/self/statm");
+    size_t size_pages = 0;
+    size_t resident_pages = 0;
+    if (statm >> size_pages >> resident_pages)
+        {
+            return resident_pages * static_cast<size_t>(sysconf(_SC_PAGESIZE));
+        }
+    return 0;
+}
+
+
+size_t Gnss_Memory_Accounting::heap_in_use_bytes()
+{
+#if defined(__GLIBC__) && ((__GLIBC__ > 2) || (__GLIBC_MINOR__ >= 33))
+    struct mallinfo2 info = mallinfo2();
+    return info.uordblks + info.hblkhd;
+#elif defined(__GLIBC__)
+    struct mallinfo info = mallinfo();  // wraps around beyond 4 GB
+    return static_cast<size_t>(static_cast<unsigned int>(info.uordblks)) + static_cast<size_t>(static_cast<unsigned int>(info.hblkhd));
+#else
+    return 0;
+#endif
+}
+
+
+Gnss_Memory_Account::Gnss_Memory_Account(const std::string& block)
+{
+    d_accounting = Gnss_Memory_Accounting::get_instance();
+    d_id = d_accounting->add_block(block);
+}
+
+
+Gnss_Memory_Account::~Gnss_Memory_Account()
+{
+    d_accounting->remove_block(d_id);
+}
+
+
+void Gnss_Memory_Account::set_channel(int32_t channel)
+{
+    d_accounting->set_channel(d_id, channel);
+}
+
+
+void Gnss_Memory_Account::set_bytes(const std::string& category, size_t bytes)
+{
+    d_accounting->set_bytes(d_id, category, bytes);
+}
@@ -0,0 +1,111 @@
+/*!
+ * \file gnss_memory_accounting.h
+ * \brief Process-wide accounting of the major memory allocations of the
+ * processing blocks, per block role and channel.
+ *
+ * -------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2019  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *          Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_GNSS_MEMORY_ACCOUNTING_H_
+#define GNSS_SDR_GNSS_MEMORY_ACCOUNTING_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+
+/*!
+ * \brief Registry of the bytes allocated by the blocks, per category
+ * (e.g. "volk", "fft", "history", "dump").
+ *
+ * The blocks update their entries when they allocate or release their
+ * buffers, never in their work calls, so a mutex is enough.
+ */
+class Gnss_Memory_Accounting
+{
+public:
+    static std::shared_ptr<Gnss_Memory_Accounting> get_instance();
+
+    Gnss_Memory_Accounting();
+
+    uint64_t add_block(const std::string& block);  //!< Returns the identifier of a new entry of role \p block (e.g. "tracking")
+    void remove_block(uint64_t id);
+    void set_channel(uint64_t id, int32_t channel);
+    void set_bytes(uint64_t id, const std::string& category, size_t bytes);
+
+    /*!
+     * \brief Bytes per category of each block, keyed by its OpenMetrics labels
+     * (e.g. block="tracking",channel="3"). The entries of the same role and
+     * channel are added up.
+     */
+    std::map<std::string, std::map<std::string, size_t>> get_bytes();
+
+    /*!
+     * \brief Writes a table of the bytes per block and category, adding
+     * \p other_bytes (e.g. the GNU Radio buffers, only known by the flow graph),
+     * with the totals per category and the memory in use by the process.
+     */
+    std::string report(const std::map<std::string, std::map<std::string, size_t>>& other_bytes);
+
+    static size_t resident_set_bytes();  //!< Resident set size of the process, 0 if unknown
+    static size_t heap_in_use_bytes();   //!< Bytes in use in the heap of the allocator, 0 if unknown
+
+private:
+    struct Entry
+    {
+        std::string block;
+        int32_t channel;
+        std::map<std::string, size_t> bytes;
+    };
+
+    std::map<uint64_t, Entry> d_entries;
+    uint64_t d_next_id;
+    std::mutex d_mutex;
+};
+
+
+/*!
+ * \brief Entry of a block in Gnss_Memory_Accounting, removed when it is destroyed
+ */
+class Gnss_Memory_Account
+{
+public:
+    explicit Gnss_Memory_Account(const std::string& block);
+    ~Gnss_Memory_Account();
+
+    Gnss_Memory_Account(const Gnss_Memory_Account&) = delete;
+    Gnss_Memory_Account& operator=(const Gnss_Memory_Account&) = delete;
+
+    void set_channel(int32_t channel);
+    void set_bytes(const std::string& category, size_t bytes);
+
+private:
+    std::shared_ptr<Gnss_Memory_Accounting> d_accounting;
+    uint64_t d_id;
+};
+
+#endif
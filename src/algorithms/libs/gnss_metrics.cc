@@ -0,0 +1,227 @@
+/*!
+ * \file gnss_metrics.cc
+ * \brief Process-wide counters and duration distributions reported by the
+ * processing blocks, exported in the OpenMetrics text format.
+ *
+ * -------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2019  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *          Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------
+ */
+
+#include "gnss_metrics.h"
+#include "gnss_tracking_state_registry.h"
+#include <sstream>
+#include <tuple>
+#include <vector>
+
+
+Gnss_Duration_Histogram::Gnss_Duration_Histogram()
+{
+    for (auto& bucket : d_buckets)
+        {
+            bucket.store(0, std::memory_order_relaxed);
+        }
+    d_count.store(0, std::memory_order_relaxed);
+    d_sum_ns.store(0, std::memory_order_relaxed);
+}
+
+
+void Gnss_Duration_Histogram::record(std::chrono::steady_clock::duration duration)
+{
+    auto duration_ns = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(duration).count());
+    uint64_t duration_us = duration_ns / 1000;
+    int bucket = 0;
+    while ((duration_us > 0) and (bucket < num_buckets - 1))
+        {
+            duration_us >>= 1;
+            bucket++;
+        }
+    d_buckets[bucket].fetch_add(1, std::memory_order_relaxed);
+    d_sum_ns.fetch_add(duration_ns, std::memory_order_relaxed);
+    d_count.fetch_add(1, std::memory_order_relaxed);
+}
+
+
+uint64_t Gnss_Duration_Histogram::count() const
+{
+    return d_count.load(std::memory_order_relaxed);
+}
+
+
+double Gnss_Duration_Histogram::sum_s() const
+{
+    return static_cast<double>(d_sum_ns.load(std::memory_order_relaxed)) * 1e-9;
+}
+
+
+double Gnss_Duration_Histogram::quantile_s(double q) const
+{
+    uint64_t counts[num_buckets];
+    uint64_t total = 0;
+    for (int k = 0; k < num_buckets; k++)
+        {
+            counts[k] = d_buckets[k].load(std::memory_order_relaxed);
+            total += counts[k];
+        }
+    if (total == 0)
+        {
+            return 0.0;
+        }
+    auto rank = static_cast<uint64_t>(q * static_cast<double>(total));
+    uint64_t accumulated = 0;
+    for (int k = 0; k < num_buckets; k++)
+        {
+            accumulated += counts[k];
+            if (accumulated >= rank)
+                {
+                    return static_cast<double>(uint64_t(1) << k) * 1e-6;
+                }
+        }
+    return static_cast<double>(uint64_t(1) << (num_buckets - 1)) * 1e-6;
+}
+
+
+std::shared_ptr<Gnss_Metrics> Gnss_Metrics::get_instance()
+{
+    static std::shared_ptr<Gnss_Metrics> instance = std::make_shared<Gnss_Metrics>();
+    return instance;
+}
+
+
+std::shared_ptr<Gnss_Duration_Histogram> Gnss_Metrics::get_histogram(const std::string& name, const std::string& labels)
+{
+    std::lock_guard<std::mutex> lock(d_mutex);
+    std::shared_ptr<Gnss_Duration_Histogram>& histogram = d_histograms[std::make_pair(name, labels)];
+    if (histogram == nullptr)
+        {
+            histogram = std::make_shared<Gnss_Duration_Histogram>();
+        }
+    return histogram;
+}
+
+
+std::shared_ptr<Gnss_Signal_Counters> Gnss_Metrics::get_signal_counters(const std::string& signal)
+{
+    std::lock_guard<std::mutex> lock(d_mutex);
+    std::shared_ptr<Gnss_Signal_Counters>& counters = d_signal_counters[signal];
+    if (counters == nullptr)
+        {
+            counters = std::make_shared<Gnss_Signal_Counters>();
+        }
+    return counters;
+}
+
+
+std::shared_ptr<std::atomic<uint64_t>> Gnss_Metrics::get_counter(const std::string& name, const std::string& labels)
+{
+    std::lock_guard<std::mutex> lock(d_mutex);
+    std::shared_ptr<std::atomic<uint64_t>>& counter = d_counters[std::make_pair(name, labels)];
+    if (counter == nullptr)
+        {
+            counter = std::make_shared<std::atomic<uint64_t>>(0);
+        }
+    return counter;
+}
+
+
+std::string Gnss_Metrics::to_openmetrics(const std::shared_ptr<Gnss_Tracking_State_Registry>& states)
+{
+    std::stringstream metrics;
+    std::lock_guard<std::mutex> lock(d_mutex);
+
+    std::string last_name;
+    for (const auto& entry : d_histograms)
+        {
+            const std::string& name = entry.first.first;
+            const std::string& labels = entry.first.second;
+            const std::string separator = labels.empty() ? "" : ",";
+            if (name != last_name)
+                {
+                    metrics << "# TYPE " << name << " summary\n";
+                    metrics << "# UNIT " << name << " seconds\n";
+                    last_name = name;
+                }
+            metrics << name << "{" << labels << separator << "quantile=\"0.5\"} " << entry.second->quantile_s(0.5) << "\n";
+            metrics << name << "{" << labels << separator << "quantile=\"0.99\"} " << entry.second->quantile_s(0.99) << "\n";
+            metrics << name << "_sum{" << labels << "} " << entry.second->sum_s() << "\n";
+            metrics << name << "_count{" << labels << "} " << entry.second->count() << "\n";
+        }
+
+    const std::vector<std::pair<std::string, std::atomic<uint64_t> Gnss_Signal_Counters::*>> counters = {
+        {"gnss_sdr_acquisitions", &Gnss_Signal_Counters::acquisitions},
+        {"gnss_sdr_positive_acquisitions", &Gnss_Signal_Counters::positive_acquisitions},
+        {"gnss_sdr_tracking_locks", &Gnss_Signal_Counters::locks},
+        {"gnss_sdr_tracking_losses_of_lock", &Gnss_Signal_Counters::losses_of_lock}};
+    for (const auto& counter : counters)
+        {
+            metrics << "# TYPE " << counter.first << " counter\n";
+            for (const auto& entry : d_signal_counters)
+                {
+                    metrics << counter.first << "_total{signal=\"" << entry.first << "\"} " << ((*entry.second).*counter.second).load(std::memory_order_relaxed) << "\n";
+                }
+        }
+
+    last_name.clear();
+    for (const auto& entry : d_counters)
+        {
+            const std::string& name = entry.first.first;
+            if (name != last_name)
+                {
+                    metrics << "# TYPE " << name << " counter\n";
+                    last_name = name;
+                }
+            metrics << name << "_total{" << entry.first.second << "} " << entry.second->load(std::memory_order_relaxed) << "\n";
+        }
+
+    // Distribution of the CN0 of the signals in tracking, from the last updates of the tracking blocks
+    const std::vector<double> cn0_bounds = {25.0, 30.0, 35.0, 40.0, 45.0, 50.0};
+    std::map<std::string, std::vector<uint64_t>> cn0_buckets;
+    std::map<std::string, double> cn0_sums;
+    for (const auto& state : states->get_states(1.0))
+        {
+            const std::string& signal = std::get<2>(state.first);
+            std::vector<uint64_t>& buckets = cn0_buckets[signal];
+            buckets.resize(cn0_bounds.size() + 1, 0);
+            for (size_t k = 0; k < cn0_bounds.size(); k++)
+                {
+                    if (state.second.cn0_db_hz <= cn0_bounds[k])
+                        {
+                            buckets[k]++;
+                        }
+                }
+            buckets[cn0_bounds.size()]++;
+            cn0_sums[signal] += state.second.cn0_db_hz;
+        }
+    metrics << "# TYPE gnss_sdr_tracking_cn0_db_hz histogram\n";
+    for (const auto& entry : cn0_buckets)
+        {
+            for (size_t k = 0; k < cn0_bounds.size(); k++)
+                {
+                    metrics << "gnss_sdr_tracking_cn0_db_hz_bucket{signal=\"" << entry.first << "\",le=\"" << cn0_bounds[k] << "\"} " << entry.second[k] << "\n";
+                }
+            metrics << "gnss_sdr_tracking_cn0_db_hz_bucket{signal=\"" << entry.first << "\",le=\"+Inf\"} " << entry.second[cn0_bounds.size()] << "\n";
+            metrics << "gnss_sdr_tracking_cn0_db_hz_sum{signal=\"" << entry.first << "\"} " << cn0_sums[entry.first] << "\n";
+            metrics << "gnss_sdr_tracking_cn0_db_hz_count{signal=\"" << entry.first << "\"} " << entry.second[cn0_bounds.size()] << "\n";
+        }
+    return metrics.str();
+}
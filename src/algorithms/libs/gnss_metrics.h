@@ -0,0 +1,126 @@
+/*!
+ * \file gnss_metrics.h
+ * \brief Process-wide counters and duration distributions reported by the
+ * processing blocks, exported in the OpenMetrics text format.
+ *
+ * -------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2019  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *          Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_GNSS_METRICS_H_
+#define GNSS_SDR_GNSS_METRICS_H_
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+
+class Gnss_Tracking_State_Registry;
+
+/*!
+ * \brief Distribution of durations, in power-of-two buckets of microseconds.
+ *
+ * Each histogram is written by the thread of a single block, so recording is
+ * a few relaxed atomic increments, and it can be read from any thread.
+ */
+class Gnss_Duration_Histogram
+{
+public:
+    Gnss_Duration_Histogram();
+
+    void record(std::chrono::steady_clock::duration duration);
+
+    uint64_t count() const;
+
+    double sum_s() const;
+
+    /*!
+     * \brief Upper bound of the bucket that holds the \p q quantile (0 < q <= 1), in seconds
+     */
+    double quantile_s(double q) const;
+
+private:
+    static const int num_buckets = 32;  // bucket k holds durations below 2^k us
+    std::atomic<uint64_t> d_buckets[num_buckets];
+    std::atomic<uint64_t> d_count;
+    std::atomic<uint64_t> d_sum_ns;
+};
+
+
+/*!
+ * \brief Acquisition and tracking events of a signal, counted by all its channels
+ */
+struct Gnss_Signal_Counters
+{
+    std::atomic<uint64_t> acquisitions{0};
+    std::atomic<uint64_t> positive_acquisitions{0};
+    std::atomic<uint64_t> locks{0};
+    std::atomic<uint64_t> losses_of_lock{0};
+};
+
+
+/*!
+ * \brief Registry of the metrics of the receiver. The blocks get their
+ * histograms and counters once, when they are configured, and update them
+ * without locking. to_openmetrics() reads them when metrics are requested.
+ */
+class Gnss_Metrics
+{
+public:
+    static std::shared_ptr<Gnss_Metrics> get_instance();
+
+    /*!
+     * \brief Gets the histogram of metric \p name with the OpenMetrics labels \p labels (e.g. channel="3")
+     */
+    std::shared_ptr<Gnss_Duration_Histogram> get_histogram(const std::string& name, const std::string& labels);
+
+    /*!
+     * \brief Gets the counters of a signal (e.g. "1C")
+     */
+    std::shared_ptr<Gnss_Signal_Counters> get_signal_counters(const std::string& signal);
+
+    /*!
+     * \brief Gets the counter of events \p name (e.g. sample losses of a signal source) with the labels \p labels
+     */
+    std::shared_ptr<std::atomic<uint64_t>> get_counter(const std::string& name, const std::string& labels);
+
+    /*!
+     * \brief Writes the histograms as summaries with their 0.5 and 0.99 quantiles,
+     * the signal counters, the other counters, and the distribution of the CN0
+     * of the signals in tracking recorded in \p states
+     */
+    std::string to_openmetrics(const std::shared_ptr<Gnss_Tracking_State_Registry>& states);
+
+private:
+    std::map<std::pair<std::string, std::string>, std::shared_ptr<Gnss_Duration_Histogram>> d_histograms;
+    std::map<std::string, std::shared_ptr<Gnss_Signal_Counters>> d_signal_counters;
+    std::map<std::pair<std::string, std::string>, std::shared_ptr<std::atomic<uint64_t>>> d_counters;
+    std::mutex d_mutex;
+};
+
+#endif
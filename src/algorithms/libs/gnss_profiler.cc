@@ -0,0 +1,259 @@
+/*!
+ * \file gnss_profiler.cc
+ * \brief Work time and heap allocations of the hot paths of the receiver
+ *
+ * -------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2019  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *          Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------
+ */
+
+#include "gnss_profiler.h"
+#include <algorithm>
+#include <cstdlib>
+#include <iomanip>
+#include <new>
+#include <sstream>
+#include <utility>
+
+
+namespace
+{
+// Plain thread-local counters, so that the allocator hook does not need any initialization
+std::atomic<bool> count_allocations(false);
+thread_local uint64_t allocations = 0;
+thread_local uint64_t allocated_bytes = 0;
+
+void* counted_malloc(std::size_t size)
+{
+    if (count_allocations.load(std::memory_order_relaxed))
+        {
+            allocations++;
+            allocated_bytes += size;
+        }
+    if (size == 0)
+        {
+            size = 1;
+        }
+    void* ptr;
+    while ((ptr = std::malloc(size)) == nullptr)
+        {
+            std::new_handler handler = std::get_new_handler();
+            if (handler == nullptr)
+                {
+                    return nullptr;
+                }
+            handler();
+        }
+    return ptr;
+}
+}  // namespace
+
+
+// Allocator hook. The array, sized and nothrow deletes of the standard
+// library forward to these, and so does its array new.
+void* operator new(std::size_t size)
+{
+    void* ptr = counted_malloc(size);
+    if (ptr == nullptr)
+        {
+            throw std::bad_alloc();
+        }
+    return ptr;
+}
+
+
+void* operator new(std::size_t size, const std::nothrow_t& /*unused*/) noexcept
+{
+    try
+        {
+            return counted_malloc(size);
+        }
+    catch (...)
+        {
+            return nullptr;
+        }
+}
+
+
+void operator delete(void* ptr) noexcept
+{
+    std::free(ptr);
+}
+
+
+std::shared_ptr<Gnss_Profiler> Gnss_Profiler::get_instance()
+{
+    static std::shared_ptr<Gnss_Profiler> instance = std::make_shared<Gnss_Profiler>();
+    return instance;
+}
+
+
+Gnss_Profiler::Gnss_Profiler()
+{
+    d_enabled.store(false, std::memory_order_relaxed);
+}
+
+
+void Gnss_Profiler::enable()
+{
+    count_allocations.store(true, std::memory_order_relaxed);
+    d_enabled.store(true, std::memory_order_relaxed);
+}
+
+
+void Gnss_Profiler::disable()
+{
+    d_enabled.store(false, std::memory_order_relaxed);
+    count_allocations.store(false, std::memory_order_relaxed);
+}
+
+
+Gnss_Profile_Region* Gnss_Profiler::region(const char* name)
+{
+    // a string literal may have a different address in each translation unit:
+    // each thread caches the regions by address, and the profiler matches them by name
+    static thread_local std::vector<std::pair<const char*, Gnss_Profile_Region*>> cache;
+    for (const auto& entry : cache)
+        {
+            if (entry.first == name)
+                {
+                    return entry.second;
+                }
+        }
+    Gnss_Profile_Region* found = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(d_mutex);
+        for (const auto& region : d_regions)
+            {
+                if (region->name == name)
+                    {
+                        found = region.get();
+                        break;
+                    }
+            }
+        if (found == nullptr)
+            {
+                d_regions.push_back(std::unique_ptr<Gnss_Profile_Region>(new Gnss_Profile_Region()));
+                found = d_regions.back().get();
+                found->name = name;
+            }
+    }
+    cache.emplace_back(name, found);
+    return found;
+}
+
+
+std::string Gnss_Profiler::report()
+{
+    std::vector<Gnss_Profile_Region*> regions;
+    {
+        std::lock_guard<std::mutex> lock(d_mutex);
+        for (const auto& region : d_regions)
+            {
+                if (region->work_time.count() > 0)
+                    {
+                        regions.push_back(region.get());
+                    }
+            }
+    }
+    std::sort(regions.begin(), regions.end(), [](const Gnss_Profile_Region* a, const Gnss_Profile_Region* b) { return a->work_time.sum_s() > b->work_time.sum_s(); });
+
+    std::stringstream ss;
+    ss << std::left << std::setw(28) << "Function" << std::right
+       << std::setw(12) << "Calls"
+       << std::setw(12) << "Total [s]"
+       << std::setw(12) << "Mean [us]"
+       << std::setw(12) << "p50 [us]"
+       << std::setw(12) << "p99 [us]"
+       << std::setw(12) << "Alloc/call"
+       << std::setw(12) << "Bytes/call"
+       << std::setw(16) << "Alloc. calls"
+       << std::setw(12) << "Max alloc" << std::endl;
+    ss << std::fixed;
+    for (const auto* region : regions)
+        {
+            uint64_t calls = region->work_time.count();
+            double sum_s = region->work_time.sum_s();
+            uint64_t allocating_calls = region->allocating_calls.load(std::memory_order_relaxed);
+            ss << std::left << std::setw(28) << region->name << std::right
+               << std::setw(12) << calls
+               << std::setw(12) << std::setprecision(3) << sum_s
+               << std::setw(12) << std::setprecision(1) << sum_s * 1e6 / static_cast<double>(calls)
+               << std::setw(12) << std::setprecision(0) << region->work_time.quantile_s(0.5) * 1e6
+               << std::setw(12) << region->work_time.quantile_s(0.99) * 1e6
+               << std::setw(12) << std::setprecision(2) << static_cast<double>(region->allocations.load(std::memory_order_relaxed)) / static_cast<double>(calls)
+               << std::setw(12) << std::setprecision(0) << static_cast<double>(region->allocated_bytes.load(std::memory_order_relaxed)) / static_cast<double>(calls)
+               << std::setw(16) << allocating_calls
+               << std::setw(12) << region->max_allocations.load(std::memory_order_relaxed) << std::endl;
+        }
+    return ss.str();
+}
+
+
+uint64_t Gnss_Profiler::thread_allocations()
+{
+    return allocations;
+}
+
+
+uint64_t Gnss_Profiler::thread_allocated_bytes()
+{
+    return allocated_bytes;
+}
+
+
+Gnss_Profile_Scope::Gnss_Profile_Scope(const char* name)
+{
+    // a plain pointer, so the scopes do not touch the shared reference count
+    static Gnss_Profiler* profiler = Gnss_Profiler::get_instance().get();
+    d_region = nullptr;
+    if (profiler->enabled())
+        {
+            d_region = profiler->region(name);
+            d_allocations = allocations;
+            d_allocated_bytes = allocated_bytes;
+            d_start = std::chrono::steady_clock::now();
+        }
+}
+
+
+Gnss_Profile_Scope::~Gnss_Profile_Scope()
+{
+    if (d_region == nullptr)
+        {
+            return;
+        }
+    std::chrono::steady_clock::duration work_time = std::chrono::steady_clock::now() - d_start;
+    uint64_t call_allocations = allocations - d_allocations;
+    d_region->work_time.record(work_time);
+    if (call_allocations > 0)
+        {
+            d_region->allocations.fetch_add(call_allocations, std::memory_order_relaxed);
+            d_region->allocated_bytes.fetch_add(allocated_bytes - d_allocated_bytes, std::memory_order_relaxed);
+            d_region->allocating_calls.fetch_add(1, std::memory_order_relaxed);
+            uint64_t max_allocations = d_region->max_allocations.load(std::memory_order_relaxed);
+            while ((call_allocations > max_allocations) and !d_region->max_allocations.compare_exchange_weak(max_allocations, call_allocations, std::memory_order_relaxed))
+                {
+                }
+        }
+}
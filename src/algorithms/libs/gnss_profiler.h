@@ -0,0 +1,124 @@
+/*!
+ * \file gnss_profiler.h
+ * \brief Work time and heap allocations of the hot paths of the receiver
+ *
+ * -------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2019  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *          Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_GNSS_PROFILER_H_
+#define GNSS_SDR_GNSS_PROFILER_H_
+
+#include "gnss_metrics.h"
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+
+/*!
+ * \brief Statistics of a profiled function. Each call is an epoch of
+ * the function (a correlation, an observables epoch, a PVT fix...), and its
+ * allocations are the calls to operator new of its thread while it runs,
+ * including those of the profiled functions it calls.
+ */
+struct Gnss_Profile_Region
+{
+    std::string name;
+    Gnss_Duration_Histogram work_time;
+    std::atomic<uint64_t> allocations{0};
+    std::atomic<uint64_t> allocated_bytes{0};
+    std::atomic<uint64_t> allocating_calls{0};  // calls that allocated at least once
+    std::atomic<uint64_t> max_allocations{0};   // in a single call
+};
+
+
+/*!
+ * \brief Built-in profiler (GNSS-SDR.profile=true). Disabled, a profiled
+ * function costs a relaxed atomic load, and the allocator hook a relaxed
+ * atomic load per allocation.
+ */
+class Gnss_Profiler
+{
+public:
+    static std::shared_ptr<Gnss_Profiler> get_instance();
+
+    Gnss_Profiler();
+
+    /*!
+     * \brief Starts profiling. The statistics of a previous run are kept
+     */
+    void enable();
+
+    void disable();
+
+    inline bool enabled() const
+    {
+        return d_enabled.load(std::memory_order_relaxed);
+    }
+
+    /*!
+     * \brief Gets the statistics of function \p name (a static string)
+     */
+    Gnss_Profile_Region* region(const char* name);
+
+    /*!
+     * \brief Table with the work time and the allocations per call of each function
+     */
+    std::string report();
+
+    /*!
+     * \brief Allocations and allocated bytes of the calling thread since it started
+     */
+    static uint64_t thread_allocations();
+    static uint64_t thread_allocated_bytes();
+
+private:
+    std::atomic<bool> d_enabled;
+    std::mutex d_mutex;  // protects the list of regions
+    std::vector<std::unique_ptr<Gnss_Profile_Region>> d_regions;
+};
+
+
+/*!
+ * \brief Records the work time and the allocations between its construction
+ * and its destruction as a call of function \p name (a static string)
+ */
+class Gnss_Profile_Scope
+{
+public:
+    explicit Gnss_Profile_Scope(const char* name);
+    ~Gnss_Profile_Scope();
+
+private:
+    Gnss_Profile_Region* d_region;  // nullptr if the profiler is disabled
+    std::chrono::steady_clock::time_point d_start;
+    uint64_t d_allocations;
+    uint64_t d_allocated_bytes;
+};
+
+#endif
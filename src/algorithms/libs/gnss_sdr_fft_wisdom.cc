@@ -0,0 +1,56 @@
+/*!
+ * \file gnss_sdr_fft_wisdom.cc
+ * \brief Load and store the FFTW wisdom of the receiver FFT plans
+ *
+ * -------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2018  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *          Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------
+ */
+
+#include "gnss_sdr_fft_wisdom.h"
+#include <boost/filesystem/operations.hpp>  // for exists
+#include <gnuradio/fft/fft.h>
+#include <fftw3.h>
+
+
+bool gnss_sdr_load_fft_wisdom(const std::string& filename)
+{
+    if (filename.empty() or !boost::filesystem::exists(filename))
+        {
+            return false;
+        }
+    // The FFTW planner is not thread-safe, share the GNU Radio lock with the fft_complex constructors
+    gr::fft::planner::scoped_lock lock(gr::fft::planner::mutex());
+    return (fftwf_import_wisdom_from_filename(filename.c_str()) != 0);
+}
+
+
+bool gnss_sdr_save_fft_wisdom(const std::string& filename)
+{
+    if (filename.empty())
+        {
+            return false;
+        }
+    gr::fft::planner::scoped_lock lock(gr::fft::planner::mutex());
+    return (fftwf_export_wisdom_to_filename(filename.c_str()) != 0);
+}
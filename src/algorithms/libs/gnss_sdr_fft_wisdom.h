@@ -0,0 +1,51 @@
+/*!
+ * \file gnss_sdr_fft_wisdom.h
+ * \brief Load and store the FFTW wisdom of the receiver FFT plans
+ *
+ * -------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2018  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *          Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_GNSS_SDR_FFT_WISDOM_H_
+#define GNSS_SDR_GNSS_SDR_FFT_WISDOM_H_
+
+#include <string>
+
+/*!
+ * \brief Imports the FFTW wisdom stored in \p filename.
+ *
+ * FFTW wisdom is global to the process, so once it is loaded every
+ * gr::fft::fft_complex object of an already known size is planned without
+ * measuring again. This has to be called before creating the receiver blocks.
+ * Returns false if the file does not exist or cannot be read.
+ */
+bool gnss_sdr_load_fft_wisdom(const std::string& filename);
+
+/*!
+ * \brief Exports the FFTW wisdom accumulated by the process to \p filename.
+ * Returns false if the file cannot be written.
+ */
+bool gnss_sdr_save_fft_wisdom(const std::string& filename);
+
+#endif
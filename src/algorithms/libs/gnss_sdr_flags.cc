@@ -33,6 +33,7 @@
 #include <boost/filesystem/operations.hpp>  // for exists
 #include <cstdint>
 #include <iostream>
+#include <sstream>
 #include <string>
 
 DEFINE_string(c, "-", "Path to the configuration file (if set, overrides --config_file).");
@@ -40,6 +41,9 @@ DEFINE_string(c, "-", "Path to the configuration file (if set, overrides --confi
 DEFINE_string(config_file, std::string(GNSSSDR_INSTALL_DIR "/share/gnss-sdr/conf/default.conf"),
     "Path to the configuration file.");
 
+DEFINE_string(config_files, "",
+    "Comma-separated paths to the configuration files of several receivers run in the same process (if set, overrides -c and --config_file).");
+
 DEFINE_string(s, "-",
     "If defined, path to the file containing the signal samples (overrides the configuration file and --signal_source).");
 
@@ -64,6 +68,14 @@ DEFINE_double(dll_bw_hz, 0.0, "If defined, bandwidth of the DLL low pass filter,
 
 DEFINE_double(pll_bw_hz, 0.0, "If defined, bandwidth of the PLL low pass filter, in Hz (overrides the configuration file).");
 
+DEFINE_bool(dry_run_capacity, false, "Builds the flowgraph without running it, and estimates its load on this machine from --capacity_calibration.");
+
+DEFINE_string(capacity_calibration, "", "Comma-separated JSON outputs of benchmark_gnss_sdr and acquisition_benchmark run on this machine, used by --dry_run_capacity.");
+
+DEFINE_int32(capacity_cores, 0, "Cores available to the receiver in --dry_run_capacity (0: all the cores of this machine).");
+
+DEFINE_double(capacity_margin, 0.2, "Fraction of the cores, and of each one, kept free in --dry_run_capacity.");
+
 
 #if GFLAGS_GREATER_2_0
 
@@ -85,6 +97,22 @@ static bool ValidateConfigFile(const char* flagname, const std::string& value)
     return false;
 }
 
+static bool ValidateConfigFiles(const char* flagname, const std::string& value)
+{
+    std::stringstream files(value);
+    std::string file;
+    while (std::getline(files, file, ','))
+        {
+            if (!boost::filesystem::exists(file))
+                {
+                    std::cout << "Invalid value for flag -" << flagname << ". The file '" << file << "' does not exist." << std::endl;
+                    std::cout << "GNSS-SDR program ended." << std::endl;
+                    return false;
+                }
+        }
+    return true;
+}
+
 static bool ValidateS(const char* flagname, const std::string& value)
 {
     if (boost::filesystem::exists(value) or value == "-")  // value is ok
@@ -185,6 +213,7 @@ static bool ValidatePllBw(const char* flagname, double value)
 
 DEFINE_validator(c, &ValidateC);
 DEFINE_validator(config_file, &ValidateConfigFile);
+DEFINE_validator(config_files, &ValidateConfigFiles);
 DEFINE_validator(s, &ValidateS);
 DEFINE_validator(signal_source, &ValidateSignalSource);
 DEFINE_validator(doppler_max, &ValidateDopplerMax);
@@ -34,8 +34,9 @@
 
 #include <gflags/gflags.h>
 
-DECLARE_string(c);            //<! Path to the configuration file.
-DECLARE_string(config_file);  //<! Path to the configuration file.
+DECLARE_string(c);             //<! Path to the configuration file.
+DECLARE_string(config_file);   //<! Path to the configuration file.
+DECLARE_string(config_files);  //<! Paths to the configuration files of several receivers run in the same process.
 
 DECLARE_string(log_dir);  //<! Path to the folder in which logging will be stored.
 
@@ -58,5 +59,11 @@ DECLARE_double(pll_bw_hz);        //<! Bandwidth of the PLL low pass filter, in
 // Declare flags for PVT
 DECLARE_string(RINEX_version);  //<! If defined, specifies the RINEX version (2.11 or 3.02). Overrides the configuration file.
 
+// Declare flags for the capacity planner
+DECLARE_bool(dry_run_capacity);        //<! Builds the flowgraph without running it, and estimates its load.
+DECLARE_string(capacity_calibration);  //<! JSON outputs of the benchmarks run on this machine.
+DECLARE_int32(capacity_cores);         //<! Cores available to the receiver (0: all of them).
+DECLARE_double(capacity_margin);       //<! Fraction of the cores, and of each one, kept free.
+
 
 #endif
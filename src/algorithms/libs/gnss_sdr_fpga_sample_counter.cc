@@ -30,6 +30,7 @@
  */
 
 #include "gnss_sdr_fpga_sample_counter.h"
+#include "gnss_sdr_sample_clock.h"
 #include "gnss_synchro.h"
 #include <glog/logging.h>
 #include <gnuradio/io_signature.h>
@@ -45,13 +46,16 @@
 
 gnss_sdr_fpga_sample_counter::gnss_sdr_fpga_sample_counter(
     double _fs,
-    int32_t _interval_ms) : gr::block("fpga_fpga_sample_counter",
+    int32_t _interval_ms,
+    int32_t _intervals_per_interrupt) : gr::block("fpga_fpga_sample_counter",
                                 gr::io_signature::make(0, 0, 0),
                                 gr::io_signature::make(1, 1, sizeof(Gnss_Synchro)))
 {
     message_port_register_out(pmt::mp("fpga_sample_counter"));
-    set_max_noutput_items(1);
     interval_ms = _interval_ms;
+    intervals_per_interrupt = _intervals_per_interrupt > 1 ? _intervals_per_interrupt : 1;
+    // all the epochs of an interrupt are output in the same call
+    set_output_multiple(intervals_per_interrupt);
     fs = _fs;
     //printf("CREATOR fs =  %f\n", fs);
     //printf("CREATOR interval_ms = %" PRIu32 "\n", interval_ms);
@@ -74,12 +78,13 @@ gnss_sdr_fpga_sample_counter::gnss_sdr_fpga_sample_counter(
     flag_m = false;
     flag_h = false;
     flag_days = false;
+    sample_clock = Gnss_Sdr_Sample_Clock::get_instance();
 }
 
 
-gnss_sdr_fpga_sample_counter_sptr gnss_sdr_make_fpga_sample_counter(double _fs, int32_t _interval_ms)
+gnss_sdr_fpga_sample_counter_sptr gnss_sdr_make_fpga_sample_counter(double _fs, int32_t _interval_ms, int32_t _intervals_per_interrupt)
 {
-    gnss_sdr_fpga_sample_counter_sptr fpga_sample_counter_(new gnss_sdr_fpga_sample_counter(_fs, _interval_ms));
+    gnss_sdr_fpga_sample_counter_sptr fpga_sample_counter_(new gnss_sdr_fpga_sample_counter(_fs, _interval_ms, _intervals_per_interrupt));
     return fpga_sample_counter_;
 }
 
@@ -90,7 +95,7 @@ bool gnss_sdr_fpga_sample_counter::start()
     //todo: place here the RE-INITIALIZATION routines. This function will be called by GNURadio at every start of the flowgraph.
 
     // configure the number of samples per output in the FPGA and enable the interrupts
-    configure_samples_per_output(samples_per_output);
+    configure_samples_per_output(samples_per_output * intervals_per_interrupt);
 
     // return true if everything is ok.
     return true;
@@ -121,86 +126,102 @@ int gnss_sdr_fpga_sample_counter::general_work(int noutput_items __attribute__((
     // with the sufficient rate to catch all the interrupts in the counter. To be evaluated later.
 
     uint32_t counter = wait_for_interrupt_and_read_counter();
-    uint64_t samples_passed = 2 * static_cast<uint64_t>(samples_per_output) - static_cast<uint64_t>(counter);  // ellapsed samples
+    uint64_t samples_passed = 2 * static_cast<uint64_t>(samples_per_output) * intervals_per_interrupt - static_cast<uint64_t>(counter);  // ellapsed samples
     //printf("============================================ interrupter : samples_passed = %" PRIu64 "\n", samples_passed);
     // Note: at this moment the sample counter is implemented as a sample counter that decreases to zero and then it is automatically
     // reloaded again and keeps counter. It is done in this way to minimize the logic in the FPGA and maximize the FPGA clock performance
     // (it takes less resources and latency in the FPGA to compare a number against a fixed value like zero than to compare it to a programmable
     // variable number).
 
-    sample_counter = sample_counter + samples_passed;  //samples_per_output;
+    // one epoch every samples_per_output samples, the last one takes up any difference with the hardware count
     auto *out = reinterpret_cast<Gnss_Synchro *>(output_items[0]);
-    out[0] = Gnss_Synchro();
-    out[0].Flag_valid_symbol_output = false;
-    out[0].Flag_valid_word = false;
-    out[0].Channel_ID = -1;
-    out[0].fs = fs;
-    if ((current_T_rx_ms % report_interval_ms) == 0)
+    for (uint32_t n = 0; n < intervals_per_interrupt; n++)
         {
-            //printf("time to print sample_counter = %" PRIu64 "\n", sample_counter);
-            //printf("time to print current Tx ms : %" PRIu64 "\n", current_T_rx_ms);
-            //printf("time to print report_interval_ms : %" PRIu32 "\n", report_interval_ms);
-            //printf("time to print %f\n", (current_T_rx_ms % report_interval_ms));
-            current_s++;
-            if ((current_s % 60) == 0)
+            if (n + 1 < intervals_per_interrupt)
                 {
-                    current_s = 0;
-                    current_m++;
-                    flag_m = true;
-                    if ((current_m % 60) == 0)
-                        {
-                            current_m = 0;
-                            current_h++;
-                            flag_h = true;
-                            if ((current_h % 24) == 0)
-                                {
-                                    current_h = 0;
-                                    current_days++;
-                                    flag_days = true;
-                                }
-                        }
+                    sample_counter = sample_counter + samples_per_output;
+                    samples_passed -= samples_per_output;
+                }
+            else
+                {
+                    sample_counter = sample_counter + samples_passed;
+                }
+            out[n] = Gnss_Synchro();
+            out[n].Flag_valid_symbol_output = false;
+            out[n].Flag_valid_word = false;
+            out[n].Channel_ID = -1;
+            out[n].fs = fs;
+            if ((current_T_rx_ms % report_interval_ms) == 0)
+                {
+                    report_receiver_time();
                 }
+            out[n].Tracking_sample_counter = sample_counter;
+            //current_T_rx_ms = (sample_counter * 1000) / samples_per_output;
+            current_T_rx_ms = interval_ms * (sample_counter) / samples_per_output;
+        }
+    // the count is also readable from memory by any block, without waiting for this output
+    sample_clock->advance(sample_counter);
+    return static_cast<int>(intervals_per_interrupt);
+}
+
 
-            if (flag_days)
+void gnss_sdr_fpga_sample_counter::report_receiver_time()
+{
+    current_s++;
+    if ((current_s % 60) == 0)
+        {
+            current_s = 0;
+            current_m++;
+            flag_m = true;
+            if ((current_m % 60) == 0)
                 {
-                    std::string day;
-                    if (current_days == 1)
+                    current_m = 0;
+                    current_h++;
+                    flag_h = true;
+                    if ((current_h % 24) == 0)
                         {
-                            day = " day ";
+                            current_h = 0;
+                            current_days++;
+                            flag_days = true;
                         }
-                    else
-                        {
-                            day = " days ";
-                        }
-                    std::cout << "Current receiver time: " << current_days << day << current_h << " h " << current_m << " min " << current_s << " s" << std::endl;
+                }
+        }
+
+    if (flag_days)
+        {
+            std::string day;
+            if (current_days == 1)
+                {
+                    day = " day ";
+                }
+            else
+                {
+                    day = " days ";
+                }
+            std::cout << "Current receiver time: " << current_days << day << current_h << " h " << current_m << " min " << current_s << " s" << std::endl;
+        }
+    else
+        {
+            if (flag_h)
+                {
+                    std::cout << "Current receiver time: " << current_h << " h " << current_m << " min " << current_s << " s" << std::endl;
                 }
             else
                 {
-                    if (flag_h)
+                    if (flag_m)
                         {
-                            std::cout << "Current receiver time: " << current_h << " h " << current_m << " min " << current_s << " s" << std::endl;
+                            std::cout << "Current receiver time: " << current_m << " min " << current_s << " s" << std::endl;
                         }
                     else
                         {
-                            if (flag_m)
-                                {
-                                    std::cout << "Current receiver time: " << current_m << " min " << current_s << " s" << std::endl;
-                                }
-                            else
-                                {
-                                    std::cout << "Current receiver time: " << current_s << " s" << std::endl;
-                                }
+                            std::cout << "Current receiver time: " << current_s << " s" << std::endl;
                         }
                 }
-            if (flag_enable_send_msg)
-                {
-                    message_port_pub(pmt::mp("receiver_time"), pmt::from_double(static_cast<double>(current_T_rx_ms) / 1000.0));
-                }
         }
-    out[0].Tracking_sample_counter = sample_counter;
-    //current_T_rx_ms = (sample_counter * 1000) / samples_per_output;
-    current_T_rx_ms = interval_ms * (sample_counter) / samples_per_output;
-    return 1;
+    if (flag_enable_send_msg)
+        {
+            message_port_pub(pmt::mp("receiver_time"), pmt::from_double(static_cast<double>(current_T_rx_ms) / 1000.0));
+        }
 }
 
 uint32_t gnss_sdr_fpga_sample_counter::test_register(uint32_t writeval)
@@ -298,6 +319,6 @@ uint32_t gnss_sdr_fpga_sample_counter::wait_for_interrupt_and_read_counter()
     map_base[1] = 0;  // writing anything to reg 1 acknowledges the interrupt
 
     // add number of passed samples or read the current counter value for more accuracy
-    counter = samples_per_output;  //map_base[0];
+    counter = samples_per_output * intervals_per_interrupt;  //map_base[0];
     return counter;
 }
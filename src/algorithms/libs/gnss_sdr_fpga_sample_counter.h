@@ -34,17 +34,25 @@
 #include <boost/shared_ptr.hpp>
 #include <gnuradio/block.h>
 #include <cstdint>
+#include <memory>
+
+class Gnss_Sdr_Sample_Clock;
 
 class gnss_sdr_fpga_sample_counter;
 
 typedef boost::shared_ptr<gnss_sdr_fpga_sample_counter> gnss_sdr_fpga_sample_counter_sptr;
 
-gnss_sdr_fpga_sample_counter_sptr gnss_sdr_make_fpga_sample_counter(double _fs, int32_t _interval_ms);
+/*!
+ * \brief Makes a block that outputs one observation epoch every \p _interval_ms
+ * ms of signal, timed by the sample counter of the FPGA. The FPGA interrupts
+ * once every \p _intervals_per_interrupt epochs, which are then output together.
+ */
+gnss_sdr_fpga_sample_counter_sptr gnss_sdr_make_fpga_sample_counter(double _fs, int32_t _interval_ms, int32_t _intervals_per_interrupt = 1);
 
 class gnss_sdr_fpga_sample_counter : public gr::block
 {
 private:
-    gnss_sdr_fpga_sample_counter(double _fs, int32_t _interval_ms);
+    gnss_sdr_fpga_sample_counter(double _fs, int32_t _interval_ms, int32_t _intervals_per_interrupt);
     uint32_t test_register(uint32_t writeval);
     void configure_samples_per_output(uint32_t interval);
     void close_device(void);
@@ -52,10 +60,12 @@ private:
     bool start();
     bool stop();
     uint32_t wait_for_interrupt_and_read_counter(void);
+    void report_receiver_time(void);
     uint32_t samples_per_output;
     double fs;
     uint64_t sample_counter;
     uint32_t interval_ms;
+    uint32_t intervals_per_interrupt;  // epochs output after each interrupt
     uint64_t current_T_rx_ms;  // Receiver time in ms since the beginning of the run
     uint32_t current_s;        // Receiver time in seconds, modulo 60
     bool flag_m;               // True if the receiver has been running for at least 1 minute
@@ -66,12 +76,13 @@ private:
     uint32_t current_days;     // Receiver time in days since the beginning of the run
     int32_t report_interval_ms;
     bool flag_enable_send_msg;
+    std::shared_ptr<Gnss_Sdr_Sample_Clock> sample_clock;  // sample_counter, for readers of memory
     int32_t fd;                              // driver descriptor
     volatile uint32_t *map_base;             // driver memory map
     std::string device_name = "/dev/uio26";  // HW device name
 
 public:
-    friend gnss_sdr_fpga_sample_counter_sptr gnss_sdr_make_fpga_sample_counter(double _fs, int32_t _interval_ms);
+    friend gnss_sdr_fpga_sample_counter_sptr gnss_sdr_make_fpga_sample_counter(double _fs, int32_t _interval_ms, int32_t _intervals_per_interrupt);
     int general_work(int noutput_items,
         gr_vector_int &ninput_items,
         gr_vector_const_void_star &input_items,
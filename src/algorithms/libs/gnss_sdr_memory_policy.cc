@@ -0,0 +1,311 @@
+/*!
+ * \file gnss_sdr_memory_policy.cc
+ * \brief Huge pages and NUMA node of the large buffers of the receiver
+ *
+ * -------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2019  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *          Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------
+ */
+
+#include "gnss_sdr_memory_policy.h"
+#include <glog/logging.h>
+#include <volk_gnsssdr/volk_gnsssdr.h>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <sstream>
+#include <vector>
+#if defined(__linux__)
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#if defined(__linux__)
+#ifndef MAP_HUGE_SHIFT
+#define MAP_HUGE_SHIFT 26
+#endif
+#ifndef MAP_HUGE_2MB
+#define MAP_HUGE_2MB (21 << MAP_HUGE_SHIFT)
+#endif
+#ifndef MAP_HUGE_1GB
+#define MAP_HUGE_1GB (30 << MAP_HUGE_SHIFT)
+#endif
+// from <numaif.h>, so that libnuma is not needed
+#ifndef MPOL_PREFERRED
+#define MPOL_PREFERRED 1
+#endif
+#ifndef MPOL_MF_MOVE
+#define MPOL_MF_MOVE (1 << 1)
+#endif
+#endif
+
+
+namespace
+{
+const size_t HUGE_PAGE_BYTES = 2097152;     // 2 MB
+const size_t GIANT_PAGE_BYTES = 1073741824;  // 1 GB
+
+enum Page_Kind
+{
+    PAGES_HUGETLB = 0,
+    PAGES_TRANSPARENT,
+    PAGES_REGULAR,
+    PAGE_KINDS
+};
+
+struct Memory_Policy
+{
+    bool use_hugepages = false;
+    int numa_node = -1;
+    std::map<void*, std::pair<size_t, Page_Kind>> mappings;  // buffers of gnss_sdr_large_malloc()
+    size_t buffers[PAGE_KINDS] = {0, 0, 0};                 // allocated so far
+    size_t bytes[PAGE_KINDS] = {0, 0, 0};
+    size_t numa_failures = 0;
+    size_t applied = 0;  // existing buffers, gnss_sdr_apply_memory_policy()
+    size_t not_applied = 0;
+    std::mutex mutex;
+};
+
+Memory_Policy& memory_policy()
+{
+    static Memory_Policy policy;
+    return policy;
+}
+
+
+inline bool policy_active(const Memory_Policy& policy)
+{
+    return policy.use_hugepages or (policy.numa_node >= 0);
+}
+
+
+#if defined(__linux__)
+bool bind_to_node(void* address, size_t bytes, int numa_node, unsigned flags)
+{
+    if (numa_node < 0)
+        {
+            return true;
+        }
+    const size_t bits = 8 * sizeof(unsigned long);
+    std::vector<unsigned long> node_mask(static_cast<size_t>(numa_node) / bits + 1, 0UL);
+    node_mask[static_cast<size_t>(numa_node) / bits] = 1UL << (static_cast<size_t>(numa_node) % bits);
+    // the kernel reads maxnode - 1 bits of the mask
+    return syscall(SYS_mbind, address, bytes, MPOL_PREFERRED, node_mask.data(), node_mask.size() * bits + 1, flags) == 0;
+}
+
+
+// Anonymous mapping of at least bytes, huge page aligned
+void* map_buffer(size_t bytes, bool use_hugepages, size_t& mapped_bytes, Page_Kind& kind)
+{
+    if (use_hugepages)
+        {
+            // explicit huge pages, only if the hugetlbfs pool has enough of them (no fault later)
+            if (bytes >= GIANT_PAGE_BYTES)
+                {
+                    mapped_bytes = (bytes + GIANT_PAGE_BYTES - 1) / GIANT_PAGE_BYTES * GIANT_PAGE_BYTES;
+                    void* map = mmap(nullptr, mapped_bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB | MAP_HUGE_1GB, -1, 0);
+                    if (map != MAP_FAILED)
+                        {
+                            kind = PAGES_HUGETLB;
+                            return map;
+                        }
+                }
+            mapped_bytes = (bytes + HUGE_PAGE_BYTES - 1) / HUGE_PAGE_BYTES * HUGE_PAGE_BYTES;
+            void* map = mmap(nullptr, mapped_bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB | MAP_HUGE_2MB, -1, 0);
+            if (map != MAP_FAILED)
+                {
+                    kind = PAGES_HUGETLB;
+                    return map;
+                }
+        }
+
+    // regular pages, aligned so that transparent huge pages can back them
+    mapped_bytes = (bytes + HUGE_PAGE_BYTES - 1) / HUGE_PAGE_BYTES * HUGE_PAGE_BYTES;
+    void* map = mmap(nullptr, mapped_bytes + HUGE_PAGE_BYTES, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (map == MAP_FAILED)
+        {
+            return nullptr;
+        }
+    auto first = reinterpret_cast<uintptr_t>(map);
+    uintptr_t aligned = (first + HUGE_PAGE_BYTES - 1) / HUGE_PAGE_BYTES * HUGE_PAGE_BYTES;
+    if (aligned > first)
+        {
+            munmap(map, aligned - first);
+        }
+    munmap(reinterpret_cast<void*>(aligned + mapped_bytes), first + HUGE_PAGE_BYTES - aligned);
+    map = reinterpret_cast<void*>(aligned);
+    kind = PAGES_REGULAR;
+#ifdef MADV_HUGEPAGE
+    if (use_hugepages and (madvise(map, mapped_bytes, MADV_HUGEPAGE) == 0))
+        {
+            kind = PAGES_TRANSPARENT;
+        }
+#endif
+    return map;
+}
+#endif
+}  // namespace
+
+
+void gnss_sdr_set_memory_policy(bool use_hugepages, int numa_node)
+{
+    Memory_Policy& policy = memory_policy();
+    std::lock_guard<std::mutex> lock(policy.mutex);
+#if defined(__linux__)
+    policy.use_hugepages = use_hugepages;
+    policy.numa_node = numa_node;
+#else
+    if (use_hugepages or (numa_node >= 0))
+        {
+            LOG(WARNING) << "Huge pages and NUMA placement are only available on Linux";
+        }
+#endif
+}
+
+
+void* gnss_sdr_large_malloc(size_t bytes, size_t alignment)
+{
+#if defined(__linux__)
+    Memory_Policy& policy = memory_policy();
+    std::lock_guard<std::mutex> lock(policy.mutex);
+    // smaller buffers share their pages with others, and follow the first touch policy
+    if (policy_active(policy) and (bytes >= HUGE_PAGE_BYTES) and (alignment <= HUGE_PAGE_BYTES))
+        {
+            size_t mapped_bytes = 0;
+            Page_Kind kind = PAGES_REGULAR;
+            void* map = map_buffer(bytes, policy.use_hugepages, mapped_bytes, kind);
+            if (map != nullptr)
+                {
+                    // before the pages are touched
+                    if (!bind_to_node(map, mapped_bytes, policy.numa_node, 0))
+                        {
+                            policy.numa_failures++;
+                        }
+                    policy.mappings[map] = std::make_pair(mapped_bytes, kind);
+                    policy.buffers[kind]++;
+                    policy.bytes[kind] += mapped_bytes;
+                    return map;
+                }
+            LOG(WARNING) << "Unable to map a buffer of " << bytes << " bytes, allocated from the heap";
+        }
+#endif
+    return volk_gnsssdr_malloc(bytes, alignment);
+}
+
+
+void gnss_sdr_large_free(void* buffer)
+{
+    if (buffer == nullptr)
+        {
+            return;
+        }
+#if defined(__linux__)
+    Memory_Policy& policy = memory_policy();
+    {
+        std::lock_guard<std::mutex> lock(policy.mutex);
+        auto mapping = policy.mappings.find(buffer);
+        if (mapping != policy.mappings.end())
+            {
+                munmap(buffer, mapping->second.first);
+                policy.mappings.erase(mapping);
+                return;
+            }
+    }
+#endif
+    volk_gnsssdr_free(buffer);
+}
+
+
+bool gnss_sdr_apply_memory_policy(void* address, size_t bytes)
+{
+#if defined(__linux__)
+    Memory_Policy& policy = memory_policy();
+    std::lock_guard<std::mutex> lock(policy.mutex);
+    if (!policy_active(policy) or (bytes == 0))
+        {
+            return false;
+        }
+    static const auto page_bytes = static_cast<uintptr_t>(sysconf(_SC_PAGESIZE));
+    uintptr_t first = reinterpret_cast<uintptr_t>(address) / page_bytes * page_bytes;
+    size_t length = (reinterpret_cast<uintptr_t>(address) + bytes - first + page_bytes - 1) / page_bytes * page_bytes;
+    bool applied = true;
+#ifdef MADV_HUGEPAGE
+    // shared memory mappings only take it with shmem_enabled=advise (or always)
+    if (policy.use_hugepages and (madvise(reinterpret_cast<void*>(first), length, MADV_HUGEPAGE) != 0))
+        {
+            applied = false;
+        }
+#endif
+    if (!bind_to_node(reinterpret_cast<void*>(first), length, policy.numa_node, MPOL_MF_MOVE))
+        {
+            applied = false;
+        }
+    if (applied)
+        {
+            policy.applied++;
+        }
+    else
+        {
+            policy.not_applied++;
+        }
+    return applied;
+#else
+    (void)address;
+    (void)bytes;
+    return false;
+#endif
+}
+
+
+std::string gnss_sdr_memory_policy_report()
+{
+    Memory_Policy& policy = memory_policy();
+    std::lock_guard<std::mutex> lock(policy.mutex);
+    if (!policy_active(policy))
+        {
+            return std::string();
+        }
+    std::stringstream report;
+    report << "Memory policy:";
+    if (policy.use_hugepages)
+        {
+            report << " huge pages";
+        }
+    if (policy.numa_node >= 0)
+        {
+            report << (policy.use_hugepages ? "," : "") << " NUMA node " << policy.numa_node;
+        }
+    const char* names[PAGE_KINDS] = {"on huge pages", "on transparent huge pages", "on regular pages"};
+    report << ". Large buffers allocated:";
+    for (int kind = 0; kind < PAGE_KINDS; kind++)
+        {
+            report << (kind > 0 ? "," : "") << " " << policy.buffers[kind] << " (" << policy.bytes[kind] / 1048576 << " MB) " << names[kind];
+        }
+    if (policy.numa_failures > 0)
+        {
+            report << ", " << policy.numa_failures << " not bound to the NUMA node";
+        }
+    report << ". Flow graph buffers: policy applied to " << policy.applied << ", failed on " << policy.not_applied << ".";
+    return report.str();
+}
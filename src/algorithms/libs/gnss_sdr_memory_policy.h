@@ -0,0 +1,72 @@
+/*!
+ * \file gnss_sdr_memory_policy.h
+ * \brief Huge pages and NUMA node of the large buffers of the receiver
+ *
+ * -------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2019  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *          Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_GNSS_SDR_MEMORY_POLICY_H_
+#define GNSS_SDR_GNSS_SDR_MEMORY_POLICY_H_
+
+#include <cstddef>
+#include <string>
+
+/*!
+ * \brief Sets how the large buffers are allocated from now on: on huge pages
+ * if \p use_hugepages, and in the memory of \p numa_node if it is not
+ * negative. This has to be called before creating the receiver blocks.
+ */
+void gnss_sdr_set_memory_policy(bool use_hugepages, int numa_node);
+
+/*!
+ * \brief Returns a buffer of \p bytes aligned to \p alignment, to be
+ * released with gnss_sdr_large_free().
+ *
+ * With a memory policy set, buffers of at least one huge page get their own
+ * mapping: on 1 GB or 2 MB pages of the hugetlbfs pool if it has enough free
+ * pages, else on transparent huge pages, else on regular pages, and bound to
+ * the NUMA node if possible. Otherwise they come from volk_gnsssdr_malloc().
+ */
+void* gnss_sdr_large_malloc(size_t bytes, size_t alignment);
+
+/*!
+ * \brief Releases a buffer of gnss_sdr_large_malloc().
+ */
+void gnss_sdr_large_free(void* buffer);
+
+/*!
+ * \brief Applies the memory policy to \p bytes already mapped at \p address
+ * (e.g., a GNU Radio buffer), moving its pages to the NUMA node. Returns
+ * false if the policy could not be applied (or there is none).
+ */
+bool gnss_sdr_apply_memory_policy(void* address, size_t bytes);
+
+/*!
+ * \brief One line on the memory policy, and on the buffers that did or did
+ * not get huge pages and the NUMA node. Empty if there is no policy.
+ */
+std::string gnss_sdr_memory_policy_report();
+
+#endif
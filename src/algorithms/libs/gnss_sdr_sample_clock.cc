@@ -0,0 +1,71 @@
+/*!
+ * \file gnss_sdr_sample_clock.cc
+ * \brief Receiver clock shared by the blocks that read the output of the
+ * signal conditioner, in samples since the beginning of the run.
+ *
+ * -------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2019  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *          Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------
+ */
+
+#include "gnss_sdr_sample_clock.h"
+
+
+std::shared_ptr<Gnss_Sdr_Sample_Clock> Gnss_Sdr_Sample_Clock::get_instance()
+{
+    static std::shared_ptr<Gnss_Sdr_Sample_Clock> instance = std::make_shared<Gnss_Sdr_Sample_Clock>();
+    return instance;
+}
+
+
+Gnss_Sdr_Sample_Clock::Gnss_Sdr_Sample_Clock() : d_samples(0), d_fs(0.0)
+{
+}
+
+
+void Gnss_Sdr_Sample_Clock::reset(double fs)
+{
+    d_fs.store(fs);
+    d_samples.store(0);
+}
+
+
+double Gnss_Sdr_Sample_Clock::fs() const
+{
+    return d_fs.load();
+}
+
+
+void Gnss_Sdr_Sample_Clock::advance(uint64_t samples)
+{
+    uint64_t current = d_samples.load(std::memory_order_relaxed);
+    while (current < samples and !d_samples.compare_exchange_weak(current, samples, std::memory_order_relaxed))
+        {
+        }
+}
+
+
+uint64_t Gnss_Sdr_Sample_Clock::samples() const
+{
+    return d_samples.load(std::memory_order_relaxed);
+}
@@ -0,0 +1,70 @@
+/*!
+ * \file gnss_sdr_sample_clock.h
+ * \brief Receiver clock shared by the blocks that read the output of the
+ * signal conditioner, in samples since the beginning of the run.
+ *
+ * -------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2019  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *          Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_GNSS_SDR_SAMPLE_CLOCK_H_
+#define GNSS_SDR_GNSS_SDR_SAMPLE_CLOCK_H_
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+
+/*!
+ * \brief Number of samples of the signal conditioner output already read by
+ * the channels, an alternative to gnss_sdr_sample_counter that does not need
+ * another full-rate reader of that buffer (GNSS-SDR.shared_sample_clock=true).
+ *
+ * The tracking blocks advance it in every call to general_work(), even in
+ * standby. The observables block advances it with the Tracking_sample_counter
+ * of its inputs, for the tracking implementations that do not, and derives the
+ * observation epochs from it.
+ */
+class Gnss_Sdr_Sample_Clock
+{
+public:
+    static std::shared_ptr<Gnss_Sdr_Sample_Clock> get_instance();
+
+    Gnss_Sdr_Sample_Clock();
+
+    void reset(double fs);  //!< Restarts the clock at sample 0, at \p fs samples per second
+    double fs() const;
+
+    /*!
+     * \brief Moves the clock forward to \p samples, if it is behind. Lock-free,
+     * the channels call it concurrently.
+     */
+    void advance(uint64_t samples);
+    uint64_t samples() const;
+
+private:
+    std::atomic<uint64_t> d_samples;
+    std::atomic<double> d_fs;
+};
+
+#endif
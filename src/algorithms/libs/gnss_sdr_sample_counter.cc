@@ -32,6 +32,7 @@
 #include "gnss_sdr_sample_counter.h"
 #include "gnss_synchro.h"
 #include <gnuradio/io_signature.h>
+#include <chrono>
 #include <cmath>
 #include <iostream>
 #include <string>
@@ -140,6 +141,9 @@ int gnss_sdr_sample_counter::work(int noutput_items __attribute__((unused)),
         }
     sample_counter += samples_per_output;
     out[0].Tracking_sample_counter = sample_counter;
+    // Time of arrival of the samples of this epoch, carried to the PVT to measure the end-to-end latency
+    auto arrival_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+    add_item_tag(0, nitems_written(0), pmt::mp("arrival_time"), pmt::from_uint64(static_cast<uint64_t>(arrival_ns)));
     current_T_rx_ms += interval_ms;
     return 1;
 }
@@ -34,10 +34,9 @@
 #include "gnss_signal_processing.h"
 #include "GPS_L1_CA.h"
 #include <gnuradio/fxpt_nco.h>
+#include <cmath>
 
 
-auto auxCeil2 = [](float x) { return static_cast<int32_t>(static_cast<int64_t>((x) + 1)); };
-
 void complex_exp_gen(std::complex<float>* _dest, double _f, double _fs, uint32_t _samps)
 {
     gr::fxpt_nco d_nco;
@@ -158,49 +157,55 @@ void hex_to_binary_converter(int32_t* _dest, char _from)
 }
 
 
-void resampler(const float* _from, float* _dest, float _fs_in,
-    float _fs_out, uint32_t _length_in, uint32_t _length_out)
+/*
+ * Output sample i takes input sample floor(((i + 1) * fs_in - offset) / fs_out).
+ * The index is stepped with an integer quotient and remainder instead of being
+ * computed in floating point for every sample, so it is exact for any length
+ * and needs no division in the loop.
+ */
+template <typename T>
+void resample_nearest(const T* _from, T* _dest, float _fs_in,
+    float _fs_out, uint32_t _length_in, uint32_t _length_out, uint64_t offset)
 {
-    uint32_t _codeValueIndex;
-    float aux;
-    //--- Find time constants --------------------------------------------------
-    const float _t_in = 1 / _fs_in;    // Incoming sampling  period in sec
-    const float _t_out = 1 / _fs_out;  // Out sampling period in sec
+    const auto fs_in = static_cast<uint64_t>(std::llround(_fs_in));
+    const auto fs_out = static_cast<uint64_t>(std::llround(_fs_out));
+    const uint64_t step_quotient = fs_in / fs_out;
+    const uint64_t step_remainder = fs_in % fs_out;
+    uint64_t index = (fs_in - offset) / fs_out;
+    uint64_t remainder = (fs_in - offset) % fs_out;
     for (uint32_t i = 0; i < _length_out - 1; i++)
         {
-            //=== Digitizing =======================================================
-            //--- compute index array to read sampled values -------------------------
-            //_codeValueIndex = ceil((_t_out * ((float)i + 1)) / _t_in) - 1;
-            aux = (_t_out * (i + 1)) / _t_in;
-            _codeValueIndex = auxCeil2(aux) - 1;
-
             //if repeat the chip -> upsample by nearest neighborhood interpolation
-            _dest[i] = _from[_codeValueIndex];
+            _dest[i] = _from[index];
+            index += step_quotient;
+            remainder += step_remainder;
+            if (remainder >= fs_out)
+                {
+                    remainder -= fs_out;
+                    index++;
+                }
         }
     //--- Correct the last index (due to number rounding issues) -----------
     _dest[_length_out - 1] = _from[_length_in - 1];
 }
 
 
+void resampler(const float* _from, float* _dest, float _fs_in,
+    float _fs_out, uint32_t _length_in, uint32_t _length_out)
+{
+    resample_nearest(_from, _dest, _fs_in, _fs_out, _length_in, _length_out, 0);
+}
+
+
 void resampler(const std::complex<float>* _from, std::complex<float>* _dest, float _fs_in,
     float _fs_out, uint32_t _length_in, uint32_t _length_out)
 {
-    uint32_t _codeValueIndex;
-    float aux;
-    //--- Find time constants --------------------------------------------------
-    const float _t_in = 1 / _fs_in;    // Incoming sampling  period in sec
-    const float _t_out = 1 / _fs_out;  // Out sampling period in sec
-    for (uint32_t i = 0; i < _length_out - 1; i++)
-        {
-            //=== Digitizing =======================================================
-            //--- compute index array to read sampled values -------------------------
-            //_codeValueIndex = ceil((_t_out * ((float)i + 1)) / _t_in) - 1;
-            aux = (_t_out * (i + 1)) / _t_in;
-            _codeValueIndex = auxCeil2(aux) - 1;
+    resample_nearest(_from, _dest, _fs_in, _fs_out, _length_in, _length_out, 0);
+}
 
-            //if repeat the chip -> upsample by nearest neighborhood interpolation
-            _dest[i] = _from[_codeValueIndex];
-        }
-    //--- Correct the last index (due to number rounding issues) -----------
-    _dest[_length_out - 1] = _from[_length_in - 1];
+
+void resampler_ceil(const std::complex<float>* _from, std::complex<float>* _dest, float _fs_in,
+    float _fs_out, uint32_t _length_in, uint32_t _length_out)
+{
+    resample_nearest(_from, _dest, _fs_in, _fs_out, _length_in, _length_out, 1);
 }
@@ -76,4 +76,13 @@ void resampler(const std::complex<float>* _from, std::complex<float>* _dest,
     float _fs_in, float _fs_out, uint32_t _length_in,
     uint32_t _length_out);
 
+/*!
+ * \brief Like resampler(), but output sample i takes input sample
+ * ceil((i + 1) * _fs_in / _fs_out) - 1 instead of floor((i + 1) * _fs_in / _fs_out),
+ * as the GPS L2C and L5 codes have always been sampled.
+ */
+void resampler_ceil(const std::complex<float>* _from, std::complex<float>* _dest,
+    float _fs_in, float _fs_out, uint32_t _length_in,
+    uint32_t _length_out);
+
 #endif /* GNSS_SDR_GNSS_SIGNAL_PROCESSING_H_ */
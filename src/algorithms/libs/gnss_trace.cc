@@ -0,0 +1,212 @@
+/*!
+ * \file gnss_trace.cc
+ * \brief Optional tracing of the processing blocks, written in the Chrome
+ * trace event format (chrome://tracing, Perfetto).
+ *
+ * -------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2019  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *          Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------
+ */
+
+#include "gnss_trace.h"
+#include <utility>
+
+
+namespace
+{
+int64_t steady_clock_us()
+{
+    return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+}  // namespace
+
+
+std::shared_ptr<Gnss_Trace> Gnss_Trace::get_instance()
+{
+    static std::shared_ptr<Gnss_Trace> instance = std::make_shared<Gnss_Trace>();
+    return instance;
+}
+
+
+Gnss_Trace::Gnss_Trace()
+{
+    d_enabled.store(false, std::memory_order_relaxed);
+    d_start_us.store(steady_clock_us(), std::memory_order_relaxed);
+    d_first_event = true;
+}
+
+
+Gnss_Trace::~Gnss_Trace()
+{
+    close();
+}
+
+
+bool Gnss_Trace::open(const std::string& filename)
+{
+    close();
+    std::lock_guard<std::mutex> lock(d_mutex);
+    d_file.open(filename, std::ios::out | std::ios::trunc);
+    if (!d_file.is_open())
+        {
+            return false;
+        }
+    for (auto& buffer : d_buffers)
+        {
+            std::lock_guard<std::mutex> buffer_lock(buffer->mutex);
+            buffer->events.clear();
+            buffer->named = false;
+        }
+    // JSON array format: the viewers accept the file without the closing bracket if the receiver is killed
+    d_file << "[\n";
+    d_first_event = true;
+    d_start_us.store(steady_clock_us(), std::memory_order_relaxed);
+    d_enabled.store(true, std::memory_order_relaxed);
+    return true;
+}
+
+
+void Gnss_Trace::close()
+{
+    d_enabled.store(false, std::memory_order_relaxed);
+    std::lock_guard<std::mutex> lock(d_mutex);
+    if (!d_file.is_open())
+        {
+            return;
+        }
+    for (auto& buffer : d_buffers)
+        {
+            std::vector<Gnss_Trace_Event> events;
+            {
+                std::lock_guard<std::mutex> buffer_lock(buffer->mutex);
+                events.swap(buffer->events);
+            }
+            write(events, *buffer);
+        }
+    d_file << "\n]\n";
+    d_file.close();
+}
+
+
+int64_t Gnss_Trace::now_us() const
+{
+    return steady_clock_us() - d_start_us.load(std::memory_order_relaxed);
+}
+
+
+Gnss_Trace::Thread_Buffer* Gnss_Trace::thread_buffer()
+{
+    static thread_local std::shared_ptr<Thread_Buffer> buffer;
+    if (buffer == nullptr)
+        {
+            buffer = std::make_shared<Thread_Buffer>();
+            buffer->events.reserve(buffer_events);
+            buffer->named = false;
+            std::lock_guard<std::mutex> lock(d_mutex);
+            d_buffers.push_back(buffer);
+            buffer->tid = d_buffers.size();
+        }
+    return buffer.get();
+}
+
+
+void Gnss_Trace::record(const Gnss_Trace_Event& event)
+{
+    if (!enabled())
+        {
+            return;
+        }
+    Thread_Buffer* buffer = thread_buffer();
+    std::vector<Gnss_Trace_Event> full_events;
+    {
+        std::lock_guard<std::mutex> buffer_lock(buffer->mutex);
+        buffer->events.push_back(event);
+        if (buffer->events.size() < buffer_events)
+            {
+                return;
+            }
+        full_events.swap(buffer->events);
+        buffer->events.reserve(buffer_events);
+    }
+    std::lock_guard<std::mutex> lock(d_mutex);
+    if (d_file.is_open())
+        {
+            write(full_events, *buffer);
+        }
+}
+
+
+void Gnss_Trace::write(const std::vector<Gnss_Trace_Event>& events, Thread_Buffer& buffer)
+{
+    for (const auto& event : events)
+        {
+            if (!d_first_event)
+                {
+                    d_file << ",\n";
+                }
+            d_first_event = false;
+            if (!buffer.named)
+                {
+                    // GNU Radio runs each block in its own thread: name the thread after its first span
+                    d_file << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << buffer.tid
+                           << ",\"args\":{\"name\":\"" << event.name;
+                    if (event.channel >= 0)
+                        {
+                            d_file << " " << event.channel;
+                        }
+                    d_file << "\"}},\n";
+                    buffer.named = true;
+                }
+            d_file << "{\"name\":\"" << event.name << "\",\"cat\":\"gnss\",\"ph\":\"X\",\"pid\":1,\"tid\":" << buffer.tid
+                   << ",\"ts\":" << event.start_us << ",\"dur\":" << event.duration_us
+                   << ",\"args\":{\"channel\":" << event.channel << ",\"first_sample\":" << event.first_sample << ",\"last_sample\":" << event.last_sample << "}}";
+        }
+}
+
+
+Gnss_Trace_Span::Gnss_Trace_Span(const char* name, int32_t channel)
+{
+    // a plain pointer, so the spans do not touch the shared reference count
+    static Gnss_Trace* trace = Gnss_Trace::get_instance().get();
+    d_trace = trace;
+    d_enabled = d_trace->enabled();
+    if (d_enabled)
+        {
+            d_event.name = name;
+            d_event.channel = channel;
+            d_event.first_sample = 0;
+            d_event.last_sample = 0;
+            d_event.start_us = d_trace->now_us();
+            d_event.duration_us = 0;
+        }
+}
+
+
+Gnss_Trace_Span::~Gnss_Trace_Span()
+{
+    if (d_enabled)
+        {
+            d_event.duration_us = d_trace->now_us() - d_event.start_us;
+            d_trace->record(d_event);
+        }
+}
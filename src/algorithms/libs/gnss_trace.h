@@ -0,0 +1,138 @@
+/*!
+ * \file gnss_trace.h
+ * \brief Optional tracing of the processing blocks, written in the Chrome
+ * trace event format (chrome://tracing, Perfetto).
+ *
+ * -------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2019  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *          Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_GNSS_TRACE_H_
+#define GNSS_SDR_GNSS_TRACE_H_
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+
+/*!
+ * \brief A span of work of a block, covering the samples [first_sample, last_sample]
+ */
+struct Gnss_Trace_Event
+{
+    const char* name;  // static string
+    int32_t channel;   // -1 if the block is not a channel
+    uint64_t first_sample;
+    uint64_t last_sample;
+    int64_t start_us;  // since the trace was opened
+    int64_t duration_us;
+};
+
+
+/*!
+ * \brief Trace writer. Each thread collects its events in its own buffer,
+ * which is written to the trace file only when it is full, so recording an
+ * event does not contend with the other threads. Disabled, a span costs a
+ * relaxed atomic load.
+ */
+class Gnss_Trace
+{
+public:
+    static std::shared_ptr<Gnss_Trace> get_instance();
+
+    Gnss_Trace();
+    ~Gnss_Trace();
+
+    /*!
+     * \brief Starts writing the spans to \p filename. Returns false if the file can not be created
+     */
+    bool open(const std::string& filename);
+
+    /*!
+     * \brief Writes the buffered spans and closes the trace file
+     */
+    void close();
+
+    inline bool enabled() const
+    {
+        return d_enabled.load(std::memory_order_relaxed);
+    }
+
+    int64_t now_us() const;
+
+    void record(const Gnss_Trace_Event& event);
+
+private:
+    struct Thread_Buffer
+    {
+        std::mutex mutex;  // only contended while the trace is being closed
+        std::vector<Gnss_Trace_Event> events;
+        uint32_t tid;
+        bool named;
+    };
+    static const size_t buffer_events = 4096;
+    Thread_Buffer* thread_buffer();
+    void write(const std::vector<Gnss_Trace_Event>& events, Thread_Buffer& buffer);
+
+    std::atomic<bool> d_enabled;
+    std::atomic<int64_t> d_start_us;  // steady clock time when the trace was opened
+    std::mutex d_mutex;               // protects the file and the list of buffers
+    std::ofstream d_file;
+    bool d_first_event;
+    std::vector<std::shared_ptr<Thread_Buffer>> d_buffers;
+};
+
+
+/*!
+ * \brief Records the time between its construction and its destruction as a span of the calling thread
+ */
+class Gnss_Trace_Span
+{
+public:
+    Gnss_Trace_Span(const char* name, int32_t channel = -1);
+    ~Gnss_Trace_Span();
+
+    inline bool enabled() const
+    {
+        return d_enabled;
+    }
+
+    inline void set_samples(uint64_t first_sample, uint64_t last_sample)
+    {
+        d_event.first_sample = first_sample;
+        d_event.last_sample = last_sample;
+    }
+
+private:
+    Gnss_Trace* d_trace;
+    bool d_enabled;
+    Gnss_Trace_Event d_event;
+};
+
+#endif
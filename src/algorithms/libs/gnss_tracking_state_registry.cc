@@ -0,0 +1,109 @@
+/*!
+ * \file gnss_tracking_state_registry.cc
+ * \brief Process-wide record of the carrier Doppler of the satellites in
+ * tracking, used to aid the acquisition of the same satellites in other bands.
+ *
+ *
+ * -------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2018  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *          Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------
+ */
+
+#include "gnss_tracking_state_registry.h"
+
+
+namespace
+{
+thread_local std::shared_ptr<Gnss_Tracking_State_Registry> thread_instance;
+}  // namespace
+
+
+std::shared_ptr<Gnss_Tracking_State_Registry> Gnss_Tracking_State_Registry::get_instance()
+{
+    if (thread_instance != nullptr)
+        {
+            return thread_instance;
+        }
+    static std::shared_ptr<Gnss_Tracking_State_Registry> instance = std::make_shared<Gnss_Tracking_State_Registry>();
+    return instance;
+}
+
+
+void Gnss_Tracking_State_Registry::set_thread_instance(const std::shared_ptr<Gnss_Tracking_State_Registry>& instance)
+{
+    thread_instance = instance;
+}
+
+
+void Gnss_Tracking_State_Registry::update(char system, uint32_t prn, const std::string& signal, double carrier_doppler_hz, double carrier_freq_hz, double cn0_db_hz)
+{
+    Gnss_Tracking_State state;
+    state.carrier_doppler_hz = carrier_doppler_hz;
+    state.carrier_freq_hz = carrier_freq_hz;
+    state.cn0_db_hz = cn0_db_hz;
+    state.update_time = std::chrono::steady_clock::now();
+    std::lock_guard<std::mutex> lock(d_mutex);
+    d_states[std::make_tuple(system, prn, signal)] = state;
+}
+
+
+void Gnss_Tracking_State_Registry::remove(char system, uint32_t prn, const std::string& signal)
+{
+    std::lock_guard<std::mutex> lock(d_mutex);
+    d_states.erase(std::make_tuple(system, prn, signal));
+}
+
+
+bool Gnss_Tracking_State_Registry::find(char system, uint32_t prn, const std::string& signal, double max_age_s, Gnss_Tracking_State& state)
+{
+    std::lock_guard<std::mutex> lock(d_mutex);
+    auto it = d_states.find(std::make_tuple(system, prn, signal));
+    if (it == d_states.end())
+        {
+            return false;
+        }
+    std::chrono::duration<double> age = std::chrono::steady_clock::now() - it->second.update_time;
+    if (age.count() > max_age_s)
+        {
+            return false;
+        }
+    state = it->second;
+    return true;
+}
+
+
+std::map<std::tuple<char, uint32_t, std::string>, Gnss_Tracking_State> Gnss_Tracking_State_Registry::get_states(double max_age_s)
+{
+    std::map<std::tuple<char, uint32_t, std::string>, Gnss_Tracking_State> states;
+    std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+    std::lock_guard<std::mutex> lock(d_mutex);
+    for (const auto& entry : d_states)
+        {
+            std::chrono::duration<double> age = now - entry.second.update_time;
+            if (age.count() <= max_age_s)
+                {
+                    states.insert(entry);
+                }
+        }
+    return states;
+}
@@ -0,0 +1,99 @@
+/*!
+ * \file gnss_tracking_state_registry.h
+ * \brief Process-wide record of the carrier Doppler of the satellites in
+ * tracking, used to aid the acquisition of the same satellites in other bands.
+ *
+ *
+ * -------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2018  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *          Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_GNSS_TRACKING_STATE_REGISTRY_H_
+#define GNSS_SDR_GNSS_TRACKING_STATE_REGISTRY_H_
+
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <tuple>
+
+
+/*!
+ * \brief Last locked tracking state of a satellite signal.
+ */
+struct Gnss_Tracking_State
+{
+    double carrier_doppler_hz;
+    double carrier_freq_hz;
+    double cn0_db_hz;
+    std::chrono::steady_clock::time_point update_time;
+};
+
+
+/*!
+ * \brief Thread-safe store of the tracking states, indexed by system, PRN
+ * and signal. The tracking blocks update it while they are locked, and the
+ * flowgraph reads it when it assigns a signal of an already tracked
+ * satellite to an acquisition channel.
+ */
+class Gnss_Tracking_State_Registry
+{
+public:
+    /*!
+     * \brief Gets the registry of the receiver being built by the calling
+     * thread (see set_thread_instance()), or the process-wide one.
+     */
+    static std::shared_ptr<Gnss_Tracking_State_Registry> get_instance();
+
+    /*!
+     * \brief Makes get_instance() return \p instance in the calling thread, so
+     * that each receiver of a multi-receiver process keeps its own states.
+     * The blocks must get the registry when they are built. A null \p instance
+     * restores the process-wide registry.
+     */
+    static void set_thread_instance(const std::shared_ptr<Gnss_Tracking_State_Registry>& instance);
+
+    void update(char system, uint32_t prn, const std::string& signal, double carrier_doppler_hz, double carrier_freq_hz, double cn0_db_hz);
+
+    void remove(char system, uint32_t prn, const std::string& signal);
+
+    /*!
+     * \brief Gets the state of a signal updated less than \p max_age_s seconds ago.
+     * \return false if there is no such state.
+     */
+    bool find(char system, uint32_t prn, const std::string& signal, double max_age_s, Gnss_Tracking_State& state);
+
+    /*!
+     * \brief Copies all the states updated less than \p max_age_s seconds ago.
+     */
+    std::map<std::tuple<char, uint32_t, std::string>, Gnss_Tracking_State> get_states(double max_age_s);
+
+private:
+    std::map<std::tuple<char, uint32_t, std::string>, Gnss_Tracking_State> d_states;
+    std::mutex d_mutex;
+};
+
+#endif
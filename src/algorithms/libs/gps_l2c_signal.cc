@@ -32,7 +32,10 @@
 
 #include "gps_l2c_signal.h"
 #include "GPS_L2C.h"
+#include "gnss_code_table.h"
+#include "gnss_signal_processing.h"
 #include <cmath>
+#include <vector>
 
 
 int32_t gps_l2c_m_shift(int32_t x)
@@ -53,39 +56,40 @@ void gps_l2c_m_code(int32_t* _dest, uint32_t _prn)
 }
 
 
-void gps_l2c_m_code_gen_complex(std::complex<float>* _dest, uint32_t _prn)
+const Gnss_Code_Table& gps_l2c_m_code_table()
 {
-    auto* _code = new int32_t[GPS_L2_M_CODE_LENGTH_CHIPS];
+    static const Gnss_Code_Table table = []() {
+        Gnss_Code_Table codes(50, GPS_L2_M_CODE_LENGTH_CHIPS);
+        std::vector<int32_t> code(GPS_L2_M_CODE_LENGTH_CHIPS);
+        for (uint32_t prn = 1; prn <= 50; prn++)
+            {
+                gps_l2c_m_code(code.data(), prn);
+                for (int32_t n = 0; n < GPS_L2_M_CODE_LENGTH_CHIPS; n++)
+                    {
+                        codes.set_chip(prn - 1, n, code[n] != 0);
+                    }
+            }
+        return codes;
+    }();
+    return table;
+}
 
-    if (_prn > 0 and _prn < 51)
-        {
-            gps_l2c_m_code(_code, _prn);
-        }
 
-    for (int32_t i = 0; i < GPS_L2_M_CODE_LENGTH_CHIPS; i++)
+void gps_l2c_m_code_gen_complex(std::complex<float>* _dest, uint32_t _prn)
+{
+    if (_prn > 0 and _prn < 51)
         {
-            _dest[i] = std::complex<float>(1.0 - 2.0 * _code[i], 0.0);
+            gps_l2c_m_code_table().unpack(_dest, _prn - 1);
         }
-
-    delete[] _code;
 }
 
 
 void gps_l2c_m_code_gen_float(float* _dest, uint32_t _prn)
 {
-    auto* _code = new int32_t[GPS_L2_M_CODE_LENGTH_CHIPS];
-
     if (_prn > 0 and _prn < 51)
         {
-            gps_l2c_m_code(_code, _prn);
-        }
-
-    for (int32_t i = 0; i < GPS_L2_M_CODE_LENGTH_CHIPS; i++)
-        {
-            _dest[i] = 1.0 - 2.0 * static_cast<float>(_code[i]);
+            gps_l2c_m_code_table().unpack(_dest, _prn - 1);
         }
-
-    delete[] _code;
 }
 
 
@@ -94,45 +98,16 @@ void gps_l2c_m_code_gen_float(float* _dest, uint32_t _prn)
  */
 void gps_l2c_m_code_gen_complex_sampled(std::complex<float>* _dest, uint32_t _prn, int32_t _fs)
 {
-    auto* _code = new int32_t[GPS_L2_M_CODE_LENGTH_CHIPS];
+    auto* _code = new std::complex<float>[GPS_L2_M_CODE_LENGTH_CHIPS]();
     if (_prn > 0 and _prn < 51)
         {
-            gps_l2c_m_code(_code, _prn);
+            gps_l2c_m_code_table().unpack(_code, _prn - 1);
         }
 
-    int32_t _samplesPerCode, _codeValueIndex;
-    float _ts;
-    float _tc;
-    const int32_t _codeLength = GPS_L2_M_CODE_LENGTH_CHIPS;
-
     //--- Find number of samples per spreading code ----------------------------
-    _samplesPerCode = static_cast<int32_t>(static_cast<double>(_fs) / (static_cast<double>(GPS_L2_M_CODE_RATE_HZ) / static_cast<double>(_codeLength)));
-
-    //--- Find time constants --------------------------------------------------
-    _ts = 1.0 / static_cast<float>(_fs);                    // Sampling period in sec
-    _tc = 1.0 / static_cast<float>(GPS_L2_M_CODE_RATE_HZ);  // C/A chip period in sec
-
-    //float aux;
-    for (int32_t i = 0; i < _samplesPerCode; i++)
-        {
-            //=== Digitizing =======================================================
-
-            //--- Make index array to read L2C code values -------------------------
-            //TODO: Check this formula! Seems to start with an extra sample
-            _codeValueIndex = ceil((_ts * (static_cast<float>(i) + 1)) / _tc) - 1;
-            //aux = (_ts * (i + 1)) / _tc;
-            //_codeValueIndex = static_cast<int32_t>(static_cast<long>(aux)) - 1;
+    const int32_t _codeLength = GPS_L2_M_CODE_LENGTH_CHIPS;
+    auto _samplesPerCode = static_cast<int32_t>(static_cast<double>(_fs) / (static_cast<double>(GPS_L2_M_CODE_RATE_HZ) / static_cast<double>(_codeLength)));
 
-            //--- Make the digitized version of the L2C code -----------------------
-            if (i == _samplesPerCode - 1)
-                {
-                    //--- Correct the last index (due to number rounding issues) -----------
-                    _dest[i] = std::complex<float>(1.0 - 2.0 * _code[_codeLength - 1], 0);
-                }
-            else
-                {
-                    _dest[i] = std::complex<float>(1.0 - 2.0 * _code[_codeValueIndex], 0);  //repeat the chip -> upsample
-                }
-        }
+    resampler_ceil(_code, _dest, GPS_L2_M_CODE_RATE_HZ, _fs, _codeLength, _samplesPerCode);  //repeat the chip -> upsample
     delete[] _code;
 }
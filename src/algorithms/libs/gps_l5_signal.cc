@@ -32,6 +32,8 @@
 
 #include "gps_l5_signal.h"
 #include "GPS_L5.h"
+#include "gnss_code_table.h"
+#include "gnss_signal_processing.h"
 #include <cinttypes>
 #include <cmath>
 #include <complex>
@@ -134,79 +136,51 @@ std::deque<bool> make_l5q_xb()
 }
 
 
-void make_l5i(int32_t* _dest, int32_t prn)
+// The XA and XB sequences are generated once, the codes of all the PRNs are made from them
+Gnss_Code_Table make_l5_code_table(const int32_t* xb_offsets, const std::deque<bool>& xa, const std::deque<bool>& xb)
 {
-    int32_t xb_offset = GPS_L5i_INIT_REG[prn];
-
-    std::deque<bool> xb = make_l5i_xb();
-    std::deque<bool> xa = make_l5i_xa();
-    std::deque<bool> xb_shift(GPS_L5i_CODE_LENGTH_CHIPS, false);
-
-    for (int32_t n = 0; n < GPS_L5i_CODE_LENGTH_CHIPS; n++)
-        {
-            xb_shift[n] = xb[(xb_offset + n) % GPS_L5i_CODE_LENGTH_CHIPS];
-        }
-    std::deque<bool> out_code(GPS_L5i_CODE_LENGTH_CHIPS, false);
-    for (int32_t n = 0; n < GPS_L5i_CODE_LENGTH_CHIPS; n++)
+    Gnss_Code_Table table(50, GPS_L5i_CODE_LENGTH_CHIPS);
+    for (uint32_t prn = 0; prn < 50; prn++)
         {
-            _dest[n] = xa[n] xor xb_shift[n];
+            int32_t xb_offset = xb_offsets[prn];
+            for (int32_t n = 0; n < GPS_L5i_CODE_LENGTH_CHIPS; n++)
+                {
+                    table.set_chip(prn, n, xa[n] xor xb[(xb_offset + n) % GPS_L5i_CODE_LENGTH_CHIPS]);
+                }
         }
+    return table;
 }
 
 
-void make_l5q(int32_t* _dest, int32_t prn)
+const Gnss_Code_Table& gps_l5i_code_table()
 {
-    int32_t xb_offset = GPS_L5q_INIT_REG[prn];
+    static const Gnss_Code_Table table = make_l5_code_table(GPS_L5i_INIT_REG, make_l5i_xa(), make_l5i_xb());
+    return table;
+}
 
-    std::deque<bool> xb = make_l5q_xb();
-    std::deque<bool> xa = make_l5q_xa();
-    std::deque<bool> xb_shift(GPS_L5q_CODE_LENGTH_CHIPS, false);
 
-    for (int32_t n = 0; n < GPS_L5q_CODE_LENGTH_CHIPS; n++)
-        {
-            xb_shift[n] = xb[(xb_offset + n) % GPS_L5q_CODE_LENGTH_CHIPS];
-        }
-    std::deque<bool> out_code(GPS_L5q_CODE_LENGTH_CHIPS, false);
-    for (int32_t n = 0; n < GPS_L5q_CODE_LENGTH_CHIPS; n++)
-        {
-            _dest[n] = xa[n] xor xb_shift[n];
-        }
+const Gnss_Code_Table& gps_l5q_code_table()
+{
+    static const Gnss_Code_Table table = make_l5_code_table(GPS_L5q_INIT_REG, make_l5q_xa(), make_l5q_xb());
+    return table;
 }
 
 
 void gps_l5i_code_gen_complex(std::complex<float>* _dest, uint32_t _prn)
 {
-    auto* _code = new int32_t[GPS_L5i_CODE_LENGTH_CHIPS];
-
     if (_prn > 0 and _prn < 51)
         {
-            make_l5i(_code, _prn - 1);
-        }
-
-    for (int32_t i = 0; i < GPS_L5i_CODE_LENGTH_CHIPS; i++)
-        {
-            _dest[i] = std::complex<float>(1.0 - 2.0 * _code[i], 0.0);
+            gps_l5i_code_table().unpack(_dest, _prn - 1);
         }
-
-    delete[] _code;
 }
 
 
 void gps_l5i_code_gen_float(float* _dest, uint32_t _prn)
 {
-    auto* _code = new int32_t[GPS_L5i_CODE_LENGTH_CHIPS];
-
     if (_prn > 0 and _prn < 51)
         {
-            make_l5i(_code, _prn - 1);
-        }
-
-    for (int32_t i = 0; i < GPS_L5i_CODE_LENGTH_CHIPS; i++)
-        {
-            _dest[i] = 1.0 - 2.0 * static_cast<float>(_code[i]);
+            gps_l5i_code_table().unpack(_dest, _prn - 1);
         }
-
-    delete[] _code;
 }
 
 
@@ -215,83 +189,36 @@ void gps_l5i_code_gen_float(float* _dest, uint32_t _prn)
  */
 void gps_l5i_code_gen_complex_sampled(std::complex<float>* _dest, uint32_t _prn, int32_t _fs)
 {
-    auto* _code = new int32_t[GPS_L5i_CODE_LENGTH_CHIPS];
+    auto* _code = new std::complex<float>[GPS_L5i_CODE_LENGTH_CHIPS]();
     if (_prn > 0 and _prn < 51)
         {
-            make_l5i(_code, _prn - 1);
+            gps_l5i_code_table().unpack(_code, _prn - 1);
         }
 
-    int32_t _samplesPerCode, _codeValueIndex;
-    float _ts;
-    float _tc;
-    const int32_t _codeLength = GPS_L5i_CODE_LENGTH_CHIPS;
-
     //--- Find number of samples per spreading code ----------------------------
-    _samplesPerCode = static_cast<int32_t>(static_cast<double>(_fs) / (static_cast<double>(GPS_L5i_CODE_RATE_HZ) / static_cast<double>(_codeLength)));
-
-    //--- Find time constants --------------------------------------------------
-    _ts = 1.0 / static_cast<float>(_fs);                   // Sampling period in sec
-    _tc = 1.0 / static_cast<float>(GPS_L5i_CODE_RATE_HZ);  // C/A chip period in sec
-
-    //float aux;
-    for (int32_t i = 0; i < _samplesPerCode; i++)
-        {
-            //=== Digitizing =======================================================
-
-            //--- Make index array to read L5 code values -------------------------
-            //TODO: Check this formula! Seems to start with an extra sample
-            _codeValueIndex = ceil((_ts * (static_cast<float>(i) + 1)) / _tc) - 1;
-            //aux = (_ts * (i + 1)) / _tc;
-            //_codeValueIndex = static_cast<int32_t> (static_cast<long>(aux)) - 1;
+    const int32_t _codeLength = GPS_L5i_CODE_LENGTH_CHIPS;
+    auto _samplesPerCode = static_cast<int32_t>(static_cast<double>(_fs) / (static_cast<double>(GPS_L5i_CODE_RATE_HZ) / static_cast<double>(_codeLength)));
 
-            //--- Make the digitized version of the L2C code -----------------------
-            if (i == _samplesPerCode - 1)
-                {
-                    //--- Correct the last index (due to number rounding issues) -----------
-                    _dest[i] = std::complex<float>(1.0 - 2.0 * _code[_codeLength - 1], 0);
-                }
-            else
-                {
-                    _dest[i] = std::complex<float>(1.0 - 2.0 * _code[_codeValueIndex], 0);  //repeat the chip -> upsample
-                }
-        }
+    resampler_ceil(_code, _dest, GPS_L5i_CODE_RATE_HZ, _fs, _codeLength, _samplesPerCode);  //repeat the chip -> upsample
     delete[] _code;
 }
 
 
 void gps_l5q_code_gen_complex(std::complex<float>* _dest, uint32_t _prn)
 {
-    auto* _code = new int32_t[GPS_L5q_CODE_LENGTH_CHIPS];
-
     if (_prn > 0 and _prn < 51)
         {
-            make_l5q(_code, _prn - 1);
-        }
-
-    for (int32_t i = 0; i < GPS_L5q_CODE_LENGTH_CHIPS; i++)
-        {
-            _dest[i] = std::complex<float>(1.0 - 2.0 * _code[i], 0.0);
+            gps_l5q_code_table().unpack(_dest, _prn - 1);
         }
-
-    delete[] _code;
 }
 
 
 void gps_l5q_code_gen_float(float* _dest, uint32_t _prn)
 {
-    auto* _code = new int32_t[GPS_L5q_CODE_LENGTH_CHIPS];
-
     if (_prn > 0 and _prn < 51)
         {
-            make_l5q(_code, _prn - 1);
-        }
-
-    for (int32_t i = 0; i < GPS_L5q_CODE_LENGTH_CHIPS; i++)
-        {
-            _dest[i] = 1.0 - 2.0 * static_cast<float>(_code[i]);
+            gps_l5q_code_table().unpack(_dest, _prn - 1);
         }
-
-    delete[] _code;
 }
 
 
@@ -300,45 +227,16 @@ void gps_l5q_code_gen_float(float* _dest, uint32_t _prn)
  */
 void gps_l5q_code_gen_complex_sampled(std::complex<float>* _dest, uint32_t _prn, int32_t _fs)
 {
-    auto* _code = new int32_t[GPS_L5q_CODE_LENGTH_CHIPS];
+    auto* _code = new std::complex<float>[GPS_L5q_CODE_LENGTH_CHIPS]();
     if (_prn > 0 and _prn < 51)
         {
-            make_l5q(_code, _prn - 1);
+            gps_l5q_code_table().unpack(_code, _prn - 1);
         }
 
-    int32_t _samplesPerCode, _codeValueIndex;
-    float _ts;
-    float _tc;
-    const int32_t _codeLength = GPS_L5q_CODE_LENGTH_CHIPS;
-
     //--- Find number of samples per spreading code ----------------------------
-    _samplesPerCode = static_cast<int32_t>(static_cast<double>(_fs) / (static_cast<double>(GPS_L5q_CODE_RATE_HZ) / static_cast<double>(_codeLength)));
-
-    //--- Find time constants --------------------------------------------------
-    _ts = 1.0 / static_cast<float>(_fs);                   // Sampling period in sec
-    _tc = 1.0 / static_cast<float>(GPS_L5q_CODE_RATE_HZ);  // C/A chip period in sec
-
-    //float aux;
-    for (int32_t i = 0; i < _samplesPerCode; i++)
-        {
-            //=== Digitizing =======================================================
-
-            //--- Make index array to read L5 code values -------------------------
-            //TODO: Check this formula! Seems to start with an extra sample
-            _codeValueIndex = ceil((_ts * (static_cast<float>(i) + 1)) / _tc) - 1;
-            //aux = (_ts * (i + 1)) / _tc;
-            //_codeValueIndex = static_cast<int32_t> (static_cast<long>(aux)) - 1;
+    const int32_t _codeLength = GPS_L5q_CODE_LENGTH_CHIPS;
+    auto _samplesPerCode = static_cast<int32_t>(static_cast<double>(_fs) / (static_cast<double>(GPS_L5q_CODE_RATE_HZ) / static_cast<double>(_codeLength)));
 
-            //--- Make the digitized version of the L2C code -----------------------
-            if (i == _samplesPerCode - 1)
-                {
-                    //--- Correct the last index (due to number rounding issues) -----------
-                    _dest[i] = std::complex<float>(1.0 - 2.0 * _code[_codeLength - 1], 0);
-                }
-            else
-                {
-                    _dest[i] = std::complex<float>(1.0 - 2.0 * _code[_codeValueIndex], 0);  //repeat the chip -> upsample
-                }
-        }
+    resampler_ceil(_code, _dest, GPS_L5q_CODE_RATE_HZ, _fs, _codeLength, _samplesPerCode);  //repeat the chip -> upsample
     delete[] _code;
 }
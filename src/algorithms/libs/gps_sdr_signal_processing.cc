@@ -31,20 +31,18 @@
  */
 
 #include "gps_sdr_signal_processing.h"
+#include "gnss_code_table.h"
+#include "gnss_signal_processing.h"
 
-auto auxCeil = [](float x) { return static_cast<int32_t>(static_cast<int64_t>((x) + 1)); };
-
-void gps_l1_ca_code_gen_int(int32_t* _dest, int32_t _prn, uint32_t _chip_shift)
+Gnss_Code_Table make_gps_l1_ca_code_table()
 {
     const uint32_t _code_length = 1023;
     bool G1[_code_length];
     bool G2[_code_length];
     bool G1_register[10], G2_register[10];
     bool feedback1, feedback2;
-    bool aux;
     uint32_t lcv, lcv2;
     uint32_t delay;
-    int32_t prn_idx;
 
     /* G2 Delays as defined in GPS-ISD-200D */
     const int32_t delays[51] = {5 /*PRN1*/, 6, 7, 8, 17, 18, 139, 140, 141, 251, 252, 254, 255, 256, 257, 258, 469, 470, 471, 472,
@@ -52,20 +50,6 @@ void gps_l1_ca_code_gen_int(int32_t* _dest, int32_t _prn, uint32_t _chip_shift)
         145 /*PRN120*/, 175, 52, 21, 237, 235, 886, 657, 634, 762,
         355, 1012, 176, 603, 130, 359, 595, 68, 386 /*PRN138*/};
 
-    // compute delay array index for given PRN number
-    if (120 <= _prn && _prn <= 138)
-        {
-            prn_idx = _prn - 88;  // SBAS PRNs are at array indices 31 to 50 (offset: -120+33-1 =-88)
-        }
-    else
-        {
-            prn_idx = _prn - 1;
-        }
-
-    /* A simple error check */
-    if ((prn_idx < 0) || (prn_idx > 51))
-        return;
-
     for (lcv = 0; lcv < 10; lcv++)
         {
             G1_register[lcv] = true;
@@ -91,53 +75,76 @@ void gps_l1_ca_code_gen_int(int32_t* _dest, int32_t _prn, uint32_t _chip_shift)
             G2_register[9] = feedback2;
         }
 
-    /* Set the delay */
-    delay = _code_length - delays[prn_idx];
-    delay += _chip_shift;
-    delay %= _code_length;
-
-    /* Generate PRN from G1 and G2 Registers */
-    for (lcv = 0; lcv < _code_length; lcv++)
+    /* Generate the PRNs from G1 and G2 Registers */
+    Gnss_Code_Table table(51, _code_length);
+    for (uint32_t prn_idx = 0; prn_idx < 51; prn_idx++)
         {
-            aux = G1[(lcv + _chip_shift) % _code_length] ^ G2[delay];
-            if (aux == true)
-                {
-                    _dest[lcv] = 1;
-                }
-            else
+            delay = _code_length - delays[prn_idx];
+            for (lcv = 0; lcv < _code_length; lcv++)
                 {
-                    _dest[lcv] = -1;
+                    // a chip is +1 when G1 xor G2 is 1
+                    table.set_chip(prn_idx, lcv, (G1[lcv] ^ G2[delay]) == false);
+                    delay++;
+                    delay %= _code_length;
                 }
-            delay++;
-            delay %= _code_length;
         }
+    return table;
 }
 
 
-void gps_l1_ca_code_gen_float(float* _dest, int32_t _prn, uint32_t _chip_shift)
+const Gnss_Code_Table& gps_l1_ca_code_table()
 {
-    const uint32_t _code_length = 1023;
-    int32_t ca_code_int[_code_length];
+    static const Gnss_Code_Table table = make_gps_l1_ca_code_table();
+    return table;
+}
+
+
+// Index in the code table of a PRN, or -1 if the PRN has no C/A code
+int32_t gps_l1_ca_code_index(int32_t _prn)
+{
+    int32_t prn_idx;
+    if (120 <= _prn && _prn <= 138)
+        {
+            prn_idx = _prn - 88;  // SBAS PRNs are at array indices 32 to 50 (offset: -120+33-1 =-88)
+        }
+    else
+        {
+            prn_idx = _prn - 1;
+        }
+    if ((prn_idx < 0) || (prn_idx > 50))
+        {
+            return -1;
+        }
+    return prn_idx;
+}
 
-    gps_l1_ca_code_gen_int(ca_code_int, _prn, _chip_shift);
 
-    for (uint32_t ii = 0; ii < _code_length; ++ii)
+void gps_l1_ca_code_gen_int(int32_t* _dest, int32_t _prn, uint32_t _chip_shift)
+{
+    int32_t prn_idx = gps_l1_ca_code_index(_prn);
+    if (prn_idx >= 0)
         {
-            _dest[ii] = static_cast<float>(ca_code_int[ii]);
+            gps_l1_ca_code_table().unpack(_dest, prn_idx, _chip_shift);
         }
 }
 
 
-void gps_l1_ca_code_gen_complex(std::complex<float>* _dest, int32_t _prn, uint32_t _chip_shift)
+void gps_l1_ca_code_gen_float(float* _dest, int32_t _prn, uint32_t _chip_shift)
 {
-    const uint32_t _code_length = 1023;
-    int32_t ca_code_int[_code_length] = {0};
+    int32_t prn_idx = gps_l1_ca_code_index(_prn);
+    if (prn_idx >= 0)
+        {
+            gps_l1_ca_code_table().unpack(_dest, prn_idx, _chip_shift);
+        }
+}
 
-    gps_l1_ca_code_gen_int(ca_code_int, _prn, _chip_shift);
 
-    for (uint32_t ii = 0; ii < _code_length; ++ii)
+void gps_l1_ca_code_gen_complex(std::complex<float>* _dest, int32_t _prn, uint32_t _chip_shift)
+{
+    int32_t prn_idx = gps_l1_ca_code_index(_prn);
+    if (prn_idx >= 0)
         {
-            _dest[ii] = std::complex<float>(static_cast<float>(ca_code_int[ii]), 0.0f);
+            gps_l1_ca_code_table().unpack(_dest, prn_idx, _chip_shift);
         }
 }
 
@@ -150,45 +157,16 @@ void gps_l1_ca_code_gen_complex_sampled(std::complex<float>* _dest, uint32_t _pr
 {
     // This function is based on the GNU software GPS for MATLAB in the Kay Borre book
     std::complex<float> _code[1023];
-    int32_t _samplesPerCode, _codeValueIndex;
-    float _ts;
-    float _tc;
-    float aux;
+    int32_t _samplesPerCode;
     const int32_t _codeFreqBasis = 1023000;  //Hz
     const int32_t _codeLength = 1023;
 
     //--- Find number of samples per spreading code ----------------------------
     _samplesPerCode = static_cast<int32_t>(static_cast<double>(_fs) / static_cast<double>(_codeFreqBasis / _codeLength));
 
-    //--- Find time constants --------------------------------------------------
-    _ts = 1.0 / static_cast<float>(_fs);                   // Sampling period in sec
-    _tc = 1.0 / static_cast<float>(_codeFreqBasis);        // C/A chip period in sec
     gps_l1_ca_code_gen_complex(_code, _prn, _chip_shift);  //generate C/A code 1 sample per chip
 
-    for (int32_t i = 0; i < _samplesPerCode; i++)
-        {
-            //=== Digitizing =======================================================
-
-            //--- Make index array to read C/A code values -------------------------
-            // The length of the index array depends on the sampling frequency -
-            // number of samples per millisecond (because one C/A code period is one
-            // millisecond).
-
-            // _codeValueIndex = ceil((_ts * ((float)i + 1)) / _tc) - 1;
-            aux = (_ts * (i + 1)) / _tc;
-            _codeValueIndex = auxCeil(aux) - 1;
-
-            //--- Make the digitized version of the C/A code -----------------------
-            // The "upsampled" code is made by selecting values form the CA code
-            // chip array (caCode) for the time instances of each sample.
-            if (i == _samplesPerCode - 1)
-                {
-                    //--- Correct the last index (due to number rounding issues) -----------
-                    _dest[i] = _code[_codeLength - 1];
-                }
-            else
-                {
-                    _dest[i] = _code[_codeValueIndex];  //repeat the chip -> upsample
-                }
-        }
+    // The "upsampled" code is made by selecting values form the CA code
+    // chip array (caCode) for the time instances of each sample.
+    resampler(_code, _dest, _codeFreqBasis, _fs, _codeLength, _samplesPerCode);
 }
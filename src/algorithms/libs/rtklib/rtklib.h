@@ -282,10 +282,11 @@ const double MAXDTOE_SBS = 360.0;    //!<    max time difference to SBAS Toe (s)
 const double MAXDTOE_S = 86400.0;    //!<    max time difference to ephem toe (s) for other
 const double MAXGDOP = 300.0;        //!<    max GDOP
 
-const int MAXSBSURA = 8;  //!<    max URA of SBAS satellite
-const int MAXBAND = 10;   //!<    max SBAS band of IGP
-const int MAXNIGP = 201;  //!<    max number of IGP in SBAS band
-const int MAXNGEO = 4;    //!<    max number of GEO satellites
+const int MAXSBSURA = 8;       //!<    max URA of SBAS satellite
+const int MAXBAND = 10;        //!<    max SBAS band of IGP
+const int MAXNIGP = 201;       //!<    max number of IGP in SBAS band
+const int NIGPGRID = 35 * 72;  //!<    IGP positions in a 5x5 deg grid (lat -85..85, lon -180..175)
+const int MAXNGEO = 4;         //!<    max number of GEO satellites
 
 const int MAXSOLMSG = 8191;  //!<    max length of solution message
 const int MAXERRMSG = 4096;  //!<    max length of error/warning message
@@ -626,11 +627,12 @@ typedef struct
 
 
 typedef struct
-{                          /* SBAS satellite corrections type */
-    int iodp;              /* IODP (issue of date mask) */
-    int nsat;              /* number of satellites */
-    int tlat;              /* system latency (s) */
-    sbssatp_t sat[MAXSAT]; /* satellite correction */
+{                            /* SBAS satellite corrections type */
+    int iodp;                /* IODP (issue of date mask) */
+    int nsat;                /* number of satellites */
+    int tlat;                /* system latency (s) */
+    sbssatp_t sat[MAXSAT];   /* satellite correction */
+    short index[MAXSAT + 1]; /* index in sat[] of each satellite number +1 (0: not in mask) */
 } sbssat_t;
 
 
@@ -653,10 +655,11 @@ typedef struct
 
 
 typedef struct
-{                          /* SBAS ionospheric corrections type */
-    int iodi;              /* IODI (issue of date ionos corr) */
-    int nigp;              /* number of igps */
-    sbsigp_t igp[MAXNIGP]; /* ionospheric correction */
+{                                 /* SBAS ionospheric corrections type */
+    int iodi;                     /* IODI (issue of date ionos corr) */
+    int nigp;                     /* number of igps */
+    sbsigp_t igp[MAXNIGP];        /* ionospheric correction */
+    unsigned char grid[NIGPGRID]; /* index in igp[] of each grid position +1 (0: not in mask) */
 } sbsion_t;
 
 
@@ -54,6 +54,7 @@
 #include "rtklib_preceph.h"
 #include "rtklib_rtkcmn.h"
 #include "rtklib_sbas.h"
+#include <vector>
 
 /* constants ------------------------------------------------------*/
 
@@ -82,6 +83,10 @@ const double MAXAGESSR = 90.0;                   /* max age of ssr orbit and clo
 const double MAXAGESSR_HRCLK = 10.0;             /* max age of ssr high-rate clock (s) */
 const double STD_BRDCCLK = 30.0;                 /* error of broadcast clock (m) */
 
+const int EPHCACHE_NODES = 9;      /* interpolation nodes of the orbit cache */
+const double EPHCACHE_STEP = 30.0; /* spacing of the nodes (s) */
+const int EPHCACHE_KEY = 10;       /* ephemeris fields identifying a cache entry */
+
 const int MAX_ITER_KEPLER = 30; /* max number of iteration of Kelpler */
 
 
@@ -395,6 +400,129 @@ void geph2pos(gtime_t time, const geph_t *geph, double *rs, double *dts,
 }
 
 
+/* orbit cache ---------------------------------------------------------------
+ * broadcast orbits and clocks evaluated at EPHCACHE_NODES equispaced nodes
+ * around the requested time and interpolated (barycentric lagrange), so that
+ * high rate solutions and the iterations of the solver do not evaluate the
+ * keplerian elements or integrate the glonass orbit at every call. The nodes
+ * are centered again when the time leaves the central node interval, and
+ * recomputed when the ephemeris changes. One cache per thread.
+ *-----------------------------------------------------------------------------*/
+namespace
+{
+struct Eph_Cache_Entry
+{
+    int valid;
+    double key[EPHCACHE_KEY]; /* ephemeris the nodes were computed with */
+    gtime_t t0;               /* time of the first node */
+    double rs[EPHCACHE_NODES][3];
+    double dts[EPHCACHE_NODES];
+    double var;
+};
+
+
+std::vector<Eph_Cache_Entry> &eph_cache()
+{
+    static thread_local std::vector<Eph_Cache_Entry> cache(MAXSAT);
+    return cache;
+}
+
+
+void eph_cache_key(const eph_t *eph, const geph_t *geph, double *key)
+{
+    if (eph)
+        {
+            key[0] = static_cast<double>(eph->toe.time);
+            key[1] = eph->toe.sec;
+            key[2] = static_cast<double>(eph->toc.time);
+            key[3] = eph->toc.sec;
+            key[4] = eph->iode;
+            key[5] = eph->iodc;
+            key[6] = eph->A;
+            key[7] = eph->M0;
+            key[8] = eph->e;
+            key[9] = eph->f0;
+        }
+    else
+        {
+            key[0] = static_cast<double>(geph->toe.time);
+            key[1] = geph->toe.sec;
+            key[2] = geph->iode;
+            key[3] = geph->pos[0];
+            key[4] = geph->pos[1];
+            key[5] = geph->pos[2];
+            key[6] = geph->vel[0];
+            key[7] = geph->taun;
+            key[8] = geph->gamn;
+            key[9] = geph->acc[0];
+        }
+}
+
+
+/* satellite position and clock bias by eph (or geph if eph is null) through
+ * the cache of satellite sat ------------------------------------------------*/
+void eph_cache_pos(gtime_t time, int sat, const eph_t *eph, const geph_t *geph,
+    double *rs, double *dts, double *var)
+{
+    /* barycentric weights of equispaced nodes: (-1)^j*binomial(N-1,j) */
+    static const double w[EPHCACHE_NODES] = {1.0, -8.0, 28.0, -56.0, 70.0, -56.0, 28.0, -8.0, 1.0};
+    const double center = (EPHCACHE_NODES - 1) / 2.0;
+    double key[EPHCACHE_KEY], dts_node[2], s, c, sum;
+    int i, j;
+
+    if (sat <= 0 || sat > MAXSAT)
+        {
+            if (eph)
+                eph2pos(time, eph, rs, dts, var);
+            else
+                geph2pos(time, geph, rs, dts, var);
+            return;
+        }
+    Eph_Cache_Entry &entry = eph_cache()[sat - 1];
+    eph_cache_key(eph, geph, key);
+
+    s = entry.valid ? timediff(time, entry.t0) / EPHCACHE_STEP : 0.0;
+    if (!entry.valid || memcmp(key, entry.key, sizeof(key)) != 0 ||
+        s < center - 1.0 || s > center + 1.0)
+        {
+            entry.t0 = timeadd(time, -center * EPHCACHE_STEP);
+            for (j = 0; j < EPHCACHE_NODES; j++)
+                {
+                    gtime_t t = timeadd(entry.t0, j * EPHCACHE_STEP);
+                    if (eph)
+                        eph2pos(t, eph, entry.rs[j], dts_node, &entry.var);
+                    else
+                        geph2pos(t, geph, entry.rs[j], dts_node, &entry.var);
+                    entry.dts[j] = dts_node[0];
+                }
+            memcpy(entry.key, key, sizeof(key));
+            entry.valid = 1;
+            s = timediff(time, entry.t0) / EPHCACHE_STEP;
+        }
+    *var = entry.var;
+    for (j = 0; j < EPHCACHE_NODES; j++)
+        {
+            if (s == static_cast<double>(j))
+                {
+                    for (i = 0; i < 3; i++) rs[i] = entry.rs[j][i];
+                    dts[0] = entry.dts[j];
+                    return;
+                }
+        }
+    rs[0] = rs[1] = rs[2] = dts[0] = sum = 0.0;
+    for (j = 0; j < EPHCACHE_NODES; j++)
+        {
+            c = w[j] / (s - j);
+            for (i = 0; i < 3; i++) rs[i] += c * entry.rs[j][i];
+            dts[0] += c * entry.dts[j];
+            sum += c;
+        }
+    for (i = 0; i < 3; i++) rs[i] /= sum;
+    dts[0] /= sum;
+}
+}  // namespace
+
+
 /* sbas ephemeris to satellite clock bias --------------------------------------
  * compute satellite clock bias with sbas ephemeris
  * args   : gtime_t time     I   time by satellite clock (gpst)
@@ -608,17 +736,17 @@ int ephpos(gtime_t time, gtime_t teph, int sat, const nav_t *nav,
         {
             if (!(eph = seleph(teph, sat, iode, nav))) return 0;
 
-            eph2pos(time, eph, rs, dts, var);
+            eph_cache_pos(time, sat, eph, nullptr, rs, dts, var);
             time = timeadd(time, tt);
-            eph2pos(time, eph, rst, dtst, var);
+            eph_cache_pos(time, sat, eph, nullptr, rst, dtst, var);
             *svh = eph->svh;
         }
     else if (sys == SYS_GLO)
         {
             if (!(geph = selgeph(teph, sat, iode, nav))) return 0;
-            geph2pos(time, geph, rs, dts, var);
+            eph_cache_pos(time, sat, nullptr, geph, rs, dts, var);
             time = timeadd(time, tt);
-            geph2pos(time, geph, rst, dtst, var);
+            eph_cache_pos(time, sat, nullptr, geph, rst, dtst, var);
             *svh = geph->svh;
         }
     else if (sys == SYS_SBS)
@@ -646,17 +774,11 @@ int satpos_sbas(gtime_t time, gtime_t teph, int sat, const nav_t *nav,
     double *rs, double *dts, double *var, int *svh)
 {
     const sbssatp_t *sbs;
-    int i;
 
     trace(4, "satpos_sbas: time=%s sat=%2d\n", time_str(time, 3), sat);
 
     /* search sbas satellite correciton */
-    for (i = 0; i < nav->sbssat.nsat; i++)
-        {
-            sbs = nav->sbssat.sat + i;
-            if (sbs->sat == sat) break;
-        }
-    if (i >= nav->sbssat.nsat)
+    if (!(sbs = sbssatp(&nav->sbssat, sat)))
         {
             trace(2, "no sbas correction for orbit: %s sat=%2d\n", time_str(time, 0), sat);
             ephpos(time, teph, sat, nav, -1, rs, dts, var, svh);
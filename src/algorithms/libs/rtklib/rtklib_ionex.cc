@@ -577,10 +577,8 @@ int iontec(gtime_t time, const nav_t *nav, const double *pos,
             *var = VAR_NOTEC;
             return 1;
         }
-    for (i = 0; i < nav->nt; i++)
-        {
-            if (timediff(nav->tec[i].time, time) > 0.0) break;
-        }
+    /* first map after time */
+    i = timeindex(nav->tec, nav->nt, time, true);
     if (i == 0 || i >= nav->nt)
         {
             trace(2, "%s: tec grid out of period\n", time_str(time, 0));
@@ -52,6 +52,218 @@
 
 #include "rtklib_lambda.h"
 #include "rtklib_rtkcmn.h"
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+
+namespace
+{
+/* workspace of lambda(), kept by each thread and only grown, so the matrices
+ * are not allocated again at every epoch ------------------------------------*/
+struct Lambda_Workspace
+{
+    std::vector<double> A, L, D, Zit, z, E, W, dist, zb, zv, step;
+    std::vector<int> up;
+
+    void resize(int n, int m)
+    {
+        size_t nn = static_cast<size_t>(n) * n;
+        if (A.size() < nn) A.resize(nn);
+        if (L.size() < nn) L.resize(nn);
+        if (Zit.size() < nn) Zit.resize(nn);
+        if (D.size() < static_cast<size_t>(n)) D.resize(n);
+        if (z.size() < static_cast<size_t>(n)) z.resize(n);
+        if (dist.size() < static_cast<size_t>(n)) dist.resize(n);
+        if (zb.size() < static_cast<size_t>(n)) zb.resize(n);
+        if (zv.size() < static_cast<size_t>(n)) zv.resize(n);
+        if (step.size() < static_cast<size_t>(n)) step.resize(n);
+        if (up.size() < static_cast<size_t>(n)) up.resize(n);
+        if (E.size() < static_cast<size_t>(n) * m) E.resize(static_cast<size_t>(n) * m);
+        if (W.size() < static_cast<size_t>(n) * (n + 1)) W.resize(static_cast<size_t>(n) * (n + 1));
+    }
+};
+
+
+Lambda_Workspace &lambda_workspace()
+{
+    static thread_local Lambda_Workspace ws;
+    return ws;
+}
+
+
+/* LD factorization using the scratch matrix A (n x n) -----------------------*/
+int LD_factor(int n, const double *Q, double *L, double *D, double *A)
+{
+    int i, j, k;
+    double a;
+
+    memcpy(A, Q, sizeof(double) * n * n);
+    for (i = n - 1; i >= 0; i--)
+        {
+            if ((D[i] = A[i + i * n]) <= 0.0)
+                {
+                    return -1;
+                }
+            a = sqrt(D[i]);
+            for (j = 0; j <= i; j++) L[i + j * n] = A[i + j * n] / a;
+            for (j = 0; j <= i - 1; j++)
+                for (k = 0; k <= j; k++) A[j + k * n] -= L[i + k * n] * L[i + j * n];
+            for (j = 0; j <= i; j++) L[i + j * n] /= L[i + i * n];
+        }
+    return 0;
+}
+
+
+/* lambda reduction that transforms z=Z'*a in place and keeps Zit=inv(Z)',
+ * so the fixed solutions are F=Zit*E with no inversion afterwards. Zit is
+ * updated by columns, which are contiguous ----------------------------------*/
+void reduction_transform(int n, double *L, double *D, double *z, double *Zit)
+{
+    int i, j, k, l, mu;
+    double del, eta, lam, a0, a1;
+
+    j = n - 2;
+    k = n - 2;
+    while (j >= 0)
+        {
+            if (j <= k)
+                for (i = j + 1; i < n; i++)
+                    {
+                        /* integer gauss transformation */
+                        if ((mu = static_cast<int> ROUND_LAMBDA(L[i + j * n])) != 0)
+                            {
+                                for (l = i; l < n; l++) L[l + n * j] -= static_cast<double>(mu) * L[l + i * n];
+                                z[j] -= static_cast<double>(mu) * z[i];
+                                for (l = 0; l < n; l++) Zit[l + n * i] += static_cast<double>(mu) * Zit[l + n * j];
+                            }
+                    }
+            del = D[j] + L[j + 1 + j * n] * L[j + 1 + j * n] * D[j + 1];
+            if (del + 1E-6 < D[j + 1])
+                { /* compared considering numerical error */
+                    /* permutation */
+                    eta = D[j] / del;
+                    lam = D[j + 1] * L[j + 1 + j * n] / del;
+                    D[j] = eta * D[j + 1];
+                    D[j + 1] = del;
+                    for (l = 0; l <= j - 1; l++)
+                        {
+                            a0 = L[j + l * n];
+                            a1 = L[j + 1 + l * n];
+                            L[j + l * n] = -L[j + 1 + j * n] * a0 + a1;
+                            L[j + 1 + l * n] = eta * a0 + lam * a1;
+                        }
+                    L[j + 1 + j * n] = lam;
+                    for (l = j + 2; l < n; l++) SWAP_LAMBDA(L[l + j * n], L[l + (j + 1) * n]);
+                    SWAP_LAMBDA(z[j], z[j + 1]);
+                    std::swap_ranges(Zit + j * n, Zit + (j + 1) * n, Zit + (j + 1) * n);
+                    k = j;
+                    j = n - 2;
+                }
+            else
+                j--;
+        }
+}
+
+
+/* mlambda search on the workspace -----------------------------------------------
+ * Same tree traversal as search(), but the partial sums of the conditional
+ * estimates are only updated from the highest level changed since the last
+ * visit (the "path" strategy of ref. [2]): W[k*(n+1)+l] is the contribution
+ * of levels l..n-1 to zb[k], and up[k] the highest level not added yet.
+ *-----------------------------------------------------------------------------*/
+int search_workspace(int n, int m, const double *L, const double *D,
+    const double *zs, double *zn, double *s, Lambda_Workspace &ws)
+{
+    int i, j, k, l, c, nn = 0, imax = 0;
+    double newdist, maxdist = 1E99, y;
+    double *W = ws.W.data(), *dist = ws.dist.data(), *zb = ws.zb.data(), *z = ws.zv.data(), *step = ws.step.data();
+    int *up = ws.up.data();
+
+    for (i = 0; i < n; i++)
+        {
+            W[i * (n + 1) + n] = 0.0;
+            up[i] = n - 1;
+        }
+    k = n - 1;
+    dist[k] = 0.0;
+    zb[k] = zs[k];
+    z[k] = ROUND_LAMBDA(zb[k]);
+    y = zb[k] - z[k];
+    step[k] = SGN_LAMBDA(y);
+    for (c = 0; c < LOOPMAX; c++)
+        {
+            newdist = dist[k] + y * y / D[k];
+            if (newdist < maxdist)
+                {
+                    if (k != 0)
+                        {
+                            dist[--k] = newdist;
+                            /* z[k+1] has changed since row k was last used */
+                            if (up[k] < k + 1) up[k] = k + 1;
+                            double *Wk = W + k * (n + 1);
+                            const double *Lk = L + k * n;
+                            for (l = up[k]; l > k; l--) Wk[l] = Wk[l + 1] + (z[l] - zb[l]) * Lk[l];
+                            if (k > 0 && up[k - 1] < up[k]) up[k - 1] = up[k];
+                            up[k] = k;
+                            zb[k] = zs[k] + Wk[k + 1];
+                            z[k] = ROUND_LAMBDA(zb[k]);
+                            y = zb[k] - z[k];
+                            step[k] = SGN_LAMBDA(y);
+                        }
+                    else
+                        {
+                            if (nn < m)
+                                {
+                                    if (nn == 0 || newdist > s[imax]) imax = nn;
+                                    for (i = 0; i < n; i++) zn[i + nn * n] = z[i];
+                                    s[nn++] = newdist;
+                                }
+                            else
+                                {
+                                    if (newdist < s[imax])
+                                        {
+                                            for (i = 0; i < n; i++) zn[i + imax * n] = z[i];
+                                            s[imax] = newdist;
+                                            for (i = imax = 0; i < m; i++)
+                                                if (s[imax] < s[i]) imax = i;
+                                        }
+                                    maxdist = s[imax];
+                                }
+                            z[0] += step[0];
+                            y = zb[0] - z[0];
+                            step[0] = -step[0] - SGN_LAMBDA(step[0]);
+                        }
+                }
+            else
+                {
+                    if (k == n - 1)
+                        break;
+
+                    k++;
+                    z[k] += step[k];
+                    y = zb[k] - z[k];
+                    step[k] = -step[k] - SGN_LAMBDA(step[k]);
+                }
+        }
+    for (i = 0; i < m - 1; i++)
+        { /* sort by s */
+            for (j = i + 1; j < m; j++)
+                {
+                    if (s[i] < s[j]) continue;
+                    SWAP_LAMBDA(s[i], s[j]);
+                    std::swap_ranges(zn + i * n, zn + (i + 1) * n, zn + j * n);
+                }
+        }
+
+    if (c >= LOOPMAX)
+        {
+            fprintf(stderr, "%s : search loop count overflow\n", __FILE__);
+            return -1;
+        }
+    return 0;
+}
+}  // namespace
 
 /* LD factorization (Q=L'*diag(D)*L) -----------------------------------------*/
 int LD(int n, const double *Q, double *L, double *D)
@@ -239,38 +451,37 @@ int search(int n, int m, const double *L, const double *D,
  *          double *s     O  sum of squared residulas of fixed solutions (1 x m)
  * return : status (0:ok,other:error)
  * notes  : matrix stored by column-major order (fortran convension)
+ *          the matrices are kept in a per-thread workspace between calls
  *-----------------------------------------------------------------------------*/
 int lambda(int n, int m, const double *a, const double *Q, double *F,
     double *s)
 {
-    int info;
-    double *L, *D, *Z, *z, *E;
+    int i, info;
 
     if (n <= 0 || m <= 0) return -1;
-    L = zeros(n, n);
-    D = mat(n, 1);
-    Z = eye(n);
-    z = mat(n, 1);
-    E = mat(n, m);
+    Lambda_Workspace &ws = lambda_workspace();
+    ws.resize(n, m);
+    double *L = ws.L.data(), *D = ws.D.data(), *Zit = ws.Zit.data(), *z = ws.z.data(), *E = ws.E.data();
+
+    std::fill(L, L + n * n, 0.0);
+    std::fill(Zit, Zit + n * n, 0.0);
+    for (i = 0; i < n; i++) Zit[i + i * n] = 1.0;
+    memcpy(z, a, sizeof(double) * n);
 
     /* LD factorization */
-    if (!(info = LD(n, Q, L, D)))
+    if ((info = LD_factor(n, Q, L, D, ws.A.data())))
         {
-            /* lambda reduction */
-            reduction(n, L, D, Z);
-            matmul("TN", n, 1, n, 1.0, Z, a, 0.0, z); /* z=Z'*a */
+            fprintf(stderr, "%s : LD factorization error\n", __FILE__);
+            return info;
+        }
+    /* lambda reduction, z=Z'*a */
+    reduction_transform(n, L, D, z, Zit);
 
-            /* mlambda search */
-            if (!(info = search(n, m, L, D, z, E, s)))
-                {
-                    info = solve("T", Z, E, n, m, F); /* F=Z'\E */
-                }
+    /* mlambda search */
+    if (!(info = search_workspace(n, m, L, D, z, E, s, ws)))
+        {
+            matmul("NN", n, m, n, 1.0, Zit, E, 0.0, F); /* F=Z'\E */
         }
-    free(L);
-    free(D);
-    free(Z);
-    free(z);
-    free(E);
     return info;
 }
 
@@ -54,6 +54,10 @@
 #include "rtklib_ephemeris.h"
 #include "rtklib_ionex.h"
 #include "rtklib_sbas.h"
+#include <vector>
+
+const double GEOCACHE_POS_TOL = 1.0;   /* receiver displacement that invalidates the geometry cache (m) */
+const double GEOCACHE_TIME_TOL = 0.2;  /* max age of the cached geometry (s) */
 
 /* pseudorange measurement error variance ------------------------------------*/
 double varerr(const prcopt_t *opt, double el, int sys)
@@ -394,6 +398,67 @@ int tropcorr(gtime_t time, const nav_t *nav __attribute__((unused)), const doubl
 }
 
 
+/* line-of-sight geometry cache -------------------------------------------------
+ * azimuth/elevation and ionospheric/tropospheric delays of each satellite, as
+ * computed at the last receiver position and time. They are reused by the
+ * following iterations of the solver and by the following epochs while the
+ * receiver position estimate moves less than GEOCACHE_POS_TOL and the time less
+ * than GEOCACHE_TIME_TOL, which saves the transcendental functions of satazel(),
+ * ionocorr() and tropcorr(). The first iteration (broadcast models) and the
+ * following ones (configured models) keep separate entries. One cache per
+ * thread.
+ *-----------------------------------------------------------------------------*/
+namespace
+{
+struct Geo_Cache_Entry
+{
+    int valid;
+    gtime_t time;  /* time and receiver position the geometry was computed at */
+    double rr[3];
+    int ionoopt, tropopt;
+    double azel[2];
+    double dion, vion, dtrp, vtrp;
+};
+
+
+std::vector<Geo_Cache_Entry> &geo_cache()
+{
+    static thread_local std::vector<Geo_Cache_Entry> cache(MAXSAT * 2);
+    return cache;
+}
+
+
+/* cache entry of satellite sat, invalidated if it does not match the receiver
+ * position, time and models ------------------------------------------------*/
+Geo_Cache_Entry *geo_cache_get(gtime_t time, int sat, const double *rr, int iter,
+    int ionoopt, int tropopt)
+{
+    Geo_Cache_Entry *entry = &geo_cache()[(sat - 1) * 2 + (iter > 0 ? 1 : 0)];
+    double dr[3];
+    int i;
+
+    if (entry->valid)
+        {
+            for (i = 0; i < 3; i++) dr[i] = rr[i] - entry->rr[i];
+            if (entry->ionoopt != ionoopt || entry->tropopt != tropopt ||
+                std::fabs(timediff(time, entry->time)) > GEOCACHE_TIME_TOL ||
+                dot(dr, dr, 3) > GEOCACHE_POS_TOL * GEOCACHE_POS_TOL)
+                {
+                    entry->valid = 0;
+                }
+        }
+    if (!entry->valid)
+        {
+            entry->time = time;
+            for (i = 0; i < 3; i++) entry->rr[i] = rr[i];
+            entry->ionoopt = ionoopt;
+            entry->tropopt = tropopt;
+        }
+    return entry;
+}
+}  // namespace
+
+
 /* pseudorange residuals -----------------------------------------------------*/
 int rescode(int iter, const obsd_t *obs, int n, const double *rs,
     const double *dts, const double *vare, const int *svh,
@@ -403,6 +468,9 @@ int rescode(int iter, const obsd_t *obs, int n, const double *rs,
 {
     double r, dion, dtrp, vmeas, vion, vtrp, rr[3], pos[3], dtr, e[3], P, lam_L1;
     int i, j, nv = 0, sys, mask[4] = {0};
+    int ionoopt = iter > 0 ? opt->ionoopt : IONOOPT_BRDC;
+    int tropopt = iter > 0 ? opt->tropopt : TROPOPT_SAAS;
+    Geo_Cache_Entry *geo;
 
     trace(3, "resprng : n=%d\n", n);
 
@@ -432,7 +500,17 @@ int rescode(int iter, const obsd_t *obs, int n, const double *rs,
                     trace(4, "geodist error\n");
                     continue;
                 }
-            double elaux = satazel(pos, e, azel + i * 2);
+            geo = geo_cache_get(obs[i].time, obs[i].sat, rr, iter, ionoopt, tropopt);
+            if (geo->valid)
+                {
+                    azel[i * 2] = geo->azel[0];
+                    azel[1 + i * 2] = geo->azel[1];
+                }
+            else
+                {
+                    satazel(pos, e, azel + i * 2);
+                }
+            double elaux = azel[1 + i * 2];
             if (elaux < opt->elmin)
                 {
                     trace(4, "satazel error. el = %lf , elmin = %lf\n", elaux, opt->elmin);
@@ -452,12 +530,36 @@ int rescode(int iter, const obsd_t *obs, int n, const double *rs,
                     continue;
                 }
 
-            /* ionospheric corrections */
-            if (!ionocorr(obs[i].time, nav, obs[i].sat, pos, azel + i * 2,
-                    iter > 0 ? opt->ionoopt : IONOOPT_BRDC, &dion, &vion))
+            if (geo->valid)
                 {
-                    trace(4, "ionocorr error\n");
-                    continue;
+                    dion = geo->dion;
+                    vion = geo->vion;
+                    dtrp = geo->dtrp;
+                    vtrp = geo->vtrp;
+                }
+            else
+                {
+                    /* ionospheric corrections */
+                    if (!ionocorr(obs[i].time, nav, obs[i].sat, pos, azel + i * 2,
+                            ionoopt, &dion, &vion))
+                        {
+                            trace(4, "ionocorr error\n");
+                            continue;
+                        }
+                    /* tropospheric corrections */
+                    if (!tropcorr(obs[i].time, nav, pos, azel + i * 2,
+                            tropopt, &dtrp, &vtrp))
+                        {
+                            trace(4, "tropocorr error\n");
+                            continue;
+                        }
+                    geo->azel[0] = azel[i * 2];
+                    geo->azel[1] = azel[1 + i * 2];
+                    geo->dion = dion;
+                    geo->vion = vion;
+                    geo->dtrp = dtrp;
+                    geo->vtrp = vtrp;
+                    geo->valid = 1;
                 }
 
             /* GPS-L1 -> L1/B1 */
@@ -465,13 +567,6 @@ int rescode(int iter, const obsd_t *obs, int n, const double *rs,
                 {
                     dion *= std::pow(lam_L1 / lam_carr[0], 2.0);
                 }
-            /* tropospheric corrections */
-            if (!tropcorr(obs[i].time, nav, pos, azel + i * 2,
-                    iter > 0 ? opt->tropopt : TROPOPT_SAAS, &dtrp, &vtrp))
-                {
-                    trace(4, "tropocorr error\n");
-                    continue;
-                }
             /* pseudorange residual */
             v[nv] = P - (r + dtr - SPEED_OF_LIGHT * dts[i * 2] + dion + dtrp);
 
@@ -620,7 +620,7 @@ double interppol(const double *x, double *y, int n)
 int pephpos(gtime_t time, int sat, const nav_t *nav, double *rs,
     double *dts, double *vare, double *varc)
 {
-    double t[NMAX + 1], p[3][NMAX + 1], c[2], *pos, std = 0.0, s[3], sinl, cosl;
+    double t[NMAX + 1], p[3][NMAX + 1], w[NMAX + 1], c[2], *pos, std = 0.0, s[3], sinl, cosl;
     int i, j, k, index;
 
     trace(4, "pephpos : time=%s sat=%2d\n", time_str(time, 3), sat);
@@ -634,15 +634,9 @@ int pephpos(gtime_t time, int sat, const nav_t *nav, double *rs,
             trace(3, "no prec ephem %s sat=%2d\n", time_str(time, 0), sat);
             return 0;
         }
-    /* binary search */
-    for (i = 0, j = nav->ne - 1; i < j;)
-        {
-            k = (i + j) / 2;
-            if (timediff(nav->peph[k].time, time) < 0.0)
-                i = k + 1;
-            else
-                j = k;
-        }
+    /* first epoch at or after time */
+    i = timeindex(nav->peph, nav->ne, time, false);
+    if (i > nav->ne - 1) i = nav->ne - 1;
     index = i <= 0 ? 0 : i - 1;
 
     /* polynomial interpolation for orbit */
@@ -676,9 +670,20 @@ int pephpos(gtime_t time, int sat, const nav_t *nav, double *rs,
 #endif
             p[2][j] = pos[2];
         }
+    /* lagrange basis at time, shared by the three coordinates (same result as
+       interppol() on each of them) */
+    for (j = 0; j <= NMAX; j++)
+        {
+            w[j] = 1.0;
+            for (k = 0; k <= NMAX; k++)
+                {
+                    if (k != j) w[j] *= t[k] / (t[k] - t[j]);
+                }
+        }
     for (i = 0; i < 3; i++)
         {
-            rs[i] = interppol(t, p[i], NMAX + 1);
+            rs[i] = 0.0;
+            for (j = 0; j <= NMAX; j++) rs[i] += w[j] * p[i][j];
         }
     if (vare)
         {
@@ -732,7 +737,7 @@ int pephclk(gtime_t time, int sat, const nav_t *nav, double *dts,
     double *varc)
 {
     double t[2], c[2], std;
-    int i, j, k, index;
+    int i, index;
 
     trace(4, "pephclk : time=%s sat=%2d\n", time_str(time, 3), sat);
 
@@ -743,15 +748,9 @@ int pephclk(gtime_t time, int sat, const nav_t *nav, double *dts,
             trace(3, "no prec clock %s sat=%2d\n", time_str(time, 0), sat);
             return 1;
         }
-    /* binary search */
-    for (i = 0, j = nav->nc - 1; i < j;)
-        {
-            k = (i + j) / 2;
-            if (timediff(nav->pclk[k].time, time) < 0.0)
-                i = k + 1;
-            else
-                j = k;
-        }
+    /* first epoch at or after time */
+    i = timeindex(nav->pclk, nav->nc, time, false);
+    if (i > nav->nc - 1) i = nav->nc - 1;
     index = i <= 0 ? 0 : i - 1;
 
     /* linear interpolation for clock */
@@ -59,6 +59,7 @@
 #include <sys/stat.h>
 #include <sys/time.h>
 #include <sys/types.h>
+#include <vector>
 
 
 const double gpst0[] = {1980, 1, 6, 0, 0, 0}; /* gps time reference */
@@ -232,6 +233,66 @@ extern "C"
 }
 
 
+namespace
+{
+/* scratch matrices of the matrix routines ------------------------------------
+ * kept by each thread and only grown, so the kalman filter of rtkpos() does
+ * not allocate its matrices at every epoch. Each routine uses its own slots.
+ *-----------------------------------------------------------------------------*/
+enum Matrix_Slot
+{
+    SLOT_MATINV_WORK,
+    SLOT_FILTER_F,
+    SLOT_FILTER_Q,
+    SLOT_FILTER_K,
+    SLOT_FILTER_X,
+    SLOT_FILTER_XP,
+    SLOT_FILTER_P,
+    SLOT_FILTER_PP,
+    SLOT_FILTER_H,
+    SLOT_LSQ_AY,
+    NUM_MATRIX_SLOTS
+};
+
+enum Index_Slot
+{
+    SLOT_MATINV_IPIV,
+    SLOT_FILTER_IX,
+    NUM_INDEX_SLOTS
+};
+
+struct Matrix_Workspace
+{
+    std::vector<double> matrices[NUM_MATRIX_SLOTS];
+    std::vector<int> indices[NUM_INDEX_SLOTS];
+};
+
+
+Matrix_Workspace &matrix_workspace()
+{
+    static thread_local Matrix_Workspace ws;
+    return ws;
+}
+
+
+double *workspace_mat(Matrix_Slot slot, int n, int m)
+{
+    std::vector<double> &buffer = matrix_workspace().matrices[slot];
+    size_t size = static_cast<size_t>(n) * static_cast<size_t>(m);
+    if (buffer.size() < size) buffer.resize(size);
+    return buffer.data();
+}
+
+
+int *workspace_imat(Index_Slot slot, int n)
+{
+    std::vector<int> &buffer = matrix_workspace().indices[slot];
+    if (buffer.size() < static_cast<size_t>(n)) buffer.resize(n);
+    return buffer.data();
+}
+}  // namespace
+
+
 /* function prototypes -------------------------------------------------------*/
 
 
@@ -997,13 +1058,11 @@ void matmul(const char *tr, int n, int k, int m, double alpha,
 int matinv(double *A, int n)
 {
     double *work;
-    int info, lwork = n * 16, *ipiv = imat(n, 1);
+    int info, lwork = n * 16, *ipiv = workspace_imat(SLOT_MATINV_IPIV, n);
 
-    work = mat(lwork, 1);
+    work = workspace_mat(SLOT_MATINV_WORK, lwork, 1);
     dgetrf_(&n, &n, A, &n, ipiv, &info);
     if (!info) dgetri_(&n, A, &n, ipiv, work, &lwork, &info);
-    free(ipiv);
-    free(work);
     return info;
 }
 
@@ -1055,11 +1114,10 @@ int lsq(const double *A, const double *y, int n, int m, double *x,
     int info;
 
     if (m < n) return -1;
-    Ay = mat(n, 1);
+    Ay = workspace_mat(SLOT_LSQ_AY, n, 1);
     matmul("NN", n, 1, m, 1.0, A, y, 0.0, Ay);                             /* Ay=A*y */
     matmul("NT", n, n, m, 1.0, A, A, 0.0, Q);                              /* Q=A*A' */
     if (!(info = matinv(Q, n))) matmul("NN", n, 1, n, 1.0, Q, Ay, 0.0, x); /* x=Q^-1*Ay */
-    free(Ay);
     return info;
 }
 
@@ -1067,7 +1125,7 @@ int lsq(const double *A, const double *y, int n, int m, double *x,
 /* kalman filter ---------------------------------------------------------------
  * kalman filter state update as follows:
  *
- *   K=P*H*(H'*P*H+R)^-1, xp=x+K*v, Pp=(I-K*H')*P
+ *   K=P*H*(H'*P*H+R)^-1, xp=x+K*v, Pp=(I-K*H')*P=P-K*(P*H)'
  *
  * args   : double *x        I   states vector (n x 1)
  *          double *P        I   covariance matrix of states (n x n)
@@ -1080,12 +1138,14 @@ int lsq(const double *A, const double *y, int n, int m, double *x,
  * return : status (0:ok,<0:error)
  * notes  : matirix stored by column-major order (fortran convention)
  *          if state x[i]==0.0, not updates state x[i]/P[i+i*n]
+ *          P must be symmetric. The covariance update costs O(n^2*m) instead
+ *          of O(n^3), and the matrices are kept in a per-thread workspace
  *-----------------------------------------------------------------------------*/
 int filter_(const double *x, const double *P, const double *H,
     const double *v, const double *R, int n, int m,
     double *xp, double *Pp)
 {
-    double *F = mat(n, m), *Q = mat(m, m), *K = mat(n, m), *I = eye(n);
+    double *F = workspace_mat(SLOT_FILTER_F, n, m), *Q = workspace_mat(SLOT_FILTER_Q, m, m), *K = workspace_mat(SLOT_FILTER_K, n, m);
     int info;
 
     matcpy(Q, R, m, m);
@@ -1096,13 +1156,9 @@ int filter_(const double *x, const double *P, const double *H,
         {
             matmul("NN", n, m, m, 1.0, F, Q, 0.0, K);  /* K=P*H*Q^-1 */
             matmul("NN", n, 1, m, 1.0, K, v, 1.0, xp); /* xp=x+K*v */
-            matmul("NT", n, n, m, -1.0, K, H, 1.0, I); /* Pp=(I-K*H')*P */
-            matmul("NN", n, n, n, 1.0, I, P, 0.0, Pp);
+            matcpy(Pp, P, n, n);                       /* Pp=P-K*F' (F'=H'*P) */
+            matmul("NT", n, n, m, -1.0, K, F, 1.0, Pp);
         }
-    free(F);
-    free(Q);
-    free(K);
-    free(I);
     return info;
 }
 
@@ -1113,14 +1169,14 @@ int filter(double *x, double *P, const double *H, const double *v,
     double *x_, *xp_, *P_, *Pp_, *H_;
     int i, j, k, info, *ix;
 
-    ix = imat(n, 1);
+    ix = workspace_imat(SLOT_FILTER_IX, n);
     for (i = k = 0; i < n; i++)
         if (x[i] != 0.0 && P[i + i * n] > 0.0) ix[k++] = i;
-    x_ = mat(k, 1);
-    xp_ = mat(k, 1);
-    P_ = mat(k, k);
-    Pp_ = mat(k, k);
-    H_ = mat(k, m);
+    x_ = workspace_mat(SLOT_FILTER_X, k, 1);
+    xp_ = workspace_mat(SLOT_FILTER_XP, k, 1);
+    P_ = workspace_mat(SLOT_FILTER_P, k, k);
+    Pp_ = workspace_mat(SLOT_FILTER_PP, k, k);
+    H_ = workspace_mat(SLOT_FILTER_H, k, m);
     for (i = 0; i < k; i++)
         {
             x_[i] = x[ix[i]];
@@ -1133,12 +1189,6 @@ int filter(double *x, double *P, const double *H, const double *v,
             x[ix[i]] = xp_[i];
             for (j = 0; j < k; j++) P[ix[i] + ix[j] * n] = Pp_[i + j * k];
         }
-    free(ix);
-    free(x_);
-    free(xp_);
-    free(P_);
-    free(Pp_);
-    free(H_);
     return info;
 }
 
@@ -4112,6 +4162,35 @@ void sunmoonpos_eci(gtime_t tut, double *rsun, double *rmoon)
 }
 
 
+/* sun and moon position cache ---------------------------------------------------
+ * sun and moon positions in ecef and gmst of the last time and erp values, so
+ * that the routines needing them at the same epoch (tides, phase windup, eclipse
+ * test, precise ephemeris of each satellite at the same time) compute them once.
+ * The sun and the moon are computed on their first request. One cache per
+ * thread.
+ *-----------------------------------------------------------------------------*/
+namespace
+{
+struct Sunmoon_Cache
+{
+    int valid;
+    gtime_t tutc; /* time and erp values {xp,yp,ut1_utc,lod} of the entry */
+    double erpv[4];
+    double U[9]; /* eci to ecef transformation matrix */
+    double gmst;
+    int has_sun, has_moon;
+    double rsun[3], rmoon[3];
+};
+
+
+Sunmoon_Cache &sunmoon_cache()
+{
+    static thread_local Sunmoon_Cache cache = {};
+    return cache;
+}
+}  // namespace
+
+
 /* sun and moon position -------------------------------------------------------
  * get sun and moon position in ecef
  * args   : gtime_t tut      I   time in ut1
@@ -4120,27 +4199,60 @@ void sunmoonpos_eci(gtime_t tut, double *rsun, double *rmoon)
  *          double *rmoon    IO  moon position in ecef (m) (NULL: not output)
  *          double *gmst     O   gmst (rad)
  * return : none
+ * notes  : the positions of the last time and erp values are cached
  *-----------------------------------------------------------------------------*/
 void sunmoonpos(gtime_t tutc, const double *erpv, double *rsun,
     double *rmoon, double *gmst)
 {
+    Sunmoon_Cache &cache = sunmoon_cache();
     gtime_t tut;
-    double rs[3], rm[3], U[9], gmst_;
+    double rs[3], rm[3];
+    int i, same_erp = 1, new_sun, new_moon;
 
     trace(4, "sunmoonpos: tutc=%s\n", time_str(tutc, 3));
 
-    tut = timeadd(tutc, erpv[2]); /* utc -> ut1 */
-
-    /* sun and moon position in eci */
-    sunmoonpos_eci(tut, rsun ? rs : nullptr, rmoon ? rm : nullptr);
+    for (i = 0; i < 4; i++)
+        {
+            if (erpv[i] != cache.erpv[i]) same_erp = 0;
+        }
+    if (!cache.valid || !same_erp || timediff(tutc, cache.tutc) != 0.0)
+        {
+            cache.valid = 1;
+            cache.tutc = tutc;
+            for (i = 0; i < 4; i++) cache.erpv[i] = erpv[i];
+            cache.has_sun = cache.has_moon = 0;
 
-    /* eci to ecef transformation matrix */
-    eci2ecef(tutc, erpv, U, &gmst_);
+            /* eci to ecef transformation matrix */
+            eci2ecef(tutc, erpv, cache.U, &cache.gmst);
+        }
+    tut = timeadd(tutc, erpv[2]); /* utc -> ut1 */
 
-    /* sun and moon position in ecef */
-    if (rsun) matmul("NN", 3, 1, 3, 1.0, U, rs, 0.0, rsun);
-    if (rmoon) matmul("NN", 3, 1, 3, 1.0, U, rm, 0.0, rmoon);
-    if (gmst) *gmst = gmst_;
+    /* sun and moon position in eci, to ecef */
+    new_sun = rsun && !cache.has_sun;
+    new_moon = rmoon && !cache.has_moon;
+    if (new_sun || new_moon)
+        {
+            sunmoonpos_eci(tut, new_sun ? rs : nullptr, new_moon ? rm : nullptr);
+        }
+    if (new_sun)
+        {
+            matmul("NN", 3, 1, 3, 1.0, cache.U, rs, 0.0, cache.rsun);
+            cache.has_sun = 1;
+        }
+    if (new_moon)
+        {
+            matmul("NN", 3, 1, 3, 1.0, cache.U, rm, 0.0, cache.rmoon);
+            cache.has_moon = 1;
+        }
+    if (rsun)
+        {
+            for (i = 0; i < 3; i++) rsun[i] = cache.rsun[i];
+        }
+    if (rmoon)
+        {
+            for (i = 0; i < 3; i++) rmoon[i] = cache.rmoon[i];
+        }
+    if (gmst) *gmst = cache.gmst;
 }
 
 
@@ -285,4 +285,51 @@ int rtk_uncompress(const char *file, char *uncfile);
 int expath(const char *path, char *paths[], int nmax);
 void windupcorr(gtime_t time, const double *rs, const double *rr, double *phw);
 
+
+/* time index ------------------------------------------------------------------
+ * index of the first record with record.time >= time (> time if upper is
+ * true) in an array of records sorted by their time member
+ * args   : T      *data     I   records (peph_t, pclk_t, tec_t...)
+ *          int    n         I   number of records
+ *          gtime_t time     I   time
+ *          bool   upper     I   strict comparison
+ * return : index (n if all the records are before time)
+ * notes  : the products are usually uniformly spaced, so the index is first
+ *          computed directly from the mean interval and only searched by
+ *          bisection if the guess is wrong
+ *-----------------------------------------------------------------------------*/
+template <typename T>
+int timeindex(const T *data, int n, gtime_t time, bool upper)
+{
+    int i, j, k;
+    double dt, t;
+
+    if (n <= 0) return 0;
+    if (n >= 2 && (dt = timediff(data[n - 1].time, data[0].time) / (n - 1)) > 0.0)
+        {
+            t = timediff(time, data[0].time) / dt;
+            k = t < 0.0 ? 0 : (t >= n ? n : static_cast<int>(ceil(t)));
+            for (i = k - 1; i <= k + 1; i++)
+                {
+                    if (i < 0 || i > n) continue;
+                    /* records before i are before time, records from i are not */
+                    if ((i == 0 || (upper ? timediff(data[i - 1].time, time) <= 0.0 : timediff(data[i - 1].time, time) < 0.0)) &&
+                        (i == n || (upper ? timediff(data[i].time, time) > 0.0 : timediff(data[i].time, time) >= 0.0)))
+                        {
+                            return i;
+                        }
+                }
+        }
+    /* binary search */
+    for (i = 0, j = n; i < j;)
+        {
+            k = (i + j) / 2;
+            if (upper ? timediff(data[k].time, time) <= 0.0 : timediff(data[k].time, time) < 0.0)
+                i = k + 1;
+            else
+                j = k;
+        }
+    return i;
+}
+
 #endif /* GNSS_SDR_RTKLIB_RTKCMN_H_ */
@@ -61,6 +61,7 @@
 
 #include "rtklib_sbas.h"
 #include "rtklib_rtkcmn.h"
+#include <cstring>
 
 /* extract field from line ---------------------------------------------------*/
 char *getfield(char *p, int pos)
@@ -101,6 +102,23 @@ double degfcorr(int ai)
 }
 
 
+/* index of an igp position in the 5x5 deg grid (-1: not a grid position) ---*/
+int igpgridindex(int lat, int lon)
+{
+    if (lat < -85 || lat > 85 || lon < -180 || lon >= 180 || lat % 5 != 0 || lon % 5 != 0) return -1;
+    return (lat + 85) / 5 * 72 + (lon + 180) / 5;
+}
+
+
+/* corrections of a satellite in the prn mask (nullptr: not in mask) ---------*/
+const sbssatp_t *sbssatp(const sbssat_t *sbssat, int sat)
+{
+    int i;
+    if (sat <= 0 || sat > MAXSAT || (i = sbssat->index[sat] - 1) < 0 || i >= sbssat->nsat) return nullptr;
+    return sbssat->sat[i].sat == sat ? sbssat->sat + i : nullptr;
+}
+
+
 /* decode type 1: prn masks --------------------------------------------------*/
 int decode_sbstype1(const sbsmsg_t *msg, sbssat_t *sbssat)
 {
@@ -108,6 +126,7 @@ int decode_sbstype1(const sbsmsg_t *msg, sbssat_t *sbssat)
 
     trace(4, "decode_sbstype1:\n");
 
+    memset(sbssat->index, 0, sizeof(sbssat->index));
     for (i = 1, n = 0; i <= 210 && n < MAXSAT; i++)
         {
             if (getbitu(msg->msg, 13 + i, 1))
@@ -128,6 +147,7 @@ int decode_sbstype1(const sbsmsg_t *msg, sbssat_t *sbssat)
                         sat = satno(SYS_QZS, i); /* 193-202: qzss ref [2] */
                     else
                         sat = 0; /* 203-   : reserved */
+                    if (sat > 0) sbssat->index[sat] = static_cast<short>(n + 1);
                     sbssat->sat[n++].sat = sat;
                 }
         }
@@ -275,7 +295,7 @@ int decode_sbstype9(const sbsmsg_t *msg, nav_t *nav)
 int decode_sbstype18(const sbsmsg_t *msg, sbsion_t *sbsion)
 {
     const sbsigpband_t *p;
-    int i, j, n, m, band = getbitu(msg->msg, 18, 4);
+    int i, j, k, n, m, band = getbitu(msg->msg, 18, 4);
 
     trace(4, "decode_sbstype18:\n");
 
@@ -293,6 +313,7 @@ int decode_sbstype18(const sbsmsg_t *msg, sbsion_t *sbsion)
         return 0;
 
     sbsion[band].iodi = static_cast<int16_t>(getbitu(msg->msg, 22, 2));
+    memset(sbsion[band].grid, 0, sizeof(sbsion[band].grid));
 
     for (i = 1, n = 0; i <= 201; i++)
         {
@@ -301,7 +322,12 @@ int decode_sbstype18(const sbsmsg_t *msg, sbsion_t *sbsion)
                 {
                     if (i < p[j].bits || p[j].bite < i) continue;
                     sbsion[band].igp[n].lat = band <= 8 ? p[j].y[i - p[j].bits] : p[j].x;
-                    sbsion[band].igp[n++].lon = band <= 8 ? p[j].x : p[j].y[i - p[j].bits];
+                    sbsion[band].igp[n].lon = band <= 8 ? p[j].x : p[j].y[i - p[j].bits];
+                    if ((k = igpgridindex(sbsion[band].igp[n].lat, sbsion[band].igp[n].lon)) >= 0)
+                        {
+                            sbsion[band].grid[k] = static_cast<unsigned char>(n + 1);
+                        }
+                    n++;
                     break;
                 }
         }
@@ -693,7 +719,7 @@ void sbsoutmsg(FILE *fp, sbsmsg_t *sbsmsg)
 void searchigp(gtime_t time __attribute__((unused)), const double *pos, const sbsion_t *ion,
     const sbsigp_t **igp, double *x, double *y)
 {
-    int i, latp[2], lonp[4];
+    int i, j, k, latp[2], lonp[4];
     double lat = pos[0] * R2D, lon = pos[1] * R2D;
     const sbsigp_t *p;
 
@@ -738,20 +764,17 @@ void searchigp(gtime_t time __attribute__((unused)), const double *pos, const sb
         }
     for (i = 0; i < 4; i++)
         if (lonp[i] == 180) lonp[i] = -180;
-    for (i = 0; i <= MAXBAND; i++)
+    /* direct lookup of the igps {ws,wn,es,en} in the grid index of each band */
+    for (i = 0; i < 4; i++)
         {
-            for (p = ion[i].igp; p < ion[i].igp + ion[i].nigp; p++)
+            /* near the poles two corners can be the same igp, used only once */
+            if ((i == 2 && lonp[2] == lonp[0]) || (i == 3 && lonp[3] == lonp[1])) continue;
+            if ((k = igpgridindex(latp[i % 2], lonp[i])) < 0) continue;
+            for (j = 0; j <= MAXBAND && !igp[i]; j++)
                 {
-                    if (p->t0.time == 0) continue;
-                    if (p->lat == latp[0] && p->lon == lonp[0] && p->give > 0)
-                        igp[0] = p;
-                    else if (p->lat == latp[1] && p->lon == lonp[1] && p->give > 0)
-                        igp[1] = p;
-                    else if (p->lat == latp[0] && p->lon == lonp[2] && p->give > 0)
-                        igp[2] = p;
-                    else if (p->lat == latp[1] && p->lon == lonp[3] && p->give > 0)
-                        igp[3] = p;
-                    if (igp[0] && igp[1] && igp[2] && igp[3]) return;
+                    if (ion[j].grid[k] == 0 || ion[j].grid[k] > ion[j].nigp) continue;
+                    p = ion[j].igp + ion[j].grid[k] - 1;
+                    if (p->t0.time != 0 && p->give > 0) igp[i] = p;
                 }
         }
 }
@@ -923,9 +946,8 @@ int sbslongcorr(gtime_t time, int sat, const sbssat_t *sbssat,
 
     trace(3, "sbslongcorr: sat=%2d\n", sat);
 
-    for (p = sbssat->sat; p < sbssat->sat + sbssat->nsat; p++)
+    if ((p = sbssatp(sbssat, sat)) && p->lcorr.t0.time != 0)
         {
-            if (p->sat != sat || p->lcorr.t0.time == 0) continue;
             t = timediff(time, p->lcorr.t0);
             if (fabs(t) > MAXSBSAGEL)
                 {
@@ -958,14 +980,16 @@ int sbsfastcorr(gtime_t time, int sat, const sbssat_t *sbssat,
 
     trace(3, "sbsfastcorr: sat=%2d\n", sat);
 
-    for (p = sbssat->sat; p < sbssat->sat + sbssat->nsat; p++)
+    if ((p = sbssatp(sbssat, sat)) && p->fcorr.t0.time != 0)
         {
-            if (p->sat != sat) continue;
-            if (p->fcorr.t0.time == 0) break;
             t = timediff(time, p->fcorr.t0) + sbssat->tlat;
 
             /* expire age of correction or UDRE==14 (not monitored) */
-            if (fabs(t) > MAXSBSAGEF || p->fcorr.udre >= 15) continue;
+            if (fabs(t) > MAXSBSAGEF || p->fcorr.udre >= 15)
+                {
+                    trace(2, "no sbas fast correction: %s sat=%2d\n", time_str(time, 0), sat);
+                    return 0;
+                }
             *prc = p->fcorr.prc;
 #ifdef RRCENA
             if (p->fcorr.ai > 0 && fabs(t) <= 8.0 * p->fcorr.dt)
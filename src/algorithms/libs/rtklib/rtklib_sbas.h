@@ -120,6 +120,8 @@ char *getfield(char *p, int pos);
 double varfcorr(int udre);
 double varicorr(int give);
 double degfcorr(int ai);
+int igpgridindex(int lat, int lon);
+const sbssatp_t *sbssatp(const sbssat_t *sbssat, int sat);
 
 int decode_sbstype1(const sbsmsg_t *msg, sbssat_t *sbssat);
 int decode_sbstype2(const sbsmsg_t *msg, sbssat_t *sbssat);
@@ -52,6 +52,12 @@
 
 #include "rtklib_tides.h"
 #include "rtklib_rtkcmn.h"
+#include <vector>
+
+
+const int TIDECACHE_STEP = 30;           /* spacing of the nodes of the tide cache (s) */
+const double TIDECACHE_POS_TOL = 1000.0; /* site displacement served by a cache entry (m) */
+const int TIDECACHE_ENTRIES = 4;         /* sites kept in the tide cache */
 
 
 /* solar/lunar tides (ref [2] 7) ---------------------------------------------*/
@@ -265,8 +271,10 @@ void tide_pole(gtime_t tut, const double *pos, const double *erpv,
  * notes  : see ref [1], [2] chap 7
  *          see ref [4] 5.2.1, 5.2.2, 5.2.3
  *          ver.2.4.0 does not use ocean loading and pole tide corrections
+ *          tidedisp_exact() evaluates the models at tutc, tidedisp() interpolates
+ *          them in time through the tide cache
  *-----------------------------------------------------------------------------*/
-void tidedisp(gtime_t tutc, const double *rr, int opt, const erp_t *erp,
+void tidedisp_exact(gtime_t tutc, const double *rr, int opt, const erp_t *erp,
     const double *odisp, double *dr)
 {
     gtime_t tut;
@@ -277,7 +285,7 @@ void tidedisp(gtime_t tutc, const double *rr, int opt, const erp_t *erp,
     int year, mon, day;
 #endif
 
-    trace(3, "tidedisp: tutc=%s\n", time_str(tutc, 0));
+    trace(3, "tidedisp_exact: tutc=%s\n", time_str(tutc, 0));
 
     if (erp) geterp(erp, tutc, erpv);
 
@@ -323,5 +331,120 @@ void tidedisp(gtime_t tutc, const double *rr, int opt, const erp_t *erp,
             matmul("TN", 3, 1, 3, 1.0, E, denu, 0.0, drt);
             for (i = 0; i < 3; i++) dr[i] += drt[i];
         }
+    trace(5, "tidedisp_exact: dr=%.3f %.3f %.3f\n", dr[0], dr[1], dr[2]);
+}
+
+
+/* tide cache ------------------------------------------------------------------
+ * displacements evaluated at nodes TIDECACHE_STEP apart, aligned to the utc
+ * seconds, and linearly interpolated in between: the tides change slowly
+ * enough (periods of hours) for the interpolation error to stay under 1e-5 m,
+ * and the high rate solutions do not compute the sun and moon ephemerides and
+ * the tide models at every epoch. An entry serves the site positions within
+ * TIDECACHE_POS_TOL of the one its nodes were computed at, with the same
+ * options and parameters; the rover and the base station of a relative
+ * solution keep their own entries. One cache per thread.
+ *-----------------------------------------------------------------------------*/
+namespace
+{
+struct Tide_Cache_Entry
+{
+    int valid;
+    int opt; /* options and parameters the nodes were computed with */
+    const erp_t *erp;
+    const double *odisp;
+    double rr[3];    /* site position of the nodes */
+    gtime_t t0;      /* time of the first node */
+    double dr[2][3]; /* displacements at t0 and t0+TIDECACHE_STEP */
+    unsigned int last_used;
+};
+
+
+std::vector<Tide_Cache_Entry> &tide_cache()
+{
+    static thread_local std::vector<Tide_Cache_Entry> cache(TIDECACHE_ENTRIES);
+    return cache;
+}
+
+
+/* entry for the site rr with the given options, its nodes not computed if it
+ * is a new one ---------------------------------------------------------------*/
+Tide_Cache_Entry *tide_cache_get(const double *rr, int opt, const erp_t *erp,
+    const double *odisp)
+{
+    static thread_local unsigned int uses = 0;
+    std::vector<Tide_Cache_Entry> &cache = tide_cache();
+    Tide_Cache_Entry *entry = &cache[0];
+    double d[3];
+    int i, j;
+
+    uses++;
+    for (i = 0; i < TIDECACHE_ENTRIES; i++)
+        {
+            if (!cache[i].valid)
+                {
+                    if (entry->valid) entry = &cache[i];
+                    continue;
+                }
+            for (j = 0; j < 3; j++) d[j] = rr[j] - cache[i].rr[j];
+            if (cache[i].opt == opt && cache[i].erp == erp && cache[i].odisp == odisp &&
+                dot(d, d, 3) <= TIDECACHE_POS_TOL * TIDECACHE_POS_TOL)
+                {
+                    cache[i].last_used = uses;
+                    return &cache[i];
+                }
+            if (entry->valid && cache[i].last_used < entry->last_used) entry = &cache[i];
+        }
+    /* a free entry or the least recently used one */
+    entry->valid = 0;
+    entry->opt = opt;
+    entry->erp = erp;
+    entry->odisp = odisp;
+    for (j = 0; j < 3; j++) entry->rr[j] = rr[j];
+    entry->last_used = uses;
+    return entry;
+}
+}  // namespace
+
+
+/* tidal displacement through the tide cache -----------------------------------
+ * args and return are the ones of tidedisp_exact()
+ *-----------------------------------------------------------------------------*/
+void tidedisp(gtime_t tutc, const double *rr, int opt, const erp_t *erp,
+    const double *odisp, double *dr)
+{
+    Tide_Cache_Entry *entry;
+    gtime_t t0;
+    double a;
+    int i;
+
+    trace(3, "tidedisp: tutc=%s\n", time_str(tutc, 0));
+
+    if (norm_rtk(rr, 3) <= 0.0)
+        {
+            dr[0] = dr[1] = dr[2] = 0.0;
+            return;
+        }
+    t0.time = tutc.time - tutc.time % TIDECACHE_STEP;
+    t0.sec = 0.0;
+
+    entry = tide_cache_get(rr, opt, erp, odisp);
+    if (!entry->valid || timediff(t0, entry->t0) != 0.0)
+        {
+            if (entry->valid && timediff(t0, entry->t0) == TIDECACHE_STEP)
+                { /* the next interval shares a node with the last one */
+                    for (i = 0; i < 3; i++) entry->dr[0][i] = entry->dr[1][i];
+                }
+            else
+                {
+                    tidedisp_exact(t0, entry->rr, opt, erp, odisp, entry->dr[0]);
+                }
+            tidedisp_exact(timeadd(t0, TIDECACHE_STEP), entry->rr, opt, erp, odisp, entry->dr[1]);
+            entry->t0 = t0;
+            entry->valid = 1;
+        }
+    a = timediff(tutc, t0) / TIDECACHE_STEP;
+    for (i = 0; i < 3; i++) dr[i] = (1.0 - a) * entry->dr[0][i] + a * entry->dr[1][i];
+
     trace(5, "tidedisp: dr=%.3f %.3f %.3f\n", dr[0], dr[1], dr[2]);
 }
@@ -87,6 +87,9 @@ void iers_mean_pole(gtime_t tut, double *xp_bar, double *yp_bar);
 void tide_pole(gtime_t tut, const double *pos, const double *erpv,
     double *denu);
 
+void tidedisp_exact(gtime_t tutc, const double *rr, int opt, const erp_t *erp,
+    const double *odisp, double *dr);
+
 void tidedisp(gtime_t tutc, const double *rr, int opt, const erp_t *erp,
     const double *odisp, double *dr);
 #endif
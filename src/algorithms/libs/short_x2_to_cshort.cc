@@ -32,6 +32,7 @@
 #include "short_x2_to_cshort.h"
 #include <gnuradio/io_signature.h>
 #include <volk/volk.h>
+#include <volk_gnsssdr/volk_gnsssdr.h>
 
 
 short_x2_to_cshort_sptr make_short_x2_to_cshort()
@@ -56,16 +57,6 @@ int short_x2_to_cshort::work(int noutput_items,
     const auto *in0 = reinterpret_cast<const int16_t *>(input_items[0]);
     const auto *in1 = reinterpret_cast<const int16_t *>(input_items[1]);
     auto *out = reinterpret_cast<lv_16sc_t *>(output_items[0]);
-    // This could be put into a volk kernel
-    int16_t real_part;
-    int16_t imag_part;
-    for (int number = 0; number < noutput_items; number++)
-        {
-            // lv_cmake(r, i) defined at volk/volk_complex.h
-            real_part = *in0++;
-            imag_part = *in1++;
-            *out++ = lv_cmake(real_part, imag_part);
-        }
-
+    volk_gnsssdr_16i_x2_interleave_16ic(out, in0, in1, noutput_items);
     return noutput_items;
 }
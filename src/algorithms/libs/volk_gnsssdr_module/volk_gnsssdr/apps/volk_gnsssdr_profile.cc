@@ -59,7 +59,7 @@ int main(int argc, char *argv[])
     profile_options.add(option_t("tol", "t", "Set the default tolerance for all tests", set_tolerance));
     profile_options.add(option_t("vlen", "v", "Set the default vector length for tests", set_vlen));
     profile_options.add((option_t("iter", "i", "Set the default number of test iterations per kernel", set_iter)));
-    profile_options.add((option_t("tests-substr", "R", "Run tests matching substring", set_substr)));
+    profile_options.add((option_t("tests-substr", "R", "Run tests matching substring (or any of a comma-separated list)", set_substr)));
     profile_options.add((option_t("update", "u", "Run only kernels missing from config", set_update)));
     profile_options.add((option_t("dry-run", "n", "Dry run. Respect other options, but don't write to file", set_dryrun)));
     profile_options.add((option_t("json", "j", "Write results to JSON file named as argument value", set_json)));
@@ -110,17 +110,31 @@ int main(int argc, char *argv[])
     std::vector<volk_gnsssdr_test_case_t> test_cases = init_test_list(test_params);
 
     // Iterate through list of tests running each one
-    std::string substr_to_match(test_params.kernel_regex());
+    std::vector<std::string> substrs_to_match;
+    std::string kernel_regex(test_params.kernel_regex());
+    size_t start = 0;
+    size_t comma;
+    while ((comma = kernel_regex.find(',', start)) != std::string::npos)
+        {
+            substrs_to_match.push_back(kernel_regex.substr(start, comma - start));
+            start = comma + 1;
+        }
+    substrs_to_match.push_back(kernel_regex.substr(start));
     for (unsigned int ii = 0; ii < test_cases.size(); ++ii)
         {
-            bool regex_match = true;
+            bool regex_match = false;
 
             volk_gnsssdr_test_case_t test_case = test_cases[ii];
-            // if the kernel name matches regex then do the test
+            // if the kernel name (or the one of the kernel tested by a puppet) matches regex then do the test
             std::string test_case_name = test_case.name();
-            if (test_case_name.find(substr_to_match) == std::string::npos)
+            for (unsigned int kk = 0; kk < substrs_to_match.size(); ++kk)
                 {
-                    regex_match = false;
+                    if ((test_case_name.find(substrs_to_match[kk]) != std::string::npos) ||
+                        (test_case.puppet_master_name().find(substrs_to_match[kk]) != std::string::npos))
+                        {
+                            regex_match = true;
+                            break;
+                        }
                 }
 
             // if we are in update mode check if we've already got results
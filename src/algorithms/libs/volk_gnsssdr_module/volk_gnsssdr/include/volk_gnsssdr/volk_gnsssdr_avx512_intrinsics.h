@@ -0,0 +1,47 @@
+/*!
+ * \file volk_gnsssdr_avx512_intrinsics.h
+ * \brief This file is intended to hold AVX-512F intrinsics of intrinsics.
+ * They should be used in VOLK kernels to avoid copy-paste.
+ *
+ * Copyright (C) 2010-2018 (see AUTHORS file for a list of contributors)
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef INCLUDED_VOLK_VOLK_AVX512_INTRINSICS_H_
+#define INCLUDED_VOLK_VOLK_AVX512_INTRINSICS_H_
+#include <immintrin.h>
+
+static inline __m512
+_mm512_complexmul_ps(__m512 x, __m512 y)
+{
+    __m512 yl, yh, tmp2;
+    yl = _mm512_moveldup_ps(y);              // Load yl with cr,cr,dr,dr ...
+    yh = _mm512_movehdup_ps(y);              // Load yh with ci,ci,di,di ...
+    tmp2 = _mm512_permute_ps(x, 0xB1);       // Re-arrange x to be ai,ar,bi,br ...
+    tmp2 = _mm512_mul_ps(tmp2, yh);          // tmp2 = ai*ci,ar*ci,bi*di,br*di
+    return _mm512_fmaddsub_ps(x, yl, tmp2);  // ar*cr-ai*ci, ai*cr+ar*ci, br*dr-bi*di, bi*dr+br*di
+}
+
+static inline __m512
+_mm512_complexnormalise_ps(__m512 z)
+{
+    __m512 tmp1 = _mm512_mul_ps(z, z);                                 // ar*ar,ai*ai,br*br,bi*bi ...
+    __m512 tmp2 = _mm512_add_ps(tmp1, _mm512_permute_ps(tmp1, 0xB1));  // |a|^2,|a|^2,|b|^2,|b|^2 ...
+    return _mm512_div_ps(z, _mm512_sqrt_ps(tmp2));
+}
+
+#endif /* INCLUDED_VOLK_VOLK_AVX512_INTRINSICS_H_ */
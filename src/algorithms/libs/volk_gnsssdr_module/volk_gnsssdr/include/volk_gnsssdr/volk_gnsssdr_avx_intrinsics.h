@@ -79,4 +79,17 @@ _mm256_magnitude_ps(__m256 cplxValue1, __m256 cplxValue2)
     return _mm256_sqrt_ps(_mm256_magnitudesquared_ps(cplxValue1, cplxValue2));
 }
 
+#ifdef LV_HAVE_FMA
+static inline __m256
+_mm256_complexmul_fma_ps(__m256 x, __m256 y)
+{
+    __m256 yl, yh, tmp2;
+    yl = _mm256_moveldup_ps(y);              // Load yl with cr,cr,dr,dr ...
+    yh = _mm256_movehdup_ps(y);              // Load yh with ci,ci,di,di ...
+    tmp2 = _mm256_shuffle_ps(x, x, 0xB1);    // Re-arrange x to be ai,ar,bi,br ...
+    tmp2 = _mm256_mul_ps(tmp2, yh);          // tmp2 = ai*ci,ar*ci,bi*di,br*di
+    return _mm256_fmaddsub_ps(x, yl, tmp2);  // ar*cr-ai*ci, ai*cr+ar*ci, br*dr-bi*di, bi*dr+br*di
+}
+#endif /* LV_HAVE_FMA */
+
 #endif /* INCLUDE_VOLK_VOLK_AVX_INTRINSICS_H_ */
@@ -0,0 +1,1057 @@
+/*!
+ * \file volk_gnsssdr_sincos_table.h
+ * \brief  Phase-quantized cosine and sine table
+ *
+ * Copyright (C) 2010-2018 (see AUTHORS file for a list of contributors)
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef INCLUDED_VOLK_GNSSSDR_SINCOS_TABLE_H
+#define INCLUDED_VOLK_GNSSSDR_SINCOS_TABLE_H
+
+/* Entry k holds {cos(2 pi k / 1024), sin(2 pi k / 1024)}
+ * max phase error = pi / 1024 rad */
+static const float sincos_table_10bits[1 << 10][2] = {
+
+    {1.000000000000000e+00, 0.000000000000000e+00},
+    {9.999811752826011e-01, 6.135884649154475e-03},
+    {9.999247018391445e-01, 1.227153828571993e-02},
+    {9.998305817958234e-01, 1.840672990580482e-02},
+    {9.996988186962042e-01, 2.454122852291229e-02},
+    {9.995294175010931e-01, 3.067480317663663e-02},
+    {9.993223845883495e-01, 3.680722294135883e-02},
+    {9.990777277526454e-01, 4.293825693494082e-02},
+    {9.987954562051724e-01, 4.906767432741801e-02},
+    {9.984755805732948e-01, 5.519524434968993e-02},
+    {9.981181129001492e-01, 6.132073630220858e-02},
+    {9.977230666441916e-01, 6.744391956366405e-02},
+    {9.972904566786902e-01, 7.356456359966743e-02},
+    {9.968202992911657e-01, 7.968243797143013e-02},
+    {9.963126121827780e-01, 8.579731234443989e-02},
+    {9.957674144676598e-01, 9.190895649713272e-02},
+    {9.951847266721969e-01, 9.801714032956060e-02},
+    {9.945645707342554e-01, 1.041216338720546e-01},
+    {9.939069700023561e-01, 1.102222072938831e-01},
+    {9.932119492347945e-01, 1.163186309119048e-01},
+    {9.924795345987100e-01, 1.224106751992162e-01},
+    {9.917097536690995e-01, 1.284981107937932e-01},
+    {9.909026354277800e-01, 1.345807085071262e-01},
+    {9.900582102622971e-01, 1.406582393328492e-01},
+    {9.891765099647810e-01, 1.467304744553617e-01},
+    {9.882575677307495e-01, 1.527971852584434e-01},
+    {9.873014181578584e-01, 1.588581433338614e-01},
+    {9.863080972445987e-01, 1.649131204899699e-01},
+    {9.852776423889412e-01, 1.709618887603012e-01},
+    {9.842100923869290e-01, 1.770042204121487e-01},
+    {9.831054874312163e-01, 1.830398879551410e-01},
+    {9.819638691095552e-01, 1.890686641498062e-01},
+    {9.807852804032304e-01, 1.950903220161282e-01},
+    {9.795697656854405e-01, 2.011046348420919e-01},
+    {9.783173707196277e-01, 2.071113761922186e-01},
+    {9.770281426577544e-01, 2.131103199160914e-01},
+    {9.757021300385286e-01, 2.191012401568698e-01},
+    {9.743393827855759e-01, 2.250839113597928e-01},
+    {9.729399522055602e-01, 2.310581082806711e-01},
+    {9.715038909862518e-01, 2.370236059943672e-01},
+    {9.700312531945440e-01, 2.429801799032639e-01},
+    {9.685220942744174e-01, 2.489276057457201e-01},
+    {9.669764710448521e-01, 2.548656596045146e-01},
+    {9.653944416976894e-01, 2.607941179152755e-01},
+    {9.637760657954398e-01, 2.667127574748984e-01},
+    {9.621214042690416e-01, 2.726213554499490e-01},
+    {9.604305194155658e-01, 2.785196893850531e-01},
+    {9.587034748958716e-01, 2.844075372112719e-01},
+    {9.569403357322088e-01, 2.902846772544623e-01},
+    {9.551411683057708e-01, 2.961508882436238e-01},
+    {9.533060403541939e-01, 3.020059493192281e-01},
+    {9.514350209690083e-01, 3.078496400415349e-01},
+    {9.495281805930367e-01, 3.136817403988915e-01},
+    {9.475855910177411e-01, 3.195020308160157e-01},
+    {9.456073253805213e-01, 3.253102921622629e-01},
+    {9.435934581619604e-01, 3.311063057598764e-01},
+    {9.415440651830208e-01, 3.368898533922201e-01},
+    {9.394592236021899e-01, 3.426607173119944e-01},
+    {9.373390119125750e-01, 3.484186802494346e-01},
+    {9.351835099389476e-01, 3.541635254204903e-01},
+    {9.329927988347390e-01, 3.598950365349881e-01},
+    {9.307669610789837e-01, 3.656129978047739e-01},
+    {9.285060804732156e-01, 3.713171939518375e-01},
+    {9.262102421383114e-01, 3.770074102164183e-01},
+    {9.238795325112867e-01, 3.826834323650898e-01},
+    {9.215140393420420e-01, 3.883450466988262e-01},
+    {9.191138516900578e-01, 3.939920400610481e-01},
+    {9.166790599210427e-01, 3.996241998456468e-01},
+    {9.142097557035307e-01, 4.052413140049899e-01},
+    {9.117060320054299e-01, 4.108431710579039e-01},
+    {9.091679830905224e-01, 4.164295600976372e-01},
+    {9.065957045149153e-01, 4.220002707997997e-01},
+    {9.039892931234433e-01, 4.275550934302821e-01},
+    {9.013488470460220e-01, 4.330938188531520e-01},
+    {8.986744656939538e-01, 4.386162385385277e-01},
+    {8.959662497561852e-01, 4.441221445704292e-01},
+    {8.932243011955153e-01, 4.496113296546065e-01},
+    {8.904487232447579e-01, 4.550835871263438e-01},
+    {8.876396204028539e-01, 4.605387109582400e-01},
+    {8.847970984309378e-01, 4.659764957679662e-01},
+    {8.819212643483550e-01, 4.713967368259976e-01},
+    {8.790122264286335e-01, 4.767992300633221e-01},
+    {8.760700941954066e-01, 4.821837720791227e-01},
+    {8.730949784182901e-01, 4.875501601484360e-01},
+    {8.700869911087115e-01, 4.928981922297840e-01},
+    {8.670462455156926e-01, 4.982276669727819e-01},
+    {8.639728561215868e-01, 5.035383837257176e-01},
+    {8.608669386377673e-01, 5.088301425431070e-01},
+    {8.577286100002721e-01, 5.141027441932217e-01},
+    {8.545579883654005e-01, 5.193559901655896e-01},
+    {8.513551931052652e-01, 5.245896826784689e-01},
+    {8.481203448032972e-01, 5.298036246862946e-01},
+    {8.448535652497071e-01, 5.349976198870972e-01},
+    {8.415549774368984e-01, 5.401714727298929e-01},
+    {8.382247055548381e-01, 5.453249884220465e-01},
+    {8.348628749863800e-01, 5.504579729366048e-01},
+    {8.314696123025452e-01, 5.555702330196022e-01},
+    {8.280450452577558e-01, 5.606615761973360e-01},
+    {8.245893027850253e-01, 5.657318107836131e-01},
+    {8.211025149911046e-01, 5.707807458869673e-01},
+    {8.175848131515837e-01, 5.758081914178453e-01},
+    {8.140363297059484e-01, 5.808139580957645e-01},
+    {8.104571982525948e-01, 5.857978574564389e-01},
+    {8.068475535437993e-01, 5.907597018588742e-01},
+    {8.032075314806449e-01, 5.956993044924334e-01},
+    {7.995372691079050e-01, 6.006164793838690e-01},
+    {7.958369046088836e-01, 6.055110414043255e-01},
+    {7.921065773002124e-01, 6.103828062763095e-01},
+    {7.883464276266063e-01, 6.152315905806268e-01},
+    {7.845565971555752e-01, 6.200572117632891e-01},
+    {7.807372285720945e-01, 6.248594881423863e-01},
+    {7.768884656732324e-01, 6.296382389149270e-01},
+    {7.730104533627370e-01, 6.343932841636455e-01},
+    {7.691033376455797e-01, 6.391244448637757e-01},
+    {7.651672656224590e-01, 6.438315428897914e-01},
+    {7.612023854842618e-01, 6.485144010221124e-01},
+    {7.572088465064846e-01, 6.531728429537768e-01},
+    {7.531867990436125e-01, 6.578066932970786e-01},
+    {7.491363945234594e-01, 6.624157775901718e-01},
+    {7.450577854414661e-01, 6.669999223036375e-01},
+    {7.409511253549591e-01, 6.715589548470183e-01},
+    {7.368165688773699e-01, 6.760927035753159e-01},
+    {7.326542716724128e-01, 6.806009977954530e-01},
+    {7.284643904482252e-01, 6.850836677727004e-01},
+    {7.242470829514670e-01, 6.895405447370668e-01},
+    {7.200025079613817e-01, 6.939714608896540e-01},
+    {7.157308252838186e-01, 6.983762494089729e-01},
+    {7.114321957452164e-01, 7.027547444572253e-01},
+    {7.071067811865476e-01, 7.071067811865475e-01},
+    {7.027547444572253e-01, 7.114321957452164e-01},
+    {6.983762494089729e-01, 7.157308252838186e-01},
+    {6.939714608896540e-01, 7.200025079613817e-01},
+    {6.895405447370669e-01, 7.242470829514669e-01},
+    {6.850836677727004e-01, 7.284643904482252e-01},
+    {6.806009977954531e-01, 7.326542716724128e-01},
+    {6.760927035753160e-01, 7.368165688773698e-01},
+    {6.715589548470183e-01, 7.409511253549591e-01},
+    {6.669999223036375e-01, 7.450577854414659e-01},
+    {6.624157775901718e-01, 7.491363945234593e-01},
+    {6.578066932970786e-01, 7.531867990436124e-01},
+    {6.531728429537768e-01, 7.572088465064845e-01},
+    {6.485144010221126e-01, 7.612023854842618e-01},
+    {6.438315428897915e-01, 7.651672656224590e-01},
+    {6.391244448637757e-01, 7.691033376455796e-01},
+    {6.343932841636455e-01, 7.730104533627370e-01},
+    {6.296382389149271e-01, 7.768884656732324e-01},
+    {6.248594881423865e-01, 7.807372285720944e-01},
+    {6.200572117632892e-01, 7.845565971555752e-01},
+    {6.152315905806268e-01, 7.883464276266062e-01},
+    {6.103828062763095e-01, 7.921065773002124e-01},
+    {6.055110414043255e-01, 7.958369046088835e-01},
+    {6.006164793838690e-01, 7.995372691079050e-01},
+    {5.956993044924335e-01, 8.032075314806448e-01},
+    {5.907597018588743e-01, 8.068475535437992e-01},
+    {5.857978574564389e-01, 8.104571982525948e-01},
+    {5.808139580957645e-01, 8.140363297059483e-01},
+    {5.758081914178453e-01, 8.175848131515837e-01},
+    {5.707807458869674e-01, 8.211025149911046e-01},
+    {5.657318107836132e-01, 8.245893027850253e-01},
+    {5.606615761973360e-01, 8.280450452577558e-01},
+    {5.555702330196023e-01, 8.314696123025452e-01},
+    {5.504579729366048e-01, 8.348628749863800e-01},
+    {5.453249884220465e-01, 8.382247055548380e-01},
+    {5.401714727298930e-01, 8.415549774368983e-01},
+    {5.349976198870973e-01, 8.448535652497070e-01},
+    {5.298036246862948e-01, 8.481203448032971e-01},
+    {5.245896826784688e-01, 8.513551931052652e-01},
+    {5.193559901655895e-01, 8.545579883654005e-01},
+    {5.141027441932217e-01, 8.577286100002721e-01},
+    {5.088301425431070e-01, 8.608669386377673e-01},
+    {5.035383837257176e-01, 8.639728561215867e-01},
+    {4.982276669727819e-01, 8.670462455156926e-01},
+    {4.928981922297841e-01, 8.700869911087113e-01},
+    {4.875501601484361e-01, 8.730949784182901e-01},
+    {4.821837720791228e-01, 8.760700941954066e-01},
+    {4.767992300633223e-01, 8.790122264286334e-01},
+    {4.713967368259978e-01, 8.819212643483549e-01},
+    {4.659764957679661e-01, 8.847970984309378e-01},
+    {4.605387109582400e-01, 8.876396204028539e-01},
+    {4.550835871263438e-01, 8.904487232447579e-01},
+    {4.496113296546066e-01, 8.932243011955153e-01},
+    {4.441221445704293e-01, 8.959662497561851e-01},
+    {4.386162385385277e-01, 8.986744656939538e-01},
+    {4.330938188531520e-01, 9.013488470460220e-01},
+    {4.275550934302822e-01, 9.039892931234433e-01},
+    {4.220002707997998e-01, 9.065957045149153e-01},
+    {4.164295600976373e-01, 9.091679830905223e-01},
+    {4.108431710579039e-01, 9.117060320054299e-01},
+    {4.052413140049899e-01, 9.142097557035307e-01},
+    {3.996241998456468e-01, 9.166790599210427e-01},
+    {3.939920400610481e-01, 9.191138516900578e-01},
+    {3.883450466988263e-01, 9.215140393420419e-01},
+    {3.826834323650898e-01, 9.238795325112867e-01},
+    {3.770074102164183e-01, 9.262102421383113e-01},
+    {3.713171939518376e-01, 9.285060804732155e-01},
+    {3.656129978047740e-01, 9.307669610789837e-01},
+    {3.598950365349883e-01, 9.329927988347388e-01},
+    {3.541635254204905e-01, 9.351835099389475e-01},
+    {3.484186802494345e-01, 9.373390119125750e-01},
+    {3.426607173119944e-01, 9.394592236021899e-01},
+    {3.368898533922201e-01, 9.415440651830208e-01},
+    {3.311063057598764e-01, 9.435934581619604e-01},
+    {3.253102921622630e-01, 9.456073253805213e-01},
+    {3.195020308160157e-01, 9.475855910177411e-01},
+    {3.136817403988916e-01, 9.495281805930367e-01},
+    {3.078496400415350e-01, 9.514350209690083e-01},
+    {3.020059493192282e-01, 9.533060403541938e-01},
+    {2.961508882436240e-01, 9.551411683057707e-01},
+    {2.902846772544623e-01, 9.569403357322089e-01},
+    {2.844075372112718e-01, 9.587034748958716e-01},
+    {2.785196893850531e-01, 9.604305194155658e-01},
+    {2.726213554499490e-01, 9.621214042690416e-01},
+    {2.667127574748984e-01, 9.637760657954398e-01},
+    {2.607941179152756e-01, 9.653944416976894e-01},
+    {2.548656596045146e-01, 9.669764710448521e-01},
+    {2.489276057457203e-01, 9.685220942744173e-01},
+    {2.429801799032640e-01, 9.700312531945440e-01},
+    {2.370236059943673e-01, 9.715038909862518e-01},
+    {2.310581082806713e-01, 9.729399522055601e-01},
+    {2.250839113597928e-01, 9.743393827855759e-01},
+    {2.191012401568698e-01, 9.757021300385286e-01},
+    {2.131103199160914e-01, 9.770281426577544e-01},
+    {2.071113761922186e-01, 9.783173707196277e-01},
+    {2.011046348420920e-01, 9.795697656854405e-01},
+    {1.950903220161283e-01, 9.807852804032304e-01},
+    {1.890686641498063e-01, 9.819638691095552e-01},
+    {1.830398879551411e-01, 9.831054874312163e-01},
+    {1.770042204121489e-01, 9.842100923869290e-01},
+    {1.709618887603014e-01, 9.852776423889412e-01},
+    {1.649131204899701e-01, 9.863080972445987e-01},
+    {1.588581433338614e-01, 9.873014181578584e-01},
+    {1.527971852584434e-01, 9.882575677307495e-01},
+    {1.467304744553617e-01, 9.891765099647810e-01},
+    {1.406582393328492e-01, 9.900582102622971e-01},
+    {1.345807085071262e-01, 9.909026354277800e-01},
+    {1.284981107937932e-01, 9.917097536690995e-01},
+    {1.224106751992163e-01, 9.924795345987100e-01},
+    {1.163186309119049e-01, 9.932119492347945e-01},
+    {1.102222072938832e-01, 9.939069700023561e-01},
+    {1.041216338720547e-01, 9.945645707342554e-01},
+    {9.801714032956077e-02, 9.951847266721968e-01},
+    {9.190895649713270e-02, 9.957674144676598e-01},
+    {8.579731234443988e-02, 9.963126121827780e-01},
+    {7.968243797143013e-02, 9.968202992911657e-01},
+    {7.356456359966745e-02, 9.972904566786902e-01},
+    {6.744391956366411e-02, 9.977230666441916e-01},
+    {6.132073630220865e-02, 9.981181129001492e-01},
+    {5.519524434969003e-02, 9.984755805732948e-01},
+    {4.906767432741813e-02, 9.987954562051724e-01},
+    {4.293825693494096e-02, 9.990777277526454e-01},
+    {3.680722294135899e-02, 9.993223845883495e-01},
+    {3.067480317663658e-02, 9.995294175010931e-01},
+    {2.454122852291226e-02, 9.996988186962042e-01},
+    {1.840672990580482e-02, 9.998305817958234e-01},
+    {1.227153828571994e-02, 9.999247018391445e-01},
+    {6.135884649154515e-03, 9.999811752826011e-01},
+    {6.123233995736766e-17, 1.000000000000000e+00},
+    {-6.135884649154393e-03, 9.999811752826011e-01},
+    {-1.227153828571982e-02, 9.999247018391445e-01},
+    {-1.840672990580470e-02, 9.998305817958234e-01},
+    {-2.454122852291214e-02, 9.996988186962042e-01},
+    {-3.067480317663646e-02, 9.995294175010931e-01},
+    {-3.680722294135887e-02, 9.993223845883495e-01},
+    {-4.293825693494083e-02, 9.990777277526454e-01},
+    {-4.906767432741801e-02, 9.987954562051724e-01},
+    {-5.519524434968991e-02, 9.984755805732948e-01},
+    {-6.132073630220853e-02, 9.981181129001492e-01},
+    {-6.744391956366398e-02, 9.977230666441916e-01},
+    {-7.356456359966733e-02, 9.972904566786902e-01},
+    {-7.968243797143001e-02, 9.968202992911658e-01},
+    {-8.579731234443976e-02, 9.963126121827780e-01},
+    {-9.190895649713257e-02, 9.957674144676598e-01},
+    {-9.801714032956065e-02, 9.951847266721969e-01},
+    {-1.041216338720546e-01, 9.945645707342554e-01},
+    {-1.102222072938831e-01, 9.939069700023561e-01},
+    {-1.163186309119048e-01, 9.932119492347945e-01},
+    {-1.224106751992162e-01, 9.924795345987100e-01},
+    {-1.284981107937931e-01, 9.917097536690995e-01},
+    {-1.345807085071261e-01, 9.909026354277800e-01},
+    {-1.406582393328491e-01, 9.900582102622971e-01},
+    {-1.467304744553616e-01, 9.891765099647810e-01},
+    {-1.527971852584433e-01, 9.882575677307495e-01},
+    {-1.588581433338613e-01, 9.873014181578584e-01},
+    {-1.649131204899699e-01, 9.863080972445987e-01},
+    {-1.709618887603012e-01, 9.852776423889412e-01},
+    {-1.770042204121487e-01, 9.842100923869290e-01},
+    {-1.830398879551409e-01, 9.831054874312163e-01},
+    {-1.890686641498062e-01, 9.819638691095552e-01},
+    {-1.950903220161282e-01, 9.807852804032304e-01},
+    {-2.011046348420918e-01, 9.795697656854405e-01},
+    {-2.071113761922184e-01, 9.783173707196277e-01},
+    {-2.131103199160913e-01, 9.770281426577544e-01},
+    {-2.191012401568697e-01, 9.757021300385286e-01},
+    {-2.250839113597927e-01, 9.743393827855759e-01},
+    {-2.310581082806711e-01, 9.729399522055602e-01},
+    {-2.370236059943672e-01, 9.715038909862518e-01},
+    {-2.429801799032639e-01, 9.700312531945440e-01},
+    {-2.489276057457201e-01, 9.685220942744174e-01},
+    {-2.548656596045145e-01, 9.669764710448521e-01},
+    {-2.607941179152755e-01, 9.653944416976894e-01},
+    {-2.667127574748983e-01, 9.637760657954398e-01},
+    {-2.726213554499489e-01, 9.621214042690416e-01},
+    {-2.785196893850529e-01, 9.604305194155659e-01},
+    {-2.844075372112717e-01, 9.587034748958716e-01},
+    {-2.902846772544622e-01, 9.569403357322089e-01},
+    {-2.961508882436238e-01, 9.551411683057707e-01},
+    {-3.020059493192281e-01, 9.533060403541939e-01},
+    {-3.078496400415349e-01, 9.514350209690083e-01},
+    {-3.136817403988914e-01, 9.495281805930367e-01},
+    {-3.195020308160156e-01, 9.475855910177412e-01},
+    {-3.253102921622629e-01, 9.456073253805214e-01},
+    {-3.311063057598763e-01, 9.435934581619604e-01},
+    {-3.368898533922199e-01, 9.415440651830208e-01},
+    {-3.426607173119943e-01, 9.394592236021899e-01},
+    {-3.484186802494344e-01, 9.373390119125750e-01},
+    {-3.541635254204904e-01, 9.351835099389476e-01},
+    {-3.598950365349882e-01, 9.329927988347388e-01},
+    {-3.656129978047739e-01, 9.307669610789837e-01},
+    {-3.713171939518375e-01, 9.285060804732156e-01},
+    {-3.770074102164182e-01, 9.262102421383114e-01},
+    {-3.826834323650897e-01, 9.238795325112867e-01},
+    {-3.883450466988262e-01, 9.215140393420420e-01},
+    {-3.939920400610480e-01, 9.191138516900578e-01},
+    {-3.996241998456467e-01, 9.166790599210427e-01},
+    {-4.052413140049897e-01, 9.142097557035307e-01},
+    {-4.108431710579038e-01, 9.117060320054299e-01},
+    {-4.164295600976370e-01, 9.091679830905225e-01},
+    {-4.220002707997997e-01, 9.065957045149153e-01},
+    {-4.275550934302819e-01, 9.039892931234434e-01},
+    {-4.330938188531519e-01, 9.013488470460220e-01},
+    {-4.386162385385274e-01, 8.986744656939539e-01},
+    {-4.441221445704291e-01, 8.959662497561852e-01},
+    {-4.496113296546067e-01, 8.932243011955152e-01},
+    {-4.550835871263437e-01, 8.904487232447580e-01},
+    {-4.605387109582401e-01, 8.876396204028539e-01},
+    {-4.659764957679660e-01, 8.847970984309379e-01},
+    {-4.713967368259977e-01, 8.819212643483550e-01},
+    {-4.767992300633219e-01, 8.790122264286335e-01},
+    {-4.821837720791227e-01, 8.760700941954066e-01},
+    {-4.875501601484357e-01, 8.730949784182902e-01},
+    {-4.928981922297840e-01, 8.700869911087115e-01},
+    {-4.982276669727816e-01, 8.670462455156928e-01},
+    {-5.035383837257175e-01, 8.639728561215868e-01},
+    {-5.088301425431071e-01, 8.608669386377672e-01},
+    {-5.141027441932217e-01, 8.577286100002721e-01},
+    {-5.193559901655896e-01, 8.545579883654005e-01},
+    {-5.245896826784687e-01, 8.513551931052652e-01},
+    {-5.298036246862947e-01, 8.481203448032972e-01},
+    {-5.349976198870970e-01, 8.448535652497072e-01},
+    {-5.401714727298929e-01, 8.415549774368984e-01},
+    {-5.453249884220462e-01, 8.382247055548382e-01},
+    {-5.504579729366047e-01, 8.348628749863801e-01},
+    {-5.555702330196020e-01, 8.314696123025455e-01},
+    {-5.606615761973359e-01, 8.280450452577558e-01},
+    {-5.657318107836132e-01, 8.245893027850252e-01},
+    {-5.707807458869671e-01, 8.211025149911048e-01},
+    {-5.758081914178453e-01, 8.175848131515837e-01},
+    {-5.808139580957644e-01, 8.140363297059485e-01},
+    {-5.857978574564389e-01, 8.104571982525948e-01},
+    {-5.907597018588741e-01, 8.068475535437994e-01},
+    {-5.956993044924334e-01, 8.032075314806449e-01},
+    {-6.006164793838688e-01, 7.995372691079052e-01},
+    {-6.055110414043254e-01, 7.958369046088836e-01},
+    {-6.103828062763096e-01, 7.921065773002123e-01},
+    {-6.152315905806267e-01, 7.883464276266063e-01},
+    {-6.200572117632892e-01, 7.845565971555751e-01},
+    {-6.248594881423862e-01, 7.807372285720946e-01},
+    {-6.296382389149271e-01, 7.768884656732324e-01},
+    {-6.343932841636454e-01, 7.730104533627371e-01},
+    {-6.391244448637757e-01, 7.691033376455796e-01},
+    {-6.438315428897913e-01, 7.651672656224591e-01},
+    {-6.485144010221124e-01, 7.612023854842619e-01},
+    {-6.531728429537765e-01, 7.572088465064847e-01},
+    {-6.578066932970786e-01, 7.531867990436125e-01},
+    {-6.624157775901719e-01, 7.491363945234593e-01},
+    {-6.669999223036374e-01, 7.450577854414661e-01},
+    {-6.715589548470184e-01, 7.409511253549590e-01},
+    {-6.760927035753158e-01, 7.368165688773700e-01},
+    {-6.806009977954530e-01, 7.326542716724128e-01},
+    {-6.850836677727002e-01, 7.284643904482253e-01},
+    {-6.895405447370669e-01, 7.242470829514669e-01},
+    {-6.939714608896538e-01, 7.200025079613818e-01},
+    {-6.983762494089728e-01, 7.157308252838187e-01},
+    {-7.027547444572251e-01, 7.114321957452167e-01},
+    {-7.071067811865475e-01, 7.071067811865476e-01},
+    {-7.114321957452165e-01, 7.027547444572252e-01},
+    {-7.157308252838186e-01, 6.983762494089729e-01},
+    {-7.200025079613817e-01, 6.939714608896540e-01},
+    {-7.242470829514668e-01, 6.895405447370671e-01},
+    {-7.284643904482252e-01, 6.850836677727004e-01},
+    {-7.326542716724127e-01, 6.806009977954532e-01},
+    {-7.368165688773699e-01, 6.760927035753159e-01},
+    {-7.409511253549589e-01, 6.715589548470186e-01},
+    {-7.450577854414659e-01, 6.669999223036376e-01},
+    {-7.491363945234591e-01, 6.624157775901720e-01},
+    {-7.531867990436124e-01, 6.578066932970787e-01},
+    {-7.572088465064846e-01, 6.531728429537766e-01},
+    {-7.612023854842617e-01, 6.485144010221126e-01},
+    {-7.651672656224590e-01, 6.438315428897914e-01},
+    {-7.691033376455795e-01, 6.391244448637758e-01},
+    {-7.730104533627370e-01, 6.343932841636455e-01},
+    {-7.768884656732323e-01, 6.296382389149272e-01},
+    {-7.807372285720945e-01, 6.248594881423863e-01},
+    {-7.845565971555750e-01, 6.200572117632894e-01},
+    {-7.883464276266062e-01, 6.152315905806269e-01},
+    {-7.921065773002122e-01, 6.103828062763097e-01},
+    {-7.958369046088835e-01, 6.055110414043257e-01},
+    {-7.995372691079051e-01, 6.006164793838689e-01},
+    {-8.032075314806448e-01, 5.956993044924335e-01},
+    {-8.068475535437993e-01, 5.907597018588742e-01},
+    {-8.104571982525947e-01, 5.857978574564390e-01},
+    {-8.140363297059484e-01, 5.808139580957645e-01},
+    {-8.175848131515836e-01, 5.758081914178454e-01},
+    {-8.211025149911046e-01, 5.707807458869673e-01},
+    {-8.245893027850251e-01, 5.657318107836135e-01},
+    {-8.280450452577557e-01, 5.606615761973361e-01},
+    {-8.314696123025453e-01, 5.555702330196022e-01},
+    {-8.348628749863800e-01, 5.504579729366049e-01},
+    {-8.382247055548381e-01, 5.453249884220464e-01},
+    {-8.415549774368983e-01, 5.401714727298930e-01},
+    {-8.448535652497071e-01, 5.349976198870972e-01},
+    {-8.481203448032971e-01, 5.298036246862948e-01},
+    {-8.513551931052652e-01, 5.245896826784689e-01},
+    {-8.545579883654004e-01, 5.193559901655898e-01},
+    {-8.577286100002720e-01, 5.141027441932218e-01},
+    {-8.608669386377671e-01, 5.088301425431073e-01},
+    {-8.639728561215867e-01, 5.035383837257177e-01},
+    {-8.670462455156928e-01, 4.982276669727818e-01},
+    {-8.700869911087113e-01, 4.928981922297841e-01},
+    {-8.730949784182901e-01, 4.875501601484359e-01},
+    {-8.760700941954065e-01, 4.821837720791229e-01},
+    {-8.790122264286335e-01, 4.767992300633221e-01},
+    {-8.819212643483549e-01, 4.713967368259979e-01},
+    {-8.847970984309378e-01, 4.659764957679662e-01},
+    {-8.876396204028538e-01, 4.605387109582402e-01},
+    {-8.904487232447579e-01, 4.550835871263439e-01},
+    {-8.932243011955152e-01, 4.496113296546069e-01},
+    {-8.959662497561851e-01, 4.441221445704293e-01},
+    {-8.986744656939539e-01, 4.386162385385275e-01},
+    {-9.013488470460219e-01, 4.330938188531521e-01},
+    {-9.039892931234433e-01, 4.275550934302820e-01},
+    {-9.065957045149153e-01, 4.220002707997998e-01},
+    {-9.091679830905224e-01, 4.164295600976372e-01},
+    {-9.117060320054298e-01, 4.108431710579041e-01},
+    {-9.142097557035307e-01, 4.052413140049899e-01},
+    {-9.166790599210426e-01, 3.996241998456471e-01},
+    {-9.191138516900578e-01, 3.939920400610482e-01},
+    {-9.215140393420418e-01, 3.883450466988266e-01},
+    {-9.238795325112867e-01, 3.826834323650899e-01},
+    {-9.262102421383114e-01, 3.770074102164181e-01},
+    {-9.285060804732155e-01, 3.713171939518377e-01},
+    {-9.307669610789837e-01, 3.656129978047738e-01},
+    {-9.329927988347388e-01, 3.598950365349883e-01},
+    {-9.351835099389476e-01, 3.541635254204904e-01},
+    {-9.373390119125748e-01, 3.484186802494348e-01},
+    {-9.394592236021899e-01, 3.426607173119944e-01},
+    {-9.415440651830207e-01, 3.368898533922203e-01},
+    {-9.435934581619604e-01, 3.311063057598765e-01},
+    {-9.456073253805212e-01, 3.253102921622633e-01},
+    {-9.475855910177411e-01, 3.195020308160158e-01},
+    {-9.495281805930367e-01, 3.136817403988914e-01},
+    {-9.514350209690083e-01, 3.078496400415350e-01},
+    {-9.533060403541939e-01, 3.020059493192280e-01},
+    {-9.551411683057707e-01, 2.961508882436240e-01},
+    {-9.569403357322088e-01, 2.902846772544624e-01},
+    {-9.587034748958715e-01, 2.844075372112721e-01},
+    {-9.604305194155658e-01, 2.785196893850532e-01},
+    {-9.621214042690415e-01, 2.726213554499493e-01},
+    {-9.637760657954398e-01, 2.667127574748985e-01},
+    {-9.653944416976893e-01, 2.607941179152758e-01},
+    {-9.669764710448521e-01, 2.548656596045147e-01},
+    {-9.685220942744174e-01, 2.489276057457201e-01},
+    {-9.700312531945440e-01, 2.429801799032641e-01},
+    {-9.715038909862518e-01, 2.370236059943672e-01},
+    {-9.729399522055601e-01, 2.310581082806713e-01},
+    {-9.743393827855759e-01, 2.250839113597928e-01},
+    {-9.757021300385285e-01, 2.191012401568700e-01},
+    {-9.770281426577544e-01, 2.131103199160914e-01},
+    {-9.783173707196275e-01, 2.071113761922188e-01},
+    {-9.795697656854405e-01, 2.011046348420920e-01},
+    {-9.807852804032304e-01, 1.950903220161286e-01},
+    {-9.819638691095552e-01, 1.890686641498064e-01},
+    {-9.831054874312163e-01, 1.830398879551409e-01},
+    {-9.842100923869290e-01, 1.770042204121489e-01},
+    {-9.852776423889412e-01, 1.709618887603012e-01},
+    {-9.863080972445986e-01, 1.649131204899701e-01},
+    {-9.873014181578584e-01, 1.588581433338615e-01},
+    {-9.882575677307495e-01, 1.527971852584437e-01},
+    {-9.891765099647810e-01, 1.467304744553618e-01},
+    {-9.900582102622970e-01, 1.406582393328495e-01},
+    {-9.909026354277800e-01, 1.345807085071263e-01},
+    {-9.917097536690995e-01, 1.284981107937931e-01},
+    {-9.924795345987100e-01, 1.224106751992163e-01},
+    {-9.932119492347945e-01, 1.163186309119047e-01},
+    {-9.939069700023561e-01, 1.102222072938832e-01},
+    {-9.945645707342554e-01, 1.041216338720546e-01},
+    {-9.951847266721968e-01, 9.801714032956083e-02},
+    {-9.957674144676598e-01, 9.190895649713275e-02},
+    {-9.963126121827780e-01, 8.579731234444016e-02},
+    {-9.968202992911657e-01, 7.968243797143020e-02},
+    {-9.972904566786902e-01, 7.356456359966773e-02},
+    {-9.977230666441916e-01, 6.744391956366418e-02},
+    {-9.981181129001492e-01, 6.132073630220849e-02},
+    {-9.984755805732948e-01, 5.519524434969009e-02},
+    {-9.987954562051724e-01, 4.906767432741797e-02},
+    {-9.990777277526454e-01, 4.293825693494102e-02},
+    {-9.993223845883495e-01, 3.680722294135883e-02},
+    {-9.995294175010931e-01, 3.067480317663687e-02},
+    {-9.996988186962042e-01, 2.454122852291233e-02},
+    {-9.998305817958234e-01, 1.840672990580510e-02},
+    {-9.999247018391445e-01, 1.227153828572001e-02},
+    {-9.999811752826011e-01, 6.135884649154799e-03},
+    {-1.000000000000000e+00, 1.224646799147353e-16},
+    {-9.999811752826011e-01, -6.135884649154554e-03},
+    {-9.999247018391445e-01, -1.227153828571976e-02},
+    {-9.998305817958234e-01, -1.840672990580486e-02},
+    {-9.996988186962042e-01, -2.454122852291208e-02},
+    {-9.995294175010931e-01, -3.067480317663662e-02},
+    {-9.993223845883495e-01, -3.680722294135858e-02},
+    {-9.990777277526454e-01, -4.293825693494078e-02},
+    {-9.987954562051724e-01, -4.906767432741772e-02},
+    {-9.984755805732948e-01, -5.519524434968985e-02},
+    {-9.981181129001492e-01, -6.132073630220825e-02},
+    {-9.977230666441916e-01, -6.744391956366393e-02},
+    {-9.972904566786902e-01, -7.356456359966750e-02},
+    {-9.968202992911658e-01, -7.968243797142995e-02},
+    {-9.963126121827780e-01, -8.579731234443992e-02},
+    {-9.957674144676598e-01, -9.190895649713252e-02},
+    {-9.951847266721969e-01, -9.801714032956059e-02},
+    {-9.945645707342555e-01, -1.041216338720543e-01},
+    {-9.939069700023561e-01, -1.102222072938830e-01},
+    {-9.932119492347946e-01, -1.163186309119045e-01},
+    {-9.924795345987100e-01, -1.224106751992161e-01},
+    {-9.917097536690995e-01, -1.284981107937928e-01},
+    {-9.909026354277800e-01, -1.345807085071261e-01},
+    {-9.900582102622971e-01, -1.406582393328493e-01},
+    {-9.891765099647810e-01, -1.467304744553616e-01},
+    {-9.882575677307495e-01, -1.527971852584434e-01},
+    {-9.873014181578584e-01, -1.588581433338612e-01},
+    {-9.863080972445987e-01, -1.649131204899699e-01},
+    {-9.852776423889413e-01, -1.709618887603010e-01},
+    {-9.842100923869291e-01, -1.770042204121487e-01},
+    {-9.831054874312164e-01, -1.830398879551406e-01},
+    {-9.819638691095552e-01, -1.890686641498061e-01},
+    {-9.807852804032304e-01, -1.950903220161284e-01},
+    {-9.795697656854405e-01, -2.011046348420918e-01},
+    {-9.783173707196277e-01, -2.071113761922186e-01},
+    {-9.770281426577544e-01, -2.131103199160912e-01},
+    {-9.757021300385286e-01, -2.191012401568698e-01},
+    {-9.743393827855759e-01, -2.250839113597926e-01},
+    {-9.729399522055602e-01, -2.310581082806711e-01},
+    {-9.715038909862519e-01, -2.370236059943669e-01},
+    {-9.700312531945440e-01, -2.429801799032638e-01},
+    {-9.685220942744174e-01, -2.489276057457199e-01},
+    {-9.669764710448522e-01, -2.548656596045145e-01},
+    {-9.653944416976894e-01, -2.607941179152756e-01},
+    {-9.637760657954400e-01, -2.667127574748983e-01},
+    {-9.621214042690416e-01, -2.726213554499490e-01},
+    {-9.604305194155659e-01, -2.785196893850529e-01},
+    {-9.587034748958716e-01, -2.844075372112718e-01},
+    {-9.569403357322089e-01, -2.902846772544621e-01},
+    {-9.551411683057708e-01, -2.961508882436238e-01},
+    {-9.533060403541940e-01, -3.020059493192278e-01},
+    {-9.514350209690084e-01, -3.078496400415348e-01},
+    {-9.495281805930368e-01, -3.136817403988912e-01},
+    {-9.475855910177412e-01, -3.195020308160156e-01},
+    {-9.456073253805213e-01, -3.253102921622630e-01},
+    {-9.435934581619604e-01, -3.311063057598763e-01},
+    {-9.415440651830208e-01, -3.368898533922201e-01},
+    {-9.394592236021900e-01, -3.426607173119942e-01},
+    {-9.373390119125750e-01, -3.484186802494346e-01},
+    {-9.351835099389477e-01, -3.541635254204901e-01},
+    {-9.329927988347390e-01, -3.598950365349881e-01},
+    {-9.307669610789838e-01, -3.656129978047736e-01},
+    {-9.285060804732156e-01, -3.713171939518374e-01},
+    {-9.262102421383115e-01, -3.770074102164179e-01},
+    {-9.238795325112868e-01, -3.826834323650897e-01},
+    {-9.215140393420419e-01, -3.883450466988264e-01},
+    {-9.191138516900578e-01, -3.939920400610479e-01},
+    {-9.166790599210427e-01, -3.996241998456468e-01},
+    {-9.142097557035307e-01, -4.052413140049897e-01},
+    {-9.117060320054299e-01, -4.108431710579039e-01},
+    {-9.091679830905225e-01, -4.164295600976369e-01},
+    {-9.065957045149154e-01, -4.220002707997996e-01},
+    {-9.039892931234434e-01, -4.275550934302818e-01},
+    {-9.013488470460220e-01, -4.330938188531518e-01},
+    {-8.986744656939540e-01, -4.386162385385273e-01},
+    {-8.959662497561852e-01, -4.441221445704291e-01},
+    {-8.932243011955153e-01, -4.496113296546067e-01},
+    {-8.904487232447580e-01, -4.550835871263437e-01},
+    {-8.876396204028539e-01, -4.605387109582401e-01},
+    {-8.847970984309379e-01, -4.659764957679660e-01},
+    {-8.819212643483550e-01, -4.713967368259976e-01},
+    {-8.790122264286336e-01, -4.767992300633219e-01},
+    {-8.760700941954066e-01, -4.821837720791227e-01},
+    {-8.730949784182902e-01, -4.875501601484357e-01},
+    {-8.700869911087115e-01, -4.928981922297839e-01},
+    {-8.670462455156929e-01, -4.982276669727815e-01},
+    {-8.639728561215868e-01, -5.035383837257175e-01},
+    {-8.608669386377673e-01, -5.088301425431071e-01},
+    {-8.577286100002721e-01, -5.141027441932216e-01},
+    {-8.545579883654005e-01, -5.193559901655896e-01},
+    {-8.513551931052653e-01, -5.245896826784687e-01},
+    {-8.481203448032972e-01, -5.298036246862946e-01},
+    {-8.448535652497072e-01, -5.349976198870969e-01},
+    {-8.415549774368984e-01, -5.401714727298929e-01},
+    {-8.382247055548382e-01, -5.453249884220461e-01},
+    {-8.348628749863801e-01, -5.504579729366047e-01},
+    {-8.314696123025455e-01, -5.555702330196020e-01},
+    {-8.280450452577558e-01, -5.606615761973359e-01},
+    {-8.245893027850253e-01, -5.657318107836132e-01},
+    {-8.211025149911048e-01, -5.707807458869671e-01},
+    {-8.175848131515837e-01, -5.758081914178453e-01},
+    {-8.140363297059485e-01, -5.808139580957643e-01},
+    {-8.104571982525948e-01, -5.857978574564389e-01},
+    {-8.068475535437994e-01, -5.907597018588739e-01},
+    {-8.032075314806449e-01, -5.956993044924332e-01},
+    {-7.995372691079052e-01, -6.006164793838686e-01},
+    {-7.958369046088836e-01, -6.055110414043254e-01},
+    {-7.921065773002123e-01, -6.103828062763095e-01},
+    {-7.883464276266063e-01, -6.152315905806267e-01},
+    {-7.845565971555752e-01, -6.200572117632892e-01},
+    {-7.807372285720946e-01, -6.248594881423862e-01},
+    {-7.768884656732324e-01, -6.296382389149270e-01},
+    {-7.730104533627371e-01, -6.343932841636453e-01},
+    {-7.691033376455797e-01, -6.391244448637757e-01},
+    {-7.651672656224591e-01, -6.438315428897913e-01},
+    {-7.612023854842619e-01, -6.485144010221123e-01},
+    {-7.572088465064848e-01, -6.531728429537765e-01},
+    {-7.531867990436126e-01, -6.578066932970785e-01},
+    {-7.491363945234593e-01, -6.624157775901718e-01},
+    {-7.450577854414661e-01, -6.669999223036374e-01},
+    {-7.409511253549591e-01, -6.715589548470184e-01},
+    {-7.368165688773700e-01, -6.760927035753158e-01},
+    {-7.326542716724128e-01, -6.806009977954530e-01},
+    {-7.284643904482254e-01, -6.850836677727001e-01},
+    {-7.242470829514670e-01, -6.895405447370668e-01},
+    {-7.200025079613819e-01, -6.939714608896538e-01},
+    {-7.157308252838187e-01, -6.983762494089728e-01},
+    {-7.114321957452167e-01, -7.027547444572251e-01},
+    {-7.071067811865477e-01, -7.071067811865475e-01},
+    {-7.027547444572253e-01, -7.114321957452164e-01},
+    {-6.983762494089730e-01, -7.157308252838185e-01},
+    {-6.939714608896540e-01, -7.200025079613817e-01},
+    {-6.895405447370671e-01, -7.242470829514668e-01},
+    {-6.850836677727004e-01, -7.284643904482252e-01},
+    {-6.806009977954532e-01, -7.326542716724126e-01},
+    {-6.760927035753160e-01, -7.368165688773698e-01},
+    {-6.715589548470187e-01, -7.409511253549589e-01},
+    {-6.669999223036376e-01, -7.450577854414658e-01},
+    {-6.624157775901720e-01, -7.491363945234590e-01},
+    {-6.578066932970787e-01, -7.531867990436124e-01},
+    {-6.531728429537771e-01, -7.572088465064842e-01},
+    {-6.485144010221122e-01, -7.612023854842620e-01},
+    {-6.438315428897915e-01, -7.651672656224590e-01},
+    {-6.391244448637760e-01, -7.691033376455795e-01},
+    {-6.343932841636459e-01, -7.730104533627367e-01},
+    {-6.296382389149269e-01, -7.768884656732326e-01},
+    {-6.248594881423865e-01, -7.807372285720944e-01},
+    {-6.200572117632894e-01, -7.845565971555750e-01},
+    {-6.152315905806273e-01, -7.883464276266059e-01},
+    {-6.103828062763094e-01, -7.921065773002124e-01},
+    {-6.055110414043257e-01, -7.958369046088835e-01},
+    {-6.006164793838693e-01, -7.995372691079048e-01},
+    {-5.956993044924331e-01, -8.032075314806451e-01},
+    {-5.907597018588743e-01, -8.068475535437992e-01},
+    {-5.857978574564391e-01, -8.104571982525947e-01},
+    {-5.808139580957650e-01, -8.140363297059481e-01},
+    {-5.758081914178452e-01, -8.175848131515838e-01},
+    {-5.707807458869674e-01, -8.211025149911046e-01},
+    {-5.657318107836135e-01, -8.245893027850251e-01},
+    {-5.606615761973365e-01, -8.280450452577555e-01},
+    {-5.555702330196022e-01, -8.314696123025452e-01},
+    {-5.504579729366049e-01, -8.348628749863800e-01},
+    {-5.453249884220468e-01, -8.382247055548379e-01},
+    {-5.401714727298927e-01, -8.415549774368986e-01},
+    {-5.349976198870973e-01, -8.448535652497070e-01},
+    {-5.298036246862949e-01, -8.481203448032971e-01},
+    {-5.245896826784694e-01, -8.513551931052649e-01},
+    {-5.193559901655894e-01, -8.545579883654006e-01},
+    {-5.141027441932218e-01, -8.577286100002720e-01},
+    {-5.088301425431073e-01, -8.608669386377671e-01},
+    {-5.035383837257180e-01, -8.639728561215865e-01},
+    {-4.982276669727818e-01, -8.670462455156926e-01},
+    {-4.928981922297842e-01, -8.700869911087113e-01},
+    {-4.875501601484363e-01, -8.730949784182899e-01},
+    {-4.821837720791226e-01, -8.760700941954067e-01},
+    {-4.767992300633221e-01, -8.790122264286334e-01},
+    {-4.713967368259979e-01, -8.819212643483549e-01},
+    {-4.659764957679666e-01, -8.847970984309376e-01},
+    {-4.605387109582399e-01, -8.876396204028540e-01},
+    {-4.550835871263439e-01, -8.904487232447579e-01},
+    {-4.496113296546069e-01, -8.932243011955152e-01},
+    {-4.441221445704298e-01, -8.959662497561849e-01},
+    {-4.386162385385276e-01, -8.986744656939538e-01},
+    {-4.330938188531521e-01, -9.013488470460219e-01},
+    {-4.275550934302825e-01, -9.039892931234431e-01},
+    {-4.220002707997995e-01, -9.065957045149154e-01},
+    {-4.164295600976372e-01, -9.091679830905224e-01},
+    {-4.108431710579042e-01, -9.117060320054298e-01},
+    {-4.052413140049904e-01, -9.142097557035305e-01},
+    {-3.996241998456467e-01, -9.166790599210427e-01},
+    {-3.939920400610482e-01, -9.191138516900577e-01},
+    {-3.883450466988266e-01, -9.215140393420418e-01},
+    {-3.826834323650903e-01, -9.238795325112865e-01},
+    {-3.770074102164182e-01, -9.262102421383114e-01},
+    {-3.713171939518378e-01, -9.285060804732155e-01},
+    {-3.656129978047743e-01, -9.307669610789836e-01},
+    {-3.598950365349879e-01, -9.329927988347390e-01},
+    {-3.541635254204905e-01, -9.351835099389476e-01},
+    {-3.484186802494348e-01, -9.373390119125748e-01},
+    {-3.426607173119949e-01, -9.394592236021897e-01},
+    {-3.368898533922199e-01, -9.415440651830208e-01},
+    {-3.311063057598765e-01, -9.435934581619603e-01},
+    {-3.253102921622633e-01, -9.456073253805212e-01},
+    {-3.195020308160154e-01, -9.475855910177412e-01},
+    {-3.136817403988915e-01, -9.495281805930367e-01},
+    {-3.078496400415351e-01, -9.514350209690083e-01},
+    {-3.020059493192285e-01, -9.533060403541938e-01},
+    {-2.961508882436237e-01, -9.551411683057708e-01},
+    {-2.902846772544624e-01, -9.569403357322088e-01},
+    {-2.844075372112722e-01, -9.587034748958715e-01},
+    {-2.785196893850536e-01, -9.604305194155657e-01},
+    {-2.726213554499489e-01, -9.621214042690416e-01},
+    {-2.667127574748985e-01, -9.637760657954398e-01},
+    {-2.607941179152759e-01, -9.653944416976893e-01},
+    {-2.548656596045143e-01, -9.669764710448522e-01},
+    {-2.489276057457201e-01, -9.685220942744173e-01},
+    {-2.429801799032641e-01, -9.700312531945440e-01},
+    {-2.370236059943677e-01, -9.715038909862517e-01},
+    {-2.310581082806709e-01, -9.729399522055602e-01},
+    {-2.250839113597929e-01, -9.743393827855759e-01},
+    {-2.191012401568701e-01, -9.757021300385285e-01},
+    {-2.131103199160919e-01, -9.770281426577543e-01},
+    {-2.071113761922185e-01, -9.783173707196277e-01},
+    {-2.011046348420921e-01, -9.795697656854405e-01},
+    {-1.950903220161287e-01, -9.807852804032303e-01},
+    {-1.890686641498060e-01, -9.819638691095554e-01},
+    {-1.830398879551410e-01, -9.831054874312163e-01},
+    {-1.770042204121490e-01, -9.842100923869290e-01},
+    {-1.709618887603017e-01, -9.852776423889411e-01},
+    {-1.649131204899698e-01, -9.863080972445987e-01},
+    {-1.588581433338615e-01, -9.873014181578583e-01},
+    {-1.527971852584437e-01, -9.882575677307495e-01},
+    {-1.467304744553623e-01, -9.891765099647809e-01},
+    {-1.406582393328492e-01, -9.900582102622971e-01},
+    {-1.345807085071264e-01, -9.909026354277800e-01},
+    {-1.284981107937936e-01, -9.917097536690995e-01},
+    {-1.224106751992160e-01, -9.924795345987101e-01},
+    {-1.163186309119048e-01, -9.932119492347945e-01},
+    {-1.102222072938833e-01, -9.939069700023561e-01},
+    {-1.041216338720551e-01, -9.945645707342554e-01},
+    {-9.801714032956045e-02, -9.951847266721969e-01},
+    {-9.190895649713282e-02, -9.957674144676598e-01},
+    {-8.579731234444023e-02, -9.963126121827780e-01},
+    {-7.968243797143069e-02, -9.968202992911657e-01},
+    {-7.356456359966736e-02, -9.972904566786902e-01},
+    {-6.744391956366423e-02, -9.977230666441916e-01},
+    {-6.132073630220899e-02, -9.981181129001492e-01},
+    {-5.519524434968971e-02, -9.984755805732948e-01},
+    {-4.906767432741803e-02, -9.987954562051724e-01},
+    {-4.293825693494108e-02, -9.990777277526454e-01},
+    {-3.680722294135933e-02, -9.993223845883494e-01},
+    {-3.067480317663648e-02, -9.995294175010931e-01},
+    {-2.454122852291239e-02, -9.996988186962042e-01},
+    {-1.840672990580516e-02, -9.998305817958234e-01},
+    {-1.227153828572051e-02, -9.999247018391445e-01},
+    {-6.135884649154416e-03, -9.999811752826011e-01},
+    {-1.836970198721030e-16, -1.000000000000000e+00},
+    {6.135884649154049e-03, -9.999811752826011e-01},
+    {1.227153828572014e-02, -9.999247018391445e-01},
+    {1.840672990580480e-02, -9.998305817958234e-01},
+    {2.454122852291202e-02, -9.996988186962042e-01},
+    {3.067480317663612e-02, -9.995294175010931e-01},
+    {3.680722294135896e-02, -9.993223845883495e-01},
+    {4.293825693494072e-02, -9.990777277526454e-01},
+    {4.906767432741766e-02, -9.987954562051724e-01},
+    {5.519524434968934e-02, -9.984755805732948e-01},
+    {6.132073630220863e-02, -9.981181129001492e-01},
+    {6.744391956366387e-02, -9.977230666441916e-01},
+    {7.356456359966698e-02, -9.972904566786902e-01},
+    {7.968243797143033e-02, -9.968202992911657e-01},
+    {8.579731234443985e-02, -9.963126121827780e-01},
+    {9.190895649713245e-02, -9.957674144676598e-01},
+    {9.801714032956009e-02, -9.951847266721969e-01},
+    {1.041216338720547e-01, -9.945645707342554e-01},
+    {1.102222072938829e-01, -9.939069700023561e-01},
+    {1.163186309119044e-01, -9.932119492347946e-01},
+    {1.224106751992156e-01, -9.924795345987101e-01},
+    {1.284981107937932e-01, -9.917097536690995e-01},
+    {1.345807085071260e-01, -9.909026354277800e-01},
+    {1.406582393328488e-01, -9.900582102622971e-01},
+    {1.467304744553619e-01, -9.891765099647809e-01},
+    {1.527971852584434e-01, -9.882575677307495e-01},
+    {1.588581433338612e-01, -9.873014181578584e-01},
+    {1.649131204899694e-01, -9.863080972445988e-01},
+    {1.709618887603013e-01, -9.852776423889412e-01},
+    {1.770042204121486e-01, -9.842100923869291e-01},
+    {1.830398879551406e-01, -9.831054874312164e-01},
+    {1.890686641498056e-01, -9.819638691095554e-01},
+    {1.950903220161283e-01, -9.807852804032304e-01},
+    {2.011046348420917e-01, -9.795697656854406e-01},
+    {2.071113761922181e-01, -9.783173707196278e-01},
+    {2.131103199160916e-01, -9.770281426577543e-01},
+    {2.191012401568697e-01, -9.757021300385286e-01},
+    {2.250839113597926e-01, -9.743393827855760e-01},
+    {2.310581082806706e-01, -9.729399522055603e-01},
+    {2.370236059943673e-01, -9.715038909862518e-01},
+    {2.429801799032638e-01, -9.700312531945440e-01},
+    {2.489276057457198e-01, -9.685220942744174e-01},
+    {2.548656596045140e-01, -9.669764710448523e-01},
+    {2.607941179152755e-01, -9.653944416976894e-01},
+    {2.667127574748982e-01, -9.637760657954400e-01},
+    {2.726213554499485e-01, -9.621214042690417e-01},
+    {2.785196893850533e-01, -9.604305194155658e-01},
+    {2.844075372112718e-01, -9.587034748958716e-01},
+    {2.902846772544621e-01, -9.569403357322089e-01},
+    {2.961508882436233e-01, -9.551411683057709e-01},
+    {3.020059493192281e-01, -9.533060403541939e-01},
+    {3.078496400415348e-01, -9.514350209690084e-01},
+    {3.136817403988911e-01, -9.495281805930368e-01},
+    {3.195020308160151e-01, -9.475855910177413e-01},
+    {3.253102921622629e-01, -9.456073253805213e-01},
+    {3.311063057598762e-01, -9.435934581619604e-01},
+    {3.368898533922196e-01, -9.415440651830209e-01},
+    {3.426607173119945e-01, -9.394592236021898e-01},
+    {3.484186802494345e-01, -9.373390119125750e-01},
+    {3.541635254204901e-01, -9.351835099389477e-01},
+    {3.598950365349876e-01, -9.329927988347391e-01},
+    {3.656129978047740e-01, -9.307669610789837e-01},
+    {3.713171939518374e-01, -9.285060804732156e-01},
+    {3.770074102164179e-01, -9.262102421383115e-01},
+    {3.826834323650900e-01, -9.238795325112866e-01},
+    {3.883450466988263e-01, -9.215140393420419e-01},
+    {3.939920400610479e-01, -9.191138516900579e-01},
+    {3.996241998456464e-01, -9.166790599210428e-01},
+    {4.052413140049900e-01, -9.142097557035306e-01},
+    {4.108431710579039e-01, -9.117060320054299e-01},
+    {4.164295600976369e-01, -9.091679830905225e-01},
+    {4.220002707997992e-01, -9.065957045149156e-01},
+    {4.275550934302821e-01, -9.039892931234433e-01},
+    {4.330938188531518e-01, -9.013488470460221e-01},
+    {4.386162385385273e-01, -8.986744656939540e-01},
+    {4.441221445704294e-01, -8.959662497561850e-01},
+    {4.496113296546066e-01, -8.932243011955153e-01},
+    {4.550835871263436e-01, -8.904487232447580e-01},
+    {4.605387109582396e-01, -8.876396204028542e-01},
+    {4.659764957679663e-01, -8.847970984309377e-01},
+    {4.713967368259976e-01, -8.819212643483550e-01},
+    {4.767992300633219e-01, -8.790122264286336e-01},
+    {4.821837720791222e-01, -8.760700941954069e-01},
+    {4.875501601484360e-01, -8.730949784182901e-01},
+    {4.928981922297839e-01, -8.700869911087115e-01},
+    {4.982276669727815e-01, -8.670462455156929e-01},
+    {5.035383837257178e-01, -8.639728561215866e-01},
+    {5.088301425431070e-01, -8.608669386377673e-01},
+    {5.141027441932216e-01, -8.577286100002722e-01},
+    {5.193559901655892e-01, -8.545579883654008e-01},
+    {5.245896826784691e-01, -8.513551931052651e-01},
+    {5.298036246862946e-01, -8.481203448032973e-01},
+    {5.349976198870969e-01, -8.448535652497072e-01},
+    {5.401714727298924e-01, -8.415549774368988e-01},
+    {5.453249884220465e-01, -8.382247055548380e-01},
+    {5.504579729366047e-01, -8.348628749863801e-01},
+    {5.555702330196018e-01, -8.314696123025455e-01},
+    {5.606615761973363e-01, -8.280450452577557e-01},
+    {5.657318107836131e-01, -8.245893027850253e-01},
+    {5.707807458869670e-01, -8.211025149911049e-01},
+    {5.758081914178449e-01, -8.175848131515840e-01},
+    {5.808139580957646e-01, -8.140363297059483e-01},
+    {5.857978574564388e-01, -8.104571982525949e-01},
+    {5.907597018588739e-01, -8.068475535437994e-01},
+    {5.956993044924329e-01, -8.032075314806453e-01},
+    {6.006164793838690e-01, -7.995372691079050e-01},
+    {6.055110414043253e-01, -7.958369046088837e-01},
+    {6.103828062763091e-01, -7.921065773002126e-01},
+    {6.152315905806270e-01, -7.883464276266061e-01},
+    {6.200572117632891e-01, -7.845565971555752e-01},
+    {6.248594881423861e-01, -7.807372285720946e-01},
+    {6.296382389149267e-01, -7.768884656732328e-01},
+    {6.343932841636456e-01, -7.730104533627369e-01},
+    {6.391244448637756e-01, -7.691033376455797e-01},
+    {6.438315428897912e-01, -7.651672656224592e-01},
+    {6.485144010221120e-01, -7.612023854842622e-01},
+    {6.531728429537768e-01, -7.572088465064846e-01},
+    {6.578066932970785e-01, -7.531867990436126e-01},
+    {6.624157775901715e-01, -7.491363945234596e-01},
+    {6.669999223036377e-01, -7.450577854414658e-01},
+    {6.715589548470183e-01, -7.409511253549591e-01},
+    {6.760927035753157e-01, -7.368165688773700e-01},
+    {6.806009977954527e-01, -7.326542716724131e-01},
+    {6.850836677727005e-01, -7.284643904482251e-01},
+    {6.895405447370668e-01, -7.242470829514670e-01},
+    {6.939714608896538e-01, -7.200025079613819e-01},
+    {6.983762494089724e-01, -7.157308252838190e-01},
+    {7.027547444572253e-01, -7.114321957452164e-01},
+    {7.071067811865474e-01, -7.071067811865477e-01},
+    {7.114321957452161e-01, -7.027547444572256e-01},
+    {7.157308252838188e-01, -6.983762494089727e-01},
+    {7.200025079613815e-01, -6.939714608896540e-01},
+    {7.242470829514667e-01, -6.895405447370672e-01},
+    {7.284643904482249e-01, -6.850836677727008e-01},
+    {7.326542716724129e-01, -6.806009977954530e-01},
+    {7.368165688773698e-01, -6.760927035753160e-01},
+    {7.409511253549589e-01, -6.715589548470187e-01},
+    {7.450577854414655e-01, -6.669999223036380e-01},
+    {7.491363945234594e-01, -6.624157775901718e-01},
+    {7.531867990436123e-01, -6.578066932970789e-01},
+    {7.572088465064842e-01, -6.531728429537771e-01},
+    {7.612023854842619e-01, -6.485144010221123e-01},
+    {7.651672656224588e-01, -6.438315428897915e-01},
+    {7.691033376455795e-01, -6.391244448637760e-01},
+    {7.730104533627367e-01, -6.343932841636459e-01},
+    {7.768884656732326e-01, -6.296382389149270e-01},
+    {7.807372285720944e-01, -6.248594881423865e-01},
+    {7.845565971555750e-01, -6.200572117632895e-01},
+    {7.883464276266059e-01, -6.152315905806274e-01},
+    {7.921065773002124e-01, -6.103828062763095e-01},
+    {7.958369046088833e-01, -6.055110414043257e-01},
+    {7.995372691079048e-01, -6.006164793838693e-01},
+    {8.032075314806451e-01, -5.956993044924332e-01},
+    {8.068475535437992e-01, -5.907597018588743e-01},
+    {8.104571982525947e-01, -5.857978574564391e-01},
+    {8.140363297059481e-01, -5.808139580957650e-01},
+    {8.175848131515837e-01, -5.758081914178452e-01},
+    {8.211025149911045e-01, -5.707807458869674e-01},
+    {8.245893027850251e-01, -5.657318107836136e-01},
+    {8.280450452577554e-01, -5.606615761973366e-01},
+    {8.314696123025452e-01, -5.555702330196022e-01},
+    {8.348628749863799e-01, -5.504579729366050e-01},
+    {8.382247055548377e-01, -5.453249884220468e-01},
+    {8.415549774368984e-01, -5.401714727298927e-01},
+    {8.448535652497070e-01, -5.349976198870973e-01},
+    {8.481203448032971e-01, -5.298036246862949e-01},
+    {8.513551931052649e-01, -5.245896826784694e-01},
+    {8.545579883654005e-01, -5.193559901655895e-01},
+    {8.577286100002720e-01, -5.141027441932219e-01},
+    {8.608669386377671e-01, -5.088301425431074e-01},
+    {8.639728561215864e-01, -5.035383837257181e-01},
+    {8.670462455156926e-01, -4.982276669727819e-01},
+    {8.700869911087113e-01, -4.928981922297843e-01},
+    {8.730949784182899e-01, -4.875501601484364e-01},
+    {8.760700941954067e-01, -4.821837720791226e-01},
+    {8.790122264286334e-01, -4.767992300633222e-01},
+    {8.819212643483548e-01, -4.713967368259979e-01},
+    {8.847970984309375e-01, -4.659764957679667e-01},
+    {8.876396204028539e-01, -4.605387109582399e-01},
+    {8.904487232447578e-01, -4.550835871263440e-01},
+    {8.932243011955151e-01, -4.496113296546070e-01},
+    {8.959662497561849e-01, -4.441221445704298e-01},
+    {8.986744656939538e-01, -4.386162385385277e-01},
+    {9.013488470460219e-01, -4.330938188531522e-01},
+    {9.039892931234431e-01, -4.275550934302825e-01},
+    {9.065957045149154e-01, -4.220002707997996e-01},
+    {9.091679830905224e-01, -4.164295600976373e-01},
+    {9.117060320054297e-01, -4.108431710579042e-01},
+    {9.142097557035305e-01, -4.052413140049904e-01},
+    {9.166790599210427e-01, -3.996241998456468e-01},
+    {9.191138516900577e-01, -3.939920400610483e-01},
+    {9.215140393420418e-01, -3.883450466988267e-01},
+    {9.238795325112865e-01, -3.826834323650904e-01},
+    {9.262102421383114e-01, -3.770074102164183e-01},
+    {9.285060804732155e-01, -3.713171939518378e-01},
+    {9.307669610789835e-01, -3.656129978047744e-01},
+    {9.329927988347390e-01, -3.598950365349880e-01},
+    {9.351835099389475e-01, -3.541635254204905e-01},
+    {9.373390119125748e-01, -3.484186802494349e-01},
+    {9.394592236021897e-01, -3.426607173119949e-01},
+    {9.415440651830208e-01, -3.368898533922200e-01},
+    {9.435934581619603e-01, -3.311063057598766e-01},
+    {9.456073253805212e-01, -3.253102921622634e-01},
+    {9.475855910177412e-01, -3.195020308160155e-01},
+    {9.495281805930367e-01, -3.136817403988915e-01},
+    {9.514350209690083e-01, -3.078496400415351e-01},
+    {9.533060403541936e-01, -3.020059493192286e-01},
+    {9.551411683057708e-01, -2.961508882436237e-01},
+    {9.569403357322088e-01, -2.902846772544625e-01},
+    {9.587034748958715e-01, -2.844075372112722e-01},
+    {9.604305194155657e-01, -2.785196893850537e-01},
+    {9.621214042690416e-01, -2.726213554499490e-01},
+    {9.637760657954398e-01, -2.667127574748986e-01},
+    {9.653944416976893e-01, -2.607941179152760e-01},
+    {9.669764710448522e-01, -2.548656596045144e-01},
+    {9.685220942744173e-01, -2.489276057457202e-01},
+    {9.700312531945440e-01, -2.429801799032642e-01},
+    {9.715038909862517e-01, -2.370236059943677e-01},
+    {9.729399522055602e-01, -2.310581082806710e-01},
+    {9.743393827855759e-01, -2.250839113597930e-01},
+    {9.757021300385285e-01, -2.191012401568702e-01},
+    {9.770281426577542e-01, -2.131103199160920e-01},
+    {9.783173707196277e-01, -2.071113761922185e-01},
+    {9.795697656854405e-01, -2.011046348420921e-01},
+    {9.807852804032303e-01, -1.950903220161287e-01},
+    {9.819638691095554e-01, -1.890686641498060e-01},
+    {9.831054874312163e-01, -1.830398879551410e-01},
+    {9.842100923869290e-01, -1.770042204121491e-01},
+    {9.852776423889411e-01, -1.709618887603018e-01},
+    {9.863080972445987e-01, -1.649131204899698e-01},
+    {9.873014181578583e-01, -1.588581433338616e-01},
+    {9.882575677307495e-01, -1.527971852584438e-01},
+    {9.891765099647809e-01, -1.467304744553624e-01},
+    {9.900582102622971e-01, -1.406582393328492e-01},
+    {9.909026354277800e-01, -1.345807085071264e-01},
+    {9.917097536690994e-01, -1.284981107937936e-01},
+    {9.924795345987100e-01, -1.224106751992160e-01},
+    {9.932119492347945e-01, -1.163186309119048e-01},
+    {9.939069700023561e-01, -1.102222072938834e-01},
+    {9.945645707342554e-01, -1.041216338720551e-01},
+    {9.951847266721969e-01, -9.801714032956051e-02},
+    {9.957674144676598e-01, -9.190895649713288e-02},
+    {9.963126121827780e-01, -8.579731234444028e-02},
+    {9.968202992911657e-01, -7.968243797143075e-02},
+    {9.972904566786902e-01, -7.356456359966741e-02},
+    {9.977230666441916e-01, -6.744391956366429e-02},
+    {9.981181129001492e-01, -6.132073630220906e-02},
+    {9.984755805732948e-01, -5.519524434968977e-02},
+    {9.987954562051724e-01, -4.906767432741809e-02},
+    {9.990777277526454e-01, -4.293825693494114e-02},
+    {9.993223845883494e-01, -3.680722294135939e-02},
+    {9.995294175010931e-01, -3.067480317663654e-02},
+    {9.996988186962042e-01, -2.454122852291245e-02},
+    {9.998305817958234e-01, -1.840672990580523e-02},
+    {9.999247018391445e-01, -1.227153828572057e-02},
+    {9.999811752826011e-01, -6.135884649154477e-03},
+};
+
+#endif
@@ -285,4 +285,35 @@ static inline void volk_gnsssdr_32f_high_dynamics_resamplerxnpuppet_32f_u_avx(fl
 //}
 //#endif
 
+
+#ifdef LV_HAVE_NEONV8
+static inline void volk_gnsssdr_32f_high_dynamics_resamplerxnpuppet_32f_neonv8(float* result, const float* local_code, unsigned int num_points)
+{
+    int code_length_chips = 2046;
+    float code_phase_step_chips = ((float)(code_length_chips) + 0.1) / ((float)num_points);
+    int num_out_vectors = 3;
+    float rem_code_phase_chips = -0.8234;
+    float code_phase_rate_step_chips = 1.0 / powf(2.0, 33.0);
+    int n;
+    float shifts_chips[3] = {-0.1, 0.0, 0.1};
+
+    float** result_aux = (float**)volk_gnsssdr_malloc(sizeof(float*) * num_out_vectors, volk_gnsssdr_get_alignment());
+    for (n = 0; n < num_out_vectors; n++)
+        {
+            result_aux[n] = (float*)volk_gnsssdr_malloc(sizeof(float) * num_points, volk_gnsssdr_get_alignment());
+        }
+
+    volk_gnsssdr_32f_xn_high_dynamics_resampler_32f_xn_neonv8(result_aux, local_code, rem_code_phase_chips, code_phase_step_chips, code_phase_rate_step_chips, shifts_chips, code_length_chips, num_out_vectors, num_points);
+
+    memcpy((float*)result, (float*)result_aux[0], sizeof(float) * num_points);
+
+    for (n = 0; n < num_out_vectors; n++)
+        {
+            volk_gnsssdr_free(result_aux[n]);
+        }
+    volk_gnsssdr_free(result_aux);
+}
+
+#endif /* LV_HAVE_NEONV8 */
+
 #endif  // INCLUDED_volk_gnsssdr_32f_high_dynamics_resamplerpuppet_32f_H
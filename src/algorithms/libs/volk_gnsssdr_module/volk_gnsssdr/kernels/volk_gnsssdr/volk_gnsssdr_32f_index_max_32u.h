@@ -548,4 +548,71 @@ static inline void volk_gnsssdr_32f_index_max_32u_neon(uint32_t* target, const f
 
 #endif /*LV_HAVE_NEONV7*/
 
+
+#ifdef LV_HAVE_NEONV8
+#include <arm_neon.h>
+
+static inline void volk_gnsssdr_32f_index_max_32u_neonv8(uint32_t* target, const float* src0, uint32_t num_points)
+{
+    if (num_points > 0)
+        {
+            uint32_t number = 0;
+            const uint32_t quarterPoints = num_points / 4;
+
+            const float* inputPtr = src0;
+            const uint32x4_t indexIncrementValues = vdupq_n_u32(4);
+            __VOLK_ATTR_ALIGNED(16)
+            const uint32_t currentIndexes_u[4] = {0, 1, 2, 3};
+            uint32x4_t currentIndexes = vld1q_u32(currentIndexes_u);
+
+            float max = src0[0];
+            uint32_t index = 0;
+            float32x4_t maxValues = vdupq_n_f32(max);
+            uint32x4_t maxValuesIndex = vdupq_n_u32(0);
+            uint32x4_t compareResults;
+            float32x4_t currentValues;
+
+            __VOLK_ATTR_ALIGNED(16)
+            float maxValuesBuffer[4];
+            __VOLK_ATTR_ALIGNED(16)
+            uint32_t maxIndexesBuffer[4];
+
+            // integer indexes, exact for any num_points
+            for (; number < quarterPoints; number++)
+                {
+                    currentValues = vld1q_f32(inputPtr);
+                    inputPtr += 4;
+                    compareResults = vcgtq_f32(currentValues, maxValues);
+                    maxValuesIndex = vbslq_u32(compareResults, currentIndexes, maxValuesIndex);
+                    maxValues = vbslq_f32(compareResults, currentValues, maxValues);
+                    currentIndexes = vaddq_u32(currentIndexes, indexIncrementValues);
+                }
+
+            // Calculate the largest value from the remaining 4 points, the first one of them on ties
+            vst1q_f32(maxValuesBuffer, maxValues);
+            vst1q_u32(maxIndexesBuffer, maxValuesIndex);
+            for (number = 0; number < 4; number++)
+                {
+                    if ((maxValuesBuffer[number] > max) || ((maxValuesBuffer[number] == max) && (maxIndexesBuffer[number] < index)))
+                        {
+                            index = maxIndexesBuffer[number];
+                            max = maxValuesBuffer[number];
+                        }
+                }
+
+            number = quarterPoints * 4;
+            for (; number < num_points; number++)
+                {
+                    if (src0[number] > max)
+                        {
+                            index = number;
+                            max = src0[number];
+                        }
+                }
+            target[0] = index;
+        }
+}
+
+#endif /*LV_HAVE_NEONV8*/
+
 #endif /*INCLUDED_volk_gnsssdr_32f_index_max_32u_H*/
@@ -704,4 +704,86 @@ static inline void volk_gnsssdr_32f_xn_high_dynamics_resampler_32f_xn_u_avx(floa
 //
 //#endif
 
+
+#ifdef LV_HAVE_NEONV8
+#include <arm_neon.h>
+
+static inline void volk_gnsssdr_32f_xn_high_dynamics_resampler_32f_xn_neonv8(float** result, const float* local_code, float rem_code_phase_chips, float code_phase_step_chips, float code_phase_rate_step_chips, float* shifts_chips, unsigned int code_length_chips, int num_out_vectors, unsigned int num_points)
+{
+    float** _result = result;
+    const unsigned int neon_iters = num_points / 4;
+    int current_correlator_tap;
+    unsigned int n;
+    unsigned int k;
+    const float32x4_t fours = vdupq_n_f32(4.0f);
+    const float32x4_t rem_code_phase_chips_reg = vdupq_n_f32(rem_code_phase_chips);
+    const float32x4_t code_phase_step_chips_reg = vdupq_n_f32(code_phase_step_chips);
+    const float32x4_t code_phase_rate_step_chips_reg = vdupq_n_f32(code_phase_rate_step_chips);
+
+    __VOLK_ATTR_ALIGNED(16)
+    int32_t local_code_chip_index[4];
+    int32_t local_code_chip_index_;
+
+    const int32x4_t zeros = vdupq_n_s32(0);
+    const float32x4_t code_length_chips_reg_f = vdupq_n_f32((float)code_length_chips);
+    const int32x4_t code_length_chips_reg_i = vdupq_n_s32((int32_t)code_length_chips);
+    int32x4_t local_code_chip_index_reg, overflows, negatives;
+    float32x4_t aux, aux2, cycles, indexn;
+    __VOLK_ATTR_ALIGNED(16)
+    const float vec[4] = {0.0f, 1.0f, 2.0f, 3.0f};
+
+    //first correlator
+    aux2 = vsubq_f32(vdupq_n_f32((float)shifts_chips[0]), rem_code_phase_chips_reg);
+    indexn = vld1q_f32((float*)vec);
+    for (n = 0; n < neon_iters; n++)
+        {
+            __VOLK_GNSSSDR_PREFETCH_LOCALITY(&_result[0][4 * n + 3], 1, 0);
+            __VOLK_GNSSSDR_PREFETCH(&local_code_chip_index[4]);
+            aux = vmulq_f32(code_phase_step_chips_reg, indexn);
+            aux = vaddq_f32(aux, vmulq_f32(code_phase_rate_step_chips_reg, vmulq_f32(indexn, indexn)));
+            aux = vaddq_f32(aux, aux2);
+            aux = vrndmq_f32(aux);  // floor
+
+            // fmod, also for the negative indexes of the early taps
+            cycles = vrndmq_f32(vdivq_f32(aux, code_length_chips_reg_f));
+            aux = vfmsq_f32(aux, cycles, code_length_chips_reg_f);
+            local_code_chip_index_reg = vcvtq_s32_f32(aux);
+
+            // the quotient of an exact multiple may be rounded to either side
+            overflows = vreinterpretq_s32_u32(vcgeq_s32(local_code_chip_index_reg, code_length_chips_reg_i));
+            negatives = vreinterpretq_s32_u32(vcltq_s32(local_code_chip_index_reg, zeros));
+            local_code_chip_index_reg = vsubq_s32(local_code_chip_index_reg, vandq_s32(code_length_chips_reg_i, overflows));
+            local_code_chip_index_reg = vaddq_s32(local_code_chip_index_reg, vandq_s32(code_length_chips_reg_i, negatives));
+
+            vst1q_s32((int32_t*)local_code_chip_index, local_code_chip_index_reg);
+
+            for (k = 0; k < 4; ++k)
+                {
+                    _result[0][n * 4 + k] = local_code[local_code_chip_index[k]];
+                }
+            indexn = vaddq_f32(indexn, fours);
+        }
+    for (n = neon_iters * 4; n < num_points; n++)
+        {
+            __VOLK_GNSSSDR_PREFETCH_LOCALITY(&_result[0][n], 1, 0);
+            // resample code for first tap
+            local_code_chip_index_ = (int)floor(code_phase_step_chips * (float)n + code_phase_rate_step_chips * (float)(n * n) + shifts_chips[0] - rem_code_phase_chips);
+            // Take into account that in multitap correlators, the shifts can be negative!
+            if (local_code_chip_index_ < 0) local_code_chip_index_ += (int)code_length_chips * (abs(local_code_chip_index_) / code_length_chips + 1);
+            local_code_chip_index_ = local_code_chip_index_ % code_length_chips;
+            _result[0][n] = local_code[local_code_chip_index_];
+        }
+
+    //adjacent correlators
+    unsigned int shift_samples = 0;
+    for (current_correlator_tap = 1; current_correlator_tap < num_out_vectors; current_correlator_tap++)
+        {
+            shift_samples += (int)round((shifts_chips[current_correlator_tap] - shifts_chips[current_correlator_tap - 1]) / code_phase_step_chips);
+            memcpy(&_result[current_correlator_tap][0], &_result[0][shift_samples], (num_points - shift_samples) * sizeof(float));
+            memcpy(&_result[current_correlator_tap][num_points - shift_samples], &_result[0][0], shift_samples * sizeof(float));
+        }
+}
+
+#endif
+
 #endif /*INCLUDED_volk_gnsssdr_32f_xn_high_dynamics_resampler_32f_xn_H*/
@@ -119,4 +119,154 @@ static inline void volk_gnsssdr_32fc_32f_high_dynamic_rotator_dot_prod_32fc_xn_g
 
 #endif /*LV_HAVE_GENERIC*/
 
+
+#ifdef LV_HAVE_NEONV8
+#include <arm_neon.h>
+
+static inline void volk_gnsssdr_32fc_32f_high_dynamic_rotator_dot_prod_32fc_xn_neonv8(lv_32fc_t* result, const lv_32fc_t* in_common, const lv_32fc_t phase_inc, const lv_32fc_t phase_inc_rate, lv_32fc_t* phase, const float** in_a, int num_a_vectors, unsigned int num_points)
+{
+    unsigned int number = 0;
+    int vec_ind = 0;
+    int j;
+    const unsigned int neon_iters = num_points / 4;
+
+    const float* aPtr = (const float*)in_common;
+#ifdef __cplusplus
+    lv_32fc_t half_phase_inc_rate = std::sqrt(phase_inc_rate);
+#else
+    lv_32fc_t half_phase_inc_rate = csqrtf(phase_inc_rate);
+#endif
+    lv_32fc_t constant_rotation = phase_inc * half_phase_inc_rate;
+    lv_32fc_t delta_phase_rate = lv_cmake(1.0f, 0.0f);
+    lv_32fc_t _phase = (*phase);
+    lv_32fc_t tmp32_1, step;
+
+    float32x4x2_t a_val;
+    float32x4_t b_val, tmp_real, tmp_imag, z_real_next, dz_real_next, inv_norm;
+    float32x4_t acc_real[num_a_vectors];
+    float32x4_t acc_imag[num_a_vectors];
+    for (vec_ind = 0; vec_ind < num_a_vectors; vec_ind++)
+        {
+            acc_real[vec_ind] = vdupq_n_f32(0.0f);
+            acc_imag[vec_ind] = vdupq_n_f32(0.0f);
+        }
+
+    // Lane k rotates the samples 4 * number + k. Its phase advances over the
+    // next four samples by dz_k = constant_rotation^4 * phase_inc_rate^(4 * (4 * number + k) + 6),
+    // so that every dz_k advances by phase_inc_rate^16 per iteration
+    __VOLK_ATTR_ALIGNED(16)
+    float phase_real[4];
+    __VOLK_ATTR_ALIGNED(16)
+    float phase_imag[4];
+    __VOLK_ATTR_ALIGNED(16)
+    float dz_real_vec[4];
+    __VOLK_ATTR_ALIGNED(16)
+    float dz_imag_vec[4];
+    _phase /= hypotf(lv_creal(_phase), lv_cimag(_phase));
+    for (vec_ind = 0; vec_ind < 4; ++vec_ind)
+        {
+            phase_real[vec_ind] = lv_creal(_phase);
+            phase_imag[vec_ind] = lv_cimag(_phase);
+            step = lv_cmake(1.0f, 0.0f);
+            tmp32_1 = delta_phase_rate;
+            for (j = 0; j < 4; ++j)
+                {
+                    step *= (constant_rotation * tmp32_1);
+                    tmp32_1 *= phase_inc_rate;
+                }
+            dz_real_vec[vec_ind] = lv_creal(step);
+            dz_imag_vec[vec_ind] = lv_cimag(step);
+            _phase *= (constant_rotation * delta_phase_rate);
+            delta_phase_rate *= phase_inc_rate;
+        }
+    float32x4_t z_real = vld1q_f32(phase_real);
+    float32x4_t z_imag = vld1q_f32(phase_imag);
+    float32x4_t dz_real = vld1q_f32(dz_real_vec);
+    float32x4_t dz_imag = vld1q_f32(dz_imag_vec);
+
+    lv_32fc_t ddz = phase_inc_rate;
+    ddz *= ddz;
+    ddz *= ddz;
+    ddz *= ddz;
+    ddz *= ddz;  // ddz = phase_inc_rate^16;
+    const float32x4_t ddz_real = vdupq_n_f32(lv_creal(ddz));
+    const float32x4_t ddz_imag = vdupq_n_f32(lv_cimag(ddz));
+    lv_32fc_t delta_phase_rate_step = phase_inc_rate;
+    delta_phase_rate_step *= delta_phase_rate_step;
+    delta_phase_rate_step *= delta_phase_rate_step;  // phase_inc_rate^4;
+    delta_phase_rate = lv_cmake(1.0f, 0.0f);
+    const float32x4_t ones = vdupq_n_f32(1.0f);
+
+    for (; number < neon_iters; number++)
+        {
+            a_val = vld2q_f32(aPtr);  // de-interleaves real and imaginary parts
+            __VOLK_GNSSSDR_PREFETCH(aPtr + 8);
+
+            tmp_real = vfmsq_f32(vmulq_f32(a_val.val[0], z_real), a_val.val[1], z_imag);
+            tmp_imag = vfmaq_f32(vmulq_f32(a_val.val[0], z_imag), a_val.val[1], z_real);
+
+            z_real_next = vfmsq_f32(vmulq_f32(z_real, dz_real), z_imag, dz_imag);
+            z_imag = vfmaq_f32(vmulq_f32(z_real, dz_imag), z_imag, dz_real);
+            z_real = z_real_next;
+
+            dz_real_next = vfmsq_f32(vmulq_f32(dz_real, ddz_real), dz_imag, ddz_imag);
+            dz_imag = vfmaq_f32(vmulq_f32(dz_real, ddz_imag), dz_imag, ddz_real);
+            dz_real = dz_real_next;
+
+            // needed by the tail
+            delta_phase_rate *= delta_phase_rate_step;
+
+            for (vec_ind = 0; vec_ind < num_a_vectors; ++vec_ind)
+                {
+                    b_val = vld1q_f32(in_a[vec_ind] + 4 * number);
+                    acc_real[vec_ind] = vfmaq_f32(acc_real[vec_ind], tmp_real, b_val);
+                    acc_imag[vec_ind] = vfmaq_f32(acc_imag[vec_ind], tmp_imag, b_val);
+                }
+
+            // Force the rotators back onto the unit circle
+            if ((number % 64) == 0)
+                {
+                    inv_norm = vdivq_f32(ones, vsqrtq_f32(vfmaq_f32(vmulq_f32(z_real, z_real), z_imag, z_imag)));
+                    z_real = vmulq_f32(z_real, inv_norm);
+                    z_imag = vmulq_f32(z_imag, inv_norm);
+                    inv_norm = vdivq_f32(ones, vsqrtq_f32(vfmaq_f32(vmulq_f32(dz_real, dz_real), dz_imag, dz_imag)));
+                    dz_real = vmulq_f32(dz_real, inv_norm);
+                    dz_imag = vmulq_f32(dz_imag, inv_norm);
+                    delta_phase_rate /= hypotf(lv_creal(delta_phase_rate), lv_cimag(delta_phase_rate));
+                }
+
+            aPtr += 8;
+        }
+
+    for (vec_ind = 0; vec_ind < num_a_vectors; ++vec_ind)
+        {
+            result[vec_ind] = lv_cmake(vaddvq_f32(acc_real[vec_ind]), vaddvq_f32(acc_imag[vec_ind]));
+        }
+
+    if (neon_iters > 0)
+        {
+            _phase = lv_cmake(vgetq_lane_f32(z_real, 0), vgetq_lane_f32(z_imag, 0));
+        }
+    else
+        {
+            _phase = (*phase);
+        }
+    _phase /= hypotf(lv_creal(_phase), lv_cimag(_phase));
+
+    for (number = neon_iters * 4; number < num_points; number++)
+        {
+            tmp32_1 = in_common[number] * _phase;
+            _phase *= (constant_rotation * delta_phase_rate);
+            delta_phase_rate *= phase_inc_rate;
+            for (vec_ind = 0; vec_ind < num_a_vectors; ++vec_ind)
+                {
+                    result[vec_ind] += (tmp32_1 * in_a[vec_ind][number]);
+                }
+        }
+
+    *phase = _phase;
+}
+
+#endif /* LV_HAVE_NEONV8 */
+
 #endif /* INCLUDED_volk_gnsssdr_32fc_32f_high_dynamic_rotator_dot_prod_32fc_xn_H */
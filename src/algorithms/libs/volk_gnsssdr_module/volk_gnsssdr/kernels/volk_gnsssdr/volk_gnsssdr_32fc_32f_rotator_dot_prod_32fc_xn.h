@@ -313,7 +313,7 @@ static inline void volk_gnsssdr_32fc_32f_rotator_dot_prod_32fc_xn_u_avx(lv_32fc_
     number = sixteenthPoints * 16;
     for (; number < num_points; number++)
         {
-            wo = (*aPtr++) * _phase;
+            wo = in_common[number] * _phase;
             _phase *= phase_inc;
 
             for (vec_ind = 0; vec_ind < num_a_vectors; ++vec_ind)
@@ -477,7 +477,7 @@ static inline void volk_gnsssdr_32fc_32f_rotator_dot_prod_32fc_xn_a_avx(lv_32fc_
     number = sixteenthPoints * 16;
     for (; number < num_points; number++)
         {
-            wo = (*aPtr++) * _phase;
+            wo = in_common[number] * _phase;
             _phase *= phase_inc;
 
             for (vec_ind = 0; vec_ind < num_a_vectors; ++vec_ind)
@@ -492,4 +492,718 @@ static inline void volk_gnsssdr_32fc_32f_rotator_dot_prod_32fc_xn_a_avx(lv_32fc_
 
 #endif /* LV_HAVE_AVX */
 
+#if LV_HAVE_AVX2 && LV_HAVE_FMA
+#include <volk_gnsssdr/volk_gnsssdr_avx_intrinsics.h>
+#include <immintrin.h>
+static inline void volk_gnsssdr_32fc_32f_rotator_dot_prod_32fc_xn_u_avx2_fma(lv_32fc_t* result, const lv_32fc_t* in_common, const lv_32fc_t phase_inc, lv_32fc_t* phase, const float** in_a, int num_a_vectors, unsigned int num_points)
+{
+    unsigned int number = 0;
+    int vec_ind = 0;
+    unsigned int i = 0;
+    const unsigned int sixteenthPoints = num_points / 16;
+
+    const float* aPtr = (float*)in_common;
+    const float* bPtr[num_a_vectors];
+    for (vec_ind = 0; vec_ind < num_a_vectors; ++vec_ind)
+        {
+            bPtr[vec_ind] = in_a[vec_ind];
+        }
+
+    lv_32fc_t _phase = (*phase);
+    lv_32fc_t wo;
+
+    __m256 a0Val, a1Val, a2Val, a3Val;
+    __m256 x0Val, x1Val;
+
+    __m256 dotProdVal0[num_a_vectors];
+    __m256 dotProdVal1[num_a_vectors];
+    __m256 dotProdVal2[num_a_vectors];
+    __m256 dotProdVal3[num_a_vectors];
+
+    for (vec_ind = 0; vec_ind < num_a_vectors; vec_ind++)
+        {
+            dotProdVal0[vec_ind] = _mm256_setzero_ps();
+            dotProdVal1[vec_ind] = _mm256_setzero_ps();
+            dotProdVal2[vec_ind] = _mm256_setzero_ps();
+            dotProdVal3[vec_ind] = _mm256_setzero_ps();
+        }
+
+    // Duplicate each real code sample, so it multiplies both the real and imaginary parts
+    const __m256i lo_idx = _mm256_set_epi32(3, 3, 2, 2, 1, 1, 0, 0);
+    const __m256i hi_idx = _mm256_set_epi32(7, 7, 6, 6, 5, 5, 4, 4);
+
+    // Set up the complex rotator
+    __m256 z0, z1, z2, z3;
+    __VOLK_ATTR_ALIGNED(32)
+    lv_32fc_t phase_vec[16];
+    for (vec_ind = 0; vec_ind < 16; ++vec_ind)
+        {
+            phase_vec[vec_ind] = _phase;
+            _phase *= phase_inc;
+        }
+
+    z0 = _mm256_load_ps((float*)phase_vec);
+    z1 = _mm256_load_ps((float*)(phase_vec + 4));
+    z2 = _mm256_load_ps((float*)(phase_vec + 8));
+    z3 = _mm256_load_ps((float*)(phase_vec + 12));
+
+    lv_32fc_t dz = phase_inc;
+    dz *= dz;
+    dz *= dz;
+    dz *= dz;
+    dz *= dz;  // dz = phase_inc^16;
+
+    for (vec_ind = 0; vec_ind < 4; ++vec_ind)
+        {
+            phase_vec[vec_ind] = dz;
+        }
+
+    __m256 dz_reg = _mm256_load_ps((float*)phase_vec);
+    dz_reg = _mm256_complexnormalise_ps(dz_reg);
+
+    for (; number < sixteenthPoints; number++)
+        {
+            a0Val = _mm256_loadu_ps(aPtr);
+            a1Val = _mm256_loadu_ps(aPtr + 8);
+            a2Val = _mm256_loadu_ps(aPtr + 16);
+            a3Val = _mm256_loadu_ps(aPtr + 24);
+
+            a0Val = _mm256_complexmul_fma_ps(a0Val, z0);
+            a1Val = _mm256_complexmul_fma_ps(a1Val, z1);
+            a2Val = _mm256_complexmul_fma_ps(a2Val, z2);
+            a3Val = _mm256_complexmul_fma_ps(a3Val, z3);
+
+            z0 = _mm256_complexmul_fma_ps(z0, dz_reg);
+            z1 = _mm256_complexmul_fma_ps(z1, dz_reg);
+            z2 = _mm256_complexmul_fma_ps(z2, dz_reg);
+            z3 = _mm256_complexmul_fma_ps(z3, dz_reg);
+
+            for (vec_ind = 0; vec_ind < num_a_vectors; ++vec_ind)
+                {
+                    x0Val = _mm256_loadu_ps(bPtr[vec_ind]);  // t0|t1|t2|t3|t4|t5|t6|t7
+                    x1Val = _mm256_loadu_ps(bPtr[vec_ind] + 8);
+
+                    // t0|t0|t1|t1|t2|t2|t3|t3 and t4|t4|t5|t5|t6|t6|t7|t7, multiplied and accumulated
+                    dotProdVal0[vec_ind] = _mm256_fmadd_ps(a0Val, _mm256_permutevar8x32_ps(x0Val, lo_idx), dotProdVal0[vec_ind]);
+                    dotProdVal1[vec_ind] = _mm256_fmadd_ps(a1Val, _mm256_permutevar8x32_ps(x0Val, hi_idx), dotProdVal1[vec_ind]);
+                    dotProdVal2[vec_ind] = _mm256_fmadd_ps(a2Val, _mm256_permutevar8x32_ps(x1Val, lo_idx), dotProdVal2[vec_ind]);
+                    dotProdVal3[vec_ind] = _mm256_fmadd_ps(a3Val, _mm256_permutevar8x32_ps(x1Val, hi_idx), dotProdVal3[vec_ind]);
+
+                    bPtr[vec_ind] += 16;
+                }
+
+            // Force the rotators back onto the unit circle
+            if ((number % 64) == 0)
+                {
+                    z0 = _mm256_complexnormalise_ps(z0);
+                    z1 = _mm256_complexnormalise_ps(z1);
+                    z2 = _mm256_complexnormalise_ps(z2);
+                    z3 = _mm256_complexnormalise_ps(z3);
+                }
+
+            aPtr += 32;
+        }
+    __VOLK_ATTR_ALIGNED(32)
+    lv_32fc_t dotProductVector[4];
+
+    for (vec_ind = 0; vec_ind < num_a_vectors; ++vec_ind)
+        {
+            dotProdVal0[vec_ind] = _mm256_add_ps(dotProdVal0[vec_ind], dotProdVal1[vec_ind]);
+            dotProdVal0[vec_ind] = _mm256_add_ps(dotProdVal0[vec_ind], dotProdVal2[vec_ind]);
+            dotProdVal0[vec_ind] = _mm256_add_ps(dotProdVal0[vec_ind], dotProdVal3[vec_ind]);
+
+            _mm256_store_ps((float*)dotProductVector, dotProdVal0[vec_ind]);  // Store the results back into the dot product vector
+
+            result[vec_ind] = lv_cmake(0, 0);
+            for (i = 0; i < 4; ++i)
+                {
+                    result[vec_ind] += dotProductVector[i];
+                }
+        }
+
+    z0 = _mm256_complexnormalise_ps(z0);
+    _mm256_store_ps((float*)phase_vec, z0);
+    _phase = phase_vec[0];
+    _mm256_zeroupper();
+
+    number = sixteenthPoints * 16;
+    for (; number < num_points; number++)
+        {
+            wo = in_common[number] * _phase;
+            _phase *= phase_inc;
+
+            for (vec_ind = 0; vec_ind < num_a_vectors; ++vec_ind)
+                {
+                    result[vec_ind] += wo * in_a[vec_ind][number];
+                }
+        }
+
+    *phase = _phase;
+}
+
+#endif /* LV_HAVE_AVX2 && LV_HAVE_FMA */
+
+
+#if LV_HAVE_AVX2 && LV_HAVE_FMA
+#include <volk_gnsssdr/volk_gnsssdr_avx_intrinsics.h>
+#include <immintrin.h>
+static inline void volk_gnsssdr_32fc_32f_rotator_dot_prod_32fc_xn_a_avx2_fma(lv_32fc_t* result, const lv_32fc_t* in_common, const lv_32fc_t phase_inc, lv_32fc_t* phase, const float** in_a, int num_a_vectors, unsigned int num_points)
+{
+    unsigned int number = 0;
+    int vec_ind = 0;
+    unsigned int i = 0;
+    const unsigned int sixteenthPoints = num_points / 16;
+
+    const float* aPtr = (float*)in_common;
+    const float* bPtr[num_a_vectors];
+    for (vec_ind = 0; vec_ind < num_a_vectors; ++vec_ind)
+        {
+            bPtr[vec_ind] = in_a[vec_ind];
+        }
+
+    lv_32fc_t _phase = (*phase);
+    lv_32fc_t wo;
+
+    __m256 a0Val, a1Val, a2Val, a3Val;
+    __m256 x0Val, x1Val;
+
+    __m256 dotProdVal0[num_a_vectors];
+    __m256 dotProdVal1[num_a_vectors];
+    __m256 dotProdVal2[num_a_vectors];
+    __m256 dotProdVal3[num_a_vectors];
+
+    for (vec_ind = 0; vec_ind < num_a_vectors; vec_ind++)
+        {
+            dotProdVal0[vec_ind] = _mm256_setzero_ps();
+            dotProdVal1[vec_ind] = _mm256_setzero_ps();
+            dotProdVal2[vec_ind] = _mm256_setzero_ps();
+            dotProdVal3[vec_ind] = _mm256_setzero_ps();
+        }
+
+    // Duplicate each real code sample, so it multiplies both the real and imaginary parts
+    const __m256i lo_idx = _mm256_set_epi32(3, 3, 2, 2, 1, 1, 0, 0);
+    const __m256i hi_idx = _mm256_set_epi32(7, 7, 6, 6, 5, 5, 4, 4);
+
+    // Set up the complex rotator
+    __m256 z0, z1, z2, z3;
+    __VOLK_ATTR_ALIGNED(32)
+    lv_32fc_t phase_vec[16];
+    for (vec_ind = 0; vec_ind < 16; ++vec_ind)
+        {
+            phase_vec[vec_ind] = _phase;
+            _phase *= phase_inc;
+        }
+
+    z0 = _mm256_load_ps((float*)phase_vec);
+    z1 = _mm256_load_ps((float*)(phase_vec + 4));
+    z2 = _mm256_load_ps((float*)(phase_vec + 8));
+    z3 = _mm256_load_ps((float*)(phase_vec + 12));
+
+    lv_32fc_t dz = phase_inc;
+    dz *= dz;
+    dz *= dz;
+    dz *= dz;
+    dz *= dz;  // dz = phase_inc^16;
+
+    for (vec_ind = 0; vec_ind < 4; ++vec_ind)
+        {
+            phase_vec[vec_ind] = dz;
+        }
+
+    __m256 dz_reg = _mm256_load_ps((float*)phase_vec);
+    dz_reg = _mm256_complexnormalise_ps(dz_reg);
+
+    for (; number < sixteenthPoints; number++)
+        {
+            a0Val = _mm256_load_ps(aPtr);
+            a1Val = _mm256_load_ps(aPtr + 8);
+            a2Val = _mm256_load_ps(aPtr + 16);
+            a3Val = _mm256_load_ps(aPtr + 24);
+
+            a0Val = _mm256_complexmul_fma_ps(a0Val, z0);
+            a1Val = _mm256_complexmul_fma_ps(a1Val, z1);
+            a2Val = _mm256_complexmul_fma_ps(a2Val, z2);
+            a3Val = _mm256_complexmul_fma_ps(a3Val, z3);
+
+            z0 = _mm256_complexmul_fma_ps(z0, dz_reg);
+            z1 = _mm256_complexmul_fma_ps(z1, dz_reg);
+            z2 = _mm256_complexmul_fma_ps(z2, dz_reg);
+            z3 = _mm256_complexmul_fma_ps(z3, dz_reg);
+
+            for (vec_ind = 0; vec_ind < num_a_vectors; ++vec_ind)
+                {
+                    x0Val = _mm256_loadu_ps(bPtr[vec_ind]);  // t0|t1|t2|t3|t4|t5|t6|t7
+                    x1Val = _mm256_loadu_ps(bPtr[vec_ind] + 8);
+
+                    // t0|t0|t1|t1|t2|t2|t3|t3 and t4|t4|t5|t5|t6|t6|t7|t7, multiplied and accumulated
+                    dotProdVal0[vec_ind] = _mm256_fmadd_ps(a0Val, _mm256_permutevar8x32_ps(x0Val, lo_idx), dotProdVal0[vec_ind]);
+                    dotProdVal1[vec_ind] = _mm256_fmadd_ps(a1Val, _mm256_permutevar8x32_ps(x0Val, hi_idx), dotProdVal1[vec_ind]);
+                    dotProdVal2[vec_ind] = _mm256_fmadd_ps(a2Val, _mm256_permutevar8x32_ps(x1Val, lo_idx), dotProdVal2[vec_ind]);
+                    dotProdVal3[vec_ind] = _mm256_fmadd_ps(a3Val, _mm256_permutevar8x32_ps(x1Val, hi_idx), dotProdVal3[vec_ind]);
+
+                    bPtr[vec_ind] += 16;
+                }
+
+            // Force the rotators back onto the unit circle
+            if ((number % 64) == 0)
+                {
+                    z0 = _mm256_complexnormalise_ps(z0);
+                    z1 = _mm256_complexnormalise_ps(z1);
+                    z2 = _mm256_complexnormalise_ps(z2);
+                    z3 = _mm256_complexnormalise_ps(z3);
+                }
+
+            aPtr += 32;
+        }
+    __VOLK_ATTR_ALIGNED(32)
+    lv_32fc_t dotProductVector[4];
+
+    for (vec_ind = 0; vec_ind < num_a_vectors; ++vec_ind)
+        {
+            dotProdVal0[vec_ind] = _mm256_add_ps(dotProdVal0[vec_ind], dotProdVal1[vec_ind]);
+            dotProdVal0[vec_ind] = _mm256_add_ps(dotProdVal0[vec_ind], dotProdVal2[vec_ind]);
+            dotProdVal0[vec_ind] = _mm256_add_ps(dotProdVal0[vec_ind], dotProdVal3[vec_ind]);
+
+            _mm256_store_ps((float*)dotProductVector, dotProdVal0[vec_ind]);  // Store the results back into the dot product vector
+
+            result[vec_ind] = lv_cmake(0, 0);
+            for (i = 0; i < 4; ++i)
+                {
+                    result[vec_ind] += dotProductVector[i];
+                }
+        }
+
+    z0 = _mm256_complexnormalise_ps(z0);
+    _mm256_store_ps((float*)phase_vec, z0);
+    _phase = phase_vec[0];
+    _mm256_zeroupper();
+
+    number = sixteenthPoints * 16;
+    for (; number < num_points; number++)
+        {
+            wo = in_common[number] * _phase;
+            _phase *= phase_inc;
+
+            for (vec_ind = 0; vec_ind < num_a_vectors; ++vec_ind)
+                {
+                    result[vec_ind] += wo * in_a[vec_ind][number];
+                }
+        }
+
+    *phase = _phase;
+}
+
+#endif /* LV_HAVE_AVX2 && LV_HAVE_FMA */
+
+
+#ifdef LV_HAVE_AVX512F
+#include <volk_gnsssdr/volk_gnsssdr_avx512_intrinsics.h>
+#include <immintrin.h>
+static inline void volk_gnsssdr_32fc_32f_rotator_dot_prod_32fc_xn_u_avx512f(lv_32fc_t* result, const lv_32fc_t* in_common, const lv_32fc_t phase_inc, lv_32fc_t* phase, const float** in_a, int num_a_vectors, unsigned int num_points)
+{
+    unsigned int number = 0;
+    int vec_ind = 0;
+    unsigned int i = 0;
+    const unsigned int thirtysecondPoints = num_points / 32;
+
+    const float* aPtr = (float*)in_common;
+    const float* bPtr[num_a_vectors];
+    for (vec_ind = 0; vec_ind < num_a_vectors; ++vec_ind)
+        {
+            bPtr[vec_ind] = in_a[vec_ind];
+        }
+
+    lv_32fc_t _phase = (*phase);
+    lv_32fc_t wo;
+
+    __m512 a0Val, a1Val, a2Val, a3Val;
+    __m512 x0Val, x1Val;
+
+    __m512 dotProdVal0[num_a_vectors];
+    __m512 dotProdVal1[num_a_vectors];
+    __m512 dotProdVal2[num_a_vectors];
+    __m512 dotProdVal3[num_a_vectors];
+
+    for (vec_ind = 0; vec_ind < num_a_vectors; vec_ind++)
+        {
+            dotProdVal0[vec_ind] = _mm512_setzero_ps();
+            dotProdVal1[vec_ind] = _mm512_setzero_ps();
+            dotProdVal2[vec_ind] = _mm512_setzero_ps();
+            dotProdVal3[vec_ind] = _mm512_setzero_ps();
+        }
+
+    // Duplicate each real code sample, so it multiplies both the real and imaginary parts
+    const __m512i lo_idx = _mm512_set_epi32(7, 7, 6, 6, 5, 5, 4, 4, 3, 3, 2, 2, 1, 1, 0, 0);
+    const __m512i hi_idx = _mm512_set_epi32(15, 15, 14, 14, 13, 13, 12, 12, 11, 11, 10, 10, 9, 9, 8, 8);
+
+    // Set up the complex rotator
+    __m512 z0, z1, z2, z3;
+    __VOLK_ATTR_ALIGNED(64)
+    lv_32fc_t phase_vec[32];
+    for (vec_ind = 0; vec_ind < 32; ++vec_ind)
+        {
+            phase_vec[vec_ind] = _phase;
+            _phase *= phase_inc;
+        }
+
+    z0 = _mm512_load_ps((float*)phase_vec);
+    z1 = _mm512_load_ps((float*)(phase_vec + 8));
+    z2 = _mm512_load_ps((float*)(phase_vec + 16));
+    z3 = _mm512_load_ps((float*)(phase_vec + 24));
+
+    lv_32fc_t dz = phase_inc;
+    dz *= dz;
+    dz *= dz;
+    dz *= dz;
+    dz *= dz;
+    dz *= dz;  // dz = phase_inc^32;
+
+    for (vec_ind = 0; vec_ind < 8; ++vec_ind)
+        {
+            phase_vec[vec_ind] = dz;
+        }
+
+    __m512 dz_reg = _mm512_load_ps((float*)phase_vec);
+    dz_reg = _mm512_complexnormalise_ps(dz_reg);
+
+    for (; number < thirtysecondPoints; number++)
+        {
+            a0Val = _mm512_loadu_ps(aPtr);
+            a1Val = _mm512_loadu_ps(aPtr + 16);
+            a2Val = _mm512_loadu_ps(aPtr + 32);
+            a3Val = _mm512_loadu_ps(aPtr + 48);
+
+            a0Val = _mm512_complexmul_ps(a0Val, z0);
+            a1Val = _mm512_complexmul_ps(a1Val, z1);
+            a2Val = _mm512_complexmul_ps(a2Val, z2);
+            a3Val = _mm512_complexmul_ps(a3Val, z3);
+
+            z0 = _mm512_complexmul_ps(z0, dz_reg);
+            z1 = _mm512_complexmul_ps(z1, dz_reg);
+            z2 = _mm512_complexmul_ps(z2, dz_reg);
+            z3 = _mm512_complexmul_ps(z3, dz_reg);
+
+            for (vec_ind = 0; vec_ind < num_a_vectors; ++vec_ind)
+                {
+                    x0Val = _mm512_loadu_ps(bPtr[vec_ind]);  // t0|t1|...|t15
+                    x1Val = _mm512_loadu_ps(bPtr[vec_ind] + 16);
+
+                    // t0|t0|...|t7|t7 and t8|t8|...|t15|t15, multiplied and accumulated
+                    dotProdVal0[vec_ind] = _mm512_fmadd_ps(a0Val, _mm512_permutexvar_ps(lo_idx, x0Val), dotProdVal0[vec_ind]);
+                    dotProdVal1[vec_ind] = _mm512_fmadd_ps(a1Val, _mm512_permutexvar_ps(hi_idx, x0Val), dotProdVal1[vec_ind]);
+                    dotProdVal2[vec_ind] = _mm512_fmadd_ps(a2Val, _mm512_permutexvar_ps(lo_idx, x1Val), dotProdVal2[vec_ind]);
+                    dotProdVal3[vec_ind] = _mm512_fmadd_ps(a3Val, _mm512_permutexvar_ps(hi_idx, x1Val), dotProdVal3[vec_ind]);
+
+                    bPtr[vec_ind] += 32;
+                }
+
+            // Force the rotators back onto the unit circle
+            if ((number % 32) == 0)
+                {
+                    z0 = _mm512_complexnormalise_ps(z0);
+                    z1 = _mm512_complexnormalise_ps(z1);
+                    z2 = _mm512_complexnormalise_ps(z2);
+                    z3 = _mm512_complexnormalise_ps(z3);
+                }
+
+            aPtr += 64;
+        }
+    __VOLK_ATTR_ALIGNED(64)
+    lv_32fc_t dotProductVector[8];
+
+    for (vec_ind = 0; vec_ind < num_a_vectors; ++vec_ind)
+        {
+            dotProdVal0[vec_ind] = _mm512_add_ps(dotProdVal0[vec_ind], dotProdVal1[vec_ind]);
+            dotProdVal0[vec_ind] = _mm512_add_ps(dotProdVal0[vec_ind], dotProdVal2[vec_ind]);
+            dotProdVal0[vec_ind] = _mm512_add_ps(dotProdVal0[vec_ind], dotProdVal3[vec_ind]);
+
+            _mm512_store_ps((float*)dotProductVector, dotProdVal0[vec_ind]);  // Store the results back into the dot product vector
+
+            result[vec_ind] = lv_cmake(0, 0);
+            for (i = 0; i < 8; ++i)
+                {
+                    result[vec_ind] += dotProductVector[i];
+                }
+        }
+
+    z0 = _mm512_complexnormalise_ps(z0);
+    _mm512_store_ps((float*)phase_vec, z0);
+    _phase = phase_vec[0];
+
+    number = thirtysecondPoints * 32;
+    for (; number < num_points; number++)
+        {
+            wo = in_common[number] * _phase;
+            _phase *= phase_inc;
+
+            for (vec_ind = 0; vec_ind < num_a_vectors; ++vec_ind)
+                {
+                    result[vec_ind] += wo * in_a[vec_ind][number];
+                }
+        }
+
+    *phase = _phase;
+}
+
+#endif /* LV_HAVE_AVX512F */
+
+
+#ifdef LV_HAVE_AVX512F
+#include <volk_gnsssdr/volk_gnsssdr_avx512_intrinsics.h>
+#include <immintrin.h>
+static inline void volk_gnsssdr_32fc_32f_rotator_dot_prod_32fc_xn_a_avx512f(lv_32fc_t* result, const lv_32fc_t* in_common, const lv_32fc_t phase_inc, lv_32fc_t* phase, const float** in_a, int num_a_vectors, unsigned int num_points)
+{
+    unsigned int number = 0;
+    int vec_ind = 0;
+    unsigned int i = 0;
+    const unsigned int thirtysecondPoints = num_points / 32;
+
+    const float* aPtr = (float*)in_common;
+    const float* bPtr[num_a_vectors];
+    for (vec_ind = 0; vec_ind < num_a_vectors; ++vec_ind)
+        {
+            bPtr[vec_ind] = in_a[vec_ind];
+        }
+
+    lv_32fc_t _phase = (*phase);
+    lv_32fc_t wo;
+
+    __m512 a0Val, a1Val, a2Val, a3Val;
+    __m512 x0Val, x1Val;
+
+    __m512 dotProdVal0[num_a_vectors];
+    __m512 dotProdVal1[num_a_vectors];
+    __m512 dotProdVal2[num_a_vectors];
+    __m512 dotProdVal3[num_a_vectors];
+
+    for (vec_ind = 0; vec_ind < num_a_vectors; vec_ind++)
+        {
+            dotProdVal0[vec_ind] = _mm512_setzero_ps();
+            dotProdVal1[vec_ind] = _mm512_setzero_ps();
+            dotProdVal2[vec_ind] = _mm512_setzero_ps();
+            dotProdVal3[vec_ind] = _mm512_setzero_ps();
+        }
+
+    // Duplicate each real code sample, so it multiplies both the real and imaginary parts
+    const __m512i lo_idx = _mm512_set_epi32(7, 7, 6, 6, 5, 5, 4, 4, 3, 3, 2, 2, 1, 1, 0, 0);
+    const __m512i hi_idx = _mm512_set_epi32(15, 15, 14, 14, 13, 13, 12, 12, 11, 11, 10, 10, 9, 9, 8, 8);
+
+    // Set up the complex rotator
+    __m512 z0, z1, z2, z3;
+    __VOLK_ATTR_ALIGNED(64)
+    lv_32fc_t phase_vec[32];
+    for (vec_ind = 0; vec_ind < 32; ++vec_ind)
+        {
+            phase_vec[vec_ind] = _phase;
+            _phase *= phase_inc;
+        }
+
+    z0 = _mm512_load_ps((float*)phase_vec);
+    z1 = _mm512_load_ps((float*)(phase_vec + 8));
+    z2 = _mm512_load_ps((float*)(phase_vec + 16));
+    z3 = _mm512_load_ps((float*)(phase_vec + 24));
+
+    lv_32fc_t dz = phase_inc;
+    dz *= dz;
+    dz *= dz;
+    dz *= dz;
+    dz *= dz;
+    dz *= dz;  // dz = phase_inc^32;
+
+    for (vec_ind = 0; vec_ind < 8; ++vec_ind)
+        {
+            phase_vec[vec_ind] = dz;
+        }
+
+    __m512 dz_reg = _mm512_load_ps((float*)phase_vec);
+    dz_reg = _mm512_complexnormalise_ps(dz_reg);
+
+    for (; number < thirtysecondPoints; number++)
+        {
+            a0Val = _mm512_load_ps(aPtr);
+            a1Val = _mm512_load_ps(aPtr + 16);
+            a2Val = _mm512_load_ps(aPtr + 32);
+            a3Val = _mm512_load_ps(aPtr + 48);
+
+            a0Val = _mm512_complexmul_ps(a0Val, z0);
+            a1Val = _mm512_complexmul_ps(a1Val, z1);
+            a2Val = _mm512_complexmul_ps(a2Val, z2);
+            a3Val = _mm512_complexmul_ps(a3Val, z3);
+
+            z0 = _mm512_complexmul_ps(z0, dz_reg);
+            z1 = _mm512_complexmul_ps(z1, dz_reg);
+            z2 = _mm512_complexmul_ps(z2, dz_reg);
+            z3 = _mm512_complexmul_ps(z3, dz_reg);
+
+            for (vec_ind = 0; vec_ind < num_a_vectors; ++vec_ind)
+                {
+                    x0Val = _mm512_loadu_ps(bPtr[vec_ind]);  // t0|t1|...|t15
+                    x1Val = _mm512_loadu_ps(bPtr[vec_ind] + 16);
+
+                    // t0|t0|...|t7|t7 and t8|t8|...|t15|t15, multiplied and accumulated
+                    dotProdVal0[vec_ind] = _mm512_fmadd_ps(a0Val, _mm512_permutexvar_ps(lo_idx, x0Val), dotProdVal0[vec_ind]);
+                    dotProdVal1[vec_ind] = _mm512_fmadd_ps(a1Val, _mm512_permutexvar_ps(hi_idx, x0Val), dotProdVal1[vec_ind]);
+                    dotProdVal2[vec_ind] = _mm512_fmadd_ps(a2Val, _mm512_permutexvar_ps(lo_idx, x1Val), dotProdVal2[vec_ind]);
+                    dotProdVal3[vec_ind] = _mm512_fmadd_ps(a3Val, _mm512_permutexvar_ps(hi_idx, x1Val), dotProdVal3[vec_ind]);
+
+                    bPtr[vec_ind] += 32;
+                }
+
+            // Force the rotators back onto the unit circle
+            if ((number % 32) == 0)
+                {
+                    z0 = _mm512_complexnormalise_ps(z0);
+                    z1 = _mm512_complexnormalise_ps(z1);
+                    z2 = _mm512_complexnormalise_ps(z2);
+                    z3 = _mm512_complexnormalise_ps(z3);
+                }
+
+            aPtr += 64;
+        }
+    __VOLK_ATTR_ALIGNED(64)
+    lv_32fc_t dotProductVector[8];
+
+    for (vec_ind = 0; vec_ind < num_a_vectors; ++vec_ind)
+        {
+            dotProdVal0[vec_ind] = _mm512_add_ps(dotProdVal0[vec_ind], dotProdVal1[vec_ind]);
+            dotProdVal0[vec_ind] = _mm512_add_ps(dotProdVal0[vec_ind], dotProdVal2[vec_ind]);
+            dotProdVal0[vec_ind] = _mm512_add_ps(dotProdVal0[vec_ind], dotProdVal3[vec_ind]);
+
+            _mm512_store_ps((float*)dotProductVector, dotProdVal0[vec_ind]);  // Store the results back into the dot product vector
+
+            result[vec_ind] = lv_cmake(0, 0);
+            for (i = 0; i < 8; ++i)
+                {
+                    result[vec_ind] += dotProductVector[i];
+                }
+        }
+
+    z0 = _mm512_complexnormalise_ps(z0);
+    _mm512_store_ps((float*)phase_vec, z0);
+    _phase = phase_vec[0];
+
+    number = thirtysecondPoints * 32;
+    for (; number < num_points; number++)
+        {
+            wo = in_common[number] * _phase;
+            _phase *= phase_inc;
+
+            for (vec_ind = 0; vec_ind < num_a_vectors; ++vec_ind)
+                {
+                    result[vec_ind] += wo * in_a[vec_ind][number];
+                }
+        }
+
+    *phase = _phase;
+}
+
+#endif /* LV_HAVE_AVX512F */
+
+
+#ifdef LV_HAVE_NEONV8
+#include <arm_neon.h>
+
+static inline void volk_gnsssdr_32fc_32f_rotator_dot_prod_32fc_xn_neonv8(lv_32fc_t* result, const lv_32fc_t* in_common, const lv_32fc_t phase_inc, lv_32fc_t* phase, const float** in_a, int num_a_vectors, unsigned int num_points)
+{
+    unsigned int number = 0;
+    int vec_ind = 0;
+    const unsigned int neon_iters = num_points / 4;
+
+    const float* aPtr = (const float*)in_common;
+    lv_32fc_t _phase = (*phase);
+    lv_32fc_t wo;
+
+    float32x4x2_t a_val;
+    float32x4_t b_val, tmp_real, tmp_imag, z_real_next, inv_norm;
+    float32x4_t acc_real[num_a_vectors];
+    float32x4_t acc_imag[num_a_vectors];
+    for (vec_ind = 0; vec_ind < num_a_vectors; vec_ind++)
+        {
+            acc_real[vec_ind] = vdupq_n_f32(0.0f);
+            acc_imag[vec_ind] = vdupq_n_f32(0.0f);
+        }
+
+    // Set up the complex rotator, with the real and imaginary parts in separate registers
+    __VOLK_ATTR_ALIGNED(16)
+    float phase_real[4];
+    __VOLK_ATTR_ALIGNED(16)
+    float phase_imag[4];
+    for (vec_ind = 0; vec_ind < 4; ++vec_ind)
+        {
+            phase_real[vec_ind] = lv_creal(_phase);
+            phase_imag[vec_ind] = lv_cimag(_phase);
+            _phase *= phase_inc;
+        }
+    float32x4_t z_real = vld1q_f32(phase_real);
+    float32x4_t z_imag = vld1q_f32(phase_imag);
+
+    lv_32fc_t dz = phase_inc;
+    dz *= dz;
+    dz *= dz;  // dz = phase_inc^4;
+    dz /= hypotf(lv_creal(dz), lv_cimag(dz));
+    const float32x4_t dz_real = vdupq_n_f32(lv_creal(dz));
+    const float32x4_t dz_imag = vdupq_n_f32(lv_cimag(dz));
+    const float32x4_t ones = vdupq_n_f32(1.0f);
+
+    for (; number < neon_iters; number++)
+        {
+            a_val = vld2q_f32(aPtr);  // de-interleaves real and imaginary parts
+            __VOLK_GNSSSDR_PREFETCH(aPtr + 8);
+
+            tmp_real = vfmsq_f32(vmulq_f32(a_val.val[0], z_real), a_val.val[1], z_imag);
+            tmp_imag = vfmaq_f32(vmulq_f32(a_val.val[0], z_imag), a_val.val[1], z_real);
+
+            z_real_next = vfmsq_f32(vmulq_f32(z_real, dz_real), z_imag, dz_imag);
+            z_imag = vfmaq_f32(vmulq_f32(z_real, dz_imag), z_imag, dz_real);
+            z_real = z_real_next;
+
+            for (vec_ind = 0; vec_ind < num_a_vectors; ++vec_ind)
+                {
+                    b_val = vld1q_f32(in_a[vec_ind] + 4 * number);
+                    acc_real[vec_ind] = vfmaq_f32(acc_real[vec_ind], tmp_real, b_val);
+                    acc_imag[vec_ind] = vfmaq_f32(acc_imag[vec_ind], tmp_imag, b_val);
+                }
+
+            // Force the rotators back onto the unit circle
+            if ((number % 64) == 0)
+                {
+                    inv_norm = vdivq_f32(ones, vsqrtq_f32(vfmaq_f32(vmulq_f32(z_real, z_real), z_imag, z_imag)));
+                    z_real = vmulq_f32(z_real, inv_norm);
+                    z_imag = vmulq_f32(z_imag, inv_norm);
+                }
+
+            aPtr += 8;
+        }
+
+    for (vec_ind = 0; vec_ind < num_a_vectors; ++vec_ind)
+        {
+            result[vec_ind] = lv_cmake(vaddvq_f32(acc_real[vec_ind]), vaddvq_f32(acc_imag[vec_ind]));
+        }
+
+    if (neon_iters > 0)
+        {
+            _phase = lv_cmake(vgetq_lane_f32(z_real, 0), vgetq_lane_f32(z_imag, 0));
+            _phase /= hypotf(lv_creal(_phase), lv_cimag(_phase));
+        }
+    else
+        {
+            _phase = (*phase);
+        }
+
+    for (number = neon_iters * 4; number < num_points; number++)
+        {
+            wo = in_common[number] * _phase;
+            _phase *= phase_inc;
+
+            for (vec_ind = 0; vec_ind < num_a_vectors; ++vec_ind)
+                {
+                    result[vec_ind] += wo * in_a[vec_ind][number];
+                }
+        }
+
+    *phase = _phase;
+}
+
+#endif /* LV_HAVE_NEONV8 */
+
 #endif /* INCLUDED_volk_gnsssdr_32fc_32f_rotator_dot_prod_32fc_xn_H */
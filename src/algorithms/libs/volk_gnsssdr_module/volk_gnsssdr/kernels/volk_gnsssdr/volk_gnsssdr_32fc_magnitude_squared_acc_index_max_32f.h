@@ -0,0 +1,496 @@
+/*!
+ * \file volk_gnsssdr_32fc_magnitude_squared_acc_index_max_32f.h
+ * \brief VOLK_GNSSSDR kernel: computes the squared magnitude of a complex vector, optionally accumulates it, and finds the index of the maximum in the same pass.
+ *
+ *
+ * -------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2018  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *          Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------
+ */
+
+
+/*!
+ * \page volk_gnsssdr_32fc_magnitude_squared_acc_index_max_32f
+ *
+ * \b Overview
+ *
+ * Computes the squared magnitude of the complex vector \p in, stores it in
+ * (or, if \p accumulate is not zero, adds it to) \p accumulator, and returns
+ * the index of the maximum value of the resulting \p accumulator. This is
+ * the same as calling volk_32fc_magnitude_squared_32f, volk_32f_x2_add_32f
+ * and volk_gnsssdr_32f_index_max_32u, but reading the data only once.
+ *
+ * <b>Dispatcher Prototype</b>
+ * \code
+ * void volk_gnsssdr_32fc_magnitude_squared_acc_index_max_32f(float* accumulator, uint32_t* index, const lv_32fc_t* in, int accumulate, unsigned int num_points)
+ * \endcode
+ *
+ * \b Inputs
+ * \li accumulator: Previous values, only read if \p accumulate is not zero.
+ * \li in: The vector of complex input values.
+ * \li accumulate: If zero, the previous content of \p accumulator is overwritten.
+ * \li num_points: The number of data points.
+ *
+ * \b Outputs
+ * \li accumulator: The (accumulated) squared magnitudes.
+ * \li index: The index of the maximum value in \p accumulator.
+ *
+ */
+
+#ifndef INCLUDED_volk_gnsssdr_32fc_magnitude_squared_acc_index_max_32f_H
+#define INCLUDED_volk_gnsssdr_32fc_magnitude_squared_acc_index_max_32f_H
+
+#include <volk_gnsssdr/volk_gnsssdr_common.h>
+#include <volk_gnsssdr/volk_gnsssdr_complex.h>
+#include <inttypes.h>
+
+
+#ifdef LV_HAVE_GENERIC
+
+static inline void volk_gnsssdr_32fc_magnitude_squared_acc_index_max_32f_generic(float* accumulator, uint32_t* index, const lv_32fc_t* in, int accumulate, unsigned int num_points)
+{
+    const float* inPtr = (const float*)in;
+    float max = -1.0f;
+    uint32_t max_index = 0;
+    unsigned int number;
+    float value;
+
+    for (number = 0; number < num_points; number++)
+        {
+            value = inPtr[0] * inPtr[0] + inPtr[1] * inPtr[1];
+            inPtr += 2;
+            if (accumulate)
+                {
+                    value += accumulator[number];
+                }
+            accumulator[number] = value;
+            if (value > max)
+                {
+                    max = value;
+                    max_index = number;
+                }
+        }
+    index[0] = max_index;
+}
+
+#endif /* LV_HAVE_GENERIC */
+
+
+#ifdef LV_HAVE_SSE3
+#include <pmmintrin.h>
+
+static inline void volk_gnsssdr_32fc_magnitude_squared_acc_index_max_32f_a_sse3(float* accumulator, uint32_t* index, const lv_32fc_t* in, int accumulate, unsigned int num_points)
+{
+    const unsigned int vec_points = num_points / 4;
+    const float* inPtr = (const float*)in;
+    float* accPtr = accumulator;
+    unsigned int number;
+    float max = -1.0f;
+    float max_index = 0.0f;
+    float value;
+
+    __m128 z1, z2, values, compareResults;
+    __m128 indexIncrementValues = _mm_set1_ps(4);
+    __m128 currentIndexes = _mm_set_ps(-1, -2, -3, -4);
+    __m128 maxValues = _mm_set1_ps(-1.0f);
+    __m128 maxValuesIndex = _mm_setzero_ps();
+
+    __VOLK_ATTR_ALIGNED(16)
+    float maxValuesBuffer[4];
+    __VOLK_ATTR_ALIGNED(16)
+    float maxIndexesBuffer[4];
+
+    for (number = 0; number < vec_points; number++)
+        {
+            z1 = _mm_load_ps(inPtr);
+            z2 = _mm_load_ps(inPtr + 4);
+            inPtr += 8;
+            z1 = _mm_mul_ps(z1, z1);
+            z2 = _mm_mul_ps(z2, z2);
+            values = _mm_hadd_ps(z1, z2);  // Re^2 + Im^2
+            if (accumulate)
+                {
+                    values = _mm_add_ps(values, _mm_load_ps(accPtr));
+                }
+            _mm_store_ps(accPtr, values);
+            accPtr += 4;
+
+            currentIndexes = _mm_add_ps(currentIndexes, indexIncrementValues);
+            compareResults = _mm_cmpgt_ps(values, maxValues);
+            maxValuesIndex = _mm_or_ps(_mm_and_ps(compareResults, currentIndexes), _mm_andnot_ps(compareResults, maxValuesIndex));
+            maxValues = _mm_or_ps(_mm_and_ps(compareResults, values), _mm_andnot_ps(compareResults, maxValues));
+        }
+
+    // Calculate the largest value from the remaining 4 points
+    _mm_store_ps(maxValuesBuffer, maxValues);
+    _mm_store_ps(maxIndexesBuffer, maxValuesIndex);
+
+    for (number = 0; number < 4; number++)
+        {
+            if ((maxValuesBuffer[number] > max) || ((maxValuesBuffer[number] == max) && (maxIndexesBuffer[number] < max_index)))
+                {
+                    max_index = maxIndexesBuffer[number];
+                    max = maxValuesBuffer[number];
+                }
+        }
+
+    for (number = vec_points * 4; number < num_points; number++)
+        {
+            value = inPtr[0] * inPtr[0] + inPtr[1] * inPtr[1];
+            inPtr += 2;
+            if (accumulate)
+                {
+                    value += accumulator[number];
+                }
+            accumulator[number] = value;
+            if (value > max)
+                {
+                    max_index = (float)number;
+                    max = value;
+                }
+        }
+    index[0] = (uint32_t)max_index;
+}
+
+#endif /* LV_HAVE_SSE3 */
+
+
+#ifdef LV_HAVE_SSE3
+#include <pmmintrin.h>
+
+static inline void volk_gnsssdr_32fc_magnitude_squared_acc_index_max_32f_u_sse3(float* accumulator, uint32_t* index, const lv_32fc_t* in, int accumulate, unsigned int num_points)
+{
+    const unsigned int vec_points = num_points / 4;
+    const float* inPtr = (const float*)in;
+    float* accPtr = accumulator;
+    unsigned int number;
+    float max = -1.0f;
+    float max_index = 0.0f;
+    float value;
+
+    __m128 z1, z2, values, compareResults;
+    __m128 indexIncrementValues = _mm_set1_ps(4);
+    __m128 currentIndexes = _mm_set_ps(-1, -2, -3, -4);
+    __m128 maxValues = _mm_set1_ps(-1.0f);
+    __m128 maxValuesIndex = _mm_setzero_ps();
+
+    __VOLK_ATTR_ALIGNED(16)
+    float maxValuesBuffer[4];
+    __VOLK_ATTR_ALIGNED(16)
+    float maxIndexesBuffer[4];
+
+    for (number = 0; number < vec_points; number++)
+        {
+            z1 = _mm_loadu_ps(inPtr);
+            z2 = _mm_loadu_ps(inPtr + 4);
+            inPtr += 8;
+            z1 = _mm_mul_ps(z1, z1);
+            z2 = _mm_mul_ps(z2, z2);
+            values = _mm_hadd_ps(z1, z2);  // Re^2 + Im^2
+            if (accumulate)
+                {
+                    values = _mm_add_ps(values, _mm_loadu_ps(accPtr));
+                }
+            _mm_storeu_ps(accPtr, values);
+            accPtr += 4;
+
+            currentIndexes = _mm_add_ps(currentIndexes, indexIncrementValues);
+            compareResults = _mm_cmpgt_ps(values, maxValues);
+            maxValuesIndex = _mm_or_ps(_mm_and_ps(compareResults, currentIndexes), _mm_andnot_ps(compareResults, maxValuesIndex));
+            maxValues = _mm_or_ps(_mm_and_ps(compareResults, values), _mm_andnot_ps(compareResults, maxValues));
+        }
+
+    // Calculate the largest value from the remaining 4 points
+    _mm_store_ps(maxValuesBuffer, maxValues);
+    _mm_store_ps(maxIndexesBuffer, maxValuesIndex);
+
+    for (number = 0; number < 4; number++)
+        {
+            if ((maxValuesBuffer[number] > max) || ((maxValuesBuffer[number] == max) && (maxIndexesBuffer[number] < max_index)))
+                {
+                    max_index = maxIndexesBuffer[number];
+                    max = maxValuesBuffer[number];
+                }
+        }
+
+    for (number = vec_points * 4; number < num_points; number++)
+        {
+            value = inPtr[0] * inPtr[0] + inPtr[1] * inPtr[1];
+            inPtr += 2;
+            if (accumulate)
+                {
+                    value += accumulator[number];
+                }
+            accumulator[number] = value;
+            if (value > max)
+                {
+                    max_index = (float)number;
+                    max = value;
+                }
+        }
+    index[0] = (uint32_t)max_index;
+}
+
+#endif /* LV_HAVE_SSE3 */
+
+
+#ifdef LV_HAVE_AVX
+#include <immintrin.h>
+
+static inline void volk_gnsssdr_32fc_magnitude_squared_acc_index_max_32f_a_avx(float* accumulator, uint32_t* index, const lv_32fc_t* in, int accumulate, unsigned int num_points)
+{
+    const unsigned int vec_points = num_points / 8;
+    const float* inPtr = (const float*)in;
+    float* accPtr = accumulator;
+    unsigned int number;
+    float max = -1.0f;
+    float max_index = 0.0f;
+    float value;
+
+    __m256 z1, z2, values, compareResults;
+    __m256 indexIncrementValues = _mm256_set1_ps(8);
+    __m256 currentIndexes = _mm256_set_ps(-1, -2, -3, -4, -5, -6, -7, -8);
+    __m256 maxValues = _mm256_set1_ps(-1.0f);
+    __m256 maxValuesIndex = _mm256_setzero_ps();
+
+    __VOLK_ATTR_ALIGNED(32)
+    float maxValuesBuffer[8];
+    __VOLK_ATTR_ALIGNED(32)
+    float maxIndexesBuffer[8];
+
+    for (number = 0; number < vec_points; number++)
+        {
+            z1 = _mm256_load_ps(inPtr);
+            z2 = _mm256_load_ps(inPtr + 8);
+            inPtr += 16;
+            z1 = _mm256_mul_ps(z1, z1);
+            z2 = _mm256_mul_ps(z2, z2);
+            // Reorder the 128-bit lanes so the horizontal add keeps the samples in order
+            values = _mm256_hadd_ps(_mm256_permute2f128_ps(z1, z2, 0x20), _mm256_permute2f128_ps(z1, z2, 0x31));  // Re^2 + Im^2
+            if (accumulate)
+                {
+                    values = _mm256_add_ps(values, _mm256_load_ps(accPtr));
+                }
+            _mm256_store_ps(accPtr, values);
+            accPtr += 8;
+
+            currentIndexes = _mm256_add_ps(currentIndexes, indexIncrementValues);
+            compareResults = _mm256_cmp_ps(values, maxValues, _CMP_GT_OS);
+            maxValuesIndex = _mm256_blendv_ps(maxValuesIndex, currentIndexes, compareResults);
+            maxValues = _mm256_blendv_ps(maxValues, values, compareResults);
+        }
+
+    // Calculate the largest value from the remaining 8 points
+    _mm256_store_ps(maxValuesBuffer, maxValues);
+    _mm256_store_ps(maxIndexesBuffer, maxValuesIndex);
+
+    for (number = 0; number < 8; number++)
+        {
+            if ((maxValuesBuffer[number] > max) || ((maxValuesBuffer[number] == max) && (maxIndexesBuffer[number] < max_index)))
+                {
+                    max_index = maxIndexesBuffer[number];
+                    max = maxValuesBuffer[number];
+                }
+        }
+
+    for (number = vec_points * 8; number < num_points; number++)
+        {
+            value = inPtr[0] * inPtr[0] + inPtr[1] * inPtr[1];
+            inPtr += 2;
+            if (accumulate)
+                {
+                    value += accumulator[number];
+                }
+            accumulator[number] = value;
+            if (value > max)
+                {
+                    max_index = (float)number;
+                    max = value;
+                }
+        }
+    index[0] = (uint32_t)max_index;
+}
+
+#endif /* LV_HAVE_AVX */
+
+
+#ifdef LV_HAVE_AVX
+#include <immintrin.h>
+
+static inline void volk_gnsssdr_32fc_magnitude_squared_acc_index_max_32f_u_avx(float* accumulator, uint32_t* index, const lv_32fc_t* in, int accumulate, unsigned int num_points)
+{
+    const unsigned int vec_points = num_points / 8;
+    const float* inPtr = (const float*)in;
+    float* accPtr = accumulator;
+    unsigned int number;
+    float max = -1.0f;
+    float max_index = 0.0f;
+    float value;
+
+    __m256 z1, z2, values, compareResults;
+    __m256 indexIncrementValues = _mm256_set1_ps(8);
+    __m256 currentIndexes = _mm256_set_ps(-1, -2, -3, -4, -5, -6, -7, -8);
+    __m256 maxValues = _mm256_set1_ps(-1.0f);
+    __m256 maxValuesIndex = _mm256_setzero_ps();
+
+    __VOLK_ATTR_ALIGNED(32)
+    float maxValuesBuffer[8];
+    __VOLK_ATTR_ALIGNED(32)
+    float maxIndexesBuffer[8];
+
+    for (number = 0; number < vec_points; number++)
+        {
+            z1 = _mm256_loadu_ps(inPtr);
+            z2 = _mm256_loadu_ps(inPtr + 8);
+            inPtr += 16;
+            z1 = _mm256_mul_ps(z1, z1);
+            z2 = _mm256_mul_ps(z2, z2);
+            // Reorder the 128-bit lanes so the horizontal add keeps the samples in order
+            values = _mm256_hadd_ps(_mm256_permute2f128_ps(z1, z2, 0x20), _mm256_permute2f128_ps(z1, z2, 0x31));  // Re^2 + Im^2
+            if (accumulate)
+                {
+                    values = _mm256_add_ps(values, _mm256_loadu_ps(accPtr));
+                }
+            _mm256_storeu_ps(accPtr, values);
+            accPtr += 8;
+
+            currentIndexes = _mm256_add_ps(currentIndexes, indexIncrementValues);
+            compareResults = _mm256_cmp_ps(values, maxValues, _CMP_GT_OS);
+            maxValuesIndex = _mm256_blendv_ps(maxValuesIndex, currentIndexes, compareResults);
+            maxValues = _mm256_blendv_ps(maxValues, values, compareResults);
+        }
+
+    // Calculate the largest value from the remaining 8 points
+    _mm256_store_ps(maxValuesBuffer, maxValues);
+    _mm256_store_ps(maxIndexesBuffer, maxValuesIndex);
+
+    for (number = 0; number < 8; number++)
+        {
+            if ((maxValuesBuffer[number] > max) || ((maxValuesBuffer[number] == max) && (maxIndexesBuffer[number] < max_index)))
+                {
+                    max_index = maxIndexesBuffer[number];
+                    max = maxValuesBuffer[number];
+                }
+        }
+
+    for (number = vec_points * 8; number < num_points; number++)
+        {
+            value = inPtr[0] * inPtr[0] + inPtr[1] * inPtr[1];
+            inPtr += 2;
+            if (accumulate)
+                {
+                    value += accumulator[number];
+                }
+            accumulator[number] = value;
+            if (value > max)
+                {
+                    max_index = (float)number;
+                    max = value;
+                }
+        }
+    index[0] = (uint32_t)max_index;
+}
+
+#endif /* LV_HAVE_AVX */
+
+
+#ifdef LV_HAVE_NEONV8
+#include <arm_neon.h>
+
+static inline void volk_gnsssdr_32fc_magnitude_squared_acc_index_max_32f_neonv8(float* accumulator, uint32_t* index, const lv_32fc_t* in, int accumulate, unsigned int num_points)
+{
+    const unsigned int vec_points = num_points / 4;
+    const float* inPtr = (const float*)in;
+    float* accPtr = accumulator;
+    unsigned int number;
+    float max = -1.0f;
+    uint32_t max_index = 0;
+    float value;
+
+    float32x4x2_t z;
+    float32x4_t values;
+    uint32x4_t compareResults;
+    const uint32x4_t indexIncrementValues = vdupq_n_u32(4);
+    __VOLK_ATTR_ALIGNED(16)
+    const uint32_t currentIndexes_u[4] = {0, 1, 2, 3};
+    uint32x4_t currentIndexes = vld1q_u32(currentIndexes_u);
+    float32x4_t maxValues = vdupq_n_f32(-1.0f);
+    uint32x4_t maxValuesIndex = vdupq_n_u32(0);
+
+    __VOLK_ATTR_ALIGNED(16)
+    float maxValuesBuffer[4];
+    __VOLK_ATTR_ALIGNED(16)
+    uint32_t maxIndexesBuffer[4];
+
+    for (number = 0; number < vec_points; number++)
+        {
+            z = vld2q_f32(inPtr);  // de-interleaves real and imaginary parts
+            inPtr += 8;
+            values = vaddq_f32(vmulq_f32(z.val[0], z.val[0]), vmulq_f32(z.val[1], z.val[1]));  // Re^2 + Im^2
+            if (accumulate)
+                {
+                    values = vaddq_f32(values, vld1q_f32(accPtr));
+                }
+            vst1q_f32(accPtr, values);
+            accPtr += 4;
+
+            compareResults = vcgtq_f32(values, maxValues);
+            maxValuesIndex = vbslq_u32(compareResults, currentIndexes, maxValuesIndex);
+            maxValues = vbslq_f32(compareResults, values, maxValues);
+            currentIndexes = vaddq_u32(currentIndexes, indexIncrementValues);
+        }
+
+    // Calculate the largest value from the remaining 4 points
+    vst1q_f32(maxValuesBuffer, maxValues);
+    vst1q_u32(maxIndexesBuffer, maxValuesIndex);
+
+    for (number = 0; number < 4; number++)
+        {
+            if ((maxValuesBuffer[number] > max) || ((maxValuesBuffer[number] == max) && (maxIndexesBuffer[number] < max_index)))
+                {
+                    max_index = maxIndexesBuffer[number];
+                    max = maxValuesBuffer[number];
+                }
+        }
+
+    for (number = vec_points * 4; number < num_points; number++)
+        {
+            value = inPtr[0] * inPtr[0] + inPtr[1] * inPtr[1];
+            inPtr += 2;
+            if (accumulate)
+                {
+                    value += accumulator[number];
+                }
+            accumulator[number] = value;
+            if (value > max)
+                {
+                    max_index = number;
+                    max = value;
+                }
+        }
+    index[0] = max_index;
+}
+
+#endif /* LV_HAVE_NEONV8 */
+
+#endif /* INCLUDED_volk_gnsssdr_32fc_magnitude_squared_acc_index_max_32f_H */
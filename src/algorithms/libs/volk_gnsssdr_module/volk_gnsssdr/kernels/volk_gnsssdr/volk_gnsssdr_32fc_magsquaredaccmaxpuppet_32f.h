@@ -0,0 +1,129 @@
+/*!
+ * \file volk_gnsssdr_32fc_magsquaredaccmaxpuppet_32f.h
+ * \brief VOLK_GNSSSDR puppet for the volk_gnsssdr_32fc_magnitude_squared_acc_index_max_32f kernel.
+ *
+ *
+ * -------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2018  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *          Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------
+ */
+
+#ifndef INCLUDED_volk_gnsssdr_32fc_magsquaredaccmaxpuppet_32f_H
+#define INCLUDED_volk_gnsssdr_32fc_magsquaredaccmaxpuppet_32f_H
+
+#include "volk_gnsssdr/volk_gnsssdr_32fc_magnitude_squared_acc_index_max_32f.h"
+#include <volk_gnsssdr/volk_gnsssdr_complex.h>
+
+
+#ifdef LV_HAVE_GENERIC
+static inline void volk_gnsssdr_32fc_magsquaredaccmaxpuppet_32f_generic(float* result, const lv_32fc_t* in, unsigned int num_points)
+{
+    uint32_t index[1];
+    // first integration overwrites the output, the second one accumulates on it
+    volk_gnsssdr_32fc_magnitude_squared_acc_index_max_32f_generic(result, index, in, 0, num_points);
+    volk_gnsssdr_32fc_magnitude_squared_acc_index_max_32f_generic(result, index, in, 1, num_points);
+    if (num_points > 0)
+        {
+            // make the index of the maximum part of the result
+            result[index[0]] += 1.0f;
+        }
+}
+#endif /* LV_HAVE_GENERIC */
+
+#ifdef LV_HAVE_SSE3
+static inline void volk_gnsssdr_32fc_magsquaredaccmaxpuppet_32f_a_sse3(float* result, const lv_32fc_t* in, unsigned int num_points)
+{
+    uint32_t index[1];
+    // first integration overwrites the output, the second one accumulates on it
+    volk_gnsssdr_32fc_magnitude_squared_acc_index_max_32f_a_sse3(result, index, in, 0, num_points);
+    volk_gnsssdr_32fc_magnitude_squared_acc_index_max_32f_a_sse3(result, index, in, 1, num_points);
+    if (num_points > 0)
+        {
+            // make the index of the maximum part of the result
+            result[index[0]] += 1.0f;
+        }
+}
+#endif /* LV_HAVE_SSE3 */
+
+#ifdef LV_HAVE_SSE3
+static inline void volk_gnsssdr_32fc_magsquaredaccmaxpuppet_32f_u_sse3(float* result, const lv_32fc_t* in, unsigned int num_points)
+{
+    uint32_t index[1];
+    // first integration overwrites the output, the second one accumulates on it
+    volk_gnsssdr_32fc_magnitude_squared_acc_index_max_32f_u_sse3(result, index, in, 0, num_points);
+    volk_gnsssdr_32fc_magnitude_squared_acc_index_max_32f_u_sse3(result, index, in, 1, num_points);
+    if (num_points > 0)
+        {
+            // make the index of the maximum part of the result
+            result[index[0]] += 1.0f;
+        }
+}
+#endif /* LV_HAVE_SSE3 */
+
+#ifdef LV_HAVE_AVX
+static inline void volk_gnsssdr_32fc_magsquaredaccmaxpuppet_32f_a_avx(float* result, const lv_32fc_t* in, unsigned int num_points)
+{
+    uint32_t index[1];
+    // first integration overwrites the output, the second one accumulates on it
+    volk_gnsssdr_32fc_magnitude_squared_acc_index_max_32f_a_avx(result, index, in, 0, num_points);
+    volk_gnsssdr_32fc_magnitude_squared_acc_index_max_32f_a_avx(result, index, in, 1, num_points);
+    if (num_points > 0)
+        {
+            // make the index of the maximum part of the result
+            result[index[0]] += 1.0f;
+        }
+}
+#endif /* LV_HAVE_AVX */
+
+#ifdef LV_HAVE_AVX
+static inline void volk_gnsssdr_32fc_magsquaredaccmaxpuppet_32f_u_avx(float* result, const lv_32fc_t* in, unsigned int num_points)
+{
+    uint32_t index[1];
+    // first integration overwrites the output, the second one accumulates on it
+    volk_gnsssdr_32fc_magnitude_squared_acc_index_max_32f_u_avx(result, index, in, 0, num_points);
+    volk_gnsssdr_32fc_magnitude_squared_acc_index_max_32f_u_avx(result, index, in, 1, num_points);
+    if (num_points > 0)
+        {
+            // make the index of the maximum part of the result
+            result[index[0]] += 1.0f;
+        }
+}
+#endif /* LV_HAVE_AVX */
+
+
+#ifdef LV_HAVE_NEONV8
+static inline void volk_gnsssdr_32fc_magsquaredaccmaxpuppet_32f_neonv8(float* result, const lv_32fc_t* in, unsigned int num_points)
+{
+    uint32_t index[1];
+    // first integration overwrites the output, the second one accumulates on it
+    volk_gnsssdr_32fc_magnitude_squared_acc_index_max_32f_neonv8(result, index, in, 0, num_points);
+    volk_gnsssdr_32fc_magnitude_squared_acc_index_max_32f_neonv8(result, index, in, 1, num_points);
+    if (num_points > 0)
+        {
+            // make the index of the maximum part of the result
+            result[index[0]] += 1.0f;
+        }
+}
+#endif /* LV_HAVE_NEONV8 */
+
+#endif /* INCLUDED_volk_gnsssdr_32fc_magsquaredaccmaxpuppet_32f_H */
@@ -0,0 +1,189 @@
+/*!
+ * \file volk_gnsssdr_32u_s32f_unpack_1bit_32fc.h
+ * \brief VOLK_GNSSSDR kernel: unpacks 1-bit complex samples held in 32-bit words.
+ *
+ * VOLK_GNSSSDR kernel that turns the two least significant bits of each
+ * 32-bit word into a complex sample of fixed magnitude.
+ *
+ * -------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2018  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *          Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------
+ */
+
+/*!
+ * \page volk_gnsssdr_32u_s32f_unpack_1bit_32fc
+ *
+ * \b Overview
+ *
+ * VOLK_GNSSSDR kernel that unpacks one complex sample from each 32-bit word: bit 0 gives
+ * the in-phase component and bit 1 the quadrature one, \p scale if the bit is set
+ * and -\p scale otherwise. The other bits are ignored.
+ *
+ * <b>Dispatcher Prototype</b>
+ * \code
+ * void volk_gnsssdr_32u_s32f_unpack_1bit_32fc(lv_32fc_t* outVector, const unsigned int* inVector, const float scale, unsigned int num_points)
+ * \endcode
+ *
+ * \b Inputs
+ * \li inVector:       Packed samples, one per word.
+ * \li scale:          Magnitude of each component.
+ * \li num_points:     Number of words in \p inVector.
+ *
+ * \b Outputs
+ * \li outVector:      Unpacked complex samples.
+ *
+ */
+
+#ifndef INCLUDED_volk_gnsssdr_32u_s32f_unpack_1bit_32fc_H
+#define INCLUDED_volk_gnsssdr_32u_s32f_unpack_1bit_32fc_H
+
+#include <volk_gnsssdr/volk_gnsssdr_common.h>
+#include <volk_gnsssdr/volk_gnsssdr_complex.h>
+#include <stdint.h>
+
+
+#ifdef LV_HAVE_GENERIC
+
+static inline void volk_gnsssdr_32u_s32f_unpack_1bit_32fc_generic(lv_32fc_t* outVector, const uint32_t* inVector, const float scale, unsigned int num_points)
+{
+    float* out = (float*)outVector;
+    unsigned int n;
+    for (n = 0; n < num_points; n++)
+        {
+            *out++ = (inVector[n] & 1) ? scale : -scale;
+            *out++ = (inVector[n] & 2) ? scale : -scale;
+        }
+}
+
+#endif /* LV_HAVE_GENERIC */
+
+
+#ifdef LV_HAVE_SSE2
+#include <emmintrin.h>
+
+static inline void volk_gnsssdr_32u_s32f_unpack_1bit_32fc_u_sse2(lv_32fc_t* outVector, const uint32_t* inVector, const float scale, unsigned int num_points)
+{
+    const unsigned int sse_iters = num_points / 4;
+    const __m128i bit0 = _mm_set1_epi32(1);
+    const __m128i bit1 = _mm_set1_epi32(2);
+    const __m128 pos = _mm_set1_ps(scale);
+    const __m128 neg = _mm_set1_ps(-scale);
+    float* out = (float*)outVector;
+    __m128i x;
+    __m128 m_i, m_q, i, q;
+    unsigned int number;
+    for (number = 0; number < sse_iters; number++)
+        {
+            x = _mm_loadu_si128((const __m128i*)inVector);
+            m_i = _mm_castsi128_ps(_mm_cmpeq_epi32(_mm_and_si128(x, bit0), bit0));
+            m_q = _mm_castsi128_ps(_mm_cmpeq_epi32(_mm_and_si128(x, bit1), bit1));
+            i = _mm_or_ps(_mm_and_ps(m_i, pos), _mm_andnot_ps(m_i, neg));
+            q = _mm_or_ps(_mm_and_ps(m_q, pos), _mm_andnot_ps(m_q, neg));
+            _mm_storeu_ps(out, _mm_unpacklo_ps(i, q));
+            _mm_storeu_ps(out + 4, _mm_unpackhi_ps(i, q));
+            out += 8;
+            inVector += 4;
+        }
+    for (number = sse_iters * 4; number < num_points; number++)
+        {
+            *out++ = (*inVector & 1) ? scale : -scale;
+            *out++ = (*inVector & 2) ? scale : -scale;
+            inVector++;
+        }
+}
+
+#endif /* LV_HAVE_SSE2 */
+
+
+#ifdef LV_HAVE_AVX2
+#include <immintrin.h>
+
+static inline void volk_gnsssdr_32u_s32f_unpack_1bit_32fc_u_avx2(lv_32fc_t* outVector, const uint32_t* inVector, const float scale, unsigned int num_points)
+{
+    const unsigned int avx2_iters = num_points / 8;
+    const __m256i bit0 = _mm256_set1_epi32(1);
+    const __m256i bit1 = _mm256_set1_epi32(2);
+    const __m256 pos = _mm256_set1_ps(scale);
+    const __m256 neg = _mm256_set1_ps(-scale);
+    float* out = (float*)outVector;
+    __m256i x;
+    __m256 i, q, a, b;
+    unsigned int number;
+    for (number = 0; number < avx2_iters; number++)
+        {
+            x = _mm256_loadu_si256((const __m256i*)inVector);
+            i = _mm256_blendv_ps(neg, pos, _mm256_castsi256_ps(_mm256_cmpeq_epi32(_mm256_and_si256(x, bit0), bit0)));
+            q = _mm256_blendv_ps(neg, pos, _mm256_castsi256_ps(_mm256_cmpeq_epi32(_mm256_and_si256(x, bit1), bit1)));
+            /* The unpacks work within each 128-bit lane: bring the lanes back in input order */
+            a = _mm256_unpacklo_ps(i, q);
+            b = _mm256_unpackhi_ps(i, q);
+            _mm256_storeu_ps(out, _mm256_permute2f128_ps(a, b, 0x20));
+            _mm256_storeu_ps(out + 8, _mm256_permute2f128_ps(a, b, 0x31));
+            out += 16;
+            inVector += 8;
+        }
+    for (number = avx2_iters * 8; number < num_points; number++)
+        {
+            *out++ = (*inVector & 1) ? scale : -scale;
+            *out++ = (*inVector & 2) ? scale : -scale;
+            inVector++;
+        }
+}
+
+#endif /* LV_HAVE_AVX2 */
+
+
+#ifdef LV_HAVE_NEONV7
+#include <arm_neon.h>
+
+static inline void volk_gnsssdr_32u_s32f_unpack_1bit_32fc_neon(lv_32fc_t* outVector, const uint32_t* inVector, const float scale, unsigned int num_points)
+{
+    const unsigned int neon_iters = num_points / 4;
+    const uint32x4_t bit0 = vdupq_n_u32(1);
+    const uint32x4_t bit1 = vdupq_n_u32(2);
+    const float32x4_t pos = vdupq_n_f32(scale);
+    const float32x4_t neg = vdupq_n_f32(-scale);
+    float* out = (float*)outVector;
+    float32x4x2_t v;
+    uint32x4_t x;
+    unsigned int number;
+    for (number = 0; number < neon_iters; number++)
+        {
+            x = vld1q_u32(inVector);
+            v.val[0] = vbslq_f32(vtstq_u32(x, bit0), pos, neg);
+            v.val[1] = vbslq_f32(vtstq_u32(x, bit1), pos, neg);
+            vst2q_f32(out, v);
+            out += 8;
+            inVector += 4;
+        }
+    for (number = neon_iters * 4; number < num_points; number++)
+        {
+            *out++ = (*inVector & 1) ? scale : -scale;
+            *out++ = (*inVector & 2) ? scale : -scale;
+            inVector++;
+        }
+}
+
+#endif /* LV_HAVE_NEONV7 */
+
+#endif /* INCLUDED_volk_gnsssdr_32u_s32f_unpack_1bit_32fc_H */
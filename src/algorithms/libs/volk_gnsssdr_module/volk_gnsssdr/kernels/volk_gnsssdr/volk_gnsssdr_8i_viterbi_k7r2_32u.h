@@ -0,0 +1,353 @@
+/*!
+ * \file volk_gnsssdr_8i_viterbi_k7r2_32u.h
+ * \brief VOLK_GNSSSDR kernel: add-compare-select steps of a K=7, rate 1/2 soft-decision Viterbi decoder.
+ *
+ * VOLK_GNSSSDR kernel that runs the trellis of the K=7, rate 1/2 convolutional
+ * code used by Galileo I/NAV and F/NAV, GPS CNAV and SBAS, with 8-bit soft
+ * symbols and 16-bit path metrics, and stores the survivor decisions.
+ *
+ * -------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2018  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *          Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------
+ */
+
+/*!
+ * \page volk_gnsssdr_8i_viterbi_k7r2_32u
+ *
+ * \b Overview
+ *
+ * VOLK_GNSSSDR kernel that performs \p num_steps add-compare-select steps over the
+ * 64 states of a K=7, rate 1/2 trellis. The state is the last six input bits, the
+ * newest one in the least significant bit, so the butterfly \c i joins the states
+ * \c i and \c i+32 to the states \c 2i and \c 2i+1.
+ *
+ * A soft symbol is positive for a coded 1. The branch metric is the correlation of the
+ * two received symbols with the branch code bits, and the path metrics are maximized.
+ * They are renormalized after each step, so that state 0 is always at 0, which keeps
+ * the spread of the metrics well within 16 bits. On a tie, the survivor comes from
+ * the state \c i.
+ *
+ * <b>Dispatcher Prototype</b>
+ * \code
+ * void volk_gnsssdr_8i_viterbi_k7r2_32u(unsigned int* decisions, short* metrics, const char* symbols, const short* branch_masks, unsigned int num_steps)
+ * \endcode
+ *
+ * \b Inputs
+ * \li metrics:        Path metrics of the 64 states before the first step.
+ * \li symbols:        Soft symbols, two per step.
+ * \li branch_masks:   Two tables of 32 masks (see volk_gnsssdr_8i_viterbi_k7r2_32u_branch_masks), 0 if the first
+ *                     code bit of the butterfly is a 1 and -1 otherwise.
+ * \li num_steps:      Number of trellis steps.
+ *
+ * \b Outputs
+ * \li decisions:      Two words per step. Bit \c j%32 of word \c j/32 is set if the survivor of state \c j comes
+ *                     from the state <tt>(j >> 1) + 32</tt>.
+ * \li metrics:        Path metrics of the 64 states after the last step.
+ *
+ */
+
+#ifndef INCLUDED_volk_gnsssdr_8i_viterbi_k7r2_32u_H
+#define INCLUDED_volk_gnsssdr_8i_viterbi_k7r2_32u_H
+
+#include <volk_gnsssdr/volk_gnsssdr_common.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+/* Initial metric of the states that are known not to be the starting one */
+#define VOLK_GNSSSDR_VITERBI_K7R2_UNLIKELY_METRIC -4096
+
+
+static inline int volk_gnsssdr_8i_viterbi_k7r2_32u_parity(int x)
+{
+    x ^= x >> 16;
+    x ^= x >> 8;
+    x ^= x >> 4;
+    x &= 0xf;
+    return (0x6996 >> x) & 1;
+}
+
+
+/* Builds the branch masks of two generator polynomials (newest bit in the LSB; a negative value inverts the output) */
+static inline void volk_gnsssdr_8i_viterbi_k7r2_32u_branch_masks(int16_t* branch_masks, const int polys[2])
+{
+    int k;
+    int i;
+    for (k = 0; k < 2; k++)
+        {
+            for (i = 0; i < 32; i++)
+                {
+                    branch_masks[32 * k + i] = ((polys[k] < 0) ^ volk_gnsssdr_8i_viterbi_k7r2_32u_parity((2 * i) & abs(polys[k]))) ? 0 : -1;
+                }
+        }
+}
+
+
+/* Sets the metrics of a trellis that starts at the state start_state */
+static inline void volk_gnsssdr_8i_viterbi_k7r2_32u_init_metrics(int16_t* metrics, unsigned int start_state)
+{
+    int i;
+    for (i = 0; i < 64; i++)
+        {
+            metrics[i] = VOLK_GNSSSDR_VITERBI_K7R2_UNLIKELY_METRIC;
+        }
+    metrics[start_state & 63] = 0;
+}
+
+
+#ifdef LV_HAVE_GENERIC
+
+static inline void volk_gnsssdr_8i_viterbi_k7r2_32u_generic(uint32_t* decisions, int16_t* metrics, const int8_t* symbols, const int16_t* branch_masks, unsigned int num_steps)
+{
+    int16_t new_metrics[64];
+    unsigned int n;
+    int i;
+    int16_t s0, s1, m0, m1, bm, a, b, p0, p1;
+    int16_t ref;
+    uint32_t d0, d1;
+    for (n = 0; n < num_steps; n++)
+        {
+            s0 = symbols[2 * n];
+            s1 = symbols[2 * n + 1];
+            decisions[2 * n] = 0;
+            decisions[2 * n + 1] = 0;
+            for (i = 0; i < 32; i++)
+                {
+                    m0 = branch_masks[i];
+                    m1 = branch_masks[32 + i];
+                    bm = (int16_t)(((s0 ^ m0) - m0) + ((s1 ^ m1) - m1));
+                    a = metrics[i];
+                    b = metrics[i + 32];
+                    p0 = (int16_t)(a + bm);
+                    p1 = (int16_t)(b - bm);
+                    d0 = p1 > p0;
+                    new_metrics[2 * i] = d0 ? p1 : p0;
+                    p0 = (int16_t)(a - bm);
+                    p1 = (int16_t)(b + bm);
+                    d1 = p1 > p0;
+                    new_metrics[2 * i + 1] = d1 ? p1 : p0;
+                    decisions[2 * n + i / 16] |= (d0 | (d1 << 1)) << ((2 * i) & 31);
+                }
+            ref = new_metrics[0];
+            for (i = 0; i < 64; i++)
+                {
+                    metrics[i] = (int16_t)(new_metrics[i] - ref);
+                }
+        }
+}
+
+#endif /* LV_HAVE_GENERIC */
+
+
+#ifdef LV_HAVE_SSE2
+#include <emmintrin.h>
+
+static inline void volk_gnsssdr_8i_viterbi_k7r2_32u_u_sse2(uint32_t* decisions, int16_t* metrics, const int8_t* symbols, const int16_t* branch_masks, unsigned int num_steps)
+{
+    __m128i pm[8], npm[8], mask0[4], mask1[4];
+    __m128i s0, s1, bm, a, b, p0, p1, p2, p3, ne, no, de, dod, ref;
+    unsigned int n;
+    int g;
+    uint32_t w;
+    for (g = 0; g < 8; g++)
+        {
+            pm[g] = _mm_loadu_si128((const __m128i*)(metrics + 8 * g));
+        }
+    for (g = 0; g < 4; g++)
+        {
+            mask0[g] = _mm_loadu_si128((const __m128i*)(branch_masks + 8 * g));
+            mask1[g] = _mm_loadu_si128((const __m128i*)(branch_masks + 32 + 8 * g));
+        }
+    for (n = 0; n < num_steps; n++)
+        {
+            s0 = _mm_set1_epi16(symbols[2 * n]);
+            s1 = _mm_set1_epi16(symbols[2 * n + 1]);
+            decisions[2 * n] = 0;
+            decisions[2 * n + 1] = 0;
+            /* eight butterflies at a time: states 8g..8g+7 and 32+8g..32+8g+7 to 16g..16g+15 */
+            for (g = 0; g < 4; g++)
+                {
+                    bm = _mm_add_epi16(_mm_sub_epi16(_mm_xor_si128(s0, mask0[g]), mask0[g]),
+                        _mm_sub_epi16(_mm_xor_si128(s1, mask1[g]), mask1[g]));
+                    a = pm[g];
+                    b = pm[g + 4];
+                    p0 = _mm_adds_epi16(a, bm);
+                    p1 = _mm_subs_epi16(b, bm);
+                    p2 = _mm_subs_epi16(a, bm);
+                    p3 = _mm_adds_epi16(b, bm);
+                    ne = _mm_max_epi16(p0, p1);
+                    no = _mm_max_epi16(p2, p3);
+                    de = _mm_cmpgt_epi16(p1, p0);
+                    dod = _mm_cmpgt_epi16(p3, p2);
+                    npm[2 * g] = _mm_unpacklo_epi16(ne, no);
+                    npm[2 * g + 1] = _mm_unpackhi_epi16(ne, no);
+                    w = (uint32_t)_mm_movemask_epi8(_mm_packs_epi16(_mm_unpacklo_epi16(de, dod), _mm_unpackhi_epi16(de, dod)));
+                    decisions[2 * n + g / 2] |= w << (16 * (g & 1));
+                }
+            ref = _mm_set1_epi16((short)_mm_extract_epi16(npm[0], 0));
+            for (g = 0; g < 8; g++)
+                {
+                    pm[g] = _mm_sub_epi16(npm[g], ref);
+                }
+        }
+    for (g = 0; g < 8; g++)
+        {
+            _mm_storeu_si128((__m128i*)(metrics + 8 * g), pm[g]);
+        }
+}
+
+#endif /* LV_HAVE_SSE2 */
+
+
+#ifdef LV_HAVE_AVX2
+#include <immintrin.h>
+
+static inline void volk_gnsssdr_8i_viterbi_k7r2_32u_u_avx2(uint32_t* decisions, int16_t* metrics, const int8_t* symbols, const int16_t* branch_masks, unsigned int num_steps)
+{
+    __m256i pm[4], npm[4], mask0[2], mask1[2];
+    __m256i s0, s1, bm, a, b, p0, p1, p2, p3, ne, no, lo, hi, de, dod, ref;
+    unsigned int n;
+    int g;
+    for (g = 0; g < 4; g++)
+        {
+            pm[g] = _mm256_loadu_si256((const __m256i*)(metrics + 16 * g));
+        }
+    for (g = 0; g < 2; g++)
+        {
+            mask0[g] = _mm256_loadu_si256((const __m256i*)(branch_masks + 16 * g));
+            mask1[g] = _mm256_loadu_si256((const __m256i*)(branch_masks + 32 + 16 * g));
+        }
+    for (n = 0; n < num_steps; n++)
+        {
+            s0 = _mm256_set1_epi16(symbols[2 * n]);
+            s1 = _mm256_set1_epi16(symbols[2 * n + 1]);
+            /* sixteen butterflies at a time: states 16g..16g+15 and 32+16g..32+16g+15 to 32g..32g+31 */
+            for (g = 0; g < 2; g++)
+                {
+                    bm = _mm256_add_epi16(_mm256_sub_epi16(_mm256_xor_si256(s0, mask0[g]), mask0[g]),
+                        _mm256_sub_epi16(_mm256_xor_si256(s1, mask1[g]), mask1[g]));
+                    a = pm[g];
+                    b = pm[g + 2];
+                    p0 = _mm256_adds_epi16(a, bm);
+                    p1 = _mm256_subs_epi16(b, bm);
+                    p2 = _mm256_subs_epi16(a, bm);
+                    p3 = _mm256_adds_epi16(b, bm);
+                    ne = _mm256_max_epi16(p0, p1);
+                    no = _mm256_max_epi16(p2, p3);
+                    /* the unpacks interleave within each 128-bit lane; put the lanes back in order */
+                    lo = _mm256_unpacklo_epi16(ne, no);
+                    hi = _mm256_unpackhi_epi16(ne, no);
+                    npm[2 * g] = _mm256_permute2x128_si256(lo, hi, 0x20);
+                    npm[2 * g + 1] = _mm256_permute2x128_si256(lo, hi, 0x31);
+                    de = _mm256_cmpgt_epi16(p1, p0);
+                    dod = _mm256_cmpgt_epi16(p3, p2);
+                    lo = _mm256_unpacklo_epi16(de, dod);
+                    hi = _mm256_unpackhi_epi16(de, dod);
+                    de = _mm256_permute2x128_si256(lo, hi, 0x20);
+                    dod = _mm256_permute2x128_si256(lo, hi, 0x31);
+                    decisions[2 * n + g] = (uint32_t)_mm256_movemask_epi8(_mm256_permute4x64_epi64(_mm256_packs_epi16(de, dod), 0xD8));
+                }
+            ref = _mm256_set1_epi16((short)_mm_extract_epi16(_mm256_castsi256_si128(npm[0]), 0));
+            for (g = 0; g < 4; g++)
+                {
+                    pm[g] = _mm256_sub_epi16(npm[g], ref);
+                }
+        }
+    for (g = 0; g < 4; g++)
+        {
+            _mm256_storeu_si256((__m256i*)(metrics + 16 * g), pm[g]);
+        }
+}
+
+#endif /* LV_HAVE_AVX2 */
+
+
+#ifdef LV_HAVE_NEONV7
+#include <arm_neon.h>
+
+static inline void volk_gnsssdr_8i_viterbi_k7r2_32u_neon(uint32_t* decisions, int16_t* metrics, const int8_t* symbols, const int16_t* branch_masks, unsigned int num_steps)
+{
+    int16x8_t pm[8], npm[8], mask0[4], mask1[4];
+    int16x8_t s0, s1, bm, a, b, p0, p1, p2, p3, ne, no, ref;
+    int16x8x2_t zm;
+    uint16x8x2_t zd;
+    uint8x8_t x, y, sum;
+    const uint8_t weights_data[8] = {1, 2, 4, 8, 16, 32, 64, 128};
+    const uint8x8_t weights = vld1_u8(weights_data);
+    unsigned int n;
+    int g;
+    uint32_t w;
+    for (g = 0; g < 8; g++)
+        {
+            pm[g] = vld1q_s16(metrics + 8 * g);
+        }
+    for (g = 0; g < 4; g++)
+        {
+            mask0[g] = vld1q_s16(branch_masks + 8 * g);
+            mask1[g] = vld1q_s16(branch_masks + 32 + 8 * g);
+        }
+    for (n = 0; n < num_steps; n++)
+        {
+            s0 = vdupq_n_s16(symbols[2 * n]);
+            s1 = vdupq_n_s16(symbols[2 * n + 1]);
+            decisions[2 * n] = 0;
+            decisions[2 * n + 1] = 0;
+            for (g = 0; g < 4; g++)
+                {
+                    bm = vaddq_s16(vsubq_s16(veorq_s16(s0, mask0[g]), mask0[g]),
+                        vsubq_s16(veorq_s16(s1, mask1[g]), mask1[g]));
+                    a = pm[g];
+                    b = pm[g + 4];
+                    p0 = vqaddq_s16(a, bm);
+                    p1 = vqsubq_s16(b, bm);
+                    p2 = vqsubq_s16(a, bm);
+                    p3 = vqaddq_s16(b, bm);
+                    ne = vmaxq_s16(p0, p1);
+                    no = vmaxq_s16(p2, p3);
+                    zm = vzipq_s16(ne, no);
+                    npm[2 * g] = zm.val[0];
+                    npm[2 * g + 1] = zm.val[1];
+                    zd = vzipq_u16(vcgtq_s16(p1, p0), vcgtq_s16(p3, p2));
+                    /* one bit per decision: weight the bytes and add them pairwise */
+                    x = vand_u8(vmovn_u16(zd.val[0]), weights);
+                    y = vand_u8(vmovn_u16(zd.val[1]), weights);
+                    sum = vpadd_u8(x, y);
+                    sum = vpadd_u8(sum, sum);
+                    sum = vpadd_u8(sum, sum);
+                    w = (uint32_t)vget_lane_u8(sum, 0) | ((uint32_t)vget_lane_u8(sum, 1) << 8);
+                    decisions[2 * n + g / 2] |= w << (16 * (g & 1));
+                }
+            ref = vdupq_n_s16(vgetq_lane_s16(npm[0], 0));
+            for (g = 0; g < 8; g++)
+                {
+                    pm[g] = vsubq_s16(npm[g], ref);
+                }
+        }
+    for (g = 0; g < 8; g++)
+        {
+            vst1q_s16(metrics + 8 * g, pm[g]);
+        }
+}
+
+#endif /* LV_HAVE_NEONV7 */
+
+#endif /* INCLUDED_volk_gnsssdr_8i_viterbi_k7r2_32u_H */
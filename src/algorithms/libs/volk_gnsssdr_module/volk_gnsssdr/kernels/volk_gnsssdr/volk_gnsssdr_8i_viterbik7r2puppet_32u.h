@@ -0,0 +1,100 @@
+/*!
+ * \file volk_gnsssdr_8i_viterbik7r2puppet_32u.h
+ * \brief VOLK_GNSSSDR puppet for the volk_gnsssdr_8i_viterbi_k7r2_32u kernel.
+ *
+ * VOLK_GNSSSDR puppet for integrating the trellis kernel into the test system.
+ *
+ * -------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2018  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *          Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------
+ */
+
+#ifndef INCLUDED_volk_gnsssdr_8i_viterbik7r2puppet_32u_H
+#define INCLUDED_volk_gnsssdr_8i_viterbik7r2puppet_32u_H
+
+
+#include "volk_gnsssdr/volk_gnsssdr_8i_viterbi_k7r2_32u.h"
+#include <stdint.h>
+
+
+/* Runs num_points / 2 steps of the 171/133 code starting at state 0; the decisions fill the output vector */
+static inline void volk_gnsssdr_8i_viterbik7r2puppet_32u_setup(uint32_t* decisions, int16_t* metrics, int16_t* branch_masks, unsigned int num_points)
+{
+    const int polys[2] = {0x4f, 0x6d};
+    volk_gnsssdr_8i_viterbi_k7r2_32u_branch_masks(branch_masks, polys);
+    volk_gnsssdr_8i_viterbi_k7r2_32u_init_metrics(metrics, 0);
+    if (num_points % 2)
+        {
+            decisions[num_points - 1] = 0;
+        }
+}
+
+
+#ifdef LV_HAVE_GENERIC
+static inline void volk_gnsssdr_8i_viterbik7r2puppet_32u_generic(uint32_t* decisions, const int8_t* symbols, unsigned int num_points)
+{
+    int16_t metrics[64];
+    int16_t branch_masks[64];
+    volk_gnsssdr_8i_viterbik7r2puppet_32u_setup(decisions, metrics, branch_masks, num_points);
+    volk_gnsssdr_8i_viterbi_k7r2_32u_generic(decisions, metrics, symbols, branch_masks, num_points / 2);
+}
+
+#endif /* LV_HAVE_GENERIC */
+
+
+#ifdef LV_HAVE_SSE2
+static inline void volk_gnsssdr_8i_viterbik7r2puppet_32u_u_sse2(uint32_t* decisions, const int8_t* symbols, unsigned int num_points)
+{
+    int16_t metrics[64];
+    int16_t branch_masks[64];
+    volk_gnsssdr_8i_viterbik7r2puppet_32u_setup(decisions, metrics, branch_masks, num_points);
+    volk_gnsssdr_8i_viterbi_k7r2_32u_u_sse2(decisions, metrics, symbols, branch_masks, num_points / 2);
+}
+
+#endif /* LV_HAVE_SSE2 */
+
+
+#ifdef LV_HAVE_AVX2
+static inline void volk_gnsssdr_8i_viterbik7r2puppet_32u_u_avx2(uint32_t* decisions, const int8_t* symbols, unsigned int num_points)
+{
+    int16_t metrics[64];
+    int16_t branch_masks[64];
+    volk_gnsssdr_8i_viterbik7r2puppet_32u_setup(decisions, metrics, branch_masks, num_points);
+    volk_gnsssdr_8i_viterbi_k7r2_32u_u_avx2(decisions, metrics, symbols, branch_masks, num_points / 2);
+}
+
+#endif /* LV_HAVE_AVX2 */
+
+
+#ifdef LV_HAVE_NEONV7
+static inline void volk_gnsssdr_8i_viterbik7r2puppet_32u_neon(uint32_t* decisions, const int8_t* symbols, unsigned int num_points)
+{
+    int16_t metrics[64];
+    int16_t branch_masks[64];
+    volk_gnsssdr_8i_viterbik7r2puppet_32u_setup(decisions, metrics, branch_masks, num_points);
+    volk_gnsssdr_8i_viterbi_k7r2_32u_neon(decisions, metrics, symbols, branch_masks, num_points / 2);
+}
+
+#endif /* LV_HAVE_NEONV7 */
+
+#endif /* INCLUDED_volk_gnsssdr_8i_viterbik7r2puppet_32u_H */
@@ -0,0 +1,167 @@
+/*!
+ * \file volk_gnsssdr_8i_x2_interleave_8ic.h
+ * \brief VOLK_GNSSSDR kernel: interleaves two 8-bit integer vectors into a complex vector.
+ *
+ * VOLK_GNSSSDR kernel that makes a complex vector out of a vector of in-phase
+ * and a vector of quadrature 8-bit components.
+ *
+ * -------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2018  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *          Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------
+ */
+
+/*!
+ * \page volk_gnsssdr_8i_x2_interleave_8ic
+ *
+ * \b Overview
+ *
+ * Takes the real parts of \p num_points complex values from \p inVectorI and
+ * their imaginary parts from \p inVectorQ.
+ *
+ * <b>Dispatcher Prototype</b>
+ * \code
+ * void volk_gnsssdr_8i_x2_interleave_8ic(lv_8sc_t* outVector, const char* inVectorI, const char* inVectorQ, unsigned int num_points)
+ * \endcode
+ *
+ * \b Inputs
+ * \li inVectorI:   In-phase components.
+ * \li inVectorQ:   Quadrature components.
+ * \li num_points:  Number of complex values.
+ *
+ * \b Outputs
+ * \li outVector:   The complex values.
+ *
+ */
+
+#ifndef INCLUDED_volk_gnsssdr_8i_x2_interleave_8ic_H
+#define INCLUDED_volk_gnsssdr_8i_x2_interleave_8ic_H
+
+#include <volk_gnsssdr/volk_gnsssdr_complex.h>
+#include <stdint.h>
+
+
+#ifdef LV_HAVE_GENERIC
+
+static inline void volk_gnsssdr_8i_x2_interleave_8ic_generic(lv_8sc_t* outVector, const int8_t* inVectorI, const int8_t* inVectorQ, unsigned int num_points)
+{
+    int8_t* out = (int8_t*)outVector;
+    unsigned int i;
+    for (i = 0; i < num_points; i++)
+        {
+            *out++ = inVectorI[i];
+            *out++ = inVectorQ[i];
+        }
+}
+
+#endif /* LV_HAVE_GENERIC */
+
+
+#ifdef LV_HAVE_SSE2
+#include <emmintrin.h>
+
+static inline void volk_gnsssdr_8i_x2_interleave_8ic_u_sse2(lv_8sc_t* outVector, const int8_t* inVectorI, const int8_t* inVectorQ, unsigned int num_points)
+{
+    const unsigned int sse_iters = num_points / 16;
+    int8_t* out = (int8_t*)outVector;
+    __m128i i_reg, q_reg;
+    unsigned int number;
+    for (number = 0; number < sse_iters; number++)
+        {
+            i_reg = _mm_loadu_si128((const __m128i*)inVectorI);
+            q_reg = _mm_loadu_si128((const __m128i*)inVectorQ);
+            _mm_storeu_si128((__m128i*)out, _mm_unpacklo_epi8(i_reg, q_reg));
+            _mm_storeu_si128((__m128i*)(out + 16), _mm_unpackhi_epi8(i_reg, q_reg));
+            out += 32;
+            inVectorI += 16;
+            inVectorQ += 16;
+        }
+    for (number = sse_iters * 16; number < num_points; number++)
+        {
+            *out++ = *inVectorI++;
+            *out++ = *inVectorQ++;
+        }
+}
+
+#endif /* LV_HAVE_SSE2 */
+
+
+#ifdef LV_HAVE_AVX2
+#include <immintrin.h>
+
+static inline void volk_gnsssdr_8i_x2_interleave_8ic_u_avx2(lv_8sc_t* outVector, const int8_t* inVectorI, const int8_t* inVectorQ, unsigned int num_points)
+{
+    const unsigned int avx2_iters = num_points / 32;
+    int8_t* out = (int8_t*)outVector;
+    __m256i i_reg, q_reg, a, b;
+    unsigned int number;
+    for (number = 0; number < avx2_iters; number++)
+        {
+            i_reg = _mm256_loadu_si256((const __m256i*)inVectorI);
+            q_reg = _mm256_loadu_si256((const __m256i*)inVectorQ);
+            /* The unpacks work within each 128-bit lane: bring the lanes back in input order */
+            a = _mm256_unpacklo_epi8(i_reg, q_reg);
+            b = _mm256_unpackhi_epi8(i_reg, q_reg);
+            _mm256_storeu_si256((__m256i*)out, _mm256_permute2x128_si256(a, b, 0x20));
+            _mm256_storeu_si256((__m256i*)(out + 32), _mm256_permute2x128_si256(a, b, 0x31));
+            out += 64;
+            inVectorI += 32;
+            inVectorQ += 32;
+        }
+    for (number = avx2_iters * 32; number < num_points; number++)
+        {
+            *out++ = *inVectorI++;
+            *out++ = *inVectorQ++;
+        }
+}
+
+#endif /* LV_HAVE_AVX2 */
+
+
+#ifdef LV_HAVE_NEONV7
+#include <arm_neon.h>
+
+static inline void volk_gnsssdr_8i_x2_interleave_8ic_neon(lv_8sc_t* outVector, const int8_t* inVectorI, const int8_t* inVectorQ, unsigned int num_points)
+{
+    const unsigned int neon_iters = num_points / 16;
+    int8_t* out = (int8_t*)outVector;
+    int8x16x2_t v;
+    unsigned int number;
+    for (number = 0; number < neon_iters; number++)
+        {
+            v.val[0] = vld1q_s8(inVectorI);
+            v.val[1] = vld1q_s8(inVectorQ);
+            vst2q_s8(out, v);
+            out += 32;
+            inVectorI += 16;
+            inVectorQ += 16;
+        }
+    for (number = neon_iters * 16; number < num_points; number++)
+        {
+            *out++ = *inVectorI++;
+            *out++ = *inVectorQ++;
+        }
+}
+
+#endif /* LV_HAVE_NEONV7 */
+
+#endif /* INCLUDED_volk_gnsssdr_8i_x2_interleave_8ic_H */
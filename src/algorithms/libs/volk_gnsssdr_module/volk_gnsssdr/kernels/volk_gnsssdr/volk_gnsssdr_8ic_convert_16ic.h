@@ -0,0 +1,158 @@
+/*!
+ * \file volk_gnsssdr_8ic_convert_16ic.h
+ * \brief VOLK_GNSSSDR kernel: converts 8-bit integer complex values to 16-bit integer complex values.
+ *
+ * VOLK_GNSSSDR kernel that sign-extends each component of a complex vector
+ * of 8-bit integers to 16 bits, without any scaling.
+ *
+ * -------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2018  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *          Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------
+ */
+
+/*!
+ * \page volk_gnsssdr_8ic_convert_16ic
+ *
+ * \b Overview
+ *
+ * Converts a complex vector of 8-bit integer components into a complex vector
+ * of 16-bit integer components holding the same values.
+ *
+ * <b>Dispatcher Prototype</b>
+ * \code
+ * void volk_gnsssdr_8ic_convert_16ic(lv_16sc_t* outputVector, const lv_8sc_t* inputVector, unsigned int num_points)
+ * \endcode
+ *
+ * \b Inputs
+ * \li inputVector:  The complex 8-bit integer input data buffer.
+ * \li num_points:   The number of complex values to be converted.
+ *
+ * \b Outputs
+ * \li outputVector: The complex 16-bit integer output data buffer.
+ *
+ */
+
+#ifndef INCLUDED_volk_gnsssdr_8ic_convert_16ic_H
+#define INCLUDED_volk_gnsssdr_8ic_convert_16ic_H
+
+#include <volk_gnsssdr/volk_gnsssdr_complex.h>
+#include <stdint.h>
+
+
+#ifdef LV_HAVE_GENERIC
+
+static inline void volk_gnsssdr_8ic_convert_16ic_generic(lv_16sc_t* outputVector, const lv_8sc_t* inputVector, unsigned int num_points)
+{
+    const int8_t* in = (const int8_t*)inputVector;
+    int16_t* out = (int16_t*)outputVector;
+    unsigned int i;
+    for (i = 0; i < 2 * num_points; i++)
+        {
+            out[i] = (int16_t)in[i];
+        }
+}
+
+#endif /* LV_HAVE_GENERIC */
+
+
+#ifdef LV_HAVE_SSE4_1
+#include <smmintrin.h>
+
+static inline void volk_gnsssdr_8ic_convert_16ic_u_sse4_1(lv_16sc_t* outputVector, const lv_8sc_t* inputVector, unsigned int num_points)
+{
+    const unsigned int sse_iters = num_points / 8;
+    const int8_t* in = (const int8_t*)inputVector;
+    int16_t* out = (int16_t*)outputVector;
+    __m128i x;
+    unsigned int number;
+    for (number = 0; number < sse_iters; number++)
+        {
+            x = _mm_loadu_si128((const __m128i*)in);
+            _mm_storeu_si128((__m128i*)out, _mm_cvtepi8_epi16(x));
+            _mm_storeu_si128((__m128i*)(out + 8), _mm_cvtepi8_epi16(_mm_srli_si128(x, 8)));
+            out += 16;
+            in += 16;
+        }
+    for (number = sse_iters * 16; number < 2 * num_points; number++)
+        {
+            *out++ = (int16_t)(*in++);
+        }
+}
+
+#endif /* LV_HAVE_SSE4_1 */
+
+
+#ifdef LV_HAVE_AVX2
+#include <immintrin.h>
+
+static inline void volk_gnsssdr_8ic_convert_16ic_u_avx2(lv_16sc_t* outputVector, const lv_8sc_t* inputVector, unsigned int num_points)
+{
+    const unsigned int avx2_iters = num_points / 16;
+    const int8_t* in = (const int8_t*)inputVector;
+    int16_t* out = (int16_t*)outputVector;
+    __m256i x;
+    unsigned int number;
+    for (number = 0; number < avx2_iters; number++)
+        {
+            x = _mm256_loadu_si256((const __m256i*)in);
+            _mm256_storeu_si256((__m256i*)out, _mm256_cvtepi8_epi16(_mm256_castsi256_si128(x)));
+            _mm256_storeu_si256((__m256i*)(out + 16), _mm256_cvtepi8_epi16(_mm256_extracti128_si256(x, 1)));
+            out += 32;
+            in += 32;
+        }
+    for (number = avx2_iters * 32; number < 2 * num_points; number++)
+        {
+            *out++ = (int16_t)(*in++);
+        }
+}
+
+#endif /* LV_HAVE_AVX2 */
+
+
+#ifdef LV_HAVE_NEONV7
+#include <arm_neon.h>
+
+static inline void volk_gnsssdr_8ic_convert_16ic_neon(lv_16sc_t* outputVector, const lv_8sc_t* inputVector, unsigned int num_points)
+{
+    const unsigned int neon_iters = num_points / 8;
+    const int8_t* in = (const int8_t*)inputVector;
+    int16_t* out = (int16_t*)outputVector;
+    int8x16_t x;
+    unsigned int number;
+    for (number = 0; number < neon_iters; number++)
+        {
+            x = vld1q_s8(in);
+            vst1q_s16(out, vmovl_s8(vget_low_s8(x)));
+            vst1q_s16(out + 8, vmovl_s8(vget_high_s8(x)));
+            out += 16;
+            in += 16;
+        }
+    for (number = neon_iters * 16; number < 2 * num_points; number++)
+        {
+            *out++ = (int16_t)(*in++);
+        }
+}
+
+#endif /* LV_HAVE_NEONV7 */
+
+#endif /* INCLUDED_volk_gnsssdr_8ic_convert_16ic_H */
@@ -0,0 +1,204 @@
+/*!
+ * \file volk_gnsssdr_8ic_deinterleave_32fc_xn.h
+ * \brief VOLK_GNSSSDR kernel: converts interleaved 8-bit complex channels to floats.
+ *
+ * VOLK_GNSSSDR kernel that splits a stream of 8-bit complex samples from several
+ * interleaved channels into one vector of 32-bit float complex samples per channel.
+ *
+ * -------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2018  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *          Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------
+ */
+
+/*!
+ * \page volk_gnsssdr_8ic_deinterleave_32fc_xn
+ *
+ * \b Overview
+ *
+ * VOLK_GNSSSDR kernel that takes \p num_points samples of each of \p num_out_vectors
+ * channels, stored channel after channel for every sample instant, and writes the
+ * samples of channel \a c, converted to float, into <tt>outVectors[c]</tt>. If
+ * \p swap_iq is not zero, the first byte of each sample is taken as the quadrature
+ * component. The SIMD versions handle one, two or four channels and fall back to the
+ * generic loop otherwise.
+ *
+ * <b>Dispatcher Prototype</b>
+ * \code
+ * void volk_gnsssdr_8ic_deinterleave_32fc_xn(lv_32fc_t** outVectors, const lv_8sc_t* inVector, int swap_iq, int num_out_vectors, unsigned int num_points)
+ * \endcode
+ *
+ * \b Inputs
+ * \li inVector:        \p num_points * \p num_out_vectors interleaved samples.
+ * \li swap_iq:         Swap the in-phase and quadrature components if not zero.
+ * \li num_out_vectors: Number of interleaved channels.
+ * \li num_points:      Number of samples per channel.
+ *
+ * \b Outputs
+ * \li outVectors:      \p num_points samples for each channel.
+ *
+ */
+
+#ifndef INCLUDED_volk_gnsssdr_8ic_deinterleave_32fc_xn_H
+#define INCLUDED_volk_gnsssdr_8ic_deinterleave_32fc_xn_H
+
+#include <volk_gnsssdr/volk_gnsssdr_common.h>
+#include <volk_gnsssdr/volk_gnsssdr_complex.h>
+#include <stdint.h>
+
+
+static inline void volk_gnsssdr_8ic_deinterleave_32fc_xn_tail(lv_32fc_t** outVectors, const int8_t* in, int swap_iq, int num_out_vectors, unsigned int first_point, unsigned int num_points)
+{
+    unsigned int n;
+    int c;
+    float* out;
+    for (n = first_point; n < num_points; n++)
+        {
+            for (c = 0; c < num_out_vectors; c++)
+                {
+                    out = (float*)(outVectors[c] + n);
+                    out[0] = (float)in[swap_iq ? 1 : 0];
+                    out[1] = (float)in[swap_iq ? 0 : 1];
+                    in += 2;
+                }
+        }
+}
+
+
+#ifdef LV_HAVE_GENERIC
+
+static inline void volk_gnsssdr_8ic_deinterleave_32fc_xn_generic(lv_32fc_t** outVectors, const lv_8sc_t* inVector, int swap_iq, int num_out_vectors, unsigned int num_points)
+{
+    volk_gnsssdr_8ic_deinterleave_32fc_xn_tail(outVectors, (const int8_t*)inVector, swap_iq, num_out_vectors, 0, num_points);
+}
+
+#endif /* LV_HAVE_GENERIC */
+
+
+#if defined(LV_HAVE_SSE4_1) || defined(LV_HAVE_AVX2)
+#include <smmintrin.h>
+
+/* Byte shuffle that gathers, within 16 bytes of input, the bytes of each channel
+ * into 16 / num_out_vectors contiguous bytes, swapping I and Q on request */
+static inline __m128i volk_gnsssdr_8ic_deinterleave_32fc_xn_mask(int swap_iq, int num_out_vectors)
+{
+    int8_t mask[16];
+    const int per_channel = 8 / num_out_vectors;
+    int c, j, b;
+    for (c = 0; c < num_out_vectors; c++)
+        {
+            for (j = 0; j < per_channel; j++)
+                {
+                    for (b = 0; b < 2; b++)
+                        {
+                            mask[c * 2 * per_channel + j * 2 + b] = (int8_t)((j * num_out_vectors + c) * 2 + (swap_iq ? 1 - b : b));
+                        }
+                }
+        }
+    return _mm_loadu_si128((const __m128i*)mask);
+}
+
+#endif /* defined(LV_HAVE_SSE4_1) || defined(LV_HAVE_AVX2) */
+
+
+#ifdef LV_HAVE_SSE4_1
+#include <smmintrin.h>
+
+static inline void volk_gnsssdr_8ic_deinterleave_32fc_xn_u_sse4_1(lv_32fc_t** outVectors, const lv_8sc_t* inVector, int swap_iq, int num_out_vectors, unsigned int num_points)
+{
+    const int8_t* in = (const int8_t*)inVector;
+    unsigned int number = 0;
+    if (num_out_vectors == 1 || num_out_vectors == 2 || num_out_vectors == 4)
+        {
+            /* Each 16-byte load holds 8 / num_out_vectors samples of every channel,
+             * converted in four chunks of two samples */
+            const unsigned int step = 8 / num_out_vectors;
+            const int chunks_per_channel = 4 / num_out_vectors;
+            const unsigned int sse_iters = num_points / step;
+            const __m128i mask = volk_gnsssdr_8ic_deinterleave_32fc_xn_mask(swap_iq, num_out_vectors);
+            __m128i x;
+            __m128 f[4];
+            unsigned int n;
+            int i;
+            for (n = 0; n < sse_iters; n++)
+                {
+                    x = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*)in), mask);
+                    f[0] = _mm_cvtepi32_ps(_mm_cvtepi8_epi32(x));
+                    f[1] = _mm_cvtepi32_ps(_mm_cvtepi8_epi32(_mm_srli_si128(x, 4)));
+                    f[2] = _mm_cvtepi32_ps(_mm_cvtepi8_epi32(_mm_srli_si128(x, 8)));
+                    f[3] = _mm_cvtepi32_ps(_mm_cvtepi8_epi32(_mm_srli_si128(x, 12)));
+                    for (i = 0; i < 4; i++)
+                        {
+                            _mm_storeu_ps((float*)(outVectors[i / chunks_per_channel] + number + 2 * (i % chunks_per_channel)), f[i]);
+                        }
+                    number += step;
+                    in += 16;
+                }
+        }
+    volk_gnsssdr_8ic_deinterleave_32fc_xn_tail(outVectors, in, swap_iq, num_out_vectors, number, num_points);
+}
+
+#endif /* LV_HAVE_SSE4_1 */
+
+
+#ifdef LV_HAVE_AVX2
+#include <immintrin.h>
+
+static inline void volk_gnsssdr_8ic_deinterleave_32fc_xn_u_avx2(lv_32fc_t** outVectors, const lv_8sc_t* inVector, int swap_iq, int num_out_vectors, unsigned int num_points)
+{
+    const int8_t* in = (const int8_t*)inVector;
+    unsigned int number = 0;
+    if (num_out_vectors == 1 || num_out_vectors == 2)
+        {
+            /* Each 128-bit lane of a 32-byte load holds 8 / num_out_vectors samples of
+             * every channel, converted in two chunks of four samples */
+            const unsigned int lane_step = 8 / num_out_vectors;
+            const int chunks_per_channel = 2 / num_out_vectors;
+            const unsigned int avx2_iters = num_points / (2 * lane_step);
+            const __m256i mask = _mm256_broadcastsi128_si256(volk_gnsssdr_8ic_deinterleave_32fc_xn_mask(swap_iq, num_out_vectors));
+            __m256i y;
+            __m128i lane[2];
+            unsigned int n;
+            int l, h;
+            for (n = 0; n < avx2_iters; n++)
+                {
+                    y = _mm256_shuffle_epi8(_mm256_loadu_si256((const __m256i*)in), mask);
+                    lane[0] = _mm256_castsi256_si128(y);
+                    lane[1] = _mm256_extracti128_si256(y, 1);
+                    for (l = 0; l < 2; l++)
+                        {
+                            for (h = 0; h < 2; h++)
+                                {
+                                    _mm256_storeu_ps((float*)(outVectors[h / chunks_per_channel] + number + l * lane_step + 4 * (h % chunks_per_channel)),
+                                        _mm256_cvtepi32_ps(_mm256_cvtepi8_epi32(h ? _mm_srli_si128(lane[l], 8) : lane[l])));
+                                }
+                        }
+                    number += 2 * lane_step;
+                    in += 32;
+                }
+        }
+    volk_gnsssdr_8ic_deinterleave_32fc_xn_tail(outVectors, in, swap_iq, num_out_vectors, number, num_points);
+}
+
+#endif /* LV_HAVE_AVX2 */
+
+#endif /* INCLUDED_volk_gnsssdr_8ic_deinterleave_32fc_xn_H */
@@ -0,0 +1,83 @@
+/*!
+ * \file volk_gnsssdr_8ic_deinterleavexnpuppet_32fc.h
+ * \brief VOLK_GNSSSDR puppet for the volk_gnsssdr_8ic_deinterleave_32fc_xn kernel.
+ *
+ * VOLK_GNSSSDR puppet for integrating the channel deinterleaver into the test system.
+ *
+ * -------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2018  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *          Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------
+ */
+
+#ifndef INCLUDED_volk_gnsssdr_8ic_deinterleavexnpuppet_32fc_H
+#define INCLUDED_volk_gnsssdr_8ic_deinterleavexnpuppet_32fc_H
+
+#include "volk_gnsssdr/volk_gnsssdr_8ic_deinterleave_32fc_xn.h"
+#include <volk_gnsssdr/volk_gnsssdr_complex.h>
+
+
+/* Two swapped channels of num_points / 2 samples, written one after the other */
+static inline void volk_gnsssdr_8ic_deinterleavexnpuppet_32fc_split(lv_32fc_t** outVectors, lv_32fc_t* outVector, unsigned int num_points)
+{
+    outVectors[0] = outVector;
+    outVectors[1] = outVector + num_points / 2;
+    if (num_points % 2)
+        {
+            outVector[num_points - 1] = lv_cmake(0.0F, 0.0F);
+        }
+}
+
+
+#ifdef LV_HAVE_GENERIC
+static inline void volk_gnsssdr_8ic_deinterleavexnpuppet_32fc_generic(lv_32fc_t* outVector, const lv_8sc_t* inVector, unsigned int num_points)
+{
+    lv_32fc_t* outVectors[2];
+    volk_gnsssdr_8ic_deinterleavexnpuppet_32fc_split(outVectors, outVector, num_points);
+    volk_gnsssdr_8ic_deinterleave_32fc_xn_generic(outVectors, inVector, 1, 2, num_points / 2);
+}
+
+#endif /* LV_HAVE_GENERIC */
+
+
+#ifdef LV_HAVE_SSE4_1
+static inline void volk_gnsssdr_8ic_deinterleavexnpuppet_32fc_u_sse4_1(lv_32fc_t* outVector, const lv_8sc_t* inVector, unsigned int num_points)
+{
+    lv_32fc_t* outVectors[2];
+    volk_gnsssdr_8ic_deinterleavexnpuppet_32fc_split(outVectors, outVector, num_points);
+    volk_gnsssdr_8ic_deinterleave_32fc_xn_u_sse4_1(outVectors, inVector, 1, 2, num_points / 2);
+}
+
+#endif /* LV_HAVE_SSE4_1 */
+
+
+#ifdef LV_HAVE_AVX2
+static inline void volk_gnsssdr_8ic_deinterleavexnpuppet_32fc_u_avx2(lv_32fc_t* outVector, const lv_8sc_t* inVector, unsigned int num_points)
+{
+    lv_32fc_t* outVectors[2];
+    volk_gnsssdr_8ic_deinterleavexnpuppet_32fc_split(outVectors, outVector, num_points);
+    volk_gnsssdr_8ic_deinterleave_32fc_xn_u_avx2(outVectors, inVector, 1, 2, num_points / 2);
+}
+
+#endif /* LV_HAVE_AVX2 */
+
+#endif /* INCLUDED_volk_gnsssdr_8ic_deinterleavexnpuppet_32fc_H */
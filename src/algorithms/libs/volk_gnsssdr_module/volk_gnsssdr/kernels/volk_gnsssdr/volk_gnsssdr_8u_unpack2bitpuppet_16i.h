@@ -0,0 +1,106 @@
+/*!
+ * \file volk_gnsssdr_8u_unpack2bitpuppet_16i.h
+ * \brief VOLK_GNSSSDR puppet for the volk_gnsssdr_8u_unpack_2bit_16i kernel.
+ *
+ * VOLK_GNSSSDR puppet for integrating the 2-bit unpacker into the test system.
+ *
+ * -------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2018  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *          Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------
+ */
+
+#ifndef INCLUDED_volk_gnsssdr_8u_unpack2bitpuppet_16i_H
+#define INCLUDED_volk_gnsssdr_8u_unpack2bitpuppet_16i_H
+
+#include "volk_gnsssdr/volk_gnsssdr_8u_unpack_2bit_16i.h"
+#include <stdint.h>
+
+
+#ifdef LV_HAVE_GENERIC
+static inline void volk_gnsssdr_8u_unpack2bitpuppet_16i_generic(int16_t* outVector, const uint8_t* inVector, unsigned int num_points)
+{
+    /* Two's complement codes mapped to 2 * code + 1, in the field order of a complex I/Q swapped byte */
+    const int8_t lut[4] = {1, 3, -3, -1};
+    const uint8_t order[4] = {2, 3, 0, 1};
+    unsigned int n;
+    volk_gnsssdr_8u_unpack_2bit_16i_generic(outVector, inVector, lut, order, num_points / 4);
+    for (n = num_points - num_points % 4; n < num_points; n++)
+        {
+            outVector[n] = 0;
+        }
+}
+
+#endif /* LV_HAVE_GENERIC */
+
+
+#ifdef LV_HAVE_SSSE3
+static inline void volk_gnsssdr_8u_unpack2bitpuppet_16i_u_ssse3(int16_t* outVector, const uint8_t* inVector, unsigned int num_points)
+{
+    /* Two's complement codes mapped to 2 * code + 1, in the field order of a complex I/Q swapped byte */
+    const int8_t lut[4] = {1, 3, -3, -1};
+    const uint8_t order[4] = {2, 3, 0, 1};
+    unsigned int n;
+    volk_gnsssdr_8u_unpack_2bit_16i_u_ssse3(outVector, inVector, lut, order, num_points / 4);
+    for (n = num_points - num_points % 4; n < num_points; n++)
+        {
+            outVector[n] = 0;
+        }
+}
+
+#endif /* LV_HAVE_SSSE3 */
+
+
+#ifdef LV_HAVE_AVX2
+static inline void volk_gnsssdr_8u_unpack2bitpuppet_16i_u_avx2(int16_t* outVector, const uint8_t* inVector, unsigned int num_points)
+{
+    /* Two's complement codes mapped to 2 * code + 1, in the field order of a complex I/Q swapped byte */
+    const int8_t lut[4] = {1, 3, -3, -1};
+    const uint8_t order[4] = {2, 3, 0, 1};
+    unsigned int n;
+    volk_gnsssdr_8u_unpack_2bit_16i_u_avx2(outVector, inVector, lut, order, num_points / 4);
+    for (n = num_points - num_points % 4; n < num_points; n++)
+        {
+            outVector[n] = 0;
+        }
+}
+
+#endif /* LV_HAVE_AVX2 */
+
+
+#ifdef LV_HAVE_NEONV7
+static inline void volk_gnsssdr_8u_unpack2bitpuppet_16i_neon(int16_t* outVector, const uint8_t* inVector, unsigned int num_points)
+{
+    /* Two's complement codes mapped to 2 * code + 1, in the field order of a complex I/Q swapped byte */
+    const int8_t lut[4] = {1, 3, -3, -1};
+    const uint8_t order[4] = {2, 3, 0, 1};
+    unsigned int n;
+    volk_gnsssdr_8u_unpack_2bit_16i_neon(outVector, inVector, lut, order, num_points / 4);
+    for (n = num_points - num_points % 4; n < num_points; n++)
+        {
+            outVector[n] = 0;
+        }
+}
+
+#endif /* LV_HAVE_NEONV7 */
+
+#endif /* INCLUDED_volk_gnsssdr_8u_unpack2bitpuppet_16i_H */
@@ -0,0 +1,205 @@
+/*!
+ * \file volk_gnsssdr_8u_unpack_2bit_32f.h
+ * \brief VOLK_GNSSSDR kernel: unpacks 2-bit samples into floats through a look-up table.
+ *
+ * VOLK_GNSSSDR kernel that expands each byte of its input into four
+ * floating point samples, mapping every 2-bit field through a table of four values.
+ *
+ * -------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2018  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *          Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------
+ */
+
+/*!
+ * \page volk_gnsssdr_8u_unpack_2bit_32f
+ *
+ * \b Overview
+ *
+ * Same as volk_gnsssdr_8u_unpack_2bit_8i, with the samples converted to float
+ * on the way out.
+ *
+ * <b>Dispatcher Prototype</b>
+ * \code
+ * void volk_gnsssdr_8u_unpack_2bit_32f(float* outVector, const unsigned char* inVector, const char* lut, const unsigned char* order, unsigned int num_bytes)
+ * \endcode
+ *
+ * \b Inputs
+ * \li inVector:       Packed samples.
+ * \li lut:            Values of the four 2-bit codes.
+ * \li order:          Fields of a byte, 0 to 3, in output order.
+ * \li num_bytes:      Number of bytes in \p inVector.
+ *
+ * \b Outputs
+ * \li outVector:      4 * \p num_bytes unpacked samples.
+ *
+ */
+
+#ifndef INCLUDED_volk_gnsssdr_8u_unpack_2bit_32f_H
+#define INCLUDED_volk_gnsssdr_8u_unpack_2bit_32f_H
+
+#include "volk_gnsssdr/volk_gnsssdr_8u_unpack_2bit_8i.h"
+#include <volk_gnsssdr/volk_gnsssdr_common.h>
+#include <stdint.h>
+
+
+#ifdef LV_HAVE_GENERIC
+
+static inline void volk_gnsssdr_8u_unpack_2bit_32f_generic(float* outVector, const uint8_t* inVector, const int8_t* lut, const uint8_t* order, unsigned int num_bytes)
+{
+    unsigned int shifts[4];
+    unsigned int n;
+    int k;
+    for (k = 0; k < 4; k++)
+        {
+            shifts[k] = 2 * (order[k] & 3);
+        }
+    for (n = 0; n < num_bytes; n++)
+        {
+            for (k = 0; k < 4; k++)
+                {
+                    *outVector++ = (float)lut[(inVector[n] >> shifts[k]) & 3];
+                }
+        }
+}
+
+#endif /* LV_HAVE_GENERIC */
+
+
+#ifdef LV_HAVE_SSSE3
+#include <tmmintrin.h>
+
+static inline void volk_gnsssdr_8u_unpack_2bit_32f_u_ssse3(float* outVector, const uint8_t* inVector, const int8_t* lut, const uint8_t* order, unsigned int num_bytes)
+{
+    const unsigned int sse_iters = num_bytes / 16;
+    __m128i lut_reg, shifts[4], out[4], lo, hi;
+    unsigned int number;
+    int k;
+    volk_gnsssdr_8u_unpack_2bit_8i_ssse3_setup(&lut_reg, shifts, lut, order);
+    for (number = 0; number < sse_iters; number++)
+        {
+            volk_gnsssdr_8u_unpack_2bit_8i_ssse3_block(out, _mm_loadu_si128((const __m128i*)inVector), lut_reg, shifts);
+            for (k = 0; k < 4; k++)
+                {
+                    /* Each byte in the upper quarter of a word, then an arithmetic shift */
+                    lo = _mm_unpacklo_epi8(out[k], out[k]);
+                    hi = _mm_unpackhi_epi8(out[k], out[k]);
+                    _mm_storeu_ps(outVector, _mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpacklo_epi16(lo, lo), 24)));
+                    _mm_storeu_ps(outVector + 4, _mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpackhi_epi16(lo, lo), 24)));
+                    _mm_storeu_ps(outVector + 8, _mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpacklo_epi16(hi, hi), 24)));
+                    _mm_storeu_ps(outVector + 12, _mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpackhi_epi16(hi, hi), 24)));
+                    outVector += 16;
+                }
+            inVector += 16;
+        }
+    for (number = sse_iters * 16; number < num_bytes; number++)
+        {
+            for (k = 0; k < 4; k++)
+                {
+                    *outVector++ = (float)lut[(*inVector >> (2 * (order[k] & 3))) & 3];
+                }
+            inVector++;
+        }
+}
+
+#endif /* LV_HAVE_SSSE3 */
+
+
+#ifdef LV_HAVE_AVX2
+#include <immintrin.h>
+
+static inline void volk_gnsssdr_8u_unpack_2bit_32f_u_avx2(float* outVector, const uint8_t* inVector, const int8_t* lut, const uint8_t* order, unsigned int num_bytes)
+{
+    const unsigned int avx2_iters = num_bytes / 32;
+    __m256i lut_reg, out[4];
+    __m128i shifts[4], lo, hi;
+    unsigned int number;
+    int k;
+    volk_gnsssdr_8u_unpack_2bit_8i_avx2_setup(&lut_reg, shifts, lut, order);
+    for (number = 0; number < avx2_iters; number++)
+        {
+            volk_gnsssdr_8u_unpack_2bit_8i_avx2_block(out, _mm256_loadu_si256((const __m256i*)inVector), lut_reg, shifts);
+            for (k = 0; k < 4; k++)
+                {
+                    lo = _mm256_castsi256_si128(out[k]);
+                    hi = _mm256_extracti128_si256(out[k], 1);
+                    _mm256_storeu_ps(outVector, _mm256_cvtepi32_ps(_mm256_cvtepi8_epi32(lo)));
+                    _mm256_storeu_ps(outVector + 8, _mm256_cvtepi32_ps(_mm256_cvtepi8_epi32(_mm_srli_si128(lo, 8))));
+                    _mm256_storeu_ps(outVector + 16, _mm256_cvtepi32_ps(_mm256_cvtepi8_epi32(hi)));
+                    _mm256_storeu_ps(outVector + 24, _mm256_cvtepi32_ps(_mm256_cvtepi8_epi32(_mm_srli_si128(hi, 8))));
+                    outVector += 32;
+                }
+            inVector += 32;
+        }
+    for (number = avx2_iters * 32; number < num_bytes; number++)
+        {
+            for (k = 0; k < 4; k++)
+                {
+                    *outVector++ = (float)lut[(*inVector >> (2 * (order[k] & 3))) & 3];
+                }
+            inVector++;
+        }
+}
+
+#endif /* LV_HAVE_AVX2 */
+
+
+#ifdef LV_HAVE_NEONV7
+#include <arm_neon.h>
+
+static inline void volk_gnsssdr_8u_unpack_2bit_32f_neon(float* outVector, const uint8_t* inVector, const int8_t* lut, const uint8_t* order, unsigned int num_bytes)
+{
+    const unsigned int neon_iters = num_bytes / 8;
+    int8x8_t lut_reg, shifts[4];
+    int8x8x4_t v;
+    int16x8_t w[4];
+    float32x4x4_t lo, hi;
+    unsigned int number;
+    int k;
+    volk_gnsssdr_8u_unpack_2bit_8i_neon_setup(&lut_reg, shifts, lut, order);
+    for (number = 0; number < neon_iters; number++)
+        {
+            v = volk_gnsssdr_8u_unpack_2bit_8i_neon_block(vld1_u8(inVector), lut_reg, shifts);
+            for (k = 0; k < 4; k++)
+                {
+                    w[k] = vmovl_s8(v.val[k]);
+                    lo.val[k] = vcvtq_f32_s32(vmovl_s16(vget_low_s16(w[k])));
+                    hi.val[k] = vcvtq_f32_s32(vmovl_s16(vget_high_s16(w[k])));
+                }
+            vst4q_f32(outVector, lo);
+            vst4q_f32(outVector + 16, hi);
+            outVector += 32;
+            inVector += 8;
+        }
+    for (number = neon_iters * 8; number < num_bytes; number++)
+        {
+            for (k = 0; k < 4; k++)
+                {
+                    *outVector++ = (float)lut[(*inVector >> (2 * (order[k] & 3))) & 3];
+                }
+            inVector++;
+        }
+}
+
+#endif /* LV_HAVE_NEONV7 */
+
+#endif /* INCLUDED_volk_gnsssdr_8u_unpack_2bit_32f_H */
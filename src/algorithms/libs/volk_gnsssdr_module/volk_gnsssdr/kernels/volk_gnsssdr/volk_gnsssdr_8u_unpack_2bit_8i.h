@@ -0,0 +1,275 @@
+/*!
+ * \file volk_gnsssdr_8u_unpack_2bit_8i.h
+ * \brief VOLK_GNSSSDR kernel: unpacks 2-bit samples into bytes through a look-up table.
+ *
+ * VOLK_GNSSSDR kernel that expands each byte of its input into four 8-bit
+ * samples, mapping every 2-bit field through a table of four values.
+ *
+ * -------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2018  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *          Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------
+ */
+
+/*!
+ * \page volk_gnsssdr_8u_unpack_2bit_8i
+ *
+ * \b Overview
+ *
+ * VOLK_GNSSSDR kernel that unpacks \p num_bytes bytes holding four 2-bit samples each.
+ * The field \c f of a byte is made of its bits <tt>2f + 1</tt> and \c 2f, and the \c k-th
+ * output sample of the byte is <tt>lut[field order[k]]</tt>. The SIMD versions extract
+ * each field with a shift and a mask and map it with a byte shuffle.
+ *
+ * <b>Dispatcher Prototype</b>
+ * \code
+ * void volk_gnsssdr_8u_unpack_2bit_8i(char* outVector, const unsigned char* inVector, const char* lut, const unsigned char* order, unsigned int num_bytes)
+ * \endcode
+ *
+ * \b Inputs
+ * \li inVector:       Packed samples.
+ * \li lut:            Values of the four 2-bit codes.
+ * \li order:          Fields of a byte, 0 to 3, in output order.
+ * \li num_bytes:      Number of bytes in \p inVector.
+ *
+ * \b Outputs
+ * \li outVector:      4 * \p num_bytes unpacked samples.
+ *
+ */
+
+#ifndef INCLUDED_volk_gnsssdr_8u_unpack_2bit_8i_H
+#define INCLUDED_volk_gnsssdr_8u_unpack_2bit_8i_H
+
+#include <volk_gnsssdr/volk_gnsssdr_common.h>
+#include <stdint.h>
+
+
+#ifdef LV_HAVE_GENERIC
+
+static inline void volk_gnsssdr_8u_unpack_2bit_8i_generic(int8_t* outVector, const uint8_t* inVector, const int8_t* lut, const uint8_t* order, unsigned int num_bytes)
+{
+    unsigned int shifts[4];
+    unsigned int n;
+    int k;
+    for (k = 0; k < 4; k++)
+        {
+            shifts[k] = 2 * (order[k] & 3);
+        }
+    for (n = 0; n < num_bytes; n++)
+        {
+            for (k = 0; k < 4; k++)
+                {
+                    *outVector++ = lut[(inVector[n] >> shifts[k]) & 3];
+                }
+        }
+}
+
+#endif /* LV_HAVE_GENERIC */
+
+
+#ifdef LV_HAVE_SSSE3
+#include <tmmintrin.h>
+
+static inline void volk_gnsssdr_8u_unpack_2bit_8i_ssse3_setup(__m128i* lut_reg, __m128i* shifts, const int8_t* lut, const uint8_t* order)
+{
+    int k;
+    *lut_reg = _mm_setr_epi8(lut[0], lut[1], lut[2], lut[3], 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0);
+    for (k = 0; k < 4; k++)
+        {
+            shifts[k] = _mm_cvtsi32_si128(2 * (order[k] & 3));
+        }
+}
+
+
+/* Unpacks 16 bytes into out[0] to out[3], in output order */
+static inline void volk_gnsssdr_8u_unpack_2bit_8i_ssse3_block(__m128i* out, const __m128i x, const __m128i lut_reg, const __m128i* shifts)
+{
+    const __m128i mask = _mm_set1_epi8(3);
+    const __m128i v0 = _mm_shuffle_epi8(lut_reg, _mm_and_si128(_mm_srl_epi16(x, shifts[0]), mask));
+    const __m128i v1 = _mm_shuffle_epi8(lut_reg, _mm_and_si128(_mm_srl_epi16(x, shifts[1]), mask));
+    const __m128i v2 = _mm_shuffle_epi8(lut_reg, _mm_and_si128(_mm_srl_epi16(x, shifts[2]), mask));
+    const __m128i v3 = _mm_shuffle_epi8(lut_reg, _mm_and_si128(_mm_srl_epi16(x, shifts[3]), mask));
+    const __m128i a_lo = _mm_unpacklo_epi8(v0, v1);
+    const __m128i a_hi = _mm_unpackhi_epi8(v0, v1);
+    const __m128i b_lo = _mm_unpacklo_epi8(v2, v3);
+    const __m128i b_hi = _mm_unpackhi_epi8(v2, v3);
+    out[0] = _mm_unpacklo_epi16(a_lo, b_lo);
+    out[1] = _mm_unpackhi_epi16(a_lo, b_lo);
+    out[2] = _mm_unpacklo_epi16(a_hi, b_hi);
+    out[3] = _mm_unpackhi_epi16(a_hi, b_hi);
+}
+
+
+static inline void volk_gnsssdr_8u_unpack_2bit_8i_u_ssse3(int8_t* outVector, const uint8_t* inVector, const int8_t* lut, const uint8_t* order, unsigned int num_bytes)
+{
+    const unsigned int sse_iters = num_bytes / 16;
+    __m128i lut_reg, shifts[4], out[4];
+    unsigned int number;
+    int k;
+    volk_gnsssdr_8u_unpack_2bit_8i_ssse3_setup(&lut_reg, shifts, lut, order);
+    for (number = 0; number < sse_iters; number++)
+        {
+            volk_gnsssdr_8u_unpack_2bit_8i_ssse3_block(out, _mm_loadu_si128((const __m128i*)inVector), lut_reg, shifts);
+            for (k = 0; k < 4; k++)
+                {
+                    _mm_storeu_si128((__m128i*)outVector, out[k]);
+                    outVector += 16;
+                }
+            inVector += 16;
+        }
+    for (number = sse_iters * 16; number < num_bytes; number++)
+        {
+            for (k = 0; k < 4; k++)
+                {
+                    *outVector++ = lut[(*inVector >> (2 * (order[k] & 3))) & 3];
+                }
+            inVector++;
+        }
+}
+
+#endif /* LV_HAVE_SSSE3 */
+
+
+#ifdef LV_HAVE_AVX2
+#include <immintrin.h>
+
+/* Unpacks 32 bytes into out[0] to out[3], in output order */
+static inline void volk_gnsssdr_8u_unpack_2bit_8i_avx2_block(__m256i* out, const __m256i x, const __m256i lut_reg, const __m128i* shifts)
+{
+    const __m256i mask = _mm256_set1_epi8(3);
+    const __m256i v0 = _mm256_shuffle_epi8(lut_reg, _mm256_and_si256(_mm256_srl_epi16(x, shifts[0]), mask));
+    const __m256i v1 = _mm256_shuffle_epi8(lut_reg, _mm256_and_si256(_mm256_srl_epi16(x, shifts[1]), mask));
+    const __m256i v2 = _mm256_shuffle_epi8(lut_reg, _mm256_and_si256(_mm256_srl_epi16(x, shifts[2]), mask));
+    const __m256i v3 = _mm256_shuffle_epi8(lut_reg, _mm256_and_si256(_mm256_srl_epi16(x, shifts[3]), mask));
+    const __m256i a_lo = _mm256_unpacklo_epi8(v0, v1);
+    const __m256i a_hi = _mm256_unpackhi_epi8(v0, v1);
+    const __m256i b_lo = _mm256_unpacklo_epi8(v2, v3);
+    const __m256i b_hi = _mm256_unpackhi_epi8(v2, v3);
+    /* The unpacks work within each 128-bit lane: bring the lanes back in input order */
+    const __m256i o0 = _mm256_unpacklo_epi16(a_lo, b_lo);
+    const __m256i o1 = _mm256_unpackhi_epi16(a_lo, b_lo);
+    const __m256i o2 = _mm256_unpacklo_epi16(a_hi, b_hi);
+    const __m256i o3 = _mm256_unpackhi_epi16(a_hi, b_hi);
+    out[0] = _mm256_permute2x128_si256(o0, o1, 0x20);
+    out[1] = _mm256_permute2x128_si256(o2, o3, 0x20);
+    out[2] = _mm256_permute2x128_si256(o0, o1, 0x31);
+    out[3] = _mm256_permute2x128_si256(o2, o3, 0x31);
+}
+
+
+static inline void volk_gnsssdr_8u_unpack_2bit_8i_avx2_setup(__m256i* lut_reg, __m128i* shifts, const int8_t* lut, const uint8_t* order)
+{
+    int k;
+    *lut_reg = _mm256_broadcastsi128_si256(_mm_setr_epi8(lut[0], lut[1], lut[2], lut[3], 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0));
+    for (k = 0; k < 4; k++)
+        {
+            shifts[k] = _mm_cvtsi32_si128(2 * (order[k] & 3));
+        }
+}
+
+
+static inline void volk_gnsssdr_8u_unpack_2bit_8i_u_avx2(int8_t* outVector, const uint8_t* inVector, const int8_t* lut, const uint8_t* order, unsigned int num_bytes)
+{
+    const unsigned int avx2_iters = num_bytes / 32;
+    __m256i lut_reg, out[4];
+    __m128i shifts[4];
+    unsigned int number;
+    int k;
+    volk_gnsssdr_8u_unpack_2bit_8i_avx2_setup(&lut_reg, shifts, lut, order);
+    for (number = 0; number < avx2_iters; number++)
+        {
+            volk_gnsssdr_8u_unpack_2bit_8i_avx2_block(out, _mm256_loadu_si256((const __m256i*)inVector), lut_reg, shifts);
+            for (k = 0; k < 4; k++)
+                {
+                    _mm256_storeu_si256((__m256i*)outVector, out[k]);
+                    outVector += 32;
+                }
+            inVector += 32;
+        }
+    for (number = avx2_iters * 32; number < num_bytes; number++)
+        {
+            for (k = 0; k < 4; k++)
+                {
+                    *outVector++ = lut[(*inVector >> (2 * (order[k] & 3))) & 3];
+                }
+            inVector++;
+        }
+}
+
+#endif /* LV_HAVE_AVX2 */
+
+
+#ifdef LV_HAVE_NEONV7
+#include <arm_neon.h>
+
+static inline void volk_gnsssdr_8u_unpack_2bit_8i_neon_setup(int8x8_t* lut_reg, int8x8_t* shifts, const int8_t* lut, const uint8_t* order)
+{
+    const int8_t lut_data[8] = {lut[0], lut[1], lut[2], lut[3], 0, 0, 0, 0};
+    int k;
+    *lut_reg = vld1_s8(lut_data);
+    for (k = 0; k < 4; k++)
+        {
+            shifts[k] = vdup_n_s8(-2 * (order[k] & 3));
+        }
+}
+
+
+/* Unpacks 8 bytes into the four fields of each byte, in output order */
+static inline int8x8x4_t volk_gnsssdr_8u_unpack_2bit_8i_neon_block(const uint8x8_t x, const int8x8_t lut_reg, const int8x8_t* shifts)
+{
+    const uint8x8_t mask = vdup_n_u8(3);
+    int8x8x4_t v;
+    v.val[0] = vtbl1_s8(lut_reg, vreinterpret_s8_u8(vand_u8(vshl_u8(x, shifts[0]), mask)));
+    v.val[1] = vtbl1_s8(lut_reg, vreinterpret_s8_u8(vand_u8(vshl_u8(x, shifts[1]), mask)));
+    v.val[2] = vtbl1_s8(lut_reg, vreinterpret_s8_u8(vand_u8(vshl_u8(x, shifts[2]), mask)));
+    v.val[3] = vtbl1_s8(lut_reg, vreinterpret_s8_u8(vand_u8(vshl_u8(x, shifts[3]), mask)));
+    return v;
+}
+
+
+static inline void volk_gnsssdr_8u_unpack_2bit_8i_neon(int8_t* outVector, const uint8_t* inVector, const int8_t* lut, const uint8_t* order, unsigned int num_bytes)
+{
+    const unsigned int neon_iters = num_bytes / 8;
+    int8x8_t lut_reg, shifts[4];
+    unsigned int number;
+    int k;
+    volk_gnsssdr_8u_unpack_2bit_8i_neon_setup(&lut_reg, shifts, lut, order);
+    for (number = 0; number < neon_iters; number++)
+        {
+            /* vst4 interleaves the fields back into output order */
+            vst4_s8(outVector, volk_gnsssdr_8u_unpack_2bit_8i_neon_block(vld1_u8(inVector), lut_reg, shifts));
+            outVector += 32;
+            inVector += 8;
+        }
+    for (number = neon_iters * 8; number < num_bytes; number++)
+        {
+            for (k = 0; k < 4; k++)
+                {
+                    *outVector++ = lut[(*inVector >> (2 * (order[k] & 3))) & 3];
+                }
+            inVector++;
+        }
+}
+
+#endif /* LV_HAVE_NEONV7 */
+
+#endif /* INCLUDED_volk_gnsssdr_8u_unpack_2bit_8i_H */
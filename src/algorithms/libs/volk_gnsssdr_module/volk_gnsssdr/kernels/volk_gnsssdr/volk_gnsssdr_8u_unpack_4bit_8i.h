@@ -0,0 +1,176 @@
+/*!
+ * \file volk_gnsssdr_8u_unpack_4bit_8i.h
+ * \brief VOLK_GNSSSDR kernel: unpacks 4-bit samples into bytes through a look-up table.
+ *
+ * VOLK_GNSSSDR kernel that expands each byte of its input into two 8-bit
+ * samples, mapping every nibble through a table of sixteen values.
+ *
+ * -------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2018  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *          Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------
+ */
+
+/*!
+ * \page volk_gnsssdr_8u_unpack_4bit_8i
+ *
+ * \b Overview
+ *
+ * VOLK_GNSSSDR kernel that unpacks \p num_bytes bytes holding two 4-bit samples each,
+ * the least significant nibble first. Each nibble is mapped to <tt>lut[nibble]</tt>;
+ * the SIMD versions do it with a single byte shuffle per nibble.
+ *
+ * <b>Dispatcher Prototype</b>
+ * \code
+ * void volk_gnsssdr_8u_unpack_4bit_8i(char* outVector, const unsigned char* inVector, const char* lut, unsigned int num_bytes)
+ * \endcode
+ *
+ * \b Inputs
+ * \li inVector:       Packed samples.
+ * \li lut:            Values of the sixteen 4-bit codes.
+ * \li num_bytes:      Number of bytes in \p inVector.
+ *
+ * \b Outputs
+ * \li outVector:      2 * \p num_bytes unpacked samples.
+ *
+ */
+
+#ifndef INCLUDED_volk_gnsssdr_8u_unpack_4bit_8i_H
+#define INCLUDED_volk_gnsssdr_8u_unpack_4bit_8i_H
+
+#include <volk_gnsssdr/volk_gnsssdr_common.h>
+#include <stdint.h>
+
+
+#ifdef LV_HAVE_GENERIC
+
+static inline void volk_gnsssdr_8u_unpack_4bit_8i_generic(int8_t* outVector, const uint8_t* inVector, const int8_t* lut, unsigned int num_bytes)
+{
+    unsigned int n;
+    for (n = 0; n < num_bytes; n++)
+        {
+            *outVector++ = lut[inVector[n] & 0x0F];
+            *outVector++ = lut[inVector[n] >> 4];
+        }
+}
+
+#endif /* LV_HAVE_GENERIC */
+
+
+#ifdef LV_HAVE_SSSE3
+#include <tmmintrin.h>
+
+static inline void volk_gnsssdr_8u_unpack_4bit_8i_u_ssse3(int8_t* outVector, const uint8_t* inVector, const int8_t* lut, unsigned int num_bytes)
+{
+    const unsigned int sse_iters = num_bytes / 16;
+    const __m128i lut_reg = _mm_loadu_si128((const __m128i*)lut);
+    const __m128i mask = _mm_set1_epi8(0x0F);
+    __m128i x, lo, hi;
+    unsigned int number;
+    for (number = 0; number < sse_iters; number++)
+        {
+            x = _mm_loadu_si128((const __m128i*)inVector);
+            lo = _mm_shuffle_epi8(lut_reg, _mm_and_si128(x, mask));
+            hi = _mm_shuffle_epi8(lut_reg, _mm_and_si128(_mm_srli_epi16(x, 4), mask));
+            _mm_storeu_si128((__m128i*)outVector, _mm_unpacklo_epi8(lo, hi));
+            _mm_storeu_si128((__m128i*)(outVector + 16), _mm_unpackhi_epi8(lo, hi));
+            outVector += 32;
+            inVector += 16;
+        }
+    for (number = sse_iters * 16; number < num_bytes; number++)
+        {
+            *outVector++ = lut[*inVector & 0x0F];
+            *outVector++ = lut[*inVector >> 4];
+            inVector++;
+        }
+}
+
+#endif /* LV_HAVE_SSSE3 */
+
+
+#ifdef LV_HAVE_AVX2
+#include <immintrin.h>
+
+static inline void volk_gnsssdr_8u_unpack_4bit_8i_u_avx2(int8_t* outVector, const uint8_t* inVector, const int8_t* lut, unsigned int num_bytes)
+{
+    const unsigned int avx2_iters = num_bytes / 32;
+    const __m256i lut_reg = _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i*)lut));
+    const __m256i mask = _mm256_set1_epi8(0x0F);
+    __m256i x, lo, hi, a, b;
+    unsigned int number;
+    for (number = 0; number < avx2_iters; number++)
+        {
+            x = _mm256_loadu_si256((const __m256i*)inVector);
+            lo = _mm256_shuffle_epi8(lut_reg, _mm256_and_si256(x, mask));
+            hi = _mm256_shuffle_epi8(lut_reg, _mm256_and_si256(_mm256_srli_epi16(x, 4), mask));
+            /* The unpacks work within each 128-bit lane: bring the lanes back in input order */
+            a = _mm256_unpacklo_epi8(lo, hi);
+            b = _mm256_unpackhi_epi8(lo, hi);
+            _mm256_storeu_si256((__m256i*)outVector, _mm256_permute2x128_si256(a, b, 0x20));
+            _mm256_storeu_si256((__m256i*)(outVector + 32), _mm256_permute2x128_si256(a, b, 0x31));
+            outVector += 64;
+            inVector += 32;
+        }
+    for (number = avx2_iters * 32; number < num_bytes; number++)
+        {
+            *outVector++ = lut[*inVector & 0x0F];
+            *outVector++ = lut[*inVector >> 4];
+            inVector++;
+        }
+}
+
+#endif /* LV_HAVE_AVX2 */
+
+
+#ifdef LV_HAVE_NEONV7
+#include <arm_neon.h>
+
+static inline void volk_gnsssdr_8u_unpack_4bit_8i_neon(int8_t* outVector, const uint8_t* inVector, const int8_t* lut, unsigned int num_bytes)
+{
+    const unsigned int neon_iters = num_bytes / 8;
+    const uint8x8_t mask = vdup_n_u8(0x0F);
+    int8x8x2_t lut_reg;
+    int8x8x2_t v;
+    uint8x8_t x;
+    unsigned int number;
+    lut_reg.val[0] = vld1_s8(lut);
+    lut_reg.val[1] = vld1_s8(lut + 8);
+    for (number = 0; number < neon_iters; number++)
+        {
+            x = vld1_u8(inVector);
+            v.val[0] = vtbl2_s8(lut_reg, vreinterpret_s8_u8(vand_u8(x, mask)));
+            v.val[1] = vtbl2_s8(lut_reg, vreinterpret_s8_u8(vshr_n_u8(x, 4)));
+            vst2_s8(outVector, v);
+            outVector += 16;
+            inVector += 8;
+        }
+    for (number = neon_iters * 8; number < num_bytes; number++)
+        {
+            *outVector++ = lut[*inVector & 0x0F];
+            *outVector++ = lut[*inVector >> 4];
+            inVector++;
+        }
+}
+
+#endif /* LV_HAVE_NEONV7 */
+
+#endif /* INCLUDED_volk_gnsssdr_8u_unpack_4bit_8i_H */
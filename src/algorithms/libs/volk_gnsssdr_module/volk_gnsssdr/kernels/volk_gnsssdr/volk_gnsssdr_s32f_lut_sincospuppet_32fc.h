@@ -0,0 +1,66 @@
+/*!
+ * \file volk_gnsssdr_s32f_lut_sincospuppet_32fc.h
+ * \brief VOLK_GNSSSDR puppet for the table-driven sincos kernel.
+ *
+ * VOLK_GNSSSDR puppet for integrating the table-driven sincos kernel into the test system.
+ * It takes the same arguments as volk_gnsssdr_s32f_sincospuppet_32fc, so that both
+ * carrier generators can be benchmarked against each other.
+ *
+ * -------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2018  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *          Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------
+ */
+
+#ifndef INCLUDED_volk_gnsssdr_s32f_lut_sincospuppet_32fc_H
+#define INCLUDED_volk_gnsssdr_s32f_lut_sincospuppet_32fc_H
+
+
+#include "volk_gnsssdr/volk_gnsssdr_s64f_lut_sincos_32fc.h"
+#include <volk_gnsssdr/volk_gnsssdr_complex.h>
+#include <math.h>
+
+
+#ifdef LV_HAVE_GENERIC
+static inline void volk_gnsssdr_s32f_lut_sincospuppet_32fc_generic(lv_32fc_t* out, const float phase_inc, unsigned int num_points)
+{
+    /* First half without dithering, then the rest with it, carrying over the phase */
+    double phase[1];
+    phase[0] = 3;
+    volk_gnsssdr_s64f_lut_sincos_32fc_generic(out, (double)phase_inc, phase, 0, num_points / 2);
+    volk_gnsssdr_s64f_lut_sincos_32fc_generic(out + num_points / 2, (double)phase_inc, phase, 1, num_points - num_points / 2);
+}
+
+#endif /* LV_HAVE_GENERIC  */
+
+
+#ifdef LV_HAVE_AVX2
+static inline void volk_gnsssdr_s32f_lut_sincospuppet_32fc_u_avx2(lv_32fc_t* out, const float phase_inc, unsigned int num_points)
+{
+    double phase[1];
+    phase[0] = 3;
+    volk_gnsssdr_s64f_lut_sincos_32fc_u_avx2(out, (double)phase_inc, phase, 0, num_points / 2);
+    volk_gnsssdr_s64f_lut_sincos_32fc_u_avx2(out + num_points / 2, (double)phase_inc, phase, 1, num_points - num_points / 2);
+}
+#endif /* LV_HAVE_AVX2  */
+
+#endif /* INCLUDED_volk_gnsssdr_s32f_lut_sincospuppet_32fc_H */
@@ -0,0 +1,192 @@
+/*!
+ * \file volk_gnsssdr_s64f_lut_sincos_32fc.h
+ * \brief VOLK_GNSSSDR kernel: table-driven carrier generator with an exact phase accumulator.
+ *
+ * VOLK_GNSSSDR kernel that generates a complex exponential with a fixed phase
+ * increment per sample, looking up a phase-quantized cosine and sine table.
+ *
+ * -------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2018  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *          Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------
+ */
+
+/*!
+ * \page volk_gnsssdr_s64f_lut_sincos_32fc
+ *
+ * \b Overview
+ *
+ * VOLK_GNSSSDR kernel that computes the cosine and sine with a fixed
+ * phase increment \p phase_inc per sample, providing the output in a complex vector (cosine, sine).
+ * The phase is accumulated in 64-bit fixed point (2^64 = 2 pi), so it stays exact for any
+ * vector length, and its 10 most significant bits index a table of 1024 phasors
+ * (phase error below pi / 1024 rad). Optionally, the phase is dithered by up to one table
+ * step before the look-up, which turns the spurs of the phase quantization into noise at the
+ * cost of doubling the maximum phase error.
+ *
+ * <b>Dispatcher Prototype</b>
+ * \code
+ * void volk_gnsssdr_s64f_lut_sincos_32fc(lv_32fc_t* out, const double phase_inc, double* phase, int dither, unsigned int num_points)
+ * \endcode
+ *
+ * \b Inputs
+ * \li phase_inc:      Phase increment per sample, in radians.
+ * \li phase:          Pointer to a double containing the initial phase, in radians.
+ * \li dither:         Non-zero to dither the phase before the table look-up.
+ * \li num_points:     Number of components in \p out to be computed.
+ *
+ * \b Outputs
+ * \li out:            Vector of the form lv_32fc_t out[n] = lv_cmake(cos(phase + n * phase_inc), sin(phase + n * phase_inc))
+ * \li phase:          Pointer to a double containing the final phase, in radians, wrapped to [0, 2 pi).
+ *
+ */
+
+#ifndef INCLUDED_volk_gnsssdr_s64f_lut_sincos_32fc_H
+#define INCLUDED_volk_gnsssdr_s64f_lut_sincos_32fc_H
+
+#include <volk_gnsssdr/volk_gnsssdr_common.h>
+#include <volk_gnsssdr/volk_gnsssdr_complex.h>
+#include <volk_gnsssdr/volk_gnsssdr_sincos_table.h>
+#include <math.h>
+#include <stdint.h>
+
+#define VOLK_GNSSSDR_SINCOS_LUT_SHIFT 54 /* 64 - 10 bits of table index */
+
+/* Turns a phase in radians into a 64-bit fixed point phase, 2^64 being 2 pi */
+static inline uint64_t volk_gnsssdr_s64f_lut_sincos_32fc_to_fxpt(double phase_rad)
+{
+    const double TWO_PI = 6.28318530717958647692;
+    double cycles = phase_rad / TWO_PI;
+    cycles -= floor(cycles);
+    if (cycles >= 1.0) cycles = 0.0;
+    /* cycles * 2^63 always fits in a uint64_t; the shift wraps 1.0 to 0 */
+    return (uint64_t)(cycles * 9223372036854775808.0) << 1;
+}
+
+
+static inline double volk_gnsssdr_s64f_lut_sincos_32fc_from_fxpt(uint64_t phase_fxpt)
+{
+    const double TWO_PI = 6.28318530717958647692;
+    return (double)phase_fxpt * (TWO_PI / 18446744073709551616.0);
+}
+
+
+/* Dither of sample n, uniform over one table step (lowbias32 integer hash) */
+static inline uint64_t volk_gnsssdr_s64f_lut_sincos_32fc_dither(uint32_t n)
+{
+    n ^= n >> 16;
+    n *= 0x7feb352dU;
+    n ^= n >> 15;
+    n *= 0x846ca68bU;
+    n ^= n >> 16;
+    return (uint64_t)n << (VOLK_GNSSSDR_SINCOS_LUT_SHIFT - 32);
+}
+
+
+#ifdef LV_HAVE_GENERIC
+
+static inline void volk_gnsssdr_s64f_lut_sincos_32fc_generic(lv_32fc_t* out, const double phase_inc, double* phase, int dither, unsigned int num_points)
+{
+    uint64_t acc = volk_gnsssdr_s64f_lut_sincos_32fc_to_fxpt(*phase);
+    const uint64_t inc = volk_gnsssdr_s64f_lut_sincos_32fc_to_fxpt(phase_inc);
+    /* Without dithering, round to the nearest table entry */
+    const uint64_t round_offset = 1ULL << (VOLK_GNSSSDR_SINCOS_LUT_SHIFT - 1);
+    const uint32_t seed = (uint32_t)(acc >> 32);
+    uint64_t offset;
+    unsigned int n;
+    unsigned int index;
+    for (n = 0; n < num_points; n++)
+        {
+            offset = dither ? volk_gnsssdr_s64f_lut_sincos_32fc_dither(seed + n) : round_offset;
+            index = (unsigned int)((acc + offset) >> VOLK_GNSSSDR_SINCOS_LUT_SHIFT);
+            out[n] = lv_cmake(sincos_table_10bits[index][0], sincos_table_10bits[index][1]);
+            acc += inc;
+        }
+    *phase = volk_gnsssdr_s64f_lut_sincos_32fc_from_fxpt(acc);
+}
+
+#endif /* LV_HAVE_GENERIC */
+
+
+#ifdef LV_HAVE_AVX2
+#include <immintrin.h>
+
+static inline void volk_gnsssdr_s64f_lut_sincos_32fc_u_avx2(lv_32fc_t* out, const double phase_inc, double* phase, int dither, unsigned int num_points)
+{
+    uint64_t acc = volk_gnsssdr_s64f_lut_sincos_32fc_to_fxpt(*phase);
+    const uint64_t inc = volk_gnsssdr_s64f_lut_sincos_32fc_to_fxpt(phase_inc);
+    const uint64_t round_offset = 1ULL << (VOLK_GNSSSDR_SINCOS_LUT_SHIFT - 1);
+    const uint32_t seed = (uint32_t)(acc >> 32);
+    const unsigned int avx_iters = num_points / 4;
+    /* Each table row (cosine, sine) is gathered as a single 64-bit element */
+    const double* table = (const double*)sincos_table_10bits;
+    __m256i acc4 = _mm256_set_epi64x((long long)(acc + 3 * inc), (long long)(acc + 2 * inc), (long long)(acc + inc), (long long)acc);
+    const __m256i inc4 = _mm256_set1_epi64x((long long)(4 * inc));
+    const __m256i round4 = _mm256_set1_epi64x((long long)round_offset);
+    __m128i n4 = _mm_set_epi32((int)(seed + 3), (int)(seed + 2), (int)(seed + 1), (int)seed);
+    const __m128i four = _mm_set1_epi32(4);
+    const __m128i mult1 = _mm_set1_epi32(0x7feb352d);
+    const __m128i mult2 = _mm_set1_epi32((int)0x846ca68bU);
+    __m256i offset4, index4;
+    __m128i h;
+    unsigned int number;
+    unsigned int n;
+    unsigned int index;
+    uint64_t offset;
+    lv_32fc_t* outPtr = out;
+
+    for (number = 0; number < avx_iters; number++)
+        {
+            if (dither)
+                {
+                    h = _mm_xor_si128(n4, _mm_srli_epi32(n4, 16));
+                    h = _mm_mullo_epi32(h, mult1);
+                    h = _mm_xor_si128(h, _mm_srli_epi32(h, 15));
+                    h = _mm_mullo_epi32(h, mult2);
+                    h = _mm_xor_si128(h, _mm_srli_epi32(h, 16));
+                    offset4 = _mm256_slli_epi64(_mm256_cvtepu32_epi64(h), VOLK_GNSSSDR_SINCOS_LUT_SHIFT - 32);
+                    n4 = _mm_add_epi32(n4, four);
+                }
+            else
+                {
+                    offset4 = round4;
+                }
+            index4 = _mm256_srli_epi64(_mm256_add_epi64(acc4, offset4), VOLK_GNSSSDR_SINCOS_LUT_SHIFT);
+            _mm256_storeu_pd((double*)outPtr, _mm256_i64gather_pd(table, index4, 8));
+            acc4 = _mm256_add_epi64(acc4, inc4);
+            outPtr += 4;
+        }
+
+    acc += (uint64_t)(avx_iters * 4) * inc;
+    for (n = avx_iters * 4; n < num_points; n++)
+        {
+            offset = dither ? volk_gnsssdr_s64f_lut_sincos_32fc_dither(seed + n) : round_offset;
+            index = (unsigned int)((acc + offset) >> VOLK_GNSSSDR_SINCOS_LUT_SHIFT);
+            *outPtr++ = lv_cmake(sincos_table_10bits[index][0], sincos_table_10bits[index][1]);
+            acc += inc;
+        }
+    *phase = volk_gnsssdr_s64f_lut_sincos_32fc_from_fxpt(acc);
+}
+
+#endif /* LV_HAVE_AVX2 */
+
+#endif /* INCLUDED_volk_gnsssdr_s64f_lut_sincos_32fc_H */
@@ -70,7 +70,9 @@ std::vector<volk_gnsssdr_test_case_t> init_test_list(volk_gnsssdr_test_params_t
     QA(VOLK_INIT_TEST(volk_gnsssdr_8i_index_max_16u, test_params_more_iters))
     QA(VOLK_INIT_TEST(volk_gnsssdr_8i_max_s8i, test_params_more_iters))
     QA(VOLK_INIT_TEST(volk_gnsssdr_8i_x2_add_8i, test_params_more_iters))
+    QA(VOLK_INIT_TEST(volk_gnsssdr_8i_x2_interleave_8ic, test_params_more_iters))
     QA(VOLK_INIT_TEST(volk_gnsssdr_8ic_conjugate_8ic, test_params_more_iters))
+    QA(VOLK_INIT_TEST(volk_gnsssdr_8ic_convert_16ic, test_params_more_iters))
     QA(VOLK_INIT_TEST(volk_gnsssdr_8ic_magnitude_squared_8i, test_params_more_iters))
     QA(VOLK_INIT_TEST(volk_gnsssdr_8ic_x2_dot_prod_8ic, test_params))
     QA(VOLK_INIT_TEST(volk_gnsssdr_8ic_x2_multiply_8ic, test_params))
@@ -85,7 +87,17 @@ std::vector<volk_gnsssdr_test_case_t> init_test_list(volk_gnsssdr_test_params_t
     QA(VOLK_INIT_TEST(volk_gnsssdr_16ic_x2_multiply_16ic, test_params_more_iters))
     QA(VOLK_INIT_TEST(volk_gnsssdr_16ic_convert_32fc, test_params_more_iters))
     QA(VOLK_INIT_TEST(volk_gnsssdr_16ic_conjugate_16ic, test_params_more_iters))
+    QA(VOLK_INIT_TEST(volk_gnsssdr_16i_x2_interleave_16ic, test_params_more_iters))
+    QA(VOLK_INIT_TEST(volk_gnsssdr_32u_s32f_unpack_1bit_32fc, test_params))
+    QA(VOLK_INIT_PUPP(volk_gnsssdr_32fc_magsquaredaccmaxpuppet_32f, volk_gnsssdr_32fc_magnitude_squared_acc_index_max_32f, test_params))
     QA(VOLK_INIT_PUPP(volk_gnsssdr_s32f_sincospuppet_32fc, volk_gnsssdr_s32f_sincos_32fc, test_params_inacc2))
+    QA(VOLK_INIT_PUPP(volk_gnsssdr_s32f_lut_sincospuppet_32fc, volk_gnsssdr_s64f_lut_sincos_32fc, test_params))
+    QA(VOLK_INIT_PUPP(volk_gnsssdr_8i_viterbik7r2puppet_32u, volk_gnsssdr_8i_viterbi_k7r2_32u, test_params))
+    QA(VOLK_INIT_PUPP(volk_gnsssdr_8u_unpack2bitpuppet_8i, volk_gnsssdr_8u_unpack_2bit_8i, test_params))
+    QA(VOLK_INIT_PUPP(volk_gnsssdr_8u_unpack2bitpuppet_16i, volk_gnsssdr_8u_unpack_2bit_16i, test_params))
+    QA(VOLK_INIT_PUPP(volk_gnsssdr_8u_unpack2bitpuppet_32f, volk_gnsssdr_8u_unpack_2bit_32f, test_params))
+    QA(VOLK_INIT_PUPP(volk_gnsssdr_8u_unpack4bitpuppet_8i, volk_gnsssdr_8u_unpack_4bit_8i, test_params))
+    QA(VOLK_INIT_PUPP(volk_gnsssdr_8ic_deinterleavexnpuppet_32fc, volk_gnsssdr_8ic_deinterleave_32fc_xn, test_params))
     QA(VOLK_INIT_PUPP(volk_gnsssdr_16ic_rotatorpuppet_16ic, volk_gnsssdr_16ic_s32fc_x2_rotator_16ic, test_params_int1))
     QA(VOLK_INIT_PUPP(volk_gnsssdr_16ic_resamplerfastpuppet_16ic, volk_gnsssdr_16ic_resampler_fast_16ic, test_params))
     QA(VOLK_INIT_PUPP(volk_gnsssdr_16ic_resamplerfastxnpuppet_16ic, volk_gnsssdr_16ic_xn_resampler_fast_16ic_xn, test_params))
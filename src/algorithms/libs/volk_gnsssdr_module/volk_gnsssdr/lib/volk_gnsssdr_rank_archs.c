@@ -59,6 +59,21 @@ int volk_gnsssdr_get_index(
 }
 
 
+static volk_gnsssdr_arch_pref_t *volk_gnsssdr_arch_prefs = NULL;
+static size_t n_arch_prefs = 0;
+static int prefs_loaded = 0;
+
+
+void volk_gnsssdr_forget_preferences(void)
+{
+    // the previous list is not freed: a kernel being initialized in
+    // another thread may still be reading it
+    volk_gnsssdr_arch_prefs = NULL;
+    n_arch_prefs = 0;
+    prefs_loaded = 0;
+}
+
+
 int volk_gnsssdr_rank_archs(
     const char *kern_name,     //name of the kernel to rank
     const char *impl_names[],  //list of implementations by name
@@ -69,9 +84,6 @@ int volk_gnsssdr_rank_archs(
 )
 {
     size_t i;
-    static volk_gnsssdr_arch_pref_t *volk_gnsssdr_arch_prefs;
-    static size_t n_arch_prefs = 0;
-    static int prefs_loaded = 0;
     if (!prefs_loaded)
         {
             n_arch_prefs = volk_gnsssdr_load_preferences(&volk_gnsssdr_arch_prefs);
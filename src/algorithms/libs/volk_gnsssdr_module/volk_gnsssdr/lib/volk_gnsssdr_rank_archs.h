@@ -42,6 +42,9 @@ extern "C"
         const bool align           //if false, filter aligned implementations
     );
 
+    //discards the loaded preferences, the next ranking reads the config file again
+    void volk_gnsssdr_forget_preferences(void);
+
 #ifdef __cplusplus
 }
 #endif
@@ -220,4 +220,14 @@ volk_gnsssdr_func_desc_t ${kern.name}_get_func_desc(void) {
 
 %endfor
 
+void volk_gnsssdr_reload_preferences(void)
+{
+    volk_gnsssdr_forget_preferences();
+%for kern in kernels:
+    ${kern.name}_a = &__${kern.name}_a;
+    ${kern.name}_u = &__${kern.name}_u;
+    ${kern.name}   = &__${kern.name};
+%endfor
+}
+
     // clang-format on
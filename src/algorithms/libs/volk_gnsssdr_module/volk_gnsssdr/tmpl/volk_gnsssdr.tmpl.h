@@ -67,6 +67,13 @@ VOLK_API size_t volk_gnsssdr_get_alignment(void);
  */
 VOLK_API bool volk_gnsssdr_is_aligned(const void *ptr);
 
+/*!
+ * Reads the volk_gnsssdr_config file again (e.g. after running
+ * volk_gnsssdr_profile) and makes every kernel choose its
+ * implementations again on its next call.
+ */
+VOLK_API void volk_gnsssdr_reload_preferences(void);
+
 // clang-format off
 %for kern in kernels:
 
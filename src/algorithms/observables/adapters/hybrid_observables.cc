@@ -6,7 +6,7 @@
  *
  * -------------------------------------------------------------------------
  *
- * Copyright (C) 2010-2018  (see AUTHORS file for a list of contributors)
+ * Copyright (C) 2010-2019  (see AUTHORS file for a list of contributors)
  *
  * GNSS-SDR is a software defined Global Navigation
  *          Satellite Systems receiver
@@ -45,8 +45,19 @@ HybridObservables::HybridObservables(ConfigurationInterface* configuration,
     dump_ = configuration->property(role + ".dump", false);
     dump_mat_ = configuration->property(role + ".dump_mat", true);
     dump_filename_ = configuration->property(role + ".dump_filename", default_dump_filename);
-
-    observables_ = hybrid_make_observables_cc(in_streams_, out_streams_, dump_, dump_mat_, dump_filename_);
+    // the observables are produced at the rate of the sample counter block
+    observable_interval_ms_ = configuration->property("GNSS-SDR.observable_interval_ms", 20);
+    interpolation_order_ = configuration->property(role + ".interpolation_order", 1);
+    if (interpolation_order_ < 1 or interpolation_order_ > 3)
+        {
+            LOG(WARNING) << "Observables interpolation order " << interpolation_order_ << " not supported, using linear interpolation";
+            interpolation_order_ = 1;
+        }
+
+    // all the channels of an epoch in a single item, read as such by the PVT and the monitor
+    vector_output_ = configuration->property("GNSS-SDR.vector_observables", false);
+
+    observables_ = hybrid_make_observables_cc(in_streams_, out_streams_, dump_, dump_mat_, dump_filename_, observable_interval_ms_, interpolation_order_, vector_output_, gnss_dump_policy_conf(configuration, role));
     DLOG(INFO) << "Observables block ID (" << observables_->unique_id() << ")";
 }
 
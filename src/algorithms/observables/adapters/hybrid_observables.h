@@ -7,7 +7,7 @@
  *
  * -------------------------------------------------------------------------
  *
- * Copyright (C) 2010-2018  (see AUTHORS file for a list of contributors)
+ * Copyright (C) 2010-2019  (see AUTHORS file for a list of contributors)
  *
  * GNSS-SDR is a software defined Global Navigation
  *          Satellite Systems receiver
@@ -85,6 +85,9 @@ private:
     bool dump_;
     bool dump_mat_;
     std::string dump_filename_;
+    unsigned int observable_interval_ms_;
+    unsigned int interpolation_order_;
+    bool vector_output_;
     std::string role_;
     unsigned int in_streams_;
     unsigned int out_streams_;
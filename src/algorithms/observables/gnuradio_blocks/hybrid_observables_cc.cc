@@ -6,7 +6,7 @@
  *
  * -------------------------------------------------------------------------
  *
- * Copyright (C) 2010-2018  (see AUTHORS file for a list of contributors)
+ * Copyright (C) 2010-2019  (see AUTHORS file for a list of contributors)
  *
  * GNSS-SDR is a software defined Global Navigation
  *          Satellite Systems receiver
@@ -32,14 +32,16 @@
 #include "hybrid_observables_cc.h"
 #include "GPS_L1_CA.h"
 #include "display.h"
+#include "gnss_profiler.h"
 #include "gnss_sdr_create_directory.h"
+#include "gnss_trace.h"
 #include <boost/filesystem/path.hpp>
 #include <glog/logging.h>
 #include <gnuradio/io_signature.h>
 #include <matio.h>
 #include <algorithm>
+#include <chrono>
 #include <cmath>
-#include <cstdlib>
 #include <iostream>
 #include <limits>
 #include <utility>
@@ -48,9 +50,9 @@
 using google::LogMessage;
 
 
-hybrid_observables_cc_sptr hybrid_make_observables_cc(unsigned int nchannels_in, unsigned int nchannels_out, bool dump, bool dump_mat, std::string dump_filename)
+hybrid_observables_cc_sptr hybrid_make_observables_cc(unsigned int nchannels_in, unsigned int nchannels_out, bool dump, bool dump_mat, std::string dump_filename, uint32_t observable_interval_ms, uint32_t interpolation_order, bool vector_output, const Gnss_Dump_Policy_Conf &dump_policy)
 {
-    return hybrid_observables_cc_sptr(new hybrid_observables_cc(nchannels_in, nchannels_out, dump, dump_mat, std::move(dump_filename)));
+    return hybrid_observables_cc_sptr(new hybrid_observables_cc(nchannels_in, nchannels_out, dump, dump_mat, std::move(dump_filename), observable_interval_ms, interpolation_order, vector_output, dump_policy));
 }
 
 
@@ -58,17 +60,37 @@ hybrid_observables_cc::hybrid_observables_cc(uint32_t nchannels_in,
     uint32_t nchannels_out,
     bool dump,
     bool dump_mat,
-    std::string dump_filename) : gr::block("hybrid_observables_cc",
-                                     gr::io_signature::make(nchannels_in, nchannels_in, sizeof(Gnss_Synchro)),
-                                     gr::io_signature::make(nchannels_out, nchannels_out, sizeof(Gnss_Synchro)))
+    std::string dump_filename,
+    uint32_t observable_interval_ms,
+    uint32_t interpolation_order,
+    bool vector_output,
+    const Gnss_Dump_Policy_Conf &dump_policy) : gr::block("hybrid_observables_cc",
+                                                    gr::io_signature::make(nchannels_in, nchannels_in, sizeof(Gnss_Synchro)),
+                                                    vector_output ? gr::io_signature::make(1, 1, sizeof(Gnss_Synchro) * nchannels_out) : gr::io_signature::make(nchannels_out, nchannels_out, sizeof(Gnss_Synchro))),
+                                                d_dump_policy(dump_policy)
 {
     d_dump = dump;
     d_dump_mat = dump_mat and d_dump;
+    if (d_dump_mat)
+        {
+            d_mat_converter = Gnss_Mat_Converter::get_instance();
+        }
     d_dump_filename = std::move(dump_filename);
     d_nchannels_out = nchannels_out;
     d_nchannels_in = nchannels_in;
+    d_vector_output = vector_output;
+    d_epoch_out = std::vector<Gnss_Synchro *>(d_nchannels_out, nullptr);
     T_rx_clock_step_samples = 0U;
     d_gnss_synchro_history = new Gnss_circular_deque<Gnss_Synchro>(500, d_nchannels_out);
+    d_observable_interval_ms = std::max(observable_interval_ms, 1U);
+    d_interpolation_nodes = std::max(interpolation_order, 1U) + 1U;
+    d_interp_weights = std::vector<double>(d_interpolation_nodes * d_nchannels_out, 0.0);
+    d_interp_carrier_phase_rads = std::vector<double>(d_interpolation_nodes * d_nchannels_out, 0.0);
+    d_interp_carrier_doppler_hz = std::vector<double>(d_interpolation_nodes * d_nchannels_out, 0.0);
+    d_interp_tow_ms = std::vector<double>(d_interpolation_nodes * d_nchannels_out, 0.0);
+    d_dump_record = std::vector<double>(7 * d_nchannels_out, 0.0);  // 7 variables per channel
+    d_dump_epochs = 0ULL;
+    d_valid_pseudorange = std::vector<bool>(d_nchannels_out, false);
 
     // ############# ENABLE DATA FILE LOG #################
     if (d_dump)
@@ -107,6 +129,9 @@ hybrid_observables_cc::hybrid_observables_cc(uint32_t nchannels_in,
                 {
                     d_dump_file.open(d_dump_filename.c_str(), std::ios::out | std::ios::binary);
                     LOG(INFO) << "Observables dump enabled Log file: " << d_dump_filename.c_str();
+                    d_dump_policy.set_writer("observables", sizeof(double) * d_dump_record.size(), 1000.0 / static_cast<double>(d_observable_interval_ms), [this](const char *record) {
+                        d_dump_file.write(record, sizeof(double) * d_dump_record.size());
+                    });
                 }
             catch (const std::ifstream::failure &e)
                 {
@@ -119,8 +144,20 @@ hybrid_observables_cc::hybrid_observables_cc(uint32_t nchannels_in,
     T_rx_TOW_set = false;
 
     // rework
-    d_Rx_clock_buffer.resize(10);  // 10*20 ms = 200 ms of data in buffer
-    d_Rx_clock_buffer.clear();     // Clear all the elements in the buffer
+    // The observables are computed at the oldest epoch in the buffer. Keep it at least 180 ms
+    // behind the newest one (the 10 epochs of 20 ms of the fixed rate), so that all the
+    // channels have tracked past it, whatever the interval
+    const uint32_t rx_clock_margin_ms = 180U;
+    d_Rx_clock_buffer.resize((rx_clock_margin_ms + d_observable_interval_ms - 1U) / d_observable_interval_ms + 1U);
+    d_Rx_clock_buffer.clear();  // Clear all the elements in the buffer
+    d_Rx_clock_arrival.set_capacity(d_Rx_clock_buffer.capacity());
+    d_shared_clock = (d_nchannels_in == d_nchannels_out);
+    d_sample_clock = Gnss_Sdr_Sample_Clock::get_instance();
+    d_epoch_samples = 0ULL;
+    d_next_epoch_sample = 0ULL;
+
+    // The arrival time of each epoch is forwarded by general_work()
+    set_tag_propagation_policy(TPP_DONT);
 }
 
 
@@ -147,189 +184,24 @@ hybrid_observables_cc::~hybrid_observables_cc()
 
 int32_t hybrid_observables_cc::save_matfile()
 {
-    // READ DUMP FILE
-    std::string dump_filename = d_dump_filename;
-    std::ifstream::pos_type size;
-    int32_t number_of_double_vars = 7;
-    int32_t epoch_size_bytes = sizeof(double) * number_of_double_vars * d_nchannels_out;
-    std::ifstream dump_file;
-    std::cout << "Generating .mat file for " << dump_filename << std::endl;
-    dump_file.exceptions(std::ifstream::failbit | std::ifstream::badbit);
-    try
-        {
-            dump_file.open(dump_filename.c_str(), std::ios::binary | std::ios::ate);
-        }
-    catch (const std::ifstream::failure &e)
-        {
-            std::cerr << "Problem opening dump file:" << e.what() << std::endl;
-            return 1;
-        }
-    // count number of epochs and rewind
-    int64_t num_epoch = 0LL;
-    if (dump_file.is_open())
-        {
-            size = dump_file.tellg();
-            num_epoch = static_cast<int64_t>(size) / static_cast<int64_t>(epoch_size_bytes);
-            dump_file.seekg(0, std::ios::beg);
-        }
-    else
-        {
-            return 1;
-        }
-    auto **RX_time = new double *[d_nchannels_out];
-    auto **TOW_at_current_symbol_s = new double *[d_nchannels_out];
-    auto **Carrier_Doppler_hz = new double *[d_nchannels_out];
-    auto **Carrier_phase_cycles = new double *[d_nchannels_out];
-    auto **Pseudorange_m = new double *[d_nchannels_out];
-    auto **PRN = new double *[d_nchannels_out];
-    auto **Flag_valid_pseudorange = new double *[d_nchannels_out];
-
-    for (uint32_t i = 0; i < d_nchannels_out; i++)
-        {
-            RX_time[i] = new double[num_epoch];
-            TOW_at_current_symbol_s[i] = new double[num_epoch];
-            Carrier_Doppler_hz[i] = new double[num_epoch];
-            Carrier_phase_cycles[i] = new double[num_epoch];
-            Pseudorange_m[i] = new double[num_epoch];
-            PRN[i] = new double[num_epoch];
-            Flag_valid_pseudorange[i] = new double[num_epoch];
-        }
-
-    try
-        {
-            if (dump_file.is_open())
-                {
-                    for (int64_t i = 0; i < num_epoch; i++)
-                        {
-                            for (uint32_t chan = 0; chan < d_nchannels_out; chan++)
-                                {
-                                    dump_file.read(reinterpret_cast<char *>(&RX_time[chan][i]), sizeof(double));
-                                    dump_file.read(reinterpret_cast<char *>(&TOW_at_current_symbol_s[chan][i]), sizeof(double));
-                                    dump_file.read(reinterpret_cast<char *>(&Carrier_Doppler_hz[chan][i]), sizeof(double));
-                                    dump_file.read(reinterpret_cast<char *>(&Carrier_phase_cycles[chan][i]), sizeof(double));
-                                    dump_file.read(reinterpret_cast<char *>(&Pseudorange_m[chan][i]), sizeof(double));
-                                    dump_file.read(reinterpret_cast<char *>(&PRN[chan][i]), sizeof(double));
-                                    dump_file.read(reinterpret_cast<char *>(&Flag_valid_pseudorange[chan][i]), sizeof(double));
-                                }
-                        }
-                }
-            dump_file.close();
-        }
-    catch (const std::ifstream::failure &e)
-        {
-            std::cerr << "Problem reading dump file:" << e.what() << std::endl;
-            for (uint32_t i = 0; i < d_nchannels_out; i++)
-                {
-                    delete[] RX_time[i];
-                    delete[] TOW_at_current_symbol_s[i];
-                    delete[] Carrier_Doppler_hz[i];
-                    delete[] Carrier_phase_cycles[i];
-                    delete[] Pseudorange_m[i];
-                    delete[] PRN[i];
-                    delete[] Flag_valid_pseudorange[i];
-                }
-            delete[] RX_time;
-            delete[] TOW_at_current_symbol_s;
-            delete[] Carrier_Doppler_hz;
-            delete[] Carrier_phase_cycles;
-            delete[] Pseudorange_m;
-            delete[] PRN;
-            delete[] Flag_valid_pseudorange;
-
-            return 1;
-        }
-
-    auto *RX_time_aux = new double[d_nchannels_out * num_epoch];
-    auto *TOW_at_current_symbol_s_aux = new double[d_nchannels_out * num_epoch];
-    auto *Carrier_Doppler_hz_aux = new double[d_nchannels_out * num_epoch];
-    auto *Carrier_phase_cycles_aux = new double[d_nchannels_out * num_epoch];
-    auto *Pseudorange_m_aux = new double[d_nchannels_out * num_epoch];
-    auto *PRN_aux = new double[d_nchannels_out * num_epoch];
-    auto *Flag_valid_pseudorange_aux = new double[d_nchannels_out * num_epoch];
-    uint32_t k = 0U;
-    for (int64_t j = 0; j < num_epoch; j++)
-        {
-            for (uint32_t i = 0; i < d_nchannels_out; i++)
-                {
-                    RX_time_aux[k] = RX_time[i][j];
-                    TOW_at_current_symbol_s_aux[k] = TOW_at_current_symbol_s[i][j];
-                    Carrier_Doppler_hz_aux[k] = Carrier_Doppler_hz[i][j];
-                    Carrier_phase_cycles_aux[k] = Carrier_phase_cycles[i][j];
-                    Pseudorange_m_aux[k] = Pseudorange_m[i][j];
-                    PRN_aux[k] = PRN[i][j];
-                    Flag_valid_pseudorange_aux[k] = Flag_valid_pseudorange[i][j];
-                    k++;
-                }
-        }
-
-    // WRITE MAT FILE
-    mat_t *matfp;
-    matvar_t *matvar;
     std::string filename = d_dump_filename;
     if (filename.size() > 4)
         {
             filename.erase(filename.end() - 4, filename.end());
         }
     filename.append(".mat");
-    matfp = Mat_CreateVer(filename.c_str(), nullptr, MAT_FT_MAT73);
-    if (reinterpret_cast<int64_t *>(matfp) != nullptr)
-        {
-            size_t dims[2] = {static_cast<size_t>(d_nchannels_out), static_cast<size_t>(num_epoch)};
-            matvar = Mat_VarCreate("RX_time", MAT_C_DOUBLE, MAT_T_DOUBLE, 2, dims, RX_time_aux, MAT_F_DONT_COPY_DATA);
-            Mat_VarWrite(matfp, matvar, MAT_COMPRESSION_ZLIB);  // or MAT_COMPRESSION_NONE
-            Mat_VarFree(matvar);
-
-            matvar = Mat_VarCreate("TOW_at_current_symbol_s", MAT_C_DOUBLE, MAT_T_DOUBLE, 2, dims, TOW_at_current_symbol_s_aux, MAT_F_DONT_COPY_DATA);
-            Mat_VarWrite(matfp, matvar, MAT_COMPRESSION_ZLIB);  // or MAT_COMPRESSION_NONE
-            Mat_VarFree(matvar);
-
-            matvar = Mat_VarCreate("Carrier_Doppler_hz", MAT_C_DOUBLE, MAT_T_DOUBLE, 2, dims, Carrier_Doppler_hz_aux, MAT_F_DONT_COPY_DATA);
-            Mat_VarWrite(matfp, matvar, MAT_COMPRESSION_ZLIB);  // or MAT_COMPRESSION_NONE
-            Mat_VarFree(matvar);
-
-            matvar = Mat_VarCreate("Carrier_phase_cycles", MAT_C_DOUBLE, MAT_T_DOUBLE, 2, dims, Carrier_phase_cycles_aux, MAT_F_DONT_COPY_DATA);
-            Mat_VarWrite(matfp, matvar, MAT_COMPRESSION_ZLIB);  // or MAT_COMPRESSION_NONE
-            Mat_VarFree(matvar);
-
-            matvar = Mat_VarCreate("Pseudorange_m", MAT_C_DOUBLE, MAT_T_DOUBLE, 2, dims, Pseudorange_m_aux, MAT_F_DONT_COPY_DATA);
-            Mat_VarWrite(matfp, matvar, MAT_COMPRESSION_ZLIB);  // or MAT_COMPRESSION_NONE
-            Mat_VarFree(matvar);
-
-            matvar = Mat_VarCreate("PRN", MAT_C_DOUBLE, MAT_T_DOUBLE, 2, dims, PRN_aux, MAT_F_DONT_COPY_DATA);
-            Mat_VarWrite(matfp, matvar, MAT_COMPRESSION_ZLIB);  // or MAT_COMPRESSION_NONE
-            Mat_VarFree(matvar);
-
-            matvar = Mat_VarCreate("Flag_valid_pseudorange", MAT_C_DOUBLE, MAT_T_DOUBLE, 2, dims, Flag_valid_pseudorange_aux, MAT_F_DONT_COPY_DATA);
-            Mat_VarWrite(matfp, matvar, MAT_COMPRESSION_ZLIB);  // or MAT_COMPRESSION_NONE
-            Mat_VarFree(matvar);
-        }
-    Mat_Close(matfp);
-
-    for (uint32_t i = 0; i < d_nchannels_out; i++)
-        {
-            delete[] RX_time[i];
-            delete[] TOW_at_current_symbol_s[i];
-            delete[] Carrier_Doppler_hz[i];
-            delete[] Carrier_phase_cycles[i];
-            delete[] Pseudorange_m[i];
-            delete[] PRN[i];
-            delete[] Flag_valid_pseudorange[i];
-        }
-    delete[] RX_time;
-    delete[] TOW_at_current_symbol_s;
-    delete[] Carrier_Doppler_hz;
-    delete[] Carrier_phase_cycles;
-    delete[] Pseudorange_m;
-    delete[] PRN;
-    delete[] Flag_valid_pseudorange;
-
-    delete[] RX_time_aux;
-    delete[] TOW_at_current_symbol_s_aux;
-    delete[] Carrier_Doppler_hz_aux;
-    delete[] Carrier_phase_cycles_aux;
-    delete[] Pseudorange_m_aux;
-    delete[] PRN_aux;
-    delete[] Flag_valid_pseudorange_aux;
+    // Each dump record holds these values for every output channel
+    const std::vector<Gnss_Mat_Converter::Field> fields = {
+        {"RX_time", MAT_C_DOUBLE, MAT_T_DOUBLE, sizeof(double)},
+        {"TOW_at_current_symbol_s", MAT_C_DOUBLE, MAT_T_DOUBLE, sizeof(double)},
+        {"Carrier_Doppler_hz", MAT_C_DOUBLE, MAT_T_DOUBLE, sizeof(double)},
+        {"Carrier_phase_cycles", MAT_C_DOUBLE, MAT_T_DOUBLE, sizeof(double)},
+        {"Pseudorange_m", MAT_C_DOUBLE, MAT_T_DOUBLE, sizeof(double)},
+        {"PRN", MAT_C_DOUBLE, MAT_T_DOUBLE, sizeof(double)},
+        {"Flag_valid_pseudorange", MAT_C_DOUBLE, MAT_T_DOUBLE, sizeof(double)}};
+    // The conversion runs in the background, in chunks of records
+    std::cout << "Generating .mat file for " << d_dump_filename << std::endl;
+    d_mat_converter->convert(d_dump_filename, filename, fields, d_nchannels_out);
     return 0;
 }
 
@@ -342,112 +214,187 @@ double hybrid_observables_cc::compute_T_rx_s(const Gnss_Synchro &a)
 
 bool hybrid_observables_cc::interp_trk_obs(Gnss_Synchro &interpolated_obs, const uint32_t &ch, const uint64_t &rx_clock)
 {
+    Gnss_Profile_Scope profile("interp_trk_obs");
     int32_t nearest_element = -1;
-    int64_t abs_diff;
     int64_t old_abs_diff = std::numeric_limits<int64_t>::max();
-    for (uint32_t i = 0; i < d_gnss_synchro_history->size(ch); i++)
+    // the history of a channel is sorted by sample counter: binary search of the first element not before rx_clock
+    const Gnss_Synchro *history = d_gnss_synchro_history->data(ch);
+    const uint32_t first = std::lower_bound(history, history + d_gnss_synchro_history->size(ch), rx_clock,
+                               [](const Gnss_Synchro &obs, uint64_t clock) { return obs.Tracking_sample_counter < clock; }) -
+                           history;
+    // the nearest element is that one or the previous one (the earliest on a tie, as in a linear scan)
+    if (first < d_gnss_synchro_history->size(ch))
         {
-            abs_diff = llabs(static_cast<int64_t>(rx_clock) - static_cast<int64_t>(d_gnss_synchro_history->at(ch, i).Tracking_sample_counter));
-            if (old_abs_diff > abs_diff)
+            old_abs_diff = static_cast<int64_t>(history[first].Tracking_sample_counter) - static_cast<int64_t>(rx_clock);
+            nearest_element = static_cast<int32_t>(first);
+        }
+    if (first > 0)
+        {
+            const int64_t abs_diff = static_cast<int64_t>(rx_clock) - static_cast<int64_t>(history[first - 1].Tracking_sample_counter);
+            if (abs_diff <= old_abs_diff)
                 {
                     old_abs_diff = abs_diff;
-                    nearest_element = static_cast<int32_t>(i);
+                    nearest_element = static_cast<int32_t>(first - 1);
                 }
         }
 
     if (nearest_element != -1 and nearest_element != static_cast<int32_t>(d_gnss_synchro_history->size(ch)))
         {
-            if ((static_cast<double>(old_abs_diff) / static_cast<double>(d_gnss_synchro_history->at(ch, nearest_element).fs)) < 0.02)
+            if ((static_cast<double>(old_abs_diff) / static_cast<double>(history[nearest_element].fs)) < 0.02)
                 {
-                    int32_t neighbor_element;
-                    if (rx_clock > d_gnss_synchro_history->at(ch, nearest_element).Tracking_sample_counter)
+                    // the nodes are the two samples bracketing rx_clock and, for higher orders, their neighbours
+                    const auto history_size = static_cast<int32_t>(d_gnss_synchro_history->size(ch));
+                    const int32_t nodes = std::min(static_cast<int32_t>(d_interpolation_nodes), history_size);
+                    const int32_t t1_idx = rx_clock > history[nearest_element].Tracking_sample_counter ? nearest_element : nearest_element - 1;
+                    if (t1_idx < 0 or t1_idx + 1 >= history_size)
                         {
-                            neighbor_element = nearest_element + 1;
+                            return false;
                         }
-                    else
-                        {
-                            neighbor_element = nearest_element - 1;
-                        }
-                    if (neighbor_element < static_cast<int32_t>(d_gnss_synchro_history->size(ch)) and neighbor_element >= 0)
+                    const int32_t first_node = std::min(std::max(t1_idx + 1 - nodes / 2, 0), history_size - nodes);
+
+                    // 1st: copy the nearest gnss_synchro data for that channel
+                    interpolated_obs = history[nearest_element];
+
+                    // 2nd: Lagrange weights of the nodes at the Rx time, y(t) = sum_k y(t_k) * prod_{j!=k} (t - t_j) / (t_k - t_j)
+                    // (order 1 is the linear interpolation). The interpolation itself runs for all channels at once in interpolate_epoch().
+                    double T_rx_s = static_cast<double>(rx_clock) / static_cast<double>(interpolated_obs.fs);
+                    for (int32_t k = 0; k < static_cast<int32_t>(d_interpolation_nodes); k++)
                         {
-                            int32_t t1_idx;
-                            int32_t t2_idx;
-                            if (rx_clock > d_gnss_synchro_history->at(ch, nearest_element).Tracking_sample_counter)
+                            const uint32_t idx = k * d_nchannels_out + ch;
+                            if (k >= nodes)
                                 {
-                                    //std::cout << "S1= " << d_gnss_synchro_history->at(ch, nearest_element).Tracking_sample_counter
-                                    //          << " Si=" << rx_clock << " S2=" << d_gnss_synchro_history->at(ch, neighbor_element).Tracking_sample_counter << std::endl;
-                                    t1_idx = nearest_element;
-                                    t2_idx = neighbor_element;
+                                    d_interp_weights[idx] = 0.0;
+                                    d_interp_carrier_phase_rads[idx] = 0.0;
+                                    d_interp_carrier_doppler_hz[idx] = 0.0;
+                                    d_interp_tow_ms[idx] = 0.0;
+                                    continue;
                                 }
-                            else
+                            const Gnss_Synchro &node = history[first_node + k];
+                            const double dt_k = node.RX_time - T_rx_s;
+                            double weight = 1.0;
+                            for (int32_t j = 0; j < nodes; j++)
                                 {
-                                    //std::cout << "inv S1= " << d_gnss_synchro_history->at(ch, neighbor_element).Tracking_sample_counter
-                                    //          << " Si=" << rx_clock << " S2=" << d_gnss_synchro_history->at(ch, nearest_element).Tracking_sample_counter << std::endl;
-                                    t1_idx = neighbor_element;
-                                    t2_idx = nearest_element;
+                                    if (j != k)
+                                        {
+                                            const double dt_j = history[first_node + j].RX_time - T_rx_s;
+                                            weight *= dt_j / (dt_j - dt_k);
+                                        }
                                 }
-
-                            // 1st: copy the nearest gnss_synchro data for that channel
-                            interpolated_obs = d_gnss_synchro_history->at(ch, nearest_element);
-
-                            // 2nd: Linear interpolation: y(t) = y(t1) + (y(t2) - y(t1)) * (t - t1) / (t2 - t1)
-
-                            double T_rx_s = static_cast<double>(rx_clock) / static_cast<double>(interpolated_obs.fs);
-
-                            double time_factor = (T_rx_s - d_gnss_synchro_history->at(ch, t1_idx).RX_time) /
-                                                 (d_gnss_synchro_history->at(ch, t2_idx).RX_time -
-                                                     d_gnss_synchro_history->at(ch, t1_idx).RX_time);
-
-                            // CARRIER PHASE INTERPOLATION
-                            interpolated_obs.Carrier_phase_rads = d_gnss_synchro_history->at(ch, t1_idx).Carrier_phase_rads + (d_gnss_synchro_history->at(ch, t2_idx).Carrier_phase_rads - d_gnss_synchro_history->at(ch, t1_idx).Carrier_phase_rads) * time_factor;
-                            // CARRIER DOPPLER INTERPOLATION
-                            interpolated_obs.Carrier_Doppler_hz = d_gnss_synchro_history->at(ch, t1_idx).Carrier_Doppler_hz + (d_gnss_synchro_history->at(ch, t2_idx).Carrier_Doppler_hz - d_gnss_synchro_history->at(ch, t1_idx).Carrier_Doppler_hz) * time_factor;
-                            // TOW INTERPOLATION
-                            interpolated_obs.interp_TOW_ms = static_cast<double>(d_gnss_synchro_history->at(ch, t1_idx).TOW_at_current_symbol_ms) + (static_cast<double>(d_gnss_synchro_history->at(ch, t2_idx).TOW_at_current_symbol_ms) - static_cast<double>(d_gnss_synchro_history->at(ch, t1_idx).TOW_at_current_symbol_ms)) * time_factor;
-                            //
-                            // std::cout << "Rx samplestamp: " << T_rx_s << " Channel " << ch << " interp buff idx " << nearest_element
-                            //           << " ,diff: " << old_abs_diff << " samples (" << static_cast<double>(old_abs_diff) / static_cast<double>(d_gnss_synchro_history->at(ch, nearest_element).fs) << " s)\n";
-                            return true;
+                            d_interp_weights[idx] = weight;
+                            d_interp_carrier_phase_rads[idx] = node.Carrier_phase_rads;
+                            d_interp_carrier_doppler_hz[idx] = node.Carrier_Doppler_hz;
+                            d_interp_tow_ms[idx] = static_cast<double>(node.TOW_at_current_symbol_ms);
                         }
-                    return false;
+                    return true;
                 }
             // std::cout << "ALERT: Channel " << ch << " interp buff idx " << nearest_element
-            //           << " ,diff: " << old_abs_diff << " samples (" << static_cast<double>(old_abs_diff) / static_cast<double>(d_gnss_synchro_history->at(ch, nearest_element).fs) << " s)\n";
+            //           << " ,diff: " << old_abs_diff << " samples (" << static_cast<double>(old_abs_diff) / static_cast<double>(history[nearest_element].fs) << " s)\n";
             // usleep(1000);
         }
     return false;
 }
 
 
+void hybrid_observables_cc::interpolate_epoch(Gnss_Synchro **data)
+{
+    // Weighted sum of the nodes, accumulated in place in the first node of each array.
+    // The inner loops run over contiguous channels, so that the compiler can vectorize them.
+    double *weights = d_interp_weights.data();
+    double *phase = d_interp_carrier_phase_rads.data();
+    double *doppler = d_interp_carrier_doppler_hz.data();
+    double *tow = d_interp_tow_ms.data();
+    for (uint32_t n = 0; n < d_nchannels_out; n++)
+        {
+            phase[n] *= weights[n];
+            doppler[n] *= weights[n];
+            tow[n] *= weights[n];
+        }
+    for (uint32_t k = 1; k < d_interpolation_nodes; k++)
+        {
+            const uint32_t offset = k * d_nchannels_out;
+            for (uint32_t n = 0; n < d_nchannels_out; n++)
+                {
+                    phase[n] += weights[offset + n] * phase[offset + n];
+                    doppler[n] += weights[offset + n] * doppler[offset + n];
+                    tow[n] += weights[offset + n] * tow[offset + n];
+                }
+        }
+    for (uint32_t n = 0; n < d_nchannels_out; n++)
+        {
+            Gnss_Synchro &obs = data[n][0];
+            if (obs.Flag_valid_word)
+                {
+                    obs.Carrier_phase_rads = phase[n];
+                    obs.Carrier_Doppler_hz = doppler[n];
+                    obs.interp_TOW_ms = tow[n];
+                }
+        }
+}
+
+
 void hybrid_observables_cc::forecast(int noutput_items __attribute__((unused)), gr_vector_int &ninput_items_required)
 {
-    for (int32_t n = 0; n < static_cast<int32_t>(d_nchannels_in) - 1; n++)
+    for (int32_t n = 0; n < static_cast<int32_t>(d_nchannels_out); n++)
         {
             ninput_items_required[n] = 0;
         }
-    // last input channel is the sample counter, triggered each ms
-    ninput_items_required[d_nchannels_in - 1] = 1;
+    if (!d_shared_clock)
+        {
+            // last input channel is the sample counter, triggered each ms
+            ninput_items_required[d_nchannels_in - 1] = 1;
+        }
+}
+
+
+bool hybrid_observables_cc::push_shared_clock_epoch()
+{
+    if (d_epoch_samples == 0ULL)
+        {
+            const double fs = d_sample_clock->fs();
+            if (fs <= 0.0)
+                {
+                    return false;
+                }
+            d_epoch_samples = static_cast<uint64_t>(std::round(fs * static_cast<double>(d_observable_interval_ms) / 1e3));
+            d_next_epoch_sample = d_epoch_samples;
+            T_rx_clock_step_samples = std::round(fs * 1e-3);  // 1 ms
+            LOG(INFO) << "Observables clock step samples set to " << T_rx_clock_step_samples << ", epochs from the shared sample clock";
+        }
+    // One epoch per call, as the sample counter port gives
+    if (d_sample_clock->samples() < d_next_epoch_sample)
+        {
+            return false;
+        }
+    d_Rx_clock_buffer.push_back(d_next_epoch_sample);
+    d_Rx_clock_arrival.push_back(static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count()));
+    const uint64_t epoch_ms = d_next_epoch_sample / T_rx_clock_step_samples;
+    if (epoch_ms % 1000ULL < d_observable_interval_ms)
+        {
+            std::cout << "Current receiver time: " << epoch_ms / 1000ULL << " s" << std::endl;
+        }
+    d_next_epoch_sample += d_epoch_samples;
+    return true;
 }
 
 
-void hybrid_observables_cc::update_TOW(std::vector<Gnss_Synchro> &data)
+void hybrid_observables_cc::update_TOW(Gnss_Synchro **data)
 {
     //1. Set the TOW using the minimum TOW in the observables.
     //   this will be the receiver time.
     //2. If the TOW is set, it must be incremented by the desired receiver time step.
     //   the time step must match the observables timer block (connected to the las input channel)
-    std::vector<Gnss_Synchro>::iterator it;
     //    if (!T_rx_TOW_set)
     //        {
     //uint32_t TOW_ref = std::numeric_limits<uint32_t>::max();
     uint32_t TOW_ref = 0U;
-    for (it = data.begin(); it != data.end(); it++)
+    for (uint32_t n = 0; n < d_nchannels_out; n++)
         {
-            if (it->Flag_valid_word)
+            const Gnss_Synchro &obs = data[n][0];
+            if (obs.Flag_valid_word)
                 {
-                    if (it->TOW_at_current_symbol_ms > TOW_ref)
+                    if (obs.TOW_at_current_symbol_ms > TOW_ref)
                         {
-                            TOW_ref = it->TOW_at_current_symbol_ms;
+                            TOW_ref = obs.TOW_at_current_symbol_ms;
                             T_rx_TOW_set = true;
                         }
                 }
@@ -467,11 +414,11 @@ void hybrid_observables_cc::update_TOW(std::vector<Gnss_Synchro> &data)
 }
 
 
-void hybrid_observables_cc::compute_pranges(std::vector<Gnss_Synchro> &data)
+void hybrid_observables_cc::compute_pranges(Gnss_Synchro **data)
 {
-    std::vector<Gnss_Synchro>::iterator it;
-    for (it = data.begin(); it != data.end(); it++)
+    for (uint32_t n = 0; n < d_nchannels_out; n++)
         {
+            Gnss_Synchro *it = &data[n][0];
             if (it->Flag_valid_word)
                 {
                     double traveltime_s = (static_cast<double>(T_rx_TOW_ms) - it->interp_TOW_ms + GPS_STARTOFFSET_ms) / 1000.0;
@@ -496,12 +443,28 @@ int hybrid_observables_cc::general_work(int noutput_items __attribute__((unused)
 {
     const auto **in = reinterpret_cast<const Gnss_Synchro **>(&input_items[0]);
     auto **out = reinterpret_cast<Gnss_Synchro **>(&output_items[0]);
+    if (d_vector_output)
+        {
+            // out[n][0] is the observation of channel n in the single output item
+            auto *epoch = reinterpret_cast<Gnss_Synchro *>(output_items[0]);
+            for (uint32_t n = 0; n < d_nchannels_out; n++)
+                {
+                    d_epoch_out[n] = epoch + n;
+                }
+            out = d_epoch_out.data();
+        }
+    Gnss_Trace_Span span("observables");
 
     // Push receiver clock into history buffer (connected to the last of the input channels)
     // The clock buffer gives time to the channels to compute the tracking observables
-    if (ninput_items[d_nchannels_in - 1] > 0)
+    bool new_epoch = false;
+    if (!d_shared_clock and ninput_items[d_nchannels_in - 1] > 0)
         {
+            new_epoch = true;
             d_Rx_clock_buffer.push_back(in[d_nchannels_in - 1][0].Tracking_sample_counter);
+            std::vector<gr::tag_t> arrival_tags;
+            get_tags_in_range(arrival_tags, d_nchannels_in - 1, nitems_read(d_nchannels_in - 1), nitems_read(d_nchannels_in - 1) + 1, pmt::mp("arrival_time"));
+            d_Rx_clock_arrival.push_back(arrival_tags.empty() ? 0 : pmt::to_uint64(arrival_tags.front().value));
             if (T_rx_clock_step_samples == 0)
                 {
                     T_rx_clock_step_samples = std::round(static_cast<double>(in[d_nchannels_in - 1][0].fs) * 1e-3);  // 1 ms
@@ -519,6 +482,11 @@ int hybrid_observables_cc::general_work(int noutput_items __attribute__((unused)
             // Push the valid tracking Gnss_Synchros to their corresponding deque
             for (int32_t m = 0; m < ninput_items[n]; m++)
                 {
+                    if (d_shared_clock)
+                        {
+                            // the channels that do not advance the clock themselves
+                            d_sample_clock->advance(in[n][m].Tracking_sample_counter);
+                        }
                     if (in[n][m].Flag_valid_word)
                         {
                             if (d_gnss_synchro_history->size(n) > 0)
@@ -529,20 +497,27 @@ int hybrid_observables_cc::general_work(int noutput_items __attribute__((unused)
                                             d_gnss_synchro_history->clear(n);
                                         }
                                 }
-                            d_gnss_synchro_history->push_back(n, in[n][m]);
-                            d_gnss_synchro_history->back(n).RX_time = compute_T_rx_s(in[n][m]);
+                            Gnss_Synchro tracking_obs = in[n][m];
+                            tracking_obs.RX_time = compute_T_rx_s(in[n][m]);
+                            d_gnss_synchro_history->push_back(n, tracking_obs);
                         }
                 }
             consume(n, ninput_items[n]);
         }
 
-    if (d_Rx_clock_buffer.size() == d_Rx_clock_buffer.capacity())
+    if (d_shared_clock)
         {
-            std::vector<Gnss_Synchro> epoch_data;
+            new_epoch = push_shared_clock_epoch();
+        }
+
+    if (new_epoch and d_Rx_clock_buffer.size() == d_Rx_clock_buffer.capacity())
+        {
+            span.set_samples(d_Rx_clock_buffer.front(), d_Rx_clock_buffer.back());
+            // the epoch is assembled in place, in the output buffers
             int32_t n_valid = 0;
             for (uint32_t n = 0; n < d_nchannels_out; n++)
                 {
-                    Gnss_Synchro interpolated_gnss_synchro{};
+                    Gnss_Synchro &interpolated_gnss_synchro = out[n][0];
                     if (!interp_trk_obs(interpolated_gnss_synchro, n, d_Rx_clock_buffer.front() + T_rx_TOW_offset_ms * T_rx_clock_step_samples))
                         {
                             // Produce an empty observation
@@ -557,46 +532,43 @@ int hybrid_observables_cc::general_work(int noutput_items __attribute__((unused)
                         {
                             n_valid++;
                         }
-                    epoch_data.push_back(interpolated_gnss_synchro);
                 }
             if (n_valid > 0)
                 {
-                    update_TOW(epoch_data);
-                    if (T_rx_TOW_ms % 20 != 0)
+                    interpolate_epoch(out);
+                    update_TOW(out);
+                    if (T_rx_TOW_ms % d_observable_interval_ms != 0)
                         {
-                            T_rx_TOW_offset_ms = T_rx_TOW_ms % 20;
+                            T_rx_TOW_offset_ms = T_rx_TOW_ms % d_observable_interval_ms;
                         }
                 }
 
-            if (n_valid > 0) compute_pranges(epoch_data);
+            if (n_valid > 0) compute_pranges(out);
 
-            for (uint32_t n = 0; n < d_nchannels_out; n++)
-                {
-                    out[n][0] = epoch_data.at(n);
-                }
             if (d_dump)
                 {
-                    // MULTIPLEXED FILE RECORDING - Record results to file
+                    // MULTIPLEXED FILE RECORDING - Record results to file, if the dump policy lets it through
                     try
                         {
-                            double tmp_double;
+                            const double epoch_s = static_cast<double>(d_dump_epochs++ * d_observable_interval_ms) / 1000.0;
+                            // one record per epoch, written at once
+                            double *record = d_dump_record.data();
                             for (uint32_t i = 0; i < d_nchannels_out; i++)
                                 {
-                                    tmp_double = out[i][0].RX_time;
-                                    d_dump_file.write(reinterpret_cast<char *>(&tmp_double), sizeof(double));
-                                    tmp_double = out[i][0].interp_TOW_ms / 1000.0;
-                                    d_dump_file.write(reinterpret_cast<char *>(&tmp_double), sizeof(double));
-                                    tmp_double = out[i][0].Carrier_Doppler_hz;
-                                    d_dump_file.write(reinterpret_cast<char *>(&tmp_double), sizeof(double));
-                                    tmp_double = out[i][0].Carrier_phase_rads / GPS_TWO_PI;
-                                    d_dump_file.write(reinterpret_cast<char *>(&tmp_double), sizeof(double));
-                                    tmp_double = out[i][0].Pseudorange_m;
-                                    d_dump_file.write(reinterpret_cast<char *>(&tmp_double), sizeof(double));
-                                    tmp_double = static_cast<double>(out[i][0].PRN);
-                                    d_dump_file.write(reinterpret_cast<char *>(&tmp_double), sizeof(double));
-                                    tmp_double = static_cast<double>(out[i][0].Flag_valid_pseudorange);
-                                    d_dump_file.write(reinterpret_cast<char *>(&tmp_double), sizeof(double));
+                                    if (d_valid_pseudorange[i] and !out[i][0].Flag_valid_pseudorange)
+                                        {
+                                            d_dump_policy.trigger("loss of the pseudorange of channel " + std::to_string(i), epoch_s);
+                                        }
+                                    d_valid_pseudorange[i] = out[i][0].Flag_valid_pseudorange;
+                                    *record++ = out[i][0].RX_time;
+                                    *record++ = out[i][0].interp_TOW_ms / 1000.0;
+                                    *record++ = out[i][0].Carrier_Doppler_hz;
+                                    *record++ = out[i][0].Carrier_phase_rads / GPS_TWO_PI;
+                                    *record++ = out[i][0].Pseudorange_m;
+                                    *record++ = static_cast<double>(out[i][0].PRN);
+                                    *record++ = static_cast<double>(out[i][0].Flag_valid_pseudorange);
                                 }
+                            d_dump_policy.dump(d_dump_record.data(), epoch_s);
                         }
                     catch (const std::ifstream::failure &e)
                         {
@@ -604,6 +576,10 @@ int hybrid_observables_cc::general_work(int noutput_items __attribute__((unused)
                             d_dump = false;
                         }
                 }
+            if (d_Rx_clock_arrival.front() != 0)
+                {
+                    add_item_tag(0, nitems_written(0), pmt::mp("arrival_time"), pmt::from_uint64(d_Rx_clock_arrival.front()));
+                }
             return 1;
         }
     return 0;
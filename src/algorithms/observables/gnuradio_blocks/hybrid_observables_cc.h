@@ -7,7 +7,7 @@
  *
  * -------------------------------------------------------------------------
  *
- * Copyright (C) 2010-2018  (see AUTHORS file for a list of contributors)
+ * Copyright (C) 2010-2019  (see AUTHORS file for a list of contributors)
  *
  * GNSS-SDR is a software defined Global Navigation
  *          Satellite Systems receiver
@@ -35,12 +35,18 @@
 #define GNSS_SDR_HYBRID_OBSERVABLES_CC_H
 
 #include "gnss_circular_deque.h"
+#include "gnss_dump_policy.h"
+#include "gnss_mat_converter.h"
+#include "gnss_sdr_sample_clock.h"
 #include "gnss_synchro.h"
+#include <boost/circular_buffer.hpp>
 #include <boost/dynamic_bitset.hpp>
 #include <gnuradio/block.h>
 #include <fstream>
+#include <memory>
 #include <string>
 #include <utility>
+#include <vector>
 
 
 class hybrid_observables_cc;
@@ -48,7 +54,7 @@ class hybrid_observables_cc;
 typedef boost::shared_ptr<hybrid_observables_cc> hybrid_observables_cc_sptr;
 
 hybrid_observables_cc_sptr
-hybrid_make_observables_cc(unsigned int nchannels_in, unsigned int nchannels_out, bool dump, bool dump_mat, std::string dump_filename);
+hybrid_make_observables_cc(unsigned int nchannels_in, unsigned int nchannels_out, bool dump, bool dump_mat, std::string dump_filename, uint32_t observable_interval_ms, uint32_t interpolation_order, bool vector_output, const Gnss_Dump_Policy_Conf& dump_policy = Gnss_Dump_Policy_Conf());
 
 /*!
  * \brief This class implements a block that computes observables
@@ -63,17 +69,25 @@ public:
 
 private:
     friend hybrid_observables_cc_sptr
-    hybrid_make_observables_cc(uint32_t nchannels_in, uint32_t nchannels_out, bool dump, bool dump_mat, std::string dump_filename);
-    hybrid_observables_cc(uint32_t nchannels_in, uint32_t nchannels_out, bool dump, bool dump_mat, std::string dump_filename);
+    hybrid_make_observables_cc(uint32_t nchannels_in, uint32_t nchannels_out, bool dump, bool dump_mat, std::string dump_filename, uint32_t observable_interval_ms, uint32_t interpolation_order, bool vector_output, const Gnss_Dump_Policy_Conf& dump_policy);
+    hybrid_observables_cc(uint32_t nchannels_in, uint32_t nchannels_out, bool dump, bool dump_mat, std::string dump_filename, uint32_t observable_interval_ms, uint32_t interpolation_order, bool vector_output, const Gnss_Dump_Policy_Conf& dump_policy);
     bool interpolate_data(Gnss_Synchro& out, const uint32_t& ch, const double& ti);
     bool interp_trk_obs(Gnss_Synchro& interpolated_obs, const uint32_t& ch, const uint64_t& rx_clock);
+    void interpolate_epoch(Gnss_Synchro** data);
     double compute_T_rx_s(const Gnss_Synchro& a);
-    void compute_pranges(std::vector<Gnss_Synchro>& data);
-    void update_TOW(std::vector<Gnss_Synchro>& data);
+    void compute_pranges(Gnss_Synchro** data);
+    void update_TOW(Gnss_Synchro** data);
+    bool push_shared_clock_epoch();
     int32_t save_matfile();
 
     //time history
     boost::circular_buffer<uint64_t> d_Rx_clock_buffer;
+    boost::circular_buffer<uint64_t> d_Rx_clock_arrival;  // "arrival_time" tags of the receiver clock items, 0 if missing
+    // Without the sample counter port (nchannels_in == nchannels_out), the epochs are derived from the shared sample clock
+    bool d_shared_clock;
+    std::shared_ptr<Gnss_Sdr_Sample_Clock> d_sample_clock;
+    uint64_t d_epoch_samples;
+    uint64_t d_next_epoch_sample;
     //Tracking observable history
     Gnss_circular_deque<Gnss_Synchro>* d_gnss_synchro_history;
     uint32_t T_rx_clock_step_samples;
@@ -81,12 +95,28 @@ private:
     bool T_rx_TOW_set;
     uint32_t T_rx_TOW_ms;
     uint32_t T_rx_TOW_offset_ms;
+    uint32_t d_observable_interval_ms;
+    // Lagrange interpolation of the tracking history at the Rx clock, stored as structure of arrays:
+    // element [k * d_nchannels_out + ch] belongs to the k-th interpolation node of channel ch
+    uint32_t d_interpolation_nodes;
+    std::vector<double> d_interp_weights;
+    std::vector<double> d_interp_carrier_phase_rads;
+    std::vector<double> d_interp_carrier_doppler_hz;
+    std::vector<double> d_interp_tow_ms;
     bool d_dump;
     bool d_dump_mat;
+    std::shared_ptr<Gnss_Mat_Converter> d_mat_converter;  // background .mat conversion, shared by all the blocks
     uint32_t d_nchannels_in;
     uint32_t d_nchannels_out;
+    // All the channels of an epoch in a single output item, instead of one output port per channel
+    bool d_vector_output;
+    std::vector<Gnss_Synchro*> d_epoch_out;
     std::string d_dump_filename;
     std::ofstream d_dump_file;
+    std::vector<double> d_dump_record;
+    Gnss_Dump_Policy d_dump_policy;         // decimation and triggered mode of the dump
+    uint64_t d_dump_epochs;                 // epochs since the start, the time base of the dump policy
+    std::vector<bool> d_valid_pseudorange;  // of each output channel in the previous epoch, for the dump triggers
 };
 
 #endif
@@ -0,0 +1,161 @@
+/*!
+ * \file polyphase_resampler_conditioner.cc
+ * \brief Implementation of an adapter of a polyphase FIR resampler block
+ * to a SignalConditionerInterface
+ *
+ * -------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2019  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *          Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------
+ */
+
+#include "polyphase_resampler_conditioner.h"
+#include "configuration_interface.h"
+#include "polyphase_filter_bank.h"
+#include "polyphase_resampler_cc.h"
+#include "polyphase_resampler_cs.h"
+#include <glog/logging.h>
+#include <gnuradio/blocks/file_sink.h>
+#include <volk/volk.h>
+#include <cmath>
+#include <iostream>
+#include <limits>
+
+using google::LogMessage;
+
+PolyphaseResamplerConditioner::PolyphaseResamplerConditioner(
+    ConfigurationInterface* configuration, const std::string& role,
+    unsigned int in_stream, unsigned int out_stream) : role_(role), in_stream_(in_stream), out_stream_(out_stream)
+{
+    std::string default_item_type = "gr_complex";
+    std::string default_dump_file = "./data/signal_conditioner.dat";
+    std::string default_quality = "balanced";
+    double fs_in_deprecated, fs_in;
+    fs_in_deprecated = configuration->property("GNSS-SDR.internal_fs_hz", 2048000.0);
+    fs_in = configuration->property("GNSS-SDR.internal_fs_sps", fs_in_deprecated);
+    sample_freq_in_ = configuration->property(role_ + ".sample_freq_in", 4000000.0);
+    sample_freq_out_ = configuration->property(role_ + ".sample_freq_out", fs_in);
+    if (std::fabs(fs_in - sample_freq_out_) > std::numeric_limits<double>::epsilon())
+        {
+            std::string aux_warn = "CONFIGURATION WARNING: Parameters GNSS-SDR.internal_fs_sps and " + role_ + ".sample_freq_out are not set to the same value!";
+            LOG(WARNING) << aux_warn;
+            std::cout << aux_warn << std::endl;
+        }
+    item_type_ = configuration->property(role + ".item_type", default_item_type);
+    dump_ = configuration->property(role + ".dump", false);
+    DLOG(INFO) << "dump_ is " << dump_;
+    dump_filename_ = configuration->property(role + ".dump_filename", default_dump_file);
+
+    quality_ = configuration->property(role + ".quality", default_quality);
+    uint32_t default_taps_per_phase;
+    uint32_t default_phases;
+    double default_bandwidth;
+    if (!PolyphaseFilterBank::preset(quality_, default_taps_per_phase, default_phases, default_bandwidth))
+        {
+            LOG(WARNING) << quality_ << " unrecognized quality for " << role_ << ", using balanced";
+            quality_ = default_quality;
+        }
+    taps_per_phase_ = configuration->property(role + ".taps_per_phase", default_taps_per_phase);
+    phases_ = configuration->property(role + ".phases", default_phases);
+    bandwidth_ = configuration->property(role + ".bandwidth", default_bandwidth);
+
+    if (item_type_ == "gr_complex")
+        {
+            item_size_ = sizeof(gr_complex);
+            polyphase_resampler_cc_sptr resampler = make_polyphase_resampler_cc(sample_freq_in_, sample_freq_out_, taps_per_phase_, phases_, bandwidth_);
+            DLOG(INFO) << "Resampler taps " << resampler->bank().taps() << ", phases " << resampler->bank().phases()
+                       << ", stopband " << resampler->bank().stopband_attenuation_db() << " dB";
+            resampler_ = resampler;
+        }
+    else if (item_type_ == "cshort")
+        {
+            item_size_ = sizeof(lv_16sc_t);
+            polyphase_resampler_cs_sptr resampler = make_polyphase_resampler_cs(sample_freq_in_, sample_freq_out_, taps_per_phase_, phases_, bandwidth_);
+            DLOG(INFO) << "Resampler taps " << resampler->bank().taps() << ", phases " << resampler->bank().phases()
+                       << ", stopband " << resampler->bank().stopband_attenuation_db() << " dB";
+            resampler_ = resampler;
+        }
+    else
+        {
+            LOG(WARNING) << item_type_ << " unrecognized item type for resampler";
+            item_size_ = sizeof(gr_complex);
+        }
+    if (resampler_)
+        {
+            DLOG(INFO) << "sample_freq_in " << sample_freq_in_;
+            DLOG(INFO) << "sample_freq_out " << sample_freq_out_;
+            DLOG(INFO) << "Item size " << item_size_;
+            DLOG(INFO) << "resampler(" << resampler_->unique_id() << ")";
+        }
+    if (dump_)
+        {
+            DLOG(INFO) << "Dumping output into file " << dump_filename_;
+            file_sink_ = gr::blocks::file_sink::make(item_size_, dump_filename_.c_str());
+            DLOG(INFO) << "file_sink(" << file_sink_->unique_id() << ")";
+        }
+    if (in_stream_ > 1)
+        {
+            LOG(ERROR) << "This implementation only supports one input stream";
+        }
+    if (out_stream_ > 1)
+        {
+            LOG(ERROR) << "This implementation only supports one output stream";
+        }
+}
+
+
+PolyphaseResamplerConditioner::~PolyphaseResamplerConditioner() = default;
+
+
+void PolyphaseResamplerConditioner::connect(gr::top_block_sptr top_block)
+{
+    if (dump_)
+        {
+            top_block->connect(resampler_, 0, file_sink_, 0);
+            DLOG(INFO) << "connected resampler to file sink";
+        }
+    else
+        {
+            DLOG(INFO) << "nothing to connect internally";
+        }
+}
+
+
+void PolyphaseResamplerConditioner::disconnect(gr::top_block_sptr top_block)
+{
+    if (dump_)
+        {
+            top_block->disconnect(resampler_, 0, file_sink_, 0);
+        }
+}
+
+
+gr::basic_block_sptr PolyphaseResamplerConditioner::get_left_block()
+{
+    return resampler_;
+}
+
+
+gr::basic_block_sptr PolyphaseResamplerConditioner::get_right_block()
+{
+    return resampler_;
+}
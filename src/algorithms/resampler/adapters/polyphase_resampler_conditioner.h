@@ -0,0 +1,101 @@
+/*!
+ * \file polyphase_resampler_conditioner.h
+ * \brief Interface of an adapter of a polyphase FIR resampler block
+ * to a SignalConditionerInterface
+ *
+ * -------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2019  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *          Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------
+ */
+
+
+#ifndef GNSS_SDR_POLYPHASE_RESAMPLER_CONDITIONER_H_
+#define GNSS_SDR_POLYPHASE_RESAMPLER_CONDITIONER_H_
+
+#include "gnss_block_interface.h"
+#include <gnuradio/hier_block2.h>
+#include <cstdint>
+#include <string>
+
+class ConfigurationInterface;
+
+/*!
+ * \brief Interface of an adapter of a polyphase FIR resampler block
+ * to a SignalConditionerInterface
+ *
+ * Unlike Direct_Resampler, which picks the nearest input sample, this
+ * resampler filters and interpolates, so the channels can run at the lowest
+ * rate their signals need. The quality property selects a preset: "fast"
+ * (8 taps per phase, 32 phases), "balanced" (16 taps, 64 phases, the
+ * default) or "high" (32 taps, 256 phases). taps_per_phase, phases and
+ * bandwidth override single values of the preset.
+ */
+class PolyphaseResamplerConditioner : public GNSSBlockInterface
+{
+public:
+    PolyphaseResamplerConditioner(ConfigurationInterface* configuration,
+        const std::string& role, unsigned int in_stream,
+        unsigned int out_stream);
+
+    virtual ~PolyphaseResamplerConditioner();
+
+    inline std::string role() override
+    {
+        return role_;
+    }
+
+    //! Returns "Polyphase_Resampler"
+    inline std::string implementation() override
+    {
+        return "Polyphase_Resampler";
+    }
+
+    inline size_t item_size() override
+    {
+        return item_size_;
+    }
+
+    void connect(gr::top_block_sptr top_block) override;
+    void disconnect(gr::top_block_sptr top_block) override;
+    gr::basic_block_sptr get_left_block() override;
+    gr::basic_block_sptr get_right_block() override;
+
+private:
+    std::string role_;
+    unsigned int in_stream_;
+    unsigned int out_stream_;
+    std::string item_type_;
+    size_t item_size_;
+    bool dump_;
+    std::string dump_filename_;
+    double sample_freq_in_;
+    double sample_freq_out_;
+    std::string quality_;
+    uint32_t taps_per_phase_;
+    uint32_t phases_;
+    double bandwidth_;
+    gr::block_sptr resampler_;
+    gr::block_sptr file_sink_;
+};
+
+#endif /*GNSS_SDR_POLYPHASE_RESAMPLER_CONDITIONER_H_*/
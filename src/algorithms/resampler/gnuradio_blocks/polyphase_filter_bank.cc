@@ -0,0 +1,138 @@
+/*!
+ * \file polyphase_filter_bank.cc
+ * \brief Bank of windowed-sinc interpolation filters for the polyphase
+ * resamplers
+ *
+ * -------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2019  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *          Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------
+ */
+
+#include "polyphase_filter_bank.h"
+#include <algorithm>
+#include <cmath>
+
+
+namespace
+{
+// Zeroth order modified Bessel function of the first kind
+double bessel_i0(double x)
+{
+    double sum = 1.0;
+    double term = 1.0;
+    for (int k = 1; k < 50; k++)
+        {
+            term *= (x / (2.0 * k)) * (x / (2.0 * k));
+            sum += term;
+            if (term < sum * 1e-12)
+                {
+                    break;
+                }
+        }
+    return sum;
+}
+}  // namespace
+
+
+bool PolyphaseFilterBank::preset(const std::string& quality, uint32_t& taps_per_phase,
+    uint32_t& phases, double& bandwidth)
+{
+    if (quality == "fast")
+        {
+            taps_per_phase = 8;
+            phases = 32;
+            bandwidth = 0.8;
+            return true;
+        }
+    if (quality == "high")
+        {
+            taps_per_phase = 32;
+            phases = 256;
+            bandwidth = 0.9;
+            return true;
+        }
+    taps_per_phase = 16;
+    phases = 64;
+    bandwidth = 0.85;
+    return quality == "balanced";
+}
+
+
+PolyphaseFilterBank::PolyphaseFilterBank(double sample_freq_in, double sample_freq_out,
+    uint32_t taps_per_phase, uint32_t phases, double bandwidth)
+{
+    // Fraction of the input rate handled by the filter: the output rate when
+    // decimating, the whole input band when interpolating
+    const double rate = std::min(1.0, sample_freq_out / sample_freq_in);
+    bandwidth = std::max(0.1, std::min(bandwidth, 0.99));
+
+    d_taps = static_cast<uint32_t>(std::ceil(std::max(taps_per_phase, 2U) / rate));
+    d_taps += d_taps % 2;
+    d_phase_bits = 0;
+    while ((1U << d_phase_bits) < std::max(phases, 1U) && d_phase_bits < 16)
+        {
+            d_phase_bits++;
+        }
+    d_phases = 1U << d_phase_bits;
+
+    // Passband up to bandwidth / 2 and stopband from 1 - bandwidth / 2, in
+    // units of the lower rate: the transition band only aliases onto itself
+    const double cutoff = 0.5 * rate;
+    const double transition = (1.0 - bandwidth) * rate;
+    d_attenuation_db = 8.0 + 2.285 * 2.0 * M_PI * transition * d_taps;
+    double beta = 0.0;
+    if (d_attenuation_db > 50.0)
+        {
+            beta = 0.1102 * (d_attenuation_db - 8.7);
+        }
+    else if (d_attenuation_db > 21.0)
+        {
+            beta = 0.5842 * std::pow(d_attenuation_db - 21.0, 0.4) + 0.07886 * (d_attenuation_db - 21.0);
+        }
+    const double i0_beta = bessel_i0(beta);
+    const double half_span = 0.5 * d_taps;
+
+    d_bank.resize((d_phases + 1) * d_taps);
+    for (uint32_t p = 0; p <= d_phases; p++)
+        {
+            // Branch p is applied to x[i] ... x[i + taps - 1] and yields the
+            // signal at i + taps / 2 - 1 + p / phases
+            float* h = d_bank.data() + p * d_taps;
+            double sum = 0.0;
+            for (uint32_t m = 0; m < d_taps; m++)
+                {
+                    const double t = static_cast<double>(p) / static_cast<double>(d_phases) + half_span - 1.0 - static_cast<double>(m);
+                    const double x = 2.0 * cutoff * t;
+                    const double sinc = (std::fabs(x) < 1e-12) ? 1.0 : std::sin(M_PI * x) / (M_PI * x);
+                    const double r = t / half_span;
+                    const double window = (std::fabs(r) >= 1.0) ? 0.0 : bessel_i0(beta * std::sqrt(1.0 - r * r)) / i0_beta;
+                    h[m] = static_cast<float>(sinc * window);
+                    sum += h[m];
+                }
+            // Unity gain at DC on every branch
+            for (uint32_t m = 0; m < d_taps; m++)
+                {
+                    h[m] = static_cast<float>(h[m] / sum);
+                }
+        }
+}
@@ -0,0 +1,80 @@
+/*!
+ * \file polyphase_filter_bank.h
+ * \brief Bank of windowed-sinc interpolation filters for the polyphase
+ * resamplers
+ *
+ * The prototype low pass filter is designed with a Kaiser window and split
+ * into phases+1 branches, one for each fractional delay in steps of
+ * 1/phases input samples. The extra branch is the first one delayed by one
+ * sample, so that rounding the fractional delay never wraps the phase.
+ *
+ * -------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2019  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *          Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_POLYPHASE_FILTER_BANK_H
+#define GNSS_SDR_POLYPHASE_FILTER_BANK_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+class PolyphaseFilterBank
+{
+public:
+    /*!
+     * \brief Designs the filter bank.
+     *
+     * taps_per_phase is counted at the lower of both rates, so that
+     * the transition band keeps its width when decimating. bandwidth is the
+     * fraction of that rate kept free of aliases (0 < bandwidth < 1).
+     */
+    PolyphaseFilterBank(double sample_freq_in, double sample_freq_out,
+        uint32_t taps_per_phase, uint32_t phases, double bandwidth);
+
+    /*!
+     * \brief Parameters of a quality preset: "fast" (8 taps per phase,
+     * 32 phases), "balanced" (16 taps, 64 phases) or "high" (32 taps,
+     * 256 phases). Returns false, leaving "balanced" values, for any other name.
+     */
+    static bool preset(const std::string& quality, uint32_t& taps_per_phase,
+        uint32_t& phases, double& bandwidth);
+
+    inline uint32_t taps() const { return d_taps; }  //!< Input samples read by each output sample
+    inline uint32_t phases() const { return d_phases; }
+    inline uint32_t phase_bits() const { return d_phase_bits; }
+    inline double stopband_attenuation_db() const { return d_attenuation_db; }
+
+    //! Taps of the branch for a fractional delay of phase/phases() input samples (0 <= phase <= phases())
+    inline const float* branch(uint32_t phase) const { return d_bank.data() + phase * d_taps; }
+
+private:
+    uint32_t d_taps;
+    uint32_t d_phases;
+    uint32_t d_phase_bits;
+    double d_attenuation_db;
+    std::vector<float> d_bank;
+};
+
+#endif  // GNSS_SDR_POLYPHASE_FILTER_BANK_H
@@ -0,0 +1,100 @@
+/*!
+ * \file polyphase_resampler_cc.cc
+ * \brief Polyphase FIR arbitrary resampler with gr_complex input and
+ * gr_complex output
+ *
+ * -------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2019  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *          Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------
+ */
+
+#include "polyphase_resampler_cc.h"
+#include <gnuradio/io_signature.h>
+#include <volk/volk.h>
+#include <algorithm>
+#include <cmath>
+
+
+polyphase_resampler_cc_sptr make_polyphase_resampler_cc(double sample_freq_in, double sample_freq_out,
+    uint32_t taps_per_phase, uint32_t phases, double bandwidth)
+{
+    return polyphase_resampler_cc_sptr(new polyphase_resampler_cc(sample_freq_in, sample_freq_out,
+        taps_per_phase, phases, bandwidth));
+}
+
+
+polyphase_resampler_cc::polyphase_resampler_cc(double sample_freq_in, double sample_freq_out,
+    uint32_t taps_per_phase, uint32_t phases, double bandwidth) : gr::block("polyphase_resampler_cc",
+                                                                      gr::io_signature::make(1, 1, sizeof(gr_complex)),
+                                                                      gr::io_signature::make(1, 1, sizeof(gr_complex))),
+                                                                  d_sample_freq_in(sample_freq_in),
+                                                                  d_sample_freq_out(sample_freq_out),
+                                                                  d_bank(sample_freq_in, sample_freq_out, taps_per_phase, phases, bandwidth),
+                                                                  d_position(0)
+{
+    d_step = static_cast<uint64_t>(std::llround(4294967296.0 * sample_freq_in / sample_freq_out));
+    set_relative_rate(sample_freq_out / sample_freq_in);
+}
+
+
+polyphase_resampler_cc::~polyphase_resampler_cc() = default;
+
+
+void polyphase_resampler_cc::forecast(int noutput_items,
+    gr_vector_int &ninput_items_required)
+{
+    const uint64_t last = d_position + static_cast<uint64_t>(noutput_items) * d_step;
+    ninput_items_required[0] = static_cast<int>(last >> 32) + d_bank.taps();
+}
+
+
+int polyphase_resampler_cc::general_work(int noutput_items,
+    gr_vector_int &ninput_items, gr_vector_const_void_star &input_items,
+    gr_vector_void_star &output_items)
+{
+    const auto *in = reinterpret_cast<const gr_complex *>(input_items[0]);
+    auto *out = reinterpret_cast<gr_complex *>(output_items[0]);
+    const uint32_t taps = d_bank.taps();
+    const uint32_t shift = 32 - d_bank.phase_bits();
+    const uint64_t round_half = (static_cast<uint64_t>(1) << shift) >> 1;
+    const uint64_t available = ninput_items[0];
+
+    int produced = 0;
+    while (produced < noutput_items)
+        {
+            const uint64_t index = d_position >> 32;
+            if (index + taps > available)
+                {
+                    break;
+                }
+            const auto phase = static_cast<uint32_t>(((d_position & 0xFFFFFFFF) + round_half) >> shift);
+            volk_32fc_32f_dot_prod_32fc(&out[produced], in + index, d_bank.branch(phase), taps);
+            d_position += d_step;
+            produced++;
+        }
+
+    const uint64_t consumed = std::min(d_position >> 32, available);
+    d_position -= consumed << 32;
+    consume_each(static_cast<int>(consumed));
+    return produced;
+}
@@ -0,0 +1,79 @@
+/*!
+ * \file polyphase_resampler_cc.h
+ * \brief Polyphase FIR arbitrary resampler with gr_complex input and
+ * gr_complex output
+ *
+ * Each output sample is the dot product of the last input samples with the
+ * filter bank branch closest to its fractional delay. The position is
+ * tracked with a 32.32 fixed point accumulator, so the ratio does not
+ * drift over long runs.
+ *
+ * -------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2019  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *          Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_POLYPHASE_RESAMPLER_CC_H
+#define GNSS_SDR_POLYPHASE_RESAMPLER_CC_H
+
+#include "polyphase_filter_bank.h"
+#include <gnuradio/block.h>
+#include <cstdint>
+
+class polyphase_resampler_cc;
+typedef boost::shared_ptr<polyphase_resampler_cc> polyphase_resampler_cc_sptr;
+polyphase_resampler_cc_sptr
+make_polyphase_resampler_cc(double sample_freq_in, double sample_freq_out,
+    uint32_t taps_per_phase, uint32_t phases, double bandwidth);
+
+/*!
+ * \brief This class implements a polyphase FIR resampler for complex data
+ */
+class polyphase_resampler_cc : public gr::block
+{
+private:
+    friend polyphase_resampler_cc_sptr
+    make_polyphase_resampler_cc(double sample_freq_in, double sample_freq_out,
+        uint32_t taps_per_phase, uint32_t phases, double bandwidth);
+    polyphase_resampler_cc(double sample_freq_in, double sample_freq_out,
+        uint32_t taps_per_phase, uint32_t phases, double bandwidth);
+    double d_sample_freq_in;
+    double d_sample_freq_out;
+    PolyphaseFilterBank d_bank;
+    uint64_t d_step;      // Input samples per output sample, 32.32 fixed point
+    uint64_t d_position;  // Position of the next output sample in the input buffer, 32.32 fixed point
+
+public:
+    ~polyphase_resampler_cc();
+    inline double sample_freq_in() const { return d_sample_freq_in; }
+    inline double sample_freq_out() const { return d_sample_freq_out; }
+    inline const PolyphaseFilterBank &bank() const { return d_bank; }
+
+    void forecast(int noutput_items, gr_vector_int &ninput_items_required);
+
+    int general_work(int noutput_items, gr_vector_int &ninput_items,
+        gr_vector_const_void_star &input_items,
+        gr_vector_void_star &output_items);
+};
+
+#endif  // GNSS_SDR_POLYPHASE_RESAMPLER_CC_H
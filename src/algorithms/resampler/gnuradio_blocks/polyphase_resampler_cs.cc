@@ -0,0 +1,114 @@
+/*!
+ * \file polyphase_resampler_cs.cc
+ * \brief Polyphase FIR arbitrary resampler with lv_16sc_t input and
+ * lv_16sc_t output
+ *
+ * -------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2019  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *          Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------
+ */
+
+#include "polyphase_resampler_cs.h"
+#include <gnuradio/io_signature.h>
+#include <volk/volk.h>
+#include <volk_gnsssdr/volk_gnsssdr.h>
+#include <algorithm>
+#include <cmath>
+
+
+polyphase_resampler_cs_sptr make_polyphase_resampler_cs(double sample_freq_in, double sample_freq_out,
+    uint32_t taps_per_phase, uint32_t phases, double bandwidth)
+{
+    return polyphase_resampler_cs_sptr(new polyphase_resampler_cs(sample_freq_in, sample_freq_out,
+        taps_per_phase, phases, bandwidth));
+}
+
+
+polyphase_resampler_cs::polyphase_resampler_cs(double sample_freq_in, double sample_freq_out,
+    uint32_t taps_per_phase, uint32_t phases, double bandwidth) : gr::block("polyphase_resampler_cs",
+                                                                      gr::io_signature::make(1, 1, sizeof(lv_16sc_t)),
+                                                                      gr::io_signature::make(1, 1, sizeof(lv_16sc_t))),
+                                                                  d_sample_freq_in(sample_freq_in),
+                                                                  d_sample_freq_out(sample_freq_out),
+                                                                  d_bank(sample_freq_in, sample_freq_out, taps_per_phase, phases, bandwidth),
+                                                                  d_position(0)
+{
+    d_step = static_cast<uint64_t>(std::llround(4294967296.0 * sample_freq_in / sample_freq_out));
+    set_relative_rate(sample_freq_out / sample_freq_in);
+}
+
+
+polyphase_resampler_cs::~polyphase_resampler_cs() = default;
+
+
+void polyphase_resampler_cs::forecast(int noutput_items,
+    gr_vector_int &ninput_items_required)
+{
+    const uint64_t last = d_position + static_cast<uint64_t>(noutput_items) * d_step;
+    ninput_items_required[0] = static_cast<int>(last >> 32) + d_bank.taps();
+}
+
+
+int polyphase_resampler_cs::general_work(int noutput_items,
+    gr_vector_int &ninput_items, gr_vector_const_void_star &input_items,
+    gr_vector_void_star &output_items)
+{
+    const auto *in = reinterpret_cast<const lv_16sc_t *>(input_items[0]);
+    auto *out = reinterpret_cast<lv_16sc_t *>(output_items[0]);
+    const uint32_t taps = d_bank.taps();
+    const uint32_t shift = 32 - d_bank.phase_bits();
+    const uint64_t round_half = (static_cast<uint64_t>(1) << shift) >> 1;
+
+    // Widen only the samples this call can reach
+    const uint64_t last = d_position + static_cast<uint64_t>(noutput_items) * d_step;
+    const uint64_t available = std::min(static_cast<uint64_t>(ninput_items[0]), (last >> 32) + taps);
+    if (d_in_buffer.size() < available)
+        {
+            d_in_buffer.resize(available);
+        }
+    if (d_out_buffer.size() < static_cast<size_t>(noutput_items))
+        {
+            d_out_buffer.resize(noutput_items);
+        }
+    volk_gnsssdr_16ic_convert_32fc(d_in_buffer.data(), in, static_cast<unsigned int>(available));
+
+    int produced = 0;
+    while (produced < noutput_items)
+        {
+            const uint64_t index = d_position >> 32;
+            if (index + taps > available)
+                {
+                    break;
+                }
+            const auto phase = static_cast<uint32_t>(((d_position & 0xFFFFFFFF) + round_half) >> shift);
+            volk_32fc_32f_dot_prod_32fc(&d_out_buffer[produced], d_in_buffer.data() + index, d_bank.branch(phase), taps);
+            d_position += d_step;
+            produced++;
+        }
+    volk_gnsssdr_32fc_convert_16ic(out, d_out_buffer.data(), static_cast<unsigned int>(produced));
+
+    const uint64_t consumed = std::min(d_position >> 32, static_cast<uint64_t>(ninput_items[0]));
+    d_position -= consumed << 32;
+    consume_each(static_cast<int>(consumed));
+    return produced;
+}
@@ -0,0 +1,83 @@
+/*!
+ * \file polyphase_resampler_cs.h
+ * \brief Polyphase FIR arbitrary resampler with lv_16sc_t input and
+ * lv_16sc_t output
+ *
+ * Same filter as polyphase_resampler_cc. The input is widened to float
+ * before filtering and the output is rounded back to 16 bits, with
+ * saturation.
+ *
+ * -------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2019  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *          Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_POLYPHASE_RESAMPLER_CS_H
+#define GNSS_SDR_POLYPHASE_RESAMPLER_CS_H
+
+#include "polyphase_filter_bank.h"
+#include <gnuradio/block.h>
+#include <gnuradio/gr_complex.h>
+#include <cstdint>
+#include <vector>
+
+class polyphase_resampler_cs;
+typedef boost::shared_ptr<polyphase_resampler_cs> polyphase_resampler_cs_sptr;
+polyphase_resampler_cs_sptr
+make_polyphase_resampler_cs(double sample_freq_in, double sample_freq_out,
+    uint32_t taps_per_phase, uint32_t phases, double bandwidth);
+
+/*!
+ * \brief This class implements a polyphase FIR resampler for complex
+ * 16-bit integer data
+ */
+class polyphase_resampler_cs : public gr::block
+{
+private:
+    friend polyphase_resampler_cs_sptr
+    make_polyphase_resampler_cs(double sample_freq_in, double sample_freq_out,
+        uint32_t taps_per_phase, uint32_t phases, double bandwidth);
+    polyphase_resampler_cs(double sample_freq_in, double sample_freq_out,
+        uint32_t taps_per_phase, uint32_t phases, double bandwidth);
+    double d_sample_freq_in;
+    double d_sample_freq_out;
+    PolyphaseFilterBank d_bank;
+    uint64_t d_step;      // Input samples per output sample, 32.32 fixed point
+    uint64_t d_position;  // Position of the next output sample in the input buffer, 32.32 fixed point
+    std::vector<gr_complex> d_in_buffer;
+    std::vector<gr_complex> d_out_buffer;
+
+public:
+    ~polyphase_resampler_cs();
+    inline double sample_freq_in() const { return d_sample_freq_in; }
+    inline double sample_freq_out() const { return d_sample_freq_out; }
+    inline const PolyphaseFilterBank &bank() const { return d_bank; }
+
+    void forecast(int noutput_items, gr_vector_int &ninput_items_required);
+
+    int general_work(int noutput_items, gr_vector_int &ninput_items,
+        gr_vector_const_void_star &input_items,
+        gr_vector_void_star &output_items);
+};
+
+#endif  // GNSS_SDR_POLYPHASE_RESAMPLER_CS_H
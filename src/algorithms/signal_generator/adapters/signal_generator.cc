@@ -6,7 +6,7 @@
  *
  * -------------------------------------------------------------------------
  *
- * Copyright (C) 2010-2018  (see AUTHORS file for a list of contributors)
+ * Copyright (C) 2010-2019  (see AUTHORS file for a list of contributors)
  *
  * GNSS-SDR is a software defined Global Navigation
  *          Satellite Systems receiver
@@ -55,6 +55,9 @@ SignalGenerator::SignalGenerator(ConfigurationInterface* configuration,
     item_type_ = configuration->property(role + ".item_type", default_item_type);
     dump_ = configuration->property(role + ".dump", false);
     dump_filename_ = configuration->property(role + ".dump_filename", default_dump_file);
+    // Packed formats of the dump file, readable by File_Signal_Source with item_type=ishort or cbyte
+    dump_item_type_ = configuration->property(role + ".dump_item_type", default_item_type);
+    unsigned int num_threads = configuration->property(role + ".threads", 0);
 
     unsigned int fs_in = configuration->property("SignalSource.fs_hz", 4e6);
     bool data_flag = configuration->property("SignalSource.data_flag", false);
@@ -117,7 +120,7 @@ SignalGenerator::SignalGenerator(ConfigurationInterface* configuration,
             item_size_ = sizeof(gr_complex);
             DLOG(INFO) << "Item size " << item_size_;
             gen_source_ = signal_make_generator_c(signal1, system, PRN, CN0_dB, doppler_Hz, delay_chips, delay_sec,
-                data_flag, noise_flag, fs_in, vector_length, BW_BB);
+                data_flag, noise_flag, fs_in, vector_length, BW_BB, num_threads);
 
             vector_to_stream_ = gr::blocks::vector_to_stream::make(item_size_, vector_length);
 
@@ -134,7 +137,27 @@ SignalGenerator::SignalGenerator(ConfigurationInterface* configuration,
     if (dump_)
         {
             DLOG(INFO) << "Dumping output into file " << dump_filename_;
-            file_sink_ = gr::blocks::file_sink::make(item_size_, dump_filename_.c_str());
+            // The noise has unit variance per component, scale it to use the range of the integer formats
+            if (dump_item_type_ == "ishort")
+                {
+                    dump_scale_ = gr::blocks::multiply_const_cc::make(configuration->property(role + ".dump_scale", 1024.0));
+                    complex_to_ishort_ = gr::blocks::complex_to_interleaved_short::make();
+                    file_sink_ = gr::blocks::file_sink::make(sizeof(int16_t), dump_filename_.c_str());
+                }
+            else if (dump_item_type_ == "cbyte")
+                {
+                    dump_scale_ = gr::blocks::multiply_const_cc::make(configuration->property(role + ".dump_scale", 16.0));
+                    complex_to_cbyte_ = make_complex_float_to_complex_byte();
+                    file_sink_ = gr::blocks::file_sink::make(sizeof(int16_t), dump_filename_.c_str());
+                }
+            else
+                {
+                    if (dump_item_type_ != "gr_complex")
+                        {
+                            LOG(WARNING) << dump_item_type_ << " unrecognized dump item type, dumping gr_complex";
+                        }
+                    file_sink_ = gr::blocks::file_sink::make(item_size_, dump_filename_.c_str());
+                }
         }
     if (dump_)
         {
@@ -161,7 +184,21 @@ void SignalGenerator::connect(gr::top_block_sptr top_block)
             top_block->connect(gen_source_, 0, vector_to_stream_, 0);
             DLOG(INFO) << "connected gen_source to vector_to_stream";
 
-            if (dump_)
+            if (dump_ && complex_to_ishort_)
+                {
+                    top_block->connect(vector_to_stream_, 0, dump_scale_, 0);
+                    top_block->connect(dump_scale_, 0, complex_to_ishort_, 0);
+                    top_block->connect(complex_to_ishort_, 0, file_sink_, 0);
+                    DLOG(INFO) << "connected vector_to_stream_ to file sink through complex_to_interleaved_short";
+                }
+            else if (dump_ && complex_to_cbyte_)
+                {
+                    top_block->connect(vector_to_stream_, 0, dump_scale_, 0);
+                    top_block->connect(dump_scale_, 0, complex_to_cbyte_, 0);
+                    top_block->connect(complex_to_cbyte_, 0, file_sink_, 0);
+                    DLOG(INFO) << "connected vector_to_stream_ to file sink through complex_float_to_complex_byte";
+                }
+            else if (dump_)
                 {
                     top_block->connect(vector_to_stream_, 0, file_sink_, 0);
                     DLOG(INFO) << "connected vector_to_stream_ to file sink";
@@ -175,7 +212,19 @@ void SignalGenerator::disconnect(gr::top_block_sptr top_block)
     if (item_type_ == "gr_complex")
         {
             top_block->disconnect(gen_source_, 0, vector_to_stream_, 0);
-            if (dump_)
+            if (dump_ && complex_to_ishort_)
+                {
+                    top_block->disconnect(vector_to_stream_, 0, dump_scale_, 0);
+                    top_block->disconnect(dump_scale_, 0, complex_to_ishort_, 0);
+                    top_block->disconnect(complex_to_ishort_, 0, file_sink_, 0);
+                }
+            else if (dump_ && complex_to_cbyte_)
+                {
+                    top_block->disconnect(vector_to_stream_, 0, dump_scale_, 0);
+                    top_block->disconnect(dump_scale_, 0, complex_to_cbyte_, 0);
+                    top_block->disconnect(complex_to_cbyte_, 0, file_sink_, 0);
+                }
+            else if (dump_)
                 {
                     top_block->disconnect(vector_to_stream_, 0, file_sink_, 0);
                 }
@@ -6,7 +6,7 @@
  *
  * -------------------------------------------------------------------------
  *
- * Copyright (C) 2010-2018  (see AUTHORS file for a list of contributors)
+ * Copyright (C) 2010-2019  (see AUTHORS file for a list of contributors)
  *
  * GNSS-SDR is a software defined Global Navigation
  *          Satellite Systems receiver
@@ -35,7 +35,10 @@
 
 #include "gnss_block_interface.h"
 #include "signal_generator_c.h"
+#include "complex_float_to_complex_byte.h"
+#include <gnuradio/blocks/complex_to_interleaved_short.h>
 #include <gnuradio/blocks/file_sink.h>
+#include <gnuradio/blocks/multiply_const_cc.h>
 #include <gnuradio/blocks/vector_to_stream.h>
 #include <gnuradio/hier_block2.h>
 #include <gnuradio/msg_queue.h>
@@ -88,8 +91,12 @@ private:
     size_t item_size_;
     bool dump_;
     std::string dump_filename_;
+    std::string dump_item_type_;
     boost::shared_ptr<gr::block> gen_source_;
     gr::blocks::vector_to_stream::sptr vector_to_stream_;
+    gr::blocks::multiply_const_cc::sptr dump_scale_;
+    gr::blocks::complex_to_interleaved_short::sptr complex_to_ishort_;
+    complex_float_to_complex_byte_sptr complex_to_cbyte_;
     gr::blocks::file_sink::sptr file_sink_;
     boost::shared_ptr<gr::msg_queue> queue_;
 };
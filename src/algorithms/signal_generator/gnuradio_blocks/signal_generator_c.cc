@@ -5,7 +5,7 @@
 *
 * -------------------------------------------------------------------------
 *
-* Copyright (C) 2010-2018 (see AUTHORS file for a list of contributors)
+* Copyright (C) 2010-2019 (see AUTHORS file for a list of contributors)
 *
 * GNSS-SDR is a software defined Global Navigation
 * Satellite Systems receiver
@@ -38,11 +38,18 @@
 #include "glonass_l1_signal_processing.h"
 #include "gps_sdr_signal_processing.h"
 #include <gnuradio/io_signature.h>
+#include <volk/volk.h>
 #include <volk_gnsssdr/volk_gnsssdr.h>
+#include <algorithm>
+#include <cmath>
 #include <fstream>
+#include <thread>
 #include <utility>
 
 
+const unsigned int signal_generator_c::NOISE_BLOCK_SAMPLES;
+
+
 /*
 * Create a new instance of signal_generator_c and return
 * a boost shared_ptr. This is effectively the public constructor.
@@ -51,10 +58,10 @@ signal_generator_c_sptr
 signal_make_generator_c(std::vector<std::string> signal1, std::vector<std::string> system, const std::vector<unsigned int> &PRN,
     const std::vector<float> &CN0_dB, const std::vector<float> &doppler_Hz,
     const std::vector<unsigned int> &delay_chips, const std::vector<unsigned int> &delay_sec, bool data_flag, bool noise_flag,
-    unsigned int fs_in, unsigned int vector_length, float BW_BB)
+    unsigned int fs_in, unsigned int vector_length, float BW_BB, unsigned int num_threads)
 {
     return gnuradio::get_initial_sptr(new signal_generator_c(std::move(signal1), std::move(system), PRN, CN0_dB, doppler_Hz, delay_chips, delay_sec,
-        data_flag, noise_flag, fs_in, vector_length, BW_BB));
+        data_flag, noise_flag, fs_in, vector_length, BW_BB, num_threads));
 }
 
 
@@ -72,7 +79,8 @@ signal_generator_c::signal_generator_c(std::vector<std::string> signal1,
     bool noise_flag,
     unsigned int fs_in,
     unsigned int vector_length,
-    float BW_BB) : gr::block("signal_gen_cc", gr::io_signature::make(0, 0, sizeof(gr_complex)), gr::io_signature::make(1, 1, sizeof(gr_complex) * vector_length)),
+    float BW_BB,
+    unsigned int num_threads) : gr::block("signal_gen_cc", gr::io_signature::make(0, 0, sizeof(gr_complex)), gr::io_signature::make(1, 1, sizeof(gr_complex) * vector_length)),
                    signal_(std::move(signal1)),
                    system_(std::move(system)),
                    PRN_(PRN),
@@ -85,7 +93,8 @@ signal_generator_c::signal_generator_c(std::vector<std::string> signal1,
                    fs_in_(fs_in),
                    num_sats_(PRN.size()),
                    vector_length_(vector_length),
-                   BW_BB_(BW_BB * static_cast<float>(fs_in) / 2.0)
+                   BW_BB_(BW_BB * static_cast<float>(fs_in) / 2.0),
+                   num_threads_(num_threads)
 {
     init();
     generate_codes();
@@ -96,14 +105,34 @@ void signal_generator_c::init()
 {
     work_counter_ = 0;
 
-    complex_phase_ = static_cast<gr_complex *>(volk_gnsssdr_malloc(vector_length_ * sizeof(gr_complex), volk_gnsssdr_get_alignment()));
+    if (num_threads_ == 0)
+        {
+            num_threads_ = std::thread::hardware_concurrency();
+        }
+    num_threads_ = std::max(1U, std::min(num_threads_, num_sats_));
+    const unsigned int alignment = volk_gnsssdr_get_alignment();
+    for (unsigned int t = 0; t < num_threads_; t++)
+        {
+            Worker worker{};
+            worker.sum = static_cast<gr_complex *>(volk_gnsssdr_malloc(vector_length_ * sizeof(gr_complex), alignment));
+            worker.segment = static_cast<gr_complex *>(volk_gnsssdr_malloc(vector_length_ * sizeof(gr_complex), alignment));
+            worker.uniform = static_cast<float *>(volk_gnsssdr_malloc(2 * NOISE_BLOCK_SAMPLES * sizeof(float), alignment));
+            worker.radius = static_cast<float *>(volk_gnsssdr_malloc(NOISE_BLOCK_SAMPLES * sizeof(float), alignment));
+            worker.noise = static_cast<gr_complex *>(volk_gnsssdr_malloc(NOISE_BLOCK_SAMPLES * sizeof(gr_complex), alignment));
+            workers_.push_back(worker);
+        }
+
+    std::random_device r;
+    noise_seed_ = (static_cast<uint64_t>(r()) << 32) | r();
 
     // True if Galileo satellites are present
     bool galileo_signal = std::find(system_.begin(), system_.end(), "E") != system_.end();
 
     for (unsigned int sat = 0; sat < num_sats_; sat++)
         {
-            start_phase_rad_.push_back(0);
+            carrier_phase_rad_.push_back(0.0);
+            carrier_phase_step_rad_.push_back(GPS_TWO_PI * doppler_Hz_[sat] / static_cast<double>(fs_in_));
+            data_bit_generators_.emplace_back(r());
             current_data_bit_int_.push_back(1);
             current_data_bits_.emplace_back(1, 0);
             ms_counter_.push_back(0);
@@ -120,6 +149,9 @@ void signal_generator_c::init()
             else if (system_[sat] == "R")
                 {
                     samples_per_code_.push_back(round(static_cast<float>(fs_in_) / (GLONASS_L1_CA_CODE_RATE_HZ / GLONASS_L1_CA_CODE_LENGTH_CHIPS)));
+                    // the intermediate frequency must be set by the user
+                    const double freq = 4e6;
+                    carrier_phase_step_rad_[sat] = GPS_TWO_PI * (freq + (DFRQ1_GLO * GLONASS_PRN.at(PRN_[sat])) + doppler_Hz_[sat]) / static_cast<double>(fs_in_);
 
                     num_of_codes_per_vector_.push_back(galileo_signal ? 4 * static_cast<int>(Galileo_E1_C_SECONDARY_CODE_LENGTH) : 1);
                     data_bit_duration_ms_.push_back(1e3 / GLONASS_GNAV_TELEMETRY_RATE_BITS_SECOND);
@@ -143,9 +175,6 @@ void signal_generator_c::init()
                         }
                 }
         }
-    std::default_random_engine e1(r());
-    std::default_random_engine e2(r());
-    std::uniform_int_distribution<int> uniform_dist(0, RAND_MAX);
 }
 
 
@@ -156,7 +185,8 @@ void signal_generator_c::generate_codes()
 
     for (unsigned int sat = 0; sat < num_sats_; sat++)
         {
-            sampled_code_data_[sat] = static_cast<gr_complex *>(std::malloc(vector_length_ * sizeof(gr_complex)));
+            sampled_code_data_[sat] = static_cast<gr_complex *>(volk_gnsssdr_malloc(vector_length_ * sizeof(gr_complex), volk_gnsssdr_get_alignment()));
+            sampled_code_pilot_[sat] = nullptr;
 
             gr_complex code[64000];  //[samples_per_code_[sat]];
 
@@ -221,6 +251,10 @@ void signal_generator_c::generate_codes()
                                             sampled_code_data_[sat][i] *= sqrt(pow(10, CN0_dB_[sat] / 10) / BW_BB_ / 2);
                                         }
                                 }
+
+                            // gr_complex(I * d, Q * p) is d * code if d == p, and d * conj(code) otherwise
+                            sampled_code_pilot_[sat] = static_cast<gr_complex *>(volk_gnsssdr_malloc(vector_length_ * sizeof(gr_complex), volk_gnsssdr_get_alignment()));
+                            volk_32fc_conjugate_32fc(sampled_code_pilot_[sat], sampled_code_data_[sat], vector_length_);
                         }
                     else
                         {
@@ -249,7 +283,7 @@ void signal_generator_c::generate_codes()
                                 }
 
                             // Generate E1C signal (25 code-periods, with secondary code)
-                            sampled_code_pilot_[sat] = static_cast<gr_complex *>(std::malloc(vector_length_ * sizeof(gr_complex)));
+                            sampled_code_pilot_[sat] = static_cast<gr_complex *>(volk_gnsssdr_malloc(vector_length_ * sizeof(gr_complex), volk_gnsssdr_get_alignment()));
 
                             strcpy(signal, "1C");
 
@@ -264,6 +298,15 @@ void signal_generator_c::generate_codes()
                                             sampled_code_pilot_[sat][i] *= sqrt(pow(10, CN0_dB_[sat] / 10) / BW_BB_ / 2);
                                         }
                                 }
+
+                            // E1B * bit - E1C is data - pilot for bit 1, and -(data + pilot) for bit -1
+                            for (unsigned int i = 0; i < vector_length_; i++)
+                                {
+                                    gr_complex data = sampled_code_data_[sat][i];
+                                    gr_complex pilot = sampled_code_pilot_[sat][i];
+                                    sampled_code_data_[sat][i] = data - pilot;
+                                    sampled_code_pilot_[sat][i] = data + pilot;
+                                }
                         }
                 }
         }
@@ -272,179 +315,217 @@ void signal_generator_c::generate_codes()
 
 signal_generator_c::~signal_generator_c()
 {
-    /*  for (unsigned int sat = 0; sat < num_sats_; sat++)
+    for (unsigned int sat = 0; sat < num_sats_; sat++)
         {
-            std::free(sampled_code_data_[sat]);
-            if (system_[sat] == "E" && signal_[sat].at(0) != '5')
+            volk_gnsssdr_free(sampled_code_data_[sat]);
+            if (sampled_code_pilot_[sat] != nullptr)
                 {
-                    std::free(sampled_code_pilot_[sat]);
+                    volk_gnsssdr_free(sampled_code_pilot_[sat]);
                 }
-        } */
-    volk_gnsssdr_free(complex_phase_);
+        }
+    for (auto &worker : workers_)
+        {
+            volk_gnsssdr_free(worker.sum);
+            volk_gnsssdr_free(worker.segment);
+            volk_gnsssdr_free(worker.uniform);
+            volk_gnsssdr_free(worker.radius);
+            volk_gnsssdr_free(worker.noise);
+        }
 }
 
 
-int signal_generator_c::general_work(int noutput_items __attribute__((unused)),
-    gr_vector_int &ninput_items __attribute__((unused)),
-    gr_vector_const_void_star &input_items __attribute__((unused)),
-    gr_vector_void_star &output_items)
+void signal_generator_c::run_workers(const std::function<void(unsigned int)> &task)
 {
-    auto *out = reinterpret_cast<gr_complex *>(output_items[0]);
-
-    work_counter_++;
-
-    unsigned int out_idx = 0;
-    unsigned int i = 0;
-    unsigned int k = 0;
-    // the intermediate frequency must be set by the user
-    unsigned int freq = 4e6;
-
-    for (out_idx = 0; out_idx < vector_length_; out_idx++)
+    std::vector<std::thread> threads;
+    for (unsigned int t = 1; t < num_threads_; t++)
         {
-            out[out_idx] = gr_complex(0.0, 0.0);
+            threads.emplace_back(task, t);
         }
-
-    for (unsigned int sat = 0; sat < num_sats_; sat++)
+    task(0);
+    for (auto &thread : threads)
         {
-            float phase_step_rad = -static_cast<float>(GPS_TWO_PI) * doppler_Hz_[sat] / static_cast<float>(fs_in_);
-            float _phase[1];
-            _phase[0] = -start_phase_rad_[sat];
-            volk_gnsssdr_s32f_sincos_32fc(complex_phase_, -phase_step_rad, _phase, vector_length_);
-            start_phase_rad_[sat] += vector_length_ * phase_step_rad;
-
-            out_idx = 0;
+            thread.join();
+        }
+}
 
-            if (system_[sat] == "G")
-                {
-                    unsigned int delay_samples = (delay_chips_[sat] % static_cast<int>(GPS_L1_CA_CODE_LENGTH_CHIPS)) * samples_per_code_[sat] / GPS_L1_CA_CODE_LENGTH_CHIPS;
 
-                    for (i = 0; i < num_of_codes_per_vector_[sat]; i++)
-                        {
-                            for (k = 0; k < delay_samples; k++)
-                                {
-                                    out[out_idx] += sampled_code_data_[sat][out_idx] * current_data_bits_[sat] * complex_phase_[out_idx];
-                                    out_idx++;
-                                }
+void signal_generator_c::add_segment(const gr_complex *code, float sign, unsigned int first, unsigned int length,
+    gr_complex &phase, gr_complex phase_step, Worker &worker)
+{
+    if (length == 0)
+        {
+            return;
+        }
+    volk_32fc_s32fc_x2_rotator_32fc(worker.segment, code + first, phase_step, &phase, length);
+    auto *sum = reinterpret_cast<float *>(worker.sum + first);
+    const auto *segment = reinterpret_cast<const float *>(worker.segment);
+    if (sign > 0.0)
+        {
+            volk_32f_x2_add_32f(sum, sum, segment, 2 * length);
+        }
+    else
+        {
+            volk_32f_x2_subtract_32f(sum, sum, segment, 2 * length);
+        }
+}
 
-                            if (ms_counter_[sat] == 0 && data_flag_)
-                                {
-                                    // New random data bit
-                                    current_data_bits_[sat] = gr_complex((uniform_dist(e1) % 2) == 0 ? 1 : -1, 0);
-                                }
 
-                            for (k = delay_samples; k < samples_per_code_[sat]; k++)
-                                {
-                                    out[out_idx] += sampled_code_data_[sat][out_idx] * current_data_bits_[sat] * complex_phase_[out_idx];
-                                    out_idx++;
-                                }
+void signal_generator_c::add_satellite(unsigned int sat, Worker &worker)
+{
+    gr_complex phase = std::polar(1.0F, static_cast<float>(carrier_phase_rad_[sat]));
+    const gr_complex phase_step = std::polar(1.0F, static_cast<float>(carrier_phase_step_rad_[sat]));
+    carrier_phase_rad_[sat] = std::fmod(carrier_phase_rad_[sat] + carrier_phase_step_rad_[sat] * vector_length_, GPS_TWO_PI);
 
-                            ms_counter_[sat] = (ms_counter_[sat] + static_cast<int>(round(1e3 * GPS_L1_CA_CODE_PERIOD))) % data_bit_duration_ms_[sat];
-                        }
-                }
+    unsigned int out_idx = 0;
+    unsigned int code_length_chips = 0;
+    double code_period_s = 0.0;
+    if (system_[sat] == "G")
+        {
+            code_length_chips = static_cast<unsigned int>(GPS_L1_CA_CODE_LENGTH_CHIPS);
+            code_period_s = GPS_L1_CA_CODE_PERIOD;
+        }
+    else if (system_[sat] == "R")
+        {
+            code_length_chips = static_cast<unsigned int>(GLONASS_L1_CA_CODE_LENGTH_CHIPS);
+            code_period_s = GLONASS_L1_CA_CODE_PERIOD;
+        }
+    else if (system_[sat] == "E" && signal_[sat].at(0) == '5')
+        {
+            // EACH WORK outputs 1 modulated primary code
+            unsigned int codelen = static_cast<unsigned int>(Galileo_E5a_CODE_LENGTH_CHIPS);
+            unsigned int delay_samples = (delay_chips_[sat] % codelen) * samples_per_code_[sat] / codelen;
+            const gr_complex *code = data_modulation_[sat] == pilot_modulation_[sat] ? sampled_code_data_[sat] : sampled_code_pilot_[sat];
+            add_segment(code, data_modulation_[sat], 0, delay_samples, phase, phase_step, worker);
 
-            else if (system_[sat] == "R")
+            if (ms_counter_[sat] % data_bit_duration_ms_[sat] == 0 && data_flag_)
                 {
-                    phase_step_rad = -static_cast<float>(GPS_TWO_PI) * (freq + (DFRQ1_GLO * GLONASS_PRN.at(PRN_[sat])) + doppler_Hz_[sat]) / static_cast<float>(fs_in_);
-                    // std::cout << "sat " << PRN_[sat] << " SG - Freq = " << (freq + (DFRQ1_GLO * GLONASS_PRN.at(PRN_[sat]))) << " Doppler = " << doppler_Hz_[sat] << std::endl;
-                    _phase[0] = -start_phase_rad_[sat];
-                    volk_gnsssdr_s32f_sincos_32fc(complex_phase_, -phase_step_rad, _phase, vector_length_);
-
-                    unsigned int delay_samples = (delay_chips_[sat] % static_cast<int>(GLONASS_L1_CA_CODE_LENGTH_CHIPS)) * samples_per_code_[sat] / GLONASS_L1_CA_CODE_LENGTH_CHIPS;
+                    // New random data bit
+                    current_data_bit_int_[sat] = (data_bit_generators_[sat]() % 2) == 0 ? 1 : -1;
+                }
+            data_modulation_[sat] = current_data_bit_int_[sat] * (Galileo_E5a_I_SECONDARY_CODE.at((ms_counter_[sat] + delay_sec_[sat]) % 20) == '0' ? 1 : -1);
+            pilot_modulation_[sat] = (Galileo_E5a_Q_SECONDARY_CODE[PRN_[sat] - 1].at((ms_counter_[sat] + delay_sec_[sat]) % 100) == '0' ? 1 : -1);
 
-                    for (i = 0; i < num_of_codes_per_vector_[sat]; i++)
-                        {
-                            for (k = 0; k < delay_samples; k++)
-                                {
-                                    out[out_idx] += sampled_code_data_[sat][out_idx] * current_data_bits_[sat] * complex_phase_[out_idx];
-                                    out_idx++;
-                                }
+            ms_counter_[sat] = ms_counter_[sat] + static_cast<int>(round(1e3 * GALILEO_E5a_CODE_PERIOD));
 
-                            if (ms_counter_[sat] == 0 && data_flag_)
-                                {
-                                    // New random data bit
-                                    current_data_bits_[sat] = gr_complex((uniform_dist(e1) % 2) == 0 ? 1 : -1, 0);
-                                }
+            code = data_modulation_[sat] == pilot_modulation_[sat] ? sampled_code_data_[sat] : sampled_code_pilot_[sat];
+            add_segment(code, data_modulation_[sat], delay_samples, samples_per_code_[sat] - delay_samples, phase, phase_step, worker);
+            return;
+        }
+    else if (system_[sat] == "E")
+        {
+            code_length_chips = static_cast<unsigned int>(Galileo_E1_B_CODE_LENGTH_CHIPS);
+            code_period_s = Galileo_E1_CODE_PERIOD;
+        }
+    else
+        {
+            return;
+        }
 
-                            for (k = delay_samples; k < samples_per_code_[sat]; k++)
-                                {
-                                    out[out_idx] += sampled_code_data_[sat][out_idx] * current_data_bits_[sat] * complex_phase_[out_idx];
-                                    out_idx++;
-                                }
+    // GPS, GLONASS and Galileo E1: the data bits can only change at the start of a delayed code period
+    unsigned int delay_samples = (delay_chips_[sat] % code_length_chips) * samples_per_code_[sat] / code_length_chips;
+    bool galileo_e1 = system_[sat] == "E";
+    for (unsigned int i = 0; i < num_of_codes_per_vector_[sat]; i++)
+        {
+            float bit = current_data_bits_[sat].real();
+            const gr_complex *code = (galileo_e1 && bit < 0.0) ? sampled_code_pilot_[sat] : sampled_code_data_[sat];
+            add_segment(code, bit, out_idx, delay_samples, phase, phase_step, worker);
+            out_idx += delay_samples;
 
-                            ms_counter_[sat] = (ms_counter_[sat] + static_cast<int>(round(1e3 * GLONASS_L1_CA_CODE_PERIOD))) % data_bit_duration_ms_[sat];
-                        }
+            if (ms_counter_[sat] == 0 && data_flag_)
+                {
+                    // New random data bit
+                    current_data_bits_[sat] = gr_complex((data_bit_generators_[sat]() % 2) == 0 ? 1 : -1, 0);
                 }
 
-            else if (system_[sat] == "E")
-                {
-                    if (signal_[sat].at(0) == '5')
-                        {
-                            // EACH WORK outputs 1 modulated primary code
-                            int codelen = static_cast<int>(Galileo_E5a_CODE_LENGTH_CHIPS);
-                            unsigned int delay_samples = (delay_chips_[sat] % codelen) * samples_per_code_[sat] / codelen;
-                            for (k = 0; k < delay_samples; k++)
-                                {
-                                    out[out_idx] += (gr_complex(sampled_code_data_[sat][out_idx].real() * data_modulation_[sat],
-                                                        sampled_code_data_[sat][out_idx].imag() * pilot_modulation_[sat])) *
-                                                    complex_phase_[out_idx];
-                                    out_idx++;
-                                }
+            bit = current_data_bits_[sat].real();
+            code = (galileo_e1 && bit < 0.0) ? sampled_code_pilot_[sat] : sampled_code_data_[sat];
+            add_segment(code, bit, out_idx, samples_per_code_[sat] - delay_samples, phase, phase_step, worker);
+            out_idx += samples_per_code_[sat] - delay_samples;
 
-                            if (ms_counter_[sat] % data_bit_duration_ms_[sat] == 0 && data_flag_)
-                                {
-                                    // New random data bit
-                                    current_data_bit_int_[sat] = (uniform_dist(e1) % 2) == 0 ? 1 : -1;
-                                }
-                            data_modulation_[sat] = current_data_bit_int_[sat] * (Galileo_E5a_I_SECONDARY_CODE.at((ms_counter_[sat] + delay_sec_[sat]) % 20) == '0' ? 1 : -1);
-                            pilot_modulation_[sat] = (Galileo_E5a_Q_SECONDARY_CODE[PRN_[sat] - 1].at((ms_counter_[sat] + delay_sec_[sat]) % 100) == '0' ? 1 : -1);
+            ms_counter_[sat] = (ms_counter_[sat] + static_cast<int>(round(1e3 * code_period_s))) % data_bit_duration_ms_[sat];
+        }
+}
 
-                            ms_counter_[sat] = ms_counter_[sat] + static_cast<int>(round(1e3 * GALILEO_E5a_CODE_PERIOD));
 
-                            for (k = delay_samples; k < samples_per_code_[sat]; k++)
-                                {
-                                    out[out_idx] += (gr_complex(sampled_code_data_[sat][out_idx].real() * data_modulation_[sat],
-                                                        sampled_code_data_[sat][out_idx].imag() * pilot_modulation_[sat])) *
-                                                    complex_phase_[out_idx];
-                                    out_idx++;
-                                }
-                        }
-                    else
-                        {
-                            unsigned int delay_samples = (delay_chips_[sat] % static_cast<int>(Galileo_E1_B_CODE_LENGTH_CHIPS)) * samples_per_code_[sat] / Galileo_E1_B_CODE_LENGTH_CHIPS;
+void signal_generator_c::add_noise(gr_complex *out, unsigned int length, uint64_t seed, Worker &worker)
+{
+    // xorshift128+ seeded with splitmix64, much faster than std::normal_distribution
+    auto splitmix64 = [](uint64_t &x) {
+        uint64_t z = (x += 0x9E3779B97F4A7C15ULL);
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+        return z ^ (z >> 31);
+    };
+    uint64_t s0 = splitmix64(seed);
+    uint64_t s1 = splitmix64(seed);
+    auto next = [&s0, &s1]() {
+        uint64_t x = s0;
+        const uint64_t y = s1;
+        s0 = y;
+        x ^= x << 23;
+        s1 = x ^ y ^ (x >> 17) ^ (y >> 26);
+        return s1 + y;
+    };
+
+    // 24-bit uniform deviates: u1 in (0, 1] for the radius, u2 - 0.5 in [-0.5, 0.5) for the angle
+    const float scale = 1.0F / 16777216.0F;
+    float *u1 = worker.uniform;
+    float *angle = worker.uniform + NOISE_BLOCK_SAMPLES;
+    for (unsigned int n = 0; n < length; n++)
+        {
+            const uint64_t x = next();
+            u1[n] = static_cast<float>((x >> 40) + 1) * scale;
+            angle[n] = static_cast<float>((x >> 16) & 0xFFFFFF) * scale - 0.5F;
+        }
 
-                            for (i = 0; i < num_of_codes_per_vector_[sat]; i++)
-                                {
-                                    for (k = 0; k < delay_samples; k++)
-                                        {
-                                            out[out_idx] += (sampled_code_data_[sat][out_idx] * current_data_bits_[sat] - sampled_code_pilot_[sat][out_idx]) * complex_phase_[out_idx];
-                                            out_idx++;
-                                        }
+    // Box-Muller: radius sqrt(-2 ln(u1)), angle 2 pi (u2 - 0.5), unit variance per component
+    volk_32f_log2_32f(worker.radius, u1, length);
+    volk_32f_s32f_multiply_32f(worker.radius, worker.radius, static_cast<float>(-2.0 * std::log(2.0)), length);
+    volk_32f_sqrt_32f(worker.radius, worker.radius, length);
+    volk_32f_s32f_multiply_32f(angle, angle, static_cast<float>(GPS_TWO_PI), length);
+    volk_gnsssdr_32f_sincos_32fc(worker.noise, angle, length);
+    volk_32fc_32f_multiply_32fc(worker.noise, worker.noise, worker.radius, length);
+    volk_32f_x2_add_32f(reinterpret_cast<float *>(out), reinterpret_cast<const float *>(out), reinterpret_cast<const float *>(worker.noise), 2 * length);
+}
 
-                                    if (ms_counter_[sat] == 0 && data_flag_)
-                                        {
-                                            // New random data bit
-                                            current_data_bits_[sat] = gr_complex((uniform_dist(e1) % 2) == 0 ? 1 : -1, 0);
-                                        }
 
-                                    for (k = delay_samples; k < samples_per_code_[sat]; k++)
-                                        {
-                                            out[out_idx] += (sampled_code_data_[sat][out_idx] * current_data_bits_[sat] - sampled_code_pilot_[sat][out_idx]) * complex_phase_[out_idx];
-                                            out_idx++;
-                                        }
+int signal_generator_c::general_work(int noutput_items __attribute__((unused)),
+    gr_vector_int &ninput_items __attribute__((unused)),
+    gr_vector_const_void_star &input_items __attribute__((unused)),
+    gr_vector_void_star &output_items)
+{
+    auto *out = reinterpret_cast<gr_complex *>(output_items[0]);
 
-                                    ms_counter_[sat] = (ms_counter_[sat] + static_cast<int>(round(1e3 * Galileo_E1_CODE_PERIOD))) % data_bit_duration_ms_[sat];
-                                }
-                        }
-                }
-        }
+    work_counter_++;
 
-    if (noise_flag_)
-        {
-            for (out_idx = 0; out_idx < vector_length_; out_idx++)
-                {
-                    out[out_idx] += gr_complex(normal_dist(e1), normal_dist(e2));
-                }
-        }
+    // Each thread adds up the carrier-rotated codes of its satellites
+    run_workers([this](unsigned int t) {
+        std::fill_n(workers_[t].sum, vector_length_, gr_complex(0.0, 0.0));
+        for (unsigned int sat = t; sat < num_sats_; sat += num_threads_)
+            {
+                add_satellite(sat, workers_[t]);
+            }
+    });
+
+    // Then each thread adds up the sums and the noise of a set of blocks of the output
+    const unsigned int num_blocks = (vector_length_ + NOISE_BLOCK_SAMPLES - 1) / NOISE_BLOCK_SAMPLES;
+    run_workers([this, out, num_blocks](unsigned int t) {
+        for (unsigned int block = t; block < num_blocks; block += num_threads_)
+            {
+                const unsigned int first = block * NOISE_BLOCK_SAMPLES;
+                const unsigned int length = std::min(NOISE_BLOCK_SAMPLES, vector_length_ - first);
+                auto *out_block = reinterpret_cast<float *>(out + first);
+                std::copy_n(workers_[0].sum + first, length, out + first);
+                for (unsigned int w = 1; w < num_threads_; w++)
+                    {
+                        volk_32f_x2_add_32f(out_block, out_block, reinterpret_cast<const float *>(workers_[w].sum + first), 2 * length);
+                    }
+                if (noise_flag_)
+                    {
+                        add_noise(out + first, length, noise_seed_ ^ ((static_cast<uint64_t>(work_counter_) << 32) + block), workers_[t]);
+                    }
+            }
+    });
 
     // Tell runtime system how many output items we produced.
     return 1;
@@ -5,7 +5,7 @@
  *
  * -------------------------------------------------------------------------
  *
- * Copyright (C) 2010-2018  (see AUTHORS file for a list of contributors)
+ * Copyright (C) 2010-2019  (see AUTHORS file for a list of contributors)
  *
  * GNSS-SDR is a software defined Global Navigation
  *          Satellite Systems receiver
@@ -35,6 +35,8 @@
 #include <boost/scoped_array.hpp>
 //#include <gnuradio/random.h>
 #include <gnuradio/block.h>
+#include <cstdint>
+#include <functional>
 #include <random>
 #include <string>
 #include <vector>
@@ -65,12 +67,18 @@ signal_generator_c_sptr
 signal_make_generator_c(std::vector<std::string> signal1, std::vector<std::string> system, const std::vector<unsigned int> &PRN,
     const std::vector<float> &CN0_dB, const std::vector<float> &doppler_Hz,
     const std::vector<unsigned int> &delay_chips, const std::vector<unsigned int> &delay_sec, bool data_flag, bool noise_flag,
-    unsigned int fs_in, unsigned int vector_length, float BW_BB);
+    unsigned int fs_in, unsigned int vector_length, float BW_BB, unsigned int num_threads = 0);
 
 /*!
 * \brief This class generates synthesized GNSS signal.
 * \ingroup block
 *
+* The satellites are split among num_threads threads (0: one per core),
+* each one adding up the carrier-rotated codes of its satellites. Then the
+* threads add up their sums and the noise, block by block. The noise of
+* each block is seeded from its position in the stream, so for a given seed
+* the output does not depend on the number of threads.
+*
 * \sa gen_source for a version that subclasses gr_block.
 */
 class signal_generator_c : public gr::block
@@ -84,15 +92,32 @@ private:
     signal_make_generator_c(std::vector<std::string> signal1, std::vector<std::string> system, const std::vector<unsigned int> &PRN,
         const std::vector<float> &CN0_dB, const std::vector<float> &doppler_Hz,
         const std::vector<unsigned int> &delay_chips, const std::vector<unsigned int> &delay_sec, bool data_flag, bool noise_flag,
-        unsigned int fs_in, unsigned int vector_length, float BW_BB);
+        unsigned int fs_in, unsigned int vector_length, float BW_BB, unsigned int num_threads);
 
     signal_generator_c(std::vector<std::string> signal1, std::vector<std::string> system, const std::vector<unsigned int> &PRN,
         std::vector<float> CN0_dB, std::vector<float> doppler_Hz,
         std::vector<unsigned int> delay_chips, std::vector<unsigned int> delay_sec, bool data_flag, bool noise_flag,
-        unsigned int fs_in, unsigned int vector_length, float BW_BB);
+        unsigned int fs_in, unsigned int vector_length, float BW_BB, unsigned int num_threads);
+
+    // Buffers of each thread
+    struct Worker
+    {
+        gr_complex *sum;        // carrier-rotated codes of the satellites of the thread
+        gr_complex *segment;    // a carrier-rotated code segment
+        float *uniform;         // 2 * NOISE_BLOCK_SAMPLES uniform deviates in (0, 1]
+        float *radius;          // Box-Muller radii
+        gr_complex *noise;      // a block of complex Gaussian noise
+    };
+
+    static const unsigned int NOISE_BLOCK_SAMPLES = 4096;
 
     void init();
     void generate_codes();
+    void run_workers(const std::function<void(unsigned int)> &task);
+    void add_satellite(unsigned int sat, Worker &worker);
+    void add_segment(const gr_complex *code, float sign, unsigned int first, unsigned int length,
+        gr_complex &phase, gr_complex phase_step, Worker &worker);
+    void add_noise(gr_complex *out, unsigned int length, uint64_t seed, Worker &worker);
 
     std::vector<std::string> signal_;
     std::vector<std::string> system_;
@@ -112,23 +137,23 @@ private:
     std::vector<unsigned int> num_of_codes_per_vector_;
     std::vector<unsigned int> data_bit_duration_ms_;
     std::vector<unsigned int> ms_counter_;
-    std::vector<float> start_phase_rad_;
+    std::vector<double> carrier_phase_rad_;       // carrier phase of each satellite at the start of the next vector
+    std::vector<double> carrier_phase_step_rad_;  // carrier phase increment per sample
     std::vector<gr_complex> current_data_bits_;
     std::vector<signed int> current_data_bit_int_;
     std::vector<signed int> data_modulation_;
     std::vector<signed int> pilot_modulation_;
+    std::vector<std::mt19937> data_bit_generators_;  // one per satellite, so the threads do not share them
+    uint64_t noise_seed_;
 
+    // Galileo E1: data - pilot and data + pilot, for each data bit sign
+    // Galileo E5a: the code and its conjugate, for equal and opposite data and pilot signs
     boost::scoped_array<gr_complex *> sampled_code_data_;
     boost::scoped_array<gr_complex *> sampled_code_pilot_;
-    //gr::random *random_;
-    gr_complex *complex_phase_;
 
+    unsigned int num_threads_;
+    std::vector<Worker> workers_;
     unsigned int work_counter_;
-    std::random_device r;
-    std::default_random_engine e1;
-    std::default_random_engine e2;
-    std::uniform_int_distribution<int> uniform_dist;
-    std::normal_distribution<float> normal_dist;
 
 public:
     ~signal_generator_c();  // public destructor
@@ -33,6 +33,7 @@
 #include "custom_udp_signal_source.h"
 #include "GPS_L1_CA.h"
 #include "configuration_interface.h"
+#include "ring_file_recorder.h"
 #include <boost/format.hpp>
 #include <glog/logging.h>
 #include <iostream>
@@ -52,6 +53,10 @@ CustomUDPSignalSource::CustomUDPSignalSource(ConfigurationInterface* configurati
     std::string default_item_type = "gr_complex";
     dump_ = configuration->property(role + ".dump", false);
     dump_filename_ = configuration->property(role + ".dump_filename", default_dump_file);
+    // a ring of dump_ring_MB megabytes and a writer thread of its own make the
+    // dump drop samples rather than stall the receiver (0: synchronous file sink)
+    dump_ring_MB_ = configuration->property(role + ".dump_ring_MB", 0);
+    dump_requantize_bits_ = configuration->property(role + ".dump_requantize_bits", 0);
 
     // network PARAMETERS
     std::string default_capture_device = "eth0";
@@ -62,6 +67,15 @@ CustomUDPSignalSource::CustomUDPSignalSource(ConfigurationInterface* configurati
     int port = configuration->property(role + ".port", default_port);
     int payload_bytes = configuration->property(role + ".payload_bytes", 1024);
 
+    // capture backend: "pcap" (raw capture on capture_device), "socket" (batched reads from UDP sockets)
+    // or "packet_mmap" (frames of capture_device read in place from a ring shared with the kernel, Linux only)
+    std::string default_capture_backend = "pcap";
+    std::string capture_backend = configuration->property(role + ".capture_backend", default_capture_backend);
+    int socket_threads = configuration->property(role + ".socket_threads", 1);
+    int socket_rcvbuf_bytes = configuration->property(role + ".socket_rcvbuf_bytes", 33554432);
+    // bytes of the big endian packet counter at the start of each payload, 0 if none
+    int sequence_bytes = configuration->property(role + ".sequence_bytes", 0);
+
     RF_channels_ = configuration->property(role + ".RF_channels", 1);
     channels_in_udp_ = configuration->property(role + ".channels_in_udp", 1);
     IQ_swap_ = configuration->property(role + ".IQ_swap", false);
@@ -79,7 +93,11 @@ CustomUDPSignalSource::CustomUDPSignalSource(ConfigurationInterface* configurati
         channels_in_udp_,
         sample_type,
         item_size_,
-        IQ_swap_);
+        IQ_swap_,
+        capture_backend,
+        socket_threads,
+        socket_rcvbuf_bytes,
+        sequence_bytes);
 
     if (channels_in_udp_ >= RF_channels_)
         {
@@ -99,7 +117,15 @@ CustomUDPSignalSource::CustomUDPSignalSource(ConfigurationInterface* configurati
             for (int n = 0; n < channels_in_udp_; n++)
                 {
                     DLOG(INFO) << "Dumping output into file " << (dump_filename_ + "c_h" + std::to_string(n) + ".bin");
-                    file_sink_.push_back(gr::blocks::file_sink::make(item_size_, (dump_filename_ + "_ch" + std::to_string(n) + ".bin").c_str()));
+                    std::string filename = dump_filename_ + "_ch" + std::to_string(n) + ".bin";
+                    if (dump_ring_MB_ > 0)
+                        {
+                            file_sink_.push_back(make_ring_file_recorder(item_size_, item_type_, filename, static_cast<size_t>(dump_ring_MB_) * 1048576, dump_requantize_bits_));
+                        }
+                    else
+                        {
+                            file_sink_.push_back(gr::blocks::file_sink::make(item_size_, filename.c_str()));
+                        }
                 }
         }
     if (in_stream_ > 0)
@@ -96,6 +96,8 @@ private:
     size_t item_size_;
     bool dump_;
     std::string dump_filename_;
+    int dump_ring_MB_;
+    int dump_requantize_bits_;
     std::vector<boost::shared_ptr<gr::block>> null_sinks_;
     gr_complex_ip_packet_source::sptr udp_gnss_rx_source_;
     std::vector<boost::shared_ptr<gr::block>> file_sink_;
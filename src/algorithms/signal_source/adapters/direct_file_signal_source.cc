@@ -0,0 +1,367 @@
+/*!
+ * \file direct_file_signal_source.cc
+ * \brief Implementation of a class that reads signal samples from a file
+ * with O_DIRECT asynchronous reads and adapts it to a SignalSourceInterface
+ *
+ * -------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2018  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *          Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------
+ */
+
+#include "direct_file_signal_source.h"
+#include "configuration_interface.h"
+#include "gnss_sdr_flags.h"
+#include "gnss_sdr_valve.h"
+#include <glog/logging.h>
+#include <algorithm>
+#include <cmath>
+#include <exception>
+#include <iomanip>
+#include <iostream>  // for std::cerr
+#include <utility>
+
+
+using google::LogMessage;
+
+
+DirectFileSignalSource::DirectFileSignalSource(ConfigurationInterface* configuration,
+    const std::string& role, unsigned int in_streams, unsigned int out_streams,
+    boost::shared_ptr<gr::msg_queue> queue) : role_(role), in_streams_(in_streams), out_streams_(out_streams), queue_(std::move(queue))
+{
+    std::string default_filename = "./example_capture.dat";
+    std::string default_item_type = "short";
+    std::string default_dump_filename = "./my_capture.dat";
+
+    double default_seconds_to_skip = 0.0;
+    size_t header_size = 0;
+    samples_ = configuration->property(role + ".samples", 0);
+    sampling_frequency_ = configuration->property(role + ".sampling_frequency", 0);
+    filename_ = configuration->property(role + ".filename", default_filename);
+
+    // override value with commandline flag, if present
+    if (FLAGS_signal_source != "-") filename_ = FLAGS_signal_source;
+    if (FLAGS_s != "-") filename_ = FLAGS_s;
+
+    item_type_ = configuration->property(role + ".item_type", default_item_type);
+    repeat_ = configuration->property(role + ".repeat", false);
+    dump_ = configuration->property(role + ".dump", false);
+    dump_filename_ = configuration->property(role + ".dump_filename", default_dump_filename);
+    enable_throttle_control_ = configuration->property(role + ".enable_throttle_control", false);
+    buffer_size_ = configuration->property(role + ".buffer_size", 4194304);
+    buffers_ = configuration->property(role + ".buffers", 8);
+
+    double seconds_to_skip = configuration->property(role + ".seconds_to_skip", default_seconds_to_skip);
+    double seconds_to_process = configuration->property(role + ".seconds_to_process", 0.0);
+    header_size = configuration->property(role + ".header_size", 0);
+    int64_t samples_to_skip = 0;
+
+    bool is_complex = false;
+
+    if (item_type_ == "gr_complex")
+        {
+            item_size_ = sizeof(gr_complex);
+        }
+    else if (item_type_ == "float")
+        {
+            item_size_ = sizeof(float);
+        }
+    else if (item_type_ == "short")
+        {
+            item_size_ = sizeof(int16_t);
+        }
+    else if (item_type_ == "ishort")
+        {
+            item_size_ = sizeof(int16_t);
+            is_complex = true;
+        }
+    else if (item_type_ == "byte")
+        {
+            item_size_ = sizeof(int8_t);
+        }
+    else if (item_type_ == "ibyte")
+        {
+            item_size_ = sizeof(int8_t);
+            is_complex = true;
+        }
+    else
+        {
+            LOG(WARNING) << item_type_
+                         << " unrecognized item type. Using gr_complex.";
+            item_size_ = sizeof(gr_complex);
+        }
+    if (seconds_to_skip > 0)
+        {
+            samples_to_skip = static_cast<int64_t>(seconds_to_skip * sampling_frequency_);
+
+            if (is_complex)
+                {
+                    samples_to_skip *= 2;
+                }
+        }
+    if (header_size > 0)
+        {
+            samples_to_skip += header_size;
+        }
+    if (samples_to_skip > 0)
+        {
+            LOG(INFO) << "Skipping " << samples_to_skip << " samples of the input file";
+        }
+    try
+        {
+            file_source_ = direct_make_file_source(item_size_, filename_, samples_to_skip, repeat_, buffer_size_, buffers_);
+        }
+    catch (const std::exception& e)
+        {
+            if (filename_ == default_filename)
+                {
+                    std::cerr
+                        << "The configuration file has not been found."
+                        << std::endl
+                        << "Please create a configuration file based on the examples at the 'conf/' folder "
+                        << std::endl
+                        << "and then generate your own GNSS Software Defined Receiver by doing:"
+                        << std::endl
+                        << "$ gnss-sdr --config_file=/path/to/my_GNSS_SDR_configuration.conf"
+                        << std::endl;
+                }
+            else
+                {
+                    std::cerr
+                        << "The receiver was configured to work with a file signal source "
+                        << std::endl
+                        << "but the specified file is unreachable by GNSS-SDR."
+                        << std::endl
+                        << "Please modify your configuration file"
+                        << std::endl
+                        << "and point SignalSource.filename to a valid raw data file. Then:"
+                        << std::endl
+                        << "$ gnss-sdr --config_file=/path/to/my_GNSS_SDR_configuration.conf"
+                        << std::endl
+                        << "Examples of configuration files available at:"
+                        << std::endl
+                        << GNSSSDR_INSTALL_DIR "/share/gnss-sdr/conf/"
+                        << std::endl;
+                }
+
+            LOG(INFO) << "direct_file_signal_source: Unable to open the samples file "
+                      << filename_.c_str() << " (" << e.what() << "), exiting the program.";
+            throw(e);
+        }
+
+    DLOG(INFO) << "direct_file_source(" << file_source_->unique_id() << ")";
+
+    if (samples_ == 0)  // read all file
+        {
+            /*!
+             * As with File_Signal_Source, the valve stops the receiver: process all the
+             * samples after the offset, excluding the last 2 milliseconds
+             */
+            std::streamsize ss = std::cout.precision();
+            std::cout << std::setprecision(16);
+            std::cout << "Processing file " << filename_ << ", which contains " << static_cast<double>(file_source_->items() * item_size_) << " [bytes] after the offset" << std::endl;
+            std::cout.precision(ss);
+            samples_ = floor(static_cast<double>(file_source_->items()) - ceil(0.002 * static_cast<double>(sampling_frequency_)));
+        }
+
+    if (seconds_to_process > 0)
+        {
+            // process a time segment of the file, starting at seconds_to_skip
+            auto samples_to_process = static_cast<uint64_t>(seconds_to_process * sampling_frequency_);
+            if (is_complex)
+                {
+                    samples_to_process *= 2;
+                }
+            samples_ = std::min(samples_, samples_to_process);
+            LOG(INFO) << "Processing " << seconds_to_process << " s of the input file";
+        }
+
+    CHECK(samples_ > 0) << "File does not contain enough samples to process.";
+    double signal_duration_s;
+    signal_duration_s = static_cast<double>(samples_) * (1 / static_cast<double>(sampling_frequency_));
+
+    if (is_complex)
+        {
+            signal_duration_s /= 2.0;
+        }
+
+    DLOG(INFO) << "Total number samples to be processed= " << samples_ << " GNSS signal duration= " << signal_duration_s << " [s]";
+    std::cout << "GNSS signal recorded time to be processed: " << signal_duration_s << " [s]" << std::endl;
+
+    valve_ = gnss_sdr_make_valve(item_size_, samples_, queue_);
+    DLOG(INFO) << "valve(" << valve_->unique_id() << ")";
+
+    if (dump_)
+        {
+            sink_ = gr::blocks::file_sink::make(item_size_, dump_filename_.c_str());
+            DLOG(INFO) << "file_sink(" << sink_->unique_id() << ")";
+        }
+
+    if (enable_throttle_control_)
+        {
+            throttle_ = gr::blocks::throttle::make(item_size_, sampling_frequency_);
+        }
+
+    DLOG(INFO) << "File source filename " << filename_;
+    DLOG(INFO) << "Samples " << samples_;
+    DLOG(INFO) << "Sampling frequency " << sampling_frequency_;
+    DLOG(INFO) << "Item type " << item_type_;
+    DLOG(INFO) << "Item size " << item_size_;
+    DLOG(INFO) << "Repeat " << repeat_;
+    DLOG(INFO) << "Read buffers " << buffers_ << " x " << buffer_size_ << " bytes";
+    DLOG(INFO) << "Dump " << dump_;
+    DLOG(INFO) << "Dump filename " << dump_filename_;
+    if (in_streams_ > 0)
+        {
+            LOG(ERROR) << "A signal source does not have an input stream";
+        }
+    if (out_streams_ > 1)
+        {
+            LOG(ERROR) << "This implementation only supports one output stream";
+        }
+}
+
+
+DirectFileSignalSource::~DirectFileSignalSource() = default;
+
+
+void DirectFileSignalSource::connect(gr::top_block_sptr top_block)
+{
+    if (samples_ > 0)
+        {
+            if (enable_throttle_control_ == true)
+                {
+                    top_block->connect(file_source_, 0, throttle_, 0);
+                    DLOG(INFO) << "connected file source to throttle";
+                    top_block->connect(throttle_, 0, valve_, 0);
+                    DLOG(INFO) << "connected throttle to valve";
+                    if (dump_)
+                        {
+                            top_block->connect(valve_, 0, sink_, 0);
+                            DLOG(INFO) << "connected valve to file sink";
+                        }
+                }
+            else
+                {
+                    top_block->connect(file_source_, 0, valve_, 0);
+                    DLOG(INFO) << "connected file source to valve";
+                    if (dump_)
+                        {
+                            top_block->connect(valve_, 0, sink_, 0);
+                            DLOG(INFO) << "connected valve to file sink";
+                        }
+                }
+        }
+    else
+        {
+            if (enable_throttle_control_ == true)
+                {
+                    top_block->connect(file_source_, 0, throttle_, 0);
+                    DLOG(INFO) << "connected file source to throttle";
+                    if (dump_)
+                        {
+                            top_block->connect(file_source_, 0, sink_, 0);
+                            DLOG(INFO) << "connected file source to sink";
+                        }
+                }
+            else
+                {
+                    if (dump_)
+                        {
+                            top_block->connect(file_source_, 0, sink_, 0);
+                            DLOG(INFO) << "connected file source to sink";
+                        }
+                }
+        }
+}
+
+
+void DirectFileSignalSource::disconnect(gr::top_block_sptr top_block)
+{
+    if (samples_ > 0)
+        {
+            if (enable_throttle_control_ == true)
+                {
+                    top_block->disconnect(file_source_, 0, throttle_, 0);
+                    DLOG(INFO) << "disconnected file source to throttle";
+                    top_block->disconnect(throttle_, 0, valve_, 0);
+                    DLOG(INFO) << "disconnected throttle to valve";
+                    if (dump_)
+                        {
+                            top_block->disconnect(valve_, 0, sink_, 0);
+                            DLOG(INFO) << "disconnected valve to file sink";
+                        }
+                }
+            else
+                {
+                    top_block->disconnect(file_source_, 0, valve_, 0);
+                    DLOG(INFO) << "disconnected file source to valve";
+                    if (dump_)
+                        {
+                            top_block->disconnect(valve_, 0, sink_, 0);
+                            DLOG(INFO) << "disconnected valve to file sink";
+                        }
+                }
+        }
+    else
+        {
+            if (enable_throttle_control_ == true)
+                {
+                    top_block->disconnect(file_source_, 0, throttle_, 0);
+                    DLOG(INFO) << "disconnected file source to throttle";
+                    if (dump_)
+                        {
+                            top_block->disconnect(file_source_, 0, sink_, 0);
+                            DLOG(INFO) << "disconnected file source to sink";
+                        }
+                }
+            else
+                {
+                    if (dump_)
+                        {
+                            top_block->disconnect(file_source_, 0, sink_, 0);
+                            DLOG(INFO) << "disconnected file source to sink";
+                        }
+                }
+        }
+}
+
+
+gr::basic_block_sptr DirectFileSignalSource::get_left_block()
+{
+    LOG(WARNING) << "Left block of a signal source should not be retrieved";
+    return direct_file_source_sptr();
+}
+
+
+gr::basic_block_sptr DirectFileSignalSource::get_right_block()
+{
+    if (samples_ > 0)
+        {
+            return valve_;
+        }
+    if (enable_throttle_control_ == true)
+        {
+            return throttle_;
+        }
+    return file_source_;
+}
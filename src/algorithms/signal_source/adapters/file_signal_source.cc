@@ -35,6 +35,7 @@
 #include "gnss_sdr_flags.h"
 #include "gnss_sdr_valve.h"
 #include <glog/logging.h>
+#include <algorithm>
 #include <exception>
 #include <fstream>
 #include <iomanip>
@@ -70,6 +71,7 @@ FileSignalSource::FileSignalSource(ConfigurationInterface* configuration,
     enable_throttle_control_ = configuration->property(role + ".enable_throttle_control", false);
 
     double seconds_to_skip = configuration->property(role + ".seconds_to_skip", default_seconds_to_skip);
+    double seconds_to_process = configuration->property(role + ".seconds_to_process", 0.0);
     header_size = configuration->property(role + ".header_size", 0);
     int64_t samples_to_skip = 0;
 
@@ -207,6 +209,18 @@ FileSignalSource::FileSignalSource(ConfigurationInterface* configuration,
                 }
         }
 
+    if (seconds_to_process > 0)
+        {
+            // process a time segment of the file, starting at seconds_to_skip
+            auto samples_to_process = static_cast<uint64_t>(seconds_to_process * sampling_frequency_);
+            if (is_complex)
+                {
+                    samples_to_process *= 2;
+                }
+            samples_ = std::min(samples_, samples_to_process);
+            LOG(INFO) << "Processing " << seconds_to_process << " s of the input file";
+        }
+
     CHECK(samples_ > 0) << "File does not contain enough samples to process.";
     double signal_duration_s;
     signal_duration_s = static_cast<double>(samples_) * (1 / static_cast<double>(sampling_frequency_));
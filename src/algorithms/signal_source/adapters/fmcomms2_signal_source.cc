@@ -35,7 +35,9 @@
 #include "ad9361_manager.h"
 #include "configuration_interface.h"
 #include "gnss_sdr_valve.h"
+#include "iio_cshort_source.h"
 #include <glog/logging.h>
+#include <volk_gnsssdr/volk_gnsssdr_complex.h>
 #include <exception>
 #include <iostream>
 #include <utility>
@@ -67,6 +69,9 @@ Fmcomms2SignalSource::Fmcomms2SignalSource(ConfigurationInterface* configuration
     rf_port_select_ = configuration->property(role + ".rf_port_select", std::string("A_BALANCED"));
     filter_file_ = configuration->property(role + ".filter_file", std::string(""));
     filter_auto_ = configuration->property(role + ".filter_auto", true);
+    // buffers of buffer_size samples in the kernel and in the ring of the cshort source
+    kernel_buffers_ = configuration->property(role + ".kernel_buffers", 4);
+    buffers_ = configuration->property(role + ".buffers", 3);
     item_type_ = configuration->property(role + ".item_type", default_item_type);
     samples_ = configuration->property(role + ".samples", 0);
     dump_ = configuration->property(role + ".dump", false);
@@ -96,7 +101,7 @@ Fmcomms2SignalSource::Fmcomms2SignalSource(ConfigurationInterface* configuration
                         }
                     else
                         {
-                            fmcomms2_source_f32c_ = gr::iio::fmcomms2_source_f32c::make(
+                            fmcomms2_source_ = gr::iio::fmcomms2_source_f32c::make(
                                 uri_.c_str(), freq_, sample_rate_,
                                 bandwidth_,
                                 rx1_en_, rx2_en_,
@@ -128,7 +133,7 @@ Fmcomms2SignalSource::Fmcomms2SignalSource(ConfigurationInterface* configuration
                         }
                     else
                         {
-                            fmcomms2_source_f32c_ = gr::iio::fmcomms2_source_f32c::make(
+                            fmcomms2_source_ = gr::iio::fmcomms2_source_f32c::make(
                                 uri_.c_str(), freq_, sample_rate_,
                                 bandwidth_,
                                 rx1_en_, rx2_en_,
@@ -156,6 +161,34 @@ Fmcomms2SignalSource::Fmcomms2SignalSource(ConfigurationInterface* configuration
                     LOG(FATAL) << "Configuration error: Unsupported number of RF_channels !";
                 }
         }
+    else if (item_type_ == "cshort")
+        {
+            // native libiio source of a single receiver, the samples go out as they come from the device
+            item_size_ = sizeof(lv_16sc_t);
+            if ((RF_channels_ != 1) or (rx1_en_ and rx2_en_))
+                {
+                    LOG(FATAL) << "Configuration error: item_type=cshort supports a single RF channel!";
+                }
+            config_ad9361_rx_remote(uri_, bandwidth_, sample_rate_, freq_, rf_port_select_,
+                gain_mode_rx1_, gain_mode_rx2_, rf_gain_rx1_, rf_gain_rx2_);
+            config_ad9361_rx_tracking_remote(uri_, quadrature_, rf_dc_, bb_dc_);
+            if (!filter_file_.empty())
+                {
+                    LOG(WARNING) << "filter_file is not loaded with item_type=cshort";
+                }
+            fmcomms2_source_ = make_iio_cshort_source(uri_, rx2_en_ ? 1 : 0, buffer_size_, kernel_buffers_, buffers_);
+            if (enable_dds_lo_ == true)
+                {
+                    std::cout << "Enabling Local Oscillator generator in FMCOMMS2\n";
+                    config_ad9361_lo_remote(uri_,
+                        bandwidth_,
+                        sample_rate_,
+                        freq_rf_tx_hz_,
+                        tx_attenuation_db_,
+                        freq_dds_tx_hz_,
+                        scale_dds_dbfs_);
+                }
+        }
     else
         {
             LOG(FATAL) << "Configuration error: item type " << item_type_ << " not supported!";
@@ -197,7 +230,7 @@ void Fmcomms2SignalSource::connect(gr::top_block_sptr top_block)
 {
     if (samples_ != 0)
         {
-            top_block->connect(fmcomms2_source_f32c_, 0, valve_, 0);
+            top_block->connect(fmcomms2_source_, 0, valve_, 0);
             DLOG(INFO) << "connected fmcomms2 source to valve";
             if (dump_)
                 {
@@ -209,7 +242,7 @@ void Fmcomms2SignalSource::connect(gr::top_block_sptr top_block)
         {
             if (dump_)
                 {
-                    top_block->connect(fmcomms2_source_f32c_, 0, file_sink_, 0);
+                    top_block->connect(fmcomms2_source_, 0, file_sink_, 0);
                     DLOG(INFO) << "connected fmcomms2 source to file sink";
                 }
         }
@@ -220,7 +253,7 @@ void Fmcomms2SignalSource::disconnect(gr::top_block_sptr top_block)
 {
     if (samples_ != 0)
         {
-            top_block->disconnect(fmcomms2_source_f32c_, 0, valve_, 0);
+            top_block->disconnect(fmcomms2_source_, 0, valve_, 0);
             if (dump_)
                 {
                     top_block->disconnect(valve_, 0, file_sink_, 0);
@@ -230,7 +263,7 @@ void Fmcomms2SignalSource::disconnect(gr::top_block_sptr top_block)
         {
             if (dump_)
                 {
-                    top_block->disconnect(fmcomms2_source_f32c_, 0, file_sink_, 0);
+                    top_block->disconnect(fmcomms2_source_, 0, file_sink_, 0);
                 }
         }
 }
@@ -251,6 +284,6 @@ gr::basic_block_sptr Fmcomms2SignalSource::get_right_block()
         }
     else
         {
-            return (fmcomms2_source_f32c_);
+            return (fmcomms2_source_);
         }
 }
@@ -96,6 +96,8 @@ private:
     std::string rf_port_select_;
     std::string filter_file_;
     bool filter_auto_;
+    unsigned int kernel_buffers_;
+    unsigned int buffers_;
 
     //DDS configuration for LO generation for external mixer
     bool enable_dds_lo_;
@@ -114,7 +116,7 @@ private:
     bool dump_;
     std::string dump_filename_;
 
-    gr::iio::fmcomms2_source_f32c::sptr fmcomms2_source_f32c_;
+    gr::block_sptr fmcomms2_source_;  // gr::iio::fmcomms2_source_f32c, or iio_cshort_source for cshort items
 
     boost::shared_ptr<gr::block> valve_;
     gr::blocks::file_sink::sptr file_sink_;
@@ -0,0 +1,135 @@
+/*!
+ * \file multi_file_signal_source.h
+ * \brief Interface of a class that reads signal samples from a set of files
+ * as a single stream and adapts it to a SignalSourceInterface
+ *
+ * The files are given either as a comma-separated list in filenames, or as a
+ * shell pattern in filename (e.g. /data/capture_*.dat), read in name order.
+ * Otherwise, same configuration as File_Signal_Source (item_type, samples,
+ * repeat, sampling_frequency, seconds_to_skip, seconds_to_process, dump and
+ * throttle control); header_size items are skipped at the start of each
+ * file, and prefetch_MB megabytes are read ahead.
+ *
+ * -------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2018  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *          Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_MULTI_FILE_SIGNAL_SOURCE_H_
+#define GNSS_SDR_MULTI_FILE_SIGNAL_SOURCE_H_
+
+#include "gnss_block_interface.h"
+#include "multi_file_source.h"
+#include <gnuradio/blocks/file_sink.h>
+#include <gnuradio/blocks/throttle.h>
+#include <gnuradio/hier_block2.h>
+#include <gnuradio/msg_queue.h>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+class ConfigurationInterface;
+
+/*!
+ * \brief Class that reads signals samples from a set of files
+ * and adapts it to a SignalSourceInterface
+ */
+class MultiFileSignalSource : public GNSSBlockInterface
+{
+public:
+    MultiFileSignalSource(ConfigurationInterface* configuration, const std::string& role,
+        unsigned int in_streams, unsigned int out_streams,
+        boost::shared_ptr<gr::msg_queue> queue);
+
+    virtual ~MultiFileSignalSource();
+
+    inline std::string role() override
+    {
+        return role_;
+    }
+
+    /*!
+     * \brief Returns "Multi_File_Signal_Source".
+     */
+    inline std::string implementation() override
+    {
+        return "Multi_File_Signal_Source";
+    }
+
+    inline size_t item_size() override
+    {
+        return item_size_;
+    }
+
+    void connect(gr::top_block_sptr top_block) override;
+    void disconnect(gr::top_block_sptr top_block) override;
+    gr::basic_block_sptr get_left_block() override;
+    gr::basic_block_sptr get_right_block() override;
+
+    inline std::vector<std::string> filenames() const
+    {
+        return filenames_;
+    }
+
+    inline std::string item_type() const
+    {
+        return item_type_;
+    }
+
+    inline bool repeat() const
+    {
+        return repeat_;
+    }
+
+    inline long sampling_frequency() const
+    {
+        return sampling_frequency_;
+    }
+
+    inline long samples() const
+    {
+        return samples_;
+    }
+
+private:
+    uint64_t samples_;
+    long sampling_frequency_;
+    std::vector<std::string> filenames_;
+    std::string item_type_;
+    bool repeat_;
+    bool dump_;
+    std::string dump_filename_;
+    std::string role_;
+    uint32_t in_streams_;
+    uint32_t out_streams_;
+    multi_file_source_sptr file_source_;
+    boost::shared_ptr<gr::block> valve_;
+    gr::blocks::file_sink::sptr sink_;
+    gr::blocks::throttle::sptr throttle_;
+    boost::shared_ptr<gr::msg_queue> queue_;
+    size_t item_size_;
+    // Throttle control
+    bool enable_throttle_control_;
+};
+
+#endif /*GNSS_SDR_MULTI_FILE_SIGNAL_SOURCE_H_*/
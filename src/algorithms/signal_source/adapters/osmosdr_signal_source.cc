@@ -33,6 +33,8 @@
 #include "GPS_L1_CA.h"
 #include "configuration_interface.h"
 #include "gnss_sdr_valve.h"
+#include "packed_iq_format.h"
+#include "ring_file_recorder.h"
 #include <boost/format.hpp>
 #include <glog/logging.h>
 #include <gnuradio/blocks/file_sink.h>
@@ -55,6 +57,12 @@ OsmosdrSignalSource::OsmosdrSignalSource(ConfigurationInterface* configuration,
     dump_ = configuration->property(role + ".dump", false);
     dump_filename_ = configuration->property(role + ".dump_filename",
         default_dump_file);
+    // a ring of dump_ring_MB megabytes and a writer thread of its own make the
+    // dump drop samples rather than stall the receiver (0: synchronous file sink)
+    dump_ring_MB_ = configuration->property(role + ".dump_ring_MB", 0);
+    dump_requantize_bits_ = configuration->property(role + ".dump_requantize_bits", 0);
+    // the ring recorder writes a packed IQ file, to be read by a Packed_IQ_File_Signal_Source
+    dump_packed_iq_ = configuration->property(role + ".dump_packed_iq", false);
 
     // OSMOSDR Driver parameters
     AGC_enabled_ = configuration->property(role + ".AGC_enabled", true);
@@ -144,7 +152,19 @@ OsmosdrSignalSource::OsmosdrSignalSource(ConfigurationInterface* configuration,
     if (dump_)
         {
             DLOG(INFO) << "Dumping output into file " << dump_filename_;
-            file_sink_ = gr::blocks::file_sink::make(item_size_, dump_filename_.c_str());
+            if (dump_ring_MB_ > 0 and dump_packed_iq_)
+                {
+                    file_sink_ = make_packed_iq_file_recorder(item_size_, item_type_, dump_filename_, static_cast<size_t>(dump_ring_MB_) * 1048576,
+                        dump_requantize_bits_ == 0 ? 8 : dump_requantize_bits_, sample_rate_, 0.0, PACKED_IQ_DEFAULT_FRAME_SAMPLES);
+                }
+            else if (dump_ring_MB_ > 0)
+                {
+                    file_sink_ = make_ring_file_recorder(item_size_, item_type_, dump_filename_, static_cast<size_t>(dump_ring_MB_) * 1048576, dump_requantize_bits_);
+                }
+            else
+                {
+                    file_sink_ = gr::blocks::file_sink::make(item_size_, dump_filename_.c_str());
+                }
             DLOG(INFO) << "file_sink(" << file_sink_->unique_id() << ")";
         }
     if (in_stream_ > 0)
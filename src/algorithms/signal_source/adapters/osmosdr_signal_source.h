@@ -102,6 +102,9 @@ private:
     int64_t samples_;
     bool dump_;
     std::string dump_filename_;
+    int dump_ring_MB_;
+    int dump_requantize_bits_;
+    bool dump_packed_iq_;
 
     osmosdr::source::sptr osmosdr_source_;
     std::string osmosdr_args_;
@@ -109,7 +112,7 @@ private:
     std::string antenna_;
 
     boost::shared_ptr<gr::block> valve_;
-    gr::blocks::file_sink::sptr file_sink_;
+    gr::block_sptr file_sink_;
     boost::shared_ptr<gr::msg_queue> queue_;
 };
 
@@ -30,9 +30,12 @@
 
 #include "plutosdr_signal_source.h"
 #include "GPS_L1_CA.h"
+#include "ad9361_manager.h"
 #include "configuration_interface.h"
 #include "gnss_sdr_valve.h"
+#include "iio_cshort_source.h"
 #include <glog/logging.h>
+#include <volk_gnsssdr/volk_gnsssdr_complex.h>
 #include <iostream>
 #include <utility>
 
@@ -58,19 +61,22 @@ PlutosdrSignalSource::PlutosdrSignalSource(ConfigurationInterface* configuration
     rf_gain_ = configuration->property(role + ".gain", 50.0);
     filter_file_ = configuration->property(role + ".filter_file", std::string(""));
     filter_auto_ = configuration->property(role + ".filter_auto", true);
+    // buffers of buffer_size samples in the kernel and in the ring of the cshort source
+    kernel_buffers_ = configuration->property(role + ".kernel_buffers", 4);
+    buffers_ = configuration->property(role + ".buffers", 3);
 
     item_type_ = configuration->property(role + ".item_type", default_item_type);
     samples_ = configuration->property(role + ".samples", 0);
     dump_ = configuration->property(role + ".dump", false);
     dump_filename_ = configuration->property(role + ".dump_filename", default_dump_file);
 
-    if (item_type_ != "gr_complex")
+    if (item_type_ != "gr_complex" and item_type_ != "cshort")
         {
-            std::cout << "Configuration error: item_type must be gr_complex" << std::endl;
-            LOG(FATAL) << "Configuration error: item_type must be gr_complex!";
+            std::cout << "Configuration error: item_type must be gr_complex or cshort" << std::endl;
+            LOG(FATAL) << "Configuration error: item_type must be gr_complex or cshort!";
         }
 
-    item_size_ = sizeof(gr_complex);
+    item_size_ = (item_type_ == "cshort") ? sizeof(lv_16sc_t) : sizeof(gr_complex);
 
     std::cout << "device address: " << uri_ << std::endl;
     std::cout << "frequency : " << freq_ << " Hz" << std::endl;
@@ -78,9 +84,24 @@ PlutosdrSignalSource::PlutosdrSignalSource(ConfigurationInterface* configuration
     std::cout << "gain mode: " << gain_mode_ << std::endl;
     std::cout << "item type: " << item_type_ << std::endl;
 
-    plutosdr_source_ = gr::iio::pluto_source::make(uri_, freq_, sample_rate_,
-        bandwidth_, buffer_size_, quadrature_, rf_dc_, bb_dc_,
-        gain_mode_.c_str(), rf_gain_, filter_file_.c_str(), filter_auto_);
+    if (item_type_ == "cshort")
+        {
+            // native libiio source, the samples go out as they come from the device
+            config_ad9361_rx_remote(uri_, bandwidth_, sample_rate_, freq_, "A_BALANCED",
+                gain_mode_, gain_mode_, rf_gain_, rf_gain_);
+            config_ad9361_rx_tracking_remote(uri_, quadrature_, rf_dc_, bb_dc_);
+            if (!filter_file_.empty())
+                {
+                    LOG(WARNING) << "filter_file is not loaded with item_type=cshort";
+                }
+            plutosdr_source_ = make_iio_cshort_source(uri_, 0, buffer_size_, kernel_buffers_, buffers_);
+        }
+    else
+        {
+            plutosdr_source_ = gr::iio::pluto_source::make(uri_, freq_, sample_rate_,
+                bandwidth_, buffer_size_, quadrature_, rf_dc_, bb_dc_,
+                gain_mode_.c_str(), rf_gain_, filter_file_.c_str(), filter_auto_);
+        }
 
     if (samples_ != 0)
         {
@@ -91,6 +91,8 @@ private:
     double rf_gain_;
     std::string filter_file_;
     bool filter_auto_;
+    unsigned int kernel_buffers_;
+    unsigned int buffers_;
 
     unsigned int in_stream_;
     unsigned int out_stream_;
@@ -101,7 +103,7 @@ private:
     bool dump_;
     std::string dump_filename_;
 
-    gr::iio::pluto_source::sptr plutosdr_source_;
+    gr::block_sptr plutosdr_source_;  // gr::iio::pluto_source, or iio_cshort_source for cshort items
 
     boost::shared_ptr<gr::block> valve_;
     gr::blocks::file_sink::sptr file_sink_;
@@ -34,8 +34,11 @@
 #include "GPS_L1_CA.h"
 #include "configuration_interface.h"
 #include "gnss_sdr_valve.h"
+#include "packed_iq_format.h"
+#include "ring_file_recorder.h"
 #include <boost/format.hpp>
 #include <glog/logging.h>
+#include <volk_gnsssdr/volk_gnsssdr_complex.h>
 #include <cstdint>
 #include <iostream>
 #include <utility>
@@ -61,6 +64,12 @@ RtlTcpSignalSource::RtlTcpSignalSource(ConfigurationInterface* configuration,
     dump_ = configuration->property(role + ".dump", false);
     dump_filename_ = configuration->property(role + ".dump_filename",
         default_dump_file);
+    // a ring of dump_ring_MB megabytes and a writer thread of its own make the
+    // dump drop samples rather than stall the receiver (0: synchronous file sink)
+    dump_ring_MB_ = configuration->property(role + ".dump_ring_MB", 0);
+    dump_requantize_bits_ = configuration->property(role + ".dump_requantize_bits", 0);
+    // the ring recorder writes a packed IQ file, to be read by a Packed_IQ_File_Signal_Source
+    dump_packed_iq_ = configuration->property(role + ".dump_packed_iq", false);
 
     // rtl_tcp PARAMETERS
     std::string default_address = "127.0.0.1";
@@ -75,14 +84,16 @@ RtlTcpSignalSource::RtlTcpSignalSource(ConfigurationInterface* configuration,
     address_ = configuration->property(role + ".address", default_address);
     port_ = configuration->property(role + ".port", default_port);
     flip_iq_ = configuration->property(role + ".flip_iq", false);
+    // bytes of the ring between the socket and the block: the samples received while it is full are dropped
+    buffer_size_ = configuration->property(role + ".buffer_size", 4194304);
 
     if (item_type_ == "short")
         {
             item_size_ = sizeof(int16_t);
         }
-    else if (item_type_ == "gr_complex")
+    else if (item_type_ == "gr_complex" or item_type_ == "cshort")
         {
-            item_size_ = sizeof(gr_complex);
+            item_size_ = (item_type_ == "cshort") ? sizeof(lv_16sc_t) : sizeof(gr_complex);
             // 1. Make the gr block
             MakeBlock();
 
@@ -132,7 +143,19 @@ RtlTcpSignalSource::RtlTcpSignalSource(ConfigurationInterface* configuration,
     if (dump_)
         {
             DLOG(INFO) << "Dumping output into file " << dump_filename_;
-            file_sink_ = gr::blocks::file_sink::make(item_size_, dump_filename_.c_str());
+            if (dump_ring_MB_ > 0 and dump_packed_iq_)
+                {
+                    file_sink_ = make_packed_iq_file_recorder(item_size_, item_type_, dump_filename_, static_cast<size_t>(dump_ring_MB_) * 1048576,
+                        dump_requantize_bits_ == 0 ? 8 : dump_requantize_bits_, sample_rate_, 0.0, PACKED_IQ_DEFAULT_FRAME_SAMPLES);
+                }
+            else if (dump_ring_MB_ > 0)
+                {
+                    file_sink_ = make_ring_file_recorder(item_size_, item_type_, dump_filename_, static_cast<size_t>(dump_ring_MB_) * 1048576, dump_requantize_bits_);
+                }
+            else
+                {
+                    file_sink_ = gr::blocks::file_sink::make(item_size_, dump_filename_.c_str());
+                }
             DLOG(INFO) << "file_sink(" << file_sink_->unique_id() << ")";
         }
     if (in_stream_ > 0)
@@ -146,7 +169,13 @@ RtlTcpSignalSource::RtlTcpSignalSource(ConfigurationInterface* configuration,
 }
 
 
-RtlTcpSignalSource::~RtlTcpSignalSource() = default;
+RtlTcpSignalSource::~RtlTcpSignalSource()
+{
+    if (signal_source_ and signal_source_->get_dropped_samples() > 0)
+        {
+            std::cout << "rtl_tcp source: " << signal_source_->get_dropped_samples() << " samples dropped" << std::endl;
+        }
+}
 
 
 void RtlTcpSignalSource::MakeBlock()
@@ -155,7 +184,7 @@ void RtlTcpSignalSource::MakeBlock()
         {
             std::cout << "Connecting to " << address_ << ":" << port_ << std::endl;
             LOG(INFO) << "Connecting to " << address_ << ":" << port_;
-            signal_source_ = rtl_tcp_make_signal_source_c(address_, port_, flip_iq_);
+            signal_source_ = rtl_tcp_make_signal_source_c(address_, port_, flip_iq_, item_type_ == "cshort", buffer_size_);
         }
     catch (const boost::exception& e)
         {
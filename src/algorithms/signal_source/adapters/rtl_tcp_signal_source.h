@@ -94,6 +94,7 @@ private:
     bool AGC_enabled_;
     double sample_rate_;
     bool flip_iq_;
+    size_t buffer_size_;
 
     unsigned int in_stream_;
     unsigned int out_stream_;
@@ -108,11 +109,14 @@ private:
     long samples_;
     bool dump_;
     std::string dump_filename_;
+    int dump_ring_MB_;
+    int dump_requantize_bits_;
+    bool dump_packed_iq_;
 
     rtl_tcp_signal_source_c_sptr signal_source_;
 
     boost::shared_ptr<gr::block> valve_;
-    gr::blocks::file_sink::sptr file_sink_;
+    gr::block_sptr file_sink_;
     boost::shared_ptr<gr::msg_queue> queue_;
 };
 
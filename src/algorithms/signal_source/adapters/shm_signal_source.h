@@ -0,0 +1,95 @@
+/*!
+ * \file shm_signal_source.h
+ * \brief Signal source that reads the samples written into a POSIX shared
+ * memory ring by another process of the same host.
+ *
+ * -------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2019  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *          Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_SHM_SIGNAL_SOURCE_H_
+#define GNSS_SDR_SHM_SIGNAL_SOURCE_H_
+
+#include "gnss_block_interface.h"
+#include "shm_sample_source.h"
+#include <boost/shared_ptr.hpp>
+#include <gnuradio/blocks/file_sink.h>
+#include <gnuradio/msg_queue.h>
+#include <string>
+
+
+class ConfigurationInterface;
+
+/*!
+ * \brief Reads the samples of a radio owned by another process (e.g., a
+ * spectrum monitor or a recorder), which writes them into a Shm_Sample_Ring.
+ * Any number of receivers can read the same ring, and the producer never
+ * waits for them.
+ */
+class ShmSignalSource : public GNSSBlockInterface
+{
+public:
+    ShmSignalSource(ConfigurationInterface* configuration,
+        const std::string& role, unsigned int in_streams,
+        unsigned int out_streams, boost::shared_ptr<gr::msg_queue> queue);
+
+    virtual ~ShmSignalSource() = default;
+
+    inline std::string role() override
+    {
+        return role_;
+    }
+
+    /*!
+     * \brief Returns "Shm_Signal_Source"
+     */
+    inline std::string implementation() override
+    {
+        return "Shm_Signal_Source";
+    }
+
+    inline size_t item_size() override
+    {
+        return item_size_;
+    }
+
+    void connect(gr::top_block_sptr top_block) override;
+    void disconnect(gr::top_block_sptr top_block) override;
+    gr::basic_block_sptr get_left_block() override;
+    gr::basic_block_sptr get_right_block() override;
+
+private:
+    std::string role_;
+    unsigned int in_streams_;
+    unsigned int out_streams_;
+    std::string item_type_;
+    size_t item_size_;
+    bool dump_;
+    std::string dump_filename_;
+    shm_sample_source_sptr source_;
+    boost::shared_ptr<gr::block> file_sink_;
+    boost::shared_ptr<gr::msg_queue> queue_;
+};
+
+#endif /*GNSS_SDR_SHM_SIGNAL_SOURCE_H_*/
@@ -0,0 +1,126 @@
+/*!
+ * \file udp_sample_signal_source.cc
+ * \brief Signal source of a channels node of a distributed receiver: the
+ * conditioned samples sent over UDP by its source node.
+ *
+ * -------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2019  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *          Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------
+ */
+
+#include "udp_sample_signal_source.h"
+#include "configuration_interface.h"
+#include <glog/logging.h>
+#include <gnuradio/gr_complex.h>
+#include <cstdint>
+#include <utility>
+
+
+using google::LogMessage;
+
+
+UdpSampleSignalSource::UdpSampleSignalSource(ConfigurationInterface* configuration,
+    const std::string& role, unsigned int in_streams, unsigned int out_streams,
+    boost::shared_ptr<gr::msg_queue> queue) : role_(role), in_streams_(in_streams), out_streams_(out_streams), queue_(std::move(queue))
+{
+    std::string default_item_type = "gr_complex";
+    std::string default_address = "239.255.0.1";
+    std::string default_dump_filename = "./data/signal_source.dat";
+    item_type_ = configuration->property(role + ".item_type", default_item_type);
+    // the group (or the unicast address of this node) the source node sends to
+    std::string address = configuration->property(role + ".address", default_address);
+    int port = configuration->property(role + ".port", 12000);
+    // must match GNSS-SDR.distributed_datagram_bytes of the source node
+    int datagram_bytes = configuration->property(role + ".datagram_bytes", 1472);
+    int socket_rcvbuf_bytes = configuration->property(role + ".socket_rcvbuf_bytes", 33554432);
+    dump_ = configuration->property(role + ".dump", false);
+    dump_filename_ = configuration->property(role + ".dump_filename", default_dump_filename);
+
+    if (item_type_ == "gr_complex")
+        {
+            item_size_ = sizeof(gr_complex);
+        }
+    else if (item_type_ == "cshort")
+        {
+            item_size_ = 2 * sizeof(int16_t);
+        }
+    else if (item_type_ == "cbyte")
+        {
+            item_size_ = 2 * sizeof(int8_t);
+        }
+    else
+        {
+            LOG(WARNING) << item_type_ << " unrecognized item type. Using gr_complex.";
+            item_size_ = sizeof(gr_complex);
+        }
+
+    source_ = make_udp_sample_source(item_size_, address, static_cast<uint16_t>(port), static_cast<size_t>(datagram_bytes), socket_rcvbuf_bytes);
+    DLOG(INFO) << "udp_sample_source(" << source_->unique_id() << ") on " << address << ":" << port;
+
+    if (dump_)
+        {
+            DLOG(INFO) << "Dumping output into file " << dump_filename_;
+            file_sink_ = gr::blocks::file_sink::make(item_size_, dump_filename_.c_str());
+        }
+    if (in_streams_ > 0)
+        {
+            LOG(ERROR) << "A signal source does not have an input stream";
+        }
+    if (out_streams_ > 1)
+        {
+            LOG(ERROR) << "This implementation only supports one output stream";
+        }
+}
+
+
+void UdpSampleSignalSource::connect(gr::top_block_sptr top_block)
+{
+    if (dump_)
+        {
+            top_block->connect(source_, 0, file_sink_, 0);
+            DLOG(INFO) << "connected udp_sample_source to file sink";
+        }
+}
+
+
+void UdpSampleSignalSource::disconnect(gr::top_block_sptr top_block)
+{
+    if (dump_)
+        {
+            top_block->disconnect(source_, 0, file_sink_, 0);
+            DLOG(INFO) << "disconnected udp_sample_source to file sink";
+        }
+}
+
+
+gr::basic_block_sptr UdpSampleSignalSource::get_left_block()
+{
+    LOG(WARNING) << "Left block of a signal source should not be retrieved";
+    return gr::block_sptr();
+}
+
+
+gr::basic_block_sptr UdpSampleSignalSource::get_right_block()
+{
+    return source_;
+}
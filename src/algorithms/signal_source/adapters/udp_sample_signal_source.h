@@ -0,0 +1,95 @@
+/*!
+ * \file udp_sample_signal_source.h
+ * \brief Signal source of a channels node of a distributed receiver: the
+ * conditioned samples sent over UDP by its source node.
+ *
+ * -------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2019  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *          Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_UDP_SAMPLE_SIGNAL_SOURCE_H_
+#define GNSS_SDR_UDP_SAMPLE_SIGNAL_SOURCE_H_
+
+#include "gnss_block_interface.h"
+#include "udp_sample_source.h"
+#include <boost/shared_ptr.hpp>
+#include <gnuradio/blocks/file_sink.h>
+#include <gnuradio/msg_queue.h>
+#include <string>
+
+
+class ConfigurationInterface;
+
+/*!
+ * \brief Receives the samples sent by a udp_sample_sink in the source node
+ * of a distributed receiver (GNSS-SDR.distributed_role=source). The samples
+ * are already conditioned, so the conditioner of the channels node must
+ * pass them through unchanged.
+ */
+class UdpSampleSignalSource : public GNSSBlockInterface
+{
+public:
+    UdpSampleSignalSource(ConfigurationInterface* configuration,
+        const std::string& role, unsigned int in_streams,
+        unsigned int out_streams, boost::shared_ptr<gr::msg_queue> queue);
+
+    virtual ~UdpSampleSignalSource() = default;
+
+    inline std::string role() override
+    {
+        return role_;
+    }
+
+    /*!
+     * \brief Returns "UDP_Sample_Signal_Source"
+     */
+    inline std::string implementation() override
+    {
+        return "UDP_Sample_Signal_Source";
+    }
+
+    inline size_t item_size() override
+    {
+        return item_size_;
+    }
+
+    void connect(gr::top_block_sptr top_block) override;
+    void disconnect(gr::top_block_sptr top_block) override;
+    gr::basic_block_sptr get_left_block() override;
+    gr::basic_block_sptr get_right_block() override;
+
+private:
+    std::string role_;
+    unsigned int in_streams_;
+    unsigned int out_streams_;
+    std::string item_type_;
+    size_t item_size_;
+    bool dump_;
+    std::string dump_filename_;
+    udp_sample_source_sptr source_;
+    boost::shared_ptr<gr::block> file_sink_;
+    boost::shared_ptr<gr::msg_queue> queue_;
+};
+
+#endif /*GNSS_SDR_UDP_SAMPLE_SIGNAL_SOURCE_H_*/
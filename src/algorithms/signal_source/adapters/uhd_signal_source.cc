@@ -32,6 +32,9 @@
 #include "GPS_L1_CA.h"
 #include "configuration_interface.h"
 #include "gnss_sdr_valve.h"
+#include "packed_iq_format.h"
+#include "ring_file_recorder.h"
+#include "rx_time_overflow_counter.h"
 #include <glog/logging.h>
 #include <uhd/exception.hpp>
 #include <uhd/types/device_addr.hpp>
@@ -68,11 +71,34 @@ UhdSignalSource::UhdSignalSource(ConfigurationInterface* configuration,
         {
             dev_addr["serial"] = device_serial;
         }
+    // transport buffering, passed to the device: number and size of the
+    // receive frames of the host (0 keeps the UHD defaults)
+    int num_recv_frames = configuration->property(role + ".num_recv_frames", 0);
+    if (num_recv_frames > 0)
+        {
+            dev_addr["num_recv_frames"] = std::to_string(num_recv_frames);
+        }
+    int recv_frame_size = configuration->property(role + ".recv_frame_size", 0);
+    if (recv_frame_size > 0)
+        {
+            dev_addr["recv_frame_size"] = std::to_string(recv_frame_size);
+        }
+    // over-the-wire sample format: sc16, sc12 or sc8 (empty keeps the UHD default, sc16)
+    otw_format_ = configuration->property(role + ".otw_format", empty);
+    // real-time priority and CPU of the thread that receives the samples (0 and -1 leave them unset)
+    recv_thread_priority_ = configuration->property(role + ".recv_thread_priority", 0);
+    recv_thread_cpu_ = configuration->property(role + ".recv_thread_cpu", -1);
     subdevice_ = configuration->property(role + ".subdevice", empty);
     clock_source_ = configuration->property(role + ".clock_source", std::string("internal"));
     RF_channels_ = configuration->property(role + ".RF_channels", 1);
     sample_rate_ = configuration->property(role + ".sampling_frequency", 4.0e6);
     item_type_ = configuration->property(role + ".item_type", default_item_type);
+    // a ring of dump_ring_MB megabytes and a writer thread of its own make the
+    // dump drop samples rather than stall the receiver (0: synchronous file sink)
+    dump_ring_MB_ = configuration->property(role + ".dump_ring_MB", 0);
+    dump_requantize_bits_ = configuration->property(role + ".dump_requantize_bits", 0);
+    // the ring recorder writes a packed IQ file, to be read by a Packed_IQ_File_Signal_Source
+    dump_packed_iq_ = configuration->property(role + ".dump_packed_iq", false);
 
     if (RF_channels_ == 1)
         {
@@ -134,6 +160,15 @@ UhdSignalSource::UhdSignalSource(ConfigurationInterface* configuration,
             uhd_stream_args_ = uhd::stream_args_t("sc16");
         }
 
+    if (otw_format_ == "sc16" or otw_format_ == "sc12" or otw_format_ == "sc8")
+        {
+            uhd_stream_args_.otw_format = otw_format_;
+        }
+    else if (!otw_format_.empty())
+        {
+            LOG(WARNING) << otw_format_ << " unrecognized over-the-wire format. Using the UHD default.";
+        }
+
     // select the number of channels and the subdevice specifications
     for (int i = 0; i < RF_channels_; i++)
         {
@@ -143,6 +178,20 @@ UhdSignalSource::UhdSignalSource(ConfigurationInterface* configuration,
     // 1.2 Make the UHD source object
     uhd_source_ = gr::uhd::usrp_source::make(dev_addr, uhd_stream_args_);
 
+    // All the channels are received by a single streamer, in the thread of the UHD source block
+    if (recv_thread_priority_ > 0)
+        {
+            // SCHED_FIFO priority, needs the rtprio limit of the user to be high enough
+            if (uhd_source_->set_thread_priority(recv_thread_priority_) != recv_thread_priority_)
+                {
+                    LOG(WARNING) << "Could not set the priority of the UHD receive thread to " << recv_thread_priority_;
+                }
+        }
+    if (recv_thread_cpu_ >= 0)
+        {
+            uhd_source_->set_processor_affinity(std::vector<int>(1, recv_thread_cpu_));
+        }
+
     // Set subdevice specification string for USRP family devices. It is composed of:
     // <motherboard slot name>:<daughterboard frontend name>
     // For motherboards: All USRP family motherboards have a first slot named A:.
@@ -225,10 +274,26 @@ UhdSignalSource::UhdSignalSource(ConfigurationInterface* configuration,
             if (dump_.at(i))
                 {
                     LOG(INFO) << "RF_channel " << i << "Dumping output into file " << dump_filename_.at(i);
-                    file_sink_.push_back(gr::blocks::file_sink::make(item_size_, dump_filename_.at(i).c_str()));
+                    if (dump_ring_MB_ > 0 and dump_packed_iq_)
+                        {
+                            file_sink_.push_back(make_packed_iq_file_recorder(item_size_, item_type_, dump_filename_.at(i), static_cast<size_t>(dump_ring_MB_) * 1048576,
+                                dump_requantize_bits_ == 0 ? 8 : dump_requantize_bits_, sample_rate_, 0.0, PACKED_IQ_DEFAULT_FRAME_SAMPLES));
+                        }
+                    else if (dump_ring_MB_ > 0)
+                        {
+                            file_sink_.push_back(make_ring_file_recorder(item_size_, item_type_, dump_filename_.at(i), static_cast<size_t>(dump_ring_MB_) * 1048576, dump_requantize_bits_));
+                        }
+                    else
+                        {
+                            file_sink_.push_back(gr::blocks::file_sink::make(item_size_, dump_filename_.at(i).c_str()));
+                        }
                     DLOG(INFO) << "file_sink(" << file_sink_.at(i)->unique_id() << ")";
                 }
         }
+    // gr-uhd tags the samples that follow an overflow. The channels share the
+    // streamer, so looking at the first one counts each overflow once.
+    overflow_counter_ = make_rx_time_overflow_counter(item_size_);
+
     if (in_stream_ > 0)
         {
             LOG(ERROR) << "A signal source does not have an input stream";
@@ -245,6 +310,8 @@ UhdSignalSource::~UhdSignalSource() = default;
 
 void UhdSignalSource::connect(gr::top_block_sptr top_block)
 {
+    top_block->connect(uhd_source_, 0, overflow_counter_, 0);
+    DLOG(INFO) << "connected usrp source to overflow counter";
     for (int i = 0; i < RF_channels_; i++)
         {
             if (samples_.at(i) != 0)
@@ -271,6 +338,7 @@ void UhdSignalSource::connect(gr::top_block_sptr top_block)
 
 void UhdSignalSource::disconnect(gr::top_block_sptr top_block)
 {
+    top_block->disconnect(uhd_source_, 0, overflow_counter_, 0);
     for (int i = 0; i < RF_channels_; i++)
         {
             if (samples_.at(i) != 0)
@@ -32,6 +32,7 @@
 #define GNSS_SDR_UHD_SIGNAL_SOURCE_H_
 
 #include "gnss_block_interface.h"
+#include "rx_time_overflow_counter.h"
 #include <boost/shared_ptr.hpp>
 #include <gnuradio/blocks/file_sink.h>
 #include <gnuradio/hier_block2.h>
@@ -95,6 +96,9 @@ private:
 
     std::string subdevice_;
     std::string clock_source_;
+    std::string otw_format_;
+    int recv_thread_priority_;
+    int recv_thread_cpu_;
 
     std::vector<double> freq_;
     std::vector<double> gain_;
@@ -102,9 +106,13 @@ private:
     std::vector<long> samples_;
     std::vector<bool> dump_;
     std::vector<std::string> dump_filename_;
+    int dump_ring_MB_;
+    int dump_requantize_bits_;
+    bool dump_packed_iq_;
 
     std::vector<boost::shared_ptr<gr::block>> valve_;
-    std::vector<gr::blocks::file_sink::sptr> file_sink_;
+    std::vector<boost::shared_ptr<gr::block>> file_sink_;
+    rx_time_overflow_counter_sptr overflow_counter_;
 
     boost::shared_ptr<gr::msg_queue> queue_;
 };
@@ -0,0 +1,300 @@
+/*!
+ * \file direct_file_source.cc
+ * \brief GNU Radio block that reads a file with O_DIRECT and a ring of
+ * asynchronous reads, so that the storage is kept busy while the flowgraph
+ * consumes the samples
+ *
+ * -------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2018  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *          Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------
+ */
+
+#include "direct_file_source.h"
+#include <glog/logging.h>
+#include <gnuradio/io_signature.h>
+#include <pmt/pmt.h>
+#include <algorithm>
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <stdexcept>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+
+namespace
+{
+const size_t DIRECT_IO_ALIGNMENT = 4096;  // covers the logical block size of current disks
+}  // namespace
+
+
+direct_file_source_sptr direct_make_file_source(size_t item_size, const std::string& filename, uint64_t offset_items, bool repeat, size_t buffer_size, unsigned int n_buffers)
+{
+    return direct_file_source_sptr(new direct_file_source(item_size, filename, offset_items, repeat, buffer_size, n_buffers));
+}
+
+
+direct_file_source::direct_file_source(size_t item_size,
+    const std::string& filename,
+    uint64_t offset_items,
+    bool repeat,
+    size_t buffer_size,
+    unsigned int n_buffers) : gr::sync_block("direct_file_source",
+                                  gr::io_signature::make(0, 0, 0),
+                                  gr::io_signature::make(1, 1, item_size)),
+                              d_filename(filename),
+                              d_fd(-1),
+                              d_item_size(item_size),
+                              d_repeat(repeat),
+                              d_start(0),
+                              d_end(0),
+                              d_current(0),
+                              d_bytes_read(0),
+                              d_bytes_since_report(0),
+                              d_throughput_MBps(0.0)
+{
+    d_buffer_size = (std::max(buffer_size, DIRECT_IO_ALIGNMENT) + DIRECT_IO_ALIGNMENT - 1) / DIRECT_IO_ALIGNMENT * DIRECT_IO_ALIGNMENT;
+    n_buffers = std::max(n_buffers, 2U);
+
+#ifdef O_DIRECT
+    d_fd = open(filename.c_str(), O_RDONLY | O_DIRECT);
+    if (d_fd < 0 and errno == EINVAL)
+        {
+            // e.g. tmpfs: fall back to buffered reads, the ring still overlaps them
+            LOG(INFO) << "O_DIRECT not supported for " << filename << ", using buffered reads";
+            d_fd = open(filename.c_str(), O_RDONLY);
+        }
+#else
+    d_fd = open(filename.c_str(), O_RDONLY);
+#endif
+    if (d_fd < 0)
+        {
+            throw std::runtime_error("direct_file_source: cannot open " + filename + ": " + std::strerror(errno));
+        }
+    struct stat file_stat;
+    if (fstat(d_fd, &file_stat) != 0)
+        {
+            close(d_fd);
+            throw std::runtime_error("direct_file_source: cannot stat " + filename);
+        }
+    auto file_size = static_cast<size_t>(file_stat.st_size);
+    d_start = std::min(static_cast<size_t>(offset_items * item_size), file_size);
+    d_end = d_start + (file_size - d_start) / item_size * item_size;
+    if (d_end == d_start)
+        {
+            close(d_fd);
+            throw std::runtime_error("direct_file_source: no items to read in " + filename);
+        }
+    d_aligned_start = d_start / DIRECT_IO_ALIGNMENT * DIRECT_IO_ALIGNMENT;
+    d_next_offset = d_aligned_start;
+
+    d_ring.resize(n_buffers);
+    for (auto& buffer : d_ring)
+        {
+            void* data = nullptr;
+            if (posix_memalign(&data, DIRECT_IO_ALIGNMENT, d_buffer_size) != 0)
+                {
+                    for (auto& allocated : d_ring)
+                        {
+                            free(allocated.data);
+                        }
+                    close(d_fd);
+                    throw std::runtime_error("direct_file_source: cannot allocate the read buffers");
+                }
+            std::memset(&buffer.cb, 0, sizeof(buffer.cb));
+            buffer.data = static_cast<uint8_t*>(data);
+            buffer.valid = 0;
+            buffer.read = 0;
+            buffer.pending = false;
+            buffer.ready = false;
+        }
+    message_port_register_out(pmt::mp("throughput"));
+
+    d_t_start = std::chrono::steady_clock::now();
+    d_t_report = d_t_start;
+    for (auto& buffer : d_ring)
+        {
+            submit(buffer);
+        }
+}
+
+
+direct_file_source::~direct_file_source()
+{
+    for (auto& buffer : d_ring)
+        {
+            if (buffer.pending)
+                {
+                    aio_cancel(d_fd, &buffer.cb);
+                    const struct aiocb* list[1] = {&buffer.cb};
+                    while (aio_error(&buffer.cb) == EINPROGRESS)
+                        {
+                            aio_suspend(list, 1, nullptr);
+                        }
+                    aio_return(&buffer.cb);
+                }
+            free(buffer.data);
+        }
+    close(d_fd);
+    double elapsed_s = std::chrono::duration<double>(std::chrono::steady_clock::now() - d_t_start).count();
+    if (elapsed_s > 0.0)
+        {
+            LOG(INFO) << "direct_file_source: read " << d_bytes_read << " bytes of " << d_filename
+                      << " at " << static_cast<double>(d_bytes_read) / 1e6 / elapsed_s << " MB/s";
+        }
+}
+
+
+void direct_file_source::submit(Read_Buffer& buffer)
+{
+    buffer.ready = false;
+    if (d_next_offset >= d_end)
+        {
+            if (!d_repeat)
+                {
+                    buffer.pending = false;
+                    return;
+                }
+            d_next_offset = d_aligned_start;
+        }
+    buffer.cb.aio_fildes = d_fd;
+    buffer.cb.aio_buf = buffer.data;
+    buffer.cb.aio_nbytes = d_buffer_size;
+    buffer.cb.aio_offset = static_cast<off_t>(d_next_offset);
+    buffer.cb.aio_sigevent.sigev_notify = SIGEV_NONE;
+    d_next_offset += d_buffer_size;
+    if (aio_read(&buffer.cb) != 0)
+        {
+            // no room in the AIO queue: read in place, the ring keeps the order
+            ssize_t n = pread(d_fd, buffer.data, d_buffer_size, buffer.cb.aio_offset);
+            buffer.pending = false;
+            if (n < 0)
+                {
+                    LOG(ERROR) << "direct_file_source: read error in " << d_filename << ": " << std::strerror(errno);
+                    return;
+                }
+            accept(buffer, static_cast<size_t>(n));
+            return;
+        }
+    buffer.pending = true;
+}
+
+
+bool direct_file_source::complete(Read_Buffer& buffer)
+{
+    if (!buffer.pending)
+        {
+            return false;  // nothing left to read
+        }
+    const struct aiocb* list[1] = {&buffer.cb};
+    while (aio_error(&buffer.cb) == EINPROGRESS)
+        {
+            aio_suspend(list, 1, nullptr);
+        }
+    buffer.pending = false;
+    int error = aio_error(&buffer.cb);
+    ssize_t n = aio_return(&buffer.cb);
+    if (error != 0 or n < 0)
+        {
+            LOG(ERROR) << "direct_file_source: read error in " << d_filename << ": " << std::strerror(error);
+            return false;
+        }
+    auto offset = static_cast<size_t>(buffer.cb.aio_offset);
+    auto got = static_cast<size_t>(n);
+    // a short read before the end of the file: finish it synchronously
+    while (got < d_buffer_size and offset + got < d_end)
+        {
+            n = pread(d_fd, buffer.data + got, d_buffer_size - got, static_cast<off_t>(offset + got));
+            if (n <= 0)
+                {
+                    LOG(ERROR) << "direct_file_source: short read in " << d_filename;
+                    return false;
+                }
+            got += static_cast<size_t>(n);
+        }
+    accept(buffer, got);
+    return true;
+}
+
+
+void direct_file_source::accept(Read_Buffer& buffer, size_t got)
+{
+    auto offset = static_cast<size_t>(buffer.cb.aio_offset);
+    d_bytes_read += got;
+    d_bytes_since_report += got;
+    buffer.valid = std::min(offset + got, d_end) - offset;
+    buffer.read = std::min(std::max(offset, d_start) - offset, buffer.valid);
+    buffer.ready = true;
+}
+
+
+void direct_file_source::report_throughput()
+{
+    std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+    double interval_s = std::chrono::duration<double>(now - d_t_report).count();
+    if (interval_s < 1.0)
+        {
+            return;
+        }
+    d_throughput_MBps = static_cast<double>(d_bytes_since_report) / 1e6 / interval_s;
+    double sustained_MBps = static_cast<double>(d_bytes_read) / 1e6 / std::chrono::duration<double>(now - d_t_start).count();
+    LOG(INFO) << "direct_file_source: " << d_throughput_MBps << " MB/s (" << sustained_MBps << " MB/s since start)";
+    message_port_pub(pmt::mp("throughput"), pmt::from_double(d_throughput_MBps));
+    d_bytes_since_report = 0;
+    d_t_report = now;
+}
+
+
+int direct_file_source::work(int noutput_items,
+    gr_vector_const_void_star& input_items __attribute__((unused)),
+    gr_vector_void_star& output_items)
+{
+    auto* out = static_cast<uint8_t*>(output_items[0]);
+    size_t requested = static_cast<size_t>(noutput_items) * d_item_size;
+    size_t produced = 0;
+    while (produced < requested)
+        {
+            Read_Buffer& buffer = d_ring[d_current];
+            if (!buffer.ready and !complete(buffer))
+                {
+                    break;  // end of the file, or a read error
+                }
+            size_t n = std::min(requested - produced, buffer.valid - buffer.read);
+            std::memcpy(out + produced, buffer.data + buffer.read, n);
+            produced += n;
+            buffer.read += n;
+            if (buffer.read == buffer.valid)
+                {
+                    submit(buffer);
+                    d_current = (d_current + 1) % d_ring.size();
+                }
+        }
+    report_throughput();
+    // the end of the file is on an item boundary, so only whole items are produced
+    if (produced == 0)
+        {
+            return WORK_DONE;
+        }
+    return static_cast<int>(produced / d_item_size);
+}
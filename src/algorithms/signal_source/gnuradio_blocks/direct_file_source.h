@@ -0,0 +1,114 @@
+/*!
+ * \file direct_file_source.h
+ * \brief GNU Radio block that reads a file with O_DIRECT and a ring of
+ * asynchronous reads, so that the storage is kept busy while the flowgraph
+ * consumes the samples
+ *
+ * -------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2018  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *          Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_DIRECT_FILE_SOURCE_H_
+#define GNSS_SDR_DIRECT_FILE_SOURCE_H_
+
+#include <gnuradio/sync_block.h>
+#include <aio.h>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+
+class direct_file_source;
+
+typedef boost::shared_ptr<direct_file_source> direct_file_source_sptr;
+
+/*!
+ * \brief Makes a source of items of \p item_size bytes read from \p filename,
+ * starting at item \p offset_items. If \p repeat is true, the file is read
+ * again from that item when its end is reached. The file is read in
+ * \p buffer_size bytes chunks (rounded up to the page size) and up to
+ * \p n_buffers reads are kept in flight. Throws std::runtime_error if the file
+ * cannot be opened or the buffers cannot be allocated.
+ */
+direct_file_source_sptr direct_make_file_source(size_t item_size, const std::string& filename, uint64_t offset_items, bool repeat, size_t buffer_size, unsigned int n_buffers);
+
+/*!
+ * \brief Reads the samples with POSIX asynchronous I/O on a file descriptor
+ * opened with O_DIRECT where the file system allows it, bypassing the page
+ * cache. The sustained read rate is logged and published as a double [MB/s]
+ * on the "throughput" message port about once per second.
+ */
+class direct_file_source : public gr::sync_block
+{
+private:
+    friend direct_file_source_sptr direct_make_file_source(size_t item_size, const std::string& filename, uint64_t offset_items, bool repeat, size_t buffer_size, unsigned int n_buffers);
+    direct_file_source(size_t item_size, const std::string& filename, uint64_t offset_items, bool repeat, size_t buffer_size, unsigned int n_buffers);
+
+    struct Read_Buffer
+    {
+        struct aiocb cb;
+        uint8_t* data;
+        size_t valid;    // bytes of data that belong to the samples
+        size_t read;     // bytes of data already produced
+        bool pending;    // a read is in flight
+        bool ready;      // data holds a completed read
+    };
+
+    void submit(Read_Buffer& buffer);
+    bool complete(Read_Buffer& buffer);
+    void accept(Read_Buffer& buffer, size_t got);
+    void report_throughput();
+
+    std::string d_filename;
+    int d_fd;
+    size_t d_item_size;
+    bool d_repeat;
+    size_t d_buffer_size;
+    size_t d_aligned_start;  // d_start rounded down to the alignment of direct reads
+    size_t d_start;          // first byte of the first item
+    size_t d_end;            // end of the last whole item
+    size_t d_next_offset;    // file offset of the next read to submit
+    std::vector<Read_Buffer> d_ring;
+    size_t d_current;        // buffer being produced
+    uint64_t d_bytes_read;
+    uint64_t d_bytes_since_report;
+    std::chrono::steady_clock::time_point d_t_start;
+    std::chrono::steady_clock::time_point d_t_report;
+    double d_throughput_MBps;
+
+public:
+    ~direct_file_source();
+
+    uint64_t items() const { return (d_end - d_start) / d_item_size; }  //!< items from the offset to the end of the file
+
+    double throughput_MBps() const { return d_throughput_MBps; }  //!< read rate over the last report interval [MB/s]
+
+    int work(int noutput_items,
+        gr_vector_const_void_star& input_items,
+        gr_vector_void_star& output_items);
+};
+
+#endif
@@ -2,7 +2,8 @@
  * \file gr_complex_ip_packet_source.cc
  *
  * \brief Receives ip frames containing samples in UDP frame encapsulation
- * using a high performance packet capture library (libpcap)
+ * using a high performance packet capture library (libpcap), or batched
+ * reads from one or several UDP sockets
  * \author Javier Arribas jarribas (at) cttc.es
  * -------------------------------------------------------------------------
  *
@@ -32,10 +33,41 @@
 
 #include "gr_complex_ip_packet_source.h"
 #include <gnuradio/io_signature.h>
+#include <volk_gnsssdr/volk_gnsssdr.h>
+#include <algorithm>
+#include <chrono>
 #include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <thread>
+#include <sys/socket.h>
+#include <unistd.h>
 #include <utility>
 
-const int FIFO_SIZE = 1472000;
+// Capacity of the ring of each capture thread
+const size_t RING_BYTES = 16777216;
+
+// Largest datagram captured by libpcap (snapshot length)
+const size_t PCAP_SLOT_BYTES = 1500;
+
+// Payload of a standard Ethernet frame
+const size_t MIN_SOCKET_SLOT_BYTES = 1472;
+
+// Datagrams read by a single recvmmsg() call
+const uint32_t RECVMMSG_BATCH = 64;
+
+// With several sockets, datagrams queued before giving up waiting for a missing sequence number
+const uint32_t REORDER_WINDOW = 64;
+
+// Receive ring shared with the kernel by the packet_mmap backend: 64 blocks of 1 MiB
+const uint32_t MMAP_BLOCK_BYTES = 1048576;
+const uint32_t MMAP_BLOCKS = 64;
+
+// Longest wait for the kernel to fill a block of the receive ring
+const int MMAP_POLL_TIMEOUT_MS = 10;
+
+// Values of the two's complement 4-bit codes
+const int8_t FOUR_BIT_LUT[16] = {1, 3, 5, 7, 9, 11, 13, 15, -15, -13, -11, -9, -7, -5, -3, -1};
 
 
 /* 4 bytes IP address */
@@ -83,7 +115,11 @@ gr_complex_ip_packet_source::make(std::string src_device,
     int n_baseband_channels,
     const std::string &wire_sample_type,
     size_t item_size,
-    bool IQ_swap_)
+    bool IQ_swap_,
+    const std::string &capture_backend,
+    int socket_threads,
+    int socket_rcvbuf_bytes,
+    int sequence_bytes)
 {
     return gnuradio::get_initial_sptr(new gr_complex_ip_packet_source(std::move(src_device),
         origin_address,
@@ -92,7 +128,11 @@ gr_complex_ip_packet_source::make(std::string src_device,
         n_baseband_channels,
         wire_sample_type,
         item_size,
-        IQ_swap_));
+        IQ_swap_,
+        capture_backend,
+        socket_threads,
+        socket_rcvbuf_bytes,
+        sequence_bytes));
 }
 
 
@@ -106,7 +146,11 @@ gr_complex_ip_packet_source::gr_complex_ip_packet_source(std::string src_device,
     int n_baseband_channels,
     const std::string &wire_sample_type,
     size_t item_size,
-    bool IQ_swap_)
+    bool IQ_swap_,
+    const std::string &capture_backend,
+    int socket_threads,
+    int socket_rcvbuf_bytes,
+    int sequence_bytes)
     : gr::sync_block("gr_complex_ip_packet_source",
           gr::io_signature::make(0, 0, 0),
           gr::io_signature::make(1, 4, item_size))  // 1 to 4 baseband complex channels
@@ -133,13 +177,60 @@ gr_complex_ip_packet_source::gr_complex_ip_packet_source(std::string src_device,
     d_src_device = std::move(src_device);
     d_udp_port = udp_port;
     d_udp_payload_size = udp_packet_size;
-    d_fifo_full = false;
 
-    // allocate signal samples buffer
-    fifo_buff = new char[FIFO_SIZE];
-    fifo_read_ptr = 0;
-    fifo_write_ptr = 0;
-    fifo_items = 0;
+    d_use_sockets = false;
+    d_use_packet_mmap = false;
+    if (capture_backend == "socket")
+        {
+            d_use_sockets = true;
+        }
+    else if (capture_backend == "packet_mmap")
+        {
+            d_use_packet_mmap = true;
+        }
+    else if (capture_backend != "pcap")
+        {
+            std::cout << "Unknown capture backend " << capture_backend << ", using pcap\n";
+        }
+
+    d_sequence_bytes = std::min(std::max(sequence_bytes, 0), 8);
+    d_sequence_mask = d_sequence_bytes == 8 ? ~0ULL : (1ULL << (8 * d_sequence_bytes)) - 1;
+    d_next_sequence = 0;
+    d_sequence_started = false;
+    d_packets_received = 0;
+    d_packets_lost = 0;
+    d_packets_late = 0;
+
+    d_socket_threads = d_use_sockets ? std::max(socket_threads, 1) : 1;
+    if (d_socket_threads > 1 && d_sequence_bytes == 0)
+        {
+            // The datagrams of different sockets can only be put back in order by their sequence numbers
+            std::cout << "Several capture sockets require packet sequence numbers, using a single one\n";
+            d_socket_threads = 1;
+        }
+    d_socket_rcvbuf_bytes = socket_rcvbuf_bytes;
+    d_stop_capture = false;
+
+    if (d_use_packet_mmap)
+        {
+            // the kernel writes the frames straight into the ring read by the block
+            d_mmap_ring = std::unique_ptr<Packet_Mmap_Ring>(new Packet_Mmap_Ring());
+            d_queues.push_back(d_mmap_ring.get());
+        }
+    else
+        {
+            // allocate one ring of datagrams per capture thread
+            size_t slot_bytes = d_use_sockets ? std::max(static_cast<size_t>(std::max(udp_packet_size, 0)), MIN_SOCKET_SLOT_BYTES) : PCAP_SLOT_BYTES;
+            for (int n = 0; n < d_socket_threads; n++)
+                {
+                    d_rings.push_back(std::unique_ptr<Udp_Packet_Ring>(new Udp_Packet_Ring(static_cast<uint32_t>(RING_BYTES / slot_bytes), slot_bytes)));
+                    d_queues.push_back(d_rings.back().get());
+                }
+        }
+    d_current_ring = -1;
+    d_current_offset = 0;
+    d_partial_bytes = 0;
+
     d_item_size = item_size;
     d_IQ_swap = IQ_swap_;
     d_sock_raw = 0;
@@ -154,6 +245,23 @@ gr_complex_ip_packet_source::gr_complex_ip_packet_source(std::string src_device,
 bool gr_complex_ip_packet_source::start()
 {
     std::cout << "gr_complex_ip_packet_source START\n";
+    if (d_use_sockets)
+        {
+            if (open_sockets() == false)
+                {
+                    return false;
+                }
+            d_stop_capture = false;
+            for (int n = 0; n < d_socket_threads; n++)
+                {
+                    d_socket_thread_pool.emplace_back(&gr_complex_ip_packet_source::socket_capture_thread, this, n);
+                }
+            return true;
+        }
+    if (d_use_packet_mmap)
+        {
+            return d_mmap_ring->open(d_src_device, static_cast<uint16_t>(d_udp_port), MMAP_BLOCK_BYTES, MMAP_BLOCKS) && bind_udp_port();
+        }
     // open the ethernet device
     if (open() == true)
         {
@@ -172,12 +280,37 @@ bool gr_complex_ip_packet_source::start()
 bool gr_complex_ip_packet_source::stop()
 {
     std::cout << "gr_complex_ip_packet_source STOP\n";
-    if (descr != nullptr)
+    if (d_use_sockets)
+        {
+            // The capture threads notice it at most one socket timeout later
+            d_stop_capture = true;
+            for (auto &thread : d_socket_thread_pool)
+                {
+                    thread.join();
+                }
+            d_socket_thread_pool.clear();
+            for (int sock : d_sockets)
+                {
+                    close(sock);
+                }
+            d_sockets.clear();
+        }
+    else if (d_use_packet_mmap)
+        {
+            d_mmap_ring->close();
+            if (d_sock_raw > 0)
+                {
+                    close(d_sock_raw);
+                    d_sock_raw = 0;
+                }
+        }
+    else if (descr != nullptr)
         {
             pcap_breakloop(descr);
             d_pcap_thread->join();
             pcap_close(descr);
         }
+    report_counters();
     return true;
 }
 
@@ -185,15 +318,20 @@ bool gr_complex_ip_packet_source::stop()
 bool gr_complex_ip_packet_source::open()
 {
     char errbuf[PCAP_ERRBUF_SIZE];
-    boost::mutex::scoped_lock lock(d_mutex);  // hold mutex for duration of this function
     // open device for reading
-    descr = pcap_open_live(d_src_device.c_str(), 1500, 1, 1000, errbuf);
+    descr = pcap_open_live(d_src_device.c_str(), PCAP_SLOT_BYTES, 1, 1000, errbuf);
     if (descr == nullptr)
         {
             std::cout << "Error opening Ethernet device " << d_src_device << std::endl;
             std::cout << "Fatal Error in pcap_open_live(): " << std::string(errbuf) << std::endl;
             return false;
         }
+    return bind_udp_port();
+}
+
+
+bool gr_complex_ip_packet_source::bind_udp_port()
+{
     // bind UDP port to avoid automatic reply with ICMP port unreachable packets from kernel
     d_sock_raw = socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
     if (d_sock_raw == -1)
@@ -219,13 +357,82 @@ bool gr_complex_ip_packet_source::open()
 }
 
 
+bool gr_complex_ip_packet_source::open_sockets()
+{
+    memset(reinterpret_cast<char *>(&si_me), 0, sizeof(si_me));
+    si_me.sin_family = AF_INET;
+    si_me.sin_port = htons(d_udp_port);
+    si_me.sin_addr.s_addr = htonl(INADDR_ANY);
+
+    for (int n = 0; n < d_socket_threads; n++)
+        {
+            int sock = socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+            if (sock == -1)
+                {
+                    std::cout << "Error opening UDP socket" << std::endl;
+                    return false;
+                }
+            d_sockets.push_back(sock);
+
+            if (d_socket_threads > 1)
+                {
+#ifdef SO_REUSEPORT
+                    // The kernel spreads the incoming flows among the sockets bound to the port
+                    int enable = 1;
+                    if (setsockopt(sock, SOL_SOCKET, SO_REUSEPORT, &enable, sizeof(enable)) == -1)
+                        {
+                            std::cout << "Error setting SO_REUSEPORT on UDP socket" << std::endl;
+                            return false;
+                        }
+#else
+                    std::cout << "SO_REUSEPORT is not available, cannot open several UDP sockets on the same port" << std::endl;
+                    return false;
+#endif
+                }
+
+            if (d_socket_rcvbuf_bytes > 0)
+                {
+                    int requested = d_socket_rcvbuf_bytes;
+                    int granted = 0;
+                    socklen_t length = sizeof(granted);
+                    setsockopt(sock, SOL_SOCKET, SO_RCVBUF, &requested, sizeof(requested));
+                    getsockopt(sock, SOL_SOCKET, SO_RCVBUF, &granted, &length);
+#ifdef SO_RCVBUFFORCE
+                    // SO_RCVBUF is capped at net.core.rmem_max, SO_RCVBUFFORCE is not but needs CAP_NET_ADMIN
+                    if (granted < requested)
+                        {
+                            setsockopt(sock, SOL_SOCKET, SO_RCVBUFFORCE, &requested, sizeof(requested));
+                            getsockopt(sock, SOL_SOCKET, SO_RCVBUF, &granted, &length);
+                        }
+#endif
+                    if (granted < requested)
+                        {
+                            std::cout << "UDP socket receive buffer limited to " << granted << " bytes, consider raising net.core.rmem_max" << std::endl;
+                        }
+                }
+
+            // A timeout lets the capture thread check regularly whether it has to stop
+            struct timeval timeout;
+            timeout.tv_sec = 0;
+            timeout.tv_usec = 100000;
+            setsockopt(sock, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+
+            if (bind(sock, reinterpret_cast<struct sockaddr *>(&si_me), sizeof(si_me)) == -1)
+                {
+                    std::cout << "Error binding UDP socket to port " << d_udp_port << std::endl;
+                    return false;
+                }
+        }
+    return true;
+}
+
+
 gr_complex_ip_packet_source::~gr_complex_ip_packet_source()
 {
     if (d_pcap_thread != nullptr)
         {
             delete d_pcap_thread;
         }
-    delete fifo_buff;
     std::cout << "Stop Ethernet packet capture\n";
 }
 
@@ -238,11 +445,9 @@ void gr_complex_ip_packet_source::static_pcap_callback(u_char *args, const struc
 }
 
 
-void gr_complex_ip_packet_source::pcap_callback(__attribute__((unused)) u_char *args, __attribute__((unused)) const struct pcap_pkthdr *pkthdr,
+void gr_complex_ip_packet_source::pcap_callback(__attribute__((unused)) u_char *args, const struct pcap_pkthdr *pkthdr,
     const u_char *packet)
 {
-    boost::mutex::scoped_lock lock(d_mutex);  // hold mutex for duration of this function
-
     const gr_ip_header *ih;
     const gr_udp_header *uh;
 
@@ -259,48 +464,26 @@ void gr_complex_ip_packet_source::pcap_callback(__attribute__((unused)) u_char *
             uh = reinterpret_cast<const gr_udp_header *>(reinterpret_cast<const u_char *>(ih) + ip_len);
 
             // convert from network byte order to host byte order
-            //u_short sport;
             u_short dport;
             dport = ntohs(uh->dport);
-            //sport = ntohs(uh->sport);
             if (dport == d_udp_port)
                 {
-                    // print ip addresses and udp ports
-                    //            printf("%d.%d.%d.%d.%d -> %d.%d.%d.%d.%d\n",
-                    //                   ih->saddr.byte1,
-                    //                   ih->saddr.byte2,
-                    //                   ih->saddr.byte3,
-                    //                   ih->saddr.byte4,
-                    //                   sport,
-                    //                   ih->daddr.byte1,
-                    //                   ih->daddr.byte2,
-                    //                   ih->daddr.byte3,
-                    //                   ih->daddr.byte4,
-                    //                   dport);
-                    //            std::cout<<"uh->len:"<<ntohs(uh->len)<<std::endl;
-
                     int payload_length_bytes = ntohs(uh->len) - 8;  // total udp packet length minus the header length
-                    // read the payload bytes and insert them into the shared circular buffer
                     const u_char *udp_payload = (reinterpret_cast<const u_char *>(uh) + sizeof(gr_udp_header));
-                    if (fifo_items <= (FIFO_SIZE - payload_length_bytes))
+                    // never read beyond the captured bytes
+                    int captured_bytes = static_cast<int>(pkthdr->caplen) - static_cast<int>(udp_payload - packet);
+                    payload_length_bytes = std::min(payload_length_bytes, captured_bytes);
+                    if (payload_length_bytes <= 0)
+                        {
+                            return;
+                        }
+                    // insert the payload into the ring read by the block
+                    Udp_Packet_Ring &ring = *d_rings[0];
+                    if (ring.writable() > 0)
                         {
-                            int aligned_write_items = FIFO_SIZE - fifo_write_ptr;
-                            if (aligned_write_items >= payload_length_bytes)
-                                {
-                                    // write all in a single memcpy
-                                    memcpy(&fifo_buff[fifo_write_ptr], &udp_payload[0], payload_length_bytes);  // size in bytes
-                                    fifo_write_ptr += payload_length_bytes;
-                                    if (fifo_write_ptr == FIFO_SIZE) fifo_write_ptr = 0;
-                                    fifo_items += payload_length_bytes;
-                                }
-                            else
-                                {
-                                    // two step wrap write
-                                    memcpy(&fifo_buff[fifo_write_ptr], &udp_payload[0], aligned_write_items);  // size in bytes
-                                    fifo_write_ptr = payload_length_bytes - aligned_write_items;
-                                    memcpy(&fifo_buff[0], &udp_payload[aligned_write_items], fifo_write_ptr);  // size in bytes
-                                    fifo_items += payload_length_bytes;
-                                }
+                            auto length = static_cast<uint32_t>(payload_length_bytes);
+                            memcpy(ring.free_slot(0), udp_payload, length);  // size in bytes
+                            ring.publish(&length, 1);
                         }
                     else
                         {
@@ -318,67 +501,188 @@ void gr_complex_ip_packet_source::my_pcap_loop_thread(pcap_t *pcap_handle)
 }
 
 
-void gr_complex_ip_packet_source::demux_samples(gr_vector_void_star output_items, int num_samples_readed)
+void gr_complex_ip_packet_source::socket_capture_thread(int index)
 {
-    int8_t real;
-    int8_t imag;
-    uint8_t tmp_char2;
-    for (int n = 0; n < num_samples_readed; n++)
+    Udp_Packet_Ring &ring = *d_rings[index];
+    const int sock = d_sockets[index];
+    std::array<uint32_t, RECVMMSG_BATCH> lengths{};
+#if defined(__linux__)
+    std::array<struct mmsghdr, RECVMMSG_BATCH> messages{};
+    std::array<struct iovec, RECVMMSG_BATCH> iovecs{};
+#endif
+    bool overflow = false;
+    while (!d_stop_capture.load(std::memory_order_relaxed))
         {
-            switch (d_wire_sample_type)
+            uint32_t batch = std::min(ring.writable(), RECVMMSG_BATCH);
+            if (batch == 0)
                 {
-                case 1:  // interleaved byte samples
-                    for (auto &output_item : output_items)
+                    // The block is late: leave the datagrams in the socket receive buffer meanwhile
+                    if (!overflow)
                         {
-                            real = fifo_buff[fifo_read_ptr++];
-                            imag = fifo_buff[fifo_read_ptr++];
-                            if (d_IQ_swap)
-                                {
-                                    static_cast<gr_complex *>(output_item)[n] = gr_complex(real, imag);
-                                }
-                            else
-                                {
-                                    static_cast<gr_complex *>(output_item)[n] = gr_complex(imag, real);
-                                }
+                            // notify overflow
+                            std::cout << "O" << std::flush;
+                            overflow = true;
                         }
-                    break;
-                case 2:  // 4-bit samples
-                    for (auto &output_item : output_items)
+                    std::this_thread::sleep_for(std::chrono::microseconds(100));
+                    continue;
+                }
+            overflow = false;
+            int received;
+#if defined(__linux__)
+            // Datagrams are received directly into the free slots of the ring
+            for (uint32_t k = 0; k < batch; k++)
+                {
+                    iovecs[k].iov_base = ring.free_slot(k);
+                    iovecs[k].iov_len = ring.slot_bytes();
+                    memset(&messages[k], 0, sizeof(struct mmsghdr));
+                    messages[k].msg_hdr.msg_iov = &iovecs[k];
+                    messages[k].msg_hdr.msg_iovlen = 1;
+                }
+            // Waits for the first datagram (or the socket timeout), then takes all those already queued
+            received = recvmmsg(sock, messages.data(), batch, MSG_WAITFORONE, nullptr);
+            for (int k = 0; k < received; k++)
+                {
+                    lengths[k] = messages[k].msg_len;
+                }
+#else
+            ssize_t bytes = recv(sock, ring.free_slot(0), ring.slot_bytes(), 0);
+            received = bytes > 0 ? 1 : 0;
+            lengths[0] = static_cast<uint32_t>(std::max(bytes, static_cast<ssize_t>(0)));
+#endif
+            if (received > 0)
+                {
+                    ring.publish(lengths.data(), static_cast<uint32_t>(received));
+                }
+        }
+}
+
+
+uint64_t gr_complex_ip_packet_source::read_sequence(const char *payload) const
+{
+    uint64_t sequence = 0;
+    for (int k = 0; k < d_sequence_bytes; k++)
+        {
+            sequence = (sequence << 8) | static_cast<uint8_t>(payload[k]);
+        }
+    return sequence;
+}
+
+
+bool gr_complex_ip_packet_source::next_datagram()
+{
+    size_t bytes;
+    if (d_sequence_bytes == 0)
+        {
+            if (d_queues[0]->readable() == 0)
+                {
+                    return false;
+                }
+            d_current_ring = 0;
+            d_current_offset = 0;
+            d_packets_received++;
+            return true;
+        }
+
+    // Look at the oldest datagram of each ring, dropping those too short
+    // to hold a sequence number or older than the last one read
+    int best = -1;
+    uint64_t best_ahead = 0;
+    uint32_t queued = 0;
+    for (size_t r = 0; r < d_queues.size(); r++)
+        {
+            Datagram_Queue &ring = *d_queues[r];
+            while (ring.readable() > 0)
+                {
+                    const char *payload = ring.front(bytes);
+                    if (bytes < static_cast<size_t>(d_sequence_bytes))
                         {
-                            tmp_char2 = fifo_buff[fifo_read_ptr] & 0x0F;
-                            if (tmp_char2 >= 8)
-                                {
-                                    real = 2 * (tmp_char2 - 16) + 1;
-                                }
-                            else
-                                {
-                                    real = 2 * tmp_char2 + 1;
-                                }
-                            tmp_char2 = fifo_buff[fifo_read_ptr++] >> 4;
-                            tmp_char2 = tmp_char2 & 0x0F;
-                            if (tmp_char2 >= 8)
-                                {
-                                    imag = 2 * (tmp_char2 - 16) + 1;
-                                }
-                            else
-                                {
-                                    imag = 2 * tmp_char2 + 1;
-                                }
-                            if (d_IQ_swap)
-                                {
-                                    static_cast<gr_complex *>(output_item)[n] = gr_complex(imag, real);
-                                }
-                            else
-                                {
-                                    static_cast<gr_complex *>(output_item)[n] = gr_complex(real, imag);
-                                }
+                            ring.pop();
+                            continue;
                         }
+                    if (!d_sequence_started)
+                        {
+                            d_next_sequence = read_sequence(payload);
+                            d_sequence_started = true;
+                        }
+                    uint64_t ahead = (read_sequence(payload) - d_next_sequence) & d_sequence_mask;
+                    if (ahead > (d_sequence_mask >> 1))
+                        {
+                            ring.pop();
+                            d_packets_late++;
+                            continue;
+                        }
+                    if (best == -1 || ahead < best_ahead)
+                        {
+                            best = static_cast<int>(r);
+                            best_ahead = ahead;
+                        }
+                    queued += ring.readable();
                     break;
-                default:
-                    std::cout << "Unknown wire sample type\n";
-                    exit(0);
                 }
-            if (fifo_read_ptr == FIFO_SIZE) fifo_read_ptr = 0;
+        }
+    if (best == -1)
+        {
+            return false;
+        }
+    if (best_ahead > 0)
+        {
+            // The missing datagrams may still come through another socket
+            if (d_queues.size() > 1 && queued < REORDER_WINDOW)
+                {
+                    return false;
+                }
+            d_packets_lost += best_ahead;
+            // a sample split across the gap is lost as well
+            d_partial_bytes = 0;
+        }
+    d_next_sequence = (read_sequence(d_queues[best]->front(bytes)) + 1) & d_sequence_mask;
+    d_current_ring = best;
+    d_current_offset = d_sequence_bytes;
+    d_packets_received++;
+    return true;
+}
+
+
+void gr_complex_ip_packet_source::report_counters() const
+{
+    std::cout << "UDP source: " << d_packets_received << " datagrams received";
+    if (d_sequence_bytes > 0)
+        {
+            std::cout << ", " << d_packets_lost << " lost, " << d_packets_late << " out of order";
+        }
+    std::cout << std::endl;
+}
+
+
+void gr_complex_ip_packet_source::demux_samples(const gr_vector_void_star &output_items, const char *buffer, int first_sample, int num_samples)
+{
+    std::array<gr_complex *, 4> channels{};
+    if (output_items.size() < static_cast<size_t>(d_n_baseband_channels) && d_discarded_samples.size() < static_cast<size_t>(num_samples))
+        {
+            d_discarded_samples.resize(num_samples);
+        }
+    for (int c = 0; c < d_n_baseband_channels; c++)
+        {
+            // the channels not connected are decoded as well, and thrown away
+            channels[c] = c < static_cast<int>(output_items.size()) ? static_cast<gr_complex *>(output_items[c]) + first_sample : d_discarded_samples.data();
+        }
+    const auto *samples = reinterpret_cast<const lv_8sc_t *>(buffer);
+    switch (d_wire_sample_type)
+        {
+        case 1:  // interleaved byte samples, the imaginary part first unless swapped
+            volk_gnsssdr_8ic_deinterleave_32fc_xn(channels.data(), samples, d_IQ_swap ? 0 : 1, d_n_baseband_channels, num_samples);
+            break;
+        case 2:  // 4-bit samples, the real part in the low nibble unless swapped
+            if (d_unpacked_samples.size() < static_cast<size_t>(2 * num_samples * d_bytes_per_sample))
+                {
+                    d_unpacked_samples.resize(2 * num_samples * d_bytes_per_sample);
+                }
+            volk_gnsssdr_8u_unpack_4bit_8i(d_unpacked_samples.data(), reinterpret_cast<const uint8_t *>(buffer), FOUR_BIT_LUT, num_samples * d_bytes_per_sample);
+            volk_gnsssdr_8ic_deinterleave_32fc_xn(channels.data(), reinterpret_cast<const lv_8sc_t *>(d_unpacked_samples.data()), d_IQ_swap ? 1 : 0, d_n_baseband_channels, num_samples);
+            break;
+        default:
+            std::cout << "Unknown wire sample type\n";
+            exit(0);
         }
 }
 
@@ -388,61 +692,73 @@ int gr_complex_ip_packet_source::work(int noutput_items,
     gr_vector_void_star &output_items)
 {
     // send samples to next GNU Radio block
-    boost::mutex::scoped_lock lock(d_mutex);  // hold mutex for duration of this function
-    if (fifo_items == 0) return 0;
-
     if (output_items.size() > static_cast<uint64_t>(d_n_baseband_channels))
         {
             std::cout << "Configuration error: more baseband channels connected than the available in the UDP source\n";
             exit(0);
         }
-    int num_samples_readed;
-    int bytes_requested;
-    switch (d_wire_sample_type)
+
+    int produced = 0;
+    while (produced < noutput_items)
         {
-        case 1:  // complex byte samples
-            bytes_requested = noutput_items * d_bytes_per_sample;
-            if (bytes_requested < fifo_items)
+            if (d_current_ring < 0 && !next_datagram())
                 {
-                    num_samples_readed = noutput_items;  // read all
-                }
-            else
-                {
-                    num_samples_readed = fifo_items / d_bytes_per_sample;  // read what we have
+                    break;
                 }
-            break;
-        case 2:  // complex 4 bits samples
-            bytes_requested = noutput_items * d_bytes_per_sample;
-            if (bytes_requested < fifo_items)
+            Datagram_Queue &ring = *d_queues[d_current_ring];
+            size_t bytes;
+            const char *payload = ring.front(bytes);
+            size_t available = bytes - d_current_offset;
+            if (d_partial_bytes > 0)
                 {
-                    num_samples_readed = noutput_items;  // read all
+                    // complete the sample split with the previous datagram
+                    size_t missing = std::min(available, static_cast<size_t>(d_bytes_per_sample - d_partial_bytes));
+                    memcpy(&d_partial_sample[d_partial_bytes], payload + d_current_offset, missing);
+                    d_partial_bytes += static_cast<int>(missing);
+                    d_current_offset += missing;
+                    available -= missing;
+                    if (d_partial_bytes == d_bytes_per_sample)
+                        {
+                            demux_samples(output_items, d_partial_sample.data(), produced, 1);
+                            produced++;
+                            d_partial_bytes = 0;
+                        }
                 }
             else
                 {
-                    num_samples_readed = fifo_items / d_bytes_per_sample;  // read what we have
+                    int num_samples = std::min(static_cast<int>(available / d_bytes_per_sample), noutput_items - produced);
+                    demux_samples(output_items, payload + d_current_offset, produced, num_samples);
+                    produced += num_samples;
+                    d_current_offset += num_samples * d_bytes_per_sample;
+                    available -= num_samples * d_bytes_per_sample;
+                    if (available > 0 && available < static_cast<size_t>(d_bytes_per_sample))
+                        {
+                            // keep the beginning of a sample split with the next datagram
+                            memcpy(d_partial_sample.data(), payload + d_current_offset, available);
+                            d_partial_bytes = static_cast<int>(available);
+                            d_current_offset += available;
+                            available = 0;
+                        }
                 }
-            break;
-        default:  // complex byte samples
-            bytes_requested = noutput_items * d_bytes_per_sample;
-            if (bytes_requested < fifo_items)
+            if (available == 0)
                 {
-                    num_samples_readed = noutput_items;  // read all
+                    ring.pop();
+                    d_current_ring = -1;
                 }
-            else
+        }
+    if (produced == 0)
+        {
+            if (d_use_packet_mmap)
                 {
-                    num_samples_readed = fifo_items / d_bytes_per_sample;  // read what we have
+                    // sleep until the kernel hands over a block, instead of spinning
+                    d_mmap_ring->wait(MMAP_POLL_TIMEOUT_MS);
                 }
+            return 0;
         }
 
-    bytes_requested = num_samples_readed * d_bytes_per_sample;
-    // read all in a single loop
-    demux_samples(output_items, num_samples_readed);  // it also increases the fifo read pointer
-    // update fifo items
-    fifo_items = fifo_items - bytes_requested;
-
     for (uint64_t n = 0; n < output_items.size(); n++)
         {
-            produce(static_cast<int>(n), num_samples_readed);
+            produce(static_cast<int>(n), produced);
         }
     return this->WORK_CALLED_PRODUCE;
 }
@@ -2,7 +2,8 @@
  * \file gr_complex_ip_packet_source.h
  *
  * \brief Receives ip frames containing samples in UDP frame encapsulation
- * using a high performance packet capture library (libpcap)
+ * using a high performance packet capture library (libpcap), or batched
+ * reads from one or several UDP sockets
  * \author Javier Arribas jarribas (at) cttc.es
  * -------------------------------------------------------------------------
  *
@@ -33,6 +34,9 @@
 #ifndef INCLUDED_GR_COMPLEX_IP_PACKET_SOURCE_H
 #define INCLUDED_GR_COMPLEX_IP_PACKET_SOURCE_H
 
+#include "datagram_queue.h"
+#include "packet_mmap_ring.h"
+#include "udp_packet_ring.h"
 #include <boost/thread.hpp>
 #include <gnuradio/sync_block.h>
 #include <arpa/inet.h>
@@ -40,27 +44,35 @@
 #include <net/if.h>
 #include <netinet/if_ether.h>
 #include <pcap.h>
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <memory>
 #include <string>
 #include <sys/ioctl.h>
+#include <vector>
 
 class gr_complex_ip_packet_source : virtual public gr::sync_block
 {
 private:
-    boost::mutex d_mutex;
     pcap_t *descr;  //ethernet pcap device descriptor
 
-    char *fifo_buff;
+    // One ring per capture thread: the pcap loop, or each of the sockets
+    std::vector<std::unique_ptr<Udp_Packet_Ring>> d_rings;
+
+    // packet_mmap backend: frames read in place from the kernel receive ring
+    bool d_use_packet_mmap;
+    std::unique_ptr<Packet_Mmap_Ring> d_mmap_ring;
+
+    // queues read by the block, either the rings or the kernel receive ring
+    std::vector<Datagram_Queue *> d_queues;
 
-    int fifo_read_ptr;
-    int fifo_write_ptr;
-    int fifo_items;
     int d_sock_raw;
     int d_udp_port;
     struct sockaddr_in si_me;
     std::string d_src_device;
     std::string d_origin_address;
     int d_udp_payload_size;
-    bool d_fifo_full;
 
     int d_n_baseband_channels;
     int d_wire_sample_type;
@@ -68,6 +80,32 @@ private:
     size_t d_item_size;
     bool d_IQ_swap;
 
+    // socket capture backend
+    bool d_use_sockets;
+    int d_socket_threads;
+    int d_socket_rcvbuf_bytes;
+    std::vector<int> d_sockets;
+    std::vector<boost::thread> d_socket_thread_pool;
+    std::atomic<bool> d_stop_capture;
+
+    // packet sequence numbers, big endian at the start of each payload
+    int d_sequence_bytes;
+    uint64_t d_sequence_mask;
+    uint64_t d_next_sequence;
+    bool d_sequence_started;
+    uint64_t d_packets_received;
+    uint64_t d_packets_lost;
+    uint64_t d_packets_late;
+
+    // read position: ring of the datagram being read (-1 if none) and offset in it
+    int d_current_ring;
+    size_t d_current_offset;
+    std::array<char, 8> d_partial_sample;  // bytes of a sample split between two datagrams
+    int d_partial_bytes;
+
+    std::vector<int8_t> d_unpacked_samples;       // 4-bit samples expanded to bytes
+    std::vector<gr_complex> d_discarded_samples;  // output of the channels not connected
+
     boost::thread *d_pcap_thread;
     /*!
 	 * \brief
@@ -76,7 +114,23 @@ private:
 	 */
     bool open();
 
-    void demux_samples(gr_vector_void_star output_items, int num_samples_readed);
+    /*!
+     * \brief Opens d_socket_threads UDP sockets bound to the same port,
+     * sharing the incoming flows if there is more than one (SO_REUSEPORT).
+     */
+    bool open_sockets();
+
+    /*!
+     * \brief Binds a UDP socket to the port, so that the kernel does not
+     * reply with ICMP port unreachable packets to the captured datagrams.
+     */
+    bool bind_udp_port();
+
+    void demux_samples(const gr_vector_void_star &output_items, const char *buffer, int first_sample, int num_samples);
+    bool next_datagram();
+    uint64_t read_sequence(const char *payload) const;
+    void report_counters() const;
+    void socket_capture_thread(int index);
     void my_pcap_loop_thread(pcap_t *pcap_handle);
     void pcap_callback(u_char *args, const struct pcap_pkthdr *pkthdr, const u_char *packet);
     static void static_pcap_callback(u_char *args, const struct pcap_pkthdr *pkthdr, const u_char *packet);
@@ -90,7 +144,11 @@ public:
         int n_baseband_channels,
         const std::string &wire_sample_type,
         size_t item_size,
-        bool IQ_swap_);
+        bool IQ_swap_,
+        const std::string &capture_backend = "pcap",
+        int socket_threads = 1,
+        int socket_rcvbuf_bytes = 0,
+        int sequence_bytes = 0);
     gr_complex_ip_packet_source(std::string src_device,
         const std::string &origin_address,
         int udp_port,
@@ -98,9 +156,38 @@ public:
         int n_baseband_channels,
         const std::string &wire_sample_type,
         size_t item_size,
-        bool IQ_swap_);
+        bool IQ_swap_,
+        const std::string &capture_backend,
+        int socket_threads,
+        int socket_rcvbuf_bytes,
+        int sequence_bytes);
     ~gr_complex_ip_packet_source();
 
+    /*!
+     * \brief Datagrams read so far. Those with a sequence number older than
+     * the previous one are not included.
+     */
+    inline uint64_t packets_received() const
+    {
+        return d_packets_received;
+    }
+
+    /*!
+     * \brief Datagrams missing from the sequence numbers.
+     */
+    inline uint64_t packets_lost() const
+    {
+        return d_packets_lost;
+    }
+
+    /*!
+     * \brief Datagrams dropped because they arrived after a newer one.
+     */
+    inline uint64_t packets_late() const
+    {
+        return d_packets_late;
+    }
+
     // Where all the action really happens
     int work(int noutput_items,
         gr_vector_const_void_star &input_items,
@@ -0,0 +1,235 @@
+/*!
+ * \file iio_cshort_source.cc
+ * \brief GNU Radio source that streams the samples of an AD9361 based
+ * front-end (ADALM-PLUTO, FMCOMMS2) with libiio, as cshort items.
+ *
+ * -------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2019  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *          Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------
+ */
+
+#include "iio_cshort_source.h"
+#include "ad9361_manager.h"
+#include "gnss_metrics.h"
+#include <glog/logging.h>
+#include <gnuradio/io_signature.h>
+#include <volk_gnsssdr/volk_gnsssdr_complex.h>
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <stdexcept>
+
+
+namespace
+{
+// DMA status register of the ADI AXI ADC core, and its overflow flag (write 1 to clear)
+const uint32_t ADI_DMA_STATUS_REGISTER = 0x80000088;
+const uint32_t ADI_DMA_OVERFLOW = 0x4;
+}  // namespace
+
+
+iio_cshort_source_sptr make_iio_cshort_source(const std::string& uri, int rx_channel, size_t buffer_samples, unsigned int kernel_buffers, unsigned int buffers)
+{
+    return gnuradio::get_initial_sptr(new iio_cshort_source(uri, rx_channel, buffer_samples, kernel_buffers, buffers));
+}
+
+
+iio_cshort_source::iio_cshort_source(const std::string& uri, int rx_channel, size_t buffer_samples, unsigned int kernel_buffers, unsigned int buffers)
+    : gr::sync_block("iio_cshort_source",
+          gr::io_signature::make(0, 0, 0),
+          gr::io_signature::make(1, 1, sizeof(lv_16sc_t))),
+      d_context(nullptr),
+      d_device(nullptr),
+      d_buffer(nullptr),
+      d_check_overflow(true),
+      d_ring(std::max(buffers, 2U), buffer_samples * sizeof(lv_16sc_t)),
+      d_offset(0),
+      d_stop(false),
+      d_stopped(false)
+{
+    d_context = create_ad9361_context(uri);
+    if (d_context == nullptr)
+        {
+            throw std::runtime_error("AD9361 IIO No context at " + uri);
+        }
+    struct iio_channel* channel_i = nullptr;
+    struct iio_channel* channel_q = nullptr;
+    if (!get_ad9361_stream_dev(d_context, RX, &d_device) or
+        !get_ad9361_stream_ch(d_context, RX, d_device, 2 * rx_channel, &channel_i) or
+        !get_ad9361_stream_ch(d_context, RX, d_device, 2 * rx_channel + 1, &channel_q))
+        {
+            iio_context_destroy(d_context);
+            throw std::runtime_error("AD9361 IIO RX channel not found");
+        }
+    // only the I and Q channels of this receiver, so that the buffer holds cshort samples
+    for (unsigned int k = 0; k < iio_device_get_channels_count(d_device); k++)
+        {
+            iio_channel_disable(iio_device_get_channel(d_device, k));
+        }
+    iio_channel_enable(channel_i);
+    iio_channel_enable(channel_q);
+
+    // more buffers in the kernel keep the DMA going while the thread is busy
+    int ret = iio_device_set_kernel_buffers_count(d_device, kernel_buffers);
+    if (ret < 0)
+        {
+            LOG(WARNING) << "Failed to set " << kernel_buffers << " kernel buffers: " << ret;
+        }
+    d_buffer = iio_device_create_buffer(d_device, buffer_samples, false);
+    if (d_buffer == nullptr)
+        {
+            iio_context_destroy(d_context);
+            throw std::runtime_error("AD9361 IIO Cannot create the RX buffer");
+        }
+
+    const std::string labels = "source=\"" + uri + "\",channel=\"" + std::to_string(rx_channel) + "\"";
+    d_overflows = Gnss_Metrics::get_instance()->get_counter("gnss_sdr_signal_source_overflows", labels);
+    d_dropped_samples = Gnss_Metrics::get_instance()->get_counter("gnss_sdr_signal_source_dropped_samples", labels);
+
+    d_thread = std::thread(&iio_cshort_source::refill_thread, this);
+}
+
+
+iio_cshort_source::~iio_cshort_source()
+{
+    d_stop.store(true);
+    if (d_buffer != nullptr)
+        {
+            // wakes up a refill waiting for the device
+            iio_buffer_cancel(d_buffer);
+        }
+    if (d_thread.joinable())
+        {
+            d_thread.join();
+        }
+    if (d_buffer != nullptr)
+        {
+            iio_buffer_destroy(d_buffer);
+        }
+    if (d_context != nullptr)
+        {
+            iio_context_destroy(d_context);
+        }
+    if ((overflows() > 0) or (dropped_samples() > 0))
+        {
+            LOG(WARNING) << "AD9361 source: " << overflows() << " overflows of the device, " << dropped_samples() << " samples dropped";
+        }
+}
+
+
+bool iio_cshort_source::check_overflow()
+{
+    uint32_t status = 0;
+    if (!d_check_overflow)
+        {
+            return false;
+        }
+    if (iio_device_reg_read(d_device, ADI_DMA_STATUS_REGISTER, &status) < 0)
+        {
+            // e.g. an old iiod without register access
+            d_check_overflow = false;
+            return false;
+        }
+    if ((status & ADI_DMA_OVERFLOW) != 0)
+        {
+            iio_device_reg_write(d_device, ADI_DMA_STATUS_REGISTER, status);
+            return true;
+        }
+    return false;
+}
+
+
+void iio_cshort_source::refill_thread()
+{
+    bool overflow = false;
+    while (!d_stop.load(std::memory_order_relaxed))
+        {
+            ssize_t bytes = iio_buffer_refill(d_buffer);
+            if (bytes < 0)
+                {
+                    if (!d_stop.load(std::memory_order_relaxed))
+                        {
+                            std::cout << "AD9361 IIO refill failed: " << bytes << std::endl;
+                            LOG(ERROR) << "AD9361 IIO refill failed: " << bytes;
+                        }
+                    break;
+                }
+            if (check_overflow())
+                {
+                    // samples lost by the device before this buffer
+                    d_overflows->fetch_add(1, std::memory_order_relaxed);
+                    std::cout << "O" << std::flush;
+                }
+            if (d_ring.writable() == 0)
+                {
+                    // the block is late: drop this buffer and keep the device running
+                    d_dropped_samples->fetch_add(bytes / sizeof(lv_16sc_t), std::memory_order_relaxed);
+                    if (!overflow)
+                        {
+                            std::cout << "O" << std::flush;
+                            overflow = true;
+                        }
+                    continue;
+                }
+            overflow = false;
+            auto length = static_cast<uint32_t>(std::min(static_cast<size_t>(bytes), d_ring.slot_bytes()));
+            std::memcpy(d_ring.free_slot(0), iio_buffer_start(d_buffer), length);
+            d_ring.publish(&length, 1);
+        }
+    d_stopped.store(true, std::memory_order_release);
+}
+
+
+int iio_cshort_source::work(int noutput_items,
+    gr_vector_const_void_star& /*input_items*/,
+    gr_vector_void_star& output_items)
+{
+    auto* out = reinterpret_cast<char*>(output_items[0]);
+    size_t wanted = static_cast<size_t>(noutput_items) * sizeof(lv_16sc_t);
+    size_t copied = 0;
+    while ((copied < wanted) and (d_ring.readable() > 0))
+        {
+            size_t bytes;
+            const char* samples = d_ring.front(bytes);
+            size_t n = std::min(bytes - d_offset, wanted - copied);
+            std::memcpy(out + copied, samples + d_offset, n);
+            copied += n;
+            d_offset += n;
+            if (d_offset == bytes)
+                {
+                    d_ring.pop();
+                    d_offset = 0;
+                }
+        }
+    if (copied == 0)
+        {
+            if (d_stopped.load(std::memory_order_acquire) and (d_ring.readable() == 0))
+                {
+                    return -1;
+                }
+            // nothing received yet: wait a bit rather than spinning
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    return static_cast<int>(copied / sizeof(lv_16sc_t));
+}
@@ -0,0 +1,103 @@
+/*!
+ * \file iio_cshort_source.h
+ * \brief GNU Radio source that streams the samples of an AD9361 based
+ * front-end (ADALM-PLUTO, FMCOMMS2) with libiio, as cshort items.
+ *
+ * A thread of its own refills the libiio buffer, while the kernel keeps
+ * several more buffers in flight, and moves each block of samples into a
+ * lock-free ring of buffers. work() copies them to the output as they come
+ * from the device (12-bit samples in 16-bit I/Q pairs), without conversion.
+ *
+ * -------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2019  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *          Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_IIO_CSHORT_SOURCE_H_
+#define GNSS_SDR_IIO_CSHORT_SOURCE_H_
+
+#include "udp_packet_ring.h"
+#include <gnuradio/sync_block.h>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <thread>
+
+#ifdef __APPLE__
+#include <iio/iio.h>
+#else
+#include <iio.h>
+#endif
+
+
+class iio_cshort_source;
+
+typedef boost::shared_ptr<iio_cshort_source> iio_cshort_source_sptr;
+
+/*!
+ * \brief Makes a source of the RX channel \p rx_channel (0 or 1) of the
+ * AD9361 at \p uri, already configured (see ad9361_manager.h). Each refill
+ * gets \p buffer_samples samples, with \p kernel_buffers buffers in the
+ * kernel and \p buffers buffers in the ring. Throws std::runtime_error if
+ * the device cannot be opened.
+ */
+iio_cshort_source_sptr make_iio_cshort_source(const std::string& uri, int rx_channel, size_t buffer_samples, unsigned int kernel_buffers, unsigned int buffers);
+
+class iio_cshort_source : public gr::sync_block
+{
+private:
+    friend iio_cshort_source_sptr make_iio_cshort_source(const std::string& uri, int rx_channel, size_t buffer_samples, unsigned int kernel_buffers, unsigned int buffers);
+    iio_cshort_source(const std::string& uri, int rx_channel, size_t buffer_samples, unsigned int kernel_buffers, unsigned int buffers);
+
+    void refill_thread();
+    bool check_overflow();
+
+    struct iio_context* d_context;
+    struct iio_device* d_device;
+    struct iio_buffer* d_buffer;
+    bool d_check_overflow;  // the DMA status register can be read
+
+    Udp_Packet_Ring d_ring;
+    size_t d_offset;  // bytes of the oldest buffer of the ring already sent
+    std::thread d_thread;
+    std::atomic<bool> d_stop;
+    std::atomic<bool> d_stopped;  // the device cannot be read anymore
+
+    // reported by the metrics interface
+    std::shared_ptr<std::atomic<uint64_t>> d_overflows;
+    std::shared_ptr<std::atomic<uint64_t>> d_dropped_samples;
+
+public:
+    ~iio_cshort_source();
+
+    uint64_t overflows() const { return d_overflows->load(std::memory_order_relaxed); }              //!< Samples lost by the device, in number of events
+    uint64_t dropped_samples() const { return d_dropped_samples->load(std::memory_order_relaxed); }  //!< Samples lost because the ring was full
+
+    int work(int noutput_items,
+        gr_vector_const_void_star& input_items,
+        gr_vector_void_star& output_items);
+};
+
+#endif
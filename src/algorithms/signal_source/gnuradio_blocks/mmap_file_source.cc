@@ -0,0 +1,184 @@
+/*!
+ * \file mmap_file_source.cc
+ * \brief GNU Radio source that reads the items of a memory-mapped file
+ *
+ * -------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2018  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *          Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------
+ */
+
+#include "mmap_file_source.h"
+#include <glog/logging.h>
+#include <gnuradio/io_signature.h>
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+
+namespace
+{
+const size_t READ_AHEAD_BYTES = 64 * 1024 * 1024;  // requested ahead of the read position
+const size_t RELEASE_BYTES = 64 * 1024 * 1024;     // processed bytes given back to the kernel at once
+}  // namespace
+
+
+mmap_file_source_sptr mmap_make_file_source(size_t item_size, const std::string& filename, uint64_t offset_items, bool repeat, bool huge_pages)
+{
+    return mmap_file_source_sptr(new mmap_file_source(item_size, filename, offset_items, repeat, huge_pages));
+}
+
+
+mmap_file_source::mmap_file_source(size_t item_size,
+    const std::string& filename,
+    uint64_t offset_items,
+    bool repeat,
+    bool huge_pages) : gr::sync_block("mmap_file_source",
+                           gr::io_signature::make(0, 0, 0),
+                           gr::io_signature::make(1, 1, item_size)),
+                       d_item_size(item_size),
+                       d_repeat(repeat),
+                       d_data(nullptr),
+                       d_file_size(0),
+                       d_start(0),
+                       d_end(0),
+                       d_position(0),
+                       d_advised_until(0),
+                       d_released_until(0)
+{
+    int fd = open(filename.c_str(), O_RDONLY);
+    if (fd < 0)
+        {
+            throw std::runtime_error("mmap_file_source: cannot open " + filename + ": " + std::strerror(errno));
+        }
+    struct stat file_stat;
+    if (fstat(fd, &file_stat) != 0)
+        {
+            close(fd);
+            throw std::runtime_error("mmap_file_source: cannot stat " + filename);
+        }
+    d_file_size = static_cast<size_t>(file_stat.st_size);
+    d_start = std::min(static_cast<size_t>(offset_items * item_size), d_file_size);
+    d_end = d_start + (d_file_size - d_start) / item_size * item_size;
+    if (d_end == d_start)
+        {
+            close(fd);
+            throw std::runtime_error("mmap_file_source: no items to read in " + filename);
+        }
+    void* map = mmap(nullptr, d_file_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);  // the mapping keeps the file open
+    if (map == MAP_FAILED)
+        {
+            throw std::runtime_error("mmap_file_source: cannot map " + filename + ": " + std::strerror(errno));
+        }
+    d_data = static_cast<const uint8_t*>(map);
+    madvise(map, d_file_size, MADV_SEQUENTIAL);
+#ifdef MADV_HUGEPAGE
+    // MAP_HUGETLB is for anonymous and hugetlbfs mappings only; for a file
+    // this is a hint that file systems without huge page support ignore
+    if (huge_pages and madvise(map, d_file_size, MADV_HUGEPAGE) != 0)
+        {
+            LOG(INFO) << "Huge pages not available for " << filename;
+        }
+#else
+    if (huge_pages)
+        {
+            LOG(INFO) << "Huge pages not available for " << filename;
+        }
+#endif
+    d_position = d_start;
+    d_released_until = d_start;
+    d_advised_until = d_start;
+    advise_window(d_position);
+}
+
+
+mmap_file_source::~mmap_file_source()
+{
+    if (d_data != nullptr)
+        {
+            munmap(const_cast<uint8_t*>(d_data), d_file_size);
+        }
+}
+
+
+void mmap_file_source::advise_window(size_t position)
+{
+    static const size_t page_size = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+    // read ahead, half a window at a time
+    if (position + READ_AHEAD_BYTES / 2 > d_advised_until and d_advised_until < d_end)
+        {
+            size_t from = std::max(d_advised_until, position) / page_size * page_size;
+            size_t to = std::min(position + READ_AHEAD_BYTES, d_end);
+            madvise(const_cast<uint8_t*>(d_data) + from, to - from, MADV_WILLNEED);
+            d_advised_until = to;
+        }
+    // drop the pages already processed, they are not read again unless repeating
+    if (position >= d_released_until + RELEASE_BYTES)
+        {
+            size_t from = d_released_until / page_size * page_size;
+            size_t to = position / page_size * page_size;
+            if (to > from)
+                {
+                    madvise(const_cast<uint8_t*>(d_data) + from, to - from, MADV_DONTNEED);
+                }
+            d_released_until = to;
+        }
+}
+
+
+int mmap_file_source::work(int noutput_items,
+    gr_vector_const_void_star& input_items __attribute__((unused)),
+    gr_vector_void_star& output_items)
+{
+    auto* out = static_cast<uint8_t*>(output_items[0]);
+    size_t requested = static_cast<size_t>(noutput_items) * d_item_size;
+    size_t produced = 0;
+    while (produced < requested)
+        {
+            if (d_position >= d_end)
+                {
+                    if (!d_repeat)
+                        {
+                            break;
+                        }
+                    d_position = d_start;
+                    d_advised_until = d_start;
+                    d_released_until = d_start;
+                }
+            size_t n = std::min(requested - produced, d_end - d_position);
+            std::memcpy(out + produced, d_data + d_position, n);
+            produced += n;
+            d_position += n;
+        }
+    advise_window(d_position);
+    if (produced == 0)
+        {
+            return WORK_DONE;
+        }
+    return static_cast<int>(produced / d_item_size);
+}
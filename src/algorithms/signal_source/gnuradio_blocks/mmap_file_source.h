@@ -0,0 +1,85 @@
+/*!
+ * \file mmap_file_source.h
+ * \brief GNU Radio source that reads the items of a memory-mapped file
+ *
+ * The file is mapped read-only and the items are copied straight from the
+ * mapping into the output buffer, with no read() calls. The kernel is told
+ * that the access is sequential, the pages ahead of the read position are
+ * requested in advance and the pages already processed are released, so
+ * that recordings much larger than the memory can be processed.
+ *
+ * -------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2018  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *          Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_MMAP_FILE_SOURCE_H_
+#define GNSS_SDR_MMAP_FILE_SOURCE_H_
+
+#include <gnuradio/sync_block.h>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+
+class mmap_file_source;
+
+typedef boost::shared_ptr<mmap_file_source> mmap_file_source_sptr;
+
+/*!
+ * \brief Makes a source of items of \p item_size bytes read from \p filename,
+ * starting at item \p offset_items. If \p repeat is true, the file is read
+ * again from that item when its end is reached. \p huge_pages asks the kernel
+ * to back the mapping with transparent huge pages, where the file system
+ * supports it. Throws std::runtime_error if the file cannot be mapped.
+ */
+mmap_file_source_sptr mmap_make_file_source(size_t item_size, const std::string& filename, uint64_t offset_items, bool repeat, bool huge_pages);
+
+class mmap_file_source : public gr::sync_block
+{
+private:
+    friend mmap_file_source_sptr mmap_make_file_source(size_t item_size, const std::string& filename, uint64_t offset_items, bool repeat, bool huge_pages);
+    mmap_file_source(size_t item_size, const std::string& filename, uint64_t offset_items, bool repeat, bool huge_pages);
+    void advise_window(size_t position);
+
+    size_t d_item_size;
+    bool d_repeat;
+    const uint8_t* d_data;    // mapping of the whole file
+    size_t d_file_size;
+    size_t d_start;           // first byte of the first item
+    size_t d_end;             // end of the last whole item
+    size_t d_position;        // next byte to produce
+    size_t d_advised_until;   // read-ahead requested up to this byte
+    size_t d_released_until;  // pages before this byte given back to the kernel
+
+public:
+    ~mmap_file_source();
+
+    uint64_t items() const { return (d_end - d_start) / d_item_size; }  //!< items from the offset to the end of the file
+
+    int work(int noutput_items,
+        gr_vector_const_void_star& input_items,
+        gr_vector_void_star& output_items);
+};
+
+#endif
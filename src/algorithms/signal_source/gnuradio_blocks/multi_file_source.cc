@@ -0,0 +1,268 @@
+/*!
+ * \file multi_file_source.cc
+ * \brief GNU Radio source that reads a set of files as a single stream
+ *
+ * -------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2018  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *          Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------
+ */
+
+#include "multi_file_source.h"
+#include <glog/logging.h>
+#include <gnuradio/io_signature.h>
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <stdexcept>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+
+namespace
+{
+const size_t READ_CHUNK_BYTES = 1048576;        // read at once by the reader thread
+const size_t MIN_RING_CHUNKS = 4;
+const off_t OPEN_READ_AHEAD_BYTES = 16777216;  // asked for as soon as a file is opened
+}  // namespace
+
+
+multi_file_source_sptr make_multi_file_source(size_t item_size, const std::vector<std::string>& filenames, size_t header_bytes, uint64_t offset_items, bool repeat, size_t prefetch_bytes)
+{
+    return multi_file_source_sptr(new multi_file_source(item_size, filenames, header_bytes, offset_items, repeat, prefetch_bytes));
+}
+
+
+multi_file_source::multi_file_source(size_t item_size,
+    const std::vector<std::string>& filenames,
+    size_t header_bytes,
+    uint64_t offset_items,
+    bool repeat,
+    size_t prefetch_bytes) : gr::sync_block("multi_file_source",
+                                 gr::io_signature::make(0, 0, 0),
+                                 gr::io_signature::make(1, 1, item_size)),
+                             d_item_size(item_size),
+                             d_filenames(filenames),
+                             d_header_bytes(header_bytes),
+                             d_repeat(repeat),
+                             d_first_file(0),
+                             d_first_position(0),
+                             d_total_bytes(0),
+                             d_read(0),
+                             d_consumed(0),
+                             d_finished(false),
+                             d_stop(false)
+{
+    if (d_filenames.empty())
+        {
+            throw std::runtime_error("multi_file_source: no files to read");
+        }
+    uint64_t total_bytes = 0;
+    for (const auto& filename : d_filenames)
+        {
+            struct stat file_stat;
+            if (stat(filename.c_str(), &file_stat) != 0)
+                {
+                    throw std::runtime_error("multi_file_source: cannot open " + filename + ": " + std::strerror(errno));
+                }
+            const auto file_size = static_cast<uint64_t>(file_stat.st_size);
+            d_file_bytes.push_back(file_size > header_bytes ? file_size - header_bytes : 0);
+            if (d_file_bytes.back() == 0)
+                {
+                    LOG(WARNING) << "No samples in " << filename;
+                }
+            total_bytes += d_file_bytes.back();
+        }
+    // the files make up a single stream, the offset may be in any of them
+    uint64_t offset_bytes = offset_items * item_size;
+    if (offset_bytes >= total_bytes)
+        {
+            throw std::runtime_error("multi_file_source: no items to read after the offset");
+        }
+    d_total_bytes = total_bytes - offset_bytes;
+    while (offset_bytes >= d_file_bytes[d_first_file])
+        {
+            offset_bytes -= d_file_bytes[d_first_file];
+            d_first_file++;
+        }
+    d_first_position = offset_bytes;
+    d_ring.resize(std::max((prefetch_bytes + READ_CHUNK_BYTES - 1) / READ_CHUNK_BYTES, MIN_RING_CHUNKS) * READ_CHUNK_BYTES);
+}
+
+
+multi_file_source::~multi_file_source()
+{
+    stop();
+}
+
+
+bool multi_file_source::start()
+{
+    if (!d_thread.joinable())
+        {
+            d_stop = false;
+            d_thread = std::thread(&multi_file_source::run, this);
+        }
+    return true;
+}
+
+
+bool multi_file_source::stop()
+{
+    if (d_thread.joinable())
+        {
+            d_stop.store(true, std::memory_order_release);
+            d_thread.join();
+        }
+    return true;
+}
+
+
+int multi_file_source::open_file(size_t file, uint64_t position)
+{
+    int fd = open(d_filenames[file].c_str(), O_RDONLY);
+    if (fd < 0)
+        {
+            LOG(ERROR) << "Cannot open " << d_filenames[file] << ": " << std::strerror(errno) << ". Its samples are skipped";
+            return -1;
+        }
+    const auto offset = static_cast<off_t>(d_header_bytes + position);
+    if (lseek(fd, offset, SEEK_SET) != offset)
+        {
+            LOG(ERROR) << "Cannot seek in " << d_filenames[file] << ". Its samples are skipped";
+            close(fd);
+            return -1;
+        }
+#ifdef POSIX_FADV_SEQUENTIAL
+    posix_fadvise(fd, 0, 0, POSIX_FADV_SEQUENTIAL);
+    // the first pages are read in the background while the previous file is consumed
+    posix_fadvise(fd, offset, OPEN_READ_AHEAD_BYTES, POSIX_FADV_WILLNEED);
+#endif
+    return fd;
+}
+
+
+void multi_file_source::run()
+{
+    const size_t files = d_filenames.size();
+    size_t file = d_first_file;
+    uint64_t position = d_first_position;
+    int fd = open_file(file, position);
+    int next_fd = -1;
+    bool next_opened = false;
+    while (!d_stop.load(std::memory_order_acquire))
+        {
+            // the file after this one, or the first one again if repeating
+            const bool last_file = file + 1 == files;
+            const size_t next_file = last_file ? d_first_file : file + 1;
+            const uint64_t next_position = last_file ? d_first_position : 0;
+            if (!next_opened and (!last_file or d_repeat))
+                {
+                    next_fd = open_file(next_file, next_position);
+                    next_opened = true;
+                }
+            if (fd < 0 or position >= d_file_bytes[file])
+                {
+                    if (fd >= 0)
+                        {
+                            close(fd);
+                        }
+                    if (last_file and !d_repeat)
+                        {
+                            break;
+                        }
+                    file = next_file;
+                    position = next_position;
+                    fd = next_fd;
+                    next_fd = -1;
+                    next_opened = false;
+                    continue;
+                }
+            const uint64_t read = d_read.load(std::memory_order_relaxed);
+            const uint64_t room = d_ring.size() - (read - d_consumed.load(std::memory_order_acquire));
+            if (room == 0)
+                {
+                    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+                    continue;
+                }
+            const size_t ring_position = read % d_ring.size();
+            const auto n = static_cast<size_t>(std::min({room, static_cast<uint64_t>(d_ring.size() - ring_position), d_file_bytes[file] - position, static_cast<uint64_t>(READ_CHUNK_BYTES)}));
+            ssize_t done = ::read(fd, d_ring.data() + ring_position, n);
+            if (done < 0 and errno == EINTR)
+                {
+                    continue;
+                }
+            if (done <= 0)
+                {
+                    LOG(ERROR) << "Error reading " << d_filenames[file] << " after " << position << " bytes. Going on with the next file";
+                    position = d_file_bytes[file];
+                    continue;
+                }
+            position += static_cast<uint64_t>(done);
+            d_read.store(read + static_cast<uint64_t>(done), std::memory_order_release);
+        }
+    if (fd >= 0)
+        {
+            close(fd);
+        }
+    if (next_fd >= 0)
+        {
+            close(next_fd);
+        }
+    d_finished.store(true, std::memory_order_release);
+}
+
+
+int multi_file_source::work(int noutput_items,
+    gr_vector_const_void_star& input_items __attribute__((unused)),
+    gr_vector_void_star& output_items)
+{
+    auto* out = static_cast<uint8_t*>(output_items[0]);
+    const uint64_t consumed = d_consumed.load(std::memory_order_relaxed);
+    uint64_t available = 0;
+    while (true)
+        {
+            // d_finished first: once it is set, d_read does not change
+            const bool finished = d_finished.load(std::memory_order_acquire);
+            available = d_read.load(std::memory_order_acquire) - consumed;
+            if (available >= d_item_size)
+                {
+                    break;
+                }
+            if (finished)
+                {
+                    return WORK_DONE;
+                }
+            // the storage is late
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    const size_t items = std::min(static_cast<uint64_t>(noutput_items), available / d_item_size);
+    const size_t bytes = items * d_item_size;
+    const size_t ring_position = consumed % d_ring.size();
+    const size_t first = std::min(bytes, d_ring.size() - ring_position);
+    std::memcpy(out, d_ring.data() + ring_position, first);
+    std::memcpy(out + first, d_ring.data(), bytes - first);
+    d_consumed.store(consumed + bytes, std::memory_order_release);
+    return static_cast<int>(items);
+}
@@ -0,0 +1,100 @@
+/*!
+ * \file multi_file_source.h
+ * \brief GNU Radio source that reads a set of files as a single stream
+ *
+ * The files, for instance those written by a recorder that starts a new
+ * file every minute, are read one after the other with no gap between them.
+ * A reader thread of its own fills a ring with the contents of the files,
+ * opening each file and asking the kernel for its first pages before the
+ * previous one is over, while work() only copies from the ring.
+ *
+ * -------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2018  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *          Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_MULTI_FILE_SOURCE_H_
+#define GNSS_SDR_MULTI_FILE_SOURCE_H_
+
+#include <gnuradio/sync_block.h>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <thread>
+#include <vector>
+
+
+class multi_file_source;
+
+typedef boost::shared_ptr<multi_file_source> multi_file_source_sptr;
+
+/*!
+ * \brief Makes a source of items of \p item_size bytes read from the files
+ * in \p filenames, in that order, skipping the first \p header_bytes bytes of
+ * each file. The output starts at item \p offset_items of the whole set. If
+ * \p repeat is true, the set is read again from that item when its end is
+ * reached. Up to \p prefetch_bytes bytes are read ahead. Throws
+ * std::runtime_error if a file cannot be opened or there are no items to read.
+ */
+multi_file_source_sptr make_multi_file_source(size_t item_size, const std::vector<std::string>& filenames, size_t header_bytes, uint64_t offset_items, bool repeat, size_t prefetch_bytes);
+
+class multi_file_source : public gr::sync_block
+{
+private:
+    friend multi_file_source_sptr make_multi_file_source(size_t item_size, const std::vector<std::string>& filenames, size_t header_bytes, uint64_t offset_items, bool repeat, size_t prefetch_bytes);
+    multi_file_source(size_t item_size, const std::vector<std::string>& filenames, size_t header_bytes, uint64_t offset_items, bool repeat, size_t prefetch_bytes);
+
+    int open_file(size_t file, uint64_t position);
+    void run();
+
+    size_t d_item_size;
+    std::vector<std::string> d_filenames;
+    std::vector<uint64_t> d_file_bytes;  // data bytes of each file, headers excluded
+    size_t d_header_bytes;
+    bool d_repeat;
+    size_t d_first_file;       // file and position of the first item to produce
+    uint64_t d_first_position;
+    uint64_t d_total_bytes;    // from the first item to the end of the set
+
+    std::vector<uint8_t> d_ring;
+    std::atomic<uint64_t> d_read;      // bytes put in the ring by the reader thread
+    std::atomic<uint64_t> d_consumed;  // bytes taken from the ring by work()
+    std::atomic<bool> d_finished;      // no more bytes will be put in the ring
+    std::atomic<bool> d_stop;
+    std::thread d_thread;
+
+public:
+    ~multi_file_source();
+
+    uint64_t items() const { return d_total_bytes / d_item_size; }  //!< items from the offset to the end of the set
+
+    bool start() override;
+    bool stop() override;
+
+    int work(int noutput_items,
+        gr_vector_const_void_star& input_items,
+        gr_vector_void_star& output_items);
+};
+
+#endif
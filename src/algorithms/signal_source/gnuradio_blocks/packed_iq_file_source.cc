@@ -0,0 +1,289 @@
+/*!
+ * \file packed_iq_file_source.cc
+ * \brief GNU Radio source that reads a packed IQ file (see packed_iq_format.h)
+ *
+ * -------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2018  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *          Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------
+ */
+
+#include "packed_iq_file_source.h"
+#include <glog/logging.h>
+#include <gnuradio/io_signature.h>
+#include <volk_gnsssdr/volk_gnsssdr.h>
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+
+namespace
+{
+// levels of the two's complement codes, 2 x + 1
+const int8_t TWO_BIT_LUT[4] = {1, 3, -3, -1};
+const uint8_t TWO_BIT_ORDER[4] = {0, 1, 2, 3};  // least significant bits first
+const int8_t FOUR_BIT_LUT[16] = {1, 3, 5, 7, 9, 11, 13, 15, -15, -13, -11, -9, -7, -5, -3, -1};
+}  // namespace
+
+
+packed_iq_file_source_sptr make_packed_iq_file_source(const std::string& filename, bool short_output, bool repeat)
+{
+    return packed_iq_file_source_sptr(new packed_iq_file_source(filename, short_output, repeat));
+}
+
+
+packed_iq_file_source::packed_iq_file_source(const std::string& filename,
+    bool short_output,
+    bool repeat) : gr::sync_block("packed_iq_file_source",
+                       gr::io_signature::make(0, 0, 0),
+                       gr::io_signature::make(1, 1, short_output ? sizeof(lv_16sc_t) : sizeof(gr_complex))),
+                   d_short_output(short_output),
+                   d_repeat(repeat),
+                   d_data(nullptr),
+                   d_file_size(0),
+                   d_header(),
+                   d_frame_bytes(0),
+                   d_frames(0),
+                   d_start(0),
+                   d_end(0),
+                   d_position(0),
+                   d_frame(0),
+                   d_decoded_frame(0),
+                   d_missing(0)
+{
+    int fd = open(filename.c_str(), O_RDONLY);
+    if (fd < 0)
+        {
+            throw std::runtime_error("packed_iq_file_source: cannot open " + filename + ": " + std::strerror(errno));
+        }
+    struct stat file_stat;
+    if (fstat(fd, &file_stat) != 0)
+        {
+            close(fd);
+            throw std::runtime_error("packed_iq_file_source: cannot stat " + filename);
+        }
+    d_file_size = static_cast<size_t>(file_stat.st_size);
+    if (d_file_size < sizeof(Packed_Iq_File_Header) or read(fd, &d_header, sizeof(d_header)) != static_cast<ssize_t>(sizeof(d_header)) or !packed_iq_header_valid(d_header))
+        {
+            close(fd);
+            throw std::runtime_error("packed_iq_file_source: " + filename + " is not a packed IQ file");
+        }
+    d_frame_bytes = packed_iq_frame_bytes(d_header.bits, d_header.frame_samples);
+    d_frames = d_file_size > d_header.header_bytes ? (d_file_size - d_header.header_bytes) / d_frame_bytes : 0;
+    if (d_frames == 0)
+        {
+            close(fd);
+            throw std::runtime_error("packed_iq_file_source: no samples to read in " + filename);
+        }
+    void* map = mmap(nullptr, d_file_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);  // the mapping keeps the file open
+    if (map == MAP_FAILED)
+        {
+            throw std::runtime_error("packed_iq_file_source: cannot map " + filename + ": " + std::strerror(errno));
+        }
+    d_data = static_cast<const uint8_t*>(map);
+    madvise(map, d_file_size, MADV_SEQUENTIAL);
+
+    const Packed_Iq_Frame_Header* first = frame_header(0);
+    const Packed_Iq_Frame_Header* last = frame_header(d_frames - 1);
+    if (first->sync != PACKED_IQ_FRAME_SYNC or last->sync != PACKED_IQ_FRAME_SYNC or last->first_sample < first->first_sample)
+        {
+            munmap(map, d_file_size);
+            throw std::runtime_error("packed_iq_file_source: corrupted frames in " + filename);
+        }
+    d_end = last->first_sample + last->samples;
+    // only the last frame may be incomplete
+    d_missing = d_end - first->first_sample - ((d_frames - 1) * d_header.frame_samples + last->samples);
+    d_start = first->first_sample;
+    if (d_missing > 0)
+        {
+            LOG(INFO) << filename << ": " << d_missing << " samples dropped by the recorder, read as zeros";
+        }
+    d_position = d_start;
+    d_frame = 0;
+    d_decoded_frame = d_frames;
+    d_codes.resize(2 * d_header.frame_samples);
+    if (d_short_output)
+        {
+            d_decoded_short.resize(d_header.frame_samples);
+        }
+    else
+        {
+            d_decoded_float.resize(d_header.frame_samples);
+        }
+}
+
+
+packed_iq_file_source::~packed_iq_file_source()
+{
+    if (d_data != nullptr)
+        {
+            munmap(const_cast<uint8_t*>(d_data), d_file_size);
+        }
+}
+
+
+bool packed_iq_file_source::seek(uint64_t offset_samples)
+{
+    const uint64_t sample = frame_header(0)->first_sample + offset_samples;
+    if (sample >= d_end)
+        {
+            return false;
+        }
+    d_start = sample;
+    d_position = sample;
+    d_frame = find_frame(sample);
+    return true;
+}
+
+
+const Packed_Iq_Frame_Header* packed_iq_file_source::frame_header(size_t frame) const
+{
+    return reinterpret_cast<const Packed_Iq_Frame_Header*>(d_data + d_header.header_bytes + frame * d_frame_bytes);
+}
+
+
+size_t packed_iq_file_source::find_frame(uint64_t sample) const
+{
+    // with no frames dropped before it, the frame is where it would be in the stream
+    const uint64_t first_sample = frame_header(0)->first_sample;
+    const uint64_t guess = (sample - first_sample) / d_header.frame_samples;
+    if (guess < d_frames and frame_header(guess)->first_sample == first_sample + guess * d_header.frame_samples)
+        {
+            return static_cast<size_t>(guess);
+        }
+    // otherwise, the last frame starting at or before the sample
+    size_t low = 0;
+    size_t high = d_frames - 1;
+    while (low < high)
+        {
+            const size_t middle = (low + high + 1) / 2;
+            if (frame_header(middle)->first_sample <= sample)
+                {
+                    low = middle;
+                }
+            else
+                {
+                    high = middle - 1;
+                }
+        }
+    if (frame_header(low)->first_sample + frame_header(low)->samples <= sample)
+        {
+            // in the gap after it
+            low++;
+        }
+    return low;
+}
+
+
+void packed_iq_file_source::decode_frame(size_t frame)
+{
+    const uint8_t* payload = reinterpret_cast<const uint8_t*>(frame_header(frame) + 1);
+    const unsigned int samples = d_header.frame_samples;
+    const int8_t* codes = reinterpret_cast<const int8_t*>(payload);
+    if (d_header.bits == 2)
+        {
+            if (d_short_output)
+                {
+                    volk_gnsssdr_8u_unpack_2bit_16i(reinterpret_cast<int16_t*>(d_decoded_short.data()), payload, TWO_BIT_LUT, TWO_BIT_ORDER, samples / 2);
+                }
+            else
+                {
+                    volk_gnsssdr_8u_unpack_2bit_32f(reinterpret_cast<float*>(d_decoded_float.data()), payload, TWO_BIT_LUT, TWO_BIT_ORDER, samples / 2);
+                }
+            d_decoded_frame = frame;
+            return;
+        }
+    if (d_header.bits == 4)
+        {
+            volk_gnsssdr_8u_unpack_4bit_8i(d_codes.data(), payload, FOUR_BIT_LUT, samples);
+            codes = d_codes.data();
+        }
+    if (d_short_output)
+        {
+            volk_gnsssdr_8ic_convert_16ic(d_decoded_short.data(), reinterpret_cast<const lv_8sc_t*>(codes), samples);
+        }
+    else
+        {
+            lv_32fc_t* out = d_decoded_float.data();
+            volk_gnsssdr_8ic_deinterleave_32fc_xn(&out, reinterpret_cast<const lv_8sc_t*>(codes), 0, 1, samples);
+        }
+    d_decoded_frame = frame;
+}
+
+
+int packed_iq_file_source::work(int noutput_items,
+    gr_vector_const_void_star& input_items __attribute__((unused)),
+    gr_vector_void_star& output_items)
+{
+    auto* out = static_cast<uint8_t*>(output_items[0]);
+    const size_t item_size = d_short_output ? sizeof(lv_16sc_t) : sizeof(gr_complex);
+    const auto* decoded = d_short_output ? reinterpret_cast<const uint8_t*>(d_decoded_short.data()) : reinterpret_cast<const uint8_t*>(d_decoded_float.data());
+    auto requested = static_cast<uint64_t>(noutput_items);
+    uint64_t produced = 0;
+    while (produced < requested)
+        {
+            if (d_position >= d_end)
+                {
+                    if (!d_repeat)
+                        {
+                            break;
+                        }
+                    d_position = d_start;
+                    d_frame = find_frame(d_start);
+                }
+            const Packed_Iq_Frame_Header* header = frame_header(d_frame);
+            uint64_t n;
+            if (d_position < header->first_sample)
+                {
+                    // samples dropped by the recorder
+                    n = std::min(requested - produced, header->first_sample - d_position);
+                    std::memset(out + produced * item_size, 0, n * item_size);
+                }
+            else
+                {
+                    if (d_decoded_frame != d_frame)
+                        {
+                            decode_frame(d_frame);
+                        }
+                    const uint64_t offset = d_position - header->first_sample;
+                    n = std::min(requested - produced, header->samples - offset);
+                    std::memcpy(out + produced * item_size, decoded + offset * item_size, n * item_size);
+                    if (offset + n == header->samples)
+                        {
+                            d_frame++;
+                        }
+                }
+            produced += n;
+            d_position += n;
+        }
+    if (produced == 0)
+        {
+            return WORK_DONE;
+        }
+    return static_cast<int>(produced);
+}
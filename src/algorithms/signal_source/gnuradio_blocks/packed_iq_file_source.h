@@ -0,0 +1,110 @@
+/*!
+ * \file packed_iq_file_source.h
+ * \brief GNU Radio source that reads a packed IQ file (see packed_iq_format.h)
+ *
+ * The file is mapped read-only and unpacked one frame at a time with the
+ * volk_gnsssdr kernels, into cshort or gr_complex samples. The frame headers
+ * give the place of each frame in the recorded stream: the output starts at
+ * any sample without reading the file up to it, and the samples dropped by
+ * the recorder come out as zeros, so that the output keeps the timing of the
+ * recorded stream.
+ *
+ * -------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2018  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *          Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_PACKED_IQ_FILE_SOURCE_H_
+#define GNSS_SDR_PACKED_IQ_FILE_SOURCE_H_
+
+#include "packed_iq_format.h"
+#include <gnuradio/sync_block.h>
+#include <volk_gnsssdr/volk_gnsssdr_complex.h>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+
+class packed_iq_file_source;
+
+typedef boost::shared_ptr<packed_iq_file_source> packed_iq_file_source_sptr;
+
+/*!
+ * \brief Makes a source of the samples of the packed IQ file \p filename, as
+ * cshort items if \p short_output is true or as gr_complex items otherwise.
+ * If \p repeat is true, the file is read again from the first sample (see
+ * seek()) when its end is reached. Throws std::runtime_error if the file
+ * cannot be mapped or is not a packed IQ file.
+ */
+packed_iq_file_source_sptr make_packed_iq_file_source(const std::string& filename, bool short_output, bool repeat);
+
+class packed_iq_file_source : public gr::sync_block
+{
+private:
+    friend packed_iq_file_source_sptr make_packed_iq_file_source(const std::string& filename, bool short_output, bool repeat);
+    packed_iq_file_source(const std::string& filename, bool short_output, bool repeat);
+
+    const Packed_Iq_Frame_Header* frame_header(size_t frame) const;
+    size_t find_frame(uint64_t sample) const;
+    void decode_frame(size_t frame);
+
+    bool d_short_output;
+    bool d_repeat;
+    const uint8_t* d_data;  // mapping of the whole file
+    size_t d_file_size;
+    Packed_Iq_File_Header d_header;
+    size_t d_frame_bytes;
+    size_t d_frames;
+    uint64_t d_start;        // stream number of the first sample to produce
+    uint64_t d_end;          // stream number after the last recorded sample
+    uint64_t d_position;     // stream number of the next sample to produce
+    size_t d_frame;          // frame holding d_position, or the next one after a gap
+    size_t d_decoded_frame;  // frame in the decoded buffer, d_frames if none
+    uint64_t d_missing;      // samples of the stream not in the file
+    std::vector<int8_t> d_codes;
+    std::vector<lv_16sc_t> d_decoded_short;
+    std::vector<gr_complex> d_decoded_float;
+
+public:
+    ~packed_iq_file_source();
+
+    /*!
+     * \brief Makes the output start \p offset_samples samples after the start
+     * of the recording. Returns false, and leaves the start as it was, if the
+     * recording ends before that sample.
+     */
+    bool seek(uint64_t offset_samples);
+
+    double sampling_frequency() const { return d_header.sampling_frequency; }
+    double intermediate_frequency() const { return d_header.intermediate_frequency; }
+    int bits() const { return static_cast<int>(d_header.bits); }
+    uint64_t samples() const { return d_end - d_start; }    //!< samples from the offset to the end of the recording, gaps included
+    uint64_t missing_samples() const { return d_missing; }  //!< samples dropped by the recorder, in the whole file
+
+    int work(int noutput_items,
+        gr_vector_const_void_star& input_items,
+        gr_vector_void_star& output_items);
+};
+
+#endif
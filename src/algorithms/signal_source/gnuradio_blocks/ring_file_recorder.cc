@@ -0,0 +1,440 @@
+/*!
+ * \file ring_file_recorder.cc
+ * \brief GNU Radio sink that records samples to a file from its own thread,
+ * dropping them instead of ever slowing down the flowgraph
+ *
+ * -------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2018  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *          Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------
+ */
+
+#include "ring_file_recorder.h"
+#include "packed_iq_format.h"
+#include <glog/logging.h>
+#include <gnuradio/io_signature.h>
+#include <algorithm>
+#include <cerrno>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <stdexcept>
+#include <fcntl.h>
+#include <unistd.h>
+
+
+namespace
+{
+const size_t DIRECT_IO_ALIGNMENT = 4096;
+const size_t CHUNK_BYTES = 1048576;   // written at once by the writer thread
+const float POWER_SMOOTHING = 0.1F;   // weight of the power of each work() call
+const float TWO_BIT_THRESHOLD = 1.0F;    // in standard deviations
+const float FOUR_BIT_STEP = 0.335F;      // in standard deviations
+const float EIGHT_BIT_STEP = 0.03125F;   // in standard deviations
+}  // namespace
+
+
+ring_file_recorder_sptr make_ring_file_recorder(size_t item_size, const std::string& item_type, const std::string& filename, size_t ring_bytes, int requantize_bits)
+{
+    return ring_file_recorder_sptr(new ring_file_recorder(item_size, item_type, filename, ring_bytes, requantize_bits));
+}
+
+
+ring_file_recorder_sptr make_packed_iq_file_recorder(size_t item_size, const std::string& item_type, const std::string& filename, size_t ring_bytes, int bits, double sampling_frequency, double intermediate_frequency, uint32_t frame_samples)
+{
+    ring_file_recorder_sptr recorder(new ring_file_recorder(item_size, item_type, filename, ring_bytes, bits));
+    recorder->begin_packed_iq(sampling_frequency, intermediate_frequency, frame_samples);
+    return recorder;
+}
+
+
+ring_file_recorder::ring_file_recorder(size_t item_size,
+    const std::string& item_type,
+    const std::string& filename,
+    size_t ring_bytes,
+    int requantize_bits) : gr::sync_block("ring_file_recorder",
+                               gr::io_signature::make(1, 1, item_size),
+                               gr::io_signature::make(0, 0, 0)),
+                           d_filename(filename),
+                           d_fd(-1),
+                           d_item_size(item_size),
+                           d_component_type(0),
+                           d_components(0),
+                           d_requantize_bits(0),
+                           d_power(0.0F),
+                           d_bit_buffer(0),
+                           d_bit_count(0),
+                           d_frame_samples(0),
+                           d_frame_fill(0),
+                           d_frame_first(0),
+                           d_ring(nullptr),
+                           d_ring_bytes(0),
+                           d_written(0),
+                           d_flushed(0),
+                           d_stop(false),
+                           d_write_failed(false),
+                           d_dropped_items(0),
+                           d_reported_items(0)
+{
+    if (requantize_bits == 2 or requantize_bits == 4 or requantize_bits == 8)
+        {
+            if (item_type == "gr_complex" or item_type == "float")
+                {
+                    d_component_type = 1;
+                }
+            else if (item_type == "cshort" or item_type == "short" or item_type == "ishort")
+                {
+                    d_component_type = 2;
+                }
+            else if (item_type == "cbyte" or item_type == "byte" or item_type == "ibyte")
+                {
+                    d_component_type = 3;
+                }
+            if (d_component_type == 0)
+                {
+                    LOG(WARNING) << "Cannot requantize items of type " << item_type << ", recording them as they are";
+                }
+            else
+                {
+                    d_requantize_bits = requantize_bits;
+                    const size_t component_bytes = d_component_type == 1 ? sizeof(float) : (d_component_type == 2 ? sizeof(int16_t) : sizeof(int8_t));
+                    d_components = static_cast<int>(item_size / component_bytes);
+                }
+        }
+    else if (requantize_bits != 0)
+        {
+            LOG(WARNING) << "Requantization to " << requantize_bits << " bits not supported, recording the items as they are";
+        }
+
+    d_ring_bytes = std::max((ring_bytes + CHUNK_BYTES - 1) / CHUNK_BYTES, static_cast<size_t>(2)) * CHUNK_BYTES;
+    void* ring = nullptr;
+    if (posix_memalign(&ring, DIRECT_IO_ALIGNMENT, d_ring_bytes) != 0)
+        {
+            throw std::runtime_error("ring_file_recorder: cannot allocate a ring of " + std::to_string(d_ring_bytes) + " bytes");
+        }
+    d_ring = static_cast<uint8_t*>(ring);
+    // touch the pages now rather than in the scheduler thread
+    std::memset(d_ring, 0, d_ring_bytes);
+
+#ifdef O_DIRECT
+    d_fd = open(filename.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_DIRECT, 0644);
+    if (d_fd < 0 and errno == EINVAL)
+        {
+            // e.g. tmpfs: fall back to buffered writes, still out of the scheduler thread
+            LOG(INFO) << "O_DIRECT not supported for " << filename << ", using buffered writes";
+            d_fd = open(filename.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+        }
+#else
+    d_fd = open(filename.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+#endif
+    if (d_fd < 0)
+        {
+            free(d_ring);
+            throw std::runtime_error("ring_file_recorder: cannot create " + filename + ": " + std::strerror(errno));
+        }
+    // the first drop is reported at once
+    d_t_report = std::chrono::steady_clock::time_point();
+}
+
+
+ring_file_recorder::~ring_file_recorder()
+{
+    stop();
+    close(d_fd);
+    free(d_ring);
+}
+
+
+bool ring_file_recorder::start()
+{
+    if (!d_thread.joinable())
+        {
+            d_stop = false;
+            d_thread = std::thread(&ring_file_recorder::run, this);
+        }
+    return true;
+}
+
+
+void ring_file_recorder::begin_packed_iq(double sampling_frequency, double intermediate_frequency, uint32_t frame_samples)
+{
+    if (d_requantize_bits == 0 or d_components != 2)
+        {
+            throw std::runtime_error("ring_file_recorder: " + d_filename + " needs complex items requantized to 2, 4 or 8 bits");
+        }
+    Packed_Iq_File_Header header{};
+    std::memcpy(header.magic, PACKED_IQ_MAGIC, sizeof(PACKED_IQ_MAGIC));
+    header.version = PACKED_IQ_VERSION;
+    header.header_bytes = sizeof(Packed_Iq_File_Header);
+    header.sampling_frequency = sampling_frequency;
+    header.intermediate_frequency = intermediate_frequency;
+    header.bits = static_cast<uint32_t>(d_requantize_bits);
+    header.frame_samples = frame_samples;
+    if (!packed_iq_header_valid(header))
+        {
+            throw std::runtime_error("ring_file_recorder: invalid packed IQ parameters for " + d_filename);
+        }
+    // the ring is still empty
+    queue(reinterpret_cast<const uint8_t*>(&header), sizeof(header));
+    d_frame_samples = frame_samples;
+    d_frame.assign(packed_iq_frame_bytes(header.bits, frame_samples), 0);
+    d_frame_fill = 0;
+    d_frame_first = 0;
+}
+
+
+void ring_file_recorder::frame_out(const uint8_t* data, size_t bytes)
+{
+    const size_t payload_bytes = d_frame.size() - sizeof(Packed_Iq_Frame_Header);
+    while (bytes > 0)
+        {
+            const size_t n = std::min(bytes, payload_bytes - d_frame_fill);
+            std::memcpy(d_frame.data() + sizeof(Packed_Iq_Frame_Header) + d_frame_fill, data, n);
+            d_frame_fill += n;
+            data += n;
+            bytes -= n;
+            if (d_frame_fill == payload_bytes)
+                {
+                    Packed_Iq_Frame_Header frame_header{d_frame_first, d_frame_samples, PACKED_IQ_FRAME_SYNC};
+                    std::memcpy(d_frame.data(), &frame_header, sizeof(frame_header));
+                    if (!queue(d_frame.data(), d_frame.size()))
+                        {
+                            // the next frame keeps its place in the stream
+                            d_dropped_items += d_frame_samples;
+                            report_dropped(false);
+                        }
+                    d_frame_first += d_frame_samples;
+                    d_frame_fill = 0;
+                }
+        }
+}
+
+
+void ring_file_recorder::flush_frame()
+{
+    // with 2 bits, an odd number of samples leaves the last one in d_bit_buffer
+    const size_t samples = (d_frame_fill * 8 + d_bit_count) / (2 * d_requantize_bits);
+    if (d_bit_count > 0)
+        {
+            // there is always room for it: a full frame is queued at once
+            d_frame[sizeof(Packed_Iq_Frame_Header) + d_frame_fill++] = static_cast<uint8_t>(d_bit_buffer);
+            d_bit_buffer = 0;
+            d_bit_count = 0;
+        }
+    if (samples == 0)
+        {
+            return;
+        }
+    std::memset(d_frame.data() + sizeof(Packed_Iq_Frame_Header) + d_frame_fill, 0, d_frame.size() - sizeof(Packed_Iq_Frame_Header) - d_frame_fill);
+    Packed_Iq_Frame_Header frame_header{d_frame_first, static_cast<uint32_t>(samples), PACKED_IQ_FRAME_SYNC};
+    std::memcpy(d_frame.data(), &frame_header, sizeof(frame_header));
+    // out of the scheduler now: wait for room in the ring
+    while (!queue(d_frame.data(), d_frame.size()) and !d_write_failed)
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    d_frame_first += samples;
+    d_frame_fill = 0;
+}
+
+
+bool ring_file_recorder::stop()
+{
+    if (d_thread.joinable())
+        {
+            if (d_frame_samples > 0)
+                {
+                    flush_frame();
+                }
+            // the writer thread empties the ring before leaving
+            d_stop.store(true, std::memory_order_release);
+            d_thread.join();
+        }
+    report_dropped(true);
+    return true;
+}
+
+
+void ring_file_recorder::write_out(const uint8_t* data, size_t bytes)
+{
+    while (bytes > 0 and !d_write_failed)
+        {
+            ssize_t done = write(d_fd, data, bytes);
+            if (done < 0)
+                {
+                    if (errno == EINTR)
+                        {
+                            continue;
+                        }
+                    // keep emptying the ring, so that the flowgraph is not affected
+                    LOG(ERROR) << "Error writing " << d_filename << ": " << std::strerror(errno) << ". The recording is stopped";
+                    std::cout << "Error writing " << d_filename << ", the recording is stopped" << std::endl;
+                    d_write_failed = true;
+                    return;
+                }
+            data += done;
+            bytes -= static_cast<size_t>(done);
+        }
+}
+
+
+void ring_file_recorder::run()
+{
+    while (true)
+        {
+            const bool stopping = d_stop.load(std::memory_order_acquire);
+            const uint64_t flushed = d_flushed.load(std::memory_order_relaxed);
+            const uint64_t available = d_written.load(std::memory_order_acquire) - flushed;
+            // d_flushed is a multiple of CHUNK_BYTES until the end, so a chunk never wraps around
+            const uint8_t* data = d_ring + flushed % d_ring_bytes;
+            if (available >= CHUNK_BYTES)
+                {
+                    write_out(data, CHUNK_BYTES);
+                    d_flushed.store(flushed + CHUNK_BYTES, std::memory_order_release);
+                }
+            else if (stopping)
+                {
+#ifdef O_DIRECT
+                    // the last bytes do not make up an aligned chunk
+                    fcntl(d_fd, F_SETFL, fcntl(d_fd, F_GETFL) & ~O_DIRECT);
+#endif
+                    write_out(data, static_cast<size_t>(available));
+                    d_flushed.store(flushed + available, std::memory_order_release);
+                    return;
+                }
+            else
+                {
+                    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+                }
+        }
+}
+
+
+bool ring_file_recorder::queue(const uint8_t* data, size_t bytes)
+{
+    const uint64_t written = d_written.load(std::memory_order_relaxed);
+    if (d_ring_bytes - (written - d_flushed.load(std::memory_order_acquire)) < bytes)
+        {
+            return false;
+        }
+    const size_t position = written % d_ring_bytes;
+    const size_t first = std::min(bytes, d_ring_bytes - position);
+    std::memcpy(d_ring + position, data, first);
+    std::memcpy(d_ring, data + first, bytes - first);
+    d_written.store(written + bytes, std::memory_order_release);
+    return true;
+}
+
+
+template <typename T>
+void ring_file_recorder::requantize(const T* in, size_t components)
+{
+    // the step follows the power of the input, smoothed over the work() calls
+    double sum = 0.0;
+    for (size_t k = 0; k < components; k++)
+        {
+            sum += static_cast<double>(in[k]) * static_cast<double>(in[k]);
+        }
+    const auto power = static_cast<float>(sum / static_cast<double>(components));
+    d_power = d_power > 0.0F ? (1.0F - POWER_SMOOTHING) * d_power + POWER_SMOOTHING * power : power;
+    const float sigma = std::sqrt(d_power);
+    const float step = sigma * (d_requantize_bits == 2 ? TWO_BIT_THRESHOLD : (d_requantize_bits == 4 ? FOUR_BIT_STEP : EIGHT_BIT_STEP));
+    // 8-bit codes are centred on the levels, the others between them
+    const float offset = d_requantize_bits == 8 ? 0.5F : 0.0F;
+    const float inverse_step = step > 0.0F ? 1.0F / step : 0.0F;
+    const int max_code = (1 << (d_requantize_bits - 1)) - 1;
+    const uint32_t mask = (1U << d_requantize_bits) - 1;
+
+    d_packed.resize(components * d_requantize_bits / 8 + 1);
+    size_t bytes = 0;
+    for (size_t k = 0; k < components; k++)
+        {
+            int code = static_cast<int>(std::floor(static_cast<float>(in[k]) * inverse_step + offset));
+            code = std::min(std::max(code, -max_code - 1), max_code);
+            d_bit_buffer |= (static_cast<uint32_t>(code) & mask) << d_bit_count;
+            d_bit_count += d_requantize_bits;
+            if (d_bit_count == 8)
+                {
+                    d_packed[bytes++] = static_cast<uint8_t>(d_bit_buffer);
+                    d_bit_buffer = 0;
+                    d_bit_count = 0;
+                }
+        }
+    d_packed.resize(bytes);
+}
+
+
+void ring_file_recorder::report_dropped(bool force)
+{
+    auto now = std::chrono::steady_clock::now();
+    if (d_dropped_items == d_reported_items or (!force and now - d_t_report < std::chrono::seconds(1)))
+        {
+            return;
+        }
+    LOG(WARNING) << "Recorder of " << d_filename << ": " << d_dropped_items << " items dropped so far, the storage cannot keep up";
+    std::cout << "Recorder of " << d_filename << ": " << d_dropped_items << " items dropped so far, the storage cannot keep up" << std::endl;
+    d_reported_items = d_dropped_items;
+    d_t_report = now;
+}
+
+
+int ring_file_recorder::work(int noutput_items,
+    gr_vector_const_void_star& input_items,
+    gr_vector_void_star& output_items __attribute__((unused)))
+{
+    bool queued;
+    if (d_requantize_bits == 0)
+        {
+            queued = queue(static_cast<const uint8_t*>(input_items[0]), noutput_items * d_item_size);
+        }
+    else
+        {
+            const size_t components = static_cast<size_t>(noutput_items) * d_components;
+            switch (d_component_type)
+                {
+                case 1:
+                    requantize(static_cast<const float*>(input_items[0]), components);
+                    break;
+                case 2:
+                    requantize(static_cast<const int16_t*>(input_items[0]), components);
+                    break;
+                default:
+                    requantize(static_cast<const int8_t*>(input_items[0]), components);
+                    break;
+                }
+            if (d_frame_samples > 0)
+                {
+                    // frames are dropped, if at all, as a whole
+                    frame_out(d_packed.data(), d_packed.size());
+                    return noutput_items;
+                }
+            queued = queue(d_packed.data(), d_packed.size());
+        }
+    if (!queued)
+        {
+            // never wait for the writer: the items are lost, and the flowgraph goes on
+            d_dropped_items += noutput_items;
+            report_dropped(false);
+        }
+    return noutput_items;
+}
@@ -0,0 +1,145 @@
+/*!
+ * \file ring_file_recorder.h
+ * \brief GNU Radio sink that records samples to a file from its own thread,
+ * dropping them instead of ever slowing down the flowgraph
+ *
+ * -------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2018  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *          Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_RING_FILE_RECORDER_H_
+#define GNSS_SDR_RING_FILE_RECORDER_H_
+
+#include <gnuradio/sync_block.h>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <thread>
+#include <vector>
+
+
+class ring_file_recorder;
+
+typedef boost::shared_ptr<ring_file_recorder> ring_file_recorder_sptr;
+
+/*!
+ * \brief Makes a recorder of items of \p item_size bytes and type \p item_type
+ * into \p filename, through a ring of \p ring_bytes bytes (rounded up to a
+ * whole number of write chunks). If \p requantize_bits is 2, 4 or 8, each
+ * component is requantized to that number of bits before being queued.
+ * Throws std::runtime_error if the file cannot be created or the ring cannot
+ * be allocated.
+ */
+ring_file_recorder_sptr make_ring_file_recorder(size_t item_size, const std::string& item_type, const std::string& filename, size_t ring_bytes, int requantize_bits);
+
+/*!
+ * \brief Makes a recorder of complex items into a packed IQ file (see
+ * packed_iq_format.h) of \p bits bits per component, with a frame header
+ * every \p frame_samples samples. \p sampling_frequency and
+ * \p intermediate_frequency are stored in the file header. Throws
+ * std::runtime_error if the items cannot be packed that way, or as
+ * make_ring_file_recorder.
+ */
+ring_file_recorder_sptr make_packed_iq_file_recorder(size_t item_size, const std::string& item_type, const std::string& filename, size_t ring_bytes, int bits, double sampling_frequency, double intermediate_frequency, uint32_t frame_samples);
+
+/*!
+ * \brief work() only copies the samples into a preallocated lock-free ring,
+ * and a writer thread empties it in large aligned chunks, with O_DIRECT where
+ * the file system allows it. If the ring is full, the samples of the call are
+ * dropped and counted, and the flowgraph goes on.
+ *
+ * Requantized components are written as two's complement codes \a x, meaning
+ * (2 \a x + 1) times half the quantization step, packed from the least
+ * significant bits of each byte: in-phase before quadrature, earlier samples
+ * first. With 4 bits, this is the c4bits format of the UDP source. With 8 bits,
+ * the codes are rounded and mean \a x steps. The step follows the power of the
+ * input: the 2-bit threshold is at one standard deviation, the 4-bit step is
+ * 0.335 of it, and the 8-bit step 1/32 of it.
+ *
+ * Packed IQ files hold the same codes, in frames: a frame is dropped as a
+ * whole if it does not fit in the ring, and the next one keeps its place in
+ * the stream.
+ */
+class ring_file_recorder : public gr::sync_block
+{
+private:
+    friend ring_file_recorder_sptr make_ring_file_recorder(size_t item_size, const std::string& item_type, const std::string& filename, size_t ring_bytes, int requantize_bits);
+    friend ring_file_recorder_sptr make_packed_iq_file_recorder(size_t item_size, const std::string& item_type, const std::string& filename, size_t ring_bytes, int bits, double sampling_frequency, double intermediate_frequency, uint32_t frame_samples);
+    ring_file_recorder(size_t item_size, const std::string& item_type, const std::string& filename, size_t ring_bytes, int requantize_bits);
+
+    void begin_packed_iq(double sampling_frequency, double intermediate_frequency, uint32_t frame_samples);
+    void frame_out(const uint8_t* data, size_t bytes);
+    void flush_frame();
+
+    template <typename T>
+    void requantize(const T* in, size_t components);
+    bool queue(const uint8_t* data, size_t bytes);
+    void report_dropped(bool force);
+    void run();
+    void write_out(const uint8_t* data, size_t bytes);
+
+    std::string d_filename;
+    int d_fd;
+    size_t d_item_size;
+    int d_component_type;    // 0: raw bytes, 1: float, 2: int16, 3: int8
+    int d_components;        // per item
+    int d_requantize_bits;   // 0 if the items are recorded as they are
+    float d_power;           // smoothed mean power of the components
+    uint32_t d_bit_buffer;   // requantized bits not yet forming a whole byte
+    int d_bit_count;
+    std::vector<uint8_t> d_packed;
+
+    uint32_t d_frame_samples;      // 0 if the codes are written as a plain stream
+    std::vector<uint8_t> d_frame;  // frame header and payload
+    size_t d_frame_fill;           // payload bytes in d_frame
+    uint64_t d_frame_first;        // stream number of the first sample of d_frame
+
+    uint8_t* d_ring;
+    size_t d_ring_bytes;
+    std::atomic<uint64_t> d_written;  // bytes queued by work()
+    std::atomic<uint64_t> d_flushed;  // bytes written to the file by the writer thread
+    std::atomic<bool> d_stop;
+    std::thread d_thread;
+    bool d_write_failed;
+
+    uint64_t d_dropped_items;
+    uint64_t d_reported_items;
+    std::chrono::steady_clock::time_point d_t_report;
+
+public:
+    ~ring_file_recorder();
+
+    uint64_t dropped_items() const { return d_dropped_items; }  //!< items dropped because the ring was full
+
+    bool start() override;
+    bool stop() override;
+
+    int work(int noutput_items,
+        gr_vector_const_void_star& input_items,
+        gr_vector_void_star& output_items);
+};
+
+#endif
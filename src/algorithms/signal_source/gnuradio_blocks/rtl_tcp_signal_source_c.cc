@@ -32,8 +32,11 @@
 
 #include "rtl_tcp_signal_source_c.h"
 #include "rtl_tcp_commands.h"
-#include <boost/thread/thread.hpp>
 #include <glog/logging.h>
+#include <volk_gnsssdr/volk_gnsssdr.h>
+#include <algorithm>
+#include <chrono>
+#include <cstring>
 #include <map>
 
 using google::LogMessage;
@@ -42,45 +45,52 @@ namespace ip = boost::asio::ip;
 using boost::asio::ip::tcp;
 
 // Buffer constants
-// TODO: Make these configurable
 enum
 {
-    RTL_TCP_BUFFER_SIZE = 1024 * 16,  // 16 KB
-    RTL_TCP_PAYLOAD_SIZE = 1024 * 4   //  4 KB
+    RTL_TCP_PAYLOAD_SIZE = 1024 * 64,  // 64 KB, largest read (one slot of the ring)
+    RTL_TCP_MIN_READ = 1024 * 16       // 16 KB, smallest read handed to work()
 };
 
 rtl_tcp_signal_source_c_sptr
 rtl_tcp_make_signal_source_c(const std::string &address,
     int16_t port,
-    bool flip_iq)
+    bool flip_iq,
+    bool short_output,
+    size_t buffer_bytes)
 {
     return gnuradio::get_initial_sptr(new rtl_tcp_signal_source_c(address,
         port,
-        flip_iq));
+        flip_iq,
+        short_output,
+        buffer_bytes));
 }
 
 
 rtl_tcp_signal_source_c::rtl_tcp_signal_source_c(const std::string &address,
     int16_t port,
-    bool flip_iq)
+    bool flip_iq,
+    bool short_output,
+    size_t buffer_bytes)
     : gr::sync_block("rtl_tcp_signal_source_c",
           gr::io_signature::make(0, 0, 0),
-          gr::io_signature::make(1, 1, sizeof(gr_complex))),
+          gr::io_signature::make(1, 1, short_output ? sizeof(lv_16sc_t) : sizeof(gr_complex))),
       socket_(io_service_),
-      data_(RTL_TCP_PAYLOAD_SIZE),
       flip_iq_(flip_iq),
-      buffer_(RTL_TCP_BUFFER_SIZE),
-      unread_(0)
+      short_output_(short_output),
+      ring_(static_cast<uint32_t>(std::max<size_t>(buffer_bytes / RTL_TCP_PAYLOAD_SIZE, 2)), RTL_TCP_PAYLOAD_SIZE),
+      overflow_buffer_(RTL_TCP_PAYLOAD_SIZE),
+      reading_overflow_(false),
+      skip_byte_(false),
+      overflow_(false),
+      dropped_bytes_(0ULL),
+      stopped_(true),
+      offset_(0),
+      has_partial_(false),
+      signed_(RTL_TCP_PAYLOAD_SIZE)
 {
     boost::system::error_code ec;
 
-    // 1. Setup lookup table
-    for (unsigned i = 0; i < 0xff; i++)
-        {
-            lookup_[i] = (static_cast<float>(i & 0xff) - 127.4f) * (1.0f / 128.0f);
-        }
-
-    // 2. Set socket options
+    // 1. Set socket options
     ip::address addr = ip::address::from_string(address, ec);
     if (ec)
         {
@@ -109,7 +119,7 @@ rtl_tcp_signal_source_c::rtl_tcp_signal_source_c(const std::string &address,
             LOG(WARNING) << "Failed to set linger option";
         }
 
-    // 3. Connect socket
+    // 2. Connect socket
 
     socket_.connect(ep, ec);
     if (ec)
@@ -123,7 +133,7 @@ rtl_tcp_signal_source_c::rtl_tcp_signal_source_c(const std::string &address,
     std::cout << "Connected to " << addr << ":" << port << std::endl;
     LOG(INFO) << "Connected to " << addr << ":" << port;
 
-    // 4. Set nodelay
+    // 3. Set nodelay
     socket_.set_option(tcp::no_delay(true), ec);
     if (ec)
         {
@@ -131,7 +141,7 @@ rtl_tcp_signal_source_c::rtl_tcp_signal_source_c(const std::string &address,
             LOG(WARNING) << "Failed to set no delay option";
         }
 
-    // 5. Receive dongle info
+    // 4. Receive dongle info
     ec = info_.read(socket_);
     if (ec)
         {
@@ -144,20 +154,24 @@ rtl_tcp_signal_source_c::rtl_tcp_signal_source_c(const std::string &address,
             LOG(INFO) << "Found " << info_.get_type_name() << " tuner.";
         }
 
-    // 6. Start reading
-    boost::asio::async_read(socket_, boost::asio::buffer(data_),
-        boost::bind(&rtl_tcp_signal_source_c::handle_read,
-            this, _1, _2));
-    boost::thread(boost::bind(&boost::asio::io_service::run, &io_service_));
+    // 5. Start reading
+    stopped_ = false;
+    start_read();
+    io_thread_ = std::thread([this] { io_service_.run(); });
 }
 
 
-rtl_tcp_signal_source_c::~rtl_tcp_signal_source_c()  // NOLINT(modernize-use-equals-default)
+rtl_tcp_signal_source_c::~rtl_tcp_signal_source_c()
 {
-    mutex_.unlock();
     io_service_.stop();
-    not_empty_.notify_one();
-    not_full_.notify_one();
+    if (io_thread_.joinable())
+        {
+            io_thread_.join();
+        }
+    if (dropped_bytes_ > 0)
+        {
+            LOG(WARNING) << "rtl_tcp source: " << get_dropped_samples() << " samples dropped because the receiver was late";
+        }
 }
 
 
@@ -282,49 +296,90 @@ void rtl_tcp_signal_source_c::set_if_gain(int gain)
 }
 
 
+void rtl_tcp_signal_source_c::start_read()
+{
+    // while the ring is full, the socket is still read (and the bytes dropped),
+    // so that the rtl_tcp server does not stall
+    reading_overflow_ = (ring_.writable() == 0);
+    char *target = reading_overflow_ ? overflow_buffer_.data() : ring_.free_slot(0);
+    boost::asio::async_read(socket_,
+        boost::asio::buffer(target, ring_.slot_bytes()),
+        boost::asio::transfer_at_least(RTL_TCP_MIN_READ),
+        [this](const boost::system::error_code &ec, size_t bytes_transferred) { handle_read(ec, bytes_transferred); });
+}
+
+
 void rtl_tcp_signal_source_c::handle_read(const boost::system::error_code &ec,
     size_t bytes_transferred)
 {
+    // a failed read may still have received some bytes
+    if (reading_overflow_)
+        {
+            if (!overflow_)
+                {
+                    // notify overflow
+                    std::cout << "O" << std::flush;
+                    overflow_ = true;
+                }
+            dropped_bytes_.fetch_add(bytes_transferred, std::memory_order_relaxed);
+            if (bytes_transferred % 2 == 1)
+                {
+                    skip_byte_ = !skip_byte_;
+                }
+        }
+    else
+        {
+            overflow_ = false;
+            char *slot = ring_.free_slot(0);
+            auto length = static_cast<uint32_t>(bytes_transferred);
+            if (skip_byte_ and length > 0)
+                {
+                    // drop one more byte, so that the stream starts again with an I sample
+                    std::memmove(slot, slot + 1, length - 1);
+                    length--;
+                    dropped_bytes_.fetch_add(1, std::memory_order_relaxed);
+                    skip_byte_ = false;
+                }
+            if (length > 0)
+                {
+                    ring_.publish(&length, 1);
+                }
+        }
     if (ec)
         {
             std::cout << "Error during read: " << ec << std::endl;
             LOG(WARNING) << "Error during read: " << ec;
-            boost::mutex::scoped_lock lock(mutex_);
-            io_service_.stop();
-            not_empty_.notify_one();
+            stopped_.store(true, std::memory_order_release);
+            return;
+        }
+    start_read();
+}
+
+
+void rtl_tcp_signal_source_c::convert(const char *in, void *out, int n)
+{
+    // unsigned bytes centered at 127.4 to signed bytes, placing I first
+    const auto *bytes = reinterpret_cast<const uint8_t *>(in);
+    const int first = flip_iq_ ? 1 : 0;
+    for (int k = 0; k < n; k++)
+        {
+            signed_[2 * k] = static_cast<int8_t>(bytes[2 * k + first] ^ 0x80U);
+            signed_[2 * k + 1] = static_cast<int8_t>(bytes[2 * k + 1 - first] ^ 0x80U);
+        }
+    if (short_output_)
+        {
+            volk_gnsssdr_8ic_convert_16ic(static_cast<lv_16sc_t *>(out), reinterpret_cast<const lv_8sc_t *>(signed_.data()), n);
         }
     else
         {
-            {
-                // Unpack read data
-                boost::mutex::scoped_lock lock(mutex_);
-                not_full_.wait(lock,
-                    boost::bind(&rtl_tcp_signal_source_c::not_full,
-                        this));
-
-                for (size_t i = 0; i < bytes_transferred; i++)
-                    {
-                        while (!not_full())
-                            {
-                                // uh-oh, buffer overflow
-                                // wait until there's space for more
-                                not_empty_.notify_one();  // needed?
-                                not_full_.wait(lock,
-                                    boost::bind(&rtl_tcp_signal_source_c::not_full,
-                                        this));
-                            }
-
-                        buffer_.push_front(lookup_[data_[i]]);
-                        unread_++;
-                    }
-            }
-            // let woker know that more data is available
-            not_empty_.notify_one();
-            // Read some more
-            boost::asio::async_read(socket_,
-                boost::asio::buffer(data_),
-                boost::bind(&rtl_tcp_signal_source_c::handle_read,
-                    this, _1, _2));
+            auto *samples = static_cast<gr_complex *>(out);
+            volk_gnsssdr_8ic_deinterleave_32fc_xn(&samples, reinterpret_cast<const lv_8sc_t *>(signed_.data()), 0, 1, n);
+            // (byte - 127.4) / 128, as the former lookup table
+            auto *values = reinterpret_cast<float *>(samples);
+            for (int k = 0; k < 2 * n; k++)
+                {
+                    values[k] = (values[k] + 0.6F) * (1.0F / 128.0F);
+                }
         }
 }
 
@@ -333,32 +388,53 @@ int rtl_tcp_signal_source_c::work(int noutput_items,
     gr_vector_const_void_star & /*input_items*/,
     gr_vector_void_star &output_items)
 {
-    gr_complex *out = reinterpret_cast<gr_complex *>(output_items[0]);
-    int i = 0;
-    if (io_service_.stopped())
+    char *out = reinterpret_cast<char *>(output_items[0]);
+    const size_t item_size = short_output_ ? sizeof(lv_16sc_t) : sizeof(gr_complex);
+    int produced = 0;
+    while (produced < noutput_items and ring_.readable() > 0)
+        {
+            size_t bytes;
+            const char *slot = ring_.front(bytes);
+            size_t available = bytes - offset_;
+            if (has_partial_)
+                {
+                    // complete the sample split with the previous slot
+                    partial_[1] = slot[offset_];
+                    offset_++;
+                    available--;
+                    convert(partial_, out + produced * item_size, 1);
+                    produced++;
+                    has_partial_ = false;
+                }
+            else
+                {
+                    int n = std::min(static_cast<int>(available / 2), noutput_items - produced);
+                    convert(slot + offset_, out + produced * item_size, n);
+                    produced += n;
+                    offset_ += 2 * n;
+                    available -= 2 * n;
+                    if (available == 1)
+                        {
+                            partial_[0] = slot[offset_];
+                            has_partial_ = true;
+                            offset_++;
+                            available = 0;
+                        }
+                }
+            if (available == 0)
+                {
+                    ring_.pop();
+                    offset_ = 0;
+                }
+        }
+    if (produced == 0)
         {
-            return -1;
+            if (stopped_.load(std::memory_order_acquire) and ring_.readable() == 0)
+                {
+                    return -1;
+                }
+            // nothing received yet: wait a bit rather than spinning
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
         }
-
-    {
-        boost::mutex::scoped_lock lock(mutex_);
-        not_empty_.wait(lock, boost::bind(&rtl_tcp_signal_source_c::not_empty,
-                                  this));
-
-        for (; i < noutput_items && unread_ > 1; i++)
-            {
-                float re = buffer_[--unread_];
-                float im = buffer_[--unread_];
-                if (flip_iq_)
-                    {
-                        out[i] = gr_complex(im, re);
-                    }
-                else
-                    {
-                        out[i] = gr_complex(re, im);
-                    }
-            }
-    }
-    not_full_.notify_one();
-    return i == 0 ? -1 : i;
+    return produced;
 }
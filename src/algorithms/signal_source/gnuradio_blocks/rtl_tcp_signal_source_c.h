@@ -39,14 +39,14 @@
 #define GNSS_SDR_RTL_TCP_SIGNAL_SOURCE_C_H
 
 #include "rtl_tcp_dongle_info.h"
-#include <boost/array.hpp>
+#include "udp_packet_ring.h"
 #include <boost/asio.hpp>
-#include <boost/circular_buffer.hpp>
-#include <boost/thread/condition.hpp>
-#include <boost/thread/mutex.hpp>
 #include <gnuradio/sync_block.h>
+#include <atomic>
 #include <cstdint>
 #include <string>
+#include <thread>
+#include <vector>
 
 class rtl_tcp_signal_source_c;
 
@@ -56,11 +56,20 @@ typedef boost::shared_ptr<rtl_tcp_signal_source_c>
 rtl_tcp_signal_source_c_sptr
 rtl_tcp_make_signal_source_c(const std::string &address,
     int16_t port,
-    bool flip_iq = false);
+    bool flip_iq = false,
+    bool short_output = false,
+    size_t buffer_bytes = 4194304);
 
 /*!
  * \brief This class reads interleaved I/Q samples
  * from an rtl_tcp server and outputs complex types.
+ *
+ * The socket is read by a Boost.Asio thread in large batches, straight into
+ * the slots of a single-producer single-consumer ring, and work() converts
+ * the bytes of the ring to gr_complex (or to lv_16sc_t if \p short_output)
+ * with volk_gnsssdr kernels. Neither side takes a lock. If the ring is full
+ * the incoming bytes are dropped, instead of stalling the socket, and
+ * counted in get_dropped_samples().
  */
 class rtl_tcp_signal_source_c : public gr::sync_block
 {
@@ -77,49 +86,58 @@ public:
     void set_gain(int gain);
     void set_if_gain(int gain);
 
-private:
-    typedef boost::circular_buffer_space_optimized<float> buffer_type;
+    //! Samples lost because the ring was full
+    inline uint64_t get_dropped_samples() const
+    {
+        return dropped_bytes_.load(std::memory_order_relaxed) / 2;
+    }
 
+private:
     friend rtl_tcp_signal_source_c_sptr
     rtl_tcp_make_signal_source_c(const std::string &address,
         int16_t port,
-        bool flip_iq);
+        bool flip_iq,
+        bool short_output,
+        size_t buffer_bytes);
 
     rtl_tcp_signal_source_c(const std::string &address,
         int16_t port,
-        bool flip_iq);
+        bool flip_iq,
+        bool short_output,
+        size_t buffer_bytes);
 
     rtl_tcp_dongle_info info_;
 
     // IO members
     boost::asio::io_service io_service_;
     boost::asio::ip::tcp::socket socket_;
-    std::vector<unsigned char> data_;
+    std::thread io_thread_;
     bool flip_iq_;
+    bool short_output_;
+
+    // producer side, owned by the IO thread
+    Udp_Packet_Ring ring_;
+    std::vector<char> overflow_buffer_;  // target of the reads while the ring is full
+    bool reading_overflow_;
+    bool skip_byte_;  // an odd number of bytes was dropped: realign I and Q
+    bool overflow_;
+    std::atomic<uint64_t> dropped_bytes_;
+    std::atomic<bool> stopped_;
 
-    // producer-consumer helpers
-    boost::mutex mutex_;
-    boost::condition not_full_;
-    boost::condition not_empty_;
-    buffer_type buffer_;
-    size_t unread_;
+    // consumer side, owned by work()
+    size_t offset_;  // bytes of the oldest slot already converted
+    bool has_partial_;
+    char partial_[2];  // sample split between two slots
+    std::vector<int8_t> signed_;
 
-    // lookup for scaling data
-    boost::array<float, 0xff> lookup_;
+    void start_read();
 
     // async read callback
     void handle_read(const boost::system::error_code &ec,
         size_t bytes_transferred);
 
-    inline bool not_full() const
-    {
-        return unread_ < buffer_.capacity();
-    }
-
-    inline bool not_empty() const
-    {
-        return unread_ > 0 || io_service_.stopped();
-    }
+    // converts n samples of unsigned interleaved bytes
+    void convert(const char *in, void *out, int n);
 };
 
 #endif  // GNSS_SDR_RTL_TCP_SIGNAL_SOURCE_C_H
@@ -0,0 +1,71 @@
+/*!
+ * \file rx_time_overflow_counter.cc
+ * \brief GNU Radio sink that counts the overflows of a UHD source
+ *
+ * -------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2018  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *          Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------
+ */
+
+#include "rx_time_overflow_counter.h"
+#include "source_overflow_counter.h"
+#include <glog/logging.h>
+#include <gnuradio/io_signature.h>
+#include <vector>
+
+
+rx_time_overflow_counter_sptr make_rx_time_overflow_counter(size_t item_size)
+{
+    return rx_time_overflow_counter_sptr(new rx_time_overflow_counter(item_size));
+}
+
+
+rx_time_overflow_counter::rx_time_overflow_counter(size_t item_size) : gr::sync_block("rx_time_overflow_counter",
+                                                                           gr::io_signature::make(1, 1, item_size),
+                                                                           gr::io_signature::make(0, 0, 0)),
+                                                                       d_rx_time_key(pmt::mp("rx_time")),
+                                                                       d_stream_started(false),
+                                                                       d_overflows(0)
+{
+}
+
+
+int rx_time_overflow_counter::work(int noutput_items,
+    gr_vector_const_void_star& input_items __attribute__((unused)),
+    gr_vector_void_star& output_items __attribute__((unused)))
+{
+    std::vector<gr::tag_t> tags;
+    get_tags_in_range(tags, 0, nitems_read(0), nitems_read(0) + noutput_items, d_rx_time_key);
+    for (const auto& tag : tags)
+        {
+            if (!d_stream_started)
+                {
+                    d_stream_started = true;
+                    continue;
+                }
+            d_overflows++;
+            signal_source_overflows().fetch_add(1, std::memory_order_relaxed);
+            DLOG(INFO) << "Signal source overflow before sample " << tag.offset << ", " << d_overflows << " so far";
+        }
+    return noutput_items;
+}
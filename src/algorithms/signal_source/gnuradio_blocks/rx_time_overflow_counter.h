@@ -0,0 +1,71 @@
+/*!
+ * \file rx_time_overflow_counter.h
+ * \brief GNU Radio sink that counts the overflows of a UHD source
+ *
+ * gr-uhd tags the first sample of the stream with rx_time, and tags it again
+ * after every overflow. This block reads the output of the source next to
+ * the rest of the flow graph, without copying it, and counts those tags.
+ *
+ * -------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2018  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *          Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_RX_TIME_OVERFLOW_COUNTER_H_
+#define GNSS_SDR_RX_TIME_OVERFLOW_COUNTER_H_
+
+#include <gnuradio/sync_block.h>
+#include <pmt/pmt.h>
+#include <cstddef>
+#include <cstdint>
+
+
+class rx_time_overflow_counter;
+
+typedef boost::shared_ptr<rx_time_overflow_counter> rx_time_overflow_counter_sptr;
+
+/*!
+ * \brief Makes a sink of items of \p item_size bytes that adds the overflows
+ * it sees to signal_source_overflows().
+ */
+rx_time_overflow_counter_sptr make_rx_time_overflow_counter(size_t item_size);
+
+class rx_time_overflow_counter : public gr::sync_block
+{
+private:
+    friend rx_time_overflow_counter_sptr make_rx_time_overflow_counter(size_t item_size);
+    explicit rx_time_overflow_counter(size_t item_size);
+
+    pmt::pmt_t d_rx_time_key;
+    bool d_stream_started;  // the first rx_time tag marks the start of the stream
+    uint64_t d_overflows;
+
+public:
+    uint64_t overflows() const { return d_overflows; }  //!< overflows seen by this block
+
+    int work(int noutput_items,
+        gr_vector_const_void_star& input_items,
+        gr_vector_void_star& output_items);
+};
+
+#endif
@@ -0,0 +1,110 @@
+/*!
+ * \file shm_sample_source.cc
+ * \brief Reads the samples that another process on the same host writes into
+ * a ring in POSIX shared memory.
+ *
+ * -------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2019  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *          Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------
+ */
+
+#include "shm_sample_source.h"
+#include "source_overflow_counter.h"
+#include <glog/logging.h>
+#include <gnuradio/io_signature.h>
+#include <pmt/pmt.h>
+#include <chrono>
+#include <stdexcept>
+#include <thread>
+
+
+shm_sample_source_sptr make_shm_sample_source(size_t item_size, const std::string& name)
+{
+    return shm_sample_source_sptr(new shm_sample_source(item_size, name));
+}
+
+
+shm_sample_source::shm_sample_source(size_t item_size,
+    const std::string& name) : gr::sync_block("shm_sample_source",
+                                   gr::io_signature::make(0, 0, 0),
+                                   gr::io_signature::make(1, 1, item_size)),
+                               d_name(name),
+                               d_tag_next(true),
+                               d_overruns(0),
+                               d_lost_items(0)
+{
+    d_ring = Shm_Sample_Ring::attach(name);
+    if (d_ring->item_size() != item_size)
+        {
+            throw std::runtime_error("shm_sample_source: the items of " + name + " have " + std::to_string(d_ring->item_size()) + " bytes, not " + std::to_string(item_size));
+        }
+    LOG(INFO) << "Attached to the shared memory ring " << name << " of " << d_ring->capacity() << " items";
+}
+
+
+shm_sample_source::~shm_sample_source() = default;
+
+
+bool shm_sample_source::stop()
+{
+    if (d_overruns > 0)
+        {
+            LOG(WARNING) << d_overruns << " overruns of the shared memory ring " << d_name << ", " << d_lost_items << " samples lost";
+        }
+    return true;
+}
+
+
+int shm_sample_source::work(int noutput_items,
+    gr_vector_const_void_star& input_items __attribute__((unused)),
+    gr_vector_void_star& output_items)
+{
+    uint64_t first_index = 0;
+    uint64_t lost = 0;
+    // the producer closes the ring after its last write
+    bool closed = d_ring->closed();
+    size_t produced = d_ring->read(output_items[0], static_cast<size_t>(noutput_items), first_index, lost);
+    if (lost > 0)
+        {
+            // the producer overwrote samples not read yet: the stream resumes later
+            d_overruns++;
+            d_lost_items += lost;
+            signal_source_overflows().fetch_add(1, std::memory_order_relaxed);
+            d_tag_next = true;
+        }
+    if (produced == 0)
+        {
+            if (closed)
+                {
+                    return WORK_DONE;
+                }
+            std::this_thread::sleep_for(std::chrono::microseconds(100));
+            return 0;
+        }
+    if (d_tag_next)
+        {
+            add_item_tag(0, nitems_written(0), pmt::mp("sample_index"), pmt::from_uint64(first_index));
+            d_tag_next = false;
+        }
+    return static_cast<int>(produced);
+}
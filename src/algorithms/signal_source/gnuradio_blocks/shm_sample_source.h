@@ -0,0 +1,82 @@
+/*!
+ * \file shm_sample_source.h
+ * \brief Reads the samples that another process on the same host writes into
+ * a ring in POSIX shared memory.
+ *
+ * -------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2019  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *          Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_SHM_SAMPLE_SOURCE_H_
+#define GNSS_SDR_SHM_SAMPLE_SOURCE_H_
+
+#include "shm_sample_ring.h"
+#include <gnuradio/sync_block.h>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+
+class shm_sample_source;
+
+typedef boost::shared_ptr<shm_sample_source> shm_sample_source_sptr;
+
+/*!
+ * \brief Makes a source of items of \p item_size bytes read from the shared
+ * memory ring \p name. Throws std::runtime_error if the ring does not exist
+ * or holds items of another size.
+ */
+shm_sample_source_sptr make_shm_sample_source(size_t item_size, const std::string& name);
+
+/*!
+ * \brief The items are copied from the shared ring straight into the output
+ * buffer. The stream index of the first output item, and of the first item
+ * after each overrun, is added as a "sample_index" tag, and every overrun
+ * counts as a signal source overflow. The block is done when the producer
+ * closes the ring and all its items have been read.
+ */
+class shm_sample_source : public gr::sync_block
+{
+public:
+    ~shm_sample_source();
+
+    bool stop() override;
+
+    int work(int noutput_items,
+        gr_vector_const_void_star& input_items,
+        gr_vector_void_star& output_items);
+
+private:
+    friend shm_sample_source_sptr make_shm_sample_source(size_t item_size, const std::string& name);
+    shm_sample_source(size_t item_size, const std::string& name);
+
+    std::string d_name;
+    std::unique_ptr<Shm_Sample_Ring> d_ring;
+    bool d_tag_next;  // the next output item starts the stream or follows an overrun
+    uint64_t d_overruns;
+    uint64_t d_lost_items;
+};
+
+#endif
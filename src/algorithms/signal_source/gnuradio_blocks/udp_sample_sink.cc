@@ -0,0 +1,162 @@
+/*!
+ * \file udp_sample_sink.cc
+ * \brief Sends a stream of samples over UDP, with the index of the first
+ * sample of each datagram, from the source node of a distributed receiver
+ * to its channels nodes.
+ *
+ * -------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2019  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *          Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------
+ */
+
+#include "udp_sample_sink.h"
+#include "monitor_le_encoding.h"
+#include <glog/logging.h>
+#include <gnuradio/io_signature.h>
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <cstring>
+
+
+// Datagrams sent by a single sendmmsg() call
+const int SENDMMSG_BATCH = 64;
+
+
+udp_sample_sink_sptr make_udp_sample_sink(size_t item_size, const std::string& address, uint16_t port, size_t datagram_bytes)
+{
+    return udp_sample_sink_sptr(new udp_sample_sink(item_size, address, port, datagram_bytes));
+}
+
+
+udp_sample_sink::udp_sample_sink(size_t item_size,
+    const std::string& address,
+    uint16_t port,
+    size_t datagram_bytes) : gr::sync_block("udp_sample_sink",
+                                 gr::io_signature::make(1, 1, item_size),
+                                 gr::io_signature::make(0, 0, 0)),
+                             d_socket{d_io_service}
+{
+    d_item_size = item_size;
+    d_items_per_datagram = static_cast<int>(std::max((std::max(datagram_bytes, UDP_SAMPLE_HEADER_SIZE) - UDP_SAMPLE_HEADER_SIZE) / item_size, static_cast<size_t>(1)));
+    d_send_errors = 0;
+    // only whole datagrams are sent
+    set_output_multiple(d_items_per_datagram);
+
+    boost::system::error_code error;
+    boost::asio::ip::address ip = boost::asio::ip::address::from_string(address, error);
+    if (error or !ip.is_v4())
+        {
+            LOG(WARNING) << "Invalid IPv4 address of the channels nodes " << address;
+        }
+    d_endpoint = boost::asio::ip::udp::endpoint(ip, port);
+    d_socket.open(boost::asio::ip::udp::v4(), error);
+    if (error)
+        {
+            LOG(WARNING) << "Cannot open the UDP socket to the channels nodes: " << error.message();
+        }
+    else if (ip.is_multicast())
+        {
+            d_socket.set_option(boost::asio::ip::multicast::hops(1), error);
+        }
+    d_headers.resize(SENDMMSG_BATCH * UDP_SAMPLE_HEADER_SIZE);
+#ifdef __linux__
+    d_messages.resize(SENDMMSG_BATCH);
+    d_iovecs.resize(2 * SENDMMSG_BATCH);
+#endif
+}
+
+
+udp_sample_sink::~udp_sample_sink()
+{
+    if (d_send_errors > 0)
+        {
+            LOG(WARNING) << d_send_errors << " sample datagrams could not be sent";
+        }
+}
+
+
+int udp_sample_sink::work(int noutput_items,
+    gr_vector_const_void_star& input_items,
+    gr_vector_void_star& output_items __attribute__((unused)))
+{
+    const auto* in = reinterpret_cast<const uint8_t*>(input_items[0]);
+    const int n_datagrams = noutput_items / d_items_per_datagram;
+    const size_t payload_bytes = d_items_per_datagram * d_item_size;
+    for (int first = 0; first < n_datagrams; first += SENDMMSG_BATCH)
+        {
+            const int batch = std::min(SENDMMSG_BATCH, n_datagrams - first);
+            for (int d = 0; d < batch; d++)
+                {
+                    size_t offset = d * UDP_SAMPLE_HEADER_SIZE;
+                    put_le(d_headers.data(), offset, UDP_SAMPLE_MAGIC);
+                    put_le(d_headers.data(), offset, UDP_SAMPLE_VERSION);
+                    put_le(d_headers.data(), offset, static_cast<uint16_t>(d_item_size));
+                    put_le(d_headers.data(), offset, nitems_read(0) + static_cast<uint64_t>(first + d) * d_items_per_datagram);
+                }
+#ifdef __linux__
+            // the samples are sent from the input buffer, after a header of their own
+            for (int d = 0; d < batch; d++)
+                {
+                    d_iovecs[2 * d].iov_base = d_headers.data() + d * UDP_SAMPLE_HEADER_SIZE;
+                    d_iovecs[2 * d].iov_len = UDP_SAMPLE_HEADER_SIZE;
+                    d_iovecs[2 * d + 1].iov_base = const_cast<uint8_t*>(in + (first + d) * payload_bytes);
+                    d_iovecs[2 * d + 1].iov_len = payload_bytes;
+                    std::memset(&d_messages[d], 0, sizeof(struct mmsghdr));
+                    d_messages[d].msg_hdr.msg_name = d_endpoint.data();
+                    d_messages[d].msg_hdr.msg_namelen = d_endpoint.size();
+                    d_messages[d].msg_hdr.msg_iov = &d_iovecs[2 * d];
+                    d_messages[d].msg_hdr.msg_iovlen = 2;
+                }
+            int sent = 0;
+            while (sent < batch)
+                {
+                    int result = sendmmsg(d_socket.native_handle(), d_messages.data() + sent, static_cast<unsigned int>(batch - sent), 0);
+                    if (result < 0)
+                        {
+                            if (errno == EINTR)
+                                {
+                                    continue;
+                                }
+                            d_send_errors += batch - sent;
+                            break;
+                        }
+                    sent += result;
+                }
+#else
+            for (int d = 0; d < batch; d++)
+                {
+                    std::array<boost::asio::const_buffer, 2> buffers = {
+                        boost::asio::buffer(d_headers.data() + d * UDP_SAMPLE_HEADER_SIZE, UDP_SAMPLE_HEADER_SIZE),
+                        boost::asio::buffer(in + (first + d) * payload_bytes, payload_bytes)};
+                    boost::system::error_code error;
+                    d_socket.send_to(buffers, d_endpoint, 0, error);
+                    if (error)
+                        {
+                            d_send_errors++;
+                        }
+                }
+#endif
+        }
+    return n_datagrams * d_items_per_datagram;
+}
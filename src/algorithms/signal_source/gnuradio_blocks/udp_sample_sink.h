@@ -0,0 +1,94 @@
+/*!
+ * \file udp_sample_sink.h
+ * \brief Sends a stream of samples over UDP, with the index of the first
+ * sample of each datagram, from the source node of a distributed receiver
+ * to its channels nodes.
+ *
+ * -------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2019  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *          Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_UDP_SAMPLE_SINK_H_
+#define GNSS_SDR_UDP_SAMPLE_SINK_H_
+
+#include <boost/asio.hpp>
+#include <gnuradio/sync_block.h>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+#ifdef __linux__
+#include <sys/socket.h>
+#endif
+
+/*!
+ * Wire format, little-endian: every datagram starts with the magic number
+ * UDP_SAMPLE_MAGIC (uint32), UDP_SAMPLE_VERSION (uint16), the size of the
+ * items (uint16) and the index of its first item in the stream (uint64),
+ * followed by the items as they are in memory. The index lets the receivers
+ * fill the lost datagrams with zeros, so that the sample counters of all the
+ * nodes stay aligned.
+ */
+const uint32_t UDP_SAMPLE_MAGIC = 0x504D5347;  // "GSMP" in little-endian order
+const uint16_t UDP_SAMPLE_VERSION = 1;
+const size_t UDP_SAMPLE_HEADER_SIZE = 16;
+
+class udp_sample_sink;
+
+typedef boost::shared_ptr<udp_sample_sink> udp_sample_sink_sptr;
+
+/*!
+ * \brief Makes a sink of items of \p item_size bytes that sends them to
+ * \p address (unicast or multicast) and \p port, in datagrams of at most
+ * \p datagram_bytes bytes.
+ */
+udp_sample_sink_sptr make_udp_sample_sink(size_t item_size, const std::string& address, uint16_t port, size_t datagram_bytes);
+
+class udp_sample_sink : public gr::sync_block
+{
+public:
+    ~udp_sample_sink();
+
+    int work(int noutput_items,
+        gr_vector_const_void_star& input_items,
+        gr_vector_void_star& output_items);
+
+private:
+    friend udp_sample_sink_sptr make_udp_sample_sink(size_t item_size, const std::string& address, uint16_t port, size_t datagram_bytes);
+    udp_sample_sink(size_t item_size, const std::string& address, uint16_t port, size_t datagram_bytes);
+
+    size_t d_item_size;
+    int d_items_per_datagram;
+    boost::asio::io_service d_io_service;
+    boost::asio::ip::udp::socket d_socket;
+    boost::asio::ip::udp::endpoint d_endpoint;
+    std::vector<uint8_t> d_headers;  // one header per datagram of a batch
+    uint64_t d_send_errors;
+#ifdef __linux__
+    std::vector<struct mmsghdr> d_messages;
+    std::vector<struct iovec> d_iovecs;
+#endif
+};
+
+#endif
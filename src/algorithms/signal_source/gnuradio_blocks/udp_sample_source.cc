@@ -0,0 +1,309 @@
+/*!
+ * \file udp_sample_source.cc
+ * \brief Receives, in a channels node of a distributed receiver, the stream
+ * of samples sent by its source node.
+ *
+ * -------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2019  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *          Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------
+ */
+
+#include "udp_sample_source.h"
+#include "monitor_le_encoding.h"
+#include "source_overflow_counter.h"
+#include "udp_sample_sink.h"
+#include <glog/logging.h>
+#include <gnuradio/io_signature.h>
+#include <pmt/pmt.h>
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+
+// Capacity of the ring of received datagrams
+const size_t SAMPLE_RING_BYTES = 67108864;
+
+// Datagrams read by a single recvmmsg() call
+const uint32_t SAMPLE_RECVMMSG_BATCH = 64;
+
+
+udp_sample_source_sptr make_udp_sample_source(size_t item_size,
+    const std::string& address,
+    uint16_t port,
+    size_t datagram_bytes,
+    int socket_rcvbuf_bytes)
+{
+    return udp_sample_source_sptr(new udp_sample_source(item_size, address, port, datagram_bytes, socket_rcvbuf_bytes));
+}
+
+
+udp_sample_source::udp_sample_source(size_t item_size,
+    const std::string& address,
+    uint16_t port,
+    size_t datagram_bytes,
+    int socket_rcvbuf_bytes) : gr::sync_block("udp_sample_source",
+                                   gr::io_signature::make(0, 0, 0),
+                                   gr::io_signature::make(1, 1, item_size))
+{
+    d_item_size = item_size;
+    d_address = address;
+    d_port = port;
+    d_socket_rcvbuf_bytes = socket_rcvbuf_bytes;
+    d_socket = -1;
+    d_stop = false;
+    d_started = false;
+    d_next_index = 0;
+    d_gaps = 0;
+    d_zero_samples = 0;
+    d_late_datagrams = 0;
+    size_t slot_bytes = std::max(datagram_bytes, UDP_SAMPLE_HEADER_SIZE + item_size);
+    d_ring = std::unique_ptr<Udp_Packet_Ring>(new Udp_Packet_Ring(static_cast<uint32_t>(std::max(SAMPLE_RING_BYTES / slot_bytes, static_cast<size_t>(SAMPLE_RECVMMSG_BATCH))), slot_bytes));
+}
+
+
+udp_sample_source::~udp_sample_source()
+{
+    if (d_socket >= 0)
+        {
+            close(d_socket);
+        }
+}
+
+
+bool udp_sample_source::open_socket()
+{
+    d_socket = socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+    if (d_socket == -1)
+        {
+            std::cout << "Error opening UDP socket" << std::endl;
+            return false;
+        }
+    int enable = 1;
+    // several channels nodes can run on the same host
+    setsockopt(d_socket, SOL_SOCKET, SO_REUSEADDR, &enable, sizeof(enable));
+
+    if (d_socket_rcvbuf_bytes > 0)
+        {
+            int requested = d_socket_rcvbuf_bytes;
+            int granted = 0;
+            socklen_t length = sizeof(granted);
+            setsockopt(d_socket, SOL_SOCKET, SO_RCVBUF, &requested, sizeof(requested));
+            getsockopt(d_socket, SOL_SOCKET, SO_RCVBUF, &granted, &length);
+            if (granted < requested)
+                {
+                    std::cout << "UDP socket receive buffer limited to " << granted << " bytes, consider raising net.core.rmem_max" << std::endl;
+                }
+        }
+
+    // A timeout lets the capture thread check regularly whether it has to stop
+    struct timeval timeout;
+    timeout.tv_sec = 0;
+    timeout.tv_usec = 100000;
+    setsockopt(d_socket, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+
+    struct sockaddr_in local;
+    std::memset(&local, 0, sizeof(local));
+    local.sin_family = AF_INET;
+    local.sin_port = htons(d_port);
+    local.sin_addr.s_addr = htonl(INADDR_ANY);
+    if (bind(d_socket, reinterpret_cast<struct sockaddr*>(&local), sizeof(local)) == -1)
+        {
+            std::cout << "Error binding UDP socket to port " << d_port << std::endl;
+            return false;
+        }
+
+    struct in_addr group;
+    if ((inet_aton(d_address.c_str(), &group) != 0) and IN_MULTICAST(ntohl(group.s_addr)))
+        {
+            struct ip_mreq membership;
+            membership.imr_multiaddr = group;
+            membership.imr_interface.s_addr = htonl(INADDR_ANY);
+            if (setsockopt(d_socket, IPPROTO_IP, IP_ADD_MEMBERSHIP, &membership, sizeof(membership)) == -1)
+                {
+                    std::cout << "Unable to join the multicast group " << d_address << std::endl;
+                    return false;
+                }
+        }
+    return true;
+}
+
+
+bool udp_sample_source::start()
+{
+    if (!open_socket())
+        {
+            return false;
+        }
+    d_stop = false;
+    d_thread = std::thread(&udp_sample_source::capture_thread, this);
+    return true;
+}
+
+
+bool udp_sample_source::stop()
+{
+    d_stop = true;
+    if (d_thread.joinable())
+        {
+            d_thread.join();
+        }
+    if (d_socket >= 0)
+        {
+            close(d_socket);
+            d_socket = -1;
+        }
+    if (d_gaps > 0 or d_late_datagrams > 0)
+        {
+            LOG(WARNING) << d_gaps << " gaps in the sample stream filled with " << d_zero_samples << " zeros, " << d_late_datagrams << " late datagrams dropped";
+        }
+    return true;
+}
+
+
+void udp_sample_source::capture_thread()
+{
+    Udp_Packet_Ring& ring = *d_ring;
+    std::array<uint32_t, SAMPLE_RECVMMSG_BATCH> lengths{};
+#if defined(__linux__)
+    std::array<struct mmsghdr, SAMPLE_RECVMMSG_BATCH> messages{};
+    std::array<struct iovec, SAMPLE_RECVMMSG_BATCH> iovecs{};
+#endif
+    while (!d_stop.load(std::memory_order_relaxed))
+        {
+            uint32_t batch = std::min(ring.writable(), SAMPLE_RECVMMSG_BATCH);
+            if (batch == 0)
+                {
+                    // The block is late: the datagrams wait in the socket receive buffer
+                    std::this_thread::sleep_for(std::chrono::microseconds(100));
+                    continue;
+                }
+            int received;
+#if defined(__linux__)
+            for (uint32_t k = 0; k < batch; k++)
+                {
+                    iovecs[k].iov_base = ring.free_slot(k);
+                    iovecs[k].iov_len = ring.slot_bytes();
+                    std::memset(&messages[k], 0, sizeof(struct mmsghdr));
+                    messages[k].msg_hdr.msg_iov = &iovecs[k];
+                    messages[k].msg_hdr.msg_iovlen = 1;
+                }
+            received = recvmmsg(d_socket, messages.data(), batch, MSG_WAITFORONE, nullptr);
+            for (int k = 0; k < received; k++)
+                {
+                    lengths[k] = messages[k].msg_len;
+                }
+#else
+            ssize_t bytes = recv(d_socket, ring.free_slot(0), ring.slot_bytes(), 0);
+            received = bytes > 0 ? 1 : 0;
+            lengths[0] = static_cast<uint32_t>(std::max(bytes, static_cast<ssize_t>(0)));
+#endif
+            if (received > 0)
+                {
+                    ring.publish(lengths.data(), static_cast<uint32_t>(received));
+                }
+        }
+}
+
+
+int udp_sample_source::work(int noutput_items,
+    gr_vector_const_void_star& input_items __attribute__((unused)),
+    gr_vector_void_star& output_items)
+{
+    auto* out = reinterpret_cast<uint8_t*>(output_items[0]);
+    int produced = 0;
+    while ((produced < noutput_items) and (d_ring->readable() > 0))
+        {
+            size_t bytes;
+            const auto* datagram = reinterpret_cast<const uint8_t*>(d_ring->front(bytes));
+            size_t offset = 0;
+            uint32_t magic = 0;
+            uint16_t version = 0;
+            uint16_t item_size = 0;
+            uint64_t index = 0;
+            if (bytes >= UDP_SAMPLE_HEADER_SIZE)
+                {
+                    get_le(datagram, offset, magic);
+                    get_le(datagram, offset, version);
+                    get_le(datagram, offset, item_size);
+                    get_le(datagram, offset, index);
+                }
+            if ((magic != UDP_SAMPLE_MAGIC) or (version != UDP_SAMPLE_VERSION) or (item_size != d_item_size))
+                {
+                    LOG_FIRST_N(WARNING, 1) << "Datagram of another stream received on port " << d_port;
+                    d_ring->pop();
+                    continue;
+                }
+            const uint64_t items = (bytes - UDP_SAMPLE_HEADER_SIZE) / d_item_size;
+            if (!d_started)
+                {
+                    d_started = true;
+                    d_next_index = index;
+                    add_item_tag(0, nitems_written(0), pmt::mp("sample_index"), pmt::from_uint64(index));
+                    LOG(INFO) << "First sample received: " << index;
+                }
+            if (index + items <= d_next_index)
+                {
+                    // its samples have already been replaced by zeros
+                    d_late_datagrams++;
+                    d_ring->pop();
+                    continue;
+                }
+            if (index > d_next_index)
+                {
+                    // lost datagrams: the same number of zeros keeps the stream aligned
+                    uint64_t zeros = std::min(index - d_next_index, static_cast<uint64_t>(noutput_items - produced));
+                    if (zeros == index - d_next_index)
+                        {
+                            // counted once, when the gap is closed
+                            d_gaps++;
+                            signal_source_overflows().fetch_add(1, std::memory_order_relaxed);
+                        }
+                    std::memset(out + produced * d_item_size, 0, zeros * d_item_size);
+                    produced += static_cast<int>(zeros);
+                    d_next_index += zeros;
+                    d_zero_samples += zeros;
+                    continue;
+                }
+            const uint64_t first = d_next_index - index;
+            const uint64_t count = std::min(items - first, static_cast<uint64_t>(noutput_items - produced));
+            std::memcpy(out + produced * d_item_size, datagram + UDP_SAMPLE_HEADER_SIZE + first * d_item_size, count * d_item_size);
+            produced += static_cast<int>(count);
+            d_next_index += count;
+            if (first + count == items)
+                {
+                    d_ring->pop();
+                }
+        }
+    if (produced == 0)
+        {
+            // nothing received yet: do not spin
+            std::this_thread::sleep_for(std::chrono::microseconds(100));
+        }
+    return produced;
+}
@@ -0,0 +1,110 @@
+/*!
+ * \file udp_sample_source.h
+ * \brief Receives, in a channels node of a distributed receiver, the stream
+ * of samples sent by its source node.
+ *
+ * -------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2019  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *          Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_UDP_SAMPLE_SOURCE_H_
+#define GNSS_SDR_UDP_SAMPLE_SOURCE_H_
+
+#include "udp_packet_ring.h"
+#include <gnuradio/sync_block.h>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <thread>
+
+
+class udp_sample_source;
+
+typedef boost::shared_ptr<udp_sample_source> udp_sample_source_sptr;
+
+/*!
+ * \brief Makes a source of items of \p item_size bytes received on \p port,
+ * sent by a udp_sample_sink. If \p address is a multicast group, the source
+ * joins it.
+ */
+udp_sample_source_sptr make_udp_sample_source(size_t item_size,
+    const std::string& address,
+    uint16_t port,
+    size_t datagram_bytes,
+    int socket_rcvbuf_bytes);
+
+/*!
+ * \brief The samples of the lost datagrams are replaced by zeros and the
+ * late datagrams are dropped, so that the output item n is always the
+ * sample n of the stream of the source node, counted from the first sample
+ * received. The index of that sample is added as a "sample_index" tag to
+ * the first output item, and every gap counts as a signal source overflow.
+ */
+class udp_sample_source : public gr::sync_block
+{
+public:
+    ~udp_sample_source();
+
+    bool start() override;
+    bool stop() override;
+
+    int work(int noutput_items,
+        gr_vector_const_void_star& input_items,
+        gr_vector_void_star& output_items);
+
+private:
+    friend udp_sample_source_sptr make_udp_sample_source(size_t item_size,
+        const std::string& address,
+        uint16_t port,
+        size_t datagram_bytes,
+        int socket_rcvbuf_bytes);
+
+    udp_sample_source(size_t item_size,
+        const std::string& address,
+        uint16_t port,
+        size_t datagram_bytes,
+        int socket_rcvbuf_bytes);
+
+    bool open_socket();
+    void capture_thread();
+
+    size_t d_item_size;
+    std::string d_address;
+    uint16_t d_port;
+    int d_socket_rcvbuf_bytes;
+    int d_socket;
+    std::unique_ptr<Udp_Packet_Ring> d_ring;
+    std::thread d_thread;
+    std::atomic<bool> d_stop;
+
+    bool d_started;
+    uint64_t d_next_index;  // index in the stream of the source node of the next output item
+    uint64_t d_gaps;
+    uint64_t d_zero_samples;
+    uint64_t d_late_datagrams;
+};
+
+#endif
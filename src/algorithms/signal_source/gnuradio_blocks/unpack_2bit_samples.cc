@@ -31,6 +31,7 @@
 
 #include "unpack_2bit_samples.h"
 #include <gnuradio/io_signature.h>
+#include <volk_gnsssdr/volk_gnsssdr.h>
 
 struct byte_2bit_struct
 {
@@ -41,6 +42,10 @@ struct byte_2bit_struct
 };
 
 
+// Value of each 2-bit code: 2 * x + 1, x being its two's complement value
+const int8_t two_bit_lut[4] = {1, 3, -3, -1};
+
+
 union byte_and_samples
 {
     int8_t byte;
@@ -71,6 +76,16 @@ bool systemBytesAreBigEndian()
 }
 
 
+// Position of the sample_0 member of byte_2bit_struct in a byte, in 2-bit
+// fields from the least significant bits. It is implementation defined.
+unsigned int firstSampleField()
+{
+    byte_and_samples b{};
+    b.samples.sample_0 = 1;
+    return (b.byte & 3) ? 0 : 3;
+}
+
+
 void swapEndianness(int8_t const *in, std::vector<int8_t> &out, size_t item_size, unsigned int ninput_items)
 {
     unsigned int i;
@@ -128,6 +143,23 @@ unpack_2bit_samples::unpack_2bit_samples(bool big_endian_bytes,
     bool big_endian_bytes_system = systemBytesAreBigEndian();
 
     swap_endian_bytes_ = (big_endian_bytes_system != big_endian_bytes_);
+
+    // The samples in a byte are either in big endian or in little endian
+    // order, and their pairs may be swapped (reverse interleaving)
+    std::array<unsigned int, 4> samples{};
+    if (!reverse_interleaving_)
+        {
+            samples = swap_endian_bytes_ ? std::array<unsigned int, 4>{3, 2, 1, 0} : std::array<unsigned int, 4>{0, 1, 2, 3};
+        }
+    else
+        {
+            samples = swap_endian_bytes_ ? std::array<unsigned int, 4>{2, 3, 0, 1} : std::array<unsigned int, 4>{1, 0, 3, 2};
+        }
+    unsigned int first_field = firstSampleField();
+    for (unsigned int k = 0; k < 4; k++)
+        {
+            sample_order_[k] = static_cast<uint8_t>(first_field == 0 ? samples[k] : 3 - samples[k]);
+        }
 }
 
 
@@ -154,71 +186,8 @@ int unpack_2bit_samples::work(int noutput_items,
         }
 
     // Here the in pointer can be interpreted as a stream of bytes to be
-    // converted. But we now have two possibilities:
-    // 1) The samples in a byte are in big endian order
-    // 2) The samples in a byte are in little endian order
-
-    byte_and_samples raw_byte{};
-    int n = 0;
-
-    if (!reverse_interleaving_)
-        {
-            if (swap_endian_bytes_)
-                {
-                    for (unsigned int i = 0; i < ninput_bytes; ++i)
-                        {
-                            // Read packed input sample (1 byte = 4 samples)
-                            raw_byte.byte = in[i];
-
-                            out[n++] = static_cast<int8_t>(2 * raw_byte.samples.sample_3 + 1);
-                            out[n++] = static_cast<int8_t>(2 * raw_byte.samples.sample_2 + 1);
-                            out[n++] = static_cast<int8_t>(2 * raw_byte.samples.sample_1 + 1);
-                            out[n++] = static_cast<int8_t>(2 * raw_byte.samples.sample_0 + 1);
-                        }
-                }
-            else
-                {
-                    for (unsigned int i = 0; i < ninput_bytes; ++i)
-                        {
-                            // Read packed input sample (1 byte = 4 samples)
-                            raw_byte.byte = in[i];
-
-                            out[n++] = static_cast<int8_t>(2 * raw_byte.samples.sample_0 + 1);
-                            out[n++] = static_cast<int8_t>(2 * raw_byte.samples.sample_1 + 1);
-                            out[n++] = static_cast<int8_t>(2 * raw_byte.samples.sample_2 + 1);
-                            out[n++] = static_cast<int8_t>(2 * raw_byte.samples.sample_3 + 1);
-                        }
-                }
-        }
-    else
-        {
-            if (swap_endian_bytes_)
-                {
-                    for (unsigned int i = 0; i < ninput_bytes; ++i)
-                        {
-                            // Read packed input sample (1 byte = 4 samples)
-                            raw_byte.byte = in[i];
-
-                            out[n++] = static_cast<int8_t>(2 * raw_byte.samples.sample_2 + 1);
-                            out[n++] = static_cast<int8_t>(2 * raw_byte.samples.sample_3 + 1);
-                            out[n++] = static_cast<int8_t>(2 * raw_byte.samples.sample_0 + 1);
-                            out[n++] = static_cast<int8_t>(2 * raw_byte.samples.sample_1 + 1);
-                        }
-                }
-            else
-                {
-                    for (unsigned int i = 0; i < ninput_bytes; ++i)
-                        {
-                            // Read packed input sample (1 byte = 4 samples)
-                            raw_byte.byte = in[i];
-
-                            out[n++] = static_cast<int8_t>(2 * raw_byte.samples.sample_1 + 1);
-                            out[n++] = static_cast<int8_t>(2 * raw_byte.samples.sample_0 + 1);
-                            out[n++] = static_cast<int8_t>(2 * raw_byte.samples.sample_3 + 1);
-                            out[n++] = static_cast<int8_t>(2 * raw_byte.samples.sample_2 + 1);
-                        }
-                }
-        }
+    // converted, in the sample order worked out in the constructor.
+    volk_gnsssdr_8u_unpack_2bit_8i(out, reinterpret_cast<const uint8_t *>(in), two_bit_lut, sample_order_.data(), ninput_bytes);
 
     return noutput_items;
 }
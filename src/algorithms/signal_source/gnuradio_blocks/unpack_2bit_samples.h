@@ -69,6 +69,7 @@
 #define GNSS_SDR_UNPACK_2BIT_SAMPLES_H
 
 #include <gnuradio/sync_interpolator.h>
+#include <array>
 #include <cstdint>
 
 class unpack_2bit_samples;
@@ -99,6 +100,7 @@ private:
     bool swap_endian_items_;
     bool swap_endian_bytes_;
     bool reverse_interleaving_;
+    std::array<uint8_t, 4> sample_order_;  // 2-bit fields of a byte, in output order
     std::vector<int8_t> work_buffer_;
 
 public:
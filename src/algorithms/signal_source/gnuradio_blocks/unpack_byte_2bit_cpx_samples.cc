@@ -35,12 +35,15 @@
 
 #include "unpack_byte_2bit_cpx_samples.h"
 #include <gnuradio/io_signature.h>
+#include <volk_gnsssdr/volk_gnsssdr.h>
 #include <cstdint>
 
-struct byte_2bit_struct
-{
-    signed two_bit_sample : 2;  // <- 2 bits wide only
-};
+// Value of each 2-bit code: 2 * x + 1, x being its two's complement value
+const int8_t byte_2bit_cpx_lut[4] = {1, 3, -3, -1};
+
+// Packing order in a byte Q1[n] Q0[n] I1[n] I0[n] Q1[n+1] Q0[n+1] I1[n+1] I0[n+1],
+// unpacked with I/Q swap as I[n] Q[n] I[n+1] Q[n+1]
+const uint8_t byte_2bit_cpx_order[4] = {2, 3, 0, 1};
 
 
 unpack_byte_2bit_cpx_samples_sptr make_unpack_byte_2bit_cpx_samples()
@@ -64,47 +67,10 @@ int unpack_byte_2bit_cpx_samples::work(int noutput_items,
     gr_vector_const_void_star &input_items,
     gr_vector_void_star &output_items)
 {
-    const auto *in = reinterpret_cast<const int8_t *>(input_items[0]);
+    const auto *in = reinterpret_cast<const uint8_t *>(input_items[0]);
     auto *out = reinterpret_cast<int16_t *>(output_items[0]);
 
-    byte_2bit_struct sample{};
-    int n = 0;
-    for (int i = 0; i < noutput_items / 4; i++)
-        {
-            // Read packed input sample (1 byte = 2 complex samples)
-            //*     Packing Order
-            //*     Most Significant Nibble  - Sample n
-            //*     Least Significant Nibble - Sample n+1
-            //*     Packing order in Nibble Q1 Q0 I1 I0
-            //normal
-            //  int8_t c = in[i];
-            //  //Q[n]
-            //  sample.two_bit_sample = (c>>6) & 3;
-            //  out[n++] = (2*(int16_t)sample.two_bit_sample+1);
-            //  //I[n]
-            //  sample.two_bit_sample = (c>>4) & 3;
-            //  out[n++] = (2*(int16_t)sample.two_bit_sample+1);
-            //  //Q[n+1]
-            //  sample.two_bit_sample = (c>>2) & 3;
-            //  out[n++] = (2*(int16_t)sample.two_bit_sample+1);
-            //  //I[n+1]
-            //  sample.two_bit_sample = c & 3;
-            //  out[n++] = (2*(int16_t)sample.two_bit_sample+1);
-
-            //I/Q swap
-            int8_t c = in[i];
-            //I[n]
-            sample.two_bit_sample = (c >> 4) & 3;
-            out[n++] = (2 * static_cast<int16_t>(sample.two_bit_sample) + 1);
-            //Q[n]
-            sample.two_bit_sample = (c >> 6) & 3;
-            out[n++] = (2 * static_cast<int16_t>(sample.two_bit_sample) + 1);
-            //I[n+1]
-            sample.two_bit_sample = c & 3;
-            out[n++] = (2 * static_cast<int16_t>(sample.two_bit_sample) + 1);
-            //Q[n+1]
-            sample.two_bit_sample = (c >> 2) & 3;
-            out[n++] = (2 * static_cast<int16_t>(sample.two_bit_sample) + 1);
-        }
+    // Read packed input samples (1 byte = 2 complex samples)
+    volk_gnsssdr_8u_unpack_2bit_16i(out, in, byte_2bit_cpx_lut, byte_2bit_cpx_order, noutput_items / 4);
     return noutput_items;
 }
@@ -31,11 +31,12 @@
 
 #include "unpack_byte_2bit_samples.h"
 #include <gnuradio/io_signature.h>
+#include <volk_gnsssdr/volk_gnsssdr.h>
+#include <cstdint>
 
-struct byte_2bit_struct
-{
-    signed two_bit_sample : 2;  // <- 2 bits wide only
-};
+// Two's complement value of each 2-bit code, least significant bits first
+const int8_t byte_2bit_lut[4] = {0, 1, -2, -1};
+const uint8_t byte_2bit_order[4] = {0, 1, 2, 3};
 
 
 unpack_byte_2bit_samples_sptr make_unpack_byte_2bit_samples()
@@ -59,26 +60,10 @@ int unpack_byte_2bit_samples::work(int noutput_items,
     gr_vector_const_void_star &input_items,
     gr_vector_void_star &output_items)
 {
-    const auto *in = reinterpret_cast<const signed char *>(input_items[0]);
+    const auto *in = reinterpret_cast<const uint8_t *>(input_items[0]);
     auto *out = reinterpret_cast<float *>(output_items[0]);
 
-    byte_2bit_struct sample{};
-    int n = 0;
-    for (int i = 0; i < noutput_items / 4; i++)
-        {
-            // Read packed input sample (1 byte = 4 samples)
-            signed char c = in[i];
-            sample.two_bit_sample = c & 3;
-            out[n++] = static_cast<float>(sample.two_bit_sample);
-
-            sample.two_bit_sample = (c >> 2) & 3;
-            out[n++] = static_cast<float>(sample.two_bit_sample);
-
-            sample.two_bit_sample = (c >> 4) & 3;
-            out[n++] = static_cast<float>(sample.two_bit_sample);
-
-            sample.two_bit_sample = (c >> 6) & 3;
-            out[n++] = static_cast<float>(sample.two_bit_sample);
-        }
+    // Read packed input samples (1 byte = 4 samples)
+    volk_gnsssdr_8u_unpack_2bit_32f(out, in, byte_2bit_lut, byte_2bit_order, noutput_items / 4);
     return noutput_items;
 }
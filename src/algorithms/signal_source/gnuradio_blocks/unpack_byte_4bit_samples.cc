@@ -32,6 +32,11 @@
 
 #include "unpack_byte_4bit_samples.h"
 #include <gnuradio/io_signature.h>
+#include <volk_gnsssdr/volk_gnsssdr.h>
+#include <cstdint>
+
+// Value of each 4-bit code: 2 * x + 1, x being its two's complement value
+const int8_t byte_4bit_lut[16] = {1, 3, 5, 7, 9, 11, 13, 15, -15, -13, -11, -9, -7, -5, -3, -1};
 
 unpack_byte_4bit_samples_sptr make_unpack_byte_4bit_samples()
 {
@@ -54,31 +59,10 @@ int unpack_byte_4bit_samples::work(int noutput_items,
     gr_vector_const_void_star &input_items,
     gr_vector_void_star &output_items)
 {
-    const auto *in = reinterpret_cast<const signed char *>(input_items[0]);
-    auto *out = reinterpret_cast<signed char *>(output_items[0]);
-    int n = 0;
-    unsigned char tmp_char2;
-    for (int i = 0; i < noutput_items / 2; i++)
-        {
-            tmp_char2 = in[i] & 0x0F;
-            if (tmp_char2 >= 8)
-                {
-                    out[n++] = 2 * (tmp_char2 - 16) + 1;
-                }
-            else
-                {
-                    out[n++] = 2 * tmp_char2 + 1;
-                }
-            tmp_char2 = in[i] >> 4;
-            tmp_char2 = tmp_char2 & 0x0F;
-            if (tmp_char2 >= 8)
-                {
-                    out[n++] = 2 * (tmp_char2 - 16) + 1;
-                }
-            else
-                {
-                    out[n++] = 2 * tmp_char2 + 1;
-                }
-        }
+    const auto *in = reinterpret_cast<const uint8_t *>(input_items[0]);
+    auto *out = reinterpret_cast<int8_t *>(output_items[0]);
+
+    // Read packed input samples (1 byte = 2 samples, least significant nibble first)
+    volk_gnsssdr_8u_unpack_4bit_8i(out, in, byte_4bit_lut, noutput_items / 2);
     return noutput_items;
 }
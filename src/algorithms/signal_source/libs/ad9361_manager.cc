@@ -60,6 +60,17 @@ void wr_ch_str(struct iio_channel *chn, const char *what, const char *str)
 }
 
 
+/* creates the IIO context of a device address: a host name or IP address, or a libiio URI (e.g. "usb:1.4.5") */
+struct iio_context *create_ad9361_context(const std::string &uri)
+{
+    if (uri.find(':') != std::string::npos)
+        {
+            return iio_create_context_from_uri(uri.c_str());
+        }
+    return iio_create_network_context(uri.c_str());
+}
+
+
 /* returns ad9361 phy device */
 struct iio_device *get_ad9361_phy(struct iio_context *ctx)
 {
@@ -316,7 +327,7 @@ bool config_ad9361_rx_remote(const std::string &remote_host,
     struct iio_channel *rx0_i;
     struct iio_channel *rx0_q;
 
-    ctx = iio_create_network_context(remote_host.c_str());
+    ctx = create_ad9361_context(remote_host);
     if (!ctx)
         {
             std::cout << "No context\n";
@@ -407,6 +418,44 @@ bool config_ad9361_rx_remote(const std::string &remote_host,
 }
 
 
+bool config_ad9361_rx_tracking_remote(const std::string &remote_host,
+    bool quadrature_,
+    bool rf_dc_,
+    bool bb_dc_)
+{
+    struct iio_context *ctx = create_ad9361_context(remote_host);
+    if (!ctx)
+        {
+            std::cout << "No context\n";
+            throw std::runtime_error("AD9361 IIO No context");
+        }
+    struct iio_device *ad9361_phy = get_ad9361_phy(ctx);
+    if (!ad9361_phy)
+        {
+            iio_context_destroy(ctx);
+            std::cout << "No ad9361-phy device\n";
+            throw std::runtime_error("AD9361 IIO No ad9361-phy device");
+        }
+    int ret = iio_device_attr_write_bool(ad9361_phy, "in_voltage_quadrature_tracking_en", quadrature_);
+    if (ret < 0)
+        {
+            std::cout << "Failed to set in_voltage_quadrature_tracking_en: " << ret << std::endl;
+        }
+    ret = iio_device_attr_write_bool(ad9361_phy, "in_voltage_rf_dc_offset_tracking_en", rf_dc_);
+    if (ret < 0)
+        {
+            std::cout << "Failed to set in_voltage_rf_dc_offset_tracking_en: " << ret << std::endl;
+        }
+    ret = iio_device_attr_write_bool(ad9361_phy, "in_voltage_bb_dc_offset_tracking_en", bb_dc_);
+    if (ret < 0)
+        {
+            std::cout << "Failed to set in_voltage_bb_dc_offset_tracking_en: " << ret << std::endl;
+        }
+    iio_context_destroy(ctx);
+    return true;
+}
+
+
 bool config_ad9361_lo_local(uint64_t bandwidth_,
     uint64_t sample_rate_,
     uint64_t freq_rf_tx_hz_,
@@ -561,7 +610,7 @@ bool config_ad9361_lo_remote(const std::string &remote_host,
 
     std::cout << "AD9361 Acquiring IIO REMOTE context in host " << remote_host << std::endl;
     struct iio_context *ctx;
-    ctx = iio_create_network_context(remote_host.c_str());
+    ctx = create_ad9361_context(remote_host);
     if (!ctx)
         {
             std::cout << "No context\n";
@@ -684,7 +733,7 @@ bool ad9361_disable_lo_remote(const std::string &remote_host)
 {
     std::cout << "AD9361 Acquiring IIO REMOTE context in host " << remote_host << std::endl;
     struct iio_context *ctx;
-    ctx = iio_create_network_context(remote_host.c_str());
+    ctx = create_ad9361_context(remote_host);
     if (!ctx)
         {
             std::cout << "No context\n";
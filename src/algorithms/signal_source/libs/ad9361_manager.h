@@ -71,6 +71,9 @@ void wr_ch_str(struct iio_channel *chn, const char *what, const char *str);
 /* helper function generating channel names */
 char *get_ch_name(const char *type, int id, char *tmpstr);
 
+/* creates the IIO context of a device address: a host name or IP address, or a libiio URI (e.g. "usb:1.4.5") */
+struct iio_context *create_ad9361_context(const std::string &uri);
+
 /* returns ad9361 phy device */
 struct iio_device *get_ad9361_phy(struct iio_context *ctx);
 
@@ -108,6 +111,12 @@ bool config_ad9361_rx_remote(const std::string &remote_host,
     double rf_gain_rx1_,
     double rf_gain_rx2_);
 
+/* enables or disables the quadrature, RF DC and baseband DC tracking of the RX path */
+bool config_ad9361_rx_tracking_remote(const std::string &remote_host,
+    bool quadrature_,
+    bool rf_dc_,
+    bool bb_dc_);
+
 bool config_ad9361_lo_local(uint64_t bandwidth_,
     uint64_t sample_rate_,
     uint64_t freq_rf_tx_hz_,
@@ -0,0 +1,65 @@
+/*!
+ * \file datagram_queue.h
+ * \brief Interface of the queues of received datagrams read by the UDP source.
+ *
+ * The UDP signal source block reads its datagrams in place, whatever the
+ * capture backend that queued them.
+ *
+ * -------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2018  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *          Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_DATAGRAM_QUEUE_H_
+#define GNSS_SDR_DATAGRAM_QUEUE_H_
+
+#include <cstddef>
+#include <cstdint>
+
+
+/*!
+ * \brief Consumer side of a queue of datagrams. The datagram returned by
+ * front() stays valid until pop() is called.
+ */
+class Datagram_Queue
+{
+public:
+    virtual ~Datagram_Queue() = default;
+
+    /*!
+     * \brief Number of datagrams waiting, or at least one if any.
+     */
+    virtual uint32_t readable() = 0;
+
+    /*!
+     * \brief Oldest datagram, readable() > 0. Its length is returned in \p bytes.
+     */
+    virtual const char* front(size_t& bytes) = 0;
+
+    /*!
+     * \brief Releases the oldest datagram.
+     */
+    virtual void pop() = 0;
+};
+
+#endif
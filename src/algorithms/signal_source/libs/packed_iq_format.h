@@ -0,0 +1,102 @@
+/*!
+ * \file packed_iq_format.h
+ * \brief Layout of the packed IQ files written by the signal source
+ * recorders and read by the Packed_IQ_File_Signal_Source.
+ *
+ * A file header is followed by frames of a fixed number of complex samples,
+ * each one with a small header of its own that places it in the recorded
+ * stream, so that any sample is found without reading the file.
+ *
+ * -------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2018  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *          Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_PACKED_IQ_FORMAT_H_
+#define GNSS_SDR_PACKED_IQ_FORMAT_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+
+const char PACKED_IQ_MAGIC[8] = {'G', 'S', 'D', 'R', 'P', 'K', 'I', 'Q'};
+const uint32_t PACKED_IQ_VERSION = 1;
+const uint32_t PACKED_IQ_FRAME_SYNC = 0x454D5246;        // "FRME" once stored little endian
+const uint32_t PACKED_IQ_DEFAULT_FRAME_SAMPLES = 16384;  // index interval of the recorders
+
+/*!
+ * \brief Header at the start of the file. All fields are little endian.
+ *
+ * Each component of a sample is a two's complement code \a x of \p bits bits.
+ * With 2 and 4 bits it stands for 2 \a x + 1 (the levels are symmetric around
+ * zero); with 8 bits, for \a x itself. The codes are packed from the least
+ * significant bits of each byte: in-phase before quadrature, earlier samples
+ * first.
+ */
+struct Packed_Iq_File_Header
+{
+    char magic[8];                  // PACKED_IQ_MAGIC
+    uint32_t version;               // PACKED_IQ_VERSION
+    uint32_t header_bytes;          // offset of the first frame
+    double sampling_frequency;      // [Sps]
+    double intermediate_frequency;  // [Hz], 0 for baseband samples
+    uint32_t bits;                  // per component: 2, 4 or 8
+    uint32_t frame_samples;         // complex samples per frame, a multiple of 16
+    uint64_t reserved[3];
+};
+
+/*!
+ * \brief Header of each frame, followed by the payload of frame_samples
+ * samples. Frames dropped by the recorder leave a jump in first_sample, so
+ * that the stream time of every sample is known; only the last frame may
+ * hold fewer valid samples than frame_samples.
+ */
+struct Packed_Iq_Frame_Header
+{
+    uint64_t first_sample;  // number of the first sample in the recorded stream
+    uint32_t samples;       // valid samples in the frame
+    uint32_t sync;          // PACKED_IQ_FRAME_SYNC
+};
+
+static_assert(sizeof(Packed_Iq_File_Header) == 64, "Unexpected size of Packed_Iq_File_Header");
+static_assert(sizeof(Packed_Iq_Frame_Header) == 16, "Unexpected size of Packed_Iq_Frame_Header");
+
+
+inline size_t packed_iq_frame_bytes(uint32_t bits, uint32_t frame_samples)
+{
+    return sizeof(Packed_Iq_Frame_Header) + static_cast<size_t>(frame_samples) * 2 * bits / 8;
+}
+
+
+inline bool packed_iq_header_valid(const Packed_Iq_File_Header& header)
+{
+    return std::memcmp(header.magic, PACKED_IQ_MAGIC, sizeof(PACKED_IQ_MAGIC)) == 0 and
+           header.version == PACKED_IQ_VERSION and
+           header.header_bytes >= sizeof(Packed_Iq_File_Header) and
+           (header.bits == 2 or header.bits == 4 or header.bits == 8) and
+           header.frame_samples > 0 and header.frame_samples % 16 == 0 and
+           header.sampling_frequency > 0.0;
+}
+
+#endif
@@ -0,0 +1,347 @@
+/*!
+ * \file packet_mmap_ring.cc
+ * \brief Receive ring of an AF_PACKET socket (TPACKET_V3) shared with the kernel.
+ *
+ * The kernel writes the Ethernet frames into blocks of a memory area mapped
+ * by the process, and the UDP payloads are read from there without any copy
+ * nor system call while there are frames waiting. Linux only.
+ *
+ * -------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2018  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *          Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------
+ */
+
+#include "packet_mmap_ring.h"
+#include <algorithm>
+#include <iostream>
+
+#if defined(__linux__)
+#include <arpa/inet.h>
+#include <linux/filter.h>
+#include <linux/if_ether.h>
+#include <linux/if_packet.h>
+#include <net/if.h>
+#include <poll.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <cerrno>
+#include <cstring>
+#endif
+
+
+Packet_Mmap_Ring::Packet_Mmap_Ring()
+{
+    d_fd = -1;
+    d_map = nullptr;
+    d_map_bytes = 0;
+    d_block_bytes = 0;
+    d_block_count = 0;
+    d_udp_port = 0;
+    d_block = 0;
+    d_current_block = nullptr;
+    d_frames_left = 0;
+    d_frame = nullptr;
+    d_payload = nullptr;
+    d_payload_bytes = 0;
+}
+
+
+Packet_Mmap_Ring::~Packet_Mmap_Ring()
+{
+    close();
+}
+
+
+#if defined(__linux__)
+
+bool Packet_Mmap_Ring::open(const std::string& device, uint16_t udp_port, uint32_t block_bytes, uint32_t block_count)
+{
+    d_udp_port = udp_port;
+    d_block_bytes = block_bytes;
+    d_block_count = block_count;
+
+    unsigned int ifindex = if_nametoindex(device.c_str());
+    if (ifindex == 0)
+        {
+            std::cout << "Unknown network interface " << device << std::endl;
+            return false;
+        }
+    d_fd = socket(AF_PACKET, SOCK_RAW, htons(ETH_P_IP));
+    if (d_fd == -1)
+        {
+            std::cout << "Error opening AF_PACKET socket (CAP_NET_RAW is required): " << strerror(errno) << std::endl;
+            return false;
+        }
+
+    // Only the unfragmented IPv4 UDP datagrams sent to the port reach the ring
+    // (offsets from the start of the Ethernet frame)
+    struct sock_filter code[] = {
+        BPF_STMT(BPF_LD | BPF_H | BPF_ABS, 12),
+        BPF_JUMP(BPF_JMP | BPF_JEQ | BPF_K, ETH_P_IP, 0, 8),
+        BPF_STMT(BPF_LD | BPF_B | BPF_ABS, 23),
+        BPF_JUMP(BPF_JMP | BPF_JEQ | BPF_K, IPPROTO_UDP, 0, 6),
+        BPF_STMT(BPF_LD | BPF_H | BPF_ABS, 20),
+        BPF_JUMP(BPF_JMP | BPF_JSET | BPF_K, 0x3FFF, 4, 0),
+        BPF_STMT(BPF_LDX | BPF_B | BPF_MSH, 14),
+        BPF_STMT(BPF_LD | BPF_H | BPF_IND, 16),
+        BPF_JUMP(BPF_JMP | BPF_JEQ | BPF_K, udp_port, 0, 1),
+        BPF_STMT(BPF_RET | BPF_K, 0xFFFFFFFF),
+        BPF_STMT(BPF_RET | BPF_K, 0)};
+    struct sock_fprog filter;
+    filter.len = sizeof(code) / sizeof(code[0]);
+    filter.filter = code;
+    if (setsockopt(d_fd, SOL_SOCKET, SO_ATTACH_FILTER, &filter, sizeof(filter)) == -1)
+        {
+            std::cout << "Error attaching the packet filter: " << strerror(errno) << std::endl;
+            return false;
+        }
+
+    int version = TPACKET_V3;
+    if (setsockopt(d_fd, SOL_PACKET, PACKET_VERSION, &version, sizeof(version)) == -1)
+        {
+            std::cout << "TPACKET_V3 is not supported by this kernel: " << strerror(errno) << std::endl;
+            return false;
+        }
+
+    struct tpacket_req3 req;
+    memset(&req, 0, sizeof(req));
+    req.tp_block_size = d_block_bytes;
+    req.tp_block_nr = d_block_count;
+    req.tp_frame_size = 2048;  // frames are packed in the blocks, only used for checks
+    req.tp_frame_nr = static_cast<unsigned int>(static_cast<uint64_t>(d_block_bytes) * d_block_count / req.tp_frame_size);
+    req.tp_retire_blk_tov = 10;  // ms before handing over a block not yet full
+    if (setsockopt(d_fd, SOL_PACKET, PACKET_RX_RING, &req, sizeof(req)) == -1)
+        {
+            std::cout << "Error setting up the packet receive ring: " << strerror(errno) << std::endl;
+            return false;
+        }
+
+    d_map_bytes = static_cast<size_t>(d_block_bytes) * d_block_count;
+    void* map = mmap(nullptr, d_map_bytes, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_LOCKED, d_fd, 0);
+    if (map == MAP_FAILED)
+        {
+            // locking the pages needs RLIMIT_MEMLOCK, try without
+            map = mmap(nullptr, d_map_bytes, PROT_READ | PROT_WRITE, MAP_SHARED, d_fd, 0);
+        }
+    if (map == MAP_FAILED)
+        {
+            std::cout << "Error mapping the packet receive ring: " << strerror(errno) << std::endl;
+            d_map_bytes = 0;
+            return false;
+        }
+    d_map = static_cast<char*>(map);
+
+    struct sockaddr_ll address;
+    memset(&address, 0, sizeof(address));
+    address.sll_family = AF_PACKET;
+    address.sll_protocol = htons(ETH_P_IP);
+    address.sll_ifindex = static_cast<int>(ifindex);
+    if (bind(d_fd, reinterpret_cast<struct sockaddr*>(&address), sizeof(address)) == -1)
+        {
+            std::cout << "Error binding AF_PACKET socket to " << device << ": " << strerror(errno) << std::endl;
+            return false;
+        }
+    d_block = 0;
+    d_current_block = nullptr;
+    d_payload = nullptr;
+    return true;
+}
+
+
+void Packet_Mmap_Ring::close()
+{
+    if (d_map != nullptr)
+        {
+            munmap(d_map, d_map_bytes);
+            d_map = nullptr;
+            d_map_bytes = 0;
+        }
+    if (d_fd != -1)
+        {
+            ::close(d_fd);
+            d_fd = -1;
+        }
+    d_current_block = nullptr;
+    d_payload = nullptr;
+}
+
+
+bool Packet_Mmap_Ring::wait(int timeout_ms)
+{
+    if (readable() > 0)
+        {
+            return true;
+        }
+    struct pollfd pfd;
+    pfd.fd = d_fd;
+    pfd.events = POLLIN | POLLERR;
+    pfd.revents = 0;
+    poll(&pfd, 1, timeout_ms);
+    return readable() > 0;
+}
+
+
+uint32_t Packet_Mmap_Ring::readable()
+{
+    if (d_map == nullptr)
+        {
+            return 0;
+        }
+    while (d_payload == nullptr)
+        {
+            if (d_current_block == nullptr)
+                {
+                    char* block = d_map + static_cast<size_t>(d_block) * d_block_bytes;
+                    auto* desc = reinterpret_cast<struct tpacket_block_desc*>(block);
+                    // the kernel hands the block over by setting its status last
+                    if ((__atomic_load_n(&desc->hdr.bh1.block_status, __ATOMIC_ACQUIRE) & TP_STATUS_USER) == 0)
+                        {
+                            return 0;
+                        }
+                    d_current_block = block;
+                    d_frames_left = desc->hdr.bh1.num_pkts;
+                    d_frame = block + desc->hdr.bh1.offset_to_first_pkt;
+                }
+            if (d_frames_left == 0)
+                {
+                    release_block();
+                }
+            else if (!parse_frame())
+                {
+                    next_frame();
+                }
+        }
+    return 1;
+}
+
+
+const char* Packet_Mmap_Ring::front(size_t& bytes)
+{
+    bytes = d_payload_bytes;
+    return d_payload;
+}
+
+
+void Packet_Mmap_Ring::pop()
+{
+    d_payload = nullptr;
+    next_frame();
+}
+
+
+bool Packet_Mmap_Ring::parse_frame()
+{
+    auto* header = reinterpret_cast<struct tpacket3_hdr*>(d_frame);
+    const auto* frame = reinterpret_cast<const uint8_t*>(d_frame + header->tp_mac);
+    size_t captured = header->tp_snaplen;
+    size_t offset = 14;  // Ethernet header
+    if (captured < offset + 20 + 8 || frame[12] != 0x08 || frame[13] != 0x00)
+        {
+            return false;
+        }
+    const uint8_t* ip = frame + offset;
+    size_t ip_len = (ip[0] & 0x0F) * 4;
+    if (ip[9] != IPPROTO_UDP || ip_len < 20 || captured < offset + ip_len + 8)
+        {
+            return false;
+        }
+    const uint8_t* udp = ip + ip_len;
+    if (((udp[2] << 8) | udp[3]) != d_udp_port)
+        {
+            return false;
+        }
+    size_t udp_len = (udp[4] << 8) | udp[5];
+    if (udp_len <= 8)
+        {
+            return false;
+        }
+    // never read beyond the captured bytes
+    d_payload_bytes = std::min(udp_len - 8, captured - offset - ip_len - 8);
+    d_payload = reinterpret_cast<const char*>(udp + 8);
+    return true;
+}
+
+
+void Packet_Mmap_Ring::next_frame()
+{
+    auto* header = reinterpret_cast<struct tpacket3_hdr*>(d_frame);
+    d_frames_left--;
+    if (d_frames_left > 0)
+        {
+            d_frame += header->tp_next_offset;
+        }
+    else
+        {
+            release_block();
+        }
+}
+
+
+void Packet_Mmap_Ring::release_block()
+{
+    auto* desc = reinterpret_cast<struct tpacket_block_desc*>(d_current_block);
+    __atomic_store_n(&desc->hdr.bh1.block_status, TP_STATUS_KERNEL, __ATOMIC_RELEASE);
+    d_current_block = nullptr;
+    d_block = (d_block + 1) % d_block_count;
+}
+
+#else
+
+bool Packet_Mmap_Ring::open(const std::string& device __attribute__((unused)), uint16_t udp_port __attribute__((unused)),
+    uint32_t block_bytes __attribute__((unused)), uint32_t block_count __attribute__((unused)))
+{
+    std::cout << "The packet_mmap capture backend is only available on Linux" << std::endl;
+    return false;
+}
+
+
+void Packet_Mmap_Ring::close()
+{
+}
+
+
+bool Packet_Mmap_Ring::wait(int timeout_ms __attribute__((unused)))
+{
+    return false;
+}
+
+
+uint32_t Packet_Mmap_Ring::readable()
+{
+    return 0;
+}
+
+
+const char* Packet_Mmap_Ring::front(size_t& bytes)
+{
+    bytes = 0;
+    return nullptr;
+}
+
+
+void Packet_Mmap_Ring::pop()
+{
+}
+
+#endif
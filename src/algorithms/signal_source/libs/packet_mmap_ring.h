@@ -0,0 +1,92 @@
+/*!
+ * \file packet_mmap_ring.h
+ * \brief Receive ring of an AF_PACKET socket (TPACKET_V3) shared with the kernel.
+ *
+ * The kernel writes the Ethernet frames into blocks of a memory area mapped
+ * by the process, and the UDP payloads are read from there without any copy
+ * nor system call while there are frames waiting. Linux only.
+ *
+ * -------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2018  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *          Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_PACKET_MMAP_RING_H_
+#define GNSS_SDR_PACKET_MMAP_RING_H_
+
+#include "datagram_queue.h"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+
+/*!
+ * \brief Queue of the IPv4 UDP datagrams sent to a port, read in place from
+ * the receive ring of a network interface.
+ */
+class Packet_Mmap_Ring : public Datagram_Queue
+{
+public:
+    Packet_Mmap_Ring();
+    ~Packet_Mmap_Ring();
+
+    /*!
+     * \brief Maps a ring of \p block_count blocks of \p block_bytes bytes
+     * (a multiple of the page size) receiving the datagrams sent to
+     * \p udp_port on \p device. Returns false on failure.
+     */
+    bool open(const std::string& device, uint16_t udp_port, uint32_t block_bytes, uint32_t block_count);
+
+    void close();
+
+    /*!
+     * \brief Waits up to \p timeout_ms milliseconds for the kernel to hand
+     * over a block. Returns true if there is one.
+     */
+    bool wait(int timeout_ms);
+
+    uint32_t readable() override;
+    const char* front(size_t& bytes) override;
+    void pop() override;
+
+private:
+    bool parse_frame();
+    void next_frame();
+    void release_block();
+
+    int d_fd;
+    char* d_map;
+    size_t d_map_bytes;
+    uint32_t d_block_bytes;
+    uint32_t d_block_count;
+    uint16_t d_udp_port;
+
+    uint32_t d_block;       // index of the next block to be read
+    char* d_current_block;  // block being read, nullptr if none
+    uint32_t d_frames_left;
+    char* d_frame;
+    const char* d_payload;  // datagram at the front, nullptr if not parsed yet
+    size_t d_payload_bytes;
+};
+
+#endif
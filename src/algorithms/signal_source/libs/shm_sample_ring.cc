@@ -0,0 +1,237 @@
+/*!
+ * \file shm_sample_ring.cc
+ * \brief Ring of signal samples in POSIX shared memory, written by the process
+ * that owns the radio and read by any number of receivers on the same host.
+ *
+ * -------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2019  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *          Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------
+ */
+
+#include "shm_sample_ring.h"
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <new>
+#include <stdexcept>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+
+namespace
+{
+const size_t SHM_DATA_ALIGNMENT = 4096;
+}  // namespace
+
+
+std::string Shm_Sample_Ring::object_name(const std::string& name)
+{
+    // POSIX shared memory objects are named "/something"
+    if (!name.empty() and name[0] == '/')
+        {
+            return name;
+        }
+    return "/" + name;
+}
+
+
+std::unique_ptr<Shm_Sample_Ring> Shm_Sample_Ring::create(const std::string& name, size_t item_size, uint64_t min_items, double sampling_frequency)
+{
+    std::string object = object_name(name);
+    if (item_size == 0)
+        {
+            throw std::runtime_error("Shm_Sample_Ring: null item size");
+        }
+    uint64_t capacity = 2;
+    while (capacity < min_items)
+        {
+            capacity <<= 1;
+        }
+    size_t data_offset = (sizeof(Shm_Sample_Ring_Header) + SHM_DATA_ALIGNMENT - 1) / SHM_DATA_ALIGNMENT * SHM_DATA_ALIGNMENT;
+    size_t map_bytes = data_offset + static_cast<size_t>(capacity) * item_size;
+
+    shm_unlink(object.c_str());
+    int fd = shm_open(object.c_str(), O_CREAT | O_EXCL | O_RDWR, 0644);
+    if (fd < 0)
+        {
+            throw std::runtime_error("Shm_Sample_Ring: cannot create " + object + ": " + std::strerror(errno));
+        }
+    if (ftruncate(fd, static_cast<off_t>(map_bytes)) != 0)
+        {
+            ::close(fd);
+            shm_unlink(object.c_str());
+            throw std::runtime_error("Shm_Sample_Ring: cannot allocate " + object + ": " + std::strerror(errno));
+        }
+    void* map = mmap(nullptr, map_bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    ::close(fd);  // the mapping keeps the object open
+    if (map == MAP_FAILED)
+        {
+            shm_unlink(object.c_str());
+            throw std::runtime_error("Shm_Sample_Ring: cannot map " + object + ": " + std::strerror(errno));
+        }
+
+    auto* header = new (map) Shm_Sample_Ring_Header();
+    header->version = SHM_SAMPLE_RING_VERSION;
+    header->header_bytes = static_cast<uint16_t>(sizeof(Shm_Sample_Ring_Header));
+    header->item_size = static_cast<uint32_t>(item_size);
+    header->padding = 0;
+    header->capacity = capacity;
+    header->data_offset = data_offset;
+    header->sampling_frequency = sampling_frequency;
+    header->reserved.store(0, std::memory_order_relaxed);
+    header->published.store(0, std::memory_order_relaxed);
+    header->closed.store(0, std::memory_order_relaxed);
+    // the consumers check the magic number last
+    std::atomic_thread_fence(std::memory_order_release);
+    header->magic = SHM_SAMPLE_RING_MAGIC;
+
+    return std::unique_ptr<Shm_Sample_Ring>(new Shm_Sample_Ring(object, true, map, map_bytes));
+}
+
+
+std::unique_ptr<Shm_Sample_Ring> Shm_Sample_Ring::attach(const std::string& name)
+{
+    std::string object = object_name(name);
+    int fd = shm_open(object.c_str(), O_RDONLY, 0);
+    if (fd < 0)
+        {
+            throw std::runtime_error("Shm_Sample_Ring: cannot open " + object + ": " + std::strerror(errno));
+        }
+    struct stat object_stat;
+    if ((fstat(fd, &object_stat) != 0) or (static_cast<size_t>(object_stat.st_size) < sizeof(Shm_Sample_Ring_Header)))
+        {
+            ::close(fd);
+            throw std::runtime_error("Shm_Sample_Ring: " + object + " is not a sample ring");
+        }
+    auto map_bytes = static_cast<size_t>(object_stat.st_size);
+    void* map = mmap(nullptr, map_bytes, PROT_READ, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (map == MAP_FAILED)
+        {
+            throw std::runtime_error("Shm_Sample_Ring: cannot map " + object + ": " + std::strerror(errno));
+        }
+    const auto* header = static_cast<const Shm_Sample_Ring_Header*>(map);
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if ((header->magic != SHM_SAMPLE_RING_MAGIC) or (header->version != SHM_SAMPLE_RING_VERSION) or (header->item_size == 0) or (header->capacity == 0) or ((header->capacity & (header->capacity - 1)) != 0) or (header->data_offset + header->capacity * header->item_size > map_bytes))
+        {
+            munmap(map, map_bytes);
+            throw std::runtime_error("Shm_Sample_Ring: " + object + " is not a compatible sample ring");
+        }
+    return std::unique_ptr<Shm_Sample_Ring>(new Shm_Sample_Ring(object, false, map, map_bytes));
+}
+
+
+Shm_Sample_Ring::Shm_Sample_Ring(const std::string& name, bool producer, void* map, size_t map_bytes) : d_name(name),
+                                                                                                         d_producer(producer),
+                                                                                                         d_map(map),
+                                                                                                         d_map_bytes(map_bytes)
+{
+    d_header = static_cast<Shm_Sample_Ring_Header*>(map);
+    d_data = static_cast<uint8_t*>(map) + d_header->data_offset;
+    d_mask = d_header->capacity - 1;
+    // a consumer joins the stream at its newest item
+    d_position = d_header->published.load(std::memory_order_acquire);
+}
+
+
+Shm_Sample_Ring::~Shm_Sample_Ring()
+{
+    if (d_producer)
+        {
+            close();
+            shm_unlink(d_name.c_str());
+        }
+    munmap(d_map, d_map_bytes);
+}
+
+
+void Shm_Sample_Ring::write(const void* items, size_t n_items)
+{
+    const auto* in = static_cast<const uint8_t*>(items);
+    const size_t item_size = d_header->item_size;
+    n_items = std::min(n_items, static_cast<size_t>(d_header->capacity));
+    uint64_t start = d_header->published.load(std::memory_order_relaxed);
+    // announce the items about to be overwritten before touching them
+    d_header->reserved.store(start + n_items, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    size_t first = static_cast<size_t>(start & d_mask);
+    size_t n_first = std::min(n_items, static_cast<size_t>(d_header->capacity) - first);
+    std::memcpy(d_data + first * item_size, in, n_first * item_size);
+    std::memcpy(d_data, in + n_first * item_size, (n_items - n_first) * item_size);
+    d_header->published.store(start + n_items, std::memory_order_release);
+}
+
+
+void Shm_Sample_Ring::close()
+{
+    d_header->closed.store(1, std::memory_order_release);
+}
+
+
+bool Shm_Sample_Ring::closed() const
+{
+    return d_header->closed.load(std::memory_order_acquire) != 0;
+}
+
+
+size_t Shm_Sample_Ring::read(void* out, size_t max_items, uint64_t& first_index, uint64_t& lost)
+{
+    auto* output = static_cast<uint8_t*>(out);
+    const size_t item_size = d_header->item_size;
+    const uint64_t capacity = d_header->capacity;
+    lost = 0;
+    uint64_t published = d_header->published.load(std::memory_order_acquire);
+    if (published - d_position > capacity)
+        {
+            // overrun: resume at the newest item, where there is most margin
+            lost = published - d_position;
+            d_position = published;
+        }
+    first_index = d_position;
+    size_t n_items = static_cast<size_t>(std::min(static_cast<uint64_t>(max_items), published - d_position));
+    if (n_items == 0)
+        {
+            return 0;
+        }
+    size_t first = static_cast<size_t>(d_position & d_mask);
+    size_t n_first = std::min(n_items, static_cast<size_t>(capacity) - first);
+    std::memcpy(output, d_data + first * item_size, n_first * item_size);
+    std::memcpy(output + n_first * item_size, d_data, (n_items - n_first) * item_size);
+
+    // the copied items are valid if the producer has not started overwriting them meanwhile
+    std::atomic_thread_fence(std::memory_order_acquire);
+    uint64_t reserved = d_header->reserved.load(std::memory_order_relaxed);
+    if (reserved > d_position + capacity)
+        {
+            uint64_t overwritten = std::min(reserved - capacity - d_position, static_cast<uint64_t>(n_items));
+            lost += overwritten;
+            n_items -= static_cast<size_t>(overwritten);
+            d_position += overwritten;
+            first_index = d_position;
+            std::memmove(output, output + overwritten * item_size, n_items * item_size);
+        }
+    d_position += n_items;
+    return n_items;
+}
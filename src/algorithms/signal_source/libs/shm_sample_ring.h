@@ -0,0 +1,156 @@
+/*!
+ * \file shm_sample_ring.h
+ * \brief Ring of signal samples in POSIX shared memory, written by the process
+ * that owns the radio and read by any number of receivers on the same host.
+ *
+ * The shared object starts with a Shm_Sample_Ring_Header, followed (at
+ * data_offset bytes) by capacity items of item_size bytes. The producer never
+ * waits for the consumers: it writes the items at position n % capacity and
+ * then advances the published counter. A consumer that falls more than
+ * capacity items behind loses the overwritten items, which it detects by
+ * checking the reserved counter after copying them.
+ *
+ * -------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2019  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *          Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_SHM_SAMPLE_RING_H_
+#define GNSS_SDR_SHM_SAMPLE_RING_H_
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+
+const uint32_t SHM_SAMPLE_RING_MAGIC = 0x474E5353;  // "GNSS"
+const uint16_t SHM_SAMPLE_RING_VERSION = 1;
+
+static_assert(ATOMIC_LLONG_LOCK_FREE == 2, "the counters of the shared ring must be lock-free");
+
+/*!
+ * \brief Beginning of the shared object. The counters are items written since
+ * the ring was created, so the stream index of an item never wraps around.
+ */
+struct Shm_Sample_Ring_Header
+{
+    uint32_t magic;
+    uint16_t version;
+    uint16_t header_bytes;        // sizeof(Shm_Sample_Ring_Header) of the producer
+    uint32_t item_size;           // bytes per item
+    uint32_t padding;             // zero
+    uint64_t capacity;            // items, a power of two
+    uint64_t data_offset;         // bytes from the beginning of the object to the first item
+    double sampling_frequency;    // [Hz], 0 if unknown
+    alignas(64) std::atomic<uint64_t> reserved;  // items being written, set before copying them
+    alignas(64) std::atomic<uint64_t> published;  // items that can be read
+    std::atomic<uint32_t> closed;                 // 1 when the producer stops
+};
+
+
+/*!
+ * \brief Producer or consumer end of a ring of samples in shared memory.
+ *
+ * Each consumer keeps its own read position in its process, so the
+ * producer does not know (nor wait for) the consumers.
+ */
+class Shm_Sample_Ring
+{
+public:
+    /*!
+     * \brief Producer: creates the shared object \p name (e.g., "/gnss_samples")
+     * holding at least \p min_items items of \p item_size bytes. The number of
+     * items is rounded up to a power of two. An existing object with that
+     * name is replaced. Throws std::runtime_error on failure.
+     */
+    static std::unique_ptr<Shm_Sample_Ring> create(const std::string& name, size_t item_size, uint64_t min_items, double sampling_frequency = 0.0);
+
+    /*!
+     * \brief Consumer: maps the shared object \p name made by a producer.
+     * Reading starts at the newest item. Throws std::runtime_error if the
+     * object does not exist or is not a sample ring.
+     */
+    static std::unique_ptr<Shm_Sample_Ring> attach(const std::string& name);
+
+    /*!
+     * \brief Unmaps the ring. The producer also marks it as closed and
+     * removes its name, the consumers still attached keep their mapping.
+     */
+    ~Shm_Sample_Ring();
+
+    inline size_t item_size() const
+    {
+        return d_header->item_size;
+    }
+
+    inline uint64_t capacity() const
+    {
+        return d_header->capacity;
+    }
+
+    inline double sampling_frequency() const
+    {
+        return d_header->sampling_frequency;
+    }
+
+    /*!
+     * \brief Producer: appends \p n_items items, n_items <= capacity().
+     */
+    void write(const void* items, size_t n_items);
+
+    /*!
+     * \brief Producer: tells the consumers that no more items will be written.
+     */
+    void close();
+
+    /*!
+     * \brief Consumer: true when the producer has closed the ring.
+     */
+    bool closed() const;
+
+    /*!
+     * \brief Consumer: copies up to \p max_items items into \p out and returns
+     * how many were copied. \p first_index returns the stream index of the
+     * first one, and \p lost the items overwritten by the producer before
+     * they could be read (skipped just before it).
+     */
+    size_t read(void* out, size_t max_items, uint64_t& first_index, uint64_t& lost);
+
+private:
+    Shm_Sample_Ring(const std::string& name, bool producer, void* map, size_t map_bytes);
+
+    static std::string object_name(const std::string& name);
+
+    std::string d_name;
+    bool d_producer;
+    void* d_map;
+    size_t d_map_bytes;
+    Shm_Sample_Ring_Header* d_header;
+    uint8_t* d_data;
+    uint64_t d_mask;
+    uint64_t d_position;  // consumer: next item to read
+};
+
+#endif
@@ -0,0 +1,95 @@
+/*!
+ * \file udp_packet_ring.cc
+ * \brief Lock-free ring of received UDP datagrams.
+ *
+ * -------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2018  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *          Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------
+ */
+
+#include "udp_packet_ring.h"
+
+
+Udp_Packet_Ring::Udp_Packet_Ring(uint32_t min_slots, size_t slot_bytes) : d_slot_bytes(slot_bytes)
+{
+    // A power of two keeps the slot index continuous when the counters wrap around
+    uint32_t slots = 2;
+    while (slots < min_slots)
+        {
+            slots <<= 1;
+        }
+    d_mask = slots - 1;
+    d_buffer.resize(static_cast<size_t>(slots) * d_slot_bytes);
+    d_lengths.resize(slots, 0);
+    d_head = 0U;
+    d_tail = 0U;
+}
+
+
+uint32_t Udp_Packet_Ring::writable() const
+{
+    uint32_t head = d_head.load(std::memory_order_relaxed);
+    uint32_t tail = d_tail.load(std::memory_order_acquire);
+    return d_mask + 1 - (head - tail);
+}
+
+
+char* Udp_Packet_Ring::free_slot(uint32_t k)
+{
+    uint32_t head = d_head.load(std::memory_order_relaxed);
+    return &d_buffer[static_cast<size_t>((head + k) & d_mask) * d_slot_bytes];
+}
+
+
+void Udp_Packet_Ring::publish(const uint32_t* lengths, uint32_t count)
+{
+    uint32_t head = d_head.load(std::memory_order_relaxed);
+    for (uint32_t k = 0; k < count; k++)
+        {
+            d_lengths[(head + k) & d_mask] = lengths[k];
+        }
+    d_head.store(head + count, std::memory_order_release);
+}
+
+
+uint32_t Udp_Packet_Ring::readable()
+{
+    uint32_t tail = d_tail.load(std::memory_order_relaxed);
+    uint32_t head = d_head.load(std::memory_order_acquire);
+    return head - tail;
+}
+
+
+const char* Udp_Packet_Ring::front(size_t& bytes)
+{
+    uint32_t slot = d_tail.load(std::memory_order_relaxed) & d_mask;
+    bytes = d_lengths[slot];
+    return &d_buffer[static_cast<size_t>(slot) * d_slot_bytes];
+}
+
+
+void Udp_Packet_Ring::pop()
+{
+    uint32_t tail = d_tail.load(std::memory_order_relaxed);
+    d_tail.store(tail + 1, std::memory_order_release);
+}
@@ -0,0 +1,103 @@
+/*!
+ * \file udp_packet_ring.h
+ * \brief Lock-free ring of received UDP datagrams.
+ *
+ * A capture thread receives datagrams directly into the free slots of the
+ * ring, and the signal source block reads them in the same order, without
+ * any lock between them. Each ring has exactly one producer and one consumer.
+ *
+ * -------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2018  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *          Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_UDP_PACKET_RING_H_
+#define GNSS_SDR_UDP_PACKET_RING_H_
+
+#include "datagram_queue.h"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+
+/*!
+ * \brief Single-producer single-consumer ring of datagrams of up to
+ * slot_bytes() bytes.
+ */
+class Udp_Packet_Ring : public Datagram_Queue
+{
+public:
+    /*!
+     * \brief Allocates at least \p min_slots slots of \p slot_bytes bytes.
+     * The number of slots is rounded up to a power of two.
+     */
+    Udp_Packet_Ring(uint32_t min_slots, size_t slot_bytes);
+
+    inline size_t slot_bytes() const
+    {
+        return d_slot_bytes;
+    }
+
+    /*!
+     * \brief Producer: number of free slots.
+     */
+    uint32_t writable() const;
+
+    /*!
+     * \brief Producer: buffer of the \p k-th free slot, \p k < writable().
+     */
+    char* free_slot(uint32_t k);
+
+    /*!
+     * \brief Producer: hands the first \p count free slots, holding
+     * \p lengths[k] bytes each, to the consumer.
+     */
+    void publish(const uint32_t* lengths, uint32_t count);
+
+    /*!
+     * \brief Consumer: number of datagrams waiting.
+     */
+    uint32_t readable() override;
+
+    /*!
+     * \brief Consumer: oldest datagram, readable() > 0. Its length is
+     * returned in \p bytes.
+     */
+    const char* front(size_t& bytes) override;
+
+    /*!
+     * \brief Consumer: releases the oldest datagram.
+     */
+    void pop() override;
+
+private:
+    size_t d_slot_bytes;
+    uint32_t d_mask;
+    std::vector<char> d_buffer;
+    std::vector<uint32_t> d_lengths;
+    std::atomic<uint32_t> d_head;  // next slot to be published by the producer
+    std::atomic<uint32_t> d_tail;  // next slot to be read by the consumer
+};
+
+#endif
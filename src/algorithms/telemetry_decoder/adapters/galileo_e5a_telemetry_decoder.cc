@@ -58,7 +58,7 @@ GalileoE5aTelemetryDecoder::GalileoE5aTelemetryDecoder(ConfigurationInterface* c
     dump_ = configuration->property(role + ".dump", false);
     dump_filename_ = configuration->property(role + ".dump_filename", default_dump_filename);
     // make telemetry decoder object
-    telemetry_decoder_ = galileo_make_telemetry_decoder_cc(satellite_, 2, dump_);  //unified galileo decoder set to FNAV (frame_type=2)
+    telemetry_decoder_ = galileo_make_telemetry_decoder_cc(satellite_, 2, dump_, gnss_dump_policy_conf(configuration, role));  //unified galileo decoder set to FNAV (frame_type=2)
     DLOG(INFO) << "telemetry_decoder(" << telemetry_decoder_->unique_id() << ")";
     channel_ = 0;
     if (in_streams_ > 1)
@@ -31,13 +31,16 @@
 
 #include "galileo_telemetry_decoder_cc.h"
 #include "control_message_factory.h"
-#include "convolutional.h"
 #include "display.h"
+#include "gnss_ephemeris_registry.h"
+#include "gnss_profiler.h"
 #include "gnss_synchro.h"
 #include <boost/lexical_cast.hpp>
 #include <glog/logging.h>
 #include <gnuradio/io_signature.h>
 #include <volk_gnsssdr/volk_gnsssdr.h>
+#include <algorithm>
+#include <cstring>
 #include <iostream>
 
 
@@ -47,20 +50,19 @@ using google::LogMessage;
 
 
 galileo_telemetry_decoder_cc_sptr
-galileo_make_telemetry_decoder_cc(const Gnss_Satellite &satellite, int frame_type, bool dump)
+galileo_make_telemetry_decoder_cc(const Gnss_Satellite &satellite, int frame_type, bool dump, const Gnss_Dump_Policy_Conf &dump_policy)
 {
-    return galileo_telemetry_decoder_cc_sptr(new galileo_telemetry_decoder_cc(satellite, frame_type, dump));
+    return galileo_telemetry_decoder_cc_sptr(new galileo_telemetry_decoder_cc(satellite, frame_type, dump, dump_policy));
 }
 
 
-void galileo_telemetry_decoder_cc::viterbi_decoder(double *page_part_symbols, int32_t *page_part_bits)
+void galileo_telemetry_decoder_cc::viterbi_decoder(float *page_part_symbols, int32_t *page_part_bits)
 {
-    Viterbi(page_part_bits, out0, state0, out1, state1,
-        page_part_symbols, KK, nn, DataLength);
+    d_viterbi->decode_block(page_part_symbols, page_part_bits, DataLength);
 }
 
 
-void galileo_telemetry_decoder_cc::deinterleaver(int32_t rows, int32_t cols, const double *in, double *out)
+void galileo_telemetry_decoder_cc::deinterleaver(int32_t rows, int32_t cols, const float *in, float *out)
 {
     for (int32_t r = 0; r < rows; r++)
         {
@@ -74,8 +76,10 @@ void galileo_telemetry_decoder_cc::deinterleaver(int32_t rows, int32_t cols, con
 
 galileo_telemetry_decoder_cc::galileo_telemetry_decoder_cc(
     const Gnss_Satellite &satellite, int frame_type,
-    bool dump) : gr::block("galileo_telemetry_decoder_cc", gr::io_signature::make(1, 1, sizeof(Gnss_Synchro)),
-                     gr::io_signature::make(1, 1, sizeof(Gnss_Synchro)))
+    bool dump,
+    const Gnss_Dump_Policy_Conf &dump_policy) : gr::block("galileo_telemetry_decoder_cc", gr::io_signature::make(1, 1, sizeof(Gnss_Synchro)),
+                                                    gr::io_signature::make(1, 1, sizeof(Gnss_Synchro))),
+                                                d_dump_policy(dump_policy)
 {
     // Ephemeris data port out
     this->message_port_register_out(pmt::mp("telemetry"));
@@ -147,7 +151,8 @@ galileo_telemetry_decoder_cc::galileo_telemetry_decoder_cc(
             std::cout << "Galileo unified telemetry decoder error: Unknown frame type " << std::endl;
         }
 
-    d_page_part_symbols = static_cast<double *>(volk_gnsssdr_malloc(d_frame_length_symbols * sizeof(double), volk_gnsssdr_get_alignment()));
+    d_page_part_symbols = static_cast<float *>(volk_gnsssdr_malloc(d_frame_length_symbols * sizeof(float), volk_gnsssdr_get_alignment()));
+    d_page_part_symbols_deint = static_cast<float *>(volk_gnsssdr_malloc(d_frame_length_symbols * sizeof(float), volk_gnsssdr_get_alignment()));
     int32_t n = 0;
     for (int32_t i = 0; i < d_bits_per_preamble; i++)
         {
@@ -201,6 +206,10 @@ galileo_telemetry_decoder_cc::galileo_telemetry_decoder_cc(
                     }
                 }
         }
+    // The preamble is searched at the start of the history, which keeps the last d_required_symbols + 1 symbols
+    d_symbol_history.set_capacity(d_required_symbols + 1);
+    d_preamble_correlator.set_preamble(d_preamble_samples, d_samples_per_preamble);
+    d_preamble_correlation_delay = d_required_symbols + 1 - d_samples_per_preamble;
     d_sample_counter = 0ULL;
     d_stat = 0;
     d_preamble_index = 0ULL;
@@ -218,16 +227,9 @@ galileo_telemetry_decoder_cc::galileo_telemetry_decoder_cc(
     flag_TOW_set = false;
 
     // vars for Viterbi decoder
-    int32_t max_states = 1 << mm;  // 2^mm
-    g_encoder[0] = 121;            // Polynomial G1
-    g_encoder[1] = 91;             // Polynomial G2
-    out0 = static_cast<int32_t *>(volk_gnsssdr_malloc(max_states * sizeof(int32_t), volk_gnsssdr_get_alignment()));
-    out1 = static_cast<int32_t *>(volk_gnsssdr_malloc(max_states * sizeof(int32_t), volk_gnsssdr_get_alignment()));
-    state0 = static_cast<int32_t *>(volk_gnsssdr_malloc(max_states * sizeof(int32_t), volk_gnsssdr_get_alignment()));
-    state1 = static_cast<int32_t *>(volk_gnsssdr_malloc(max_states * sizeof(int32_t), volk_gnsssdr_get_alignment()));
-    // create appropriate transition matrices
-    nsc_transit(out0, state0, 0, g_encoder, KK, nn);
-    nsc_transit(out1, state1, 1, g_encoder, KK, nn);
+    g_encoder[0] = 121;  // Polynomial G1
+    g_encoder[1] = 91;   // Polynomial G2
+    d_viterbi = new Viterbi_Decoder(g_encoder, KK, nn);
 }
 
 
@@ -239,10 +241,8 @@ galileo_telemetry_decoder_cc::~galileo_telemetry_decoder_cc()
             volk_gnsssdr_free(d_secondary_code_samples);
         }
     volk_gnsssdr_free(d_page_part_symbols);
-    volk_gnsssdr_free(out0);
-    volk_gnsssdr_free(out1);
-    volk_gnsssdr_free(state0);
-    volk_gnsssdr_free(state1);
+    volk_gnsssdr_free(d_page_part_symbols_deint);
+    delete d_viterbi;
     if (d_dump_file.is_open() == true)
         {
             try
@@ -257,26 +257,22 @@ galileo_telemetry_decoder_cc::~galileo_telemetry_decoder_cc()
 }
 
 
-void galileo_telemetry_decoder_cc::decode_INAV_word(double *page_part_symbols, int32_t frame_length)
+void galileo_telemetry_decoder_cc::decode_INAV_word(const float *page_part_symbols, int32_t frame_length)
 {
     // 1. De-interleave
-    auto *page_part_symbols_deint = static_cast<double *>(volk_gnsssdr_malloc(frame_length * sizeof(double), volk_gnsssdr_get_alignment()));
+    float *page_part_symbols_deint = d_page_part_symbols_deint;
     deinterleaver(GALILEO_INAV_INTERLEAVER_ROWS, GALILEO_INAV_INTERLEAVER_COLS, page_part_symbols, page_part_symbols_deint);
 
     // 2. Viterbi decoder
     // 2.1 Take into account the NOT gate in G2 polynomial (Galileo ICD Figure 13, FEC encoder)
     // 2.2 Take into account the possible inversion of the polarity due to PLL lock at 180º
-    for (int32_t i = 0; i < frame_length; i++)
+    for (int32_t i = 1; i < frame_length; i += 2)
         {
-            if ((i + 1) % 2 == 0)
-                {
-                    page_part_symbols_deint[i] = -page_part_symbols_deint[i];
-                }
+            page_part_symbols_deint[i] = -page_part_symbols_deint[i];
         }
 
     auto *page_part_bits = static_cast<int32_t *>(volk_gnsssdr_malloc((frame_length / 2) * sizeof(int32_t), volk_gnsssdr_get_alignment()));
     viterbi_decoder(page_part_symbols_deint, page_part_bits);
-    volk_gnsssdr_free(page_part_symbols_deint);
 
     // 3. Call the Galileo page decoder
     std::string page_String;
@@ -319,8 +315,11 @@ void galileo_telemetry_decoder_cc::decode_INAV_word(double *page_part_symbols, i
         {
             // get object for this SV (mandatory)
             std::shared_ptr<Galileo_Ephemeris> tmp_obj = std::make_shared<Galileo_Ephemeris>(d_inav_nav.get_ephemeris());
-            std::cout << "New Galileo E1 I/NAV message received in channel " << d_channel << ": ephemeris from satellite " << d_satellite << std::endl;
-            this->message_port_pub(pmt::mp("telemetry"), pmt::make_any(tmp_obj));
+            if (Gnss_Ephemeris_Registry::get_instance()->is_new(*tmp_obj, Gnss_Ephemeris_Registry::GALILEO_INAV))
+                {
+                    std::cout << "New Galileo E1 I/NAV message received in channel " << d_channel << ": ephemeris from satellite " << d_satellite << std::endl;
+                    this->message_port_pub(pmt::mp("telemetry"), pmt::make_any(tmp_obj));
+                }
         }
     if (d_inav_nav.have_new_iono_and_GST() == true)
         {
@@ -351,25 +350,21 @@ void galileo_telemetry_decoder_cc::decode_INAV_word(double *page_part_symbols, i
 }
 
 
-void galileo_telemetry_decoder_cc::decode_FNAV_word(double *page_symbols, int32_t frame_length)
+void galileo_telemetry_decoder_cc::decode_FNAV_word(const float *page_symbols, int32_t frame_length)
 {
     // 1. De-interleave
-    auto *page_symbols_deint = static_cast<double *>(volk_gnsssdr_malloc(frame_length * sizeof(double), volk_gnsssdr_get_alignment()));
+    float *page_symbols_deint = d_page_part_symbols_deint;
     deinterleaver(GALILEO_FNAV_INTERLEAVER_ROWS, GALILEO_FNAV_INTERLEAVER_COLS, page_symbols, page_symbols_deint);
 
     // 2. Viterbi decoder
     // 2.1 Take into account the NOT gate in G2 polynomial (Galileo ICD Figure 13, FEC encoder)
     // 2.2 Take into account the possible inversion of the polarity due to PLL lock at 180�
-    for (int32_t i = 0; i < frame_length; i++)
+    for (int32_t i = 1; i < frame_length; i += 2)
         {
-            if ((i + 1) % 2 == 0)
-                {
-                    page_symbols_deint[i] = -page_symbols_deint[i];
-                }
+            page_symbols_deint[i] = -page_symbols_deint[i];
         }
     auto *page_bits = static_cast<int32_t *>(volk_gnsssdr_malloc((frame_length / 2) * sizeof(int32_t), volk_gnsssdr_get_alignment()));
     viterbi_decoder(page_symbols_deint, page_bits);
-    volk_gnsssdr_free(page_symbols_deint);
 
     // 3. Call the Galileo page decoder
     std::string page_String;
@@ -401,8 +396,11 @@ void galileo_telemetry_decoder_cc::decode_FNAV_word(double *page_symbols, int32_
     if (d_fnav_nav.have_new_ephemeris() == true)
         {
             std::shared_ptr<Galileo_Ephemeris> tmp_obj = std::make_shared<Galileo_Ephemeris>(d_fnav_nav.get_ephemeris());
-            std::cout << TEXT_MAGENTA << "New Galileo E5a F/NAV message received in channel " << d_channel << ": ephemeris from satellite " << d_satellite << TEXT_RESET << std::endl;
-            this->message_port_pub(pmt::mp("telemetry"), pmt::make_any(tmp_obj));
+            if (Gnss_Ephemeris_Registry::get_instance()->is_new(*tmp_obj, Gnss_Ephemeris_Registry::GALILEO_FNAV))
+                {
+                    std::cout << TEXT_MAGENTA << "New Galileo E5a F/NAV message received in channel " << d_channel << ": ephemeris from satellite " << d_satellite << TEXT_RESET << std::endl;
+                    this->message_port_pub(pmt::mp("telemetry"), pmt::make_any(tmp_obj));
+                }
         }
     if (d_fnav_nav.have_new_iono_and_GST() == true)
         {
@@ -443,6 +441,8 @@ void galileo_telemetry_decoder_cc::set_channel(int32_t channel)
                             d_dump_filename.append(".dat");
                             d_dump_file.exceptions(std::ifstream::failbit | std::ifstream::badbit);
                             d_dump_file.open(d_dump_filename.c_str(), std::ios::out | std::ios::binary);
+                            d_dump_policy.set_channel(d_channel);
+                            d_dump_policy.set_writer("telemetry decoder channel " + std::to_string(d_channel), DUMP_RECORD_BYTES, 1000.0, [this](const char *record) { write_dump_record(record); });
                             LOG(INFO) << "Telemetry decoder dump enabled on channel " << d_channel << " Log file: " << d_dump_filename.c_str();
                         }
                     catch (const std::ifstream::failure &e)
@@ -454,39 +454,42 @@ void galileo_telemetry_decoder_cc::set_channel(int32_t channel)
 }
 
 
-int galileo_telemetry_decoder_cc::general_work(int noutput_items __attribute__((unused)), gr_vector_int &ninput_items __attribute__((unused)),
-    gr_vector_const_void_star &input_items, gr_vector_void_star &output_items)
+void galileo_telemetry_decoder_cc::write_dump_record(const char *record)
+{
+    try
+        {
+            d_dump_file.write(record, DUMP_RECORD_BYTES);
+        }
+    catch (const std::ifstream::failure &e)
+        {
+            LOG(WARNING) << "Exception writing telemetry dump file " << e.what();
+        }
+}
+
+
+int32_t galileo_telemetry_decoder_cc::process_symbol(const Gnss_Synchro &in_symbol, Gnss_Synchro &out_symbol)
 {
     int32_t corr_value = 0;
     int32_t preamble_diff = 0;
 
-    auto **out = reinterpret_cast<Gnss_Synchro **>(&output_items[0]);            // Get the output buffer pointer
-    const auto **in = reinterpret_cast<const Gnss_Synchro **>(&input_items[0]);  // Get the input buffer pointer
 
     Gnss_Synchro current_symbol{};  // structure to save the synchronization information and send the output object to the next block
     // 1. Copy the current tracking output
-    current_symbol = in[0][0];
+    current_symbol = in_symbol;
     // add new symbol to the symbol queue
-    d_symbol_history.push_back(current_symbol.Prompt_I);
+    d_symbol_history.push_back(static_cast<float>(current_symbol.Prompt_I));
     d_sample_counter++;  // count for the processed samples
-    consume_each(1);
     d_flag_preamble = false;
 
-    if (d_symbol_history.size() > d_required_symbols)
+    // ******* preamble correlation ********
+    // slide the correlator over the symbols at the start of the history, one symbol in and one out
+    if (d_symbol_history.size() > d_preamble_correlation_delay)
         {
-            // TODO Optimize me!
-            // ******* preamble correlation ********
-            for (int32_t i = 0; i < d_samples_per_preamble; i++)
-                {
-                    if (d_symbol_history.at(i) < 0.0)  // symbols clipping
-                        {
-                            corr_value -= d_preamble_samples[i];
-                        }
-                    else
-                        {
-                            corr_value += d_preamble_samples[i];
-                        }
-                }
+            d_preamble_correlator.push_symbol(d_symbol_history[d_symbol_history.size() - 1 - d_preamble_correlation_delay]);
+        }
+    if (d_symbol_history.full())
+        {
+            corr_value = d_preamble_correlator.correlation();
         }
 
     // ******* frame sync ******************
@@ -534,54 +537,29 @@ int galileo_telemetry_decoder_cc::general_work(int noutput_items __attribute__((
                             {
                             case 1:  // INAV
                                      // NEW Galileo page part is received
-                                // 0. fetch the symbols into an array
-                                if (corr_value > 0)  //normal PLL lock
-                                    {
-                                        for (uint32_t i = 0; i < d_frame_length_symbols; i++)
-                                            {
-                                                d_page_part_symbols[i] = d_symbol_history.at(i + d_samples_per_preamble);  // because last symbol of the preamble is just received now!
-                                            }
-                                    }
-                                else  //180 deg. inverted carrier phase PLL lock
-                                    {
-                                        for (uint32_t i = 0; i < d_frame_length_symbols; i++)
-                                            {
-                                                d_page_part_symbols[i] = d_symbol_history.at(i + d_samples_per_preamble);  // because last symbol of the preamble is just received now!
-                                            }
-                                    }
-                                decode_INAV_word(d_page_part_symbols, d_frame_length_symbols);
+                                // 0. the page symbols follow the preamble in the history: decode them in place
+                                decode_INAV_word(d_symbol_history.data() + d_samples_per_preamble, d_frame_length_symbols);  // because last symbol of the preamble is just received now!
                                 break;
                             case 2:  // FNAV
                                      // NEW Galileo page part is received
-                                // 0. fetch the symbols into an array
-                                if (corr_value > 0)  //normal PLL lock
-                                    {
-                                        int k = 0;
-                                        for (uint32_t i = 0; i < d_frame_length_symbols; i++)
-                                            {
-                                                d_page_part_symbols[i] = 0;
-                                                for (uint32_t m = 0; m < d_samples_per_symbol; m++)
-                                                    {
-                                                        d_page_part_symbols[i] += static_cast<float>(d_secondary_code_samples[k]) * d_symbol_history.at(i * d_samples_per_symbol + d_samples_per_preamble + m);  // because last symbol of the preamble is just received now!
-                                                        k++;
-                                                        k = k % Galileo_E5a_I_SECONDARY_CODE_LENGTH;
-                                                    }
-                                            }
-                                    }
-                                else  //180 deg. inverted carrier phase PLL lock
-                                    {
-                                        int k = 0;
-                                        for (uint32_t i = 0; i < d_frame_length_symbols; i++)
-                                            {
-                                                d_page_part_symbols[i] = 0;
-                                                for (uint32_t m = 0; m < d_samples_per_symbol; m++)  //integrate samples into symbols
-                                                    {
-                                                        d_page_part_symbols[i] -= static_cast<float>(d_secondary_code_samples[k]) * d_symbol_history.at(i * d_samples_per_symbol + d_samples_per_preamble + m);  // because last symbol of the preamble is just received now!
-                                                        k++;
-                                                        k = k % Galileo_E5a_I_SECONDARY_CODE_LENGTH;
-                                                    }
-                                            }
-                                    }
+                                // 0. integrate the samples that follow the preamble into symbols, wiping off the secondary code
+                                {
+                                    const float *page_samples = d_symbol_history.data() + d_samples_per_preamble;  // because last symbol of the preamble is just received now!
+                                    const float polarity = corr_value > 0 ? 1.0 : -1.0;                            // 180 deg. inverted carrier phase PLL lock
+                                    int k = 0;
+                                    for (uint32_t i = 0; i < d_frame_length_symbols; i++)
+                                        {
+                                            float symbol = 0;
+                                            for (uint32_t m = 0; m < d_samples_per_symbol; m++)
+                                                {
+                                                    symbol += static_cast<float>(d_secondary_code_samples[k]) * page_samples[m];
+                                                    k++;
+                                                    k = k % Galileo_E5a_I_SECONDARY_CODE_LENGTH;
+                                                }
+                                            d_page_part_symbols[i] = polarity * symbol;
+                                            page_samples += d_samples_per_symbol;
+                                        }
+                                }
                                 decode_FNAV_word(d_page_part_symbols, d_frame_length_symbols);
                                 break;
                             default:
@@ -607,6 +585,10 @@ int galileo_telemetry_decoder_cc::general_work(int noutput_items __attribute__((
                                 if (d_CRC_error_counter > CRC_ERROR_LIMIT)
                                     {
                                         LOG(INFO) << "Lost of frame sync SAT " << this->d_satellite;
+                                        if (d_dump)
+                                            {
+                                                d_dump_policy.trigger("loss of frame sync", static_cast<double>(in_symbol.Tracking_sample_counter) / static_cast<double>(in_symbol.fs));
+                                            }
                                         d_flag_frame_sync = false;
                                         d_stat = 0;
                                         d_TOW_at_current_symbol_ms = 0;
@@ -718,13 +700,6 @@ int galileo_telemetry_decoder_cc::general_work(int noutput_items __attribute__((
                 }
         }
 
-    // remove used symbols from history
-    // todo: Use circular buffer here
-    if (d_symbol_history.size() > d_required_symbols)
-        {
-            d_symbol_history.pop_front();
-        }
-
     switch (d_frame_type)
         {
         case 1:  // INAV
@@ -759,26 +734,46 @@ int galileo_telemetry_decoder_cc::general_work(int noutput_items __attribute__((
 
             if (d_dump == true)
                 {
-                    // MULTIPLEXED FILE RECORDING - Record results to file
-                    try
-                        {
-                            double tmp_double;
-                            uint64_t tmp_ulong_int;
-                            tmp_double = static_cast<double>(d_TOW_at_current_symbol_ms) / 1000.0;
-                            d_dump_file.write(reinterpret_cast<char *>(&tmp_double), sizeof(double));
-                            tmp_ulong_int = current_symbol.Tracking_sample_counter;
-                            d_dump_file.write(reinterpret_cast<char *>(&tmp_ulong_int), sizeof(uint64_t));
-                            tmp_double = static_cast<double>(d_TOW_at_Preamble_ms) / 1000.0;
-                            d_dump_file.write(reinterpret_cast<char *>(&tmp_double), sizeof(double));
-                        }
-                    catch (const std::ifstream::failure &e)
-                        {
-                            LOG(WARNING) << "Exception writing observables dump file " << e.what();
-                        }
+                    // MULTIPLEXED FILE RECORDING - Record results to file, if the dump policy lets it through
+                    char record[DUMP_RECORD_BYTES];
+                    double tmp_double;
+                    uint64_t tmp_ulong_int;
+                    tmp_double = static_cast<double>(d_TOW_at_current_symbol_ms) / 1000.0;
+                    memcpy(record, &tmp_double, sizeof(double));
+                    tmp_ulong_int = current_symbol.Tracking_sample_counter;
+                    memcpy(record + sizeof(double), &tmp_ulong_int, sizeof(uint64_t));
+                    tmp_double = static_cast<double>(d_TOW_at_Preamble_ms) / 1000.0;
+                    memcpy(record + sizeof(double) + sizeof(uint64_t), &tmp_double, sizeof(double));
+                    d_dump_policy.dump(record, static_cast<double>(current_symbol.Tracking_sample_counter) / static_cast<double>(current_symbol.fs), current_symbol.PRN);
                 }
             // 3. Make the output (copy the object contents to the GNURadio reserved memory)
-            *out[0] = current_symbol;
+            out_symbol = current_symbol;
             return 1;
         }
     return 0;
 }
+
+
+int galileo_telemetry_decoder_cc::general_work(int noutput_items, gr_vector_int &ninput_items,
+    gr_vector_const_void_star &input_items, gr_vector_void_star &output_items)
+{
+    Gnss_Profile_Scope profile("galileo_telemetry");
+    auto *out = reinterpret_cast<Gnss_Synchro *>(output_items[0]);            // Get the output buffer pointer
+    const auto *in = reinterpret_cast<const Gnss_Synchro *>(input_items[0]);  // Get the input buffer pointer
+
+    // process all the available symbols in one call, each one produces at most one output
+    const int32_t n_symbols = std::min(ninput_items[0], noutput_items);
+    int32_t n_produced = 0;
+    for (int32_t i = 0; i < n_symbols; i++)
+        {
+            const int32_t produced = process_symbol(in[i], out[n_produced]);
+            if (produced < 0)
+                {
+                    consume_each(i + 1);
+                    return produced;
+                }
+            n_produced += produced;
+        }
+    consume_each(n_symbols);
+    return n_produced;
+}
@@ -5,7 +5,7 @@
  *
  * -------------------------------------------------------------------------
  *
- * Copyright (C) 2010-2018  (see AUTHORS file for a list of contributors)
+ * Copyright (C) 2010-2019  (see AUTHORS file for a list of contributors)
  *
  * GNSS-SDR is a software defined Global Navigation
  *          Satellite Systems receiver
@@ -43,6 +43,10 @@
 #include "galileo_utc_model.h"
 #include "gnss_satellite.h"
 #include "gnss_synchro.h"
+#include "linear_ring_buffer.h"
+#include "preamble_correlator.h"
+#include "telemetry_symbol_processor.h"
+#include "viterbi_decoder.h"
 #include <gnuradio/block.h>
 #include <fstream>
 #include <string>
@@ -52,12 +56,12 @@ class galileo_telemetry_decoder_cc;
 
 typedef boost::shared_ptr<galileo_telemetry_decoder_cc> galileo_telemetry_decoder_cc_sptr;
 
-galileo_telemetry_decoder_cc_sptr galileo_make_telemetry_decoder_cc(const Gnss_Satellite &satellite, int frame_type, bool dump);
+galileo_telemetry_decoder_cc_sptr galileo_make_telemetry_decoder_cc(const Gnss_Satellite &satellite, int frame_type, bool dump, const Gnss_Dump_Policy_Conf &dump_policy = Gnss_Dump_Policy_Conf());
 
 /*!
  * \brief This class implements a block that decodes the INAV and FNAV data defined in Galileo ICD
  */
-class galileo_telemetry_decoder_cc : public gr::block
+class galileo_telemetry_decoder_cc : public gr::block, public TelemetrySymbolProcessor
 {
 public:
     ~galileo_telemetry_decoder_cc();
@@ -71,17 +75,21 @@ public:
     int general_work(int noutput_items, gr_vector_int &ninput_items,
         gr_vector_const_void_star &input_items, gr_vector_void_star &output_items);
 
+    int32_t process_symbol(const Gnss_Synchro &in_symbol, Gnss_Synchro &out_symbol) override;  //!< Decodes one symbol, also called by a fused tracking block
+
 private:
     friend galileo_telemetry_decoder_cc_sptr
-    galileo_make_telemetry_decoder_cc(const Gnss_Satellite &satellite, int frame_type, bool dump);
-    galileo_telemetry_decoder_cc(const Gnss_Satellite &satellite, int frame_type, bool dump);
+    galileo_make_telemetry_decoder_cc(const Gnss_Satellite &satellite, int frame_type, bool dump, const Gnss_Dump_Policy_Conf &dump_policy);
+    galileo_telemetry_decoder_cc(const Gnss_Satellite &satellite, int frame_type, bool dump, const Gnss_Dump_Policy_Conf &dump_policy);
+
+    void write_dump_record(const char *record);
 
-    void viterbi_decoder(double *page_part_symbols, int32_t *page_part_bits);
+    void viterbi_decoder(float *page_part_symbols, int32_t *page_part_bits);
 
-    void deinterleaver(int32_t rows, int32_t cols, const double *in, double *out);
+    void deinterleaver(int32_t rows, int32_t cols, const float *in, float *out);
 
-    void decode_INAV_word(double *symbols, int32_t frame_length);
-    void decode_FNAV_word(double *page_symbols, int32_t frame_length);
+    void decode_INAV_word(const float *page_part_symbols, int32_t frame_length);
+    void decode_FNAV_word(const float *page_symbols, int32_t frame_length);
 
     int d_frame_type;
     int32_t d_bits_per_preamble;
@@ -93,9 +101,12 @@ private:
     uint32_t d_PRN_code_period_ms;
     uint32_t d_required_symbols;
     uint32_t d_frame_length_symbols;
-    double *d_page_part_symbols;
+    float *d_page_part_symbols;
+    float *d_page_part_symbols_deint;
 
-    std::deque<float> d_symbol_history;
+    Linear_Ring_Buffer<float> d_symbol_history;
+    Preamble_Correlator d_preamble_correlator;
+    uint32_t d_preamble_correlation_delay;  // symbols between the newest one and the end of the correlated preamble
 
     uint64_t d_sample_counter;
     uint64_t d_preamble_index;
@@ -122,9 +133,11 @@ private:
 
     std::string d_dump_filename;
     std::ofstream d_dump_file;
+    Gnss_Dump_Policy d_dump_policy;  // decimation, filters and triggered mode of the dump
+    static const size_t DUMP_RECORD_BYTES = 2 * sizeof(double) + sizeof(uint64_t);
 
     // vars for Viterbi decoder
-    int32_t *out0, *out1, *state0, *state1;
+    Viterbi_Decoder *d_viterbi;
     int32_t g_encoder[2]{};
     const int32_t nn = 2;  // Coding rate 1/n
     const int32_t KK = 7;  // Constraint Length
@@ -32,9 +32,12 @@
 
 
 #include "glonass_l1_ca_telemetry_decoder_cc.h"
+#include "gnss_ephemeris_registry.h"
+#include "gnss_profiler.h"
 #include <boost/lexical_cast.hpp>
 #include <glog/logging.h>
 #include <gnuradio/io_signature.h>
+#include <algorithm>
 
 
 #define CRC_ERROR_LIMIT 6
@@ -89,6 +92,10 @@ glonass_l1_ca_telemetry_decoder_cc::glonass_l1_ca_telemetry_decoder_cc(
                     n++;
                 }
         }
+    // The preamble is searched at the start of the history, which keeps the last string plus one symbol
+    d_symbol_history.set_capacity(GLONASS_GNAV_STRING_SYMBOLS + 1);
+    d_preamble_correlator.set_preamble(d_preambles_symbols, d_symbols_per_preamble);
+    d_preamble_correlation_delay = GLONASS_GNAV_STRING_SYMBOLS + 1 - d_symbols_per_preamble;
     d_sample_counter = 0ULL;
     d_stat = 0;
     d_preamble_index = 0ULL;
@@ -193,9 +200,12 @@ void glonass_l1_ca_telemetry_decoder_cc::decode_string(const double *frame_symbo
             // get object for this SV (mandatory)
             d_nav.gnav_ephemeris.i_satellite_freq_channel = d_satellite.get_rf_link();
             std::shared_ptr<Glonass_Gnav_Ephemeris> tmp_obj = std::make_shared<Glonass_Gnav_Ephemeris>(d_nav.get_ephemeris());
-            this->message_port_pub(pmt::mp("telemetry"), pmt::make_any(tmp_obj));
-            LOG(INFO) << "GLONASS GNAV Ephemeris have been received in channel" << d_channel << " from satellite " << d_satellite;
-            std::cout << "New GLONASS L1 GNAV message received in channel " << d_channel << ": ephemeris from satellite " << d_satellite << std::endl;
+            if (Gnss_Ephemeris_Registry::get_instance()->is_new(*tmp_obj))
+                {
+                    this->message_port_pub(pmt::mp("telemetry"), pmt::make_any(tmp_obj));
+                    LOG(INFO) << "GLONASS GNAV Ephemeris have been received in channel" << d_channel << " from satellite " << d_satellite;
+                    std::cout << "New GLONASS L1 GNAV message received in channel " << d_channel << ": ephemeris from satellite " << d_satellite << std::endl;
+                }
         }
     if (d_nav.have_new_utc_model() == true)
         {
@@ -259,39 +269,29 @@ void glonass_l1_ca_telemetry_decoder_cc::set_channel(int32_t channel)
 }
 
 
-int glonass_l1_ca_telemetry_decoder_cc::general_work(int noutput_items __attribute__((unused)), gr_vector_int &ninput_items __attribute__((unused)),
-    gr_vector_const_void_star &input_items, gr_vector_void_star &output_items)
+int32_t glonass_l1_ca_telemetry_decoder_cc::process_symbol(const Gnss_Synchro &in_symbol, Gnss_Synchro &out_symbol)
 {
     int32_t corr_value = 0;
     int32_t preamble_diff = 0;
 
-    auto **out = reinterpret_cast<Gnss_Synchro **>(&output_items[0]);            // Get the output buffer pointer
-    const auto **in = reinterpret_cast<const Gnss_Synchro **>(&input_items[0]);  // Get the input buffer pointer
 
     Gnss_Synchro current_symbol{};  // structure to save the synchronization information and send the output object to the next block
     // 1. Copy the current tracking output
-    current_symbol = in[0][0];
+    current_symbol = in_symbol;
     d_symbol_history.push_back(current_symbol);  // add new symbol to the symbol queue
     d_sample_counter++;                          // count for the processed samples
-    consume_each(1);
 
     d_flag_preamble = false;
-    uint32_t required_symbols = GLONASS_GNAV_STRING_SYMBOLS;
 
-    if (d_symbol_history.size() > required_symbols)
+    // ******* preamble correlation ********
+    // slide the correlator over the symbols at the start of the history, one symbol in and one out
+    if (d_symbol_history.size() > d_preamble_correlation_delay)
         {
-            // ******* preamble correlation ********
-            for (int32_t i = 0; i < d_symbols_per_preamble; i++)
-                {
-                    if (d_symbol_history.at(i).Prompt_I < 0)  // symbols clipping
-                        {
-                            corr_value -= d_preambles_symbols[i];
-                        }
-                    else
-                        {
-                            corr_value += d_preambles_symbols[i];
-                        }
-                }
+            d_preamble_correlator.push_symbol(d_symbol_history[d_symbol_history.size() - 1 - d_preamble_correlation_delay].Prompt_I);
+        }
+    if (d_symbol_history.full())
+        {
+            corr_value = d_preamble_correlator.correlation();
         }
 
     // ******* frame sync ******************
@@ -304,7 +304,7 @@ int glonass_l1_ca_telemetry_decoder_cc::general_work(int noutput_items __attribu
                     LOG(INFO) << "Preamble detection for GLONASS L1 C/A SAT " << this->d_satellite;
                     // Enter into frame pre-detection status
                     d_stat = 1;
-                    d_preamble_time_samples = d_symbol_history.at(0).Tracking_sample_counter;  // record the preamble sample stamp
+                    d_preamble_time_samples = d_symbol_history.front().Tracking_sample_counter;  // record the preamble sample stamp
                 }
         }
     else if (d_stat == 1)  // possible preamble lock
@@ -314,7 +314,7 @@ int glonass_l1_ca_telemetry_decoder_cc::general_work(int noutput_items __attribu
                     // check preamble separation
                     preamble_diff = static_cast<int32_t>(d_sample_counter - d_preamble_index);
                     // Record the PRN start sample index associated to the preamble
-                    d_preamble_time_samples = static_cast<double>(d_symbol_history.at(0).Tracking_sample_counter);
+                    d_preamble_time_samples = static_cast<double>(d_symbol_history.front().Tracking_sample_counter);
                     if (abs(preamble_diff - GLONASS_GNAV_PREAMBLE_PERIOD_SYMBOLS) == 0)
                         {
                             // try to decode frame
@@ -343,16 +343,11 @@ int glonass_l1_ca_telemetry_decoder_cc::general_work(int noutput_items __attribu
                     double string_symbols[GLONASS_GNAV_DATA_SYMBOLS] = {0};
 
                     // ******* SYMBOL TO BIT *******
+                    const Gnss_Synchro *string_start = d_symbol_history.data() + d_symbols_per_preamble;  // because last symbol of the preamble is just received now!
+                    const double polarity = corr_value > 0 ? 1.0 : -1.0;
                     for (int32_t i = 0; i < string_length; i++)
                         {
-                            if (corr_value > 0)
-                                {
-                                    string_symbols[i] = d_symbol_history.at(i + d_symbols_per_preamble).Prompt_I;  // because last symbol of the preamble is just received now!
-                                }
-                            else
-                                {
-                                    string_symbols[i] = -d_symbol_history.at(i + d_symbols_per_preamble).Prompt_I;  // because last symbol of the preamble is just received now!
-                                }
+                            string_symbols[i] = polarity * string_start[i].Prompt_I;
                         }
 
                     // call the decoder
@@ -366,7 +361,7 @@ int glonass_l1_ca_telemetry_decoder_cc::general_work(int noutput_items __attribu
                                 {
                                     d_flag_frame_sync = true;
                                     DLOG(INFO) << " Frame sync SAT " << this->d_satellite << " with preamble start at "
-                                               << d_symbol_history.at(0).Tracking_sample_counter << " [samples]";
+                                               << d_symbol_history.front().Tracking_sample_counter << " [samples]";
                                 }
                         }
                     else
@@ -437,13 +432,33 @@ int glonass_l1_ca_telemetry_decoder_cc::general_work(int noutput_items __attribu
                 }
         }
 
-    // remove used symbols from history
-    if (d_symbol_history.size() > required_symbols)
-        {
-            d_symbol_history.pop_front();
-        }
     // 3. Make the output (copy the object contents to the GNURadio reserved memory)
-    *out[0] = current_symbol;
+    out_symbol = current_symbol;
 
     return 1;
 }
+
+
+int glonass_l1_ca_telemetry_decoder_cc::general_work(int noutput_items, gr_vector_int &ninput_items,
+    gr_vector_const_void_star &input_items, gr_vector_void_star &output_items)
+{
+    Gnss_Profile_Scope profile("glonass_l1_ca_telemetry");
+    auto *out = reinterpret_cast<Gnss_Synchro *>(output_items[0]);            // Get the output buffer pointer
+    const auto *in = reinterpret_cast<const Gnss_Synchro *>(input_items[0]);  // Get the input buffer pointer
+
+    // process all the available symbols in one call, each one produces at most one output
+    const int32_t n_symbols = std::min(ninput_items[0], noutput_items);
+    int32_t n_produced = 0;
+    for (int32_t i = 0; i < n_symbols; i++)
+        {
+            const int32_t produced = process_symbol(in[i], out[n_produced]);
+            if (produced < 0)
+                {
+                    consume_each(i + 1);
+                    return produced;
+                }
+            n_produced += produced;
+        }
+    consume_each(n_symbols);
+    return n_produced;
+}
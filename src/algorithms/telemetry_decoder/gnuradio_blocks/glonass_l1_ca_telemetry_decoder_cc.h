@@ -7,7 +7,7 @@
  *
  * -------------------------------------------------------------------------
  *
- * Copyright (C) 2010-2018  (see AUTHORS file for a list of contributors)
+ * Copyright (C) 2010-2019  (see AUTHORS file for a list of contributors)
  *
  * GNSS-SDR is a software defined Global Navigation
  *          Satellite Systems receiver
@@ -41,6 +41,9 @@
 #include "glonass_gnav_utc_model.h"
 #include "gnss_satellite.h"
 #include "gnss_synchro.h"
+#include "linear_ring_buffer.h"
+#include "preamble_correlator.h"
+#include "telemetry_symbol_processor.h"
 #include <gnuradio/block.h>
 #include <fstream>
 #include <string>
@@ -58,7 +61,7 @@ glonass_l1_ca_telemetry_decoder_cc_sptr glonass_l1_ca_make_telemetry_decoder_cc(
  * \see <a href="http://russianspacesystems.ru/wp-content/uploads/2016/08/ICD_GLONASS_eng_v5.1.pdf">GLONASS ICD</a>
  *
  */
-class glonass_l1_ca_telemetry_decoder_cc : public gr::block
+class glonass_l1_ca_telemetry_decoder_cc : public gr::block, public TelemetrySymbolProcessor
 {
 public:
     ~glonass_l1_ca_telemetry_decoder_cc();                //!< Class destructor
@@ -71,6 +74,8 @@ public:
     int general_work(int noutput_items, gr_vector_int &ninput_items,
         gr_vector_const_void_star &input_items, gr_vector_void_star &output_items);
 
+    int32_t process_symbol(const Gnss_Synchro &in_symbol, Gnss_Synchro &out_symbol) override;  //!< Decodes one symbol, also called by a fused tracking block
+
 private:
     friend glonass_l1_ca_telemetry_decoder_cc_sptr
     glonass_l1_ca_make_telemetry_decoder_cc(const Gnss_Satellite &satellite, bool dump);
@@ -88,7 +93,9 @@ private:
     int32_t d_symbols_per_preamble;
 
     //!< Storage for incoming data
-    std::deque<Gnss_Synchro> d_symbol_history;
+    Linear_Ring_Buffer<Gnss_Synchro> d_symbol_history;
+    Preamble_Correlator d_preamble_correlator;
+    uint32_t d_preamble_correlation_delay;  //!< Symbols between the newest one and the end of the correlated preamble
 
     //!< Variables for internal functionality
     uint64_t d_sample_counter;    //!< Sample counter as an index (1,2,3,..etc) indicating number of samples processed
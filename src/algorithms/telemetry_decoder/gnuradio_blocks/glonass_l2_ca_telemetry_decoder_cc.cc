@@ -32,9 +32,12 @@
 
 #include "glonass_l2_ca_telemetry_decoder_cc.h"
 #include "display.h"
+#include "gnss_ephemeris_registry.h"
+#include "gnss_profiler.h"
 #include <boost/lexical_cast.hpp>
 #include <glog/logging.h>
 #include <gnuradio/io_signature.h>
+#include <algorithm>
 
 
 #define CRC_ERROR_LIMIT 6
@@ -193,9 +196,12 @@ void glonass_l2_ca_telemetry_decoder_cc::decode_string(const double *frame_symbo
             // get object for this SV (mandatory)
             d_nav.gnav_ephemeris.i_satellite_freq_channel = d_satellite.get_rf_link();
             std::shared_ptr<Glonass_Gnav_Ephemeris> tmp_obj = std::make_shared<Glonass_Gnav_Ephemeris>(d_nav.get_ephemeris());
-            this->message_port_pub(pmt::mp("telemetry"), pmt::make_any(tmp_obj));
-            LOG(INFO) << "GLONASS GNAV Ephemeris have been received in channel" << d_channel << " from satellite " << d_satellite;
-            std::cout << TEXT_CYAN << "New GLONASS L2 GNAV message received in channel " << d_channel << ": ephemeris from satellite " << d_satellite << TEXT_RESET << std::endl;
+            if (Gnss_Ephemeris_Registry::get_instance()->is_new(*tmp_obj))
+                {
+                    this->message_port_pub(pmt::mp("telemetry"), pmt::make_any(tmp_obj));
+                    LOG(INFO) << "GLONASS GNAV Ephemeris have been received in channel" << d_channel << " from satellite " << d_satellite;
+                    std::cout << TEXT_CYAN << "New GLONASS L2 GNAV message received in channel " << d_channel << ": ephemeris from satellite " << d_satellite << TEXT_RESET << std::endl;
+                }
         }
     if (d_nav.have_new_utc_model() == true)
         {
@@ -259,21 +265,17 @@ void glonass_l2_ca_telemetry_decoder_cc::set_channel(int32_t channel)
 }
 
 
-int glonass_l2_ca_telemetry_decoder_cc::general_work(int noutput_items __attribute__((unused)), gr_vector_int &ninput_items __attribute__((unused)),
-    gr_vector_const_void_star &input_items, gr_vector_void_star &output_items)
+int32_t glonass_l2_ca_telemetry_decoder_cc::process_symbol(const Gnss_Synchro &in_symbol, Gnss_Synchro &out_symbol)
 {
     int32_t corr_value = 0;
     int32_t preamble_diff = 0;
 
-    auto **out = reinterpret_cast<Gnss_Synchro **>(&output_items[0]);            // Get the output buffer pointer
-    const auto **in = reinterpret_cast<const Gnss_Synchro **>(&input_items[0]);  // Get the input buffer pointer
 
     Gnss_Synchro current_symbol{};  // structure to save the synchronization information and send the output object to the next block
     // 1. Copy the current tracking output
-    current_symbol = in[0][0];
+    current_symbol = in_symbol;
     d_symbol_history.push_back(current_symbol);  // add new symbol to the symbol queue
     d_sample_counter++;                          // count for the processed samples
-    consume_each(1);
 
     d_flag_preamble = false;
     uint32_t required_symbols = GLONASS_GNAV_STRING_SYMBOLS;
@@ -443,7 +445,32 @@ int glonass_l2_ca_telemetry_decoder_cc::general_work(int noutput_items __attribu
             d_symbol_history.pop_front();
         }
     // 3. Make the output (copy the object contents to the GNURadio reserved memory)
-    *out[0] = current_symbol;
+    out_symbol = current_symbol;
 
     return 1;
 }
+
+
+int glonass_l2_ca_telemetry_decoder_cc::general_work(int noutput_items, gr_vector_int &ninput_items,
+    gr_vector_const_void_star &input_items, gr_vector_void_star &output_items)
+{
+    Gnss_Profile_Scope profile("glonass_l2_ca_telemetry");
+    auto *out = reinterpret_cast<Gnss_Synchro *>(output_items[0]);            // Get the output buffer pointer
+    const auto *in = reinterpret_cast<const Gnss_Synchro *>(input_items[0]);  // Get the input buffer pointer
+
+    // process all the available symbols in one call, each one produces at most one output
+    const int32_t n_symbols = std::min(ninput_items[0], noutput_items);
+    int32_t n_produced = 0;
+    for (int32_t i = 0; i < n_symbols; i++)
+        {
+            const int32_t produced = process_symbol(in[i], out[n_produced]);
+            if (produced < 0)
+                {
+                    consume_each(i + 1);
+                    return produced;
+                }
+            n_produced += produced;
+        }
+    consume_each(n_symbols);
+    return n_produced;
+}
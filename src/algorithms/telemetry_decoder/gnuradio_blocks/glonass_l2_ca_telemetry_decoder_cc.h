@@ -6,7 +6,7 @@
  *
  * -------------------------------------------------------------------------
  *
- * Copyright (C) 2010-2018  (see AUTHORS file for a list of contributors)
+ * Copyright (C) 2010-2019  (see AUTHORS file for a list of contributors)
  *
  * GNSS-SDR is a software defined Global Navigation
  *          Satellite Systems receiver
@@ -40,6 +40,7 @@
 #include "glonass_gnav_utc_model.h"
 #include "gnss_satellite.h"
 #include "gnss_synchro.h"
+#include "telemetry_symbol_processor.h"
 #include <gnuradio/block.h>
 #include <fstream>
 #include <string>
@@ -56,7 +57,7 @@ glonass_l2_ca_telemetry_decoder_cc_sptr glonass_l2_ca_make_telemetry_decoder_cc(
  * \see <a href="http://russianspacesystems.ru/wp-content/uploads/2016/08/ICD_GLONASS_eng_v5.1.pdf">GLONASS ICD</a>
  *
  */
-class glonass_l2_ca_telemetry_decoder_cc : public gr::block
+class glonass_l2_ca_telemetry_decoder_cc : public gr::block, public TelemetrySymbolProcessor
 {
 public:
     ~glonass_l2_ca_telemetry_decoder_cc();                //!< Class destructor
@@ -69,6 +70,8 @@ public:
     int general_work(int noutput_items, gr_vector_int &ninput_items,
         gr_vector_const_void_star &input_items, gr_vector_void_star &output_items);
 
+    int32_t process_symbol(const Gnss_Synchro &in_symbol, Gnss_Synchro &out_symbol) override;  //!< Decodes one symbol, also called by a fused tracking block
+
 private:
     friend glonass_l2_ca_telemetry_decoder_cc_sptr
     glonass_l2_ca_make_telemetry_decoder_cc(const Gnss_Satellite &satellite, bool dump);
@@ -31,10 +31,14 @@
 
 #include "gps_l1_ca_telemetry_decoder_cc.h"
 #include "control_message_factory.h"
+#include "gnss_ephemeris_registry.h"
+#include "gnss_profiler.h"
 #include <boost/lexical_cast.hpp>
 #include <glog/logging.h>
 #include <gnuradio/io_signature.h>
 #include <volk_gnsssdr/volk_gnsssdr.h>
+#include <algorithm>
+#include <cstring>
 
 
 #ifndef _rotl
@@ -44,16 +48,18 @@
 using google::LogMessage;
 
 gps_l1_ca_telemetry_decoder_cc_sptr
-gps_l1_ca_make_telemetry_decoder_cc(const Gnss_Satellite &satellite, bool dump)
+gps_l1_ca_make_telemetry_decoder_cc(const Gnss_Satellite &satellite, bool dump, const Gnss_Dump_Policy_Conf &dump_policy)
 {
-    return gps_l1_ca_telemetry_decoder_cc_sptr(new gps_l1_ca_telemetry_decoder_cc(satellite, dump));
+    return gps_l1_ca_telemetry_decoder_cc_sptr(new gps_l1_ca_telemetry_decoder_cc(satellite, dump, dump_policy));
 }
 
 
 gps_l1_ca_telemetry_decoder_cc::gps_l1_ca_telemetry_decoder_cc(
     const Gnss_Satellite &satellite,
-    bool dump) : gr::block("gps_navigation_cc", gr::io_signature::make(1, 1, sizeof(Gnss_Synchro)),
-                     gr::io_signature::make(1, 1, sizeof(Gnss_Synchro)))
+    bool dump,
+    const Gnss_Dump_Policy_Conf &dump_policy) : gr::block("gps_navigation_cc", gr::io_signature::make(1, 1, sizeof(Gnss_Synchro)),
+                                                    gr::io_signature::make(1, 1, sizeof(Gnss_Synchro))),
+                                                d_dump_policy(dump_policy)
 {
     // Ephemeris data port out
     this->message_port_register_out(pmt::mp("telemetry"));
@@ -94,6 +100,7 @@ gps_l1_ca_telemetry_decoder_cc::gps_l1_ca_telemetry_decoder_cc(
     d_preamble_time_samples = 0ULL;
     d_TOW_at_current_symbol_ms = 0;
     d_symbol_history.set_capacity(GPS_CA_PREAMBLE_LENGTH_SYMBOLS);
+    d_preamble_correlator.set_preamble(d_preambles_symbols, GPS_CA_PREAMBLE_LENGTH_SYMBOLS);
     d_crc_error_synchronization_counter = 0;
     d_current_subframe_symbol = 0;
 }
@@ -171,6 +178,8 @@ void gps_l1_ca_telemetry_decoder_cc::set_channel(int32_t channel)
                             d_dump_filename.append(".dat");
                             d_dump_file.exceptions(std::ifstream::failbit | std::ifstream::badbit);
                             d_dump_file.open(d_dump_filename.c_str(), std::ios::out | std::ios::binary);
+                            d_dump_policy.set_channel(d_channel);
+                            d_dump_policy.set_writer("telemetry decoder channel " + std::to_string(d_channel), DUMP_RECORD_BYTES, 1000.0, [this](const char *record) { write_dump_record(record); });
                             LOG(INFO) << "Telemetry decoder dump enabled on channel " << d_channel
                                       << " Log file: " << d_dump_filename.c_str();
                         }
@@ -183,6 +192,28 @@ void gps_l1_ca_telemetry_decoder_cc::set_channel(int32_t channel)
 }
 
 
+void gps_l1_ca_telemetry_decoder_cc::write_dump_record(const char *record)
+{
+    try
+        {
+            d_dump_file.write(record, DUMP_RECORD_BYTES);
+        }
+    catch (const std::ifstream::failure &e)
+        {
+            LOG(WARNING) << "Exception writing telemetry dump file " << e.what();
+        }
+}
+
+
+void gps_l1_ca_telemetry_decoder_cc::lost_frame_sync(const Gnss_Synchro &symbol)
+{
+    if (d_dump)
+        {
+            d_dump_policy.trigger("loss of frame sync", static_cast<double>(symbol.Tracking_sample_counter) / static_cast<double>(symbol.fs));
+        }
+}
+
+
 bool gps_l1_ca_telemetry_decoder_cc::decode_subframe()
 {
     char subframe[GPS_SUBFRAME_LENGTH];
@@ -274,7 +305,11 @@ bool gps_l1_ca_telemetry_decoder_cc::decode_subframe()
                                 {
                                     // get ephemeris object for this SV (mandatory)
                                     std::shared_ptr<Gps_Ephemeris> tmp_obj = std::make_shared<Gps_Ephemeris>(d_nav.get_ephemeris());
-                                    this->message_port_pub(pmt::mp("telemetry"), pmt::make_any(tmp_obj));
+                                    // publish it only if no other channel did it before
+                                    if (Gnss_Ephemeris_Registry::get_instance()->is_new(*tmp_obj))
+                                        {
+                                            this->message_port_pub(pmt::mp("telemetry"), pmt::make_any(tmp_obj));
+                                        }
                                 }
                             break;
                         case 4:  // Possible IONOSPHERE and UTC model update (page 18)
@@ -308,17 +343,14 @@ bool gps_l1_ca_telemetry_decoder_cc::decode_subframe()
 }
 
 
-int gps_l1_ca_telemetry_decoder_cc::general_work(int noutput_items __attribute__((unused)), gr_vector_int &ninput_items __attribute__((unused)),
-    gr_vector_const_void_star &input_items, gr_vector_void_star &output_items)
+int32_t gps_l1_ca_telemetry_decoder_cc::process_symbol(const Gnss_Synchro &in_symbol, Gnss_Synchro &out_symbol)
 {
     int32_t preamble_diff_ms = 0;
 
-    auto **out = reinterpret_cast<Gnss_Synchro **>(&output_items[0]);            // Get the output buffer pointer
-    const auto **in = reinterpret_cast<const Gnss_Synchro **>(&input_items[0]);  // Get the input buffer pointer
 
     Gnss_Synchro current_symbol{};  // structure to save the synchronization information and send the output object to the next block
     // 1. Copy the current tracking output
-    current_symbol = in[0][0];
+    current_symbol = in_symbol;
 
     // record the oldest subframe symbol before inserting a new symbol into the circular buffer
     if (d_current_subframe_symbol < GPS_SUBFRAME_MS and !d_symbol_history.empty())
@@ -328,29 +360,15 @@ int gps_l1_ca_telemetry_decoder_cc::general_work(int noutput_items __attribute__
         }
 
     d_symbol_history.push_back(current_symbol);  // add new symbol to the symbol queue
-    consume_each(1);
+    d_preamble_correlator.push_symbol(current_symbol.Prompt_I, current_symbol.Flag_valid_symbol_output);
 
     d_flag_preamble = false;
 
     // ******* preamble correlation ********
     int32_t corr_value = 0;
-    if ((d_symbol_history.size() == GPS_CA_PREAMBLE_LENGTH_SYMBOLS))  // and (d_make_correlation or !d_flag_frame_sync))
+    if (d_preamble_correlator.full())  // and (d_make_correlation or !d_flag_frame_sync))
         {
-            // std::cout << "-------\n";
-            for (uint32_t i = 0; i < GPS_CA_PREAMBLE_LENGTH_SYMBOLS; i++)
-                {
-                    if (d_symbol_history[i].Flag_valid_symbol_output == true)
-                        {
-                            if (d_symbol_history[i].Prompt_I < 0)  // symbols clipping
-                                {
-                                    corr_value -= d_preambles_symbols[i];
-                                }
-                            else
-                                {
-                                    corr_value += d_preambles_symbols[i];
-                                }
-                        }
-                }
+            corr_value = d_preamble_correlator.correlation();
         }
 
     // ******* frame sync ******************
@@ -395,6 +413,7 @@ int gps_l1_ca_telemetry_decoder_cc::general_work(int noutput_items __attribute__
                                     if (d_crc_error_synchronization_counter > 3)
                                         {
                                             DLOG(INFO) << "TOO MANY CRC ERRORS: Lost of frame sync SAT " << this->d_satellite << std::endl;
+                                            lost_frame_sync(in_symbol);
                                             d_stat = 0;  // lost of frame sync
                                             d_flag_frame_sync = false;
                                             flag_TOW_set = false;
@@ -414,6 +433,7 @@ int gps_l1_ca_telemetry_decoder_cc::general_work(int noutput_items __attribute__
                         {
                             DLOG(INFO) << "Lost of frame sync SAT " << this->d_satellite << " preamble_diff= " << preamble_diff_ms;
                             //  std::cout << "Lost of frame sync SAT " << this->d_satellite << " preamble_diff= " << preamble_diff_ms << std::endl;
+                            lost_frame_sync(in_symbol);
                             d_stat = 0;  // lost of frame sync
                             d_flag_frame_sync = false;
                             flag_TOW_set = false;
@@ -453,26 +473,21 @@ int gps_l1_ca_telemetry_decoder_cc::general_work(int noutput_items __attribute__
 
             if (d_dump == true)
                 {
-                    // MULTIPLEXED FILE RECORDING - Record results to file
-                    try
-                        {
-                            double tmp_double;
-                            uint64_t tmp_ulong_int;
-                            tmp_double = static_cast<double>(d_TOW_at_current_symbol_ms) / 1000.0;
-                            d_dump_file.write(reinterpret_cast<char *>(&tmp_double), sizeof(double));
-                            tmp_ulong_int = current_symbol.Tracking_sample_counter;
-                            d_dump_file.write(reinterpret_cast<char *>(&tmp_ulong_int), sizeof(uint64_t));
-                            tmp_double = static_cast<double>(d_TOW_at_Preamble_ms) / 1000.0;
-                            d_dump_file.write(reinterpret_cast<char *>(&tmp_double), sizeof(double));
-                        }
-                    catch (const std::ifstream::failure &e)
-                        {
-                            LOG(WARNING) << "Exception writing observables dump file " << e.what();
-                        }
+                    // MULTIPLEXED FILE RECORDING - Record results to file, if the dump policy lets it through
+                    char record[DUMP_RECORD_BYTES];
+                    double tmp_double;
+                    uint64_t tmp_ulong_int;
+                    tmp_double = static_cast<double>(d_TOW_at_current_symbol_ms) / 1000.0;
+                    memcpy(record, &tmp_double, sizeof(double));
+                    tmp_ulong_int = current_symbol.Tracking_sample_counter;
+                    memcpy(record + sizeof(double), &tmp_ulong_int, sizeof(uint64_t));
+                    tmp_double = static_cast<double>(d_TOW_at_Preamble_ms) / 1000.0;
+                    memcpy(record + sizeof(double) + sizeof(uint64_t), &tmp_double, sizeof(double));
+                    d_dump_policy.dump(record, static_cast<double>(current_symbol.Tracking_sample_counter) / static_cast<double>(current_symbol.fs), current_symbol.PRN);
                 }
 
             // 3. Make the output (copy the object contents to the GNURadio reserved memory)
-            *out[0] = current_symbol;
+            out_symbol = current_symbol;
 
             return 1;
         }
@@ -480,3 +495,28 @@ int gps_l1_ca_telemetry_decoder_cc::general_work(int noutput_items __attribute__
 
     return 0;
 }
+
+
+int gps_l1_ca_telemetry_decoder_cc::general_work(int noutput_items, gr_vector_int &ninput_items,
+    gr_vector_const_void_star &input_items, gr_vector_void_star &output_items)
+{
+    Gnss_Profile_Scope profile("gps_l1_ca_telemetry");
+    auto *out = reinterpret_cast<Gnss_Synchro *>(output_items[0]);            // Get the output buffer pointer
+    const auto *in = reinterpret_cast<const Gnss_Synchro *>(input_items[0]);  // Get the input buffer pointer
+
+    // process all the available symbols in one call, each one produces at most one output
+    const int32_t n_symbols = std::min(ninput_items[0], noutput_items);
+    int32_t n_produced = 0;
+    for (int32_t i = 0; i < n_symbols; i++)
+        {
+            const int32_t produced = process_symbol(in[i], out[n_produced]);
+            if (produced < 0)
+                {
+                    consume_each(i + 1);
+                    return produced;
+                }
+            n_produced += produced;
+        }
+    consume_each(n_symbols);
+    return n_produced;
+}
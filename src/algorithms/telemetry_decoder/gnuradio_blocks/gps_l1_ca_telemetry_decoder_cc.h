@@ -5,7 +5,7 @@
  * \author Javier Arribas, 2011. jarribas(at)cttc.es
  * -------------------------------------------------------------------------
  *
- * Copyright (C) 2010-2018  (see AUTHORS file for a list of contributors)
+ * Copyright (C) 2010-2019  (see AUTHORS file for a list of contributors)
  *
  * GNSS-SDR is a software defined Global Navigation
  *          Satellite Systems receiver
@@ -34,7 +34,10 @@
 #include "GPS_L1_CA.h"
 #include "gnss_satellite.h"
 #include "gnss_synchro.h"
+#include "preamble_correlator.h"
 #include "gps_navigation_message.h"
+#include "telemetry_symbol_processor.h"
+#include "gnss_dump_policy.h"
 #include <boost/circular_buffer.hpp>
 #include <gnuradio/block.h>
 #include <fstream>
@@ -45,13 +48,13 @@ class gps_l1_ca_telemetry_decoder_cc;
 typedef boost::shared_ptr<gps_l1_ca_telemetry_decoder_cc> gps_l1_ca_telemetry_decoder_cc_sptr;
 
 gps_l1_ca_telemetry_decoder_cc_sptr
-gps_l1_ca_make_telemetry_decoder_cc(const Gnss_Satellite &satellite, bool dump);
+gps_l1_ca_make_telemetry_decoder_cc(const Gnss_Satellite &satellite, bool dump, const Gnss_Dump_Policy_Conf &dump_policy = Gnss_Dump_Policy_Conf());
 
 /*!
  * \brief This class implements a block that decodes the NAV data defined in IS-GPS-200E
  *
  */
-class gps_l1_ca_telemetry_decoder_cc : public gr::block
+class gps_l1_ca_telemetry_decoder_cc : public gr::block, public TelemetrySymbolProcessor
 {
 public:
     ~gps_l1_ca_telemetry_decoder_cc();
@@ -64,11 +67,16 @@ public:
     int general_work(int noutput_items, gr_vector_int &ninput_items,
         gr_vector_const_void_star &input_items, gr_vector_void_star &output_items);
 
+    int32_t process_symbol(const Gnss_Synchro &in_symbol, Gnss_Synchro &out_symbol) override;  //!< Decodes one symbol, also called by a fused tracking block
+
 private:
     friend gps_l1_ca_telemetry_decoder_cc_sptr
-    gps_l1_ca_make_telemetry_decoder_cc(const Gnss_Satellite &satellite, bool dump);
+    gps_l1_ca_make_telemetry_decoder_cc(const Gnss_Satellite &satellite, bool dump, const Gnss_Dump_Policy_Conf &dump_policy);
+
+    gps_l1_ca_telemetry_decoder_cc(const Gnss_Satellite &satellite, bool dump, const Gnss_Dump_Policy_Conf &dump_policy);
 
-    gps_l1_ca_telemetry_decoder_cc(const Gnss_Satellite &satellite, bool dump);
+    void write_dump_record(const char *record);
+    void lost_frame_sync(const Gnss_Synchro &symbol);
 
     bool gps_word_parityCheck(uint32_t gpsword);
 
@@ -82,6 +90,7 @@ private:
 
     // symbols
     boost::circular_buffer<Gnss_Synchro> d_symbol_history;
+    Preamble_Correlator d_preamble_correlator;  // slides over the same symbols as d_symbol_history
     float d_subframe_symbols[GPS_SUBFRAME_MS]{};  // symbols per subframe
     int d_current_subframe_symbol;
 
@@ -107,6 +116,8 @@ private:
 
     std::string d_dump_filename;
     std::ofstream d_dump_file;
+    Gnss_Dump_Policy d_dump_policy;  // decimation, filters and triggered mode of the dump
+    static const size_t DUMP_RECORD_BYTES = 2 * sizeof(double) + sizeof(uint64_t);
 };
 
 #endif
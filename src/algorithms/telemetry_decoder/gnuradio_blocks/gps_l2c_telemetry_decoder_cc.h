@@ -5,7 +5,7 @@
  * \author Javier Arribas, 2015. jarribas(at)cttc.es
  * -------------------------------------------------------------------------
  *
- * Copyright (C) 2010-2018  (see AUTHORS file for a list of contributors)
+ * Copyright (C) 2010-2019  (see AUTHORS file for a list of contributors)
  *
  * GNSS-SDR is a software defined Global Navigation
  *          Satellite Systems receiver
@@ -33,6 +33,7 @@
 
 
 #include "gnss_satellite.h"
+#include "gnss_synchro.h"
 #include "gps_cnav_ephemeris.h"
 #include "gps_cnav_iono.h"
 #include "gps_cnav_navigation_message.h"
@@ -54,6 +55,7 @@ extern "C"
 }
 
 #include "GPS_L2C.h"
+#include "telemetry_symbol_processor.h"
 
 class gps_l2c_telemetry_decoder_cc;
 
@@ -66,7 +68,7 @@ gps_l2c_make_telemetry_decoder_cc(const Gnss_Satellite &satellite, bool dump);
  * \brief This class implements a block that decodes the SBAS integrity and corrections data defined in RTCA MOPS DO-229
  *
  */
-class gps_l2c_telemetry_decoder_cc : public gr::block
+class gps_l2c_telemetry_decoder_cc : public gr::block, public TelemetrySymbolProcessor
 {
 public:
     ~gps_l2c_telemetry_decoder_cc();
@@ -79,6 +81,8 @@ public:
     int general_work(int noutput_items, gr_vector_int &ninput_items,
         gr_vector_const_void_star &input_items, gr_vector_void_star &output_items);
 
+    int32_t process_symbol(const Gnss_Synchro &in_symbol, Gnss_Synchro &out_symbol) override;  //!< Decodes one symbol, also called by a fused tracking block
+
 private:
     friend gps_l2c_telemetry_decoder_cc_sptr
     gps_l2c_make_telemetry_decoder_cc(const Gnss_Satellite &satellite, bool dump);
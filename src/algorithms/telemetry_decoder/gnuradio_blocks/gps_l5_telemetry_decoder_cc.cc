@@ -31,12 +31,15 @@
 
 #include "gps_l5_telemetry_decoder_cc.h"
 #include "display.h"
+#include "gnss_ephemeris_registry.h"
+#include "gnss_profiler.h"
 #include "gnss_synchro.h"
 #include "gps_cnav_ephemeris.h"
 #include "gps_cnav_iono.h"
 #include <boost/lexical_cast.hpp>
 #include <glog/logging.h>
 #include <gnuradio/io_signature.h>
+#include <algorithm>
 #include <bitset>
 #include <iostream>
 #include <sstream>
@@ -137,19 +140,13 @@ void gps_l5_telemetry_decoder_cc::set_channel(int32_t channel)
 }
 
 
-int gps_l5_telemetry_decoder_cc::general_work(int noutput_items __attribute__((unused)), gr_vector_int &ninput_items __attribute__((unused)),
-    gr_vector_const_void_star &input_items, gr_vector_void_star &output_items)
+int32_t gps_l5_telemetry_decoder_cc::process_symbol(const Gnss_Synchro &in_symbol, Gnss_Synchro &out_symbol)
 {
-    // get pointers on in- and output gnss-synchro objects
-    auto *out = reinterpret_cast<Gnss_Synchro *>(output_items[0]);            // Get the output buffer pointer
-    const auto *in = reinterpret_cast<const Gnss_Synchro *>(input_items[0]);  // Get the input buffer pointer
-
     // UPDATE GNSS SYNCHRO DATA
     Gnss_Synchro current_synchro_data{};  //structure to save the synchronization information and send the output object to the next block
     // 1. Copy the current tracking output
-    current_synchro_data = in[0];
-    consume_each(1);  //one by one
-    sym_hist.push_back(in[0].Prompt_I);
+    current_synchro_data = in_symbol;
+    sym_hist.push_back(in_symbol.Prompt_I);
     int32_t corr_NH = 0;
     int32_t symbol_value = 0;
 
@@ -218,8 +215,11 @@ int gps_l5_telemetry_decoder_cc::general_work(int noutput_items __attribute__((u
                 {
                     // get ephemeris object for this SV
                     std::shared_ptr<Gps_CNAV_Ephemeris> tmp_obj = std::make_shared<Gps_CNAV_Ephemeris>(d_CNAV_Message.get_ephemeris());
-                    std::cout << TEXT_MAGENTA << "New GPS L5 CNAV message received in channel " << d_channel << ": ephemeris from satellite " << d_satellite << TEXT_RESET << std::endl;
-                    this->message_port_pub(pmt::mp("telemetry"), pmt::make_any(tmp_obj));
+                    if (Gnss_Ephemeris_Registry::get_instance()->is_new(*tmp_obj))
+                        {
+                            std::cout << TEXT_MAGENTA << "New GPS L5 CNAV message received in channel " << d_channel << ": ephemeris from satellite " << d_satellite << TEXT_RESET << std::endl;
+                            this->message_port_pub(pmt::mp("telemetry"), pmt::make_any(tmp_obj));
+                        }
                 }
             if (d_CNAV_Message.have_new_iono() == true)
                 {
@@ -279,8 +279,33 @@ int gps_l5_telemetry_decoder_cc::general_work(int noutput_items __attribute__((u
                 }
 
             // 3. Make the output (copy the object contents to the GNURadio reserved memory)
-            out[0] = current_synchro_data;
+            out_symbol = current_synchro_data;
             return 1;
         }
     return 0;
 }
+
+
+int gps_l5_telemetry_decoder_cc::general_work(int noutput_items, gr_vector_int &ninput_items,
+    gr_vector_const_void_star &input_items, gr_vector_void_star &output_items)
+{
+    Gnss_Profile_Scope profile("gps_l5_telemetry");
+    auto *out = reinterpret_cast<Gnss_Synchro *>(output_items[0]);            // Get the output buffer pointer
+    const auto *in = reinterpret_cast<const Gnss_Synchro *>(input_items[0]);  // Get the input buffer pointer
+
+    // process all the available symbols in one call, each one produces at most one output
+    const int32_t n_symbols = std::min(ninput_items[0], noutput_items);
+    int32_t n_produced = 0;
+    for (int32_t i = 0; i < n_symbols; i++)
+        {
+            const int32_t produced = process_symbol(in[i], out[n_produced]);
+            if (produced < 0)
+                {
+                    consume_each(i + 1);
+                    return produced;
+                }
+            n_produced += produced;
+        }
+    consume_each(n_symbols);
+    return n_produced;
+}
@@ -4,7 +4,7 @@
  * \author Antonio Ramos, 2017. antonio.ramos(at)cttc.es
  * -------------------------------------------------------------------------
  *
- * Copyright (C) 2010-2018  (see AUTHORS file for a list of contributors)
+ * Copyright (C) 2010-2019  (see AUTHORS file for a list of contributors)
  *
  * GNSS-SDR is a software defined Global Navigation
  *          Satellite Systems receiver
@@ -32,6 +32,7 @@
 
 
 #include "gnss_satellite.h"
+#include "gnss_synchro.h"
 #include "gps_cnav_navigation_message.h"
 #include <gnuradio/block.h>
 #include <algorithm>
@@ -50,6 +51,7 @@ extern "C"
 }
 
 #include "GPS_L5.h"
+#include "telemetry_symbol_processor.h"
 
 class gps_l5_telemetry_decoder_cc;
 
@@ -62,7 +64,7 @@ gps_l5_make_telemetry_decoder_cc(const Gnss_Satellite &satellite, bool dump);
  * \brief This class implements a GPS L5 Telemetry decoder
  *
  */
-class gps_l5_telemetry_decoder_cc : public gr::block
+class gps_l5_telemetry_decoder_cc : public gr::block, public TelemetrySymbolProcessor
 {
 public:
     ~gps_l5_telemetry_decoder_cc();
@@ -71,6 +73,8 @@ public:
     int general_work(int noutput_items, gr_vector_int &ninput_items,
         gr_vector_const_void_star &input_items, gr_vector_void_star &output_items);
 
+    int32_t process_symbol(const Gnss_Synchro &in_symbol, Gnss_Synchro &out_symbol) override;  //!< Decodes one symbol, also called by a fused tracking block
+
 private:
     friend gps_l5_telemetry_decoder_cc_sptr
     gps_l5_make_telemetry_decoder_cc(const Gnss_Satellite &satellite, bool dump);
@@ -30,10 +30,12 @@
 
 #include "sbas_l1_telemetry_decoder_cc.h"
 #include "control_message_factory.h"
+#include "gnss_profiler.h"
 #include "gnss_synchro.h"
 #include <boost/lexical_cast.hpp>
 #include <glog/logging.h>
 #include <gnuradio/io_signature.h>
+#include <algorithm>
 #include <sstream>
 
 
@@ -219,8 +221,9 @@ bool sbas_l1_telemetry_decoder_cc::symbol_aligner_and_decoder::get_bits(const st
     int32_t nbits_requested = symbols.size() / d_symbols_per_bit;
     int32_t nbits_decoded;
     // fill two vectors with the two possible symbol alignments
-    std::vector<double> symbols_vd1(symbols);  // aligned symbol vector -> copy input symbol vector
-    std::vector<double> symbols_vd2;           // shifted symbol vector -> add past sample in front of input vector
+    std::vector<float> symbols_vd1(symbols.cbegin(), symbols.cend());  // aligned symbol vector -> copy input symbol vector
+    std::vector<float> symbols_vd2;                                    // shifted symbol vector -> add past sample in front of input vector
+    symbols_vd2.reserve(symbols.size());
     symbols_vd2.push_back(d_past_symbol);
     for (auto symbol_it = symbols.cbegin(); symbol_it != symbols.cend() - 1; ++symbol_it)
         {
@@ -416,23 +419,16 @@ void sbas_l1_telemetry_decoder_cc::crc_verifier::zerropad_front_and_convert_to_b
 }
 
 
-int sbas_l1_telemetry_decoder_cc::general_work(int noutput_items __attribute__((unused)), gr_vector_int &ninput_items __attribute__((unused)),
-    gr_vector_const_void_star &input_items, gr_vector_void_star &output_items)
+int32_t sbas_l1_telemetry_decoder_cc::process_symbol(const Gnss_Synchro &in_symbol, Gnss_Synchro &out_symbol)
 {
-    VLOG(FLOW) << "general_work(): "
-               << "noutput_items=" << noutput_items << "\toutput_items real size=" << output_items.size() << "\tninput_items size=" << ninput_items.size() << "\tinput_items real size=" << input_items.size() << "\tninput_items[0]=" << ninput_items[0];
-    // get pointers on in- and output gnss-synchro objects
-    auto *out = reinterpret_cast<Gnss_Synchro *>(output_items[0]);            // Get the output buffer pointer
-    const auto *in = reinterpret_cast<const Gnss_Synchro *>(input_items[0]);  // Get the input buffer pointer
-
     Gnss_Synchro current_symbol{};  // structure to save the synchronization information and send the output object to the next block
     // 1. Copy the current tracking output
-    current_symbol = in[0];
+    current_symbol = in_symbol;
     // copy correlation samples into samples vector
     d_sample_buf.push_back(current_symbol.Prompt_I);  //add new symbol to the symbol queue
 
     // store the time stamp of the first sample in the processed sample block
-    double sample_stamp = static_cast<double>(in[0].Tracking_sample_counter) / static_cast<double>(in[0].fs);
+    double sample_stamp = static_cast<double>(in_symbol.Tracking_sample_counter) / static_cast<double>(in_symbol.fs);
 
     // decode only if enough samples in buffer
     if (d_sample_buf.size() >= d_block_size)
@@ -491,7 +487,33 @@ int sbas_l1_telemetry_decoder_cc::general_work(int noutput_items __attribute__((
     // UPDATE GNSS SYNCHRO DATA
     // actually the SBAS telemetry decoder doesn't support ranging
     current_symbol.Flag_valid_word = false;  // indicate to observable block that this synchro object isn't valid for pseudorange computation
-    out[0] = current_symbol;
-    consume_each(1);  // tell scheduler input items consumed
-    return 1;         // tell scheduler output items produced
+    out_symbol = current_symbol;
+    return 1;
+}
+
+
+int sbas_l1_telemetry_decoder_cc::general_work(int noutput_items, gr_vector_int &ninput_items,
+    gr_vector_const_void_star &input_items, gr_vector_void_star &output_items)
+{
+    Gnss_Profile_Scope profile("sbas_l1_telemetry");
+    VLOG(FLOW) << "general_work(): "
+               << "noutput_items=" << noutput_items << "\toutput_items real size=" << output_items.size() << "\tninput_items size=" << ninput_items.size() << "\tinput_items real size=" << input_items.size() << "\tninput_items[0]=" << ninput_items[0];
+    auto *out = reinterpret_cast<Gnss_Synchro *>(output_items[0]);            // Get the output buffer pointer
+    const auto *in = reinterpret_cast<const Gnss_Synchro *>(input_items[0]);  // Get the input buffer pointer
+
+    // process all the available symbols in one call, each one produces at most one output
+    const int32_t n_symbols = std::min(ninput_items[0], noutput_items);
+    int32_t n_produced = 0;
+    for (int32_t i = 0; i < n_symbols; i++)
+        {
+            const int32_t produced = process_symbol(in[i], out[n_produced]);
+            if (produced < 0)
+                {
+                    consume_each(i + 1);
+                    return produced;
+                }
+            n_produced += produced;
+        }
+    consume_each(n_symbols);
+    return n_produced;
 }
@@ -5,7 +5,7 @@
  *
  * -------------------------------------------------------------------------
  *
- * Copyright (C) 2010-2018  (see AUTHORS file for a list of contributors)
+ * Copyright (C) 2010-2019  (see AUTHORS file for a list of contributors)
  *
  * GNSS-SDR is a software defined Global Navigation
  *          Satellite Systems receiver
@@ -32,6 +32,8 @@
 #define GNSS_SDR_SBAS_L1_TELEMETRY_DECODER_CC_H
 
 #include "gnss_satellite.h"
+#include "gnss_synchro.h"
+#include "telemetry_symbol_processor.h"
 #include "viterbi_decoder.h"
 #include <boost/crc.hpp>
 #include <gnuradio/block.h>
@@ -55,7 +57,7 @@ sbas_l1_make_telemetry_decoder_cc(const Gnss_Satellite &satellite, bool dump);
  * \brief This class implements a block that decodes the SBAS integrity and corrections data defined in RTCA MOPS DO-229
  *
  */
-class sbas_l1_telemetry_decoder_cc : public gr::block
+class sbas_l1_telemetry_decoder_cc : public gr::block, public TelemetrySymbolProcessor
 {
 public:
     ~sbas_l1_telemetry_decoder_cc();
@@ -68,6 +70,8 @@ public:
     int general_work(int noutput_items, gr_vector_int &ninput_items,
         gr_vector_const_void_star &input_items, gr_vector_void_star &output_items);
 
+    int32_t process_symbol(const Gnss_Synchro &in_symbol, Gnss_Synchro &out_symbol) override;  //!< Decodes one symbol, also called by a fused tracking block
+
 private:
     friend sbas_l1_telemetry_decoder_cc_sptr
     sbas_l1_make_telemetry_decoder_cc(const Gnss_Satellite &satellite, bool dump);
@@ -0,0 +1,105 @@
+/*!
+ * \file gnss_ephemeris_registry.cc
+ * \brief Process-wide record of the last ephemeris issue published for each
+ * satellite, used to drop the copies decoded by other channels and bands.
+ *
+ *
+ * -------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2018  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *          Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------
+ */
+
+#include "gnss_ephemeris_registry.h"
+
+
+Gnss_Ephemeris_Registry::Gnss_Ephemeris_Registry()
+{
+    clear();
+}
+
+
+std::shared_ptr<Gnss_Ephemeris_Registry> Gnss_Ephemeris_Registry::get_instance()
+{
+    static std::shared_ptr<Gnss_Ephemeris_Registry> instance = std::make_shared<Gnss_Ephemeris_Registry>();
+    return instance;
+}
+
+
+bool Gnss_Ephemeris_Registry::is_new(Navigation_Message message, uint32_t prn, uint64_t issue)
+{
+    if (prn >= MAX_PRN)
+        {
+            return true;  // not tracked, always publish it
+        }
+    const uint64_t recorded = issue | ISSUE_RECORDED;
+    // the exchange is atomic: of several channels racing with the same issue only one sees the old value
+    return d_issues[message][prn].exchange(recorded, std::memory_order_relaxed) != recorded;
+}
+
+
+bool Gnss_Ephemeris_Registry::is_new(const Gps_Ephemeris& eph)
+{
+    const uint64_t issue = (static_cast<uint64_t>(static_cast<uint32_t>(eph.d_Toe)) << 32) |
+                           (static_cast<uint64_t>(eph.d_IODC & 0x3FF) << 16) |
+                           (static_cast<uint64_t>(eph.d_IODE_SF2 & 0xFF) << 8) |
+                           static_cast<uint64_t>(eph.d_IODE_SF3 & 0xFF);
+    return is_new(GPS_LNAV, eph.i_satellite_PRN, issue);
+}
+
+
+bool Gnss_Ephemeris_Registry::is_new(const Gps_CNAV_Ephemeris& eph)
+{
+    // CNAV has no IODE: an upload is identified by its reference times (< 2^20 s each)
+    const uint64_t issue = (static_cast<uint64_t>(eph.d_Toe1 & 0xFFFFF) << 40) |
+                           (static_cast<uint64_t>(eph.d_Toe2 & 0xFFFFF) << 20) |
+                           static_cast<uint64_t>(eph.d_Toc & 0xFFFFF);
+    return is_new(GPS_CNAV, eph.i_satellite_PRN, issue);
+}
+
+
+bool Gnss_Ephemeris_Registry::is_new(const Galileo_Ephemeris& eph, Navigation_Message message)
+{
+    const uint64_t issue = (static_cast<uint64_t>(static_cast<uint32_t>(eph.t0e_1)) << 16) |
+                           static_cast<uint64_t>(eph.IOD_ephemeris & 0x3FF);
+    return is_new(message, eph.i_satellite_PRN, issue);
+}
+
+
+bool Gnss_Ephemeris_Registry::is_new(const Glonass_Gnav_Ephemeris& eph)
+{
+    const uint64_t issue = (static_cast<uint64_t>(eph.d_N_T) << 32) |
+                           static_cast<uint64_t>(eph.d_t_b);
+    return is_new(GLONASS_GNAV, eph.i_satellite_PRN, issue);
+}
+
+
+void Gnss_Ephemeris_Registry::clear()
+{
+    for (auto& message_issues : d_issues)
+        {
+            for (auto& issue : message_issues)
+                {
+                    issue.store(0, std::memory_order_relaxed);
+                }
+        }
+}
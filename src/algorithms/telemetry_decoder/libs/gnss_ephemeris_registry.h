@@ -0,0 +1,96 @@
+/*!
+ * \file gnss_ephemeris_registry.h
+ * \brief Process-wide record of the last ephemeris issue published for each
+ * satellite, used to drop the copies decoded by other channels and bands.
+ *
+ *
+ * -------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2018  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *          Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_GNSS_EPHEMERIS_REGISTRY_H_
+#define GNSS_SDR_GNSS_EPHEMERIS_REGISTRY_H_
+
+#include "galileo_ephemeris.h"
+#include "glonass_gnav_ephemeris.h"
+#include "gps_cnav_ephemeris.h"
+#include "gps_ephemeris.h"
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+
+
+/*!
+ * \brief Lock-free store of the ephemeris issues already sent to the PVT,
+ * indexed by navigation message and PRN.
+ *
+ * The telemetry decoders ask it before publishing an ephemeris: only the
+ * first channel that decodes a given issue of data gets a true answer, so
+ * the redundant copies decoded in other channels or bands never reach the
+ * message queue. The issue is the set of fields that identify an upload
+ * of the control segment (IODE/IODC and reference times for GPS, IODnav
+ * for Galileo, t_b for GLONASS).
+ */
+class Gnss_Ephemeris_Registry
+{
+public:
+    enum Navigation_Message
+    {
+        GPS_LNAV = 0,
+        GPS_CNAV,
+        GALILEO_INAV,
+        GALILEO_FNAV,
+        GLONASS_GNAV,
+        NUM_NAVIGATION_MESSAGES
+    };
+
+    Gnss_Ephemeris_Registry();
+
+    static std::shared_ptr<Gnss_Ephemeris_Registry> get_instance();
+
+    /*!
+     * \brief Records \p issue as the last one of the satellite \p prn.
+     * \return true if it differs from the previously recorded one, that is, if
+     * the ephemeris has to be published.
+     */
+    bool is_new(Navigation_Message message, uint32_t prn, uint64_t issue);
+
+    bool is_new(const Gps_Ephemeris& eph);
+    bool is_new(const Gps_CNAV_Ephemeris& eph);
+    bool is_new(const Galileo_Ephemeris& eph, Navigation_Message message);
+    bool is_new(const Glonass_Gnav_Ephemeris& eph);
+
+    /*!
+     * \brief Forgets all the recorded issues, for a new flowgraph.
+     */
+    void clear();
+
+private:
+    static const uint32_t MAX_PRN = 64;
+    static const uint64_t ISSUE_RECORDED = 1ULL << 63;  // distinguishes a recorded issue 0 from an empty entry
+    std::array<std::array<std::atomic<uint64_t>, MAX_PRN>, NUM_NAVIGATION_MESSAGES> d_issues;
+};
+
+#endif
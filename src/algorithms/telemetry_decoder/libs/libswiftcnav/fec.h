@@ -41,8 +41,8 @@
 
 typedef struct
 {
-    unsigned char c0[32];
-    unsigned char c1[32];
+    /* Branch masks of the two code bits, as used by volk_gnsssdr_8i_viterbi_k7r2_32u */
+    short branch_masks[64];
 } v27_poly_t;
 
 typedef struct
@@ -54,10 +54,7 @@ typedef struct
  */
 typedef struct
 {
-    unsigned int metrics1[64]; /* Path metric buffer 1 */
-    unsigned int metrics2[64]; /* Path metric buffer 2 */
-    /* Pointers to path metrics, swapped on every bit */
-    unsigned int *old_metrics, *new_metrics;
+    short metrics[64];            /* Path metrics, the larger the more likely */
     const v27_poly_t *poly;       /* Polynomial to use */
     v27_decision_t *decisions;    /* Beginning of decisions for block */
     unsigned int decisions_index; /* Index of current decision */
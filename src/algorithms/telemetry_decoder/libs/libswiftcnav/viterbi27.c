@@ -1,7 +1,7 @@
 /*!
  * \file viterbi27.c
  * \author Phil Karn, KA9Q
- * \brief K=7 r=1/2 Viterbi decoder in portable C
+ * \brief K=7 r=1/2 Viterbi decoder, on top of the volk_gnsssdr trellis kernel
  *
  * -------------------------------------------------------------------------
  * This file was originally borrowed from libswiftnav
@@ -30,8 +30,9 @@
  */
 
 
-#include <stdlib.h>
 #include "fec.h"
+#include <volk_gnsssdr/volk_gnsssdr.h>
+#include <stdlib.h>
 
 static inline int parity(int x)
 {
@@ -54,8 +55,8 @@ void v27_poly_init(v27_poly_t *poly, const signed char polynomial[2])
 
     for(state = 0; state < 32; state++)
         {
-            poly->c0[state] = (polynomial[0] < 0) ^ parity((2*state) & abs(polynomial[0])) ? 255 : 0;
-            poly->c1[state] = (polynomial[1] < 0) ^ parity((2*state) & abs(polynomial[1])) ? 255 : 0;
+            poly->branch_masks[state] = (polynomial[0] < 0) ^ parity((2*state) & abs(polynomial[0])) ? 0 : -1;
+            poly->branch_masks[32 + state] = (polynomial[1] < 0) ^ parity((2*state) & abs(polynomial[1])) ? 0 : -1;
         }
 }
 
@@ -76,36 +77,18 @@ void v27_init(v27_t *v, v27_decision_t *decisions, unsigned int decisions_count,
 {
     int i;
 
-    v->old_metrics = v->metrics1;
-    v->new_metrics = v->metrics2;
     v->poly = poly;
     v->decisions = decisions;
     v->decisions_index = 0;
     v->decisions_count = decisions_count;
 
     for(i = 0; i < 64; i++)
-        v->old_metrics[i] = 63;
+        v->metrics[i] = -63;
 
-    v->old_metrics[initial_state & 63] = 0; /* Bias known start state */
+    v->metrics[initial_state & 63] = 0; /* Bias known start state */
 }
 
 
-/* C-language butterfly */
-#define BFLY(i) {\
-        unsigned int metric,m0,m1,decision;\
-        metric = (v->poly->c0[i] ^ sym0) + (v->poly->c1[i] ^ sym1);\
-        m0 = v->old_metrics[i] + metric;\
-        m1 = v->old_metrics[(i)+32] + (510 - metric);\
-        decision = (signed int)(m0-m1) > 0;\
-        v->new_metrics[2*(i)] = decision ? m1 : m0;\
-        d->w[(i)/16] |= decision << ((2*(i))&31);\
-        m0 -= (metric+metric-510);\
-        m1 += (metric+metric-510);\
-        decision = (signed int)(m0-m1) > 0;\
-        v->new_metrics[2*(i)+1] = decision ? m1 : m0;\
-        d->w[(i)/16] |= decision << ((2*(i)+1)&31);\
-}
-
 /** Update a v27_t decoder with a block of symbols.
  *
  * \param v Structure to update.
@@ -115,77 +98,32 @@ void v27_init(v27_t *v, v27_decision_t *decisions, unsigned int decisions_count,
  */
 void v27_update(v27_t *v, const unsigned char *syms, int nbits)
 {
-    unsigned char sym0, sym1;
-    unsigned int *tmp;
-    int normalize = 0;
+    /* The kernel takes signed symbols, centred on the erasure value 128 */
+    signed char signed_syms[2 * 64];
+    int i;
 
-    while(nbits--)
+    while(nbits > 0)
         {
-            v27_decision_t *d = &v->decisions[v->decisions_index];
-
-            d->w[0] = d->w[1] = 0;
-            sym0 = *syms++;
-            sym1 = *syms++;
-
-            BFLY(0);
-            BFLY(1);
-            BFLY(2);
-            BFLY(3);
-            BFLY(4);
-            BFLY(5);
-            BFLY(6);
-            BFLY(7);
-            BFLY(8);
-            BFLY(9);
-            BFLY(10);
-            BFLY(11);
-            BFLY(12);
-            BFLY(13);
-            BFLY(14);
-            BFLY(15);
-            BFLY(16);
-            BFLY(17);
-            BFLY(18);
-            BFLY(19);
-            BFLY(20);
-            BFLY(21);
-            BFLY(22);
-            BFLY(23);
-            BFLY(24);
-            BFLY(25);
-            BFLY(26);
-            BFLY(27);
-            BFLY(28);
-            BFLY(29);
-            BFLY(30);
-            BFLY(31);
-
-            /* Normalize metrics if they are nearing overflow */
-            if(v->new_metrics[0] > (1 << 30))
-                {
-                    int i;
-                    unsigned int minmetric = 1 << 31;
-
-                    for(i = 0; i < 64; i++)
-                        {
-                            if(v->new_metrics[i] < minmetric)
-                                minmetric = v->new_metrics[i];
-                        }
+            /* Run up to the end of the decisions buffer, or of the symbol buffer */
+            int n = (int)(v->decisions_count - v->decisions_index);
+            if(n > nbits)
+                n = nbits;
+            if(n > 64)
+                n = 64;
 
-                    for(i = 0; i < 64; i++)
-                        v->new_metrics[i] -= minmetric;
+            for(i = 0; i < 2 * n; i++)
+                signed_syms[i] = (signed char)(syms[i] ^ 0x80);
 
-                    normalize += minmetric;
-                }
+            volk_gnsssdr_8i_viterbi_k7r2_32u(v->decisions[v->decisions_index].w, v->metrics,
+                signed_syms, v->poly->branch_masks, n);
 
             /* Advance decision index */
-            if(++v->decisions_index >= v->decisions_count)
+            v->decisions_index += n;
+            if(v->decisions_index >= v->decisions_count)
                 v->decisions_index = 0;
 
-            /* Swap pointers to old and new metrics */
-            tmp = v->old_metrics;
-            v->old_metrics = v->new_metrics;
-            v->new_metrics = tmp;
+            syms += 2 * n;
+            nbits -= n;
         }
 }
 
@@ -234,16 +172,16 @@ void v27_chainback_fixed(v27_t *v, unsigned char *data, unsigned int nbits,
  */
 void v27_chainback_likely(v27_t *v, unsigned char *data, unsigned int nbits)
 {
-    /* Determine state with minimum metric */
+    /* Determine state with maximum metric */
 
     int i;
-    unsigned int best_metric = 0xffffffff;
+    short best_metric = v->metrics[0];
     unsigned char best_state = 0;
-    for(i = 0; i < 64; i++)
+    for(i = 1; i < 64; i++)
         {
-            if(v->new_metrics[i] < best_metric)
+            if(v->metrics[i] > best_metric)
                 {
-                    best_metric = v->new_metrics[i];
+                    best_metric = v->metrics[i];
                     best_state = i;
                 }
         }
@@ -0,0 +1,147 @@
+/*!
+ * \file linear_ring_buffer.h
+ * \brief Ring buffer that keeps its contents in contiguous memory
+ *
+ * Fixed capacity ring buffer that writes every element twice, one capacity
+ * apart, so that its contents can always be read as a plain array.
+ *
+ * -------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2018  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *          Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_LINEAR_RING_BUFFER_H_
+#define GNSS_SDR_LINEAR_RING_BUFFER_H_
+
+#include <cstddef>
+#include <vector>
+
+/*!
+ * \brief Fixed capacity ring buffer with contiguous contents.
+ *
+ * Element k of the storage is mirrored at k + capacity, so the elements from
+ * the oldest to the newest are always an array that starts at data(). Once
+ * the buffer is full, each push_back() drops the oldest element, like
+ * boost::circular_buffer.
+ */
+template <typename T>
+class Linear_Ring_Buffer
+{
+public:
+    Linear_Ring_Buffer() : d_capacity(0), d_next(0), d_size(0) {}
+
+    explicit Linear_Ring_Buffer(size_t capacity) : Linear_Ring_Buffer()
+    {
+        set_capacity(capacity);
+    }
+
+    /*!
+     * \brief Sets the capacity, discarding the contents.
+     */
+    void set_capacity(size_t capacity)
+    {
+        d_capacity = capacity;
+        d_storage.assign(2 * capacity, T());
+        clear();
+    }
+
+    inline void clear()
+    {
+        d_next = 0;
+        d_size = 0;
+    }
+
+    inline void push_back(const T& value)
+    {
+        if (d_capacity == 0)
+            {
+                return;
+            }
+        d_storage[d_next] = value;
+        d_storage[d_next + d_capacity] = value;
+        d_next = (d_next + 1) % d_capacity;
+        if (d_size < d_capacity)
+            {
+                d_size++;
+            }
+    }
+
+    inline void pop_front()
+    {
+        if (d_size > 0)
+            {
+                d_size--;
+            }
+    }
+
+    /*!
+     * \brief Returns a pointer to the oldest element, followed by the others up to the newest one.
+     */
+    inline const T* data() const
+    {
+        return &d_storage[d_next + d_capacity - d_size];
+    }
+
+    inline const T& operator[](size_t i) const
+    {
+        return data()[i];
+    }
+
+    inline const T& front() const
+    {
+        return data()[0];
+    }
+
+    inline const T& back() const
+    {
+        return data()[d_size - 1];
+    }
+
+    inline size_t size() const
+    {
+        return d_size;
+    }
+
+    inline size_t capacity() const
+    {
+        return d_capacity;
+    }
+
+    inline bool empty() const
+    {
+        return d_size == 0;
+    }
+
+    inline bool full() const
+    {
+        return d_capacity > 0 and d_size == d_capacity;
+    }
+
+private:
+    size_t d_capacity;
+    size_t d_next;  // storage index of the next element to be written
+    size_t d_size;
+    std::vector<T> d_storage;
+};
+
+#endif
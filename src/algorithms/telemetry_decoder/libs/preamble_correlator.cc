@@ -0,0 +1,130 @@
+/*!
+ * \file preamble_correlator.cc
+ * \brief Implementation of a bit-packed sliding preamble correlator
+ *
+ * Class that keeps the signs of the last symbols of a telemetry stream and
+ * correlates them with the preamble using XOR and popcount operations on
+ * 64-bit words, shifting one symbol in and one symbol out at a time.
+ *
+ * -------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2018  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *          Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------
+ */
+
+#include "preamble_correlator.h"
+#include <algorithm>
+
+
+namespace
+{
+inline uint32_t popcount64(uint64_t x)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    return static_cast<uint32_t>(__builtin_popcountll(x));
+#else
+    x = x - ((x >> 1) & 0x5555555555555555ULL);
+    x = (x & 0x3333333333333333ULL) + ((x >> 2) & 0x3333333333333333ULL);
+    x = (x + (x >> 4)) & 0x0F0F0F0F0F0F0F0FULL;
+    return static_cast<uint32_t>((x * 0x0101010101010101ULL) >> 56);
+#endif
+}
+
+
+// Drops bit 0 of a packed sequence of length bits and appends bit as its bit length - 1
+inline void shift_in(std::vector<uint64_t>& sequence, uint32_t length, bool bit)
+{
+    const size_t words = sequence.size();
+    for (size_t w = 0; w + 1 < words; w++)
+        {
+            sequence[w] = (sequence[w] >> 1) | (sequence[w + 1] << 63);
+        }
+    sequence[words - 1] >>= 1;
+    if (bit)
+        {
+            sequence[(length - 1) / 64U] |= (1ULL << ((length - 1) % 64U));
+        }
+}
+}  // namespace
+
+
+Preamble_Correlator::Preamble_Correlator()
+{
+    d_length = 0U;
+    d_words = 0U;
+    d_count = 0U;
+}
+
+
+void Preamble_Correlator::set_preamble(const int32_t* preamble_samples, uint32_t length)
+{
+    d_length = length;
+    d_words = (d_length + 63U) / 64U;
+    d_preamble.assign(d_words, 0ULL);
+    for (uint32_t j = 0; j < d_length; j++)
+        {
+            if (preamble_samples[j] < 0)
+                {
+                    d_preamble[j / 64U] |= (1ULL << (j % 64U));
+                }
+        }
+    d_signs.assign(d_words, 0ULL);
+    d_valid.assign(d_words, 0ULL);
+    d_count = 0U;
+}
+
+
+void Preamble_Correlator::clear()
+{
+    std::fill(d_signs.begin(), d_signs.end(), 0ULL);
+    std::fill(d_valid.begin(), d_valid.end(), 0ULL);
+    d_count = 0U;
+}
+
+
+void Preamble_Correlator::push_symbol(double symbol, bool valid)
+{
+    if (d_length == 0U)
+        {
+            return;
+        }
+    shift_in(d_signs, d_length, symbol < 0.0);
+    shift_in(d_valid, d_length, valid);
+    if (d_count < d_length)
+        {
+            d_count++;
+        }
+}
+
+
+int32_t Preamble_Correlator::correlation() const
+{
+    // Each valid symbol adds +1 if its sign matches the preamble sample and -1 otherwise
+    uint32_t valid = 0U;
+    uint32_t errors = 0U;
+    for (uint32_t w = 0; w < d_words; w++)
+        {
+            valid += popcount64(d_valid[w]);
+            errors += popcount64((d_signs[w] ^ d_preamble[w]) & d_valid[w]);
+        }
+    return static_cast<int32_t>(valid) - 2 * static_cast<int32_t>(errors);
+}
@@ -0,0 +1,94 @@
+/*!
+ * \file preamble_correlator.h
+ * \brief Interface of a bit-packed sliding preamble correlator
+ *
+ * Class that keeps the signs of the last symbols of a telemetry stream and
+ * correlates them with the preamble using XOR and popcount operations on
+ * 64-bit words, shifting one symbol in and one symbol out at a time.
+ *
+ * -------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2018  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *          Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_PREAMBLE_CORRELATOR_H_
+#define GNSS_SDR_PREAMBLE_CORRELATOR_H_
+
+#include <cstdint>
+#include <vector>
+
+/*!
+ * \brief This class implements a bit-packed sliding preamble correlator.
+ *
+ * Bit j of the sign history holds the sign of the j-th oldest symbol in the
+ * window of one preamble length (1 if negative), and bit j of the valid mask
+ * tells whether that symbol takes part in the correlation. Each new symbol
+ * shifts the window by one, and the correlation takes a handful of word
+ * operations instead of one multiply and add per preamble sample.
+ */
+class Preamble_Correlator
+{
+public:
+    Preamble_Correlator();
+
+    /*!
+     * \brief Sets the preamble, as \p length samples equal to +1 or -1.
+     */
+    void set_preamble(const int32_t* preamble_samples, uint32_t length);
+
+    /*!
+     * \brief Discards the symbol history.
+     */
+    void clear();
+
+    /*!
+     * \brief Appends the newest symbol to the window, dropping the oldest one.
+     * An invalid symbol does not contribute to the correlation.
+     */
+    void push_symbol(double symbol, bool valid = true);
+
+    /*!
+     * \brief Returns true if the window holds a whole preamble length of symbols.
+     */
+    inline bool full() const
+    {
+        return d_length > 0 and d_count >= d_length;
+    }
+
+    /*!
+     * \brief Returns the correlation of the window with the preamble, each
+     * valid symbol contributing its preamble sample with the symbol sign
+     * (zero counts as positive). The oldest symbol meets the first sample.
+     */
+    int32_t correlation() const;
+
+private:
+    uint32_t d_length;  // preamble length [samples]
+    uint32_t d_words;   // 64-bit words per packed sequence
+    uint32_t d_count;   // symbols in the window, saturated at d_length
+    std::vector<uint64_t> d_preamble;
+    std::vector<uint64_t> d_signs;
+    std::vector<uint64_t> d_valid;
+};
+
+#endif
@@ -1,7 +1,8 @@
 /*!
  * \file viterbi_decoder.h
  * \brief Interface of a Viterbi decoder class based on the Iterative Solutions
- * Coded Modulation Library by Matthew C. Valenti
+ * Coded Modulation Library by Matthew C. Valenti. The trellis runs on the
+ * volk_gnsssdr_8i_viterbi_k7r2_32u kernel.
  * \author Daniel Fehr 2013. daniel.co(at)bluewin.ch
  *
  * -------------------------------------------------------------------------
@@ -32,17 +33,30 @@
 #ifndef GNSS_SDR_VITERBI_DECODER_H_
 #define GNSS_SDR_VITERBI_DECODER_H_
 
+#include <array>
 #include <cstddef>  // for size_t
+#include <cstdint>
 #include <deque>
+#include <vector>
 
 /*!
- * \brief Class that implements a Viterbi decoder
+ * \brief Class that implements a soft-decision Viterbi decoder for the K=7, rate 1/2
+ * convolutional code shared by Galileo I/NAV and F/NAV, GPS CNAV and SBAS.
+ *
+ * The soft symbols are taken in single precision, quantized to 8 bits and the
+ * add-compare-select steps run on the SIMD kernels of volk_gnsssdr. Only the
+ * trellis history is kept in this class.
  */
 class Viterbi_Decoder
 {
 public:
+    /*!
+     * \brief Builds the decoder of the code with generators \p g_encoder, in the
+     * convention of nsc_enc_bit() (newest bit in the most significant position).
+     * Only KK = 7 and nn = 2 are supported.
+     */
     Viterbi_Decoder(const int g_encoder[], const int KK, const int nn);
-    ~Viterbi_Decoder();
+    ~Viterbi_Decoder() = default;
     void reset();
 
     /*!
@@ -53,75 +67,49 @@ public:
      *
      * \return  output_u_int[] Hard decisions on the data bits (without the mm zero-tail-bits)
      */
-    float decode_block(const double input_c[], int* output_u_int, const int LL);
+    float decode_block(const float input_c[], int* output_u_int, const int LL);
 
-    float decode_continuous(const double sym[], const int traceback_depth, int output_u_int[],
+    float decode_continuous(const float sym[], const int traceback_depth, int output_u_int[],
         const int nbits_requested, int& nbits_decoded);
 
 private:
-    class Prev
+    // one trellis step: the survivor decisions of the 64 states and the received symbols
+    struct Trellis_Step
     {
-    public:
-        int num_states;
-        Prev(int states, int t);
-        Prev(const Prev& prev);
-        Prev& operator=(const Prev& other);
-        ~Prev();
-
-        int get_anchestor_state_of_current_state(int current_state);
-        int get_bit_of_current_state(int current_state);
-        float get_metric_of_current_state(int current_state);
-        int get_t();
-        void set_current_state_as_ancestor_of_next_state(int next_state, int current_state);
-        void set_decoded_bit_for_next_state(int next_state, int bit);
-        void set_survivor_branch_metric_of_next_state(int next_state, float metric);
-
-    private:
-        int t;
-        int* state;
-        int* bit;
-        float* metric;
-        int* refcount;
+        std::array<uint32_t, 2> decisions;
+        std::array<float, 2> symbols;
     };
 
     // code properties
     int d_KK;
     int d_nn;
-
-    // derived code properties
     int d_mm;
-    int d_states;
-    int d_number_symbols;
+    int d_polys[2];  // generators with the newest bit in the least significant position
 
     // trellis definition
-    int* d_out0;
-    int* d_state0;
-    int* d_out1;
-    int* d_state1;
+    std::array<int16_t, 64> d_branch_masks;
 
     // trellis state
-    float* d_pm_t;
-    std::deque<Prev> d_trellis_paths;
-    float* d_metric_c;  /* Set of all possible branch metrics */
-    float* d_rec_array; /* Received values for one trellis section */
-    bool d_trellis_state_is_initialised;
+    std::array<int16_t, 64> d_metrics;
+    std::deque<Trellis_Step> d_trellis_paths;  // newest step first
+    float d_mean_abs_symbol;                   // running mean of |symbol|, sets the quantization scale
+
+    // work buffers
+    std::vector<int8_t> d_quantized_symbols;
+    std::vector<uint32_t> d_decisions;
 
     // measures
     float d_indicator_metric;
 
     // operations on the trellis (change decoder state)
     void init_trellis_state();
-    int do_acs(const double sym[], int nbits);
+    int do_acs(const float sym[], int nbits, bool block);
     int do_traceback(std::size_t traceback_length);
     int do_tb_and_decode(int traceback_length, int requested_decoding_length, int state, int bits[], float& indicator_metric);
 
-    // branch metric function
-    float gamma(const float rec_array[], int symbol, int nn);
-
-    // trellis generation
-    void nsc_transit(int output_p[], int trans_p[], int input, const int g[], int KK, int nn);
-    int nsc_enc_bit(int state_out_p[], int input, int state_in, const int g[], int KK, int nn);
-    int parity_counter(int symbol, int length);
+    // survivor branch of a state at a trellis step
+    int get_ancestor_state(const Trellis_Step& step, int state) const;
+    float get_branch_metric(const Trellis_Step& step, int state) const;
 };
 
 #endif /* GNSS_SDR_VITERBI_DECODER_H_ */
@@ -57,7 +57,20 @@ GalileoE1DllPllVemlTracking::GalileoE1DllPllVemlTracking(
     std::string item_type = configuration->property(role + ".item_type", default_item_type);
     int fs_in_deprecated = configuration->property("GNSS-SDR.internal_fs_hz", 2048000);
     int fs_in = configuration->property("GNSS-SDR.internal_fs_sps", fs_in_deprecated);
+    int pre_decimation_factor = configuration->property(role + ".pre_decimation_factor", 1);
+    if (pre_decimation_factor < 1)
+        {
+            pre_decimation_factor = 1;
+        }
+    if (pre_decimation_factor > 1 and (item_type != "gr_complex" or fs_in % pre_decimation_factor != 0))
+        {
+            pre_decimation_factor = 1;
+            std::cout << TEXT_RED << "WARNING: Galileo E1. pre_decimation_factor requires gr_complex samples and must divide the sampling rate. Pre-decimation has been disabled" << TEXT_RESET << std::endl;
+        }
+    pre_decimation_factor_ = pre_decimation_factor;
+    fs_in /= pre_decimation_factor;  // the tracking block only sees the decimated samples
     trk_param.fs_in = fs_in;
+    trk_param.pre_decimation_factor = pre_decimation_factor;
     bool dump = configuration->property(role + ".dump", false);
     trk_param.dump = dump;
     std::string default_dump_filename = "./track_ch";
@@ -66,6 +79,17 @@ GalileoE1DllPllVemlTracking::GalileoE1DllPllVemlTracking(
     bool dump_mat = configuration->property(role + ".dump_mat", true);
     trk_param.dump_mat = dump_mat;
     trk_param.high_dyn = configuration->property(role + ".high_dyn", false);
+    trk_param.batch_correlator = configuration->property(role + ".batch_correlator", false);
+    trk_param.batch_window_us = configuration->property(role + ".batch_window_us", 50);
+    trk_param.code_replica_phases = configuration->property(role + ".code_replica_phases", 0);
+    trk_param.carrier_kf_order = configuration->property(role + ".carrier_kf_order", 0);
+    trk_param.max_epochs_per_call = configuration->property(role + ".max_epochs_per_call", 1);
+    trk_param.adaptive_taps_cn0_db_hz = configuration->property(role + ".adaptive_taps_cn0_db_hz", 0.0);
+    trk_param.dump_async = configuration->property(role + ".dump_async", false);
+    trk_param.dump_compress = configuration->property(role + ".dump_compress", false);
+    trk_param.dump_policy = gnss_dump_policy_conf(configuration, role);
+    trk_param.use_cuda = configuration->property(role + ".use_cuda", false);
+    trk_param.cuda_batch_window_us = configuration->property(role + ".cuda_batch_window_us", 200);
     if (configuration->property(role + ".smoother_length", 10) < 1)
         {
             trk_param.smoother_length = 1;
@@ -135,6 +159,12 @@ GalileoE1DllPllVemlTracking::GalileoE1DllPllVemlTracking(
             item_size_ = sizeof(gr_complex);
             tracking_ = dll_pll_veml_make_tracking(trk_param);
         }
+    else if (item_type == "cshort")
+        {
+            item_size_ = sizeof(lv_16sc_t);
+            trk_param.item_type = item_type;
+            tracking_ = dll_pll_veml_make_tracking(trk_param);
+        }
     else
         {
             item_size_ = sizeof(gr_complex);
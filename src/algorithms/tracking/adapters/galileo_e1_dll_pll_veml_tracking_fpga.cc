@@ -131,6 +131,7 @@ GalileoE1DllPllVemlTrackingFpga::GalileoE1DllPllVemlTrackingFpga(
     trk_param_fpga.device_name = device_name;
     unsigned int device_base = configuration->property(role + ".device_base", 1);
     trk_param_fpga.device_base = device_base;
+    trk_param_fpga.pipeline_epochs = configuration->property(role + ".pipeline_epochs", false);
     //unsigned int multicorr_type = configuration->property(role + ".multicorr_type", 1);
     trk_param_fpga.multicorr_type = 1;  // 0 -> 3 correlators, 1 -> 5 correlators
 
@@ -63,6 +63,7 @@ GalileoE1TcpConnectorTracking::GalileoE1TcpConnectorTracking(
     float early_late_space_chips;
     float very_early_late_space_chips;
     size_t port_ch0;
+    bool batch_tcp;
     item_type = configuration->property(role + ".item_type", default_item_type);
     int fs_in_deprecated = configuration->property("GNSS-SDR.internal_fs_hz", 2048000);
     fs_in = configuration->property("GNSS-SDR.internal_fs_sps", fs_in_deprecated);
@@ -74,6 +75,7 @@ GalileoE1TcpConnectorTracking::GalileoE1TcpConnectorTracking(
     early_late_space_chips = configuration->property(role + ".early_late_space_chips", 0.15);
     very_early_late_space_chips = configuration->property(role + ".very_early_late_space_chips", 0.6);
     port_ch0 = configuration->property(role + ".port_ch0", 2060);
+    batch_tcp = configuration->property(role + ".batch_tcp", false);
     std::string default_dump_filename = "./track_ch";
     dump_filename = configuration->property(role + ".dump_filename", default_dump_filename);
     vector_length = std::round(fs_in / (Galileo_E1_CODE_CHIP_RATE_HZ / Galileo_E1_B_CODE_LENGTH_CHIPS));
@@ -91,7 +93,8 @@ GalileoE1TcpConnectorTracking::GalileoE1TcpConnectorTracking(
                 dll_bw_hz,
                 early_late_space_chips,
                 very_early_late_space_chips,
-                port_ch0);
+                port_ch0,
+                batch_tcp);
         }
     else
         {
@@ -39,8 +39,10 @@
 #include "glonass_l1_ca_dll_pll_tracking.h"
 #include "GLONASS_L1_L2_CA.h"
 #include "configuration_interface.h"
+#include "display.h"
 #include "gnss_sdr_flags.h"
 #include <glog/logging.h>
+#include <iostream>
 
 
 using google::LogMessage;
@@ -64,6 +66,18 @@ GlonassL1CaDllPllTracking::GlonassL1CaDllPllTracking(
     item_type = configuration->property(role + ".item_type", default_item_type);
     int fs_in_deprecated = configuration->property("GNSS-SDR.internal_fs_hz", 2048000);
     fs_in = configuration->property("GNSS-SDR.internal_fs_sps", fs_in_deprecated);
+    int pre_decimation_factor = configuration->property(role + ".pre_decimation_factor", 1);
+    if (pre_decimation_factor < 1)
+        {
+            pre_decimation_factor = 1;
+        }
+    if (pre_decimation_factor > 1 and (item_type != "gr_complex" or fs_in % pre_decimation_factor != 0))
+        {
+            pre_decimation_factor = 1;
+            std::cout << TEXT_RED << "WARNING: GLONASS L1 C/A. pre_decimation_factor requires gr_complex samples and must divide the sampling rate. Pre-decimation has been disabled" << TEXT_RESET << std::endl;
+        }
+    pre_decimation_factor_ = pre_decimation_factor;
+    fs_in /= pre_decimation_factor;  // the tracking block only sees the decimated samples
     dump = configuration->property(role + ".dump", false);
     pll_bw_hz = configuration->property(role + ".pll_bw_hz", 50.0);
     if (FLAGS_pll_bw_hz != 0.0) pll_bw_hz = static_cast<float>(FLAGS_pll_bw_hz);
@@ -85,7 +99,8 @@ GlonassL1CaDllPllTracking::GlonassL1CaDllPllTracking(
                 dump_filename,
                 pll_bw_hz,
                 dll_bw_hz,
-                early_late_space_chips);
+                early_late_space_chips,
+                pre_decimation_factor);
         }
     else
         {
@@ -119,6 +134,13 @@ void GlonassL1CaDllPllTracking::start_tracking()
 }
 
 
+bool GlonassL1CaDllPllTracking::set_fdma_premixed(unsigned int latency_samples)
+{
+    tracking_->set_fdma_premixed(latency_samples);
+    return true;
+}
+
+
 /*
  * Set tracking channel unique ID
  */
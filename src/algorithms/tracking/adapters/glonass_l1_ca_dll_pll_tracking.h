@@ -96,10 +96,21 @@ public:
      */
     void stop_tracking() override;
 
+    /*!
+     * \brief Decimation factor expected at the tracking input
+     */
+    inline unsigned int pre_decimation_factor() override
+    {
+        return pre_decimation_factor_;
+    }
+
+    bool set_fdma_premixed(unsigned int latency_samples) override;
+
 private:
     glonass_l1_ca_dll_pll_tracking_cc_sptr tracking_;
     size_t item_size_;
     unsigned int channel_;
+    unsigned int pre_decimation_factor_;
     std::string role_;
     unsigned int in_streams_;
     unsigned int out_streams_;
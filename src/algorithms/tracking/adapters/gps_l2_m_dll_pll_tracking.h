@@ -95,10 +95,19 @@ public:
      */
     void stop_tracking() override;
 
+    /*!
+     * \brief Integrate-and-dump decimation factor expected at the tracking input
+     */
+    inline unsigned int pre_decimation_factor() override
+    {
+        return pre_decimation_factor_;
+    }
+
 private:
     dll_pll_veml_tracking_sptr tracking_;
     size_t item_size_;
     unsigned int channel_;
+    unsigned int pre_decimation_factor_;
     std::string role_;
     unsigned int in_streams_;
     unsigned int out_streams_;
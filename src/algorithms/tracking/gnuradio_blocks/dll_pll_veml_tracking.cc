@@ -11,7 +11,7 @@
  *
  * -------------------------------------------------------------------------
  *
- * Copyright (C) 2010-2018  (see AUTHORS file for a list of contributors)
+ * Copyright (C) 2010-2019  (see AUTHORS file for a list of contributors)
  *
  * GNSS-SDR is a software defined Global Navigation
  *          Satellite Systems receiver
@@ -44,25 +44,44 @@
 #include "control_message_factory.h"
 #include "galileo_e1_signal_processing.h"
 #include "galileo_e5_signal_processing.h"
+#include "gnss_profiler.h"
 #include "gnss_sdr_create_directory.h"
+#include "gnss_trace.h"
+#include "gnss_tracking_state_registry.h"
 #include "gps_l2c_signal.h"
 #include "gps_l5_signal.h"
 #include "gps_sdr_signal_processing.h"
 #include "lock_detectors.h"
 #include "tracking_discriminators.h"
+#include "trk_code_cache.h"
+#include <boost/bind.hpp>
 #include <boost/filesystem/path.hpp>
 #include <glog/logging.h>
 #include <gnuradio/io_signature.h>
 #include <matio.h>
 #include <volk_gnsssdr/volk_gnsssdr.h>
 #include <algorithm>
+#include <chrono>
 #include <cmath>
+#include <cstring>
 #include <iostream>
 #include <numeric>
 #include <sstream>
+#if CUDA_GPU_ACCEL
+#include "cuda_multicorrelator_batch.h"
+#endif
 
 using google::LogMessage;
 
+
+// Copies a value into a dump record, returning the position of the next one
+template <typename T>
+static inline char *append_to_record(char *pos, T value)
+{
+    std::memcpy(pos, &value, sizeof(T));
+    return pos + sizeof(T);
+}
+
 dll_pll_veml_tracking_sptr dll_pll_veml_make_tracking(const Dll_Pll_Conf &conf_)
 {
     return dll_pll_veml_tracking_sptr(new dll_pll_veml_tracking(conf_));
@@ -74,15 +93,21 @@ void dll_pll_veml_tracking::forecast(int noutput_items,
 {
     if (noutput_items != 0)
         {
-            ninput_items_required[0] = static_cast<int32_t>(trk_parameters.vector_length) * 2;
+            // The correlators may read up to one extra code period beyond the last epoch
+            int32_t epochs = std::min(noutput_items, d_max_epochs_per_call);
+            ninput_items_required[0] = static_cast<int32_t>(trk_parameters.vector_length) * (epochs + 1);
         }
 }
 
 
-dll_pll_veml_tracking::dll_pll_veml_tracking(const Dll_Pll_Conf &conf_) : gr::block("dll_pll_veml_tracking", gr::io_signature::make(1, 1, sizeof(gr_complex)),
-                                                                              gr::io_signature::make(1, 1, sizeof(Gnss_Synchro)))
+dll_pll_veml_tracking::dll_pll_veml_tracking(const Dll_Pll_Conf &conf_) : gr::block("dll_pll_veml_tracking", gr::io_signature::make(1, 1, conf_.item_type == "cshort" ? sizeof(lv_16sc_t) : sizeof(gr_complex)),
+                                                                              gr::io_signature::make(1, 1, sizeof(Gnss_Synchro))),
+                                                                          d_memory("tracking")
 {
     trk_parameters = conf_;
+    d_use_16sc = (trk_parameters.item_type == "cshort");
+    d_input_item_size = d_use_16sc ? sizeof(lv_16sc_t) : sizeof(gr_complex);
+    d_max_epochs_per_call = std::max(trk_parameters.max_epochs_per_call, 1);
     // Telemetry bit synchronization message port input
     this->message_port_register_out(pmt::mp("events"));
     this->set_relative_rate(1.0 / static_cast<double>(trk_parameters.vector_length));
@@ -90,12 +115,19 @@ dll_pll_veml_tracking::dll_pll_veml_tracking(const Dll_Pll_Conf &conf_) : gr::bl
     // Telemetry bit synchronization message port input (mainly for GPS L1 CA)
     this->message_port_register_in(pmt::mp("preamble_samplestamp"));
 
+    // Telemetry of a fused decoder, forwarded to the observables
+    this->message_port_register_out(pmt::mp("telemetry"));
+    this->message_port_register_in(pmt::mp("telemetry_in"));
+    this->set_msg_handler(pmt::mp("telemetry_in"), boost::bind(&dll_pll_veml_tracking::msg_handler_telemetry, this, _1));
+    d_telemetry = nullptr;
+
     // initialize internal vars
     d_veml = false;
     d_cloop = true;
     d_code_chip_rate = 0.0;
     d_secondary_code_length = 0U;
     d_secondary_code_string = nullptr;
+    d_secondary_lock_symbol = 0;
     d_gps_l1ca_preambles_symbols = nullptr;
     signal_type = std::string(trk_parameters.signal);
 
@@ -109,6 +141,11 @@ dll_pll_veml_tracking::dll_pll_veml_tracking(const Dll_Pll_Conf &conf_) : gr::bl
     map_signal_pretty_name["L5"] = "L5";
 
     signal_pretty_name = map_signal_pretty_name[signal_type];
+    d_signal_counters = Gnss_Metrics::get_instance()->get_signal_counters(signal_type);
+    d_state_registry = Gnss_Tracking_State_Registry::get_instance();
+    d_state_system = 0;
+    d_state_prn = 0;
+    d_sample_clock = Gnss_Sdr_Sample_Clock::get_instance();
 
     if (trk_parameters.system == 'G')
         {
@@ -287,16 +324,26 @@ dll_pll_veml_tracking::dll_pll_veml_tracking(const Dll_Pll_Conf &conf_) : gr::bl
     T_prn_seconds = 0.0;
     T_prn_samples = 0.0;
     K_blk_samples = 0.0;
+    select_signal_kernels();
+    // The 16 bit multicorrelator always computes all the taps
+    d_adaptive_taps = d_veml and trk_parameters.adaptive_taps_cn0_db_hz > 0.0 and !d_use_16sc;
+    d_reduced_taps = false;
+    d_reduce_taps = false;
+    d_strong_cn0_count = 0;
 
     // Initialize tracking  ==========================================
     d_code_loop_filter = Tracking_2nd_DLL_filter(static_cast<float>(d_code_period));
     d_carrier_loop_filter = Tracking_2nd_PLL_filter(static_cast<float>(d_code_period));
     d_code_loop_filter.set_DLL_BW(trk_parameters.dll_bw_hz);
     d_carrier_loop_filter.set_PLL_BW(trk_parameters.pll_bw_hz);
+    d_use_carrier_kf = (trk_parameters.carrier_kf_order == 2) or (trk_parameters.carrier_kf_order == 3);
+    if (d_use_carrier_kf)
+        {
+            // Same initial covariances as in gps_l1_ca_kf_tracking_cc
+            d_carrier_kf.set_params(trk_parameters.carrier_kf_order, d_code_period);
+            d_carrier_kf.set_initial_covariance(PI_2 / 4.0, 450.0, std::pow(4.0 * PI_2, 2) / 12.0);
+        }
 
-    // Initialization of local code replica
-    // Get space for a vector with the sinboc(1,1) replica sampled 2x/chip
-    d_tracking_code = static_cast<float *>(volk_gnsssdr_malloc(2 * d_code_length_chips * sizeof(float), volk_gnsssdr_get_alignment()));
     // correlator outputs (scalar)
     if (d_veml)
         {
@@ -309,8 +356,28 @@ dll_pll_veml_tracking::dll_pll_veml_tracking(const Dll_Pll_Conf &conf_) : gr::bl
             d_n_correlator_taps = 3;
         }
 
-    d_correlator_outs = static_cast<gr_complex *>(volk_gnsssdr_malloc(d_n_correlator_taps * sizeof(gr_complex), volk_gnsssdr_get_alignment()));
-    d_local_code_shift_chips = static_cast<float *>(volk_gnsssdr_malloc(d_n_correlator_taps * sizeof(float), volk_gnsssdr_get_alignment()));
+    // The arrays used on every epoch share a single buffer, in the order they are used: tap shifts,
+    // resampled local codes (and the correlator internal outputs), correlator outputs and data prompt.
+    // The first pass sizes the arena, and the second one takes the arrays from it
+    for (int32_t pass = 0; pass < 2; pass++)
+        {
+            d_local_code_shift_chips = d_arena.take<float>(d_n_correlator_taps);
+            // The data component prompt correlator (slave to Pilot prompt) is computed in the same pass, if tracking uses Pilot signal
+            if (d_use_16sc)
+                {
+                    multicorrelator_cpu_16sc.init(2 * trk_parameters.vector_length, d_n_correlator_taps, trk_parameters.track_pilot ? 1 : 0, &d_arena);
+                }
+            else
+                {
+                    multicorrelator_cpu.init(2 * trk_parameters.vector_length, d_n_correlator_taps, trk_parameters.track_pilot ? 1 : 0, &d_arena);
+                }
+            d_correlator_outs = d_arena.take<gr_complex>(d_n_correlator_taps);
+            d_Prompt_Data = d_arena.take<gr_complex>(1);
+            if (pass == 0)
+                {
+                    d_arena.allocate();
+                }
+        }
 
     // map memory pointers of correlator outputs
     if (d_veml)
@@ -340,8 +407,6 @@ dll_pll_veml_tracking::dll_pll_veml_tracking(const Dll_Pll_Conf &conf_) : gr::bl
             d_prompt_data_shift = &d_local_code_shift_chips[1];
         }
 
-    multicorrelator_cpu.init(2 * trk_parameters.vector_length, d_n_correlator_taps);
-
     if (trk_parameters.extend_correlation_symbols > 1)
         {
             d_enable_extended_integration = true;
@@ -352,21 +417,52 @@ dll_pll_veml_tracking::dll_pll_veml_tracking(const Dll_Pll_Conf &conf_) : gr::bl
             trk_parameters.extend_correlation_symbols = 1;
         }
 
-    // Enable Data component prompt correlator (slave to Pilot prompt) if tracking uses Pilot signal
-    if (trk_parameters.track_pilot)
+    // --- Initializations ---
+    multicorrelator_cpu.set_high_dynamics_resampler(trk_parameters.high_dyn);
+    if (trk_parameters.code_replica_phases > 0)
         {
-            // Extra correlator for the data component
-            correlator_data_cpu.init(2 * trk_parameters.vector_length, 1);
-            correlator_data_cpu.set_high_dynamics_resampler(trk_parameters.high_dyn);
-            d_data_code = static_cast<float *>(volk_gnsssdr_malloc(2 * d_code_length_chips * sizeof(float), volk_gnsssdr_get_alignment()));
+            if (trk_parameters.high_dyn or d_use_16sc)
+                {
+                    LOG(WARNING) << "The code replica table is not available for high dynamics or cshort tracking, disabling it";
+                }
+            else
+                {
+                    multicorrelator_cpu.set_replica_table(trk_parameters.code_replica_phases);
+                }
         }
-    else
+    d_cuda_slot = -1;
+    d_cuda_tracking = false;
+    if (trk_parameters.use_cuda)
         {
-            d_data_code = nullptr;
+#if CUDA_GPU_ACCEL
+            if (d_use_16sc)
+                {
+                    LOG(WARNING) << "CUDA tracking is not available for cshort samples, using the CPU";
+                }
+            else
+                {
+                    d_cuda_correlator = cuda_multicorrelator_batch::get_instance(trk_parameters.cuda_batch_window_us);
+                    d_cuda_slot = d_cuda_correlator->add_channel(d_n_correlator_taps, trk_parameters.track_pilot ? 1 : 0);
+                    if (d_cuda_slot < 0)
+                        {
+                            LOG(WARNING) << "CUDA tracking cannot be initialized, using the CPU";
+                            d_cuda_correlator.reset();
+                        }
+                }
+#else
+            LOG(WARNING) << "GNSS-SDR was built without CUDA support, tracking will run on the CPU";
+#endif
+        }
+    d_batch_registered = false;
+    if (trk_parameters.batch_correlator and d_use_16sc)
+        {
+            LOG(WARNING) << "The batched correlator is not available for cshort samples, disabling it";
+        }
+    else if (trk_parameters.batch_correlator and (d_cuda_slot < 0))
+        {
+            d_batch_correlator = cpu_multicorrelator_batch::get_instance(trk_parameters.batch_window_us);
+            d_batch_correlators.push_back(&multicorrelator_cpu);
         }
-
-    // --- Initializations ---
-    multicorrelator_cpu.set_high_dynamics_resampler(trk_parameters.high_dyn);
     // Initial code frequency basis of NCO
     d_code_freq_chips = d_code_chip_rate;
     // Residual code phase (in chips)
@@ -380,14 +476,12 @@ dll_pll_veml_tracking::dll_pll_veml_tracking(const Dll_Pll_Conf &conf_) : gr::bl
 
     d_current_prn_length_samples = static_cast<int32_t>(trk_parameters.vector_length);
 
-    // CN0 estimation and lock detector buffers
-    d_cn0_estimation_counter = 0;
-    d_Prompt_buffer = new gr_complex[trk_parameters.cn0_samples];
+    // CN0 estimation and lock detectors
+    d_cn0_estimator.set_length(trk_parameters.cn0_samples);
     d_carrier_lock_test = 1.0;
     d_CN0_SNV_dB_Hz = 0.0;
     d_carrier_lock_fail_counter = 0;
     d_carrier_lock_threshold = trk_parameters.carrier_lock_th;
-    d_Prompt_Data = static_cast<gr_complex *>(volk_gnsssdr_malloc(sizeof(gr_complex), volk_gnsssdr_get_alignment()));
 
     d_acquisition_gnss_synchro = nullptr;
     d_channel = 0;
@@ -417,7 +511,14 @@ dll_pll_veml_tracking::dll_pll_veml_tracking(const Dll_Pll_Conf &conf_) : gr::bl
         }
 
     d_dump = trk_parameters.dump;
+    d_dump_stream = -1;
+    d_dump_compressed = trk_parameters.dump and trk_parameters.dump_async and trk_parameters.dump_compress;
+    d_dump_policy = Gnss_Dump_Policy(trk_parameters.dump_policy);
     d_dump_mat = trk_parameters.dump_mat and d_dump;
+    if (d_dump_mat)
+        {
+            d_mat_converter = Gnss_Mat_Converter::get_instance();
+        }
     if (d_dump)
         {
             d_dump_filename = trk_parameters.dump_filename;
@@ -451,6 +552,33 @@ dll_pll_veml_tracking::dll_pll_veml_tracking(const Dll_Pll_Conf &conf_) : gr::bl
                     d_dump = false;
                 }
         }
+    update_memory_accounting();
+}
+
+
+void dll_pll_veml_tracking::update_memory_accounting()
+{
+    // The local codes are shared with other channels through Trk_Code_Cache, and not accounted here
+    size_t volk_bytes = d_arena.bytes() + multicorrelator_cpu.allocated_bytes() + multicorrelator_cpu_16sc.allocated_bytes();
+    d_memory.set_bytes("volk", volk_bytes);
+    d_memory.set_bytes("history", d_symbol_history.capacity() * sizeof(float) + (d_code_ph_history.capacity() + d_carr_ph_history.capacity()) * sizeof(std::pair<double, double>));
+    d_memory.set_bytes("dump", (d_dump_stream >= 0 ? d_dump_writer->ring_bytes(d_dump_stream) : 0) + d_dump_policy.ring_bytes());
+}
+
+
+std::shared_ptr<const float> dll_pll_veml_tracking::local_code(const std::string &component, const std::function<void(float *)> &generate)
+{
+    std::string key = systemName + "_" + component + "_" + std::to_string(d_acquisition_gnss_synchro->PRN) + "_" + std::to_string(d_code_samples_per_chip);
+    std::shared_ptr<Trk_Code_Cache> cache = Trk_Code_Cache::get_instance();
+    std::shared_ptr<const float> code = cache->find(key);
+    if (code)
+        {
+            return code;
+        }
+    auto *samples = static_cast<float *>(volk_gnsssdr_malloc(d_code_samples_per_chip * d_code_length_chips * sizeof(float), volk_gnsssdr_get_alignment()));
+    generate(samples);
+    // if another channel generated the same code meanwhile, its copy is kept
+    return cache->insert(key, std::shared_ptr<const float>(samples, [](const float *p) { volk_gnsssdr_free(const_cast<float *>(p)); }));
 }
 
 
@@ -462,6 +590,15 @@ void dll_pll_veml_tracking::start_tracking()
     d_acq_code_phase_samples = d_acquisition_gnss_synchro->Acq_delay_samples;
     d_acq_carrier_doppler_hz = d_acquisition_gnss_synchro->Acq_doppler_hz;
     d_acq_sample_stamp = d_acquisition_gnss_synchro->Acq_samplestamp_samples;
+    if (trk_parameters.pre_decimation_factor > 1)
+        {
+            // acquisition runs at the full input rate: move its stamp to the decimated
+            // samples, each one centred on the block of input samples it integrates
+            uint64_t decimation = static_cast<uint64_t>(trk_parameters.pre_decimation_factor);
+            d_acq_code_phase_samples += static_cast<double>(d_acq_sample_stamp % decimation) - static_cast<double>(decimation - 1ULL) / 2.0;
+            d_acq_code_phase_samples /= static_cast<double>(decimation);
+            d_acq_sample_stamp /= decimation;
+        }
 
     d_carrier_doppler_hz = d_acq_carrier_doppler_hz;
     d_carrier_phase_step_rad = PI_2 * d_carrier_doppler_hz / trk_parameters.fs_in;
@@ -471,70 +608,118 @@ void dll_pll_veml_tracking::start_tracking()
     // DLL/PLL filter initialization
     d_carrier_loop_filter.initialize();  // initialize the carrier filter
     d_code_loop_filter.initialize();     // initialize the code filter
+    if (d_use_carrier_kf)
+        {
+            // Initial Doppler uncertainty according to the acquisition Doppler step size (3 sigma)
+            if (d_acquisition_gnss_synchro->Acq_doppler_step > 0)
+                {
+                    d_carrier_kf.set_initial_doppler_variance(std::pow(static_cast<double>(d_acquisition_gnss_synchro->Acq_doppler_step) / 3.0, 2));
+                }
+            d_carrier_kf.set_pdi(d_code_period);
+            d_carrier_kf.initialize(0.0, d_acq_carrier_doppler_hz, 0.0);
+        }
 
+    // The local codes are generated only the first time a satellite is tracked in the process
+    const uint32_t PRN = d_acquisition_gnss_synchro->PRN;
     if (systemName == "GPS" and signal_type == "1C")
         {
-            gps_l1_ca_code_gen_float(d_tracking_code, d_acquisition_gnss_synchro->PRN, 0);
+            d_tracking_code = local_code("1C", [PRN](float *code) { gps_l1_ca_code_gen_float(code, PRN, 0); });
         }
     else if (systemName == "GPS" and signal_type == "2S")
         {
-            gps_l2c_m_code_gen_float(d_tracking_code, d_acquisition_gnss_synchro->PRN);
+            d_tracking_code = local_code("2S", [PRN](float *code) { gps_l2c_m_code_gen_float(code, PRN); });
         }
     else if (systemName == "GPS" and signal_type == "L5")
         {
             if (trk_parameters.track_pilot)
                 {
-                    gps_l5q_code_gen_float(d_tracking_code, d_acquisition_gnss_synchro->PRN);
-                    gps_l5i_code_gen_float(d_data_code, d_acquisition_gnss_synchro->PRN);
+                    d_tracking_code = local_code("L5Q", [PRN](float *code) { gps_l5q_code_gen_float(code, PRN); });
+                    d_data_code = local_code("L5I", [PRN](float *code) { gps_l5i_code_gen_float(code, PRN); });
                     d_Prompt_Data[0] = gr_complex(0.0, 0.0);
-                    correlator_data_cpu.set_local_code_and_taps(d_code_length_chips, d_data_code, d_prompt_data_shift);
+                    multicorrelator_cpu.set_extra_local_code_and_taps(d_code_length_chips, d_data_code.get(), d_prompt_data_shift);
                 }
             else
                 {
-                    gps_l5i_code_gen_float(d_tracking_code, d_acquisition_gnss_synchro->PRN);
+                    d_tracking_code = local_code("L5I", [PRN](float *code) { gps_l5i_code_gen_float(code, PRN); });
                 }
         }
     else if (systemName == "Galileo" and signal_type == "1B")
         {
             if (trk_parameters.track_pilot)
                 {
-                    char pilot_signal[3] = "1C";
-                    galileo_e1_code_gen_sinboc11_float(d_tracking_code, pilot_signal, d_acquisition_gnss_synchro->PRN);
-                    galileo_e1_code_gen_sinboc11_float(d_data_code, d_acquisition_gnss_synchro->Signal, d_acquisition_gnss_synchro->PRN);
+                    d_tracking_code = local_code("1C", [PRN](float *code) {
+                        char pilot_signal[3] = "1C";
+                        galileo_e1_code_gen_sinboc11_float(code, pilot_signal, PRN);
+                    });
+                    d_data_code = local_code("1B", [PRN](float *code) {
+                        char data_signal[3] = "1B";
+                        galileo_e1_code_gen_sinboc11_float(code, data_signal, PRN);
+                    });
                     d_Prompt_Data[0] = gr_complex(0.0, 0.0);
-                    correlator_data_cpu.set_local_code_and_taps(d_code_samples_per_chip * d_code_length_chips, d_data_code, d_prompt_data_shift);
+                    multicorrelator_cpu.set_extra_local_code_and_taps(d_code_samples_per_chip * d_code_length_chips, d_data_code.get(), d_prompt_data_shift);
                 }
             else
                 {
-                    galileo_e1_code_gen_sinboc11_float(d_tracking_code, d_acquisition_gnss_synchro->Signal, d_acquisition_gnss_synchro->PRN);
+                    d_tracking_code = local_code("1B", [PRN](float *code) {
+                        char data_signal[3] = "1B";
+                        galileo_e1_code_gen_sinboc11_float(code, data_signal, PRN);
+                    });
                 }
         }
     else if (systemName == "Galileo" and signal_type == "5X")
         {
-            auto *aux_code = static_cast<gr_complex *>(volk_gnsssdr_malloc(sizeof(gr_complex) * d_code_length_chips, volk_gnsssdr_get_alignment()));
-            galileo_e5_a_code_gen_complex_primary(aux_code, d_acquisition_gnss_synchro->PRN, const_cast<char *>(signal_type.c_str()));
+            const uint32_t code_length_chips = d_code_length_chips;
+            // the generator returns the full signal: E5aI in the real part, E5aQ in the imaginary part
+            auto e5a_component = [PRN, code_length_chips](float *code, bool pilot) {
+                auto *aux_code = static_cast<gr_complex *>(volk_gnsssdr_malloc(sizeof(gr_complex) * code_length_chips, volk_gnsssdr_get_alignment()));
+                galileo_e5_a_code_gen_complex_primary(aux_code, PRN, "5X");
+                for (uint32_t i = 0; i < code_length_chips; i++)
+                    {
+                        code[i] = pilot ? aux_code[i].imag() : aux_code[i].real();
+                    }
+                volk_gnsssdr_free(aux_code);
+            };
             if (trk_parameters.track_pilot)
                 {
-                    d_secondary_code_string = const_cast<std::string *>(&Galileo_E5a_Q_SECONDARY_CODE[d_acquisition_gnss_synchro->PRN - 1]);
-                    for (uint32_t i = 0; i < d_code_length_chips; i++)
-                        {
-                            d_tracking_code[i] = aux_code[i].imag();
-                            d_data_code[i] = aux_code[i].real();  //the same because it is generated the full signal (E5aI + E5aQ)
-                        }
+                    d_secondary_code_string = const_cast<std::string *>(&Galileo_E5a_Q_SECONDARY_CODE[PRN - 1]);
+                    d_tracking_code = local_code("5Q", [e5a_component](float *code) { e5a_component(code, true); });
+                    d_data_code = local_code("5I", [e5a_component](float *code) { e5a_component(code, false); });
                     d_Prompt_Data[0] = gr_complex(0.0, 0.0);
-                    correlator_data_cpu.set_local_code_and_taps(d_code_length_chips, d_data_code, d_prompt_data_shift);
+                    multicorrelator_cpu.set_extra_local_code_and_taps(d_code_length_chips, d_data_code.get(), d_prompt_data_shift);
                 }
             else
                 {
-                    for (uint32_t i = 0; i < d_code_length_chips; i++)
-                        {
-                            d_tracking_code[i] = aux_code[i].real();
-                        }
+                    d_tracking_code = local_code("5I", [e5a_component](float *code) { e5a_component(code, false); });
                 }
-            volk_gnsssdr_free(aux_code);
         }
 
-    multicorrelator_cpu.set_local_code_and_taps(d_code_samples_per_chip * d_code_length_chips, d_tracking_code, d_local_code_shift_chips);
+    multicorrelator_cpu.set_local_code_and_taps(d_code_samples_per_chip * d_code_length_chips, d_tracking_code.get(), d_local_code_shift_chips);
+    if (d_use_16sc)
+        {
+            // The 16-bit correlator keeps its own int16 copy of the codes
+            multicorrelator_cpu_16sc.set_local_code_and_taps(d_code_samples_per_chip * d_code_length_chips, d_tracking_code.get(), d_local_code_shift_chips);
+            if (trk_parameters.track_pilot)
+                {
+                    multicorrelator_cpu_16sc.set_extra_local_code_and_taps(d_code_samples_per_chip * d_code_length_chips, d_data_code.get(), d_prompt_data_shift);
+                }
+        }
+#if CUDA_GPU_ACCEL
+    if (d_cuda_slot >= 0)
+        {
+            bool uploaded = d_cuda_correlator->set_local_code_and_taps(d_cuda_slot, d_code_samples_per_chip * d_code_length_chips, d_tracking_code.get(), d_local_code_shift_chips);
+            if (uploaded and trk_parameters.track_pilot)
+                {
+                    uploaded = d_cuda_correlator->set_extra_local_code_and_taps(d_cuda_slot, d_code_samples_per_chip * d_code_length_chips, d_data_code.get(), d_prompt_data_shift);
+                }
+            if (!uploaded)
+                {
+                    LOG(WARNING) << "Channel " << d_channel << ": cannot upload the local codes to the GPU, using the CPU from now on";
+                    d_cuda_correlator->remove_channel(d_cuda_slot);
+                    d_cuda_correlator.reset();
+                    d_cuda_slot = -1;
+                }
+        }
+#endif
     std::fill_n(d_correlator_outs, d_n_correlator_taps, gr_complex(0.0, 0.0));
 
     d_carrier_lock_fail_counter = 0;
@@ -542,7 +727,7 @@ void dll_pll_veml_tracking::start_tracking()
     d_rem_carr_phase_rad = 0.0;
     d_rem_code_phase_chips = 0.0;
     d_acc_carrier_phase_rad = 0.0;
-    d_cn0_estimation_counter = 0;
+    d_cn0_estimator.reset();
     d_carrier_lock_test = 1.0;
     d_CN0_SNV_dB_Hz = 0.0;
 
@@ -568,11 +753,25 @@ void dll_pll_veml_tracking::start_tracking()
     std::cout << "Tracking of " << systemName << " " << signal_pretty_name << " signal started on channel " << d_channel << " for satellite " << Gnss_Satellite(systemName, d_acquisition_gnss_synchro->PRN) << std::endl;
     DLOG(INFO) << "Starting tracking of satellite " << Gnss_Satellite(systemName, d_acquisition_gnss_synchro->PRN) << " on channel " << d_channel;
 
+    if (d_reduced_taps)
+        {
+            set_reduced_taps(false);
+        }
+    d_reduce_taps = false;
+    d_strong_cn0_count = 0;
+
     // enable tracking pull-in
     d_state = 1;
     d_cloop = true;
-    d_Prompt_buffer_deque.clear();
+    if (d_secondary)
+        {
+            // The code is known now also for Galileo E5a, which has one per PRN
+            d_secondary_sync.set_code(*d_secondary_code_string);
+        }
+    d_secondary_lock_symbol = 0;
     d_last_prompt = gr_complex(0.0, 0.0);
+    // the dump ring is opened by set_channel(), and the replica table of the multicorrelator grows with the code rates tracked so far
+    update_memory_accounting();
 }
 
 
@@ -594,23 +793,30 @@ dll_pll_veml_tracking::~dll_pll_veml_tracking()
                     LOG(WARNING) << "Exception in destructor " << ex.what();
                 }
         }
+    if (d_dump_stream >= 0)
+        {
+            d_dump_writer->close(d_dump_stream);
+            d_dump_stream = -1;
+        }
     if (d_dump_mat)
         {
             save_matfile();
         }
+    if (d_batch_registered)
+        {
+            d_batch_correlator->remove_channel();
+        }
+#if CUDA_GPU_ACCEL
+    if (d_cuda_slot >= 0)
+        {
+            d_cuda_correlator->remove_channel(d_cuda_slot);
+        }
+#endif
     try
         {
-            volk_gnsssdr_free(d_local_code_shift_chips);
-            volk_gnsssdr_free(d_correlator_outs);
-            volk_gnsssdr_free(d_tracking_code);
-            volk_gnsssdr_free(d_Prompt_Data);
-            if (trk_parameters.track_pilot)
-                {
-                    volk_gnsssdr_free(d_data_code);
-                    correlator_data_cpu.free();
-                }
-            delete[] d_Prompt_buffer;
             multicorrelator_cpu.free();
+            multicorrelator_cpu_16sc.free();
+            d_arena.release();
         }
     catch (const std::exception &ex)
         {
@@ -621,58 +827,51 @@ dll_pll_veml_tracking::~dll_pll_veml_tracking()
 
 bool dll_pll_veml_tracking::acquire_secondary()
 {
-    // ******* preamble correlation ********
-    int32_t corr_value = 0;
-    for (uint32_t i = 0; i < d_secondary_code_length; i++)
+    // ******* secondary code correlation ********
+    int32_t shift;
+    if (trk_parameters.track_pilot)
         {
-            if (d_Prompt_buffer_deque.at(i).real() < 0.0)  // symbols clipping
-                {
-                    if (d_secondary_code_string->at(i) == '0')
-                        {
-                            corr_value++;
-                        }
-                    else
-                        {
-                            corr_value--;
-                        }
-                }
-            else
-                {
-                    if (d_secondary_code_string->at(i) == '0')
-                        {
-                            corr_value--;
-                        }
-                    else
-                        {
-                            corr_value++;
-                        }
-                }
+            // at all the code shifts
+            shift = d_secondary_sync.find_shift();
         }
-
-    if (abs(corr_value) == static_cast<int32_t>(d_secondary_code_length))
+    else
         {
-            return true;
+            // The secondary code of a data component starts with each bit: the extended
+            // integration has to start at the code boundary, or it would straddle the bit transitions
+            shift = d_secondary_sync.matches_shift(0U) ? 0 : -1;
         }
-
-    return false;
+    if (shift < 0)
+        {
+            return false;
+        }
+    // The next prompt is aligned with the secondary code chip of the oldest one in the history
+    d_secondary_lock_symbol = static_cast<uint32_t>(shift);
+    return true;
 }
 
 
 bool dll_pll_veml_tracking::cn0_and_tracking_lock_status(double coh_integration_time_s)
 {
     // ####### CN0 ESTIMATION AND LOCK DETECTORS ######
-    if (d_cn0_estimation_counter < trk_parameters.cn0_samples)
+    if (!d_cn0_estimator.ready())
         {
-            // fill buffer with prompt correlator output values
-            d_Prompt_buffer[d_cn0_estimation_counter] = d_P_accu;
-            d_cn0_estimation_counter++;
+            // accumulate the prompt correlator output values
+            d_cn0_estimator.add(d_P_accu);
             return true;
         }
-    d_cn0_estimation_counter = 0;
     // Code lock indicator
-    d_CN0_SNV_dB_Hz = cn0_svn_estimator(d_Prompt_buffer, trk_parameters.cn0_samples, coh_integration_time_s);
+    d_CN0_SNV_dB_Hz = d_cn0_estimator.cn0_db_hz(coh_integration_time_s);
     // Carrier lock indicator
-    d_carrier_lock_test = carrier_lock_detector(d_Prompt_buffer, trk_parameters.cn0_samples);
+    d_carrier_lock_test = d_cn0_estimator.carrier_lock();
+    d_cn0_estimator.reset();
+    if (d_dump)
+        {
+            d_dump_policy.check_cn0(d_CN0_SNV_dB_Hz, receiver_time_s(), d_acquisition_gnss_synchro->PRN);
+            if (d_carrier_lock_test < d_carrier_lock_threshold and d_carrier_lock_fail_counter == 0)
+                {
+                    d_dump_policy.trigger("carrier lock test failure, possible cycle slip", receiver_time_s());
+                }
+        }
     // Loss of lock detection
     if (d_carrier_lock_test < d_carrier_lock_threshold or d_CN0_SNV_dB_Hz < trk_parameters.cn0_min)
         {
@@ -682,28 +881,136 @@ bool dll_pll_veml_tracking::cn0_and_tracking_lock_status(double coh_integration_
         {
             if (d_carrier_lock_fail_counter > 0) d_carrier_lock_fail_counter--;
         }
+    update_active_taps();
     if (d_carrier_lock_fail_counter > trk_parameters.max_lock_fail)
         {
             std::cout << "Loss of lock in channel " << d_channel << "!" << std::endl;
             LOG(INFO) << "Loss of lock in channel " << d_channel << "!";
             this->message_port_pub(pmt::mp("events"), pmt::from_long(3));  // 3 -> loss of lock
+            d_signal_counters->losses_of_lock.fetch_add(1, std::memory_order_relaxed);
+            if (d_dump)
+                {
+                    d_dump_policy.trigger("loss of lock", receiver_time_s());
+                }
             d_carrier_lock_fail_counter = 0;
+            remove_tracking_state();
             return false;
         }
+    if (d_carrier_lock_fail_counter == 0)
+        {
+            // Let the acquisition of this satellite in other bands know where to look
+            d_state_registry->update(d_acquisition_gnss_synchro->System, d_acquisition_gnss_synchro->PRN, signal_type, d_carrier_doppler_hz, d_signal_carrier_freq, d_CN0_SNV_dB_Hz);
+            d_state_system = d_acquisition_gnss_synchro->System;
+            d_state_prn = d_acquisition_gnss_synchro->PRN;
+        }
     return true;
 }
 
 
+void dll_pll_veml_tracking::remove_tracking_state()
+{
+    // The state is no longer updated once the channel leaves this satellite: stop aiding with it
+    if (d_state_prn != 0)
+        {
+            d_state_registry->remove(d_state_system, d_state_prn, signal_type);
+            d_state_prn = 0;
+        }
+}
+
+
 // correlation requires:
 // - updated remnant carrier phase in radians (rem_carr_phase_rad)
 // - updated remnant code phase in samples (d_rem_code_phase_samples)
 // - d_code_freq_chips
 // - d_carrier_doppler_hz
-void dll_pll_veml_tracking::do_correlation_step(const gr_complex *input_samples)
+// Correlates only E-P-L while the C/N0 stays above Tracking.adaptive_taps_cn0_db_hz, and restores
+// VE and VL as soon as it drops or the carrier lock test fails. The change is applied by
+// apply_active_taps() at the end of the integration
+void dll_pll_veml_tracking::update_active_taps()
+{
+    if (!d_adaptive_taps)
+        {
+            return;
+        }
+    if (d_CN0_SNV_dB_Hz < trk_parameters.adaptive_taps_cn0_db_hz or d_carrier_lock_fail_counter > 0)
+        {
+            d_strong_cn0_count = 0;
+            d_reduce_taps = false;
+            return;
+        }
+    // The taps run on the CPU multicorrelator only
+    if (!d_reduce_taps and d_cuda_slot < 0 and ++d_strong_cn0_count >= ADAPTIVE_TAPS_STRONG_ESTIMATES)
+        {
+            d_reduce_taps = true;
+        }
+}
+
+
+// To be called at an integration boundary, once the discriminator has used the
+// accumulators and they have been reset, so that all of them come from the same taps
+void dll_pll_veml_tracking::apply_active_taps()
+{
+    if (d_reduce_taps != d_reduced_taps)
+        {
+            set_reduced_taps(d_reduce_taps);
+        }
+}
+
+
+void dll_pll_veml_tracking::set_reduced_taps(bool reduced)
 {
+    // Taps are Very-Early, Early, Prompt, Late and Very-Late
+    if (reduced)
+        {
+            multicorrelator_cpu.set_active_correlators(1, 3);
+        }
+    else
+        {
+            multicorrelator_cpu.set_active_correlators(0, d_n_correlator_taps);
+        }
+    d_reduced_taps = reduced;
+    DLOG(INFO) << "Channel " << d_channel << ": " << (reduced ? "E-P-L" : "VE-E-P-L-VL") << " correlators at C/N0 " << d_CN0_SNV_dB_Hz << " dB-Hz";
+}
+
+
+void dll_pll_veml_tracking::do_correlation_step(const void *input_samples)
+{
+    Gnss_Profile_Scope profile("do_correlation_step");
     // ################# CARRIER WIPEOFF AND CORRELATORS ##############################
     // perform carrier wipe-off and compute Early, Prompt and Late correlation
-    multicorrelator_cpu.set_input_output_vectors(d_correlator_outs, input_samples);
+    if (d_use_16sc)
+        {
+            multicorrelator_cpu_16sc.set_input_output_vectors(d_correlator_outs, static_cast<const lv_16sc_t *>(input_samples), d_Prompt_Data);
+            multicorrelator_cpu_16sc.Carrier_wipeoff_multicorrelator_resampler(
+                d_rem_carr_phase_rad,
+                d_carrier_phase_step_rad, d_carrier_phase_rate_step_rad,
+                static_cast<float>(d_rem_code_phase_chips) * static_cast<float>(d_code_samples_per_chip),
+                static_cast<float>(d_code_phase_step_chips) * static_cast<float>(d_code_samples_per_chip),
+                static_cast<float>(d_code_phase_rate_step_chips) * static_cast<float>(d_code_samples_per_chip),
+                trk_parameters.vector_length);
+            return;
+        }
+    if (d_cuda_slot >= 0)
+        {
+            if (do_cuda_correlation_step(static_cast<const gr_complex *>(input_samples)))
+                {
+                    return;
+                }
+#if CUDA_GPU_ACCEL
+            LOG(WARNING) << "Channel " << d_channel << ": CUDA tracking failed, using the CPU from now on";
+            d_cuda_correlator->remove_channel(d_cuda_slot);
+            d_cuda_correlator.reset();
+            d_cuda_slot = -1;
+            d_cuda_tracking = false;
+#endif
+        }
+    if (d_batch_correlator)
+        {
+            do_batch_correlation_step(static_cast<const gr_complex *>(input_samples));
+            return;
+        }
+    // Early, Prompt and Late correlators, plus the data component prompt if tracking the pilot
+    multicorrelator_cpu.set_input_output_vectors(d_correlator_outs, static_cast<const gr_complex *>(input_samples), d_Prompt_Data);
     multicorrelator_cpu.Carrier_wipeoff_multicorrelator_resampler(
         d_rem_carr_phase_rad,
         d_carrier_phase_step_rad, d_carrier_phase_rate_step_rad,
@@ -711,24 +1018,51 @@ void dll_pll_veml_tracking::do_correlation_step(const gr_complex *input_samples)
         static_cast<float>(d_code_phase_step_chips) * static_cast<float>(d_code_samples_per_chip),
         static_cast<float>(d_code_phase_rate_step_chips) * static_cast<float>(d_code_samples_per_chip),
         trk_parameters.vector_length);
+}
 
-    // DATA CORRELATOR (if tracking tracks the pilot signal)
-    if (trk_parameters.track_pilot)
+
+// Same as do_correlation_step, but the input is processed together with the rest of channels
+void dll_pll_veml_tracking::do_batch_correlation_step(const gr_complex *input_samples)
+{
+    if (!d_batch_registered)
         {
-            correlator_data_cpu.set_input_output_vectors(d_Prompt_Data, input_samples);
-            correlator_data_cpu.Carrier_wipeoff_multicorrelator_resampler(
-                d_rem_carr_phase_rad,
-                d_carrier_phase_step_rad, d_carrier_phase_rate_step_rad,
-                static_cast<float>(d_rem_code_phase_chips) * static_cast<float>(d_code_samples_per_chip),
-                static_cast<float>(d_code_phase_step_chips) * static_cast<float>(d_code_samples_per_chip),
-                static_cast<float>(d_code_phase_rate_step_chips) * static_cast<float>(d_code_samples_per_chip),
-                trk_parameters.vector_length);
+            d_batch_correlator->add_channel();
+            d_batch_registered = true;
         }
+    multicorrelator_cpu.set_input_output_vectors(d_correlator_outs, input_samples, d_Prompt_Data);
+    multicorrelator_cpu.start_batch_correlation(
+        d_rem_carr_phase_rad,
+        d_carrier_phase_step_rad, d_carrier_phase_rate_step_rad,
+        static_cast<float>(d_rem_code_phase_chips) * static_cast<float>(d_code_samples_per_chip),
+        static_cast<float>(d_code_phase_step_chips) * static_cast<float>(d_code_samples_per_chip),
+        static_cast<float>(d_code_phase_rate_step_chips) * static_cast<float>(d_code_samples_per_chip),
+        trk_parameters.vector_length);
+    d_batch_correlator->correlate(d_batch_correlators);
+}
+
+
+// Same as do_correlation_step, but the correlations of all the channels run in a single GPU kernel
+bool dll_pll_veml_tracking::do_cuda_correlation_step(const gr_complex *input_samples)
+{
+#if CUDA_GPU_ACCEL
+    d_cuda_tracking = true;
+    // As in the CPU multicorrelator, the rates are only applied with the high dynamics resampler
+    return d_cuda_correlator->correlate(d_cuda_slot, input_samples,
+        d_rem_carr_phase_rad,
+        d_carrier_phase_step_rad, trk_parameters.high_dyn ? d_carrier_phase_rate_step_rad : 0.0,
+        static_cast<float>(d_rem_code_phase_chips) * static_cast<float>(d_code_samples_per_chip),
+        static_cast<float>(d_code_phase_step_chips) * static_cast<float>(d_code_samples_per_chip),
+        trk_parameters.high_dyn ? static_cast<float>(d_code_phase_rate_step_chips) * static_cast<float>(d_code_samples_per_chip) : 0.0F,
+        trk_parameters.vector_length, d_correlator_outs, d_Prompt_Data);
+#else
+    return false;
+#endif
 }
 
 
 void dll_pll_veml_tracking::run_dll_pll()
 {
+    Gnss_Profile_Scope profile("run_dll_pll");
     // ################## PLL ##########################################################
     // PLL discriminator
     if (d_cloop)
@@ -742,22 +1076,30 @@ void dll_pll_veml_tracking::run_dll_pll()
             d_carr_error_hz = pll_four_quadrant_atan(d_P_accu) / PI_2;
         }
 
-    // Carrier discriminator filter
-    d_carr_error_filt_hz = d_carrier_loop_filter.get_carrier_nco(d_carr_error_hz);
-    // New carrier Doppler frequency estimation
-    d_carrier_doppler_hz = d_acq_carrier_doppler_hz + d_carr_error_filt_hz;
-
-
-    // ################## DLL ##########################################################
-    // DLL discriminator
-    if (d_veml)
+    if (d_use_carrier_kf)
         {
-            d_code_error_chips = dll_nc_vemlp_normalized(d_VE_accu, d_E_accu, d_L_accu, d_VL_accu);  // [chips/Ti]
+            // Kalman carrier filter, with the phase detector noise of the current C/N0 (30 dB-Hz until it is estimated)
+            double CN_lin = std::pow(10.0, (d_CN0_SNV_dB_Hz > 0.0 ? d_CN0_SNV_dB_Hz : 30.0) / 10.0);
+            double sigma2_phase_detector = (1.0 / (2.0 * CN_lin * d_carrier_kf.pdi())) * (1.0 + 1.0 / (2.0 * CN_lin * d_carrier_kf.pdi()));
+            d_carrier_kf.predict();
+            d_carrier_kf.update(d_carr_error_hz * PI_2, d_carrier_kf.predicted_phase_variance() + sigma2_phase_detector);
+            // The phase correction goes straight to the NCO
+            d_rem_carr_phase_rad += d_carrier_kf.phase_correction_rad();
+            d_carrier_doppler_hz = d_carrier_kf.doppler_hz();
+            d_carr_error_filt_hz = d_carrier_doppler_hz - d_acq_carrier_doppler_hz;
         }
     else
         {
-            d_code_error_chips = dll_nc_e_minus_l_normalized(d_E_accu, d_L_accu);  // [chips/Ti]
+            // Carrier discriminator filter
+            d_carr_error_filt_hz = d_carrier_loop_filter.get_carrier_nco(d_carr_error_hz);
+            // New carrier Doppler frequency estimation
+            d_carrier_doppler_hz = d_acq_carrier_doppler_hz + d_carr_error_filt_hz;
         }
+
+
+    // ################## DLL ##########################################################
+    // DLL discriminator
+    d_code_error_chips = (this->*d_code_discriminator)();  // [chips/Ti]
     // Code discriminator filter
     d_code_error_filt_chips = d_code_loop_filter.get_code_nco(d_code_error_chips);  // [chips/second]
 
@@ -775,7 +1117,8 @@ void dll_pll_veml_tracking::clear_tracking_vars()
     d_code_error_chips = 0.0;
     d_code_error_filt_chips = 0.0;
     d_current_symbol = 0;
-    d_Prompt_buffer_deque.clear();
+    d_secondary_sync.clear();
+    d_secondary_lock_symbol = 0;
     d_last_prompt = gr_complex(0.0, 0.0);
     d_carrier_phase_rate_step_rad = 0.0;
     d_code_phase_rate_step_chips = 0.0;
@@ -860,13 +1203,98 @@ void dll_pll_veml_tracking::update_tracking_vars()
 }
 
 
-void dll_pll_veml_tracking::save_correlation_results()
+// Picks the per-epoch kernels of the tracked signal, so that general_work does not branch on its features
+void dll_pll_veml_tracking::select_signal_kernels()
 {
-    if (d_secondary)
+    const bool pilot = trk_parameters.track_pilot;
+    if (d_veml)
+        {
+            if (d_secondary)
+                {
+                    if (pilot)
+                        set_signal_kernels<Dll_Pll_Signal_Traits<true, true, true, false>>();
+                    else
+                        set_signal_kernels<Dll_Pll_Signal_Traits<true, true, false, false>>();
+                }
+            else
+                {
+                    if (pilot)
+                        set_signal_kernels<Dll_Pll_Signal_Traits<true, false, true, false>>();
+                    else
+                        set_signal_kernels<Dll_Pll_Signal_Traits<true, false, false, false>>();
+                }
+        }
+    else if (d_secondary)
+        {
+            if (pilot)
+                {
+                    if (interchange_iq)
+                        set_signal_kernels<Dll_Pll_Signal_Traits<false, true, true, true>>();
+                    else
+                        set_signal_kernels<Dll_Pll_Signal_Traits<false, true, true, false>>();
+                }
+            else
+                {
+                    if (interchange_iq)
+                        set_signal_kernels<Dll_Pll_Signal_Traits<false, true, false, true>>();
+                    else
+                        set_signal_kernels<Dll_Pll_Signal_Traits<false, true, false, false>>();
+                }
+        }
+    else
+        {
+            if (pilot)
+                {
+                    if (interchange_iq)
+                        set_signal_kernels<Dll_Pll_Signal_Traits<false, false, true, true>>();
+                    else
+                        set_signal_kernels<Dll_Pll_Signal_Traits<false, false, true, false>>();
+                }
+            else
+                {
+                    if (interchange_iq)
+                        set_signal_kernels<Dll_Pll_Signal_Traits<false, false, false, true>>();
+                    else
+                        set_signal_kernels<Dll_Pll_Signal_Traits<false, false, false, false>>();
+                }
+        }
+}
+
+
+template <typename Traits>
+void dll_pll_veml_tracking::set_signal_kernels()
+{
+    d_load_correlation_results = &dll_pll_veml_tracking::load_correlation_results_t<Traits>;
+    d_save_correlation_results = &dll_pll_veml_tracking::save_correlation_results_t<Traits>;
+    d_code_discriminator = &dll_pll_veml_tracking::code_discriminator_t<Traits>;
+    d_fill_prompt = &dll_pll_veml_tracking::fill_prompt_t<Traits>;
+}
+
+
+// Stores the correlators of a single correlation step
+template <typename Traits>
+void dll_pll_veml_tracking::load_correlation_results_t()
+{
+    if (Traits::veml)
+        {
+            d_VE_accu = *d_Very_Early;
+            d_VL_accu = *d_Very_Late;
+        }
+    d_E_accu = *d_Early;
+    d_P_accu = *d_Prompt;
+    d_L_accu = *d_Late;
+}
+
+
+// Accumulates the correlators in the extended integration, wiping off the secondary code
+template <typename Traits>
+void dll_pll_veml_tracking::save_correlation_results_t()
+{
+    if (Traits::secondary)
         {
             if (d_secondary_code_string->at(d_current_symbol) == '0')
                 {
-                    if (d_veml)
+                    if (Traits::veml)
                         {
                             d_VE_accu += *d_Very_Early;
                             d_VL_accu += *d_Very_Late;
@@ -877,7 +1305,7 @@ void dll_pll_veml_tracking::save_correlation_results()
                 }
             else
                 {
-                    if (d_veml)
+                    if (Traits::veml)
                         {
                             d_VE_accu -= *d_Very_Early;
                             d_VL_accu -= *d_Very_Late;
@@ -892,7 +1320,7 @@ void dll_pll_veml_tracking::save_correlation_results()
         }
     else
         {
-            if (d_veml)
+            if (Traits::veml)
                 {
                     d_VE_accu += *d_Very_Early;
                     d_VL_accu += *d_Very_Late;
@@ -904,10 +1332,38 @@ void dll_pll_veml_tracking::save_correlation_results()
             d_current_symbol %= d_symbols_per_bit;
         }
     // If tracking pilot, disable Costas loop
-    if (trk_parameters.track_pilot)
-        d_cloop = false;
+    d_cloop = !Traits::pilot;
+}
+
+
+template <typename Traits>
+double dll_pll_veml_tracking::code_discriminator_t() const
+{
+    // Without VE and VL, the VEML discriminator would have twice the gain of the E-L one
+    if (Traits::veml and !d_reduced_taps)
+        {
+            return dll_nc_vemlp_normalized(d_VE_accu, d_E_accu, d_L_accu, d_VL_accu);
+        }
+    return dll_nc_e_minus_l_normalized(d_E_accu, d_L_accu);
+}
+
+
+// Prompt correlator output for the telemetry decoder
+template <typename Traits>
+void dll_pll_veml_tracking::fill_prompt_t(Gnss_Synchro &synchro) const
+{
+    // Note that data and pilot components are in quadrature if interchange_iq. I and Q are interchanged
+    const gr_complex prompt = Traits::pilot ? *d_Prompt_Data : *d_Prompt;
+    if (Traits::interchange_iq)
+        {
+            synchro.Prompt_I = static_cast<double>(prompt.imag());
+            synchro.Prompt_Q = static_cast<double>(prompt.real());
+        }
     else
-        d_cloop = true;
+        {
+            synchro.Prompt_I = static_cast<double>(prompt.real());
+            synchro.Prompt_Q = static_cast<double>(prompt.imag());
+        }
 }
 
 
@@ -919,9 +1375,6 @@ void dll_pll_veml_tracking::log_data(bool integrating)
             float prompt_I;
             float prompt_Q;
             float tmp_VE, tmp_E, tmp_P, tmp_L, tmp_VL;
-            float tmp_float;
-            double tmp_double;
-            uint64_t tmp_long_int;
             if (trk_parameters.track_pilot)
                 {
                     if (interchange_iq)
@@ -976,307 +1429,109 @@ void dll_pll_veml_tracking::log_data(bool integrating)
                         }
                 }
 
-            try
-                {
-                    // Dump correlators output
-                    d_dump_file.write(reinterpret_cast<char *>(&tmp_VE), sizeof(float));
-                    d_dump_file.write(reinterpret_cast<char *>(&tmp_E), sizeof(float));
-                    d_dump_file.write(reinterpret_cast<char *>(&tmp_P), sizeof(float));
-                    d_dump_file.write(reinterpret_cast<char *>(&tmp_L), sizeof(float));
-                    d_dump_file.write(reinterpret_cast<char *>(&tmp_VL), sizeof(float));
-                    // PROMPT I and Q (to analyze navigation symbols)
-                    d_dump_file.write(reinterpret_cast<char *>(&prompt_I), sizeof(float));
-                    d_dump_file.write(reinterpret_cast<char *>(&prompt_Q), sizeof(float));
-                    // PRN start sample stamp
-                    tmp_long_int = d_sample_counter + static_cast<uint64_t>(d_current_prn_length_samples);
-                    d_dump_file.write(reinterpret_cast<char *>(&tmp_long_int), sizeof(uint64_t));
-                    // accumulated carrier phase
-                    tmp_float = d_acc_carrier_phase_rad;
-                    d_dump_file.write(reinterpret_cast<char *>(&tmp_float), sizeof(float));
-                    // carrier and code frequency
-                    tmp_float = d_carrier_doppler_hz;
-                    d_dump_file.write(reinterpret_cast<char *>(&tmp_float), sizeof(float));
-                    // carrier phase rate [Hz/s]
-                    tmp_float = d_carrier_phase_rate_step_rad * trk_parameters.fs_in * trk_parameters.fs_in / PI_2;
-                    d_dump_file.write(reinterpret_cast<char *>(&tmp_float), sizeof(float));
-                    tmp_float = d_code_freq_chips;
-                    d_dump_file.write(reinterpret_cast<char *>(&tmp_float), sizeof(float));
-                    // code phase rate [chips/s^2]
-                    tmp_float = d_code_phase_rate_step_chips * trk_parameters.fs_in * trk_parameters.fs_in;
-                    d_dump_file.write(reinterpret_cast<char *>(&tmp_float), sizeof(float));
-                    // PLL commands
-                    tmp_float = d_carr_error_hz;
-                    d_dump_file.write(reinterpret_cast<char *>(&tmp_float), sizeof(float));
-                    tmp_float = d_carr_error_filt_hz;
-                    d_dump_file.write(reinterpret_cast<char *>(&tmp_float), sizeof(float));
-                    // DLL commands
-                    tmp_float = d_code_error_chips;
-                    d_dump_file.write(reinterpret_cast<char *>(&tmp_float), sizeof(float));
-                    tmp_float = d_code_error_filt_chips;
-                    d_dump_file.write(reinterpret_cast<char *>(&tmp_float), sizeof(float));
-                    // CN0 and carrier lock test
-                    tmp_float = d_CN0_SNV_dB_Hz;
-                    d_dump_file.write(reinterpret_cast<char *>(&tmp_float), sizeof(float));
-                    tmp_float = d_carrier_lock_test;
-                    d_dump_file.write(reinterpret_cast<char *>(&tmp_float), sizeof(float));
-                    // AUX vars (for debug purposes)
-                    tmp_float = d_rem_code_phase_samples;
-                    d_dump_file.write(reinterpret_cast<char *>(&tmp_float), sizeof(float));
-                    tmp_double = static_cast<double>(d_sample_counter + d_current_prn_length_samples);
-                    d_dump_file.write(reinterpret_cast<char *>(&tmp_double), sizeof(double));
-                    // PRN
-                    uint32_t prn_ = d_acquisition_gnss_synchro->PRN;
-                    d_dump_file.write(reinterpret_cast<char *>(&prn_), sizeof(uint32_t));
-                }
-            catch (const std::ifstream::failure &e)
-                {
-                    LOG(WARNING) << "Exception writing trk dump file " << e.what();
-                }
+            char record[DUMP_RECORD_BYTES];
+            char *pos = record;
+            // Dump correlators output
+            pos = append_to_record(pos, tmp_VE);
+            pos = append_to_record(pos, tmp_E);
+            pos = append_to_record(pos, tmp_P);
+            pos = append_to_record(pos, tmp_L);
+            pos = append_to_record(pos, tmp_VL);
+            // PROMPT I and Q (to analyze navigation symbols)
+            pos = append_to_record(pos, prompt_I);
+            pos = append_to_record(pos, prompt_Q);
+            // PRN start sample stamp
+            pos = append_to_record(pos, d_sample_counter + static_cast<uint64_t>(d_current_prn_length_samples));
+            // accumulated carrier phase
+            pos = append_to_record(pos, static_cast<float>(d_acc_carrier_phase_rad));
+            // carrier and code frequency
+            pos = append_to_record(pos, static_cast<float>(d_carrier_doppler_hz));
+            // carrier phase rate [Hz/s]
+            pos = append_to_record(pos, static_cast<float>(d_carrier_phase_rate_step_rad * trk_parameters.fs_in * trk_parameters.fs_in / PI_2));
+            pos = append_to_record(pos, static_cast<float>(d_code_freq_chips));
+            // code phase rate [chips/s^2]
+            pos = append_to_record(pos, static_cast<float>(d_code_phase_rate_step_chips * trk_parameters.fs_in * trk_parameters.fs_in));
+            // PLL commands
+            pos = append_to_record(pos, static_cast<float>(d_carr_error_hz));
+            pos = append_to_record(pos, static_cast<float>(d_carr_error_filt_hz));
+            // DLL commands
+            pos = append_to_record(pos, static_cast<float>(d_code_error_chips));
+            pos = append_to_record(pos, static_cast<float>(d_code_error_filt_chips));
+            // CN0 and carrier lock test
+            pos = append_to_record(pos, static_cast<float>(d_CN0_SNV_dB_Hz));
+            pos = append_to_record(pos, static_cast<float>(d_carrier_lock_test));
+            // AUX vars (for debug purposes)
+            pos = append_to_record(pos, static_cast<float>(d_rem_code_phase_samples));
+            pos = append_to_record(pos, static_cast<double>(d_sample_counter + d_current_prn_length_samples));
+            // PRN
+            append_to_record(pos, static_cast<uint32_t>(d_acquisition_gnss_synchro->PRN));
+
+            // The policy calls write_dump_record() for the records that reach the file
+            d_dump_policy.dump(record, receiver_time_s(), d_acquisition_gnss_synchro->PRN);
         }
 }
 
 
-int32_t dll_pll_veml_tracking::save_matfile()
+void dll_pll_veml_tracking::write_dump_record(const char *record)
 {
-    // READ DUMP FILE
-    std::ifstream::pos_type size;
-    int32_t number_of_double_vars = 1;
-    int32_t number_of_float_vars = 19;
-    int32_t epoch_size_bytes = sizeof(uint64_t) + sizeof(double) * number_of_double_vars +
-                               sizeof(float) * number_of_float_vars + sizeof(uint32_t);
-    std::ifstream dump_file;
-    std::string dump_filename_ = d_dump_filename;
-    // add channel number to the filename
-    dump_filename_.append(std::to_string(d_channel));
-    // add extension
-    dump_filename_.append(".dat");
-    std::cout << "Generating .mat file for " << dump_filename_ << std::endl;
-    dump_file.exceptions(std::ifstream::failbit | std::ifstream::badbit);
-    try
-        {
-            dump_file.open(dump_filename_.c_str(), std::ios::binary | std::ios::ate);
-        }
-    catch (const std::ifstream::failure &e)
-        {
-            std::cerr << "Problem opening dump file:" << e.what() << std::endl;
-            return 1;
-        }
-    // count number of epochs and rewind
-    int64_t num_epoch = 0;
-    if (dump_file.is_open())
+    if (d_dump_stream >= 0)
         {
-            size = dump_file.tellg();
-            num_epoch = static_cast<int64_t>(size) / static_cast<int64_t>(epoch_size_bytes);
-            dump_file.seekg(0, std::ios::beg);
+            // The record is written by the receiver-wide dump writer thread
+            d_dump_writer->push(d_dump_stream, record);
+            return;
         }
-    else
-        {
-            return 1;
-        }
-    auto *abs_VE = new float[num_epoch];
-    auto *abs_E = new float[num_epoch];
-    auto *abs_P = new float[num_epoch];
-    auto *abs_L = new float[num_epoch];
-    auto *abs_VL = new float[num_epoch];
-    auto *Prompt_I = new float[num_epoch];
-    auto *Prompt_Q = new float[num_epoch];
-    auto *PRN_start_sample_count = new uint64_t[num_epoch];
-    auto *acc_carrier_phase_rad = new float[num_epoch];
-    auto *carrier_doppler_hz = new float[num_epoch];
-    auto *carrier_doppler_rate_hz = new float[num_epoch];
-    auto *code_freq_chips = new float[num_epoch];
-    auto *code_freq_rate_chips = new float[num_epoch];
-    auto *carr_error_hz = new float[num_epoch];
-    auto *carr_error_filt_hz = new float[num_epoch];
-    auto *code_error_chips = new float[num_epoch];
-    auto *code_error_filt_chips = new float[num_epoch];
-    auto *CN0_SNV_dB_Hz = new float[num_epoch];
-    auto *carrier_lock_test = new float[num_epoch];
-    auto *aux1 = new float[num_epoch];
-    auto *aux2 = new double[num_epoch];
-    auto *PRN = new uint32_t[num_epoch];
-
     try
         {
-            if (dump_file.is_open())
-                {
-                    for (int64_t i = 0; i < num_epoch; i++)
-                        {
-                            dump_file.read(reinterpret_cast<char *>(&abs_VE[i]), sizeof(float));
-                            dump_file.read(reinterpret_cast<char *>(&abs_E[i]), sizeof(float));
-                            dump_file.read(reinterpret_cast<char *>(&abs_P[i]), sizeof(float));
-                            dump_file.read(reinterpret_cast<char *>(&abs_L[i]), sizeof(float));
-                            dump_file.read(reinterpret_cast<char *>(&abs_VL[i]), sizeof(float));
-                            dump_file.read(reinterpret_cast<char *>(&Prompt_I[i]), sizeof(float));
-                            dump_file.read(reinterpret_cast<char *>(&Prompt_Q[i]), sizeof(float));
-                            dump_file.read(reinterpret_cast<char *>(&PRN_start_sample_count[i]), sizeof(uint64_t));
-                            dump_file.read(reinterpret_cast<char *>(&acc_carrier_phase_rad[i]), sizeof(float));
-                            dump_file.read(reinterpret_cast<char *>(&carrier_doppler_hz[i]), sizeof(float));
-                            dump_file.read(reinterpret_cast<char *>(&carrier_doppler_rate_hz[i]), sizeof(float));
-                            dump_file.read(reinterpret_cast<char *>(&code_freq_chips[i]), sizeof(float));
-                            dump_file.read(reinterpret_cast<char *>(&code_freq_rate_chips[i]), sizeof(float));
-                            dump_file.read(reinterpret_cast<char *>(&carr_error_hz[i]), sizeof(float));
-                            dump_file.read(reinterpret_cast<char *>(&carr_error_filt_hz[i]), sizeof(float));
-                            dump_file.read(reinterpret_cast<char *>(&code_error_chips[i]), sizeof(float));
-                            dump_file.read(reinterpret_cast<char *>(&code_error_filt_chips[i]), sizeof(float));
-                            dump_file.read(reinterpret_cast<char *>(&CN0_SNV_dB_Hz[i]), sizeof(float));
-                            dump_file.read(reinterpret_cast<char *>(&carrier_lock_test[i]), sizeof(float));
-                            dump_file.read(reinterpret_cast<char *>(&aux1[i]), sizeof(float));
-                            dump_file.read(reinterpret_cast<char *>(&aux2[i]), sizeof(double));
-                            dump_file.read(reinterpret_cast<char *>(&PRN[i]), sizeof(uint32_t));
-                        }
-                }
-            dump_file.close();
+            d_dump_file.write(record, DUMP_RECORD_BYTES);
         }
     catch (const std::ifstream::failure &e)
         {
-            std::cerr << "Problem reading dump file:" << e.what() << std::endl;
-            delete[] abs_VE;
-            delete[] abs_E;
-            delete[] abs_P;
-            delete[] abs_L;
-            delete[] abs_VL;
-            delete[] Prompt_I;
-            delete[] Prompt_Q;
-            delete[] PRN_start_sample_count;
-            delete[] acc_carrier_phase_rad;
-            delete[] carrier_doppler_hz;
-            delete[] carrier_doppler_rate_hz;
-            delete[] code_freq_chips;
-            delete[] code_freq_rate_chips;
-            delete[] carr_error_hz;
-            delete[] carr_error_filt_hz;
-            delete[] code_error_chips;
-            delete[] code_error_filt_chips;
-            delete[] CN0_SNV_dB_Hz;
-            delete[] carrier_lock_test;
-            delete[] aux1;
-            delete[] aux2;
-            delete[] PRN;
-            return 1;
-        }
-
-    // WRITE MAT FILE
-    mat_t *matfp;
-    matvar_t *matvar;
+            LOG(WARNING) << "Exception writing trk dump file " << e.what();
+        }
+}
+
+
+int32_t dll_pll_veml_tracking::save_matfile()
+{
+    std::string dump_filename_ = d_dump_filename;
+    // add channel number to the filename
+    dump_filename_.append(std::to_string(d_channel));
+    // add extension
+    dump_filename_.append(".dat");
     std::string filename = dump_filename_;
     filename.erase(filename.length() - 4, 4);
     filename.append(".mat");
-    matfp = Mat_CreateVer(filename.c_str(), nullptr, MAT_FT_MAT73);
-    if (reinterpret_cast<int64_t *>(matfp) != nullptr)
-        {
-            size_t dims[2] = {1, static_cast<size_t>(num_epoch)};
-            matvar = Mat_VarCreate("abs_VE", MAT_C_SINGLE, MAT_T_SINGLE, 2, dims, abs_VE, 0);
-            Mat_VarWrite(matfp, matvar, MAT_COMPRESSION_ZLIB);  // or MAT_COMPRESSION_NONE
-            Mat_VarFree(matvar);
-
-            matvar = Mat_VarCreate("abs_E", MAT_C_SINGLE, MAT_T_SINGLE, 2, dims, abs_E, 0);
-            Mat_VarWrite(matfp, matvar, MAT_COMPRESSION_ZLIB);  // or MAT_COMPRESSION_NONE
-            Mat_VarFree(matvar);
-
-            matvar = Mat_VarCreate("abs_P", MAT_C_SINGLE, MAT_T_SINGLE, 2, dims, abs_P, 0);
-            Mat_VarWrite(matfp, matvar, MAT_COMPRESSION_ZLIB);  // or MAT_COMPRESSION_NONE
-            Mat_VarFree(matvar);
-
-            matvar = Mat_VarCreate("abs_L", MAT_C_SINGLE, MAT_T_SINGLE, 2, dims, abs_L, 0);
-            Mat_VarWrite(matfp, matvar, MAT_COMPRESSION_ZLIB);  // or MAT_COMPRESSION_NONE
-            Mat_VarFree(matvar);
-
-            matvar = Mat_VarCreate("abs_VL", MAT_C_SINGLE, MAT_T_SINGLE, 2, dims, abs_VL, 0);
-            Mat_VarWrite(matfp, matvar, MAT_COMPRESSION_ZLIB);  // or MAT_COMPRESSION_NONE
-            Mat_VarFree(matvar);
-
-            matvar = Mat_VarCreate("Prompt_I", MAT_C_SINGLE, MAT_T_SINGLE, 2, dims, Prompt_I, 0);
-            Mat_VarWrite(matfp, matvar, MAT_COMPRESSION_ZLIB);  // or MAT_COMPRESSION_NONE
-            Mat_VarFree(matvar);
-
-            matvar = Mat_VarCreate("Prompt_Q", MAT_C_SINGLE, MAT_T_SINGLE, 2, dims, Prompt_Q, 0);
-            Mat_VarWrite(matfp, matvar, MAT_COMPRESSION_ZLIB);  // or MAT_COMPRESSION_NONE
-            Mat_VarFree(matvar);
-
-            matvar = Mat_VarCreate("PRN_start_sample_count", MAT_C_UINT64, MAT_T_UINT64, 2, dims, PRN_start_sample_count, 0);
-            Mat_VarWrite(matfp, matvar, MAT_COMPRESSION_ZLIB);  // or MAT_COMPRESSION_NONE
-            Mat_VarFree(matvar);
-
-            matvar = Mat_VarCreate("acc_carrier_phase_rad", MAT_C_SINGLE, MAT_T_SINGLE, 2, dims, acc_carrier_phase_rad, 0);
-            Mat_VarWrite(matfp, matvar, MAT_COMPRESSION_ZLIB);  // or MAT_COMPRESSION_NONE
-            Mat_VarFree(matvar);
-
-            matvar = Mat_VarCreate("carrier_doppler_hz", MAT_C_SINGLE, MAT_T_SINGLE, 2, dims, carrier_doppler_hz, 0);
-            Mat_VarWrite(matfp, matvar, MAT_COMPRESSION_ZLIB);  // or MAT_COMPRESSION_NONE
-            Mat_VarFree(matvar);
-
-            matvar = Mat_VarCreate("carrier_doppler_rate_hz", MAT_C_SINGLE, MAT_T_SINGLE, 2, dims, carrier_doppler_rate_hz, 0);
-            Mat_VarWrite(matfp, matvar, MAT_COMPRESSION_ZLIB);  // or MAT_COMPRESSION_NONE
-            Mat_VarFree(matvar);
-
-            matvar = Mat_VarCreate("code_freq_chips", MAT_C_SINGLE, MAT_T_SINGLE, 2, dims, code_freq_chips, 0);
-            Mat_VarWrite(matfp, matvar, MAT_COMPRESSION_ZLIB);  // or MAT_COMPRESSION_NONE
-            Mat_VarFree(matvar);
-
-            matvar = Mat_VarCreate("code_freq_rate_chips", MAT_C_SINGLE, MAT_T_SINGLE, 2, dims, code_freq_rate_chips, 0);
-            Mat_VarWrite(matfp, matvar, MAT_COMPRESSION_ZLIB);  // or MAT_COMPRESSION_NONE
-            Mat_VarFree(matvar);
-
-            matvar = Mat_VarCreate("carr_error_hz", MAT_C_SINGLE, MAT_T_SINGLE, 2, dims, carr_error_hz, 0);
-            Mat_VarWrite(matfp, matvar, MAT_COMPRESSION_ZLIB);  // or MAT_COMPRESSION_NONE
-            Mat_VarFree(matvar);
-
-            matvar = Mat_VarCreate("carr_error_filt_hz", MAT_C_SINGLE, MAT_T_SINGLE, 2, dims, carr_error_filt_hz, 0);
-            Mat_VarWrite(matfp, matvar, MAT_COMPRESSION_ZLIB);  // or MAT_COMPRESSION_NONE
-            Mat_VarFree(matvar);
-
-            matvar = Mat_VarCreate("code_error_chips", MAT_C_SINGLE, MAT_T_SINGLE, 2, dims, code_error_chips, 0);
-            Mat_VarWrite(matfp, matvar, MAT_COMPRESSION_ZLIB);  // or MAT_COMPRESSION_NONE
-            Mat_VarFree(matvar);
-
-            matvar = Mat_VarCreate("code_error_filt_chips", MAT_C_SINGLE, MAT_T_SINGLE, 2, dims, code_error_filt_chips, 0);
-            Mat_VarWrite(matfp, matvar, MAT_COMPRESSION_ZLIB);  // or MAT_COMPRESSION_NONE
-            Mat_VarFree(matvar);
-
-            matvar = Mat_VarCreate("CN0_SNV_dB_Hz", MAT_C_SINGLE, MAT_T_SINGLE, 2, dims, CN0_SNV_dB_Hz, 0);
-            Mat_VarWrite(matfp, matvar, MAT_COMPRESSION_ZLIB);  // or MAT_COMPRESSION_NONE
-            Mat_VarFree(matvar);
-
-            matvar = Mat_VarCreate("carrier_lock_test", MAT_C_SINGLE, MAT_T_SINGLE, 2, dims, carrier_lock_test, 0);
-            Mat_VarWrite(matfp, matvar, MAT_COMPRESSION_ZLIB);  // or MAT_COMPRESSION_NONE
-            Mat_VarFree(matvar);
-
-            matvar = Mat_VarCreate("aux1", MAT_C_SINGLE, MAT_T_SINGLE, 2, dims, aux1, 0);
-            Mat_VarWrite(matfp, matvar, MAT_COMPRESSION_ZLIB);  // or MAT_COMPRESSION_NONE
-            Mat_VarFree(matvar);
-
-            matvar = Mat_VarCreate("aux2", MAT_C_DOUBLE, MAT_T_DOUBLE, 2, dims, aux2, 0);
-            Mat_VarWrite(matfp, matvar, MAT_COMPRESSION_ZLIB);  // or MAT_COMPRESSION_NONE
-            Mat_VarFree(matvar);
-
-            matvar = Mat_VarCreate("PRN", MAT_C_UINT32, MAT_T_UINT32, 2, dims, PRN, 0);
-            Mat_VarWrite(matfp, matvar, MAT_COMPRESSION_ZLIB);  // or MAT_COMPRESSION_NONE
-            Mat_VarFree(matvar);
-        }
-    Mat_Close(matfp);
-    delete[] abs_VE;
-    delete[] abs_E;
-    delete[] abs_P;
-    delete[] abs_L;
-    delete[] abs_VL;
-    delete[] Prompt_I;
-    delete[] Prompt_Q;
-    delete[] PRN_start_sample_count;
-    delete[] acc_carrier_phase_rad;
-    delete[] carrier_doppler_hz;
-    delete[] carrier_doppler_rate_hz;
-    delete[] code_freq_chips;
-    delete[] code_freq_rate_chips;
-    delete[] carr_error_hz;
-    delete[] carr_error_filt_hz;
-    delete[] code_error_chips;
-    delete[] code_error_filt_chips;
-    delete[] CN0_SNV_dB_Hz;
-    delete[] carrier_lock_test;
-    delete[] aux1;
-    delete[] aux2;
-    delete[] PRN;
+    if (d_dump_compressed)
+        {
+            dump_filename_.append(".gz");
+        }
+    // Same order as the dump records
+    const std::vector<Gnss_Mat_Converter::Field> fields = {
+        {"abs_VE", MAT_C_SINGLE, MAT_T_SINGLE, sizeof(float)},
+        {"abs_E", MAT_C_SINGLE, MAT_T_SINGLE, sizeof(float)},
+        {"abs_P", MAT_C_SINGLE, MAT_T_SINGLE, sizeof(float)},
+        {"abs_L", MAT_C_SINGLE, MAT_T_SINGLE, sizeof(float)},
+        {"abs_VL", MAT_C_SINGLE, MAT_T_SINGLE, sizeof(float)},
+        {"Prompt_I", MAT_C_SINGLE, MAT_T_SINGLE, sizeof(float)},
+        {"Prompt_Q", MAT_C_SINGLE, MAT_T_SINGLE, sizeof(float)},
+        {"PRN_start_sample_count", MAT_C_UINT64, MAT_T_UINT64, sizeof(uint64_t)},
+        {"acc_carrier_phase_rad", MAT_C_SINGLE, MAT_T_SINGLE, sizeof(float)},
+        {"carrier_doppler_hz", MAT_C_SINGLE, MAT_T_SINGLE, sizeof(float)},
+        {"carrier_doppler_rate_hz", MAT_C_SINGLE, MAT_T_SINGLE, sizeof(float)},
+        {"code_freq_chips", MAT_C_SINGLE, MAT_T_SINGLE, sizeof(float)},
+        {"code_freq_rate_chips", MAT_C_SINGLE, MAT_T_SINGLE, sizeof(float)},
+        {"carr_error_hz", MAT_C_SINGLE, MAT_T_SINGLE, sizeof(float)},
+        {"carr_error_filt_hz", MAT_C_SINGLE, MAT_T_SINGLE, sizeof(float)},
+        {"code_error_chips", MAT_C_SINGLE, MAT_T_SINGLE, sizeof(float)},
+        {"code_error_filt_chips", MAT_C_SINGLE, MAT_T_SINGLE, sizeof(float)},
+        {"CN0_SNV_dB_Hz", MAT_C_SINGLE, MAT_T_SINGLE, sizeof(float)},
+        {"carrier_lock_test", MAT_C_SINGLE, MAT_T_SINGLE, sizeof(float)},
+        {"aux1", MAT_C_SINGLE, MAT_T_SINGLE, sizeof(float)},
+        {"aux2", MAT_C_DOUBLE, MAT_T_DOUBLE, sizeof(double)},
+        {"PRN", MAT_C_UINT32, MAT_T_UINT32, sizeof(uint32_t)}};
+    // The conversion runs in the background, in chunks of records
+    std::cout << "Generating .mat file for " << dump_filename_ << std::endl;
+    d_mat_converter->convert(dump_filename_, filename, fields);
     return 0;
 }
 
@@ -1285,6 +1540,8 @@ void dll_pll_veml_tracking::set_channel(uint32_t channel)
 {
     gr::thread::scoped_lock l(d_setlock);
     d_channel = channel;
+    d_work_time = Gnss_Metrics::get_instance()->get_histogram("gnss_sdr_tracking_work_seconds", "channel=\"" + std::to_string(d_channel) + "\"");
+    d_memory.set_channel(static_cast<int32_t>(d_channel));
     LOG(INFO) << "Tracking Channel set to " << d_channel;
     // ############# ENABLE DATA FILE LOG #################
     if (d_dump)
@@ -1295,7 +1552,26 @@ void dll_pll_veml_tracking::set_channel(uint32_t channel)
             // add extension
             dump_filename_.append(".dat");
 
-            if (!d_dump_file.is_open())
+            // at most one record per millisecond
+            d_dump_policy.set_channel(static_cast<int32_t>(d_channel));
+            d_dump_policy.set_writer("tracking channel " + std::to_string(d_channel), DUMP_RECORD_BYTES, 1000.0, [this](const char *record) { write_dump_record(record); });
+
+            if (trk_parameters.dump_async and d_dump_stream < 0)
+                {
+                    std::string async_filename_ = dump_filename_ + (d_dump_compressed ? ".gz" : "");
+                    d_dump_writer = Tracking_Dump_Writer::get_instance();
+                    // a triggered dump writes its whole pre-trigger ring at once
+                    auto ring_records = static_cast<uint32_t>(std::max<size_t>(4096, d_dump_policy.ring_records(1000.0)));
+                    d_dump_stream = d_dump_writer->open(async_filename_, DUMP_RECORD_BYTES, d_dump_compressed, ring_records);
+                    if (d_dump_stream >= 0)
+                        {
+                            LOG(INFO) << "Tracking dump enabled on channel " << d_channel << " Log file: " << async_filename_.c_str();
+                            return;
+                        }
+                    // fall back to the synchronous dump
+                    d_dump_compressed = false;
+                }
+            if (d_dump_stream < 0 and !d_dump_file.is_open())
                 {
                     try
                         {
@@ -1317,6 +1593,7 @@ void dll_pll_veml_tracking::set_channel(uint32_t channel)
 void dll_pll_veml_tracking::set_gnss_synchro(Gnss_Synchro *p_gnss_synchro)
 {
     gr::thread::scoped_lock l(d_setlock);
+    remove_tracking_state();
     d_acquisition_gnss_synchro = p_gnss_synchro;
 }
 
@@ -1325,24 +1602,94 @@ void dll_pll_veml_tracking::stop_tracking()
 {
     gr::thread::scoped_lock l(d_setlock);
     d_state = 0;
+    remove_tracking_state();
+}
+
+void dll_pll_veml_tracking::fuse_telemetry_decoder(gr::basic_block_sptr decoder_block, TelemetrySymbolProcessor *decoder)
+{
+    gr::thread::scoped_lock l(d_setlock);
+    d_telemetry_block = decoder_block;
+    d_telemetry = decoder;
+    d_telemetry_block->message_port_sub(pmt::mp("telemetry"), pmt::cons(alias_pmt(), pmt::mp("telemetry_in")));
+}
+
+
+void dll_pll_veml_tracking::msg_handler_telemetry(pmt::pmt_t msg)
+{
+    this->message_port_pub(pmt::mp("telemetry"), msg);
 }
 
-int dll_pll_veml_tracking::general_work(int noutput_items __attribute__((unused)), gr_vector_int &ninput_items,
+
+int dll_pll_veml_tracking::general_work(int noutput_items, gr_vector_int &ninput_items,
     gr_vector_const_void_star &input_items, gr_vector_void_star &output_items)
 {
     gr::thread::scoped_lock l(d_setlock);
-    const auto *in = reinterpret_cast<const gr_complex *>(input_items[0]);
-    auto **out = reinterpret_cast<Gnss_Synchro **>(&output_items[0]);
-    Gnss_Synchro current_synchro_data = Gnss_Synchro();
+    const auto start_time = std::chrono::steady_clock::now();
+    const bool tracking = (d_state != 0);
+    Gnss_Trace_Span span("tracking", d_channel);
+    const uint64_t first_sample = d_sample_counter;
+    const auto *in = static_cast<const uint8_t *>(input_items[0]);  // gr_complex or lv_16sc_t samples
+    auto *out = reinterpret_cast<Gnss_Synchro *>(output_items[0]);
+    const int32_t max_epochs = std::min(noutput_items, d_max_epochs_per_call);
+    const auto min_epoch_samples = static_cast<int32_t>(trk_parameters.vector_length) * 2;
+    int32_t consumed = 0;
+    int32_t produced = 0;
+
+    // Process every complete code period in the input buffer, up to max_epochs outputs
+    for (;;)
+        {
+            bool standby = (d_state == 0);
+            Gnss_Synchro current_synchro_data = Gnss_Synchro();
+            consumed += process_epoch(in + static_cast<size_t>(consumed) * d_input_item_size, ninput_items[0] - consumed, current_synchro_data);
+            if (current_synchro_data.Flag_valid_symbol_output)
+                {
+                    if (d_telemetry == nullptr)
+                        {
+                            out[produced++] = current_synchro_data;
+                        }
+                    else if (d_telemetry->process_symbol(current_synchro_data, out[produced]) > 0)
+                        {
+                            produced++;
+                        }
+                }
+            if (standby or d_state == 0 or produced == max_epochs or ninput_items[0] - consumed < min_epoch_samples)
+                {
+                    break;
+                }
+        }
+    consume_each(consumed);
+    d_sample_clock->advance(d_sample_counter * static_cast<uint64_t>(trk_parameters.pre_decimation_factor));
+    span.set_samples(first_sample, d_sample_counter);
+    if (tracking and d_work_time)
+        {
+            d_work_time->record(std::chrono::steady_clock::now() - start_time);
+        }
+    return produced;
+}
+
 
+// Runs one step of the tracking state machine. Returns the number of input samples it used
+int32_t dll_pll_veml_tracking::process_epoch(const void *in, int32_t ninput_items, Gnss_Synchro &current_synchro_data)
+{
     switch (d_state)
         {
         case 0:  // Standby - Consume samples at full throttle, do nothing
             {
-                d_sample_counter += static_cast<uint64_t>(ninput_items[0]);
-                consume_each(ninput_items[0]);
-                return 0;
-                break;
+                if (d_batch_registered)
+                    {
+                        // Do not make the rest of channels wait for this one
+                        d_batch_correlator->remove_channel();
+                        d_batch_registered = false;
+                    }
+#if CUDA_GPU_ACCEL
+                if (d_cuda_tracking)
+                    {
+                        d_cuda_correlator->set_idle(d_cuda_slot);
+                        d_cuda_tracking = false;
+                    }
+#endif
+                d_sample_counter += static_cast<uint64_t>(ninput_items);
+                return ninput_items;
             }
         case 1:  // Pull-in
             {
@@ -1368,27 +1715,20 @@ int dll_pll_veml_tracking::general_work(int noutput_items __attribute__((unused)
                 int32_t samples_offset = round(d_acq_code_phase_samples);
                 d_acc_carrier_phase_rad -= d_carrier_phase_step_rad * static_cast<double>(samples_offset);
                 d_state = 2;
+                d_signal_counters->locks.fetch_add(1, std::memory_order_relaxed);
                 d_sample_counter += samples_offset;  // count for the processed samples
 
                 DLOG(INFO) << "Number of samples between Acquisition and Tracking = " << acq_trk_diff_samples << " ( " << acq_trk_diff_seconds << " s)";
                 DLOG(INFO) << "PULL-IN Doppler [Hz] = " << d_carrier_doppler_hz
                            << ". PULL-IN Code Phase [samples] = " << d_acq_code_phase_samples;
 
-                consume_each(samples_offset);  // shift input to perform alignment with local replica
-                return 0;
+                return samples_offset;  // shift input to perform alignment with local replica
             }
         case 2:  // Wide tracking and symbol synchronization
             {
                 do_correlation_step(in);
                 // Save single correlation step variables
-                if (d_veml)
-                    {
-                        d_VE_accu = *d_Very_Early;
-                        d_VL_accu = *d_Very_Late;
-                    }
-                d_E_accu = *d_Early;
-                d_P_accu = *d_Prompt;
-                d_L_accu = *d_Late;
+                (this->*d_load_correlation_results)();
 
                 // Check lock status
                 if (!cn0_and_tracking_lock_status(d_code_period))
@@ -1402,14 +1742,16 @@ int dll_pll_veml_tracking::general_work(int noutput_items __attribute__((unused)
                         // Perform DLL/PLL tracking loop computations. Costas Loop enabled
                         run_dll_pll();
                         update_tracking_vars();
+                        // each correlation step is a whole integration in this state
+                        apply_active_taps();
 
                         // enable write dump file this cycle (valid DLL/PLL cycle)
                         log_data(false);
                         if (d_secondary)
                             {
                                 // ####### SECONDARY CODE LOCK #####
-                                d_Prompt_buffer_deque.push_back(*d_Prompt);
-                                if (d_Prompt_buffer_deque.size() == d_secondary_code_length)
+                                d_secondary_sync.push_sign(d_Prompt->real() < 0.0);
+                                if (d_secondary_sync.full())
                                     {
                                         next_state = acquire_secondary();
                                         if (next_state)
@@ -1417,8 +1759,6 @@ int dll_pll_veml_tracking::general_work(int noutput_items __attribute__((unused)
                                                 std::cout << systemName << " " << signal_pretty_name << " secondary code locked in channel " << d_channel
                                                           << " for satellite " << Gnss_Satellite(systemName, d_acquisition_gnss_synchro->PRN) << std::endl;
                                             }
-
-                                        d_Prompt_buffer_deque.pop_front();
                                     }
                             }
                         else if (d_symbols_per_bit > 1)  //Signal does not have secondary code. Search a bit transition by sign change
@@ -1464,34 +1804,7 @@ int dll_pll_veml_tracking::general_work(int noutput_items __attribute__((unused)
                             }
 
                         // ########### Output the tracking results to Telemetry block ##########
-                        if (interchange_iq)
-                            {
-                                if (trk_parameters.track_pilot)
-                                    {
-                                        // Note that data and pilot components are in quadrature. I and Q are interchanged
-                                        current_synchro_data.Prompt_I = static_cast<double>((*d_Prompt_Data).imag());
-                                        current_synchro_data.Prompt_Q = static_cast<double>((*d_Prompt_Data).real());
-                                    }
-                                else
-                                    {
-                                        current_synchro_data.Prompt_I = static_cast<double>((*d_Prompt).imag());
-                                        current_synchro_data.Prompt_Q = static_cast<double>((*d_Prompt).real());
-                                    }
-                            }
-                        else
-                            {
-                                if (trk_parameters.track_pilot)
-                                    {
-                                        // Note that data and pilot components are in quadrature. I and Q are interchanged
-                                        current_synchro_data.Prompt_I = static_cast<double>((*d_Prompt_Data).real());
-                                        current_synchro_data.Prompt_Q = static_cast<double>((*d_Prompt_Data).imag());
-                                    }
-                                else
-                                    {
-                                        current_synchro_data.Prompt_I = static_cast<double>((*d_Prompt).real());
-                                        current_synchro_data.Prompt_Q = static_cast<double>((*d_Prompt).imag());
-                                    }
-                            }
+                        (this->*d_fill_prompt)(current_synchro_data);
                         current_synchro_data.Code_phase_samples = d_rem_code_phase_samples;
                         current_synchro_data.Carrier_phase_rads = d_acc_carrier_phase_rad;
                         current_synchro_data.Carrier_Doppler_hz = d_carrier_doppler_hz;
@@ -1507,8 +1820,8 @@ int dll_pll_veml_tracking::general_work(int noutput_items __attribute__((unused)
                                 d_L_accu = gr_complex(0.0, 0.0);
                                 d_VL_accu = gr_complex(0.0, 0.0);
                                 d_last_prompt = gr_complex(0.0, 0.0);
-                                d_Prompt_buffer_deque.clear();
-                                d_current_symbol = 0;
+                                d_secondary_sync.clear();
+                                d_current_symbol = d_secondary_lock_symbol;
 
                                 if (d_enable_extended_integration)
                                     {
@@ -1516,6 +1829,7 @@ int dll_pll_veml_tracking::general_work(int noutput_items __attribute__((unused)
                                         d_extend_correlation_symbols_count = 0;
                                         float new_correlation_time = static_cast<float>(trk_parameters.extend_correlation_symbols) * static_cast<float>(d_code_period);
                                         d_carrier_loop_filter.set_pdi(new_correlation_time);
+                                        d_carrier_kf.set_pdi(new_correlation_time);
                                         d_code_loop_filter.set_pdi(new_correlation_time);
                                         d_state = 3;  // next state is the extended correlator integrator
                                         LOG(INFO) << "Enabled " << trk_parameters.extend_correlation_symbols * static_cast<int32_t>(d_code_period * 1000.0) << " ms extended correlator in channel "
@@ -1555,37 +1869,10 @@ int dll_pll_veml_tracking::general_work(int noutput_items __attribute__((unused)
                 // perform a correlation step
                 do_correlation_step(in);
                 update_tracking_vars();
-                save_correlation_results();
+                (this->*d_save_correlation_results)();
 
                 // ########### Output the tracking results to Telemetry block ##########
-                if (interchange_iq)
-                    {
-                        if (trk_parameters.track_pilot)
-                            {
-                                // Note that data and pilot components are in quadrature. I and Q are interchanged
-                                current_synchro_data.Prompt_I = static_cast<double>((*d_Prompt_Data).imag());
-                                current_synchro_data.Prompt_Q = static_cast<double>((*d_Prompt_Data).real());
-                            }
-                        else
-                            {
-                                current_synchro_data.Prompt_I = static_cast<double>((*d_Prompt).imag());
-                                current_synchro_data.Prompt_Q = static_cast<double>((*d_Prompt).real());
-                            }
-                    }
-                else
-                    {
-                        if (trk_parameters.track_pilot)
-                            {
-                                // Note that data and pilot components are in quadrature. I and Q are interchanged
-                                current_synchro_data.Prompt_I = static_cast<double>((*d_Prompt_Data).real());
-                                current_synchro_data.Prompt_Q = static_cast<double>((*d_Prompt_Data).imag());
-                            }
-                        else
-                            {
-                                current_synchro_data.Prompt_I = static_cast<double>((*d_Prompt).real());
-                                current_synchro_data.Prompt_Q = static_cast<double>((*d_Prompt).imag());
-                            }
-                    }
+                (this->*d_fill_prompt)(current_synchro_data);
                 current_synchro_data.Code_phase_samples = d_rem_code_phase_samples;
                 current_synchro_data.Carrier_phase_rads = d_acc_carrier_phase_rad;
                 current_synchro_data.Carrier_Doppler_hz = d_carrier_doppler_hz;
@@ -1608,7 +1895,7 @@ int dll_pll_veml_tracking::general_work(int noutput_items __attribute__((unused)
 
                 // perform a correlation step
                 do_correlation_step(in);
-                save_correlation_results();
+                (this->*d_save_correlation_results)();
 
                 // check lock status
                 if (!cn0_and_tracking_lock_status(d_code_period * static_cast<double>(trk_parameters.extend_correlation_symbols)))
@@ -1622,34 +1909,7 @@ int dll_pll_veml_tracking::general_work(int noutput_items __attribute__((unused)
                         update_tracking_vars();
 
                         // ########### Output the tracking results to Telemetry block ##########
-                        if (interchange_iq)
-                            {
-                                if (trk_parameters.track_pilot)
-                                    {
-                                        // Note that data and pilot components are in quadrature. I and Q are interchanged
-                                        current_synchro_data.Prompt_I = static_cast<double>((*d_Prompt_Data).imag());
-                                        current_synchro_data.Prompt_Q = static_cast<double>((*d_Prompt_Data).real());
-                                    }
-                                else
-                                    {
-                                        current_synchro_data.Prompt_I = static_cast<double>((*d_Prompt).imag());
-                                        current_synchro_data.Prompt_Q = static_cast<double>((*d_Prompt).real());
-                                    }
-                            }
-                        else
-                            {
-                                if (trk_parameters.track_pilot)
-                                    {
-                                        // Note that data and pilot components are in quadrature. I and Q are interchanged
-                                        current_synchro_data.Prompt_I = static_cast<double>((*d_Prompt_Data).real());
-                                        current_synchro_data.Prompt_Q = static_cast<double>((*d_Prompt_Data).imag());
-                                    }
-                                else
-                                    {
-                                        current_synchro_data.Prompt_I = static_cast<double>((*d_Prompt).real());
-                                        current_synchro_data.Prompt_Q = static_cast<double>((*d_Prompt).imag());
-                                    }
-                            }
+                        (this->*d_fill_prompt)(current_synchro_data);
                         current_synchro_data.Code_phase_samples = d_rem_code_phase_samples;
                         current_synchro_data.Carrier_phase_rads = d_acc_carrier_phase_rad;
                         current_synchro_data.Carrier_Doppler_hz = d_carrier_doppler_hz;
@@ -1664,6 +1924,7 @@ int dll_pll_veml_tracking::general_work(int noutput_items __attribute__((unused)
                         d_P_accu = gr_complex(0.0, 0.0);
                         d_L_accu = gr_complex(0.0, 0.0);
                         d_VL_accu = gr_complex(0.0, 0.0);
+                        apply_active_taps();
                         if (d_enable_extended_integration)
                             {
                                 d_state = 3;  // new coherent integration (correlation time extension) cycle
@@ -1671,14 +1932,17 @@ int dll_pll_veml_tracking::general_work(int noutput_items __attribute__((unused)
                     }
             }
         }
-    consume_each(d_current_prn_length_samples);
     d_sample_counter += static_cast<uint64_t>(d_current_prn_length_samples);
     if (current_synchro_data.Flag_valid_symbol_output)
         {
-            current_synchro_data.fs = static_cast<int64_t>(trk_parameters.fs_in);
-            current_synchro_data.Tracking_sample_counter = d_sample_counter;
-            *out[0] = current_synchro_data;
-            return 1;
+            // report the stamps in samples of the receiver clock, which runs at the full input rate
+            int64_t decimation = static_cast<int64_t>(trk_parameters.pre_decimation_factor);
+            current_synchro_data.fs = static_cast<int64_t>(trk_parameters.fs_in) * decimation;
+            current_synchro_data.Tracking_sample_counter = d_sample_counter * static_cast<uint64_t>(decimation);
+            if (decimation > 1)
+                {
+                    current_synchro_data.Code_phase_samples = current_synchro_data.Code_phase_samples * static_cast<double>(decimation) + static_cast<double>(decimation - 1) / 2.0;
+                }
         }
-    return 0;
+    return d_current_prn_length_samples;
 }
@@ -6,7 +6,7 @@
  *
  * -------------------------------------------------------------------------
  *
- * Copyright (C) 2010-2018  (see AUTHORS file for a list of contributors)
+ * Copyright (C) 2010-2019  (see AUTHORS file for a list of contributors)
  *
  * GNSS-SDR is a software defined Global Navigation
  *          Satellite Systems receiver
@@ -32,29 +32,61 @@
 #ifndef GNSS_SDR_DLL_PLL_VEML_TRACKING_H
 #define GNSS_SDR_DLL_PLL_VEML_TRACKING_H
 
+#include "cpu_multicorrelator_batch.h"
 #include "cpu_multicorrelator_real_codes.h"
+#include "cpu_multicorrelator_real_codes_16sc.h"
 #include "dll_pll_conf.h"
+#include "gnss_arena.h"
+#include "gnss_mat_converter.h"
+#include "gnss_memory_accounting.h"
+#include "gnss_metrics.h"
+#include "gnss_sdr_sample_clock.h"
 #include "gnss_synchro.h"
+#include "gnss_tracking_state_registry.h"
+#include "lock_detectors.h"
+#include "secondary_code_sync.h"
+#include "telemetry_symbol_processor.h"
 #include "tracking_2nd_DLL_filter.h"
 #include "tracking_2nd_PLL_filter.h"
+#include "tracking_dump_writer.h"
+#include "tracking_kf_carrier_filter.h"
 #include <boost/circular_buffer.hpp>
 #include <gnuradio/block.h>
 #include <fstream>
+#include <functional>
 #include <map>
+#include <memory>
 #include <queue>
 #include <string>
 #include <utility>
+#include <vector>
 
 class dll_pll_veml_tracking;
 
+class cuda_multicorrelator_batch;
+
 typedef boost::shared_ptr<dll_pll_veml_tracking> dll_pll_veml_tracking_sptr;
 
 dll_pll_veml_tracking_sptr dll_pll_veml_make_tracking(const Dll_Pll_Conf &conf_);
 
+/*!
+ * \brief Signal features that the tracking loop branches on at every epoch.
+ * They are fixed when the block is built, so each combination gets its own
+ * instantiation of the per-epoch kernels.
+ */
+template <bool VEML, bool SECONDARY, bool PILOT, bool INTERCHANGE_IQ>
+struct Dll_Pll_Signal_Traits
+{
+    static const bool veml = VEML;                      // Very Early and Very Late taps
+    static const bool secondary = SECONDARY;            // secondary code wipe-off in the extended integration
+    static const bool pilot = PILOT;                    // tracking the pilot, with a data prompt tap
+    static const bool interchange_iq = INTERCHANGE_IQ;  // data and pilot components in quadrature
+};
+
 /*!
  * \brief This class implements a code DLL + carrier PLL tracking block.
  */
-class dll_pll_veml_tracking : public gr::block
+class dll_pll_veml_tracking : public gr::block, public TelemetryFusedTracking
 {
 public:
     ~dll_pll_veml_tracking();
@@ -69,20 +101,54 @@ public:
 
     void forecast(int noutput_items, gr_vector_int &ninput_items_required);
 
+    void fuse_telemetry_decoder(gr::basic_block_sptr decoder_block, TelemetrySymbolProcessor *decoder) override;
+
 private:
     friend dll_pll_veml_tracking_sptr dll_pll_veml_make_tracking(const Dll_Pll_Conf &conf_);
 
     dll_pll_veml_tracking(const Dll_Pll_Conf &conf_);
     void msg_handler_preamble_index(pmt::pmt_t msg);
+    void msg_handler_telemetry(pmt::pmt_t msg);
+    int32_t process_epoch(const void *in, int32_t ninput_items, Gnss_Synchro &current_synchro_data);
 
     bool cn0_and_tracking_lock_status(double coh_integration_time_s);
+    void remove_tracking_state();
+    void update_active_taps();
+    void apply_active_taps();
+    void set_reduced_taps(bool reduced);
     bool acquire_secondary();
-    void do_correlation_step(const gr_complex *input_samples);
+    void do_correlation_step(const void *input_samples);
+    void do_batch_correlation_step(const gr_complex *input_samples);
+    bool do_cuda_correlation_step(const gr_complex *input_samples);
     void run_dll_pll();
     void update_tracking_vars();
     void clear_tracking_vars();
-    void save_correlation_results();
     void log_data(bool integrating);
+    void write_dump_record(const char *record);
+    inline double receiver_time_s() const
+    {
+        return static_cast<double>(d_sample_counter) / trk_parameters.fs_in;
+    }
+    void select_signal_kernels();
+    std::shared_ptr<const float> local_code(const std::string &component, const std::function<void(float *)> &generate);
+    void update_memory_accounting();
+
+    // per-epoch kernels, instantiated for the Dll_Pll_Signal_Traits of the tracked signal
+    template <typename Traits>
+    void set_signal_kernels();
+    template <typename Traits>
+    void load_correlation_results_t();
+    template <typename Traits>
+    void save_correlation_results_t();
+    template <typename Traits>
+    double code_discriminator_t() const;
+    template <typename Traits>
+    void fill_prompt_t(Gnss_Synchro &synchro) const;
+
+    void (dll_pll_veml_tracking::*d_load_correlation_results)();
+    void (dll_pll_veml_tracking::*d_save_correlation_results)();
+    double (dll_pll_veml_tracking::*d_code_discriminator)() const;
+    void (dll_pll_veml_tracking::*d_fill_prompt)(Gnss_Synchro &synchro) const;
     int32_t save_matfile();
 
     // tracking configuration vars
@@ -106,6 +172,15 @@ private:
     std::string signal_type;
     std::string *d_secondary_code_string;
     std::string signal_pretty_name;
+    std::shared_ptr<Gnss_Signal_Counters> d_signal_counters;
+    std::shared_ptr<Gnss_Duration_Histogram> d_work_time;  // duration of the calls to general_work() while tracking
+    std::shared_ptr<Gnss_Tracking_State_Registry> d_state_registry;  // of the receiver this channel belongs to
+    char d_state_system;                                             // satellite of the state this channel keeps in d_state_registry
+    uint32_t d_state_prn;                                            // 0 if there is none
+    Gnss_Memory_Account d_memory;  // correlator buffers, histories and dump ring of this channel
+    std::shared_ptr<Gnss_Sdr_Sample_Clock> d_sample_clock;  // advanced with the samples read by this channel
+    gr::basic_block_sptr d_telemetry_block;                 // decoder fused into this block, kept alive for its message ports
+    TelemetrySymbolProcessor *d_telemetry;                  // decodes the symbols in place, nullptr if not fused
 
     int32_t *d_gps_l1ca_preambles_symbols;
     boost::circular_buffer<float> d_symbol_history;
@@ -115,18 +190,27 @@ private:
     //Integration period in samples
     int32_t d_correlation_length_ms;
     int32_t d_n_correlator_taps;
+    bool d_adaptive_taps;        // VE and VL are only correlated when the signal is weak
+    bool d_reduced_taps;         // only E-P-L are being correlated
+    bool d_reduce_taps;          // E-P-L requested, from the next integration on
+    int32_t d_strong_cn0_count;  // consecutive C/N0 estimates above trk_parameters.adaptive_taps_cn0_db_hz
 
-    float *d_tracking_code;
-    float *d_data_code;
+    std::shared_ptr<const float> d_tracking_code;  // shared with the other channels through Trk_Code_Cache
+    std::shared_ptr<const float> d_data_code;
+    Gnss_Arena d_arena;  // working arrays of this channel: tap shifts, resampled local codes, correlator outputs
     float *d_local_code_shift_chips;
     float *d_prompt_data_shift;
-    cpu_multicorrelator_real_codes multicorrelator_cpu;
-    cpu_multicorrelator_real_codes correlator_data_cpu;  //for data channel
-    /*  TODO: currently the multicorrelator does not support adding extra correlator
-        with different local code, thus we need extra multicorrelator instance.
-        Implement this functionality inside multicorrelator class
-        as an enhancement to increase the performance
-     */
+    cpu_multicorrelator_real_codes multicorrelator_cpu;  // pilot (or data) taps, plus the data prompt if tracking the pilot
+    cpu_multicorrelator_real_codes_16sc multicorrelator_cpu_16sc;  // same, for cshort input samples
+    bool d_use_16sc;
+    size_t d_input_item_size;
+    int32_t d_max_epochs_per_call;  // code periods processed in each general_work call
+    std::shared_ptr<cpu_multicorrelator_batch> d_batch_correlator;  // shared with the rest of channels, if enabled
+    std::vector<cpu_multicorrelator_real_codes *> d_batch_correlators;
+    bool d_batch_registered;
+    std::shared_ptr<cuda_multicorrelator_batch> d_cuda_correlator;  // shared with the rest of channels, if enabled
+    int32_t d_cuda_slot;                                       // slot of this channel in d_cuda_correlator, -1 if the correlations run on the CPU
+    bool d_cuda_tracking;                                      // the GPU dispatcher waits for this channel
     gr_complex *d_correlator_outs;
     gr_complex *d_Very_Early;
     gr_complex *d_Early;
@@ -160,6 +244,8 @@ private:
     // PLL and DLL filter library
     Tracking_2nd_DLL_filter d_code_loop_filter;
     Tracking_2nd_PLL_filter d_carrier_loop_filter;
+    Tracking_KF_Carrier_Filter d_carrier_kf;  // replaces d_carrier_loop_filter if enabled
+    bool d_use_carrier_kf;
 
     // acquisition
     double d_acq_code_phase_samples;
@@ -185,20 +271,30 @@ private:
     uint64_t d_acq_sample_stamp;
 
     // CN0 estimation and lock detector
-    int32_t d_cn0_estimation_counter;
+    Cn0_Lock_Estimator d_cn0_estimator;
     int32_t d_carrier_lock_fail_counter;
-    std::deque<float> d_carrier_lock_detector_queue;
     double d_carrier_lock_test;
     double d_CN0_SNV_dB_Hz;
     double d_carrier_lock_threshold;
-    std::deque<gr_complex> d_Prompt_buffer_deque;
-    gr_complex *d_Prompt_buffer;
+    Secondary_Code_Sync d_secondary_sync;  // signs of the last prompts, for the secondary code synchronization
+    uint32_t d_secondary_lock_symbol;      // secondary code chip of the first prompt after the synchronization
 
     // file dump
     std::ofstream d_dump_file;
     std::string d_dump_filename;
     bool d_dump;
     bool d_dump_mat;
+    std::shared_ptr<Gnss_Mat_Converter> d_mat_converter;  // background .mat conversion, shared by all the blocks
+    std::shared_ptr<Tracking_Dump_Writer> d_dump_writer;  // asynchronous dump, shared by all the channels
+    int32_t d_dump_stream;                                 // stream of this channel in d_dump_writer, or -1
+    bool d_dump_compressed;
+    Gnss_Dump_Policy d_dump_policy;  // decimation, filters and triggered mode of the dump
+
+    // C/N0 estimates above the threshold before dropping the VE and VL taps
+    static const int32_t ADAPTIVE_TAPS_STRONG_ESTIMATES = 10;
+
+    // size of each dump record: sample stamp, PRN, 19 floats and a double
+    static const int32_t DUMP_RECORD_BYTES = sizeof(uint64_t) + sizeof(double) + 19 * sizeof(float) + sizeof(uint32_t);
 };
 
 #endif  // GNSS_SDR_DLL_PLL_VEML_TRACKING_H
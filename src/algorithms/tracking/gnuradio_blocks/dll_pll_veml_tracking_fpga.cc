@@ -379,9 +379,9 @@ dll_pll_veml_tracking_fpga::dll_pll_veml_tracking_fpga(const Dll_Pll_Conf_Fpga &
     d_next_prn_length_samples = d_current_prn_length_samples;
     d_correlation_length_samples = static_cast<int32_t>(trk_parameters.vector_length);  // this one is only for initialisation and does not change its value (MM)
 
-    // CN0 estimation and lock detector buffers
-    d_cn0_estimation_counter = 0;
-    d_Prompt_buffer = new gr_complex[trk_parameters.cn0_samples];
+    // CN0 estimation and lock detectors
+    d_cn0_estimator.set_length(trk_parameters.cn0_samples);
+    d_Prompt_circular_buffer.set_capacity(d_secondary_code_length);
     d_carrier_lock_test = 1.0;
     d_CN0_SNV_dB_Hz = 0.0;
     d_carrier_lock_fail_counter = 0;
@@ -424,6 +424,10 @@ dll_pll_veml_tracking_fpga::dll_pll_veml_tracking_fpga(const Dll_Pll_Conf_Fpga &
 
     d_dump = trk_parameters.dump;
     d_dump_mat = trk_parameters.dump_mat and d_dump;
+    if (d_dump_mat)
+        {
+            d_mat_converter = Gnss_Mat_Converter::get_instance();
+        }
     if (d_dump)
         {
             d_dump_filename = trk_parameters.dump_filename;
@@ -462,6 +466,9 @@ dll_pll_veml_tracking_fpga::dll_pll_veml_tracking_fpga(const Dll_Pll_Conf_Fpga &
 
 void dll_pll_veml_tracking_fpga::start_tracking()
 {
+    // an epoch launched before a restart belongs to the previous satellite
+    multicorrelator_fpga->discard_pending_epoch();
+
     //  correct the code phase according to the delay between acq and trk
     d_acq_code_phase_samples = d_acquisition_gnss_synchro->Acq_delay_samples;
     d_acq_carrier_doppler_hz = d_acquisition_gnss_synchro->Acq_doppler_hz;
@@ -560,7 +567,7 @@ void dll_pll_veml_tracking_fpga::start_tracking()
     d_rem_carr_phase_rad = 0.0;
     d_rem_code_phase_chips = 0.0;
     d_acc_carrier_phase_rad = 0.0;
-    d_cn0_estimation_counter = 0;
+    d_cn0_estimator.reset();
     d_carrier_lock_test = 1.0;
     d_CN0_SNV_dB_Hz = 0.0;
 
@@ -589,7 +596,7 @@ void dll_pll_veml_tracking_fpga::start_tracking()
 
     d_synchonizing = false;
     d_cloop = true;
-    d_Prompt_buffer_deque.clear();
+    d_Prompt_circular_buffer.clear();
     d_last_prompt = gr_complex(0.0, 0.0);
     LOG(INFO) << "PULL-IN Doppler [Hz] = " << d_carrier_doppler_hz
               << ". Code Phase correction [samples] = " << delay_correction_samples
@@ -633,7 +640,6 @@ dll_pll_veml_tracking_fpga::~dll_pll_veml_tracking_fpga()
             //                {
             //                    volk_gnsssdr_free(d_Prompt_Data);
             //                }
-            delete[] d_Prompt_buffer;
             multicorrelator_fpga->free();
         }
     catch (const std::exception &ex)
@@ -649,7 +655,7 @@ bool dll_pll_veml_tracking_fpga::acquire_secondary()
     int32_t corr_value = 0;
     for (uint32_t i = 0; i < d_secondary_code_length; i++)
         {
-            if (d_Prompt_buffer_deque.at(i).real() < 0.0)  // symbols clipping
+            if (d_Prompt_circular_buffer.at(i).real() < 0.0)  // symbols clipping
                 {
                     if (d_secondary_code_string->at(i) == '0')
                         {
@@ -687,23 +693,21 @@ bool dll_pll_veml_tracking_fpga::acquire_secondary()
 
 bool dll_pll_veml_tracking_fpga::cn0_and_tracking_lock_status(double coh_integration_time_s)
 {
-    //printf("kkkkkkkkkkkkk d_cn0_estimation_counter = %d\n", d_cn0_estimation_counter);
     // ####### CN0 ESTIMATION AND LOCK DETECTORS ######
-    if (d_cn0_estimation_counter < trk_parameters.cn0_samples)
+    if (!d_cn0_estimator.ready())
         {
-            // fill buffer with prompt correlator output values
-            d_Prompt_buffer[d_cn0_estimation_counter] = d_P_accu;
-            d_cn0_estimation_counter++;
+            // accumulate the prompt correlator output values
+            d_cn0_estimator.add(d_P_accu);
             return true;
         }
     else
         {
             //printf("KKKKKKKKKKK checking count fail ...\n");
-            d_cn0_estimation_counter = 0;
             // Code lock indicator
-            d_CN0_SNV_dB_Hz = cn0_svn_estimator(d_Prompt_buffer, trk_parameters.cn0_samples, coh_integration_time_s);
+            d_CN0_SNV_dB_Hz = d_cn0_estimator.cn0_db_hz(coh_integration_time_s);
             // Carrier lock indicator
-            d_carrier_lock_test = carrier_lock_detector(d_Prompt_buffer, trk_parameters.cn0_samples);
+            d_carrier_lock_test = d_cn0_estimator.carrier_lock();
+            d_cn0_estimator.reset();
             // Loss of lock detection
             if (d_carrier_lock_test < d_carrier_lock_threshold or d_CN0_SNV_dB_Hz < trk_parameters.cn0_min)
                 {
@@ -730,6 +734,26 @@ bool dll_pll_veml_tracking_fpga::cn0_and_tracking_lock_status(double coh_integra
 }
 
 
+void dll_pll_veml_tracking_fpga::launch_correlation_step(int32_t length_samples)
+{
+    multicorrelator_fpga->launch_multicorrelator_resampler(
+        d_rem_carr_phase_rad, d_carrier_phase_step_rad,
+        d_rem_code_phase_chips * static_cast<float>(d_code_samples_per_chip), d_code_phase_step_chips * static_cast<float>(d_code_samples_per_chip),
+        length_samples);
+}
+
+
+void dll_pll_veml_tracking_fpga::do_correlation_step()
+{
+    // with pipeline_epochs, the epoch was already launched at the end of the previous call
+    if (!multicorrelator_fpga->epoch_pending())
+        {
+            launch_correlation_step(d_current_prn_length_samples);
+        }
+    multicorrelator_fpga->read_multicorrelator_results();
+}
+
+
 void dll_pll_veml_tracking_fpga::run_dll_pll()
 {
     // ################## PLL ##########################################################
@@ -777,7 +801,7 @@ void dll_pll_veml_tracking_fpga::clear_tracking_vars()
     d_code_error_chips = 0.0;
     d_code_error_filt_chips = 0.0;
     d_current_symbol = 0;
-    d_Prompt_buffer_deque.clear();
+    d_Prompt_circular_buffer.clear();
     d_last_prompt = gr_complex(0.0, 0.0);
 }
 
@@ -990,229 +1014,39 @@ void dll_pll_veml_tracking_fpga::log_data(bool integrating)
 
 int32_t dll_pll_veml_tracking_fpga::save_matfile()
 {
-    // READ DUMP FILE
-    std::ifstream::pos_type size;
-    int32_t number_of_double_vars = 1;
-    int32_t number_of_float_vars = 17;
-    int32_t epoch_size_bytes = sizeof(uint64_t) + sizeof(double) * number_of_double_vars +
-                               sizeof(float) * number_of_float_vars + sizeof(uint32_t);
-    std::ifstream dump_file;
     std::string dump_filename_ = d_dump_filename;
     // add channel number to the filename
     dump_filename_.append(std::to_string(d_channel));
     // add extension
     dump_filename_.append(".dat");
-    std::cout << "Generating .mat file for " << dump_filename_ << std::endl;
-    dump_file.exceptions(std::ifstream::failbit | std::ifstream::badbit);
-    try
-        {
-            dump_file.open(dump_filename_.c_str(), std::ios::binary | std::ios::ate);
-        }
-    catch (const std::ifstream::failure &e)
-        {
-            std::cerr << "Problem opening dump file:" << e.what() << std::endl;
-            return 1;
-        }
-    // count number of epochs and rewind
-    int64_t num_epoch = 0;
-    if (dump_file.is_open())
-        {
-            size = dump_file.tellg();
-            num_epoch = static_cast<int64_t>(size) / static_cast<int64_t>(epoch_size_bytes);
-            dump_file.seekg(0, std::ios::beg);
-        }
-    else
-        {
-            return 1;
-        }
-    auto *abs_VE = new float[num_epoch];
-    auto *abs_E = new float[num_epoch];
-    auto *abs_P = new float[num_epoch];
-    auto *abs_L = new float[num_epoch];
-    auto *abs_VL = new float[num_epoch];
-    auto *Prompt_I = new float[num_epoch];
-    auto *Prompt_Q = new float[num_epoch];
-    auto *PRN_start_sample_count = new uint64_t[num_epoch];
-    auto *acc_carrier_phase_rad = new float[num_epoch];
-    auto *carrier_doppler_hz = new float[num_epoch];
-    auto *code_freq_chips = new float[num_epoch];
-    auto *carr_error_hz = new float[num_epoch];
-    auto *carr_error_filt_hz = new float[num_epoch];
-    auto *code_error_chips = new float[num_epoch];
-    auto *code_error_filt_chips = new float[num_epoch];
-    auto *CN0_SNV_dB_Hz = new float[num_epoch];
-    auto *carrier_lock_test = new float[num_epoch];
-    auto *aux1 = new float[num_epoch];
-    auto *aux2 = new double[num_epoch];
-    auto *PRN = new uint32_t[num_epoch];
-
-    try
-        {
-            if (dump_file.is_open())
-                {
-                    for (int64_t i = 0; i < num_epoch; i++)
-                        {
-                            dump_file.read(reinterpret_cast<char *>(&abs_VE[i]), sizeof(float));
-                            dump_file.read(reinterpret_cast<char *>(&abs_E[i]), sizeof(float));
-                            dump_file.read(reinterpret_cast<char *>(&abs_P[i]), sizeof(float));
-                            dump_file.read(reinterpret_cast<char *>(&abs_L[i]), sizeof(float));
-                            dump_file.read(reinterpret_cast<char *>(&abs_VL[i]), sizeof(float));
-                            dump_file.read(reinterpret_cast<char *>(&Prompt_I[i]), sizeof(float));
-                            dump_file.read(reinterpret_cast<char *>(&Prompt_Q[i]), sizeof(float));
-                            dump_file.read(reinterpret_cast<char *>(&PRN_start_sample_count[i]), sizeof(uint64_t));
-                            dump_file.read(reinterpret_cast<char *>(&acc_carrier_phase_rad[i]), sizeof(float));
-                            dump_file.read(reinterpret_cast<char *>(&carrier_doppler_hz[i]), sizeof(float));
-                            dump_file.read(reinterpret_cast<char *>(&code_freq_chips[i]), sizeof(float));
-                            dump_file.read(reinterpret_cast<char *>(&carr_error_hz[i]), sizeof(float));
-                            dump_file.read(reinterpret_cast<char *>(&carr_error_filt_hz[i]), sizeof(float));
-                            dump_file.read(reinterpret_cast<char *>(&code_error_chips[i]), sizeof(float));
-                            dump_file.read(reinterpret_cast<char *>(&code_error_filt_chips[i]), sizeof(float));
-                            dump_file.read(reinterpret_cast<char *>(&CN0_SNV_dB_Hz[i]), sizeof(float));
-                            dump_file.read(reinterpret_cast<char *>(&carrier_lock_test[i]), sizeof(float));
-                            dump_file.read(reinterpret_cast<char *>(&aux1[i]), sizeof(float));
-                            dump_file.read(reinterpret_cast<char *>(&aux2[i]), sizeof(double));
-                            dump_file.read(reinterpret_cast<char *>(&PRN[i]), sizeof(uint32_t));
-                        }
-                }
-            dump_file.close();
-        }
-    catch (const std::ifstream::failure &e)
-        {
-            std::cerr << "Problem reading dump file:" << e.what() << std::endl;
-            delete[] abs_VE;
-            delete[] abs_E;
-            delete[] abs_P;
-            delete[] abs_L;
-            delete[] abs_VL;
-            delete[] Prompt_I;
-            delete[] Prompt_Q;
-            delete[] PRN_start_sample_count;
-            delete[] acc_carrier_phase_rad;
-            delete[] carrier_doppler_hz;
-            delete[] code_freq_chips;
-            delete[] carr_error_hz;
-            delete[] carr_error_filt_hz;
-            delete[] code_error_chips;
-            delete[] code_error_filt_chips;
-            delete[] CN0_SNV_dB_Hz;
-            delete[] carrier_lock_test;
-            delete[] aux1;
-            delete[] aux2;
-            delete[] PRN;
-            return 1;
-        }
-
-    // WRITE MAT FILE
-    mat_t *matfp;
-    matvar_t *matvar;
     std::string filename = dump_filename_;
     filename.erase(filename.length() - 4, 4);
     filename.append(".mat");
-    matfp = Mat_CreateVer(filename.c_str(), nullptr, MAT_FT_MAT73);
-    if (reinterpret_cast<int64_t *>(matfp) != nullptr)
-        {
-            size_t dims[2] = {1, static_cast<size_t>(num_epoch)};
-            matvar = Mat_VarCreate("abs_VE", MAT_C_SINGLE, MAT_T_SINGLE, 2, dims, abs_VE, 0);
-            Mat_VarWrite(matfp, matvar, MAT_COMPRESSION_ZLIB);  // or MAT_COMPRESSION_NONE
-            Mat_VarFree(matvar);
-
-            matvar = Mat_VarCreate("abs_E", MAT_C_SINGLE, MAT_T_SINGLE, 2, dims, abs_E, 0);
-            Mat_VarWrite(matfp, matvar, MAT_COMPRESSION_ZLIB);  // or MAT_COMPRESSION_NONE
-            Mat_VarFree(matvar);
-
-            matvar = Mat_VarCreate("abs_P", MAT_C_SINGLE, MAT_T_SINGLE, 2, dims, abs_P, 0);
-            Mat_VarWrite(matfp, matvar, MAT_COMPRESSION_ZLIB);  // or MAT_COMPRESSION_NONE
-            Mat_VarFree(matvar);
-
-            matvar = Mat_VarCreate("abs_L", MAT_C_SINGLE, MAT_T_SINGLE, 2, dims, abs_L, 0);
-            Mat_VarWrite(matfp, matvar, MAT_COMPRESSION_ZLIB);  // or MAT_COMPRESSION_NONE
-            Mat_VarFree(matvar);
-
-            matvar = Mat_VarCreate("abs_VL", MAT_C_SINGLE, MAT_T_SINGLE, 2, dims, abs_VL, 0);
-            Mat_VarWrite(matfp, matvar, MAT_COMPRESSION_ZLIB);  // or MAT_COMPRESSION_NONE
-            Mat_VarFree(matvar);
-
-            matvar = Mat_VarCreate("Prompt_I", MAT_C_SINGLE, MAT_T_SINGLE, 2, dims, Prompt_I, 0);
-            Mat_VarWrite(matfp, matvar, MAT_COMPRESSION_ZLIB);  // or MAT_COMPRESSION_NONE
-            Mat_VarFree(matvar);
-
-            matvar = Mat_VarCreate("Prompt_Q", MAT_C_SINGLE, MAT_T_SINGLE, 2, dims, Prompt_Q, 0);
-            Mat_VarWrite(matfp, matvar, MAT_COMPRESSION_ZLIB);  // or MAT_COMPRESSION_NONE
-            Mat_VarFree(matvar);
-
-            matvar = Mat_VarCreate("PRN_start_sample_count", MAT_C_UINT64, MAT_T_UINT64, 2, dims, PRN_start_sample_count, 0);
-            Mat_VarWrite(matfp, matvar, MAT_COMPRESSION_ZLIB);  // or MAT_COMPRESSION_NONE
-            Mat_VarFree(matvar);
-
-            matvar = Mat_VarCreate("acc_carrier_phase_rad", MAT_C_SINGLE, MAT_T_SINGLE, 2, dims, acc_carrier_phase_rad, 0);
-            Mat_VarWrite(matfp, matvar, MAT_COMPRESSION_ZLIB);  // or MAT_COMPRESSION_NONE
-            Mat_VarFree(matvar);
-
-            matvar = Mat_VarCreate("carrier_doppler_hz", MAT_C_SINGLE, MAT_T_SINGLE, 2, dims, carrier_doppler_hz, 0);
-            Mat_VarWrite(matfp, matvar, MAT_COMPRESSION_ZLIB);  // or MAT_COMPRESSION_NONE
-            Mat_VarFree(matvar);
-
-            matvar = Mat_VarCreate("code_freq_chips", MAT_C_SINGLE, MAT_T_SINGLE, 2, dims, code_freq_chips, 0);
-            Mat_VarWrite(matfp, matvar, MAT_COMPRESSION_ZLIB);  // or MAT_COMPRESSION_NONE
-            Mat_VarFree(matvar);
-
-            matvar = Mat_VarCreate("carr_error_hz", MAT_C_SINGLE, MAT_T_SINGLE, 2, dims, carr_error_hz, 0);
-            Mat_VarWrite(matfp, matvar, MAT_COMPRESSION_ZLIB);  // or MAT_COMPRESSION_NONE
-            Mat_VarFree(matvar);
-
-            matvar = Mat_VarCreate("carr_error_filt_hz", MAT_C_SINGLE, MAT_T_SINGLE, 2, dims, carr_error_filt_hz, 0);
-            Mat_VarWrite(matfp, matvar, MAT_COMPRESSION_ZLIB);  // or MAT_COMPRESSION_NONE
-            Mat_VarFree(matvar);
-
-            matvar = Mat_VarCreate("code_error_chips", MAT_C_SINGLE, MAT_T_SINGLE, 2, dims, code_error_chips, 0);
-            Mat_VarWrite(matfp, matvar, MAT_COMPRESSION_ZLIB);  // or MAT_COMPRESSION_NONE
-            Mat_VarFree(matvar);
-
-            matvar = Mat_VarCreate("code_error_filt_chips", MAT_C_SINGLE, MAT_T_SINGLE, 2, dims, code_error_filt_chips, 0);
-            Mat_VarWrite(matfp, matvar, MAT_COMPRESSION_ZLIB);  // or MAT_COMPRESSION_NONE
-            Mat_VarFree(matvar);
-
-            matvar = Mat_VarCreate("CN0_SNV_dB_Hz", MAT_C_SINGLE, MAT_T_SINGLE, 2, dims, CN0_SNV_dB_Hz, 0);
-            Mat_VarWrite(matfp, matvar, MAT_COMPRESSION_ZLIB);  // or MAT_COMPRESSION_NONE
-            Mat_VarFree(matvar);
-
-            matvar = Mat_VarCreate("carrier_lock_test", MAT_C_SINGLE, MAT_T_SINGLE, 2, dims, carrier_lock_test, 0);
-            Mat_VarWrite(matfp, matvar, MAT_COMPRESSION_ZLIB);  // or MAT_COMPRESSION_NONE
-            Mat_VarFree(matvar);
-
-            matvar = Mat_VarCreate("aux1", MAT_C_SINGLE, MAT_T_SINGLE, 2, dims, aux1, 0);
-            Mat_VarWrite(matfp, matvar, MAT_COMPRESSION_ZLIB);  // or MAT_COMPRESSION_NONE
-            Mat_VarFree(matvar);
-
-            matvar = Mat_VarCreate("aux2", MAT_C_DOUBLE, MAT_T_DOUBLE, 2, dims, aux2, 0);
-            Mat_VarWrite(matfp, matvar, MAT_COMPRESSION_ZLIB);  // or MAT_COMPRESSION_NONE
-            Mat_VarFree(matvar);
-
-            matvar = Mat_VarCreate("PRN", MAT_C_UINT32, MAT_T_UINT32, 2, dims, PRN, 0);
-            Mat_VarWrite(matfp, matvar, MAT_COMPRESSION_ZLIB);  // or MAT_COMPRESSION_NONE
-            Mat_VarFree(matvar);
-        }
-    Mat_Close(matfp);
-    delete[] abs_VE;
-    delete[] abs_E;
-    delete[] abs_P;
-    delete[] abs_L;
-    delete[] abs_VL;
-    delete[] Prompt_I;
-    delete[] Prompt_Q;
-    delete[] PRN_start_sample_count;
-    delete[] acc_carrier_phase_rad;
-    delete[] carrier_doppler_hz;
-    delete[] code_freq_chips;
-    delete[] carr_error_hz;
-    delete[] carr_error_filt_hz;
-    delete[] code_error_chips;
-    delete[] code_error_filt_chips;
-    delete[] CN0_SNV_dB_Hz;
-    delete[] carrier_lock_test;
-    delete[] aux1;
-    delete[] aux2;
-    delete[] PRN;
+    // Same order as the dump records
+    const std::vector<Gnss_Mat_Converter::Field> fields = {
+        {"abs_VE", MAT_C_SINGLE, MAT_T_SINGLE, sizeof(float)},
+        {"abs_E", MAT_C_SINGLE, MAT_T_SINGLE, sizeof(float)},
+        {"abs_P", MAT_C_SINGLE, MAT_T_SINGLE, sizeof(float)},
+        {"abs_L", MAT_C_SINGLE, MAT_T_SINGLE, sizeof(float)},
+        {"abs_VL", MAT_C_SINGLE, MAT_T_SINGLE, sizeof(float)},
+        {"Prompt_I", MAT_C_SINGLE, MAT_T_SINGLE, sizeof(float)},
+        {"Prompt_Q", MAT_C_SINGLE, MAT_T_SINGLE, sizeof(float)},
+        {"PRN_start_sample_count", MAT_C_UINT64, MAT_T_UINT64, sizeof(uint64_t)},
+        {"acc_carrier_phase_rad", MAT_C_SINGLE, MAT_T_SINGLE, sizeof(float)},
+        {"carrier_doppler_hz", MAT_C_SINGLE, MAT_T_SINGLE, sizeof(float)},
+        {"code_freq_chips", MAT_C_SINGLE, MAT_T_SINGLE, sizeof(float)},
+        {"carr_error_hz", MAT_C_SINGLE, MAT_T_SINGLE, sizeof(float)},
+        {"carr_error_filt_hz", MAT_C_SINGLE, MAT_T_SINGLE, sizeof(float)},
+        {"code_error_chips", MAT_C_SINGLE, MAT_T_SINGLE, sizeof(float)},
+        {"code_error_filt_chips", MAT_C_SINGLE, MAT_T_SINGLE, sizeof(float)},
+        {"CN0_SNV_dB_Hz", MAT_C_SINGLE, MAT_T_SINGLE, sizeof(float)},
+        {"carrier_lock_test", MAT_C_SINGLE, MAT_T_SINGLE, sizeof(float)},
+        {"aux1", MAT_C_SINGLE, MAT_T_SINGLE, sizeof(float)},
+        {"aux2", MAT_C_DOUBLE, MAT_T_DOUBLE, sizeof(double)},
+        {"PRN", MAT_C_UINT32, MAT_T_UINT32, sizeof(uint32_t)}};
+    // The conversion runs in the background, in chunks of records
+    std::cout << "Generating .mat file for " << dump_filename_ << std::endl;
+    d_mat_converter->convert(dump_filename_, filename, fields);
     return 0;
 }
 
@@ -1256,6 +1090,7 @@ void dll_pll_veml_tracking_fpga::set_gnss_synchro(Gnss_Synchro *p_gnss_synchro)
 void dll_pll_veml_tracking_fpga::stop_tracking()
 {
     gr::thread::scoped_lock l(d_setlock);
+    multicorrelator_fpga->discard_pending_epoch();
     d_state = 0;
 }
 
@@ -1316,10 +1151,7 @@ int dll_pll_veml_tracking_fpga::general_work(int noutput_items __attribute__((un
 
                 // ################# CARRIER WIPEOFF AND CORRELATORS ##############################
                 // perform carrier wipe-off and compute Early, Prompt and Late correlation
-                multicorrelator_fpga->Carrier_wipeoff_multicorrelator_resampler(
-                    d_rem_carr_phase_rad, d_carrier_phase_step_rad,
-                    d_rem_code_phase_chips * static_cast<float>(d_code_samples_per_chip), d_code_phase_step_chips * static_cast<float>(d_code_samples_per_chip),
-                    d_current_prn_length_samples);
+                do_correlation_step();
 
                 // Save single correlation step variables
                 if (d_veml)
@@ -1348,8 +1180,8 @@ int dll_pll_veml_tracking_fpga::general_work(int noutput_items __attribute__((un
                         if (d_secondary)
                             {
                                 // ####### SECONDARY CODE LOCK #####
-                                d_Prompt_buffer_deque.push_back(*d_Prompt);
-                                if (d_Prompt_buffer_deque.size() == d_secondary_code_length)
+                                d_Prompt_circular_buffer.push_back(*d_Prompt);
+                                if (d_Prompt_circular_buffer.size() == d_secondary_code_length)
                                     {
                                         next_state = acquire_secondary();
                                         if (next_state)
@@ -1357,8 +1189,6 @@ int dll_pll_veml_tracking_fpga::general_work(int noutput_items __attribute__((un
                                                 std::cout << systemName << " " << signal_pretty_name << " secondary code locked in channel " << d_channel
                                                           << " for satellite " << Gnss_Satellite(systemName, d_acquisition_gnss_synchro->PRN) << std::endl;
                                             }
-
-                                        d_Prompt_buffer_deque.pop_front();
                                     }
                             }
                         else if (d_symbols_per_bit > 1)  //Signal does not have secondary code. Search a bit transition by sign change
@@ -1478,7 +1308,7 @@ int dll_pll_veml_tracking_fpga::general_work(int noutput_items __attribute__((un
                                 d_L_accu = gr_complex(0.0, 0.0);
                                 d_VL_accu = gr_complex(0.0, 0.0);
                                 d_last_prompt = gr_complex(0.0, 0.0);
-                                d_Prompt_buffer_deque.clear();
+                                d_Prompt_circular_buffer.clear();
                                 d_current_symbol = 0;
                                 d_synchonizing = false;
 
@@ -1530,10 +1360,7 @@ int dll_pll_veml_tracking_fpga::general_work(int noutput_items __attribute__((un
                 // Fill the acquisition data
                 current_synchro_data = *d_acquisition_gnss_synchro;
                 // perform a correlation step
-                multicorrelator_fpga->Carrier_wipeoff_multicorrelator_resampler(
-                    d_rem_carr_phase_rad, d_carrier_phase_step_rad,
-                    d_rem_code_phase_chips * static_cast<float>(d_code_samples_per_chip), d_code_phase_step_chips * static_cast<float>(d_code_samples_per_chip),
-                    d_current_prn_length_samples);
+                do_correlation_step();
                 update_tracking_vars();
                 save_correlation_results();
 
@@ -1588,11 +1415,7 @@ int dll_pll_veml_tracking_fpga::general_work(int noutput_items __attribute__((un
                 d_sample_counter_next = d_sample_counter + static_cast<uint64_t>(d_current_prn_length_samples);
 
                 // perform a correlation step
-                //do_correlation_step(in);
-                multicorrelator_fpga->Carrier_wipeoff_multicorrelator_resampler(
-                    d_rem_carr_phase_rad, d_carrier_phase_step_rad,
-                    d_rem_code_phase_chips * static_cast<float>(d_code_samples_per_chip), d_code_phase_step_chips * static_cast<float>(d_code_samples_per_chip),
-                    d_current_prn_length_samples);
+                do_correlation_step();
 
                 save_correlation_results();
 
@@ -1658,6 +1481,11 @@ int dll_pll_veml_tracking_fpga::general_work(int noutput_items __attribute__((un
                     }
             }
         }
+    if (trk_parameters.pipeline_epochs and d_state > 1)
+        {
+            // the FPGA correlates the next epoch while this output goes through the scheduler
+            launch_correlation_step(d_next_prn_length_samples);
+        }
     if (current_synchro_data.Flag_valid_symbol_output)
         {
             current_synchro_data.fs = static_cast<int64_t>(trk_parameters.fs_in);
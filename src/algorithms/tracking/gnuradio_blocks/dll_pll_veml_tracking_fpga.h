@@ -41,7 +41,9 @@
 
 #include "dll_pll_conf_fpga.h"
 #include "fpga_multicorrelator.h"
+#include "gnss_mat_converter.h"
 #include "gnss_synchro.h"
+#include "lock_detectors.h"
 #include "tracking_2nd_DLL_filter.h"
 #include "tracking_2nd_PLL_filter.h"
 #include <boost/circular_buffer.hpp>
@@ -84,6 +86,8 @@ private:
 
     bool cn0_and_tracking_lock_status(double coh_integration_time_s);
     bool acquire_secondary();
+    void launch_correlation_step(int32_t length_samples);
+    void do_correlation_step();
     void run_dll_pll();
     void update_tracking_vars();
     void clear_tracking_vars();
@@ -184,19 +188,19 @@ private:
     uint64_t d_absolute_samples_offset;
 
     // CN0 estimation and lock detector
-    int32_t d_cn0_estimation_counter;
+    Cn0_Lock_Estimator d_cn0_estimator;
     int32_t d_carrier_lock_fail_counter;
     double d_carrier_lock_test;
     double d_CN0_SNV_dB_Hz;
     double d_carrier_lock_threshold;
-    std::deque<gr_complex> d_Prompt_buffer_deque;
-    gr_complex *d_Prompt_buffer;
+    boost::circular_buffer<gr_complex> d_Prompt_circular_buffer;  // last prompts, for the secondary code synchronization
 
     // file dump
     std::ofstream d_dump_file;
     std::string d_dump_filename;
     bool d_dump;
     bool d_dump_mat;
+    std::shared_ptr<Gnss_Mat_Converter> d_mat_converter;  // background .mat conversion, shared by all the blocks
 
     // extra
     int32_t d_correlation_length_samples;
@@ -69,10 +69,11 @@ galileo_e1_tcp_connector_tracking_cc_sptr galileo_e1_tcp_connector_make_tracking
     float dll_bw_hz,
     float early_late_space_chips,
     float very_early_late_space_chips,
-    size_t port_ch0)
+    size_t port_ch0,
+    bool batch_tcp)
 {
     return galileo_e1_tcp_connector_tracking_cc_sptr(new Galileo_E1_Tcp_Connector_Tracking_cc(
-        fs_in, vector_length, dump, dump_filename, pll_bw_hz, dll_bw_hz, early_late_space_chips, very_early_late_space_chips, port_ch0));
+        fs_in, vector_length, dump, dump_filename, pll_bw_hz, dll_bw_hz, early_late_space_chips, very_early_late_space_chips, port_ch0, batch_tcp));
 }
 
 
@@ -95,7 +96,8 @@ Galileo_E1_Tcp_Connector_Tracking_cc::Galileo_E1_Tcp_Connector_Tracking_cc(
     float dll_bw_hz __attribute__((unused)),
     float early_late_space_chips,
     float very_early_late_space_chips,
-    size_t port_ch0) : gr::block("Galileo_E1_Tcp_Connector_Tracking_cc", gr::io_signature::make(1, 1, sizeof(gr_complex)),
+    size_t port_ch0,
+    bool batch_tcp) : gr::block("Galileo_E1_Tcp_Connector_Tracking_cc", gr::io_signature::make(1, 1, sizeof(gr_complex)),
                            gr::io_signature::make(1, 1, sizeof(Gnss_Synchro)))
 {
     this->message_port_register_out(pmt::mp("events"));
@@ -116,6 +118,7 @@ Galileo_E1_Tcp_Connector_Tracking_cc::Galileo_E1_Tcp_Connector_Tracking_cc(
     d_port = 0;
     d_listen_connection = true;
     d_control_id = 0;
+    d_batch_tcp = batch_tcp;
 
     // Initialization of local code replica
     // Get space for a vector with the sinboc(1,1) replica sampled 2x/chip
@@ -249,7 +252,10 @@ Galileo_E1_Tcp_Connector_Tracking_cc::~Galileo_E1_Tcp_Connector_Tracking_cc()
             volk_gnsssdr_free(d_correlator_outs);
             volk_gnsssdr_free(d_ca_code);
             delete[] d_Prompt_buffer;
-            d_tcp_com.close_tcp_connection(d_port);
+            if (!d_batch_tcp)
+                {
+                    d_tcp_com.close_tcp_connection(d_port);
+                }
             multicorrelator_cpu.free();
         }
     catch (const std::exception &ex)
@@ -286,8 +292,18 @@ void Galileo_E1_Tcp_Connector_Tracking_cc::set_channel(uint32_t channel)
     //! Listen for connections on a TCP port
     if (d_listen_connection == true)
         {
-            d_port = d_port_ch0 + d_channel;
-            d_listen_connection = d_tcp_com.listen_tcp_connection(d_port, d_port_ch0);
+            if (d_batch_tcp)
+                {
+                    // all the channels share the connection on port_ch0
+                    d_port = d_port_ch0;
+                    d_tcp_batch = tcp_batch_communication::get_instance(d_port);
+                    d_listen_connection = false;
+                }
+            else
+                {
+                    d_port = d_port_ch0 + d_channel;
+                    d_listen_connection = d_tcp_com.listen_tcp_connection(d_port, d_port_ch0);
+                }
         }
 }
 
@@ -367,7 +383,15 @@ int Galileo_E1_Tcp_Connector_Tracking_cc::general_work(int noutput_items __attri
                 (*d_Prompt).imag(),
                 d_acq_carrier_doppler_hz,
                 1}};
-            d_tcp_com.send_receive_tcp_packet_galileo_e1(tx_variables_array, &tcp_data);
+            if (d_batch_tcp)
+                {
+                    // the reply to an earlier period, if any, otherwise no errors
+                    d_tcp_batch->send_receive(d_channel, tx_variables_array.data(), tx_variables_array.size(), &tcp_data);
+                }
+            else
+                {
+                    d_tcp_com.send_receive_tcp_packet_galileo_e1(tx_variables_array, &tcp_data);
+                }
 
             // ################## PLL ##########################################################
             // PLL discriminator, carrier loop filter implementation and NCO command generation (TCP_connector)
@@ -460,9 +484,12 @@ int Galileo_E1_Tcp_Connector_Tracking_cc::general_work(int noutput_items __attri
             *d_Prompt = gr_complex(0, 0);
             *d_Late = gr_complex(0, 0);
             current_synchro_data.Tracking_sample_counter = d_sample_counter + static_cast<uint64_t>(d_current_prn_length_samples);
-            //! When tracking is disabled an array of 1's is sent to maintain the TCP connection
-            boost::array<float, NUM_TX_VARIABLES_GALILEO_E1> tx_variables_array = {{1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 0}};
-            d_tcp_com.send_receive_tcp_packet_galileo_e1(tx_variables_array, &tcp_data);
+            //! When tracking is disabled an array of 1's is sent to maintain the TCP connection (the batched one does not need it)
+            if (!d_batch_tcp)
+                {
+                    boost::array<float, NUM_TX_VARIABLES_GALILEO_E1> tx_variables_array = {{1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 0}};
+                    d_tcp_com.send_receive_tcp_packet_galileo_e1(tx_variables_array, &tcp_data);
+                }
         }
     //assign the GNURadio block output data
     current_synchro_data.System = {'E'};
@@ -41,11 +41,13 @@
 
 #include "cpu_multicorrelator.h"
 #include "gnss_synchro.h"
+#include "tcp_batch_communication.h"
 #include "tcp_communication.h"
 #include <gnuradio/block.h>
 #include <volk/volk.h>
 #include <fstream>
 #include <map>
+#include <memory>
 #include <string>
 
 
@@ -62,7 +64,8 @@ galileo_e1_tcp_connector_make_tracking_cc(
     float dll_bw_hz,
     float early_late_space_chips,
     float very_early_late_space_chips,
-    size_t port_ch0);
+    size_t port_ch0,
+    bool batch_tcp);
 
 /*!
  * \brief This class implements a code DLL + carrier PLL VEML (Very Early
@@ -92,7 +95,8 @@ private:
         float dll_bw_hz,
         float early_late_space_chips,
         float very_early_late_space_chips,
-        size_t port_ch0);
+        size_t port_ch0,
+        bool batch_tcp);
 
     Galileo_E1_Tcp_Connector_Tracking_cc(
         int64_t fs_in, uint32_t vector_length,
@@ -102,7 +106,8 @@ private:
         float dll_bw_hz,
         float early_late_space_chips,
         float very_early_late_space_chips,
-        size_t port_ch0);
+        size_t port_ch0,
+        bool batch_tcp);
 
     void update_local_code();
 
@@ -155,6 +160,8 @@ private:
     int32_t d_listen_connection;
     float d_control_id;
     tcp_communication d_tcp_com;
+    bool d_batch_tcp;
+    std::shared_ptr<tcp_batch_communication> d_tcp_batch;  // with d_batch_tcp, instead of d_tcp_com
 
     //PRN period in samples
     int32_t d_current_prn_length_samples;
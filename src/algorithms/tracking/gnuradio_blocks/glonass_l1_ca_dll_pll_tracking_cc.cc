@@ -65,10 +65,11 @@ glonass_l1_ca_dll_pll_make_tracking_cc(
     std::string dump_filename,
     float pll_bw_hz,
     float dll_bw_hz,
-    float early_late_space_chips)
+    float early_late_space_chips,
+    int32_t pre_decimation_factor)
 {
     return glonass_l1_ca_dll_pll_tracking_cc_sptr(new Glonass_L1_Ca_Dll_Pll_Tracking_cc(
-        fs_in, vector_length, dump, std::move(dump_filename), pll_bw_hz, dll_bw_hz, early_late_space_chips));
+        fs_in, vector_length, dump, std::move(dump_filename), pll_bw_hz, dll_bw_hz, early_late_space_chips, pre_decimation_factor));
 }
 
 
@@ -89,7 +90,8 @@ Glonass_L1_Ca_Dll_Pll_Tracking_cc::Glonass_L1_Ca_Dll_Pll_Tracking_cc(
     std::string dump_filename,
     float pll_bw_hz,
     float dll_bw_hz,
-    float early_late_space_chips) : gr::block("Glonass_L1_Ca_Dll_Pll_Tracking_cc", gr::io_signature::make(1, 1, sizeof(gr_complex)),
+    float early_late_space_chips,
+    int32_t pre_decimation_factor) : gr::block("Glonass_L1_Ca_Dll_Pll_Tracking_cc", gr::io_signature::make(1, 1, sizeof(gr_complex)),
                                         gr::io_signature::make(1, 1, sizeof(Gnss_Synchro)))
 {
     this->message_port_register_out(pmt::mp("events"));
@@ -97,6 +99,10 @@ Glonass_L1_Ca_Dll_Pll_Tracking_cc::Glonass_L1_Ca_Dll_Pll_Tracking_cc(
     // initialize internal vars
     d_dump = dump;
     d_fs_in = fs_in;
+    d_pre_decimation_factor = pre_decimation_factor;
+    // an integrate-and-dump sample is centred on the block of input samples it sums
+    d_input_delay_samples = -static_cast<double>(d_pre_decimation_factor - 1) / 2.0;
+    d_fdma_premixed = false;
     d_vector_length = vector_length;
     d_dump_filename = std::move(dump_filename);
 
@@ -173,6 +179,13 @@ Glonass_L1_Ca_Dll_Pll_Tracking_cc::Glonass_L1_Ca_Dll_Pll_Tracking_cc(
 }
 
 
+void Glonass_L1_Ca_Dll_Pll_Tracking_cc::set_fdma_premixed(uint32_t latency_samples)
+{
+    d_fdma_premixed = true;
+    d_input_delay_samples = static_cast<double>(latency_samples);
+}
+
+
 void Glonass_L1_Ca_Dll_Pll_Tracking_cc::start_tracking()
 {
     /*
@@ -181,6 +194,14 @@ void Glonass_L1_Ca_Dll_Pll_Tracking_cc::start_tracking()
     d_acq_code_phase_samples = d_acquisition_gnss_synchro->Acq_delay_samples;
     d_acq_carrier_doppler_hz = d_acquisition_gnss_synchro->Acq_doppler_hz;
     d_acq_sample_stamp = d_acquisition_gnss_synchro->Acq_samplestamp_samples;
+    if (d_pre_decimation_factor > 1 or d_fdma_premixed)
+        {
+            // acquisition runs at the full input rate: move its stamp to the decimated samples
+            auto decimation = static_cast<uint64_t>(d_pre_decimation_factor);
+            d_acq_code_phase_samples += static_cast<double>(d_acq_sample_stamp % decimation) + d_input_delay_samples;
+            d_acq_code_phase_samples /= static_cast<double>(decimation);
+            d_acq_sample_stamp /= decimation;
+        }
 
     int64_t acq_trk_diff_samples;
     double acq_trk_diff_seconds;
@@ -217,7 +238,11 @@ void Glonass_L1_Ca_Dll_Pll_Tracking_cc::start_tracking()
 
     d_acq_code_phase_samples = corrected_acq_phase_samples;
 
-    d_carrier_frequency_hz = d_acq_carrier_doppler_hz + (DFRQ1_GLO * GLONASS_PRN.at(d_acquisition_gnss_synchro->PRN));
+    d_carrier_frequency_hz = d_acq_carrier_doppler_hz;
+    if (!d_fdma_premixed)
+        {
+            d_carrier_frequency_hz += DFRQ1_GLO * GLONASS_PRN.at(d_acquisition_gnss_synchro->PRN);
+        }
     d_carrier_doppler_hz = d_acq_carrier_doppler_hz;
     d_carrier_phase_step_rad = GLONASS_TWO_PI * d_carrier_frequency_hz / static_cast<double>(d_fs_in);
     d_carrier_doppler_phase_step_rad = GLONASS_TWO_PI * (d_carrier_doppler_hz) / static_cast<double>(d_fs_in);
@@ -575,7 +600,8 @@ int Glonass_L1_Ca_Dll_Pll_Tracking_cc::general_work(int noutput_items __attribut
                     d_acc_carrier_phase_rad -= d_carrier_doppler_phase_step_rad * samples_offset;
                     current_synchro_data.Carrier_phase_rads = d_acc_carrier_phase_rad;
                     current_synchro_data.Carrier_Doppler_hz = d_carrier_doppler_hz;
-                    current_synchro_data.fs = d_fs_in;
+                    current_synchro_data.fs = d_fs_in * d_pre_decimation_factor;
+                    current_synchro_data.Tracking_sample_counter *= static_cast<uint64_t>(d_pre_decimation_factor);
                     current_synchro_data.correlation_length_ms = 1;
                     *out[0] = current_synchro_data;
                     consume_each(samples_offset);  // shift input to perform alignment with local replica
@@ -693,8 +719,15 @@ int Glonass_L1_Ca_Dll_Pll_Tracking_cc::general_work(int noutput_items __attribut
             current_synchro_data.correlation_length_ms = 1;
         }
 
+    // report the stamps in samples of the receiver clock, which runs at the full input rate
+    current_synchro_data.fs = d_fs_in * d_pre_decimation_factor;
+    current_synchro_data.Tracking_sample_counter *= static_cast<uint64_t>(d_pre_decimation_factor);
+    if (current_synchro_data.Flag_valid_symbol_output and (d_pre_decimation_factor > 1 or d_fdma_premixed))
+        {
+            current_synchro_data.Code_phase_samples = current_synchro_data.Code_phase_samples * static_cast<double>(d_pre_decimation_factor) - d_input_delay_samples;
+        }
+
     //assign the GNURadio block output data
-    current_synchro_data.fs = d_fs_in;
     *out[0] = current_synchro_data;
     if (d_dump)
         {
@@ -60,7 +60,8 @@ glonass_l1_ca_dll_pll_make_tracking_cc(
     std::string dump_filename,
     float pll_bw_hz,
     float dll_bw_hz,
-    float early_late_space_chips);
+    float early_late_space_chips,
+    int32_t pre_decimation_factor = 1);
 
 
 /*!
@@ -75,6 +76,13 @@ public:
     void set_gnss_synchro(Gnss_Synchro* p_gnss_synchro);
     void start_tracking();
 
+    /*!
+     * \brief The input comes from a shared FDMA pre-mixer, which has already
+     * removed the frequency channel offset and delays the signal by
+     * latency_samples samples at the full input rate
+     */
+    void set_fdma_premixed(uint32_t latency_samples);
+
     int general_work(int noutput_items, gr_vector_int& ninput_items,
         gr_vector_const_void_star& input_items, gr_vector_void_star& output_items);
 
@@ -88,7 +96,8 @@ private:
         std::string dump_filename,
         float pll_bw_hz,
         float dll_bw_hz,
-        float early_late_space_chips);
+        float early_late_space_chips,
+        int32_t pre_decimation_factor);
 
     Glonass_L1_Ca_Dll_Pll_Tracking_cc(
         int64_t fs_in, uint32_t vector_length,
@@ -96,7 +105,8 @@ private:
         std::string dump_filename,
         float pll_bw_hz,
         float dll_bw_hz,
-        float early_late_space_chips);
+        float early_late_space_chips,
+        int32_t pre_decimation_factor);
 
     // tracking configuration vars
     uint32_t d_vector_length;
@@ -107,6 +117,9 @@ private:
 
     int64_t d_fs_in;
     int64_t d_glonass_freq_ch;
+    int32_t d_pre_decimation_factor;  // decimation applied upstream (d_fs_in is the decimated rate)
+    double d_input_delay_samples;     // delay of the decimated samples with respect to the full rate input
+    bool d_fdma_premixed;
 
     double d_early_late_spc_chips;
 
@@ -170,9 +170,8 @@ glonass_l2_ca_dll_pll_c_aid_tracking_cc::glonass_l2_ca_dll_pll_c_aid_tracking_cc
     d_enable_tracking = false;
     d_pull_in = false;
 
-    // CN0 estimation and lock detector buffers
-    d_cn0_estimation_counter = 0;
-    d_Prompt_buffer = new gr_complex[FLAGS_cn0_samples];
+    // CN0 estimation and lock detectors
+    d_cn0_estimator.set_length(CN0_ESTIMATION_SAMPLES);
     d_carrier_lock_test = 1;
     d_CN0_SNV_dB_Hz = 0;
     d_carrier_lock_fail_counter = 0;
@@ -335,7 +334,6 @@ glonass_l2_ca_dll_pll_c_aid_tracking_cc::~glonass_l2_ca_dll_pll_c_aid_tracking_c
             volk_gnsssdr_free(d_local_code_shift_chips);
             volk_gnsssdr_free(d_correlator_outs);
             volk_gnsssdr_free(d_ca_code);
-            delete[] d_Prompt_buffer;
             multicorrelator_cpu.free();
         }
     catch (const std::exception &ex)
@@ -778,19 +776,18 @@ int glonass_l2_ca_dll_pll_c_aid_tracking_cc::general_work(int noutput_items __at
                     d_rem_code_phase_chips = d_rem_code_phase_samples * (d_code_freq_chips / static_cast<double>(d_fs_in));
 
                     // ####### CN0 ESTIMATION AND LOCK DETECTORS #######################################
-                    if (d_cn0_estimation_counter < CN0_ESTIMATION_SAMPLES)
+                    if (!d_cn0_estimator.ready())
                         {
-                            // fill buffer with prompt correlator output values
-                            d_Prompt_buffer[d_cn0_estimation_counter] = d_correlator_outs[1];  // prompt
-                            d_cn0_estimation_counter++;
+                            // accumulate the prompt correlator output values
+                            d_cn0_estimator.add(d_correlator_outs[1]);  // prompt
                         }
                     else
                         {
-                            d_cn0_estimation_counter = 0;
                             // Code lock indicator
-                            d_CN0_SNV_dB_Hz = cn0_svn_estimator(d_Prompt_buffer, CN0_ESTIMATION_SAMPLES, GLONASS_L2_CA_CODE_PERIOD);
+                            d_CN0_SNV_dB_Hz = d_cn0_estimator.cn0_db_hz(GLONASS_L2_CA_CODE_PERIOD);
                             // Carrier lock indicator
-                            d_carrier_lock_test = carrier_lock_detector(d_Prompt_buffer, CN0_ESTIMATION_SAMPLES);
+                            d_carrier_lock_test = d_cn0_estimator.carrier_lock();
+                            d_cn0_estimator.reset();
                             // Loss of lock detection
                             if (d_carrier_lock_test < d_carrier_lock_threshold or d_CN0_SNV_dB_Hz < FLAGS_cn0_min)
                                 {
@@ -38,6 +38,7 @@
 #define GNSS_SDR_GLONASS_L2_CA_DLL_PLL_C_AID_TRACKING_CC_H
 
 #include "gnss_synchro.h"
+#include "lock_detectors.h"
 #include "tracking_2nd_DLL_filter.h"
 #include "tracking_FLL_PLL_filter.h"
 //#include "tracking_loop_filter.h"
@@ -178,8 +179,7 @@ private:
     uint64_t d_acq_sample_stamp;
 
     // CN0 estimation and lock detector
-    int32_t d_cn0_estimation_counter;
-    gr_complex* d_Prompt_buffer;
+    Cn0_Lock_Estimator d_cn0_estimator;
     double d_carrier_lock_test;
     double d_CN0_SNV_dB_Hz;
     double d_carrier_lock_threshold;
@@ -40,6 +40,7 @@
 #include "cpu_multicorrelator_16sc.h"
 #include "glonass_l2_signal_processing.h"
 #include "gnss_synchro.h"
+#include "lock_detectors.h"
 #include "tracking_2nd_DLL_filter.h"
 #include "tracking_FLL_PLL_filter.h"
 #include <boost/thread/mutex.hpp>
@@ -181,8 +182,7 @@ private:
     uint64_t d_acq_sample_stamp;
 
     // CN0 estimation and lock detector
-    int32_t d_cn0_estimation_counter;
-    gr_complex* d_Prompt_buffer;
+    Cn0_Lock_Estimator d_cn0_estimator;
     double d_carrier_lock_test;
     double d_CN0_SNV_dB_Hz;
     double d_carrier_lock_threshold;
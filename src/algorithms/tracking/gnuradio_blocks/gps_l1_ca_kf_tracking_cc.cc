@@ -161,9 +161,8 @@ Gps_L1_Ca_Kf_Tracking_cc::Gps_L1_Ca_Kf_Tracking_cc(
     d_enable_tracking = false;
     d_pull_in = false;
 
-    // CN0 estimation and lock detector buffers
-    d_cn0_estimation_counter = 0;
-    d_Prompt_buffer = new gr_complex[FLAGS_cn0_samples];
+    // CN0 estimation and lock detectors
+    d_cn0_estimator.set_length(FLAGS_cn0_samples);
     d_carrier_lock_test = 1;
     d_CN0_SNV_dB_Hz = 0;
     d_carrier_lock_fail_counter = 0;
@@ -202,54 +201,12 @@ Gps_L1_Ca_Kf_Tracking_cc::Gps_L1_Ca_Kf_Tracking_cc(
     double sigma2_doppler = 450;
     double sigma2_doppler_rate = pow(4.0 * GPS_TWO_PI, 2) / 12.0;
 
-    kf_P_x_ini = arma::zeros(2, 2);
-    kf_P_x_ini(0, 0) = sigma2_carrier_phase;
-    kf_P_x_ini(1, 1) = sigma2_doppler;
+    kf_R = sigma2_phase_detector_cycles2;
+    kf_P_y = 0.0;
+    kf_y = 0.0;
 
-    kf_R = arma::zeros(1, 1);
-    kf_R(0, 0) = sigma2_phase_detector_cycles2;
-
-    kf_Q = arma::zeros(2, 2);
-    kf_Q(0, 0) = pow(GPS_L1_CA_CODE_PERIOD, 4);
-    kf_Q(1, 1) = GPS_L1_CA_CODE_PERIOD;
-
-    kf_F = arma::zeros(2, 2);
-    kf_F(0, 0) = 1.0;
-    kf_F(0, 1) = GPS_TWO_PI * GPS_L1_CA_CODE_PERIOD;
-    kf_F(1, 0) = 0.0;
-    kf_F(1, 1) = 1.0;
-
-    kf_H = arma::zeros(1, 2);
-    kf_H(0, 0) = 1.0;
-
-    kf_x = arma::zeros(2, 1);
-    kf_y = arma::zeros(1, 1);
-    kf_P_y = arma::zeros(1, 1);
-
-    // order three
-    if (d_order == 3)
-        {
-            kf_P_x_ini = arma::resize(kf_P_x_ini, 3, 3);
-            kf_P_x_ini(2, 2) = sigma2_doppler_rate;
-
-            kf_Q = arma::zeros(3, 3);
-            kf_Q(0, 0) = pow(GPS_L1_CA_CODE_PERIOD, 4);
-            kf_Q(1, 1) = GPS_L1_CA_CODE_PERIOD;
-            kf_Q(2, 2) = GPS_L1_CA_CODE_PERIOD;
-
-            kf_F = arma::resize(kf_F, 3, 3);
-            kf_F(0, 2) = 0.5 * GPS_TWO_PI * pow(GPS_L1_CA_CODE_PERIOD, 2);
-            kf_F(1, 2) = GPS_L1_CA_CODE_PERIOD;
-            kf_F(2, 0) = 0.0;
-            kf_F(2, 1) = 0.0;
-            kf_F(2, 2) = 1.0;
-
-            kf_H = arma::resize(kf_H, 1, 3);
-            kf_H(0, 2) = 0.0;
-
-            kf_x = arma::resize(kf_x, 3, 1);
-            kf_x(2, 0) = 0.0;
-        }
+    d_carrier_kf.set_params(d_order, GPS_L1_CA_CODE_PERIOD);
+    d_carrier_kf.set_initial_covariance(sigma2_carrier_phase, sigma2_doppler, sigma2_doppler_rate);
 
     // Bayesian covariance estimator initialization
     kf_iter = 0;
@@ -261,7 +218,14 @@ Gps_L1_Ca_Kf_Tracking_cc::Gps_L1_Ca_Kf_Tracking_cc(
     bayes_nu = bce_nu;
     kf_R_est = kf_R;
 
-    bayes_estimator.init(arma::zeros(1, 1), bayes_kappa, bayes_nu, (kf_H * kf_P_x_ini * kf_H.t() + kf_R) * (bayes_nu + 2));
+    init_bayes_estimator();
+}
+
+
+void Gps_L1_Ca_Kf_Tracking_cc::init_bayes_estimator()
+{
+    double Psi_prior = (d_carrier_kf.initial_phase_variance() + kf_R) * (bayes_nu + 2);
+    bayes_estimator.init(0.0, bayes_kappa, bayes_nu, Psi_prior);
 }
 
 void Gps_L1_Ca_Kf_Tracking_cc::start_tracking()
@@ -277,8 +241,8 @@ void Gps_L1_Ca_Kf_Tracking_cc::start_tracking()
     // Correct Kalman filter covariance according to acq doppler step size (3 sigma)
     if (d_acquisition_gnss_synchro->Acq_doppler_step > 0)
         {
-            kf_P_x_ini(1, 1) = pow(d_acq_carrier_doppler_step_hz / 3.0, 2);
-            bayes_estimator.init(arma::zeros(1, 1), bayes_kappa, bayes_nu, (kf_H * kf_P_x_ini * kf_H.t() + kf_R) * (bayes_nu + 2));
+            d_carrier_kf.set_initial_doppler_variance(pow(d_acq_carrier_doppler_step_hz / 3.0, 2));
+            init_bayes_estimator();
         }
 
     int64_t acq_trk_diff_samples;
@@ -386,7 +350,6 @@ Gps_L1_Ca_Kf_Tracking_cc::~Gps_L1_Ca_Kf_Tracking_cc()
             volk_gnsssdr_free(d_local_code_shift_chips);
             volk_gnsssdr_free(d_correlator_outs);
             volk_gnsssdr_free(d_ca_code);
-            delete[] d_Prompt_buffer;
             multicorrelator_cpu.free();
         }
     catch (const std::exception &ex)
@@ -708,19 +671,12 @@ int Gps_L1_Ca_Kf_Tracking_cc::general_work(int noutput_items __attribute__((unus
                     current_synchro_data.fs = d_fs_in;
                     current_synchro_data.correlation_length_ms = 1;
                     *out[0] = current_synchro_data;
-                    // Kalman filter initialization reset
-                    kf_P_x = kf_P_x_ini;
-                    // Update Kalman states based on acquisition information
-                    kf_x(0) = d_carrier_phase_step_rad * samples_offset;
-                    kf_x(1) = d_carrier_doppler_hz;
-                    if (kf_x.n_elem > 2)
-                        {
-                            kf_x(2) = d_carrier_dopplerrate_hz2;
-                        }
+                    // Kalman filter initialization reset, with the states based on acquisition information
+                    d_carrier_kf.initialize(d_carrier_phase_step_rad * samples_offset, d_carrier_doppler_hz, d_carrier_dopplerrate_hz2);
 
                     // Covariance estimation initialization reset
                     kf_iter = 0;
-                    bayes_estimator.init(arma::zeros(1, 1), bayes_kappa, bayes_nu, (kf_H * kf_P_x_ini * kf_H.t() + kf_R) * (bayes_nu + 2));
+                    init_bayes_estimator();
 
                     consume_each(samples_offset);  // shift input to perform alignment with local replica
                     return 1;
@@ -739,8 +695,7 @@ int Gps_L1_Ca_Kf_Tracking_cc::general_work(int noutput_items __attribute__((unus
             // ################## Kalman Carrier Tracking ######################################
 
             // Kalman state prediction (time update)
-            kf_x_pre = kf_F * kf_x;                        //state prediction
-            kf_P_x_pre = kf_F * kf_P_x * kf_F.t() + kf_Q;  //state error covariance prediction
+            d_carrier_kf.predict();
 
             // Update discriminator [rads/Ti]
             d_carr_phase_error_rad = pll_cloop_two_quadrant_atan(d_correlator_outs[1]);  // prompt output
@@ -750,8 +705,8 @@ int Gps_L1_Ca_Kf_Tracking_cc::general_work(int noutput_items __attribute__((unus
             double CN_lin = pow(10, d_CN0_SNV_dB_Hz / 10.0);
             sigma2_phase_detector_cycles2 = (1.0 / (2.0 * CN_lin * GPS_L1_CA_CODE_PERIOD)) * (1.0 + 1.0 / (2.0 * CN_lin * GPS_L1_CA_CODE_PERIOD));
 
-            kf_y(0) = d_carr_phase_error_rad;  // measurement vector
-            kf_R(0, 0) = sigma2_phase_detector_cycles2;
+            kf_y = d_carr_phase_error_rad;  // measurement
+            kf_R = sigma2_phase_detector_cycles2;
 
             if (bayes_run && (kf_iter >= bayes_ptrans))
                 {
@@ -759,33 +714,23 @@ int Gps_L1_Ca_Kf_Tracking_cc::general_work(int noutput_items __attribute__((unus
                 }
             if (bayes_run && (kf_iter >= (bayes_ptrans + bayes_strans)))
                 {
-                    // TODO: Resolve segmentation fault
-                    kf_P_y = bayes_estimator.get_Psi_est();
-                    kf_R_est = kf_P_y - kf_H * kf_P_x_pre * kf_H.t();
+                    kf_P_y = bayes_estimator.Psi_est(0, 0);
+                    kf_R_est = kf_P_y - d_carrier_kf.predicted_phase_variance();
                 }
             else
                 {
-                    kf_P_y = kf_H * kf_P_x_pre * kf_H.t() + kf_R;  // innovation covariance matrix
+                    kf_P_y = d_carrier_kf.predicted_phase_variance() + kf_R;  // innovation covariance
                     kf_R_est = kf_R;
                 }
 
             // Kalman filter update step
-            kf_K = (kf_P_x_pre * kf_H.t()) * arma::inv(kf_P_y);                 // Kalman gain
-            kf_x = kf_x_pre + kf_K * kf_y;                                      // updated state estimation
-            kf_P_x = (arma::eye(size(kf_P_x_pre)) - kf_K * kf_H) * kf_P_x_pre;  // update state estimation error covariance matrix
+            d_carrier_kf.update(d_carr_phase_error_rad, kf_P_y);
 
             // Store Kalman filter results
-            d_rem_carr_phase_rad = kf_x(0);  // set a new carrier Phase estimation to the NCO
-            d_carrier_doppler_hz = kf_x(1);  // set a new carrier Doppler estimation to the NCO
-            if (kf_x.n_elem > 2)
-                {
-                    d_carrier_dopplerrate_hz2 = kf_x(2);
-                }
-            else
-                {
-                    d_carrier_dopplerrate_hz2 = 0;
-                }
-            d_carr_phase_sigma2 = kf_R_est(0, 0);
+            d_rem_carr_phase_rad = d_carrier_kf.phase_rad();            // set a new carrier Phase estimation to the NCO
+            d_carrier_doppler_hz = d_carrier_kf.doppler_hz();           // set a new carrier Doppler estimation to the NCO
+            d_carrier_dopplerrate_hz2 = d_carrier_kf.doppler_rate_hz2();  // zero for the second order filter
+            d_carr_phase_sigma2 = kf_R_est;
 
             // ################## DLL ##########################################################
             // New code Doppler frequency estimation based on carrier frequency estimation
@@ -819,19 +764,18 @@ int Gps_L1_Ca_Kf_Tracking_cc::general_work(int noutput_items __attribute__((unus
             d_rem_code_phase_chips = d_code_freq_chips * (d_rem_code_phase_samples / static_cast<double>(d_fs_in));
 
             // ####### CN0 ESTIMATION AND LOCK DETECTORS ######
-            if (d_cn0_estimation_counter < FLAGS_cn0_samples)
+            if (!d_cn0_estimator.ready())
                 {
-                    // fill buffer with prompt correlator output values
-                    d_Prompt_buffer[d_cn0_estimation_counter] = d_correlator_outs[1];  //prompt
-                    d_cn0_estimation_counter++;
+                    // accumulate the prompt correlator output values
+                    d_cn0_estimator.add(d_correlator_outs[1]);  //prompt
                 }
             else
                 {
-                    d_cn0_estimation_counter = 0;
                     // Code lock indicator
-                    d_CN0_SNV_dB_Hz = cn0_svn_estimator(d_Prompt_buffer, FLAGS_cn0_samples, GPS_L1_CA_CODE_PERIOD);
+                    d_CN0_SNV_dB_Hz = d_cn0_estimator.cn0_db_hz(GPS_L1_CA_CODE_PERIOD);
                     // Carrier lock indicator
-                    d_carrier_lock_test = carrier_lock_detector(d_Prompt_buffer, FLAGS_cn0_samples);
+                    d_carrier_lock_test = d_cn0_estimator.carrier_lock();
+                    d_cn0_estimator.reset();
                     // Loss of lock detection
                     if (d_carrier_lock_test < d_carrier_lock_threshold or d_CN0_SNV_dB_Hz < FLAGS_cn0_min)
                         {
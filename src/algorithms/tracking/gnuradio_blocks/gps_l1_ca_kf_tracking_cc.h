@@ -43,8 +43,10 @@
 #include "bayesian_estimation.h"
 #include "cpu_multicorrelator_real_codes.h"
 #include "gnss_synchro.h"
+#include "lock_detectors.h"
 #include "tracking_2nd_DLL_filter.h"
 #include "tracking_2nd_PLL_filter.h"
+#include "tracking_kf_carrier_filter.h"
 #include <armadillo>
 #include <gnuradio/block.h>
 #include <fstream>
@@ -135,24 +137,15 @@ private:
     double d_rem_carr_phase_rad;
 
     // Kalman filter variables
-    arma::mat kf_P_x_ini;  // initial state error covariance matrix
-    arma::mat kf_P_x;      // state error covariance matrix
-    arma::mat kf_P_x_pre;  // Predicted state error covariance matrix
-    arma::mat kf_P_y;      // innovation covariance matrix
-
-    arma::mat kf_F;  // state transition matrix
-    arma::mat kf_H;  // system matrix
-    arma::mat kf_R;  // measurement error covariance matrix
-    arma::mat kf_Q;  // system error covariance matrix
-
-    arma::colvec kf_x;      // state vector
-    arma::colvec kf_x_pre;  // predicted state vector
-    arma::colvec kf_y;      // measurement vector
-    arma::mat kf_K;         // Kalman gain matrix
+    Tracking_KF_Carrier_Filter d_carrier_kf;
+    double kf_R;    // measurement error covariance
+    double kf_P_y;  // innovation covariance
+    double kf_y;    // measurement
 
     // Bayesian estimator
+    void init_bayes_estimator();
     Bayesian_estimator bayes_estimator;
-    arma::mat kf_R_est;  // measurement error covariance
+    double kf_R_est;  // measurement error covariance
     uint32_t bayes_ptrans;
     uint32_t bayes_strans;
     int32_t bayes_nu;
@@ -198,8 +191,7 @@ private:
     uint64_t d_acq_sample_stamp;
 
     // CN0 estimation and lock detector
-    int32_t d_cn0_estimation_counter;
-    gr_complex* d_Prompt_buffer;
+    Cn0_Lock_Estimator d_cn0_estimator;
     double d_carrier_lock_test;
     double d_CN0_SNV_dB_Hz;
     double d_carrier_lock_threshold;
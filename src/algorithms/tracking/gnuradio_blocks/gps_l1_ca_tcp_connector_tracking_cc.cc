@@ -64,10 +64,11 @@ gps_l1_ca_tcp_connector_make_tracking_cc(
     bool dump,
     const std::string &dump_filename,
     float early_late_space_chips,
-    size_t port_ch0)
+    size_t port_ch0,
+    bool batch_tcp)
 {
     return gps_l1_ca_tcp_connector_tracking_cc_sptr(new Gps_L1_Ca_Tcp_Connector_Tracking_cc(
-        fs_in, vector_length, dump, dump_filename, early_late_space_chips, port_ch0));
+        fs_in, vector_length, dump, dump_filename, early_late_space_chips, port_ch0, batch_tcp));
 }
 
 
@@ -87,7 +88,8 @@ Gps_L1_Ca_Tcp_Connector_Tracking_cc::Gps_L1_Ca_Tcp_Connector_Tracking_cc(
     bool dump,
     const std::string &dump_filename,
     float early_late_space_chips,
-    size_t port_ch0) : gr::block("Gps_L1_Ca_Tcp_Connector_Tracking_cc", gr::io_signature::make(1, 1, sizeof(gr_complex)),
+    size_t port_ch0,
+    bool batch_tcp) : gr::block("Gps_L1_Ca_Tcp_Connector_Tracking_cc", gr::io_signature::make(1, 1, sizeof(gr_complex)),
                            gr::io_signature::make(1, 1, sizeof(Gnss_Synchro)))
 {
     this->message_port_register_out(pmt::mp("events"));
@@ -105,6 +107,7 @@ Gps_L1_Ca_Tcp_Connector_Tracking_cc::Gps_L1_Ca_Tcp_Connector_Tracking_cc(
     d_port = 0;
     d_listen_connection = true;
     d_control_id = 0;
+    d_batch_tcp = batch_tcp;
 
     // Initialization of local code replica
     // Get space for a vector with the C/A code replica sampled 1x/chip
@@ -278,7 +281,10 @@ Gps_L1_Ca_Tcp_Connector_Tracking_cc::~Gps_L1_Ca_Tcp_Connector_Tracking_cc()
             volk_gnsssdr_free(d_local_code_shift_chips);
             volk_gnsssdr_free(d_correlator_outs);
             volk_gnsssdr_free(d_ca_code);
-            d_tcp_com.close_tcp_connection(d_port);
+            if (!d_batch_tcp)
+                {
+                    d_tcp_com.close_tcp_connection(d_port);
+                }
             delete[] d_Prompt_buffer;
             multicorrelator_cpu.free();
         }
@@ -316,8 +322,18 @@ void Gps_L1_Ca_Tcp_Connector_Tracking_cc::set_channel(uint32_t channel)
     //! Listen for connections on a TCP port
     if (d_listen_connection == true)
         {
-            d_port = d_port_ch0 + d_channel;
-            d_listen_connection = d_tcp_com.listen_tcp_connection(d_port, d_port_ch0);
+            if (d_batch_tcp)
+                {
+                    // all the channels share the connection on port_ch0
+                    d_port = d_port_ch0;
+                    d_tcp_batch = tcp_batch_communication::get_instance(d_port);
+                    d_listen_connection = false;
+                }
+            else
+                {
+                    d_port = d_port_ch0 + d_channel;
+                    d_listen_connection = d_tcp_com.listen_tcp_connection(d_port, d_port_ch0);
+                }
         }
 }
 
@@ -402,7 +418,16 @@ int Gps_L1_Ca_Tcp_Connector_Tracking_cc::general_work(int noutput_items __attrib
                 (*d_Prompt).imag(),
                 d_acq_carrier_doppler_hz,
                 1}};
-            d_tcp_com.send_receive_tcp_packet_gps_l1_ca(tx_variables_array, &tcp_data);
+            if (d_batch_tcp)
+                {
+                    // the reply to an earlier period, if any, otherwise the current Doppler and no errors
+                    tcp_data.proc_pack_carrier_doppler_hz = d_carrier_doppler_hz;
+                    d_tcp_batch->send_receive(d_channel, tx_variables_array.data(), tx_variables_array.size(), &tcp_data);
+                }
+            else
+                {
+                    d_tcp_com.send_receive_tcp_packet_gps_l1_ca(tx_variables_array, &tcp_data);
+                }
 
             //! Recover the tracking data
             code_error = tcp_data.proc_pack_code_error;
@@ -496,9 +521,12 @@ int Gps_L1_Ca_Tcp_Connector_Tracking_cc::general_work(int noutput_items __attrib
             *d_Late = gr_complex(0, 0);
             // GNSS_SYNCHRO OBJECT to interchange data between tracking->telemetry_decoder
             current_synchro_data.Tracking_sample_counter = d_sample_counter + static_cast<uint64_t>(d_correlation_length_samples);
-            //! When tracking is disabled an array of 1's is sent to maintain the TCP connection
-            boost::array<float, NUM_TX_VARIABLES_GPS_L1_CA> tx_variables_array = {{1, 1, 1, 1, 1, 1, 1, 1, 0}};
-            d_tcp_com.send_receive_tcp_packet_gps_l1_ca(tx_variables_array, &tcp_data);
+            //! When tracking is disabled an array of 1's is sent to maintain the TCP connection (the batched one does not need it)
+            if (!d_batch_tcp)
+                {
+                    boost::array<float, NUM_TX_VARIABLES_GPS_L1_CA> tx_variables_array = {{1, 1, 1, 1, 1, 1, 1, 1, 0}};
+                    d_tcp_com.send_receive_tcp_packet_gps_l1_ca(tx_variables_array, &tcp_data);
+                }
         }
 
     //assign the GNURadio block output data
@@ -39,10 +39,12 @@
 
 #include "cpu_multicorrelator.h"
 #include "gnss_synchro.h"
+#include "tcp_batch_communication.h"
 #include "tcp_communication.h"
 #include <gnuradio/block.h>
 #include <fstream>
 #include <map>
+#include <memory>
 #include <string>
 
 
@@ -56,7 +58,8 @@ gps_l1_ca_tcp_connector_make_tracking_cc(
     bool dump,
     const std::string &dump_filename,
     float early_late_space_chips,
-    size_t port_ch0);
+    size_t port_ch0,
+    bool batch_tcp);
 
 
 /*!
@@ -88,14 +91,16 @@ private:
         bool dump,
         const std::string &dump_filename,
         float early_late_space_chips,
-        size_t port_ch0);
+        size_t port_ch0,
+        bool batch_tcp);
 
     Gps_L1_Ca_Tcp_Connector_Tracking_cc(
         int64_t fs_in, uint32_t vector_length,
         bool dump,
         const std::string &dump_filename,
         float early_late_space_chips,
-        size_t port_ch0);
+        size_t port_ch0,
+        bool batch_tcp);
 
     // tracking configuration vars
     uint32_t d_vector_length;
@@ -140,6 +145,8 @@ private:
     int32_t d_listen_connection;
     float d_control_id;
     tcp_communication d_tcp_com;
+    bool d_batch_tcp;
+    std::shared_ptr<tcp_batch_communication> d_tcp_batch;  // with d_batch_tcp, instead of d_tcp_com
 
     //PRN period in samples
     int32_t d_current_prn_length_samples;
@@ -38,101 +38,139 @@
  */
 
 #include "bayesian_estimation.h"
+#include <glog/logging.h>
+#include <algorithm>
 
 
 Bayesian_estimator::Bayesian_estimator()
 {
-    int ny = 1;
-    mu_prior = arma::zeros(ny, 1);
-    kappa_prior = 0;
-    nu_prior = 0;
-    Psi_prior = arma::eye(ny, ny) * (nu_prior + ny + 1);
-
-    mu_est = mu_prior;
-    Psi_est = Psi_prior;
+    double mu_prior_0[MAX_NY] = {0.0, 0.0};
+    double Psi_prior_0[MAX_NY * MAX_NY] = {2.0, 0.0, 0.0, 0.0};
+    d_ny = 1;
+    set_priors(mu_prior_0, 0, 0, Psi_prior_0);
 }
 
 Bayesian_estimator::Bayesian_estimator(int ny)
 {
-    mu_prior = arma::zeros(ny, 1);
-    kappa_prior = 0;
-    nu_prior = 0;
-    Psi_prior = arma::eye(ny, ny) * (nu_prior + ny + 1);
-
-    mu_est = mu_prior;
-    Psi_est = Psi_prior;
+    d_ny = (ny < 1) ? 1 : ((ny > MAX_NY) ? MAX_NY : ny);
+    double mu_prior_0[MAX_NY] = {0.0, 0.0};
+    double Psi_prior_0[MAX_NY * MAX_NY] = {0.0, 0.0, 0.0, 0.0};
+    for (int i = 0; i < d_ny; i++)
+        {
+            Psi_prior_0[i * MAX_NY + i] = d_ny + 1;
+        }
+    set_priors(mu_prior_0, 0, 0, Psi_prior_0);
 }
 
 Bayesian_estimator::Bayesian_estimator(const arma::vec& mu_prior_0, int kappa_prior_0, int nu_prior_0, const arma::mat& Psi_prior_0)
 {
-    mu_prior = mu_prior_0;
-    kappa_prior = kappa_prior_0;
-    nu_prior = nu_prior_0;
-    Psi_prior = Psi_prior_0;
-
-    mu_est = mu_prior;
-    Psi_est = Psi_prior;
+    set_priors(mu_prior_0, kappa_prior_0, nu_prior_0, Psi_prior_0);
 }
 
 Bayesian_estimator::~Bayesian_estimator() = default;
 
 void Bayesian_estimator::init(const arma::mat& mu_prior_0, int kappa_prior_0, int nu_prior_0, const arma::mat& Psi_prior_0)
 {
-    mu_prior = mu_prior_0;
-    kappa_prior = kappa_prior_0;
-    nu_prior = nu_prior_0;
-    Psi_prior = Psi_prior_0;
-
-    mu_est = mu_prior;
-    Psi_est = Psi_prior;
+    set_priors(mu_prior_0, kappa_prior_0, nu_prior_0, Psi_prior_0);
 }
 
-/*
- * Perform Bayesian noise estimation using the normal-inverse-Wishart priors stored in
- * the class structure, and update the priors according to the computed posteriors
- */
-void Bayesian_estimator::update_sequential(const arma::vec& data)
+void Bayesian_estimator::init(double mu_prior_0, int kappa_prior_0, int nu_prior_0, double Psi_prior_0)
 {
-    int K = data.n_cols;
-    int ny = data.n_rows;
+    double mu[MAX_NY] = {mu_prior_0, 0.0};
+    double Psi[MAX_NY * MAX_NY] = {Psi_prior_0, 0.0, 0.0, 0.0};
+    d_ny = 1;
+    set_priors(mu, kappa_prior_0, nu_prior_0, Psi);
+}
 
-    if (mu_prior.is_empty())
+void Bayesian_estimator::set_priors(const arma::mat& mu_prior_0, int kappa_prior_0, int nu_prior_0, const arma::mat& Psi_prior_0)
+{
+    int ny = static_cast<int>(Psi_prior_0.n_rows);
+    if (ny > MAX_NY)
         {
-            mu_prior = arma::zeros(ny, 1);
+            LOG(WARNING) << "Bayesian_estimator supports samples of up to " << MAX_NY << " elements, ignoring the rest of the " << ny;
         }
-
-    if (Psi_prior.is_empty())
+    d_ny = (ny < 1) ? 1 : ((ny > MAX_NY) ? MAX_NY : ny);
+    double mu[MAX_NY] = {0.0, 0.0};
+    double Psi[MAX_NY * MAX_NY] = {0.0, 0.0, 0.0, 0.0};
+    for (int i = 0; i < d_ny; i++)
         {
-            Psi_prior = arma::zeros(ny, ny);
+            if (static_cast<arma::uword>(i) < mu_prior_0.n_elem)
+                {
+                    mu[i] = mu_prior_0(i);
+                }
+            for (int j = 0; j < d_ny; j++)
+                {
+                    Psi[i * MAX_NY + j] = Psi_prior_0(i, j);
+                }
         }
+    set_priors(mu, kappa_prior_0, nu_prior_0, Psi);
+}
 
-    arma::vec y_mean = arma::mean(data, 1);
-    arma::mat Psi_N = arma::zeros(ny, ny);
-
-    for (int kk = 0; kk < K; kk++)
+void Bayesian_estimator::set_priors(const double* mu_prior_0, int kappa_prior_0, int nu_prior_0, const double* Psi_prior_0)
+{
+    std::fill_n(d_mu_prior, MAX_NY, 0.0);
+    std::fill_n(&d_Psi_prior[0][0], MAX_NY * MAX_NY, 0.0);
+    for (int i = 0; i < d_ny; i++)
         {
-            Psi_N = Psi_N + (data.col(kk) - y_mean) * ((data.col(kk) - y_mean).t());
+            d_mu_prior[i] = mu_prior_0[i];
+            for (int j = 0; j < d_ny; j++)
+                {
+                    d_Psi_prior[i][j] = Psi_prior_0[i * MAX_NY + j];
+                }
         }
+    d_kappa_prior = kappa_prior_0;
+    d_nu_prior = nu_prior_0;
 
-    arma::vec mu_posterior = (kappa_prior * mu_prior + K * y_mean) / (kappa_prior + K);
-    int kappa_posterior = kappa_prior + K;
-    int nu_posterior = nu_prior + K;
-    arma::mat Psi_posterior = Psi_prior + Psi_N + (kappa_prior * K) / (kappa_prior + K) * (y_mean - mu_prior) * ((y_mean - mu_prior).t());
+    std::copy(d_mu_prior, d_mu_prior + MAX_NY, d_mu_est);
+    std::copy(&d_Psi_prior[0][0], &d_Psi_prior[0][0] + MAX_NY * MAX_NY, &d_Psi_est[0][0]);
+}
 
-    mu_est = mu_posterior;
-    if ((nu_posterior - ny - 1) > 0)
+/*
+ * Perform Bayesian noise estimation using the normal-inverse-Wishart priors stored in
+ * the class structure, and update the priors according to the computed posteriors.
+ * With a single sample y, the scatter matrix of the data is zero and
+ *   mu_post = mu + (y - mu) / (kappa + 1)
+ *   Psi_post = Psi + kappa / (kappa + 1) * (y - mu) * (y - mu)'
+ */
+void Bayesian_estimator::update_sequential(const double* data)
+{
+    double innovation[MAX_NY] = {0.0, 0.0};
+    double kappa = static_cast<double>(d_kappa_prior);
+    for (int i = 0; i < d_ny; i++)
+        {
+            innovation[i] = data[i] - d_mu_prior[i];
+            d_mu_prior[i] += innovation[i] / (kappa + 1.0);
+        }
+    double weight = kappa / (kappa + 1.0);
+    for (int i = 0; i < d_ny; i++)
         {
-            Psi_est = Psi_posterior / (nu_posterior - ny - 1);
+            for (int j = 0; j < d_ny; j++)
+                {
+                    d_Psi_prior[i][j] += weight * innovation[i] * innovation[j];
+                }
         }
-    else
+    d_kappa_prior++;
+    d_nu_prior++;
+
+    double dof = static_cast<double>((d_nu_prior - d_ny - 1) > 0 ? (d_nu_prior - d_ny - 1) : (d_nu_prior + d_ny + 1));
+    for (int i = 0; i < d_ny; i++)
         {
-            Psi_est = Psi_posterior / (nu_posterior + ny + 1);
+            d_mu_est[i] = d_mu_prior[i];
+            for (int j = 0; j < d_ny; j++)
+                {
+                    d_Psi_est[i][j] = d_Psi_prior[i][j] / dof;
+                }
         }
+}
 
-    mu_prior = mu_posterior;
-    kappa_prior = kappa_posterior;
-    nu_prior = nu_posterior;
-    Psi_prior = Psi_posterior;
+void Bayesian_estimator::update_sequential(double data)
+{
+    update_sequential(&data);
+}
+
+void Bayesian_estimator::update_sequential(const arma::vec& data)
+{
+    update_sequential(data.memptr());
 }
 
 
@@ -142,44 +180,29 @@ void Bayesian_estimator::update_sequential(const arma::vec& data)
  */
 void Bayesian_estimator::update_sequential(const arma::vec& data, const arma::vec& mu_prior_0, int kappa_prior_0, int nu_prior_0, const arma::mat& Psi_prior_0)
 {
-    int K = data.n_cols;
-    int ny = data.n_rows;
-
-    arma::vec y_mean = arma::mean(data, 1);
-    arma::mat Psi_N = arma::zeros(ny, ny);
-
-    for (int kk = 0; kk < K; kk++)
-        {
-            Psi_N = Psi_N + (data.col(kk) - y_mean) * ((data.col(kk) - y_mean).t());
-        }
-
-    arma::vec mu_posterior = (kappa_prior_0 * mu_prior_0 + K * y_mean) / (kappa_prior_0 + K);
-    int kappa_posterior = kappa_prior_0 + K;
-    int nu_posterior = nu_prior_0 + K;
-    arma::mat Psi_posterior = Psi_prior_0 + Psi_N + (kappa_prior_0 * K) / (kappa_prior_0 + K) * (y_mean - mu_prior_0) * ((y_mean - mu_prior_0).t());
-
-    mu_est = mu_posterior;
-    if ((nu_posterior - ny - 1) > 0)
-        {
-            Psi_est = Psi_posterior / (nu_posterior - ny - 1);
-        }
-    else
-        {
-            Psi_est = Psi_posterior / (nu_posterior + ny + 1);
-        }
-
-    mu_prior = mu_posterior;
-    kappa_prior = kappa_posterior;
-    nu_prior = nu_posterior;
-    Psi_prior = Psi_posterior;
+    set_priors(mu_prior_0, kappa_prior_0, nu_prior_0, Psi_prior_0);
+    update_sequential(data.memptr());
 }
 
 arma::mat Bayesian_estimator::get_mu_est() const
 {
-    return mu_est;
+    arma::mat mu(d_ny, 1);
+    for (int i = 0; i < d_ny; i++)
+        {
+            mu(i, 0) = d_mu_est[i];
+        }
+    return mu;
 }
 
 arma::mat Bayesian_estimator::get_Psi_est() const
 {
-    return Psi_est;
+    arma::mat Psi(d_ny, d_ny);
+    for (int i = 0; i < d_ny; i++)
+        {
+            for (int j = 0; j < d_ny; j++)
+                {
+                    Psi(i, j) = d_Psi_est[i][j];
+                }
+        }
+    return Psi;
 }
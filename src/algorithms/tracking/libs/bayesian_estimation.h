@@ -52,6 +52,10 @@
  * which has a conjugate prior given by a normal-inverse-Wishart distribution with paramemters
  * \mathbf{\mu}_{0}, \kappa_{0}, \nu_{0}, and \mathbf{\Psi}.
  *
+ * The samples are scalars or vectors of two elements. The estimates and the priors have a
+ * fixed size and are updated in place, one sample at a time (a rank-one update of \mathbf{\Psi}),
+ * so the sequential updates run without any memory allocation.
+ *
  * [1] TODO: Ref1
  *
  */
@@ -59,6 +63,8 @@
 class Bayesian_estimator
 {
 public:
+    static const int MAX_NY = 2;  // maximum size of the samples
+
     Bayesian_estimator();
     Bayesian_estimator(int ny);
     Bayesian_estimator(const arma::vec& mu_prior_0, int kappa_prior_0, int nu_prior_0, const arma::mat& Psi_prior_0);
@@ -66,20 +72,50 @@ public:
 
     void init(const arma::mat& mu_prior_0, int kappa_prior_0, int nu_prior_0, const arma::mat& Psi_prior_0);
 
+    /*!
+     * \brief Initializes a scalar estimator with the prior mean \p mu_prior_0 and scale \p Psi_prior_0
+     */
+    void init(double mu_prior_0, int kappa_prior_0, int nu_prior_0, double Psi_prior_0);
+
     void update_sequential(const arma::vec& data);
     void update_sequential(const arma::vec& data, const arma::vec& mu_prior_0, int kappa_prior_0, int nu_prior_0, const arma::mat& Psi_prior_0);
 
+    /*!
+     * \brief Updates the estimates with the sample \p data, of ny() elements,
+     * without allocating memory
+     */
+    void update_sequential(const double* data);
+    void update_sequential(double data);
+
     arma::mat get_mu_est() const;
     arma::mat get_Psi_est() const;
 
+    inline int ny() const
+    {
+        return d_ny;
+    }
+    inline double mu_est(int row) const
+    {
+        return d_mu_est[row];
+    }
+    inline double Psi_est(int row, int col) const
+    {
+        return d_Psi_est[row][col];
+    }
+
 private:
-    arma::vec mu_est;
-    arma::mat Psi_est;
+    void set_priors(const double* mu_prior_0, int kappa_prior_0, int nu_prior_0, const double* Psi_prior_0);
+    void set_priors(const arma::mat& mu_prior_0, int kappa_prior_0, int nu_prior_0, const arma::mat& Psi_prior_0);
+
+    int d_ny;
+
+    double d_mu_est[MAX_NY];
+    double d_Psi_est[MAX_NY][MAX_NY];
 
-    arma::vec mu_prior;
-    int kappa_prior;
-    int nu_prior;
-    arma::mat Psi_prior;
+    double d_mu_prior[MAX_NY];
+    int d_kappa_prior;
+    int d_nu_prior;
+    double d_Psi_prior[MAX_NY][MAX_NY];
 };
 
 #endif
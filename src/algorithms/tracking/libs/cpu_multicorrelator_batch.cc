@@ -0,0 +1,166 @@
+/*!
+ * \file cpu_multicorrelator_batch.cc
+ * \brief Engine that runs the correlations of all the tracking channels
+ * sharing the same input buffer in a single pass over the samples.
+ *
+ * -------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2018  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *          Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------
+ */
+
+#include "cpu_multicorrelator_batch.h"
+#include <algorithm>
+#include <chrono>
+
+
+std::shared_ptr<cpu_multicorrelator_batch> cpu_multicorrelator_batch::get_instance(int32_t batch_window_us)
+{
+    static std::mutex registry_mutex;
+    static std::weak_ptr<cpu_multicorrelator_batch> registry;
+
+    std::lock_guard<std::mutex> lock(registry_mutex);
+    std::shared_ptr<cpu_multicorrelator_batch> engine = registry.lock();
+    if (!engine)
+        {
+            engine = std::make_shared<cpu_multicorrelator_batch>(batch_window_us);
+            registry = engine;
+        }
+    return engine;
+}
+
+
+cpu_multicorrelator_batch::cpu_multicorrelator_batch(int32_t batch_window_us)
+{
+    d_batch_window_us = (batch_window_us > 0 ? batch_window_us : 0);
+    d_channels = 0U;
+}
+
+
+void cpu_multicorrelator_batch::add_channel()
+{
+    std::lock_guard<std::mutex> lock(d_mutex);
+    d_channels++;
+}
+
+
+void cpu_multicorrelator_batch::remove_channel()
+{
+    std::lock_guard<std::mutex> lock(d_mutex);
+    if (d_channels > 0U)
+        {
+            d_channels--;
+        }
+}
+
+
+void cpu_multicorrelator_batch::correlate(const std::vector<cpu_multicorrelator_real_codes*>& correlators)
+{
+    Request request;
+    request.correlators = &correlators;
+    request.taken = false;
+    request.done = false;
+
+    std::unique_lock<std::mutex> lock(d_mutex);
+    d_pending.push_back(&request);
+    if (d_pending.size() < d_channels)
+        {
+            // Wait for the rest of the channels, or for another thread to process the batch
+            d_done_cond.wait_for(lock, std::chrono::microseconds(d_batch_window_us), [&request] { return request.taken; });
+        }
+    if (!request.taken)
+        {
+            // This thread processes all the pending requests
+            std::vector<Request*> batch;
+            batch.swap(d_pending);
+            for (auto r : batch)
+                {
+                    r->taken = true;
+                }
+            lock.unlock();
+            run_batch(batch);
+            lock.lock();
+            for (auto r : batch)
+                {
+                    r->done = true;
+                }
+            d_done_cond.notify_all();
+        }
+    d_done_cond.wait(lock, [&request] { return request.done; });
+}
+
+
+void cpu_multicorrelator_batch::run_batch(const std::vector<Request*>& batch)
+{
+    struct Span
+    {
+        cpu_multicorrelator_real_codes* correlator;
+        uintptr_t begin;
+        uintptr_t end;
+    };
+
+    std::vector<Span> spans;
+    for (auto r : batch)
+        {
+            for (auto correlator : *r->correlators)
+                {
+                    Span span;
+                    span.correlator = correlator;
+                    span.begin = reinterpret_cast<uintptr_t>(correlator->input_vector());
+                    span.end = span.begin + correlator->batch_length_samples() * sizeof(std::complex<float>);
+                    spans.push_back(span);
+                }
+        }
+    std::sort(spans.begin(), spans.end(), [](const Span& a, const Span& b) { return a.begin < b.begin; });
+
+    // Process each group of overlapping input ranges chunk by chunk
+    size_t group_begin = 0;
+    while (group_begin < spans.size())
+        {
+            size_t group_end = group_begin + 1;
+            uintptr_t end = spans[group_begin].end;
+            while (group_end < spans.size() and spans[group_end].begin < end)
+                {
+                    end = std::max(end, spans[group_end].end);
+                    group_end++;
+                }
+            for (uintptr_t chunk = spans[group_begin].begin; chunk < end; chunk += CHUNK_BYTES)
+                {
+                    for (size_t n = group_begin; n < group_end; n++)
+                        {
+                            const Span& span = spans[n];
+                            if (span.end <= chunk or span.begin >= chunk + CHUNK_BYTES)
+                                {
+                                    continue;
+                                }
+                            // First sample of the span at or after each chunk boundary
+                            auto first_sample = [&span](uintptr_t address) {
+                                return address <= span.begin ? 0 : static_cast<int>((address - span.begin + sizeof(std::complex<float>) - 1) / sizeof(std::complex<float>));
+                            };
+                            int first = first_sample(chunk);
+                            int last = std::min(first_sample(chunk + CHUNK_BYTES), span.correlator->batch_length_samples());
+                            span.correlator->batch_correlation_chunk(first, last - first);
+                        }
+                }
+            group_begin = group_end;
+        }
+}
@@ -0,0 +1,98 @@
+/*!
+ * \file cpu_multicorrelator_batch.h
+ * \brief Engine that runs the correlations of all the tracking channels
+ * sharing the same input buffer in a single pass over the samples.
+ *
+ * Every tracking channel reads the same samples from the output buffer of
+ * the signal conditioner. Instead of streaming them through the cache once
+ * per channel, the correlations requested by the channels within a short
+ * batching window are processed together, chunk by chunk of the shared
+ * input, so that each chunk is correlated by all the channels covering it
+ * while it is still in cache.
+ *
+ * -------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2018  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *          Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_CPU_MULTICORRELATOR_BATCH_H_
+#define GNSS_SDR_CPU_MULTICORRELATOR_BATCH_H_
+
+#include "cpu_multicorrelator_real_codes.h"
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+
+/*!
+ * \brief Shared back-end for the CPU multicorrelators of the tracking channels.
+ *
+ * Channels register with add_channel() while they are tracking. A batch is
+ * processed as soon as all the registered channels have submitted their
+ * correlations, or when the batching window of the oldest request expires.
+ * It is run by one of the submitting threads, so no extra thread is needed.
+ */
+class cpu_multicorrelator_batch
+{
+public:
+    /*!
+     * \brief Returns the engine shared by all the tracking channels. It is
+     * created on the first request, and released when the last channel using
+     * it is destroyed.
+     */
+    static std::shared_ptr<cpu_multicorrelator_batch> get_instance(int32_t batch_window_us);
+
+    explicit cpu_multicorrelator_batch(int32_t batch_window_us);
+
+    void add_channel();
+    void remove_channel();
+
+    /*!
+     * \brief Runs the correlations started with
+     * cpu_multicorrelator_real_codes::start_batch_correlation() in
+     * \p correlators, blocking until they are completed.
+     */
+    void correlate(const std::vector<cpu_multicorrelator_real_codes*>& correlators);
+
+private:
+    struct Request
+    {
+        const std::vector<cpu_multicorrelator_real_codes*>* correlators;
+        bool taken;
+        bool done;
+    };
+
+    void run_batch(const std::vector<Request*>& batch);
+
+    static const uintptr_t CHUNK_BYTES = 4096 * sizeof(std::complex<float>);
+
+    int32_t d_batch_window_us;
+    uint32_t d_channels;
+    std::vector<Request*> d_pending;
+    std::mutex d_mutex;
+    std::condition_variable d_done_cond;
+};
+
+#endif
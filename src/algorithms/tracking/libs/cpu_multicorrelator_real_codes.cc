@@ -34,7 +34,9 @@
  */
 
 #include "cpu_multicorrelator_real_codes.h"
+#include "gnss_arena.h"
 #include <volk_gnsssdr/volk_gnsssdr.h>
+#include <algorithm>
 #include <cmath>
 
 cpu_multicorrelator_real_codes::cpu_multicorrelator_real_codes()
@@ -44,8 +46,33 @@ cpu_multicorrelator_real_codes::cpu_multicorrelator_real_codes()
     d_shifts_chips = nullptr;
     d_corr_out = nullptr;
     d_local_codes_resampled = nullptr;
+    d_in_arena = false;
+    d_extra_corr_out = nullptr;
+    d_all_corr_out = nullptr;
+    d_extra_local_code_in = nullptr;
+    d_extra_shifts_chips = nullptr;
+    d_extra_code_length_chips = 0;
+    d_n_extra_correlators = 0;
+    d_batch_partial_out = nullptr;
+    d_batch_phase = std::complex<float>(1.0, 0.0);
+    d_batch_phase_step_rad = 0.0;
+    d_batch_phase_rate_step_rad = 0.0;
+    d_batch_length_samples = 0;
+    d_local_codes = nullptr;
+    d_replica_table = nullptr;
+    d_replica_table_size = 0;
+    d_n_replica_phases = 0;
+    d_replica_length_samples = 0;
+    d_replica_stride = 0;
+    d_replica_code_phase_step_chips = 0.0;
+    d_replica_candidate_step_chips = 0.0;
+    d_replica_stable_calls = 0;
+    d_replica_table_valid = false;
+    d_max_signal_length_samples = 0;
     d_code_length_chips = 0;
     d_n_correlators = 0;
+    d_first_active_correlator = 0;
+    d_n_active_correlators = 0;
     d_use_high_dynamics_resampler = true;
 }
 
@@ -61,17 +88,57 @@ cpu_multicorrelator_real_codes::~cpu_multicorrelator_real_codes()
 
 bool cpu_multicorrelator_real_codes::init(
     int max_signal_length_samples,
-    int n_correlators)
+    int n_correlators,
+    int n_extra_correlators,
+    Gnss_Arena* arena)
 {
     // ALLOCATE MEMORY FOR INTERNAL vectors
     size_t size = max_signal_length_samples * sizeof(float);
+    int n_all_correlators = n_correlators + n_extra_correlators;
 
-    d_local_codes_resampled = static_cast<float**>(volk_gnsssdr_malloc(n_correlators * sizeof(float*), volk_gnsssdr_get_alignment()));
-    for (int n = 0; n < n_correlators; n++)
+    if (arena != nullptr)
         {
-            d_local_codes_resampled[n] = static_cast<float*>(volk_gnsssdr_malloc(size, volk_gnsssdr_get_alignment()));
+            // in the order they are used by each correlation
+            auto** local_codes_resampled = arena->take<float*>(n_all_correlators);
+            for (int n = 0; n < n_all_correlators; n++)
+                {
+                    float* local_code = arena->take<float>(max_signal_length_samples);
+                    if (local_codes_resampled != nullptr)
+                        {
+                            local_codes_resampled[n] = local_code;
+                        }
+                }
+            auto* batch_partial_out = arena->take<std::complex<float>>(n_all_correlators);
+            auto* all_corr_out = arena->take<std::complex<float>>(n_all_correlators);
+            if (!arena->allocated())
+                {
+                    // sizing the arena
+                    return true;
+                }
+            d_local_codes_resampled = local_codes_resampled;
+            d_batch_partial_out = batch_partial_out;
+            d_all_corr_out = all_corr_out;
+            d_in_arena = true;
         }
+    else
+        {
+            d_local_codes_resampled = static_cast<float**>(volk_gnsssdr_malloc(n_all_correlators * sizeof(float*), volk_gnsssdr_get_alignment()));
+            for (int n = 0; n < n_all_correlators; n++)
+                {
+                    d_local_codes_resampled[n] = static_cast<float*>(volk_gnsssdr_malloc(size, volk_gnsssdr_get_alignment()));
+                }
+            d_all_corr_out = static_cast<std::complex<float>*>(volk_gnsssdr_malloc(n_all_correlators * sizeof(std::complex<float>), volk_gnsssdr_get_alignment()));
+            d_batch_partial_out = static_cast<std::complex<float>*>(volk_gnsssdr_malloc(n_all_correlators * sizeof(std::complex<float>), volk_gnsssdr_get_alignment()));
+            d_in_arena = false;
+        }
+    d_active_codes.resize(n_all_correlators);
+    d_local_codes = d_local_codes_resampled;
+    d_replica_codes.resize(n_all_correlators);
+    d_max_signal_length_samples = max_signal_length_samples;
     d_n_correlators = n_correlators;
+    d_n_extra_correlators = n_extra_correlators;
+    d_first_active_correlator = 0;
+    d_n_active_correlators = n_correlators;
     return true;
 }
 
@@ -84,47 +151,265 @@ bool cpu_multicorrelator_real_codes::set_local_code_and_taps(
     d_local_code_in = local_code_in;
     d_shifts_chips = shifts_chips;
     d_code_length_chips = code_length_chips;
+    d_replica_table_valid = false;
+
+    return true;
+}
+
+
+bool cpu_multicorrelator_real_codes::set_extra_local_code_and_taps(
+    int code_length_chips,
+    const float* local_code_in,
+    float* shifts_chips)
+{
+    d_extra_local_code_in = local_code_in;
+    d_extra_shifts_chips = shifts_chips;
+    d_extra_code_length_chips = code_length_chips;
+    d_replica_table_valid = false;
+
+    return true;
+}
 
+
+bool cpu_multicorrelator_real_codes::set_active_correlators(int first_correlator, int n_active_correlators)
+{
+    if (first_correlator < 0 or n_active_correlators < 1 or first_correlator + n_active_correlators > d_n_correlators)
+        {
+            return false;
+        }
+    d_first_active_correlator = first_correlator;
+    d_n_active_correlators = n_active_correlators;
     return true;
 }
 
 
-bool cpu_multicorrelator_real_codes::set_input_output_vectors(std::complex<float>* corr_out, const std::complex<float>* sig_in)
+bool cpu_multicorrelator_real_codes::set_input_output_vectors(std::complex<float>* corr_out, const std::complex<float>* sig_in, std::complex<float>* extra_corr_out)
 {
     // Save CPU pointers
     d_sig_in = sig_in;
     d_corr_out = corr_out;
+    d_extra_corr_out = extra_corr_out;
     return true;
 }
 
 
 void cpu_multicorrelator_real_codes::update_local_code(int correlator_length_samples, float rem_code_phase_chips, float code_phase_step_chips, float code_phase_rate_step_chips)
 {
+    if (d_n_replica_phases > 0 and !d_use_high_dynamics_resampler)
+        {
+            if (select_replicas(correlator_length_samples, rem_code_phase_chips, code_phase_step_chips))
+                {
+                    return;
+                }
+        }
+    d_local_codes = d_local_codes_resampled;
     if (d_use_high_dynamics_resampler)
         {
-            volk_gnsssdr_32f_xn_high_dynamics_resampler_32f_xn(d_local_codes_resampled,
+            volk_gnsssdr_32f_xn_high_dynamics_resampler_32f_xn(d_local_codes_resampled + d_first_active_correlator,
                 d_local_code_in,
                 rem_code_phase_chips,
                 code_phase_step_chips,
                 code_phase_rate_step_chips,
-                d_shifts_chips,
+                d_shifts_chips + d_first_active_correlator,
                 d_code_length_chips,
-                d_n_correlators,
+                d_n_active_correlators,
                 correlator_length_samples);
+            if (d_n_extra_correlators > 0)
+                {
+                    volk_gnsssdr_32f_xn_high_dynamics_resampler_32f_xn(d_local_codes_resampled + d_n_correlators,
+                        d_extra_local_code_in,
+                        rem_code_phase_chips,
+                        code_phase_step_chips,
+                        code_phase_rate_step_chips,
+                        d_extra_shifts_chips,
+                        d_extra_code_length_chips,
+                        d_n_extra_correlators,
+                        correlator_length_samples);
+                }
         }
     else
         {
-            volk_gnsssdr_32f_xn_resampler_32f_xn(d_local_codes_resampled,
+            volk_gnsssdr_32f_xn_resampler_32f_xn(d_local_codes_resampled + d_first_active_correlator,
+                d_local_code_in,
+                rem_code_phase_chips,
+                code_phase_step_chips,
+                d_shifts_chips + d_first_active_correlator,
+                d_code_length_chips,
+                d_n_active_correlators,
+                correlator_length_samples);
+            if (d_n_extra_correlators > 0)
+                {
+                    volk_gnsssdr_32f_xn_resampler_32f_xn(d_local_codes_resampled + d_n_correlators,
+                        d_extra_local_code_in,
+                        rem_code_phase_chips,
+                        code_phase_step_chips,
+                        d_extra_shifts_chips,
+                        d_extra_code_length_chips,
+                        d_n_extra_correlators,
+                        correlator_length_samples);
+                }
+        }
+}
+
+
+// Points d_local_codes to the precomputed replicas closest to the requested code phase.
+// The table is built for a given code rate, and it is rebuilt when the code rate drifts by more
+// than one code phase step over the correlation length, but only once the new code rate has
+// remained within that tolerance for n_code_phases calls (e.g. not during the DLL pull-in).
+// Returns false if the local codes must be resampled instead.
+bool cpu_multicorrelator_real_codes::select_replicas(int correlator_length_samples, float rem_code_phase_chips, float code_phase_step_chips)
+{
+    float tolerance_chips = code_phase_step_chips / static_cast<float>(d_n_replica_phases);
+    bool usable = d_replica_table_valid and correlator_length_samples <= d_replica_length_samples and
+                  std::abs(code_phase_step_chips - d_replica_code_phase_step_chips) * static_cast<float>(correlator_length_samples) <= tolerance_chips;
+    for (int n = 0; usable and n < d_n_correlators; n++)
+        {
+            usable = (d_shifts_chips[n] == d_replica_shifts_chips[n]);
+        }
+    for (int n = 0; usable and n < d_n_extra_correlators; n++)
+        {
+            usable = (d_extra_shifts_chips[n] == d_replica_shifts_chips[d_n_correlators + n]);
+        }
+    if (!usable)
+        {
+            if (std::abs(code_phase_step_chips - d_replica_candidate_step_chips) * static_cast<float>(correlator_length_samples) <= tolerance_chips)
+                {
+                    d_replica_stable_calls++;
+                }
+            else
+                {
+                    d_replica_candidate_step_chips = code_phase_step_chips;
+                    d_replica_stable_calls = 0;
+                }
+            if (d_replica_stable_calls < d_n_replica_phases)
+                {
+                    return false;
+                }
+            build_replica_table(correlator_length_samples, code_phase_step_chips);
+        }
+
+    int phase_index = static_cast<int>(std::floor(rem_code_phase_chips / d_replica_code_phase_step_chips * static_cast<float>(d_n_replica_phases)));
+    phase_index = std::min(std::max(phase_index, 0), d_n_replica_phases - 1);
+    int n_all_correlators = d_n_correlators + d_n_extra_correlators;
+    for (int n = 0; n < n_all_correlators; n++)
+        {
+            d_replica_codes[n] = d_replica_table + static_cast<size_t>(phase_index * n_all_correlators + n) * d_replica_stride;
+        }
+    d_local_codes = d_replica_codes.data();
+    return true;
+}
+
+
+void cpu_multicorrelator_real_codes::build_replica_table(int correlator_length_samples, float code_phase_step_chips)
+{
+    int n_all_correlators = d_n_correlators + d_n_extra_correlators;
+    // Some margin for the variations of the correlation length between calls
+    int length_samples = std::min(correlator_length_samples + correlator_length_samples / 16 + 1, d_max_signal_length_samples);
+    int row_alignment = static_cast<int>(volk_gnsssdr_get_alignment() / sizeof(float));
+    int stride = ((length_samples + row_alignment - 1) / row_alignment) * row_alignment;
+    size_t size = static_cast<size_t>(d_n_replica_phases * n_all_correlators) * stride * sizeof(float);
+    if (size > d_replica_table_size)
+        {
+            if (d_replica_table != nullptr)
+                {
+                    volk_gnsssdr_free(d_replica_table);
+                }
+            d_replica_table = static_cast<float*>(volk_gnsssdr_malloc(size, volk_gnsssdr_get_alignment()));
+            d_replica_table_size = size;
+        }
+
+    for (int k = 0; k < d_n_replica_phases; k++)
+        {
+            // Each replica is computed at the center of its code phase interval
+            float rem_code_phase_chips = (static_cast<float>(k) + 0.5F) * code_phase_step_chips / static_cast<float>(d_n_replica_phases);
+            for (int n = 0; n < n_all_correlators; n++)
+                {
+                    d_replica_codes[n] = d_replica_table + static_cast<size_t>(k * n_all_correlators + n) * stride;
+                }
+            volk_gnsssdr_32f_xn_resampler_32f_xn(d_replica_codes.data(),
                 d_local_code_in,
                 rem_code_phase_chips,
                 code_phase_step_chips,
                 d_shifts_chips,
                 d_code_length_chips,
                 d_n_correlators,
-                correlator_length_samples);
+                length_samples);
+            if (d_n_extra_correlators > 0)
+                {
+                    volk_gnsssdr_32f_xn_resampler_32f_xn(d_replica_codes.data() + d_n_correlators,
+                        d_extra_local_code_in,
+                        rem_code_phase_chips,
+                        code_phase_step_chips,
+                        d_extra_shifts_chips,
+                        d_extra_code_length_chips,
+                        d_n_extra_correlators,
+                        length_samples);
+                }
+        }
+
+    d_replica_shifts_chips.assign(d_shifts_chips, d_shifts_chips + d_n_correlators);
+    if (d_n_extra_correlators > 0)
+        {
+            d_replica_shifts_chips.insert(d_replica_shifts_chips.end(), d_extra_shifts_chips, d_extra_shifts_chips + d_n_extra_correlators);
         }
+    d_replica_code_phase_step_chips = code_phase_step_chips;
+    d_replica_length_samples = length_samples;
+    d_replica_stride = stride;
+    d_replica_table_valid = true;
 }
 
+
+// Points d_active_codes to the local codes of the active main taps, followed by the extra ones.
+// Returns the number of taps to be correlated
+int cpu_multicorrelator_real_codes::select_active_codes(int first_sample)
+{
+    for (int n = 0; n < d_n_active_correlators; n++)
+        {
+            d_active_codes[n] = d_local_codes[d_first_active_correlator + n] + first_sample;
+        }
+    for (int n = 0; n < d_n_extra_correlators; n++)
+        {
+            d_active_codes[d_n_active_correlators + n] = d_local_codes[d_n_correlators + n] + first_sample;
+        }
+    return d_n_active_correlators + d_n_extra_correlators;
+}
+
+
+// Copies the outputs of the active taps, as given by select_active_codes, to the output vectors
+void cpu_multicorrelator_real_codes::scatter_outputs(const std::complex<float>* all_corr_out)
+{
+    std::fill_n(d_corr_out, d_first_active_correlator, lv_cmake(0.0F, 0.0F));
+    std::copy(all_corr_out, all_corr_out + d_n_active_correlators, d_corr_out + d_first_active_correlator);
+    std::fill(d_corr_out + d_first_active_correlator + d_n_active_correlators, d_corr_out + d_n_correlators, lv_cmake(0.0F, 0.0F));
+    std::copy(all_corr_out + d_n_active_correlators, all_corr_out + d_n_active_correlators + d_n_extra_correlators, d_extra_corr_out);
+}
+
+
+// Carrier wipe-off and dot products of all the active taps (main and extra codes) in a single pass over the input
+void cpu_multicorrelator_real_codes::correlate(float rem_carrier_phase_in_rad, float phase_step_rad, float phase_rate_step_rad, int signal_length_samples, bool high_dynamics)
+{
+    // Regenerate phase at each call in order to avoid numerical issues
+    lv_32fc_t phase_offset_as_complex[1];
+    phase_offset_as_complex[0] = lv_cmake(std::cos(rem_carrier_phase_in_rad), -std::sin(rem_carrier_phase_in_rad));
+    int n_active_correlators = select_active_codes(0);
+    bool direct_output = (d_n_active_correlators == d_n_correlators and d_n_extra_correlators == 0);
+    std::complex<float>* corr_out = (direct_output ? d_corr_out : d_all_corr_out);
+    // call VOLK_GNSSSDR kernel
+    if (high_dynamics)
+        {
+            volk_gnsssdr_32fc_32f_high_dynamic_rotator_dot_prod_32fc_xn(corr_out, d_sig_in, std::exp(lv_32fc_t(0.0, -phase_step_rad)), std::exp(lv_32fc_t(0.0, -phase_rate_step_rad)), phase_offset_as_complex, d_active_codes.data(), n_active_correlators, signal_length_samples);
+        }
+    else
+        {
+            volk_gnsssdr_32fc_32f_rotator_dot_prod_32fc_xn(corr_out, d_sig_in, std::exp(lv_32fc_t(0.0, -phase_step_rad)), phase_offset_as_complex, d_active_codes.data(), n_active_correlators, signal_length_samples);
+        }
+    if (!direct_output)
+        {
+            scatter_outputs(d_all_corr_out);
+        }
+}
+
+
 // Overload Carrier_wipeoff_multicorrelator_resampler to ensure back compatibility
 bool cpu_multicorrelator_real_codes::Carrier_wipeoff_multicorrelator_resampler(
     float rem_carrier_phase_in_rad,
@@ -136,18 +421,7 @@ bool cpu_multicorrelator_real_codes::Carrier_wipeoff_multicorrelator_resampler(
     int signal_length_samples)
 {
     update_local_code(signal_length_samples, rem_code_phase_chips, code_phase_step_chips, code_phase_rate_step_chips);
-    // Regenerate phase at each call in order to avoid numerical issues
-    lv_32fc_t phase_offset_as_complex[1];
-    phase_offset_as_complex[0] = lv_cmake(std::cos(rem_carrier_phase_in_rad), -std::sin(rem_carrier_phase_in_rad));
-    // call VOLK_GNSSSDR kernel
-    if (d_use_high_dynamics_resampler)
-        {
-            volk_gnsssdr_32fc_32f_high_dynamic_rotator_dot_prod_32fc_xn(d_corr_out, d_sig_in, std::exp(lv_32fc_t(0.0, -phase_step_rad)), std::exp(lv_32fc_t(0.0, -phase_rate_step_rad)), phase_offset_as_complex, const_cast<const float**>(d_local_codes_resampled), d_n_correlators, signal_length_samples);
-        }
-    else
-        {
-            volk_gnsssdr_32fc_32f_rotator_dot_prod_32fc_xn(d_corr_out, d_sig_in, std::exp(lv_32fc_t(0.0, -phase_step_rad)), phase_offset_as_complex, const_cast<const float**>(d_local_codes_resampled), d_n_correlators, signal_length_samples);
-        }
+    correlate(rem_carrier_phase_in_rad, phase_step_rad, phase_rate_step_rad, signal_length_samples, d_use_high_dynamics_resampler);
     return true;
 }
 // Overload Carrier_wipeoff_multicorrelator_resampler to ensure back compatibility
@@ -160,27 +434,103 @@ bool cpu_multicorrelator_real_codes::Carrier_wipeoff_multicorrelator_resampler(
     int signal_length_samples)
 {
     update_local_code(signal_length_samples, rem_code_phase_chips, code_phase_step_chips, code_phase_rate_step_chips);
-    // Regenerate phase at each call in order to avoid numerical issues
-    lv_32fc_t phase_offset_as_complex[1];
-    phase_offset_as_complex[0] = lv_cmake(std::cos(rem_carrier_phase_in_rad), -std::sin(rem_carrier_phase_in_rad));
-    // call VOLK_GNSSSDR kernel
-    volk_gnsssdr_32fc_32f_rotator_dot_prod_32fc_xn(d_corr_out, d_sig_in, std::exp(lv_32fc_t(0.0, -phase_step_rad)), phase_offset_as_complex, const_cast<const float**>(d_local_codes_resampled), d_n_correlators, signal_length_samples);
+    correlate(rem_carrier_phase_in_rad, phase_step_rad, 0.0, signal_length_samples, false);
     return true;
 }
 
 
+void cpu_multicorrelator_real_codes::start_batch_correlation(
+    float rem_carrier_phase_in_rad,
+    float phase_step_rad,
+    float phase_rate_step_rad,
+    float rem_code_phase_chips,
+    float code_phase_step_chips,
+    float code_phase_rate_step_chips,
+    int signal_length_samples)
+{
+    update_local_code(signal_length_samples, rem_code_phase_chips, code_phase_step_chips, code_phase_rate_step_chips);
+    d_batch_phase = lv_cmake(std::cos(rem_carrier_phase_in_rad), -std::sin(rem_carrier_phase_in_rad));
+    d_batch_phase_step_rad = phase_step_rad;
+    d_batch_phase_rate_step_rad = d_use_high_dynamics_resampler ? phase_rate_step_rad : 0.0F;
+    d_batch_length_samples = signal_length_samples;
+    for (int n = 0; n < d_n_correlators; n++)
+        {
+            d_corr_out[n] = lv_cmake(0.0F, 0.0F);
+        }
+    for (int n = 0; n < d_n_extra_correlators; n++)
+        {
+            d_extra_corr_out[n] = lv_cmake(0.0F, 0.0F);
+        }
+}
+
+
+void cpu_multicorrelator_real_codes::batch_correlation_chunk(int first_sample, int n_samples)
+{
+    if (n_samples <= 0)
+        {
+            return;
+        }
+    int n_active_correlators = select_active_codes(first_sample);
+    // The carrier NCO phase is carried over from the previous chunk by the kernel,
+    // while its frequency at the first sample of the chunk is computed here
+    float chunk_phase_step_rad = d_batch_phase_step_rad + static_cast<float>(first_sample) * d_batch_phase_rate_step_rad;
+    if (d_use_high_dynamics_resampler)
+        {
+            volk_gnsssdr_32fc_32f_high_dynamic_rotator_dot_prod_32fc_xn(d_batch_partial_out, d_sig_in + first_sample, std::exp(lv_32fc_t(0.0, -chunk_phase_step_rad)), std::exp(lv_32fc_t(0.0, -d_batch_phase_rate_step_rad)), &d_batch_phase, d_active_codes.data(), n_active_correlators, n_samples);
+        }
+    else
+        {
+            volk_gnsssdr_32fc_32f_rotator_dot_prod_32fc_xn(d_batch_partial_out, d_sig_in + first_sample, std::exp(lv_32fc_t(0.0, -chunk_phase_step_rad)), &d_batch_phase, d_active_codes.data(), n_active_correlators, n_samples);
+        }
+    for (int n = 0; n < d_n_active_correlators; n++)
+        {
+            d_corr_out[d_first_active_correlator + n] += d_batch_partial_out[n];
+        }
+    for (int n = 0; n < d_n_extra_correlators; n++)
+        {
+            d_extra_corr_out[n] += d_batch_partial_out[d_n_active_correlators + n];
+        }
+}
+
+
+size_t cpu_multicorrelator_real_codes::allocated_bytes() const
+{
+    if ((d_local_codes_resampled == nullptr) or d_in_arena)
+        {
+            return d_replica_table_size;
+        }
+    auto n_all_correlators = static_cast<size_t>(d_n_correlators + d_n_extra_correlators);
+    size_t bytes = n_all_correlators * (sizeof(float*) + d_max_signal_length_samples * sizeof(float));
+    bytes += 2 * n_all_correlators * sizeof(std::complex<float>);
+    return bytes + d_replica_table_size;
+}
+
+
 bool cpu_multicorrelator_real_codes::free()
 {
     // Free memory
-    if (d_local_codes_resampled != nullptr)
+    if ((d_local_codes_resampled != nullptr) and !d_in_arena)
         {
-            for (int n = 0; n < d_n_correlators; n++)
+            for (int n = 0; n < d_n_correlators + d_n_extra_correlators; n++)
                 {
                     volk_gnsssdr_free(d_local_codes_resampled[n]);
                 }
             volk_gnsssdr_free(d_local_codes_resampled);
-            d_local_codes_resampled = nullptr;
+            volk_gnsssdr_free(d_all_corr_out);
+            volk_gnsssdr_free(d_batch_partial_out);
+        }
+    // the arena releases its arrays by itself
+    d_local_codes_resampled = nullptr;
+    d_all_corr_out = nullptr;
+    d_batch_partial_out = nullptr;
+    d_in_arena = false;
+    if (d_replica_table != nullptr)
+        {
+            volk_gnsssdr_free(d_replica_table);
+            d_replica_table = nullptr;
+            d_replica_table_size = 0;
         }
+    d_replica_table_valid = false;
     return true;
 }
 
@@ -190,3 +540,11 @@ void cpu_multicorrelator_real_codes::set_high_dynamics_resampler(
 {
     d_use_high_dynamics_resampler = use_high_dynamics_resampler;
 }
+
+
+void cpu_multicorrelator_real_codes::set_replica_table(int n_code_phases)
+{
+    d_n_replica_phases = std::max(n_code_phases, 0);
+    d_replica_table_valid = false;
+    d_replica_stable_calls = 0;
+}
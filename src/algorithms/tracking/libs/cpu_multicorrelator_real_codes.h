@@ -38,6 +38,10 @@
 
 
 #include <complex>
+#include <cstddef>
+#include <vector>
+
+class Gnss_Arena;
 
 /*!
  * \brief Class that implements carrier wipe-off and correlators.
@@ -47,26 +51,80 @@ class cpu_multicorrelator_real_codes
 public:
     cpu_multicorrelator_real_codes();
     void set_high_dynamics_resampler(bool use_high_dynamics_resampler);
+    // Picks the local codes from a table of replicas precomputed at n_code_phases sub-sample code phases, instead of resampling them at every call (0 disables it)
+    void set_replica_table(int n_code_phases);
     ~cpu_multicorrelator_real_codes();
-    bool init(int max_signal_length_samples, int n_correlators);
+    // n_extra_correlators taps are computed on a second local code (e.g. the data component when tracking the pilot)
+    // With an arena, the working arrays are taken from it (called once while sizing it, and again once allocated)
+    bool init(int max_signal_length_samples, int n_correlators, int n_extra_correlators = 0, Gnss_Arena *arena = nullptr);
     bool set_local_code_and_taps(int code_length_chips, const float *local_code_in, float *shifts_chips);
-    bool set_input_output_vectors(std::complex<float> *corr_out, const std::complex<float> *sig_in);
+    bool set_extra_local_code_and_taps(int code_length_chips, const float *local_code_in, float *shifts_chips);
+    // Computes only n_active_correlators of the main taps, from first_correlator on (e.g. E-P-L out of VE-E-P-L-VL). The outputs of the rest of taps are zero
+    bool set_active_correlators(int first_correlator, int n_active_correlators);
+    bool set_input_output_vectors(std::complex<float> *corr_out, const std::complex<float> *sig_in, std::complex<float> *extra_corr_out = nullptr);
     void update_local_code(int correlator_length_samples, float rem_code_phase_chips, float code_phase_step_chips, float code_phase_rate_step_chips = 0.0);
     // Overload Carrier_wipeoff_multicorrelator_resampler to ensure back compatibility
     bool Carrier_wipeoff_multicorrelator_resampler(float rem_carrier_phase_in_rad, float phase_step_rad, float phase_rate_step_rad, float rem_code_phase_chips, float code_phase_step_chips, float code_phase_rate_step_chips, int signal_length_samples);
     bool Carrier_wipeoff_multicorrelator_resampler(float rem_carrier_phase_in_rad, float phase_step_rad, float rem_code_phase_chips, float code_phase_step_chips, float code_phase_rate_step_chips, int signal_length_samples);
+    // Piecewise version of Carrier_wipeoff_multicorrelator_resampler, used by cpu_multicorrelator_batch
+    void start_batch_correlation(float rem_carrier_phase_in_rad, float phase_step_rad, float phase_rate_step_rad, float rem_code_phase_chips, float code_phase_step_chips, float code_phase_rate_step_chips, int signal_length_samples);
+    void batch_correlation_chunk(int first_sample, int n_samples);
+    inline const std::complex<float> *input_vector() const
+    {
+        return d_sig_in;
+    }
+    inline int batch_length_samples() const
+    {
+        return d_batch_length_samples;
+    }
+    size_t allocated_bytes() const;  // local codes, replica table and correlator outputs, except those in an arena
     bool free();
 
 private:
+    void correlate(float rem_carrier_phase_in_rad, float phase_step_rad, float phase_rate_step_rad, int signal_length_samples, bool high_dynamics);
+    bool select_replicas(int correlator_length_samples, float rem_code_phase_chips, float code_phase_step_chips);
+    void build_replica_table(int correlator_length_samples, float code_phase_step_chips);
+    int select_active_codes(int first_sample);
+    void scatter_outputs(const std::complex<float> *all_corr_out);
+
     // Allocate the device input vectors
     const std::complex<float> *d_sig_in;
     float **d_local_codes_resampled;
+    bool d_in_arena;  // d_local_codes_resampled, d_all_corr_out and d_batch_partial_out belong to an arena
     const float *d_local_code_in;
+    float **d_local_codes;  // either d_local_codes_resampled or d_replica_codes.data()
+
     std::complex<float> *d_corr_out;
+    std::complex<float> *d_extra_corr_out;
+    std::complex<float> *d_all_corr_out;  // outputs of the main and extra taps, if any
+    const float *d_extra_local_code_in;
+    float *d_extra_shifts_chips;
+    int d_extra_code_length_chips;
+    int d_n_extra_correlators;
+    std::complex<float> *d_batch_partial_out;  // correlation of a single chunk
+    std::vector<const float *> d_active_codes;  // local codes of the active taps, from the first sample of the chunk
+    std::complex<float> d_batch_phase;         // carrier NCO state between chunks
+    float d_batch_phase_step_rad;
+    float d_batch_phase_rate_step_rad;
+    int d_batch_length_samples;
+    float *d_replica_table;  // n_code_phases x taps replicas, each one d_replica_stride samples long
+    size_t d_replica_table_size;
+    std::vector<float *> d_replica_codes;       // replicas selected for the current call
+    std::vector<float> d_replica_shifts_chips;  // taps used to build the table
+    int d_n_replica_phases;
+    int d_replica_length_samples;
+    int d_replica_stride;
+    float d_replica_code_phase_step_chips;  // code rate used to build the table
+    float d_replica_candidate_step_chips;
+    int d_replica_stable_calls;
+    bool d_replica_table_valid;
+    int d_max_signal_length_samples;
     float *d_shifts_chips;
     bool d_use_high_dynamics_resampler;
     int d_code_length_chips;
     int d_n_correlators;
+    int d_first_active_correlator;
+    int d_n_active_correlators;
 };
 
 
@@ -0,0 +1,247 @@
+/*!
+ * \file cpu_multicorrelator_real_codes_16sc.cc
+ * \brief CPU vector multiTAP correlator class for 16-bit integer complex
+ * input samples, using real-valued local codes
+ *
+ * -------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2018  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *          Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------
+ */
+
+#include "cpu_multicorrelator_real_codes_16sc.h"
+#include "gnss_arena.h"
+#include <algorithm>
+#include <cmath>
+
+
+cpu_multicorrelator_real_codes_16sc::cpu_multicorrelator_real_codes_16sc()
+{
+    d_sig_in = nullptr;
+    d_local_codes_resampled = nullptr;
+    d_in_arena = false;
+    d_block_corr_out = nullptr;
+    d_corr_out = nullptr;
+    d_extra_corr_out = nullptr;
+    d_shifts_chips = nullptr;
+    d_extra_shifts_chips = nullptr;
+    d_max_signal_length_samples = 0;
+    d_n_correlators = 0;
+    d_n_extra_correlators = 0;
+}
+
+
+cpu_multicorrelator_real_codes_16sc::~cpu_multicorrelator_real_codes_16sc()
+{
+    if (d_local_codes_resampled != nullptr)
+        {
+            cpu_multicorrelator_real_codes_16sc::free();
+        }
+}
+
+
+bool cpu_multicorrelator_real_codes_16sc::init(
+    int max_signal_length_samples,
+    int n_correlators,
+    int n_extra_correlators,
+    Gnss_Arena* arena)
+{
+    // ALLOCATE MEMORY FOR INTERNAL vectors
+    size_t size = max_signal_length_samples * sizeof(int16_t);
+    int n_all_correlators = n_correlators + n_extra_correlators;
+
+    if (arena != nullptr)
+        {
+            // in the order they are used by each correlation
+            auto** local_codes_resampled = arena->take<int16_t*>(n_all_correlators);
+            for (int n = 0; n < n_all_correlators; n++)
+                {
+                    int16_t* local_code = arena->take<int16_t>(max_signal_length_samples);
+                    if (local_codes_resampled != nullptr)
+                        {
+                            local_codes_resampled[n] = local_code;
+                        }
+                }
+            auto* block_corr_out = arena->take<lv_16sc_t>(n_all_correlators);
+            if (!arena->allocated())
+                {
+                    // sizing the arena
+                    return true;
+                }
+            d_local_codes_resampled = local_codes_resampled;
+            d_block_corr_out = block_corr_out;
+            d_in_arena = true;
+        }
+    else
+        {
+            d_local_codes_resampled = static_cast<int16_t**>(volk_gnsssdr_malloc(n_all_correlators * sizeof(int16_t*), volk_gnsssdr_get_alignment()));
+            for (int n = 0; n < n_all_correlators; n++)
+                {
+                    d_local_codes_resampled[n] = static_cast<int16_t*>(volk_gnsssdr_malloc(size, volk_gnsssdr_get_alignment()));
+                }
+            d_block_corr_out = static_cast<lv_16sc_t*>(volk_gnsssdr_malloc(n_all_correlators * sizeof(lv_16sc_t), volk_gnsssdr_get_alignment()));
+            d_in_arena = false;
+        }
+    d_block_codes.resize(n_all_correlators);
+    d_max_signal_length_samples = max_signal_length_samples;
+    d_n_correlators = n_correlators;
+    d_n_extra_correlators = n_extra_correlators;
+    return true;
+}
+
+
+bool cpu_multicorrelator_real_codes_16sc::set_local_code_and_taps(
+    int code_length_chips,
+    const float* local_code_in,
+    float* shifts_chips)
+{
+    d_local_code.resize(code_length_chips);
+    for (int i = 0; i < code_length_chips; i++)
+        {
+            d_local_code[i] = static_cast<int16_t>(std::round(local_code_in[i]));
+        }
+    d_shifts_chips = shifts_chips;
+    return true;
+}
+
+
+bool cpu_multicorrelator_real_codes_16sc::set_extra_local_code_and_taps(
+    int code_length_chips,
+    const float* local_code_in,
+    float* shifts_chips)
+{
+    d_extra_local_code.resize(code_length_chips);
+    for (int i = 0; i < code_length_chips; i++)
+        {
+            d_extra_local_code[i] = static_cast<int16_t>(std::round(local_code_in[i]));
+        }
+    d_extra_shifts_chips = shifts_chips;
+    return true;
+}
+
+
+bool cpu_multicorrelator_real_codes_16sc::set_input_output_vectors(std::complex<float>* corr_out, const lv_16sc_t* sig_in, std::complex<float>* extra_corr_out)
+{
+    // Save CPU pointers
+    d_sig_in = sig_in;
+    d_corr_out = corr_out;
+    d_extra_corr_out = extra_corr_out;
+    return true;
+}
+
+
+void cpu_multicorrelator_real_codes_16sc::update_local_code(int correlator_length_samples, float rem_code_phase_chips, float code_phase_step_chips)
+{
+    volk_gnsssdr_16i_xn_resampler_16i_xn(d_local_codes_resampled,
+        d_local_code.data(),
+        rem_code_phase_chips,
+        code_phase_step_chips,
+        d_shifts_chips,
+        d_local_code.size(),
+        d_n_correlators,
+        correlator_length_samples);
+    if (d_n_extra_correlators > 0)
+        {
+            volk_gnsssdr_16i_xn_resampler_16i_xn(d_local_codes_resampled + d_n_correlators,
+                d_extra_local_code.data(),
+                rem_code_phase_chips,
+                code_phase_step_chips,
+                d_extra_shifts_chips,
+                d_extra_local_code.size(),
+                d_n_extra_correlators,
+                correlator_length_samples);
+        }
+}
+
+
+bool cpu_multicorrelator_real_codes_16sc::Carrier_wipeoff_multicorrelator_resampler(
+    float rem_carrier_phase_in_rad,
+    float phase_step_rad,
+    float phase_rate_step_rad,
+    float rem_code_phase_chips,
+    float code_phase_step_chips,
+    float code_phase_rate_step_chips __attribute__((unused)),
+    int signal_length_samples)
+{
+    update_local_code(signal_length_samples, rem_code_phase_chips, code_phase_step_chips);
+    // Regenerate phase at each call in order to avoid numerical issues
+    lv_32fc_t phase = lv_cmake(std::cos(rem_carrier_phase_in_rad), -std::sin(rem_carrier_phase_in_rad));
+    int n_all_correlators = d_n_correlators + d_n_extra_correlators;
+    std::fill_n(d_corr_out, d_n_correlators, std::complex<float>(0.0, 0.0));
+    if (d_n_extra_correlators > 0)
+        {
+            std::fill_n(d_extra_corr_out, d_n_extra_correlators, std::complex<float>(0.0, 0.0));
+        }
+    for (int first_sample = 0; first_sample < signal_length_samples; first_sample += BLOCK_SAMPLES)
+        {
+            int n_samples = std::min(BLOCK_SAMPLES, signal_length_samples - first_sample);
+            for (int n = 0; n < n_all_correlators; n++)
+                {
+                    d_block_codes[n] = d_local_codes_resampled[n] + first_sample;
+                }
+            // Carrier frequency at the middle of the block. The kernel carries the phase over to the next block
+            float block_phase_step_rad = phase_step_rad + phase_rate_step_rad * (static_cast<float>(first_sample) + static_cast<float>(n_samples) / 2.0F);
+            // call VOLK_GNSSSDR kernel
+            volk_gnsssdr_16ic_16i_rotator_dot_prod_16ic_xn(d_block_corr_out, d_sig_in + first_sample, std::exp(lv_32fc_t(0.0, -block_phase_step_rad)), &phase, d_block_codes.data(), n_all_correlators, n_samples);
+            for (int n = 0; n < d_n_correlators; n++)
+                {
+                    d_corr_out[n] += std::complex<float>(static_cast<float>(d_block_corr_out[n].real()), static_cast<float>(d_block_corr_out[n].imag()));
+                }
+            for (int n = 0; n < d_n_extra_correlators; n++)
+                {
+                    const lv_16sc_t& out = d_block_corr_out[d_n_correlators + n];
+                    d_extra_corr_out[n] += std::complex<float>(static_cast<float>(out.real()), static_cast<float>(out.imag()));
+                }
+        }
+    return true;
+}
+
+
+size_t cpu_multicorrelator_real_codes_16sc::allocated_bytes() const
+{
+    if ((d_local_codes_resampled == nullptr) or d_in_arena)
+        {
+            return 0;
+        }
+    auto n_all_correlators = static_cast<size_t>(d_n_correlators + d_n_extra_correlators);
+    return n_all_correlators * (sizeof(int16_t*) + d_max_signal_length_samples * sizeof(int16_t) + sizeof(lv_16sc_t));
+}
+
+
+bool cpu_multicorrelator_real_codes_16sc::free()
+{
+    // Free memory
+    if ((d_local_codes_resampled != nullptr) and !d_in_arena)
+        {
+            for (int n = 0; n < d_n_correlators + d_n_extra_correlators; n++)
+                {
+                    volk_gnsssdr_free(d_local_codes_resampled[n]);
+                }
+            volk_gnsssdr_free(d_local_codes_resampled);
+            volk_gnsssdr_free(d_block_corr_out);
+        }
+    // the arena releases its arrays by itself
+    d_local_codes_resampled = nullptr;
+    d_block_corr_out = nullptr;
+    d_in_arena = false;
+    return true;
+}
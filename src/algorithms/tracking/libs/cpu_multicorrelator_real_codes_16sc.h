@@ -0,0 +1,92 @@
+/*!
+ * \file cpu_multicorrelator_real_codes_16sc.h
+ * \brief CPU vector multiTAP correlator class for 16-bit integer complex
+ * input samples, using real-valued local codes
+ *
+ * Class that performs the carrier wipe-off and correlations of 16-bit
+ * integer complex samples, so tracking channels can work with cshort
+ * input without converting it to floating point.
+ *
+ * -------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2018  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *          Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_CPU_MULTICORRELATOR_REAL_CODES_16SC_H_
+#define GNSS_SDR_CPU_MULTICORRELATOR_REAL_CODES_16SC_H_
+
+#include <volk_gnsssdr/volk_gnsssdr.h>
+#include <complex>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+class Gnss_Arena;
+
+/*!
+ * \brief Class that implements carrier wipe-off and correlators for 16-bit integer complex samples.
+ *
+ * It has the same interface than cpu_multicorrelator_real_codes, but the
+ * input samples are lv_16sc_t. The local codes are converted to int16 when
+ * set, and the correlations are accumulated in floating point block by
+ * block to avoid the saturation of the int16 dot products. The carrier
+ * phase rate is applied piecewise, block by block, and the code phase rate
+ * is neglected within a correlation.
+ */
+class cpu_multicorrelator_real_codes_16sc
+{
+public:
+    cpu_multicorrelator_real_codes_16sc();
+    ~cpu_multicorrelator_real_codes_16sc();
+    // n_extra_correlators taps are computed on a second local code (e.g. the data component when tracking the pilot)
+    // With an arena, the working arrays are taken from it (called once while sizing it, and again once allocated)
+    bool init(int max_signal_length_samples, int n_correlators, int n_extra_correlators = 0, Gnss_Arena *arena = nullptr);
+    bool set_local_code_and_taps(int code_length_chips, const float *local_code_in, float *shifts_chips);
+    bool set_extra_local_code_and_taps(int code_length_chips, const float *local_code_in, float *shifts_chips);
+    bool set_input_output_vectors(std::complex<float> *corr_out, const lv_16sc_t *sig_in, std::complex<float> *extra_corr_out = nullptr);
+    void update_local_code(int correlator_length_samples, float rem_code_phase_chips, float code_phase_step_chips);
+    bool Carrier_wipeoff_multicorrelator_resampler(float rem_carrier_phase_in_rad, float phase_step_rad, float phase_rate_step_rad, float rem_code_phase_chips, float code_phase_step_chips, float code_phase_rate_step_chips, int signal_length_samples);
+    size_t allocated_bytes() const;  // resampled local codes and block outputs, unless they are in an arena
+    bool free();
+
+private:
+    static const int BLOCK_SAMPLES = 512;  // correlation length accumulated in int16
+
+    const lv_16sc_t *d_sig_in;
+    int16_t **d_local_codes_resampled;
+    bool d_in_arena;  // d_local_codes_resampled and d_block_corr_out belong to an arena
+    std::vector<int16_t> d_local_code;
+    std::vector<int16_t> d_extra_local_code;
+    std::vector<const int16_t *> d_block_codes;  // resampled local codes, from the first sample of the block
+    lv_16sc_t *d_block_corr_out;
+    std::complex<float> *d_corr_out;
+    std::complex<float> *d_extra_corr_out;
+    float *d_shifts_chips;
+    float *d_extra_shifts_chips;
+    int d_max_signal_length_samples;
+    int d_n_correlators;
+    int d_n_extra_correlators;
+};
+
+
+#endif
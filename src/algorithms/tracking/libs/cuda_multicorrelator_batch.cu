@@ -0,0 +1,534 @@
+/*!
+ * \file cuda_multicorrelator_batch.cu
+ * \brief Class that runs the correlations of all the tracking channels on a
+ * NVIDIA CUDA GPU, with a single kernel launch per batch.
+ *
+ * -------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2018  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *          Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------
+ */
+
+#include "cuda_multicorrelator_batch.h"
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <iostream>
+
+#define TRK_CUDA_THREADS_PER_BLOCK 256
+
+
+// Carrier wipe-off, local code resampling and correlation of the job blockIdx.x
+__global__ void trk_multicorrelator_kernel(const cuda_multicorrelator_batch::Job* jobs, const cuFloatComplex* input)
+{
+    __shared__ cuFloatComplex partial[TRK_CUDA_THREADS_PER_BLOCK];
+    __shared__ cuda_multicorrelator_batch::Job job;
+    // The jobs are in mapped host memory: read them only once
+    if (threadIdx.x == 0)
+        {
+            job = jobs[blockIdx.x];
+        }
+    __syncthreads();
+    const cuFloatComplex* in = input + job.input_offset;
+    int n_taps = job.n_correlators + job.n_extra_correlators;
+    cuFloatComplex acc[TRK_CUDA_MAX_CORRELATORS];
+    for (int k = 0; k < TRK_CUDA_MAX_CORRELATORS; k++)
+        {
+            acc[k] = make_cuFloatComplex(0.0f, 0.0f);
+        }
+    for (int n = threadIdx.x; n < job.length; n += blockDim.x)
+        {
+            // Keep only the fractional part of the phase (in cycles) before going to single precision
+            double dn = static_cast<double>(n);
+            double cycles = job.rem_carrier_phase_cycles + dn * job.phase_step_cycles + 0.5 * job.phase_rate_step_cycles * dn * dn;
+            cycles -= floor(cycles);
+            float s, c;
+            sincospif(-2.0f * static_cast<float>(cycles), &s, &c);
+            cuFloatComplex wiped = cuCmulf(in[n], make_cuFloatComplex(c, s));
+            // Same index computation as the VOLK_GNSSSDR resamplers
+            float fn = static_cast<float>(n);
+            float code_phase = job.code_phase_step_chips * fn + job.code_phase_rate_step_chips * fn * fn;
+            for (int k = 0; k < n_taps; k++)
+                {
+                    bool extra = (k >= job.n_correlators);
+                    int code_length = extra ? job.extra_code_length_chips : job.code_length_chips;
+                    int index = static_cast<int>(floorf(code_phase + job.shifts_chips[k] - job.rem_code_phase_chips)) % code_length;
+                    if (index < 0)
+                        {
+                            index += code_length;
+                        }
+                    float chip = extra ? job.extra_code[index] : job.code[index];
+                    acc[k].x += wiped.x * chip;
+                    acc[k].y += wiped.y * chip;
+                }
+        }
+    for (int k = 0; k < n_taps; k++)
+        {
+            partial[threadIdx.x] = acc[k];
+            __syncthreads();
+            for (uint32_t stride = blockDim.x / 2; stride > 0; stride >>= 1)
+                {
+                    if (threadIdx.x < stride)
+                        {
+                            partial[threadIdx.x] = cuCaddf(partial[threadIdx.x], partial[threadIdx.x + stride]);
+                        }
+                    __syncthreads();
+                }
+            if (threadIdx.x == 0)
+                {
+                    job.corr_out[k] = partial[0];
+                }
+            __syncthreads();
+        }
+}
+
+
+static bool cuda_check(cudaError_t error, const char* what)
+{
+    if (error != cudaSuccess)
+        {
+            std::cerr << "CUDA tracking: " << what << " failed: " << cudaGetErrorString(error) << std::endl;
+            return false;
+        }
+    return true;
+}
+
+
+std::shared_ptr<cuda_multicorrelator_batch> cuda_multicorrelator_batch::get_instance(uint32_t batch_window_us)
+{
+    static std::mutex registry_mutex;
+    static std::weak_ptr<cuda_multicorrelator_batch> registry;
+
+    std::lock_guard<std::mutex> lock(registry_mutex);
+    std::shared_ptr<cuda_multicorrelator_batch> engine = registry.lock();
+    if (!engine)
+        {
+            engine = std::make_shared<cuda_multicorrelator_batch>(batch_window_us);
+            registry = engine;
+        }
+    return engine;
+}
+
+
+cuda_multicorrelator_batch::cuda_multicorrelator_batch(uint32_t batch_window_us)
+{
+    d_batch_window_us = batch_window_us;
+    d_stop = false;
+    d_integrated = false;
+    d_staged_input = nullptr;
+    d_jobs = nullptr;
+    d_input = nullptr;
+    d_jobs_device = nullptr;
+    d_input_capacity = 0;
+    d_jobs_capacity = 0;
+    d_stream = nullptr;
+
+    int num_devices = 0;
+    d_ready = (cudaGetDeviceCount(&num_devices) == cudaSuccess) and (num_devices > 0);
+    if (d_ready)
+        {
+            // Mapped host memory must be enabled before the context is created.
+            // If another engine created it already, mapping is available anyway with unified addressing.
+            if (cudaSetDeviceFlags(cudaDeviceMapHost) != cudaSuccess)
+                {
+                    cudaGetLastError();
+                }
+            int device = 0;
+            cudaDeviceProp prop;
+            d_ready = cuda_check(cudaGetDevice(&device), "device query") and
+                      cuda_check(cudaGetDeviceProperties(&prop, device), "device query");
+            if (d_ready and !prop.canMapHostMemory)
+                {
+                    std::cerr << "CUDA tracking: the device cannot map host memory" << std::endl;
+                    d_ready = false;
+                }
+            d_integrated = d_ready and prop.integrated;
+        }
+    if (d_ready)
+        {
+            d_ready = cuda_check(cudaStreamCreateWithFlags(&d_stream, cudaStreamNonBlocking), "stream creation");
+        }
+    if (!d_ready)
+        {
+            std::cerr << "CUDA tracking: no CUDA device available, tracking will run on the CPU" << std::endl;
+            return;
+        }
+    d_thread = std::thread(&cuda_multicorrelator_batch::dispatcher, this);
+}
+
+
+cuda_multicorrelator_batch::~cuda_multicorrelator_batch()
+{
+    if (d_thread.joinable())
+        {
+            {
+                std::lock_guard<std::mutex> lock(d_mutex);
+                d_stop = true;
+            }
+            d_request_cond.notify_all();
+            d_thread.join();
+        }
+    for (auto& slot : d_slots)
+        {
+            if (slot.allocated)
+                {
+                    cudaFree(slot.code);
+                    cudaFree(slot.extra_code);
+                    cudaFreeHost(slot.corr_out);
+                }
+        }
+    cudaFreeHost(d_staged_input);
+    cudaFreeHost(d_jobs);
+    if (!d_integrated)
+        {
+            cudaFree(d_input);
+        }
+    if (d_stream != nullptr)
+        {
+            cudaStreamDestroy(d_stream);
+        }
+}
+
+
+int32_t cuda_multicorrelator_batch::add_channel(int n_correlators, int n_extra_correlators)
+{
+    if (!d_ready or (n_correlators <= 0) or (n_extra_correlators < 0) or (n_correlators + n_extra_correlators > TRK_CUDA_MAX_CORRELATORS))
+        {
+            return -1;
+        }
+    Channel_Slot slot;
+    slot.code = nullptr;
+    slot.extra_code = nullptr;
+    slot.code_length_chips = 0;
+    slot.extra_code_length_chips = 0;
+    slot.code_capacity = 0;
+    slot.extra_code_capacity = 0;
+    slot.shifts_chips = nullptr;
+    slot.extra_shifts_chips = nullptr;
+    slot.n_correlators = n_correlators;
+    slot.n_extra_correlators = n_extra_correlators;
+    slot.corr_out = nullptr;
+    slot.corr_out_device = nullptr;
+    slot.allocated = true;
+    slot.tracking = false;
+    if (!cuda_check(cudaHostAlloc(reinterpret_cast<void**>(&slot.corr_out), TRK_CUDA_MAX_CORRELATORS * sizeof(std::complex<float>), cudaHostAllocMapped), "output allocation") or
+        !cuda_check(cudaHostGetDevicePointer(reinterpret_cast<void**>(&slot.corr_out_device), slot.corr_out, 0), "output mapping"))
+        {
+            cudaFreeHost(slot.corr_out);
+            return -1;
+        }
+
+    std::lock_guard<std::mutex> lock(d_mutex);
+    for (uint32_t i = 0; i < d_slots.size(); i++)
+        {
+            if (!d_slots[i].allocated)
+                {
+                    d_slots[i] = slot;
+                    return static_cast<int32_t>(i);
+                }
+        }
+    d_slots.push_back(slot);
+    return static_cast<int32_t>(d_slots.size() - 1);
+}
+
+
+void cuda_multicorrelator_batch::remove_channel(int32_t slot)
+{
+    std::lock_guard<std::mutex> lock(d_mutex);
+    if ((slot < 0) or (slot >= static_cast<int32_t>(d_slots.size())) or !d_slots[slot].allocated)
+        {
+            return;
+        }
+    cudaFree(d_slots[slot].code);
+    cudaFree(d_slots[slot].extra_code);
+    cudaFreeHost(d_slots[slot].corr_out);
+    d_slots[slot].allocated = false;
+    d_slots[slot].tracking = false;
+    d_request_cond.notify_all();
+}
+
+
+void cuda_multicorrelator_batch::set_idle(int32_t slot)
+{
+    std::lock_guard<std::mutex> lock(d_mutex);
+    if ((slot >= 0) and (slot < static_cast<int32_t>(d_slots.size())))
+        {
+            d_slots[slot].tracking = false;
+            d_request_cond.notify_all();
+        }
+}
+
+
+bool cuda_multicorrelator_batch::upload_code(float*& code, int& capacity, int code_length_chips, const float* local_code_in)
+{
+    if (code_length_chips > capacity)
+        {
+            cudaFree(code);
+            code = nullptr;
+            capacity = 0;
+            if (!cuda_check(cudaMalloc(&code, code_length_chips * sizeof(float)), "code allocation"))
+                {
+                    return false;
+                }
+            capacity = code_length_chips;
+        }
+    return cuda_check(cudaMemcpy(code, local_code_in, code_length_chips * sizeof(float), cudaMemcpyHostToDevice), "code upload");
+}
+
+
+bool cuda_multicorrelator_batch::set_local_code_and_taps(int32_t slot, int code_length_chips, const float* local_code_in, const float* shifts_chips)
+{
+    std::lock_guard<std::mutex> lock(d_mutex);
+    if ((slot < 0) or (slot >= static_cast<int32_t>(d_slots.size())) or !d_slots[slot].allocated or (code_length_chips <= 0))
+        {
+            return false;
+        }
+    Channel_Slot& s = d_slots[slot];
+    s.shifts_chips = shifts_chips;
+    s.code_length_chips = code_length_chips;
+    return upload_code(s.code, s.code_capacity, code_length_chips, local_code_in);
+}
+
+
+bool cuda_multicorrelator_batch::set_extra_local_code_and_taps(int32_t slot, int code_length_chips, const float* local_code_in, const float* shifts_chips)
+{
+    std::lock_guard<std::mutex> lock(d_mutex);
+    if ((slot < 0) or (slot >= static_cast<int32_t>(d_slots.size())) or !d_slots[slot].allocated or (code_length_chips <= 0))
+        {
+            return false;
+        }
+    Channel_Slot& s = d_slots[slot];
+    s.extra_shifts_chips = shifts_chips;
+    s.extra_code_length_chips = code_length_chips;
+    return upload_code(s.extra_code, s.extra_code_capacity, code_length_chips, local_code_in);
+}
+
+
+bool cuda_multicorrelator_batch::correlate(int32_t slot, const std::complex<float>* sig_in,
+    float rem_carrier_phase_in_rad, float phase_step_rad, float phase_rate_step_rad,
+    float rem_code_phase_chips, float code_phase_step_chips, float code_phase_rate_step_chips,
+    int signal_length_samples, std::complex<float>* corr_out, std::complex<float>* extra_corr_out)
+{
+    const double TWO_PI = 6.283185307179586;
+    Request request;
+    request.slot = slot;
+    request.in = sig_in;
+    request.length = signal_length_samples;
+    request.corr_out = corr_out;
+    request.extra_corr_out = extra_corr_out;
+    request.done = false;
+    request.result = false;
+
+    Job& job = request.job;
+    job.length = signal_length_samples;
+    job.input_offset = 0;
+    job.rem_carrier_phase_cycles = static_cast<double>(rem_carrier_phase_in_rad) / TWO_PI;
+    job.phase_step_cycles = static_cast<double>(phase_step_rad) / TWO_PI;
+    job.phase_rate_step_cycles = static_cast<double>(phase_rate_step_rad) / TWO_PI;
+    job.rem_code_phase_chips = rem_code_phase_chips;
+    job.code_phase_step_chips = code_phase_step_chips;
+    job.code_phase_rate_step_chips = code_phase_rate_step_chips;
+
+    std::unique_lock<std::mutex> lock(d_mutex);
+    if (!d_ready or (slot < 0) or (slot >= static_cast<int32_t>(d_slots.size())) or (signal_length_samples <= 0))
+        {
+            return false;
+        }
+    Channel_Slot& s = d_slots[slot];
+    if (!s.allocated or (s.code == nullptr) or ((s.n_extra_correlators > 0) and (s.extra_code == nullptr)))
+        {
+            return false;
+        }
+    job.code = s.code;
+    job.extra_code = (s.n_extra_correlators > 0 ? s.extra_code : s.code);
+    job.corr_out = s.corr_out_device;
+    job.code_length_chips = s.code_length_chips;
+    job.extra_code_length_chips = (s.n_extra_correlators > 0 ? s.extra_code_length_chips : s.code_length_chips);
+    job.n_correlators = s.n_correlators;
+    job.n_extra_correlators = s.n_extra_correlators;
+    std::copy(s.shifts_chips, s.shifts_chips + s.n_correlators, job.shifts_chips);
+    if (s.n_extra_correlators > 0)
+        {
+            std::copy(s.extra_shifts_chips, s.extra_shifts_chips + s.n_extra_correlators, job.shifts_chips + s.n_correlators);
+        }
+    s.tracking = true;
+    d_pending.push_back(&request);
+    d_request_cond.notify_all();
+    d_done_cond.wait(lock, [&request] { return request.done; });
+    return request.result;
+}
+
+
+void cuda_multicorrelator_batch::dispatcher()
+{
+    std::unique_lock<std::mutex> lock(d_mutex);
+    while (!d_stop)
+        {
+            if (d_pending.empty())
+                {
+                    d_request_cond.wait(lock);
+                    continue;
+                }
+            // Give the rest of the channels in tracking the chance to join the batch
+            auto deadline = std::chrono::steady_clock::now() + std::chrono::microseconds(d_batch_window_us);
+            auto tracking_channels = [this]() { return static_cast<size_t>(std::count_if(d_slots.begin(), d_slots.end(), [](const Channel_Slot& s) { return s.allocated and s.tracking; })); };
+            while (!d_stop and (d_pending.size() < tracking_channels()))
+                {
+                    if (d_request_cond.wait_until(lock, deadline) == std::cv_status::timeout)
+                        {
+                            break;
+                        }
+                }
+            std::vector<Request*> batch;
+            batch.swap(d_pending);
+            lock.unlock();
+            bool result = run_batch(batch);
+            lock.lock();
+            for (auto* request : batch)
+                {
+                    request->result = result;
+                    request->done = true;
+                }
+            d_done_cond.notify_all();
+        }
+    // Nobody is going to process the requests left
+    for (auto* request : d_pending)
+        {
+            request->done = true;
+        }
+    d_pending.clear();
+    d_done_cond.notify_all();
+}
+
+
+bool cuda_multicorrelator_batch::reserve(size_t input_samples, size_t jobs)
+{
+    bool ok = true;
+    if (input_samples > d_input_capacity)
+        {
+            // Grow with some margin, since the pinned allocations are expensive
+            size_t capacity = std::max(input_samples, 2 * d_input_capacity);
+            cudaFreeHost(d_staged_input);
+            if (!d_integrated)
+                {
+                    cudaFree(d_input);
+                }
+            d_staged_input = nullptr;
+            d_input = nullptr;
+            d_input_capacity = 0;
+            ok = cuda_check(cudaHostAlloc(reinterpret_cast<void**>(&d_staged_input), capacity * sizeof(std::complex<float>), cudaHostAllocMapped), "input allocation");
+            if (ok and d_integrated)
+                {
+                    ok = cuda_check(cudaHostGetDevicePointer(reinterpret_cast<void**>(&d_input), d_staged_input, 0), "input mapping");
+                }
+            else if (ok)
+                {
+                    ok = cuda_check(cudaMalloc(&d_input, capacity * sizeof(cuFloatComplex)), "input allocation");
+                }
+            d_input_capacity = (ok ? capacity : 0);
+        }
+    if (ok and (jobs > d_jobs_capacity))
+        {
+            size_t capacity = std::max(jobs, 2 * d_jobs_capacity);
+            cudaFreeHost(d_jobs);
+            d_jobs = nullptr;
+            d_jobs_device = nullptr;
+            d_jobs_capacity = 0;
+            ok = cuda_check(cudaHostAlloc(reinterpret_cast<void**>(&d_jobs), capacity * sizeof(Job), cudaHostAllocMapped), "jobs allocation") and
+                 cuda_check(cudaHostGetDevicePointer(reinterpret_cast<void**>(&d_jobs_device), d_jobs, 0), "jobs mapping");
+            d_jobs_capacity = (ok ? capacity : 0);
+        }
+    return ok;
+}
+
+
+bool cuda_multicorrelator_batch::run_batch(const std::vector<Request*>& batch)
+{
+    // The channels read overlapping ranges of the same input buffer: each range is staged only once
+    std::vector<Request*> sorted(batch);
+    std::sort(sorted.begin(), sorted.end(), [](const Request* a, const Request* b) { return a->in < b->in; });
+    struct Range
+    {
+        const std::complex<float>* begin;
+        const std::complex<float>* end;
+        size_t staged_offset;
+    };
+    std::vector<Range> ranges;
+    size_t staged_samples = 0;
+    for (auto* request : sorted)
+        {
+            const std::complex<float>* end = request->in + request->length;
+            if (ranges.empty() or (request->in >= ranges.back().end))
+                {
+                    if (!ranges.empty())
+                        {
+                            staged_samples += ranges.back().end - ranges.back().begin;
+                        }
+                    ranges.push_back(Range{request->in, end, staged_samples});
+                }
+            else
+                {
+                    ranges.back().end = std::max(ranges.back().end, end);
+                }
+            request->job.input_offset = static_cast<uint32_t>(ranges.back().staged_offset + (request->in - ranges.back().begin));
+        }
+    staged_samples += ranges.back().end - ranges.back().begin;
+    if (!reserve(staged_samples, batch.size()))
+        {
+            return false;
+        }
+
+    bool ok = true;
+    for (const auto& range : ranges)
+        {
+            std::memcpy(d_staged_input + range.staged_offset, range.begin, (range.end - range.begin) * sizeof(std::complex<float>));
+        }
+    if (!d_integrated)
+        {
+            ok = cuda_check(cudaMemcpyAsync(d_input, d_staged_input, staged_samples * sizeof(std::complex<float>), cudaMemcpyHostToDevice, d_stream), "input upload");
+        }
+    for (size_t r = 0; r < batch.size(); r++)
+        {
+            d_jobs[r] = batch[r]->job;
+        }
+
+    // All the channels in a single launch, one thread block per channel
+    trk_multicorrelator_kernel<<<batch.size(), TRK_CUDA_THREADS_PER_BLOCK, 0, d_stream>>>(d_jobs_device, d_input);
+    ok = ok and cuda_check(cudaGetLastError(), "correlator launch") and
+         cuda_check(cudaStreamSynchronize(d_stream), "correlation");
+    if (!ok)
+        {
+            return false;
+        }
+
+    std::lock_guard<std::mutex> lock(d_mutex);
+    for (auto* request : batch)
+        {
+            const Channel_Slot& s = d_slots[request->slot];
+            std::copy(s.corr_out, s.corr_out + s.n_correlators, request->corr_out);
+            if ((s.n_extra_correlators > 0) and (request->extra_corr_out != nullptr))
+                {
+                    std::copy(s.corr_out + s.n_correlators, s.corr_out + s.n_correlators + s.n_extra_correlators, request->extra_corr_out);
+                }
+        }
+    return true;
+}
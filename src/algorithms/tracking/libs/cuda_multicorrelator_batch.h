@@ -0,0 +1,194 @@
+/*!
+ * \file cuda_multicorrelator_batch.h
+ * \brief Class that runs the correlations of all the tracking channels on a
+ * NVIDIA CUDA GPU, with a single kernel launch per batch.
+ *
+ * Every dll_pll_veml_tracking channel with use_cuda enabled submits its
+ * correlations here. Requests arriving within a short batching window are
+ * processed together: the input samples of the channels are staged once in
+ * pinned host memory, and one thread block per channel performs the carrier
+ * wipe-off, the local code resampling and all the correlator taps, writing
+ * the results straight into mapped (zero-copy) host memory.
+ *
+ * -------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2018  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *          Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_CUDA_MULTICORRELATOR_BATCH_H_
+#define GNSS_SDR_CUDA_MULTICORRELATOR_BATCH_H_
+
+#include <cuComplex.h>
+#include <cuda_runtime.h>
+#include <condition_variable>
+#include <complex>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#define TRK_CUDA_MAX_CORRELATORS 8
+
+
+/*!
+ * \brief Shared GPU back-end for the multicorrelators of the tracking channels.
+ *
+ * Each channel owns a slot holding its local codes in device memory and its
+ * correlator outputs in mapped host memory. correlate() blocks the calling
+ * channel until its request has been processed by the batch dispatcher
+ * thread. A batch is launched as soon as all the channels in tracking have
+ * submitted their requests, or when the batching window expires.
+ */
+class cuda_multicorrelator_batch
+{
+public:
+    /*!
+     * \brief Returns the engine shared by all the tracking channels. It is
+     * created on the first request, and released when the last channel using
+     * it is destroyed.
+     */
+    static std::shared_ptr<cuda_multicorrelator_batch> get_instance(uint32_t batch_window_us);
+
+    explicit cuda_multicorrelator_batch(uint32_t batch_window_us);
+    ~cuda_multicorrelator_batch();
+
+    /*!
+     * \brief Returns false if no CUDA device could be initialized.
+     */
+    inline bool ready() const
+    {
+        return d_ready;
+    }
+
+    /*!
+     * \brief Reserves a slot for a channel with \p n_correlators taps, plus
+     * \p n_extra_correlators taps on a second local code.
+     * \return the slot identifier, or -1 in case of failure.
+     */
+    int32_t add_channel(int n_correlators, int n_extra_correlators);
+
+    void remove_channel(int32_t slot);
+
+    /*!
+     * \brief Uploads the local code of a channel. As in the CPU
+     * multicorrelators, \p shifts_chips is read at every correlation.
+     */
+    bool set_local_code_and_taps(int32_t slot, int code_length_chips, const float* local_code_in, const float* shifts_chips);
+    bool set_extra_local_code_and_taps(int32_t slot, int code_length_chips, const float* local_code_in, const float* shifts_chips);
+
+    /*!
+     * \brief Correlates \p signal_length_samples samples of \p sig_in, with the
+     * same parameters as cpu_multicorrelator_real_codes. The rates are only
+     * applied if they are not zero.
+     */
+    bool correlate(int32_t slot, const std::complex<float>* sig_in,
+        float rem_carrier_phase_in_rad, float phase_step_rad, float phase_rate_step_rad,
+        float rem_code_phase_chips, float code_phase_step_chips, float code_phase_rate_step_chips,
+        int signal_length_samples, std::complex<float>* corr_out, std::complex<float>* extra_corr_out);
+
+    /*!
+     * \brief Tells the dispatcher not to wait for this channel until its next request.
+     */
+    void set_idle(int32_t slot);
+
+    struct Job
+    {
+        const float* code;
+        const float* extra_code;
+        cuFloatComplex* corr_out;  // device pointer to the mapped outputs of the slot
+        uint32_t input_offset;     // first sample in the staged input
+        int32_t length;
+        int32_t code_length_chips;
+        int32_t extra_code_length_chips;
+        int32_t n_correlators;
+        int32_t n_extra_correlators;
+        float shifts_chips[TRK_CUDA_MAX_CORRELATORS];
+        double rem_carrier_phase_cycles;
+        double phase_step_cycles;
+        double phase_rate_step_cycles;
+        float rem_code_phase_chips;
+        float code_phase_step_chips;
+        float code_phase_rate_step_chips;
+    };
+
+private:
+    struct Channel_Slot
+    {
+        float* code;        // local code, in device memory
+        float* extra_code;  // second local code, in device memory
+        int code_length_chips;
+        int extra_code_length_chips;
+        int code_capacity;
+        int extra_code_capacity;
+        const float* shifts_chips;
+        const float* extra_shifts_chips;
+        int n_correlators;
+        int n_extra_correlators;
+        std::complex<float>* corr_out;  // mapped host memory
+        cuFloatComplex* corr_out_device;
+        bool allocated;
+        bool tracking;
+    };
+
+    struct Request
+    {
+        int32_t slot;
+        const std::complex<float>* in;
+        int length;
+        Job job;
+        std::complex<float>* corr_out;
+        std::complex<float>* extra_corr_out;
+        bool done;
+        bool result;
+    };
+
+    void dispatcher();
+    bool run_batch(const std::vector<Request*>& batch);
+    bool reserve(size_t input_samples, size_t jobs);
+    bool upload_code(float*& code, int& capacity, int code_length_chips, const float* local_code_in);
+
+    uint32_t d_batch_window_us;
+    bool d_ready;
+    bool d_stop;
+    bool d_integrated;  // the GPU shares the host memory, so it reads the staged input in place
+
+    // Pinned host buffers, reused by all the batches
+    std::complex<float>* d_staged_input;
+    Job* d_jobs;
+    // Their device counterparts
+    cuFloatComplex* d_input;
+    Job* d_jobs_device;
+    size_t d_input_capacity;
+    size_t d_jobs_capacity;
+    cudaStream_t d_stream;
+
+    std::vector<Channel_Slot> d_slots;
+    std::vector<Request*> d_pending;
+    std::mutex d_mutex;
+    std::condition_variable d_request_cond;
+    std::condition_variable d_done_cond;
+    std::thread d_thread;
+};
+
+#endif
@@ -43,6 +43,8 @@ Dll_Pll_Conf::Dll_Pll_Conf()
     dump = false;
     dump_mat = true;
     dump_filename = std::string("./dll_pll_dump.dat");
+    dump_async = false;
+    dump_compress = false;
     pll_pull_in_bw_hz = 50.0;
     dll_pull_in_bw_hz = 3.0;
     pll_bw_hz = 35.0;
@@ -60,6 +62,16 @@ Dll_Pll_Conf::Dll_Pll_Conf()
     max_lock_fail = 50;
     carrier_lock_th = 0.85;
     track_pilot = false;
+    item_type = std::string("gr_complex");
+    batch_correlator = false;
+    batch_window_us = 50;
+    code_replica_phases = 0;
+    carrier_kf_order = 0;
+    max_epochs_per_call = 1;
+    adaptive_taps_cn0_db_hz = 0.0;
+    pre_decimation_factor = 1;
+    use_cuda = false;
+    cuda_batch_window_us = 200;
     system = 'G';
     char sig_[3] = "1C";
     std::memcpy(signal, sig_, 3);
@@ -33,6 +33,7 @@
 #ifndef GNSS_SDR_DLL_PLL_CONF_H_
 #define GNSS_SDR_DLL_PLL_CONF_H_
 
+#include "gnss_dump_policy.h"
 #include <cstdint>
 #include <string>
 
@@ -45,6 +46,9 @@ public:
     bool dump;
     bool dump_mat;
     std::string dump_filename;
+    bool dump_async;     // write the dumps from the receiver-wide dump writer thread
+    bool dump_compress;  // gzip the asynchronous dumps
+    Gnss_Dump_Policy_Conf dump_policy;
     float pll_pull_in_bw_hz;
     float dll_pull_in_bw_hz;
     float pll_bw_hz;
@@ -64,6 +68,16 @@ public:
     uint32_t smoother_length;
     double carrier_lock_th;
     bool track_pilot;
+    std::string item_type;  // gr_complex or cshort
+    bool batch_correlator;
+    int32_t batch_window_us;
+    int32_t code_replica_phases;    // 0: resample the local code at every epoch
+    int32_t carrier_kf_order;       // 0: 2nd order PLL filter, 2 or 3: Kalman filter of that order
+    bool use_cuda;                  // run the correlations on the CUDA GPU, batched with the rest of channels
+    uint32_t cuda_batch_window_us;  // time the GPU waits for the requests of other channels before running a batch
+    int32_t max_epochs_per_call;    // code periods tracked in each general_work call
+    float adaptive_taps_cn0_db_hz;  // VEML: only E-P-L above this C/N0 (0 disables it)
+    int32_t pre_decimation_factor;  // integrate-and-dump decimation applied upstream (fs_in is the decimated rate)
     char system;
     char signal[3]{};
 
@@ -65,4 +65,5 @@ Dll_Pll_Conf_Fpga::Dll_Pll_Conf_Fpga()
     code_samples_per_chip = 0U;
     ca_codes = nullptr;
     data_codes = nullptr;
+    pipeline_epochs = false;
 }
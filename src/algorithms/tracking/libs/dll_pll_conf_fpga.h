@@ -68,6 +68,7 @@ public:
     uint32_t code_samples_per_chip;
     int32_t* ca_codes;
     int32_t* data_codes;
+    bool pipeline_epochs;  // launch the next epoch at the end of each general_work call
 
     Dll_Pll_Conf_Fpga();
 };
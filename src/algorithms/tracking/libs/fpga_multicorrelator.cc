@@ -63,6 +63,7 @@
 // string manipulation
 #include <string>
 #include <utility>
+#include <vector>
 
 // constants
 #include "GPS_L1_CA.h"
@@ -112,6 +113,7 @@ void fpga_multicorrelator_8sc::set_local_code_and_taps(float *shifts_chips, floa
     d_prompt_data_shift = prompt_data_shift;
     //d_code_length_chips = code_length_chips;
     fpga_multicorrelator_8sc::fpga_configure_tracking_gps_local_code(PRN);
+    d_loaded_registers_valid = false;  // write all the NCO registers in the next epoch
 }
 
 void fpga_multicorrelator_8sc::set_output_vectors(gr_complex *corr_out, gr_complex *Prompt_Data)
@@ -133,6 +135,17 @@ void fpga_multicorrelator_8sc::Carrier_wipeoff_multicorrelator_resampler(
     float rem_carrier_phase_in_rad, float phase_step_rad,
     float rem_code_phase_chips, float code_phase_step_chips,
     int32_t signal_length_samples)
+{
+    launch_multicorrelator_resampler(rem_carrier_phase_in_rad, phase_step_rad,
+        rem_code_phase_chips, code_phase_step_chips, signal_length_samples);
+    read_multicorrelator_results();
+}
+
+
+void fpga_multicorrelator_8sc::launch_multicorrelator_resampler(
+    float rem_carrier_phase_in_rad, float phase_step_rad,
+    float rem_code_phase_chips, float code_phase_step_chips,
+    int32_t signal_length_samples)
 {
     update_local_code(rem_code_phase_chips);
     d_rem_carrier_phase_in_rad = rem_carrier_phase_in_rad;
@@ -142,6 +155,28 @@ void fpga_multicorrelator_8sc::Carrier_wipeoff_multicorrelator_resampler(
     fpga_multicorrelator_8sc::fpga_compute_signal_parameters_in_fpga();
     fpga_multicorrelator_8sc::fpga_configure_signal_parameters_in_fpga();
     fpga_multicorrelator_8sc::fpga_launch_multicorrelator_fpga();
+    d_epoch_pending = true;
+}
+
+
+void fpga_multicorrelator_8sc::read_multicorrelator_results()
+{
+    fpga_multicorrelator_8sc::wait_for_interrupt();
+    fpga_multicorrelator_8sc::read_tracking_gps_results();
+}
+
+
+void fpga_multicorrelator_8sc::discard_pending_epoch()
+{
+    if (d_epoch_pending)
+        {
+            fpga_multicorrelator_8sc::wait_for_interrupt();
+        }
+}
+
+
+void fpga_multicorrelator_8sc::wait_for_interrupt()
+{
     int32_t irq_count;
     ssize_t nb;
     //printf("$$$$$ waiting for interrupt ... \n");
@@ -152,9 +187,20 @@ void fpga_multicorrelator_8sc::Carrier_wipeoff_multicorrelator_resampler(
             printf("Tracking_module Read failed to retrieve 4 bytes!\n");
             printf("Tracking_module Interrupt number %d\n", irq_count);
         }
-    fpga_multicorrelator_8sc::read_tracking_gps_results();
+    d_epoch_pending = false;
 }
 
+
+void fpga_multicorrelator_8sc::write_register(uint32_t address, uint32_t value, uint32_t &loaded_value)
+{
+    if (!d_loaded_registers_valid or value != loaded_value)
+        {
+            d_map_base[address] = value;
+            loaded_value = value;
+        }
+}
+
+
 fpga_multicorrelator_8sc::fpga_multicorrelator_8sc(int32_t n_correlators,
     std::string device_name, uint32_t device_base, int32_t *ca_codes, int32_t *data_codes, uint32_t code_length_chips, bool track_pilot,
     uint32_t multicorr_type, uint32_t code_samples_per_chip)
@@ -193,6 +239,15 @@ fpga_multicorrelator_8sc::fpga_multicorrelator_8sc(int32_t n_correlators,
     d_rem_carr_phase_rad_int = 0;
     d_phase_step_rad_int = 0;
     d_initial_sample_counter = 0;
+    d_loaded_registers_valid = false;
+    d_loaded_code_phase_step_chips_num = 0;
+    d_loaded_nsamples_minus_1 = 0;
+    d_loaded_code_length_minus_1 = 0;
+    d_loaded_rem_carr_phase_rad = 0;
+    d_loaded_phase_step_rad = 0;
+    d_loaded_initial_index = std::vector<uint32_t>(n_correlators + 1, 0);
+    d_loaded_initial_interp_counter = std::vector<uint32_t>(n_correlators + 1, 0);
+    d_epoch_pending = false;
     d_channel = 0;
     d_correlator_length_samples = 0,
     //d_code_length = code_length;
@@ -323,6 +378,7 @@ void fpga_multicorrelator_8sc::set_channel(uint32_t channel)
     //printf("www trk set channel\n");
     char device_io_name[MAX_LENGTH_DEVICEIO_NAME];  // driver io name
     d_channel = channel;
+    d_loaded_registers_valid = false;
 
     // open the device corresponding to the assigned channel
     std::string mergedname;
@@ -532,22 +588,22 @@ void fpga_multicorrelator_8sc::fpga_configure_code_parameters_in_fpga(void)
     for (i = 0; i < d_n_correlators; i++)
         {
             //printf("www writing d map base %d = d_initial_index %d  = %d\n", d_INITIAL_INDEX_REG_BASE_ADDR + i, i, d_initial_index[i]);
-            d_map_base[d_INITIAL_INDEX_REG_BASE_ADDR + i] = d_initial_index[i];
+            write_register(d_INITIAL_INDEX_REG_BASE_ADDR + i, d_initial_index[i], d_loaded_initial_index[i]);
             //d_map_base[1 + d_n_correlators + i] = d_initial_interp_counter[i];
             //printf("www writing d map base %d = d_initial_interp_counter %d  = %d\n", d_INITIAL_INTERP_COUNTER_REG_BASE_ADDR + i, i, d_initial_interp_counter[i]);
-            d_map_base[d_INITIAL_INTERP_COUNTER_REG_BASE_ADDR + i] = d_initial_interp_counter[i];
+            write_register(d_INITIAL_INTERP_COUNTER_REG_BASE_ADDR + i, d_initial_interp_counter[i], d_loaded_initial_interp_counter[i]);
         }
     if (d_track_pilot)
         {
             //printf("www writing d map base %d = d_initial_index %d  = %d\n", d_INITIAL_INDEX_REG_BASE_ADDR + d_n_correlators, d_n_correlators, d_initial_index[d_n_correlators]);
-            d_map_base[d_INITIAL_INDEX_REG_BASE_ADDR + d_n_correlators] = d_initial_index[d_n_correlators];
+            write_register(d_INITIAL_INDEX_REG_BASE_ADDR + d_n_correlators, d_initial_index[d_n_correlators], d_loaded_initial_index[d_n_correlators]);
             //d_map_base[1 + d_n_correlators + i] = d_initial_interp_counter[i];
             //printf("www writing d map base %d = d_initial_interp_counter %d  = %d\n", d_INITIAL_INTERP_COUNTER_REG_BASE_ADDR + d_n_correlators, d_n_correlators, d_initial_interp_counter[d_n_correlators]);
-            d_map_base[d_INITIAL_INTERP_COUNTER_REG_BASE_ADDR + d_n_correlators] = d_initial_interp_counter[d_n_correlators];
+            write_register(d_INITIAL_INTERP_COUNTER_REG_BASE_ADDR + d_n_correlators, d_initial_interp_counter[d_n_correlators], d_loaded_initial_interp_counter[d_n_correlators]);
         }
 
     //printf("www writing d map base %d = d_code_length_chips*d_code_samples_per_chip - 1  = %d\n", d_CODE_LENGTH_MINUS_1_REG_ADDR, (d_code_length_chips*d_code_samples_per_chip) - 1);
-    d_map_base[d_CODE_LENGTH_MINUS_1_REG_ADDR] = (d_code_length_chips * d_code_samples_per_chip) - 1;  // number of samples - 1
+    write_register(d_CODE_LENGTH_MINUS_1_REG_ADDR, (d_code_length_chips * d_code_samples_per_chip) - 1, d_loaded_code_length_minus_1);  // number of samples - 1
 }
 
 
@@ -597,16 +653,17 @@ void fpga_multicorrelator_8sc::fpga_compute_signal_parameters_in_fpga(void)
 void fpga_multicorrelator_8sc::fpga_configure_signal_parameters_in_fpga(void)
 {
     //printf("www d map base %d = d_code_phase_step_chips_num = %d\n", d_CODE_PHASE_STEP_CHIPS_NUM_REG_ADDR, d_code_phase_step_chips_num);
-    d_map_base[d_CODE_PHASE_STEP_CHIPS_NUM_REG_ADDR] = d_code_phase_step_chips_num;
+    write_register(d_CODE_PHASE_STEP_CHIPS_NUM_REG_ADDR, d_code_phase_step_chips_num, d_loaded_code_phase_step_chips_num);
 
     //printf("www d map base %d = d_correlator_length_samples - 1 = %d\n", d_NSAMPLES_MINUS_1_REG_ADDR, d_correlator_length_samples - 1);
-    d_map_base[d_NSAMPLES_MINUS_1_REG_ADDR] = d_correlator_length_samples - 1;
+    write_register(d_NSAMPLES_MINUS_1_REG_ADDR, d_correlator_length_samples - 1, d_loaded_nsamples_minus_1);
 
     //printf("www d map base %d = d_rem_carr_phase_rad_int = %d\n", d_REM_CARR_PHASE_RAD_REG_ADDR, d_rem_carr_phase_rad_int);
-    d_map_base[d_REM_CARR_PHASE_RAD_REG_ADDR] = d_rem_carr_phase_rad_int;
+    write_register(d_REM_CARR_PHASE_RAD_REG_ADDR, static_cast<uint32_t>(d_rem_carr_phase_rad_int), d_loaded_rem_carr_phase_rad);
 
     //printf("www d map base %d = d_phase_step_rad_int = %d\n", d_PHASE_STEP_RAD_REG_ADDR, d_phase_step_rad_int);
-    d_map_base[d_PHASE_STEP_RAD_REG_ADDR] = d_phase_step_rad_int;
+    write_register(d_PHASE_STEP_RAD_REG_ADDR, static_cast<uint32_t>(d_phase_step_rad_int), d_loaded_phase_step_rad);
+    d_loaded_registers_valid = true;
 }
 
 
@@ -40,6 +40,8 @@
 #include <gnuradio/block.h>
 #include <volk_gnsssdr/volk_gnsssdr.h>
 #include <cstdint>
+#include <string>
+#include <vector>
 
 #define MAX_LENGTH_DEVICEIO_NAME 50
 
@@ -68,6 +70,29 @@ public:
         float rem_carrier_phase_in_rad, float phase_step_rad,
         float rem_code_phase_chips, float code_phase_step_chips,
         int32_t signal_length_samples);
+
+    /*!
+     * \brief Programs the NCOs and launches one correlation epoch, without waiting for it to finish
+     */
+    void launch_multicorrelator_resampler(
+        float rem_carrier_phase_in_rad, float phase_step_rad,
+        float rem_code_phase_chips, float code_phase_step_chips,
+        int32_t signal_length_samples);
+
+    /*!
+     * \brief Waits for the interrupt of the launched epoch and reads its correlation results
+     */
+    void read_multicorrelator_results();
+
+    /*!
+     * \brief Waits for the launched epoch, if any, and drops its results
+     */
+    void discard_pending_epoch();
+
+    inline bool epoch_pending() const
+    {
+        return d_epoch_pending;
+    }
     bool free();
     void set_channel(uint32_t channel);
     void set_initial_sample(uint64_t samples_offset);
@@ -106,6 +131,18 @@ private:
     int32_t d_phase_step_rad_int;
     uint64_t d_initial_sample_counter;
 
+    // last values written to the NCO registers: the registers keep their contents
+    // between epochs, so only the words that change are written again
+    bool d_loaded_registers_valid;
+    uint32_t d_loaded_code_phase_step_chips_num;
+    uint32_t d_loaded_nsamples_minus_1;
+    uint32_t d_loaded_code_length_minus_1;
+    uint32_t d_loaded_rem_carr_phase_rad;
+    uint32_t d_loaded_phase_step_rad;
+    std::vector<uint32_t> d_loaded_initial_index;
+    std::vector<uint32_t> d_loaded_initial_interp_counter;
+    bool d_epoch_pending;  // an epoch has been launched and its results have not been read yet
+
     // driver
     std::string d_device_name;
     uint32_t d_device_base;
@@ -152,6 +189,8 @@ private:
     void fpga_compute_signal_parameters_in_fpga(void);
     void fpga_configure_signal_parameters_in_fpga(void);
     void fpga_launch_multicorrelator_fpga(void);
+    void write_register(uint32_t address, uint32_t value, uint32_t &loaded_value);
+    void wait_for_interrupt(void);
     void read_tracking_gps_results(void);
     //void reset_multicorrelator(void);
     void close_device(void);
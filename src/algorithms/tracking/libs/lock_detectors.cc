@@ -109,3 +109,55 @@ float carrier_lock_detector(gr_complex* Prompt_buffer, int length)
     NBD = tmp_sum_I * tmp_sum_I - tmp_sum_Q * tmp_sum_Q;
     return NBD / NBP;
 }
+
+
+Cn0_Lock_Estimator::Cn0_Lock_Estimator(int length)
+{
+    d_length = length;
+    reset();
+}
+
+
+void Cn0_Lock_Estimator::set_length(int length)
+{
+    d_length = length;
+    reset();
+}
+
+
+void Cn0_Lock_Estimator::reset()
+{
+    d_count = 0;
+    d_sum_abs_I = 0.0;
+    d_sum_power = 0.0;
+    d_sum_I = 0.0;
+    d_sum_Q = 0.0;
+}
+
+
+void Cn0_Lock_Estimator::add(const gr_complex& prompt)
+{
+    d_sum_abs_I += std::abs(static_cast<double>(prompt.real()));
+    d_sum_power += static_cast<double>(prompt.imag()) * static_cast<double>(prompt.imag()) + static_cast<double>(prompt.real()) * static_cast<double>(prompt.real());
+    d_sum_I += prompt.real();
+    d_sum_Q += prompt.imag();
+    d_count++;
+}
+
+
+float Cn0_Lock_Estimator::cn0_db_hz(double coh_integration_time_s) const
+{
+    double Psig = d_sum_abs_I / static_cast<double>(d_count);
+    Psig = Psig * Psig;
+    double Ptot = d_sum_power / static_cast<double>(d_count);
+    double SNR = Psig / (Ptot - Psig);
+    return static_cast<float>(10.0 * log10(SNR) - 10.0 * log10(coh_integration_time_s));
+}
+
+
+float Cn0_Lock_Estimator::carrier_lock() const
+{
+    float NBP = d_sum_I * d_sum_I + d_sum_Q * d_sum_Q;
+    float NBD = d_sum_I * d_sum_I - d_sum_Q * d_sum_Q;
+    return NBD / NBP;
+}
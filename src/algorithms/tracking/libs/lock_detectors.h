@@ -91,4 +91,44 @@ float cn0_svn_estimator(const gr_complex* Prompt_buffer, int length, double coh_
  */
 float carrier_lock_detector(gr_complex* Prompt_buffer, int length);
 
+
+/*! \brief Incremental version of cn0_svn_estimator and carrier_lock_detector
+ *
+ * The prompt correlator outputs are accumulated into the running sums of
+ * both estimators as they arrive, so no buffer is kept and adding each
+ * output costs O(1). Once \p length outputs have been added, the estimates
+ * are the same as the ones of cn0_svn_estimator and carrier_lock_detector
+ * over those outputs.
+ */
+class Cn0_Lock_Estimator
+{
+public:
+    explicit Cn0_Lock_Estimator(int length = 20);
+    void set_length(int length);
+    void reset();
+
+    //! Adds a prompt correlator output to the estimation window
+    void add(const gr_complex& prompt);
+
+    //! Returns true when the estimation window is complete
+    inline bool ready() const
+    {
+        return d_count >= d_length;
+    }
+
+    //! CN0 [dB-Hz] over the prompt outputs added since the last reset
+    float cn0_db_hz(double coh_integration_time_s) const;
+
+    //! Carrier lock test over the prompt outputs added since the last reset
+    float carrier_lock() const;
+
+private:
+    int d_length;
+    int d_count;
+    double d_sum_abs_I;  // SNV signal power
+    double d_sum_power;  // SNV total power
+    float d_sum_I;       // carrier lock narrow band power and difference
+    float d_sum_Q;
+};
+
 #endif
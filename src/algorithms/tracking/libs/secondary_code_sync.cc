@@ -0,0 +1,141 @@
+/*!
+ * \file secondary_code_sync.cc
+ * \brief Implementation of a bit-packed secondary code synchronizer
+ *
+ * Class that keeps the signs of the last prompt correlator outputs and
+ * finds their alignment with the secondary code, testing every circular
+ * shift of the code with XOR and popcount operations on 64-bit words.
+ *
+ * -------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2018  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *          Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------
+ */
+
+#include "secondary_code_sync.h"
+#include <algorithm>
+
+
+namespace
+{
+inline uint32_t popcount64(uint64_t x)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    return static_cast<uint32_t>(__builtin_popcountll(x));
+#else
+    x = x - ((x >> 1) & 0x5555555555555555ULL);
+    x = (x & 0x3333333333333333ULL) + ((x >> 2) & 0x3333333333333333ULL);
+    x = (x + (x >> 4)) & 0x0F0F0F0F0F0F0F0FULL;
+    return static_cast<uint32_t>((x * 0x0101010101010101ULL) >> 56);
+#endif
+}
+}  // namespace
+
+
+Secondary_Code_Sync::Secondary_Code_Sync()
+{
+    d_length = 0U;
+    d_words = 0U;
+    d_count = 0U;
+}
+
+
+void Secondary_Code_Sync::set_code(const std::string& code)
+{
+    d_length = static_cast<uint32_t>(code.length());
+    d_words = (d_length + 63U) / 64U;
+    // Shift s holds chip (j + s) mod d_length of the code in its bit j
+    d_rotations.assign(static_cast<size_t>(d_length) * d_words, 0ULL);
+    for (uint32_t s = 0; s < d_length; s++)
+        {
+            uint64_t* rotation = &d_rotations[static_cast<size_t>(s) * d_words];
+            for (uint32_t j = 0; j < d_length; j++)
+                {
+                    if (code[(j + s) % d_length] == '1')
+                        {
+                            rotation[j / 64U] |= (1ULL << (j % 64U));
+                        }
+                }
+        }
+    d_history.assign(d_words, 0ULL);
+    d_count = 0U;
+}
+
+
+void Secondary_Code_Sync::clear()
+{
+    std::fill(d_history.begin(), d_history.end(), 0ULL);
+    d_count = 0U;
+}
+
+
+void Secondary_Code_Sync::push_sign(bool negative)
+{
+    if (d_length == 0U)
+        {
+            return;
+        }
+    // Drop the oldest sign (bit 0) and append the newest one as bit d_length - 1
+    for (uint32_t w = 0; w + 1 < d_words; w++)
+        {
+            d_history[w] = (d_history[w] >> 1) | (d_history[w + 1] << 63);
+        }
+    d_history[d_words - 1] >>= 1;
+    if (negative)
+        {
+            d_history[(d_length - 1) / 64U] |= (1ULL << ((d_length - 1) % 64U));
+        }
+    if (d_count < d_length)
+        {
+            d_count++;
+        }
+}
+
+
+int32_t Secondary_Code_Sync::find_shift() const
+{
+    for (uint32_t s = 0; s < d_length; s++)
+        {
+            if (matches_shift(s))
+                {
+                    return static_cast<int32_t>(s);
+                }
+        }
+    return -1;
+}
+
+
+bool Secondary_Code_Sync::matches_shift(uint32_t shift) const
+{
+    if (!full() or (shift >= d_length))
+        {
+            return false;
+        }
+    const uint64_t* rotation = &d_rotations[static_cast<size_t>(shift) * d_words];
+    uint32_t errors = 0U;
+    for (uint32_t w = 0; w < d_words; w++)
+        {
+            errors += popcount64(d_history[w] ^ rotation[w]);
+        }
+    // Signs are negative where the code chips are '1', or the other way round
+    return errors == 0U or errors == d_length;
+}
@@ -0,0 +1,98 @@
+/*!
+ * \file secondary_code_sync.h
+ * \brief Interface of a bit-packed secondary code synchronizer
+ *
+ * Class that keeps the signs of the last prompt correlator outputs and
+ * finds their alignment with the secondary code, testing every circular
+ * shift of the code with XOR and popcount operations on 64-bit words.
+ *
+ * -------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2018  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *          Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_SECONDARY_CODE_SYNC_H_
+#define GNSS_SDR_SECONDARY_CODE_SYNC_H_
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/*!
+ * \brief This class implements a bit-packed secondary code synchronizer.
+ *
+ * Bit j of the sign history holds the sign of the j-th oldest prompt in the
+ * window of one secondary code period (1 if negative). Every circular shift
+ * of the code is packed in the same way in set_code(), so each epoch the
+ * search takes a handful of word operations per shift.
+ */
+class Secondary_Code_Sync
+{
+public:
+    Secondary_Code_Sync();
+
+    /*!
+     * \brief Sets the secondary code, as a string of '0' and '1' chips.
+     */
+    void set_code(const std::string& code);
+
+    /*!
+     * \brief Discards the sign history.
+     */
+    void clear();
+
+    /*!
+     * \brief Appends the sign of the newest prompt to the history.
+     */
+    void push_sign(bool negative);
+
+    /*!
+     * \brief Returns true if the history spans a whole secondary code period.
+     */
+    inline bool full() const
+    {
+        return d_length > 0 and d_count >= d_length;
+    }
+
+    /*!
+     * \brief Looks for a circular shift of the code that matches all the signs
+     * of the history, or all of them inverted.
+     * \return the secondary code chip of the oldest prompt in the history, or -1.
+     */
+    int32_t find_shift() const;
+
+    /*!
+     * \brief Returns true if circular shift \p shift of the code matches all
+     * the signs of the history, or all of them inverted.
+     */
+    bool matches_shift(uint32_t shift) const;
+
+private:
+    uint32_t d_length;                  // secondary code length [chips]
+    uint32_t d_words;                   // 64-bit words per packed sequence
+    uint32_t d_count;                   // prompts in the history, saturated at d_length
+    std::vector<uint64_t> d_rotations;  // d_length circular shifts of the code, d_words each
+    std::vector<uint64_t> d_history;
+};
+
+#endif
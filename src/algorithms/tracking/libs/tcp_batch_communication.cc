@@ -0,0 +1,219 @@
+/*!
+ * \file tcp_batch_communication.cc
+ * \brief Connection to an external loop filter shared by all the channels of
+ * the tcp_connector tracking blocks, with one message per batch of channels.
+ *
+ * -------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2019  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *          Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------
+ */
+
+#include "tcp_batch_communication.h"
+#include "tcp_communication.h"
+#include <glog/logging.h>
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <iostream>
+
+
+std::shared_ptr<tcp_batch_communication> tcp_batch_communication::get_instance(size_t port)
+{
+    static std::mutex instances_mutex;
+    static std::map<size_t, std::weak_ptr<tcp_batch_communication>> instances;
+    std::lock_guard<std::mutex> lock(instances_mutex);
+    std::shared_ptr<tcp_batch_communication> instance = instances[port].lock();
+    if (!instance)
+        {
+            instance = std::shared_ptr<tcp_batch_communication>(new tcp_batch_communication(port));
+            instances[port] = instance;
+        }
+    return instance;
+}
+
+
+tcp_batch_communication::tcp_batch_communication(size_t port) : d_port(port),
+                                                                d_socket(d_io_service),
+                                                                d_connected(false),
+                                                                d_batch(0),
+                                                                d_stop(false)
+{
+    try
+        {
+            boost::asio::ip::tcp::endpoint endpoint(boost::asio::ip::tcp::v4(), d_port);
+            boost::asio::ip::tcp::acceptor acceptor(d_io_service, endpoint);
+            acceptor.set_option(boost::asio::ip::tcp::acceptor::reuse_address(true));
+            std::cout << "Server ready. Listening for a batched TCP connection on port " << d_port << "..." << std::endl;
+            acceptor.listen(1);
+            acceptor.accept(d_socket);
+            d_socket.set_option(boost::asio::ip::tcp::no_delay(true));
+            d_connected = true;
+            std::cout << "Socket accepted on port " << d_port << ", all the channels share it" << std::endl;
+        }
+    catch (const std::exception& e)
+        {
+            LOG(WARNING) << "Batched TCP connection on port " << d_port << " failed: " << e.what();
+            std::cerr << "Exception: " << e.what() << std::endl;
+            return;
+        }
+    d_sender = std::thread(&tcp_batch_communication::send_batches, this);
+    d_receiver = std::thread(&tcp_batch_communication::receive_replies, this);
+}
+
+
+tcp_batch_communication::~tcp_batch_communication()
+{
+    {
+        std::lock_guard<std::mutex> lock(d_mutex);
+        d_stop = true;
+    }
+    d_pending_cond.notify_all();
+    boost::system::error_code ec;
+    d_socket.shutdown(boost::asio::ip::tcp::socket::shutdown_both, ec);  // unblocks the reader
+    if (d_sender.joinable())
+        {
+            d_sender.join();
+        }
+    if (d_receiver.joinable())
+        {
+            d_receiver.join();
+        }
+    d_socket.close(ec);
+    std::cout << "Socket closed on port " << d_port << std::endl;
+}
+
+
+void tcp_batch_communication::send_receive(uint32_t channel, const float* values, size_t n_values, tcp_packet_data* tcp_data)
+{
+    if (!d_connected)
+        {
+            return;
+        }
+    {
+        std::lock_guard<std::mutex> lock(d_mutex);
+        d_pending[channel].assign(values, values + n_values);
+        auto reply = d_replies.find(channel);
+        if (reply != d_replies.end())
+            {
+                *tcp_data = reply->second;
+            }
+    }
+    d_pending_cond.notify_one();
+}
+
+
+void tcp_batch_communication::send_batches()
+{
+    std::vector<uint8_t> message;
+    std::unique_lock<std::mutex> lock(d_mutex);
+    while (!d_stop)
+        {
+            d_pending_cond.wait(lock, [this] { return d_stop or !d_pending.empty(); });
+            // the channels of the previous batch are usually about to queue their values too
+            d_pending_cond.wait_for(lock, std::chrono::milliseconds(TCP_BATCH_TIMEOUT_MS), [this] {
+                return d_stop or std::all_of(d_last_batch.cbegin(), d_last_batch.cend(), [this](uint32_t channel) { return d_pending.count(channel) > 0; });
+            });
+            if (d_stop)
+                {
+                    break;
+                }
+
+            size_t values_per_record = 0;
+            for (const auto& pending : d_pending)
+                {
+                    values_per_record = std::max(values_per_record, pending.second.size());
+                }
+            tcp_batch_header header;
+            header.magic = TCP_BATCH_MAGIC;
+            header.batch = d_batch++;
+            header.n_records = static_cast<uint32_t>(d_pending.size());
+            header.values_per_record = static_cast<uint32_t>(values_per_record);
+            const size_t record_bytes = sizeof(uint32_t) + values_per_record * sizeof(float);
+            message.assign(sizeof(header) + d_pending.size() * record_bytes, 0);
+            std::memcpy(message.data(), &header, sizeof(header));
+            uint8_t* record = message.data() + sizeof(header);
+            d_last_batch.clear();
+            for (const auto& pending : d_pending)
+                {
+                    std::memcpy(record, &pending.first, sizeof(uint32_t));
+                    std::memcpy(record + sizeof(uint32_t), pending.second.data(), pending.second.size() * sizeof(float));
+                    record += record_bytes;
+                    d_last_batch.insert(pending.first);
+                }
+            d_pending.clear();
+
+            lock.unlock();
+            try
+                {
+                    boost::asio::write(d_socket, boost::asio::buffer(message));
+                }
+            catch (const std::exception& e)
+                {
+                    LOG(WARNING) << "Batched TCP connection on port " << d_port << ": " << e.what();
+                    lock.lock();
+                    break;
+                }
+            lock.lock();
+        }
+}
+
+
+void tcp_batch_communication::receive_replies()
+{
+    std::vector<float> values;
+    while (true)
+        {
+            tcp_batch_header header;
+            try
+                {
+                    boost::asio::read(d_socket, boost::asio::buffer(&header, sizeof(header)));
+                    if ((header.magic != TCP_BATCH_MAGIC) or (header.values_per_record < NUM_RX_VARIABLES))
+                        {
+                            LOG(WARNING) << "Batched TCP connection on port " << d_port << ": wrong reply header, the connection is no longer read";
+                            return;
+                        }
+                    for (uint32_t n = 0; n < header.n_records; n++)
+                        {
+                            uint32_t channel = 0;
+                            values.resize(header.values_per_record);
+                            boost::asio::read(d_socket, boost::asio::buffer(&channel, sizeof(channel)));
+                            boost::asio::read(d_socket, boost::asio::buffer(values));
+                            tcp_packet_data reply;
+                            reply.proc_pack_code_error = values[1];
+                            reply.proc_pack_carr_error = values[2];
+                            reply.proc_pack_carrier_doppler_hz = values[3];
+                            std::lock_guard<std::mutex> lock(d_mutex);
+                            d_replies[channel] = reply;
+                        }
+                }
+            catch (const std::exception& e)
+                {
+                    std::lock_guard<std::mutex> lock(d_mutex);
+                    if (!d_stop)
+                        {
+                            LOG(WARNING) << "Batched TCP connection on port " << d_port << ": " << e.what();
+                        }
+                    return;
+                }
+        }
+}
@@ -0,0 +1,122 @@
+/*!
+ * \file tcp_batch_communication.h
+ * \brief Connection to an external loop filter shared by all the channels of
+ * the tcp_connector tracking blocks, with one message per batch of channels.
+ *
+ * -------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2019  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *          Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_TCP_BATCH_COMMUNICATION_H_
+#define GNSS_SDR_TCP_BATCH_COMMUNICATION_H_
+
+#include "tcp_packet_data.h"
+#include <boost/asio.hpp>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <thread>
+#include <vector>
+
+#define TCP_BATCH_MAGIC 0x47425443
+#define TCP_BATCH_TIMEOUT_MS 5  // longest wait for the rest of the channels of a batch
+
+/*!
+ * \brief Header of every message of the batched protocol, in both directions.
+ * It is followed by n_records records, each one an uint32_t channel number
+ * and values_per_record floats. All the fields are little endian.
+ *
+ * The receiver sends the correlator outputs of a tcp_connector tracking
+ * block (the same values as in a packet of tcp_communication, starting with
+ * the control id). The loop filter answers with a message with the same
+ * batch number and one record of NUM_RX_VARIABLES values (control id, code
+ * error, carrier error and carrier Doppler) per channel of the request.
+ */
+struct tcp_batch_header
+{
+    uint32_t magic;
+    uint32_t batch;
+    uint32_t n_records;
+    uint32_t values_per_record;
+};
+
+
+/*!
+ * \brief One TCP connection to the loop filter for all the channels
+ * (Tracking.batch_tcp=true), instead of a connection and a blocking round
+ * trip per channel and integration period.
+ *
+ * The channels queue their correlator outputs without waiting. A thread
+ * sends the pending outputs in a single message as soon as all the channels
+ * of the previous batch have queued theirs (or after a short timeout, so
+ * that a channel that stops does not hold the others), and another thread
+ * reads the replies. A channel applies the newest reply it has, which is
+ * usually the one of its previous integration period: the loop is closed
+ * with one period of latency, and the channels never wait for the network.
+ */
+class tcp_batch_communication
+{
+public:
+    /*!
+     * \brief The connection on \p port, shared by all the channels. The first
+     * call waits for the loop filter to connect.
+     */
+    static std::shared_ptr<tcp_batch_communication> get_instance(size_t port);
+
+    ~tcp_batch_communication();
+
+    /*!
+     * \brief Queues the \p n_values values of \p channel, replacing those not
+     * sent yet, and copies into \p tcp_data the newest reply of the loop
+     * filter for that channel. \p tcp_data is left as it is if there is none.
+     */
+    void send_receive(uint32_t channel, const float* values, size_t n_values, tcp_packet_data* tcp_data);
+
+private:
+    explicit tcp_batch_communication(size_t port);
+    void send_batches();
+    void receive_replies();
+
+    size_t d_port;
+    boost::asio::io_service d_io_service;
+    boost::asio::ip::tcp::socket d_socket;
+    bool d_connected;
+
+    std::mutex d_mutex;
+    std::condition_variable d_pending_cond;
+    std::map<uint32_t, std::vector<float>> d_pending;  // channel, values not sent yet
+    std::set<uint32_t> d_last_batch;                   // channels of the last message sent
+    std::map<uint32_t, tcp_packet_data> d_replies;     // channel, newest reply
+    uint32_t d_batch;
+    bool d_stop;
+
+    std::thread d_sender;
+    std::thread d_receiver;
+};
+
+#endif
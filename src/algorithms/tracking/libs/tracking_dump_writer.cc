@@ -0,0 +1,300 @@
+/*!
+ * \file tracking_dump_writer.cc
+ * \brief Receiver-wide writer thread for the tracking dump files.
+ *
+ * -------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2018  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *          Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------
+ */
+
+#include "tracking_dump_writer.h"
+#include <glog/logging.h>
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <exception>
+#if HAVE_ZLIB
+#include <zlib.h>
+#endif
+
+
+std::shared_ptr<Tracking_Dump_Writer> Tracking_Dump_Writer::get_instance()
+{
+    static std::mutex registry_mutex;
+    static std::weak_ptr<Tracking_Dump_Writer> registry;
+
+    std::lock_guard<std::mutex> lock(registry_mutex);
+    std::shared_ptr<Tracking_Dump_Writer> writer = registry.lock();
+    if (!writer)
+        {
+            writer = std::make_shared<Tracking_Dump_Writer>();
+            registry = writer;
+        }
+    return writer;
+}
+
+
+Tracking_Dump_Writer::Tracking_Dump_Writer()
+{
+    d_stop = false;
+    d_thread = std::thread(&Tracking_Dump_Writer::run, this);
+}
+
+
+Tracking_Dump_Writer::~Tracking_Dump_Writer()
+{
+    {
+        std::lock_guard<std::mutex> lock(d_mutex);
+        d_stop = true;
+    }
+    d_cond.notify_all();
+    if (d_thread.joinable())
+        {
+            d_thread.join();
+        }
+    for (int32_t i = 0; i < MAX_STREAMS; i++)
+        {
+            close(i);
+        }
+}
+
+
+int32_t Tracking_Dump_Writer::open(const std::string& filename, size_t record_bytes, bool compress, uint32_t ring_records)
+{
+    std::shared_ptr<Stream> stream = std::make_shared<Stream>();
+    stream->filename = filename;
+    stream->record_bytes = record_bytes;
+    stream->ring_records = std::max(ring_records, 2U);
+    stream->ring.resize(stream->ring_records * record_bytes);
+    stream->head = 0U;
+    stream->tail = 0U;
+    stream->dropped = 0ULL;
+    stream->compress = compress;
+    stream->gz_file = nullptr;
+#if HAVE_ZLIB
+    if (compress)
+        {
+            // Fastest compression level, the dump files compress well anyway
+            stream->gz_file = gzopen(filename.c_str(), "wb1");
+            if (stream->gz_file == nullptr)
+                {
+                    LOG(WARNING) << "Unable to open the tracking dump file " << filename;
+                    return -1;
+                }
+        }
+#else
+    if (compress)
+        {
+            LOG(WARNING) << "zlib is not available, the tracking dump file " << filename << " will not be compressed";
+            stream->compress = false;
+        }
+#endif
+    if (!stream->compress)
+        {
+            try
+                {
+                    stream->file.exceptions(std::ofstream::failbit | std::ofstream::badbit);
+                    stream->file.open(filename.c_str(), std::ios::out | std::ios::binary);
+                }
+            catch (const std::ofstream::failure& e)
+                {
+                    LOG(WARNING) << "Exception opening the tracking dump file " << filename << " " << e.what();
+                    return -1;
+                }
+        }
+
+    std::lock_guard<std::mutex> lock(d_mutex);
+    for (int32_t i = 0; i < MAX_STREAMS; i++)
+        {
+            if (!d_streams[i])
+                {
+                    d_streams[i] = stream;
+                    return i;
+                }
+        }
+    LOG(WARNING) << "Too many tracking dump files, " << filename << " will not be written";
+    return -1;
+}
+
+
+bool Tracking_Dump_Writer::push(int32_t stream, const void* record)
+{
+    // The owner of a stream is its only producer, and it is also the one that
+    // opens and closes it, so its entry cannot change here
+    Stream& s = *d_streams[stream];
+    uint32_t head = s.head.load(std::memory_order_relaxed);
+    uint32_t tail = s.tail.load(std::memory_order_acquire);
+    if (head - tail >= s.ring_records)
+        {
+            s.dropped++;
+            return false;
+        }
+    std::memcpy(&s.ring[(head % s.ring_records) * s.record_bytes], record, s.record_bytes);
+    s.head.store(head + 1, std::memory_order_release);
+    return true;
+}
+
+
+void Tracking_Dump_Writer::drain(Stream& stream)
+{
+    uint32_t tail = stream.tail.load(std::memory_order_relaxed);
+    uint32_t head = stream.head.load(std::memory_order_acquire);
+    while (tail != head)
+        {
+            // Contiguous records, up to the end of the ring
+            uint32_t first = tail % stream.ring_records;
+            uint32_t count = std::min(head - tail, stream.ring_records - first);
+            const char* data = &stream.ring[first * stream.record_bytes];
+            size_t bytes = count * stream.record_bytes;
+            try
+                {
+#if HAVE_ZLIB
+                    if (stream.compress)
+                        {
+                            gzwrite(static_cast<gzFile>(stream.gz_file), data, static_cast<unsigned>(bytes));
+                        }
+                    else
+#endif
+                        {
+                            stream.file.write(data, bytes);
+                        }
+                }
+            catch (const std::ofstream::failure& e)
+                {
+                    LOG(WARNING) << "Exception writing the tracking dump file " << stream.filename << " " << e.what();
+                }
+            tail += count;
+            stream.tail.store(tail, std::memory_order_release);
+        }
+}
+
+
+void Tracking_Dump_Writer::run()
+{
+    bool stop = false;
+    while (!stop)
+        {
+            std::vector<std::shared_ptr<Stream>> streams;
+            {
+                std::unique_lock<std::mutex> lock(d_mutex);
+                d_cond.wait_for(lock, std::chrono::milliseconds(10), [this] { return d_stop; });
+                stop = d_stop;
+                for (auto& stream : d_streams)
+                    {
+                        if (stream)
+                            {
+                                streams.push_back(stream);
+                            }
+                    }
+            }
+            for (auto& stream : streams)
+                {
+                    std::lock_guard<std::mutex> lock(stream->drain_mutex);
+                    drain(*stream);
+                }
+        }
+}
+
+
+size_t Tracking_Dump_Writer::ring_bytes(int32_t stream)
+{
+    std::lock_guard<std::mutex> lock(d_mutex);
+    if (stream < 0 or stream >= MAX_STREAMS or !d_streams[stream])
+        {
+            return 0;
+        }
+    return d_streams[stream]->ring.size();
+}
+
+
+void Tracking_Dump_Writer::close(int32_t stream)
+{
+    std::shared_ptr<Stream> s;
+    {
+        std::lock_guard<std::mutex> lock(d_mutex);
+        if (stream < 0 or stream >= MAX_STREAMS)
+            {
+                return;
+            }
+        s = d_streams[stream];
+        d_streams[stream] = nullptr;
+    }
+    if (!s)
+        {
+            return;
+        }
+    std::lock_guard<std::mutex> lock(s->drain_mutex);
+    drain(*s);
+#if HAVE_ZLIB
+    if (s->gz_file != nullptr)
+        {
+            gzclose(static_cast<gzFile>(s->gz_file));
+            s->gz_file = nullptr;
+        }
+#endif
+    if (s->file.is_open())
+        {
+            try
+                {
+                    s->file.close();
+                }
+            catch (const std::exception& ex)
+                {
+                    LOG(WARNING) << "Exception closing the tracking dump file " << s->filename << " " << ex.what();
+                }
+        }
+    if (s->dropped > 0)
+        {
+            LOG(WARNING) << s->dropped << " records were dropped from the tracking dump file " << s->filename;
+        }
+}
+
+
+bool Tracking_Dump_Writer::read(const std::string& filename, std::vector<char>& contents)
+{
+    contents.clear();
+#if HAVE_ZLIB
+    // gzread also reads files that are not compressed
+    gzFile file = gzopen(filename.c_str(), "rb");
+    if (file == nullptr)
+        {
+            return false;
+        }
+    std::vector<char> buffer(1 << 20);
+    int bytes = 0;
+    while ((bytes = gzread(file, buffer.data(), static_cast<unsigned>(buffer.size()))) > 0)
+        {
+            contents.insert(contents.end(), buffer.begin(), buffer.begin() + bytes);
+        }
+    gzclose(file);
+    return bytes == 0;
+#else
+    std::ifstream file(filename.c_str(), std::ios::binary);
+    if (!file.is_open())
+        {
+            return false;
+        }
+    contents.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    return true;
+#endif
+}
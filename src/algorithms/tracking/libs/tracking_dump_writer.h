@@ -0,0 +1,127 @@
+/*!
+ * \file tracking_dump_writer.h
+ * \brief Receiver-wide writer thread for the tracking dump files.
+ *
+ * The tracking blocks push one fixed-size record per integration period into
+ * a lock-free single-producer single-consumer ring owned by their dump
+ * stream, so no file I/O is performed in their real-time threads. A single
+ * thread drains the rings of all the channels into their files, optionally
+ * compressing them with zlib.
+ *
+ * -------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2018  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *          Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_TRACKING_DUMP_WRITER_H_
+#define GNSS_SDR_TRACKING_DUMP_WRITER_H_
+
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+
+/*!
+ * \brief Writes the records of the tracking dump streams from a single thread.
+ *
+ * Each stream accepts records from a single producer thread. If its ring is
+ * full because the writer cannot keep up, the record is dropped and counted.
+ */
+class Tracking_Dump_Writer
+{
+public:
+    /*!
+     * \brief Returns the writer shared by all the channels. It is created on
+     * the first request, and released when the last channel using it is destroyed.
+     */
+    static std::shared_ptr<Tracking_Dump_Writer> get_instance();
+
+    Tracking_Dump_Writer();
+    ~Tracking_Dump_Writer();
+
+    /*!
+     * \brief Opens the dump file \p filename, made of records of \p record_bytes bytes.
+     * It is written in gzip format if \p compress is true.
+     * \return the stream identifier, or -1 in case of failure.
+     */
+    int32_t open(const std::string& filename, size_t record_bytes, bool compress, uint32_t ring_records = 4096);
+
+    /*!
+     * \brief Queues a record. Only one thread can push the records of a given stream.
+     * \return false if the record was dropped because the ring was full.
+     */
+    bool push(int32_t stream, const void* record);
+
+    /*!
+     * \brief Writes the records still queued and closes the file.
+     */
+    void close(int32_t stream);
+
+    /*!
+     * \brief Size of the ring of records of \p stream, in bytes (0 if it is not open).
+     */
+    size_t ring_bytes(int32_t stream);
+
+    /*!
+     * \brief Reads a dump file, either plain or gzip compressed, into \p contents.
+     */
+    static bool read(const std::string& filename, std::vector<char>& contents);
+
+private:
+    struct Stream
+    {
+        std::string filename;
+        size_t record_bytes;
+        uint32_t ring_records;
+        std::vector<char> ring;
+        std::atomic<uint32_t> head;  // next record to be written by the producer
+        std::atomic<uint32_t> tail;  // next record to be read by the writer
+        uint64_t dropped;
+        bool compress;
+        std::ofstream file;
+        void* gz_file;
+        std::mutex drain_mutex;  // serializes the writer thread and close()
+    };
+
+    void run();
+    void drain(Stream& stream);
+
+    static const int32_t MAX_STREAMS = 1024;
+
+    // Indexed by stream identifier, null if free. It is never reallocated, so that push() can access it without locking
+    std::array<std::shared_ptr<Stream>, MAX_STREAMS> d_streams;
+    std::mutex d_mutex;
+    std::condition_variable d_cond;
+    bool d_stop;
+    std::thread d_thread;
+};
+
+#endif
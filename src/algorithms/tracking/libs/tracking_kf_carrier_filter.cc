@@ -0,0 +1,164 @@
+/*!
+ * \file tracking_kf_carrier_filter.cc
+ * \brief Implementation of a Kalman filter for the carrier tracking loop
+ *
+ * Class that implements a second or third order Kalman filter of the
+ * carrier phase, Doppler and Doppler rate, driven by the output of the
+ * phase discriminator.
+ *
+ * -------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2018  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *          Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------
+ */
+
+#include "tracking_kf_carrier_filter.h"
+#include "MATH_CONSTANTS.h"
+#include <algorithm>
+#include <cmath>
+
+
+Tracking_KF_Carrier_Filter::Tracking_KF_Carrier_Filter()
+{
+    d_order = 2;
+    d_pdi = 0.001;
+    std::fill_n(&d_P_ini[0][0], N * N, 0.0);
+    std::fill_n(&d_P[0][0], N * N, 0.0);
+    std::fill_n(&d_P_pre[0][0], N * N, 0.0);
+    std::fill_n(d_x, N, 0.0);
+    std::fill_n(d_x_pre, N, 0.0);
+    update_model();
+}
+
+
+void Tracking_KF_Carrier_Filter::set_params(uint32_t order, double pdi_s)
+{
+    d_order = (order == 3 ? 3 : 2);
+    d_pdi = pdi_s;
+    if (d_order == 2)
+        {
+            for (int i = 0; i < N; i++)
+                {
+                    d_P_ini[i][2] = 0.0;
+                    d_P_ini[2][i] = 0.0;
+                }
+        }
+    update_model();
+}
+
+
+void Tracking_KF_Carrier_Filter::set_pdi(double pdi_s)
+{
+    d_pdi = pdi_s;
+    update_model();
+}
+
+
+void Tracking_KF_Carrier_Filter::update_model()
+{
+    std::fill_n(&d_F[0][0], N * N, 0.0);
+    std::fill_n(&d_Q[0][0], N * N, 0.0);
+    d_F[0][0] = 1.0;
+    d_F[0][1] = PI_2 * d_pdi;
+    d_F[1][1] = 1.0;
+    d_Q[0][0] = std::pow(d_pdi, 4);
+    d_Q[1][1] = d_pdi;
+    if (d_order == 3)
+        {
+            d_F[0][2] = 0.5 * PI_2 * d_pdi * d_pdi;
+            d_F[1][2] = d_pdi;
+            d_F[2][2] = 1.0;
+            d_Q[2][2] = d_pdi;
+        }
+}
+
+
+void Tracking_KF_Carrier_Filter::set_initial_covariance(double sigma2_phase_rad2, double sigma2_doppler_hz2, double sigma2_doppler_rate)
+{
+    std::fill_n(&d_P_ini[0][0], N * N, 0.0);
+    d_P_ini[0][0] = sigma2_phase_rad2;
+    d_P_ini[1][1] = sigma2_doppler_hz2;
+    d_P_ini[2][2] = (d_order == 3 ? sigma2_doppler_rate : 0.0);
+}
+
+
+void Tracking_KF_Carrier_Filter::set_initial_doppler_variance(double sigma2_doppler_hz2)
+{
+    d_P_ini[1][1] = sigma2_doppler_hz2;
+}
+
+
+void Tracking_KF_Carrier_Filter::initialize(double phase_rad, double doppler_hz, double doppler_rate_hz2)
+{
+    std::copy(&d_P_ini[0][0], &d_P_ini[0][0] + N * N, &d_P[0][0]);
+    std::copy(&d_P_ini[0][0], &d_P_ini[0][0] + N * N, &d_P_pre[0][0]);
+    d_x[0] = phase_rad;
+    d_x[1] = doppler_hz;
+    d_x[2] = (d_order == 3 ? doppler_rate_hz2 : 0.0);
+    std::copy(d_x, d_x + N, d_x_pre);
+}
+
+
+void Tracking_KF_Carrier_Filter::predict()
+{
+    // x_pre = F * x
+    for (int i = 0; i < N; i++)
+        {
+            d_x_pre[i] = d_F[i][0] * d_x[0] + d_F[i][1] * d_x[1] + d_F[i][2] * d_x[2];
+        }
+    // P_pre = F * P * F' + Q
+    double FP[N][N];
+    for (int i = 0; i < N; i++)
+        {
+            for (int j = 0; j < N; j++)
+                {
+                    FP[i][j] = d_F[i][0] * d_P[0][j] + d_F[i][1] * d_P[1][j] + d_F[i][2] * d_P[2][j];
+                }
+        }
+    for (int i = 0; i < N; i++)
+        {
+            for (int j = 0; j < N; j++)
+                {
+                    d_P_pre[i][j] = FP[i][0] * d_F[j][0] + FP[i][1] * d_F[j][1] + FP[i][2] * d_F[j][2] + d_Q[i][j];
+                }
+        }
+}
+
+
+void Tracking_KF_Carrier_Filter::update(double phase_error_rad, double innovation_variance)
+{
+    // With H = [1 0 0], the Kalman gain is the first column of P_pre divided by the
+    // (scalar) innovation covariance, and (I - K * H) * P_pre = P_pre - K * P_pre(0, :)
+    double K[N];
+    for (int i = 0; i < N; i++)
+        {
+            K[i] = d_P_pre[i][0] / innovation_variance;
+            d_x[i] = d_x_pre[i] + K[i] * phase_error_rad;
+        }
+    for (int i = 0; i < N; i++)
+        {
+            for (int j = 0; j < N; j++)
+                {
+                    d_P[i][j] = d_P_pre[i][j] - K[i] * d_P_pre[0][j];
+                }
+        }
+}
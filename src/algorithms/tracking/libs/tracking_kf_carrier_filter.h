@@ -0,0 +1,133 @@
+/*!
+ * \file tracking_kf_carrier_filter.h
+ * \brief Interface of a Kalman filter for the carrier tracking loop
+ *
+ * Class that implements a second or third order Kalman filter of the
+ * carrier phase, Doppler and Doppler rate, driven by the output of the
+ * phase discriminator.
+ *
+ * -------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2018  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *          Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_TRACKING_KF_CARRIER_FILTER_H_
+#define GNSS_SDR_TRACKING_KF_CARRIER_FILTER_H_
+
+#include <cstdint>
+
+/*!
+ * \brief This class implements a Kalman filter for the carrier tracking loop.
+ *
+ * The state vector is [phase (rad), Doppler (Hz), Doppler rate (Hz/s)]. The
+ * state and the covariances have a fixed size of three; the second order
+ * filter keeps the Doppler rate and its covariances at zero. The measurement
+ * is scalar, so the filter runs without any matrix inversion nor memory
+ * allocation.
+ */
+class Tracking_KF_Carrier_Filter
+{
+public:
+    Tracking_KF_Carrier_Filter();
+
+    /*!
+     * \brief Sets the order (2 or 3) and the update period \p pdi_s of the filter.
+     */
+    void set_params(uint32_t order, double pdi_s);
+    void set_pdi(double pdi_s);
+
+    /*!
+     * \brief Sets the diagonal of the state error covariance used by initialize().
+     */
+    void set_initial_covariance(double sigma2_phase_rad2, double sigma2_doppler_hz2, double sigma2_doppler_rate);
+    void set_initial_doppler_variance(double sigma2_doppler_hz2);
+
+    void initialize(double phase_rad, double doppler_hz, double doppler_rate_hz2);
+
+    /*!
+     * \brief Time update of the state and of its error covariance.
+     */
+    void predict();
+
+    /*!
+     * \brief Measurement update with the phase discriminator output
+     * \p phase_error_rad, whose innovation covariance is \p innovation_variance.
+     */
+    void update(double phase_error_rad, double innovation_variance);
+
+    inline uint32_t order() const
+    {
+        return d_order;
+    }
+    inline double pdi() const
+    {
+        return d_pdi;
+    }
+
+    //! Phase error covariance of the initial and of the predicted state (H * P * H')
+    inline double initial_phase_variance() const
+    {
+        return d_P_ini[0][0];
+    }
+    inline double predicted_phase_variance() const
+    {
+        return d_P_pre[0][0];
+    }
+
+    inline double phase_rad() const
+    {
+        return d_x[0];
+    }
+    inline double doppler_hz() const
+    {
+        return d_x[1];
+    }
+    inline double doppler_rate_hz2() const
+    {
+        return d_x[2];
+    }
+
+    //! Phase correction applied by the last measurement update [rad]
+    inline double phase_correction_rad() const
+    {
+        return d_x[0] - d_x_pre[0];
+    }
+
+private:
+    static const int N = 3;
+
+    void update_model();
+
+    uint32_t d_order;
+    double d_pdi;
+
+    double d_F[N][N];      // state transition matrix
+    double d_Q[N][N];      // system error covariance matrix
+    double d_P_ini[N][N];  // initial state error covariance matrix
+    double d_P[N][N];      // state error covariance matrix
+    double d_P_pre[N][N];  // predicted state error covariance matrix
+    double d_x[N];         // state vector
+    double d_x_pre[N];     // predicted state vector
+};
+
+#endif
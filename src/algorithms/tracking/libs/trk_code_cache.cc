@@ -0,0 +1,65 @@
+/*!
+ * \file trk_code_cache.cc
+ * \brief Process-wide, read-only cache of the local codes used by the
+ * tracking blocks.
+ *
+ * -------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2019  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *          Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------
+ */
+
+#include "trk_code_cache.h"
+
+
+std::shared_ptr<Trk_Code_Cache> Trk_Code_Cache::get_instance()
+{
+    static std::shared_ptr<Trk_Code_Cache> instance = std::make_shared<Trk_Code_Cache>();
+    return instance;
+}
+
+
+std::shared_ptr<const float> Trk_Code_Cache::find(const std::string& key)
+{
+    std::lock_guard<std::mutex> lock(d_mutex);
+    auto entry = d_codes.find(key);
+    if (entry != d_codes.end())
+        {
+            return entry->second;
+        }
+    return nullptr;
+}
+
+
+std::shared_ptr<const float> Trk_Code_Cache::insert(const std::string& key, const std::shared_ptr<const float>& code)
+{
+    std::lock_guard<std::mutex> lock(d_mutex);
+    auto entry = d_codes.insert(std::make_pair(key, code));
+    return entry.first->second;
+}
+
+
+size_t Trk_Code_Cache::size()
+{
+    std::lock_guard<std::mutex> lock(d_mutex);
+    return d_codes.size();
+}
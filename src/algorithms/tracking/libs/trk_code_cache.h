@@ -0,0 +1,79 @@
+/*!
+ * \file trk_code_cache.h
+ * \brief Process-wide, read-only cache of the local codes used by the
+ * tracking blocks.
+ *
+ * Each entry holds a local code replica sampled at an integer number of
+ * samples per chip. It is generated the first time a channel tracks a
+ * given satellite, and it is never modified afterwards, so starting the
+ * tracking of a satellite again just takes a pointer.
+ *
+ * -------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2019  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *          Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_TRK_CODE_CACHE_H_
+#define GNSS_SDR_TRK_CODE_CACHE_H_
+
+#include <cstddef>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+
+
+/*!
+ * \brief Thread-safe store of local code replicas.
+ *
+ * Keys are built by the tracking blocks from the signal component, PRN
+ * and samples per chip, so entries can be shared by all the channels of
+ * all the receivers of the process.
+ */
+class Trk_Code_Cache
+{
+public:
+    /*!
+     * \brief Returns the process-wide instance of the cache.
+     */
+    static std::shared_ptr<Trk_Code_Cache> get_instance();
+
+    /*!
+     * \brief Returns the cached code for \p key, or nullptr if it is not available.
+     */
+    std::shared_ptr<const float> find(const std::string& key);
+
+    /*!
+     * \brief Stores \p code under \p key. If another channel already
+     * stored an entry with the same key, that entry is kept and returned.
+     */
+    std::shared_ptr<const float> insert(const std::string& key, const std::shared_ptr<const float>& code);
+
+    size_t size();
+
+private:
+    std::map<std::string, std::shared_ptr<const float> > d_codes;
+    std::mutex d_mutex;
+};
+
+#endif
@@ -37,8 +37,11 @@
 #ifndef GNSS_SDR_CHANNEL_INTERFACE_H_
 #define GNSS_SDR_CHANNEL_INTERFACE_H_
 
+#include "concurrent_ring_queue.h"
+#include "control_message_factory.h"
 #include "gnss_block_interface.h"
 #include "gnss_signal.h"
+#include <memory>
 
 /*!
  * \brief This abstract class represents an interface to a channel GNSS block.
@@ -59,6 +62,8 @@ public:
     virtual void start_acquisition() = 0;
     virtual void stop_channel() = 0;
     virtual void set_signal(const Gnss_Signal&) = 0;
+    virtual void set_doppler_aiding(double doppler_hz, double uncertainty_hz) = 0;
+    virtual void set_event_queue(std::shared_ptr<concurrent_ring_queue<ControlMessage>> event_queue) = 0;
 };
 
 #endif /* GNSS_SDR_CHANNEL_INTERFACE_H_ */
@@ -42,6 +42,9 @@
 #include "gnss_block_interface.h"
 #include "gps_almanac.h"
 #include "gps_ephemeris.h"
+#include "pvt_status.h"
+#include <map>
+#include <memory>
 
 /*!
  * \brief This class represents an interface to a PVT block.
@@ -57,10 +60,10 @@ class PvtInterface : public GNSSBlockInterface
 public:
     virtual void reset() = 0;
     virtual void clear_ephemeris() = 0;
-    virtual std::map<int, Gps_Ephemeris> get_gps_ephemeris() const = 0;
-    virtual std::map<int, Galileo_Ephemeris> get_galileo_ephemeris() const = 0;
-    virtual std::map<int, Gps_Almanac> get_gps_almanac() const = 0;
-    virtual std::map<int, Galileo_Almanac> get_galileo_almanac() const = 0;
+    virtual std::shared_ptr<const std::map<int, Gps_Ephemeris>> get_gps_ephemeris() const = 0;
+    virtual std::shared_ptr<const std::map<int, Galileo_Ephemeris>> get_galileo_ephemeris() const = 0;
+    virtual std::shared_ptr<const std::map<int, Gps_Almanac>> get_gps_almanac() const = 0;
+    virtual std::shared_ptr<const std::map<int, Galileo_Almanac>> get_galileo_almanac() const = 0;
 
     virtual bool get_latest_PVT(double* longitude_deg,
         double* latitude_deg,
@@ -68,6 +71,17 @@ public:
         double* ground_speed_kmh,
         double* course_over_ground_deg,
         time_t* UTC_time) = 0;
+
+    /*!
+     * \brief Stops (or resumes) writing the optional position outputs (KML, GPX, GeoJSON and NMEA files)
+     */
+    virtual void suspend_position_outputs(bool suspend) = 0;
+
+    /*!
+     * \brief Gets the latest status of the channels and of the position, null
+     * until the first epoch. It never waits for the PVT block.
+     */
+    virtual std::shared_ptr<const Pvt_Status> get_status() const = 0;
 };
 
 #endif /* GNSS_SDR_PVT_INTERFACE_H_ */
@@ -0,0 +1,75 @@
+/*!
+ * \file telemetry_symbol_processor.h
+ * \brief Interfaces to run a telemetry decoder inside the tracking block of
+ * its channel, without a GNU Radio buffer between them.
+ *
+ * -------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2019  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *          Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------
+ */
+
+
+#ifndef GNSS_SDR_TELEMETRY_SYMBOL_PROCESSOR_H_
+#define GNSS_SDR_TELEMETRY_SYMBOL_PROCESSOR_H_
+
+#include "gnss_synchro.h"
+#include <gnuradio/basic_block.h>
+#include <cstdint>
+
+/*!
+ * \brief Symbol by symbol processing of a telemetry decoder block, as done
+ * by its general_work().
+ */
+class TelemetrySymbolProcessor
+{
+public:
+    virtual ~TelemetrySymbolProcessor() = default;
+
+    /*!
+     * \brief Decodes a symbol of the tracking block. Returns 1 if \p out_symbol
+     * is an output of the decoder, 0 if not, and a negative value on error.
+     */
+    virtual int32_t process_symbol(const Gnss_Synchro& in_symbol, Gnss_Synchro& out_symbol) = 0;
+};
+
+
+/*!
+ * \brief Tracking block that can pass its symbols straight to the telemetry
+ * decoder of its channel (Channel.fuse_telemetry=true), saving the decoder
+ * thread, its input buffer and a scheduler handoff per symbol.
+ */
+class TelemetryFusedTracking
+{
+public:
+    virtual ~TelemetryFusedTracking() = default;
+
+    /*!
+     * \brief From now on, the output of the tracking block are the outputs of
+     * \p decoder, and the "telemetry" messages of \p decoder_block are
+     * published on the "telemetry" port of the tracking block. \p decoder_block
+     * must not be connected to the flow graph.
+     */
+    virtual void fuse_telemetry_decoder(gr::basic_block_sptr decoder_block, TelemetrySymbolProcessor* decoder) = 0;
+};
+
+#endif /* GNSS_SDR_TELEMETRY_SYMBOL_PROCESSOR_H_ */
@@ -59,6 +59,26 @@ public:
     virtual void stop_tracking() = 0;
     virtual void set_gnss_synchro(Gnss_Synchro* gnss_synchro) = 0;
     virtual void set_channel(unsigned int channel) = 0;
+
+    /*!
+     * \brief Integrate-and-dump decimation factor that the flowgraph must
+     * apply to the samples feeding this tracking block (1 = full rate).
+     */
+    virtual unsigned int pre_decimation_factor()
+    {
+        return 1;  // non pure virtual to allow trackers without pre-decimation support
+    }
+
+    /*!
+     * \brief Tells an FDMA tracking block that the flowgraph feeds it from a
+     * pre-mixer that has already removed its frequency channel offset, with a
+     * latency of latency_samples at the full input rate. Returns false if the
+     * block does not support it, and then the flowgraph does not pre-mix.
+     */
+    virtual bool set_fdma_premixed(unsigned int latency_samples __attribute__((unused)))
+    {
+        return false;  // non pure virtual to allow trackers without FDMA pre-mixing support
+    }
 };
 
 #endif /* GNSS_SDR_TRACKING_INTERFACE_H_ */
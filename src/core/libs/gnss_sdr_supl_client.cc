@@ -371,6 +371,13 @@ void gnss_sdr_supl_client::read_supl_data()
 
 bool gnss_sdr_supl_client::load_ephemeris_xml(const std::string& file_name)
 {
+    // the binary store written by the PVT block is much faster to load
+    const std::string binary_file_name = gnss_sdr_binary_store_name(file_name);
+    if (gnss_sdr_binary_store_is_current(binary_file_name, file_name) and gnss_sdr_load_binary_store(binary_file_name, "GNSS-SDR_ephemeris_map", this->gps_ephemeris_map))
+        {
+            LOG(INFO) << "Loaded " << binary_file_name;
+            return true;
+        }
     std::ifstream ifs;
     try
         {
@@ -418,6 +425,13 @@ bool gnss_sdr_supl_client::save_ephemeris_map_xml(const std::string& file_name,
 
 bool gnss_sdr_supl_client::load_gal_ephemeris_xml(const std::string& file_name)
 {
+    // the binary store written by the PVT block is much faster to load
+    const std::string binary_file_name = gnss_sdr_binary_store_name(file_name);
+    if (gnss_sdr_binary_store_is_current(binary_file_name, file_name) and gnss_sdr_load_binary_store(binary_file_name, "GNSS-SDR_gal_ephemeris_map", this->gal_ephemeris_map))
+        {
+            LOG(INFO) << "Loaded " << binary_file_name;
+            return true;
+        }
     std::ifstream ifs;
     try
         {
@@ -465,6 +479,13 @@ bool save_gal_ephemeris_map_xml(const std::string& file_name, std::map<int, Gali
 
 bool gnss_sdr_supl_client::load_cnav_ephemeris_xml(const std::string& file_name)
 {
+    // the binary store written by the PVT block is much faster to load
+    const std::string binary_file_name = gnss_sdr_binary_store_name(file_name);
+    if (gnss_sdr_binary_store_is_current(binary_file_name, file_name) and gnss_sdr_load_binary_store(binary_file_name, "GNSS-SDR_cnav_ephemeris_map", this->gps_cnav_ephemeris_map))
+        {
+            LOG(INFO) << "Loaded " << binary_file_name;
+            return true;
+        }
     std::ifstream ifs;
     try
         {
@@ -512,6 +533,13 @@ bool save_cnav_ephemeris_map_xml(const std::string& file_name, std::map<int, Gps
 
 bool gnss_sdr_supl_client::load_gnav_ephemeris_xml(const std::string& file_name)
 {
+    // the binary store written by the PVT block is much faster to load
+    const std::string binary_file_name = gnss_sdr_binary_store_name(file_name);
+    if (gnss_sdr_binary_store_is_current(binary_file_name, file_name) and gnss_sdr_load_binary_store(binary_file_name, "GNSS-SDR_gnav_ephemeris_map", this->glonass_gnav_ephemeris_map))
+        {
+            LOG(INFO) << "Loaded " << binary_file_name;
+            return true;
+        }
     std::ifstream ifs;
     try
         {
@@ -559,6 +587,13 @@ bool save_gnav_ephemeris_map_xml(const std::string& file_name, std::map<int, Glo
 
 bool gnss_sdr_supl_client::load_utc_xml(const std::string& file_name)
 {
+    // the binary store written by the PVT block is much faster to load
+    const std::string binary_file_name = gnss_sdr_binary_store_name(file_name);
+    if (gnss_sdr_binary_store_is_current(binary_file_name, file_name) and gnss_sdr_load_binary_store(binary_file_name, "GNSS-SDR_utc_model", this->gps_utc))
+        {
+            LOG(INFO) << "Loaded " << binary_file_name;
+            return true;
+        }
     std::ifstream ifs;
     try
         {
@@ -605,6 +640,13 @@ bool gnss_sdr_supl_client::save_utc_xml(const std::string& file_name, Gps_Utc_Mo
 
 bool gnss_sdr_supl_client::load_cnav_utc_xml(const std::string& file_name)
 {
+    // the binary store written by the PVT block is much faster to load
+    const std::string binary_file_name = gnss_sdr_binary_store_name(file_name);
+    if (gnss_sdr_binary_store_is_current(binary_file_name, file_name) and gnss_sdr_load_binary_store(binary_file_name, "GNSS-SDR_cnav_utc_model", this->gps_cnav_utc))
+        {
+            LOG(INFO) << "Loaded " << binary_file_name;
+            return true;
+        }
     std::ifstream ifs;
     try
         {
@@ -651,6 +693,13 @@ bool gnss_sdr_supl_client::save_cnav_utc_xml(const std::string& file_name, Gps_C
 
 bool gnss_sdr_supl_client::load_gal_utc_xml(const std::string& file_name)
 {
+    // the binary store written by the PVT block is much faster to load
+    const std::string binary_file_name = gnss_sdr_binary_store_name(file_name);
+    if (gnss_sdr_binary_store_is_current(binary_file_name, file_name) and gnss_sdr_load_binary_store(binary_file_name, "GNSS-SDR_gal_utc_model", this->gal_utc))
+        {
+            LOG(INFO) << "Loaded " << binary_file_name;
+            return true;
+        }
     std::ifstream ifs;
     try
         {
@@ -697,6 +746,13 @@ bool gnss_sdr_supl_client::save_gal_utc_xml(const std::string& file_name, Galile
 
 bool gnss_sdr_supl_client::load_iono_xml(const std::string& file_name)
 {
+    // the binary store written by the PVT block is much faster to load
+    const std::string binary_file_name = gnss_sdr_binary_store_name(file_name);
+    if (gnss_sdr_binary_store_is_current(binary_file_name, file_name) and gnss_sdr_load_binary_store(binary_file_name, "GNSS-SDR_iono_model", this->gps_iono))
+        {
+            LOG(INFO) << "Loaded " << binary_file_name;
+            return true;
+        }
     std::ifstream ifs;
     try
         {
@@ -743,6 +799,13 @@ bool gnss_sdr_supl_client::save_iono_xml(const std::string& file_name, Gps_Iono&
 
 bool gnss_sdr_supl_client::load_gal_iono_xml(const std::string& file_name)
 {
+    // the binary store written by the PVT block is much faster to load
+    const std::string binary_file_name = gnss_sdr_binary_store_name(file_name);
+    if (gnss_sdr_binary_store_is_current(binary_file_name, file_name) and gnss_sdr_load_binary_store(binary_file_name, "GNSS-SDR_gal_iono_model", this->gal_iono))
+        {
+            LOG(INFO) << "Loaded " << binary_file_name;
+            return true;
+        }
     std::ifstream ifs;
     try
         {
@@ -789,6 +852,13 @@ bool gnss_sdr_supl_client::save_gal_iono_xml(const std::string& file_name, Galil
 
 bool gnss_sdr_supl_client::load_gps_almanac_xml(const std::string& file_name)
 {
+    // the binary store written by the PVT block is much faster to load
+    const std::string binary_file_name = gnss_sdr_binary_store_name(file_name);
+    if (gnss_sdr_binary_store_is_current(binary_file_name, file_name) and gnss_sdr_load_binary_store(binary_file_name, "GNSS-SDR_gps_almanac_map", this->gps_almanac_map))
+        {
+            LOG(INFO) << "Loaded " << binary_file_name;
+            return true;
+        }
     std::ifstream ifs;
     try
         {
@@ -836,6 +906,13 @@ bool gnss_sdr_supl_client::save_gps_almanac_xml(const std::string& file_name, st
 
 bool gnss_sdr_supl_client::load_gal_almanac_xml(const std::string& file_name)
 {
+    // the binary store written by the PVT block is much faster to load
+    const std::string binary_file_name = gnss_sdr_binary_store_name(file_name);
+    if (gnss_sdr_binary_store_is_current(binary_file_name, file_name) and gnss_sdr_load_binary_store(binary_file_name, "GNSS-SDR_gal_almanac_map", this->gal_almanac_map))
+        {
+            LOG(INFO) << "Loaded " << binary_file_name;
+            return true;
+        }
     std::ifstream ifs;
     try
         {
@@ -933,6 +1010,13 @@ bool gnss_sdr_supl_client::save_gal_almanac_xml(const std::string& file_name, st
 
 bool gnss_sdr_supl_client::load_glo_utc_xml(const std::string& file_name)
 {
+    // the binary store written by the PVT block is much faster to load
+    const std::string binary_file_name = gnss_sdr_binary_store_name(file_name);
+    if (gnss_sdr_binary_store_is_current(binary_file_name, file_name) and gnss_sdr_load_binary_store(binary_file_name, "GNSS-SDR_glo_utc_model", this->glo_gnav_utc))
+        {
+            LOG(INFO) << "Loaded " << binary_file_name;
+            return true;
+        }
     std::ifstream ifs;
     try
         {
@@ -979,6 +1063,13 @@ bool gnss_sdr_supl_client::save_glo_utc_xml(const std::string& file_name, Glonas
 
 bool gnss_sdr_supl_client::load_ref_time_xml(const std::string& file_name)
 {
+    // the binary store written by the PVT block is much faster to load
+    const std::string binary_file_name = gnss_sdr_binary_store_name(file_name);
+    if (gnss_sdr_binary_store_is_current(binary_file_name, file_name) and gnss_sdr_load_binary_store(binary_file_name, "GNSS-SDR_ref_time", this->gps_time))
+        {
+            LOG(INFO) << "Loaded " << binary_file_name;
+            return true;
+        }
     std::ifstream ifs;
     try
         {
@@ -1025,6 +1116,13 @@ bool gnss_sdr_supl_client::save_ref_time_xml(const std::string& file_name, Agnss
 
 bool gnss_sdr_supl_client::load_ref_location_xml(const std::string& file_name)
 {
+    // the binary store written by the PVT block is much faster to load
+    const std::string binary_file_name = gnss_sdr_binary_store_name(file_name);
+    if (gnss_sdr_binary_store_is_current(binary_file_name, file_name) and gnss_sdr_load_binary_store(binary_file_name, "GNSS-SDR_ref_location", this->gps_ref_loc))
+        {
+            LOG(INFO) << "Loaded " << binary_file_name;
+            return true;
+        }
     std::ifstream ifs;
     try
         {
@@ -47,6 +47,7 @@ extern "C"
 #include "galileo_utc_model.h"
 #include "glonass_gnav_ephemeris.h"
 #include "glonass_gnav_utc_model.h"
+#include "gnss_sdr_binary_store.h"
 #include "gps_acq_assist.h"
 #include "gps_almanac.h"
 #include "gps_cnav_ephemeris.h"
@@ -8,7 +8,7 @@
  *
  * -------------------------------------------------------------------------
  *
- * Copyright (C) 2010-2018  (see AUTHORS file for a list of contributors)
+ * Copyright (C) 2010-2019  (see AUTHORS file for a list of contributors)
  *
  * GNSS-SDR is a software defined Global Navigation
  *          Satellite Systems receiver
@@ -44,24 +44,28 @@ using google::LogMessage;
 gnss_synchro_monitor_sptr gnss_synchro_make_monitor(unsigned int n_channels,
     int output_rate_ms,
     int udp_port,
-    std::vector<std::string> udp_addresses)
+    std::vector<std::string> udp_addresses,
+    bool vector_input)
 {
     return gnss_synchro_monitor_sptr(new gnss_synchro_monitor(n_channels,
         output_rate_ms,
         udp_port,
-        udp_addresses));
+        udp_addresses,
+        vector_input));
 }
 
 
 gnss_synchro_monitor::gnss_synchro_monitor(unsigned int n_channels,
     int output_rate_ms,
     int udp_port,
-    std::vector<std::string> udp_addresses) : gr::sync_block("gnss_synchro_monitor",
-                                                  gr::io_signature::make(n_channels, n_channels, sizeof(Gnss_Synchro)),
-                                                  gr::io_signature::make(0, 0, 0))
+    std::vector<std::string> udp_addresses,
+    bool vector_input) : gr::sync_block("gnss_synchro_monitor",
+                             vector_input ? gr::io_signature::make(1, 1, sizeof(Gnss_Synchro) * n_channels) : gr::io_signature::make(n_channels, n_channels, sizeof(Gnss_Synchro)),
+                             gr::io_signature::make(0, 0, 0))
 {
     d_output_rate_ms = output_rate_ms;
     d_nchannels = n_channels;
+    d_vector_input = vector_input;
 
     udp_sink_ptr = std::unique_ptr<Gnss_Synchro_Udp_Sink>(new Gnss_Synchro_Udp_Sink(udp_addresses, udp_port));
 
@@ -81,12 +85,21 @@ int gnss_synchro_monitor::work(int noutput_items, gr_vector_const_void_star& inp
             count++;
             if (count >= d_output_rate_ms)
                 {
-                    for (unsigned int i = 0; i < d_nchannels; i++)
+                    // all the channels of the epoch, sent together
+                    if (d_vector_input)
                         {
-                            std::vector<Gnss_Synchro> stocks;
-                            stocks.push_back(in[i][epoch]);
-                            udp_sink_ptr->write_gnss_synchro(stocks);
+                            const Gnss_Synchro* first = in[0] + static_cast<size_t>(epoch) * d_nchannels;
+                            stocks.assign(first, first + d_nchannels);
                         }
+                    else
+                        {
+                            stocks.clear();
+                            for (unsigned int i = 0; i < d_nchannels; i++)
+                                {
+                                    stocks.push_back(in[i][epoch]);
+                                }
+                        }
+                    udp_sink_ptr->write_gnss_synchro(stocks);
                     count = 0;
                 }
         }
@@ -8,7 +8,7 @@
  *
  * -------------------------------------------------------------------------
  *
- * Copyright (C) 2010-2018  (see AUTHORS file for a list of contributors)
+ * Copyright (C) 2010-2019  (see AUTHORS file for a list of contributors)
  *
  * GNSS-SDR is a software defined Global Navigation
  *          Satellite Systems receiver
@@ -49,7 +49,8 @@ typedef boost::shared_ptr<gnss_synchro_monitor> gnss_synchro_monitor_sptr;
 gnss_synchro_monitor_sptr gnss_synchro_make_monitor(unsigned int n_channels,
     int output_rate_ms,
     int udp_port,
-    std::vector<std::string> udp_addresses);
+    std::vector<std::string> udp_addresses,
+    bool vector_input);
 
 /*!
  * \brief This class implements a block that computes the PVT solution with Galileo E1 signals
@@ -60,13 +61,16 @@ private:
     friend gnss_synchro_monitor_sptr gnss_synchro_make_monitor(unsigned int nchannels,
         int output_rate_ms,
         int udp_port,
-        std::vector<std::string> udp_addresses);
+        std::vector<std::string> udp_addresses,
+        bool vector_input);
 
     unsigned int d_nchannels;
+    bool d_vector_input;  // all the channels of an epoch in a single input item
 
     int d_output_rate_ms;
 
     std::unique_ptr<Gnss_Synchro_Udp_Sink> udp_sink_ptr;
+    std::vector<Gnss_Synchro> stocks;  // observables of the current epoch
 
     int count;
 
@@ -75,7 +79,8 @@ public:
     gnss_synchro_monitor(unsigned int nchannels,
         int output_rate_ms,
         int udp_port,
-        std::vector<std::string> udp_addresses);
+        std::vector<std::string> udp_addresses,
+        bool vector_input);
 
     ~gnss_synchro_monitor();  //!< Default destructor
 
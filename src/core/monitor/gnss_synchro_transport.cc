@@ -0,0 +1,178 @@
+/*!
+ * \file gnss_synchro_transport.cc
+ * \brief Wire format of the observables and navigation data sent by the
+ * channels nodes of a distributed receiver to its PVT node.
+ *
+ * -------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2019  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *          Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------
+ */
+
+#include "gnss_synchro_transport.h"
+#include "galileo_almanac.h"
+#include "galileo_ephemeris.h"
+#include "galileo_iono.h"
+#include "galileo_utc_model.h"
+#include "glonass_gnav_almanac.h"
+#include "glonass_gnav_ephemeris.h"
+#include "glonass_gnav_utc_model.h"
+#include "gnss_sdr_binary_store.h"
+#include "gps_almanac.h"
+#include "gps_cnav_ephemeris.h"
+#include "gps_cnav_iono.h"
+#include "gps_cnav_utc_model.h"
+#include "gps_ephemeris.h"
+#include "gps_iono.h"
+#include "gps_utc_model.h"
+#include "monitor_le_encoding.h"
+#include <boost/archive/binary_iarchive.hpp>
+#include <boost/archive/binary_oarchive.hpp>
+#include <glog/logging.h>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <sstream>
+#include <typeindex>
+#include <vector>
+
+
+namespace
+{
+struct Navigation_Codec
+{
+    std::type_index type;
+    std::function<void(const boost::any&, std::string&)> encode;
+    std::function<pmt::pmt_t(const uint8_t*, size_t)> decode;
+};
+
+
+template <class T>
+Navigation_Codec make_codec()
+{
+    Navigation_Codec codec{std::type_index(typeid(std::shared_ptr<T>)), nullptr, nullptr};
+    codec.encode = [](const boost::any& telemetry, std::string& payload) {
+        std::ostringstream buffer;
+        {
+            boost::archive::binary_oarchive archive(buffer, boost::archive::no_header);
+            const T& object = *boost::any_cast<std::shared_ptr<T>>(telemetry);
+            archive << object;
+        }
+        payload += buffer.str();
+    };
+    codec.decode = [](const uint8_t* payload, size_t size) {
+        std::shared_ptr<T> object = std::make_shared<T>();
+        Gnss_Sdr_Mapped_Streambuf buffer(reinterpret_cast<const char*>(payload), size);
+        boost::archive::binary_iarchive archive(buffer, boost::archive::no_header);
+        archive >> *object;
+        return pmt::make_any(object);
+    };
+    return codec;
+}
+
+
+// The type of the navigation data on the wire is its position in this list: append new types at its end
+const std::vector<Navigation_Codec>& navigation_codecs()
+{
+    static const std::vector<Navigation_Codec> codecs = {
+        make_codec<Gps_Ephemeris>(),
+        make_codec<Gps_Iono>(),
+        make_codec<Gps_Utc_Model>(),
+        make_codec<Gps_Almanac>(),
+        make_codec<Gps_CNAV_Ephemeris>(),
+        make_codec<Gps_CNAV_Iono>(),
+        make_codec<Gps_CNAV_Utc_Model>(),
+        make_codec<Galileo_Ephemeris>(),
+        make_codec<Galileo_Iono>(),
+        make_codec<Galileo_Utc_Model>(),
+        make_codec<Galileo_Almanac>(),
+        make_codec<Glonass_Gnav_Ephemeris>(),
+        make_codec<Glonass_Gnav_Utc_Model>(),
+        make_codec<Glonass_Gnav_Almanac>()};
+    return codecs;
+}
+}  // namespace
+
+
+size_t gnss_synchro_transport_header(uint8_t* buffer, uint8_t kind, uint8_t node, uint64_t sequence)
+{
+    size_t offset = 0;
+    put_le(buffer, offset, GNSS_SYNCHRO_TRANSPORT_MAGIC);
+    put_le(buffer, offset, GNSS_SYNCHRO_TRANSPORT_VERSION);
+    put_le(buffer, offset, kind);
+    put_le(buffer, offset, node);
+    put_le(buffer, offset, sequence);
+    return offset;
+}
+
+
+bool gnss_synchro_transport_parse_header(const uint8_t* buffer, size_t size, uint8_t& kind, uint8_t& node, uint64_t& sequence)
+{
+    if (size < GNSS_SYNCHRO_TRANSPORT_HEADER_SIZE)
+        {
+            return false;
+        }
+    size_t offset = 0;
+    uint32_t magic;
+    uint16_t version;
+    get_le(buffer, offset, magic);
+    get_le(buffer, offset, version);
+    get_le(buffer, offset, kind);
+    get_le(buffer, offset, node);
+    get_le(buffer, offset, sequence);
+    return (magic == GNSS_SYNCHRO_TRANSPORT_MAGIC) and (version == GNSS_SYNCHRO_TRANSPORT_VERSION);
+}
+
+
+bool gnss_navigation_encode(const boost::any& telemetry, std::string& payload)
+{
+    const std::vector<Navigation_Codec>& codecs = navigation_codecs();
+    for (size_t type = 0; type < codecs.size(); type++)
+        {
+            if (codecs[type].type == std::type_index(telemetry.type()))
+                {
+                    payload.push_back(static_cast<char>(type));
+                    codecs[type].encode(telemetry, payload);
+                    return true;
+                }
+        }
+    return false;
+}
+
+
+pmt::pmt_t gnss_navigation_decode(const uint8_t* payload, size_t size)
+{
+    const std::vector<Navigation_Codec>& codecs = navigation_codecs();
+    if ((size < 1) or (payload[0] >= codecs.size()))
+        {
+            return pmt::PMT_NIL;
+        }
+    try
+        {
+            return codecs[payload[0]].decode(payload + 1, size - 1);
+        }
+    catch (const std::exception& e)
+        {
+            LOG(WARNING) << "Corrupted navigation data of type " << static_cast<int>(payload[0]) << ": " << e.what();
+        }
+    return pmt::PMT_NIL;
+}
@@ -0,0 +1,90 @@
+/*!
+ * \file gnss_synchro_transport.h
+ * \brief Wire format of the observables and navigation data sent by the
+ * channels nodes of a distributed receiver to its PVT node.
+ *
+ * -------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2019  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *          Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_GNSS_SYNCHRO_TRANSPORT_H_
+#define GNSS_SDR_GNSS_SYNCHRO_TRANSPORT_H_
+
+#include "gnss_synchro_udp_sink.h"
+#include <boost/any.hpp>
+#include <pmt/pmt.h>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+/*!
+ * Wire format, little-endian: every datagram starts with the magic number
+ * GNSS_SYNCHRO_TRANSPORT_MAGIC (uint32), GNSS_SYNCHRO_TRANSPORT_VERSION
+ * (uint16), the kind of datagram (uint8), the number of the node that sent
+ * it (uint8) and the sequence number of the datagram in that node (uint64).
+ *
+ * An observables datagram carries the number of records (uint16) and the
+ * records, made of the stream they belong to (uint16, the input port of the
+ * observables block, or GNSS_SYNCHRO_TRANSPORT_CLOCK_STREAM for the sample
+ * counter) followed by a Gnss_Synchro written by gnss_synchro_encode().
+ *
+ * A navigation datagram carries the type of the object (uint8) and a boost
+ * binary archive of it. As the binary stores, it uses the byte order and
+ * the class layouts of the machine that wrote it, so all the nodes must
+ * run the same build on the same architecture.
+ */
+const uint32_t GNSS_SYNCHRO_TRANSPORT_MAGIC = 0x53424F47;  // "GOBS" in little-endian order
+const uint16_t GNSS_SYNCHRO_TRANSPORT_VERSION = 1;
+const size_t GNSS_SYNCHRO_TRANSPORT_HEADER_SIZE = 16;
+const uint8_t GNSS_SYNCHRO_TRANSPORT_OBSERVABLES = 0;
+const uint8_t GNSS_SYNCHRO_TRANSPORT_NAVIGATION = 1;
+const uint16_t GNSS_SYNCHRO_TRANSPORT_CLOCK_STREAM = 0xFFFF;
+const size_t GNSS_SYNCHRO_TRANSPORT_RECORD_SIZE = 2 + GNSS_SYNCHRO_RECORD_SIZE;
+const size_t GNSS_SYNCHRO_TRANSPORT_MAX_DATAGRAM = 65507;  // largest UDP payload over IPv4
+
+/*!
+ * \brief Writes the header of a datagram at \p buffer and returns its size
+ */
+size_t gnss_synchro_transport_header(uint8_t* buffer, uint8_t kind, uint8_t node, uint64_t sequence);
+
+/*!
+ * \brief Reads the header of a datagram of \p size bytes.
+ * \return false if it is not a datagram of this version of the transport
+ */
+bool gnss_synchro_transport_parse_header(const uint8_t* buffer, size_t size, uint8_t& kind, uint8_t& node, uint64_t& sequence);
+
+/*!
+ * \brief Archives the navigation data of a telemetry message, held as a
+ * std::shared_ptr in \p telemetry, into \p payload, preceded by its type.
+ * \return false if that kind of data is not forwarded (Galileo almanac helpers)
+ */
+bool gnss_navigation_encode(const boost::any& telemetry, std::string& payload);
+
+/*!
+ * \brief Rebuilds the telemetry message archived by gnss_navigation_encode()
+ * \return pmt::PMT_NIL if the payload is corrupted or of an unknown type
+ */
+pmt::pmt_t gnss_navigation_decode(const uint8_t* payload, size_t size);
+
+#endif
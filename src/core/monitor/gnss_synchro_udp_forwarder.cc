@@ -0,0 +1,220 @@
+/*!
+ * \file gnss_synchro_udp_forwarder.cc
+ * \brief Sends the outputs of the channels and of the sample counter of a
+ * channels node, and its navigation data, to the PVT node of a distributed
+ * receiver.
+ *
+ * -------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2019  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *          Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------
+ */
+
+#include "gnss_synchro_udp_forwarder.h"
+#include "gnss_synchro_transport.h"
+#include "monitor_le_encoding.h"
+#include <boost/any.hpp>
+#include <boost/bind.hpp>
+#include <glog/logging.h>
+#include <gnuradio/io_signature.h>
+#include <algorithm>
+#include <exception>
+
+
+gnss_synchro_udp_forwarder_sptr gnss_synchro_make_udp_forwarder(unsigned int nchannels,
+    const std::string& address,
+    uint16_t port,
+    uint8_t node,
+    unsigned int channel_offset)
+{
+    return gnss_synchro_udp_forwarder_sptr(new gnss_synchro_udp_forwarder(nchannels, address, port, node, channel_offset));
+}
+
+
+gnss_synchro_udp_forwarder::gnss_synchro_udp_forwarder(unsigned int nchannels,
+    const std::string& address,
+    uint16_t port,
+    uint8_t node,
+    unsigned int channel_offset) : gr::block("gnss_synchro_udp_forwarder",
+                                       gr::io_signature::make(nchannels + 1, nchannels + 1, sizeof(Gnss_Synchro)),
+                                       gr::io_signature::make(0, 0, 0)),
+                                   d_socket{d_io_service}
+{
+    d_nchannels = nchannels;
+    d_node = node;
+    d_channel_offset = channel_offset;
+    d_sample_index_known = false;
+    d_sample_index = 0;
+    d_sequence = 0;
+    d_datagram.resize(GNSS_SYNCHRO_TRANSPORT_MAX_DATAGRAM);
+    d_datagram_bytes = 0;
+    d_records = 0;
+    d_send_errors = 0;
+
+    boost::system::error_code error;
+    boost::asio::ip::address ip = boost::asio::ip::address::from_string(address, error);
+    if (error or !ip.is_v4())
+        {
+            LOG(WARNING) << "Invalid IPv4 address of the PVT node " << address;
+        }
+    d_endpoint = boost::asio::ip::udp::endpoint(ip, port);
+    d_socket.open(boost::asio::ip::udp::v4(), error);
+    if (error)
+        {
+            LOG(WARNING) << "Cannot open the UDP socket to the PVT node: " << error.message();
+        }
+    else if (ip.is_multicast())
+        {
+            d_socket.set_option(boost::asio::ip::multicast::hops(1), error);
+        }
+
+    this->message_port_register_in(pmt::mp("telemetry"));
+    this->set_msg_handler(pmt::mp("telemetry"), boost::bind(&gnss_synchro_udp_forwarder::msg_handler_telemetry, this, _1));
+}
+
+
+gnss_synchro_udp_forwarder::~gnss_synchro_udp_forwarder()
+{
+    if (d_send_errors > 0)
+        {
+            LOG(WARNING) << d_send_errors << " datagrams could not be sent to the PVT node";
+        }
+}
+
+
+void gnss_synchro_udp_forwarder::msg_handler_telemetry(pmt::pmt_t msg)
+{
+    std::string payload;
+    try
+        {
+            if (!gnss_navigation_encode(pmt::any_ref(msg), payload))
+                {
+                    return;
+                }
+        }
+    catch (const std::exception& e)
+        {
+            LOG(WARNING) << "Navigation data not forwarded: " << e.what();
+            return;
+        }
+    std::vector<uint8_t> datagram(GNSS_SYNCHRO_TRANSPORT_HEADER_SIZE + payload.size());
+    std::lock_guard<std::mutex> lock(d_mutex);
+    gnss_synchro_transport_header(datagram.data(), GNSS_SYNCHRO_TRANSPORT_NAVIGATION, d_node, d_sequence++);
+    std::copy(payload.begin(), payload.end(), datagram.begin() + GNSS_SYNCHRO_TRANSPORT_HEADER_SIZE);
+    boost::system::error_code error;
+    d_socket.send_to(boost::asio::buffer(datagram), d_endpoint, 0, error);
+    if (error)
+        {
+            d_send_errors++;
+        }
+}
+
+
+void gnss_synchro_udp_forwarder::forecast(int noutput_items __attribute__((unused)), gr_vector_int& ninput_items_required)
+{
+    for (unsigned int n = 0; n < d_nchannels; n++)
+        {
+            ninput_items_required[n] = 0;
+        }
+    // the items are sent with each sample counter item
+    ninput_items_required[d_nchannels] = 1;
+}
+
+
+void gnss_synchro_udp_forwarder::add_record(uint16_t stream, const Gnss_Synchro& gnss_synchro)
+{
+    if (d_datagram_bytes + GNSS_SYNCHRO_TRANSPORT_RECORD_SIZE > GNSS_SYNCHRO_UDP_MAX_DATAGRAM)
+        {
+            send_datagram();
+        }
+    if (d_records == 0)
+        {
+            // header and number of records, written when the datagram is sent
+            d_datagram_bytes = GNSS_SYNCHRO_TRANSPORT_HEADER_SIZE + 2;
+        }
+    put_le(d_datagram.data(), d_datagram_bytes, stream);
+    Gnss_Synchro absolute = gnss_synchro;
+    absolute.Tracking_sample_counter += d_sample_index;
+    absolute.Acq_samplestamp_samples += d_sample_index;
+    if (stream != GNSS_SYNCHRO_TRANSPORT_CLOCK_STREAM)
+        {
+            absolute.Channel_ID += d_channel_offset;
+        }
+    gnss_synchro_encode(absolute, d_datagram.data() + d_datagram_bytes);
+    d_datagram_bytes += GNSS_SYNCHRO_RECORD_SIZE;
+    d_records++;
+}
+
+
+void gnss_synchro_udp_forwarder::send_datagram()
+{
+    if (d_records == 0)
+        {
+            return;
+        }
+    std::lock_guard<std::mutex> lock(d_mutex);
+    size_t offset = gnss_synchro_transport_header(d_datagram.data(), GNSS_SYNCHRO_TRANSPORT_OBSERVABLES, d_node, d_sequence++);
+    put_le(d_datagram.data(), offset, d_records);
+    boost::system::error_code error;
+    d_socket.send_to(boost::asio::buffer(d_datagram.data(), d_datagram_bytes), d_endpoint, 0, error);
+    if (error)
+        {
+            d_send_errors++;
+        }
+    d_records = 0;
+    d_datagram_bytes = 0;
+}
+
+
+int gnss_synchro_udp_forwarder::general_work(int noutput_items __attribute__((unused)), gr_vector_int& ninput_items,
+    gr_vector_const_void_star& input_items, gr_vector_void_star& output_items __attribute__((unused)))
+{
+    // a block without outputs is called whenever one of its inputs has items
+    if (ninput_items[d_nchannels] == 0)
+        {
+            return 0;
+        }
+    const auto** in = reinterpret_cast<const Gnss_Synchro**>(&input_items[0]);
+    if (!d_sample_index_known)
+        {
+            std::vector<gr::tag_t> tags;
+            get_tags_in_range(tags, d_nchannels, nitems_read(d_nchannels), nitems_read(d_nchannels) + 1, pmt::mp("sample_index"));
+            d_sample_index = tags.empty() ? 0 : pmt::to_uint64(tags.front().value);
+            d_sample_index_known = true;
+            LOG(INFO) << "First sample of this node: " << d_sample_index << " of the stream of the source node";
+        }
+    for (unsigned int n = 0; n < d_nchannels; n++)
+        {
+            for (int m = 0; m < ninput_items[n]; m++)
+                {
+                    add_record(static_cast<uint16_t>(d_channel_offset + n), in[n][m]);
+                }
+            consume(n, ninput_items[n]);
+        }
+    for (int m = 0; m < ninput_items[d_nchannels]; m++)
+        {
+            add_record(GNSS_SYNCHRO_TRANSPORT_CLOCK_STREAM, in[d_nchannels][m]);
+        }
+    consume(d_nchannels, ninput_items[d_nchannels]);
+    send_datagram();
+    return 0;
+}
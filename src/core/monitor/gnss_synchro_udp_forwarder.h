@@ -0,0 +1,113 @@
+/*!
+ * \file gnss_synchro_udp_forwarder.h
+ * \brief Sends the outputs of the channels and of the sample counter of a
+ * channels node, and its navigation data, to the PVT node of a distributed
+ * receiver.
+ *
+ * -------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2019  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *          Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_GNSS_SYNCHRO_UDP_FORWARDER_H_
+#define GNSS_SDR_GNSS_SYNCHRO_UDP_FORWARDER_H_
+
+#include "gnss_synchro.h"
+#include <boost/asio.hpp>
+#include <gnuradio/block.h>
+#include <pmt/pmt.h>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <vector>
+
+
+class gnss_synchro_udp_forwarder;
+
+typedef boost::shared_ptr<gnss_synchro_udp_forwarder> gnss_synchro_udp_forwarder_sptr;
+
+/*!
+ * \brief Makes a forwarder of \p nchannels channels. Its input \p nchannels
+ * is the sample counter.
+ */
+gnss_synchro_udp_forwarder_sptr gnss_synchro_make_udp_forwarder(unsigned int nchannels,
+    const std::string& address,
+    uint16_t port,
+    uint8_t node,
+    unsigned int channel_offset);
+
+/*!
+ * \brief Sends the Gnss_Synchro items of its inputs to the PVT node, where
+ * the channel i of this node is the input channel_offset + i of the
+ * observables block. The sample counters are made absolute, adding the
+ * index of the first sample received by the node (tag "sample_index" of the
+ * first sample counter item), so that the PVT node can align the channels
+ * of all the nodes. The items seen by each call are sent together, when a
+ * sample counter item is available. The navigation data received in the
+ * "telemetry" message port is sent at once.
+ */
+class gnss_synchro_udp_forwarder : public gr::block
+{
+public:
+    ~gnss_synchro_udp_forwarder();
+
+    void forecast(int noutput_items, gr_vector_int& ninput_items_required);
+
+    int general_work(int noutput_items, gr_vector_int& ninput_items,
+        gr_vector_const_void_star& input_items, gr_vector_void_star& output_items);
+
+private:
+    friend gnss_synchro_udp_forwarder_sptr gnss_synchro_make_udp_forwarder(unsigned int nchannels,
+        const std::string& address,
+        uint16_t port,
+        uint8_t node,
+        unsigned int channel_offset);
+
+    gnss_synchro_udp_forwarder(unsigned int nchannels,
+        const std::string& address,
+        uint16_t port,
+        uint8_t node,
+        unsigned int channel_offset);
+
+    void msg_handler_telemetry(pmt::pmt_t msg);
+    void add_record(uint16_t stream, const Gnss_Synchro& gnss_synchro);
+    void send_datagram();
+
+    unsigned int d_nchannels;
+    uint8_t d_node;
+    unsigned int d_channel_offset;
+    bool d_sample_index_known;
+    uint64_t d_sample_index;  // index, in the stream of the source node, of the first sample of this node
+
+    std::mutex d_mutex;  // the telemetry arrives in the thread of the message handler
+    uint64_t d_sequence;
+    boost::asio::io_service d_io_service;
+    boost::asio::ip::udp::socket d_socket;
+    boost::asio::ip::udp::endpoint d_endpoint;
+    std::vector<uint8_t> d_datagram;
+    size_t d_datagram_bytes;
+    uint16_t d_records;
+    uint64_t d_send_errors;
+};
+
+#endif
@@ -0,0 +1,277 @@
+/*!
+ * \file gnss_synchro_udp_receiver.cc
+ * \brief Receives, in the PVT node of a distributed receiver, the outputs
+ * of the channels and the navigation data sent by the channels nodes.
+ *
+ * -------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2019  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *          Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------
+ */
+
+#include "gnss_synchro_udp_receiver.h"
+#include "gnss_synchro_transport.h"
+#include "monitor_le_encoding.h"
+#include <glog/logging.h>
+#include <gnuradio/io_signature.h>
+#include <pmt/pmt.h>
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+
+gnss_synchro_udp_receiver_sptr gnss_synchro_make_udp_receiver(unsigned int nchannels,
+    const std::string& address,
+    uint16_t port,
+    uint8_t clock_node)
+{
+    return gnss_synchro_udp_receiver_sptr(new gnss_synchro_udp_receiver(nchannels, address, port, clock_node));
+}
+
+
+gnss_synchro_udp_receiver::gnss_synchro_udp_receiver(unsigned int nchannels,
+    const std::string& address,
+    uint16_t port,
+    uint8_t clock_node) : gr::block("gnss_synchro_udp_receiver",
+                              gr::io_signature::make(0, 0, 0),
+                              gr::io_signature::make(nchannels + 1, nchannels + 1, sizeof(Gnss_Synchro)))
+{
+    d_nchannels = nchannels;
+    d_address = address;
+    d_port = port;
+    d_clock_node = clock_node;
+    d_socket = -1;
+    d_stop = false;
+    d_queues.resize(nchannels + 1);
+    d_lost_datagrams = 0;
+    // the receiver time is driven by the sample counter, its tags are added here
+    set_tag_propagation_policy(TPP_DONT);
+    this->message_port_register_out(pmt::mp("telemetry"));
+}
+
+
+gnss_synchro_udp_receiver::~gnss_synchro_udp_receiver()
+{
+    if (d_socket >= 0)
+        {
+            close(d_socket);
+        }
+}
+
+
+bool gnss_synchro_udp_receiver::open_socket()
+{
+    d_socket = socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+    if (d_socket == -1)
+        {
+            LOG(ERROR) << "Error opening the UDP socket of the channels nodes";
+            return false;
+        }
+    int enable = 1;
+    setsockopt(d_socket, SOL_SOCKET, SO_REUSEADDR, &enable, sizeof(enable));
+
+    // A timeout lets the receive thread check regularly whether it has to stop
+    struct timeval timeout;
+    timeout.tv_sec = 0;
+    timeout.tv_usec = 100000;
+    setsockopt(d_socket, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+
+    struct sockaddr_in local;
+    std::memset(&local, 0, sizeof(local));
+    local.sin_family = AF_INET;
+    local.sin_port = htons(d_port);
+    local.sin_addr.s_addr = htonl(INADDR_ANY);
+    if (bind(d_socket, reinterpret_cast<struct sockaddr*>(&local), sizeof(local)) == -1)
+        {
+            LOG(ERROR) << "Error binding the UDP socket of the channels nodes to port " << d_port;
+            return false;
+        }
+
+    struct in_addr group;
+    if ((inet_aton(d_address.c_str(), &group) != 0) and IN_MULTICAST(ntohl(group.s_addr)))
+        {
+            struct ip_mreq membership;
+            membership.imr_multiaddr = group;
+            membership.imr_interface.s_addr = htonl(INADDR_ANY);
+            if (setsockopt(d_socket, IPPROTO_IP, IP_ADD_MEMBERSHIP, &membership, sizeof(membership)) == -1)
+                {
+                    LOG(ERROR) << "Unable to join the multicast group " << d_address;
+                    return false;
+                }
+        }
+    return true;
+}
+
+
+bool gnss_synchro_udp_receiver::start()
+{
+    if (!open_socket())
+        {
+            return false;
+        }
+    d_stop = false;
+    d_thread = std::thread(&gnss_synchro_udp_receiver::receive_thread, this);
+    return true;
+}
+
+
+bool gnss_synchro_udp_receiver::stop()
+{
+    d_stop = true;
+    d_received.notify_all();
+    if (d_thread.joinable())
+        {
+            d_thread.join();
+        }
+    if (d_socket >= 0)
+        {
+            close(d_socket);
+            d_socket = -1;
+        }
+    if (d_lost_datagrams > 0)
+        {
+            LOG(WARNING) << d_lost_datagrams << " datagrams of the channels nodes were lost";
+        }
+    return true;
+}
+
+
+void gnss_synchro_udp_receiver::receive_thread()
+{
+    std::vector<uint8_t> datagram(GNSS_SYNCHRO_TRANSPORT_MAX_DATAGRAM);
+    while (!d_stop.load())
+        {
+            ssize_t bytes = recv(d_socket, datagram.data(), datagram.size(), 0);
+            if (bytes <= 0)
+                {
+                    continue;
+                }
+            uint8_t kind;
+            uint8_t node;
+            uint64_t sequence;
+            if (!gnss_synchro_transport_parse_header(datagram.data(), bytes, kind, node, sequence))
+                {
+                    continue;
+                }
+            auto next_sequence = d_next_sequence.find(node);
+            if (next_sequence != d_next_sequence.end())
+                {
+                    if (sequence < next_sequence->second)
+                        {
+                            // late: the records of its streams have already been passed over
+                            continue;
+                        }
+                    d_lost_datagrams += sequence - next_sequence->second;
+                }
+            d_next_sequence[node] = sequence + 1;
+
+            const uint8_t* payload = datagram.data() + GNSS_SYNCHRO_TRANSPORT_HEADER_SIZE;
+            size_t payload_bytes = bytes - GNSS_SYNCHRO_TRANSPORT_HEADER_SIZE;
+            if (kind == GNSS_SYNCHRO_TRANSPORT_OBSERVABLES)
+                {
+                    parse_observables(node, payload, payload_bytes);
+                }
+            else if (kind == GNSS_SYNCHRO_TRANSPORT_NAVIGATION)
+                {
+                    pmt::pmt_t msg = gnss_navigation_decode(payload, payload_bytes);
+                    if (!pmt::is_null(msg))
+                        {
+                            this->message_port_pub(pmt::mp("telemetry"), msg);
+                        }
+                }
+        }
+}
+
+
+void gnss_synchro_udp_receiver::parse_observables(uint8_t node, const uint8_t* payload, size_t size)
+{
+    if (size < 2)
+        {
+            return;
+        }
+    size_t offset = 0;
+    uint16_t records;
+    get_le(payload, offset, records);
+    records = std::min(records, static_cast<uint16_t>((size - offset) / GNSS_SYNCHRO_TRANSPORT_RECORD_SIZE));
+    int64_t arrival_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+    {
+        std::lock_guard<std::mutex> lock(d_mutex);
+        for (uint16_t r = 0; r < records; r++)
+            {
+                uint16_t stream;
+                get_le(payload, offset, stream);
+                Gnss_Synchro gnss_synchro;
+                gnss_synchro_decode(payload + offset, gnss_synchro);
+                offset += GNSS_SYNCHRO_RECORD_SIZE;
+                if (stream == GNSS_SYNCHRO_TRANSPORT_CLOCK_STREAM)
+                    {
+                        // every channels node sends its sample counter, only one of them drives the observables
+                        if (node == d_clock_node)
+                            {
+                                d_queues[d_nchannels].push_back(gnss_synchro);
+                                d_clock_arrival.push_back(arrival_ns);
+                            }
+                    }
+                else if (stream < d_nchannels)
+                    {
+                        d_queues[stream].push_back(gnss_synchro);
+                    }
+                else
+                    {
+                        LOG_FIRST_N(WARNING, 1) << "Node " << static_cast<int>(node) << " sends channel " << stream << ", but the PVT node has " << d_nchannels << " channels";
+                    }
+            }
+    }
+    d_received.notify_one();
+}
+
+
+int gnss_synchro_udp_receiver::general_work(int noutput_items, gr_vector_int& ninput_items __attribute__((unused)),
+    gr_vector_const_void_star& input_items __attribute__((unused)), gr_vector_void_star& output_items)
+{
+    auto** out = reinterpret_cast<Gnss_Synchro**>(&output_items[0]);
+    std::unique_lock<std::mutex> lock(d_mutex);
+    d_received.wait_for(lock, std::chrono::milliseconds(100), [this] {
+        return d_stop.load() or std::any_of(d_queues.begin(), d_queues.end(), [](const std::deque<Gnss_Synchro>& queue) { return !queue.empty(); });
+    });
+    for (unsigned int n = 0; n <= d_nchannels; n++)
+        {
+            std::deque<Gnss_Synchro>& queue = d_queues[n];
+            int items = std::min(static_cast<int>(queue.size()), noutput_items);
+            for (int m = 0; m < items; m++)
+                {
+                    out[n][m] = queue.front();
+                    queue.pop_front();
+                    if (n == d_nchannels)
+                        {
+                            add_item_tag(n, nitems_written(n) + m, pmt::mp("arrival_time"), pmt::from_uint64(static_cast<uint64_t>(d_clock_arrival.front())));
+                            d_clock_arrival.pop_front();
+                        }
+                }
+            produce(n, items);
+        }
+    return WORK_CALLED_PRODUCE;
+}
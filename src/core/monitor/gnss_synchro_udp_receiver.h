@@ -0,0 +1,111 @@
+/*!
+ * \file gnss_synchro_udp_receiver.h
+ * \brief Receives, in the PVT node of a distributed receiver, the outputs
+ * of the channels and the navigation data sent by the channels nodes.
+ *
+ * -------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2019  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *          Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_GNSS_SYNCHRO_UDP_RECEIVER_H_
+#define GNSS_SDR_GNSS_SYNCHRO_UDP_RECEIVER_H_
+
+#include "gnss_synchro.h"
+#include <gnuradio/block.h>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+
+class gnss_synchro_udp_receiver;
+
+typedef boost::shared_ptr<gnss_synchro_udp_receiver> gnss_synchro_udp_receiver_sptr;
+
+/*!
+ * \brief Makes a receiver of the \p nchannels channels of all the channels
+ * nodes, listening on \p port. If \p address is a multicast group, the
+ * receiver joins it. The sample counter output, \p nchannels, follows the
+ * sample counter of the node \p clock_node.
+ */
+gnss_synchro_udp_receiver_sptr gnss_synchro_make_udp_receiver(unsigned int nchannels,
+    const std::string& address,
+    uint16_t port,
+    uint8_t clock_node);
+
+/*!
+ * \brief Source of the inputs of the observables block in a PVT node. The
+ * records of each stream are produced in its output port, in the order in
+ * which they were received. The navigation data is published in the
+ * "telemetry" message port.
+ */
+class gnss_synchro_udp_receiver : public gr::block
+{
+public:
+    ~gnss_synchro_udp_receiver();
+
+    bool start() override;
+    bool stop() override;
+
+    int general_work(int noutput_items, gr_vector_int& ninput_items,
+        gr_vector_const_void_star& input_items, gr_vector_void_star& output_items);
+
+private:
+    friend gnss_synchro_udp_receiver_sptr gnss_synchro_make_udp_receiver(unsigned int nchannels,
+        const std::string& address,
+        uint16_t port,
+        uint8_t clock_node);
+
+    gnss_synchro_udp_receiver(unsigned int nchannels,
+        const std::string& address,
+        uint16_t port,
+        uint8_t clock_node);
+
+    bool open_socket();
+    void receive_thread();
+    void parse_observables(uint8_t node, const uint8_t* payload, size_t size);
+
+    unsigned int d_nchannels;
+    std::string d_address;
+    uint16_t d_port;
+    uint8_t d_clock_node;
+    int d_socket;
+    std::thread d_thread;
+    std::atomic<bool> d_stop;
+
+    std::mutex d_mutex;  // protects the queues, filled by the receive thread
+    std::condition_variable d_received;
+    std::vector<std::deque<Gnss_Synchro>> d_queues;  // one per output port
+    std::deque<int64_t> d_clock_arrival;             // steady clock time when each sample counter record arrived, in ns
+
+    std::map<uint8_t, uint64_t> d_next_sequence;  // of each node
+    uint64_t d_lost_datagrams;
+};
+
+#endif
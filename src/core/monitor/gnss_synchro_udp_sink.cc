@@ -1,7 +1,7 @@
 /*!
  * \file gnss_synchro_udp_sink.cc
- * \brief Implementation of a class that sends serialized Gnss_Synchro
- * objects over udp to one or multiple endponits
+ * \brief Implementation of a class that sends Gnss_Synchro objects in a compact binary format
+ * over udp to one or multiple endponits
  * \author Álvaro Cebrián Juan, 2018. acebrianjuan(at)gmail.com
  *
  * -------------------------------------------------------------------------
@@ -30,40 +30,199 @@
  */
 
 #include "gnss_synchro_udp_sink.h"
-#include <boost/archive/binary_oarchive.hpp>
-#include <boost/serialization/vector.hpp>
-#include <iostream>
-#include <sstream>
+#include "monitor_le_encoding.h"
+#include <glog/logging.h>
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
 
-Gnss_Synchro_Udp_Sink::Gnss_Synchro_Udp_Sink(std::vector<std::string> addresses, const uint16_t& port) : socket{io_service}
+
+Gnss_Synchro_Udp_Sink::Gnss_Synchro_Udp_Sink(const std::vector<std::string>& addresses, const uint16_t& port) : socket{io_service}
 {
-    for (auto address : addresses)
+    bool multicast = false;
+    for (const auto& address : addresses)
+        {
+            boost::asio::ip::address ip = boost::asio::ip::address::from_string(address, error);
+            if (error or !ip.is_v4())
+                {
+                    LOG(WARNING) << "Monitor: invalid IPv4 address " << address;
+                    continue;
+                }
+            multicast = multicast or ip.is_multicast();
+            endpoints.emplace_back(ip, port);
+        }
+    // one socket for all the endpoints, opened once
+    socket.open(boost::asio::ip::udp::v4(), error);
+    if (error)
+        {
+            LOG(WARNING) << "Monitor: cannot open the UDP socket: " << error.message();
+        }
+    else if (multicast)
         {
-            boost::asio::ip::udp::endpoint endpoint(boost::asio::ip::address::from_string(address, error), port);
-            endpoints.push_back(endpoint);
+            socket.set_option(boost::asio::ip::multicast::hops(1), error);
         }
 }
 
-bool Gnss_Synchro_Udp_Sink::write_gnss_synchro(std::vector<Gnss_Synchro> stocks)
+
+void gnss_synchro_encode(const Gnss_Synchro& gnss_synchro, uint8_t* record)
 {
-    std::ostringstream archive_stream;
-    boost::archive::binary_oarchive oa{archive_stream};
-    oa << stocks;
-    std::string outbound_data = archive_stream.str();
+    size_t offset = 0;
+    // Satellite and signal info
+    put_le(record, offset, static_cast<uint8_t>(gnss_synchro.System));
+    for (int i = 0; i < 3; i++) put_le(record, offset, static_cast<uint8_t>(gnss_synchro.Signal[i]));
+    put_le(record, offset, gnss_synchro.PRN);
+    put_le(record, offset, gnss_synchro.Channel_ID);
+    // Acquisition
+    put_le(record, offset, gnss_synchro.Acq_delay_samples);
+    put_le(record, offset, gnss_synchro.Acq_doppler_hz);
+    put_le(record, offset, gnss_synchro.Acq_samplestamp_samples);
+    put_le(record, offset, gnss_synchro.Acq_doppler_step);
+    put_le(record, offset, gnss_synchro.Flag_valid_acquisition);
+    put_le(record, offset, gnss_synchro.Acq_doppler_aiding_hz);
+    put_le(record, offset, gnss_synchro.Acq_doppler_uncertainty_hz);
+    // Tracking
+    put_le(record, offset, gnss_synchro.fs);
+    put_le(record, offset, gnss_synchro.Prompt_I);
+    put_le(record, offset, gnss_synchro.Prompt_Q);
+    put_le(record, offset, gnss_synchro.CN0_dB_hz);
+    put_le(record, offset, gnss_synchro.Carrier_Doppler_hz);
+    put_le(record, offset, gnss_synchro.Carrier_phase_rads);
+    put_le(record, offset, gnss_synchro.Code_phase_samples);
+    put_le(record, offset, gnss_synchro.Tracking_sample_counter);
+    put_le(record, offset, gnss_synchro.Flag_valid_symbol_output);
+    put_le(record, offset, gnss_synchro.correlation_length_ms);
+    // Telemetry Decoder
+    put_le(record, offset, gnss_synchro.Flag_valid_word);
+    put_le(record, offset, gnss_synchro.TOW_at_current_symbol_ms);
+    // Observables
+    put_le(record, offset, gnss_synchro.Pseudorange_m);
+    put_le(record, offset, gnss_synchro.RX_time);
+    put_le(record, offset, gnss_synchro.Flag_valid_pseudorange);
+    put_le(record, offset, gnss_synchro.interp_TOW_ms);
+}
+
 
-    for (auto endpoint : endpoints)
+void gnss_synchro_decode(const uint8_t* record, Gnss_Synchro& gnss_synchro)
+{
+    size_t offset = 0;
+    uint8_t character;
+    // Satellite and signal info
+    get_le(record, offset, character);
+    gnss_synchro.System = static_cast<char>(character);
+    for (int i = 0; i < 3; i++)
         {
-            socket.open(endpoint.protocol(), error);
-            socket.connect(endpoint, error);
+            get_le(record, offset, character);
+            gnss_synchro.Signal[i] = static_cast<char>(character);
+        }
+    get_le(record, offset, gnss_synchro.PRN);
+    get_le(record, offset, gnss_synchro.Channel_ID);
+    // Acquisition
+    get_le(record, offset, gnss_synchro.Acq_delay_samples);
+    get_le(record, offset, gnss_synchro.Acq_doppler_hz);
+    get_le(record, offset, gnss_synchro.Acq_samplestamp_samples);
+    get_le(record, offset, gnss_synchro.Acq_doppler_step);
+    get_le(record, offset, gnss_synchro.Flag_valid_acquisition);
+    get_le(record, offset, gnss_synchro.Acq_doppler_aiding_hz);
+    get_le(record, offset, gnss_synchro.Acq_doppler_uncertainty_hz);
+    // Tracking
+    get_le(record, offset, gnss_synchro.fs);
+    get_le(record, offset, gnss_synchro.Prompt_I);
+    get_le(record, offset, gnss_synchro.Prompt_Q);
+    get_le(record, offset, gnss_synchro.CN0_dB_hz);
+    get_le(record, offset, gnss_synchro.Carrier_Doppler_hz);
+    get_le(record, offset, gnss_synchro.Carrier_phase_rads);
+    get_le(record, offset, gnss_synchro.Code_phase_samples);
+    get_le(record, offset, gnss_synchro.Tracking_sample_counter);
+    get_le(record, offset, gnss_synchro.Flag_valid_symbol_output);
+    get_le(record, offset, gnss_synchro.correlation_length_ms);
+    // Telemetry Decoder
+    get_le(record, offset, gnss_synchro.Flag_valid_word);
+    get_le(record, offset, gnss_synchro.TOW_at_current_symbol_ms);
+    // Observables
+    get_le(record, offset, gnss_synchro.Pseudorange_m);
+    get_le(record, offset, gnss_synchro.RX_time);
+    get_le(record, offset, gnss_synchro.Flag_valid_pseudorange);
+    get_le(record, offset, gnss_synchro.interp_TOW_ms);
+}
+
 
-            try
+bool Gnss_Synchro_Udp_Sink::write_gnss_synchro(const std::vector<Gnss_Synchro>& stocks)
+{
+    if (stocks.empty() or endpoints.empty())
+        {
+            return true;
+        }
+    const size_t records_per_datagram = (GNSS_SYNCHRO_UDP_MAX_DATAGRAM - GNSS_SYNCHRO_UDP_HEADER_SIZE) / GNSS_SYNCHRO_RECORD_SIZE;
+    const size_t n_datagrams = (stocks.size() + records_per_datagram - 1) / records_per_datagram;
+    if (datagrams.size() < n_datagrams * GNSS_SYNCHRO_UDP_MAX_DATAGRAM)
+        {
+            datagrams.resize(n_datagrams * GNSS_SYNCHRO_UDP_MAX_DATAGRAM);
+        }
+    datagram_sizes.resize(n_datagrams);
+    for (size_t d = 0; d < n_datagrams; d++)
+        {
+            uint8_t* datagram = datagrams.data() + d * GNSS_SYNCHRO_UDP_MAX_DATAGRAM;
+            size_t first = d * records_per_datagram;
+            size_t count = std::min(records_per_datagram, stocks.size() - first);
+            size_t offset = 0;
+            put_le(datagram, offset, GNSS_SYNCHRO_UDP_MAGIC);
+            put_le(datagram, offset, GNSS_SYNCHRO_UDP_VERSION);
+            put_le(datagram, offset, static_cast<uint16_t>(count));
+            for (size_t i = 0; i < count; i++)
                 {
-                    socket.send(boost::asio::buffer(outbound_data));
+                    gnss_synchro_encode(stocks[first + i], datagram + offset);
+                    offset += GNSS_SYNCHRO_RECORD_SIZE;
                 }
-            catch (boost::system::system_error const& e)
+            datagram_sizes[d] = offset;
+        }
+
+#ifdef __linux__
+    // all the datagrams to all the endpoints in as few system calls as possible
+    const size_t n_messages = n_datagrams * endpoints.size();
+    messages.resize(n_messages);
+    iovecs.resize(n_messages);
+    for (size_t e = 0; e < endpoints.size(); e++)
+        {
+            for (size_t d = 0; d < n_datagrams; d++)
                 {
+                    size_t m = e * n_datagrams + d;
+                    iovecs[m].iov_base = datagrams.data() + d * GNSS_SYNCHRO_UDP_MAX_DATAGRAM;
+                    iovecs[m].iov_len = datagram_sizes[d];
+                    std::memset(&messages[m], 0, sizeof(struct mmsghdr));
+                    messages[m].msg_hdr.msg_name = endpoints[e].data();
+                    messages[m].msg_hdr.msg_namelen = endpoints[e].size();
+                    messages[m].msg_hdr.msg_iov = &iovecs[m];
+                    messages[m].msg_hdr.msg_iovlen = 1;
+                }
+        }
+    size_t sent = 0;
+    while (sent < n_messages)
+        {
+            int result = sendmmsg(socket.native_handle(), messages.data() + sent, static_cast<unsigned int>(n_messages - sent), 0);
+            if (result < 0)
+                {
+                    if (errno == EINTR)
+                        {
+                            continue;
+                        }
                     return false;
                 }
+            sent += static_cast<size_t>(result);
         }
     return true;
+#else
+    bool sent = true;
+    for (const auto& endpoint : endpoints)
+        {
+            for (size_t d = 0; d < n_datagrams; d++)
+                {
+                    socket.send_to(boost::asio::buffer(datagrams.data() + d * GNSS_SYNCHRO_UDP_MAX_DATAGRAM, datagram_sizes[d]), endpoint, 0, error);
+                    if (error)
+                        {
+                            sent = false;
+                        }
+                }
+        }
+    return sent;
+#endif
 }
@@ -1,6 +1,6 @@
 /*!
  * \file gnss_synchro_udp_sink.h
- * \brief Interface of a class that sends serialized Gnss_Synchro objects
+ * \brief Interface of a class that sends Gnss_Synchro objects in a compact binary format
  * over udp to one or multiple endponits
  * \author Álvaro Cebrián Juan, 2018. acebrianjuan(at)gmail.com
  *
@@ -34,19 +34,57 @@
 
 #include "gnss_synchro.h"
 #include <boost/asio.hpp>
+#include <cstdint>
+#include <string>
+#include <vector>
+#ifdef __linux__
+#include <sys/socket.h>
+#endif
+
+/*!
+ * \brief Sends the observables of each epoch to one or several endpoints.
+ *
+ * Wire format, little-endian: every datagram starts with the magic number
+ * GNSS_SYNCHRO_UDP_MAGIC (uint32), GNSS_SYNCHRO_UDP_VERSION (uint16) and the
+ * number of records (uint16), followed by records of GNSS_SYNCHRO_RECORD_SIZE
+ * bytes with the members of Gnss_Synchro in the order of its serialize()
+ * function (bools as one byte). The records of an epoch are split in
+ * datagrams of at most GNSS_SYNCHRO_UDP_MAX_DATAGRAM bytes.
+ */
+const uint32_t GNSS_SYNCHRO_UDP_MAGIC = 0x4E595347;  // "GSYN" in little-endian order
+const uint16_t GNSS_SYNCHRO_UDP_VERSION = 1;
+const size_t GNSS_SYNCHRO_UDP_HEADER_SIZE = 8;
+const size_t GNSS_SYNCHRO_RECORD_SIZE = 1 + 3 + 4 + 4 + 8 + 8 + 8 + 4 + 1 + 8 + 8 + 8 + 8 + 8 + 8 + 8 + 8 + 8 + 8 + 1 + 4 + 1 + 4 + 8 + 8 + 1 + 8;
+const size_t GNSS_SYNCHRO_UDP_MAX_DATAGRAM = 1400;  // fits in an Ethernet frame
+
+/*!
+ * \brief Writes \p gnss_synchro in the GNSS_SYNCHRO_RECORD_SIZE bytes at \p record
+ */
+void gnss_synchro_encode(const Gnss_Synchro& gnss_synchro, uint8_t* record);
+
+/*!
+ * \brief Reads a record written by gnss_synchro_encode()
+ */
+void gnss_synchro_decode(const uint8_t* record, Gnss_Synchro& gnss_synchro);
 
 class Gnss_Synchro_Udp_Sink
 {
 public:
-    Gnss_Synchro_Udp_Sink(std::vector<std::string> addresses, const uint16_t &port);
-    bool write_gnss_synchro(std::vector<Gnss_Synchro> stocks);
+    Gnss_Synchro_Udp_Sink(const std::vector<std::string>& addresses, const uint16_t& port);
+    bool write_gnss_synchro(const std::vector<Gnss_Synchro>& stocks);
 
 private:
     boost::asio::io_service io_service;
     boost::asio::ip::udp::socket socket;
     boost::system::error_code error;
     std::vector<boost::asio::ip::udp::endpoint> endpoints;
-    std::vector<Gnss_Synchro> stocks;
+    // datagrams of the current epoch, reused from one call to the next
+    std::vector<uint8_t> datagrams;
+    std::vector<size_t> datagram_sizes;
+#ifdef __linux__
+    std::vector<struct mmsghdr> messages;
+    std::vector<struct iovec> iovecs;
+#endif
 };
 
 
@@ -0,0 +1,84 @@
+/*!
+ * \file monitor_le_encoding.h
+ * \brief Fixed little-endian encoding of the monitor records
+ *
+ * -------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2018  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *          Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_MONITOR_LE_ENCODING_H_
+#define GNSS_SDR_MONITOR_LE_ENCODING_H_
+
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+/*!
+ * \brief Writes an integer or a bool at buffer + offset in little-endian
+ * order, whatever the byte order of the host, and advances offset.
+ */
+template <typename T>
+inline void put_le(uint8_t* buffer, size_t& offset, T value)
+{
+    static_assert(std::is_integral<T>::value, "put_le: integral type expected");
+    for (size_t i = 0; i < sizeof(T); i++)
+        {
+            buffer[offset++] = static_cast<uint8_t>((static_cast<uint64_t>(value) >> (8 * i)) & 0xFF);
+        }
+}
+
+
+inline void put_le(uint8_t* buffer, size_t& offset, double value)
+{
+    uint64_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    put_le(buffer, offset, bits);
+}
+
+
+/*!
+ * \brief Reads an integer or a bool written by put_le() at buffer + offset,
+ * and advances offset.
+ */
+template <typename T>
+inline void get_le(const uint8_t* buffer, size_t& offset, T& value)
+{
+    static_assert(std::is_integral<T>::value, "get_le: integral type expected");
+    uint64_t bits = 0;
+    for (size_t i = 0; i < sizeof(T); i++)
+        {
+            bits |= static_cast<uint64_t>(buffer[offset++]) << (8 * i);
+        }
+    value = static_cast<T>(bits);
+}
+
+
+inline void get_le(const uint8_t* buffer, size_t& offset, double& value)
+{
+    uint64_t bits;
+    get_le(buffer, offset, bits);
+    std::memcpy(&value, &bits, sizeof(value));
+}
+
+#endif
@@ -0,0 +1,74 @@
+/*!
+ * \file monitor_pvt.h
+ * \brief Compact fixed binary record of a PVT solution, published by
+ * Pvt_Udp_Sink for the receiver monitoring clients
+ *
+ * -------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2018  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *          Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_MONITOR_PVT_H_
+#define GNSS_SDR_MONITOR_PVT_H_
+
+#include <cstdint>
+
+/*!
+ * \brief PVT solution as published by the monitor.
+ *
+ * On the wire, it takes MONITOR_PVT_RECORD_SIZE bytes, little-endian, with
+ * the fields in the order below, preceded by the magic number "GPVT"
+ * (uint32), the version (uint16) and the record size (uint16).
+ */
+struct Monitor_Pvt
+{
+    uint32_t sequence;   // incremented at every published solution
+    int32_t week;        // GPS week
+    double tow_s;        // GPS time of week of the solution [s]
+    double pos_x_m;      // position, ECEF [m]
+    double pos_y_m;
+    double pos_z_m;
+    double vel_x_m_s;    // velocity, ECEF [m/s]
+    double vel_y_m_s;
+    double vel_z_m_s;
+    double latitude_deg;   // WGS84
+    double longitude_deg;  // WGS84
+    double height_m;       // WGS84 ellipsoidal height
+    double clock_bias_s;   // receiver clock bias [s]
+    double clock_drift_s_s;  // receiver clock drift [s/s]
+    double gdop;
+    double pdop;
+    double hdop;
+    double vdop;
+    uint8_t valid_sats;  // satellites used in the solution
+    uint8_t status;      // RTKLIB solution status (SOLQ_*)
+    uint32_t latency_us;             // time spent by the solver on this epoch [us]
+    uint32_t source_overflows;       // overflow events of the signal source since the start
+    uint32_t end_to_end_latency_us;  // from the arrival of the samples to the solution [us], 0 if unknown
+};
+
+const uint32_t MONITOR_PVT_MAGIC = 0x54565047;  // "GPVT" in little-endian order
+const uint16_t MONITOR_PVT_VERSION = 3;
+const uint16_t MONITOR_PVT_RECORD_SIZE = 4 + 2 + 2 + 4 + 4 + 8 * 16 + 1 + 1 + 2 + 4 + 4 + 4;
+
+#endif
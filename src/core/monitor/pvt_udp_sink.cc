@@ -0,0 +1,105 @@
+/*!
+ * \file pvt_udp_sink.cc
+ * \brief Implementation of a class that sends the PVT solutions as
+ * Monitor_Pvt binary records over UDP, to unicast or multicast addresses
+ *
+ * -------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2018  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *          Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------
+ */
+
+#include "pvt_udp_sink.h"
+#include "monitor_le_encoding.h"
+#include <glog/logging.h>
+
+
+Pvt_Udp_Sink::Pvt_Udp_Sink(const std::vector<std::string>& addresses, const uint16_t& port) : socket{io_service}, record(MONITOR_PVT_RECORD_SIZE, 0)
+{
+    bool multicast = false;
+    for (const auto& address : addresses)
+        {
+            boost::asio::ip::address ip = boost::asio::ip::address::from_string(address, error);
+            if (error or !ip.is_v4())
+                {
+                    LOG(WARNING) << "PVT monitor: invalid IPv4 address " << address;
+                    continue;
+                }
+            multicast = multicast or ip.is_multicast();
+            endpoints.emplace_back(ip, port);
+        }
+    socket.open(boost::asio::ip::udp::v4(), error);
+    if (error)
+        {
+            LOG(WARNING) << "PVT monitor: cannot open the UDP socket: " << error.message();
+        }
+    else if (multicast)
+        {
+            socket.set_option(boost::asio::ip::multicast::hops(1), error);
+            socket.set_option(boost::asio::ip::multicast::enable_loopback(true), error);
+        }
+}
+
+
+bool Pvt_Udp_Sink::write_monitor_pvt(const Monitor_Pvt& monitor_pvt)
+{
+    size_t offset = 0;
+    put_le(record.data(), offset, MONITOR_PVT_MAGIC);
+    put_le(record.data(), offset, MONITOR_PVT_VERSION);
+    put_le(record.data(), offset, MONITOR_PVT_RECORD_SIZE);
+    put_le(record.data(), offset, monitor_pvt.sequence);
+    put_le(record.data(), offset, static_cast<uint32_t>(monitor_pvt.week));
+    put_le(record.data(), offset, monitor_pvt.tow_s);
+    put_le(record.data(), offset, monitor_pvt.pos_x_m);
+    put_le(record.data(), offset, monitor_pvt.pos_y_m);
+    put_le(record.data(), offset, monitor_pvt.pos_z_m);
+    put_le(record.data(), offset, monitor_pvt.vel_x_m_s);
+    put_le(record.data(), offset, monitor_pvt.vel_y_m_s);
+    put_le(record.data(), offset, monitor_pvt.vel_z_m_s);
+    put_le(record.data(), offset, monitor_pvt.latitude_deg);
+    put_le(record.data(), offset, monitor_pvt.longitude_deg);
+    put_le(record.data(), offset, monitor_pvt.height_m);
+    put_le(record.data(), offset, monitor_pvt.clock_bias_s);
+    put_le(record.data(), offset, monitor_pvt.clock_drift_s_s);
+    put_le(record.data(), offset, monitor_pvt.gdop);
+    put_le(record.data(), offset, monitor_pvt.pdop);
+    put_le(record.data(), offset, monitor_pvt.hdop);
+    put_le(record.data(), offset, monitor_pvt.vdop);
+    put_le(record.data(), offset, monitor_pvt.valid_sats);
+    put_le(record.data(), offset, monitor_pvt.status);
+    put_le(record.data(), offset, static_cast<uint16_t>(0));  // reserved
+    put_le(record.data(), offset, monitor_pvt.latency_us);
+    put_le(record.data(), offset, monitor_pvt.source_overflows);
+    put_le(record.data(), offset, monitor_pvt.end_to_end_latency_us);
+
+    bool sent = true;
+    for (const auto& endpoint : endpoints)
+        {
+            // never blocks the PVT block: a datagram that cannot be sent is dropped
+            socket.send_to(boost::asio::buffer(record), endpoint, 0, error);
+            if (error)
+                {
+                    sent = false;
+                }
+        }
+    return sent;
+}
@@ -0,0 +1,59 @@
+/*!
+ * \file pvt_udp_sink.h
+ * \brief Interface of a class that sends the PVT solutions as Monitor_Pvt
+ * binary records over UDP, to unicast or multicast addresses
+ *
+ * -------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2018  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *          Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_PVT_UDP_SINK_H_
+#define GNSS_SDR_PVT_UDP_SINK_H_
+
+#include "monitor_pvt.h"
+#include <boost/asio.hpp>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/*!
+ * \brief Sends every solution in one datagram of MONITOR_PVT_RECORD_SIZE
+ * bytes to each of the (IPv4) addresses, so clients can read them at the
+ * solution rate without parsing files.
+ */
+class Pvt_Udp_Sink
+{
+public:
+    Pvt_Udp_Sink(const std::vector<std::string>& addresses, const uint16_t& port);
+    bool write_monitor_pvt(const Monitor_Pvt& monitor_pvt);
+
+private:
+    boost::asio::io_service io_service;
+    boost::asio::ip::udp::socket socket;
+    boost::system::error_code error;
+    std::vector<boost::asio::ip::udp::endpoint> endpoints;
+    std::vector<uint8_t> record;
+};
+
+#endif
@@ -0,0 +1,48 @@
+/*!
+ * \file source_overflow_counter.h
+ * \brief Count of the overflows of the signal sources, published by the monitor.
+ *
+ * The signal sources that detect lost samples add them here, and the PVT
+ * monitor sends the total with every solution.
+ *
+ * -------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2018  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *          Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_SOURCE_OVERFLOW_COUNTER_H_
+#define GNSS_SDR_SOURCE_OVERFLOW_COUNTER_H_
+
+#include <atomic>
+#include <cstdint>
+
+/*!
+ * \brief Overflow events reported by the signal sources since the receiver started.
+ */
+inline std::atomic<uint32_t>& signal_source_overflows()
+{
+    static std::atomic<uint32_t> overflows(0);
+    return overflows;
+}
+
+#endif
@@ -0,0 +1,433 @@
+/*!
+ * \file capacity_planner.cc
+ * \brief Estimates, without running the receiver, the CPU load of a
+ * configuration from the kernel benchmarks of the host
+ *
+ * -------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2019  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *          Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------
+ */
+
+#include "capacity_planner.h"
+#include "configuration_interface.h"
+#include <boost/property_tree/json_parser.hpp>
+#include <boost/property_tree/ptree.hpp>
+#include <glog/logging.h>
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <iomanip>
+#include <limits>
+#include <sstream>
+#include <utility>
+
+
+namespace
+{
+struct Signal_Model
+{
+    const char* signal;
+    double code_period_s;  // samples processed by each correlation
+    int64_t taps;          // correlators of the tracking (E, P, L or VE, E, P, L, VL)
+};
+
+const std::array<Signal_Model, 7> SIGNALS = {{{"1C", 0.001, 3},
+    {"2S", 0.020, 3},
+    {"L5", 0.001, 3},
+    {"1B", 0.004, 5},
+    {"5X", 0.001, 3},
+    {"1G", 0.001, 3},
+    {"2G", 0.001, 3}}};
+
+// Distance between two sizes, in octaves
+double size_distance(double a, double b)
+{
+    return std::abs(std::log2(std::max(a, 1.0) / std::max(b, 1.0)));
+}
+
+// Work of an FFT of n points, relative to its size
+double fft_work(double n)
+{
+    return n * std::log2(std::max(n, 2.0));
+}
+}  // namespace
+
+
+Capacity_Planner::Capacity_Planner(std::shared_ptr<ConfigurationInterface> configuration) : d_configuration(std::move(configuration)),
+                                                                                           d_fits(false)
+{
+}
+
+
+bool Capacity_Planner::load_calibration(const std::string& filename)
+{
+    boost::property_tree::ptree tree;
+    try
+        {
+            boost::property_tree::read_json(filename, tree);
+        }
+    catch (const boost::property_tree::json_parser_error& e)
+        {
+            LOG(WARNING) << "Unable to read the calibration file " << filename << ": " << e.what();
+            return false;
+        }
+
+    size_t results = 0;
+    auto benchmarks = tree.get_child_optional("benchmarks");
+    if (benchmarks)
+        {
+            // Google Benchmark output of benchmark_gnss_sdr, with names like BM_32f_xn_resampler_32f_xn/4000/3
+            for (const auto& item : *benchmarks)
+                {
+                    std::string name = item.second.get<std::string>("name", "");
+                    double items_per_second = item.second.get<double>("items_per_second", 0.0);
+                    if (name.empty() or (items_per_second <= 0.0))
+                        {
+                            continue;
+                        }
+                    Kernel_Result result;
+                    std::stringstream ss(name);
+                    std::string field;
+                    std::getline(ss, result.family, '/');
+                    while (std::getline(ss, field, '/'))
+                        {
+                            try
+                                {
+                                    result.args.push_back(std::stoll(field));
+                                }
+                            catch (const std::exception& e)
+                                {
+                                    break;  // e.g. the threads/ or real_time suffixes
+                                }
+                        }
+                    result.seconds_per_item = 1.0 / items_per_second;
+                    d_kernels.push_back(result);
+                    results++;
+                }
+        }
+    else
+        {
+            // acquisition_benchmark output, an array of results
+            for (const auto& item : tree)
+                {
+                    Acquisition_Result result;
+                    result.implementation = item.second.get<std::string>("implementation", "");
+                    result.fs_hz = item.second.get<double>("fs_hz", 0.0);
+                    result.doppler_bins = item.second.get<double>("doppler_bins", 0.0);
+                    result.seconds_per_dwell = item.second.get<double>("us_per_dwell_mean", 0.0) * 1e-6;
+                    if (result.implementation.empty() or (result.fs_hz <= 0.0) or (result.doppler_bins <= 0.0) or (result.seconds_per_dwell <= 0.0))
+                        {
+                            continue;
+                        }
+                    d_acquisitions.push_back(result);
+                    results++;
+                }
+        }
+    if (results == 0)
+        {
+            LOG(WARNING) << "No benchmark results in the calibration file " << filename;
+            return false;
+        }
+    d_calibration_files.push_back(filename);
+    LOG(INFO) << results << " benchmark results read from " << filename;
+    return true;
+}
+
+
+double Capacity_Planner::kernel_seconds_per_item(const std::string& family, int64_t items, int64_t taps) const
+{
+    // the result of the same number of correlators and the closest size
+    const Kernel_Result* best = nullptr;
+    double best_distance = std::numeric_limits<double>::max();
+    for (const auto& result : d_kernels)
+        {
+            if ((result.family != family) or result.args.empty())
+                {
+                    continue;
+                }
+            double distance = size_distance(static_cast<double>(result.args[0]), static_cast<double>(items));
+            if ((taps > 0) and (result.args.size() > 1) and (result.args[1] != taps))
+                {
+                    distance += 100.0;
+                }
+            if (distance < best_distance)
+                {
+                    best_distance = distance;
+                    best = &result;
+                }
+        }
+    if (best == nullptr)
+        {
+            return -1.0;
+        }
+    double seconds_per_item = best->seconds_per_item;
+    if ((taps > 0) and (best->args.size() > 1) and (best->args[1] != taps))
+        {
+            seconds_per_item *= static_cast<double>(taps) / static_cast<double>(best->args[1]);
+        }
+    return seconds_per_item;
+}
+
+
+double Capacity_Planner::acquisition_seconds_per_dwell(const std::string& implementation, double fs, double doppler_bins, double coherent_s, bool& extrapolated) const
+{
+    // the result of the same implementation (or of any, if not measured) at the closest sampling rate
+    const Acquisition_Result* best = nullptr;
+    double best_distance = std::numeric_limits<double>::max();
+    for (const auto& result : d_acquisitions)
+        {
+            double distance = size_distance(result.fs_hz, fs) + size_distance(result.doppler_bins, doppler_bins);
+            if (result.implementation != implementation)
+                {
+                    distance += 100.0;
+                }
+            if (distance < best_distance)
+                {
+                    best_distance = distance;
+                    best = &result;
+                }
+        }
+    if (best == nullptr)
+        {
+            return -1.0;
+        }
+    extrapolated = (best->implementation != implementation);
+
+    // a dwell is an FFT per Doppler bin, scaled from the benchmark grid
+    // (acquisition_benchmark integrates 1 ms, 4 ms with QuickSync)
+    double benchmark_coherent_s = (best->implementation.find("QuickSync") != std::string::npos) ? 0.004 : 0.001;
+    return best->seconds_per_dwell * (doppler_bins / best->doppler_bins) * (fft_work(fs * coherent_s) / fft_work(best->fs_hz * benchmark_coherent_s));
+}
+
+
+std::vector<Capacity_Planner::Block_Cost> Capacity_Planner::estimate() const
+{
+    std::vector<Block_Cost> costs;
+    const double fs = d_configuration->property("GNSS-SDR.internal_fs_sps", 0.0);
+    if (fs <= 0.0)
+        {
+            return costs;
+        }
+
+    // sample conversion of the signal conditioner
+    std::string adapter = d_configuration->property("DataTypeAdapter.implementation", std::string("Pass_Through"));
+    if (adapter != "Pass_Through")
+        {
+            Block_Cost cost{"DataTypeAdapter", 1, -1.0, false, adapter + ", not calibrated"};
+            if ((adapter.find("short") != std::string::npos) and (adapter.find("Complex") != std::string::npos))
+                {
+                    double seconds_per_item = kernel_seconds_per_item("BM_16ic_convert_32fc", 32768, 0);
+                    if (seconds_per_item > 0.0)
+                        {
+                            cost.cores_each = fs * seconds_per_item;
+                            cost.model = "16ic to 32fc conversion of every sample";
+                        }
+                }
+            costs.push_back(cost);
+        }
+    std::string filter = d_configuration->property("InputFilter.implementation", std::string("Pass_Through"));
+    if (filter != "Pass_Through")
+        {
+            costs.push_back(Block_Cost{"InputFilter", 1, -1.0, false, filter + ", not calibrated"});
+        }
+
+    // tracking, one block per channel, processing all the samples
+    std::vector<std::pair<double, std::string>> acquisitions;  // cost of each channel that may search, and its signal
+    int32_t channels = 0;
+    for (const auto& model : SIGNALS)
+        {
+            const std::string signal = model.signal;
+            int32_t count = d_configuration->property("Channels_" + signal + ".count", 0);
+            if (count <= 0)
+                {
+                    continue;
+                }
+            channels += count;
+            const std::string trk_role = "Tracking_" + signal;
+            const int64_t items = static_cast<int64_t>(std::round(fs * model.code_period_s));
+            Block_Cost tracking{trk_role, count, -1.0, false, d_configuration->property(trk_role + ".implementation", std::string("")) + ", not calibrated"};
+            bool cshort = (d_configuration->property(trk_role + ".item_type", std::string("gr_complex")) == "cshort");
+            double rotator = kernel_seconds_per_item(cshort ? "BM_16ic_x2_rotator_dot_prod_16ic_xn" : "BM_32fc_32f_rotator_dot_prod_32fc_xn", items, model.taps);
+            double resampler = kernel_seconds_per_item(cshort ? "BM_16ic_xn_resampler_16ic_xn" : "BM_32f_xn_resampler_32f_xn", items, model.taps);
+            if ((rotator > 0.0) and (resampler > 0.0))
+                {
+                    tracking.cores_each = fs * (rotator + resampler);
+                    std::stringstream description;
+                    description << model.taps << " correlators of " << items << " samples";
+                    tracking.model = description.str();
+                }
+            costs.push_back(tracking);
+
+            // acquisition, one dwell per coherent integration while searching
+            const std::string acq_role = "Acquisition_" + signal;
+            std::string implementation = d_configuration->property(acq_role + ".implementation", std::string(""));
+            double coherent_s = d_configuration->property(acq_role + ".coherent_integration_time_ms", model.code_period_s * 1e3) * 1e-3;
+            double doppler_max = d_configuration->property(acq_role + ".doppler_max", 5000.0);
+            double doppler_step = std::max(d_configuration->property(acq_role + ".doppler_step", 500.0), 1.0);
+            double doppler_bins = 2.0 * std::floor(doppler_max / doppler_step) + 1.0;
+            bool blocking = d_configuration->property(acq_role + ".blocking", true);
+            bool extrapolated = false;
+            double seconds_per_dwell = acquisition_seconds_per_dwell(implementation, fs, doppler_bins, coherent_s, extrapolated);
+            double cores_each = -1.0;
+            if (seconds_per_dwell > 0.0)
+                {
+                    cores_each = blocking ? seconds_per_dwell / coherent_s : std::min(seconds_per_dwell / coherent_s, 1.0);
+                }
+            for (int32_t n = 0; n < count; n++)
+                {
+                    acquisitions.emplace_back(cores_each, signal);
+                }
+            std::stringstream description;
+            description << implementation << ", " << doppler_bins << " Doppler bins of " << std::round(fs * coherent_s) << " samples";
+            if (seconds_per_dwell <= 0.0)
+                {
+                    description << ", not calibrated";
+                }
+            else if (extrapolated)
+                {
+                    description << ", from another implementation";
+                }
+            if (!blocking)
+                {
+                    description << ", non-blocking";
+                }
+            costs.push_back(Block_Cost{acq_role, 0, cores_each, !blocking, description.str()});
+        }
+
+    // at most Channels.in_acquisition channels search at once: the most expensive ones, in the worst case
+    int32_t in_acquisition = std::min(d_configuration->property("Channels.in_acquisition", channels), channels);
+    std::sort(acquisitions.begin(), acquisitions.end(), [](const std::pair<double, std::string>& a, const std::pair<double, std::string>& b) { return a.first > b.first; });
+    for (int32_t n = 0; n < in_acquisition; n++)
+        {
+            for (auto& cost : costs)
+                {
+                    if (cost.block == "Acquisition_" + acquisitions[n].second)
+                        {
+                            cost.instances++;
+                        }
+                }
+        }
+    costs.erase(std::remove_if(costs.begin(), costs.end(), [](const Block_Cost& cost) { return cost.instances == 0; }), costs.end());
+
+    if (channels > 0)
+        {
+            costs.push_back(Block_Cost{"TelemetryDecoder", channels, -1.0, false, "negligible, not calibrated"});
+            costs.push_back(Block_Cost{"Observables", 1, -1.0, false, "negligible, not calibrated"});
+            costs.push_back(Block_Cost{"PVT", 1, -1.0, false, "negligible, not calibrated"});
+        }
+    return costs;
+}
+
+
+std::string Capacity_Planner::report(int32_t cores, double margin)
+{
+    std::stringstream report;
+    d_fits = false;
+    if (d_configuration->property("GNSS-SDR.internal_fs_sps", 0.0) <= 0.0)
+        {
+            report << "Set GNSS-SDR.internal_fs_sps in the configuration to estimate its load" << std::endl;
+            return report.str();
+        }
+    if (d_kernels.empty() and d_acquisitions.empty())
+        {
+            report << "No calibration: run benchmark_gnss_sdr --benchmark_out=kernels.json and acquisition_benchmark --output=acquisition.json on this machine, "
+                   << "and pass the files with --capacity_calibration=kernels.json,acquisition.json" << std::endl;
+            return report.str();
+        }
+
+    std::vector<Block_Cost> costs = estimate();
+    double total = 0.0;
+    const Block_Cost* largest = nullptr;
+    bool uncalibrated = false;
+    report << "Estimated load at " << d_configuration->property("GNSS-SDR.internal_fs_sps", 0.0) << " samples per second" << std::endl
+           << std::left << std::setw(20) << "Block" << std::right << std::setw(10) << "Instances" << std::setw(12) << "Cores each" << std::setw(12) << "Cores" << "  Model" << std::endl;
+    for (const auto& cost : costs)
+        {
+            report << std::left << std::setw(20) << cost.block << std::right << std::setw(10) << cost.instances;
+            if (cost.cores_each < 0.0)
+                {
+                    uncalibrated = true;
+                    report << std::setw(12) << "-" << std::setw(12) << "-";
+                }
+            else
+                {
+                    total += cost.instances * cost.cores_each;
+                    report << std::fixed << std::setprecision(3) << std::setw(12) << cost.cores_each << std::setw(12) << cost.instances * cost.cores_each;
+                    if (!cost.skips and ((largest == nullptr) or (cost.cores_each > largest->cores_each)))
+                        {
+                            largest = &cost;
+                        }
+                }
+            report << "  " << cost.model << std::endl;
+        }
+
+    std::vector<const Block_Cost*> top;
+    for (const auto& cost : costs)
+        {
+            if (cost.cores_each > 0.0)
+                {
+                    top.push_back(&cost);
+                }
+        }
+    std::sort(top.begin(), top.end(), [](const Block_Cost* a, const Block_Cost* b) { return a->instances * a->cores_each > b->instances * b->cores_each; });
+    report << std::endl
+           << "Top contributors:" << std::endl;
+    for (size_t n = 0; n < std::min(top.size(), static_cast<size_t>(3)); n++)
+        {
+            report << "  " << top[n]->block << ": " << std::setprecision(1) << 100.0 * top[n]->instances * top[n]->cores_each / total << " % of the load" << std::endl;
+        }
+
+    // GNU Radio runs each block in its own thread, so no block can use more than one core
+    const double budget = static_cast<double>(cores) * (1.0 - margin);
+    bool block_fits = (largest == nullptr) or (largest->cores_each <= 1.0 - margin);
+    d_fits = (total <= budget) and block_fits;
+    report << std::endl
+           << std::setprecision(3) << "Total: " << total << " of " << cores << " cores, headroom " << std::setprecision(1) << 100.0 * (1.0 - total / static_cast<double>(cores)) << " %" << std::endl;
+    if (largest != nullptr)
+        {
+            report << "Largest block: " << largest->block << ", " << std::setprecision(1) << 100.0 * largest->cores_each << " % of a core" << std::endl;
+        }
+    if (uncalibrated)
+        {
+            report << "The blocks without calibration are not in the total" << std::endl;
+        }
+    if (d_fits)
+        {
+            report << "The configuration fits in real time with a margin of " << std::setprecision(0) << 100.0 * margin << " %" << std::endl;
+        }
+    else if (!block_fits)
+        {
+            report << "The configuration does not fit in real time: " << largest->block << " needs more than " << std::setprecision(0) << 100.0 * (1.0 - margin) << " % of a core" << std::endl;
+        }
+    else
+        {
+            report << "The configuration does not fit in real time: it needs more than " << std::setprecision(0) << 100.0 * (1.0 - margin) << " % of " << cores << " cores" << std::endl;
+        }
+    report << "Calibration:";
+    for (const auto& file : d_calibration_files)
+        {
+            report << " " << file;
+        }
+    report << std::endl;
+    return report.str();
+}
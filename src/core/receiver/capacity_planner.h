@@ -0,0 +1,119 @@
+/*!
+ * \file capacity_planner.h
+ * \brief Estimates, without running the receiver, the CPU load of a
+ * configuration from the kernel benchmarks of the host
+ *
+ * -------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2019  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *          Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_CAPACITY_PLANNER_H_
+#define GNSS_SDR_CAPACITY_PLANNER_H_
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+class ConfigurationInterface;
+
+/*!
+ * \brief Cost model of a configuration, calibrated on the target machine.
+ *
+ * The calibration is the JSON output of the benchmarks of the host:
+ * benchmark_gnss_sdr --benchmark_out=file.json (throughput of the tracking
+ * and conversion kernels) and acquisition_benchmark --output=file.json
+ * (time per dwell of the acquisition implementations). The load of each
+ * block is the time its kernels take to process one second of signal:
+ * - tracking: the code resampler and the rotator dot product of each
+ *   channel, over all the samples, with its number of correlators;
+ * - acquisition: one dwell per coherent integration of each channel in
+ *   acquisition, searching all the time (at most one core each in the
+ *   non-blocking mode, which skips the samples it cannot search);
+ * - data type adapter: the sample conversion.
+ * Telemetry decoders, observables and PVT are negligible next to them,
+ * and the input filters are not calibrated.
+ */
+class Capacity_Planner
+{
+public:
+    explicit Capacity_Planner(std::shared_ptr<ConfigurationInterface> configuration);
+
+    /*!
+     * \brief Adds the results in \p filename, written by benchmark_gnss_sdr
+     * or by acquisition_benchmark
+     */
+    bool load_calibration(const std::string& filename);
+
+    /*!
+     * \brief Estimates the load on \p cores cores, keeping \p margin (0 to 1)
+     * of them free, and returns the report
+     */
+    std::string report(int32_t cores, double margin);
+
+    /*!
+     * \brief True if the last report found the configuration fits in real time
+     */
+    inline bool fits() const
+    {
+        return d_fits;
+    }
+
+private:
+    struct Kernel_Result
+    {
+        std::string family;         // e.g. BM_32fc_32f_rotator_dot_prod_32fc_xn
+        std::vector<int64_t> args;  // e.g. samples and correlators
+        double seconds_per_item;
+    };
+
+    struct Acquisition_Result
+    {
+        std::string implementation;
+        double fs_hz;
+        double doppler_bins;
+        double seconds_per_dwell;
+    };
+
+    struct Block_Cost
+    {
+        std::string block;
+        int32_t instances;
+        double cores_each;  // negative if not calibrated
+        bool skips;         // skips samples instead of falling behind
+        std::string model;
+    };
+
+    double kernel_seconds_per_item(const std::string& family, int64_t items, int64_t taps) const;
+    double acquisition_seconds_per_dwell(const std::string& implementation, double fs, double doppler_bins, double coherent_s, bool& extrapolated) const;
+    std::vector<Block_Cost> estimate() const;
+
+    std::shared_ptr<ConfigurationInterface> d_configuration;
+    std::vector<Kernel_Result> d_kernels;
+    std::vector<Acquisition_Result> d_acquisitions;
+    std::vector<std::string> d_calibration_files;
+    bool d_fits;
+};
+
+#endif  // GNSS_SDR_CAPACITY_PLANNER_H_
@@ -0,0 +1,218 @@
+/*!
+ * \file concurrent_ring_queue.h
+ * \brief Interface of a bounded lock-free multi-producer multi-consumer queue
+ *
+ * -------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2019  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *          Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_CONCURRENT_RING_QUEUE_H
+#define GNSS_SDR_CONCURRENT_RING_QUEUE_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+template <typename Data>
+
+/*!
+ * \brief This class implements a bounded lock-free queue for several producers and consumers
+ *
+ * Ring buffer of cells tagged with a sequence number (D. Vyukov's bounded
+ * MPMC queue): producers and consumers claim cells with a single
+ * compare-and-swap and never take a lock. Only a consumer that finds the
+ * queue empty after spinning blocks on a condition variable, and producers
+ * touch its mutex only when a consumer is actually waiting.
+ * Items are moved in and out, and push() fails instead of blocking when
+ * the queue is full.
+ */
+class concurrent_ring_queue
+{
+public:
+    /*!
+     * \brief The capacity is rounded up to a power of two. wait_and_pop()
+     * retries spin_count times before blocking.
+     */
+    explicit concurrent_ring_queue(size_t capacity = 1024, unsigned int spin_count = 1000) : spin_count_(spin_count),
+                                                                                                 enqueue_pos_(0),
+                                                                                                 dequeue_pos_(0),
+                                                                                                 waiting_consumers_(0)
+    {
+        size_t size = 2;
+        while (size < capacity)
+            {
+                size <<= 1;
+            }
+        mask_ = size - 1;
+        cells_ = std::unique_ptr<Cell[]>(new Cell[size]);
+        for (size_t i = 0; i < size; i++)
+            {
+                cells_[i].sequence.store(i, std::memory_order_relaxed);
+            }
+    }
+
+    concurrent_ring_queue(const concurrent_ring_queue&) = delete;
+    concurrent_ring_queue& operator=(const concurrent_ring_queue&) = delete;
+
+    //! Moves data into the queue. Returns false, leaving data untouched, if the queue is full
+    bool push(Data&& data)
+    {
+        Cell* cell;
+        size_t pos = enqueue_pos_.load(std::memory_order_relaxed);
+        for (;;)
+            {
+                cell = &cells_[pos & mask_];
+                size_t sequence = cell->sequence.load(std::memory_order_acquire);
+                std::ptrdiff_t diff = static_cast<std::ptrdiff_t>(sequence) - static_cast<std::ptrdiff_t>(pos);
+                if (diff == 0)
+                    {
+                        if (enqueue_pos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                            {
+                                break;
+                            }
+                    }
+                else if (diff < 0)
+                    {
+                        return false;
+                    }
+                else
+                    {
+                        pos = enqueue_pos_.load(std::memory_order_relaxed);
+                    }
+            }
+        cell->data = std::move(data);
+        cell->sequence.store(pos + 1, std::memory_order_release);
+
+        // Pairs with the fence in wait_and_pop(): either the consumer sees the item, or we see the consumer
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (waiting_consumers_.load(std::memory_order_relaxed) > 0)
+            {
+                std::lock_guard<std::mutex> lock(wait_mutex_);
+                wait_condition_.notify_one();
+            }
+        return true;
+    }
+
+    bool empty() const
+    {
+        size_t pos = dequeue_pos_.load(std::memory_order_relaxed);
+        return cells_[pos & mask_].sequence.load(std::memory_order_acquire) != pos + 1;
+    }
+
+    size_t capacity() const
+    {
+        return mask_ + 1;
+    }
+
+    bool try_pop(Data& popped_value)
+    {
+        Cell* cell;
+        size_t pos = dequeue_pos_.load(std::memory_order_relaxed);
+        for (;;)
+            {
+                cell = &cells_[pos & mask_];
+                size_t sequence = cell->sequence.load(std::memory_order_acquire);
+                std::ptrdiff_t diff = static_cast<std::ptrdiff_t>(sequence) - static_cast<std::ptrdiff_t>(pos + 1);
+                if (diff == 0)
+                    {
+                        if (dequeue_pos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                            {
+                                break;
+                            }
+                    }
+                else if (diff < 0)
+                    {
+                        return false;
+                    }
+                else
+                    {
+                        pos = dequeue_pos_.load(std::memory_order_relaxed);
+                    }
+            }
+        popped_value = std::move(cell->data);
+        cell->sequence.store(pos + mask_ + 1, std::memory_order_release);
+        return true;
+    }
+
+    //! Appends up to max_items items to popped_values. Returns the number of items popped
+    size_t try_pop_n(std::vector<Data>& popped_values, size_t max_items)
+    {
+        size_t n = 0;
+        Data value;
+        while ((n < max_items) and try_pop(value))
+            {
+                popped_values.push_back(std::move(value));
+                n++;
+            }
+        return n;
+    }
+
+    void wait_and_pop(Data& popped_value)
+    {
+        for (unsigned int i = 0; i < spin_count_; i++)
+            {
+                if (try_pop(popped_value))
+                    {
+                        return;
+                    }
+                std::this_thread::yield();
+            }
+        std::unique_lock<std::mutex> lock(wait_mutex_);
+        waiting_consumers_.fetch_add(1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        while (!try_pop(popped_value))
+            {
+                wait_condition_.wait(lock);
+            }
+        waiting_consumers_.fetch_sub(1, std::memory_order_relaxed);
+    }
+
+private:
+    struct Cell
+    {
+        std::atomic<size_t> sequence;
+        Data data;
+    };
+
+    // Producers and consumers update their own position without sharing a cache line
+    static constexpr size_t cache_line_size = 64;
+    std::unique_ptr<Cell[]> cells_;
+    size_t mask_;
+    unsigned int spin_count_;
+    char pad0_[cache_line_size];
+    std::atomic<size_t> enqueue_pos_;
+    char pad1_[cache_line_size];
+    std::atomic<size_t> dequeue_pos_;
+    char pad2_[cache_line_size];
+    std::atomic<unsigned int> waiting_consumers_;
+    std::mutex wait_mutex_;
+    std::condition_variable wait_condition_;
+};
+
+#endif
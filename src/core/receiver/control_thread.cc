@@ -33,6 +33,8 @@
  */
 
 #include "control_thread.h"
+#include "GPS_L1_CA.h"
+#include "capacity_planner.h"
 #include "concurrent_map.h"
 #include "concurrent_queue.h"
 #include "control_message_factory.h"
@@ -41,18 +43,20 @@
 #include "galileo_ephemeris.h"
 #include "galileo_iono.h"
 #include "galileo_utc_model.h"
-#include "geofunctions.h"
 #include "glonass_gnav_ephemeris.h"
 #include "glonass_gnav_utc_model.h"
 #include "gnss_flowgraph.h"
+#include "gnss_profiler.h"
+#include "gnss_sdr_binary_store.h"
 #include "gnss_sdr_flags.h"
+#include "gnss_trace.h"
+#include "gnss_tracking_state_registry.h"
 #include "gps_almanac.h"
 #include "gps_ephemeris.h"
 #include "gps_iono.h"
 #include "gps_utc_model.h"
 #include "pvt_interface.h"
 #include "rtklib_conversions.h"
-#include "rtklib_ephemeris.h"
 #include "rtklib_rtkcmn.h"
 #include <boost/chrono.hpp>
 #include <boost/lexical_cast.hpp>
@@ -60,13 +64,18 @@
 #include <gnuradio/message.h>
 #include <algorithm>
 #include <cmath>
+#include <ctime>
+#include <functional>
 #include <iostream>
 #include <limits>
 #include <map>
+#include <sstream>
 #include <string>
 #include <sys/ipc.h>
 #include <sys/msg.h>
 #include <sys/types.h>
+#include <thread>
+#include <tuple>
 #include <utility>
 
 
@@ -106,6 +115,9 @@ void ControlThread::init()
     // Instantiates a control queue, a GNSS flowgraph, and a control message factory
     control_queue_ = gr::msg_queue::make(0);
     cmd_interface_.set_msg_queue(control_queue_);  //set also the queue pointer for the telecommand thread
+    // the blocks built with the flowgraph get the tracking state registry of this receiver
+    state_registry_ = std::make_shared<Gnss_Tracking_State_Registry>();
+    Gnss_Tracking_State_Registry::set_thread_instance(state_registry_);
     try
         {
             flowgraph_ = std::make_shared<GNSSFlowgraph>(configuration_, control_queue_);
@@ -114,14 +126,19 @@ void ControlThread::init()
         {
             std::cout << "Caught bad lexical cast with error " << e.what() << std::endl;
         }
+    Gnss_Tracking_State_Registry::set_thread_instance(nullptr);
     control_message_factory_ = std::make_shared<ControlMessageFactory>();
     stop_ = false;
+    process_listeners_ = true;
     processed_control_messages_ = 0;
     applied_actions_ = 0;
     supl_mcc = 0;
     supl_mns = 0;
     supl_lac = 0;
     supl_ci = 0;
+    supl_eph_error_ = 0;
+    supl_alm_error_ = 0;
+    supl_acq_error_ = 0;
     msqid = -1;
     agnss_ref_location_ = Agnss_Ref_Location();
     agnss_ref_time_ = Agnss_Ref_Time();
@@ -186,6 +203,41 @@ void ControlThread::init()
                     agnss_ref_time_.valid = false;
                 }
         }
+
+    // Receiver state saved by the previous run
+    receiver_snapshot_loaded_ = false;
+    snapshot_range_rates_.clear();
+    snapshot_filename_ = configuration_->property("GNSS-SDR.snapshot_filename", empty_string);
+    if (!snapshot_filename_.empty() and gnss_sdr_load_binary_store(snapshot_filename_, "GNSS-SDR_receiver_snapshot", receiver_snapshot_))
+        {
+            double age_s = difftime(time(nullptr), static_cast<time_t>(receiver_snapshot_.save_utc_time));
+            if ((age_s >= 0.0) and (age_s <= configuration_->property("GNSS-SDR.snapshot_max_age_s", 14400.0)))
+                {
+                    receiver_snapshot_loaded_ = true;
+                    std::cout << "Receiver snapshot loaded, taken " << static_cast<int>(age_s) << " s ago" << std::endl;
+                    if (receiver_snapshot_.pvt_valid and !agnss_ref_location_.valid)
+                        {
+                            agnss_ref_location_.lat = receiver_snapshot_.latitude_deg;
+                            agnss_ref_location_.lon = receiver_snapshot_.longitude_deg;
+                            agnss_ref_location_.valid = true;
+                        }
+                    // The Doppler shifts (which include the receiver clock drift) are still accurate after a short restart
+                    if (age_s <= configuration_->property("GNSS-SDR.snapshot_doppler_max_age_s", 120.0))
+                        {
+                            for (const auto& state : receiver_snapshot_.tracking_states)
+                                {
+                                    if (state.carrier_freq_hz > 0.0)
+                                        {
+                                            snapshot_range_rates_[std::make_pair(state.system, state.prn)] = -state.carrier_doppler_hz * GPS_C_m_s / state.carrier_freq_hz;
+                                        }
+                                }
+                        }
+                }
+            else
+                {
+                    LOG(INFO) << "Receiver snapshot " << snapshot_filename_ << " is too old, ignored";
+                }
+        }
 }
 
 
@@ -201,7 +253,50 @@ void ControlThread::telecommand_listener()
     if (telecommand_enabled)
         {
             int tcp_cmd_port = configuration_->property("GNSS-SDR.telecommand_tcp_port", 3333);
-            cmd_interface_.run_cmd_server(tcp_cmd_port);
+            int status_period_ms = configuration_->property("GNSS-SDR.telecommand_status_period_ms", 1000);
+            cmd_interface_.run_cmd_server(tcp_cmd_port, status_period_ms);
+        }
+}
+
+
+/*
+ * Serves the receiver metrics in the OpenMetrics text format to any HTTP
+ * request (e.g. GET /metrics from a Prometheus server)
+ */
+void ControlThread::metrics_http_listener()
+{
+    int port = configuration_->property("GNSS-SDR.metrics_http_port", 0);
+    boost::asio::io_service service;
+    try
+        {
+            boost::asio::ip::tcp::acceptor acceptor(service, boost::asio::ip::tcp::endpoint(boost::asio::ip::tcp::v4(), port));
+            acceptor.non_blocking(true);  // check stop_ while no one is connected
+            std::cout << "Metrics available at http://localhost:" << port << "/metrics" << std::endl;
+            while (!stop_)
+                {
+                    boost::system::error_code error;
+                    boost::asio::ip::tcp::socket socket(service);
+                    acceptor.accept(socket, error);
+                    if (error == boost::asio::error::would_block)
+                        {
+                            boost::this_thread::sleep(boost::posix_time::milliseconds(100));
+                            continue;
+                        }
+                    if (error)
+                        {
+                            LOG(WARNING) << "Metrics HTTP endpoint: " << error.message();
+                            continue;
+                        }
+                    boost::asio::streambuf request;
+                    boost::asio::read_until(socket, request, "\r\n\r\n", error);
+                    std::string response = "HTTP/1.0 200 OK\r\nContent-Type: application/openmetrics-text; version=1.0.0; charset=utf-8\r\n\r\n" + flowgraph_->get_metrics();
+                    boost::asio::write(socket, boost::asio::buffer(response), error);
+                    socket.shutdown(boost::asio::ip::tcp::socket::shutdown_both, error);
+                }
+        }
+    catch (const boost::system::system_error &e)
+        {
+            LOG(WARNING) << "Metrics HTTP endpoint not available on port " << port << ": " << e.what();
         }
 }
 
@@ -236,6 +331,26 @@ int ControlThread::run()
             LOG(ERROR) << "Unable to connect flowgraph";
             return 0;
         }
+    // Start tracing the blocks, if requested
+    std::string trace_filename = configuration_->property("GNSS-SDR.trace_filename", std::string(""));
+    if (!trace_filename.empty())
+        {
+            if (Gnss_Trace::get_instance()->open(trace_filename))
+                {
+                    std::cout << "Writing the processing trace to " << trace_filename << std::endl;
+                }
+            else
+                {
+                    LOG(WARNING) << "Unable to create the trace file " << trace_filename;
+                }
+        }
+    // Profile the hot paths, if requested
+    bool profile = configuration_->property("GNSS-SDR.profile", false);
+    if (profile)
+        {
+            Gnss_Profiler::get_instance()->enable();
+        }
+
     // Start the flowgraph
     flowgraph_->start();
     if (flowgraph_->running())
@@ -248,16 +363,55 @@ int ControlThread::run()
             return 0;
         }
 
+    // memory footprint of the blocks, once the GNU Radio buffers are allocated
+    std::string memory_report = flowgraph_->get_memory_report();
+    LOG(INFO) << memory_report;
+    if (configuration_->property("GNSS-SDR.print_memory_report", false))
+        {
+            std::cout << memory_report;
+        }
+
     // launch GNSS assistance process AFTER the flowgraph is running because the GNU Radio asynchronous queues must be already running to transport msgs
     assist_GNSS();
     // start the keyboard_listener thread
-    keyboard_thread_ = boost::thread(&ControlThread::keyboard_listener, this);
-    sysv_queue_thread_ = boost::thread(&ControlThread::sysv_queue_listener, this);
+    if (process_listeners_)
+        {
+            keyboard_thread_ = boost::thread(&ControlThread::keyboard_listener, this);
+            sysv_queue_thread_ = boost::thread(&ControlThread::sysv_queue_listener, this);
+        }
+
+    // start the receiver snapshot writer
+    if (!snapshot_filename_.empty())
+        {
+            snapshot_thread_ = boost::thread(&ControlThread::snapshot_writer, this);
+        }
+
+    // start the periodic re-prioritization of the satellites in the search list
+    if (configuration_->property("GNSS-SDR.reprioritize_interval_s", 0) > 0)
+        {
+            visibility_thread_ = boost::thread(&ControlThread::visibility_updater, this);
+        }
 
     // start the telecommand listener thread
     cmd_interface_.set_pvt(flowgraph_->get_pvt());
+    cmd_interface_.set_channels_handler(std::bind(&GNSSFlowgraph::set_active_channels, flowgraph_.get(), std::placeholders::_1, std::placeholders::_2));
+    cmd_interface_.set_stats_handler(std::bind(&GNSSFlowgraph::get_metrics, flowgraph_.get()));
+    cmd_interface_.set_memory_handler(std::bind(&GNSSFlowgraph::get_memory_report, flowgraph_.get()));
     cmd_interface_thread_ = boost::thread(&ControlThread::telecommand_listener, this);
 
+    // start the metrics HTTP endpoint
+    if (configuration_->property("GNSS-SDR.metrics_http_port", 0) > 0)
+        {
+            metrics_http_thread_ = boost::thread(&ControlThread::metrics_http_listener, this);
+        }
+
+    // profile the VOLK_GNSSSDR kernels in use that are missing from the volk_gnsssdr_config file
+    if (configuration_->property("GNSS-SDR.volk_gnsssdr_autoprofile", false))
+        {
+            volk_autoprofile_ = std::unique_ptr<Volk_Gnsssdr_Autoprofile>(new Volk_Gnsssdr_Autoprofile(configuration_));
+            volk_autoprofile_thread_ = boost::thread(&Volk_Gnsssdr_Autoprofile::run, volk_autoprofile_.get());
+        }
+
     bool enable_FPGA = configuration_->property("Channel.enable_FPGA", false);
     if (enable_FPGA == true)
         {
@@ -274,19 +428,51 @@ int ControlThread::run()
     std::cout << "Stopping GNSS-SDR, please wait!" << std::endl;
     flowgraph_->stop();
     stop_ = true;
+    Gnss_Trace::get_instance()->close();
+    if (profile)
+        {
+            Gnss_Profiler::get_instance()->disable();
+            std::string report = Gnss_Profiler::get_instance()->report();
+            std::cout << "Profile of the hot paths:" << std::endl
+                      << report;
+            LOG(INFO) << "Profile of the hot paths:" << std::endl
+                      << report;
+        }
+    if (!snapshot_filename_.empty())
+        {
+            snapshot_thread_.join();
+            save_receiver_snapshot();
+        }
+    if (visibility_thread_.joinable())
+        {
+            visibility_thread_.join();
+        }
     flowgraph_->disconnect();
+    cmd_interface_.stop_cmd_server();
+    if (volk_autoprofile_)
+        {
+            volk_autoprofile_->cancel();
+            volk_autoprofile_thread_.join();
+        }
 
 // Join keyboard thread
 #ifdef OLD_BOOST
     keyboard_thread_.timed_join(boost::posix_time::seconds(1));
     sysv_queue_thread_.timed_join(boost::posix_time::seconds(1));
     cmd_interface_thread_.timed_join(boost::posix_time::seconds(1));
+    metrics_http_thread_.timed_join(boost::posix_time::seconds(1));
 #endif
 #ifndef OLD_BOOST
     keyboard_thread_.try_join_until(boost::chrono::steady_clock::now() + boost::chrono::milliseconds(1000));
     sysv_queue_thread_.try_join_until(boost::chrono::steady_clock::now() + boost::chrono::milliseconds(1000));
     cmd_interface_thread_.try_join_until(boost::chrono::steady_clock::now() + boost::chrono::milliseconds(1000));
+    metrics_http_thread_.try_join_until(boost::chrono::steady_clock::now() + boost::chrono::milliseconds(1000));
 #endif
+    if (supl_thread_.joinable())
+        {
+            // the SUPL requests cannot be cancelled, wait for their network timeouts
+            supl_thread_.join();
+        }
 
     LOG(INFO) << "Flowgraph stopped";
 
@@ -311,6 +497,55 @@ void ControlThread::set_control_queue(const gr::msg_queue::sptr &control_queue)
 }
 
 
+int ControlThread::dry_run_capacity()
+{
+    try
+        {
+            flowgraph_->connect();
+        }
+    catch (const std::exception &e)
+        {
+            LOG(ERROR) << e.what();
+        }
+    if (!flowgraph_->connected())
+        {
+            std::cout << "Unable to connect the flowgraph" << std::endl;
+            return 1;
+        }
+
+    Capacity_Planner planner(configuration_);
+    std::stringstream files(FLAGS_capacity_calibration);
+    std::string file;
+    while (std::getline(files, file, ','))
+        {
+            if (!file.empty() and !planner.load_calibration(file))
+                {
+                    std::cout << "Unable to read the calibration file " << file << std::endl;
+                }
+        }
+    int32_t cores = FLAGS_capacity_cores > 0 ? FLAGS_capacity_cores : static_cast<int32_t>(std::max(std::thread::hardware_concurrency(), 1U));
+    std::cout << planner.report(cores, std::min(std::max(FLAGS_capacity_margin, 0.0), 0.99)) << std::endl
+              << flowgraph_->get_memory_report();
+    return planner.fits() ? 0 : 1;
+}
+
+
+void ControlThread::set_process_listeners(bool enabled)
+{
+    process_listeners_ = enabled;
+}
+
+
+void ControlThread::stop()
+{
+    std::unique_ptr<ControlMessageFactory> cmf(new ControlMessageFactory());
+    if (control_queue_ != gr::msg_queue::sptr())
+        {
+            control_queue_->handle(cmf->GetQueueMessage(200, 0));
+        }
+}
+
+
 /*
  * Returns true if reading was successful
  */
@@ -543,6 +778,7 @@ void ControlThread::assist_GNSS()
     // GNSS Assistance configuration
     bool enable_gps_supl_assistance = configuration_->property("GNSS-SDR.SUPL_gps_enabled", false);
     bool enable_agnss_xml = configuration_->property("GNSS-SDR.AGNSS_XML_enabled", false);
+    bool supl_pending = false;
     if ((enable_gps_supl_assistance == true) and (enable_agnss_xml == false))
         {
             std::cout << "SUPL RRLP GPS assistance enabled!" << std::endl;
@@ -598,138 +834,27 @@ void ControlThread::assist_GNSS()
                             std::cout << "No SUPL request has been performed." << std::endl;
                         }
                 }
-            else
+            else if (supl_cache_is_valid())
                 {
-                    // Request ephemeris from SUPL server
-                    int error;
-                    supl_client_ephemeris_.request = 1;
-                    std::cout << "SUPL: Try to read GPS ephemeris data from SUPL server..." << std::endl;
-                    error = supl_client_ephemeris_.get_assistance(supl_mcc, supl_mns, supl_lac, supl_ci);
-                    if (error == 0)
-                        {
-                            std::map<int, Gps_Ephemeris>::const_iterator gps_eph_iter;
-                            for (gps_eph_iter = supl_client_ephemeris_.gps_ephemeris_map.cbegin();
-                                 gps_eph_iter != supl_client_ephemeris_.gps_ephemeris_map.cend();
-                                 gps_eph_iter++)
-                                {
-                                    std::cout << "SUPL: Received ephemeris data for satellite " << Gnss_Satellite("GPS", gps_eph_iter->second.i_satellite_PRN) << std::endl;
-                                    std::shared_ptr<Gps_Ephemeris> tmp_obj = std::make_shared<Gps_Ephemeris>(gps_eph_iter->second);
-                                    flowgraph_->send_telemetry_msg(pmt::make_any(tmp_obj));
-                                }
-                            // Save ephemeris to XML file
-                            std::string eph_xml_filename = configuration_->property("GNSS-SDR.SUPL_gps_ephemeris_xml", eph_default_xml_filename);
-                            if (supl_client_ephemeris_.save_ephemeris_map_xml(eph_xml_filename, supl_client_ephemeris_.gps_ephemeris_map) == true)
-                                {
-                                    std::cout << "SUPL: XML ephemeris data file created" << std::endl;
-                                }
-                            else
-                                {
-                                    std::cout << "SUPL: Failed to create XML ephemeris data file" << std::endl;
-                                }
-                        }
-                    else
-                        {
-                            std::cout << "ERROR: SUPL client request for ephemeris data returned " << error << std::endl;
-                            std::cout << "Please check your network connectivity and SUPL server configuration" << std::endl;
-                            std::cout << "Trying to read AGNSS data from local XML file(s)..." << std::endl;
-                            if (read_assistance_from_XML() == false)
-                                {
-                                    std::cout << "ERROR: Could not read XML files: Disabling SUPL assistance." << std::endl;
-                                }
-                        }
-
-                    // Request almanac, IONO and UTC Model data
-                    supl_client_ephemeris_.request = 0;
-                    std::cout << "SUPL: Try to read Almanac, Iono, Utc Model, Ref Time and Ref Location data from SUPL server..." << std::endl;
-                    error = supl_client_ephemeris_.get_assistance(supl_mcc, supl_mns, supl_lac, supl_ci);
-                    if (error == 0)
-                        {
-                            std::map<int, Gps_Almanac>::const_iterator gps_alm_iter;
-                            for (gps_alm_iter = supl_client_ephemeris_.gps_almanac_map.cbegin();
-                                 gps_alm_iter != supl_client_ephemeris_.gps_almanac_map.cend();
-                                 gps_alm_iter++)
-                                {
-                                    std::cout << "SUPL: Received almanac data for satellite " << Gnss_Satellite("GPS", gps_alm_iter->second.i_satellite_PRN) << std::endl;
-                                    std::shared_ptr<Gps_Almanac> tmp_obj = std::make_shared<Gps_Almanac>(gps_alm_iter->second);
-                                    flowgraph_->send_telemetry_msg(pmt::make_any(tmp_obj));
-                                }
-                            supl_client_ephemeris_.save_gps_almanac_xml("gps_almanac_map.xml", supl_client_ephemeris_.gps_almanac_map);
-                            if (supl_client_ephemeris_.gps_iono.valid == true)
-                                {
-                                    std::cout << "SUPL: Received GPS Ionosphere model parameters" << std::endl;
-                                    std::shared_ptr<Gps_Iono> tmp_obj = std::make_shared<Gps_Iono>(supl_client_ephemeris_.gps_iono);
-                                    flowgraph_->send_telemetry_msg(pmt::make_any(tmp_obj));
-                                }
-                            if (supl_client_ephemeris_.gps_utc.valid == true)
-                                {
-                                    std::cout << "SUPL: Received GPS UTC model parameters" << std::endl;
-                                    std::shared_ptr<Gps_Utc_Model> tmp_obj = std::make_shared<Gps_Utc_Model>(supl_client_ephemeris_.gps_utc);
-                                    flowgraph_->send_telemetry_msg(pmt::make_any(tmp_obj));
-                                }
-                            // Save iono and UTC model data to xml file
-                            std::string iono_xml_filename = configuration_->property("GNSS-SDR.SUPL_gps_iono_xml", iono_default_xml_filename);
-                            if (supl_client_ephemeris_.save_iono_xml(iono_xml_filename, supl_client_ephemeris_.gps_iono) == true)
-                                {
-                                    std::cout << "SUPL: Iono data file created" << std::endl;
-                                }
-                            else
-                                {
-                                    std::cout << "SUPL: Failed to create Iono data file" << std::endl;
-                                }
-                            std::string utc_xml_filename = configuration_->property("GNSS-SDR.SUPL_gps_utc_model_xml", utc_default_xml_filename);
-                            if (supl_client_ephemeris_.save_utc_xml(utc_xml_filename, supl_client_ephemeris_.gps_utc) == true)
-                                {
-                                    std::cout << "SUPL: UTC model data file created" << std::endl;
-                                }
-                            else
-                                {
-                                    std::cout << "SUPL: Failed to create UTC model data file" << std::endl;
-                                }
-                        }
-                    else
-                        {
-                            std::cout << "ERROR: SUPL client for almanac data returned " << error << std::endl;
-                            std::cout << "Please check your network connectivity and SUPL server configuration" << std::endl;
-                        }
-
-                    // Request acquisition assistance
-                    supl_client_acquisition_.request = 2;
-                    std::cout << "SUPL: Try to read acquisition assistance data from SUPL server..." << std::endl;
-                    error = supl_client_acquisition_.get_assistance(supl_mcc, supl_mns, supl_lac, supl_ci);
-                    if (error == 0)
-                        {
-                            std::map<int, Gps_Acq_Assist>::const_iterator gps_acq_iter;
-                            for (gps_acq_iter = supl_client_acquisition_.gps_acq_map.cbegin();
-                                 gps_acq_iter != supl_client_acquisition_.gps_acq_map.cend();
-                                 gps_acq_iter++)
-                                {
-                                    std::cout << "SUPL: Received acquisition assistance data for satellite " << Gnss_Satellite("GPS", gps_acq_iter->second.i_satellite_PRN) << std::endl;
-                                    global_gps_acq_assist_map.write(gps_acq_iter->second.i_satellite_PRN, gps_acq_iter->second);
-                                }
-                            if (supl_client_acquisition_.gps_ref_loc.valid == true)
-                                {
-                                    std::cout << "SUPL: Received Ref Location data (Acquisition Assistance)" << std::endl;
-                                    agnss_ref_location_ = supl_client_acquisition_.gps_ref_loc;
-                                    std::shared_ptr<Agnss_Ref_Location> tmp_obj = std::make_shared<Agnss_Ref_Location>(agnss_ref_location_);
-                                    flowgraph_->send_telemetry_msg(pmt::make_any(tmp_obj));
-                                    supl_client_acquisition_.save_ref_location_xml("agnss_ref_location.xml", agnss_ref_location_);
-                                }
-                            if (supl_client_acquisition_.gps_time.valid == true)
-                                {
-                                    std::cout << "SUPL: Received Ref Time data (Acquisition Assistance)" << std::endl;
-                                    agnss_ref_time_ = supl_client_acquisition_.gps_time;
-                                    std::shared_ptr<Agnss_Ref_Time> tmp_obj = std::make_shared<Agnss_Ref_Time>(agnss_ref_time_);
-                                    flowgraph_->send_telemetry_msg(pmt::make_any(tmp_obj));
-                                    supl_client_acquisition_.save_ref_time_xml("agnss_ref_time.xml", agnss_ref_time_);
-                                }
-                        }
-                    else
+                    // The data of a previous SUPL request is still valid
+                    if (read_assistance_from_XML())
                         {
-                            std::cout << "ERROR: SUPL client for acquisition assistance returned " << error << std::endl;
-                            std::cout << "Please check your network connectivity and SUPL server configuration" << std::endl;
-                            std::cout << "Disabling SUPL acquisition assistance." << std::endl;
+                            std::cout << "SUPL: GNSS assistance data loaded from the local cache." << std::endl;
+                            std::cout << "No SUPL request has been performed." << std::endl;
                         }
                 }
+            else if (configuration_->property("GNSS-SDR.SUPL_background_request", true))
+                {
+                    // Acquisitions start in cold mode, the assistance is applied when it arrives
+                    std::cout << "SUPL: Requesting assistance data in the background..." << std::endl;
+                    supl_thread_ = boost::thread(&ControlThread::supl_request_worker, this);
+                    supl_pending = true;
+                }
+            else
+                {
+                    request_supl_assistance();
+                    apply_supl_assistance();
+                }
         }
 
     if ((enable_gps_supl_assistance == false) and (enable_agnss_xml == true))
@@ -741,8 +866,238 @@ void ControlThread::assist_GNSS()
                 }
         }
 
-    // If AGNSS is enabled, make use of it
-    if ((agnss_ref_location_.valid == true) and ((enable_gps_supl_assistance == true) or (enable_agnss_xml == true)))
+    if (receiver_snapshot_loaded_)
+        {
+            // navigation data kept by the previous run
+            for (const auto& eph : receiver_snapshot_.gps_ephemeris)
+                {
+                    std::shared_ptr<Gps_Ephemeris> tmp_obj = std::make_shared<Gps_Ephemeris>(eph.second);
+                    flowgraph_->send_telemetry_msg(pmt::make_any(tmp_obj));
+                }
+            for (const auto& eph : receiver_snapshot_.galileo_ephemeris)
+                {
+                    std::shared_ptr<Galileo_Ephemeris> tmp_obj = std::make_shared<Galileo_Ephemeris>(eph.second);
+                    flowgraph_->send_telemetry_msg(pmt::make_any(tmp_obj));
+                }
+            for (const auto& alm : receiver_snapshot_.gps_almanac)
+                {
+                    std::shared_ptr<Gps_Almanac> tmp_obj = std::make_shared<Gps_Almanac>(alm.second);
+                    flowgraph_->send_telemetry_msg(pmt::make_any(tmp_obj));
+                }
+            for (const auto& alm : receiver_snapshot_.galileo_almanac)
+                {
+                    std::shared_ptr<Galileo_Almanac> tmp_obj = std::make_shared<Galileo_Almanac>(alm.second);
+                    flowgraph_->send_telemetry_msg(pmt::make_any(tmp_obj));
+                }
+            std::cout << "Receiver snapshot: " << receiver_snapshot_.gps_ephemeris.size() + receiver_snapshot_.galileo_ephemeris.size()
+                      << " ephemerides and " << snapshot_range_rates_.size() << " Doppler shifts restored" << std::endl;
+        }
+
+    if (!supl_pending)
+        {
+            priorize_assisted_satellites();
+        }
+}
+
+
+/*
+ * Returns true if the assistance data saved by the last SUPL request is
+ * younger than GNSS-SDR.SUPL_cache_validity_s
+ */
+bool ControlThread::supl_cache_is_valid()
+{
+    int64_t validity_s = configuration_->property("GNSS-SDR.SUPL_cache_validity_s", 7200);
+    if (validity_s <= 0)
+        {
+            return false;
+        }
+    std::string cache_filename = configuration_->property("GNSS-SDR.SUPL_cache_file", supl_cache_default_filename);
+    int64_t fetch_time = 0;
+    if (!gnss_sdr_load_binary_store(cache_filename, "GNSS-SDR_supl_fetch_time", fetch_time))
+        {
+            return false;
+        }
+    int64_t age_s = static_cast<int64_t>(time(nullptr)) - fetch_time;
+    LOG(INFO) << "SUPL: cached assistance data is " << age_s << " s old";
+    return (age_s >= 0) and (age_s < validity_s);
+}
+
+
+void ControlThread::supl_request_worker()
+{
+    request_supl_assistance();
+    // The assistance is applied by the control thread, see apply_action()
+    std::unique_ptr<ControlMessageFactory> cmf(new ControlMessageFactory());
+    if (control_queue_ != gr::msg_queue::sptr())
+        {
+            control_queue_->handle(cmf->GetQueueMessage(200, 14));
+        }
+}
+
+
+/*
+ * Network round trips of the SUPL assistance. It does not touch the flowgraph,
+ * so it can run in a background thread.
+ */
+void ControlThread::request_supl_assistance()
+{
+    // Request ephemeris from SUPL server
+    supl_client_ephemeris_.request = 1;
+    std::cout << "SUPL: Try to read GPS ephemeris data from SUPL server..." << std::endl;
+    supl_eph_error_ = supl_client_ephemeris_.get_assistance(supl_mcc, supl_mns, supl_lac, supl_ci);
+
+    // Request almanac, IONO and UTC Model data
+    // (from its own client, so the ephemeris received above are kept until they are applied)
+    supl_client_almanac_.server_name = supl_client_ephemeris_.server_name;
+    supl_client_almanac_.server_port = supl_client_ephemeris_.server_port;
+    supl_client_almanac_.request = 0;
+    std::cout << "SUPL: Try to read Almanac, Iono, Utc Model, Ref Time and Ref Location data from SUPL server..." << std::endl;
+    supl_alm_error_ = supl_client_almanac_.get_assistance(supl_mcc, supl_mns, supl_lac, supl_ci);
+
+    // Request acquisition assistance
+    supl_client_acquisition_.request = 2;
+    std::cout << "SUPL: Try to read acquisition assistance data from SUPL server..." << std::endl;
+    supl_acq_error_ = supl_client_acquisition_.get_assistance(supl_mcc, supl_mns, supl_lac, supl_ci);
+}
+
+
+/*
+ * Sends the data received by request_supl_assistance() to the flowgraph and saves it
+ */
+void ControlThread::apply_supl_assistance()
+{
+    if (supl_eph_error_ == 0)
+        {
+            std::map<int, Gps_Ephemeris>::const_iterator gps_eph_iter;
+            for (gps_eph_iter = supl_client_ephemeris_.gps_ephemeris_map.cbegin();
+                 gps_eph_iter != supl_client_ephemeris_.gps_ephemeris_map.cend();
+                 gps_eph_iter++)
+                {
+                    std::cout << "SUPL: Received ephemeris data for satellite " << Gnss_Satellite("GPS", gps_eph_iter->second.i_satellite_PRN) << std::endl;
+                    std::shared_ptr<Gps_Ephemeris> tmp_obj = std::make_shared<Gps_Ephemeris>(gps_eph_iter->second);
+                    flowgraph_->send_telemetry_msg(pmt::make_any(tmp_obj));
+                }
+            // Save ephemeris to XML file
+            std::string eph_xml_filename = configuration_->property("GNSS-SDR.SUPL_gps_ephemeris_xml", eph_default_xml_filename);
+            if (supl_client_ephemeris_.save_ephemeris_map_xml(eph_xml_filename, supl_client_ephemeris_.gps_ephemeris_map) == true)
+                {
+                    std::cout << "SUPL: XML ephemeris data file created" << std::endl;
+                    // Restarts within the validity of the ephemeris skip the SUPL request
+                    std::string cache_filename = configuration_->property("GNSS-SDR.SUPL_cache_file", supl_cache_default_filename);
+                    int64_t fetch_time = static_cast<int64_t>(time(nullptr));
+                    gnss_sdr_save_binary_store(cache_filename, "GNSS-SDR_supl_fetch_time", fetch_time);
+                }
+            else
+                {
+                    std::cout << "SUPL: Failed to create XML ephemeris data file" << std::endl;
+                }
+        }
+    else
+        {
+            std::cout << "ERROR: SUPL client request for ephemeris data returned " << supl_eph_error_ << std::endl;
+            std::cout << "Please check your network connectivity and SUPL server configuration" << std::endl;
+            std::cout << "Trying to read AGNSS data from local XML file(s)..." << std::endl;
+            if (read_assistance_from_XML() == false)
+                {
+                    std::cout << "ERROR: Could not read XML files: Disabling SUPL assistance." << std::endl;
+                }
+        }
+
+    if (supl_alm_error_ == 0)
+        {
+            std::map<int, Gps_Almanac>::const_iterator gps_alm_iter;
+            for (gps_alm_iter = supl_client_almanac_.gps_almanac_map.cbegin();
+                 gps_alm_iter != supl_client_almanac_.gps_almanac_map.cend();
+                 gps_alm_iter++)
+                {
+                    std::cout << "SUPL: Received almanac data for satellite " << Gnss_Satellite("GPS", gps_alm_iter->second.i_satellite_PRN) << std::endl;
+                    std::shared_ptr<Gps_Almanac> tmp_obj = std::make_shared<Gps_Almanac>(gps_alm_iter->second);
+                    flowgraph_->send_telemetry_msg(pmt::make_any(tmp_obj));
+                }
+            supl_client_almanac_.save_gps_almanac_xml("gps_almanac_map.xml", supl_client_almanac_.gps_almanac_map);
+            if (supl_client_almanac_.gps_iono.valid == true)
+                {
+                    std::cout << "SUPL: Received GPS Ionosphere model parameters" << std::endl;
+                    std::shared_ptr<Gps_Iono> tmp_obj = std::make_shared<Gps_Iono>(supl_client_almanac_.gps_iono);
+                    flowgraph_->send_telemetry_msg(pmt::make_any(tmp_obj));
+                }
+            if (supl_client_almanac_.gps_utc.valid == true)
+                {
+                    std::cout << "SUPL: Received GPS UTC model parameters" << std::endl;
+                    std::shared_ptr<Gps_Utc_Model> tmp_obj = std::make_shared<Gps_Utc_Model>(supl_client_almanac_.gps_utc);
+                    flowgraph_->send_telemetry_msg(pmt::make_any(tmp_obj));
+                }
+            // Save iono and UTC model data to xml file
+            std::string iono_xml_filename = configuration_->property("GNSS-SDR.SUPL_gps_iono_xml", iono_default_xml_filename);
+            if (supl_client_almanac_.save_iono_xml(iono_xml_filename, supl_client_almanac_.gps_iono) == true)
+                {
+                    std::cout << "SUPL: Iono data file created" << std::endl;
+                }
+            else
+                {
+                    std::cout << "SUPL: Failed to create Iono data file" << std::endl;
+                }
+            std::string utc_xml_filename = configuration_->property("GNSS-SDR.SUPL_gps_utc_model_xml", utc_default_xml_filename);
+            if (supl_client_almanac_.save_utc_xml(utc_xml_filename, supl_client_almanac_.gps_utc) == true)
+                {
+                    std::cout << "SUPL: UTC model data file created" << std::endl;
+                }
+            else
+                {
+                    std::cout << "SUPL: Failed to create UTC model data file" << std::endl;
+                }
+        }
+    else
+        {
+            std::cout << "ERROR: SUPL client for almanac data returned " << supl_alm_error_ << std::endl;
+            std::cout << "Please check your network connectivity and SUPL server configuration" << std::endl;
+        }
+
+    if (supl_acq_error_ == 0)
+        {
+            std::map<int, Gps_Acq_Assist>::const_iterator gps_acq_iter;
+            for (gps_acq_iter = supl_client_acquisition_.gps_acq_map.cbegin();
+                 gps_acq_iter != supl_client_acquisition_.gps_acq_map.cend();
+                 gps_acq_iter++)
+                {
+                    std::cout << "SUPL: Received acquisition assistance data for satellite " << Gnss_Satellite("GPS", gps_acq_iter->second.i_satellite_PRN) << std::endl;
+                    global_gps_acq_assist_map.write(gps_acq_iter->second.i_satellite_PRN, gps_acq_iter->second);
+                }
+            if (supl_client_acquisition_.gps_ref_loc.valid == true)
+                {
+                    std::cout << "SUPL: Received Ref Location data (Acquisition Assistance)" << std::endl;
+                    agnss_ref_location_ = supl_client_acquisition_.gps_ref_loc;
+                    std::shared_ptr<Agnss_Ref_Location> tmp_obj = std::make_shared<Agnss_Ref_Location>(agnss_ref_location_);
+                    flowgraph_->send_telemetry_msg(pmt::make_any(tmp_obj));
+                    supl_client_acquisition_.save_ref_location_xml("agnss_ref_location.xml", agnss_ref_location_);
+                }
+            if (supl_client_acquisition_.gps_time.valid == true)
+                {
+                    std::cout << "SUPL: Received Ref Time data (Acquisition Assistance)" << std::endl;
+                    agnss_ref_time_ = supl_client_acquisition_.gps_time;
+                    std::shared_ptr<Agnss_Ref_Time> tmp_obj = std::make_shared<Agnss_Ref_Time>(agnss_ref_time_);
+                    flowgraph_->send_telemetry_msg(pmt::make_any(tmp_obj));
+                    supl_client_acquisition_.save_ref_time_xml("agnss_ref_time.xml", agnss_ref_time_);
+                }
+        }
+    else
+        {
+            std::cout << "ERROR: SUPL client for acquisition assistance returned " << supl_acq_error_ << std::endl;
+            std::cout << "Please check your network connectivity and SUPL server configuration" << std::endl;
+            std::cout << "Disabling SUPL acquisition assistance." << std::endl;
+        }
+}
+
+
+/*
+ * If AGNSS is enabled, gives priority to the satellites visible from the
+ * reference location and restarts the search (hot start)
+ */
+void ControlThread::priorize_assisted_satellites()
+{
+    bool enable_gps_supl_assistance = configuration_->property("GNSS-SDR.SUPL_gps_enabled", false);
+    bool enable_agnss_xml = configuration_->property("GNSS-SDR.AGNSS_XML_enabled", false);
+    if ((agnss_ref_location_.valid == true) and ((enable_gps_supl_assistance == true) or (enable_agnss_xml == true) or receiver_snapshot_loaded_))
         {
             // Get the list of visible satellites
             arma::vec ref_LLH = arma::zeros(3, 1);
@@ -851,6 +1206,12 @@ void ControlThread::apply_action(unsigned int what)
             flowgraph_->priorize_satellites(visible_satellites);
             // start again the satellite acquisitions (done in chained apply_action to flowgraph)
             break;
+        case 14:
+            LOG(INFO) << "Received SUPL assistance data";
+            apply_supl_assistance();
+            priorize_assisted_satellites();
+            applied_actions_++;
+            break;
         default:
             LOG(INFO) << "Unrecognized action.";
             break;
@@ -858,133 +1219,65 @@ void ControlThread::apply_action(unsigned int what)
 }
 
 
-std::vector<std::pair<int, Gnss_Satellite>> ControlThread::get_visible_sats(time_t rx_utc_time, const arma::vec &LLH)
+std::vector<std::pair<int, Gnss_Satellite>> ControlThread::get_visible_sats(time_t rx_utc_time, const arma::vec &LLH, bool verbose)
 {
-    // 1. Compute rx ECEF position from LLH WGS84
-    arma::vec LLH_rad = arma::vec{degtorad(LLH(0)), degtorad(LLH(1)), LLH(2)};
-    arma::mat C_tmp = arma::zeros(3, 3);
-    arma::vec r_eb_e = arma::zeros(3, 1);
-    arma::vec v_eb_e = arma::zeros(3, 1);
-    Geo_to_ECEF(LLH_rad, arma::vec{0, 0, 0}, C_tmp, r_eb_e, v_eb_e, C_tmp);
-
-    // 2. Compute rx GPS time from UTC time
+    // 1. Compute rx GPS time from UTC time
     gtime_t utc_gtime;
     utc_gtime.time = rx_utc_time;
     utc_gtime.sec = 0;
     gtime_t gps_gtime = utc2gpst(utc_gtime);
 
-    // 3. loop through all the available ephemeris or almanac and compute satellite positions and elevations
-    // store visible satellites in a vector of pairs <int,Gnss_Satellite> to associate an elevation to the each satellite
-    std::vector<std::pair<int, Gnss_Satellite>> available_satellites;
-    std::vector<unsigned int> visible_gps;
-    std::vector<unsigned int> visible_gal;
+    // 2. update the orbits of the predictor with the available ephemeris and almanac.
+    // Only the satellites whose data changed since the last call are propagated again.
     std::shared_ptr<PvtInterface> pvt_ptr = flowgraph_->get_pvt();
-    struct tm tstruct = {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, nullptr};
-    char buf[80];
-    tstruct = *gmtime(&rx_utc_time);
-    strftime(buf, sizeof(buf), "%d/%m/%Y %H:%M:%S ", &tstruct);
-    std::string str_time = std::string(buf);
-    std::cout << "Get visible satellites at " << str_time
-              << "UTC, assuming RX position " << LLH(0) << " [deg], " << LLH(1) << " [deg], " << LLH(2) << " [m]" << std::endl;
-
-    std::map<int, Gps_Ephemeris> gps_eph_map = pvt_ptr->get_gps_ephemeris();
-    for (std::map<int, Gps_Ephemeris>::iterator it = gps_eph_map.begin(); it != gps_eph_map.end(); ++it)
-        {
-            eph_t rtklib_eph = eph_to_rtklib(it->second);
-            double r_sat[3];
-            double clock_bias_s;
-            double sat_pos_variance_m2;
-            eph2pos(gps_gtime, &rtklib_eph, &r_sat[0], &clock_bias_s,
-                &sat_pos_variance_m2);
-            double Az, El, dist_m;
-            arma::vec r_sat_eb_e = arma::vec{r_sat[0], r_sat[1], r_sat[2]};
-            arma::vec dx = r_sat_eb_e - r_eb_e;
-            topocent(&Az, &El, &dist_m, r_eb_e, dx);
-            // push sat
-            if (El > 0)
-                {
-                    std::cout << "Using GPS Ephemeris: Sat " << it->second.i_satellite_PRN << " Az: " << Az << " El: " << El << std::endl;
-                    available_satellites.push_back(std::pair<int, Gnss_Satellite>(floor(El),
-                        (Gnss_Satellite(std::string("GPS"), it->second.i_satellite_PRN))));
-                    visible_gps.push_back(it->second.i_satellite_PRN);
-                }
-        }
-
-    std::map<int, Galileo_Ephemeris> gal_eph_map = pvt_ptr->get_galileo_ephemeris();
-    for (std::map<int, Galileo_Ephemeris>::iterator it = gal_eph_map.begin(); it != gal_eph_map.end(); ++it)
-        {
-            eph_t rtklib_eph = eph_to_rtklib(it->second);
-            double r_sat[3];
-            double clock_bias_s;
-            double sat_pos_variance_m2;
-            eph2pos(gps_gtime, &rtklib_eph, &r_sat[0], &clock_bias_s,
-                &sat_pos_variance_m2);
-            double Az, El, dist_m;
-            arma::vec r_sat_eb_e = arma::vec{r_sat[0], r_sat[1], r_sat[2]};
-            arma::vec dx = r_sat_eb_e - r_eb_e;
-            topocent(&Az, &El, &dist_m, r_eb_e, dx);
-            // push sat
-            if (El > 0)
-                {
-                    std::cout << "Using Galileo Ephemeris: Sat " << it->second.i_satellite_PRN << " Az: " << Az << " El: " << El << std::endl;
-                    available_satellites.push_back(std::pair<int, Gnss_Satellite>(floor(El),
-                        (Gnss_Satellite(std::string("Galileo"), it->second.i_satellite_PRN))));
-                    visible_gal.push_back(it->second.i_satellite_PRN);
-                }
-        }
-
-    std::map<int, Gps_Almanac> gps_alm_map = pvt_ptr->get_gps_almanac();
-    for (std::map<int, Gps_Almanac>::iterator it = gps_alm_map.begin(); it != gps_alm_map.end(); ++it)
-        {
-            alm_t rtklib_alm = alm_to_rtklib(it->second);
-            double r_sat[3];
-            double clock_bias_s;
-            gtime_t aux_gtime;
-            aux_gtime.time = fmod(utc2gpst(gps_gtime).time + 345600, 604800);
-            alm2pos(aux_gtime, &rtklib_alm, &r_sat[0], &clock_bias_s);
-            double Az, El, dist_m;
-            arma::vec r_sat_eb_e = arma::vec{r_sat[0], r_sat[1], r_sat[2]};
-            arma::vec dx = r_sat_eb_e - r_eb_e;
-            topocent(&Az, &El, &dist_m, r_eb_e, dx);
-            // push sat
-            std::vector<unsigned int>::iterator it2;
-            if (El > 0)
-                {
-                    it2 = std::find(visible_gps.begin(), visible_gps.end(), it->second.i_satellite_PRN);
-                    if (it2 == visible_gps.end())
-                        {
-                            std::cout << "Using GPS Almanac:  Sat " << it->second.i_satellite_PRN << " Az: " << Az << " El: " << El << std::endl;
-                            available_satellites.push_back(std::pair<int, Gnss_Satellite>(floor(El),
-                                (Gnss_Satellite(std::string("GPS"), it->second.i_satellite_PRN))));
-                        }
-                }
+    std::lock_guard<std::mutex> lock(visibility_mutex_);
+    std::shared_ptr<const std::map<int, Gps_Ephemeris>> gps_eph_map = pvt_ptr->get_gps_ephemeris();
+    for (const auto &eph : *gps_eph_map)
+        {
+            visibility_predictor_.set_ephemeris("GPS", eph.second.i_satellite_PRN, eph_to_rtklib(eph.second));
+        }
+    std::shared_ptr<const std::map<int, Galileo_Ephemeris>> gal_eph_map = pvt_ptr->get_galileo_ephemeris();
+    for (const auto &eph : *gal_eph_map)
+        {
+            visibility_predictor_.set_ephemeris("Galileo", eph.second.i_satellite_PRN, eph_to_rtklib(eph.second));
+        }
+    std::shared_ptr<const std::map<int, Gps_Almanac>> gps_alm_map = pvt_ptr->get_gps_almanac();
+    for (const auto &alm : *gps_alm_map)
+        {
+            visibility_predictor_.set_almanac("GPS", alm.second.i_satellite_PRN, alm_to_rtklib(alm.second));
+        }
+    std::shared_ptr<const std::map<int, Galileo_Almanac>> gal_alm_map = pvt_ptr->get_galileo_almanac();
+    for (const auto &alm : *gal_alm_map)
+        {
+            visibility_predictor_.set_almanac("Galileo", alm.second.i_satellite_PRN, alm_to_rtklib(alm.second));
         }
+    visibility_predictor_.remove_stale();
 
-    std::map<int, Galileo_Almanac> gal_alm_map = pvt_ptr->get_galileo_almanac();
-    for (std::map<int, Galileo_Almanac>::iterator it = gal_alm_map.begin(); it != gal_alm_map.end(); ++it)
+    if (verbose)
         {
-            alm_t rtklib_alm = alm_to_rtklib(it->second);
-            double r_sat[3];
-            double clock_bias_s;
-            gtime_t gal_gtime;
-            gal_gtime.time = fmod(utc2gpst(gps_gtime).time + 345600, 604800);
-            alm2pos(gal_gtime, &rtklib_alm, &r_sat[0], &clock_bias_s);
-            double Az, El, dist_m;
-            arma::vec r_sat_eb_e = arma::vec{r_sat[0], r_sat[1], r_sat[2]};
-            arma::vec dx = r_sat_eb_e - r_eb_e;
-            topocent(&Az, &El, &dist_m, r_eb_e, dx);
-            // push sat
-            std::vector<unsigned int>::iterator it2;
-            if (El > 0)
+            struct tm tstruct = {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, nullptr};
+            char buf[80];
+            tstruct = *gmtime(&rx_utc_time);
+            strftime(buf, sizeof(buf), "%d/%m/%Y %H:%M:%S ", &tstruct);
+            std::string str_time = std::string(buf);
+            std::cout << "Get visible satellites at " << str_time
+                      << "UTC, assuming RX position " << LLH(0) << " [deg], " << LLH(1) << " [deg], " << LLH(2) << " [m]" << std::endl;
+        }
+
+    // 3. compute the elevations of all the satellites at once, and
+    // store visible satellites in a vector of pairs <int,Gnss_Satellite> to associate an elevation to the each satellite
+    std::vector<std::pair<int, Gnss_Satellite>> available_satellites;
+    std::map<std::pair<std::string, uint32_t>, double> range_rates;  // predicted line-of-sight velocity [m/s]
+    for (const auto &sat : visibility_predictor_.predict(gps_gtime, LLH(0), LLH(1), LLH(2)))
+        {
+            if (verbose)
                 {
-                    it2 = std::find(visible_gal.begin(), visible_gal.end(), it->second.i_satellite_PRN);
-                    if (it2 == visible_gal.end())
-                        {
-                            std::cout << "Using Galileo Almanac:  Sat " << it->second.i_satellite_PRN << " Az: " << Az << " El: " << El << std::endl;
-                            available_satellites.push_back(std::pair<int, Gnss_Satellite>(floor(El),
-                                (Gnss_Satellite(std::string("Galileo"), it->second.i_satellite_PRN))));
-                        }
+                    std::cout << "Using " << sat.system << (sat.from_almanac ? " Almanac:  Sat " : " Ephemeris: Sat ") << sat.prn
+                              << " Az: " << sat.azimuth_deg << " El: " << sat.elevation_deg << std::endl;
                 }
+            available_satellites.push_back(std::pair<int, Gnss_Satellite>(floor(sat.elevation_deg),
+                (Gnss_Satellite(sat.system, sat.prn))));
+            range_rates[std::make_pair(sat.system, sat.prn)] = sat.range_rate_m_s;
         }
 
     // sort the visible satellites in ascending order of elevation
@@ -993,10 +1286,122 @@ std::vector<std::pair<int, Gnss_Satellite>> ControlThread::get_visible_sats(time
     });
     // provide list starting from satellites with higher elevation
     std::reverse(available_satellites.begin(), available_satellites.end());
+
+    // the Doppler shifts measured right before a restart are better than the predicted ones, if available
+    for (const auto& range_rate : snapshot_range_rates_)
+        {
+            range_rates[range_rate.first] = range_rate.second;
+        }
+    snapshot_range_rates_.clear();
+
+    // the predicted Doppler shifts narrow the search of the next acquisitions
+    flowgraph_->set_predicted_range_rates(range_rates);
     return available_satellites;
 }
 
 
+bool ControlThread::save_receiver_snapshot()
+{
+    std::shared_ptr<PvtInterface> pvt_ptr = flowgraph_->get_pvt();
+    Gnss_Receiver_Snapshot snapshot;
+    snapshot.save_utc_time = static_cast<int64_t>(time(nullptr));
+    double ground_speed_kmh;
+    double course_over_ground_deg;
+    time_t pvt_utc_time;
+    snapshot.pvt_valid = pvt_ptr->get_latest_PVT(&snapshot.longitude_deg, &snapshot.latitude_deg, &snapshot.height_m, &ground_speed_kmh, &course_over_ground_deg, &pvt_utc_time);
+    if (!snapshot.pvt_valid and receiver_snapshot_loaded_ and receiver_snapshot_.pvt_valid)
+        {
+            // no fix yet in this run, keep the last known position
+            snapshot.pvt_valid = true;
+            snapshot.latitude_deg = receiver_snapshot_.latitude_deg;
+            snapshot.longitude_deg = receiver_snapshot_.longitude_deg;
+            snapshot.height_m = receiver_snapshot_.height_m;
+        }
+    snapshot.gps_ephemeris = *pvt_ptr->get_gps_ephemeris();
+    snapshot.galileo_ephemeris = *pvt_ptr->get_galileo_ephemeris();
+    snapshot.gps_almanac = *pvt_ptr->get_gps_almanac();
+    snapshot.galileo_almanac = *pvt_ptr->get_galileo_almanac();
+
+    for (const auto& entry : state_registry_->get_states(1.0))
+        {
+            Gnss_Snapshot_Tracking_State state;
+            switch (std::get<0>(entry.first))
+                {
+                case 'G':
+                    state.system = "GPS";
+                    break;
+                case 'E':
+                    state.system = "Galileo";
+                    break;
+                case 'R':
+                    state.system = "Glonass";
+                    break;
+                default:
+                    continue;
+                }
+            state.prn = std::get<1>(entry.first);
+            state.signal = std::get<2>(entry.first);
+            state.carrier_doppler_hz = entry.second.carrier_doppler_hz;
+            state.carrier_freq_hz = entry.second.carrier_freq_hz;
+            state.cn0_db_hz = entry.second.cn0_db_hz;
+            snapshot.tracking_states.push_back(state);
+        }
+
+    if (!gnss_sdr_save_binary_store(snapshot_filename_, "GNSS-SDR_receiver_snapshot", snapshot))
+        {
+            return false;
+        }
+    DLOG(INFO) << "Receiver snapshot saved: " << snapshot.tracking_states.size() << " signals in tracking";
+    return true;
+}
+
+
+void ControlThread::snapshot_writer()
+{
+    int interval_s = configuration_->property("GNSS-SDR.snapshot_interval_s", 60);
+    if (interval_s <= 0)
+        {
+            return;  // only on shutdown
+        }
+    while (!stop_)
+        {
+            for (int i = 0; (i < 10 * interval_s) and !stop_; i++)
+                {
+                    boost::this_thread::sleep(boost::posix_time::milliseconds(100));
+                }
+            if (!stop_)
+                {
+                    save_receiver_snapshot();
+                }
+        }
+}
+
+
+void ControlThread::visibility_updater()
+{
+    int interval_s = configuration_->property("GNSS-SDR.reprioritize_interval_s", 0);
+    std::shared_ptr<PvtInterface> pvt_ptr = flowgraph_->get_pvt();
+    while (!stop_)
+        {
+            for (int i = 0; (i < 10 * interval_s) and !stop_; i++)
+                {
+                    boost::this_thread::sleep(boost::posix_time::milliseconds(100));
+                }
+            double longitude_deg;
+            double latitude_deg;
+            double height_m;
+            double ground_speed_kmh;
+            double course_over_ground_deg;
+            time_t pvt_utc_time;
+            if (!stop_ and pvt_ptr->get_latest_PVT(&longitude_deg, &latitude_deg, &height_m, &ground_speed_kmh, &course_over_ground_deg, &pvt_utc_time))
+                {
+                    arma::vec LLH = {latitude_deg, longitude_deg, height_m};
+                    flowgraph_->priorize_satellites(get_visible_sats(pvt_utc_time, LLH, false));
+                }
+        }
+}
+
+
 void ControlThread::gps_acq_assist_data_collector()
 {
     // ############ 1.bis READ EPHEMERIS/UTC_MODE/IONO QUEUE ####################
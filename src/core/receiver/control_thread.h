@@ -40,13 +40,21 @@
 #include "configuration_interface.h"
 #include "control_message_factory.h"
 #include "gnss_flowgraph.h"
+#include "gnss_receiver_snapshot.h"
 #include "gnss_satellite.h"
 #include "gnss_sdr_supl_client.h"
+#include "gnss_tracking_state_registry.h"
 #include "tcp_cmd_interface.h"
+#include "visibility_predictor.h"
+#include "volk_gnsssdr_autoprofile.h"
 #include <armadillo>
 #include <boost/thread.hpp>
 #include <gnuradio/msg_queue.h>
+#include <map>
 #include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
 #include <vector>
 
 
@@ -88,6 +96,13 @@ public:
      */
     int run();
 
+    /*!
+     * \brief Connects the flowgraph without starting it, and writes the
+     * estimated load of the receiver on this machine (see Capacity_Planner)
+     * and the memory of its blocks. Returns 0 if it fits in real time.
+     */
+    int dry_run_capacity();
+
     /*!
      * \brief Sets the control_queue
      *
@@ -95,6 +110,18 @@ public:
      */
     void set_control_queue(const gr::msg_queue::sptr& control_queue);
 
+    /*!
+     * \brief Whether the receiver stops on the 'q' keystroke and on the SysV
+     * stop message (default). In a process running several receivers, only
+     * one of them listens to them.
+     */
+    void set_process_listeners(bool enabled);
+
+    /*!
+     * \brief Asks the receiver to stop, from any thread
+     */
+    void stop();
+
 
     unsigned int processed_control_messages()
     {
@@ -121,9 +148,16 @@ private:
     TcpCmdInterface cmd_interface_;
     void telecommand_listener();
     boost::thread cmd_interface_thread_;
+    //Metrics HTTP endpoint
+    void metrics_http_listener();
+    boost::thread metrics_http_thread_;
+    //Profile of the VOLK_GNSSSDR kernels in use, if missing
+    std::unique_ptr<Volk_Gnsssdr_Autoprofile> volk_autoprofile_;
+    boost::thread volk_autoprofile_thread_;
     //SUPL assistance classes
     gnss_sdr_supl_client supl_client_acquisition_;
     gnss_sdr_supl_client supl_client_ephemeris_;
+    gnss_sdr_supl_client supl_client_almanac_;
     int supl_mcc;  // Current network MCC (Mobile country code), 3 digits.
     int supl_mns;  // Current network MNC (Mobile Network code), 2 or 3 digits.
     int supl_lac;  // Current network LAC (Location area code),16 bits, 1-65520 are valid values.
@@ -150,13 +184,52 @@ private:
      * Compute elevations for the specified time and position for all the available satellites in ephemeris and almanac queues
      * returns a vector filled with the available satellites ordered from high elevation to low elevation angle.
      */
-    std::vector<std::pair<int, Gnss_Satellite>> get_visible_sats(time_t rx_utc_time, const arma::vec& LLH);
+    std::vector<std::pair<int, Gnss_Satellite>> get_visible_sats(time_t rx_utc_time, const arma::vec& LLH, bool verbose = true);
+    Visibility_Predictor visibility_predictor_;
+    std::mutex visibility_mutex_;
+
+    /*
+     * Every GNSS-SDR.reprioritize_interval_s seconds, sorts the search list of the
+     * channels by the elevation of the satellites at the last PVT fix
+     */
+    void visibility_updater();
+    boost::thread visibility_thread_;
 
     /*
      * Read initial GNSS assistance from SUPL server or local XML files
      */
     void assist_GNSS();
 
+    /*
+     * SUPL assistance: the network requests can run in a background thread
+     * (GNSS-SDR.SUPL_background_request), which asks the control thread to
+     * apply the received data to the running flowgraph. The time of the last
+     * successful request is saved in GNSS-SDR.SUPL_cache_file, and the saved
+     * XML files are used instead of a new request within
+     * GNSS-SDR.SUPL_cache_validity_s seconds.
+     */
+    bool supl_cache_is_valid();
+    void supl_request_worker();
+    void request_supl_assistance();
+    void apply_supl_assistance();
+    void priorize_assisted_satellites();
+    boost::thread supl_thread_;
+    int supl_eph_error_;
+    int supl_alm_error_;
+    int supl_acq_error_;
+
+    /*
+     * Receiver snapshot: saved every GNSS-SDR.snapshot_interval_s seconds and on shutdown,
+     * loaded at startup and used as assistance by assist_GNSS()
+     */
+    bool save_receiver_snapshot();
+    void snapshot_writer();
+    std::string snapshot_filename_;
+    Gnss_Receiver_Snapshot receiver_snapshot_;
+    bool receiver_snapshot_loaded_;
+    std::map<std::pair<std::string, uint32_t>, double> snapshot_range_rates_;  // range rates [m/s] from the Doppler shifts in the snapshot
+    boost::thread snapshot_thread_;
+
     void apply_action(unsigned int what);
     std::shared_ptr<GNSSFlowgraph> flowgraph_;
     std::shared_ptr<ConfigurationInterface> configuration_;
@@ -175,6 +248,10 @@ private:
     void keyboard_listener();
     void sysv_queue_listener();
     int msqid;
+    bool process_listeners_;
+
+    // tracking states of the channels of this receiver, not shared with the other receivers of the process
+    std::shared_ptr<Gnss_Tracking_State_Registry> state_registry_;
 
     // default filename for assistance data
     const std::string eph_default_xml_filename = "./gps_ephemeris.xml";
@@ -191,6 +268,7 @@ private:
     const std::string glo_utc_default_xml_filename = "./glo_utc_model.xml";
     const std::string gal_almanac_default_xml_filename = "./gal_almanac.xml";
     const std::string gps_almanac_default_xml_filename = "./gps_almanac.xml";
+    const std::string supl_cache_default_filename = "./supl_assistance_time.bin";
 
     Agnss_Ref_Location agnss_ref_location_;
     Agnss_Ref_Time agnss_ref_time_;
@@ -40,11 +40,14 @@
 #include "beamformer_filter.h"
 #include "byte_to_short.h"
 #include "channel.h"
+#include "channelizer_signal_conditioner.h"
 #include "configuration_interface.h"
+#include "direct_file_signal_source.h"
 #include "direct_resampler_conditioner.h"
 #include "file_signal_source.h"
 #include "fir_filter.h"
 #include "freq_xlating_fir_filter.h"
+#include "fused_signal_conditioner.h"
 #include "galileo_e1_dll_pll_veml_tracking.h"
 #include "galileo_e1_pcps_8ms_ambiguous_acquisition.h"
 #include "galileo_e1_pcps_ambiguous_acquisition.h"
@@ -90,20 +93,26 @@
 #include "ishort_to_complex.h"
 #include "ishort_to_cshort.h"
 #include "labsat_signal_source.h"
+#include "mmap_file_signal_source.h"
 #include "mmse_resampler_conditioner.h"
+#include "multi_file_signal_source.h"
 #include "notch_filter.h"
 #include "notch_filter_lite.h"
 #include "nsr_file_signal_source.h"
+#include "packed_iq_file_signal_source.h"
 #include "pass_through.h"
+#include "polyphase_resampler_conditioner.h"
 #include "pulse_blanking_filter.h"
 #include "rtklib_pvt.h"
 #include "rtl_tcp_signal_source.h"
 #include "sbas_l1_telemetry_decoder.h"
+#include "shm_signal_source.h"
 #include "signal_conditioner.h"
 #include "spir_file_signal_source.h"
 #include "spir_gss6450_file_signal_source.h"
 #include "two_bit_cpx_file_signal_source.h"
 #include "two_bit_packed_file_signal_source.h"
+#include "udp_sample_signal_source.h"
 
 #if RAW_UDP
 #include "custom_udp_signal_source.h"
@@ -163,9 +172,14 @@
 #endif
 
 #include <glog/logging.h>
+#include <algorithm>
+#include <atomic>
+#include <functional>
 #include <iostream>
 #include <sstream>
 #include <string>
+#include <thread>
+#include <unordered_map>
 
 
 using google::LogMessage;
@@ -245,6 +259,22 @@ std::unique_ptr<GNSSBlockInterface> GNSSBlockFactory::GetSignalConditioner(
               << input_filter << ", and Resampler implementation: "
               << resampler;
 
+    if (signal_conditioner == "Fused_Signal_Conditioner")
+        {
+            //data type adapter, input filter and resampler in a single block
+            LOG(INFO) << "The DataTypeAdapter, InputFilter and Resampler blocks are replaced by " << role_conditioner;
+            std::unique_ptr<GNSSBlockInterface> conditioner_(new FusedSignalConditioner(configuration.get(),
+                role_conditioner, 1, 1));
+            return conditioner_;
+        }
+    if (signal_conditioner == "Channelizer_Signal_Conditioner")
+        {
+            //one polyphase filter bank pass for all the sub-bands of a wideband input
+            LOG(INFO) << "The DataTypeAdapter, InputFilter and Resampler blocks are replaced by " << role_conditioner;
+            std::unique_ptr<GNSSBlockInterface> conditioner_(new ChannelizerSignalConditioner(configuration.get(),
+                role_conditioner, 1, 1));
+            return conditioner_;
+        }
     if (signal_conditioner == "Array_Signal_Conditioner")
         {
             //instantiate the array version
@@ -280,6 +310,10 @@ std::unique_ptr<GNSSBlockInterface> GNSSBlockFactory::GetObservables(std::shared
     GPS_channels += configuration->property("Channels_L5.count", 0);
     unsigned int Glonass_channels = configuration->property("Channels_1G.count", 0);
     unsigned int extra_channels = 1;  // For monitor channel sample counter
+    if (configuration->property("GNSS-SDR.shared_sample_clock", false) and configuration->property("GNSS-SDR.distributed_role", std::string("")).empty())
+        {
+            extra_channels = 0;  // the epochs come from the shared sample clock, see GNSSFlowgraph::connect()
+        }
     return GetBlock(configuration, "Observables", implementation,
         Galileo_channels +
             GPS_channels +
@@ -802,6 +836,7 @@ std::unique_ptr<std::vector<std::unique_ptr<GNSSBlockInterface>>> GNSSBlockFacto
                                   Channels_L5_count;
 
     std::unique_ptr<std::vector<std::unique_ptr<GNSSBlockInterface>>> channels(new std::vector<std::unique_ptr<GNSSBlockInterface>>(total_channels));
+    std::vector<std::function<std::unique_ptr<GNSSBlockInterface>()>> channel_builders(total_channels);
     try
         {
             //**************** GPS L1 C/A  CHANNELS **********************
@@ -824,13 +859,15 @@ std::unique_ptr<std::vector<std::unique_ptr<GNSSBlockInterface>>> GNSSBlockFacto
                         "TelemetryDecoder_1C" + std::to_string(channel_absolute_id) + ".implementation",
                         telemetry_decoder_implementation);
 
-                    // Push back the channel to the vector of channels
-                    channels->at(channel_absolute_id) = GetChannel_1C(configuration,
-                        acquisition_implementation_specific,
-                        tracking_implementation_specific,
-                        telemetry_decoder_implementation_specific,
-                        channel_absolute_id,
-                        queue);
+                    // The channel is built below, maybe at the same time as others
+                    channel_builders.at(channel_absolute_id) = [=]() {
+                        return GetChannel_1C(configuration,
+                            acquisition_implementation_specific,
+                            tracking_implementation_specific,
+                            telemetry_decoder_implementation_specific,
+                            channel_absolute_id,
+                            queue);
+                    };
                     channel_absolute_id++;
                 }
 
@@ -853,13 +890,15 @@ std::unique_ptr<std::vector<std::unique_ptr<GNSSBlockInterface>>> GNSSBlockFacto
                         "TelemetryDecoder_2S" + std::to_string(channel_absolute_id) + ".implementation",
                         telemetry_decoder_implementation);
 
-                    // Push back the channel to the vector of channels
-                    channels->at(channel_absolute_id) = GetChannel_2S(configuration,
-                        acquisition_implementation_specific,
-                        tracking_implementation_specific,
-                        telemetry_decoder_implementation_specific,
-                        channel_absolute_id,
-                        queue);
+                    // The channel is built below, maybe at the same time as others
+                    channel_builders.at(channel_absolute_id) = [=]() {
+                        return GetChannel_2S(configuration,
+                            acquisition_implementation_specific,
+                            tracking_implementation_specific,
+                            telemetry_decoder_implementation_specific,
+                            channel_absolute_id,
+                            queue);
+                    };
                     channel_absolute_id++;
                 }
 
@@ -882,13 +921,15 @@ std::unique_ptr<std::vector<std::unique_ptr<GNSSBlockInterface>>> GNSSBlockFacto
                         "TelemetryDecoder_L5" + std::to_string(channel_absolute_id) + ".implementation",
                         telemetry_decoder_implementation);
 
-                    // Push back the channel to the vector of channels
-                    channels->at(channel_absolute_id) = GetChannel_L5(configuration,
-                        acquisition_implementation_specific,
-                        tracking_implementation_specific,
-                        telemetry_decoder_implementation_specific,
-                        channel_absolute_id,
-                        queue);
+                    // The channel is built below, maybe at the same time as others
+                    channel_builders.at(channel_absolute_id) = [=]() {
+                        return GetChannel_L5(configuration,
+                            acquisition_implementation_specific,
+                            tracking_implementation_specific,
+                            telemetry_decoder_implementation_specific,
+                            channel_absolute_id,
+                            queue);
+                    };
                     channel_absolute_id++;
                 }
 
@@ -911,13 +952,15 @@ std::unique_ptr<std::vector<std::unique_ptr<GNSSBlockInterface>>> GNSSBlockFacto
                         "TelemetryDecoder_1B" + std::to_string(channel_absolute_id) + ".implementation",
                         telemetry_decoder_implementation);
 
-                    // Push back the channel to the vector of channels
-                    channels->at(channel_absolute_id) = GetChannel_1B(configuration,
-                        acquisition_implementation_specific,
-                        tracking_implementation_specific,
-                        telemetry_decoder_implementation_specific,
-                        channel_absolute_id,
-                        queue);
+                    // The channel is built below, maybe at the same time as others
+                    channel_builders.at(channel_absolute_id) = [=]() {
+                        return GetChannel_1B(configuration,
+                            acquisition_implementation_specific,
+                            tracking_implementation_specific,
+                            telemetry_decoder_implementation_specific,
+                            channel_absolute_id,
+                            queue);
+                    };
                     channel_absolute_id++;
                 }
 
@@ -940,13 +983,15 @@ std::unique_ptr<std::vector<std::unique_ptr<GNSSBlockInterface>>> GNSSBlockFacto
                         "TelemetryDecoder_5X" + std::to_string(channel_absolute_id) + ".implementation",
                         telemetry_decoder_implementation);
 
-                    // Push back the channel to the vector of channels
-                    channels->at(channel_absolute_id) = GetChannel_5X(configuration,
-                        acquisition_implementation_specific,
-                        tracking_implementation_specific,
-                        telemetry_decoder_implementation_specific,
-                        channel_absolute_id,
-                        queue);
+                    // The channel is built below, maybe at the same time as others
+                    channel_builders.at(channel_absolute_id) = [=]() {
+                        return GetChannel_5X(configuration,
+                            acquisition_implementation_specific,
+                            tracking_implementation_specific,
+                            telemetry_decoder_implementation_specific,
+                            channel_absolute_id,
+                            queue);
+                    };
                     channel_absolute_id++;
                 }
 
@@ -970,13 +1015,15 @@ std::unique_ptr<std::vector<std::unique_ptr<GNSSBlockInterface>>> GNSSBlockFacto
                         "TelemetryDecoder_1G" + std::to_string(channel_absolute_id) + ".implementation",
                         telemetry_decoder_implementation);
 
-                    // Push back the channel to the vector of channels
-                    channels->at(channel_absolute_id) = GetChannel_1G(configuration,
-                        acquisition_implementation_specific,
-                        tracking_implementation_specific,
-                        telemetry_decoder_implementation_specific,
-                        channel_absolute_id,
-                        queue);
+                    // The channel is built below, maybe at the same time as others
+                    channel_builders.at(channel_absolute_id) = [=]() {
+                        return GetChannel_1G(configuration,
+                            acquisition_implementation_specific,
+                            tracking_implementation_specific,
+                            telemetry_decoder_implementation_specific,
+                            channel_absolute_id,
+                            queue);
+                    };
                     channel_absolute_id++;
                 }
 
@@ -1000,15 +1047,19 @@ std::unique_ptr<std::vector<std::unique_ptr<GNSSBlockInterface>>> GNSSBlockFacto
                         "TelemetryDecoder_2G" + std::to_string(channel_absolute_id) + ".implementation",
                         telemetry_decoder_implementation);
 
-                    // Push back the channel to the vector of channels
-                    channels->at(channel_absolute_id) = GetChannel_2G(configuration,
-                        acquisition_implementation_specific,
-                        tracking_implementation_specific,
-                        telemetry_decoder_implementation_specific,
-                        channel_absolute_id,
-                        queue);
+                    // The channel is built below, maybe at the same time as others
+                    channel_builders.at(channel_absolute_id) = [=]() {
+                        return GetChannel_2G(configuration,
+                            acquisition_implementation_specific,
+                            tracking_implementation_specific,
+                            telemetry_decoder_implementation_specific,
+                            channel_absolute_id,
+                            queue);
+                    };
                     channel_absolute_id++;
                 }
+
+            BuildChannels(configuration, channel_builders, *channels);
         }
     catch (const std::exception &e)
         {
@@ -1020,664 +1071,334 @@ std::unique_ptr<std::vector<std::unique_ptr<GNSSBlockInterface>>> GNSSBlockFacto
 
 
 /*
- * Returns the block with the required configuration and implementation
- *
- * PLEASE ADD YOUR NEW BLOCK HERE!!
- *
- * IMPORTANT NOTE: Acquisition, Tracking and telemetry blocks are only included here for testing purposes.
- * To be included in a channel they must be also be included in GetAcqBlock(), GetTrkBlock() and GetTlmBlock()
- * (see below)
+ * Each channel generates its codes, plans its FFTs and allocates its buffers
+ * independently of the others, so with GNSS-SDR.init_threads > 1 they are built
+ * by a pool of threads. FFTW planning is serialized by GNU Radio, and is cheap
+ * when GNSS-SDR.fft_wisdom_filename is set.
  */
-std::unique_ptr<GNSSBlockInterface> GNSSBlockFactory::GetBlock(
-    std::shared_ptr<ConfigurationInterface> configuration,
-    std::string role,
-    std::string implementation, unsigned int in_streams,
-    unsigned int out_streams, gr::msg_queue::sptr queue)
+void GNSSBlockFactory::BuildChannels(std::shared_ptr<ConfigurationInterface> configuration,
+    const std::vector<std::function<std::unique_ptr<GNSSBlockInterface>()>> &channel_builders,
+    std::vector<std::unique_ptr<GNSSBlockInterface>> &channels)
 {
-    std::unique_ptr<GNSSBlockInterface> block;
-
-    //PASS THROUGH ----------------------------------------------------------------
-    if (implementation == "Pass_Through")
+    unsigned int n_threads = configuration->property("GNSS-SDR.init_threads", 1U);
+    if (n_threads == 0)
         {
-            std::unique_ptr<GNSSBlockInterface> block_(new Pass_Through(configuration.get(), role, in_streams, out_streams));
-            block = std::move(block_);
+            n_threads = std::max(std::thread::hardware_concurrency(), 1U);
         }
+    n_threads = std::min(n_threads, static_cast<unsigned int>(channel_builders.size()));
 
-    // SIGNAL SOURCES -------------------------------------------------------------
-    else if (implementation == "File_Signal_Source")
+    if (n_threads <= 1)
         {
-            try
+            for (size_t i = 0; i < channel_builders.size(); i++)
                 {
-                    std::unique_ptr<GNSSBlockInterface> block_(new FileSignalSource(configuration.get(), role, in_streams,
-                        out_streams, queue));
-                    block = std::move(block_);
-                }
-
-            catch (const std::exception &e)
-                {
-                    std::cout << "GNSS-SDR program ended." << std::endl;
-                    exit(1);
+                    channels.at(i) = channel_builders[i]();
                 }
+            return;
         }
-#if RAW_UDP
-    else if (implementation == "Custom_UDP_Signal_Source")
-        {
-            try
-                {
-                    std::unique_ptr<GNSSBlockInterface> block_(new CustomUDPSignalSource(configuration.get(), role, in_streams,
-                        out_streams, queue));
-                    block = std::move(block_);
-                }
 
-            catch (const std::exception &e)
-                {
-                    std::cout << "GNSS-SDR program ended." << std::endl;
-                    exit(1);
-                }
-        }
-#endif
-    else if (implementation == "Nsr_File_Signal_Source")
+    LOG(INFO) << "Building " << channel_builders.size() << " channels with " << n_threads << " threads";
+    std::atomic<size_t> next_channel(0);
+    std::vector<std::thread> builders;
+    for (unsigned int t = 0; t < n_threads; t++)
         {
-            try
-                {
-                    std::unique_ptr<GNSSBlockInterface> block_(new NsrFileSignalSource(configuration.get(), role, in_streams,
-                        out_streams, queue));
-                    block = std::move(block_);
-                }
-            catch (const std::exception &e)
-                {
-                    std::cout << "GNSS-SDR program ended." << std::endl;
-                    exit(1);
-                }
+            builders.emplace_back([&]() {
+                for (size_t i = next_channel++; i < channel_builders.size(); i = next_channel++)
+                    {
+                        try
+                            {
+                                channels.at(i) = channel_builders[i]();
+                            }
+                        catch (const std::exception &e)
+                            {
+                                LOG(WARNING) << "Channel " << i << " could not be built: " << e.what();
+                            }
+                    }
+            });
         }
-#if MODERN_GNURADIO
-    else if (implementation == "Two_Bit_Cpx_File_Signal_Source")
+    for (auto &builder : builders)
         {
-            try
-                {
-                    std::unique_ptr<GNSSBlockInterface> block_(new TwoBitCpxFileSignalSource(configuration.get(), role, in_streams,
-                        out_streams, queue));
-                    block = std::move(block_);
-                }
-            catch (const std::exception &e)
-                {
-                    std::cout << "GNSS-SDR program ended." << std::endl;
-                    exit(1);
-                }
-        }
-    else if (implementation == "Two_Bit_Packed_File_Signal_Source")
-        {
-            try
-                {
-                    std::unique_ptr<GNSSBlockInterface> block_(new TwoBitPackedFileSignalSource(configuration.get(), role, in_streams,
-                        out_streams, queue));
-                    block = std::move(block_);
-                }
-            catch (const std::exception &e)
-                {
-                    std::cout << "GNSS-SDR program ended." << std::endl;
-                    exit(1);
-                }
+            builder.join();
         }
-#endif
-    else if (implementation == "Spir_File_Signal_Source")
+}
+
+
+namespace
+{
+template <typename Interface>
+using Block_Maker = std::unique_ptr<Interface> (*)(ConfigurationInterface* configuration, const std::string& role, unsigned int in_streams, unsigned int out_streams, const gr::msg_queue::sptr& queue);
+
+template <typename Interface>
+using Block_Makers = std::unordered_map<std::string, Block_Maker<Interface>>;
+
+
+template <typename Interface, typename Block>
+std::unique_ptr<Interface> make_block(ConfigurationInterface* configuration, const std::string& role, unsigned int in_streams, unsigned int out_streams, const gr::msg_queue::sptr& /* queue */)
+{
+    return std::unique_ptr<Interface>(new Block(configuration, role, in_streams, out_streams));
+}
+
+
+// Signal sources post their messages (e.g., end of file) to the control queue
+template <typename Block>
+std::unique_ptr<GNSSBlockInterface> make_source(ConfigurationInterface* configuration, const std::string& role, unsigned int in_streams, unsigned int out_streams, const gr::msg_queue::sptr& queue)
+{
+    return std::unique_ptr<GNSSBlockInterface>(new Block(configuration, role, in_streams, out_streams, queue));
+}
+
+
+// Sources that end the program if they cannot be opened (e.g., a missing file)
+template <typename Block>
+std::unique_ptr<GNSSBlockInterface> make_checked_source(ConfigurationInterface* configuration, const std::string& role, unsigned int in_streams, unsigned int out_streams, const gr::msg_queue::sptr& queue)
+{
+    try
         {
-            try
-                {
-                    std::unique_ptr<GNSSBlockInterface> block_(new SpirFileSignalSource(configuration.get(), role, in_streams,
-                        out_streams, queue));
-                    block = std::move(block_);
-                }
-            catch (const std::exception &e)
-                {
-                    std::cout << "GNSS-SDR program ended." << std::endl;
-                    exit(1);
-                }
+            return std::unique_ptr<GNSSBlockInterface>(new Block(configuration, role, in_streams, out_streams, queue));
         }
-    else if (implementation == "Spir_GSS6450_File_Signal_Source")
+    catch (const std::exception& e)
         {
-            try
-                {
-                    std::unique_ptr<GNSSBlockInterface> block_(new SpirGSS6450FileSignalSource(configuration.get(), role, in_streams,
-                        out_streams, queue));
-                    block = std::move(block_);
-                }
-            catch (const std::exception &e)
-                {
-                    std::cout << "GNSS-SDR program ended." << std::endl;
-                    exit(1);
-                }
+            std::cout << role << ": " << e.what() << std::endl;
+            std::cout << "GNSS-SDR program ended." << std::endl;
+            exit(1);
         }
-    else if (implementation == "RtlTcp_Signal_Source")
+}
+
+
+template <typename Interface>
+Block_Maker<Interface> find_maker(const Block_Makers<Interface>& makers, const std::string& implementation)
+{
+    auto maker = makers.find(implementation);
+    if (maker == makers.end())
         {
-            try
-                {
-                    std::unique_ptr<GNSSBlockInterface> block_(new RtlTcpSignalSource(configuration.get(), role, in_streams,
-                        out_streams, queue));
-                    block = std::move(block_);
-                }
-            catch (const std::exception &e)
-                {
-                    std::cout << "GNSS-SDR program ended." << std::endl;
-                    exit(1);
-                }
+            return nullptr;
         }
-    else if (implementation == "Labsat_Signal_Source")
-        {
-            try
-                {
-                    std::unique_ptr<GNSSBlockInterface> block_(new LabsatSignalSource(configuration.get(), role, in_streams,
-                        out_streams, queue));
-                    block = std::move(block_);
-                }
+    return maker->second;
+}
 
-            catch (const std::exception &e)
-                {
-                    std::cout << "GNSS-SDR program ended." << std::endl;
-                    exit(1);
-                }
-        }
+
+/*
+ * PLEASE ADD YOUR NEW BLOCK HERE!!
+ *
+ * Implementations of the signal sources, conditioners, observables and PVT.
+ * Acquisition, tracking and telemetry blocks go to the tables below, so that
+ * they can be included in a channel.
+ */
+const Block_Makers<GNSSBlockInterface>& block_makers()
+{
+    static const Block_Makers<GNSSBlockInterface> makers = {
+        // Pass through
+        {"Pass_Through", make_block<GNSSBlockInterface, Pass_Through>},
+        // Signal sources
+        {"File_Signal_Source", make_checked_source<FileSignalSource>},
+        {"Mmap_File_Signal_Source", make_checked_source<MmapFileSignalSource>},
+        {"Multi_File_Signal_Source", make_checked_source<MultiFileSignalSource>},
+        {"Packed_IQ_File_Signal_Source", make_checked_source<PackedIqFileSignalSource>},
+        {"Direct_File_Signal_Source", make_checked_source<DirectFileSignalSource>},
+#if RAW_UDP
+        {"Custom_UDP_Signal_Source", make_checked_source<CustomUDPSignalSource>},
+#endif
+        {"Nsr_File_Signal_Source", make_checked_source<NsrFileSignalSource>},
+#if MODERN_GNURADIO
+        {"Two_Bit_Cpx_File_Signal_Source", make_checked_source<TwoBitCpxFileSignalSource>},
+        {"Two_Bit_Packed_File_Signal_Source", make_checked_source<TwoBitPackedFileSignalSource>},
+#endif
+        {"Spir_File_Signal_Source", make_checked_source<SpirFileSignalSource>},
+        {"Spir_GSS6450_File_Signal_Source", make_checked_source<SpirGSS6450FileSignalSource>},
+        {"RtlTcp_Signal_Source", make_checked_source<RtlTcpSignalSource>},
+        {"Labsat_Signal_Source", make_checked_source<LabsatSignalSource>},
+        {"UDP_Sample_Signal_Source", make_checked_source<UdpSampleSignalSource>},
+        {"Shm_Signal_Source", make_checked_source<ShmSignalSource>},
 #if UHD_DRIVER
-    else if (implementation == "UHD_Signal_Source")
-        {
-            std::unique_ptr<GNSSBlockInterface> block_(new UhdSignalSource(configuration.get(), role, in_streams,
-                out_streams, queue));
-            block = std::move(block_);
-        }
+        {"UHD_Signal_Source", make_source<UhdSignalSource>},
 #endif
 #if GN3S_DRIVER
-    else if (implementation == "GN3S_Signal_Source")
-        {
-            std::unique_ptr<GNSSBlockInterface> block_(new Gn3sSignalSource(configuration.get(), role, in_streams,
-                out_streams, queue));
-            block = std::move(block_);
-        }
+        {"GN3S_Signal_Source", make_source<Gn3sSignalSource>},
 #endif
-
 #if RAW_ARRAY_DRIVER
-    else if (implementation == "Raw_Array_Signal_Source")
-        {
-            std::unique_ptr<GNSSBlockInterface> block_(new RawArraySignalSource(configuration.get(), role, in_streams,
-                out_streams, queue));
-            block = std::move(block_);
-        }
+        {"Raw_Array_Signal_Source", make_source<RawArraySignalSource>},
 #endif
-
 #if OSMOSDR_DRIVER
-    else if (implementation == "Osmosdr_Signal_Source")
-        {
-            std::unique_ptr<GNSSBlockInterface> block_(new OsmosdrSignalSource(configuration.get(), role, in_streams,
-                out_streams, queue));
-            block = std::move(block_);
-        }
+        {"Osmosdr_Signal_Source", make_source<OsmosdrSignalSource>},
 #endif
-
 #if PLUTOSDR_DRIVER
-    else if (implementation == "Plutosdr_Signal_Source")
-        {
-            std::unique_ptr<GNSSBlockInterface> block_(new PlutosdrSignalSource(configuration.get(), role, in_streams,
-                out_streams, queue));
-            block = std::move(block_);
-        }
+        {"Plutosdr_Signal_Source", make_source<PlutosdrSignalSource>},
 #endif
-
 #if FMCOMMS2_DRIVER
-    else if (implementation == "Fmcomms2_Signal_Source")
-        {
-            std::unique_ptr<GNSSBlockInterface> block_(new Fmcomms2SignalSource(configuration.get(), role, in_streams,
-                out_streams, queue));
-            block = std::move(block_);
-        }
+        {"Fmcomms2_Signal_Source", make_source<Fmcomms2SignalSource>},
 #endif
-
 #if AD9361_DRIVER
-    else if (implementation == "Ad9361_Fpga_Signal_Source")
-        {
-            std::unique_ptr<GNSSBlockInterface> block_(new Ad9361FpgaSignalSource(configuration.get(), role, in_streams,
-                out_streams, queue));
-            block = std::move(block_);
-        }
+        {"Ad9361_Fpga_Signal_Source", make_source<Ad9361FpgaSignalSource>},
 #endif
-
 #if FLEXIBAND_DRIVER
-    else if (implementation == "Flexiband_Signal_Source")
-        {
-            std::unique_ptr<GNSSBlockInterface> block_(new FlexibandSignalSource(configuration.get(), role, in_streams,
-                out_streams, queue));
-            block = std::move(block_);
-        }
+        {"Flexiband_Signal_Source", make_source<FlexibandSignalSource>},
 #endif
+        // Data type adapter
+        {"Byte_To_Short", make_block<GNSSBlockInterface, ByteToShort>},
+        {"Ibyte_To_Cbyte", make_block<GNSSBlockInterface, IbyteToCbyte>},
+        {"Ibyte_To_Cshort", make_block<GNSSBlockInterface, IbyteToCshort>},
+        {"Ibyte_To_Complex", make_block<GNSSBlockInterface, IbyteToComplex>},
+        {"Ishort_To_Cshort", make_block<GNSSBlockInterface, IshortToCshort>},
+        {"Ishort_To_Complex", make_block<GNSSBlockInterface, IshortToComplex>},
+        // Input filter
+        {"Fir_Filter", make_block<GNSSBlockInterface, FirFilter>},
+        {"Freq_Xlating_Fir_Filter", make_block<GNSSBlockInterface, FreqXlatingFirFilter>},
+        {"Beamformer_Filter", make_block<GNSSBlockInterface, BeamformerFilter>},
+        {"Pulse_Blanking_Filter", make_block<GNSSBlockInterface, PulseBlankingFilter>},
+        {"Notch_Filter", make_block<GNSSBlockInterface, NotchFilter>},
+        {"Notch_Filter_Lite", make_block<GNSSBlockInterface, NotchFilterLite>},
+        // Resampler
+        {"Direct_Resampler", make_block<GNSSBlockInterface, DirectResamplerConditioner>},
+        {"Fractional_Resampler", make_block<GNSSBlockInterface, MmseResamplerConditioner>},
+        {"Mmse_Resampler", make_block<GNSSBlockInterface, MmseResamplerConditioner>},
+        {"Polyphase_Resampler", make_block<GNSSBlockInterface, PolyphaseResamplerConditioner>},
+        // Observables
+        {"Hybrid_Observables", make_block<GNSSBlockInterface, HybridObservables>},
+        {"GPS_L1_CA_Observables", make_block<GNSSBlockInterface, HybridObservables>},
+        {"GPS_L2C_Observables", make_block<GNSSBlockInterface, HybridObservables>},
+        {"Galileo_E5A_Observables", make_block<GNSSBlockInterface, HybridObservables>},
+        // PVT
+        {"RTKLIB_PVT", make_block<GNSSBlockInterface, RtklibPvt>},
+        {"GPS_L1_CA_PVT", make_block<GNSSBlockInterface, RtklibPvt>},
+        {"Galileo_E1_PVT", make_block<GNSSBlockInterface, RtklibPvt>},
+        {"Hybrid_PVT", make_block<GNSSBlockInterface, RtklibPvt>}
+    };
+    return makers;
+}
 
-    // DATA TYPE ADAPTER -----------------------------------------------------------
-    else if (implementation == "Byte_To_Short")
-        {
-            std::unique_ptr<GNSSBlockInterface> block_(new ByteToShort(configuration.get(), role, in_streams,
-                out_streams));
-            block = std::move(block_);
-        }
-    else if (implementation == "Ibyte_To_Cbyte")
-        {
-            std::unique_ptr<GNSSBlockInterface> block_(new IbyteToCbyte(configuration.get(), role, in_streams,
-                out_streams));
-            block = std::move(block_);
-        }
-    else if (implementation == "Ibyte_To_Cshort")
-        {
-            std::unique_ptr<GNSSBlockInterface> block_(new IbyteToCshort(configuration.get(), role, in_streams,
-                out_streams));
-            block = std::move(block_);
-        }
-    else if (implementation == "Ibyte_To_Complex")
-        {
-            std::unique_ptr<GNSSBlockInterface> block_(new IbyteToComplex(configuration.get(), role, in_streams,
-                out_streams));
-            block = std::move(block_);
-        }
-    else if (implementation == "Ishort_To_Cshort")
-        {
-            std::unique_ptr<GNSSBlockInterface> block_(new IshortToCshort(configuration.get(), role, in_streams,
-                out_streams));
-            block = std::move(block_);
-        }
-    else if (implementation == "Ishort_To_Complex")
-        {
-            std::unique_ptr<GNSSBlockInterface> block_(new IshortToComplex(configuration.get(), role, in_streams,
-                out_streams));
-            block = std::move(block_);
-        }
-
-    // INPUT FILTER ----------------------------------------------------------------
-    else if (implementation == "Fir_Filter")
-        {
-            std::unique_ptr<GNSSBlockInterface> block_(new FirFilter(configuration.get(), role, in_streams,
-                out_streams));
-            block = std::move(block_);
-        }
-    else if (implementation == "Freq_Xlating_Fir_Filter")
-        {
-            std::unique_ptr<GNSSBlockInterface> block_(new FreqXlatingFirFilter(configuration.get(), role, in_streams,
-                out_streams));
-            block = std::move(block_);
-        }
-    else if (implementation == "Beamformer_Filter")
-        {
-            std::unique_ptr<GNSSBlockInterface> block_(new BeamformerFilter(configuration.get(), role, in_streams,
-                out_streams));
-            block = std::move(block_);
-        }
-    else if (implementation == "Pulse_Blanking_Filter")
-        {
-            std::unique_ptr<GNSSBlockInterface> block_(new PulseBlankingFilter(configuration.get(), role, in_streams,
-                out_streams));
-            block = std::move(block_);
-        }
-    else if (implementation == "Notch_Filter")
-        {
-            std::unique_ptr<GNSSBlockInterface> block_(new NotchFilter(configuration.get(), role, in_streams,
-                out_streams));
-            block = std::move(block_);
-        }
-    else if (implementation == "Notch_Filter_Lite")
-        {
-            std::unique_ptr<GNSSBlockInterface> block_(new NotchFilterLite(configuration.get(), role, in_streams,
-                out_streams));
-            block = std::move(block_);
-        }
-
-    // RESAMPLER -------------------------------------------------------------------
-    else if (implementation == "Direct_Resampler")
-        {
-            std::unique_ptr<GNSSBlockInterface> block_(new DirectResamplerConditioner(configuration.get(), role,
-                in_streams, out_streams));
-            block = std::move(block_);
-        }
-
-    else if ((implementation == "Fractional_Resampler") || (implementation == "Mmse_Resampler"))
-        {
-            std::unique_ptr<GNSSBlockInterface> block_(new MmseResamplerConditioner(configuration.get(), role,
-                in_streams, out_streams));
-            block = std::move(block_);
-        }
-
-    // ACQUISITION BLOCKS ---------------------------------------------------------
-    else if (implementation == "GPS_L1_CA_PCPS_Acquisition")
-        {
-            std::unique_ptr<GNSSBlockInterface> block_(new GpsL1CaPcpsAcquisition(configuration.get(), role, in_streams,
-                out_streams));
-            block = std::move(block_);
-        }
 
+// Acquisition blocks, for GetAcqBlock() and GetBlock()
+const Block_Makers<AcquisitionInterface>& acquisition_makers()
+{
+    static const Block_Makers<AcquisitionInterface> makers = {
+        {"GPS_L1_CA_PCPS_Acquisition", make_block<AcquisitionInterface, GpsL1CaPcpsAcquisition>},
 #if ENABLE_FPGA
-    else if (implementation == "GPS_L1_CA_PCPS_Acquisition_Fpga")
-        {
-            std::unique_ptr<GNSSBlockInterface> block_(new GpsL1CaPcpsAcquisitionFpga(configuration.get(), role, in_streams,
-                out_streams));
-            block = std::move(block_);
-        }
+        {"GPS_L1_CA_PCPS_Acquisition_Fpga", make_block<AcquisitionInterface, GpsL1CaPcpsAcquisitionFpga>},
 #endif
-    else if (implementation == "GPS_L1_CA_PCPS_Assisted_Acquisition")
-        {
-            std::unique_ptr<GNSSBlockInterface> block_(new GpsL1CaPcpsAssistedAcquisition(configuration.get(), role, in_streams,
-                out_streams));
-            block = std::move(block_);
-        }
-    else if (implementation == "GPS_L1_CA_PCPS_Tong_Acquisition")
-        {
-            std::unique_ptr<GNSSBlockInterface> block_(new GpsL1CaPcpsTongAcquisition(configuration.get(), role, in_streams,
-                out_streams));
-            block = std::move(block_);
-        }
-
+        {"GPS_L1_CA_PCPS_Assisted_Acquisition", make_block<AcquisitionInterface, GpsL1CaPcpsAssistedAcquisition>},
+        {"GPS_L1_CA_PCPS_Tong_Acquisition", make_block<AcquisitionInterface, GpsL1CaPcpsTongAcquisition>},
 #if OPENCL_BLOCKS
-    else if (implementation == "GPS_L1_CA_PCPS_OpenCl_Acquisition")
-        {
-            std::unique_ptr<GNSSBlockInterface> block_(new GpsL1CaPcpsOpenClAcquisition(configuration.get(), role, in_streams,
-                out_streams));
-            block = std::move(block_);
-        }
+        {"GPS_L1_CA_PCPS_OpenCl_Acquisition", make_block<AcquisitionInterface, GpsL1CaPcpsOpenClAcquisition>},
 #endif
-
-    else if (implementation == "GPS_L1_CA_PCPS_Acquisition_Fine_Doppler")
-        {
-            std::unique_ptr<GNSSBlockInterface> block_(new GpsL1CaPcpsAcquisitionFineDoppler(configuration.get(), role, in_streams,
-                out_streams));
-            block = std::move(block_);
-        }
-    else if (implementation == "GPS_L1_CA_PCPS_QuickSync_Acquisition")
-        {
-            std::unique_ptr<GNSSBlockInterface> block_(new GpsL1CaPcpsQuickSyncAcquisition(configuration.get(), role, in_streams,
-                out_streams));
-            block = std::move(block_);
-        }
-    else if (implementation == "GPS_L2_M_PCPS_Acquisition")
-        {
-            std::unique_ptr<AcquisitionInterface> block_(new GpsL2MPcpsAcquisition(configuration.get(), role, in_streams,
-                out_streams));
-            block = std::move(block_);
-        }
+        {"GPS_L1_CA_PCPS_Acquisition_Fine_Doppler", make_block<AcquisitionInterface, GpsL1CaPcpsAcquisitionFineDoppler>},
+        {"GPS_L1_CA_PCPS_QuickSync_Acquisition", make_block<AcquisitionInterface, GpsL1CaPcpsQuickSyncAcquisition>},
+        {"GPS_L2_M_PCPS_Acquisition", make_block<AcquisitionInterface, GpsL2MPcpsAcquisition>},
 #if ENABLE_FPGA
-    else if (implementation == "GPS_L2_M_PCPS_Acquisition_Fpga")
-        {
-            std::unique_ptr<GNSSBlockInterface> block_(new GpsL2MPcpsAcquisitionFpga(configuration.get(), role, in_streams,
-                out_streams));
-            block = std::move(block_);
-        }
+        {"GPS_L2_M_PCPS_Acquisition_Fpga", make_block<AcquisitionInterface, GpsL2MPcpsAcquisitionFpga>},
 #endif
-    else if (implementation == "GPS_L5i_PCPS_Acquisition")
-        {
-            std::unique_ptr<AcquisitionInterface> block_(new GpsL5iPcpsAcquisition(configuration.get(), role, in_streams,
-                out_streams));
-            block = std::move(block_);
-        }
+        {"GPS_L5i_PCPS_Acquisition", make_block<AcquisitionInterface, GpsL5iPcpsAcquisition>},
 #if ENABLE_FPGA
-    else if (implementation == "GPS_L5i_PCPS_Acquisition_Fpga")
-        {
-            std::unique_ptr<AcquisitionInterface> block_(new GpsL5iPcpsAcquisitionFpga(configuration.get(), role, in_streams,
-                out_streams));
-            block = std::move(block_);
-        }
+        {"GPS_L5i_PCPS_Acquisition_Fpga", make_block<AcquisitionInterface, GpsL5iPcpsAcquisitionFpga>},
 #endif
-    else if (implementation == "Galileo_E1_PCPS_Ambiguous_Acquisition")
-        {
-            std::unique_ptr<GNSSBlockInterface> block_(new GalileoE1PcpsAmbiguousAcquisition(configuration.get(), role, in_streams,
-                out_streams));
-            block = std::move(block_);
-        }
+        {"Galileo_E1_PCPS_Ambiguous_Acquisition", make_block<AcquisitionInterface, GalileoE1PcpsAmbiguousAcquisition>},
 #if ENABLE_FPGA
-    else if (implementation == "Galileo_E1_PCPS_Ambiguous_Acquisition_Fpga")
-        {
-            std::unique_ptr<GNSSBlockInterface> block_(new GalileoE1PcpsAmbiguousAcquisitionFpga(configuration.get(), role, in_streams,
-                out_streams));
-            block = std::move(block_);
-        }
+        {"Galileo_E1_PCPS_Ambiguous_Acquisition_Fpga", make_block<AcquisitionInterface, GalileoE1PcpsAmbiguousAcquisitionFpga>},
 #endif
-    else if (implementation == "Galileo_E1_PCPS_8ms_Ambiguous_Acquisition")
-        {
-            std::unique_ptr<GNSSBlockInterface> block_(new GalileoE1Pcps8msAmbiguousAcquisition(configuration.get(), role, in_streams,
-                out_streams));
-            block = std::move(block_);
-        }
-    else if (implementation == "Galileo_E1_PCPS_Tong_Ambiguous_Acquisition")
-        {
-            std::unique_ptr<GNSSBlockInterface> block_(new GalileoE1PcpsTongAmbiguousAcquisition(configuration.get(), role, in_streams,
-                out_streams));
-            block = std::move(block_);
-        }
-    else if (implementation == "Galileo_E1_PCPS_CCCWSR_Ambiguous_Acquisition")
-        {
-            std::unique_ptr<GNSSBlockInterface> block_(new GalileoE1PcpsCccwsrAmbiguousAcquisition(configuration.get(), role, in_streams,
-                out_streams));
-            block = std::move(block_);
-        }
-    else if (implementation == "Galileo_E5a_Noncoherent_IQ_Acquisition_CAF")
-        {
-            std::unique_ptr<GNSSBlockInterface> block_(new GalileoE5aNoncoherentIQAcquisitionCaf(configuration.get(), role, in_streams,
-                out_streams));
-            block = std::move(block_);
-        }
-    else if (implementation == "Galileo_E5a_Pcps_Acquisition")
-        {
-            std::unique_ptr<GNSSBlockInterface> block_(new GalileoE5aPcpsAcquisition(configuration.get(), role, in_streams,
-                out_streams));
-            block = std::move(block_);
-        }
+        {"Galileo_E1_PCPS_8ms_Ambiguous_Acquisition", make_block<AcquisitionInterface, GalileoE1Pcps8msAmbiguousAcquisition>},
+        {"Galileo_E1_PCPS_Tong_Ambiguous_Acquisition", make_block<AcquisitionInterface, GalileoE1PcpsTongAmbiguousAcquisition>},
+        {"Galileo_E1_PCPS_CCCWSR_Ambiguous_Acquisition", make_block<AcquisitionInterface, GalileoE1PcpsCccwsrAmbiguousAcquisition>},
+        {"Galileo_E1_PCPS_QuickSync_Ambiguous_Acquisition", make_block<AcquisitionInterface, GalileoE1PcpsQuickSyncAmbiguousAcquisition>},
+        {"Galileo_E5a_Noncoherent_IQ_Acquisition_CAF", make_block<AcquisitionInterface, GalileoE5aNoncoherentIQAcquisitionCaf>},
+        {"Galileo_E5a_Pcps_Acquisition", make_block<AcquisitionInterface, GalileoE5aPcpsAcquisition>},
 #if ENABLE_FPGA
-    else if (implementation == "Galileo_E5a_Pcps_Acquisition_Fpga")
-        {
-            std::unique_ptr<GNSSBlockInterface> block_(new GalileoE5aPcpsAcquisitionFpga(configuration.get(), role, in_streams,
-                out_streams));
-            block = std::move(block_);
-        }
+        {"Galileo_E5a_Pcps_Acquisition_Fpga", make_block<AcquisitionInterface, GalileoE5aPcpsAcquisitionFpga>},
 #endif
-    else if (implementation == "Galileo_E1_PCPS_QuickSync_Ambiguous_Acquisition")
-        {
-            std::unique_ptr<GNSSBlockInterface> block_(new GalileoE1PcpsQuickSyncAmbiguousAcquisition(configuration.get(), role, in_streams,
-                out_streams));
-            block = std::move(block_);
-        }
-    else if (implementation == "GLONASS_L1_CA_PCPS_Acquisition")
-        {
-            std::unique_ptr<AcquisitionInterface> block_(new GlonassL1CaPcpsAcquisition(configuration.get(), role, in_streams,
-                out_streams));
-            block = std::move(block_);
-        }
-    else if (implementation == "GLONASS_L2_CA_PCPS_Acquisition")
-        {
-            std::unique_ptr<AcquisitionInterface> block_(new GlonassL2CaPcpsAcquisition(configuration.get(), role, in_streams,
-                out_streams));
-            block = std::move(block_);
-        }
-    // TRACKING BLOCKS -------------------------------------------------------------
-    else if (implementation == "GPS_L1_CA_DLL_PLL_Tracking")
-        {
-            std::unique_ptr<GNSSBlockInterface> block_(new GpsL1CaDllPllTracking(configuration.get(), role, in_streams,
-                out_streams));
-            block = std::move(block_);
-        }
-    else if (implementation == "GPS_L1_CA_KF_Tracking")
-        {
-            std::unique_ptr<GNSSBlockInterface> block_(new GpsL1CaKfTracking(configuration.get(), role, in_streams,
-                out_streams));
-            block = std::move(block_);
-        }
-    else if (implementation == "GPS_L1_CA_DLL_PLL_C_Aid_Tracking")
-        {
-            std::unique_ptr<TrackingInterface> block_(new GpsL1CaDllPllCAidTracking(configuration.get(), role, in_streams,
-                out_streams));
-            block = std::move(block_);
-        }
+        {"GLONASS_L1_CA_PCPS_Acquisition", make_block<AcquisitionInterface, GlonassL1CaPcpsAcquisition>},
+        {"GLONASS_L2_CA_PCPS_Acquisition", make_block<AcquisitionInterface, GlonassL2CaPcpsAcquisition>}
+    };
+    return makers;
+}
+
+
+// Tracking blocks, for GetTrkBlock() and GetBlock()
+const Block_Makers<TrackingInterface>& tracking_makers()
+{
+    static const Block_Makers<TrackingInterface> makers = {
+        {"GPS_L1_CA_DLL_PLL_Tracking", make_block<TrackingInterface, GpsL1CaDllPllTracking>},
+        {"GPS_L1_CA_KF_Tracking", make_block<TrackingInterface, GpsL1CaKfTracking>},
+        {"GPS_L1_CA_DLL_PLL_C_Aid_Tracking", make_block<TrackingInterface, GpsL1CaDllPllCAidTracking>},
 #if ENABLE_FPGA
-    else if (implementation == "GPS_L1_CA_DLL_PLL_Tracking_Fpga")
-        {
-            std::unique_ptr<TrackingInterface> block_(new GpsL1CaDllPllTrackingFpga(configuration.get(), role, in_streams,
-                out_streams));
-            block = std::move(block_);
-        }
+        {"GPS_L1_CA_DLL_PLL_Tracking_Fpga", make_block<TrackingInterface, GpsL1CaDllPllTrackingFpga>},
 #endif
-    else if (implementation == "GPS_L1_CA_TCP_CONNECTOR_Tracking")
-        {
-            std::unique_ptr<GNSSBlockInterface> block_(new GpsL1CaTcpConnectorTracking(configuration.get(), role, in_streams,
-                out_streams));
-            block = std::move(block_);
-        }
-    else if (implementation == "GPS_L2_M_DLL_PLL_Tracking")
-        {
-            std::unique_ptr<GNSSBlockInterface> block_(new GpsL2MDllPllTracking(configuration.get(), role, in_streams,
-                out_streams));
-            block = std::move(block_);
-        }
+        {"GPS_L1_CA_TCP_CONNECTOR_Tracking", make_block<TrackingInterface, GpsL1CaTcpConnectorTracking>},
+        {"Galileo_E1_DLL_PLL_VEML_Tracking", make_block<TrackingInterface, GalileoE1DllPllVemlTracking>},
 #if ENABLE_FPGA
-    else if (implementation == "GPS_L2_M_DLL_PLL_Tracking_Fpga")
-        {
-            std::unique_ptr<GNSSBlockInterface> block_(new GpsL2MDllPllTrackingFpga(configuration.get(), role, in_streams,
-                out_streams));
-            block = std::move(block_);
-        }
+        {"Galileo_E1_DLL_PLL_VEML_Tracking_Fpga", make_block<TrackingInterface, GalileoE1DllPllVemlTrackingFpga>},
 #endif
-    else if ((implementation == "GPS_L5i_DLL_PLL_Tracking") or (implementation == "GPS_L5_DLL_PLL_Tracking"))
-        {
-            std::unique_ptr<GNSSBlockInterface> block_(new GpsL5DllPllTracking(configuration.get(), role, in_streams,
-                out_streams));
-            block = std::move(block_);
-        }
+        {"Galileo_E1_TCP_CONNECTOR_Tracking", make_block<TrackingInterface, GalileoE1TcpConnectorTracking>},
+        {"Galileo_E5a_DLL_PLL_Tracking", make_block<TrackingInterface, GalileoE5aDllPllTracking>},
 #if ENABLE_FPGA
-    else if ((implementation == "GPS_L5i_DLL_PLL_Tracking_Fpga") or (implementation == "GPS_L5_DLL_PLL_Tracking_Fpga"))
-        {
-            std::unique_ptr<GNSSBlockInterface> block_(new GpsL5DllPllTrackingFpga(configuration.get(), role, in_streams,
-                out_streams));
-            block = std::move(block_);
-        }
-#endif
-#if CUDA_GPU_ACCEL
-    else if (implementation == "GPS_L1_CA_DLL_PLL_Tracking_GPU")
-        {
-            std::unique_ptr<GNSSBlockInterface> block_(new GpsL1CaDllPllTrackingGPU(configuration.get(), role, in_streams,
-                out_streams));
-            block = std::move(block_);
-        }
+        {"Galileo_E5a_DLL_PLL_Tracking_Fpga", make_block<TrackingInterface, GalileoE5aDllPllTrackingFpga>},
 #endif
-    else if (implementation == "Galileo_E1_DLL_PLL_VEML_Tracking")
-        {
-            std::unique_ptr<GNSSBlockInterface> block_(new GalileoE1DllPllVemlTracking(configuration.get(), role, in_streams,
-                out_streams));
-            block = std::move(block_);
-        }
+        {"GPS_L2_M_DLL_PLL_Tracking", make_block<TrackingInterface, GpsL2MDllPllTracking>},
 #if ENABLE_FPGA
-    else if (implementation == "Galileo_E1_DLL_PLL_VEML_Tracking_Fpga")
-        {
-            std::unique_ptr<TrackingInterface> block_(new GalileoE1DllPllVemlTrackingFpga(configuration.get(), role, in_streams,
-                out_streams));
-            block = std::move(block_);
-        }
+        {"GPS_L2_M_DLL_PLL_Tracking_Fpga", make_block<TrackingInterface, GpsL2MDllPllTrackingFpga>},
 #endif
-    else if (implementation == "Galileo_E1_TCP_CONNECTOR_Tracking")
-        {
-            std::unique_ptr<GNSSBlockInterface> block_(new GalileoE1TcpConnectorTracking(configuration.get(), role, in_streams,
-                out_streams));
-            block = std::move(block_);
-        }
-    else if (implementation == "Galileo_E5a_DLL_PLL_Tracking")
-        {
-            std::unique_ptr<GNSSBlockInterface> block_(new GalileoE5aDllPllTracking(configuration.get(), role, in_streams,
-                out_streams));
-            block = std::move(block_);
-        }
+        {"GPS_L5i_DLL_PLL_Tracking", make_block<TrackingInterface, GpsL5DllPllTracking>},
+        {"GPS_L5_DLL_PLL_Tracking", make_block<TrackingInterface, GpsL5DllPllTracking>},
 #if ENABLE_FPGA
-    else if (implementation == "Galileo_E5a_DLL_PLL_Tracking_Fpga")
-        {
-            std::unique_ptr<GNSSBlockInterface> block_(new GalileoE5aDllPllTrackingFpga(configuration.get(), role, in_streams,
-                out_streams));
-            block = std::move(block_);
-        }
+        {"GPS_L5i_DLL_PLL_Tracking_Fpga", make_block<TrackingInterface, GpsL5DllPllTrackingFpga>},
+        {"GPS_L5_DLL_PLL_Tracking_Fpga", make_block<TrackingInterface, GpsL5DllPllTrackingFpga>},
 #endif
-    else if (implementation == "GLONASS_L1_CA_DLL_PLL_Tracking")
-        {
-            std::unique_ptr<GNSSBlockInterface> block_(new GlonassL1CaDllPllTracking(configuration.get(), role, in_streams,
-                out_streams));
-            block = std::move(block_);
-        }
-    else if (implementation == "GLONASS_L1_CA_DLL_PLL_C_Aid_Tracking")
-        {
-            std::unique_ptr<GNSSBlockInterface> block_(new GlonassL1CaDllPllCAidTracking(configuration.get(), role, in_streams,
-                out_streams));
-            block = std::move(block_);
-        }
-    else if (implementation == "GLONASS_L2_CA_DLL_PLL_Tracking")
-        {
-            std::unique_ptr<GNSSBlockInterface> block_(new GlonassL2CaDllPllTracking(configuration.get(), role, in_streams,
-                out_streams));
-            block = std::move(block_);
-        }
-    else if (implementation == "GLONASS_L2_CA_DLL_PLL_C_Aid_Tracking")
-        {
-            std::unique_ptr<GNSSBlockInterface> block_(new GlonassL2CaDllPllCAidTracking(configuration.get(), role, in_streams,
-                out_streams));
-            block = std::move(block_);
-        }
-    // TELEMETRY DECODERS ----------------------------------------------------------
-    else if (implementation == "GPS_L1_CA_Telemetry_Decoder")
-        {
-            std::unique_ptr<GNSSBlockInterface> block_(new GpsL1CaTelemetryDecoder(configuration.get(), role, in_streams,
-                out_streams));
-            block = std::move(block_);
-        }
-    else if (implementation == "GPS_L2C_Telemetry_Decoder")
-        {
-            std::unique_ptr<GNSSBlockInterface> block_(new GpsL2CTelemetryDecoder(configuration.get(), role, in_streams,
-                out_streams));
-            block = std::move(block_);
-        }
-    else if (implementation == "GPS_L5_Telemetry_Decoder")
-        {
-            std::unique_ptr<GNSSBlockInterface> block_(new GpsL5TelemetryDecoder(configuration.get(), role, in_streams,
-                out_streams));
-            block = std::move(block_);
-        }
-    else if (implementation == "Galileo_E1B_Telemetry_Decoder")
-        {
-            std::unique_ptr<GNSSBlockInterface> block_(new GalileoE1BTelemetryDecoder(configuration.get(), role, in_streams,
-                out_streams));
-            block = std::move(block_);
-        }
-    else if (implementation == "SBAS_L1_Telemetry_Decoder")
-        {
-            std::unique_ptr<GNSSBlockInterface> block_(new SbasL1TelemetryDecoder(configuration.get(), role, in_streams,
-                out_streams));
-            block = std::move(block_);
-        }
-    else if (implementation == "Galileo_E5a_Telemetry_Decoder")
-        {
-            std::unique_ptr<GNSSBlockInterface> block_(new GalileoE5aTelemetryDecoder(configuration.get(), role, in_streams,
-                out_streams));
-            block = std::move(block_);
-        }
-    else if (implementation == "GLONASS_L1_CA_Telemetry_Decoder")
+#if CUDA_GPU_ACCEL
+        {"GPS_L1_CA_DLL_PLL_Tracking_GPU", make_block<TrackingInterface, GpsL1CaDllPllTrackingGPU>},
+#endif
+        {"GLONASS_L1_CA_DLL_PLL_Tracking", make_block<TrackingInterface, GlonassL1CaDllPllTracking>},
+        {"GLONASS_L1_CA_DLL_PLL_C_Aid_Tracking", make_block<TrackingInterface, GlonassL1CaDllPllCAidTracking>},
+        {"GLONASS_L2_CA_DLL_PLL_Tracking", make_block<TrackingInterface, GlonassL2CaDllPllTracking>},
+        {"GLONASS_L2_CA_DLL_PLL_C_Aid_Tracking", make_block<TrackingInterface, GlonassL2CaDllPllCAidTracking>}
+    };
+    return makers;
+}
+
+
+// Telemetry decoders, for GetTlmBlock() and GetBlock()
+const Block_Makers<TelemetryDecoderInterface>& telemetry_makers()
+{
+    static const Block_Makers<TelemetryDecoderInterface> makers = {
+        {"GPS_L1_CA_Telemetry_Decoder", make_block<TelemetryDecoderInterface, GpsL1CaTelemetryDecoder>},
+        {"Galileo_E1B_Telemetry_Decoder", make_block<TelemetryDecoderInterface, GalileoE1BTelemetryDecoder>},
+        {"SBAS_L1_Telemetry_Decoder", make_block<TelemetryDecoderInterface, SbasL1TelemetryDecoder>},
+        {"Galileo_E5a_Telemetry_Decoder", make_block<TelemetryDecoderInterface, GalileoE5aTelemetryDecoder>},
+        {"GPS_L2C_Telemetry_Decoder", make_block<TelemetryDecoderInterface, GpsL2CTelemetryDecoder>},
+        {"GLONASS_L1_CA_Telemetry_Decoder", make_block<TelemetryDecoderInterface, GlonassL1CaTelemetryDecoder>},
+        {"GLONASS_L2_CA_Telemetry_Decoder", make_block<TelemetryDecoderInterface, GlonassL2CaTelemetryDecoder>},
+        {"GPS_L5_Telemetry_Decoder", make_block<TelemetryDecoderInterface, GpsL5TelemetryDecoder>}
+    };
+    return makers;
+}
+}  // namespace
+
+
+/*
+ * Returns the block with the required configuration and implementation.
+ * Acquisition, tracking and telemetry blocks can also be built on their own,
+ * for testing purposes.
+ */
+std::unique_ptr<GNSSBlockInterface> GNSSBlockFactory::GetBlock(
+    std::shared_ptr<ConfigurationInterface> configuration,
+    std::string role,
+    std::string implementation, unsigned int in_streams,
+    unsigned int out_streams, gr::msg_queue::sptr queue)
+{
+    std::unique_ptr<GNSSBlockInterface> block;
+    Block_Maker<GNSSBlockInterface> maker = find_maker(block_makers(), implementation);
+    Block_Maker<AcquisitionInterface> acq_maker = find_maker(acquisition_makers(), implementation);
+    Block_Maker<TrackingInterface> trk_maker = find_maker(tracking_makers(), implementation);
+    Block_Maker<TelemetryDecoderInterface> tlm_maker = find_maker(telemetry_makers(), implementation);
+    if (maker != nullptr)
         {
-            std::unique_ptr<GNSSBlockInterface> block_(new GlonassL1CaTelemetryDecoder(configuration.get(), role, in_streams,
-                out_streams));
-            block = std::move(block_);
+            block = maker(configuration.get(), role, in_streams, out_streams, queue);
         }
-    else if (implementation == "GLONASS_L2_CA_Telemetry_Decoder")
+    else if (acq_maker != nullptr)
         {
-            std::unique_ptr<GNSSBlockInterface> block_(new GlonassL2CaTelemetryDecoder(configuration.get(), role, in_streams,
-                out_streams));
-            block = std::move(block_);
+            block = acq_maker(configuration.get(), role, in_streams, out_streams, queue);
         }
-    // OBSERVABLES -----------------------------------------------------------------
-    else if ((implementation == "Hybrid_Observables") || (implementation == "GPS_L1_CA_Observables") || (implementation == "GPS_L2C_Observables") ||
-             (implementation == "Galileo_E5A_Observables"))
+    else if (trk_maker != nullptr)
         {
-            std::unique_ptr<GNSSBlockInterface> block_(new HybridObservables(configuration.get(), role, in_streams,
-                out_streams));
-            block = std::move(block_);
+            block = trk_maker(configuration.get(), role, in_streams, out_streams, queue);
         }
-
-    // PVT -------------------------------------------------------------------------
-    else if ((implementation == "RTKLIB_PVT") || (implementation == "GPS_L1_CA_PVT") || (implementation == "Galileo_E1_PVT") || (implementation == "Hybrid_PVT"))
+    else if (tlm_maker != nullptr)
         {
-            std::unique_ptr<GNSSBlockInterface> block_(new RtklibPvt(configuration.get(), role, in_streams,
-                out_streams));
-            block = std::move(block_);
+            block = tlm_maker(configuration.get(), role, in_streams, out_streams, queue);
         }
     else
         {
@@ -1688,14 +1409,6 @@ std::unique_ptr<GNSSBlockInterface> GNSSBlockFactory::GetBlock(
 }
 
 
-/*
- *
- * PLEASE ADD YOUR NEW BLOCK HERE!!
- *
- * Not very elegant, Acq, Trk and Tlm blocks must be added here, too.
- * To be improved!
- */
-
 std::unique_ptr<AcquisitionInterface> GNSSBlockFactory::GetAcqBlock(
     std::shared_ptr<ConfigurationInterface> configuration,
     std::string role,
@@ -1703,153 +1416,10 @@ std::unique_ptr<AcquisitionInterface> GNSSBlockFactory::GetAcqBlock(
     unsigned int out_streams)
 {
     std::unique_ptr<AcquisitionInterface> block;
-    // ACQUISITION BLOCKS ---------------------------------------------------------
-    if (implementation == "GPS_L1_CA_PCPS_Acquisition")
-        {
-            std::unique_ptr<AcquisitionInterface> block_(new GpsL1CaPcpsAcquisition(configuration.get(), role, in_streams,
-                out_streams));
-            block = std::move(block_);
-        }
-#if ENABLE_FPGA
-    else if (implementation == "GPS_L1_CA_PCPS_Acquisition_Fpga")
-        {
-            std::unique_ptr<AcquisitionInterface> block_(new GpsL1CaPcpsAcquisitionFpga(configuration.get(), role, in_streams,
-                out_streams));
-            block = std::move(block_);
-        }
-#endif
-    else if (implementation == "GPS_L1_CA_PCPS_Assisted_Acquisition")
-        {
-            std::unique_ptr<AcquisitionInterface> block_(new GpsL1CaPcpsAssistedAcquisition(configuration.get(), role, in_streams,
-                out_streams));
-            block = std::move(block_);
-        }
-    else if (implementation == "GPS_L1_CA_PCPS_Tong_Acquisition")
-        {
-            std::unique_ptr<AcquisitionInterface> block_(new GpsL1CaPcpsTongAcquisition(configuration.get(), role, in_streams,
-                out_streams));
-            block = std::move(block_);
-        }
-
-#if OPENCL_BLOCKS
-    else if (implementation == "GPS_L1_CA_PCPS_OpenCl_Acquisition")
-        {
-            std::unique_ptr<AcquisitionInterface> block_(new GpsL1CaPcpsOpenClAcquisition(configuration.get(), role, in_streams,
-                out_streams));
-            block = std::move(block_);
-        }
-#endif
-
-    else if (implementation == "GPS_L1_CA_PCPS_Acquisition_Fine_Doppler")
-        {
-            std::unique_ptr<AcquisitionInterface> block_(new GpsL1CaPcpsAcquisitionFineDoppler(configuration.get(), role, in_streams,
-                out_streams));
-            block = std::move(block_);
-        }
-    else if (implementation == "GPS_L1_CA_PCPS_QuickSync_Acquisition")
-        {
-            std::unique_ptr<AcquisitionInterface> block_(new GpsL1CaPcpsQuickSyncAcquisition(configuration.get(), role, in_streams,
-                out_streams));
-            block = std::move(block_);
-        }
-    else if (implementation == "GPS_L2_M_PCPS_Acquisition")
-        {
-            std::unique_ptr<AcquisitionInterface> block_(new GpsL2MPcpsAcquisition(configuration.get(), role, in_streams,
-                out_streams));
-            block = std::move(block_);
-        }
-#if ENABLE_FPGA
-    else if (implementation == "GPS_L2_M_PCPS_Acquisition_Fpga")
-        {
-            std::unique_ptr<AcquisitionInterface> block_(new GpsL2MPcpsAcquisitionFpga(configuration.get(), role, in_streams,
-                out_streams));
-            block = std::move(block_);
-        }
-#endif
-    else if (implementation == "GPS_L5i_PCPS_Acquisition")
-        {
-            std::unique_ptr<AcquisitionInterface> block_(new GpsL5iPcpsAcquisition(configuration.get(), role, in_streams,
-                out_streams));
-            block = std::move(block_);
-        }
-#if ENABLE_FPGA
-    else if (implementation == "GPS_L5i_PCPS_Acquisition_Fpga")
-        {
-            std::unique_ptr<AcquisitionInterface> block_(new GpsL5iPcpsAcquisitionFpga(configuration.get(), role, in_streams,
-                out_streams));
-            block = std::move(block_);
-        }
-#endif
-    else if (implementation == "Galileo_E1_PCPS_Ambiguous_Acquisition")
-        {
-            std::unique_ptr<AcquisitionInterface> block_(new GalileoE1PcpsAmbiguousAcquisition(configuration.get(), role, in_streams,
-                out_streams));
-            block = std::move(block_);
-        }
-#if ENABLE_FPGA
-    else if (implementation == "Galileo_E1_PCPS_Ambiguous_Acquisition_Fpga")
-        {
-            std::unique_ptr<AcquisitionInterface> block_(new GalileoE1PcpsAmbiguousAcquisitionFpga(configuration.get(), role, in_streams,
-                out_streams));
-            block = std::move(block_);
-        }
-#endif
-    else if (implementation == "Galileo_E1_PCPS_8ms_Ambiguous_Acquisition")
-        {
-            std::unique_ptr<AcquisitionInterface> block_(new GalileoE1Pcps8msAmbiguousAcquisition(configuration.get(), role, in_streams,
-                out_streams));
-            block = std::move(block_);
-        }
-    else if (implementation == "Galileo_E1_PCPS_Tong_Ambiguous_Acquisition")
-        {
-            std::unique_ptr<AcquisitionInterface> block_(new GalileoE1PcpsTongAmbiguousAcquisition(configuration.get(), role, in_streams,
-                out_streams));
-            block = std::move(block_);
-        }
-    else if (implementation == "Galileo_E1_PCPS_CCCWSR_Ambiguous_Acquisition")
-        {
-            std::unique_ptr<AcquisitionInterface> block_(new GalileoE1PcpsCccwsrAmbiguousAcquisition(configuration.get(), role, in_streams,
-                out_streams));
-            block = std::move(block_);
-        }
-
-    else if (implementation == "Galileo_E1_PCPS_QuickSync_Ambiguous_Acquisition")
-        {
-            std::unique_ptr<AcquisitionInterface> block_(new GalileoE1PcpsQuickSyncAmbiguousAcquisition(configuration.get(), role, in_streams,
-                out_streams));
-            block = std::move(block_);
-        }
-    else if (implementation == "Galileo_E5a_Noncoherent_IQ_Acquisition_CAF")
-        {
-            std::unique_ptr<AcquisitionInterface> block_(new GalileoE5aNoncoherentIQAcquisitionCaf(configuration.get(), role, in_streams,
-                out_streams));
-            block = std::move(block_);
-        }
-    else if (implementation == "Galileo_E5a_Pcps_Acquisition")
+    Block_Maker<AcquisitionInterface> maker = find_maker(acquisition_makers(), implementation);
+    if (maker != nullptr)
         {
-            std::unique_ptr<AcquisitionInterface> block_(new GalileoE5aPcpsAcquisition(configuration.get(), role, in_streams,
-                out_streams));
-            block = std::move(block_);
-        }
-#if ENABLE_FPGA
-    else if (implementation == "Galileo_E5a_Pcps_Acquisition_Fpga")
-        {
-            std::unique_ptr<AcquisitionInterface> block_(new GalileoE5aPcpsAcquisitionFpga(configuration.get(), role, in_streams,
-                out_streams));
-            block = std::move(block_);
-        }
-#endif
-    else if (implementation == "GLONASS_L1_CA_PCPS_Acquisition")
-        {
-            std::unique_ptr<AcquisitionInterface> block_(new GlonassL1CaPcpsAcquisition(configuration.get(), role, in_streams,
-                out_streams));
-            block = std::move(block_);
-        }
-    else if (implementation == "GLONASS_L2_CA_PCPS_Acquisition")
-        {
-            std::unique_ptr<AcquisitionInterface> block_(new GlonassL2CaPcpsAcquisition(configuration.get(), role, in_streams,
-                out_streams));
-            block = std::move(block_);
+            block = maker(configuration.get(), role, in_streams, out_streams, nullptr);
         }
     else
         {
@@ -1867,133 +1437,10 @@ std::unique_ptr<TrackingInterface> GNSSBlockFactory::GetTrkBlock(
     unsigned int out_streams)
 {
     std::unique_ptr<TrackingInterface> block;
-
-    // TRACKING BLOCKS -------------------------------------------------------------
-    if (implementation == "GPS_L1_CA_DLL_PLL_Tracking")
-        {
-            std::unique_ptr<TrackingInterface> block_(new GpsL1CaDllPllTracking(configuration.get(), role, in_streams,
-                out_streams));
-            block = std::move(block_);
-        }
-    else if (implementation == "GPS_L1_CA_KF_Tracking")
-        {
-            std::unique_ptr<TrackingInterface> block_(new GpsL1CaKfTracking(configuration.get(), role, in_streams,
-                out_streams));
-            block = std::move(block_);
-        }
-    else if (implementation == "GPS_L1_CA_DLL_PLL_C_Aid_Tracking")
-        {
-            std::unique_ptr<TrackingInterface> block_(new GpsL1CaDllPllCAidTracking(configuration.get(), role, in_streams,
-                out_streams));
-            block = std::move(block_);
-        }
-#if ENABLE_FPGA
-    else if (implementation == "GPS_L1_CA_DLL_PLL_Tracking_Fpga")
-        {
-            std::unique_ptr<TrackingInterface> block_(new GpsL1CaDllPllTrackingFpga(configuration.get(), role, in_streams,
-                out_streams));
-            block = std::move(block_);
-        }
-#endif
-    else if (implementation == "GPS_L1_CA_TCP_CONNECTOR_Tracking")
-        {
-            std::unique_ptr<TrackingInterface> block_(new GpsL1CaTcpConnectorTracking(configuration.get(), role, in_streams,
-                out_streams));
-            block = std::move(block_);
-        }
-    else if (implementation == "Galileo_E1_DLL_PLL_VEML_Tracking")
-        {
-            std::unique_ptr<TrackingInterface> block_(new GalileoE1DllPllVemlTracking(configuration.get(), role, in_streams,
-                out_streams));
-            block = std::move(block_);
-        }
-#if ENABLE_FPGA
-    else if (implementation == "Galileo_E1_DLL_PLL_VEML_Tracking_Fpga")
-        {
-            std::unique_ptr<TrackingInterface> block_(new GalileoE1DllPllVemlTrackingFpga(configuration.get(), role, in_streams,
-                out_streams));
-            block = std::move(block_);
-        }
-#endif
-    else if (implementation == "Galileo_E1_TCP_CONNECTOR_Tracking")
-        {
-            std::unique_ptr<TrackingInterface> block_(new GalileoE1TcpConnectorTracking(configuration.get(), role, in_streams,
-                out_streams));
-            block = std::move(block_);
-        }
-    else if (implementation == "Galileo_E5a_DLL_PLL_Tracking")
-        {
-            std::unique_ptr<TrackingInterface> block_(new GalileoE5aDllPllTracking(configuration.get(), role, in_streams,
-                out_streams));
-            block = std::move(block_);
-        }
-#if ENABLE_FPGA
-    else if (implementation == "Galileo_E5a_DLL_PLL_Tracking_Fpga")
-        {
-            std::unique_ptr<TrackingInterface> block_(new GalileoE5aDllPllTrackingFpga(configuration.get(), role, in_streams,
-                out_streams));
-            block = std::move(block_);
-        }
-#endif
-    else if (implementation == "GPS_L2_M_DLL_PLL_Tracking")
-        {
-            std::unique_ptr<TrackingInterface> block_(new GpsL2MDllPllTracking(configuration.get(), role, in_streams,
-                out_streams));
-            block = std::move(block_);
-        }
-#if ENABLE_FPGA
-    else if (implementation == "GPS_L2_M_DLL_PLL_Tracking_Fpga")
-        {
-            std::unique_ptr<TrackingInterface> block_(new GpsL2MDllPllTrackingFpga(configuration.get(), role, in_streams,
-                out_streams));
-            block = std::move(block_);
-        }
-#endif
-    else if ((implementation == "GPS_L5i_DLL_PLL_Tracking") or (implementation == "GPS_L5_DLL_PLL_Tracking"))
-        {
-            std::unique_ptr<TrackingInterface> block_(new GpsL5DllPllTracking(configuration.get(), role, in_streams,
-                out_streams));
-            block = std::move(block_);
-        }
-#if ENABLE_FPGA
-    else if ((implementation == "GPS_L5i_DLL_PLL_Tracking_Fpga") or (implementation == "GPS_L5_DLL_PLL_Tracking_Fpga"))
-        {
-            std::unique_ptr<TrackingInterface> block_(new GpsL5DllPllTrackingFpga(configuration.get(), role, in_streams,
-                out_streams));
-            block = std::move(block_);
-        }
-#endif
-#if CUDA_GPU_ACCEL
-    else if (implementation == "GPS_L1_CA_DLL_PLL_Tracking_GPU")
-        {
-            std::unique_ptr<TrackingInterface> block_(new GpsL1CaDllPllTrackingGPU(configuration.get(), role, in_streams,
-                out_streams));
-            block = std::move(block_);
-        }
-#endif
-    else if (implementation == "GLONASS_L1_CA_DLL_PLL_Tracking")
+    Block_Maker<TrackingInterface> maker = find_maker(tracking_makers(), implementation);
+    if (maker != nullptr)
         {
-            std::unique_ptr<TrackingInterface> block_(new GlonassL1CaDllPllTracking(configuration.get(), role, in_streams,
-                out_streams));
-            block = std::move(block_);
-        }
-    else if (implementation == "GLONASS_L1_CA_DLL_PLL_C_Aid_Tracking")
-        {
-            std::unique_ptr<TrackingInterface> block_(new GlonassL1CaDllPllCAidTracking(configuration.get(), role, in_streams,
-                out_streams));
-            block = std::move(block_);
-        }
-    else if (implementation == "GLONASS_L2_CA_DLL_PLL_Tracking")
-        {
-            std::unique_ptr<TrackingInterface> block_(new GlonassL2CaDllPllTracking(configuration.get(), role, in_streams,
-                out_streams));
-            block = std::move(block_);
-        }
-    else if (implementation == "GLONASS_L2_CA_DLL_PLL_C_Aid_Tracking")
-        {
-            std::unique_ptr<TrackingInterface> block_(new GlonassL2CaDllPllCAidTracking(configuration.get(), role, in_streams,
-                out_streams));
-            block = std::move(block_);
+            block = maker(configuration.get(), role, in_streams, out_streams, nullptr);
         }
     else
         {
@@ -2011,55 +1458,10 @@ std::unique_ptr<TelemetryDecoderInterface> GNSSBlockFactory::GetTlmBlock(
     unsigned int out_streams)
 {
     std::unique_ptr<TelemetryDecoderInterface> block;
-
-    // TELEMETRY DECODERS ----------------------------------------------------------
-    if (implementation == "GPS_L1_CA_Telemetry_Decoder")
-        {
-            std::unique_ptr<TelemetryDecoderInterface> block_(new GpsL1CaTelemetryDecoder(configuration.get(), role, in_streams,
-                out_streams));
-            block = std::move(block_);
-        }
-    else if (implementation == "Galileo_E1B_Telemetry_Decoder")
-        {
-            std::unique_ptr<TelemetryDecoderInterface> block_(new GalileoE1BTelemetryDecoder(configuration.get(), role, in_streams,
-                out_streams));
-            block = std::move(block_);
-        }
-    else if (implementation == "SBAS_L1_Telemetry_Decoder")
-        {
-            std::unique_ptr<TelemetryDecoderInterface> block_(new SbasL1TelemetryDecoder(configuration.get(), role, in_streams,
-                out_streams));
-            block = std::move(block_);
-        }
-    else if (implementation == "Galileo_E5a_Telemetry_Decoder")
-        {
-            std::unique_ptr<TelemetryDecoderInterface> block_(new GalileoE5aTelemetryDecoder(configuration.get(), role, in_streams,
-                out_streams));
-            block = std::move(block_);
-        }
-    else if (implementation == "GPS_L2C_Telemetry_Decoder")
-        {
-            std::unique_ptr<TelemetryDecoderInterface> block_(new GpsL2CTelemetryDecoder(configuration.get(), role, in_streams,
-                out_streams));
-            block = std::move(block_);
-        }
-    else if (implementation == "GLONASS_L1_CA_Telemetry_Decoder")
-        {
-            std::unique_ptr<TelemetryDecoderInterface> block_(new GlonassL1CaTelemetryDecoder(configuration.get(), role, in_streams,
-                out_streams));
-            block = std::move(block_);
-        }
-    else if (implementation == "GLONASS_L2_CA_Telemetry_Decoder")
-        {
-            std::unique_ptr<TelemetryDecoderInterface> block_(new GlonassL2CaTelemetryDecoder(configuration.get(), role, in_streams,
-                out_streams));
-            block = std::move(block_);
-        }
-    else if (implementation == "GPS_L5_Telemetry_Decoder")
+    Block_Maker<TelemetryDecoderInterface> maker = find_maker(telemetry_makers(), implementation);
+    if (maker != nullptr)
         {
-            std::unique_ptr<TelemetryDecoderInterface> block_(new GpsL5TelemetryDecoder(configuration.get(), role, in_streams,
-                out_streams));
-            block = std::move(block_);
+            block = maker(configuration.get(), role, in_streams, out_streams, nullptr);
         }
     else
         {
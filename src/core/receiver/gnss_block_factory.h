@@ -38,6 +38,7 @@
 #define GNSS_SDR_BLOCK_FACTORY_H_
 
 #include <gnuradio/msg_queue.h>
+#include <functional>
 #include <memory>
 #include <string>
 #include <vector>
@@ -78,6 +79,10 @@ public:
         gr::msg_queue::sptr queue = nullptr);
 
 private:
+    void BuildChannels(std::shared_ptr<ConfigurationInterface> configuration,
+        const std::vector<std::function<std::unique_ptr<GNSSBlockInterface>()>>& channel_builders,
+        std::vector<std::unique_ptr<GNSSBlockInterface>>& channels);
+
     std::unique_ptr<GNSSBlockInterface> GetChannel_1C(std::shared_ptr<ConfigurationInterface> configuration,
         std::string acq, std::string trk, std::string tlm, int channel,
         gr::msg_queue::sptr queue);
@@ -9,7 +9,7 @@
  *
  * -------------------------------------------------------------------------
  *
- * Copyright (C) 2010-2018  (see AUTHORS file for a list of contributors)
+ * Copyright (C) 2010-2019  (see AUTHORS file for a list of contributors)
  *
  * GNSS-SDR is a software defined Global Navigation
  *          Satellite Systems receiver
@@ -33,6 +33,7 @@
  */
 
 #include "gnss_flowgraph.h"
+#include "GLONASS_L1_L2_CA.h"
 #include "GPS_L1_CA.h"
 #include "GPS_L2C.h"
 #include "GPS_L5.h"
@@ -42,19 +43,41 @@
 #include "channel_interface.h"
 #include "configuration_interface.h"
 #include "gnss_block_factory.h"
+#include "gnss_ephemeris_registry.h"
+#include "gnss_memory_accounting.h"
+#include "gnss_metrics.h"
+#include "gnss_sdr_fft_wisdom.h"
+#include "gnss_sdr_memory_policy.h"
+#include "gnss_synchro.h"
+#include "gnss_tracking_state_registry.h"
 #include <boost/lexical_cast.hpp>
 #include <boost/tokenizer.hpp>
 #include <glog/logging.h>
+#include <gnuradio/block_detail.h>
+#include <gnuradio/buffer.h>
 #include <gnuradio/filter/firdes.h>
+#include <gnuradio/high_res_timer.h>
+#include <gnuradio/io_signature.h>
 #include <algorithm>
+#include <chrono>
+#include <cmath>
 #include <exception>
+#include <fstream>
 #include <iostream>
+#include <limits>
 #include <set>
+#include <sstream>
+#include <thread>
+#include <tuple>
 #include <utility>
 #ifdef GR_GREATER_38
+#include <gnuradio/blocks/integrate.h>
 #include <gnuradio/filter/fir_filter_blk.h>
+#include <gnuradio/filter/freq_xlating_fir_filter.h>
 #else
+#include <gnuradio/blocks/integrate_cc.h>
 #include <gnuradio/filter/fir_filter_ccf.h>
+#include <gnuradio/filter/freq_xlating_fir_filter_ccf.h>
 #endif
 
 
@@ -66,18 +89,39 @@ GNSSFlowgraph::GNSSFlowgraph(std::shared_ptr<ConfigurationInterface> configurati
 {
     connected_ = false;
     running_ = false;
+    doppler_aiding_uncertainty_hz_ = 0.0;
+    cross_band_uncertainty_hz_ = 0.0;
+    acq_load_per_tracking_channel_ = 0.0;
+    min_acq_channels_ = 1;
+    overload_watchdog_stop_ = false;
+    overload_max_deficit_ = 0.02;
+    overload_check_interval_ms_ = 1000;
+    overload_recovery_checks_ = 10;
+    overload_min_channels_ = 4;
+    acquisitions_suspended_ = false;
+    position_outputs_suspended_ = false;
     configuration_ = configuration;
     queue_ = std::move(queue);
+    state_registry_ = Gnss_Tracking_State_Registry::get_instance();
     init();
 }
 
 
 GNSSFlowgraph::~GNSSFlowgraph()
 {
+    stop_overload_watchdog();
+    stop_channel_events();
     if (connected_)
         {
             GNSSFlowgraph::disconnect();
         }
+    if (!fft_wisdom_filename_.empty())
+        {
+            if (!gnss_sdr_save_fft_wisdom(fft_wisdom_filename_))
+                {
+                    LOG(WARNING) << "Unable to write the FFT wisdom file " << fft_wisdom_filename_;
+                }
+        }
 }
 
 
@@ -89,6 +133,7 @@ void GNSSFlowgraph::start()
             return;
         }
 
+    std::chrono::time_point<std::chrono::steady_clock> start_start = std::chrono::steady_clock::now();
     try
         {
             top_block_->start();
@@ -101,6 +146,18 @@ void GNSSFlowgraph::start()
         }
 
     running_ = true;
+    startup_times_s_["start"] = std::chrono::duration<double>(std::chrono::steady_clock::now() - start_start).count();
+    apply_memory_policy();
+    if (channel_events_ != nullptr)
+        {
+            channel_events_thread_ = std::thread(&GNSSFlowgraph::dispatch_channel_events, this);
+        }
+    // Files are not read in real time, there is no load to shed
+    if (configuration_->property("GNSS-SDR.overload_watchdog", false) and !batch_scheduler_ and ((ch_out_sample_counter != nullptr) or shared_sample_clock_))
+        {
+            overload_watchdog_stop_ = false;
+            overload_watchdog_thread_ = std::thread(&GNSSFlowgraph::overload_watchdog, this);
+        }
 }
 
 
@@ -108,6 +165,47 @@ void GNSSFlowgraph::stop()
 {
     top_block_->stop();
     running_ = false;
+    stop_overload_watchdog();
+    stop_channel_events();
+}
+
+
+void GNSSFlowgraph::dispatch_channel_events()
+{
+    // A burst of events (e.g. many acquisitions failing at cold start) is handled in a single pass
+    std::vector<ControlMessage> events;
+    for (;;)
+        {
+            events.resize(1);
+            channel_events_->wait_and_pop(events.front());
+            channel_events_->try_pop_n(events, channel_events_->capacity());
+            auto end = std::find_if(events.begin(), events.end(), [](const ControlMessage& event) { return event.who == std::numeric_limits<unsigned int>::max(); });
+            if (end != events.begin())
+                {
+                    apply_actions(std::vector<ControlMessage>(events.begin(), end));
+                }
+            if (end != events.end())
+                {
+                    return;
+                }
+        }
+}
+
+
+void GNSSFlowgraph::stop_channel_events()
+{
+    if (!channel_events_thread_.joinable())
+        {
+            return;
+        }
+    ControlMessage stop_event;
+    stop_event.who = std::numeric_limits<unsigned int>::max();
+    stop_event.what = 0;
+    while (!channel_events_->push(std::move(stop_event)))
+        {
+            std::this_thread::yield();
+        }
+    channel_events_thread_.join();
 }
 
 
@@ -117,12 +215,24 @@ void GNSSFlowgraph::connect()
     // Signal Source > Signal conditioner >> Channels >> Observables >> PVT
 
     LOG(INFO) << "Connecting flowgraph";
+    std::chrono::time_point<std::chrono::steady_clock> connect_start = std::chrono::steady_clock::now();
     if (connected_)
         {
             LOG(WARNING) << "flowgraph already connected";
             return;
         }
 
+    // the new PVT block has not received any ephemeris yet
+    Gnss_Ephemeris_Registry::get_instance()->clear();
+
+    if (distributed_role_ == "pvt")
+        {
+            connect_pvt_node();
+            startup_times_s_["connect"] = std::chrono::duration<double>(std::chrono::steady_clock::now() - connect_start).count();
+            LOG(INFO) << "Flowgraph connected in " << std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - connect_start).count() << " ms";
+            return;
+        }
+
     for (int i = 0; i < sources_count_; i++)
         {
             if (configuration_->property(sig_source_.at(i)->role() + ".enable_FPGA", false) == false)
@@ -273,6 +383,32 @@ void GNSSFlowgraph::connect()
                 }
         }
     DLOG(INFO) << "Signal source connected to signal conditioner";
+
+    if (distributed_role_ == "source")
+        {
+            // Signal Source > Signal conditioner > channels nodes
+            try
+                {
+                    for (unsigned int i = 0; i < sample_sinks_.size(); i++)
+                        {
+                            top_block_->connect(sig_conditioner_.at(i)->get_right_block(), 0, sample_sinks_.at(i), 0);
+                        }
+                }
+            catch (const std::exception& e)
+                {
+                    LOG(WARNING) << "Can't connect signal conditioner to the channels nodes";
+                    LOG(ERROR) << e.what();
+                    top_block_->disconnect_all();
+                    return;
+                }
+            set_thread_placement();
+            set_buffer_sizes();
+            connected_ = true;
+            startup_times_s_["connect"] = std::chrono::duration<double>(std::chrono::steady_clock::now() - connect_start).count();
+            LOG(INFO) << "Flowgraph connected in " << std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - connect_start).count() << " ms";
+            return;
+        }
+
     bool FPGA_enabled = configuration_->property(sig_source_.at(0)->role() + ".enable_FPGA", false);
 
 #if ENABLE_FPGA
@@ -289,10 +425,18 @@ void GNSSFlowgraph::connect()
                             std::cout << "Set GNSS-SDR.internal_fs_sps in configuration file" << std::endl;
                             throw(std::invalid_argument("Set GNSS-SDR.internal_fs_sps in configuration"));
                         }
-                    int observable_interval_ms = static_cast<double>(configuration_->property("GNSS-SDR.observable_interval_ms", 20));
-                    ch_out_sample_counter = gnss_sdr_make_sample_counter(fs, observable_interval_ms, sig_conditioner_.at(0)->get_right_block()->output_signature()->sizeof_stream_item(0));
-                    top_block_->connect(sig_conditioner_.at(0)->get_right_block(), 0, ch_out_sample_counter, 0);
-                    top_block_->connect(ch_out_sample_counter, 0, observables_->get_left_block(), channels_count_);  //extra port for the sample counter pulse
+                    if (shared_sample_clock_)
+                        {
+                            // the channels advance the clock, no reader of the conditioner output is needed
+                            Gnss_Sdr_Sample_Clock::get_instance()->reset(fs);
+                        }
+                    else
+                        {
+                            int observable_interval_ms = static_cast<double>(configuration_->property("GNSS-SDR.observable_interval_ms", 20));
+                            ch_out_sample_counter = gnss_sdr_make_sample_counter(fs, observable_interval_ms, sig_conditioner_.at(0)->get_right_block()->output_signature()->sizeof_stream_item(0));
+                            top_block_->connect(sig_conditioner_.at(0)->get_right_block(), 0, ch_out_sample_counter, 0);
+                            top_block_->connect(ch_out_sample_counter, 0, observables_input_, channels_count_);  //extra port for the sample counter pulse
+                        }
                 }
             catch (const std::exception& e)
                 {
@@ -314,9 +458,19 @@ void GNSSFlowgraph::connect()
                             std::cout << "Set GNSS-SDR.internal_fs_sps in configuration file" << std::endl;
                             throw(std::invalid_argument("Set GNSS-SDR.internal_fs_sps in configuration"));
                         }
-                    int observable_interval_ms = static_cast<double>(configuration_->property("GNSS-SDR.observable_interval_ms", 20));
-                    ch_out_fpga_sample_counter = gnss_sdr_make_fpga_sample_counter(fs, observable_interval_ms);
-                    top_block_->connect(ch_out_fpga_sample_counter, 0, observables_->get_left_block(), channels_count_);  //extra port for the sample counter pulse
+                    if (shared_sample_clock_)
+                        {
+                            // advanced by the observables block with the outputs of the channels
+                            Gnss_Sdr_Sample_Clock::get_instance()->reset(fs);
+                        }
+                    else
+                        {
+                            int observable_interval_ms = static_cast<double>(configuration_->property("GNSS-SDR.observable_interval_ms", 20));
+                            // several epochs per interrupt, to save interrupts and context switches
+                            int intervals_per_interrupt = configuration_->property("GNSS-SDR.fpga_intervals_per_interrupt", 1);
+                            ch_out_fpga_sample_counter = gnss_sdr_make_fpga_sample_counter(fs, observable_interval_ms, intervals_per_interrupt);
+                            top_block_->connect(ch_out_fpga_sample_counter, 0, observables_input_, channels_count_);  //extra port for the sample counter pulse
+                        }
                 }
             catch (const std::exception& e)
                 {
@@ -339,10 +493,18 @@ void GNSSFlowgraph::connect()
                     throw(std::invalid_argument("Set GNSS-SDR.internal_fs_sps in configuration"));
                 }
 
-            int observable_interval_ms = static_cast<double>(configuration_->property("GNSS-SDR.observable_interval_ms", 20));
-            ch_out_sample_counter = gnss_sdr_make_sample_counter(fs, observable_interval_ms, sig_conditioner_.at(0)->get_right_block()->output_signature()->sizeof_stream_item(0));
-            top_block_->connect(sig_conditioner_.at(0)->get_right_block(), 0, ch_out_sample_counter, 0);
-            top_block_->connect(ch_out_sample_counter, 0, observables_->get_left_block(), channels_count_);  //extra port for the sample counter pulse
+            if (shared_sample_clock_)
+                {
+                    // the channels advance the clock, no reader of the conditioner output is needed
+                    Gnss_Sdr_Sample_Clock::get_instance()->reset(fs);
+                }
+            else
+                {
+                    int observable_interval_ms = static_cast<double>(configuration_->property("GNSS-SDR.observable_interval_ms", 20));
+                    ch_out_sample_counter = gnss_sdr_make_sample_counter(fs, observable_interval_ms, sig_conditioner_.at(0)->get_right_block()->output_signature()->sizeof_stream_item(0));
+                    top_block_->connect(sig_conditioner_.at(0)->get_right_block(), 0, ch_out_sample_counter, 0);
+                    top_block_->connect(ch_out_sample_counter, 0, observables_input_, channels_count_);  //extra port for the sample counter pulse
+                }
         }
     catch (const std::exception& e)
         {
@@ -368,8 +530,11 @@ void GNSSFlowgraph::connect()
                         {
                             LOG(WARNING) << e.what();
                         }
+                    int conditioner_port = get_conditioner_port(i, selected_signal_conditioner_ID);
                     try
                         {
+                            int trk_port = 0;
+                            gr::basic_block_sptr trk_input = get_trk_input_block(i, selected_signal_conditioner_ID, trk_port);
                             // Enable automatic resampler for the acquisition, if required
                             if (use_acq_resampler == true)
                                 {
@@ -408,7 +573,7 @@ void GNSSFlowgraph::connect()
                                     if (acq_fs < fs)
                                         {
                                             //check if the resampler is already created for the channel system/signal and for the specific RF Channel
-                                            std::string map_key = channels_.at(i)->implementation() + std::to_string(selected_signal_conditioner_ID);
+                                            std::string map_key = channels_.at(i)->implementation() + std::to_string(selected_signal_conditioner_ID) + "_" + std::to_string(conditioner_port);
                                             resampler_ratio = static_cast<double>(fs) / acq_fs;
                                             int decimation = floor(resampler_ratio);
                                             while (fs % decimation > 0)
@@ -433,7 +598,7 @@ void GNSSFlowgraph::connect()
                                                     ret = acq_resamplers_.insert(std::pair<std::string, gr::basic_block_sptr>(map_key, fir_filter_ccf_));
                                                     if (ret.second == true)
                                                         {
-                                                            top_block_->connect(sig_conditioner_.at(selected_signal_conditioner_ID)->get_right_block(), 0,
+                                                            top_block_->connect(sig_conditioner_.at(selected_signal_conditioner_ID)->get_right_block(), conditioner_port,
                                                                 acq_resamplers_.at(map_key), 0);
                                                             LOG(INFO) << "Created "
                                                                       << channels_.at(i)->implementation()
@@ -450,7 +615,7 @@ void GNSSFlowgraph::connect()
                                                     top_block_->connect(acq_resamplers_.at(map_key), 0,
                                                         channels_.at(i)->get_left_block_acq(), 0);
 
-                                                    top_block_->connect(sig_conditioner_.at(selected_signal_conditioner_ID)->get_right_block(), 0,
+                                                    top_block_->connect(trk_input, trk_port,
                                                         channels_.at(i)->get_left_block_trk(), 0);
 
                                                     std::shared_ptr<Channel> channel_ptr;
@@ -461,26 +626,26 @@ void GNSSFlowgraph::connect()
                                                 {
                                                     LOG(INFO) << "Disabled acquisition resampler because the input sampling frequency is too low";
                                                     //resampler not required!
-                                                    top_block_->connect(sig_conditioner_.at(selected_signal_conditioner_ID)->get_right_block(), 0,
+                                                    top_block_->connect(sig_conditioner_.at(selected_signal_conditioner_ID)->get_right_block(), conditioner_port,
                                                         channels_.at(i)->get_left_block_acq(), 0);
-                                                    top_block_->connect(sig_conditioner_.at(selected_signal_conditioner_ID)->get_right_block(), 0,
+                                                    top_block_->connect(trk_input, trk_port,
                                                         channels_.at(i)->get_left_block_trk(), 0);
                                                 }
                                         }
                                     else
                                         {
                                             LOG(INFO) << "Disabled acquisition resampler because the input sampling frequency is too low";
-                                            top_block_->connect(sig_conditioner_.at(selected_signal_conditioner_ID)->get_right_block(), 0,
+                                            top_block_->connect(sig_conditioner_.at(selected_signal_conditioner_ID)->get_right_block(), conditioner_port,
                                                 channels_.at(i)->get_left_block_acq(), 0);
-                                            top_block_->connect(sig_conditioner_.at(selected_signal_conditioner_ID)->get_right_block(), 0,
+                                            top_block_->connect(trk_input, trk_port,
                                                 channels_.at(i)->get_left_block_trk(), 0);
                                         }
                                 }
                             else
                                 {
-                                    top_block_->connect(sig_conditioner_.at(selected_signal_conditioner_ID)->get_right_block(), 0,
+                                    top_block_->connect(sig_conditioner_.at(selected_signal_conditioner_ID)->get_right_block(), conditioner_port,
                                         channels_.at(i)->get_left_block_acq(), 0);
-                                    top_block_->connect(sig_conditioner_.at(selected_signal_conditioner_ID)->get_right_block(), 0,
+                                    top_block_->connect(trk_input, trk_port,
                                         channels_.at(i)->get_left_block_trk(), 0);
                                 }
                         }
@@ -498,7 +663,7 @@ void GNSSFlowgraph::connect()
             try
                 {
                     top_block_->connect(channels_.at(i)->get_right_block(), 0,
-                        observables_->get_left_block(), i);
+                        observables_input_, i);
                 }
             catch (const std::exception& e)
                 {
@@ -548,7 +713,7 @@ void GNSSFlowgraph::connect()
                 }
             if (sat == 0)
                 {
-                    channels_.at(i)->set_signal(search_next_signal(gnss_signal, false));
+                    set_channel_signal(i, search_next_signal(gnss_signal, false));
                 }
             else
                 {
@@ -606,16 +771,26 @@ void GNSSFlowgraph::connect()
                             break;
                         }
 
-                    channels_.at(i)->set_signal(signal_value);
+                    set_channel_signal(i, signal_value);
                 }
         }
 
     // Connect the observables output of each channel to the PVT block
+    // (in a channels node, the navigation data goes with the channel outputs to the PVT node)
     try
         {
             for (unsigned int i = 0; i < channels_count_; i++)
                 {
-                    top_block_->connect(observables_->get_right_block(), i, pvt_->get_left_block(), i);
+                    if (distributed_role_ == "channels")
+                        {
+                            top_block_->msg_connect(channels_.at(i)->get_right_block(), pmt::mp("telemetry"), observables_input_, pmt::mp("telemetry"));
+                            continue;
+                        }
+                    // with vector observables, all the channels go through the first port
+                    if (!vector_observables_ or i == 0)
+                        {
+                            top_block_->connect(observables_->get_right_block(), i, pvt_->get_left_block(), i);
+                        }
                     top_block_->msg_connect(channels_.at(i)->get_right_block(), pmt::mp("telemetry"), pvt_->get_left_block(), pmt::mp("telemetry"));
                 }
         }
@@ -632,7 +807,8 @@ void GNSSFlowgraph::connect()
         {
             try
                 {
-                    for (unsigned int i = 0; i < channels_count_; i++)
+                    const unsigned int streams = vector_observables_ ? 1 : channels_count_;
+                    for (unsigned int i = 0; i < streams; i++)
                         {
                             top_block_->connect(observables_->get_right_block(), i, GnssSynchroMonitor_, i);
                         }
@@ -664,12 +840,431 @@ void GNSSFlowgraph::connect()
                 }
         }
 
+    set_thread_placement();
+    set_buffer_sizes();
+
     connected_ = true;
-    LOG(INFO) << "Flowgraph connected";
+    startup_times_s_["connect"] = std::chrono::duration<double>(std::chrono::steady_clock::now() - connect_start).count();
+    LOG(INFO) << "Flowgraph connected in " << std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - connect_start).count() << " ms";
     top_block_->dump();
 }
 
 
+/*
+ * The samples of a file are all available at once, so the channels can run
+ * as fast as the cores allow instead of waiting for them. The outcome only
+ * depends on the file if each channel processes its samples in the same
+ * order on every run: the acquisitions block the sample stream while they
+ * search, and while they wait for their next satellite, so the channel
+ * assignments happen at the same sample every time.
+ */
+bool GNSSFlowgraph::set_batch_scheduler()
+{
+    for (const auto& source : sig_source_)
+        {
+            const std::string implementation = source->implementation();
+            if ((implementation.find("File") == std::string::npos) and (implementation != "Labsat_Signal_Source"))
+                {
+                    LOG(WARNING) << "GNSS-SDR.scheduler=batch needs file signal sources, " << source->role() << " is a " << implementation << ". Using the default scheduler";
+                    std::cout << "GNSS-SDR.scheduler=batch ignored: " << source->role() << " does not read a file" << std::endl;
+                    return false;
+                }
+        }
+    unsigned int total_channels = 0;
+    for (const auto& signal : {"1C", "2S", "L5", "1B", "5X", "1G", "2G"})
+        {
+            total_channels += configuration_->property("Channels_" + std::string(signal) + ".count", 0U);
+        }
+    for (const auto& signal : {"1C", "2S", "L5", "1B", "5X", "1G", "2G"})
+        {
+            // the acquisitions of each signal, and those configured for a given channel
+            std::vector<std::string> roles(1, "Acquisition_" + std::string(signal));
+            for (unsigned int channel = 0; channel < total_channels; channel++)
+                {
+                    std::string role = "Acquisition_" + std::string(signal) + std::to_string(channel);
+                    if (!configuration_->property(role + ".implementation", std::string("")).empty())
+                        {
+                            roles.push_back(role);
+                        }
+                }
+            for (const auto& role : roles)
+                {
+                    configuration_->set_property(role + ".blocking", "true");
+                    configuration_->set_property(role + ".blocking_on_standby", "true");
+                }
+        }
+    LOG(INFO) << "Batch scheduler: blocking acquisitions, channels pinned to a fixed set of cores";
+    return true;
+}
+
+
+void GNSSFlowgraph::set_thread_placement()
+{
+    // With GNSS-SDR.numa_node, the threads stay on the cores of that node, so that
+    // the buffers they write (first touch) are allocated in its local memory
+    std::vector<int> node_cores;
+    int numa_node = configuration_->property("GNSS-SDR.numa_node", -1);
+    if (numa_node >= 0)
+        {
+            std::ifstream cpulist("/sys/devices/system/node/node" + std::to_string(numa_node) + "/cpulist");
+            std::string list;
+            if (cpulist.is_open() and std::getline(cpulist, list))
+                {
+                    node_cores = parse_cpu_list(list);
+                }
+            if (node_cores.empty())
+                {
+                    LOG(WARNING) << "Unable to read the cores of NUMA node " << numa_node << ", GNSS-SDR.numa_node ignored";
+                }
+        }
+
+    // The cores explicitly assigned to the signal sources and conditioners are kept free of channels
+    std::set<int> reserved_cores;
+    for (const auto& source : sig_source_)
+        {
+            std::vector<int> cores = set_block_placement(source->role(), {source->get_right_block()}, node_cores, 0);
+            reserved_cores.insert(cores.begin(), cores.end());
+        }
+    for (const auto& conditioner : sig_conditioner_)
+        {
+            std::vector<int> cores = set_block_placement(conditioner->role(), {conditioner->get_left_block(), conditioner->get_right_block()}, node_cores, 0);
+            reserved_cores.insert(cores.begin(), cores.end());
+        }
+    set_block_placement(observables_->role(), {observables_->get_left_block(), observables_->get_right_block()}, node_cores, 0);
+    set_block_placement(pvt_->role(), {pvt_->get_left_block()}, node_cores, 0);
+
+    // Cores available for the round-robin placement of the channels
+    // In batch mode, the channels run in parallel on a fixed set of GNSS-SDR.batch_threads cores
+    std::vector<int> channel_cores;
+    if (configuration_->property("GNSS-SDR.channel_affinity", batch_scheduler_))
+        {
+            int default_cores = static_cast<int>(std::max(std::thread::hardware_concurrency(), 1U));
+            if (batch_scheduler_)
+                {
+                    default_cores = configuration_->property("GNSS-SDR.batch_threads", default_cores);
+                }
+            int n_cores = configuration_->property("GNSS-SDR.channel_affinity_cores", default_cores);
+            if (n_cores <= 0)
+                {
+                    LOG(WARNING) << "GNSS-SDR.channel_affinity_cores must be positive, channel affinity disabled";
+                }
+            else
+                {
+                    for (int core = 0; core < n_cores; core++)
+                        {
+                            if ((node_cores.empty() or std::find(node_cores.begin(), node_cores.end(), core) != node_cores.end()) and
+                                (reserved_cores.count(core) == 0))
+                                {
+                                    channel_cores.push_back(core);
+                                }
+                        }
+                    if (channel_cores.empty())
+                        {
+                            LOG(WARNING) << "All the channel affinity cores are reserved, channels share them with the signal sources";
+                            for (int core = 0; core < n_cores; core++)
+                                {
+                                    channel_cores.push_back(core);
+                                }
+                        }
+                }
+        }
+
+    // The channels of each band are spread over the cores, so that every core holds
+    // a similar tracking load, and all the blocks of a channel share the same core
+    int channel_priority = configuration_->property("Channel.rt_priority", 0);
+    std::map<std::string, size_t> next_core;
+    for (unsigned int i = 0; i < channels_count_; i++)
+        {
+            std::string signal = channels_.at(i)->get_signal().get_signal_str();
+            std::vector<int> cores = node_cores;
+            if (!channel_cores.empty())
+                {
+                    if (next_core.find(signal) == next_core.end())
+                        {
+                            size_t first_core = next_core.size() % channel_cores.size();
+                            next_core[signal] = first_core;
+                        }
+                    cores = std::vector<int>(1, channel_cores[next_core[signal]]);
+                    next_core[signal] = (next_core[signal] + 1) % channel_cores.size();
+                }
+            std::vector<int> explicit_cores = set_block_placement("Channel" + std::to_string(i),
+                {channels_.at(i)->get_left_block_acq(), channels_.at(i)->get_left_block_trk(), channels_.at(i)->get_right_block()},
+                cores, channel_priority);
+            if (!explicit_cores.empty())
+                {
+                    cores = explicit_cores;
+                }
+            if (!cores.empty())
+                {
+                    LOG(INFO) << "Channel " << i << " (" << signal << ") pinned to core " << cores[0] << (cores.size() > 1 ? " and others" : "");
+                }
+        }
+}
+
+
+void GNSSFlowgraph::set_buffer_sizes()
+{
+    if (batch_scheduler_)
+        {
+            if (configuration_->property("GNSS-SDR.low_latency", false))
+                {
+                    LOG(WARNING) << "GNSS-SDR.low_latency is ignored with GNSS-SDR.scheduler=batch";
+                }
+            set_batch_chunks();
+            return;
+        }
+    if (!configuration_->property("GNSS-SDR.low_latency", false))
+        {
+            return;
+        }
+    // Sample buffers: two periods of the longest spreading code (Galileo E1, 4 ms) are needed by the tracking blocks
+    int buffer_ms = configuration_->property("GNSS-SDR.low_latency_buffer_ms", 10);
+    if (buffer_ms < 8)
+        {
+            LOG(WARNING) << "GNSS-SDR.low_latency_buffer_ms must be at least 8 ms, set to 8 ms";
+            buffer_ms = 8;
+        }
+    // Gnss_Synchro buffers: channels >> observables >> PVT
+    int synchro_items = configuration_->property("GNSS-SDR.low_latency_synchro_items", 32);
+    if (synchro_items < 2)
+        {
+            LOG(WARNING) << "GNSS-SDR.low_latency_synchro_items must be at least 2, set to 2";
+            synchro_items = 2;
+        }
+    double fs = configuration_->property("GNSS-SDR.internal_fs_sps", 0.0);
+    int max_buffer_ms = 0;
+
+    for (const auto& source : sig_source_)
+        {
+            double source_fs = configuration_->property(source->role() + ".sampling_frequency", fs);
+            if (set_block_buffer(source->get_right_block(), static_cast<int>(source_fs * buffer_ms / 1000.0)))
+                {
+                    max_buffer_ms = buffer_ms;
+                }
+        }
+    bool conditioner_buffer = false;
+    for (const auto& conditioner : sig_conditioner_)
+        {
+            if (set_block_buffer(conditioner->get_right_block(), static_cast<int>(fs * buffer_ms / 1000.0)))
+                {
+                    conditioner_buffer = true;
+                }
+        }
+    if (conditioner_buffer)
+        {
+            max_buffer_ms += buffer_ms;
+        }
+    for (unsigned int i = 0; i < channels_count_; i++)
+        {
+            set_block_buffer(channels_.at(i)->get_left_block_trk(), synchro_items);
+            set_block_buffer(channels_.at(i)->get_right_block(), synchro_items);
+        }
+    set_block_buffer(observables_->get_right_block(), synchro_items);
+
+    // Samples are released in chunks of half a buffer, and the observables wait for their next epoch
+    int latency_ms = max_buffer_ms / 2 + configuration_->property("GNSS-SDR.observable_interval_ms", 20);
+    LOG(INFO) << "Low latency mode: " << buffer_ms << " ms sample buffers, " << synchro_items << " items Gnss_Synchro buffers";
+    std::cout << "Low latency mode enabled, sample buffering up to " << max_buffer_ms << " ms, expected latency to the observables about " << latency_ms << " ms" << std::endl;
+}
+
+
+/*
+ * With the default buffers, each block is woken up for every few thousand
+ * samples written by the block before it. In batch mode the source and the
+ * conditioners only run when a whole chunk fits in their output buffer, so
+ * every wake-up of the readers (the channels) is worth a whole chunk.
+ */
+void GNSSFlowgraph::set_batch_chunks()
+{
+    int chunk_ms = configuration_->property("GNSS-SDR.batch_chunk_ms", 100);
+    if (chunk_ms < 1)
+        {
+            LOG(WARNING) << "GNSS-SDR.batch_chunk_ms must be positive, set to 100 ms";
+            chunk_ms = 100;
+        }
+    double fs = configuration_->property("GNSS-SDR.internal_fs_sps", 0.0);
+    std::vector<gr::basic_block_sptr> sample_blocks;
+    std::vector<double> sample_rates;
+    for (const auto& source : sig_source_)
+        {
+            sample_blocks.push_back(source->get_right_block());
+            sample_rates.push_back(configuration_->property(source->role() + ".sampling_frequency", fs));
+        }
+    for (const auto& conditioner : sig_conditioner_)
+        {
+            sample_blocks.push_back(conditioner->get_right_block());
+            sample_rates.push_back(fs);
+        }
+    for (size_t i = 0; i < sample_blocks.size(); i++)
+        {
+            gr::block_sptr block = boost::dynamic_pointer_cast<gr::block>(sample_blocks[i]);
+            auto items = static_cast<int>(sample_rates[i] * chunk_ms / 1000.0);
+            if ((block == nullptr) or (items <= 0))
+                {
+                    continue;
+                }
+            // room for the chunk being read and the next one
+            block->set_min_output_buffer(2 * static_cast<long>(items));
+            block->set_min_noutput_items(items);
+        }
+    std::cout << "Batch scheduler: samples processed in chunks of " << chunk_ms << " ms" << std::endl;
+}
+
+
+bool GNSSFlowgraph::set_block_buffer(const gr::basic_block_sptr& basic_block, int items)
+{
+    gr::block_sptr block = boost::dynamic_pointer_cast<gr::block>(basic_block);
+    if ((block == nullptr) or (items <= 0))
+        {
+            return false;
+        }
+    block->set_max_output_buffer(items);
+    block->set_max_noutput_items(std::max(items / 2, 1));
+    return true;
+}
+
+
+std::vector<int> GNSSFlowgraph::set_block_placement(const std::string& role, const std::vector<gr::basic_block_sptr>& blocks, const std::vector<int>& default_cores, int default_priority)
+{
+    std::vector<int> cores = parse_cpu_list(configuration_->property(role + ".cpu_affinity", std::string("")));
+    int priority = configuration_->property(role + ".rt_priority", default_priority);
+    const std::vector<int>& applied_cores = cores.empty() ? default_cores : cores;
+    for (const auto& basic_block : blocks)
+        {
+            gr::block_sptr block = boost::dynamic_pointer_cast<gr::block>(basic_block);
+            if (block == nullptr)
+                {
+                    continue;
+                }
+            if (!applied_cores.empty())
+                {
+                    block->set_processor_affinity(applied_cores);
+                }
+            if (priority > 0)
+                {
+                    // Applied by the scheduler when the thread of the block starts
+                    block->set_thread_priority(priority);
+                }
+        }
+    return cores;
+}
+
+
+std::vector<int> GNSSFlowgraph::parse_cpu_list(const std::string& list)
+{
+    // Linux cpulist format, e.g. "0,2,4-7"
+    std::vector<int> cores;
+    for (const auto& item : split_string(list, ','))
+        {
+            try
+                {
+                    size_t dash = item.find('-');
+                    int first = std::stoi(item.substr(0, dash));
+                    int last = (dash == std::string::npos) ? first : std::stoi(item.substr(dash + 1));
+                    for (int core = first; core <= last; core++)
+                        {
+                            if (core >= 0)
+                                {
+                                    cores.push_back(core);
+                                }
+                        }
+                }
+            catch (const std::exception& e)
+                {
+                    LOG(WARNING) << "Malformed core list " << list << ": " << e.what();
+                    return std::vector<int>();
+                }
+        }
+    return cores;
+}
+
+
+int GNSSFlowgraph::get_conditioner_port(unsigned int ch_index, int signal_conditioner_ID)
+{
+    // A channelizer delivers one sub-band per output port. Each channel takes the
+    // sub-band declared for its signal, unless Channel<i>.sub_band selects another one
+    std::string role = sig_conditioner_.at(signal_conditioner_ID)->role();
+    std::string signal = channels_.at(ch_index)->get_signal().get_signal_str();
+    int sub_bands = configuration_->property(role + ".sub_bands", 1);
+    int port = 0;
+    for (int k = 0; k < sub_bands; k++)
+        {
+            if (configuration_->property(role + ".sub_band" + std::to_string(k) + "_signal", std::string("")) == signal)
+                {
+                    port = k;
+                    break;
+                }
+        }
+    return configuration_->property("Channel" + std::to_string(ch_index) + ".sub_band", port);
+}
+
+
+gr::basic_block_sptr GNSSFlowgraph::get_trk_input_block(unsigned int ch_index, int signal_conditioner_ID, int& port)
+{
+    gr::basic_block_sptr conditioner_output = sig_conditioner_.at(signal_conditioner_ID)->get_right_block();
+    int conditioner_port = get_conditioner_port(ch_index, signal_conditioner_ID);
+    std::shared_ptr<Channel> channel_ptr = std::dynamic_pointer_cast<Channel>(channels_.at(ch_index));
+    unsigned int decimation = 1;
+    if (channel_ptr != nullptr)
+        {
+            decimation = channel_ptr->tracking()->pre_decimation_factor();
+        }
+
+    // GLONASS channels fixed to a satellite share one pre-mixer per frequency channel number,
+    // which removes the FDMA offset and decimates once for all of them
+    std::string signal = channels_.at(ch_index)->get_signal().get_signal_str();
+    unsigned int sat = configuration_->property("Channel" + std::to_string(ch_index) + ".satellite", 0);
+    if ((signal == "1G" or signal == "2G") and sat != 0 and channel_ptr != nullptr and configuration_->property("GNSS-SDR.glonass_fdma_premix", false) and GLONASS_PRN.count(sat) > 0)
+        {
+            int32_t freq_channel = GLONASS_PRN.at(sat);
+            double fs = configuration_->property("GNSS-SDR.internal_fs_sps", 0.0);
+            double premix_fs = fs / static_cast<double>(decimation);
+            std::vector<float> taps = gr::filter::firdes::low_pass(1.0,
+                fs,
+                0.4 * premix_fs,
+                0.1 * premix_fs,
+                gr::filter::firdes::win_type::WIN_HAMMING);
+            if (channel_ptr->tracking()->set_fdma_premixed((taps.size() - 1) / 2))
+                {
+                    std::string map_key = signal + std::to_string(signal_conditioner_ID) + "_" + std::to_string(conditioner_port) + "_" + std::to_string(freq_channel) + "_" + std::to_string(decimation);
+                    auto it = fdma_premixers_.find(map_key);
+                    if (it == fdma_premixers_.end())
+                        {
+                            double offset_hz = static_cast<double>(freq_channel) * (signal == "1G" ? DFRQ1_GLO : DFRQ2_GLO);
+                            gr::basic_block_sptr premixer_ = gr::filter::freq_xlating_fir_filter_ccf::make(static_cast<int>(decimation), taps, offset_hz, fs);
+                            top_block_->connect(conditioner_output, conditioner_port, premixer_, 0);
+                            it = fdma_premixers_.insert(std::pair<std::string, gr::basic_block_sptr>(map_key, premixer_)).first;
+                            LOG(INFO) << "Created " << signal << " FDMA pre-mixer for RF channel " << signal_conditioner_ID
+                                      << " and frequency channel " << freq_channel << " with " << taps.size() << " taps and decimation factor of " << decimation;
+                        }
+                    port = 0;
+                    return it->second;
+                }
+        }
+
+    if (decimation < 2)
+        {
+            port = conditioner_port;
+            return conditioner_output;
+        }
+
+    // The tracking blocks of the same signal and RF channel share the integrate-and-dump
+    // pre-decimator, while their acquisition blocks keep working at the full input rate
+    std::string map_key = channels_.at(ch_index)->implementation() + std::to_string(signal_conditioner_ID) + "_" + std::to_string(conditioner_port) + "_" + std::to_string(decimation);
+    auto it = trk_decimators_.find(map_key);
+    if (it == trk_decimators_.end())
+        {
+            gr::basic_block_sptr integrate_ = gr::blocks::integrate_cc::make(static_cast<int>(decimation));
+            top_block_->connect(conditioner_output, conditioner_port, integrate_, 0);
+            it = trk_decimators_.insert(std::pair<std::string, gr::basic_block_sptr>(map_key, integrate_)).first;
+            LOG(INFO) << "Created " << channels_.at(ch_index)->implementation()
+                      << " tracking pre-decimator for RF channel " << signal_conditioner_ID << " with decimation factor of " << decimation;
+        }
+    port = 0;
+    return it->second;
+}
+
+
 void GNSSFlowgraph::disconnect()
 {
     LOG(INFO) << "Disconnecting flowgraph";
@@ -680,6 +1275,12 @@ void GNSSFlowgraph::disconnect()
             return;
         }
     connected_ = false;
+    if (!distributed_role_.empty())
+        {
+            // the UDP blocks replace a part of the blocks of a single node receiver
+            top_block_->disconnect_all();
+            return;
+        }
     // Signal Source (i) >  Signal conditioner (i) >
     int RF_Channels = 0;
     int signal_conditioner_ID = 0;
@@ -744,9 +1345,12 @@ void GNSSFlowgraph::disconnect()
             // disconnect the sample counter to Observables
             try
                 {
-                    top_block_->disconnect(sig_conditioner_.at(0)->get_right_block(), 0, ch_out_sample_counter, 0);
-                    top_block_->disconnect(ch_out_sample_counter, 0, observables_->get_left_block(), channels_count_);  // extra port for the sample counter pulse
-                }
+                    if (!shared_sample_clock_)
+                        {
+                            top_block_->disconnect(sig_conditioner_.at(0)->get_right_block(), 0, ch_out_sample_counter, 0);
+                            top_block_->disconnect(ch_out_sample_counter, 0, observables_->get_left_block(), channels_count_);  // extra port for the sample counter pulse
+                        }
+                }
             catch (const std::exception& e)
                 {
                     LOG(WARNING) << "Can't disconnect sample counter";
@@ -759,7 +1363,10 @@ void GNSSFlowgraph::disconnect()
         {
             try
                 {
-                    top_block_->disconnect(ch_out_fpga_sample_counter, 0, observables_->get_left_block(), channels_count_);
+                    if (!shared_sample_clock_)
+                        {
+                            top_block_->disconnect(ch_out_fpga_sample_counter, 0, observables_->get_left_block(), channels_count_);
+                        }
                 }
             catch (const std::exception& e)
                 {
@@ -774,8 +1381,11 @@ void GNSSFlowgraph::disconnect()
     // disconnect the sample counter to Observables
     try
         {
-            top_block_->disconnect(sig_conditioner_.at(0)->get_right_block(), 0, ch_out_sample_counter, 0);
-            top_block_->disconnect(ch_out_sample_counter, 0, observables_->get_left_block(), channels_count_);  // extra port for the sample counter pulse
+            if (!shared_sample_clock_)
+                {
+                    top_block_->disconnect(sig_conditioner_.at(0)->get_right_block(), 0, ch_out_sample_counter, 0);
+                    top_block_->disconnect(ch_out_sample_counter, 0, observables_->get_left_block(), channels_count_);  // extra port for the sample counter pulse
+                }
         }
     catch (const std::exception& e)
         {
@@ -787,6 +1397,7 @@ void GNSSFlowgraph::disconnect()
 #endif
     // Signal conditioner (selected_signal_source) >> channels (i) (dependent of their associated SignalSource_ID)
     int selected_signal_conditioner_ID;
+    std::set<gr::basic_block_sptr> shared_trk_inputs;
     for (unsigned int i = 0; i < channels_count_; i++)
         {
             try
@@ -801,8 +1412,17 @@ void GNSSFlowgraph::disconnect()
                 }
             try
                 {
-                    top_block_->disconnect(sig_conditioner_.at(selected_signal_conditioner_ID)->get_right_block(), 0,
+                    int trk_port = 0;
+                    gr::basic_block_sptr trk_input = get_trk_input_block(i, selected_signal_conditioner_ID, trk_port);
+                    top_block_->disconnect(trk_input, trk_port,
                         channels_.at(i)->get_left_block_trk(), 0);
+                    // A pre-decimator or FDMA pre-mixer is shared by several channels: disconnect it from the conditioner once
+                    gr::basic_block_sptr conditioner_output = sig_conditioner_.at(selected_signal_conditioner_ID)->get_right_block();
+                    if (trk_input != conditioner_output and shared_trk_inputs.insert(trk_input).second)
+                        {
+                            top_block_->disconnect(conditioner_output, get_conditioner_port(i, selected_signal_conditioner_ID),
+                                trk_input, 0);
+                        }
                 }
             catch (const std::exception& e)
                 {
@@ -824,12 +1444,18 @@ void GNSSFlowgraph::disconnect()
                     return;
                 }
         }
+    // the next connect() creates new pre-decimators and pre-mixers
+    trk_decimators_.clear();
+    fdma_premixers_.clear();
 
     try
         {
             for (unsigned int i = 0; i < channels_count_; i++)
                 {
-                    top_block_->disconnect(observables_->get_right_block(), i, pvt_->get_left_block(), i);
+                    if (!vector_observables_ or i == 0)
+                        {
+                            top_block_->disconnect(observables_->get_right_block(), i, pvt_->get_left_block(), i);
+                        }
                     top_block_->msg_disconnect(channels_.at(i)->get_right_block(), pmt::mp("telemetry"), pvt_->get_left_block(), pmt::mp("telemetry"));
                 }
         }
@@ -928,6 +1554,16 @@ bool GNSSFlowgraph::send_telemetry_msg(const pmt::pmt_t& msg)
 {
     // Push ephemeris to PVT telemetry msg in port using a channel out port
     // it uses the first channel as a message producer (it is already connected to PVT)
+    if (channels_.empty())
+        {
+            // a PVT node has no channels, the outputs of the channels nodes arrive through channels_receiver_
+            if (channels_receiver_ == nullptr)
+                {
+                    return false;
+                }
+            channels_receiver_->message_port_pub(pmt::mp("telemetry"), msg);
+            return true;
+        }
     channels_.at(0)->get_right_block()->message_port_pub(pmt::mp("telemetry"), msg);
     return true;
 }
@@ -958,17 +1594,33 @@ bool GNSSFlowgraph::send_telemetry_msg(const pmt::pmt_t& msg)
 void GNSSFlowgraph::apply_action(unsigned int who, unsigned int what)
 {
     std::lock_guard<std::mutex> lock(signal_list_mutex);
+    apply_action_locked(who, what);
+}
+
+
+void GNSSFlowgraph::apply_actions(const std::vector<ControlMessage>& actions)
+{
+    std::lock_guard<std::mutex> lock(signal_list_mutex);
+    for (const auto& action : actions)
+        {
+            apply_action_locked(action.who, action.what);
+        }
+}
+
+
+void GNSSFlowgraph::apply_action_locked(unsigned int who, unsigned int what)
+{
     DLOG(INFO) << "Received " << what << " from " << who << ". Number of applied actions = " << applied_actions_;
     unsigned int sat = 0;
-    if (who < 200)
+    if (who < channels_count_)
         {
-            try
-                {
-                    sat = configuration_->property("Channel" + std::to_string(who) + ".satellite", 0);
-                }
-            catch (const std::exception& e)
+            sat = channels_satellite_[who];
+            if ((what < 10) and (channels_state_[who] == 3))
                 {
-                    LOG(WARNING) << e.what();
+                    // Late event of a channel disabled in the meantime
+                    DLOG(INFO) << "Channel " << who << " is disabled, event " << what << " ignored";
+                    applied_actions_++;
+                    return;
                 }
         }
     switch (what)
@@ -1025,21 +1677,13 @@ void GNSSFlowgraph::apply_action(unsigned int who, unsigned int what)
             for (unsigned int i = 0; i < channels_count_; i++)
                 {
                     unsigned int ch_index = (who + i + 1) % channels_count_;
-                    unsigned int sat_ = 0;
-                    try
-                        {
-                            sat_ = configuration_->property("Channel" + std::to_string(ch_index) + ".satellite", 0);
-                        }
-                    catch (const std::exception& e)
-                        {
-                            LOG(WARNING) << e.what();
-                        }
-                    if ((acq_channels_count_ < max_acq_channels_) && (channels_state_[ch_index] == 0))
+                    unsigned int sat_ = channels_satellite_[ch_index];
+                    if ((acq_channels_count_ < acquisition_budget()) && (channels_state_[ch_index] == 0))
                         {
                             channels_state_[ch_index] = 1;
                             if (sat_ == 0)
                                 {
-                                    channels_[ch_index]->set_signal(search_next_signal(channels_[ch_index]->get_signal().get_signal_str(), true));
+                                    set_channel_signal(ch_index, search_next_signal(channels_[ch_index]->get_signal().get_signal_str(), true));
                                 }
                             acq_channels_count_++;
                             DLOG(INFO) << "Channel " << ch_index << " Starting acquisition " << channels_[ch_index]->get_signal().get_satellite() << ", Signal " << channels_[ch_index]->get_signal().get_signal_str();
@@ -1092,21 +1736,13 @@ void GNSSFlowgraph::apply_action(unsigned int who, unsigned int what)
             acq_channels_count_--;
             for (unsigned int i = 0; i < channels_count_; i++)
                 {
-                    unsigned int sat_ = 0;
-                    try
-                        {
-                            sat_ = configuration_->property("Channel" + std::to_string(i) + ".satellite", 0);
-                        }
-                    catch (const std::exception& e)
-                        {
-                            LOG(WARNING) << e.what();
-                        }
-                    if ((acq_channels_count_ < max_acq_channels_) && (channels_state_[i] == 0))
+                    unsigned int sat_ = channels_satellite_[i];
+                    if ((acq_channels_count_ < acquisition_budget()) && (channels_state_[i] == 0))
                         {
                             channels_state_[i] = 1;
                             if (sat_ == 0)
                                 {
-                                    channels_[i]->set_signal(search_next_signal(channels_[i]->get_signal().get_signal_str(), true, true));
+                                    set_channel_signal(i, search_next_signal(channels_[i]->get_signal().get_signal_str(), true, true));
                                 }
                             acq_channels_count_++;
                             DLOG(INFO) << "Channel " << i << " Starting acquisition " << channels_[i]->get_signal().get_satellite() << ", Signal " << channels_[i]->get_signal().get_signal_str();
@@ -1114,13 +1750,15 @@ void GNSSFlowgraph::apply_action(unsigned int who, unsigned int what)
                         }
                     DLOG(INFO) << "Channel " << i << " in state " << channels_state_[i];
                 }
+            // The new tracking channel may leave less room for acquisitions
+            preempt_acquisitions();
             break;
 
         case 2:
             LOG(INFO) << "Channel " << who << " TRK FAILED satellite " << channels_[who]->get_signal().get_satellite();
             DLOG(INFO) << "Number of channels in acquisition = " << acq_channels_count_;
 
-            if (acq_channels_count_ < max_acq_channels_)
+            if (acq_channels_count_ < acquisition_budget())
                 {
                     channels_state_[who] = 1;
                     acq_channels_count_++;
@@ -1232,21 +1870,13 @@ void GNSSFlowgraph::apply_action(unsigned int who, unsigned int what)
             for (unsigned int i = 0; i < channels_count_; i++)
                 {
                     unsigned int ch_index = (who + i + 1) % channels_count_;
-                    unsigned int sat_ = 0;
-                    try
-                        {
-                            sat_ = configuration_->property("Channel" + std::to_string(ch_index) + ".satellite", 0);
-                        }
-                    catch (const std::exception& e)
-                        {
-                            LOG(WARNING) << e.what();
-                        }
-                    if ((acq_channels_count_ < max_acq_channels_) && (channels_state_[ch_index] == 0))
+                    unsigned int sat_ = channels_satellite_[ch_index];
+                    if ((acq_channels_count_ < acquisition_budget()) && (channels_state_[ch_index] == 0))
                         {
                             channels_state_[ch_index] = 1;
                             if (sat_ == 0)
                                 {
-                                    channels_[ch_index]->set_signal(search_next_signal(channels_[ch_index]->get_signal().get_signal_str(), true));
+                                    set_channel_signal(ch_index, search_next_signal(channels_[ch_index]->get_signal().get_signal_str(), true));
                                 }
                             acq_channels_count_++;
                             DLOG(INFO) << "Channel " << ch_index << " Starting acquisition " << channels_[ch_index]->get_signal().get_satellite() << ", Signal " << channels_[ch_index]->get_signal().get_signal_str();
@@ -1260,21 +1890,13 @@ void GNSSFlowgraph::apply_action(unsigned int who, unsigned int what)
             for (unsigned int i = 0; i < channels_count_; i++)
                 {
                     unsigned int ch_index = (who + i + 1) % channels_count_;
-                    unsigned int sat_ = 0;
-                    try
-                        {
-                            sat_ = configuration_->property("Channel" + std::to_string(ch_index) + ".satellite", 0);
-                        }
-                    catch (const std::exception& e)
-                        {
-                            LOG(WARNING) << e.what();
-                        }
-                    if ((acq_channels_count_ < max_acq_channels_) && (channels_state_[ch_index] == 0))
+                    unsigned int sat_ = channels_satellite_[ch_index];
+                    if ((acq_channels_count_ < acquisition_budget()) && (channels_state_[ch_index] == 0))
                         {
                             channels_state_[ch_index] = 1;
                             if (sat_ == 0)
                                 {
-                                    channels_[ch_index]->set_signal(search_next_signal(channels_[ch_index]->get_signal().get_signal_str(), true));
+                                    set_channel_signal(ch_index, search_next_signal(channels_[ch_index]->get_signal().get_signal_str(), true));
                                 }
                             acq_channels_count_++;
                             DLOG(INFO) << "Channel " << ch_index << " Starting acquisition " << channels_[ch_index]->get_signal().get_satellite() << ", Signal " << channels_[ch_index]->get_signal().get_signal_str();
@@ -1289,21 +1911,13 @@ void GNSSFlowgraph::apply_action(unsigned int who, unsigned int what)
             for (unsigned int i = 0; i < channels_count_; i++)
                 {
                     unsigned int ch_index = (who + i + 1) % channels_count_;
-                    unsigned int sat_ = 0;
-                    try
-                        {
-                            sat_ = configuration_->property("Channel" + std::to_string(ch_index) + ".satellite", 0);
-                        }
-                    catch (const std::exception& e)
-                        {
-                            LOG(WARNING) << e.what();
-                        }
-                    if ((acq_channels_count_ < max_acq_channels_) && (channels_state_[ch_index] == 0))
+                    unsigned int sat_ = channels_satellite_[ch_index];
+                    if ((acq_channels_count_ < acquisition_budget()) && (channels_state_[ch_index] == 0))
                         {
                             channels_state_[ch_index] = 1;
                             if (sat_ == 0)
                                 {
-                                    channels_[ch_index]->set_signal(search_next_signal(channels_[ch_index]->get_signal().get_signal_str(), true));
+                                    set_channel_signal(ch_index, search_next_signal(channels_[ch_index]->get_signal().get_signal_str(), true));
                                 }
                             acq_channels_count_++;
                             DLOG(INFO) << "Channel " << ch_index << " Starting acquisition " << channels_[ch_index]->get_signal().get_satellite() << ", Signal " << channels_[ch_index]->get_signal().get_signal_str();
@@ -1321,32 +1935,27 @@ void GNSSFlowgraph::apply_action(unsigned int who, unsigned int what)
 
 void GNSSFlowgraph::priorize_satellites(std::vector<std::pair<int, Gnss_Satellite>> visible_satellites)
 {
-    size_t old_size;
+    // the control thread may re-prioritize while the channels request signals
+    std::lock_guard<std::mutex> lock(signal_list_mutex);
     Gnss_Signal gs;
     for (std::vector<std::pair<int, Gnss_Satellite>>::iterator it = visible_satellites.begin(); it != visible_satellites.end(); ++it)
         {
             if (it->second.get_system() == "GPS")
                 {
                     gs = Gnss_Signal(it->second, "1C");
-                    old_size = available_GPS_1C_signals_.size();
-                    available_GPS_1C_signals_.remove(gs);
-                    if (old_size > available_GPS_1C_signals_.size())
+                    if (available_GPS_1C_signals_.remove(gs))
                         {
                             available_GPS_1C_signals_.push_front(gs);
                         }
 
                     gs = Gnss_Signal(it->second, "2S");
-                    old_size = available_GPS_2S_signals_.size();
-                    available_GPS_2S_signals_.remove(gs);
-                    if (old_size > available_GPS_2S_signals_.size())
+                    if (available_GPS_2S_signals_.remove(gs))
                         {
                             available_GPS_2S_signals_.push_front(gs);
                         }
 
                     gs = Gnss_Signal(it->second, "L5");
-                    old_size = available_GPS_L5_signals_.size();
-                    available_GPS_L5_signals_.remove(gs);
-                    if (old_size > available_GPS_L5_signals_.size())
+                    if (available_GPS_L5_signals_.remove(gs))
                         {
                             available_GPS_L5_signals_.push_front(gs);
                         }
@@ -1354,17 +1963,13 @@ void GNSSFlowgraph::priorize_satellites(std::vector<std::pair<int, Gnss_Satellit
             else if (it->second.get_system() == "Galileo")
                 {
                     gs = Gnss_Signal(it->second, "1B");
-                    old_size = available_GAL_1B_signals_.size();
-                    available_GAL_1B_signals_.remove(gs);
-                    if (old_size > available_GAL_1B_signals_.size())
+                    if (available_GAL_1B_signals_.remove(gs))
                         {
                             available_GAL_1B_signals_.push_front(gs);
                         }
 
                     gs = Gnss_Signal(it->second, "5X");
-                    old_size = available_GAL_5X_signals_.size();
-                    available_GAL_5X_signals_.remove(gs);
-                    if (old_size > available_GAL_5X_signals_.size())
+                    if (available_GAL_5X_signals_.remove(gs))
                         {
                             available_GAL_5X_signals_.push_front(gs);
                         }
@@ -1373,190 +1978,987 @@ void GNSSFlowgraph::priorize_satellites(std::vector<std::pair<int, Gnss_Satellit
 }
 
 
-void GNSSFlowgraph::set_configuration(std::shared_ptr<ConfigurationInterface> configuration)
+unsigned int GNSSFlowgraph::acquisition_budget()
 {
-    if (running_)
+    if (acquisitions_suspended_)
         {
-            LOG(WARNING) << "Unable to update configuration while flowgraph running";
-            return;
+            return 0;
         }
-    if (connected_)
+    if (acq_load_per_tracking_channel_ <= 0.0)
         {
-            LOG(WARNING) << "Unable to update configuration while flowgraph connected";
+            return max_acq_channels_;
         }
-    configuration_ = configuration;
+    // Each channel in tracking takes a share of the CPU otherwise available for acquisition
+    unsigned int tracking_channels = std::count(channels_state_.begin(), channels_state_.end(), 2);
+    double budget = static_cast<double>(max_acq_channels_) - std::floor(static_cast<double>(tracking_channels) * acq_load_per_tracking_channel_);
+    return static_cast<unsigned int>(std::max(budget, static_cast<double>(std::min(min_acq_channels_, max_acq_channels_))));
 }
 
 
-void GNSSFlowgraph::start_acquisition_helper()
+void GNSSFlowgraph::preempt_acquisitions()
 {
-    for (unsigned int i = 0; i < channels_count_; i++)
+    unsigned int budget = acquisition_budget();
+    for (unsigned int n = channels_count_; (n > 0) and (acq_channels_count_ > budget); n--)
         {
-            if (channels_state_[i] == 1)
+            unsigned int ch_index = n - 1;
+            if (channels_state_[ch_index] != 1)
                 {
-                    channels_.at(i)->start_acquisition();
+                    continue;
+                }
+            unsigned int sat = channels_satellite_[ch_index];
+            LOG(INFO) << "Channel " << ch_index << " acquisition preempted by tracking load, satellite " << channels_[ch_index]->get_signal().get_satellite();
+            channels_[ch_index]->stop_channel();
+            channels_state_[ch_index] = 0;
+            acq_channels_count_--;
+            if (sat == 0)
+                {
+                    // Keep its priority: it will be the next one to be searched
+                    Gnss_Signal_Pool* available_signals = available_signals_list(channels_[ch_index]->get_signal().get_signal_str());
+                    if (available_signals != nullptr)
+                        {
+                            available_signals->remove(channels_[ch_index]->get_signal());
+                            available_signals->push_front(channels_[ch_index]->get_signal());
+                        }
                 }
         }
 }
 
 
-void GNSSFlowgraph::init()
+Gnss_Signal_Pool* GNSSFlowgraph::available_signals_list(const std::string& signal)
 {
-    /*
-     * Instantiates the receiver blocks
-     */
-    std::unique_ptr<GNSSBlockFactory> block_factory_(new GNSSBlockFactory());
-
-    // 1. read the number of RF front-ends available (one file_source per RF front-end)
-    sources_count_ = configuration_->property("Receiver.sources_count", 1);
+    switch (mapStringValues_[signal])
+        {
+        case evGPS_1C:
+            return &available_GPS_1C_signals_;
+        case evGPS_2S:
+            return &available_GPS_2S_signals_;
+        case evGPS_L5:
+            return &available_GPS_L5_signals_;
+        case evSBAS_1C:
+            return &available_SBAS_1C_signals_;
+        case evGAL_1B:
+            return &available_GAL_1B_signals_;
+        case evGAL_5X:
+            return &available_GAL_5X_signals_;
+        case evGLO_1G:
+            return &available_GLO_1G_signals_;
+        case evGLO_2G:
+            return &available_GLO_2G_signals_;
+        default:
+            return nullptr;
+        }
+}
 
-    int RF_Channels = 0;
-    int signal_conditioner_ID = 0;
 
-    if (sources_count_ > 1)
+bool GNSSFlowgraph::set_active_channels(const std::string& signal, unsigned int active)
+{
+    std::lock_guard<std::mutex> lock(signal_list_mutex);
+    std::vector<unsigned int> band;
+    unsigned int enabled = 0;
+    for (unsigned int i = 0; i < channels_count_; i++)
         {
-            for (int i = 0; i < sources_count_; i++)
+            if (channels_[i]->get_signal().get_signal_str() == signal)
                 {
-                    std::cout << "Creating source " << i << std::endl;
-                    sig_source_.push_back(block_factory_->GetSignalSource(configuration_, queue_, i));
-                    // TODO: Create a class interface for SignalSources, derived from GNSSBlockInterface.
-                    // Include GetRFChannels in the interface to avoid read config parameters here
-                    // read the number of RF channels for each front-end
-                    RF_Channels = configuration_->property(sig_source_.at(i)->role() + ".RF_channels", 1);
-                    std::cout << "RF Channels " << RF_Channels << std::endl;
-                    for (int j = 0; j < RF_Channels; j++)
+                    band.push_back(i);
+                    if (channels_state_[i] != 3)
                         {
-                            sig_conditioner_.push_back(block_factory_->GetSignalConditioner(configuration_, signal_conditioner_ID));
-                            signal_conditioner_ID++;
+                            enabled++;
                         }
                 }
         }
-    else
+    if (band.empty())
         {
-            // backwards compatibility for old config files
-            sig_source_.push_back(block_factory_->GetSignalSource(configuration_, queue_, -1));
-            // TODO: Create a class interface for SignalSources, derived from GNSSBlockInterface.
-            // Include GetRFChannels in the interface to avoid read config parameters here
-            // read the number of RF channels for each front-end
-            RF_Channels = configuration_->property(sig_source_.at(0)->role() + ".RF_channels", 0);
-            if (RF_Channels != 0)
-                {
-                    for (int j = 0; j < RF_Channels; j++)
-                        {
-                            sig_conditioner_.push_back(block_factory_->GetSignalConditioner(configuration_, signal_conditioner_ID));
-                            signal_conditioner_ID++;
-                        }
-                }
-            else
-                {
-                    // old config file, single signal source and single channel, not specified
-                    sig_conditioner_.push_back(block_factory_->GetSignalConditioner(configuration_, -1));
-                }
+            LOG(WARNING) << "There are no channels for signal " << signal;
+            return false;
         }
-
-    observables_ = block_factory_->GetObservables(configuration_);
-    // Mark old implementations as deprecated
-    std::string default_str("Default");
-    std::string obs_implementation = configuration_->property("Observables.implementation", default_str);
-    if ((obs_implementation == "GPS_L1_CA_Observables") || (obs_implementation == "GPS_L2C_Observables") ||
-        (obs_implementation == "Galileo_E1B_Observables") || (obs_implementation == "Galileo_E5A_Observables"))
+    if (active > band.size())
         {
-            std::cout << "WARNING: Implementation '" << obs_implementation << "' of the Observables block has been replaced by 'Hybrid_Observables'." << std::endl;
-            std::cout << "Please update your configuration file." << std::endl;
+            LOG(WARNING) << "Only " << band.size() << " channels are available for signal " << signal;
+            active = band.size();
         }
 
-    pvt_ = block_factory_->GetPVT(configuration_);
-    // Mark old implementations as deprecated
-    std::string pvt_implementation = configuration_->property("PVT.implementation", default_str);
-    if ((pvt_implementation == "GPS_L1_CA_PVT") || (pvt_implementation == "Galileo_E1_PVT") || (pvt_implementation == "Hybrid_PVT"))
+    // Enable the spare channels with the lowest index
+    for (unsigned int n = 0; (n < band.size()) and (enabled < active); n++)
         {
-            std::cout << "WARNING: Implementation '" << pvt_implementation << "' of the PVT block has been replaced by 'RTKLIB_PVT'." << std::endl;
-            std::cout << "Please update your configuration file." << std::endl;
+            if (channels_state_[band[n]] == 3)
+                {
+                    channels_state_[band[n]] = 0;
+                    shed_channels_.erase(std::remove(shed_channels_.begin(), shed_channels_.end(), band[n]), shed_channels_.end());
+                    enabled++;
+                    LOG(INFO) << "Channel " << band[n] << " enabled";
+                }
         }
 
-    std::shared_ptr<std::vector<std::unique_ptr<GNSSBlockInterface>>> channels = block_factory_->GetChannels(configuration_, queue_);
-
-    channels_count_ = channels->size();
-    for (unsigned int i = 0; i < channels_count_; i++)
+    // Disable the idle channels first, then those in acquisition, and the ones in tracking last
+    for (unsigned int state = 0; (state < 3) and (enabled > active); state++)
         {
-            std::shared_ptr<GNSSBlockInterface> chan_ = std::move(channels->at(i));
-            channels_.push_back(std::dynamic_pointer_cast<ChannelInterface>(chan_));
+            for (unsigned int n = band.size(); (n > 0) and (enabled > active); n--)
+                {
+                    unsigned int ch_index = band[n - 1];
+                    if (channels_state_[ch_index] != state)
+                        {
+                            continue;
+                        }
+                    if (state != 0)
+                        {
+                            channels_[ch_index]->stop_channel();
+                            if (channels_satellite_[ch_index] == 0)
+                                {
+                                    // Its satellite will be the next one to be searched in the remaining channels
+                                    Gnss_Signal_Pool* available_signals = available_signals_list(signal);
+                                    if (available_signals != nullptr)
+                                        {
+                                            available_signals->remove(channels_[ch_index]->get_signal());
+                                            available_signals->push_front(channels_[ch_index]->get_signal());
+                                        }
+                                }
+                        }
+                    if (state == 1)
+                        {
+                            acq_channels_count_--;
+                        }
+                    channels_state_[ch_index] = 3;
+                    enabled--;
+                    LOG(INFO) << "Channel " << ch_index << " disabled";
+                }
         }
 
-    top_block_ = gr::make_top_block("GNSSFlowgraph");
-
-    mapStringValues_["1C"] = evGPS_1C;
-    mapStringValues_["2S"] = evGPS_2S;
-    mapStringValues_["L5"] = evGPS_L5;
-    mapStringValues_["1B"] = evGAL_1B;
-    mapStringValues_["5X"] = evGAL_5X;
-    mapStringValues_["1G"] = evGLO_1G;
-    mapStringValues_["2G"] = evGLO_2G;
-
-    // fill the signals queue with the satellites ID's to be searched by the acquisition
-    set_signals_list();
-    set_channels_state();
-    applied_actions_ = 0;
-    DLOG(INFO) << "Blocks instantiated. " << channels_count_ << " channels.";
-
-    /*
-	 * Instantiate the receiver monitor block, if required
-	 */
-    enable_monitor_ = configuration_->property("Monitor.enable_monitor", false);
+    // Use the freed acquisition budget, or give it back if there is no room
+    start_idle_acquisitions();
+    preempt_acquisitions();
+    return true;
+}
 
-    std::string address_string = configuration_->property("Monitor.client_addresses", std::string("127.0.0.1"));
-    std::vector<std::string> udp_addr_vec = split_string(address_string, '_');
-    std::sort(udp_addr_vec.begin(), udp_addr_vec.end());
-    udp_addr_vec.erase(std::unique(udp_addr_vec.begin(), udp_addr_vec.end()), udp_addr_vec.end());
 
-    if (enable_monitor_)
+void GNSSFlowgraph::start_idle_acquisitions()
+{
+    for (unsigned int i = 0; i < channels_count_; i++)
         {
-            GnssSynchroMonitor_ = gr::basic_block_sptr(new gnss_synchro_monitor(channels_count_,
-                configuration_->property("Monitor.output_rate_ms", 1),
-                configuration_->property("Monitor.udp_port", 1234),
-                udp_addr_vec));
+            if ((acq_channels_count_ < acquisition_budget()) && (channels_state_[i] == 0))
+                {
+                    channels_state_[i] = 1;
+                    if (channels_satellite_[i] == 0)
+                        {
+                            set_channel_signal(i, search_next_signal(channels_[i]->get_signal().get_signal_str(), true));
+                        }
+                    acq_channels_count_++;
+                    DLOG(INFO) << "Channel " << i << " Starting acquisition " << channels_[i]->get_signal().get_satellite() << ", Signal " << channels_[i]->get_signal().get_signal_str();
+                    channels_[i]->start_acquisition();
+                }
         }
 }
 
 
-void GNSSFlowgraph::set_signals_list()
+void GNSSFlowgraph::overload_watchdog()
 {
-    // Set a sequential list of GNSS satellites
-    std::set<unsigned int>::const_iterator available_gnss_prn_iter;
-
-    // Create the lists of GNSS satellites
-    std::set<unsigned int> available_gps_prn = {1, 2, 3, 4, 5, 6, 7, 8, 9, 10,
-        11, 12, 13, 14, 15, 16, 17, 18, 19, 20, 21, 22, 23, 24, 25, 26, 27, 28,
-        29, 30, 31, 32};
+    // With a live signal source, the samples that the receiver can not process in time are lost
+    // before reaching the sample counter, so it falls behind the wall clock
+    const double fs = configuration_->property("GNSS-SDR.internal_fs_sps", 0.0);
+    uint64_t last_samples = 0;
+    std::chrono::steady_clock::time_point last_check;
+    bool first_check = true;  // skip the startup transient
+    int checks_without_overload = 0;
+    std::unique_lock<std::mutex> lock(overload_watchdog_mutex_);
+    while (!overload_watchdog_condition_.wait_for(lock, std::chrono::milliseconds(overload_check_interval_ms_), [this] { return overload_watchdog_stop_; }))
+        {
+            uint64_t samples = shared_sample_clock_ ? Gnss_Sdr_Sample_Clock::get_instance()->samples() : ch_out_sample_counter->nitems_read(0);
+            std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+            if (!first_check)
+                {
+                    double elapsed_s = std::chrono::duration<double>(now - last_check).count();
+                    double deficit = 1.0 - static_cast<double>(samples - last_samples) / (fs * elapsed_s);
+                    if (deficit > overload_max_deficit_)
+                        {
+                            checks_without_overload = 0;
+                            shed_load(deficit);
+                        }
+                    else if ((deficit < overload_max_deficit_ / 2.0) and (++checks_without_overload >= overload_recovery_checks_))
+                        {
+                            checks_without_overload = 0;
+                            restore_load();
+                        }
+                }
+            first_check = false;
+            last_samples = samples;
+            last_check = now;
+        }
+}
 
-    std::set<unsigned int> available_sbas_prn = {123, 131, 135, 136, 138};
 
-    std::set<unsigned int> available_galileo_prn = {1, 2, 3, 4, 5, 6, 7, 8, 9, 10,
-        11, 12, 13, 14, 15, 16, 17, 18, 19, 20, 21, 22, 23, 24, 25, 26, 27, 28,
-        29, 30, 31, 32, 33, 34, 35, 36};
+void GNSSFlowgraph::stop_overload_watchdog()
+{
+    if (!overload_watchdog_thread_.joinable())
+        {
+            return;
+        }
+    {
+        std::lock_guard<std::mutex> lock(overload_watchdog_mutex_);
+        overload_watchdog_stop_ = true;
+    }
+    overload_watchdog_condition_.notify_one();
+    overload_watchdog_thread_.join();
+}
 
-    // Removing satellites sharing same frequency number(1 and 5, 2 and 6, 3 and 7, 4 and 6, 11 and 15, 12 and 16, 14 and 18, 17 and 21
-    std::set<unsigned int> available_glonass_prn = {1, 2, 3, 4, 9, 10, 11, 12, 18, 19, 20, 21, 24};
 
-    std::string sv_list = configuration_->property("Galileo.prns", std::string(""));
+void GNSSFlowgraph::shed_load(double deficit)
+{
+    std::lock_guard<std::mutex> lock(signal_list_mutex);
+    std::stringstream overload;
+    overload << "Receiver overloaded (" << std::round(deficit * 100.0) << " % of the samples lost)";
 
-    if (sv_list.length() > 0)
+    // 1. stop searching for new satellites
+    if (!acquisitions_suspended_)
         {
-            // Reset the available prns:
-            std::set<unsigned int> tmp_set;
-            boost::tokenizer<> tok(sv_list);
-            std::transform(tok.begin(), tok.end(), std::inserter(tmp_set, tmp_set.begin()),
-                boost::lexical_cast<unsigned int, std::string>);
-
-            if (tmp_set.size() > 0)
-                {
-                    available_galileo_prn = tmp_set;
-                }
+            acquisitions_suspended_ = true;
+            preempt_acquisitions();
+            LOG(WARNING) << overload.str() << ": acquisitions suspended";
+            std::cout << overload.str() << ": acquisitions suspended" << std::endl;
+            return;
         }
 
-    sv_list = configuration_->property("GPS.prns", std::string(""));
-
-    if (sv_list.length() > 0)
+    // 2. disable the channel tracking the weakest signal
+    unsigned int tracking_channels = std::count(channels_state_.begin(), channels_state_.end(), 2);
+    if (tracking_channels > overload_min_channels_)
+        {
+            std::map<std::tuple<char, uint32_t, std::string>, Gnss_Tracking_State> states = state_registry_->get_states(10.0);
+            unsigned int weakest = channels_count_;
+            double weakest_cn0 = std::numeric_limits<double>::max();
+            for (unsigned int i = 0; i < channels_count_; i++)
+                {
+                    if (channels_state_[i] != 2)
+                        {
+                            continue;
+                        }
+                    Gnss_Signal signal = channels_[i]->get_signal();
+                    auto state = states.find(std::make_tuple(signal.get_satellite().get_system_short().at(0), signal.get_satellite().get_PRN(), signal.get_signal_str()));
+                    double cn0 = (state == states.end()) ? 0.0 : state->second.cn0_db_hz;  // no recent update: losing lock
+                    if (cn0 < weakest_cn0)
+                        {
+                            weakest = i;
+                            weakest_cn0 = cn0;
+                        }
+                }
+            Gnss_Signal signal = channels_[weakest]->get_signal();
+            channels_[weakest]->stop_channel();
+            channels_state_[weakest] = 3;
+            shed_channels_.push_back(weakest);
+            state_registry_->remove(signal.get_satellite().get_system_short().at(0), signal.get_satellite().get_PRN(), signal.get_signal_str());
+            if (channels_satellite_[weakest] == 0)
+                {
+                    // It can be searched again when the load is restored
+                    Gnss_Signal_Pool* available_signals = available_signals_list(signal.get_signal_str());
+                    if (available_signals != nullptr)
+                        {
+                            available_signals->remove(signal);
+                            available_signals->push_back(signal);
+                        }
+                }
+            LOG(WARNING) << overload.str() << ": channel " << weakest << " disabled, " << signal.get_satellite() << " " << signal.get_signal_str() << " CN0 " << weakest_cn0 << " dB-Hz";
+            std::cout << overload.str() << ": channel " << weakest << " disabled (" << signal.get_satellite() << ", CN0 " << std::round(weakest_cn0) << " dB-Hz)" << std::endl;
+            return;
+        }
+
+    // 3. stop writing the optional position outputs
+    std::shared_ptr<PvtInterface> pvt = std::dynamic_pointer_cast<PvtInterface>(pvt_);
+    if (!position_outputs_suspended_ and (pvt != nullptr))
+        {
+            position_outputs_suspended_ = true;
+            pvt->suspend_position_outputs(true);
+            LOG(WARNING) << overload.str() << ": KML, GPX, GeoJSON and NMEA outputs suspended";
+            std::cout << overload.str() << ": KML, GPX, GeoJSON and NMEA outputs suspended" << std::endl;
+            return;
+        }
+    DLOG(INFO) << overload.str() << ": no more load to shed";
+}
+
+
+void GNSSFlowgraph::restore_load()
+{
+    std::lock_guard<std::mutex> lock(signal_list_mutex);
+    if (position_outputs_suspended_)
+        {
+            position_outputs_suspended_ = false;
+            std::dynamic_pointer_cast<PvtInterface>(pvt_)->suspend_position_outputs(false);
+            LOG(INFO) << "Receiver load reduced: KML, GPX, GeoJSON and NMEA outputs resumed";
+            std::cout << "Receiver load reduced: KML, GPX, GeoJSON and NMEA outputs resumed" << std::endl;
+            return;
+        }
+    if (!shed_channels_.empty())
+        {
+            unsigned int ch_index = shed_channels_.back();
+            shed_channels_.pop_back();
+            if (channels_state_[ch_index] == 3)
+                {
+                    channels_state_[ch_index] = 0;  // it starts acquiring when the acquisitions are resumed
+                }
+            LOG(INFO) << "Receiver load reduced: channel " << ch_index << " enabled";
+            std::cout << "Receiver load reduced: channel " << ch_index << " enabled" << std::endl;
+            return;
+        }
+    if (acquisitions_suspended_)
+        {
+            acquisitions_suspended_ = false;
+            start_idle_acquisitions();
+            LOG(INFO) << "Receiver load reduced: acquisitions resumed";
+            std::cout << "Receiver load reduced: acquisitions resumed" << std::endl;
+        }
+}
+
+
+std::vector<std::tuple<std::string, std::string, gr::block_sptr>> GNSSFlowgraph::monitored_blocks()
+{
+    std::vector<std::tuple<std::string, std::string, gr::block_sptr>> blocks;
+    auto add_block = [&blocks](const std::string& type, const std::string& id, const gr::basic_block_sptr& basic_block) {
+        gr::block_sptr block = boost::dynamic_pointer_cast<gr::block>(basic_block);
+        if (block != nullptr)
+            {
+                blocks.emplace_back(type, "block=\"" + type + "\"" + id, block);
+            }
+    };
+    for (unsigned int i = 0; i < sig_source_.size(); i++)
+        {
+            add_block("signal_source", ",id=\"" + std::to_string(i) + "\"", sig_source_[i]->get_right_block());
+        }
+    for (unsigned int i = 0; i < sig_conditioner_.size(); i++)
+        {
+            add_block("signal_conditioner", ",id=\"" + std::to_string(i) + "\"", sig_conditioner_[i]->get_right_block());
+        }
+    for (unsigned int i = 0; i < channels_count_; i++)
+        {
+            const std::string channel = ",channel=\"" + std::to_string(i) + "\"";
+            add_block("acquisition", channel, channels_[i]->get_left_block_acq());
+            add_block("tracking", channel, channels_[i]->get_left_block_trk());
+            add_block("telemetry_decoder", channel, channels_[i]->get_right_block());
+        }
+    if (observables_ != nullptr)
+        {
+            add_block("observables", "", observables_->get_left_block());
+        }
+    if (pvt_ != nullptr)
+        {
+            add_block("pvt", "", pvt_->get_left_block());
+        }
+    return blocks;
+}
+
+
+std::map<std::string, double> GNSSFlowgraph::get_startup_times()
+{
+    return startup_times_s_;
+}
+
+
+std::map<std::string, double> GNSSFlowgraph::get_work_time_per_block_type()
+{
+    std::map<std::string, double> work_time;
+    for (const auto& block : monitored_blocks())
+        {
+            work_time[std::get<0>(block)] += std::get<2>(block)->pc_work_time_total() / static_cast<double>(gr::high_res_timer_tps());
+        }
+    return work_time;
+}
+
+
+void GNSSFlowgraph::apply_memory_policy()
+{
+    if (!configuration_->property("GNSS-SDR.use_hugepages", false) and (configuration_->property("GNSS-SDR.numa_node", -1) < 0))
+        {
+            return;
+        }
+    // GNU Radio maps its buffers when the flow graph starts. Their pages are
+    // mapped twice (so that they wrap around), and a window of the size of
+    // the buffer starting anywhere covers each of them once
+    for (const auto& block : monitored_blocks())
+        {
+            gr::block_detail_sptr detail = std::get<2>(block)->detail();
+            if (detail == nullptr)
+                {
+                    continue;
+                }
+            for (int i = 0; i < detail->noutputs(); i++)
+                {
+                    size_t bytes = static_cast<size_t>(detail->output(i)->bufsize()) * std::get<2>(block)->output_signature()->sizeof_stream_item(i);
+                    gnss_sdr_apply_memory_policy(detail->output(i)->write_pointer(), bytes);
+                }
+        }
+    std::string report = gnss_sdr_memory_policy_report();
+    LOG(INFO) << report;
+    std::cout << report << std::endl;
+}
+
+
+std::string GNSSFlowgraph::get_memory_report()
+{
+    std::map<std::string, std::map<std::string, size_t>> buffer_bytes;
+    for (const auto& block : monitored_blocks())
+        {
+            gr::block_detail_sptr detail = std::get<2>(block)->detail();
+            if (detail == nullptr)
+                {
+                    continue;
+                }
+            size_t bytes = 0;
+            for (int i = 0; i < detail->noutputs(); i++)
+                {
+                    bytes += static_cast<size_t>(detail->output(i)->bufsize()) * std::get<2>(block)->output_signature()->sizeof_stream_item(i);
+                }
+            buffer_bytes[std::get<1>(block)]["gr_buffers"] += bytes;
+        }
+    std::string policy = gnss_sdr_memory_policy_report();
+    return Gnss_Memory_Accounting::get_instance()->report(buffer_bytes) + (policy.empty() ? "" : policy + "\n");
+}
+
+
+std::string GNSSFlowgraph::get_metrics()
+{
+    std::vector<std::pair<std::string, gr::block_sptr>> blocks;
+    for (const auto& block : monitored_blocks())
+        {
+            blocks.emplace_back(std::get<1>(block), std::get<2>(block));
+        }
+
+    std::stringstream metrics;
+    metrics << "# TYPE gnss_sdr_block_items_read counter\n";
+    for (const auto& block : blocks)
+        {
+            if (block.second->input_signature()->max_streams() != 0)
+                {
+                    metrics << "gnss_sdr_block_items_read_total{" << block.first << "} " << block.second->nitems_read(0) << "\n";
+                }
+        }
+    metrics << "# TYPE gnss_sdr_block_items_written counter\n";
+    for (const auto& block : blocks)
+        {
+            if (block.second->output_signature()->max_streams() != 0)
+                {
+                    metrics << "gnss_sdr_block_items_written_total{" << block.first << "} " << block.second->nitems_written(0) << "\n";
+                }
+        }
+    metrics << "# TYPE gnss_sdr_block_work_time_seconds gauge\n";
+    for (const auto& block : blocks)
+        {
+            metrics << "gnss_sdr_block_work_time_seconds{" << block.first << "} " << block.second->pc_work_time_avg() / static_cast<double>(gr::high_res_timer_tps()) << "\n";
+        }
+    metrics << "# TYPE gnss_sdr_block_input_buffer_full_ratio gauge\n";
+    for (const auto& block : blocks)
+        {
+            if (block.second->input_signature()->max_streams() != 0)
+                {
+                    metrics << "gnss_sdr_block_input_buffer_full_ratio{" << block.first << "} " << block.second->pc_input_buffers_full(0) << "\n";
+                }
+        }
+    metrics << Gnss_Metrics::get_instance()->to_openmetrics(state_registry_);
+    metrics << "# EOF\n";
+    return metrics.str();
+}
+
+
+void GNSSFlowgraph::set_predicted_range_rates(const std::map<std::pair<std::string, uint32_t>, double>& range_rates)
+{
+    std::lock_guard<std::mutex> lock(signal_list_mutex);
+    predicted_range_rates_ = range_rates;
+}
+
+
+void GNSSFlowgraph::set_channel_signal(unsigned int ch_index, const Gnss_Signal& signal)
+{
+    // Doppler shift predicted from the satellite range rate, if available
+    double doppler_hz = 0.0;
+    double uncertainty_hz = 0.0;
+    auto range_rate = predicted_range_rates_.find(std::make_pair(signal.get_satellite().get_system(), signal.get_satellite().get_PRN()));
+    if ((range_rate != predicted_range_rates_.end()) and (doppler_aiding_uncertainty_hz_ > 0.0))
+        {
+            double carrier_freq_hz = 0.0;
+            switch (mapStringValues_[signal.get_signal_str()])
+                {
+                case evGPS_1C:
+                    carrier_freq_hz = GPS_L1_FREQ_HZ;
+                    break;
+                case evGPS_2S:
+                    carrier_freq_hz = GPS_L2_FREQ_HZ;
+                    break;
+                case evGPS_L5:
+                    carrier_freq_hz = GPS_L5_FREQ_HZ;
+                    break;
+                case evGAL_1B:
+                    carrier_freq_hz = Galileo_E1_FREQ_HZ;
+                    break;
+                case evGAL_5X:
+                    carrier_freq_hz = Galileo_E5a_FREQ_HZ;
+                    break;
+                default:
+                    break;
+                }
+            if (carrier_freq_hz > 0.0)
+                {
+                    doppler_hz = -range_rate->second * carrier_freq_hz / GPS_C_m_s;
+                    uncertainty_hz = doppler_aiding_uncertainty_hz_;
+                }
+        }
+
+    // The Doppler shift of the same satellite in tracking in the first band is much closer
+    std::string reference_signal;
+    switch (mapStringValues_[signal.get_signal_str()])
+        {
+        case evGPS_2S:
+        case evGPS_L5:
+            reference_signal = "1C";
+            break;
+        case evGAL_5X:
+            reference_signal = "1B";
+            break;
+        default:
+            break;
+        }
+    Gnss_Tracking_State reference_state;
+    if ((cross_band_uncertainty_hz_ > 0.0) and !reference_signal.empty() and
+        state_registry_->find(signal.get_satellite().get_system_short().c_str()[0], signal.get_satellite().get_PRN(), reference_signal, 1.0, reference_state))
+        {
+            double carrier_freq_hz = 0.0;
+            switch (mapStringValues_[signal.get_signal_str()])
+                {
+                case evGPS_2S:
+                    carrier_freq_hz = GPS_L2_FREQ_HZ;
+                    break;
+                case evGPS_L5:
+                    carrier_freq_hz = GPS_L5_FREQ_HZ;
+                    break;
+                default:
+                    carrier_freq_hz = Galileo_E5a_FREQ_HZ;
+                    break;
+                }
+            doppler_hz = reference_state.carrier_doppler_hz * carrier_freq_hz / reference_state.carrier_freq_hz;
+            uncertainty_hz = cross_band_uncertainty_hz_;
+            DLOG(INFO) << "Channel " << ch_index << ": " << signal << " aided by " << reference_signal << " tracking, Doppler " << doppler_hz << " Hz";
+        }
+    channels_.at(ch_index)->set_doppler_aiding(doppler_hz, uncertainty_hz);
+
+    // Count the channels assigned to each satellite in each band, for search_next_signal()
+    Gnss_Signal old_signal = channels_.at(ch_index)->get_signal();
+    uint32_t prn = old_signal.get_satellite().get_PRN();
+    std::vector<uint16_t>& old_band = assigned_channels_[mapStringValues_[old_signal.get_signal_str()]];
+    if (prn < GNSS_SIGNAL_POOL_MAX_PRN and old_band[prn] > 0)
+        {
+            old_band[prn]--;
+        }
+    prn = signal.get_satellite().get_PRN();
+    if (prn < GNSS_SIGNAL_POOL_MAX_PRN)
+        {
+            assigned_channels_[mapStringValues_[signal.get_signal_str()]][prn]++;
+        }
+    channels_.at(ch_index)->set_signal(signal);
+}
+
+
+void GNSSFlowgraph::set_configuration(std::shared_ptr<ConfigurationInterface> configuration)
+{
+    if (running_)
+        {
+            LOG(WARNING) << "Unable to update configuration while flowgraph running";
+            return;
+        }
+    if (connected_)
+        {
+            LOG(WARNING) << "Unable to update configuration while flowgraph connected";
+        }
+    configuration_ = configuration;
+}
+
+
+void GNSSFlowgraph::start_acquisition_helper()
+{
+    for (unsigned int i = 0; i < channels_count_; i++)
+        {
+            if (channels_state_[i] == 1)
+                {
+                    channels_.at(i)->start_acquisition();
+                }
+        }
+}
+
+
+void GNSSFlowgraph::init()
+{
+    /*
+     * Instantiates the receiver blocks
+     */
+    std::unique_ptr<GNSSBlockFactory> block_factory_(new GNSSBlockFactory());
+    std::chrono::time_point<std::chrono::steady_clock> init_start = std::chrono::steady_clock::now();
+
+    doppler_aiding_uncertainty_hz_ = configuration_->property("GNSS-SDR.AGNSS_doppler_uncertainty_hz", 1000.0);
+    cross_band_uncertainty_hz_ = configuration_->property("GNSS-SDR.cross_band_doppler_uncertainty_hz", 50.0);
+    overload_max_deficit_ = configuration_->property("GNSS-SDR.overload_max_deficit", 0.02);
+    overload_check_interval_ms_ = std::max(configuration_->property("GNSS-SDR.overload_check_interval_ms", 1000), 100);
+    overload_recovery_checks_ = configuration_->property("GNSS-SDR.overload_recovery_checks", 10);
+    overload_min_channels_ = configuration_->property("GNSS-SDR.overload_min_channels", 4);
+
+    // Huge pages and NUMA node of the large buffers that the blocks allocate from now on
+    gnss_sdr_set_memory_policy(configuration_->property("GNSS-SDR.use_hugepages", false), configuration_->property("GNSS-SDR.numa_node", -1));
+
+    // 0. load the FFT plans known from previous runs, so the blocks do not need to measure them again
+    fft_wisdom_filename_ = configuration_->property("GNSS-SDR.fft_wisdom_filename", std::string(""));
+    if (!fft_wisdom_filename_.empty())
+        {
+            if (gnss_sdr_load_fft_wisdom(fft_wisdom_filename_))
+                {
+                    LOG(INFO) << "FFT wisdom loaded from " << fft_wisdom_filename_;
+                }
+            else
+                {
+                    LOG(INFO) << "FFT wisdom file " << fft_wisdom_filename_ << " not available, it will be created on exit";
+                }
+        }
+
+    std::chrono::time_point<std::chrono::steady_clock> sources_start = std::chrono::steady_clock::now();
+
+    // 1. read the number of RF front-ends available (one file_source per RF front-end)
+    sources_count_ = configuration_->property("Receiver.sources_count", 1);
+    distributed_role_ = configuration_->property("GNSS-SDR.distributed_role", std::string(""));
+    if (!distributed_role_.empty() and (distributed_role_ != "source") and (distributed_role_ != "channels") and (distributed_role_ != "pvt"))
+        {
+            LOG(WARNING) << "Unknown GNSS-SDR.distributed_role " << distributed_role_ << ", running as a single node receiver";
+            distributed_role_.clear();
+        }
+    // The observables block of a single node receiver can take its epochs from the channels,
+    // instead of from a sample counter reading the whole output of the signal conditioner
+    shared_sample_clock_ = configuration_->property("GNSS-SDR.shared_sample_clock", false) and distributed_role_.empty();
+    vector_observables_ = configuration_->property("GNSS-SDR.vector_observables", false);
+
+    int RF_Channels = 0;
+    int signal_conditioner_ID = 0;
+
+    if (distributed_role_ == "pvt")
+        {
+            // the samples are processed by the channels nodes
+            sources_count_ = 0;
+        }
+    else if (sources_count_ > 1)
+        {
+            for (int i = 0; i < sources_count_; i++)
+                {
+                    std::cout << "Creating source " << i << std::endl;
+                    sig_source_.push_back(block_factory_->GetSignalSource(configuration_, queue_, i));
+                    // TODO: Create a class interface for SignalSources, derived from GNSSBlockInterface.
+                    // Include GetRFChannels in the interface to avoid read config parameters here
+                    // read the number of RF channels for each front-end
+                    RF_Channels = configuration_->property(sig_source_.at(i)->role() + ".RF_channels", 1);
+                    std::cout << "RF Channels " << RF_Channels << std::endl;
+                    for (int j = 0; j < RF_Channels; j++)
+                        {
+                            sig_conditioner_.push_back(block_factory_->GetSignalConditioner(configuration_, signal_conditioner_ID));
+                            signal_conditioner_ID++;
+                        }
+                }
+        }
+    else
+        {
+            // backwards compatibility for old config files
+            sig_source_.push_back(block_factory_->GetSignalSource(configuration_, queue_, -1));
+            // TODO: Create a class interface for SignalSources, derived from GNSSBlockInterface.
+            // Include GetRFChannels in the interface to avoid read config parameters here
+            // read the number of RF channels for each front-end
+            RF_Channels = configuration_->property(sig_source_.at(0)->role() + ".RF_channels", 0);
+            if (RF_Channels != 0)
+                {
+                    for (int j = 0; j < RF_Channels; j++)
+                        {
+                            sig_conditioner_.push_back(block_factory_->GetSignalConditioner(configuration_, signal_conditioner_ID));
+                            signal_conditioner_ID++;
+                        }
+                }
+            else
+                {
+                    // old config file, single signal source and single channel, not specified
+                    sig_conditioner_.push_back(block_factory_->GetSignalConditioner(configuration_, -1));
+                }
+        }
+
+    // Before the channels are created, so that their acquisitions are configured for it
+    batch_scheduler_ = false;
+    std::string scheduler = configuration_->property("GNSS-SDR.scheduler", std::string("default"));
+    if (scheduler == "batch")
+        {
+            batch_scheduler_ = set_batch_scheduler();
+        }
+    else if (scheduler != "default")
+        {
+            LOG(WARNING) << "Unknown GNSS-SDR.scheduler " << scheduler << ", using the default one";
+        }
+
+    std::chrono::time_point<std::chrono::steady_clock> observables_start = std::chrono::steady_clock::now();
+    observables_ = block_factory_->GetObservables(configuration_);
+    // Mark old implementations as deprecated
+    std::string default_str("Default");
+    std::string obs_implementation = configuration_->property("Observables.implementation", default_str);
+    if ((obs_implementation == "GPS_L1_CA_Observables") || (obs_implementation == "GPS_L2C_Observables") ||
+        (obs_implementation == "Galileo_E1B_Observables") || (obs_implementation == "Galileo_E5A_Observables"))
+        {
+            std::cout << "WARNING: Implementation '" << obs_implementation << "' of the Observables block has been replaced by 'Hybrid_Observables'." << std::endl;
+            std::cout << "Please update your configuration file." << std::endl;
+        }
+
+    std::chrono::time_point<std::chrono::steady_clock> pvt_start = std::chrono::steady_clock::now();
+    pvt_ = block_factory_->GetPVT(configuration_);
+    // Mark old implementations as deprecated
+    std::string pvt_implementation = configuration_->property("PVT.implementation", default_str);
+    if ((pvt_implementation == "GPS_L1_CA_PVT") || (pvt_implementation == "Galileo_E1_PVT") || (pvt_implementation == "Hybrid_PVT"))
+        {
+            std::cout << "WARNING: Implementation '" << pvt_implementation << "' of the PVT block has been replaced by 'RTKLIB_PVT'." << std::endl;
+            std::cout << "Please update your configuration file." << std::endl;
+        }
+
+    std::chrono::time_point<std::chrono::steady_clock> channels_start = std::chrono::steady_clock::now();
+    std::shared_ptr<std::vector<std::unique_ptr<GNSSBlockInterface>>> channels;
+    if ((distributed_role_ == "source") or (distributed_role_ == "pvt"))
+        {
+            channels = std::make_shared<std::vector<std::unique_ptr<GNSSBlockInterface>>>();
+        }
+    else
+        {
+            channels = block_factory_->GetChannels(configuration_, queue_);
+        }
+    std::chrono::time_point<std::chrono::steady_clock> channels_end = std::chrono::steady_clock::now();
+
+    channels_count_ = channels->size();
+    for (unsigned int i = 0; i < channels_count_; i++)
+        {
+            std::shared_ptr<GNSSBlockInterface> chan_ = std::move(channels->at(i));
+            channels_.push_back(std::dynamic_pointer_cast<ChannelInterface>(chan_));
+        }
+
+    // Startup time breakdown
+    auto elapsed_ms = [](std::chrono::time_point<std::chrono::steady_clock> from, std::chrono::time_point<std::chrono::steady_clock> to) {
+        return std::chrono::duration_cast<std::chrono::milliseconds>(to - from).count();
+    };
+    std::cout << "Receiver blocks created in " << elapsed_ms(init_start, channels_end) << " ms (FFT wisdom: "
+              << elapsed_ms(init_start, sources_start) << " ms, signal sources and conditioners: "
+              << elapsed_ms(sources_start, observables_start) << " ms, observables: "
+              << elapsed_ms(observables_start, pvt_start) << " ms, PVT: "
+              << elapsed_ms(pvt_start, channels_start) << " ms, " << channels_count_ << " channels: "
+              << elapsed_ms(channels_start, channels_end) << " ms)" << std::endl;
+    auto elapsed_s = [](std::chrono::time_point<std::chrono::steady_clock> from, std::chrono::time_point<std::chrono::steady_clock> to) {
+        return std::chrono::duration<double>(to - from).count();
+    };
+    startup_times_s_["fft_wisdom"] = elapsed_s(init_start, sources_start);
+    startup_times_s_["sources"] = elapsed_s(sources_start, observables_start);
+    startup_times_s_["observables"] = elapsed_s(observables_start, pvt_start);
+    startup_times_s_["pvt"] = elapsed_s(pvt_start, channels_start);
+    startup_times_s_["channels"] = elapsed_s(channels_start, channels_end);
+
+    // The channel events skip the control message queue, and are applied by a dedicated thread
+    if (configuration_->property("GNSS-SDR.channel_event_bus", true))
+        {
+            channel_events_ = std::make_shared<concurrent_ring_queue<ControlMessage>>(std::max(4 * channels_count_, 256U));
+            for (unsigned int i = 0; i < channels_count_; i++)
+                {
+                    channels_[i]->set_event_queue(channel_events_);
+                }
+        }
+
+    top_block_ = gr::make_top_block("GNSSFlowgraph");
+
+    mapStringValues_["1C"] = evGPS_1C;
+    mapStringValues_["2S"] = evGPS_2S;
+    mapStringValues_["L5"] = evGPS_L5;
+    mapStringValues_["1B"] = evGAL_1B;
+    mapStringValues_["5X"] = evGAL_5X;
+    mapStringValues_["1G"] = evGLO_1G;
+    mapStringValues_["2G"] = evGLO_2G;
+
+    // Cache the configuration needed on every channel event
+    band_signals_ = {"1C", "2S", "L5", "1C", "1B", "5X", "1G", "2G"};
+    band_channels_ = {configuration_->property("Channels_1C.count", 0U),
+        configuration_->property("Channels_2S.count", 0U),
+        configuration_->property("Channels_L5.count", 0U),
+        configuration_->property("Channels_SBAS.count", 0U),
+        configuration_->property("Channels_1B.count", 0U),
+        configuration_->property("Channels_5X.count", 0U),
+        configuration_->property("Channels_1G.count", 0U),
+        configuration_->property("Channels_2G.count", 0U)};
+    same_satellite_bands_ = {{evGPS_2S, evGPS_L5},
+        {evGPS_1C, evGPS_L5},
+        {evGPS_1C, evGPS_2S},
+        {},
+        {evGAL_5X},
+        {evGAL_1B},
+        {evGLO_2G},
+        {evGLO_1G}};
+    assigned_channels_ = std::vector<std::vector<uint16_t>>(band_signals_.size(), std::vector<uint16_t>(GNSS_SIGNAL_POOL_MAX_PRN, 0));
+    channels_satellite_.clear();
+    for (unsigned int i = 0; i < channels_count_; i++)
+        {
+            channels_satellite_.push_back(configuration_->property("Channel" + std::to_string(i) + ".satellite", 0));
+        }
+
+    // fill the signals queue with the satellites ID's to be searched by the acquisition
+    set_signals_list();
+    set_channels_state();
+    applied_actions_ = 0;
+    DLOG(INFO) << "Blocks instantiated. " << channels_count_ << " channels.";
+
+    /*
+	 * Instantiate the receiver monitor block, if required
+	 */
+    enable_monitor_ = configuration_->property("Monitor.enable_monitor", false);
+
+    std::string address_string = configuration_->property("Monitor.client_addresses", std::string("127.0.0.1"));
+    std::vector<std::string> udp_addr_vec = split_string(address_string, '_');
+    std::sort(udp_addr_vec.begin(), udp_addr_vec.end());
+    udp_addr_vec.erase(std::unique(udp_addr_vec.begin(), udp_addr_vec.end()), udp_addr_vec.end());
+
+    init_distributed();
+    unsigned int monitor_channels = channels_count_;
+    if ((distributed_role_ == "source") or (distributed_role_ == "channels"))
+        {
+            // the observables are computed in the PVT node
+            enable_monitor_ = false;
+        }
+    else if (distributed_role_ == "pvt")
+        {
+            monitor_channels = observables_channels();
+        }
+
+    if (enable_monitor_)
+        {
+            GnssSynchroMonitor_ = gr::basic_block_sptr(new gnss_synchro_monitor(monitor_channels,
+                configuration_->property("Monitor.output_rate_ms", 1),
+                configuration_->property("Monitor.udp_port", 1234),
+                udp_addr_vec,
+                vector_observables_));
+        }
+}
+
+
+void GNSSFlowgraph::init_distributed()
+{
+    observables_input_ = observables_->get_left_block();
+    if (distributed_role_.empty())
+        {
+            return;
+        }
+    std::string default_pvt_address = "127.0.0.1";
+    std::string pvt_address = configuration_->property("GNSS-SDR.distributed_pvt_address", default_pvt_address);
+    int pvt_port = configuration_->property("GNSS-SDR.distributed_pvt_port", 12100);
+
+    if (distributed_role_ == "source")
+        {
+            // Signal Source > Signal conditioner (i) > channels nodes, on port distributed_sample_port + i
+            std::string default_sample_address = "239.255.0.1";
+            std::string sample_address = configuration_->property("GNSS-SDR.distributed_sample_address", default_sample_address);
+            int sample_port = configuration_->property("GNSS-SDR.distributed_sample_port", 12000);
+            int datagram_bytes = configuration_->property("GNSS-SDR.distributed_datagram_bytes", 1472);
+            for (unsigned int i = 0; i < sig_conditioner_.size(); i++)
+                {
+                    size_t item_size = sig_conditioner_.at(i)->get_right_block()->output_signature()->sizeof_stream_item(0);
+                    sample_sinks_.push_back(make_udp_sample_sink(item_size, sample_address, static_cast<uint16_t>(sample_port + i), static_cast<size_t>(datagram_bytes)));
+                }
+            std::cout << "Distributed receiver, source node: samples sent to " << sample_address << ":" << sample_port << std::endl;
+        }
+    else if (distributed_role_ == "channels")
+        {
+            // Channels >> PVT node: the forwarder takes the place of the observables block
+            int node = configuration_->property("GNSS-SDR.distributed_node", 0);
+            unsigned int channel_offset = configuration_->property("GNSS-SDR.distributed_channel_offset", 0U);
+            observables_input_ = gnss_synchro_make_udp_forwarder(channels_count_, pvt_address, static_cast<uint16_t>(pvt_port), static_cast<uint8_t>(node), channel_offset);
+            std::cout << "Distributed receiver, channels node " << node << ": channels " << channel_offset << " to " << channel_offset + channels_count_ - 1
+                      << " sent to " << pvt_address << ":" << pvt_port << std::endl;
+        }
+    else
+        {
+            // Channels nodes >> Observables
+            int clock_node = configuration_->property("GNSS-SDR.distributed_clock_node", 0);
+            unsigned int nchannels = observables_channels();
+            channels_receiver_ = gnss_synchro_make_udp_receiver(nchannels, pvt_address, static_cast<uint16_t>(pvt_port), static_cast<uint8_t>(clock_node));
+            std::cout << "Distributed receiver, PVT node: " << nchannels << " channels received on port " << pvt_port << std::endl;
+        }
+}
+
+
+unsigned int GNSSFlowgraph::observables_channels()
+{
+    gr::io_signature::sptr signature = observables_->get_right_block()->output_signature();
+    if (vector_observables_)
+        {
+            return static_cast<unsigned int>(signature->sizeof_stream_item(0) / sizeof(Gnss_Synchro));
+        }
+    return static_cast<unsigned int>(signature->max_streams());
+}
+
+
+void GNSSFlowgraph::connect_pvt_node()
+{
+    // Channels nodes >> Observables >> PVT
+    const int nchannels = observables_channels();
+    const int observables_streams = vector_observables_ ? 1 : nchannels;
+    try
+        {
+            observables_->connect(top_block_);
+            pvt_->connect(top_block_);
+            // the last output carries the sample counter of the clock node
+            for (int i = 0; i <= nchannels; i++)
+                {
+                    top_block_->connect(channels_receiver_, i, observables_->get_left_block(), i);
+                }
+            for (int i = 0; i < observables_streams; i++)
+                {
+                    top_block_->connect(observables_->get_right_block(), i, pvt_->get_left_block(), i);
+                    if (enable_monitor_)
+                        {
+                            top_block_->connect(observables_->get_right_block(), i, GnssSynchroMonitor_, i);
+                        }
+                }
+            top_block_->msg_connect(channels_receiver_, pmt::mp("telemetry"), pvt_->get_left_block(), pmt::mp("telemetry"));
+        }
+    catch (const std::exception& e)
+        {
+            LOG(WARNING) << "Can't connect the channels nodes to the observables and PVT";
+            LOG(ERROR) << e.what();
+            top_block_->disconnect_all();
+            return;
+        }
+    set_thread_placement();
+    set_buffer_sizes();
+    connected_ = true;
+}
+
+void GNSSFlowgraph::set_signals_list()
+{
+    // Set a sequential list of GNSS satellites
+    std::set<unsigned int>::const_iterator available_gnss_prn_iter;
+
+    // Create the lists of GNSS satellites
+    std::set<unsigned int> available_gps_prn = {1, 2, 3, 4, 5, 6, 7, 8, 9, 10,
+        11, 12, 13, 14, 15, 16, 17, 18, 19, 20, 21, 22, 23, 24, 25, 26, 27, 28,
+        29, 30, 31, 32};
+
+    std::set<unsigned int> available_sbas_prn = {123, 131, 135, 136, 138};
+
+    std::set<unsigned int> available_galileo_prn = {1, 2, 3, 4, 5, 6, 7, 8, 9, 10,
+        11, 12, 13, 14, 15, 16, 17, 18, 19, 20, 21, 22, 23, 24, 25, 26, 27, 28,
+        29, 30, 31, 32, 33, 34, 35, 36};
+
+    // Removing satellites sharing same frequency number(1 and 5, 2 and 6, 3 and 7, 4 and 6, 11 and 15, 12 and 16, 14 and 18, 17 and 21
+    std::set<unsigned int> available_glonass_prn = {1, 2, 3, 4, 9, 10, 11, 12, 18, 19, 20, 21, 24};
+
+    std::string sv_list = configuration_->property("Galileo.prns", std::string(""));
+
+    if (sv_list.length() > 0)
+        {
+            // Reset the available prns:
+            std::set<unsigned int> tmp_set;
+            boost::tokenizer<> tok(sv_list);
+            std::transform(tok.begin(), tok.end(), std::inserter(tmp_set, tmp_set.begin()),
+                boost::lexical_cast<unsigned int, std::string>);
+
+            if (tmp_set.size() > 0)
+                {
+                    available_galileo_prn = tmp_set;
+                }
+        }
+
+    sv_list = configuration_->property("GPS.prns", std::string(""));
+
+    if (sv_list.length() > 0)
         {
             // Reset the available prns:
             std::set<unsigned int> tmp_set;
@@ -1717,20 +3119,34 @@ void GNSSFlowgraph::set_channels_state()
             max_acq_channels_ = channels_count_;
             LOG(WARNING) << "Channels_in_acquisition is bigger than number of channels. Variable acq_channels_count_ is set to " << channels_count_;
         }
+    // Acquisitions give way to tracking: every tracking channel reduces the number of concurrent acquisitions by this amount
+    acq_load_per_tracking_channel_ = configuration_->property("Channels.acquisition_load_per_tracking_channel", 0.0);
+    min_acq_channels_ = configuration_->property("Channels.min_in_acquisition", 1);
     channels_state_.reserve(channels_count_);
+    acq_channels_count_ = 0;
+    std::map<std::string, unsigned int> enabled_channels;
     for (unsigned int i = 0; i < channels_count_; i++)
         {
-            if (i < max_acq_channels_)
+            // Channels_XX.active < Channels_XX.count leaves spare channels, to be enabled at runtime
+            std::string signal = channels_[i]->get_signal().get_signal_str();
+            unsigned int active = configuration_->property("Channels_" + signal + ".active", channels_count_);
+            if (enabled_channels[signal] >= active)
+                {
+                    channels_state_.push_back(3);
+                }
+            else if (acq_channels_count_ < max_acq_channels_)
                 {
+                    enabled_channels[signal]++;
                     channels_state_.push_back(1);
+                    acq_channels_count_++;
                 }
             else
                 {
+                    enabled_channels[signal]++;
                     channels_state_.push_back(0);
                 }
             DLOG(INFO) << "Channel " << i << " in state " << channels_state_[i];
         }
-    acq_channels_count_ = max_acq_channels_;
     DLOG(INFO) << acq_channels_count_ << " channels in acquisition state";
 }
 
@@ -1738,210 +3154,46 @@ void GNSSFlowgraph::set_channels_state()
 Gnss_Signal GNSSFlowgraph::search_next_signal(const std::string& searched_signal, bool pop, bool tracked)
 {
     Gnss_Signal result;
-    bool untracked_satellite = true;
-    switch (mapStringValues_[searched_signal])
+    Gnss_Signal_Pool* available_signals = available_signals_list(searched_signal);
+    if (available_signals == nullptr)
         {
-        case evGPS_1C:
+            LOG(ERROR) << "This should not happen :-(";
             result = available_GPS_1C_signals_.front();
-            available_GPS_1C_signals_.pop_front();
-            if (!pop)
-                {
-                    available_GPS_1C_signals_.push_back(result);
-                }
-            if (tracked)
-                {
-                    if ((configuration_->property("Channels_2S.count", 0) > 0) or (configuration_->property("Channels_L5.count", 0) > 0))
-                        {
-                            for (unsigned int ch = 0; ch < channels_count_; ch++)
-                                {
-                                    if ((channels_[ch]->get_signal().get_satellite() == result.get_satellite()) and (channels_[ch]->get_signal().get_signal_str() != "1C")) untracked_satellite = false;
-                                }
-                            if (untracked_satellite and configuration_->property("Channels_2S.count", 0) > 0)
-                                {
-                                    Gnss_Signal gs = Gnss_Signal(result.get_satellite(), "2S");
-                                    available_GPS_2S_signals_.remove(gs);
-                                    available_GPS_2S_signals_.push_front(gs);
-                                }
-                            if (untracked_satellite and configuration_->property("Channels_L5.count", 0) > 0)
-                                {
-                                    Gnss_Signal gs = Gnss_Signal(result.get_satellite(), "L5");
-                                    available_GPS_L5_signals_.remove(gs);
-                                    available_GPS_L5_signals_.push_front(gs);
-                                }
-                        }
-                }
-            break;
-
-        case evGPS_2S:
-            result = available_GPS_2S_signals_.front();
-            available_GPS_2S_signals_.pop_front();
-            if (!pop)
-                {
-                    available_GPS_2S_signals_.push_back(result);
-                }
-            if (tracked)
-                {
-                    if ((configuration_->property("Channels_1C.count", 0) > 0) or (configuration_->property("Channels_L5.count", 0) > 0))
-                        {
-                            for (unsigned int ch = 0; ch < channels_count_; ch++)
-                                {
-                                    if ((channels_[ch]->get_signal().get_satellite() == result.get_satellite()) and (channels_[ch]->get_signal().get_signal_str() != "2S")) untracked_satellite = false;
-                                }
-                            if (untracked_satellite and configuration_->property("Channels_1C.count", 0) > 0)
-                                {
-                                    Gnss_Signal gs = Gnss_Signal(result.get_satellite(), "1C");
-                                    available_GPS_1C_signals_.remove(gs);
-                                    available_GPS_1C_signals_.push_front(gs);
-                                }
-                            if (untracked_satellite and configuration_->property("Channels_L5.count", 0) > 0)
-                                {
-                                    Gnss_Signal gs = Gnss_Signal(result.get_satellite(), "L5");
-                                    available_GPS_L5_signals_.remove(gs);
-                                    available_GPS_L5_signals_.push_front(gs);
-                                }
-                        }
-                }
-            break;
-
-        case evGPS_L5:
-            result = available_GPS_L5_signals_.front();
-            available_GPS_L5_signals_.pop_front();
-            if (!pop)
-                {
-                    available_GPS_L5_signals_.push_back(result);
-                }
-            if (tracked)
-                {
-                    if ((configuration_->property("Channels_1C.count", 0) > 0) or (configuration_->property("Channels_2S.count", 0) > 0))
-                        {
-                            for (unsigned int ch = 0; ch < channels_count_; ch++)
-                                {
-                                    if ((channels_[ch]->get_signal().get_satellite() == result.get_satellite()) and (channels_[ch]->get_signal().get_signal_str() != "L5")) untracked_satellite = false;
-                                }
-                            if (untracked_satellite and configuration_->property("Channels_1C.count", 0) > 0)
-                                {
-                                    Gnss_Signal gs = Gnss_Signal(result.get_satellite(), "1C");
-                                    available_GPS_1C_signals_.remove(gs);
-                                    available_GPS_1C_signals_.push_front(gs);
-                                }
-                            if (untracked_satellite and configuration_->property("Channels_2S.count", 0) > 0)
-                                {
-                                    Gnss_Signal gs = Gnss_Signal(result.get_satellite(), "2S");
-                                    available_GPS_2S_signals_.remove(gs);
-                                    available_GPS_2S_signals_.push_front(gs);
-                                }
-                        }
-                }
-            break;
-
-        case evGAL_1B:
-            result = available_GAL_1B_signals_.front();
-            available_GAL_1B_signals_.pop_front();
-            if (!pop)
-                {
-                    available_GAL_1B_signals_.push_back(result);
-                }
-            if (tracked)
-                {
-                    if (configuration_->property("Channels_5X.count", 0) > 0)
-                        {
-                            for (unsigned int ch = 0; ch < channels_count_; ch++)
-                                {
-                                    if ((channels_[ch]->get_signal().get_satellite() == result.get_satellite()) and (channels_[ch]->get_signal().get_signal_str() != "1B")) untracked_satellite = false;
-                                }
-                            if (untracked_satellite)
-                                {
-                                    Gnss_Signal gs = Gnss_Signal(result.get_satellite(), "5X");
-                                    available_GAL_5X_signals_.remove(gs);
-                                    available_GAL_5X_signals_.push_front(gs);
-                                }
-                        }
-                }
-            break;
-
-        case evGAL_5X:
-            result = available_GAL_5X_signals_.front();
-            available_GAL_5X_signals_.pop_front();
-            if (!pop)
-                {
-                    available_GAL_5X_signals_.push_back(result);
-                }
-            if (tracked)
-                {
-                    if (configuration_->property("Channels_1B.count", 0) > 0)
-                        {
-                            for (unsigned int ch = 0; ch < channels_count_; ch++)
-                                {
-                                    if ((channels_[ch]->get_signal().get_satellite() == result.get_satellite()) and (channels_[ch]->get_signal().get_signal_str() != "5X")) untracked_satellite = false;
-                                }
-                            if (untracked_satellite)
-                                {
-                                    Gnss_Signal gs = Gnss_Signal(result.get_satellite(), "1B");
-                                    available_GAL_1B_signals_.remove(gs);
-                                    available_GAL_1B_signals_.push_front(gs);
-                                }
-                        }
-                }
-            break;
-
-        case evGLO_1G:
-            result = available_GLO_1G_signals_.front();
-            available_GLO_1G_signals_.pop_front();
-            if (!pop)
+            if (pop)
                 {
-                    available_GLO_1G_signals_.push_back(result);
+                    available_GPS_1C_signals_.pop_front();
                 }
-            if (tracked)
+            return result;
+        }
+    result = available_signals->front();
+    available_signals->pop_front();
+    if (!pop)
+        {
+            available_signals->push_back(result);
+        }
+    if (tracked)
+        {
+            // Unless a channel already follows it in another band, that satellite is the next one to search there
+            StringValue band = mapStringValues_[searched_signal];
+            uint32_t prn = result.get_satellite().get_PRN();
+            bool untracked_satellite = prn < GNSS_SIGNAL_POOL_MAX_PRN;
+            for (StringValue other_band : same_satellite_bands_[band])
                 {
-                    if (configuration_->property("Channels_2G.count", 0) > 0)
+                    if (untracked_satellite and assigned_channels_[other_band][prn] > 0)
                         {
-                            for (unsigned int ch = 0; ch < channels_count_; ch++)
-                                {
-                                    if ((channels_[ch]->get_signal().get_satellite() == result.get_satellite()) and (channels_[ch]->get_signal().get_signal_str() != "1G")) untracked_satellite = false;
-                                }
-                            if (untracked_satellite)
-                                {
-                                    Gnss_Signal gs = Gnss_Signal(result.get_satellite(), "2G");
-                                    available_GLO_2G_signals_.remove(gs);
-                                    available_GLO_2G_signals_.push_front(gs);
-                                }
+                            untracked_satellite = false;
                         }
                 }
-            break;
-
-        case evGLO_2G:
-            result = available_GLO_2G_signals_.front();
-            available_GLO_2G_signals_.pop_front();
-            if (!pop)
-                {
-                    available_GLO_2G_signals_.push_back(result);
-                }
-            if (tracked)
+            for (StringValue other_band : same_satellite_bands_[band])
                 {
-                    if (configuration_->property("Channels_1G.count", 0) > 0)
+                    if (untracked_satellite and band_channels_[other_band] > 0)
                         {
-                            for (unsigned int ch = 0; ch < channels_count_; ch++)
-                                {
-                                    if ((channels_[ch]->get_signal().get_satellite() == result.get_satellite()) and (channels_[ch]->get_signal().get_signal_str() != "2G")) untracked_satellite = false;
-                                }
-                            if (untracked_satellite)
-                                {
-                                    Gnss_Signal gs = Gnss_Signal(result.get_satellite(), "1G");
-                                    available_GLO_1G_signals_.remove(gs);
-                                    available_GLO_1G_signals_.push_front(gs);
-                                }
+                            Gnss_Signal gs = Gnss_Signal(result.get_satellite(), band_signals_[other_band]);
+                            Gnss_Signal_Pool* other_signals = available_signals_list(band_signals_[other_band]);
+                            other_signals->remove(gs);
+                            other_signals->push_front(gs);
                         }
                 }
-            break;
-
-        default:
-            LOG(ERROR) << "This should not happen :-(";
-            result = available_GPS_1C_signals_.front();
-            if (pop)
-                {
-                    available_GPS_1C_signals_.pop_front();
-                }
-            break;
         }
     return result;
 }
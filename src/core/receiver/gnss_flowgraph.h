@@ -11,7 +11,7 @@
  *
  * -------------------------------------------------------------------------
  *
- * Copyright (C) 2010-2018  (see AUTHORS file for a list of contributors)
+ * Copyright (C) 2010-2019  (see AUTHORS file for a list of contributors)
  *
  * GNSS-SDR is a software defined Global Navigation
  *          Satellite Systems receiver
@@ -39,21 +39,32 @@
 
 #include "GPS_L1_CA.h"
 #include "channel_interface.h"
+#include "concurrent_ring_queue.h"
 #include "configuration_interface.h"
+#include "control_message_factory.h"
 #include "gnss_block_factory.h"
 #include "gnss_block_interface.h"
+#include "gnss_sdr_sample_clock.h"
 #include "gnss_sdr_sample_counter.h"
 #include "gnss_signal.h"
+#include "gnss_signal_pool.h"
 #include "gnss_synchro_monitor.h"
+#include "gnss_synchro_udp_forwarder.h"
+#include "gnss_synchro_udp_receiver.h"
+#include "gnss_tracking_state_registry.h"
 #include "pvt_interface.h"
+#include "udp_sample_sink.h"
 #include <gnuradio/msg_queue.h>
 #include <gnuradio/top_block.h>
-#include <list>
+#include <condition_variable>
+#include <cstdint>
 #include <map>
 #include <memory>
 #include <mutex>
 #include <queue>
 #include <string>
+#include <thread>
+#include <tuple>
 #include <vector>
 #include <map>
 
@@ -107,6 +118,11 @@ public:
      */
     void apply_action(unsigned int who, unsigned int what);
 
+    /*!
+     * \brief Applies a batch of actions, taking the signal lists lock only once
+     */
+    void apply_actions(const std::vector<ControlMessage>& actions);
+
     void set_configuration(std::shared_ptr<ConfigurationInterface> configuration);
 
     unsigned int applied_actions() const
@@ -144,21 +160,103 @@ public:
      */
     void priorize_satellites(std::vector<std::pair<int, Gnss_Satellite>> visible_satellites);
 
+    /*!
+     * \brief Sets the range rates [m/s] predicted for the visible satellites,
+     * indexed by system and PRN. They are used to narrow the Doppler search
+     * of the channels assigned to those satellites.
+     */
+    void set_predicted_range_rates(const std::map<std::pair<std::string, uint32_t>, double>& range_rates);
+
+    /*!
+     * \brief Enables or disables channels of the signal (e.g. "1C") at runtime, up to its Channels_XX.count
+     *
+     * All the channels are created and connected to the observables and the PVT at startup,
+     * so changing the number of active channels does not stop the flow graph nor disturb
+     * the channels that keep tracking. Idle channels are disabled first, then those in
+     * acquisition, and the ones in tracking last. Returns false if the signal has no channels.
+     */
+    bool set_active_channels(const std::string& signal, unsigned int active);
+
+    /*!
+     * \brief Returns the metrics of the receiver in the OpenMetrics text format
+     *
+     * Items read and written, average work time and input buffer occupancy of
+     * the blocks (the last two require the GNU Radio performance counters),
+     * followed by the acquisition and tracking metrics of Gnss_Metrics.
+     */
+    std::string get_metrics();
+
+    /*!
+     * \brief Returns the total time spent in the work calls of the blocks, in seconds,
+     * added up per type of block: signal_source, signal_conditioner, acquisition,
+     * tracking, telemetry_decoder, observables and pvt.
+     *
+     * All zeros unless the GNU Radio performance counters are enabled.
+     */
+    std::map<std::string, double> get_work_time_per_block_type();
+
+    /*!
+     * \brief Returns the duration of each startup phase, in seconds: fft_wisdom,
+     * sources (signal sources and conditioners), observables, pvt, channels,
+     * connect and start. A phase not run yet is missing.
+     */
+    std::map<std::string, double> get_startup_times();
+
+    /*!
+     * \brief Returns a table of the memory allocated by the blocks, per block role
+     * and channel: the buffers accounted in Gnss_Memory_Accounting (VOLK_GNSSSDR
+     * buffers, FFT plans, histories and dump rings) and the GNU Radio output
+     * buffers of the blocks, followed by the memory in use by the process.
+     *
+     * The GNU Radio buffers are only known once the flow graph is started.
+     */
+    std::string get_memory_report();
+
 private:
+    std::vector<std::tuple<std::string, std::string, gr::block_sptr>> monitored_blocks();  // Type, OpenMetrics labels and block of the blocks with metrics
     void init();  // Populates the SV PRN list available for acquisition and tracking
     void set_signals_list();
+    void apply_action_locked(unsigned int who, unsigned int what);  // apply_action() body, with signal_list_mutex already held
+    void dispatch_channel_events();                                 // Applies the channel events as they arrive, in batches
+    void stop_channel_events();
     void set_channels_state();  // Initializes the channels state (start acquisition or keep standby)
                                 // using the configuration parameters (number of channels and max channels in acquisition)
     Gnss_Signal search_next_signal(const std::string& searched_signal, bool pop, bool tracked = false);
+    void set_channel_signal(unsigned int ch_index, const Gnss_Signal& signal);  // Assigns the signal, with its predicted Doppler, to a channel
+    unsigned int acquisition_budget();  // Number of concurrent acquisitions allowed with the current tracking load
+    void preempt_acquisitions();        // Stops the acquisitions exceeding acquisition_budget()
+    void start_idle_acquisitions();     // Starts the acquisition of the idle channels, up to acquisition_budget()
+    void overload_watchdog();           // Compares the samples processed with the wall clock, and sheds or restores load
+    void stop_overload_watchdog();      // Stops and joins overload_watchdog_thread_
+    void shed_load(double deficit);     // Next step: suspend acquisitions, disable the weakest channel, suspend the PVT position outputs
+    void restore_load();                // Undoes the last step of shed_load()
+    void set_thread_placement();        // Applies the cpu_affinity, rt_priority and numa_node settings, and the round-robin pinning of the channels
+    void apply_memory_policy();         // Huge pages and NUMA node of the GNU Radio buffers, once they are allocated
+    std::vector<int> set_block_placement(const std::string& role, const std::vector<gr::basic_block_sptr>& blocks, const std::vector<int>& default_cores, int default_priority);
+    std::vector<int> parse_cpu_list(const std::string& list);
+    void set_buffer_sizes();                                                    // Bounds the buffers between blocks in GNSS-SDR.low_latency mode
+    bool set_batch_scheduler();                                                 // GNSS-SDR.scheduler=batch: deterministic acquisitions, if all the sources read files
+    void set_batch_chunks();                                                    // The samples move through the source and the conditioners in large chunks
+    bool set_block_buffer(const gr::basic_block_sptr& basic_block, int items);  // Limits the output buffer and the items produced per call of a block
+    int get_conditioner_port(unsigned int ch_index, int signal_conditioner_ID);                             // Signal conditioner output port (sub-band) of a channel
+    gr::basic_block_sptr get_trk_input_block(unsigned int ch_index, int signal_conditioner_ID, int& port);  // Signal conditioner output, or its pre-decimator, feeding a tracking block
+    Gnss_Signal_Pool* available_signals_list(const std::string& signal);
+    void init_distributed();  // Creates the UDP blocks of the node of a distributed receiver
+    void connect_pvt_node();  // Connects the channels nodes to the observables and the PVT of a PVT node
+    unsigned int observables_channels();  // Channels in the output of the observables block
     bool connected_;
+    std::map<std::string, double> startup_times_s_;
     bool running_;
     int sources_count_;
 
     unsigned int channels_count_;
     unsigned int acq_channels_count_;
     unsigned int max_acq_channels_;
+    unsigned int min_acq_channels_;
+    double acq_load_per_tracking_channel_;
     unsigned int applied_actions_;
     std::string config_file_;
+    std::string fft_wisdom_filename_;
     std::shared_ptr<ConfigurationInterface> configuration_;
 
     std::vector<std::shared_ptr<GNSSBlockInterface>> sig_source_;
@@ -168,22 +266,28 @@ private:
     std::shared_ptr<GNSSBlockInterface> pvt_;
 
     std::map<std::string, gr::basic_block_sptr> acq_resamplers_;
+    std::map<std::string, gr::basic_block_sptr> trk_decimators_;  // integrate-and-dump pre-decimators of the tracking blocks
+    std::map<std::string, gr::basic_block_sptr> fdma_premixers_;  // GLONASS FDMA pre-mixers, one per frequency channel number in use
     std::vector<std::shared_ptr<ChannelInterface>> channels_;
     gnss_sdr_sample_counter_sptr ch_out_sample_counter;
+    bool shared_sample_clock_;  // GNSS-SDR.shared_sample_clock: epochs from Gnss_Sdr_Sample_Clock, without ch_out_sample_counter
+    bool vector_observables_;   // GNSS-SDR.vector_observables: one stream of whole epochs from the observables to the PVT and the monitor
+    bool batch_scheduler_;      // GNSS-SDR.scheduler=batch: offline processing of files, as fast as the cores allow
 #if ENABLE_FPGA
     gnss_sdr_fpga_sample_counter_sptr ch_out_fpga_sample_counter;
 #endif
     gr::top_block_sptr top_block_;
     gr::msg_queue::sptr queue_;
+    std::shared_ptr<Gnss_Tracking_State_Registry> state_registry_;  // tracking states of the channels of this receiver
 
-    std::list<Gnss_Signal> available_GPS_1C_signals_;
-    std::list<Gnss_Signal> available_GPS_2S_signals_;
-    std::list<Gnss_Signal> available_GPS_L5_signals_;
-    std::list<Gnss_Signal> available_SBAS_1C_signals_;
-    std::list<Gnss_Signal> available_GAL_1B_signals_;
-    std::list<Gnss_Signal> available_GAL_5X_signals_;
-    std::list<Gnss_Signal> available_GLO_1G_signals_;
-    std::list<Gnss_Signal> available_GLO_2G_signals_;
+    Gnss_Signal_Pool available_GPS_1C_signals_;
+    Gnss_Signal_Pool available_GPS_2S_signals_;
+    Gnss_Signal_Pool available_GPS_L5_signals_;
+    Gnss_Signal_Pool available_SBAS_1C_signals_;
+    Gnss_Signal_Pool available_GAL_1B_signals_;
+    Gnss_Signal_Pool available_GAL_5X_signals_;
+    Gnss_Signal_Pool available_GLO_1G_signals_;
+    Gnss_Signal_Pool available_GLO_2G_signals_;
     enum StringValue
     {
         evGPS_1C,
@@ -196,10 +300,37 @@ private:
         evGLO_2G
     };
     std::map<std::string, StringValue> mapStringValues_;
+    std::vector<std::string> band_signals_;                       // signal string of each band
+    std::vector<std::vector<StringValue>> same_satellite_bands_;  // the other bands of the satellites of each band
+    std::vector<unsigned int> band_channels_;                     // Channels_XX.count of each band
+    std::vector<std::vector<uint16_t>> assigned_channels_;        // channels assigned to each band and PRN
+    std::vector<unsigned int> channels_satellite_;                // ChannelN.satellite, or 0 if not fixed
+    std::map<std::pair<std::string, uint32_t>, double> predicted_range_rates_;
+    double doppler_aiding_uncertainty_hz_;
+    double cross_band_uncertainty_hz_;  // Doppler window of the searches aided by the tracking in another band
 
-    std::vector<unsigned int> channels_state_;
+    std::shared_ptr<concurrent_ring_queue<ControlMessage>> channel_events_;  // acquisition and tracking events of the channels
+    std::thread channel_events_thread_;
+    std::vector<unsigned int> channels_state_;  // 0: idle; 1: acquisition; 2: tracking; 3: disabled
     std::mutex signal_list_mutex;
 
+    std::thread overload_watchdog_thread_;
+    std::mutex overload_watchdog_mutex_;
+    std::condition_variable overload_watchdog_condition_;
+    bool overload_watchdog_stop_;
+    double overload_max_deficit_;              // fraction of the samples not processed in time that triggers shed_load()
+    int overload_check_interval_ms_;
+    int overload_recovery_checks_;             // checks without overload before each restore_load()
+    unsigned int overload_min_channels_;       // channels in tracking that are never disabled
+    bool acquisitions_suspended_;
+    bool position_outputs_suspended_;
+    std::vector<unsigned int> shed_channels_;  // channels disabled by shed_load(), in order
+
+    std::string distributed_role_;                      // GNSS-SDR.distributed_role: "source", "channels", "pvt" or empty (single node)
+    gr::basic_block_sptr observables_input_;            // observables block, or the forwarder to the PVT node in a channels node
+    std::vector<udp_sample_sink_sptr> sample_sinks_;    // one per signal conditioner in a source node
+    gnss_synchro_udp_receiver_sptr channels_receiver_;  // outputs of the channels nodes in a PVT node
+
     bool enable_monitor_;
     gr::basic_block_sptr GnssSynchroMonitor_;
     std::vector<std::string> split_string(const std::string& s, char delim);
@@ -0,0 +1,148 @@
+/*!
+ * \file gnss_signal_pool.cc
+ * \brief Queue of the GNSS signals available for acquisition, with
+ * constant time insertion and removal
+ *
+ * -------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2019  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *          Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------
+ */
+
+#include "gnss_signal_pool.h"
+#include <glog/logging.h>
+
+
+Gnss_Signal_Pool::Gnss_Signal_Pool() : d_slots(GNSS_SIGNAL_POOL_MAX_PRN, Slot{Gnss_Signal(), -1, -1, false}),
+                                       d_head(-1),
+                                       d_tail(-1),
+                                       d_size(0)
+{
+}
+
+
+bool Gnss_Signal_Pool::contains(const Gnss_Signal& signal) const
+{
+    uint32_t prn = signal.get_satellite().get_PRN();
+    return (prn < GNSS_SIGNAL_POOL_MAX_PRN) and d_slots[prn].queued and (d_slots[prn].signal == signal);
+}
+
+
+bool Gnss_Signal_Pool::remove(const Gnss_Signal& signal)
+{
+    if (!contains(signal))
+        {
+            return false;
+        }
+    auto prn = static_cast<int32_t>(signal.get_satellite().get_PRN());
+    Slot& slot = d_slots[prn];
+    if (slot.prev >= 0)
+        {
+            d_slots[slot.prev].next = slot.next;
+        }
+    else
+        {
+            d_head = slot.next;
+        }
+    if (slot.next >= 0)
+        {
+            d_slots[slot.next].prev = slot.prev;
+        }
+    else
+        {
+            d_tail = slot.prev;
+        }
+    slot.prev = -1;
+    slot.next = -1;
+    slot.queued = false;
+    d_size--;
+    return true;
+}
+
+
+void Gnss_Signal_Pool::link(const Gnss_Signal& signal, bool front)
+{
+    uint32_t prn = signal.get_satellite().get_PRN();
+    if (prn >= GNSS_SIGNAL_POOL_MAX_PRN)
+        {
+            LOG(WARNING) << "PRN " << prn << " out of the range of the signal pool, " << signal << " ignored";
+            return;
+        }
+    Slot& slot = d_slots[prn];
+    if (slot.queued)
+        {
+            // a slot holds one signal, which is moved, or replaced if it is another one with the same PRN
+            remove(slot.signal);
+        }
+    slot.signal = signal;
+    slot.queued = true;
+    auto index = static_cast<int32_t>(prn);
+    if (d_head < 0)
+        {
+            d_head = index;
+            d_tail = index;
+        }
+    else if (front)
+        {
+            slot.next = d_head;
+            d_slots[d_head].prev = index;
+            d_head = index;
+        }
+    else
+        {
+            slot.prev = d_tail;
+            d_slots[d_tail].next = index;
+            d_tail = index;
+        }
+    d_size++;
+}
+
+
+void Gnss_Signal_Pool::push_back(const Gnss_Signal& signal)
+{
+    link(signal, false);
+}
+
+
+void Gnss_Signal_Pool::push_front(const Gnss_Signal& signal)
+{
+    link(signal, true);
+}
+
+
+void Gnss_Signal_Pool::pop_front()
+{
+    if (d_head >= 0)
+        {
+            remove(d_slots[d_head].signal);
+        }
+}
+
+
+Gnss_Signal Gnss_Signal_Pool::front() const
+{
+    if (d_head < 0)
+        {
+            return Gnss_Signal();
+        }
+    return d_slots[d_head].signal;
+}
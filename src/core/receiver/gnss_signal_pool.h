@@ -0,0 +1,79 @@
+/*!
+ * \file gnss_signal_pool.h
+ * \brief Queue of the GNSS signals available for acquisition, with
+ * constant time insertion and removal
+ *
+ * -------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2019  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *          Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_GNSS_SIGNAL_POOL_H_
+#define GNSS_SDR_GNSS_SIGNAL_POOL_H_
+
+#include "gnss_signal.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+const uint32_t GNSS_SIGNAL_POOL_MAX_PRN = 256;  //!< PRNs of a pool go from 0 to GNSS_SIGNAL_POOL_MAX_PRN - 1
+
+/*!
+ * \brief Ordered queue of the signals of one band waiting to be searched.
+ *
+ * It has the same interface as the std::list it replaces in GNSSFlowgraph,
+ * but every signal has a fixed slot indexed by its PRN, linked to the
+ * previous and next ones in the queue, so that removing a signal or moving
+ * it to either end does not need to walk the queue. A signal is never
+ * queued twice: pushing a signal already in the pool moves it.
+ */
+class Gnss_Signal_Pool
+{
+public:
+    Gnss_Signal_Pool();
+
+    void push_back(const Gnss_Signal& signal);
+    void push_front(const Gnss_Signal& signal);
+    bool remove(const Gnss_Signal& signal);  //!< Returns true if the signal was in the pool
+    void pop_front();
+    Gnss_Signal front() const;  //!< Returns an empty Gnss_Signal if the pool is empty
+    bool contains(const Gnss_Signal& signal) const;
+    inline size_t size() const { return d_size; }
+    inline bool empty() const { return d_size == 0; }
+
+private:
+    struct Slot
+    {
+        Gnss_Signal signal;
+        int32_t prev;
+        int32_t next;
+        bool queued;
+    };
+    void link(const Gnss_Signal& signal, bool front);
+    std::vector<Slot> d_slots;
+    int32_t d_head;
+    int32_t d_tail;
+    size_t d_size;
+};
+
+#endif /*GNSS_SDR_GNSS_SIGNAL_POOL_H_*/
@@ -31,14 +31,181 @@
 
 #include "tcp_cmd_interface.h"
 #include "control_message_factory.h"
+#include "gnss_dump_policy.h"
+#include "gnss_trace.h"
+#include <cstdlib>
+#include <deque>
 #include <functional>
+#include <iomanip>
+#include <iterator>
 #include <sstream>
 
 
+// Shortest period of the status sent to the subscribed clients
+const int MIN_STATUS_PERIOD_MS = 100;
+
+// Responses waiting to be sent to a client before its status updates are skipped
+const size_t MAX_PENDING_RESPONSES = 4;
+
+
+/*!
+ * \brief A client connection. Its commands are read and answered
+ * asynchronously, so that a slow client never delays the others.
+ */
+class TcpCmdInterface::Session : public std::enable_shared_from_this<TcpCmdInterface::Session>
+{
+public:
+    Session(TcpCmdInterface* server, boost::asio::io_service& io_service) : server_(server), socket_(io_service), timer_(io_service)
+    {
+        period_ms_ = 0;
+        closing_ = false;
+    }
+
+    boost::asio::ip::tcp::socket& socket()
+    {
+        return socket_;
+    }
+
+    void start()
+    {
+        read_command();
+    }
+
+private:
+    void read_command()
+    {
+        auto self = shared_from_this();
+        boost::asio::async_read_until(socket_, input_, '\n', [this, self](const boost::system::error_code& error, size_t bytes __attribute__((unused))) {
+            if (error)
+                {
+                    close();
+                    return;
+                }
+            std::istream is(&input_);
+            std::string line;
+            std::getline(is, line);
+            std::istringstream iss(line);
+            std::vector<std::string> cmd_vector(std::istream_iterator<std::string>{iss},
+                std::istream_iterator<std::string>());
+            if (!cmd_vector.empty() and (cmd_vector.at(0) == "exit"))
+                {
+                    // the connection is closed once the response is sent
+                    closing_ = true;
+                    send("OK\n");
+                    return;
+                }
+            if (!cmd_vector.empty() and (cmd_vector.at(0) == "subscribe"))
+                {
+                    send(subscribe(cmd_vector));
+                }
+            else if (!cmd_vector.empty() and (cmd_vector.at(0) == "unsubscribe"))
+                {
+                    period_ms_ = 0;
+                    boost::system::error_code ignored;
+                    timer_.cancel(ignored);
+                    send("OK\n");
+                }
+            else
+                {
+                    send(server_->execute(cmd_vector));
+                }
+            read_command();
+        });
+    }
+
+    std::string subscribe(const std::vector<std::string>& commandLine)
+    {
+        int period_ms = server_->status_period_ms_;
+        if (commandLine.size() > 1)
+            {
+                period_ms = std::atoi(commandLine.at(1).c_str());
+            }
+        if (period_ms < MIN_STATUS_PERIOD_MS)
+            {
+                return "ERROR: the period must be at least " + std::to_string(MIN_STATUS_PERIOD_MS) + " ms\n";
+            }
+        bool subscribed = period_ms_ > 0;
+        period_ms_ = period_ms;
+        if (!subscribed)
+            {
+                send_status();
+            }
+        return "OK\n";
+    }
+
+    void send_status()
+    {
+        timer_.expires_from_now(boost::posix_time::milliseconds(period_ms_));
+        auto self = shared_from_this();
+        timer_.async_wait([this, self](const boost::system::error_code& error) {
+            if (error or (period_ms_ == 0) or closing_)
+                {
+                    return;
+                }
+            // a client that does not read its updates loses them, the others are not delayed
+            if (pending_.size() < MAX_PENDING_RESPONSES)
+                {
+                    send(server_->status_report() + "\n");
+                }
+            send_status();
+        });
+    }
+
+    void send(std::string response)
+    {
+        bool idle = pending_.empty();
+        pending_.push_back(std::move(response));
+        if (idle)
+            {
+                write_next();
+            }
+    }
+
+    void write_next()
+    {
+        auto self = shared_from_this();
+        boost::asio::async_write(socket_, boost::asio::buffer(pending_.front()), [this, self](const boost::system::error_code& error, size_t bytes __attribute__((unused))) {
+            if (error)
+                {
+                    close();
+                    return;
+                }
+            pending_.pop_front();
+            if (!pending_.empty())
+                {
+                    write_next();
+                }
+            else if (closing_)
+                {
+                    close();
+                }
+        });
+    }
+
+    void close()
+    {
+        closing_ = true;
+        period_ms_ = 0;
+        boost::system::error_code ignored;
+        timer_.cancel(ignored);
+        socket_.shutdown(boost::asio::ip::tcp::socket::shutdown_both, ignored);
+        socket_.close(ignored);
+    }
+
+    TcpCmdInterface* server_;
+    boost::asio::ip::tcp::socket socket_;
+    boost::asio::deadline_timer timer_;
+    boost::asio::streambuf input_;
+    std::deque<std::string> pending_;  // responses being sent, the front one first
+    int period_ms_;                    // period of the status updates, 0 if not subscribed
+    bool closing_;
+};
+
+
 TcpCmdInterface::TcpCmdInterface()
 {
     register_functions();
-    keep_running_ = true;
+    status_period_ms_ = 1000;
     control_queue_ = nullptr;
     rx_latitude_ = 0;
     rx_longitude_ = 0;
@@ -59,6 +226,11 @@ void TcpCmdInterface::register_functions()
     functions["warmstart"] = std::bind(&TcpCmdInterface::warmstart, this, std::placeholders::_1);
     functions["coldstart"] = std::bind(&TcpCmdInterface::coldstart, this, std::placeholders::_1);
     functions["set_ch_satellite"] = std::bind(&TcpCmdInterface::set_ch_satellite, this, std::placeholders::_1);
+    functions["set_channels"] = std::bind(&TcpCmdInterface::set_channels, this, std::placeholders::_1);
+    functions["stats"] = std::bind(&TcpCmdInterface::stats, this, std::placeholders::_1);
+    functions["memory"] = std::bind(&TcpCmdInterface::memory, this, std::placeholders::_1);
+    functions["trace"] = std::bind(&TcpCmdInterface::trace, this, std::placeholders::_1);
+    functions["dump_trigger"] = std::bind(&TcpCmdInterface::dump_trigger, this, std::placeholders::_1);
 }
 
 
@@ -68,6 +240,24 @@ void TcpCmdInterface::set_pvt(std::shared_ptr<PvtInterface> PVT_sptr)
 }
 
 
+void TcpCmdInterface::set_channels_handler(std::function<bool(const std::string &, unsigned int)> channels_handler)
+{
+    channels_handler_ = channels_handler;
+}
+
+
+void TcpCmdInterface::set_stats_handler(std::function<std::string()> stats_handler)
+{
+    stats_handler_ = stats_handler;
+}
+
+
+void TcpCmdInterface::set_memory_handler(std::function<std::string()> memory_handler)
+{
+    memory_handler_ = memory_handler;
+}
+
+
 time_t TcpCmdInterface::get_utc_time()
 {
     return receiver_utc_time_;
@@ -116,51 +306,61 @@ std::string TcpCmdInterface::standby(const std::vector<std::string> &commandLine
 
 
 std::string TcpCmdInterface::status(const std::vector<std::string> &commandLine __attribute__((unused)))
+{
+    return status_report();
+}
+
+
+std::string TcpCmdInterface::status_report()
 {
     std::stringstream str_stream;
-    //todo: implement the receiver status report
-
-    //    str_stream << "-------------------------------------------------------\n";
-    //    str_stream << "ch | sys | sig | mode | Tlm | Eph | Doppler | CN0 |\n";
-    //    str_stream << "   |     |     |      |     |     |  [Hz]   | [dB - Hz] |\n";
-    //    str_stream << "-------------------------------------------------------\n";
-    //    int n_ch = 10;
-    //    for (int n = 0; n < n_ch; n++)
-    //        {
-    //            str_stream << n << "GPS | L1CA | TRK | YES | YES | 23412.4 | 44.3 |\n";
-    //        }
-    //    str_stream << "--------------------------------------------------------\n";
-
-    double longitude_deg, latitude_deg, height_m, ground_speed_kmh, course_over_ground_deg;
-    time_t UTC_time;
-    if (PVT_sptr_->get_latest_PVT(&longitude_deg,
-            &latitude_deg,
-            &height_m,
-            &ground_speed_kmh,
-            &course_over_ground_deg,
-            &UTC_time) == true)
+    std::shared_ptr<const Pvt_Status> pvt_status;
+    if (PVT_sptr_ != nullptr)
+        {
+            pvt_status = PVT_sptr_->get_status();
+        }
+    if (pvt_status and pvt_status->valid_position)
         {
             struct tm tstruct = {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, nullptr};
             char buf1[80];
+            time_t UTC_time = pvt_status->utc_time;
             tstruct = *gmtime(&UTC_time);
             strftime(buf1, sizeof(buf1), "%d/%m/%Y %H:%M:%S", &tstruct);
             std::string str_time = std::string(buf1);
             str_stream << "- Receiver UTC Time: " << str_time << std::endl;
             str_stream << std::setprecision(9);
             str_stream << "- Receiver Position WGS84 [Lat, Long, H]: "
-                       << latitude_deg << ", "
-                       << longitude_deg << ", ";
+                       << pvt_status->latitude_deg << ", "
+                       << pvt_status->longitude_deg << ", ";
             str_stream << std::setprecision(3);
-            str_stream << height_m << std::endl;
+            str_stream << pvt_status->height_m << std::endl;
             str_stream << std::setprecision(1);
-            str_stream << "- Receiver Speed over Ground [km/h]: " << ground_speed_kmh << std::endl;
-            str_stream << "- Receiver Course over ground [deg]: " << course_over_ground_deg << std::endl;
+            str_stream << "- Receiver Speed over Ground [km/h]: " << pvt_status->ground_speed_kmh << std::endl;
+            str_stream << "- Receiver Course over ground [deg]: " << pvt_status->course_over_ground_deg << std::endl;
         }
     else
         {
             str_stream << "No PVT information available.\n";
         }
 
+    if (pvt_status and !pvt_status->channels.empty())
+        {
+            str_stream << std::fixed << std::setprecision(1);
+            str_stream << "-------------------------------------------------------\n";
+            str_stream << "ch | sys | PRN | sig | CN0 [dB-Hz] | Doppler [Hz] | PVT\n";
+            str_stream << "-------------------------------------------------------\n";
+            for (const auto &channel : pvt_status->channels)
+                {
+                    str_stream << channel.channel_id << " | " << channel.system << " | " << channel.prn << " | " << channel.signal << " | "
+                               << channel.cn0_db_hz << " | " << channel.carrier_doppler_hz << " | " << (channel.used_in_pvt ? "YES" : "NO") << "\n";
+                }
+            str_stream << "-------------------------------------------------------\n";
+        }
+    else
+        {
+            str_stream << "No observables available.\n";
+        }
+
     return str_stream.str();
 }
 
@@ -282,117 +482,187 @@ std::string TcpCmdInterface::set_ch_satellite(const std::vector<std::string> &co
 }
 
 
+std::string TcpCmdInterface::set_channels(const std::vector<std::string> &commandLine)
+{
+    std::string response;
+    if (commandLine.size() > 2)
+        {
+            int active = std::atoi(commandLine.at(2).c_str());
+            if (active < 0)
+                {
+                    response = "ERROR: number of channels malformed\n";
+                }
+            else if (channels_handler_ and channels_handler_(commandLine.at(1), active))
+                {
+                    response = "OK\n";
+                }
+            else
+                {
+                    response = "ERROR\n";
+                }
+        }
+    else
+        {
+            response = "ERROR: parameters not found, please use set_channels signal number (e.g. set_channels 1C 8)\n";
+        }
+    return response;
+}
+
+
+std::string TcpCmdInterface::stats(const std::vector<std::string> &commandLine __attribute__((unused)))
+{
+    std::string response;
+    if (stats_handler_)
+        {
+            response = stats_handler_();
+        }
+    else
+        {
+            response = "ERROR: metrics not available\n";
+        }
+    return response;
+}
+
+
+std::string TcpCmdInterface::memory(const std::vector<std::string> &commandLine __attribute__((unused)))
+{
+    std::string response;
+    if (memory_handler_)
+        {
+            response = memory_handler_();
+        }
+    else
+        {
+            response = "ERROR: memory report not available\n";
+        }
+    return response;
+}
+
+
+std::string TcpCmdInterface::trace(const std::vector<std::string> &commandLine)
+{
+    std::string response;
+    if (commandLine.size() > 1)
+        {
+            if (commandLine.at(1) == "stop")
+                {
+                    Gnss_Trace::get_instance()->close();
+                    response = "OK\n";
+                }
+            else if (Gnss_Trace::get_instance()->open(commandLine.at(1)))
+                {
+                    response = "OK\n";
+                }
+            else
+                {
+                    response = "ERROR: unable to create the trace file\n";
+                }
+        }
+    else
+        {
+            response = "ERROR: parameters not found, please use trace filename or trace stop\n";
+        }
+    return response;
+}
+
+
+std::string TcpCmdInterface::dump_trigger(const std::vector<std::string> &commandLine __attribute__((unused)))
+{
+    // the dumps in triggered mode write their pre-trigger records on their next record
+    Gnss_Dump_Policy::trigger_all();
+    return "OK\n";
+}
+
+
 void TcpCmdInterface::set_msg_queue(gr::msg_queue::sptr control_queue)
 {
     control_queue_ = control_queue;
 }
 
 
-void TcpCmdInterface::run_cmd_server(int tcp_port)
+std::string TcpCmdInterface::execute(const std::vector<std::string> &commandLine)
+{
+    if (commandLine.empty())
+        {
+            return "ERROR: empty command\n";
+        }
+    auto function = functions.find(commandLine.at(0));
+    if (function == functions.end())
+        {
+            return "ERROR: command not found \n ";
+        }
+    std::string response;
+    try
+        {
+            response = function->second(commandLine);
+        }
+    catch (const std::exception &ex)
+        {
+            response = "ERROR: command execution error: " + std::string(ex.what()) + "\n";
+        }
+    return response;
+}
+
+
+void TcpCmdInterface::start_accept()
+{
+    auto session = std::make_shared<Session>(this, io_service_);
+    acceptor_->async_accept(session->socket(), [this, session](const boost::system::error_code &error) {
+        if (error == boost::asio::error::operation_aborted)
+            {
+                return;
+            }
+        if (error)
+            {
+                LOG(WARNING) << "TcpCmdInterface: error accepting a connection: " << error.message();
+            }
+        else
+            {
+                session->start();
+            }
+        start_accept();
+    });
+}
+
+
+void TcpCmdInterface::run_cmd_server(int tcp_port, int status_period_ms)
 {
     // Get the port from the parameters
     uint16_t port = tcp_port;
+    status_period_ms_ = std::max(status_period_ms, MIN_STATUS_PERIOD_MS);
 
-    // Error to not throw exception
-    boost::system::error_code not_throw;
-
-    // Socket and acceptor
-    boost::asio::io_service service;
     try
         {
-            boost::asio::ip::tcp::acceptor acceptor(service, boost::asio::ip::tcp::endpoint(boost::asio::ip::tcp::v4(), port));
-
-            while (keep_running_)
-                {
-                    try
-                        {
-                            std::cout << "TcpCmdInterface: Telecommand TCP interface listening on port " << tcp_port << std::endl;
-
-                            boost::asio::ip::tcp::socket socket(service);
-                            acceptor.accept(socket, not_throw);
-                            if (not_throw)
-                                {
-                                    std::cout << "TcpCmdInterface: Error when binding the port in the socket" << std::endl;
-                                    continue;
-                                }
-
-                            // Read a message
-                            boost::system::error_code error = boost::asio::error::eof;
-                            do
-                                {
-                                    std::string response;
-                                    boost::asio::streambuf b;
-                                    boost::asio::read_until(socket, b, '\n', error);
-                                    std::istream is(&b);
-                                    std::string line;
-                                    std::getline(is, line);
-                                    std::istringstream iss(line);
-                                    std::vector<std::string> cmd_vector(std::istream_iterator<std::string>{iss},
-                                        std::istream_iterator<std::string>());
-
-                                    if (cmd_vector.size() > 0)
-                                        {
-                                            try
-                                                {
-                                                    if (cmd_vector.at(0) == "exit")
-                                                        {
-                                                            error = boost::asio::error::eof;
-                                                            // send cmd response
-                                                            socket.write_some(boost::asio::buffer("OK\n"), not_throw);
-                                                        }
-                                                    else
-                                                        {
-                                                            response = functions[cmd_vector.at(0)](cmd_vector);
-                                                        }
-                                                }
-                                            catch (const std::bad_function_call &ex)
-                                                {
-                                                    response = "ERROR: command not found \n ";
-                                                }
-                                            catch (const std::exception &ex)
-                                                {
-                                                    response = "ERROR: command execution error: " + std::string(ex.what()) + "\n";
-                                                }
-                                        }
-                                    else
-                                        {
-                                            response = "ERROR: empty command\n";
-                                        }
-
-                                    // send cmd response
-                                    socket.write_some(boost::asio::buffer(response), not_throw);
-                                    if (not_throw)
-                                        {
-                                            std::cout << "Error sending(" << not_throw.value() << "): " << not_throw.message() << std::endl;
-                                            break;
-                                        }
-                                }
-                            while (error != boost::asio::error::eof);
-
-                            if (error == boost::asio::error::eof)
-                                {
-                                    std::cout << "TcpCmdInterface: EOF detected\n";
-                                }
-                            else
-                                {
-                                    std::cout << "TcpCmdInterface unexpected error: " << error << std::endl;
-                                }
-
-                            // Close socket
-                            socket.close();
-                        }
-                    catch (const boost::exception &e)
-                        {
-                            std::cout << "TcpCmdInterface: Boost exception " << std::endl;
-                        }
-                    catch (const std::exception &ex)
-                        {
-                            std::cout << "TcpCmdInterface: Exception " << ex.what() << std::endl;
-                        }
-                }
+            io_service_.reset();
+            acceptor_ = std::unique_ptr<boost::asio::ip::tcp::acceptor>(new boost::asio::ip::tcp::acceptor(io_service_, boost::asio::ip::tcp::endpoint(boost::asio::ip::tcp::v4(), port)));
         }
-    catch (const boost::exception &e)
+    catch (const boost::system::system_error &e)
         {
             std::cout << "TCP Command Interface exception: address already in use" << std::endl;
+            return;
         }
+    std::cout << "TcpCmdInterface: Telecommand TCP interface listening on port " << tcp_port << std::endl;
+
+    // All the clients are served by this thread
+    start_accept();
+    while (true)
+        {
+            try
+                {
+                    io_service_.run();
+                    break;
+                }
+            catch (const std::exception &ex)
+                {
+                    std::cout << "TcpCmdInterface: Exception " << ex.what() << std::endl;
+                }
+        }
+    boost::system::error_code ignored;
+    acceptor_->close(ignored);
+}
+
+
+void TcpCmdInterface::stop_cmd_server()
+{
+    io_service_.stop();
 }
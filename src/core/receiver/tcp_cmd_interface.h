@@ -42,6 +42,7 @@
 #include <ctime>
 #include <functional>
 #include <iostream>
+#include <memory>
 #include <string>
 #include <unordered_map>
 #include <vector>
@@ -52,7 +53,19 @@ class TcpCmdInterface
 public:
     TcpCmdInterface();
     virtual ~TcpCmdInterface();
-    void run_cmd_server(int tcp_port);
+
+    /*!
+     * \brief Serves any number of clients from the calling thread, until
+     * stop_cmd_server() is called. The subscribed clients get the status
+     * every \p status_period_ms milliseconds, unless they ask for another period.
+     */
+    void run_cmd_server(int tcp_port, int status_period_ms = 1000);
+
+    /*!
+     * \brief Closes the connections and makes run_cmd_server() return
+     */
+    void stop_cmd_server();
+
     void set_msg_queue(gr::msg_queue::sptr control_queue);
 
     /*!
@@ -67,7 +80,24 @@ public:
 
     void set_pvt(std::shared_ptr<PvtInterface> PVT_sptr);
 
+    /*!
+     * \brief sets the function that changes the number of active channels of a signal
+     */
+    void set_channels_handler(std::function<bool(const std::string &, unsigned int)> channels_handler);
+
+    /*!
+     * \brief sets the function that returns the receiver metrics, in the OpenMetrics text format
+     */
+    void set_stats_handler(std::function<std::string()> stats_handler);
+
+    /*!
+     * \brief sets the function that returns the memory footprint report of the receiver
+     */
+    void set_memory_handler(std::function<std::string()> memory_handler);
+
 private:
+    class Session;  // a client connection
+
     std::unordered_map<std::string, std::function<std::string(const std::vector<std::string> &)>>
         functions;
     std::string status(const std::vector<std::string> &commandLine);
@@ -77,11 +107,21 @@ private:
     std::string warmstart(const std::vector<std::string> &commandLine);
     std::string coldstart(const std::vector<std::string> &commandLine);
     std::string set_ch_satellite(const std::vector<std::string> &commandLine);
+    std::string set_channels(const std::vector<std::string> &commandLine);
+    std::string stats(const std::vector<std::string> &commandLine);
+    std::string memory(const std::vector<std::string> &commandLine);
+    std::string trace(const std::vector<std::string> &commandLine);
+    std::string dump_trigger(const std::vector<std::string> &commandLine);
 
     void register_functions();
+    void start_accept();
+    std::string execute(const std::vector<std::string> &commandLine);
+    std::string status_report();  // built from the status snapshot of the PVT block, never waits for the receiver
 
     gr::msg_queue::sptr control_queue_;
-    bool keep_running_;
+    int status_period_ms_;
+    boost::asio::io_service io_service_;
+    std::unique_ptr<boost::asio::ip::tcp::acceptor> acceptor_;
 
     time_t receiver_utc_time_;
 
@@ -90,6 +130,9 @@ private:
     double rx_altitude_;
 
     std::shared_ptr<PvtInterface> PVT_sptr_;
+    std::function<bool(const std::string &, unsigned int)> channels_handler_;
+    std::function<std::string()> stats_handler_;
+    std::function<std::string()> memory_handler_;
 };
 
 #endif /* GNSS_SDR_TCP_CMD_INTERFACE_H_ */
@@ -0,0 +1,211 @@
+/*!
+ * \file visibility_predictor.cc
+ * \brief Predicts the azimuth, elevation and range rate of the satellites
+ * from cached orbit samples on a coarse time grid
+ *
+ * -------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2019  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *          Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------
+ */
+
+#include "visibility_predictor.h"
+#include "rtklib_ephemeris.h"
+#include "rtklib_rtkcmn.h"
+#include <cmath>
+
+
+Visibility_Predictor::Visibility_Predictor(double grid_step_s)
+{
+    d_grid_step_s = grid_step_s > 0.0 ? grid_step_s : 30.0;
+}
+
+
+void Visibility_Predictor::set_ephemeris(const std::string& system, uint32_t prn, const eph_t& eph)
+{
+    Orbit& orbit = d_ephemeris[std::make_pair(system, prn)];
+    if (!orbit.nodes_valid or orbit.eph.sat != eph.sat or orbit.eph.iode != eph.iode or
+        orbit.eph.toe.time != eph.toe.time or orbit.eph.toe.sec != eph.toe.sec or
+        orbit.eph.A != eph.A or orbit.eph.M0 != eph.M0 or orbit.eph.e != eph.e)
+        {
+            orbit.almanac = false;
+            orbit.eph = eph;
+            orbit.nodes_valid = false;
+        }
+    orbit.fresh = true;
+}
+
+
+void Visibility_Predictor::set_almanac(const std::string& system, uint32_t prn, const alm_t& alm)
+{
+    Orbit& orbit = d_almanac[std::make_pair(system, prn)];
+    if (!orbit.nodes_valid or orbit.alm.sat != alm.sat or orbit.alm.week != alm.week or
+        orbit.alm.toa.time != alm.toa.time or orbit.alm.toas != alm.toas or
+        orbit.alm.A != alm.A or orbit.alm.M0 != alm.M0 or orbit.alm.e != alm.e)
+        {
+            orbit.almanac = true;
+            orbit.alm = alm;
+            orbit.nodes_valid = false;
+        }
+    orbit.fresh = true;
+}
+
+
+void Visibility_Predictor::remove_stale()
+{
+    for (auto* orbits : {&d_ephemeris, &d_almanac})
+        {
+            for (auto it = orbits->begin(); it != orbits->end();)
+                {
+                    if (!it->second.fresh)
+                        {
+                            it = orbits->erase(it);
+                        }
+                    else
+                        {
+                            it->second.fresh = false;
+                            ++it;
+                        }
+                }
+        }
+}
+
+
+void Visibility_Predictor::position(const Orbit& orbit, int64_t node, double* r) const
+{
+    double t = static_cast<double>(node) * d_grid_step_s;
+    gtime_t gps_time;
+    gps_time.time = static_cast<time_t>(std::floor(t));
+    gps_time.sec = t - std::floor(t);
+    double dts[2];
+    double var;
+    if (orbit.almanac)
+        {
+            // same time reference as the almanac conversion to RTKLIB
+            gtime_t alm_time;
+            alm_time.time = std::fmod(utc2gpst(gps_time).time + 345600, 604800);
+            alm_time.sec = gps_time.sec;
+            alm2pos(alm_time, &orbit.alm, r, dts);
+        }
+    else
+        {
+            eph2pos(gps_time, &orbit.eph, r, dts, &var);
+        }
+}
+
+
+void Visibility_Predictor::update_nodes(Orbit& orbit, int64_t node_index) const
+{
+    if (orbit.nodes_valid and node_index == orbit.node_index)
+        {
+            return;
+        }
+    if (orbit.nodes_valid and node_index == orbit.node_index + 1)
+        {
+            // the time moved to the next node: only one new orbit propagation
+            for (int i = 0; i < 3; i++)
+                {
+                    orbit.nodes[0][i] = orbit.nodes[1][i];
+                    orbit.nodes[1][i] = orbit.nodes[2][i];
+                }
+            position(orbit, node_index + 1, orbit.nodes[2]);
+        }
+    else
+        {
+            for (int j = 0; j < 3; j++)
+                {
+                    position(orbit, node_index - 1 + j, orbit.nodes[j]);
+                }
+        }
+    orbit.node_index = node_index;
+    orbit.nodes_valid = true;
+}
+
+
+std::vector<Visibility_Predictor::Prediction> Visibility_Predictor::predict(gtime_t time, double lat_deg, double lon_deg, double height_m, double min_elevation_deg)
+{
+    std::vector<Prediction> visible;
+
+    // receiver position and ECEF to ENU rotation, once for all the satellites
+    double pos[3] = {lat_deg * D2R, lon_deg * D2R, height_m};
+    double rr[3];
+    double E[9];
+    pos2ecef(pos, rr);
+    xyz2enu(pos, E);
+
+    double t = static_cast<double>(time.time) + time.sec;
+    auto node_index = static_cast<int64_t>(std::llround(t / d_grid_step_s));
+    double s = (t - static_cast<double>(node_index) * d_grid_step_s) / d_grid_step_s;
+
+    for (auto* orbits : {&d_ephemeris, &d_almanac})
+        {
+            for (auto& entry : *orbits)
+                {
+                    Orbit& orbit = entry.second;
+                    if (orbit.almanac and d_ephemeris.count(entry.first) != 0)
+                        {
+                            continue;
+                        }
+                    update_nodes(orbit, node_index);
+
+                    // quadratic interpolation of the position and its derivative
+                    double dx[3];
+                    double v[3];
+                    for (int i = 0; i < 3; i++)
+                        {
+                            double a = 0.5 * (orbit.nodes[2][i] - orbit.nodes[0][i]);
+                            double b = 0.5 * (orbit.nodes[2][i] - 2.0 * orbit.nodes[1][i] + orbit.nodes[0][i]);
+                            dx[i] = orbit.nodes[1][i] + s * (a + s * b) - rr[i];
+                            v[i] = (a + 2.0 * s * b) / d_grid_step_s;
+                        }
+                    double enu[3];
+                    for (int i = 0; i < 3; i++)
+                        {
+                            enu[i] = E[i] * dx[0] + E[i + 3] * dx[1] + E[i + 6] * dx[2];
+                        }
+                    double dist = std::sqrt(dx[0] * dx[0] + dx[1] * dx[1] + dx[2] * dx[2]);
+                    if (dist <= 0.0)
+                        {
+                            continue;
+                        }
+                    double el = std::asin(enu[2] / dist) * R2D;
+                    if (el <= min_elevation_deg)
+                        {
+                            continue;
+                        }
+                    double az = std::atan2(enu[0], enu[1]) * R2D;
+                    if (az < 0.0)
+                        {
+                            az += 360.0;
+                        }
+                    Prediction p;
+                    p.system = entry.first.first;
+                    p.prn = entry.first.second;
+                    p.azimuth_deg = az;
+                    p.elevation_deg = el;
+                    p.range_rate_m_s = (v[0] * dx[0] + v[1] * dx[1] + v[2] * dx[2]) / dist;
+                    p.from_almanac = orbit.almanac;
+                    visible.push_back(p);
+                }
+        }
+    return visible;
+}
@@ -0,0 +1,108 @@
+/*!
+ * \file visibility_predictor.h
+ * \brief Predicts the azimuth, elevation and range rate of the satellites
+ * from cached orbit samples on a coarse time grid
+ *
+ * -------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2019  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *          Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_VISIBILITY_PREDICTOR_H_
+#define GNSS_SDR_VISIBILITY_PREDICTOR_H_
+
+#include "rtklib.h"
+#include <cstdint>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+
+/*!
+ * \brief Keeps, for each satellite with an ephemeris or an almanac, its
+ * position at the three nodes of a coarse time grid around the last
+ * prediction, and interpolates them (quadratic Lagrange) to get the position
+ * and velocity at any time in between.
+ *
+ * Orbits are propagated only when their ephemeris or almanac changes, or when
+ * the prediction time moves to the next node (one new node per satellite),
+ * so predicting the visibility of the whole constellation every few seconds
+ * costs a few multiplications and one azimuth/elevation per satellite.
+ */
+class Visibility_Predictor
+{
+public:
+    struct Prediction
+    {
+        std::string system;  //!< "GPS" or "Galileo"
+        uint32_t prn;
+        double azimuth_deg;
+        double elevation_deg;
+        double range_rate_m_s;  //!< predicted line-of-sight velocity
+        bool from_almanac;
+    };
+
+    explicit Visibility_Predictor(double grid_step_s = 30.0);
+
+    /*!
+     * \brief Sets the orbit of a satellite. Nodes are only recomputed if the
+     * ephemeris (or almanac) differs from the one already in use.
+     */
+    void set_ephemeris(const std::string& system, uint32_t prn, const eph_t& eph);
+    void set_almanac(const std::string& system, uint32_t prn, const alm_t& alm);
+
+    /*!
+     * \brief Forgets the satellites whose orbit has not been set since the
+     * previous call (e.g., after a cold start cleared the maps)
+     */
+    void remove_stale();
+
+    /*!
+     * \brief Returns the satellites above \p min_elevation_deg for a receiver
+     * at \p lat_deg, \p lon_deg, \p height_m (WGS84) at GPS time \p time.
+     * Satellites with an ephemeris do not use their almanac.
+     */
+    std::vector<Prediction> predict(gtime_t time, double lat_deg, double lon_deg, double height_m, double min_elevation_deg = 0.0);
+
+private:
+    struct Orbit
+    {
+        bool almanac;
+        eph_t eph;
+        alm_t alm;
+        bool fresh;          // set since the last remove_stale()
+        bool nodes_valid;    // nodes computed with the current orbit
+        int64_t node_index;  // index of the central node
+        double nodes[3][3];  // positions at node_index - 1, node_index, node_index + 1
+    };
+
+    void position(const Orbit& orbit, int64_t node, double* r) const;
+    void update_nodes(Orbit& orbit, int64_t node_index) const;
+
+    double d_grid_step_s;
+    std::map<std::pair<std::string, uint32_t>, Orbit> d_ephemeris;
+    std::map<std::pair<std::string, uint32_t>, Orbit> d_almanac;
+};
+
+#endif
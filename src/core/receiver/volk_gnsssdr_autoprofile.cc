@@ -0,0 +1,226 @@
+/*!
+ * \file volk_gnsssdr_autoprofile.cc
+ * \brief Profiles, while the receiver runs, the VOLK_GNSSSDR kernels used by
+ * the configured blocks that are missing from the volk_gnsssdr_config file
+ *
+ * -------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2019  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *          Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------
+ */
+
+#include "volk_gnsssdr_autoprofile.h"
+#include "configuration_interface.h"
+#include <glog/logging.h>
+#include <volk_gnsssdr/volk_gnsssdr.h>
+#include <volk_gnsssdr/volk_gnsssdr_prefs.h>
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <csignal>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <fcntl.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+
+Volk_Gnsssdr_Autoprofile::Volk_Gnsssdr_Autoprofile(const std::shared_ptr<ConfigurationInterface>& configuration)
+{
+    d_profile_binary = configuration->property("GNSS-SDR.volk_gnsssdr_profile_binary", std::string("volk_gnsssdr_profile"));
+    d_iterations = configuration->property("GNSS-SDR.volk_gnsssdr_autoprofile_iterations", 200);
+    d_child = 0;
+    d_cancelled = false;
+
+    const std::array<std::string, 7> signals = {{"1C", "2S", "L5", "1B", "5X", "1G", "2G"}};
+    for (const auto& signal : signals)
+        {
+            if (configuration->property("Channels_" + signal + ".count", 0) == 0)
+                {
+                    continue;
+                }
+            std::string acq_role = "Acquisition_" + signal;
+            d_kernels.emplace_back("volk_gnsssdr_32f_index_max_32u");
+            d_kernels.emplace_back("volk_gnsssdr_32fc_magnitude_squared_acc_index_max_32f");
+            if (configuration->property(acq_role + ".item_type", std::string("gr_complex")) == "cshort")
+                {
+                    d_kernels.emplace_back("volk_gnsssdr_16ic_s32fc_x2_rotator_16ic");
+                    d_kernels.emplace_back("volk_gnsssdr_16ic_convert_32fc");
+                }
+
+            std::string trk_role = "Tracking_" + signal;
+            std::string implementation = configuration->property(trk_role + ".implementation", std::string(""));
+            if (implementation.find("C_Aid") != std::string::npos)
+                {
+                    if (configuration->property(trk_role + ".item_type", std::string("gr_complex")) == "cshort")
+                        {
+                            d_kernels.emplace_back("volk_gnsssdr_16ic_xn_resampler_16ic_xn");
+                            d_kernels.emplace_back("volk_gnsssdr_16ic_x2_rotator_dot_prod_16ic_xn");
+                        }
+                    else
+                        {
+                            d_kernels.emplace_back("volk_gnsssdr_32fc_xn_resampler_32fc_xn");
+                            d_kernels.emplace_back("volk_gnsssdr_32fc_x2_rotator_dot_prod_32fc_xn");
+                        }
+                }
+            else if (configuration->property(trk_role + ".high_dyn", false))
+                {
+                    d_kernels.emplace_back("volk_gnsssdr_32f_xn_high_dynamics_resampler_32f_xn");
+                    d_kernels.emplace_back("volk_gnsssdr_32fc_32f_high_dynamic_rotator_dot_prod_32fc_xn");
+                }
+            else
+                {
+                    d_kernels.emplace_back("volk_gnsssdr_32f_xn_resampler_32f_xn");
+                    d_kernels.emplace_back("volk_gnsssdr_32fc_32f_rotator_dot_prod_32fc_xn");
+                }
+
+            // the Galileo navigation messages are convolutionally encoded
+            if ((signal == "1B") or (signal == "5X"))
+                {
+                    d_kernels.emplace_back("volk_gnsssdr_8i_viterbi_k7r2_32u");
+                }
+        }
+    std::sort(d_kernels.begin(), d_kernels.end());
+    d_kernels.erase(std::unique(d_kernels.begin(), d_kernels.end()), d_kernels.end());
+}
+
+
+std::vector<std::string> Volk_Gnsssdr_Autoprofile::kernels_in_use() const
+{
+    return d_kernels;
+}
+
+
+std::vector<std::string> Volk_Gnsssdr_Autoprofile::unprofiled_kernels() const
+{
+    volk_gnsssdr_arch_pref_t* prefs = nullptr;
+    size_t n_prefs = volk_gnsssdr_load_preferences(&prefs);
+    std::vector<std::string> unprofiled;
+    for (const auto& kernel : d_kernels)
+        {
+            bool found = false;
+            for (size_t i = 0; i < n_prefs; i++)
+                {
+                    if (kernel == prefs[i].name)
+                        {
+                            found = true;
+                            break;
+                        }
+                }
+            if (!found)
+                {
+                    unprofiled.push_back(kernel);
+                }
+        }
+    free(prefs);
+    return unprofiled;
+}
+
+
+bool Volk_Gnsssdr_Autoprofile::run()
+{
+    std::vector<std::string> kernels = unprofiled_kernels();
+    if (kernels.empty())
+        {
+            return false;
+        }
+    std::string kernel_list;
+    for (const auto& kernel : kernels)
+        {
+            kernel_list += (kernel_list.empty() ? "" : ",") + kernel;
+        }
+    std::string iterations = std::to_string(d_iterations);
+    std::array<std::string, 7> args = {{d_profile_binary, "-u", "1", "-i", iterations, "-R", kernel_list}};
+    std::array<char*, 8> argv{};
+    for (size_t i = 0; i < args.size(); i++)
+        {
+            argv[i] = &args[i][0];
+        }
+
+    std::cout << "Profiling " << kernels.size() << " VOLK_GNSSSDR kernels in the background..." << std::endl;
+    LOG(INFO) << "Running " << d_profile_binary << " on " << kernel_list;
+    if (d_cancelled)
+        {
+            return false;
+        }
+    pid_t pid = fork();
+    if (pid == -1)
+        {
+            LOG(WARNING) << "Unable to run " << d_profile_binary << ": " << std::strerror(errno);
+            return false;
+        }
+    if (pid == 0)
+        {
+            // its report is of no use in the receiver output
+            int null_fd = open("/dev/null", O_WRONLY);
+            if (null_fd != -1)
+                {
+                    dup2(null_fd, STDOUT_FILENO);
+                }
+            execvp(argv[0], argv.data());
+            _exit(127);
+        }
+    d_child = pid;
+    if (d_cancelled)
+        {
+            kill(pid, SIGTERM);
+        }
+    int status = 0;
+    pid_t result;
+    do
+        {
+            result = waitpid(pid, &status, 0);
+        }
+    while ((result == -1) and (errno == EINTR));
+    d_child = 0;
+
+    if (d_cancelled or !WIFEXITED(status) or (WEXITSTATUS(status) != 0))
+        {
+            if (!d_cancelled)
+                {
+                    LOG(WARNING) << d_profile_binary << " failed, the VOLK_GNSSSDR kernels keep their default implementations";
+                }
+            return false;
+        }
+    volk_gnsssdr_reload_preferences();
+    char path[1024];
+    volk_gnsssdr_get_config_path(path);
+    std::cout << "VOLK_GNSSSDR kernels profiled, the results are in " << path << std::endl;
+    std::vector<std::string> still_unprofiled = unprofiled_kernels();
+    for (const auto& kernel : still_unprofiled)
+        {
+            LOG(WARNING) << "No profile results for " << kernel;
+        }
+    return true;
+}
+
+
+void Volk_Gnsssdr_Autoprofile::cancel()
+{
+    d_cancelled = true;
+    pid_t pid = d_child;
+    if (pid > 0)
+        {
+            kill(pid, SIGTERM);
+        }
+}
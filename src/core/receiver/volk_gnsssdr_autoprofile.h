@@ -0,0 +1,77 @@
+/*!
+ * \file volk_gnsssdr_autoprofile.h
+ * \brief Profiles, while the receiver runs, the VOLK_GNSSSDR kernels used by
+ * the configured blocks that are missing from the volk_gnsssdr_config file
+ *
+ * -------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2019  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *          Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_VOLK_GNSSSDR_AUTOPROFILE_H_
+#define GNSS_SDR_VOLK_GNSSSDR_AUTOPROFILE_H_
+
+#include <atomic>
+#include <memory>
+#include <string>
+#include <vector>
+#include <sys/types.h>
+
+class ConfigurationInterface;
+
+/*!
+ * \brief Runs volk_gnsssdr_profile in update mode on the kernels of the
+ * configured acquisition, tracking and telemetry blocks that have no entry
+ * in the volk_gnsssdr_config file (never profiled, or profiled before the
+ * kernel existed), and makes them use the new entries without restarting.
+ *
+ * Until then, and for the kernels that are already profiled, nothing
+ * changes: a kernel with no entry uses the implementation with the most
+ * demanding instruction set requirements.
+ */
+class Volk_Gnsssdr_Autoprofile
+{
+public:
+    Volk_Gnsssdr_Autoprofile(const std::shared_ptr<ConfigurationInterface>& configuration);
+
+    std::vector<std::string> kernels_in_use() const;
+    std::vector<std::string> unprofiled_kernels() const;
+
+    /*!
+     * \brief Profiles the unprofiled kernels, blocking until
+     * volk_gnsssdr_profile exits, and reloads the preferences.
+     * Returns true if the volk_gnsssdr_config file was updated.
+     */
+    bool run();
+
+    void cancel();  //!< Terminates a profile in progress, from any thread
+
+private:
+    std::vector<std::string> d_kernels;
+    std::string d_profile_binary;
+    int d_iterations;
+    std::atomic<pid_t> d_child;
+    std::atomic<bool> d_cancelled;
+};
+
+#endif /*GNSS_SDR_VOLK_GNSSSDR_AUTOPROFILE_H_*/
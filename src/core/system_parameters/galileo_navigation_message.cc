@@ -257,87 +257,21 @@ bool Galileo_Navigation_Message::CRC_test(std::bitset<GALILEO_DATA_FRAME_BITS> b
 }
 
 
-uint64_t Galileo_Navigation_Message::read_navigation_unsigned(std::bitset<GALILEO_DATA_JK_BITS> bits, const std::vector<std::pair<int32_t, int32_t> >& parameter)
+uint64_t Galileo_Navigation_Message::read_navigation_unsigned(const Gnss_Packed_Bits& bits, const std::vector<std::pair<int32_t, int32_t> >& parameter)
 {
-    uint64_t value = 0ULL;
-    int32_t num_of_slices = parameter.size();
-    for (int32_t i = 0; i < num_of_slices; i++)
-        {
-            for (int32_t j = 0; j < parameter[i].second; j++)
-                {
-                    value <<= 1;  // shift left
-                    if (static_cast<int>(bits[GALILEO_DATA_JK_BITS - parameter[i].first - j]) == 1)
-                        {
-                            value += 1;  // insert the bit
-                        }
-                }
-        }
-    return value;
+    return bits.read_unsigned(parameter);
 }
 
 
-uint64_t Galileo_Navigation_Message::read_page_type_unsigned(std::bitset<GALILEO_PAGE_TYPE_BITS> bits, const std::vector<std::pair<int32_t, int32_t> >& parameter)
+int64_t Galileo_Navigation_Message::read_navigation_signed(const Gnss_Packed_Bits& bits, const std::vector<std::pair<int32_t, int32_t> >& parameter)
 {
-    uint64_t value = 0ULL;
-    int32_t num_of_slices = parameter.size();
-    for (int32_t i = 0; i < num_of_slices; i++)
-        {
-            for (int32_t j = 0; j < parameter[i].second; j++)
-                {
-                    value <<= 1;  // shift left
-                    if (static_cast<int>(bits[GALILEO_PAGE_TYPE_BITS - parameter[i].first - j]) == 1)
-                        {
-                            value += 1ULL;  // insert the bit
-                        }
-                }
-        }
-    return value;
+    return bits.read_signed(parameter);
 }
 
 
-int64_t Galileo_Navigation_Message::read_navigation_signed(std::bitset<GALILEO_DATA_JK_BITS> bits, const std::vector<std::pair<int32_t, int32_t> >& parameter)
+bool Galileo_Navigation_Message::read_navigation_bool(const Gnss_Packed_Bits& bits, const std::vector<std::pair<int32_t, int32_t> >& parameter)
 {
-    int64_t value = 0LL;
-    int32_t num_of_slices = parameter.size();
-
-    // read the MSB and perform the sign extension
-    if (static_cast<int>(bits[GALILEO_DATA_JK_BITS - parameter[0].first]) == 1)
-        {
-            value ^= 0xFFFFFFFFFFFFFFFFLL;  // 64 bits variable
-        }
-    else
-        {
-            value &= 0LL;
-        }
-
-    for (int32_t i = 0; i < num_of_slices; i++)
-        {
-            for (int32_t j = 0; j < parameter[i].second; j++)
-                {
-                    value <<= 1;                  // shift left
-                    value &= 0xFFFFFFFFFFFFFFFE;  // reset the corresponding bit (for the 64 bits variable)
-                    if (static_cast<int>(bits[GALILEO_DATA_JK_BITS - parameter[i].first - j]) == 1)
-                        {
-                            value += 1LL;  // insert the bit
-                        }
-                }
-        }
-    return value;
-}
-
-
-bool Galileo_Navigation_Message::read_navigation_bool(std::bitset<GALILEO_DATA_JK_BITS> bits, const std::vector<std::pair<int32_t, int32_t> >& parameter)
-{
-    bool value;
-    if (static_cast<int>(static_cast<int>(bits[GALILEO_DATA_JK_BITS - parameter[0].first])) == 1)
-        {
-            value = true;
-        }
-    else
-        {
-            value = false;
-        }
-    return value;
+    return bits.read_bool(parameter);
 }
 
 
@@ -396,12 +330,12 @@ void Galileo_Navigation_Message::split_page(std::string page_string, int32_t fla
                         {
                             flag_CRC_test = true;
                             // CRC correct: Decode word
-                            std::string page_number_bits = Data_k.substr(0, 6);
-                            std::bitset<GALILEO_PAGE_TYPE_BITS> page_type_bits(page_number_bits);  // from string to bitset
-                            Page_type = static_cast<int32_t>(read_page_type_unsigned(page_type_bits, type));
-                            Page_type_time_stamp = Page_type;
                             std::string Data_jk_ephemeris = Data_k + Data_j;
-                            page_jk_decoder(Data_jk_ephemeris.c_str());
+                            Gnss_Packed_Bits data_jk_bits;
+                            data_jk_bits.assign_bits(Data_jk_ephemeris);
+                            Page_type = static_cast<int32_t>(read_navigation_unsigned(data_jk_bits, type));
+                            Page_type_time_stamp = Page_type;
+                            page_jk_decoder(data_jk_bits);
                         }
                     else
                         {
@@ -640,10 +574,15 @@ Galileo_Almanac_Helper Galileo_Navigation_Message::get_almanac()
 
 int32_t Galileo_Navigation_Message::page_jk_decoder(const char* data_jk)
 {
-    int32_t page_number = 0;
+    Gnss_Packed_Bits data_jk_bits;
+    data_jk_bits.assign_bits(data_jk, GALILEO_DATA_JK_BITS);
+    return page_jk_decoder(data_jk_bits);
+}
+
 
-    std::string data_jk_string = data_jk;
-    std::bitset<GALILEO_DATA_JK_BITS> data_jk_bits(data_jk_string);
+int32_t Galileo_Navigation_Message::page_jk_decoder(const Gnss_Packed_Bits& data_jk_bits)
+{
+    int32_t page_number = 0;
 
     page_number = static_cast<int32_t>(read_navigation_unsigned(data_jk_bits, PAGE_TYPE_bit));
     LOG(INFO) << "Page number = " << page_number;
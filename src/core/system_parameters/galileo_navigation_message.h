@@ -38,6 +38,7 @@
 #include "galileo_ephemeris.h"
 #include "galileo_iono.h"
 #include "galileo_utc_model.h"
+#include "gnss_packed_bits.h"
 #include <bitset>
 #include <cstdint>
 #include <map>
@@ -55,10 +56,10 @@ class Galileo_Navigation_Message
 {
 private:
     bool CRC_test(std::bitset<GALILEO_DATA_FRAME_BITS> bits, uint32_t checksum);
-    bool read_navigation_bool(std::bitset<GALILEO_DATA_JK_BITS> bits, const std::vector<std::pair<int32_t, int32_t> >& parameter);
-    uint64_t read_navigation_unsigned(std::bitset<GALILEO_DATA_JK_BITS> bits, const std::vector<std::pair<int32_t, int32_t> >& parameter);
-    uint64_t read_page_type_unsigned(std::bitset<GALILEO_PAGE_TYPE_BITS> bits, const std::vector<std::pair<int32_t, int32_t> >& parameter);
-    int64_t read_navigation_signed(std::bitset<GALILEO_DATA_JK_BITS> bits, const std::vector<std::pair<int32_t, int32_t> >& parameter);
+    bool read_navigation_bool(const Gnss_Packed_Bits& bits, const std::vector<std::pair<int32_t, int32_t> >& parameter);
+    uint64_t read_navigation_unsigned(const Gnss_Packed_Bits& bits, const std::vector<std::pair<int32_t, int32_t> >& parameter);
+    int64_t read_navigation_signed(const Gnss_Packed_Bits& bits, const std::vector<std::pair<int32_t, int32_t> >& parameter);
+    int32_t page_jk_decoder(const Gnss_Packed_Bits& data_jk_bits);
 
 public:
     int32_t Page_type_time_stamp;
@@ -33,6 +33,7 @@
 #include "glonass_gnav_navigation_message.h"
 #include "gnss_satellite.h"
 #include <glog/logging.h>
+#include <algorithm>
 
 
 void Glonass_Gnav_Navigation_Message::reset()
@@ -210,67 +211,22 @@ bool Glonass_Gnav_Navigation_Message::CRC_test(std::bitset<GLONASS_GNAV_STRING_B
 }
 
 
-bool Glonass_Gnav_Navigation_Message::read_navigation_bool(std::bitset<GLONASS_GNAV_STRING_BITS> bits, const std::vector<std::pair<int32_t, int32_t>>& parameter)
+bool Glonass_Gnav_Navigation_Message::read_navigation_bool(const Gnss_Packed_Bits& bits, const std::vector<std::pair<int32_t, int32_t>>& parameter)
 {
-    bool value;
-
-    if (bits[GLONASS_GNAV_STRING_BITS - parameter[0].first] == 1)
-        {
-            value = true;
-        }
-    else
-        {
-            value = false;
-        }
-    return value;
+    return bits.read_bool(parameter);
 }
 
 
-uint64_t Glonass_Gnav_Navigation_Message::read_navigation_unsigned(std::bitset<GLONASS_GNAV_STRING_BITS> bits, const std::vector<std::pair<int32_t, int32_t>>& parameter)
+uint64_t Glonass_Gnav_Navigation_Message::read_navigation_unsigned(const Gnss_Packed_Bits& bits, const std::vector<std::pair<int32_t, int32_t>>& parameter)
 {
-    uint64_t value = 0ULL;
-    int32_t num_of_slices = parameter.size();
-    for (int32_t i = 0; i < num_of_slices; i++)
-        {
-            for (int32_t j = 0; j < parameter[i].second; j++)
-                {
-                    value <<= 1;  // shift left
-                    if (bits[GLONASS_GNAV_STRING_BITS - parameter[i].first - j] == 1)
-                        {
-                            value += 1ULL;  // insert the bit
-                        }
-                }
-        }
-    return value;
+    return bits.read_unsigned(parameter);
 }
 
 
-int64_t Glonass_Gnav_Navigation_Message::read_navigation_signed(std::bitset<GLONASS_GNAV_STRING_BITS> bits, const std::vector<std::pair<int32_t, int32_t>>& parameter)
+int64_t Glonass_Gnav_Navigation_Message::read_navigation_signed(const Gnss_Packed_Bits& bits, const std::vector<std::pair<int32_t, int32_t>>& parameter)
 {
-    int64_t value = 0LL;
-    int64_t sign = 0LL;
-    int32_t num_of_slices = parameter.size();
-    // read the MSB and perform the sign extension
-    if (bits[GLONASS_GNAV_STRING_BITS - parameter[0].first] == 1)
-        {
-            sign = -1LL;
-        }
-    else
-        {
-            sign = 1LL;
-        }
-    for (int32_t i = 0; i < num_of_slices; i++)
-        {
-            for (int32_t j = 1; j < parameter[i].second; j++)
-                {
-                    value <<= 1;  // shift left
-                    if (bits[GLONASS_GNAV_STRING_BITS - parameter[i].first - j] == 1)
-                        {
-                            value += 1LL;  // insert the bit
-                        }
-                }
-        }
-    return (sign * value);
+    // GLONASS uses sign-magnitude representation
+    return bits.read_sign_magnitude(parameter);
 }
 
 
@@ -314,14 +270,15 @@ int32_t Glonass_Gnav_Navigation_Message::string_decoder(const std::string& frame
     d_string_ID = 0U;
     d_frame_ID = 0U;
 
-    // Unpack bytes to bits
-    std::bitset<GLONASS_GNAV_STRING_BITS> string_bits(frame_string);
-
     // Perform data verification and exit code if error in bit sequence
-    flag_CRC_test = CRC_test(string_bits);
+    flag_CRC_test = CRC_test(std::bitset<GLONASS_GNAV_STRING_BITS>(frame_string));
     if (flag_CRC_test == false)
         return 0;
 
+    // Pack the string in words, so each parameter is read with a shift and a mask
+    Gnss_Packed_Bits string_bits;
+    string_bits.assign_bits(frame_string.data(), std::min<std::size_t>(frame_string.length(), GLONASS_GNAV_STRING_BITS));
+
     // Decode all 15 string messages
     d_string_ID = static_cast<uint32_t>(read_navigation_unsigned(string_bits, STRING_ID));
     switch (d_string_ID)
@@ -39,6 +39,7 @@
 #include "glonass_gnav_almanac.h"
 #include "glonass_gnav_ephemeris.h"
 #include "glonass_gnav_utc_model.h"
+#include "gnss_packed_bits.h"
 #include <bitset>
 #include <cstdint>
 
@@ -51,9 +52,9 @@
 class Glonass_Gnav_Navigation_Message
 {
 private:
-    uint64_t read_navigation_unsigned(std::bitset<GLONASS_GNAV_STRING_BITS> bits, const std::vector<std::pair<int32_t, int32_t>>& parameter);
-    int64_t read_navigation_signed(std::bitset<GLONASS_GNAV_STRING_BITS> bits, const std::vector<std::pair<int32_t, int32_t>>& parameter);
-    bool read_navigation_bool(std::bitset<GLONASS_GNAV_STRING_BITS> bits, const std::vector<std::pair<int32_t, int32_t>>& parameter);
+    uint64_t read_navigation_unsigned(const Gnss_Packed_Bits& bits, const std::vector<std::pair<int32_t, int32_t>>& parameter);
+    int64_t read_navigation_signed(const Gnss_Packed_Bits& bits, const std::vector<std::pair<int32_t, int32_t>>& parameter);
+    bool read_navigation_bool(const Gnss_Packed_Bits& bits, const std::vector<std::pair<int32_t, int32_t>>& parameter);
 
 public:
     bool flag_CRC_test;
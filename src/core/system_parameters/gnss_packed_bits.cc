@@ -0,0 +1,146 @@
+/*!
+ * \file gnss_packed_bits.cc
+ * \brief Navigation message bits packed in 32-bit words, with field
+ * extraction by shift and mask
+ *
+ * -------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2019  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *          Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------
+ */
+
+
+#include "gnss_packed_bits.h"
+
+
+Gnss_Packed_Bits::Gnss_Packed_Bits()
+{
+    d_bit_count = 0;
+}
+
+
+void Gnss_Packed_Bits::reset(std::size_t n_bits)
+{
+    d_bit_count = n_bits;
+    d_words.assign((n_bits + 31) / 32 + 1, 0U);
+}
+
+
+void Gnss_Packed_Bits::assign_bits(const char* bits, std::size_t n_bits)
+{
+    reset(n_bits);
+    for (std::size_t i = 0; i < n_bits; i++)
+        {
+            if (bits[i] == '1')
+                {
+                    d_words[i >> 5] |= 0x80000000U >> (i & 31);
+                }
+        }
+}
+
+
+void Gnss_Packed_Bits::assign_bits(const std::string& bits)
+{
+    assign_bits(bits.data(), bits.length());
+}
+
+
+void Gnss_Packed_Bits::assign_words(const uint32_t* words, std::size_t n_words, uint32_t bits_per_word)
+{
+    reset(n_words * bits_per_word);
+    const uint64_t mask = (1ULL << bits_per_word) - 1ULL;
+    std::size_t position = 0;
+    for (std::size_t i = 0; i < n_words; i++)
+        {
+            // Left-align the word in a 64-bit window starting at the current word boundary
+            uint32_t offset = position & 31;
+            uint64_t window = (static_cast<uint64_t>(words[i]) & mask) << (64 - bits_per_word - offset);
+            d_words[position >> 5] |= static_cast<uint32_t>(window >> 32);
+            d_words[(position >> 5) + 1] |= static_cast<uint32_t>(window);
+            position += bits_per_word;
+        }
+}
+
+
+uint32_t Gnss_Packed_Bits::field(int32_t first_bit, int32_t length) const
+{
+    if (first_bit < 1 or length < 1 or length > 32 or static_cast<std::size_t>(first_bit - 1 + length) > d_bit_count)
+        {
+            return 0U;
+        }
+    const std::size_t position = first_bit - 1;
+    const std::size_t index = position >> 5;
+    uint64_t window = (static_cast<uint64_t>(d_words[index]) << 32) | d_words[index + 1];
+    window <<= (position & 31);
+    return static_cast<uint32_t>(window >> (64 - length));
+}
+
+
+uint64_t Gnss_Packed_Bits::read_unsigned(const std::vector<std::pair<int32_t, int32_t>>& parameter) const
+{
+    uint64_t value = 0ULL;
+    for (const auto& slice : parameter)
+        {
+            value = (value << slice.second) | field(slice.first, slice.second);
+        }
+    return value;
+}
+
+
+int64_t Gnss_Packed_Bits::read_signed(const std::vector<std::pair<int32_t, int32_t>>& parameter) const
+{
+    uint64_t value = read_unsigned(parameter);
+    int32_t length = 0;
+    for (const auto& slice : parameter)
+        {
+            length += slice.second;
+        }
+    // sign extension
+    if (length > 0 and length < 64 and ((value >> (length - 1)) & 1ULL))
+        {
+            value |= ~0ULL << length;
+        }
+    return static_cast<int64_t>(value);
+}
+
+
+int64_t Gnss_Packed_Bits::read_sign_magnitude(const std::vector<std::pair<int32_t, int32_t>>& parameter) const
+{
+    if (parameter.empty())
+        {
+            return 0LL;
+        }
+    int64_t sign = read_bool(parameter) ? -1LL : 1LL;
+    int64_t value = 0LL;
+    for (const auto& slice : parameter)
+        {
+            // The first bit of each slice is skipped, as in the bit-by-bit readers
+            value = (value << (slice.second - 1)) | field(slice.first + 1, slice.second - 1);
+        }
+    return sign * value;
+}
+
+
+bool Gnss_Packed_Bits::read_bool(const std::vector<std::pair<int32_t, int32_t>>& parameter) const
+{
+    return field(parameter[0].first, 1) == 1U;
+}
@@ -0,0 +1,97 @@
+/*!
+ * \file gnss_packed_bits.h
+ * \brief Navigation message bits packed in 32-bit words, with field
+ * extraction by shift and mask
+ *
+ * -------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2019  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *          Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------
+ */
+
+
+#ifndef GNSS_SDR_GNSS_PACKED_BITS_H_
+#define GNSS_SDR_GNSS_PACKED_BITS_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+
+/*!
+ * \brief Holds a navigation message (subframe, page or string) with its
+ * first bit at the most significant position of the first 32-bit word.
+ *
+ * Fields are read with the same tables of (first bit, length) slices used
+ * by the ICD definitions in GPS_L1_CA.h, Galileo_E1.h and GLONASS_L1_L2_CA.h,
+ * where bit 1 is the first transmitted bit. Each slice is extracted with a
+ * shift and a mask over a 64-bit window instead of bit by bit.
+ */
+class Gnss_Packed_Bits
+{
+public:
+    Gnss_Packed_Bits();
+
+    /*!
+     * \brief Packs \p n_bits symbols given as '0' and '1' characters
+     */
+    void assign_bits(const char* bits, std::size_t n_bits);
+    void assign_bits(const std::string& bits);
+
+    /*!
+     * \brief Packs \p n_words words holding \p bits_per_word bits each,
+     * right-justified and most significant bit first (e.g., the 30-bit
+     * words of a GPS L1 C/A subframe)
+     */
+    void assign_words(const uint32_t* words, std::size_t n_words, uint32_t bits_per_word);
+
+    /*!
+     * \brief Returns the \p length (up to 32) bits starting at \p first_bit (1-based)
+     */
+    uint32_t field(int32_t first_bit, int32_t length) const;
+
+    uint64_t read_unsigned(const std::vector<std::pair<int32_t, int32_t>>& parameter) const;
+
+    /*!
+     * \brief Reads a two's complement field
+     */
+    int64_t read_signed(const std::vector<std::pair<int32_t, int32_t>>& parameter) const;
+
+    /*!
+     * \brief Reads a field whose most significant bit is the sign and the
+     * rest the magnitude, as used by GLONASS
+     */
+    int64_t read_sign_magnitude(const std::vector<std::pair<int32_t, int32_t>>& parameter) const;
+
+    bool read_bool(const std::vector<std::pair<int32_t, int32_t>>& parameter) const;
+
+    std::size_t size() const { return d_bit_count; }
+
+private:
+    void reset(std::size_t n_bits);
+    std::vector<uint32_t> d_words;  // one extra word so any field can be read from a 64-bit window
+    std::size_t d_bit_count;
+};
+
+#endif
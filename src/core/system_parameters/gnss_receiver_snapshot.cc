@@ -0,0 +1,49 @@
+/*!
+ * \file gnss_receiver_snapshot.cc
+ * \brief  Implementation of a storage of the receiver state, used to speed up
+ * the acquisition of the satellites after a restart
+ *
+ * -------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2019  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *          Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------
+ */
+
+#include "gnss_receiver_snapshot.h"
+
+Gnss_Snapshot_Tracking_State::Gnss_Snapshot_Tracking_State()
+{
+    prn = 0;
+    carrier_doppler_hz = 0.0;
+    carrier_freq_hz = 0.0;
+    cn0_db_hz = 0.0;
+}
+
+
+Gnss_Receiver_Snapshot::Gnss_Receiver_Snapshot()
+{
+    save_utc_time = 0;
+    pvt_valid = false;
+    latitude_deg = 0.0;
+    longitude_deg = 0.0;
+    height_m = 0.0;
+}
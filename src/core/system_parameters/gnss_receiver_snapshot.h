@@ -0,0 +1,121 @@
+/*!
+ * \file gnss_receiver_snapshot.h
+ * \brief  Interface of a storage of the receiver state, used to speed up
+ * the acquisition of the satellites after a restart
+ *
+ * -------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2019  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *          Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_GNSS_RECEIVER_SNAPSHOT_H_
+#define GNSS_SDR_GNSS_RECEIVER_SNAPSHOT_H_
+
+#include "galileo_almanac.h"
+#include "galileo_ephemeris.h"
+#include "gps_almanac.h"
+#include "gps_ephemeris.h"
+#include <boost/serialization/map.hpp>
+#include <boost/serialization/nvp.hpp>
+#include <boost/serialization/string.hpp>
+#include <boost/serialization/vector.hpp>
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+
+
+/*!
+ * \brief Last tracking state of a satellite signal, as stored in a receiver snapshot
+ */
+class Gnss_Snapshot_Tracking_State
+{
+public:
+    std::string system;  //!< "GPS", "Galileo", ...
+    uint32_t prn;
+    std::string signal;  //!< "1C", "1B", ...
+    double carrier_doppler_hz;
+    double carrier_freq_hz;
+    double cn0_db_hz;
+
+    Gnss_Snapshot_Tracking_State();
+
+    template <class Archive>
+    inline void serialize(Archive& archive, const unsigned int version)
+    {
+        using boost::serialization::make_nvp;
+        if (version)
+            {
+            };
+        archive& make_nvp("system", system);
+        archive& make_nvp("prn", prn);
+        archive& make_nvp("signal", signal);
+        archive& make_nvp("carrier_doppler_hz", carrier_doppler_hz);
+        archive& make_nvp("carrier_freq_hz", carrier_freq_hz);
+        archive& make_nvp("cn0_db_hz", cn0_db_hz);
+    }
+};
+
+
+/*!
+ * \brief State of the receiver saved periodically and on shutdown, and
+ * used as assistance (position, time, navigation data and Doppler shifts)
+ * when it starts again.
+ */
+class Gnss_Receiver_Snapshot
+{
+public:
+    int64_t save_utc_time;  //!< System time when the snapshot was taken [s since the Unix epoch]
+    bool pvt_valid;
+    double latitude_deg;
+    double longitude_deg;
+    double height_m;
+    std::map<int, Gps_Ephemeris> gps_ephemeris;
+    std::map<int, Galileo_Ephemeris> galileo_ephemeris;
+    std::map<int, Gps_Almanac> gps_almanac;
+    std::map<int, Galileo_Almanac> galileo_almanac;
+    std::vector<Gnss_Snapshot_Tracking_State> tracking_states;
+
+    Gnss_Receiver_Snapshot();
+
+    template <class Archive>
+    inline void serialize(Archive& archive, const unsigned int version)
+    {
+        using boost::serialization::make_nvp;
+        if (version)
+            {
+            };
+        archive& make_nvp("save_utc_time", save_utc_time);
+        archive& make_nvp("pvt_valid", pvt_valid);
+        archive& make_nvp("latitude_deg", latitude_deg);
+        archive& make_nvp("longitude_deg", longitude_deg);
+        archive& make_nvp("height_m", height_m);
+        archive& make_nvp("gps_ephemeris", gps_ephemeris);
+        archive& make_nvp("galileo_ephemeris", galileo_ephemeris);
+        archive& make_nvp("gps_almanac", gps_almanac);
+        archive& make_nvp("galileo_almanac", galileo_almanac);
+        archive& make_nvp("tracking_states", tracking_states);
+    }
+};
+
+#endif
@@ -0,0 +1,208 @@
+/*!
+ * \file gnss_sdr_binary_store.h
+ * \brief Compact binary persistence of the navigation data stores
+ *
+ * The ephemeris, almanac and iono/UTC stores are saved with a boost
+ * binary archive preceded by a format version and a tag. Files are
+ * replaced atomically, and they are memory-mapped for loading, which is
+ * much faster than parsing the XML files of full constellations.
+ * The archives use the byte order of the machine that wrote them.
+ *
+ * -------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2018  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *          Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_BINARY_STORE_H_
+#define GNSS_SDR_BINARY_STORE_H_
+
+#include <boost/archive/binary_iarchive.hpp>
+#include <boost/archive/binary_oarchive.hpp>
+#include <boost/serialization/map.hpp>
+#include <boost/serialization/string.hpp>
+#include <glog/logging.h>
+#include <cstdint>
+#include <cstdio>
+#include <exception>
+#include <fstream>
+#include <stdexcept>
+#include <streambuf>
+#include <string>
+#include <utility>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+const uint32_t GNSS_SDR_BINARY_STORE_VERSION = 1;  // increase when the layout of a stored class changes
+
+/*!
+ * \brief Name of the binary store that goes with an XML file:
+ * the .xml extension is replaced by .bin
+ */
+inline std::string gnss_sdr_binary_store_name(const std::string& xml_file_name)
+{
+    const std::string xml_ext(".xml");
+    if (xml_file_name.size() > xml_ext.size() and xml_file_name.compare(xml_file_name.size() - xml_ext.size(), xml_ext.size(), xml_ext) == 0)
+        {
+            return xml_file_name.substr(0, xml_file_name.size() - xml_ext.size()) + ".bin";
+        }
+    return xml_file_name + ".bin";
+}
+
+
+/*!
+ * \brief Returns true if the binary store exists and is not older than
+ * the XML file (which may have been edited or replaced by hand)
+ */
+inline bool gnss_sdr_binary_store_is_current(const std::string& binary_file_name, const std::string& xml_file_name)
+{
+    struct stat bin_stat;
+    if (stat(binary_file_name.c_str(), &bin_stat) != 0)
+        {
+            return false;
+        }
+    struct stat xml_stat;
+    if (stat(xml_file_name.c_str(), &xml_stat) != 0)
+        {
+            return true;
+        }
+    return bin_stat.st_mtime >= xml_stat.st_mtime;
+}
+
+
+/*!
+ * \brief Saves \p data into \p file_name. The file is written next to its
+ * final name and then renamed, so readers never see a partial file.
+ */
+template <class T>
+bool gnss_sdr_save_binary_store(const std::string& file_name, const std::string& tag, const T& data)
+{
+    const std::string tmp_file_name = file_name + ".tmp";
+    try
+        {
+            std::ofstream ofs(tmp_file_name.c_str(), std::ofstream::trunc | std::ofstream::out | std::ofstream::binary);
+            if (!ofs.is_open())
+                {
+                    LOG(WARNING) << "Cannot open " << tmp_file_name;
+                    return false;
+                }
+            {
+                boost::archive::binary_oarchive archive(ofs);
+                const uint32_t version = GNSS_SDR_BINARY_STORE_VERSION;
+                archive << version;
+                archive << tag;
+                archive << data;
+            }
+            ofs.close();
+            if (ofs.fail())
+                {
+                    throw std::runtime_error("write error");
+                }
+        }
+    catch (const std::exception& e)
+        {
+            LOG(WARNING) << "Failed to save " << file_name << ": " << e.what();
+            std::remove(tmp_file_name.c_str());
+            return false;
+        }
+    if (std::rename(tmp_file_name.c_str(), file_name.c_str()) != 0)
+        {
+            LOG(WARNING) << "Failed to replace " << file_name;
+            std::remove(tmp_file_name.c_str());
+            return false;
+        }
+    return true;
+}
+
+
+/*!
+ * \brief Read-only stream buffer over a memory-mapped file
+ */
+class Gnss_Sdr_Mapped_Streambuf : public std::streambuf
+{
+public:
+    Gnss_Sdr_Mapped_Streambuf(const char* data, std::size_t size)
+    {
+        char* begin = const_cast<char*>(data);
+        setg(begin, begin, begin + size);
+    }
+};
+
+
+/*!
+ * \brief Loads \p data from a binary store written by gnss_sdr_save_binary_store().
+ * \return false, leaving \p data untouched, if the file does not exist or
+ * its version or tag do not match.
+ */
+template <class T>
+bool gnss_sdr_load_binary_store(const std::string& file_name, const std::string& tag, T& data)
+{
+    int fd = open(file_name.c_str(), O_RDONLY);
+    if (fd < 0)
+        {
+            return false;
+        }
+    struct stat file_stat;
+    if (fstat(fd, &file_stat) != 0 or file_stat.st_size <= 0)
+        {
+            close(fd);
+            return false;
+        }
+    const std::size_t size = static_cast<std::size_t>(file_stat.st_size);
+    void* map = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (map == MAP_FAILED)
+        {
+            return false;
+        }
+    bool loaded = false;
+    try
+        {
+            Gnss_Sdr_Mapped_Streambuf buffer(static_cast<const char*>(map), size);
+            boost::archive::binary_iarchive archive(buffer);
+            uint32_t version = 0;
+            std::string stored_tag;
+            archive >> version;
+            archive >> stored_tag;
+            if (version == GNSS_SDR_BINARY_STORE_VERSION and stored_tag == tag)
+                {
+                    T stored_data;
+                    archive >> stored_data;
+                    data = std::move(stored_data);
+                    loaded = true;
+                }
+            else
+                {
+                    LOG(INFO) << "Ignoring " << file_name << ": version " << version << " and tag " << stored_tag;
+                }
+        }
+    catch (const std::exception& e)
+        {
+            LOG(WARNING) << "Failed to load " << file_name << ": " << e.what();
+        }
+    munmap(map, size);
+    return loaded;
+}
+
+#endif
@@ -44,30 +44,28 @@
 class Gnss_Synchro
 {
 public:
+    // The members are grouped by the stage that sets them, in the order in which
+    // the blocks downstream of tracking read them, and the groups are laid out
+    // so that the alignment padding is minimal. The acquisition results, only
+    // read when tracking starts, are kept at the end.
+
     // Satellite and signal info
     char System;         //!< Set by Channel::set_signal(Gnss_Signal gnss_signal)
     char Signal[3];      //!< Set by Channel::set_signal(Gnss_Signal gnss_signal)
     uint32_t PRN;        //!< Set by Channel::set_signal(Gnss_Signal gnss_signal)
     int32_t Channel_ID;  //!< Set by Channel constructor
 
-    // Acquisition
-    double Acq_delay_samples;          //!< Set by Acquisition processing block
-    double Acq_doppler_hz;             //!< Set by Acquisition processing block
-    uint64_t Acq_samplestamp_samples;  //!< Set by Acquisition processing block
-    uint32_t Acq_doppler_step;         //!< Set by Acquisition processing block
-    bool Flag_valid_acquisition;       //!< Set by Acquisition processing block
-
     // Tracking
+    int32_t correlation_length_ms;     //!< Set by Tracking processing block
     int64_t fs;                        //!< Set by Tracking processing block
     double Prompt_I;                   //!< Set by Tracking processing block
     double Prompt_Q;                   //!< Set by Tracking processing block
-    double CN0_dB_hz;                  //!< Set by Tracking processing block
+    double CN0_dB_hz;                  //!< Set by Tracking processing block (first estimated by the PCPS Acquisition)
     double Carrier_Doppler_hz;         //!< Set by Tracking processing block
     double Carrier_phase_rads;         //!< Set by Tracking processing block
     double Code_phase_samples;         //!< Set by Tracking processing block
     uint64_t Tracking_sample_counter;  //!< Set by Tracking processing block
     bool Flag_valid_symbol_output;     //!< Set by Tracking processing block
-    int32_t correlation_length_ms;     //!< Set by Tracking processing block
 
     // Telemetry Decoder
     bool Flag_valid_word;               //!< Set by Telemetry Decoder processing block
@@ -76,8 +74,17 @@ public:
     // Observables
     double Pseudorange_m;         //!< Set by Observables processing block
     double RX_time;               //!< Set by Observables processing block
-    bool Flag_valid_pseudorange;  //!< Set by Observables processing block
     double interp_TOW_ms;         //!< Set by Observables processing block
+    bool Flag_valid_pseudorange;  //!< Set by Observables processing block
+
+    // Acquisition
+    bool Flag_valid_acquisition;        //!< Set by Acquisition processing block
+    uint32_t Acq_doppler_step;          //!< Set by Acquisition processing block
+    double Acq_delay_samples;           //!< Set by Acquisition processing block
+    double Acq_doppler_hz;              //!< Set by Acquisition processing block
+    uint64_t Acq_samplestamp_samples;   //!< Set by Acquisition processing block
+    double Acq_doppler_aiding_hz;       //!< Predicted Doppler for the acquisition search. Set by the Flowgraph
+    double Acq_doppler_uncertainty_hz;  //!< Uncertainty of the predicted Doppler (0 if not available). Set by the Flowgraph
 
     /*!
      * \brief This member function serializes and restores
@@ -101,6 +108,8 @@ public:
         ar& BOOST_SERIALIZATION_NVP(Acq_samplestamp_samples);
         ar& BOOST_SERIALIZATION_NVP(Acq_doppler_step);
         ar& BOOST_SERIALIZATION_NVP(Flag_valid_acquisition);
+        ar& BOOST_SERIALIZATION_NVP(Acq_doppler_aiding_hz);
+        ar& BOOST_SERIALIZATION_NVP(Acq_doppler_uncertainty_hz);
         // Tracking
         ar& BOOST_SERIALIZATION_NVP(fs);
         ar& BOOST_SERIALIZATION_NVP(Prompt_I);
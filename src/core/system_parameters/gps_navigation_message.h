@@ -34,6 +34,7 @@
 
 
 #include "GPS_L1_CA.h"
+#include "gnss_packed_bits.h"
 #include "gps_almanac.h"
 #include "gps_ephemeris.h"
 #include "gps_iono.h"
@@ -54,9 +55,9 @@
 class Gps_Navigation_Message
 {
 private:
-    uint64_t read_navigation_unsigned(std::bitset<GPS_SUBFRAME_BITS> bits, const std::vector<std::pair<int32_t, int32_t>>& parameter);
-    int64_t read_navigation_signed(std::bitset<GPS_SUBFRAME_BITS> bits, const std::vector<std::pair<int32_t, int32_t>>& parameter);
-    bool read_navigation_bool(std::bitset<GPS_SUBFRAME_BITS> bits, const std::vector<std::pair<int32_t, int32_t>>& parameter);
+    uint64_t read_navigation_unsigned(const Gnss_Packed_Bits& bits, const std::vector<std::pair<int32_t, int32_t>>& parameter);
+    int64_t read_navigation_signed(const Gnss_Packed_Bits& bits, const std::vector<std::pair<int32_t, int32_t>>& parameter);
+    bool read_navigation_bool(const Gnss_Packed_Bits& bits, const std::vector<std::pair<int32_t, int32_t>>& parameter);
     void print_gps_word_bytes(uint32_t GPS_word);
 
 public:
@@ -0,0 +1,73 @@
+/*!
+ * \file pvt_status.h
+ * \brief Status of the receiver channels and of its last position,
+ * published by the PVT block for the telecommand interface
+ *
+ * -------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2019  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *          Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_PVT_STATUS_H_
+#define GNSS_SDR_PVT_STATUS_H_
+
+#include <cstdint>
+#include <ctime>
+#include <string>
+#include <vector>
+
+
+/*!
+ * \brief A channel with a valid pseudorange in the last epoch.
+ */
+struct Pvt_Channel_Status
+{
+    int32_t channel_id;
+    char system;
+    uint32_t prn;
+    std::string signal;
+    double cn0_db_hz;
+    double carrier_doppler_hz;
+    bool used_in_pvt;  // its ephemeris is known
+};
+
+
+/*!
+ * \brief Copy of the PVT state, never modified once published, so that
+ * it can be read from any thread without locking the PVT block.
+ */
+struct Pvt_Status
+{
+    double rx_time_s = 0.0;  // receiver time of the last epoch
+    bool valid_position = false;
+    double latitude_deg = 0.0;
+    double longitude_deg = 0.0;
+    double height_m = 0.0;
+    double ground_speed_kmh = 0.0;
+    double course_over_ground_deg = 0.0;
+    time_t utc_time = 0;
+    int valid_observations = 0;  // used in the position
+    std::vector<Pvt_Channel_Status> channels;
+};
+
+#endif
@@ -46,14 +46,14 @@
 using google::LogMessage;
 
 
-Rtcm::Rtcm(uint16_t port)
+Rtcm::Rtcm(uint16_t port, const std::string& ntrip_mountpoint)
 {
     RTCM_port = port;
     preamble = std::bitset<8>("11010011");
     reserved_field = std::bitset<6>("000000");
-    rtcm_message_queue = std::make_shared<concurrent_queue<std::string> >();
+    rtcm_message_queue = std::make_shared<concurrent_ring_queue<std::string> >();
     boost::asio::ip::tcp::endpoint endpoint(boost::asio::ip::tcp::v4(), RTCM_port);
-    servers.emplace_back(io_context, endpoint);
+    servers.emplace_back(io_context, endpoint, ntrip_mountpoint);
     server_is_running = false;
 }
 
@@ -88,7 +88,7 @@ void Rtcm::run_server()
     std::cout << "Starting a TCP/IP server of RTCM messages on port " << RTCM_port << std::endl;
     try
         {
-            std::thread tq([&] { std::make_shared<Queue_Reader>(io_context, rtcm_message_queue, RTCM_port)->do_read_queue(); });
+            std::thread tq([&] { std::make_shared<Queue_Reader>(io_context, rtcm_message_queue, servers.front().room())->do_read_queue(); });
             tq.detach();
 
             std::thread t([&] { io_context.run(); });
@@ -111,7 +111,10 @@ void Rtcm::stop_service()
 void Rtcm::stop_server()
 {
     std::cout << "Stopping TCP/IP server on port " << RTCM_port << std::endl;
-    rtcm_message_queue->push("Goodbye");  // this terminates tq
+    while (!rtcm_message_queue->push(std::string("Goodbye")))  // this terminates tq
+        {
+            std::this_thread::yield();
+        }
     Rtcm::stop_service();
     servers.front().close_server();
     std::this_thread::sleep_for(std::chrono::seconds(1));
@@ -121,7 +124,11 @@ void Rtcm::stop_server()
 
 void Rtcm::send_message(const std::string& msg)
 {
-    rtcm_message_queue->push(msg);
+    // never blocks the caller (the PVT thread)
+    if (!rtcm_message_queue->push(std::string(msg)))
+        {
+            LOG(WARNING) << "RTCM message queue full, message dropped";
+        }
 }
 
 
@@ -137,26 +144,6 @@ bool Rtcm::is_server_running() const
 //
 // *****************************************************************************************************
 
-std::string Rtcm::add_CRC(const std::string& message_without_crc) const
-{
-    // ******  Computes Qualcomm CRC-24Q ******
-    boost::crc_optimal<24, 0x1864CFBu, 0x0, 0x0, false, false> CRC_RTCM;
-    // 1) Converts the string to a vector of uint8_t:
-    boost::dynamic_bitset<uint8_t> frame_bits(message_without_crc);
-    std::vector<uint8_t> bytes;
-    boost::to_block_range(frame_bits, std::back_inserter(bytes));
-    std::reverse(bytes.begin(), bytes.end());
-
-    // 2) Computes CRC
-    CRC_RTCM.process_bytes(bytes.data(), bytes.size());
-    std::bitset<24> crc_frame = std::bitset<24>(CRC_RTCM.checksum());
-
-    // 3) Builds the complete message
-    std::string complete_message = message_without_crc + crc_frame.to_string();
-    return bin_to_binary_data(complete_message);
-}
-
-
 bool Rtcm::check_CRC(const std::string& message) const
 {
     boost::crc_optimal<24, 0x1864CFBu, 0x0, 0x0, false, false> CRC_RTCM_CHECK;
@@ -408,17 +395,9 @@ int64_t Rtcm::hex_to_int(const std::string& s) const
 
 std::string Rtcm::build_message(const std::string& data) const
 {
-    uint32_t msg_length_bits = data.length();
-    uint32_t msg_length_bytes = std::ceil(static_cast<float>(msg_length_bits) / 8.0);
-    std::bitset<10> message_length = std::bitset<10>(msg_length_bytes);
-    uint32_t zeros_to_fill = 8 * msg_length_bytes - msg_length_bits;
-    std::string b(zeros_to_fill, '0');
-    std::string msg_content = data + b;
-    std::string msg_without_crc = preamble.to_string() +
-                                  reserved_field.to_string() +
-                                  message_length.to_string() +
-                                  msg_content;
-    return Rtcm::add_CRC(msg_without_crc);
+    Rtcm_Bit_Writer writer;
+    writer.put_bits(data);
+    return writer.frame();
 }
 
 
@@ -521,7 +500,7 @@ std::string Rtcm::print_MT1001(const Gps_Ephemeris& gps_eph, double obs_time, co
     std::string msg = build_message(data);
     if (server_is_running)
         {
-            rtcm_message_queue->push(msg);
+            Rtcm::send_message(msg);
         }
     return msg;
 }
@@ -570,7 +549,7 @@ std::string Rtcm::print_MT1002(const Gps_Ephemeris& gps_eph, double obs_time, co
     std::string msg = build_message(data);
     if (server_is_running)
         {
-            rtcm_message_queue->push(msg);
+            Rtcm::send_message(msg);
         }
     return msg;
 }
@@ -673,7 +652,7 @@ std::string Rtcm::print_MT1003(const Gps_Ephemeris& ephL1, const Gps_CNAV_Epheme
     std::string msg = build_message(data);
     if (server_is_running)
         {
-            rtcm_message_queue->push(msg);
+            Rtcm::send_message(msg);
         }
     return msg;
 }
@@ -782,7 +761,7 @@ std::string Rtcm::print_MT1004(const Gps_Ephemeris& ephL1, const Gps_CNAV_Epheme
     std::string msg = build_message(data);
     if (server_is_running)
         {
-            rtcm_message_queue->push(msg);
+            Rtcm::send_message(msg);
         }
     return msg;
 }
@@ -917,7 +896,7 @@ std::string Rtcm::print_MT1005(uint32_t ref_id, double ecef_x, double ecef_y, do
     std::string msg = build_message(data);
     if (server_is_running)
         {
-            rtcm_message_queue->push(msg);
+            Rtcm::send_message(msg);
         }
     return msg;
 }
@@ -1040,7 +1019,7 @@ std::string Rtcm::print_MT1006(uint32_t ref_id, double ecef_x, double ecef_y, do
     std::string msg = build_message(data);
     if (server_is_running)
         {
-            rtcm_message_queue->push(msg);
+            Rtcm::send_message(msg);
         }
     return msg;
 }
@@ -1103,7 +1082,7 @@ std::string Rtcm::print_MT1008(uint32_t ref_id, const std::string& antenna_descr
     std::string msg = build_message(data);
     if (server_is_running)
         {
-            rtcm_message_queue->push(msg);
+            Rtcm::send_message(msg);
         }
     return msg;
 }
@@ -1202,7 +1181,7 @@ std::string Rtcm::print_MT1009(const Glonass_Gnav_Ephemeris& glonass_gnav_eph, d
     std::string msg = build_message(data);
     if (server_is_running)
         {
-            rtcm_message_queue->push(msg);
+            Rtcm::send_message(msg);
         }
     return msg;
 }
@@ -1251,7 +1230,7 @@ std::string Rtcm::print_MT1010(const Glonass_Gnav_Ephemeris& glonass_gnav_eph, d
     std::string msg = build_message(data);
     if (server_is_running)
         {
-            rtcm_message_queue->push(msg);
+            Rtcm::send_message(msg);
         }
     return msg;
 }
@@ -1358,7 +1337,7 @@ std::string Rtcm::print_MT1011(const Glonass_Gnav_Ephemeris& ephL1, const Glonas
     std::string msg = build_message(data);
     if (server_is_running)
         {
-            rtcm_message_queue->push(msg);
+            Rtcm::send_message(msg);
         }
     return msg;
 }
@@ -1469,7 +1448,7 @@ std::string Rtcm::print_MT1012(const Glonass_Gnav_Ephemeris& ephL1, const Glonas
     std::string msg = build_message(data);
     if (server_is_running)
         {
-            rtcm_message_queue->push(msg);
+            Rtcm::send_message(msg);
         }
     return msg;
 }
@@ -1553,49 +1532,48 @@ std::string Rtcm::print_MT1019(const Gps_Ephemeris& gps_eph)
     Rtcm::set_DF103(gps_eph);
     Rtcm::set_DF137(gps_eph);
 
-    std::string data;
-    data.clear();
-    data = DF002.to_string() +
-           DF009.to_string() +
-           DF076.to_string() +
-           DF077.to_string() +
-           DF078.to_string() +
-           DF079.to_string() +
-           DF071.to_string() +
-           DF081.to_string() +
-           DF082.to_string() +
-           DF083.to_string() +
-           DF084.to_string() +
-           DF085.to_string() +
-           DF086.to_string() +
-           DF087.to_string() +
-           DF088.to_string() +
-           DF089.to_string() +
-           DF090.to_string() +
-           DF091.to_string() +
-           DF092.to_string() +
-           DF093.to_string() +
-           DF094.to_string() +
-           DF095.to_string() +
-           DF096.to_string() +
-           DF097.to_string() +
-           DF098.to_string() +
-           DF099.to_string() +
-           DF100.to_string() +
-           DF101.to_string() +
-           DF102.to_string() +
-           DF103.to_string() +
-           DF137.to_string();
-
-    if (data.length() != 488)
-        {
-            LOG(WARNING) << "Bad-formatted RTCM MT1019 (488 bits expected, found " << data.length() << ")";
-        }
-
-    std::string msg = build_message(data);
+    Rtcm_Bit_Writer writer;
+    writer.put(DF002);
+    writer.put(DF009);
+    writer.put(DF076);
+    writer.put(DF077);
+    writer.put(DF078);
+    writer.put(DF079);
+    writer.put(DF071);
+    writer.put(DF081);
+    writer.put(DF082);
+    writer.put(DF083);
+    writer.put(DF084);
+    writer.put(DF085);
+    writer.put(DF086);
+    writer.put(DF087);
+    writer.put(DF088);
+    writer.put(DF089);
+    writer.put(DF090);
+    writer.put(DF091);
+    writer.put(DF092);
+    writer.put(DF093);
+    writer.put(DF094);
+    writer.put(DF095);
+    writer.put(DF096);
+    writer.put(DF097);
+    writer.put(DF098);
+    writer.put(DF099);
+    writer.put(DF100);
+    writer.put(DF101);
+    writer.put(DF102);
+    writer.put(DF103);
+    writer.put(DF137);
+
+    if (writer.size_bits() != 488)
+        {
+            LOG(WARNING) << "Bad-formatted RTCM MT1019 (488 bits expected, found " << writer.size_bits() << ")";
+        }
+
+    std::string msg = writer.frame();
     if (server_is_running)
         {
-            rtcm_message_queue->push(msg);
+            Rtcm::send_message(msg);
         }
     return msg;
 }
@@ -1780,55 +1758,54 @@ std::string Rtcm::print_MT1020(const Glonass_Gnav_Ephemeris& glonass_gnav_eph, c
     Rtcm::set_DF135(glonass_gnav_utc_model);
     Rtcm::set_DF136(glonass_gnav_eph);
 
-    std::string data;
-    data.clear();
-    data = DF002.to_string() +
-           DF038.to_string() +
-           DF040.to_string() +
-           DF104.to_string() +
-           DF105.to_string() +
-           DF106.to_string() +
-           DF107.to_string() +
-           DF108.to_string() +
-           DF109.to_string() +
-           DF110.to_string() +
-           DF111.to_string() +
-           DF112.to_string() +
-           DF113.to_string() +
-           DF114.to_string() +
-           DF115.to_string() +
-           DF116.to_string() +
-           DF117.to_string() +
-           DF118.to_string() +
-           DF119.to_string() +
-           DF120.to_string() +
-           DF121.to_string() +
-           DF122.to_string() +
-           DF123.to_string() +
-           DF124.to_string() +
-           DF125.to_string() +
-           DF126.to_string() +
-           DF127.to_string() +
-           DF128.to_string() +
-           DF129.to_string() +
-           DF130.to_string() +
-           DF131.to_string() +
-           DF132.to_string() +
-           DF133.to_string() +
-           DF134.to_string() +
-           DF135.to_string() +
-           DF136.to_string() +
-           std::bitset<7>().to_string();  // Reserved bits
-
-    if (data.length() != 360)
-        {
-            LOG(WARNING) << "Bad-formatted RTCM MT1020 (360 bits expected, found " << data.length() << ")";
-        }
-
-    std::string msg = build_message(data);
+    Rtcm_Bit_Writer writer;
+    writer.put(DF002);
+    writer.put(DF038);
+    writer.put(DF040);
+    writer.put(DF104);
+    writer.put(DF105);
+    writer.put(DF106);
+    writer.put(DF107);
+    writer.put(DF108);
+    writer.put(DF109);
+    writer.put(DF110);
+    writer.put(DF111);
+    writer.put(DF112);
+    writer.put(DF113);
+    writer.put(DF114);
+    writer.put(DF115);
+    writer.put(DF116);
+    writer.put(DF117);
+    writer.put(DF118);
+    writer.put(DF119);
+    writer.put(DF120);
+    writer.put(DF121);
+    writer.put(DF122);
+    writer.put(DF123);
+    writer.put(DF124);
+    writer.put(DF125);
+    writer.put(DF126);
+    writer.put(DF127);
+    writer.put(DF128);
+    writer.put(DF129);
+    writer.put(DF130);
+    writer.put(DF131);
+    writer.put(DF132);
+    writer.put(DF133);
+    writer.put(DF134);
+    writer.put(DF135);
+    writer.put(DF136);
+    writer.put(0, 7);  // Reserved bits
+
+    if (writer.size_bits() != 360)
+        {
+            LOG(WARNING) << "Bad-formatted RTCM MT1020 (360 bits expected, found " << writer.size_bits() << ")";
+        }
+
+    std::string msg = writer.frame();
     if (server_is_running)
         {
-            rtcm_message_queue->push(msg);
+            Rtcm::send_message(msg);
         }
     return msg;
 }
@@ -2056,7 +2033,7 @@ std::string Rtcm::print_MT1029(uint32_t ref_id, const Gps_Ephemeris& gps_eph, do
     std::string msg = build_message(data);
     if (server_is_running)
         {
-            rtcm_message_queue->push(msg);
+            Rtcm::send_message(msg);
         }
     return msg;
 }
@@ -2102,47 +2079,46 @@ std::string Rtcm::print_MT1045(const Galileo_Ephemeris& gal_eph)
     uint32_t seven_zero = 0;
     std::bitset<7> DF001_ = std::bitset<7>(seven_zero);
 
-    std::string data;
-    data.clear();
-    data = DF002.to_string() +
-           DF252.to_string() +
-           DF289.to_string() +
-           DF290.to_string() +
-           DF291.to_string() +
-           DF292.to_string() +
-           DF293.to_string() +
-           DF294.to_string() +
-           DF295.to_string() +
-           DF296.to_string() +
-           DF297.to_string() +
-           DF298.to_string() +
-           DF299.to_string() +
-           DF300.to_string() +
-           DF301.to_string() +
-           DF302.to_string() +
-           DF303.to_string() +
-           DF304.to_string() +
-           DF305.to_string() +
-           DF306.to_string() +
-           DF307.to_string() +
-           DF308.to_string() +
-           DF309.to_string() +
-           DF310.to_string() +
-           DF311.to_string() +
-           DF312.to_string() +
-           DF314.to_string() +
-           DF315.to_string() +
-           DF001_.to_string();
-
-    if (data.length() != 496)
-        {
-            LOG(WARNING) << "Bad-formatted RTCM MT1045 (496 bits expected, found " << data.length() << ")";
-        }
-
-    std::string msg = build_message(data);
+    Rtcm_Bit_Writer writer;
+    writer.put(DF002);
+    writer.put(DF252);
+    writer.put(DF289);
+    writer.put(DF290);
+    writer.put(DF291);
+    writer.put(DF292);
+    writer.put(DF293);
+    writer.put(DF294);
+    writer.put(DF295);
+    writer.put(DF296);
+    writer.put(DF297);
+    writer.put(DF298);
+    writer.put(DF299);
+    writer.put(DF300);
+    writer.put(DF301);
+    writer.put(DF302);
+    writer.put(DF303);
+    writer.put(DF304);
+    writer.put(DF305);
+    writer.put(DF306);
+    writer.put(DF307);
+    writer.put(DF308);
+    writer.put(DF309);
+    writer.put(DF310);
+    writer.put(DF311);
+    writer.put(DF312);
+    writer.put(DF314);
+    writer.put(DF315);
+    writer.put(DF001_);
+
+    if (writer.size_bits() != 496)
+        {
+            LOG(WARNING) << "Bad-formatted RTCM MT1045 (496 bits expected, found " << writer.size_bits() << ")";
+        }
+
+    std::string msg = writer.frame();
     if (server_is_running)
         {
-            rtcm_message_queue->push(msg);
+            Rtcm::send_message(msg);
         }
     return msg;
 }
@@ -2301,7 +2277,9 @@ std::string Rtcm::print_MSM_1(const Gps_Ephemeris& gps_eph,
             msg_number = 1071;
         }
 
-    std::string header = Rtcm::get_MSM_header(msg_number,
+    Rtcm_Bit_Writer writer;
+    Rtcm::write_MSM_header(writer,
+        msg_number,
         obs_time,
         observables,
         ref_id,
@@ -2311,22 +2289,23 @@ std::string Rtcm::print_MSM_1(const Gps_Ephemeris& gps_eph,
         divergence_free,
         more_messages);
 
-    std::string sat_data = Rtcm::get_MSM_1_content_sat_data(observables);
+    Rtcm::write_MSM_1_content_sat_data(writer, observables);
 
-    std::string signal_data = Rtcm::get_MSM_1_content_signal_data(observables);
+    Rtcm::write_MSM_1_content_signal_data(writer, observables);
 
-    std::string message = build_message(header + sat_data + signal_data);
+    std::string message = writer.frame();
 
     if (server_is_running)
         {
-            rtcm_message_queue->push(message);
+            Rtcm::send_message(message);
         }
 
     return message;
 }
 
 
-std::string Rtcm::get_MSM_header(uint32_t msg_number,
+void Rtcm::write_MSM_header(Rtcm_Bit_Writer& writer,
+    uint32_t msg_number,
     double obs_time,
     const std::map<int32_t, Gnss_Synchro>& observables,
     uint32_t ref_id,
@@ -2344,7 +2323,6 @@ std::string Rtcm::get_MSM_header(uint32_t msg_number,
     Rtcm::set_DF003(ref_id);
     Rtcm::set_DF393(more_messages);
     Rtcm::set_DF409(0);  // Issue of Data Station. 0: not utilized
-    std::bitset<7> DF001_ = std::bitset<7>("0000000");
     Rtcm::set_DF411(clock_steering_indicator);
     Rtcm::set_DF412(external_clock_indicator);
     Rtcm::set_DF417(divergence_free);
@@ -2353,41 +2331,37 @@ std::string Rtcm::get_MSM_header(uint32_t msg_number,
     Rtcm::set_DF394(observables);
     Rtcm::set_DF395(observables);
 
-    std::string header = DF002.to_string() + DF003.to_string();
+    writer.put(DF002);
+    writer.put(DF003);
     // GNSS Epoch Time Specific to each constellation
     if ((sys == "R"))
         {
             // GLONASS Epoch Time
             Rtcm::set_DF034(obs_time);
-            header += DF034.to_string();
+            writer.put(DF034);
         }
     else
         {
             // GPS, Galileo Epoch Time
             Rtcm::set_DF004(obs_time);
-            header += DF004.to_string();
+            writer.put(DF004);
         }
 
-    header = header + DF393.to_string() +
-             DF409.to_string() +
-             DF001_.to_string() +
-             DF411.to_string() +
-             DF417.to_string() +
-             DF412.to_string() +
-             DF418.to_string() +
-             DF394.to_string() +
-             DF395.to_string() +
-             Rtcm::set_DF396(observables);
-
-    return header;
+    writer.put(DF393);
+    writer.put(DF409);
+    writer.put(0, 7);  // DF001, reserved
+    writer.put(DF411);
+    writer.put(DF417);
+    writer.put(DF412);
+    writer.put(DF418);
+    writer.put(DF394);
+    writer.put(DF395);
+    writer.put_bits(Rtcm::set_DF396(observables));  // cell mask, up to 64 bits
 }
 
 
-std::string Rtcm::get_MSM_1_content_sat_data(const std::map<int32_t, Gnss_Synchro>& observables)
+void Rtcm::write_MSM_1_content_sat_data(Rtcm_Bit_Writer& writer, const std::map<int32_t, Gnss_Synchro>& observables)
 {
-    std::string sat_data;
-    sat_data.clear();
-
     Rtcm::set_DF394(observables);
     uint32_t num_satellites = DF394.count();
 
@@ -2413,17 +2387,13 @@ std::string Rtcm::get_MSM_1_content_sat_data(const std::map<int32_t, Gnss_Synchr
     for (uint32_t nsat = 0; nsat < num_satellites; nsat++)
         {
             Rtcm::set_DF398(ordered_by_PRN_pos.at(nsat).second);
-            sat_data += DF398.to_string();
+            writer.put(DF398);
         }
-
-    return sat_data;
 }
 
 
-std::string Rtcm::get_MSM_1_content_signal_data(const std::map<int32_t, Gnss_Synchro>& observables)
+void Rtcm::write_MSM_1_content_signal_data(Rtcm_Bit_Writer& writer, const std::map<int32_t, Gnss_Synchro>& observables)
 {
-    std::string signal_data;
-    signal_data.clear();
     uint32_t Ncells = observables.size();
 
     std::vector<std::pair<int32_t, Gnss_Synchro> > observables_vector;
@@ -2443,10 +2413,8 @@ std::string Rtcm::get_MSM_1_content_signal_data(const std::map<int32_t, Gnss_Syn
     for (uint32_t cell = 0; cell < Ncells; cell++)
         {
             Rtcm::set_DF400(ordered_by_PRN_pos.at(cell).second);
-            signal_data += DF400.to_string();
+            writer.put(DF400);
         }
-
-    return signal_data;
 }
 
 
@@ -2484,7 +2452,9 @@ std::string Rtcm::print_MSM_2(const Gps_Ephemeris& gps_eph,
             msg_number = 1072;
         }
 
-    std::string header = Rtcm::get_MSM_header(msg_number,
+    Rtcm_Bit_Writer writer;
+    Rtcm::write_MSM_header(writer,
+        msg_number,
         obs_time,
         observables,
         ref_id,
@@ -2494,33 +2464,31 @@ std::string Rtcm::print_MSM_2(const Gps_Ephemeris& gps_eph,
         divergence_free,
         more_messages);
 
-    std::string sat_data = Rtcm::get_MSM_1_content_sat_data(observables);
+    Rtcm::write_MSM_1_content_sat_data(writer, observables);
 
-    std::string signal_data = Rtcm::get_MSM_2_content_signal_data(gps_eph, gps_cnav_eph, gal_eph, glo_gnav_eph, obs_time, observables);
+    Rtcm::write_MSM_2_content_signal_data(writer, gps_eph, gps_cnav_eph, gal_eph, glo_gnav_eph, obs_time, observables);
 
-    std::string message = build_message(header + sat_data + signal_data);
+    std::string message = writer.frame();
     if (server_is_running)
         {
-            rtcm_message_queue->push(message);
+            Rtcm::send_message(message);
         }
 
     return message;
 }
 
 
-std::string Rtcm::get_MSM_2_content_signal_data(const Gps_Ephemeris& ephNAV,
+void Rtcm::write_MSM_2_content_signal_data(Rtcm_Bit_Writer& writer, const Gps_Ephemeris& ephNAV,
     const Gps_CNAV_Ephemeris& ephCNAV,
     const Galileo_Ephemeris& ephFNAV,
     const Glonass_Gnav_Ephemeris& ephGNAV,
     double obs_time,
     const std::map<int32_t, Gnss_Synchro>& observables)
 {
-    std::string signal_data;
-    std::string first_data_type;
-    std::string second_data_type;
-    std::string third_data_type;
-
     uint32_t Ncells = observables.size();
+    std::vector<uint64_t> first_data_type(Ncells);
+    std::vector<uint64_t> second_data_type(Ncells);
+    std::vector<uint64_t> third_data_type(Ncells);
 
     std::vector<std::pair<int32_t, Gnss_Synchro> > observables_vector;
     std::map<int32_t, Gnss_Synchro>::const_iterator map_iter;
@@ -2541,13 +2509,23 @@ std::string Rtcm::get_MSM_2_content_signal_data(const Gps_Ephemeris& ephNAV,
             Rtcm::set_DF401(ordered_by_PRN_pos.at(cell).second);
             Rtcm::set_DF402(ephNAV, ephCNAV, ephFNAV, ephGNAV, obs_time, ordered_by_PRN_pos.at(cell).second);
             Rtcm::set_DF420(ordered_by_PRN_pos.at(cell).second);
-            first_data_type += DF401.to_string();
-            second_data_type += DF402.to_string();
-            third_data_type += DF420.to_string();
+            first_data_type[cell] = DF401.to_ullong();
+            second_data_type[cell] = DF402.to_ullong();
+            third_data_type[cell] = DF420.to_ullong();
         }
 
-    signal_data = first_data_type + second_data_type + third_data_type;
-    return signal_data;
+    for (uint32_t i = 0; i < Ncells; i++)
+        {
+            writer.put(first_data_type[i], DF401.size());
+        }
+    for (uint32_t i = 0; i < Ncells; i++)
+        {
+            writer.put(second_data_type[i], DF402.size());
+        }
+    for (uint32_t i = 0; i < Ncells; i++)
+        {
+            writer.put(third_data_type[i], DF420.size());
+        }
 }
 
 
@@ -2585,7 +2563,9 @@ std::string Rtcm::print_MSM_3(const Gps_Ephemeris& gps_eph,
             msg_number = 1073;
         }
 
-    std::string header = Rtcm::get_MSM_header(msg_number,
+    Rtcm_Bit_Writer writer;
+    Rtcm::write_MSM_header(writer,
+        msg_number,
         obs_time,
         observables,
         ref_id,
@@ -2595,34 +2575,32 @@ std::string Rtcm::print_MSM_3(const Gps_Ephemeris& gps_eph,
         divergence_free,
         more_messages);
 
-    std::string sat_data = Rtcm::get_MSM_1_content_sat_data(observables);
+    Rtcm::write_MSM_1_content_sat_data(writer, observables);
 
-    std::string signal_data = Rtcm::get_MSM_3_content_signal_data(gps_eph, gps_cnav_eph, gal_eph, glo_gnav_eph, obs_time, observables);
+    Rtcm::write_MSM_3_content_signal_data(writer, gps_eph, gps_cnav_eph, gal_eph, glo_gnav_eph, obs_time, observables);
 
-    std::string message = build_message(header + sat_data + signal_data);
+    std::string message = writer.frame();
     if (server_is_running)
         {
-            rtcm_message_queue->push(message);
+            Rtcm::send_message(message);
         }
 
     return message;
 }
 
 
-std::string Rtcm::get_MSM_3_content_signal_data(const Gps_Ephemeris& ephNAV,
+void Rtcm::write_MSM_3_content_signal_data(Rtcm_Bit_Writer& writer, const Gps_Ephemeris& ephNAV,
     const Gps_CNAV_Ephemeris& ephCNAV,
     const Galileo_Ephemeris& ephFNAV,
     const Glonass_Gnav_Ephemeris& ephGNAV,
     double obs_time,
     const std::map<int32_t, Gnss_Synchro>& observables)
 {
-    std::string signal_data;
-    std::string first_data_type;
-    std::string second_data_type;
-    std::string third_data_type;
-    std::string fourth_data_type;
-
     uint32_t Ncells = observables.size();
+    std::vector<uint64_t> first_data_type(Ncells);
+    std::vector<uint64_t> second_data_type(Ncells);
+    std::vector<uint64_t> third_data_type(Ncells);
+    std::vector<uint64_t> fourth_data_type(Ncells);
 
     std::vector<std::pair<int32_t, Gnss_Synchro> > observables_vector;
     std::map<int32_t, Gnss_Synchro>::const_iterator map_iter;
@@ -2644,14 +2622,28 @@ std::string Rtcm::get_MSM_3_content_signal_data(const Gps_Ephemeris& ephNAV,
             Rtcm::set_DF401(ordered_by_PRN_pos.at(cell).second);
             Rtcm::set_DF402(ephNAV, ephCNAV, ephFNAV, ephGNAV, obs_time, ordered_by_PRN_pos.at(cell).second);
             Rtcm::set_DF420(ordered_by_PRN_pos.at(cell).second);
-            first_data_type += DF400.to_string();
-            second_data_type += DF401.to_string();
-            third_data_type += DF402.to_string();
-            fourth_data_type += DF420.to_string();
+            first_data_type[cell] = DF400.to_ullong();
+            second_data_type[cell] = DF401.to_ullong();
+            third_data_type[cell] = DF402.to_ullong();
+            fourth_data_type[cell] = DF420.to_ullong();
         }
 
-    signal_data = first_data_type + second_data_type + third_data_type + fourth_data_type;
-    return signal_data;
+    for (uint32_t i = 0; i < Ncells; i++)
+        {
+            writer.put(first_data_type[i], DF400.size());
+        }
+    for (uint32_t i = 0; i < Ncells; i++)
+        {
+            writer.put(second_data_type[i], DF401.size());
+        }
+    for (uint32_t i = 0; i < Ncells; i++)
+        {
+            writer.put(third_data_type[i], DF402.size());
+        }
+    for (uint32_t i = 0; i < Ncells; i++)
+        {
+            writer.put(fourth_data_type[i], DF420.size());
+        }
 }
 
 
@@ -2689,7 +2681,9 @@ std::string Rtcm::print_MSM_4(const Gps_Ephemeris& gps_eph,
             msg_number = 1074;
         }
 
-    std::string header = Rtcm::get_MSM_header(msg_number,
+    Rtcm_Bit_Writer writer;
+    Rtcm::write_MSM_header(writer,
+        msg_number,
         obs_time,
         observables,
         ref_id,
@@ -2699,28 +2693,26 @@ std::string Rtcm::print_MSM_4(const Gps_Ephemeris& gps_eph,
         divergence_free,
         more_messages);
 
-    std::string sat_data = Rtcm::get_MSM_4_content_sat_data(observables);
+    Rtcm::write_MSM_4_content_sat_data(writer, observables);
 
-    std::string signal_data = Rtcm::get_MSM_4_content_signal_data(gps_eph, gps_cnav_eph, gal_eph, glo_gnav_eph, obs_time, observables);
+    Rtcm::write_MSM_4_content_signal_data(writer, gps_eph, gps_cnav_eph, gal_eph, glo_gnav_eph, obs_time, observables);
 
-    std::string message = build_message(header + sat_data + signal_data);
+    std::string message = writer.frame();
     if (server_is_running)
         {
-            rtcm_message_queue->push(message);
+            Rtcm::send_message(message);
         }
 
     return message;
 }
 
 
-std::string Rtcm::get_MSM_4_content_sat_data(const std::map<int32_t, Gnss_Synchro>& observables)
+void Rtcm::write_MSM_4_content_sat_data(Rtcm_Bit_Writer& writer, const std::map<int32_t, Gnss_Synchro>& observables)
 {
-    std::string sat_data;
-    std::string first_data_type;
-    std::string second_data_type;
-
     Rtcm::set_DF394(observables);
     uint32_t num_satellites = DF394.count();
+    std::vector<uint64_t> first_data_type(num_satellites);
+    std::vector<uint64_t> second_data_type(num_satellites);
 
     std::vector<std::pair<int32_t, Gnss_Synchro> > observables_vector;
     std::map<int32_t, Gnss_Synchro>::const_iterator gnss_synchro_iter;
@@ -2745,29 +2737,33 @@ std::string Rtcm::get_MSM_4_content_sat_data(const std::map<int32_t, Gnss_Synchr
         {
             Rtcm::set_DF397(ordered_by_PRN_pos.at(nsat).second);
             Rtcm::set_DF398(ordered_by_PRN_pos.at(nsat).second);
-            first_data_type += DF397.to_string();
-            second_data_type += DF398.to_string();
+            first_data_type[nsat] = DF397.to_ullong();
+            second_data_type[nsat] = DF398.to_ullong();
+        }
+    for (uint32_t i = 0; i < num_satellites; i++)
+        {
+            writer.put(first_data_type[i], DF397.size());
+        }
+    for (uint32_t i = 0; i < num_satellites; i++)
+        {
+            writer.put(second_data_type[i], DF398.size());
         }
-    sat_data = first_data_type + second_data_type;
-    return sat_data;
 }
 
 
-std::string Rtcm::get_MSM_4_content_signal_data(const Gps_Ephemeris& ephNAV,
+void Rtcm::write_MSM_4_content_signal_data(Rtcm_Bit_Writer& writer, const Gps_Ephemeris& ephNAV,
     const Gps_CNAV_Ephemeris& ephCNAV,
     const Galileo_Ephemeris& ephFNAV,
     const Glonass_Gnav_Ephemeris& ephGNAV,
     double obs_time,
     const std::map<int32_t, Gnss_Synchro>& observables)
 {
-    std::string signal_data;
-    std::string first_data_type;
-    std::string second_data_type;
-    std::string third_data_type;
-    std::string fourth_data_type;
-    std::string fifth_data_type;
-
     uint32_t Ncells = observables.size();
+    std::vector<uint64_t> first_data_type(Ncells);
+    std::vector<uint64_t> second_data_type(Ncells);
+    std::vector<uint64_t> third_data_type(Ncells);
+    std::vector<uint64_t> fourth_data_type(Ncells);
+    std::vector<uint64_t> fifth_data_type(Ncells);
 
     std::vector<std::pair<int32_t, Gnss_Synchro> > observables_vector;
     std::map<int32_t, Gnss_Synchro>::const_iterator map_iter;
@@ -2790,15 +2786,33 @@ std::string Rtcm::get_MSM_4_content_signal_data(const Gps_Ephemeris& ephNAV,
             Rtcm::set_DF402(ephNAV, ephCNAV, ephFNAV, ephGNAV, obs_time, ordered_by_PRN_pos.at(cell).second);
             Rtcm::set_DF420(ordered_by_PRN_pos.at(cell).second);
             Rtcm::set_DF403(ordered_by_PRN_pos.at(cell).second);
-            first_data_type += DF400.to_string();
-            second_data_type += DF401.to_string();
-            third_data_type += DF402.to_string();
-            fourth_data_type += DF420.to_string();
-            fifth_data_type += DF403.to_string();
+            first_data_type[cell] = DF400.to_ullong();
+            second_data_type[cell] = DF401.to_ullong();
+            third_data_type[cell] = DF402.to_ullong();
+            fourth_data_type[cell] = DF420.to_ullong();
+            fifth_data_type[cell] = DF403.to_ullong();
         }
 
-    signal_data = first_data_type + second_data_type + third_data_type + fourth_data_type + fifth_data_type;
-    return signal_data;
+    for (uint32_t i = 0; i < Ncells; i++)
+        {
+            writer.put(first_data_type[i], DF400.size());
+        }
+    for (uint32_t i = 0; i < Ncells; i++)
+        {
+            writer.put(second_data_type[i], DF401.size());
+        }
+    for (uint32_t i = 0; i < Ncells; i++)
+        {
+            writer.put(third_data_type[i], DF402.size());
+        }
+    for (uint32_t i = 0; i < Ncells; i++)
+        {
+            writer.put(fourth_data_type[i], DF420.size());
+        }
+    for (uint32_t i = 0; i < Ncells; i++)
+        {
+            writer.put(fifth_data_type[i], DF403.size());
+        }
 }
 
 
@@ -2836,7 +2850,9 @@ std::string Rtcm::print_MSM_5(const Gps_Ephemeris& gps_eph,
             msg_number = 1075;
         }
 
-    std::string header = Rtcm::get_MSM_header(msg_number,
+    Rtcm_Bit_Writer writer;
+    Rtcm::write_MSM_header(writer,
+        msg_number,
         obs_time,
         observables,
         ref_id,
@@ -2846,30 +2862,27 @@ std::string Rtcm::print_MSM_5(const Gps_Ephemeris& gps_eph,
         divergence_free,
         more_messages);
 
-    std::string sat_data = Rtcm::get_MSM_5_content_sat_data(observables);
+    Rtcm::write_MSM_5_content_sat_data(writer, observables);
 
-    std::string signal_data = Rtcm::get_MSM_5_content_signal_data(gps_eph, gps_cnav_eph, gal_eph, glo_gnav_eph, obs_time, observables);
+    Rtcm::write_MSM_5_content_signal_data(writer, gps_eph, gps_cnav_eph, gal_eph, glo_gnav_eph, obs_time, observables);
 
-    std::string message = build_message(header + sat_data + signal_data);
+    std::string message = writer.frame();
     if (server_is_running)
         {
-            rtcm_message_queue->push(message);
+            Rtcm::send_message(message);
         }
 
     return message;
 }
 
 
-std::string Rtcm::get_MSM_5_content_sat_data(const std::map<int32_t, Gnss_Synchro>& observables)
+void Rtcm::write_MSM_5_content_sat_data(Rtcm_Bit_Writer& writer, const std::map<int32_t, Gnss_Synchro>& observables)
 {
-    std::string sat_data;
-    std::string first_data_type;
-    std::string second_data_type;
-    std::string third_data_type;
-    std::string fourth_data_type;
-
     Rtcm::set_DF394(observables);
     uint32_t num_satellites = DF394.count();
+    std::vector<uint64_t> first_data_type(num_satellites);
+    std::vector<uint64_t> third_data_type(num_satellites);
+    std::vector<uint64_t> fourth_data_type(num_satellites);
 
     std::vector<std::pair<int32_t, Gnss_Synchro> > observables_vector;
     std::map<int32_t, Gnss_Synchro>::const_iterator gnss_synchro_iter;
@@ -2895,33 +2908,43 @@ std::string Rtcm::get_MSM_5_content_sat_data(const std::map<int32_t, Gnss_Synchr
             Rtcm::set_DF397(ordered_by_PRN_pos.at(nsat).second);
             Rtcm::set_DF398(ordered_by_PRN_pos.at(nsat).second);
             Rtcm::set_DF399(ordered_by_PRN_pos.at(nsat).second);
-            std::bitset<4> reserved = std::bitset<4>("0000");
-            first_data_type += DF397.to_string();
-            second_data_type += reserved.to_string();
-            third_data_type += DF398.to_string();
-            fourth_data_type += DF399.to_string();
+            first_data_type[nsat] = DF397.to_ullong();
+            third_data_type[nsat] = DF398.to_ullong();
+            fourth_data_type[nsat] = DF399.to_ullong();
+        }
+    for (uint32_t i = 0; i < num_satellites; i++)
+        {
+            writer.put(first_data_type[i], DF397.size());
+        }
+    for (uint32_t i = 0; i < num_satellites; i++)
+        {
+            writer.put(0, 4);  // reserved
+        }
+    for (uint32_t i = 0; i < num_satellites; i++)
+        {
+            writer.put(third_data_type[i], DF398.size());
+        }
+    for (uint32_t i = 0; i < num_satellites; i++)
+        {
+            writer.put(fourth_data_type[i], DF399.size());
         }
-    sat_data = first_data_type + second_data_type + third_data_type + fourth_data_type;
-    return sat_data;
 }
 
 
-std::string Rtcm::get_MSM_5_content_signal_data(const Gps_Ephemeris& ephNAV,
+void Rtcm::write_MSM_5_content_signal_data(Rtcm_Bit_Writer& writer, const Gps_Ephemeris& ephNAV,
     const Gps_CNAV_Ephemeris& ephCNAV,
     const Galileo_Ephemeris& ephFNAV,
     const Glonass_Gnav_Ephemeris& ephGNAV,
     double obs_time,
     const std::map<int32_t, Gnss_Synchro>& observables)
 {
-    std::string signal_data;
-    std::string first_data_type;
-    std::string second_data_type;
-    std::string third_data_type;
-    std::string fourth_data_type;
-    std::string fifth_data_type;
-    std::string sixth_data_type;
-
     uint32_t Ncells = observables.size();
+    std::vector<uint64_t> first_data_type(Ncells);
+    std::vector<uint64_t> second_data_type(Ncells);
+    std::vector<uint64_t> third_data_type(Ncells);
+    std::vector<uint64_t> fourth_data_type(Ncells);
+    std::vector<uint64_t> fifth_data_type(Ncells);
+    std::vector<uint64_t> sixth_data_type(Ncells);
 
     std::vector<std::pair<int32_t, Gnss_Synchro> > observables_vector;
     std::map<int32_t, Gnss_Synchro>::const_iterator map_iter;
@@ -2945,16 +2968,38 @@ std::string Rtcm::get_MSM_5_content_signal_data(const Gps_Ephemeris& ephNAV,
             Rtcm::set_DF420(ordered_by_PRN_pos.at(cell).second);
             Rtcm::set_DF403(ordered_by_PRN_pos.at(cell).second);
             Rtcm::set_DF404(ordered_by_PRN_pos.at(cell).second);
-            first_data_type += DF400.to_string();
-            second_data_type += DF401.to_string();
-            third_data_type += DF402.to_string();
-            fourth_data_type += DF420.to_string();
-            fifth_data_type += DF403.to_string();
-            sixth_data_type += DF404.to_string();
+            first_data_type[cell] = DF400.to_ullong();
+            second_data_type[cell] = DF401.to_ullong();
+            third_data_type[cell] = DF402.to_ullong();
+            fourth_data_type[cell] = DF420.to_ullong();
+            fifth_data_type[cell] = DF403.to_ullong();
+            sixth_data_type[cell] = DF404.to_ullong();
         }
 
-    signal_data = first_data_type + second_data_type + third_data_type + fourth_data_type + fifth_data_type + sixth_data_type;
-    return signal_data;
+    for (uint32_t i = 0; i < Ncells; i++)
+        {
+            writer.put(first_data_type[i], DF400.size());
+        }
+    for (uint32_t i = 0; i < Ncells; i++)
+        {
+            writer.put(second_data_type[i], DF401.size());
+        }
+    for (uint32_t i = 0; i < Ncells; i++)
+        {
+            writer.put(third_data_type[i], DF402.size());
+        }
+    for (uint32_t i = 0; i < Ncells; i++)
+        {
+            writer.put(fourth_data_type[i], DF420.size());
+        }
+    for (uint32_t i = 0; i < Ncells; i++)
+        {
+            writer.put(fifth_data_type[i], DF403.size());
+        }
+    for (uint32_t i = 0; i < Ncells; i++)
+        {
+            writer.put(sixth_data_type[i], DF404.size());
+        }
 }
 
 
@@ -2992,7 +3037,9 @@ std::string Rtcm::print_MSM_6(const Gps_Ephemeris& gps_eph,
             msg_number = 1076;
         }
 
-    std::string header = Rtcm::get_MSM_header(msg_number,
+    Rtcm_Bit_Writer writer;
+    Rtcm::write_MSM_header(writer,
+        msg_number,
         obs_time,
         observables,
         ref_id,
@@ -3002,35 +3049,33 @@ std::string Rtcm::print_MSM_6(const Gps_Ephemeris& gps_eph,
         divergence_free,
         more_messages);
 
-    std::string sat_data = Rtcm::get_MSM_4_content_sat_data(observables);
+    Rtcm::write_MSM_4_content_sat_data(writer, observables);
 
-    std::string signal_data = Rtcm::get_MSM_6_content_signal_data(gps_eph, gps_cnav_eph, gal_eph, glo_gnav_eph, obs_time, observables);
+    Rtcm::write_MSM_6_content_signal_data(writer, gps_eph, gps_cnav_eph, gal_eph, glo_gnav_eph, obs_time, observables);
 
-    std::string message = build_message(header + sat_data + signal_data);
+    std::string message = writer.frame();
     if (server_is_running)
         {
-            rtcm_message_queue->push(message);
+            Rtcm::send_message(message);
         }
 
     return message;
 }
 
 
-std::string Rtcm::get_MSM_6_content_signal_data(const Gps_Ephemeris& ephNAV,
+void Rtcm::write_MSM_6_content_signal_data(Rtcm_Bit_Writer& writer, const Gps_Ephemeris& ephNAV,
     const Gps_CNAV_Ephemeris& ephCNAV,
     const Galileo_Ephemeris& ephFNAV,
     const Glonass_Gnav_Ephemeris& ephGNAV,
     double obs_time,
     const std::map<int32_t, Gnss_Synchro>& observables)
 {
-    std::string signal_data;
-    std::string first_data_type;
-    std::string second_data_type;
-    std::string third_data_type;
-    std::string fourth_data_type;
-    std::string fifth_data_type;
-
     uint32_t Ncells = observables.size();
+    std::vector<uint64_t> first_data_type(Ncells);
+    std::vector<uint64_t> second_data_type(Ncells);
+    std::vector<uint64_t> third_data_type(Ncells);
+    std::vector<uint64_t> fourth_data_type(Ncells);
+    std::vector<uint64_t> fifth_data_type(Ncells);
 
     std::vector<std::pair<int32_t, Gnss_Synchro> > observables_vector;
     std::map<int32_t, Gnss_Synchro>::const_iterator map_iter;
@@ -3053,15 +3098,33 @@ std::string Rtcm::get_MSM_6_content_signal_data(const Gps_Ephemeris& ephNAV,
             Rtcm::set_DF407(ephNAV, ephCNAV, ephFNAV, ephGNAV, obs_time, ordered_by_PRN_pos.at(cell).second);
             Rtcm::set_DF420(ordered_by_PRN_pos.at(cell).second);
             Rtcm::set_DF408(ordered_by_PRN_pos.at(cell).second);
-            first_data_type += DF405.to_string();
-            second_data_type += DF406.to_string();
-            third_data_type += DF407.to_string();
-            fourth_data_type += DF420.to_string();
-            fifth_data_type += DF408.to_string();
+            first_data_type[cell] = DF405.to_ullong();
+            second_data_type[cell] = DF406.to_ullong();
+            third_data_type[cell] = DF407.to_ullong();
+            fourth_data_type[cell] = DF420.to_ullong();
+            fifth_data_type[cell] = DF408.to_ullong();
         }
 
-    signal_data = first_data_type + second_data_type + third_data_type + fourth_data_type + fifth_data_type;
-    return signal_data;
+    for (uint32_t i = 0; i < Ncells; i++)
+        {
+            writer.put(first_data_type[i], DF405.size());
+        }
+    for (uint32_t i = 0; i < Ncells; i++)
+        {
+            writer.put(second_data_type[i], DF406.size());
+        }
+    for (uint32_t i = 0; i < Ncells; i++)
+        {
+            writer.put(third_data_type[i], DF407.size());
+        }
+    for (uint32_t i = 0; i < Ncells; i++)
+        {
+            writer.put(fourth_data_type[i], DF420.size());
+        }
+    for (uint32_t i = 0; i < Ncells; i++)
+        {
+            writer.put(fifth_data_type[i], DF408.size());
+        }
 }
 
 
@@ -3099,7 +3162,9 @@ std::string Rtcm::print_MSM_7(const Gps_Ephemeris& gps_eph,
             msg_number = 1076;
         }
 
-    std::string header = Rtcm::get_MSM_header(msg_number,
+    Rtcm_Bit_Writer writer;
+    Rtcm::write_MSM_header(writer,
+        msg_number,
         obs_time,
         observables,
         ref_id,
@@ -3109,36 +3174,34 @@ std::string Rtcm::print_MSM_7(const Gps_Ephemeris& gps_eph,
         divergence_free,
         more_messages);
 
-    std::string sat_data = Rtcm::get_MSM_5_content_sat_data(observables);
+    Rtcm::write_MSM_5_content_sat_data(writer, observables);
 
-    std::string signal_data = Rtcm::get_MSM_7_content_signal_data(gps_eph, gps_cnav_eph, gal_eph, glo_gnav_eph, obs_time, observables);
+    Rtcm::write_MSM_7_content_signal_data(writer, gps_eph, gps_cnav_eph, gal_eph, glo_gnav_eph, obs_time, observables);
 
-    std::string message = build_message(header + sat_data + signal_data);
+    std::string message = writer.frame();
     if (server_is_running)
         {
-            rtcm_message_queue->push(message);
+            Rtcm::send_message(message);
         }
 
     return message;
 }
 
 
-std::string Rtcm::get_MSM_7_content_signal_data(const Gps_Ephemeris& ephNAV,
+void Rtcm::write_MSM_7_content_signal_data(Rtcm_Bit_Writer& writer, const Gps_Ephemeris& ephNAV,
     const Gps_CNAV_Ephemeris& ephCNAV,
     const Galileo_Ephemeris& ephFNAV,
     const Glonass_Gnav_Ephemeris& ephGNAV,
     double obs_time,
     const std::map<int32_t, Gnss_Synchro>& observables)
 {
-    std::string signal_data;
-    std::string first_data_type;
-    std::string second_data_type;
-    std::string third_data_type;
-    std::string fourth_data_type;
-    std::string fifth_data_type;
-    std::string sixth_data_type;
-
     uint32_t Ncells = observables.size();
+    std::vector<uint64_t> first_data_type(Ncells);
+    std::vector<uint64_t> second_data_type(Ncells);
+    std::vector<uint64_t> third_data_type(Ncells);
+    std::vector<uint64_t> fourth_data_type(Ncells);
+    std::vector<uint64_t> fifth_data_type(Ncells);
+    std::vector<uint64_t> sixth_data_type(Ncells);
 
     std::vector<std::pair<int32_t, Gnss_Synchro> > observables_vector;
     std::map<int32_t, Gnss_Synchro>::const_iterator map_iter;
@@ -3162,16 +3225,38 @@ std::string Rtcm::get_MSM_7_content_signal_data(const Gps_Ephemeris& ephNAV,
             Rtcm::set_DF420(ordered_by_PRN_pos.at(cell).second);
             Rtcm::set_DF408(ordered_by_PRN_pos.at(cell).second);
             Rtcm::set_DF404(ordered_by_PRN_pos.at(cell).second);
-            first_data_type += DF405.to_string();
-            second_data_type += DF406.to_string();
-            third_data_type += DF407.to_string();
-            fourth_data_type += DF420.to_string();
-            fifth_data_type += DF408.to_string();
-            sixth_data_type += DF404.to_string();
+            first_data_type[cell] = DF405.to_ullong();
+            second_data_type[cell] = DF406.to_ullong();
+            third_data_type[cell] = DF407.to_ullong();
+            fourth_data_type[cell] = DF420.to_ullong();
+            fifth_data_type[cell] = DF408.to_ullong();
+            sixth_data_type[cell] = DF404.to_ullong();
         }
 
-    signal_data = first_data_type + second_data_type + third_data_type + fourth_data_type + fifth_data_type + sixth_data_type;
-    return signal_data;
+    for (uint32_t i = 0; i < Ncells; i++)
+        {
+            writer.put(first_data_type[i], DF405.size());
+        }
+    for (uint32_t i = 0; i < Ncells; i++)
+        {
+            writer.put(second_data_type[i], DF406.size());
+        }
+    for (uint32_t i = 0; i < Ncells; i++)
+        {
+            writer.put(third_data_type[i], DF407.size());
+        }
+    for (uint32_t i = 0; i < Ncells; i++)
+        {
+            writer.put(fourth_data_type[i], DF420.size());
+        }
+    for (uint32_t i = 0; i < Ncells; i++)
+        {
+            writer.put(fifth_data_type[i], DF408.size());
+        }
+    for (uint32_t i = 0; i < Ncells; i++)
+        {
+            writer.put(sixth_data_type[i], DF404.size());
+        }
 }
 
 
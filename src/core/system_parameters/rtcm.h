@@ -33,12 +33,13 @@
 #define GNSS_SDR_RTCM_H_
 
 
-#include "concurrent_queue.h"
+#include "concurrent_ring_queue.h"
 #include "galileo_fnav_message.h"
 #include "glonass_gnav_navigation_message.h"
 #include "gnss_synchro.h"
 #include "gps_cnav_navigation_message.h"
 #include "gps_navigation_message.h"
+#include "rtcm_bit_writer.h"
 #include <boost/asio.hpp>
 #include <boost/date_time/posix_time/posix_time.hpp>
 #include <glog/logging.h>
@@ -48,6 +49,7 @@
 #include <map>
 #include <memory>
 #include <set>
+#include <sstream>
 #include <string>
 #include <thread>
 #include <utility>
@@ -86,7 +88,7 @@
 class Rtcm
 {
 public:
-    Rtcm(uint16_t port = 2101);  //<! Default constructor that sets TCP port of the RTCM message server and RTCM Station ID. 2101 is the standard RTCM port according to the Internet Assigned Numbers Authority (IANA). See https://www.iana.org/assignments/service-names-port-numbers/service-names-port-numbers.xml
+    Rtcm(uint16_t port = 2101, const std::string& ntrip_mountpoint = std::string(""));  //<! Default constructor that sets TCP port of the RTCM message server and RTCM Station ID. 2101 is the standard RTCM port according to the Internet Assigned Numbers Authority (IANA). See https://www.iana.org/assignments/service-names-port-numbers/service-names-port-numbers.xml. If a mountpoint is given, the server works as an NTRIP (v1 and v2) caster
     ~Rtcm();
 
     /*!
@@ -454,7 +456,8 @@ private:
      */
     std::bitset<130> get_MT1012_sat_content(const Glonass_Gnav_Ephemeris& ephGNAVL1, const Glonass_Gnav_Ephemeris& ephGNAVL2, double obs_time, const Gnss_Synchro& gnss_synchroL1, const Gnss_Synchro& gnss_synchroL2);
 
-    std::string get_MSM_header(uint32_t msg_number,
+    void write_MSM_header(Rtcm_Bit_Writer& writer,
+        uint32_t msg_number,
         double obs_time,
         const std::map<int32_t, Gnss_Synchro>& observables,
         uint32_t ref_id,
@@ -464,17 +467,17 @@ private:
         bool divergence_free,
         bool more_messages);
 
-    std::string get_MSM_1_content_sat_data(const std::map<int32_t, Gnss_Synchro>& observables);
-    std::string get_MSM_4_content_sat_data(const std::map<int32_t, Gnss_Synchro>& observables);
-    std::string get_MSM_5_content_sat_data(const std::map<int32_t, Gnss_Synchro>& observables);
+    void write_MSM_1_content_sat_data(Rtcm_Bit_Writer& writer, const std::map<int32_t, Gnss_Synchro>& observables);
+    void write_MSM_4_content_sat_data(Rtcm_Bit_Writer& writer, const std::map<int32_t, Gnss_Synchro>& observables);
+    void write_MSM_5_content_sat_data(Rtcm_Bit_Writer& writer, const std::map<int32_t, Gnss_Synchro>& observables);
 
-    std::string get_MSM_1_content_signal_data(const std::map<int32_t, Gnss_Synchro>& observables);
-    std::string get_MSM_2_content_signal_data(const Gps_Ephemeris& ephNAV, const Gps_CNAV_Ephemeris& ephCNAV, const Galileo_Ephemeris& ephFNAV, const Glonass_Gnav_Ephemeris& ephGNAV, double obs_time, const std::map<int32_t, Gnss_Synchro>& observables);
-    std::string get_MSM_3_content_signal_data(const Gps_Ephemeris& ephNAV, const Gps_CNAV_Ephemeris& ephCNAV, const Galileo_Ephemeris& ephFNAV, const Glonass_Gnav_Ephemeris& ephGNAV, double obs_time, const std::map<int32_t, Gnss_Synchro>& observables);
-    std::string get_MSM_4_content_signal_data(const Gps_Ephemeris& ephNAV, const Gps_CNAV_Ephemeris& ephCNAV, const Galileo_Ephemeris& ephFNAV, const Glonass_Gnav_Ephemeris& ephGNAV, double obs_time, const std::map<int32_t, Gnss_Synchro>& observables);
-    std::string get_MSM_5_content_signal_data(const Gps_Ephemeris& ephNAV, const Gps_CNAV_Ephemeris& ephCNAV, const Galileo_Ephemeris& ephFNAV, const Glonass_Gnav_Ephemeris& ephGNAV, double obs_time, const std::map<int32_t, Gnss_Synchro>& observables);
-    std::string get_MSM_6_content_signal_data(const Gps_Ephemeris& ephNAV, const Gps_CNAV_Ephemeris& ephCNAV, const Galileo_Ephemeris& ephFNAV, const Glonass_Gnav_Ephemeris& ephGNAV, double obs_time, const std::map<int32_t, Gnss_Synchro>& observables);
-    std::string get_MSM_7_content_signal_data(const Gps_Ephemeris& ephNAV, const Gps_CNAV_Ephemeris& ephCNAV, const Galileo_Ephemeris& ephFNAV, const Glonass_Gnav_Ephemeris& ephGNAV, double obs_time, const std::map<int32_t, Gnss_Synchro>& observables);
+    void write_MSM_1_content_signal_data(Rtcm_Bit_Writer& writer, const std::map<int32_t, Gnss_Synchro>& observables);
+    void write_MSM_2_content_signal_data(Rtcm_Bit_Writer& writer, const Gps_Ephemeris& ephNAV, const Gps_CNAV_Ephemeris& ephCNAV, const Galileo_Ephemeris& ephFNAV, const Glonass_Gnav_Ephemeris& ephGNAV, double obs_time, const std::map<int32_t, Gnss_Synchro>& observables);
+    void write_MSM_3_content_signal_data(Rtcm_Bit_Writer& writer, const Gps_Ephemeris& ephNAV, const Gps_CNAV_Ephemeris& ephCNAV, const Galileo_Ephemeris& ephFNAV, const Glonass_Gnav_Ephemeris& ephGNAV, double obs_time, const std::map<int32_t, Gnss_Synchro>& observables);
+    void write_MSM_4_content_signal_data(Rtcm_Bit_Writer& writer, const Gps_Ephemeris& ephNAV, const Gps_CNAV_Ephemeris& ephCNAV, const Galileo_Ephemeris& ephFNAV, const Glonass_Gnav_Ephemeris& ephGNAV, double obs_time, const std::map<int32_t, Gnss_Synchro>& observables);
+    void write_MSM_5_content_signal_data(Rtcm_Bit_Writer& writer, const Gps_Ephemeris& ephNAV, const Gps_CNAV_Ephemeris& ephCNAV, const Galileo_Ephemeris& ephFNAV, const Glonass_Gnav_Ephemeris& ephGNAV, double obs_time, const std::map<int32_t, Gnss_Synchro>& observables);
+    void write_MSM_6_content_signal_data(Rtcm_Bit_Writer& writer, const Gps_Ephemeris& ephNAV, const Gps_CNAV_Ephemeris& ephCNAV, const Galileo_Ephemeris& ephFNAV, const Glonass_Gnav_Ephemeris& ephGNAV, double obs_time, const std::map<int32_t, Gnss_Synchro>& observables);
+    void write_MSM_7_content_signal_data(Rtcm_Bit_Writer& writer, const Gps_Ephemeris& ephNAV, const Gps_CNAV_Ephemeris& ephCNAV, const Galileo_Ephemeris& ephFNAV, const Glonass_Gnav_Ephemeris& ephGNAV, double obs_time, const std::map<int32_t, Gnss_Synchro>& observables);
 
     //
     // Utilities
@@ -594,11 +597,14 @@ private:
     };
 
 
+    // Messages are encoded once and shared, read-only, by all the client sessions
+    typedef std::shared_ptr<const std::string> Rtcm_Shared_Message;
+
     class Rtcm_Listener
     {
     public:
         virtual ~Rtcm_Listener() = default;
-        virtual void deliver(const Rtcm_Message& msg) = 0;
+        virtual void deliver(const Rtcm_Shared_Message& msg) = 0;
     };
 
 
@@ -608,7 +614,7 @@ private:
         inline void join(std::shared_ptr<Rtcm_Listener> participant)
         {
             participants_.insert(participant);
-            for (auto msg : recent_msgs_)
+            for (const auto& msg : recent_msgs_)
                 participant->deliver(msg);
         }
 
@@ -617,13 +623,13 @@ private:
             participants_.erase(participant);
         }
 
-        inline void deliver(const Rtcm_Message& msg)
+        inline void deliver(const Rtcm_Shared_Message& msg)
         {
             recent_msgs_.push_back(msg);
             while (recent_msgs_.size() > max_recent_msgs)
                 recent_msgs_.pop_front();
 
-            for (auto participant : participants_)
+            for (const auto& participant : participants_)
                 participant->deliver(msg);
         }
 
@@ -633,7 +639,7 @@ private:
         {
             max_recent_msgs = 1
         };
-        std::deque<Rtcm_Message> recent_msgs_;
+        std::deque<Rtcm_Shared_Message> recent_msgs_;
     };
 
 
@@ -642,24 +648,147 @@ private:
           public std::enable_shared_from_this<Rtcm_Session>
     {
     public:
-        Rtcm_Session(boost::asio::ip::tcp::socket socket, Rtcm_Listener_Room& room) : socket_(std::move(socket)), room_(room) {}
+        Rtcm_Session(boost::asio::ip::tcp::socket socket, Rtcm_Listener_Room& room, const std::string& mountpoint) : socket_(std::move(socket)), room_(room), mountpoint_(mountpoint) {}
         inline void start()
         {
-            room_.join(shared_from_this());
-            do_read_message_header();
+            if (mountpoint_.empty())
+                {
+                    // raw TCP server: start streaming right away
+                    room_.join(shared_from_this());
+                    joined_ = true;
+                    do_read_message_header();
+                }
+            else
+                {
+                    do_read_ntrip_request();
+                }
         }
 
-        inline void deliver(const Rtcm_Message& msg)
+        inline void deliver(const Rtcm_Shared_Message& msg)
         {
-            bool write_in_progress = !write_msgs_.empty();
+            if (msg->empty())
+                {
+                    return;  // an empty chunk would end an NTRIP v2 stream
+                }
+            if (write_msgs_.size() - in_flight_ >= max_queued_msgs)
+                {
+                    // slow client: drop its oldest message not being written
+                    write_msgs_.erase(write_msgs_.begin() + in_flight_);
+                    if (dropped_msgs_++ == 0)
+                        {
+                            LOG(WARNING) << "RTCM client cannot keep up, dropping messages";
+                        }
+                }
             write_msgs_.push_back(msg);
-            if (!write_in_progress)
+            if (in_flight_ == 0)
                 {
                     do_write();
                 }
         }
 
     private:
+        enum
+        {
+            max_queued_msgs = 64
+        };
+
+        inline void leave()
+        {
+            if (joined_)
+                {
+                    room_.leave(shared_from_this());
+                    joined_ = false;
+                }
+            if (dropped_msgs_ > 0)
+                {
+                    LOG(INFO) << "RTCM client dropped " << dropped_msgs_ << " messages";
+                }
+        }
+
+        // NTRIP caster: the client asks for a mountpoint (or for the sourcetable) with an HTTP GET
+        inline void do_read_ntrip_request()
+        {
+            auto self(shared_from_this());
+            boost::asio::async_read_until(socket_, request_, "\r\n\r\n",
+                [this, self](boost::system::error_code ec, std::size_t length) {
+                    if (ec)
+                        {
+                            std::cout << "Closing connection with RTCM client" << std::endl;
+                            return;
+                        }
+                    std::string request(boost::asio::buffers_begin(request_.data()), boost::asio::buffers_begin(request_.data()) + length);
+                    request_.consume(length);
+                    handle_ntrip_request(request);
+                });
+        }
+
+        inline void handle_ntrip_request(const std::string& request)
+        {
+            bool v2 = request.find("Ntrip-Version: Ntrip/2.0") != std::string::npos;
+            std::string resource;
+            if (request.compare(0, 4, "GET ") == 0)
+                {
+                    std::size_t end = request.find(' ', 4);
+                    if (end != std::string::npos)
+                        {
+                            resource = request.substr(4, end - 4);
+                        }
+                }
+            if (resource == "/" + mountpoint_)
+                {
+                    if (v2)
+                        {
+                            response_ = "HTTP/1.1 200 OK\r\nNtrip-Version: Ntrip/2.0\r\nServer: NTRIP GNSS-SDR\r\nContent-Type: gnss/data\r\nCache-Control: no-store, no-cache, max-age=0\r\nPragma: no-cache\r\nConnection: close\r\nTransfer-Encoding: chunked\r\n\r\n";
+                            chunked_ = true;
+                        }
+                    else
+                        {
+                            response_ = "ICY 200 OK\r\n\r\n";
+                        }
+                    LOG(INFO) << "NTRIP client connected to mountpoint " << mountpoint_;
+                    send_response(true);
+                }
+            else if (resource == "/" or resource.empty())
+                {
+                    std::string table = "STR;" + mountpoint_ + ";" + mountpoint_ + ";RTCM 3.2;;2;GPS+GLO+GAL;GNSS-SDR;;0.00;0.00;0;0;GNSS-SDR;none;N;N;0;\r\nENDSOURCETABLE\r\n";
+                    if (v2)
+                        {
+                            response_ = "HTTP/1.1 200 OK\r\nNtrip-Version: Ntrip/2.0\r\nServer: NTRIP GNSS-SDR\r\nContent-Type: gnss/sourcetable\r\nContent-Length: " + std::to_string(table.size()) + "\r\nConnection: close\r\n\r\n" + table;
+                        }
+                    else
+                        {
+                            response_ = "SOURCETABLE 200 OK\r\nServer: NTRIP GNSS-SDR\r\nContent-Type: text/plain\r\nContent-Length: " + std::to_string(table.size()) + "\r\n\r\n" + table;
+                        }
+                    send_response(false);
+                }
+            else
+                {
+                    LOG(INFO) << "NTRIP client asked for unknown mountpoint " << resource;
+                    response_ = v2 ? "HTTP/1.1 404 Not Found\r\nNtrip-Version: Ntrip/2.0\r\nConnection: close\r\n\r\n" : "HTTP/1.0 404 Not Found\r\n\r\n";
+                    send_response(false);
+                }
+        }
+
+        inline void send_response(bool stream)
+        {
+            auto self(shared_from_this());
+            boost::asio::async_write(socket_,
+                boost::asio::buffer(response_),
+                [this, self, stream](boost::system::error_code ec, std::size_t /*length*/) {
+                    if (!ec and stream)
+                        {
+                            room_.join(shared_from_this());
+                            joined_ = true;
+                            do_read_message_header();
+                        }
+                    else
+                        {
+                            boost::system::error_code ignored;
+                            socket_.shutdown(boost::asio::ip::tcp::socket::shutdown_both, ignored);
+                        }
+                });
+        }
+
         inline void do_read_message_header()
         {
             auto self(shared_from_this());
@@ -672,7 +801,7 @@ private:
                         }
                     else if (!ec and !read_msg_.decode_header())
                         {
-                            client_says += read_msg_.data();
+                            client_says += std::string(read_msg_.data(), Rtcm_Message::header_length);
                             bool first = true;
                             while (client_says.length() >= 80)
                                 {
@@ -689,7 +818,7 @@ private:
                     else
                         {
                             std::cout << "Closing connection with RTCM client" << std::endl;
-                            room_.leave(shared_from_this());
+                            leave();
                         }
                 });
         }
@@ -702,29 +831,50 @@ private:
                 [this, self](boost::system::error_code ec, std::size_t /*length*/) {
                     if (!ec)
                         {
-                            room_.deliver(read_msg_);
-                            //std::cout << "Delivered message (session): ";
-                            //std::cout.write(read_msg_.body(), read_msg_.body_length());
-                            //std::cout << std::endl;
+                            room_.deliver(std::make_shared<const std::string>(read_msg_.body(), read_msg_.body_length()));
                             do_read_message_header();
                         }
                     else
                         {
                             std::cout << "Closing connection with RTCM client" << std::endl;
-                            room_.leave(shared_from_this());
+                            leave();
                         }
                 });
         }
 
+        // all the queued messages are sent with a single scatter-gather write
         inline void do_write()
         {
             auto self(shared_from_this());
+            write_buffers_.clear();
+            std::size_t bytes = 0;
+            for (const auto& msg : write_msgs_)
+                {
+                    bytes += msg->size();
+                }
+            if (chunked_)
+                {
+                    std::ostringstream chunk_size;
+                    chunk_size << std::hex << bytes << "\r\n";
+                    chunk_header_ = chunk_size.str();
+                    write_buffers_.push_back(boost::asio::buffer(chunk_header_));
+                }
+            for (const auto& msg : write_msgs_)
+                {
+                    write_buffers_.push_back(boost::asio::buffer(*msg));
+                }
+            if (chunked_)
+                {
+                    write_buffers_.push_back(boost::asio::buffer(chunk_trailer_, 2));
+                }
+            in_flight_ = write_msgs_.size();
             boost::asio::async_write(socket_,
-                boost::asio::buffer(write_msgs_.front().body(), write_msgs_.front().body_length()),
+                write_buffers_,
                 [this, self](boost::system::error_code ec, std::size_t /*length*/) {
                     if (!ec)
                         {
-                            write_msgs_.pop_front();
+                            write_msgs_.erase(write_msgs_.begin(), write_msgs_.begin() + in_flight_);
+                            in_flight_ = 0;
                             if (!write_msgs_.empty())
                                 {
                                     do_write();
@@ -733,147 +883,67 @@ private:
                     else
                         {
                             std::cout << "Closing connection with RTCM client" << std::endl;
-                            room_.leave(shared_from_this());
+                            leave();
                         }
                 });
         }
 
         boost::asio::ip::tcp::socket socket_;
         Rtcm_Listener_Room& room_;
+        std::string mountpoint_;
+        bool joined_ = false;
+        bool chunked_ = false;  // NTRIP v2 streams use the HTTP/1.1 chunked transfer encoding
+        boost::asio::streambuf request_;
+        std::string response_;
         Rtcm_Message read_msg_;
-        std::deque<Rtcm_Message> write_msgs_;
+        std::deque<Rtcm_Shared_Message> write_msgs_;
+        std::size_t in_flight_ = 0;  // messages of write_msgs_ being written
+        uint64_t dropped_msgs_ = 0;
+        std::vector<boost::asio::const_buffer> write_buffers_;
+        std::string chunk_header_;
+        const char* chunk_trailer_ = "\r\n";
         std::string client_says;
     };
 
 
-    class Tcp_Internal_Client
-        : public std::enable_shared_from_this<Tcp_Internal_Client>
-    {
-    public:
-        Tcp_Internal_Client(boost::asio::io_service& io_context,
-            boost::asio::ip::tcp::resolver::iterator endpoint_iterator)
-            : io_context_(io_context), socket_(io_context)
-        {
-            do_connect(endpoint_iterator);
-        }
-
-        inline void close()
-        {
-            io_context_.post([this]() { socket_.close(); });
-        }
-
-        inline void write(const Rtcm_Message& msg)
-        {
-            io_context_.post(
-                [this, msg]() {
-                    bool write_in_progress = !write_msgs_.empty();
-                    write_msgs_.push_back(msg);
-                    if (!write_in_progress)
-                        {
-                            do_write();
-                        }
-                });
-        }
-
-    private:
-        inline void do_connect(boost::asio::ip::tcp::resolver::iterator endpoint_iterator)
-        {
-            boost::asio::async_connect(socket_, endpoint_iterator,
-                [this](boost::system::error_code ec, boost::asio::ip::tcp::resolver::iterator) {
-                    if (!ec)
-                        {
-                            do_read_message();
-                        }
-                    else
-                        {
-                            std::cout << "Server is down." << std::endl;
-                        }
-                });
-        }
-
-        inline void do_read_message()
-        {
-            boost::asio::async_read(socket_,
-                boost::asio::buffer(read_msg_.data(), 1029),
-                [this](boost::system::error_code ec, std::size_t /*length*/) {
-                    if (!ec)
-                        {
-                            do_read_message();
-                        }
-                    else
-                        {
-                            std::cout << "Error in client" << std::endl;
-                            socket_.close();
-                        }
-                });
-        }
-
-        inline void do_write()
-        {
-            boost::asio::async_write(socket_,
-                boost::asio::buffer(write_msgs_.front().data(), write_msgs_.front().length()),
-                [this](boost::system::error_code ec, std::size_t /*length*/) {
-                    if (!ec)
-                        {
-                            write_msgs_.pop_front();
-                            if (!write_msgs_.empty())
-                                {
-                                    do_write();
-                                }
-                        }
-                    else
-                        {
-                            socket_.close();
-                        }
-                });
-        }
-
-        boost::asio::io_service& io_context_;
-        boost::asio::ip::tcp::socket socket_;
-        Rtcm_Message read_msg_;
-        std::deque<Rtcm_Message> write_msgs_;
-    };
-
-
     class Queue_Reader
     {
     public:
-        Queue_Reader(boost::asio::io_service& io_context, std::shared_ptr<concurrent_queue<std::string> >& queue, int32_t port) : queue_(queue)
+        Queue_Reader(boost::asio::io_service& io_context, std::shared_ptr<concurrent_ring_queue<std::string> >& queue, Rtcm_Listener_Room& room) : io_context_(io_context), queue_(queue), room_(room)
         {
-            boost::asio::ip::tcp::resolver resolver(io_context);
-            std::string host("localhost");
-            std::string port_str = std::to_string(port);
-            auto queue_endpoint_iterator = resolver.resolve({host.c_str(), port_str.c_str()});
-            c = std::make_shared<Tcp_Internal_Client>(io_context, queue_endpoint_iterator);
         }
 
         inline void do_read_queue()
         {
             for (;;)
                 {
-                    std::string message;
-                    Rtcm_Message msg;
-                    queue_->wait_and_pop(message);  //message += '\n';
-                    if (message == "Goodbye") break;
-                    const char* char_msg = message.c_str();
-                    msg.body_length(message.length());
-                    std::memcpy(msg.body(), char_msg, msg.body_length());
-                    msg.encode_header();
-                    c->write(msg);
+                    // wait for a message, and take along those already queued behind it
+                    std::vector<std::string> messages(1);
+                    queue_->wait_and_pop(messages.front());
+                    queue_->try_pop_n(messages, 64);
+                    for (auto& message : messages)
+                        {
+                            if (message == "Goodbye") return;
+                            // handed to the server thread, which owns the sessions
+                            Rtcm_Shared_Message msg = std::make_shared<const std::string>(std::move(message));
+                            Rtcm_Listener_Room& room = room_;
+                            io_context_.post([&room, msg]() { room.deliver(msg); });
+                        }
                 }
         }
 
     private:
-        std::shared_ptr<Tcp_Internal_Client> c;
-        std::shared_ptr<concurrent_queue<std::string> >& queue_;
+        boost::asio::io_service& io_context_;
+        std::shared_ptr<concurrent_ring_queue<std::string> >& queue_;
+        Rtcm_Listener_Room& room_;
     };
 
 
     class Tcp_Server
     {
     public:
-        Tcp_Server(boost::asio::io_service& io_context, const boost::asio::ip::tcp::endpoint& endpoint)
-            : acceptor_(io_context), socket_(io_context)
+        Tcp_Server(boost::asio::io_service& io_context, const boost::asio::ip::tcp::endpoint& endpoint, const std::string& mountpoint)
+            : acceptor_(io_context), socket_(io_context), mountpoint_(mountpoint)
         {
             acceptor_.open(endpoint.protocol());
             acceptor_.set_option(boost::asio::ip::tcp::acceptor::reuse_address(true));
@@ -888,37 +958,34 @@ private:
             acceptor_.close();
         }
 
+        inline Rtcm_Listener_Room& room()
+        {
+            return room_;
+        }
+
     private:
         inline void do_accept()
         {
             acceptor_.async_accept(socket_, [this](boost::system::error_code ec) {
                 if (!ec)
                     {
-                        if (first_client)
+                        std::cout << "Starting RTCM TCP/IP server session..." << std::endl;
+                        boost::system::error_code ec2;
+                        boost::asio::ip::tcp::endpoint endpoint = socket_.remote_endpoint(ec2);
+                        if (ec2)
                             {
-                                std::cout << "The TCP/IP server of RTCM messages is up and running. Accepting connections ..." << std::endl;
-                                first_client = false;
+                                // Error creating remote_endpoint
+                                std::cout << "Error getting remote IP address, closing session." << std::endl;
+                                LOG(INFO) << "Error getting remote IP address";
+                                start_session = false;
                             }
                         else
                             {
-                                std::cout << "Starting RTCM TCP/IP server session..." << std::endl;
-                                boost::system::error_code ec2;
-                                boost::asio::ip::tcp::endpoint endpoint = socket_.remote_endpoint(ec2);
-                                if (ec2)
-                                    {
-                                        // Error creating remote_endpoint
-                                        std::cout << "Error getting remote IP address, closing session." << std::endl;
-                                        LOG(INFO) << "Error getting remote IP address";
-                                        start_session = false;
-                                    }
-                                else
-                                    {
-                                        std::string remote_addr = endpoint.address().to_string();
-                                        std::cout << "Serving client from " << remote_addr << std::endl;
-                                        LOG(INFO) << "Serving client from " << remote_addr;
-                                    }
+                                std::string remote_addr = endpoint.address().to_string();
+                                std::cout << "Serving client from " << remote_addr << std::endl;
+                                LOG(INFO) << "Serving client from " << remote_addr;
                             }
-                        if (start_session) std::make_shared<Rtcm_Session>(std::move(socket_), room_)->start();
+                        if (start_session) std::make_shared<Rtcm_Session>(std::move(socket_), room_, mountpoint_)->start();
                     }
                 else
                     {
@@ -932,12 +999,12 @@ private:
         boost::asio::ip::tcp::acceptor acceptor_;
         boost::asio::ip::tcp::socket socket_;
         Rtcm_Listener_Room room_;
-        bool first_client = true;
+        std::string mountpoint_;
         bool start_session = true;
     };
 
     boost::asio::io_service io_context;
-    std::shared_ptr<concurrent_queue<std::string> > rtcm_message_queue;
+    std::shared_ptr<concurrent_ring_queue<std::string> > rtcm_message_queue;
     std::thread t;
     std::thread tq;
     std::list<Rtcm::Tcp_Server> servers;
@@ -949,7 +1016,6 @@ private:
     //
     std::bitset<8> preamble;
     std::bitset<6> reserved_field;
-    std::string add_CRC(const std::string& m) const;
     std::string build_message(const std::string& data) const;  // adds 0s to complete a byte and adds the CRC
 
     //
@@ -0,0 +1,143 @@
+/*!
+ * \file rtcm_bit_writer.cc
+ * \brief Packs RTCM 3 data fields directly into a byte buffer
+ *
+ * -------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2019  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *          Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------
+ */
+
+
+#include "rtcm_bit_writer.h"
+#include <glog/logging.h>
+#include <algorithm>
+#include <array>
+
+
+namespace
+{
+const uint8_t RTCM_PREAMBLE = 0xD3;
+const uint32_t RTCM_MAX_MESSAGE_LENGTH_BYTES = 1023;
+
+std::array<uint32_t, 256> make_crc24q_table()
+{
+    std::array<uint32_t, 256> table{};
+    for (uint32_t i = 0; i < 256; i++)
+        {
+            uint32_t c = i << 16;
+            for (int bit = 0; bit < 8; bit++)
+                {
+                    c <<= 1;
+                    if (c & 0x1000000)
+                        {
+                            c ^= 0x1864CFB;
+                        }
+                }
+            table[i] = c & 0xFFFFFF;
+        }
+    return table;
+}
+
+const std::array<uint32_t, 256> CRC24Q_TABLE = make_crc24q_table();
+}  // namespace
+
+
+uint32_t rtcm_crc24q(uint32_t crc, const uint8_t* data, std::size_t length)
+{
+    for (std::size_t i = 0; i < length; i++)
+        {
+            crc = ((crc << 8) & 0xFFFFFF) ^ CRC24Q_TABLE[((crc >> 16) ^ data[i]) & 0xFF];
+        }
+    return crc;
+}
+
+
+Rtcm_Bit_Writer::Rtcm_Bit_Writer()
+{
+    d_data.reserve(RTCM_MAX_MESSAGE_LENGTH_BYTES);
+    d_bit_count = 0;
+}
+
+
+void Rtcm_Bit_Writer::clear()
+{
+    d_data.clear();
+    d_bit_count = 0;
+}
+
+
+void Rtcm_Bit_Writer::put(uint64_t value, uint32_t n_bits)
+{
+    if (n_bits < 64)
+        {
+            value &= (static_cast<uint64_t>(1) << n_bits) - 1;
+        }
+    while (n_bits > 0)
+        {
+            uint32_t used = d_bit_count % 8;
+            if (used == 0)
+                {
+                    d_data.push_back(0);
+                }
+            uint32_t room = 8 - used;
+            uint32_t take = std::min(room, n_bits);
+            auto bits = static_cast<uint8_t>((value >> (n_bits - take)) & ((1U << take) - 1));
+            d_data.back() |= static_cast<uint8_t>(bits << (room - take));
+            n_bits -= take;
+            d_bit_count += take;
+        }
+}
+
+
+void Rtcm_Bit_Writer::put_bits(const std::string& bits)
+{
+    for (char bit : bits)
+        {
+            put(bit == '1' ? 1 : 0, 1);
+        }
+}
+
+
+std::string Rtcm_Bit_Writer::frame() const
+{
+    const auto length = static_cast<uint32_t>(d_data.size());
+    if (length > RTCM_MAX_MESSAGE_LENGTH_BYTES)
+        {
+            LOG(WARNING) << "RTCM message too long (" << length << " bytes)";
+        }
+    std::string message;
+    message.reserve(length + 6);
+    uint8_t header[3];
+    header[0] = RTCM_PREAMBLE;
+    header[1] = static_cast<uint8_t>((length >> 8) & 0x03);  // 6 reserved bits set to 0
+    header[2] = static_cast<uint8_t>(length & 0xFF);
+    message.append(reinterpret_cast<const char*>(header), 3);
+    message.append(reinterpret_cast<const char*>(d_data.data()), length);
+
+    uint32_t crc = rtcm_crc24q(0, header, 3);
+    crc = rtcm_crc24q(crc, d_data.data(), length);
+    message.push_back(static_cast<char>((crc >> 16) & 0xFF));
+    message.push_back(static_cast<char>((crc >> 8) & 0xFF));
+    message.push_back(static_cast<char>(crc & 0xFF));
+    return message;
+}
@@ -0,0 +1,100 @@
+/*!
+ * \file rtcm_bit_writer.h
+ * \brief Packs RTCM 3 data fields directly into a byte buffer
+ *
+ * -------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2019  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *          Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------
+ */
+
+
+#ifndef GNSS_SDR_RTCM_BIT_WRITER_H_
+#define GNSS_SDR_RTCM_BIT_WRITER_H_
+
+#include <bitset>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+
+/*!
+ * \brief Computes the Qualcomm CRC-24Q used by RTCM 3, starting from \p crc,
+ * so it can be updated with consecutive blocks of a frame.
+ */
+uint32_t rtcm_crc24q(uint32_t crc, const uint8_t* data, std::size_t length);
+
+
+/*!
+ * \brief Builds the data message of an RTCM 3 frame, most significant bit
+ * first, and wraps it in the transport layer (preamble, length and CRC-24Q)
+ * without going through strings of '0' and '1' characters.
+ */
+class Rtcm_Bit_Writer
+{
+public:
+    Rtcm_Bit_Writer();
+
+    /*!
+     * \brief Discards the data written so far, keeping the allocated memory
+     */
+    void clear();
+
+    /*!
+     * \brief Appends the \p n_bits (up to 64) least significant bits of \p value
+     */
+    void put(uint64_t value, uint32_t n_bits);
+
+    /*!
+     * \brief Appends a data field
+     */
+    template <std::size_t N>
+    void put(const std::bitset<N>& field)
+    {
+        static_assert(N <= 64, "Fields longer than 64 bits must be split");
+        put(field.to_ullong(), N);
+    }
+
+    /*!
+     * \brief Appends a field given as a string of '0' and '1' characters
+     */
+    void put_bits(const std::string& bits);
+
+    /*!
+     * \brief Number of bits written so far
+     */
+    uint32_t size_bits() const { return d_bit_count; }
+
+    /*!
+     * \brief Returns the complete frame (preamble, reserved bits, message
+     * length, data message padded to a whole byte, and CRC-24Q) as binary data,
+     * as Rtcm::build_message() does.
+     */
+    std::string frame() const;
+
+private:
+    std::vector<uint8_t> d_data;
+    uint32_t d_bit_count;
+};
+
+#endif
@@ -42,6 +42,7 @@
 #include "concurrent_map.h"
 #include "concurrent_queue.h"
 #include "control_thread.h"
+#include "file_configuration.h"
 #include "gnss_sdr_flags.h"
 #include "gps_acq_assist.h"
 #include <boost/exception/diagnostic_information.hpp>
@@ -55,7 +56,10 @@
 #include <exception>
 #include <iostream>
 #include <memory>
+#include <sstream>
 #include <string>
+#include <thread>
+#include <vector>
 
 #if CUDA_GPU_ACCEL
 // For the CUDA runtime routines (prefixed with "cuda_")
@@ -75,6 +79,65 @@ using google::LogMessage;
 concurrent_queue<Gps_Acq_Assist> global_gps_acq_assist_queue;
 concurrent_map<Gps_Acq_Assist> global_gps_acq_assist_map;
 
+/*
+ * Runs one receiver per configuration file in \p config_files (comma-separated),
+ * each with its own flowgraph, in the same process. The code tables, the
+ * Doppler wipe-off tables, the FFTW wisdom and the VOLK kernels are shared
+ * by all of them. The first receiver listens to the keyboard and to the
+ * SysV stop message, and stops the others when it ends.
+ */
+int run_receivers(const std::string& config_files)
+{
+    std::vector<std::shared_ptr<ControlThread>> receivers;
+    std::stringstream files(config_files);
+    std::string file;
+    while (std::getline(files, file, ','))
+        {
+            std::cout << "Receiver " << receivers.size() << " configured by " << file << std::endl;
+            receivers.push_back(std::make_shared<ControlThread>(std::make_shared<FileConfiguration>(file)));
+            receivers.back()->set_process_listeners(receivers.size() == 1);
+        }
+
+    std::vector<int> return_codes(receivers.size(), 0);
+    std::vector<std::exception_ptr> errors(receivers.size());
+    std::vector<std::thread> threads;
+    for (size_t i = 1; i < receivers.size(); i++)
+        {
+            threads.emplace_back([&receivers, &return_codes, &errors, i]() {
+                try
+                    {
+                        return_codes[i] = receivers[i]->run();
+                    }
+                catch (...)
+                    {
+                        errors[i] = std::current_exception();
+                    }
+            });
+        }
+    try
+        {
+            return_codes[0] = receivers[0]->run();
+        }
+    catch (...)
+        {
+            errors[0] = std::current_exception();
+        }
+    for (size_t i = 1; i < receivers.size(); i++)
+        {
+            receivers[i]->stop();
+            threads[i - 1].join();
+        }
+    for (const auto& error : errors)
+        {
+            if (error)
+                {
+                    std::rethrow_exception(error);
+                }
+        }
+    return return_codes[0];
+}
+
+
 int main(int argc, char** argv)
 {
     const std::string intro_help(
@@ -132,8 +195,6 @@ int main(int argc, char** argv)
                 }
         }
 
-    std::unique_ptr<ControlThread> control_thread(new ControlThread());
-
     // record startup time
     std::chrono::time_point<std::chrono::system_clock> start, end;
     start = std::chrono::system_clock::now();
@@ -141,7 +202,15 @@ int main(int argc, char** argv)
     int return_code;
     try
         {
-            return_code = control_thread->run();
+            if (FLAGS_config_files.empty())
+                {
+                    std::unique_ptr<ControlThread> control_thread(new ControlThread());
+                    return_code = FLAGS_dry_run_capacity ? control_thread->dry_run_capacity() : control_thread->run();
+                }
+            else
+                {
+                    return_code = run_receivers(FLAGS_config_files);
+                }
         }
     catch (const boost::exception& e)
         {
@@ -0,0 +1,369 @@
+/*!
+ * \file acquisition_benchmark.cc
+ * \brief Measures the processing time and the memory footprint of the
+ * acquisition implementations over a sweep of grid sizes.
+ *
+ * For every combination of implementation, sampling rate, number of Doppler
+ * bins, number of dwells, bit transition flag, number of Doppler threads and
+ * folding factor, the acquisition block is run over Gaussian noise with an
+ * unreachable threshold, so all the dwells are always computed. The time
+ * spent by the same flow graph with the acquisition block in standby is
+ * subtracted. Optionally, the sensitivity is estimated as the rate of runs
+ * that find the code phase of a GPS L1 C/A signal at a given C/N0. The
+ * results are written in JSON format.
+ *
+ * -------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2018  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *          Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------
+ */
+
+#include "acquisition_interface.h"
+#include "concurrent_map.h"
+#include "concurrent_queue.h"
+#include "gnss_block_factory.h"
+#include "gnss_synchro.h"
+#include "gps_acq_assist.h"
+#include "gps_sdr_signal_processing.h"
+#include "in_memory_configuration.h"
+#include <boost/tokenizer.hpp>
+#include <gflags/gflags.h>
+#include <glog/logging.h>
+#include <gnuradio/blocks/head.h>
+#include <gnuradio/blocks/vector_source_c.h>
+#include <gnuradio/msg_queue.h>
+#include <gnuradio/top_block.h>
+#include <unistd.h>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+
+concurrent_queue<Gps_Acq_Assist> global_gps_acq_assist_queue;
+
+concurrent_map<Gps_Acq_Assist> global_gps_acq_assist_map;
+
+DEFINE_string(implementations, "GPS_L1_CA_PCPS_Acquisition,GPS_L1_CA_PCPS_QuickSync_Acquisition,GPS_L1_CA_PCPS_Tong_Acquisition,GPS_L1_CA_PCPS_OpenCl_Acquisition", "Comma-separated list of acquisition implementations");
+DEFINE_string(fs_hz, "2000000,4000000,8000000", "Comma-separated list of sampling rates [Hz], which set the FFT length");
+DEFINE_string(doppler_bins, "20,40,80", "Comma-separated list of numbers of Doppler bins");
+DEFINE_int32(doppler_step, 250, "Doppler step [Hz]");
+DEFINE_string(max_dwells, "1,2", "Comma-separated list of numbers of dwells");
+DEFINE_string(bit_transition_flag, "false,true", "Comma-separated list of bit_transition_flag values");
+DEFINE_string(doppler_threads, "1", "Comma-separated list of numbers of Doppler grid threads (PCPS only)");
+DEFINE_string(folding_factors, "1", "Comma-separated list of folding factors of the first step search (PCPS only)");
+DEFINE_int32(detection_trials, 0, "Number of runs with a GPS L1 C/A signal to estimate the code phase hit rate (0 to skip it)");
+DEFINE_double(cn0_dB_Hz, 40.0, "C/N0 [dB-Hz] of the signal used to estimate the code phase hit rate");
+DEFINE_int32(trials, 10, "Number of runs averaged for each configuration");
+DEFINE_string(output, "", "JSON output file (standard output if empty)");
+
+
+std::vector<std::string> split_list(const std::string& list)
+{
+    std::vector<std::string> items;
+    boost::char_separator<char> sep(",");
+    boost::tokenizer<boost::char_separator<char> > tokens(list, sep);
+    for (const auto& token : tokens)
+        {
+            items.push_back(token);
+        }
+    return items;
+}
+
+
+// Resident memory of the process [MB], or a negative value if it is not available
+double resident_memory_mb()
+{
+    std::ifstream statm("/proc/self/statm");
+    uint64_t total_pages = 0;
+    uint64_t resident_pages = 0;
+    if (!(statm >> total_pages >> resident_pages))
+        {
+            return -1.0;
+        }
+    return static_cast<double>(resident_pages) * static_cast<double>(sysconf(_SC_PAGESIZE)) / (1024.0 * 1024.0);
+}
+
+
+struct Benchmark_Result
+{
+    uint32_t dwells;  // dwells of each acquisition
+    double us_per_dwell_mean;
+    double us_per_dwell_min;
+    double memory_mb;
+    double code_phase_hit_rate;  // negative if not estimated
+};
+
+
+// Runs the flow graph once, with the acquisition active or in standby, and returns the elapsed time [s]
+double run_once(std::shared_ptr<AcquisitionInterface> acquisition, const std::vector<gr_complex>& noise, uint64_t nsamples, bool active)
+{
+    gr::top_block_sptr top_block = gr::make_top_block("Acquisition benchmark");
+    gr::blocks::vector_source_c::sptr source = gr::blocks::vector_source_c::make(noise, true);
+    gr::blocks::head::sptr head = gr::blocks::head::make(sizeof(gr_complex), nsamples);
+    acquisition->connect(top_block);
+    top_block->connect(source, 0, head, 0);
+    top_block->connect(head, 0, acquisition->get_left_block(), 0);
+    acquisition->set_state(0);
+    if (active)
+        {
+            acquisition->reset();
+        }
+    else
+        {
+            acquisition->stop_acquisition();
+        }
+    std::chrono::time_point<std::chrono::steady_clock> start = std::chrono::steady_clock::now();
+    top_block->run();
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    acquisition->disconnect(top_block);
+    return elapsed.count();
+}
+
+
+// Rate of runs that find the code phase of a GPS L1 C/A signal at FLAGS_cn0_dB_Hz, within half a chip
+double code_phase_hit_rate(std::shared_ptr<AcquisitionInterface> acquisition, Gnss_Synchro& gnss_synchro, int64_t fs_hz, uint64_t samples_per_dwell, uint64_t nsamples)
+{
+    auto samples_per_code = static_cast<uint32_t>(fs_hz / 1000);
+    std::vector<gr_complex> code(samples_per_code);
+    gps_l1_ca_code_gen_complex_sampled(code.data(), gnss_synchro.PRN, static_cast<int32_t>(fs_hz), 0);
+
+    // Unit variance noise in each component, so N0 = 2 / fs_hz
+    float amplitude = static_cast<float>(std::sqrt(2.0 * std::pow(10.0, FLAGS_cn0_dB_Hz / 10.0) / static_cast<double>(fs_hz)));
+    double tolerance = static_cast<double>(fs_hz) / 1.023e6 / 2.0;
+    std::mt19937 generator(4321);
+    std::uniform_int_distribution<uint32_t> delays(0, samples_per_code - 1);
+    std::normal_distribution<float> distribution(0.0, 1.0);
+    int32_t hits = 0;
+    for (int32_t trial = 0; trial < FLAGS_detection_trials; trial++)
+        {
+            uint32_t delay = delays(generator);
+            std::vector<gr_complex> signal(samples_per_dwell);
+            for (uint64_t i = 0; i < samples_per_dwell; i++)
+                {
+                    signal[i] = amplitude * code[(i + samples_per_code - delay) % samples_per_code] + gr_complex(distribution(generator), distribution(generator));
+                }
+            run_once(acquisition, signal, nsamples, true);
+            double error = std::abs(gnss_synchro.Acq_delay_samples - static_cast<double>(delay));
+            error = std::min(error, static_cast<double>(samples_per_code) - error);
+            if (error <= tolerance)
+                {
+                    hits++;
+                }
+        }
+    return static_cast<double>(hits) / static_cast<double>(FLAGS_detection_trials);
+}
+
+
+// Dwells of each acquisition with the threshold never reached, as the adapters set them
+uint32_t dwells_per_acquisition(const std::string& implementation, uint32_t max_dwells, bool bit_transition_flag)
+{
+    if (!bit_transition_flag or (implementation.find("Tong") != std::string::npos))
+        {
+            return max_dwells;
+        }
+    if ((implementation.find("QuickSync") != std::string::npos) or (implementation.find("OpenCl") != std::string::npos))
+        {
+            return 2;
+        }
+    // PCPS searches a single dwell of two code periods
+    return 1;
+}
+
+
+bool run_benchmark(const std::string& implementation, int64_t fs_hz, uint32_t doppler_bins, uint32_t max_dwells, bool bit_transition_flag, uint32_t doppler_threads, uint32_t folding_factor, Benchmark_Result& result)
+{
+    uint32_t doppler_max = doppler_bins * FLAGS_doppler_step / 2;
+    // QuickSync needs several code periods per dwell
+    uint32_t coherent_integration_time_ms = (implementation.find("QuickSync") != std::string::npos ? 4 : 1);
+    uint64_t samples_per_dwell = static_cast<uint64_t>(fs_hz) * coherent_integration_time_ms / 1000 * (bit_transition_flag ? 2 : 1);
+
+    std::shared_ptr<InMemoryConfiguration> config = std::make_shared<InMemoryConfiguration>();
+    config->set_property("GNSS-SDR.internal_fs_sps", std::to_string(fs_hz));
+    config->set_property("Acquisition_1C.implementation", implementation);
+    config->set_property("Acquisition_1C.item_type", "gr_complex");
+    config->set_property("Acquisition_1C.coherent_integration_time_ms", std::to_string(coherent_integration_time_ms));
+    config->set_property("Acquisition_1C.doppler_max", std::to_string(doppler_max));
+    config->set_property("Acquisition_1C.doppler_step", std::to_string(FLAGS_doppler_step));
+    config->set_property("Acquisition_1C.max_dwells", std::to_string(max_dwells));
+    config->set_property("Acquisition_1C.tong_max_dwells", std::to_string(max_dwells));
+    config->set_property("Acquisition_1C.bit_transition_flag", bit_transition_flag ? "true" : "false");
+    config->set_property("Acquisition_1C.doppler_threads", std::to_string(doppler_threads));
+    if (implementation.find("QuickSync") == std::string::npos)
+        {
+            // QuickSync computes its own folding factor
+            config->set_property("Acquisition_1C.folding_factor", std::to_string(folding_factor));
+        }
+    config->set_property("Acquisition_1C.blocking", "true");
+    config->set_property("Acquisition_1C.dump", "false");
+    config->set_property("Acquisition_1C.repeat_satellite", "false");
+
+    Gnss_Synchro gnss_synchro = Gnss_Synchro();
+    gnss_synchro.System = 'G';
+    std::string signal = "1C";
+    signal.copy(gnss_synchro.Signal, 2, 0);
+    gnss_synchro.PRN = 1;
+
+    double memory_before = resident_memory_mb();
+    std::shared_ptr<GNSSBlockFactory> factory = std::make_shared<GNSSBlockFactory>();
+    gr::msg_queue::sptr queue = gr::msg_queue::make(0);
+    std::shared_ptr<GNSSBlockInterface> block = factory->GetBlock(config, "Acquisition_1C", implementation, 1, 0, queue);
+    std::shared_ptr<AcquisitionInterface> acquisition = std::dynamic_pointer_cast<AcquisitionInterface>(block);
+    if (!acquisition)
+        {
+            std::cerr << "Implementation " << implementation << " is not available in this build" << std::endl;
+            return false;
+        }
+    acquisition->set_gnss_synchro(&gnss_synchro);
+    acquisition->set_channel(0);
+    acquisition->set_threshold(1e9);  // never reached: all the dwells are always computed
+    acquisition->set_doppler_max(doppler_max);
+    acquisition->set_doppler_step(FLAGS_doppler_step);
+    acquisition->init();
+    acquisition->set_local_code();
+
+    std::vector<gr_complex> noise(samples_per_dwell);
+    std::mt19937 generator(1234);
+    std::normal_distribution<float> distribution(0.0, 1.0);
+    for (auto& sample : noise)
+        {
+            sample = gr_complex(distribution(generator), distribution(generator));
+        }
+    result.dwells = dwells_per_acquisition(implementation, max_dwells, bit_transition_flag);
+    // some extra samples for the implementations that skip the first block
+    uint64_t nsamples = (result.dwells + 2) * samples_per_dwell;
+
+    // The first run includes plan creation and buffer initialization
+    run_once(acquisition, noise, nsamples, true);
+    std::vector<double> us_per_dwell;
+    for (int32_t trial = 0; trial < FLAGS_trials; trial++)
+        {
+            double active = run_once(acquisition, noise, nsamples, true);
+            double standby = run_once(acquisition, noise, nsamples, false);
+            us_per_dwell.push_back(std::max(active - standby, 0.0) * 1e6 / static_cast<double>(result.dwells));
+        }
+    double memory_after = resident_memory_mb();
+
+    result.us_per_dwell_mean = 0.0;
+    for (double t : us_per_dwell)
+        {
+            result.us_per_dwell_mean += t / static_cast<double>(us_per_dwell.size());
+        }
+    result.us_per_dwell_min = (us_per_dwell.empty() ? 0.0 : *std::min_element(us_per_dwell.begin(), us_per_dwell.end()));
+    result.memory_mb = ((memory_before < 0.0) or (memory_after < 0.0)) ? -1.0 : memory_after - memory_before;
+    result.code_phase_hit_rate = -1.0;
+    if (FLAGS_detection_trials > 0)
+        {
+            result.code_phase_hit_rate = code_phase_hit_rate(acquisition, gnss_synchro, fs_hz, samples_per_dwell, nsamples);
+        }
+    return true;
+}
+
+
+// Runs the sweep of parameters of an implementation, appending its results to json
+void benchmark_implementation(const std::string& implementation, std::stringstream& json, bool& first)
+{
+    for (const auto& fs_hz : split_list(FLAGS_fs_hz))
+        {
+            for (const auto& doppler_bins : split_list(FLAGS_doppler_bins))
+                {
+                    for (const auto& max_dwells : split_list(FLAGS_max_dwells))
+                        {
+                            for (const auto& bit_transition_flag : split_list(FLAGS_bit_transition_flag))
+                                {
+                                    for (const auto& doppler_threads : split_list(FLAGS_doppler_threads))
+                                        {
+                                            for (const auto& folding_factor : split_list(FLAGS_folding_factors))
+                                                {
+                                                    Benchmark_Result result{};
+                                                    bool bit_transition = (bit_transition_flag == "true") or (bit_transition_flag == "1");
+                                                    if (!run_benchmark(implementation, std::stoll(fs_hz), std::stoul(doppler_bins), std::stoul(max_dwells), bit_transition, std::stoul(doppler_threads), std::stoul(folding_factor), result))
+                                                        {
+                                                            // not available in this build: skip the rest of its sweep
+                                                            return;
+                                                        }
+                                                    json << (first ? "" : ",\n")
+                                                         << "  {\"implementation\": \"" << implementation << "\""
+                                                         << ", \"fs_hz\": " << fs_hz
+                                                         << ", \"doppler_bins\": " << doppler_bins
+                                                         << ", \"doppler_step_hz\": " << FLAGS_doppler_step
+                                                         << ", \"max_dwells\": " << max_dwells
+                                                         << ", \"dwells\": " << result.dwells
+                                                         << ", \"bit_transition_flag\": " << (bit_transition ? "true" : "false")
+                                                         << ", \"doppler_threads\": " << doppler_threads
+                                                         << ", \"folding_factor\": " << folding_factor
+                                                         << ", \"folding_loss_dB\": " << 10.0 * std::log10(std::stod(folding_factor))
+                                                         << ", \"trials\": " << FLAGS_trials
+                                                         << ", \"us_per_dwell_mean\": " << result.us_per_dwell_mean
+                                                         << ", \"us_per_dwell_min\": " << result.us_per_dwell_min
+                                                         << ", \"memory_MB\": " << result.memory_mb;
+                                                    if (result.code_phase_hit_rate >= 0.0)
+                                                        {
+                                                            json << ", \"cn0_dB_Hz\": " << FLAGS_cn0_dB_Hz
+                                                                 << ", \"code_phase_hit_rate\": " << result.code_phase_hit_rate;
+                                                        }
+                                                    json << "}";
+                                                    first = false;
+                                                    std::cerr << "." << std::flush;
+                                                }
+                                        }
+                                }
+                        }
+                }
+        }
+}
+
+
+int main(int argc, char** argv)
+{
+    google::SetUsageMessage("Measures the processing time of the acquisition implementations over a sweep of grid sizes");
+    google::ParseCommandLineFlags(&argc, &argv, true);
+    google::InitGoogleLogging(argv[0]);
+
+    std::stringstream json;
+    json << "[" << std::endl;
+    bool first = true;
+    for (const auto& implementation : split_list(FLAGS_implementations))
+        {
+            benchmark_implementation(implementation, json, first);
+        }
+    json << std::endl
+         << "]" << std::endl;
+    std::cerr << std::endl;
+
+    if (FLAGS_output.empty())
+        {
+            std::cout << json.str();
+        }
+    else
+        {
+            std::ofstream output(FLAGS_output);
+            output << json.str();
+        }
+    google::ShutDownCommandLineFlags();
+    return 0;
+}
@@ -0,0 +1,246 @@
+/*!
+ * \file lambda_benchmark.cc
+ * \brief Compares the processing time of the LAMBDA/MLAMBDA integer ambiguity
+ * resolution used by the RTK solver with the reference RTKLIB implementation.
+ *
+ * The float ambiguities and their covariance matrices are read from a text
+ * file, one epoch per line (n, then the n float ambiguities, then the n x n
+ * covariance matrix in column-major order), or simulated with a random
+ * geometry if no file is given. Both implementations must return the same
+ * fixed solutions. The results are written in JSON format.
+ *
+ * -------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2018  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *          Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------
+ */
+
+#include "rtklib_lambda.h"
+#include "rtklib_rtkcmn.h"
+#include <gflags/gflags.h>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+
+DEFINE_string(input, "", "Text file with the float ambiguities and covariance matrices of the recorded epochs (simulated epochs if empty)");
+DEFINE_string(ambiguities, "10,20,30,40,60", "Comma-separated list of numbers of ambiguities of the simulated epochs");
+DEFINE_int32(epochs, 200, "Number of simulated epochs for each number of ambiguities");
+DEFINE_int32(trials, 10, "Number of runs averaged for each epoch");
+DEFINE_string(output, "", "JSON output file (standard output if empty)");
+
+
+struct Lambda_Epoch
+{
+    int n;
+    std::vector<double> a;
+    std::vector<double> Q;
+};
+
+
+// Reference implementation: RTKLIB lambda() with a heap allocation per matrix and a LU solve of Z'*F=E
+int lambda_reference(int n, int m, const double* a, const double* Q, double* F, double* s)
+{
+    int info;
+    double *L, *D, *Z, *z, *E;
+
+    if (n <= 0 || m <= 0) return -1;
+    L = zeros(n, n);
+    D = mat(n, 1);
+    Z = eye(n);
+    z = mat(n, 1);
+    E = mat(n, m);
+    if (!(info = LD(n, Q, L, D)))
+        {
+            reduction(n, L, D, Z);
+            matmul("TN", n, 1, n, 1.0, Z, a, 0.0, z);
+            if (!(info = search(n, m, L, D, z, E, s)))
+                {
+                    info = solve("T", Z, E, n, m, F);
+                }
+        }
+    free(L);
+    free(D);
+    free(Z);
+    free(z);
+    free(E);
+    return info;
+}
+
+
+// Float ambiguities dominated by the common position error of a random geometry
+std::vector<Lambda_Epoch> simulate_epochs(int n, int epochs, std::mt19937& generator)
+{
+    std::normal_distribution<double> distribution(0.0, 1.0);
+    std::vector<Lambda_Epoch> result(epochs);
+    for (auto& epoch : result)
+        {
+            std::vector<double> G(n * 4);
+            for (auto& g : G) g = distribution(generator);
+            epoch.n = n;
+            epoch.a.resize(n);
+            epoch.Q.resize(n * n);
+            for (int i = 0; i < n; i++)
+                {
+                    for (int j = 0; j < n; j++)
+                        {
+                            double q = (i == j ? 4e-4 : 0.0);
+                            for (int k = 0; k < 4; k++) q += 0.01 * G[i + k * n] * G[j + k * n];
+                            epoch.Q[i + j * n] = q;
+                        }
+                    epoch.a[i] = std::round(20.0 * distribution(generator)) + 0.02 * distribution(generator);
+                }
+        }
+    return result;
+}
+
+
+std::vector<Lambda_Epoch> read_epochs(const std::string& filename)
+{
+    std::vector<Lambda_Epoch> result;
+    std::ifstream input(filename);
+    std::string line;
+    while (std::getline(input, line))
+        {
+            std::istringstream fields(line);
+            Lambda_Epoch epoch;
+            if (!(fields >> epoch.n) or epoch.n <= 0)
+                {
+                    continue;
+                }
+            epoch.a.resize(epoch.n);
+            epoch.Q.resize(epoch.n * epoch.n);
+            bool ok = true;
+            for (auto& x : epoch.a) ok = ok and static_cast<bool>(fields >> x);
+            for (auto& x : epoch.Q) ok = ok and static_cast<bool>(fields >> x);
+            if (ok)
+                {
+                    result.push_back(epoch);
+                }
+        }
+    return result;
+}
+
+
+// Runs both implementations over the epochs with n ambiguities and writes a JSON object
+void run_benchmark(int n, const std::vector<Lambda_Epoch>& epochs, std::ostream& json)
+{
+    const int m = 2;  // as in the RTK solver
+    std::vector<double> F_ref(n * m), F(n * m), s_ref(m), s(m);
+    double t_ref = 0.0;
+    double t_new = 0.0;
+    int mismatches = 0;
+    int failures = 0;
+    int count = 0;
+    for (const auto& epoch : epochs)
+        {
+            if (epoch.n != n)
+                {
+                    continue;
+                }
+            std::chrono::time_point<std::chrono::steady_clock> start = std::chrono::steady_clock::now();
+            int info_ref = 0;
+            for (int32_t trial = 0; trial < FLAGS_trials; trial++) info_ref = lambda_reference(n, m, epoch.a.data(), epoch.Q.data(), F_ref.data(), s_ref.data());
+            std::chrono::time_point<std::chrono::steady_clock> middle = std::chrono::steady_clock::now();
+            int info = 0;
+            for (int32_t trial = 0; trial < FLAGS_trials; trial++) info = lambda(n, m, epoch.a.data(), epoch.Q.data(), F.data(), s.data());
+            std::chrono::time_point<std::chrono::steady_clock> end = std::chrono::steady_clock::now();
+            t_ref += std::chrono::duration<double>(middle - start).count();
+            t_new += std::chrono::duration<double>(end - middle).count();
+            count++;
+            if (info_ref != 0) failures++;
+            bool same = (info == info_ref);
+            for (int i = 0; same and info == 0 and i < n * m; i++) same = std::fabs(F[i] - F_ref[i]) < 1e-6;
+            if (!same) mismatches++;
+        }
+    if (count == 0)
+        {
+            return;
+        }
+    double runs = static_cast<double>(count) * FLAGS_trials;
+    json << "  {\"ambiguities\": " << n
+         << ", \"epochs\": " << count
+         << ", \"trials\": " << FLAGS_trials
+         << ", \"search_failures\": " << failures
+         << ", \"mismatches\": " << mismatches
+         << ", \"us_reference\": " << t_ref * 1e6 / runs
+         << ", \"us_lambda\": " << t_new * 1e6 / runs
+         << ", \"speedup\": " << (t_new > 0.0 ? t_ref / t_new : 0.0) << "}";
+}
+
+
+int main(int argc, char** argv)
+{
+    google::SetUsageMessage("Compares the processing time of the LAMBDA integer ambiguity resolution with the reference RTKLIB implementation");
+    google::ParseCommandLineFlags(&argc, &argv, true);
+
+    std::vector<Lambda_Epoch> epochs;
+    std::vector<int> sizes;
+    if (FLAGS_input.empty())
+        {
+            std::mt19937 generator(1234);
+            std::stringstream list(FLAGS_ambiguities);
+            std::string item;
+            while (std::getline(list, item, ','))
+                {
+                    int n = std::stoi(item);
+                    std::vector<Lambda_Epoch> simulated = simulate_epochs(n, FLAGS_epochs, generator);
+                    epochs.insert(epochs.end(), simulated.begin(), simulated.end());
+                    sizes.push_back(n);
+                }
+        }
+    else
+        {
+            epochs = read_epochs(FLAGS_input);
+            for (const auto& epoch : epochs) sizes.push_back(epoch.n);
+            std::sort(sizes.begin(), sizes.end());
+            sizes.erase(std::unique(sizes.begin(), sizes.end()), sizes.end());
+        }
+
+    std::stringstream json;
+    json << "[" << std::endl;
+    for (size_t i = 0; i < sizes.size(); i++)
+        {
+            json << (i == 0 ? "" : ",\n");
+            run_benchmark(sizes[i], epochs, json);
+        }
+    json << std::endl
+         << "]" << std::endl;
+
+    if (FLAGS_output.empty())
+        {
+            std::cout << json.str();
+        }
+    else
+        {
+            std::ofstream output(FLAGS_output);
+            output << json.str();
+        }
+    google::ShutDownCommandLineFlags();
+    return 0;
+}
@@ -0,0 +1,204 @@
+/*!
+ * \file multicorrelator_benchmark.cc
+ * \brief Google Benchmark microbenchmarks of the multicorrelators of the
+ * tracking blocks, one per channel, with as many channels as threads.
+ *
+ * Each benchmark thread runs its own multicorrelator, as the channels of the
+ * receiver do, so the results show how the correlation throughput scales
+ * with the number of channels on the host. Run benchmark_gnss_sdr
+ * --benchmark_format=json (or --benchmark_out=file.json) to get results that
+ * can be tracked per commit and compared across machines.
+ *
+ * -------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2019  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *          Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------
+ */
+
+#include "GPS_L1_CA.h"
+#include "cpu_multicorrelator.h"
+#include "cpu_multicorrelator_16sc.h"
+#include "cpu_multicorrelator_real_codes.h"
+#include "gps_sdr_signal_processing.h"
+#include <benchmark/benchmark.h>
+#include <volk_gnsssdr/volk_gnsssdr.h>
+#include <atomic>
+#include <complex>
+#include <random>
+#include <vector>
+
+
+// Upper bound of the number of channels
+const int MAX_CHANNELS = 8;
+
+
+void multicorrelator_args(benchmark::internal::Benchmark* b)
+{
+    // 1 ms of GPS L1 C/A at 2, 4 and 8 Msps, with Early-Prompt-Late and with two more taps
+    for (auto samples : {2000, 4000, 8000})
+        {
+            for (auto taps : {3, 5})
+                {
+                    b->Args({samples, taps});
+                }
+        }
+}
+
+
+// Each thread tracks a different satellite, whatever the Google Benchmark version
+std::atomic<int> next_channel(0);
+
+int channel_prn()
+{
+    return next_channel.fetch_add(1) % 32 + 1;
+}
+
+
+std::vector<float> tap_shifts(int taps)
+{
+    // half a chip spacing, centered on the prompt correlator
+    std::vector<float> shifts_chips(taps);
+    for (int n = 0; n < taps; n++)
+        {
+            shifts_chips[n] = 0.5F * static_cast<float>(n - taps / 2);
+        }
+    return shifts_chips;
+}
+
+
+std::vector<std::complex<float>> noisy_samples(int length, int seed)
+{
+    std::default_random_engine generator(seed);
+    std::normal_distribution<float> noise(0.0, 1.0);
+    std::vector<std::complex<float>> samples(length);
+    for (auto& sample : samples)
+        {
+            sample = std::complex<float>(noise(generator), noise(generator));
+        }
+    return samples;
+}
+
+
+static void BM_cpu_multicorrelator_real_codes(benchmark::State& state, bool high_dynamics)
+{
+    const int samples = state.range(0);
+    const int taps = state.range(1);
+    const int prn = channel_prn();
+    const int code_length = static_cast<int>(GPS_L1_CA_CODE_LENGTH_CHIPS);
+    std::vector<float> code(code_length);
+    gps_l1_ca_code_gen_float(code.data(), prn, 0);
+    std::vector<float> shifts_chips = tap_shifts(taps);
+    std::vector<std::complex<float>> in = noisy_samples(samples, prn);
+    auto* corr_out = static_cast<std::complex<float>*>(volk_gnsssdr_malloc(taps * sizeof(std::complex<float>), volk_gnsssdr_get_alignment()));
+
+    cpu_multicorrelator_real_codes correlator;
+    correlator.set_high_dynamics_resampler(high_dynamics);
+    correlator.init(samples, taps);
+    correlator.set_local_code_and_taps(code_length, code.data(), shifts_chips.data());
+    correlator.set_input_output_vectors(corr_out, in.data());
+    const float code_phase_step_chips = static_cast<float>(code_length) / static_cast<float>(samples);
+    for (auto _ : state)
+        {
+            correlator.Carrier_wipeoff_multicorrelator_resampler(0.1F, 0.01F, 1e-7F, 0.3F, code_phase_step_chips, 1e-9F, samples);
+            benchmark::DoNotOptimize(corr_out);
+            benchmark::ClobberMemory();
+        }
+    correlator.free();
+    volk_gnsssdr_free(corr_out);
+    state.SetItemsProcessed(state.iterations() * samples);
+    state.SetLabel(volk_gnsssdr_get_machine());
+}
+BENCHMARK_CAPTURE(BM_cpu_multicorrelator_real_codes, standard, false)->Apply(multicorrelator_args)->ThreadRange(1, MAX_CHANNELS)->UseRealTime();
+BENCHMARK_CAPTURE(BM_cpu_multicorrelator_real_codes, high_dynamics, true)->Apply(multicorrelator_args)->ThreadRange(1, MAX_CHANNELS)->UseRealTime();
+
+
+static void BM_cpu_multicorrelator(benchmark::State& state)
+{
+    const int samples = state.range(0);
+    const int taps = state.range(1);
+    const int prn = channel_prn();
+    const int code_length = static_cast<int>(GPS_L1_CA_CODE_LENGTH_CHIPS);
+    std::vector<std::complex<float>> code(code_length);
+    gps_l1_ca_code_gen_complex(code.data(), prn, 0);
+    std::vector<float> shifts_chips = tap_shifts(taps);
+    std::vector<std::complex<float>> in = noisy_samples(samples, prn);
+    auto* corr_out = static_cast<std::complex<float>*>(volk_gnsssdr_malloc(taps * sizeof(std::complex<float>), volk_gnsssdr_get_alignment()));
+
+    cpu_multicorrelator correlator;
+    correlator.init(samples, taps);
+    correlator.set_local_code_and_taps(code_length, code.data(), shifts_chips.data());
+    correlator.set_input_output_vectors(corr_out, in.data());
+    const float code_phase_step_chips = static_cast<float>(code_length) / static_cast<float>(samples);
+    for (auto _ : state)
+        {
+            correlator.Carrier_wipeoff_multicorrelator_resampler(0.1F, 0.01F, 0.3F, code_phase_step_chips, samples);
+            benchmark::DoNotOptimize(corr_out);
+            benchmark::ClobberMemory();
+        }
+    correlator.free();
+    volk_gnsssdr_free(corr_out);
+    state.SetItemsProcessed(state.iterations() * samples);
+    state.SetLabel(volk_gnsssdr_get_machine());
+}
+BENCHMARK(BM_cpu_multicorrelator)->Apply(multicorrelator_args)->ThreadRange(1, MAX_CHANNELS)->UseRealTime();
+
+
+static void BM_cpu_multicorrelator_16sc(benchmark::State& state)
+{
+    const int samples = state.range(0);
+    const int taps = state.range(1);
+    const int prn = channel_prn();
+    const int code_length = static_cast<int>(GPS_L1_CA_CODE_LENGTH_CHIPS);
+    std::vector<float> code_float(code_length);
+    gps_l1_ca_code_gen_float(code_float.data(), prn, 0);
+    std::vector<lv_16sc_t> code(code_length);
+    for (int n = 0; n < code_length; n++)
+        {
+            code[n] = lv_cmake(static_cast<int16_t>(code_float[n]), static_cast<int16_t>(0));
+        }
+    std::vector<float> shifts_chips = tap_shifts(taps);
+    std::vector<std::complex<float>> noise = noisy_samples(samples, prn);
+    std::vector<lv_16sc_t> in(samples);
+    for (int n = 0; n < samples; n++)
+        {
+            // 4-bit front-end
+            in[n] = lv_cmake(static_cast<int16_t>(4.0F * noise[n].real()), static_cast<int16_t>(4.0F * noise[n].imag()));
+        }
+    auto* corr_out = static_cast<lv_16sc_t*>(volk_gnsssdr_malloc(taps * sizeof(lv_16sc_t), volk_gnsssdr_get_alignment()));
+
+    cpu_multicorrelator_16sc correlator;
+    correlator.init(samples, taps);
+    correlator.set_local_code_and_taps(code_length, code.data(), shifts_chips.data());
+    correlator.set_input_output_vectors(corr_out, in.data());
+    const float code_phase_step_chips = static_cast<float>(code_length) / static_cast<float>(samples);
+    for (auto _ : state)
+        {
+            correlator.Carrier_wipeoff_multicorrelator_resampler(0.1F, 0.01F, 0.3F, code_phase_step_chips, samples);
+            benchmark::DoNotOptimize(corr_out);
+            benchmark::ClobberMemory();
+        }
+    correlator.free();
+    volk_gnsssdr_free(corr_out);
+    state.SetItemsProcessed(state.iterations() * samples);
+    state.SetLabel(volk_gnsssdr_get_machine());
+}
+BENCHMARK(BM_cpu_multicorrelator_16sc)->Apply(multicorrelator_args)->ThreadRange(1, MAX_CHANNELS)->UseRealTime();
@@ -0,0 +1,525 @@
+/*!
+ * \file volk_gnsssdr_kernels_benchmark.cc
+ * \brief Google Benchmark microbenchmarks of the VOLK_GNSSSDR kernels in the
+ * hot paths of the receiver: rotator dot products and code resamplers of the
+ * tracking blocks, maximum searches of the acquisition blocks, and sample
+ * conversions and unpackers of the signal sources.
+ *
+ * The kernels are called through their dispatchers, so they run the
+ * implementations selected by the volk_gnsssdr_config file of the host. Run
+ * benchmark_gnss_sdr --benchmark_format=json (or --benchmark_out=file.json)
+ * to get results that can be tracked per commit and compared across machines.
+ *
+ * -------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2019  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *          Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------
+ */
+
+#include "GPS_L1_CA.h"
+#include "gps_sdr_signal_processing.h"
+#include <benchmark/benchmark.h>
+#include <volk_gnsssdr/volk_gnsssdr.h>
+#include <array>
+#include <cmath>
+#include <complex>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+
+// Samples of a coherent integration: 1 ms at 2, 4, 8 and 25 Msps, and 4 ms (Galileo E1) at 4 Msps
+const std::array<int64_t, 5> INTEGRATION_SAMPLES = {{2000, 4000, 8000, 16000, 25000}};
+
+// Early-Prompt-Late, plus Very Early and Very Late, plus two more for multipath monitoring
+const std::array<int64_t, 3> CORRELATOR_TAPS = {{3, 5, 7}};
+
+// Items of the buffers exchanged by the signal source blocks
+const std::array<int64_t, 3> BUFFER_ITEMS = {{4096, 32768, 262144}};
+
+// Lengths of the FFTs of the acquisition blocks
+const std::array<int64_t, 4> ACQUISITION_POINTS = {{4000, 8192, 16384, 65536}};
+
+
+void tracking_args(benchmark::internal::Benchmark* b)
+{
+    for (auto samples : INTEGRATION_SAMPLES)
+        {
+            for (auto taps : CORRELATOR_TAPS)
+                {
+                    b->Args({samples, taps});
+                }
+        }
+}
+
+
+void buffer_args(benchmark::internal::Benchmark* b)
+{
+    for (auto items : BUFFER_ITEMS)
+        {
+            b->Arg(items);
+        }
+}
+
+
+void acquisition_args(benchmark::internal::Benchmark* b)
+{
+    for (auto points : ACQUISITION_POINTS)
+        {
+            b->Arg(points);
+        }
+}
+
+
+/*!
+ * \brief Buffers aligned as the ones of the receiver blocks, so that the
+ * dispatchers pick the aligned implementations. Each vector starts on an
+ * aligned address.
+ */
+template <typename T>
+class Aligned_Vectors
+{
+public:
+    Aligned_Vectors(int n_vectors, int length)
+    {
+        d_stride = ((length + 15) / 16) * 16;
+        d_data = static_cast<T*>(volk_gnsssdr_malloc(n_vectors * d_stride * sizeof(T), volk_gnsssdr_get_alignment()));
+        for (int n = 0; n < n_vectors; n++)
+            {
+                d_vectors.push_back(d_data + n * d_stride);
+            }
+    }
+    ~Aligned_Vectors()
+    {
+        volk_gnsssdr_free(d_data);
+    }
+    Aligned_Vectors(const Aligned_Vectors&) = delete;
+    Aligned_Vectors& operator=(const Aligned_Vectors&) = delete;
+
+    T* operator[](int n) const { return d_vectors[n]; }
+    T** data() { return d_vectors.data(); }
+    const T** const_data() { return const_cast<const T**>(d_vectors.data()); }
+
+private:
+    T* d_data;
+    int d_stride;
+    std::vector<T*> d_vectors;
+};
+
+
+void random_samples(lv_32fc_t* out, int length)
+{
+    std::default_random_engine generator(1);
+    std::normal_distribution<float> noise(0.0, 1.0);
+    for (int n = 0; n < length; n++)
+        {
+            out[n] = lv_cmake(noise(generator), noise(generator));
+        }
+}
+
+
+std::vector<float> shifts(int taps)
+{
+    // half a chip spacing, centered on the prompt correlator
+    std::vector<float> shifts_chips(taps);
+    for (int n = 0; n < taps; n++)
+        {
+            shifts_chips[n] = 0.5F * static_cast<float>(n - taps / 2);
+        }
+    return shifts_chips;
+}
+
+
+//////////////////////////////////////////////////////////////////////////////
+// Tracking: carrier wipe-off and correlation
+//////////////////////////////////////////////////////////////////////////////
+
+static void BM_32fc_x2_rotator_dot_prod_32fc_xn(benchmark::State& state)
+{
+    const int samples = state.range(0);
+    const int taps = state.range(1);
+    Aligned_Vectors<lv_32fc_t> in(1, samples);
+    Aligned_Vectors<lv_32fc_t> codes(taps, samples);
+    Aligned_Vectors<lv_32fc_t> result(1, taps);
+    random_samples(in[0], samples);
+    for (int n = 0; n < taps; n++)
+        {
+            random_samples(codes[n], samples);
+        }
+    const lv_32fc_t phase_inc = lv_cmake(std::cos(0.1F), std::sin(0.1F));
+    lv_32fc_t phase = lv_cmake(1.0F, 0.0F);
+    for (auto _ : state)
+        {
+            volk_gnsssdr_32fc_x2_rotator_dot_prod_32fc_xn(result[0], in[0], phase_inc, &phase, codes.const_data(), taps, samples);
+            benchmark::DoNotOptimize(result[0]);
+        }
+    state.SetItemsProcessed(state.iterations() * samples);
+    state.SetLabel(volk_gnsssdr_get_machine());
+}
+BENCHMARK(BM_32fc_x2_rotator_dot_prod_32fc_xn)->Apply(tracking_args);
+
+
+static void BM_32fc_32f_rotator_dot_prod_32fc_xn(benchmark::State& state)
+{
+    const int samples = state.range(0);
+    const int taps = state.range(1);
+    Aligned_Vectors<lv_32fc_t> in(1, samples);
+    Aligned_Vectors<float> codes(taps, samples);
+    Aligned_Vectors<lv_32fc_t> result(1, taps);
+    random_samples(in[0], samples);
+    for (int n = 0; n < taps; n++)
+        {
+            for (int k = 0; k < samples; k++)
+                {
+                    codes[n][k] = (k % 3) ? 1.0F : -1.0F;
+                }
+        }
+    const lv_32fc_t phase_inc = lv_cmake(std::cos(0.1F), std::sin(0.1F));
+    lv_32fc_t phase = lv_cmake(1.0F, 0.0F);
+    for (auto _ : state)
+        {
+            volk_gnsssdr_32fc_32f_rotator_dot_prod_32fc_xn(result[0], in[0], phase_inc, &phase, codes.const_data(), taps, samples);
+            benchmark::DoNotOptimize(result[0]);
+        }
+    state.SetItemsProcessed(state.iterations() * samples);
+    state.SetLabel(volk_gnsssdr_get_machine());
+}
+BENCHMARK(BM_32fc_32f_rotator_dot_prod_32fc_xn)->Apply(tracking_args);
+
+
+static void BM_32fc_32f_high_dynamic_rotator_dot_prod_32fc_xn(benchmark::State& state)
+{
+    const int samples = state.range(0);
+    const int taps = state.range(1);
+    Aligned_Vectors<lv_32fc_t> in(1, samples);
+    Aligned_Vectors<float> codes(taps, samples);
+    Aligned_Vectors<lv_32fc_t> result(1, taps);
+    random_samples(in[0], samples);
+    for (int n = 0; n < taps; n++)
+        {
+            for (int k = 0; k < samples; k++)
+                {
+                    codes[n][k] = (k % 3) ? 1.0F : -1.0F;
+                }
+        }
+    const lv_32fc_t phase_inc = lv_cmake(std::cos(0.1F), std::sin(0.1F));
+    const lv_32fc_t phase_inc_rate = lv_cmake(std::cos(1e-6F), std::sin(1e-6F));
+    lv_32fc_t phase = lv_cmake(1.0F, 0.0F);
+    for (auto _ : state)
+        {
+            volk_gnsssdr_32fc_32f_high_dynamic_rotator_dot_prod_32fc_xn(result[0], in[0], phase_inc, phase_inc_rate, &phase, codes.const_data(), taps, samples);
+            benchmark::DoNotOptimize(result[0]);
+        }
+    state.SetItemsProcessed(state.iterations() * samples);
+    state.SetLabel(volk_gnsssdr_get_machine());
+}
+BENCHMARK(BM_32fc_32f_high_dynamic_rotator_dot_prod_32fc_xn)->Apply(tracking_args);
+
+
+static void BM_16ic_x2_rotator_dot_prod_16ic_xn(benchmark::State& state)
+{
+    const int samples = state.range(0);
+    const int taps = state.range(1);
+    Aligned_Vectors<lv_16sc_t> in(1, samples);
+    Aligned_Vectors<lv_16sc_t> codes(taps, samples);
+    Aligned_Vectors<lv_16sc_t> result(1, taps);
+    for (int k = 0; k < samples; k++)
+        {
+            in[0][k] = lv_cmake(static_cast<int16_t>(k % 7 - 3), static_cast<int16_t>(k % 5 - 2));
+            for (int n = 0; n < taps; n++)
+                {
+                    codes[n][k] = lv_cmake(static_cast<int16_t>((k % 3) ? 1 : -1), static_cast<int16_t>(0));
+                }
+        }
+    const lv_32fc_t phase_inc = lv_cmake(std::cos(0.1F), std::sin(0.1F));
+    lv_32fc_t phase = lv_cmake(1.0F, 0.0F);
+    for (auto _ : state)
+        {
+            volk_gnsssdr_16ic_x2_rotator_dot_prod_16ic_xn(result[0], in[0], phase_inc, &phase, codes.const_data(), taps, samples);
+            benchmark::DoNotOptimize(result[0]);
+        }
+    state.SetItemsProcessed(state.iterations() * samples);
+    state.SetLabel(volk_gnsssdr_get_machine());
+}
+BENCHMARK(BM_16ic_x2_rotator_dot_prod_16ic_xn)->Apply(tracking_args);
+
+
+//////////////////////////////////////////////////////////////////////////////
+// Tracking: local code resampling
+//////////////////////////////////////////////////////////////////////////////
+
+static void BM_32f_xn_resampler_32f_xn(benchmark::State& state)
+{
+    const int samples = state.range(0);
+    const int taps = state.range(1);
+    std::vector<float> code(static_cast<int>(GPS_L1_CA_CODE_LENGTH_CHIPS));
+    gps_l1_ca_code_gen_float(code.data(), 1, 0);
+    std::vector<float> shifts_chips = shifts(taps);
+    Aligned_Vectors<float> result(taps, samples);
+    const float code_phase_step_chips = static_cast<float>(GPS_L1_CA_CODE_LENGTH_CHIPS) / static_cast<float>(samples);
+    for (auto _ : state)
+        {
+            volk_gnsssdr_32f_xn_resampler_32f_xn(result.data(), code.data(), 0.3F, code_phase_step_chips, shifts_chips.data(), static_cast<unsigned int>(GPS_L1_CA_CODE_LENGTH_CHIPS), taps, samples);
+            benchmark::DoNotOptimize(result[0]);
+        }
+    state.SetItemsProcessed(state.iterations() * samples);
+    state.SetLabel(volk_gnsssdr_get_machine());
+}
+BENCHMARK(BM_32f_xn_resampler_32f_xn)->Apply(tracking_args);
+
+
+static void BM_32f_xn_high_dynamics_resampler_32f_xn(benchmark::State& state)
+{
+    const int samples = state.range(0);
+    const int taps = state.range(1);
+    std::vector<float> code(static_cast<int>(GPS_L1_CA_CODE_LENGTH_CHIPS));
+    gps_l1_ca_code_gen_float(code.data(), 1, 0);
+    std::vector<float> shifts_chips = shifts(taps);
+    Aligned_Vectors<float> result(taps, samples);
+    const float code_phase_step_chips = static_cast<float>(GPS_L1_CA_CODE_LENGTH_CHIPS) / static_cast<float>(samples);
+    for (auto _ : state)
+        {
+            volk_gnsssdr_32f_xn_high_dynamics_resampler_32f_xn(result.data(), code.data(), 0.3F, code_phase_step_chips, 1e-9F, shifts_chips.data(), static_cast<unsigned int>(GPS_L1_CA_CODE_LENGTH_CHIPS), taps, samples);
+            benchmark::DoNotOptimize(result[0]);
+        }
+    state.SetItemsProcessed(state.iterations() * samples);
+    state.SetLabel(volk_gnsssdr_get_machine());
+}
+BENCHMARK(BM_32f_xn_high_dynamics_resampler_32f_xn)->Apply(tracking_args);
+
+
+static void BM_32fc_xn_resampler_32fc_xn(benchmark::State& state)
+{
+    const int samples = state.range(0);
+    const int taps = state.range(1);
+    std::vector<std::complex<float>> code(static_cast<int>(GPS_L1_CA_CODE_LENGTH_CHIPS));
+    gps_l1_ca_code_gen_complex(code.data(), 1, 0);
+    std::vector<float> shifts_chips = shifts(taps);
+    Aligned_Vectors<lv_32fc_t> result(taps, samples);
+    const float code_phase_step_chips = static_cast<float>(GPS_L1_CA_CODE_LENGTH_CHIPS) / static_cast<float>(samples);
+    for (auto _ : state)
+        {
+            volk_gnsssdr_32fc_xn_resampler_32fc_xn(result.data(), code.data(), 0.3F, code_phase_step_chips, shifts_chips.data(), static_cast<unsigned int>(GPS_L1_CA_CODE_LENGTH_CHIPS), taps, samples);
+            benchmark::DoNotOptimize(result[0]);
+        }
+    state.SetItemsProcessed(state.iterations() * samples);
+    state.SetLabel(volk_gnsssdr_get_machine());
+}
+BENCHMARK(BM_32fc_xn_resampler_32fc_xn)->Apply(tracking_args);
+
+
+static void BM_16ic_xn_resampler_16ic_xn(benchmark::State& state)
+{
+    const int samples = state.range(0);
+    const int taps = state.range(1);
+    std::vector<float> code_float(static_cast<int>(GPS_L1_CA_CODE_LENGTH_CHIPS));
+    gps_l1_ca_code_gen_float(code_float.data(), 1, 0);
+    std::vector<lv_16sc_t> code(code_float.size());
+    for (size_t n = 0; n < code.size(); n++)
+        {
+            code[n] = lv_cmake(static_cast<int16_t>(code_float[n]), static_cast<int16_t>(0));
+        }
+    std::vector<float> shifts_chips = shifts(taps);
+    Aligned_Vectors<lv_16sc_t> result(taps, samples);
+    const float code_phase_step_chips = static_cast<float>(GPS_L1_CA_CODE_LENGTH_CHIPS) / static_cast<float>(samples);
+    for (auto _ : state)
+        {
+            volk_gnsssdr_16ic_xn_resampler_16ic_xn(result.data(), code.data(), 0.3F, code_phase_step_chips, shifts_chips.data(), static_cast<unsigned int>(GPS_L1_CA_CODE_LENGTH_CHIPS), taps, samples);
+            benchmark::DoNotOptimize(result[0]);
+        }
+    state.SetItemsProcessed(state.iterations() * samples);
+    state.SetLabel(volk_gnsssdr_get_machine());
+}
+BENCHMARK(BM_16ic_xn_resampler_16ic_xn)->Apply(tracking_args);
+
+
+//////////////////////////////////////////////////////////////////////////////
+// Acquisition
+//////////////////////////////////////////////////////////////////////////////
+
+static void BM_32fc_magnitude_squared_acc_index_max_32f(benchmark::State& state)
+{
+    const int points = state.range(0);
+    Aligned_Vectors<lv_32fc_t> in(1, points);
+    Aligned_Vectors<float> accumulator(1, points);
+    random_samples(in[0], points);
+    uint32_t index = 0;
+    for (auto _ : state)
+        {
+            volk_gnsssdr_32fc_magnitude_squared_acc_index_max_32f(accumulator[0], &index, in[0], 1, points);
+            benchmark::DoNotOptimize(index);
+        }
+    state.SetItemsProcessed(state.iterations() * points);
+    state.SetLabel(volk_gnsssdr_get_machine());
+}
+BENCHMARK(BM_32fc_magnitude_squared_acc_index_max_32f)->Apply(acquisition_args);
+
+
+static void BM_32f_index_max_32u(benchmark::State& state)
+{
+    const int points = state.range(0);
+    Aligned_Vectors<float> in(1, points);
+    std::default_random_engine generator(1);
+    std::uniform_real_distribution<float> uniform(0.0, 1.0);
+    for (int n = 0; n < points; n++)
+        {
+            in[0][n] = uniform(generator);
+        }
+    uint32_t index = 0;
+    for (auto _ : state)
+        {
+            volk_gnsssdr_32f_index_max_32u(&index, in[0], points);
+            benchmark::DoNotOptimize(index);
+        }
+    state.SetItemsProcessed(state.iterations() * points);
+    state.SetLabel(volk_gnsssdr_get_machine());
+}
+BENCHMARK(BM_32f_index_max_32u)->Apply(acquisition_args);
+
+
+//////////////////////////////////////////////////////////////////////////////
+// Signal sources: conversions and unpackers
+//////////////////////////////////////////////////////////////////////////////
+
+static void BM_16ic_convert_32fc(benchmark::State& state)
+{
+    const int items = state.range(0);
+    Aligned_Vectors<lv_16sc_t> in(1, items);
+    Aligned_Vectors<lv_32fc_t> out(1, items);
+    for (int n = 0; n < items; n++)
+        {
+            in[0][n] = lv_cmake(static_cast<int16_t>(n % 255 - 127), static_cast<int16_t>(n % 127 - 63));
+        }
+    for (auto _ : state)
+        {
+            volk_gnsssdr_16ic_convert_32fc(out[0], in[0], items);
+            benchmark::DoNotOptimize(out[0]);
+        }
+    state.SetItemsProcessed(state.iterations() * items);
+    state.SetLabel(volk_gnsssdr_get_machine());
+}
+BENCHMARK(BM_16ic_convert_32fc)->Apply(buffer_args);
+
+
+static void BM_32fc_convert_16ic(benchmark::State& state)
+{
+    const int items = state.range(0);
+    Aligned_Vectors<lv_32fc_t> in(1, items);
+    Aligned_Vectors<lv_16sc_t> out(1, items);
+    random_samples(in[0], items);
+    for (auto _ : state)
+        {
+            volk_gnsssdr_32fc_convert_16ic(out[0], in[0], items);
+            benchmark::DoNotOptimize(out[0]);
+        }
+    state.SetItemsProcessed(state.iterations() * items);
+    state.SetLabel(volk_gnsssdr_get_machine());
+}
+BENCHMARK(BM_32fc_convert_16ic)->Apply(buffer_args);
+
+
+static void BM_8ic_convert_16ic(benchmark::State& state)
+{
+    const int items = state.range(0);
+    Aligned_Vectors<lv_8sc_t> in(1, items);
+    Aligned_Vectors<lv_16sc_t> out(1, items);
+    for (int n = 0; n < items; n++)
+        {
+            in[0][n] = lv_cmake(static_cast<int8_t>(n % 15 - 7), static_cast<int8_t>(n % 13 - 6));
+        }
+    for (auto _ : state)
+        {
+            volk_gnsssdr_8ic_convert_16ic(out[0], in[0], items);
+            benchmark::DoNotOptimize(out[0]);
+        }
+    state.SetItemsProcessed(state.iterations() * items);
+    state.SetLabel(volk_gnsssdr_get_machine());
+}
+BENCHMARK(BM_8ic_convert_16ic)->Apply(buffer_args);
+
+
+// 2-bit samples, four per byte, with the sign-magnitude values of the MAX2769 front-end
+const int8_t TWO_BIT_LUT[4] = {1, 3, -1, -3};
+const uint8_t TWO_BIT_ORDER[4] = {3, 2, 1, 0};
+
+
+static void BM_8u_unpack_2bit_32f(benchmark::State& state)
+{
+    const int items = state.range(0);
+    Aligned_Vectors<uint8_t> in(1, items / 4);
+    Aligned_Vectors<float> out(1, items);
+    for (int n = 0; n < items / 4; n++)
+        {
+            in[0][n] = static_cast<uint8_t>(n * 37);
+        }
+    for (auto _ : state)
+        {
+            volk_gnsssdr_8u_unpack_2bit_32f(out[0], in[0], TWO_BIT_LUT, TWO_BIT_ORDER, items / 4);
+            benchmark::DoNotOptimize(out[0]);
+        }
+    state.SetItemsProcessed(state.iterations() * items);
+    state.SetLabel(volk_gnsssdr_get_machine());
+}
+BENCHMARK(BM_8u_unpack_2bit_32f)->Apply(buffer_args);
+
+
+static void BM_8u_unpack_2bit_16i(benchmark::State& state)
+{
+    const int items = state.range(0);
+    Aligned_Vectors<uint8_t> in(1, items / 4);
+    Aligned_Vectors<int16_t> out(1, items);
+    for (int n = 0; n < items / 4; n++)
+        {
+            in[0][n] = static_cast<uint8_t>(n * 37);
+        }
+    for (auto _ : state)
+        {
+            volk_gnsssdr_8u_unpack_2bit_16i(out[0], in[0], TWO_BIT_LUT, TWO_BIT_ORDER, items / 4);
+            benchmark::DoNotOptimize(out[0]);
+        }
+    state.SetItemsProcessed(state.iterations() * items);
+    state.SetLabel(volk_gnsssdr_get_machine());
+}
+BENCHMARK(BM_8u_unpack_2bit_16i)->Apply(buffer_args);
+
+
+static void BM_32u_s32f_unpack_1bit_32fc(benchmark::State& state)
+{
+    const int items = state.range(0);
+    Aligned_Vectors<uint32_t> in(1, items);
+    Aligned_Vectors<lv_32fc_t> out(1, items);
+    for (int n = 0; n < items; n++)
+        {
+            in[0][n] = static_cast<uint32_t>(n * 7);
+        }
+    for (auto _ : state)
+        {
+            volk_gnsssdr_32u_s32f_unpack_1bit_32fc(out[0], in[0], 1.0F, items);
+            benchmark::DoNotOptimize(out[0]);
+        }
+    state.SetItemsProcessed(state.iterations() * items);
+    state.SetLabel(volk_gnsssdr_get_machine());
+}
+BENCHMARK(BM_32u_s32f_unpack_1bit_32fc)->Apply(buffer_args);
+
+
+BENCHMARK_MAIN();
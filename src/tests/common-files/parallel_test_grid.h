@@ -0,0 +1,93 @@
+/*!
+ * \file parallel_test_grid.h
+ * \brief Runs the points of a parameter sweep of a test in parallel threads,
+ * each one with its own flow graph, and merges their results in order.
+ *
+ * -------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2019  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *          Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_PARALLEL_TEST_GRID_H_
+#define GNSS_SDR_PARALLEL_TEST_GRID_H_
+
+#include <gflags/gflags.h>
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <thread>
+#include <vector>
+
+DEFINE_int32(test_threads, 1, "Points of a parameter sweep processed in parallel, each one with its own flow graph (0: one per core)");
+
+
+/*!
+ * \brief Number of workers for a sweep of \p points points, from --test_threads.
+ */
+inline unsigned int test_grid_workers(size_t points)
+{
+    unsigned int workers = FLAGS_test_threads > 0 ? static_cast<unsigned int>(FLAGS_test_threads) : std::thread::hardware_concurrency();
+    return static_cast<unsigned int>(std::max<size_t>(1, std::min<size_t>(std::max(workers, 1U), points)));
+}
+
+
+/*!
+ * \brief Calls run_point(point, worker) for every point in [0, points), in
+ * \p workers threads that take the next pending point when they finish one,
+ * and returns the results indexed by point. Each worker has an index in
+ * [0, workers), so that it can use its own channel, dump files, etc. With a
+ * single worker, the points run in order in the calling thread.
+ */
+template <typename Result>
+std::vector<Result> run_test_grid(size_t points, unsigned int workers, const std::function<Result(size_t, unsigned int)>& run_point)
+{
+    std::vector<Result> results(points);
+    if (workers <= 1)
+        {
+            for (size_t point = 0; point < points; point++)
+                {
+                    results[point] = run_point(point, 0);
+                }
+            return results;
+        }
+    std::atomic<size_t> next_point(0);
+    std::vector<std::thread> threads;
+    for (unsigned int worker = 0; worker < workers; worker++)
+        {
+            threads.emplace_back([&, worker]() {
+                for (size_t point = next_point++; point < points; point = next_point++)
+                    {
+                        results[point] = run_point(point, worker);
+                    }
+            });
+        }
+    for (auto& thread : threads)
+        {
+            thread.join();
+        }
+    return results;
+}
+
+#endif
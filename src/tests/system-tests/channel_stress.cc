@@ -0,0 +1,453 @@
+/*!
+ * \file channel_stress.cc
+ * \brief Runs the receiver with hundreds of channels on a synthetic signal
+ * with tens of satellites, and checks that the throughput does not degrade,
+ * that every channel keeps making progress and that memory does not grow.
+ *
+ * -------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2019  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *          Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------
+ */
+
+#include "Galileo_E1.h"
+#include "concurrent_map.h"
+#include "concurrent_queue.h"
+#include "control_message_factory.h"
+#include "control_thread.h"
+#include "gnss_flowgraph.h"
+#include "gnss_memory_accounting.h"
+#include "gps_acq_assist.h"
+#include "in_memory_configuration.h"
+#include "signal_generator_c.h"
+#include <boost/tokenizer.hpp>
+#include <gflags/gflags.h>
+#include <glog/logging.h>
+#include <gnuradio/blocks/file_sink.h>
+#include <gnuradio/blocks/head.h>
+#include <gnuradio/blocks/vector_to_stream.h>
+#include <gnuradio/msg_queue.h>
+#include <gnuradio/top_block.h>
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+
+DEFINE_int32(stress_gps_satellites, 32, "Number of GPS L1 C/A satellites in the synthetic signal");
+DEFINE_int32(stress_galileo_satellites, 24, "Number of Galileo E1 satellites in the synthetic signal");
+DEFINE_string(stress_channels, std::string("1C:104,1B:104"), "Comma-separated list of band:channels");
+DEFINE_int32(stress_in_acquisition, 0, "Channels searching at the same time (0: all of them)");
+DEFINE_int32(stress_fs, 4000000, "Sampling rate of the synthetic signal, in Samples/s");
+DEFINE_int32(stress_signal_s, 1, "Seconds of synthetic signal, read over and over again by the receiver");
+DEFINE_double(stress_duration, 300.0, "Wall-clock duration of the run, in seconds");
+DEFINE_double(stress_sample_period, 10.0, "Time between samples of the receiver progress, in seconds");
+DEFINE_double(stress_max_throughput_drop, 0.25, "Maximum drop of the sample rate in the second half of the run, relative to the first half");
+DEFINE_double(stress_max_rss_growth_mb, 64.0, "Maximum growth of the resident memory in the second half of the run, in MB");
+DEFINE_string(stress_output, std::string("channel_stress.json"), "JSON summary output file");
+
+// For GPS NAVIGATION (L1)
+concurrent_queue<Gps_Acq_Assist> global_gps_acq_assist_queue;
+concurrent_map<Gps_Acq_Assist> global_gps_acq_assist_map;
+
+
+struct Stress_Sample
+{
+    double time_s;
+    double source_samples;
+    double rss_mb;
+    std::map<std::string, double> block_items;  // samples read by each acquisition and tracking block, by OpenMetrics labels
+    double locks;
+};
+
+
+class ChannelStressTest : public ::testing::Test
+{
+public:
+    bool generate_signal(const std::string& filename);
+    std::shared_ptr<ConfigurationInterface> configure_receiver(const std::string& filename, const std::map<std::string, int>& channels);
+    void monitor(const std::shared_ptr<GNSSFlowgraph>& flowgraph, const gr::msg_queue::sptr& control_queue);
+    void print_report();
+
+    std::vector<Stress_Sample> samples;
+    std::atomic<bool> receiver_done{false};
+
+    const double central_freq = 1575420000.0;
+    const float cn0_db_hz = 45.0;
+    const float doppler_max = 5000.0;
+    const float doppler_step = 250.0;
+    const float threshold = 0.01;
+};
+
+
+// Parses "1C:104,1B:104" into the number of channels of each band
+std::map<std::string, int> parse_stress_channels(const std::string& list)
+{
+    std::map<std::string, int> channels;
+    boost::char_separator<char> sep(",");
+    boost::tokenizer<boost::char_separator<char> > tokens(list, sep);
+    for (const auto& band : tokens)
+        {
+            size_t colon = band.find(':');
+            if (colon != std::string::npos)
+                {
+                    channels[band.substr(0, colon)] = std::stoi(band.substr(colon + 1));
+                }
+        }
+    return channels;
+}
+
+
+// Values of the metrics of GNSSFlowgraph::get_metrics(), by name and labels
+std::map<std::string, double> parse_metrics(const std::string& metrics)
+{
+    std::map<std::string, double> values;
+    std::istringstream lines(metrics);
+    std::string line;
+    while (std::getline(lines, line))
+        {
+            size_t space = line.rfind(' ');
+            if (line.empty() or (line[0] == '#') or (space == std::string::npos))
+                {
+                    continue;
+                }
+            values[line.substr(0, space)] = std::atof(line.substr(space + 1).c_str());
+        }
+    return values;
+}
+
+
+bool ChannelStressTest::generate_signal(const std::string& filename)
+{
+    std::vector<std::string> signal;
+    std::vector<std::string> system;
+    std::vector<unsigned int> prn;
+    std::vector<float> cn0_db;
+    std::vector<float> doppler_hz;
+    std::vector<unsigned int> delay_chips;
+    std::vector<unsigned int> delay_sec;
+    const int num_satellites = FLAGS_stress_gps_satellites + FLAGS_stress_galileo_satellites;
+    for (int sat = 0; sat < num_satellites; sat++)
+        {
+            bool gps = sat < FLAGS_stress_gps_satellites;
+            signal.emplace_back(gps ? "1C" : "1B");
+            system.emplace_back(gps ? "G" : "E");
+            prn.push_back(gps ? sat + 1 : sat - FLAGS_stress_gps_satellites + 1);
+            cn0_db.push_back(cn0_db_hz);
+            // Integer Doppler shifts, so that the carrier phase is continuous when the file is read again
+            doppler_hz.push_back(std::round(-4000.0 + 8000.0 * static_cast<double>(sat) / static_cast<double>(num_satellites)));
+            delay_chips.push_back((sat * 97) % 1023);
+            delay_sec.push_back(0);
+        }
+
+    // 100 ms vectors, a whole number of Galileo E1 secondary code periods
+    auto vector_length = static_cast<unsigned int>(std::round(static_cast<double>(FLAGS_stress_fs) / (Galileo_E1_CODE_CHIP_RATE_HZ / Galileo_E1_B_CODE_LENGTH_CHIPS)) * Galileo_E1_C_SECONDARY_CODE_LENGTH);
+    gr::top_block_sptr top_block = gr::make_top_block("Channel stress signal generator");
+    signal_generator_c_sptr generator = signal_make_generator_c(signal, system, prn, cn0_db, doppler_hz, delay_chips, delay_sec,
+        false, true, FLAGS_stress_fs, vector_length, 1.0);
+    gr::blocks::vector_to_stream::sptr vector_to_stream = gr::blocks::vector_to_stream::make(sizeof(gr_complex), vector_length);
+    gr::blocks::head::sptr head = gr::blocks::head::make(sizeof(gr_complex), static_cast<uint64_t>(FLAGS_stress_signal_s) * FLAGS_stress_fs);
+    gr::blocks::file_sink::sptr sink = gr::blocks::file_sink::make(sizeof(gr_complex), filename.c_str());
+    top_block->connect(generator, 0, vector_to_stream, 0);
+    top_block->connect(vector_to_stream, 0, head, 0);
+    top_block->connect(head, 0, sink, 0);
+    top_block->run();
+    sink->close();
+    std::ifstream file(filename, std::ios::binary | std::ios::ate);
+    return file.is_open() and (file.tellg() == static_cast<std::streamoff>(static_cast<uint64_t>(FLAGS_stress_signal_s) * FLAGS_stress_fs * sizeof(gr_complex)));
+}
+
+
+std::shared_ptr<ConfigurationInterface> ChannelStressTest::configure_receiver(const std::string& filename, const std::map<std::string, int>& channels)
+{
+    std::shared_ptr<InMemoryConfiguration> config = std::make_shared<InMemoryConfiguration>();
+    config->set_property("GNSS-SDR.internal_fs_sps", std::to_string(FLAGS_stress_fs));
+
+    // Set the Signal Source. The run is stopped before the valve closes
+    config->set_property("SignalSource.implementation", "File_Signal_Source");
+    config->set_property("SignalSource.filename", filename);
+    config->set_property("SignalSource.item_type", "gr_complex");
+    config->set_property("SignalSource.sampling_frequency", std::to_string(FLAGS_stress_fs));
+    config->set_property("SignalSource.freq", std::to_string(central_freq));
+    config->set_property("SignalSource.samples", std::to_string(static_cast<uint64_t>(FLAGS_stress_duration * 100.0 * FLAGS_stress_fs)));
+    config->set_property("SignalSource.repeat", "true");
+    config->set_property("SignalSource.dump", "false");
+
+    // Set the Signal Conditioner
+    config->set_property("SignalConditioner.implementation", "Signal_Conditioner");
+    for (const auto& role : std::vector<std::string>{"DataTypeAdapter", "InputFilter", "Resampler"})
+        {
+            config->set_property(role + ".implementation", "Pass_Through");
+            config->set_property(role + ".item_type", "gr_complex");
+        }
+
+    // Set the Channels
+    int total_channels = 0;
+    for (const auto& band : channels)
+        {
+            config->set_property("Channels_" + band.first + ".count", std::to_string(band.second));
+            total_channels += band.second;
+        }
+    int in_acquisition = (FLAGS_stress_in_acquisition > 0) ? FLAGS_stress_in_acquisition : total_channels;
+    config->set_property("Channels.in_acquisition", std::to_string(in_acquisition));
+
+    // GPS L1 C/A
+    config->set_property("Acquisition_1C.implementation", "GPS_L1_CA_PCPS_Acquisition");
+    config->set_property("Acquisition_1C.item_type", "gr_complex");
+    config->set_property("Acquisition_1C.coherent_integration_time_ms", "1");
+    config->set_property("Acquisition_1C.threshold", std::to_string(threshold));
+    config->set_property("Acquisition_1C.doppler_max", std::to_string(doppler_max));
+    config->set_property("Acquisition_1C.doppler_step", std::to_string(doppler_step));
+    config->set_property("Acquisition_1C.dump", "false");
+    config->set_property("Tracking_1C.implementation", "GPS_L1_CA_DLL_PLL_Tracking");
+    config->set_property("Tracking_1C.item_type", "gr_complex");
+    config->set_property("Tracking_1C.pll_bw_hz", "30.0");
+    config->set_property("Tracking_1C.dll_bw_hz", "4.0");
+    config->set_property("Tracking_1C.dump", "false");
+    config->set_property("TelemetryDecoder_1C.implementation", "GPS_L1_CA_Telemetry_Decoder");
+    config->set_property("TelemetryDecoder_1C.dump", "false");
+
+    // Galileo E1
+    config->set_property("Acquisition_1B.implementation", "Galileo_E1_PCPS_Ambiguous_Acquisition");
+    config->set_property("Acquisition_1B.item_type", "gr_complex");
+    config->set_property("Acquisition_1B.coherent_integration_time_ms", "4");
+    config->set_property("Acquisition_1B.threshold", std::to_string(threshold));
+    config->set_property("Acquisition_1B.doppler_max", std::to_string(doppler_max));
+    config->set_property("Acquisition_1B.doppler_step", std::to_string(doppler_step));
+    config->set_property("Acquisition_1B.dump", "false");
+    config->set_property("Tracking_1B.implementation", "Galileo_E1_DLL_PLL_VEML_Tracking");
+    config->set_property("Tracking_1B.item_type", "gr_complex");
+    config->set_property("Tracking_1B.pll_bw_hz", "15.0");
+    config->set_property("Tracking_1B.dll_bw_hz", "2.0");
+    config->set_property("Tracking_1B.dump", "false");
+    config->set_property("TelemetryDecoder_1B.implementation", "Galileo_E1B_Telemetry_Decoder");
+    config->set_property("TelemetryDecoder_1B.dump", "false");
+
+    // Set Observables
+    config->set_property("Observables.implementation", "Hybrid_Observables");
+    config->set_property("Observables.dump", "false");
+
+    // Set PVT
+    config->set_property("PVT.implementation", "RTKLIB_PVT");
+    config->set_property("PVT.positioning_mode", "Single");
+    config->set_property("PVT.output_rate_ms", "100");
+    config->set_property("PVT.display_rate_ms", "500");
+    config->set_property("PVT.flag_nmea_tty_port", "false");
+    config->set_property("PVT.flag_rtcm_server", "false");
+    config->set_property("PVT.flag_rtcm_tty_port", "false");
+    config->set_property("PVT.dump", "false");
+    return config;
+}
+
+
+void ChannelStressTest::monitor(const std::shared_ptr<GNSSFlowgraph>& flowgraph, const gr::msg_queue::sptr& control_queue)
+{
+    std::chrono::time_point<std::chrono::steady_clock> start = std::chrono::steady_clock::now();
+    while (!flowgraph->running() and !receiver_done)
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        }
+    std::chrono::time_point<std::chrono::steady_clock> next_sample = std::chrono::steady_clock::now();
+    while (!receiver_done)
+        {
+            std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+            if (elapsed.count() >= FLAGS_stress_duration)
+                {
+                    break;
+                }
+            if (std::chrono::steady_clock::now() >= next_sample)
+                {
+                    std::map<std::string, double> metrics = parse_metrics(flowgraph->get_metrics());
+                    Stress_Sample sample{};
+                    sample.time_s = elapsed.count();
+                    sample.rss_mb = static_cast<double>(Gnss_Memory_Accounting::resident_set_bytes()) / 1048576.0;
+                    for (const auto& metric : metrics)
+                        {
+                            const std::string& name = metric.first;
+                            if (name.find("gnss_sdr_block_items_written_total{block=\"signal_source\"") == 0)
+                                {
+                                    sample.source_samples += metric.second;
+                                }
+                            else if ((name.find("gnss_sdr_block_items_read_total{block=\"acquisition\"") == 0) or (name.find("gnss_sdr_block_items_read_total{block=\"tracking\"") == 0))
+                                {
+                                    sample.block_items[name.substr(name.find('{'))] = metric.second;
+                                }
+                            else if (name.find("gnss_sdr_tracking_locks_total") == 0)
+                                {
+                                    sample.locks += metric.second;
+                                }
+                        }
+                    samples.push_back(sample);
+                    std::cout << "t = " << sample.time_s << " s: " << sample.source_samples / static_cast<double>(FLAGS_stress_fs) << " s of signal processed, "
+                              << sample.locks << " locks, " << sample.rss_mb << " MB resident" << std::endl;
+                    next_sample += std::chrono::milliseconds(static_cast<int64_t>(FLAGS_stress_sample_period * 1000.0));
+                }
+            std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        }
+
+    std::unique_ptr<ControlMessageFactory> control_msg_factory(new ControlMessageFactory());
+    control_queue->handle(control_msg_factory->GetQueueMessage(200, 0));
+}
+
+
+void ChannelStressTest::print_report()
+{
+    std::stringstream json;
+    json << "{" << std::endl;
+    json << "  \"host\": \"" << std::string(HOST_SYSTEM) << "\"," << std::endl;
+    json << "  \"channels\": \"" << FLAGS_stress_channels << "\"," << std::endl;
+    json << "  \"satellites\": " << FLAGS_stress_gps_satellites + FLAGS_stress_galileo_satellites << "," << std::endl;
+    json << "  \"samples\": [" << std::endl;
+    for (size_t s = 0; s < samples.size(); s++)
+        {
+            json << "    {\"time_s\": " << samples[s].time_s
+                 << ", \"signal_s\": " << samples[s].source_samples / static_cast<double>(FLAGS_stress_fs)
+                 << ", \"locks\": " << samples[s].locks
+                 << ", \"rss_MB\": " << samples[s].rss_mb << "}" << (s + 1 < samples.size() ? "," : "") << std::endl;
+        }
+    json << "  ]" << std::endl;
+    json << "}" << std::endl;
+    std::ofstream output(FLAGS_stress_output);
+    if (output.is_open())
+        {
+            output << json.str();
+            std::cout << "Summary written to " << FLAGS_stress_output << std::endl;
+        }
+}
+
+
+TEST_F(ChannelStressTest /*unused*/, ManyChannels /*unused*/)
+{
+    const std::string filename = "./channel_stress_signal.dat";
+    std::cout << "Generating " << FLAGS_stress_signal_s << " s of signal with " << FLAGS_stress_gps_satellites << " GPS and "
+              << FLAGS_stress_galileo_satellites << " Galileo satellites..." << std::endl;
+    ASSERT_TRUE(generate_signal(filename)) << "Unable to generate " << filename;
+
+    std::map<std::string, int> channels = parse_stress_channels(FLAGS_stress_channels);
+    std::shared_ptr<ControlThread> control_thread = std::make_shared<ControlThread>(configure_receiver(filename, channels));
+    gr::msg_queue::sptr control_queue = gr::msg_queue::make(0);
+    control_thread->set_control_queue(control_queue);
+    std::thread monitor_thread(&ChannelStressTest::monitor, this, control_thread->flowgraph(), control_queue);
+    try
+        {
+            control_thread->run();
+        }
+    catch (const boost::exception& e)
+        {
+            std::cout << "Boost exception: " << boost::diagnostic_information(e);
+        }
+    catch (const std::exception& ex)
+        {
+            std::cout << "STD exception: " << ex.what();
+        }
+    receiver_done = true;
+    monitor_thread.join();
+    std::remove(filename.c_str());
+    print_report();
+
+    // The first sample is taken while the channels start, the rest are compared
+    ASSERT_GE(samples.size(), 5U) << "The run is too short, see --stress_duration and --stress_sample_period";
+    std::vector<double> rates;
+    for (size_t s = 2; s < samples.size(); s++)
+        {
+            double interval_s = samples[s].time_s - samples[s - 1].time_s;
+            rates.push_back((samples[s].source_samples - samples[s - 1].source_samples) / interval_s);
+        }
+
+    // Throughput: the slowest interval of the second half against the mean of the first half
+    size_t half = rates.size() / 2;
+    double first_half_rate = 0.0;
+    for (size_t r = 0; r < half; r++)
+        {
+            first_half_rate += rates[r] / static_cast<double>(half);
+        }
+    double slowest_rate = *std::min_element(rates.begin() + half, rates.end());
+    std::cout << "Sample rate: " << first_half_rate << " Sps in the first half, " << slowest_rate << " Sps at worst in the second half" << std::endl;
+    EXPECT_GT(first_half_rate, 0.0);
+    EXPECT_GE(slowest_rate, (1.0 - FLAGS_stress_max_throughput_drop) * first_half_rate);
+
+    // Progress: every acquisition and tracking block reads samples in every interval
+    int stalled = 0;
+    for (size_t s = 2; s < samples.size(); s++)
+        {
+            for (const auto& block : samples[s].block_items)
+                {
+                    auto previous = samples[s - 1].block_items.find(block.first);
+                    if ((previous != samples[s - 1].block_items.end()) and (block.second <= previous->second))
+                        {
+                            std::cout << block.first << " stalled between t = " << samples[s - 1].time_s << " s and t = " << samples[s].time_s << " s" << std::endl;
+                            stalled++;
+                        }
+                }
+        }
+    int total_channels = 0;
+    for (const auto& band : channels)
+        {
+            total_channels += band.second;
+        }
+    EXPECT_EQ(samples.back().block_items.size(), static_cast<size_t>(2 * total_channels));
+    EXPECT_EQ(stalled, 0);
+    EXPECT_GT(samples.back().locks, 0.0);
+
+    // Memory: no growth once all the channels have been through acquisition and tracking
+    double rss_growth_mb = samples.back().rss_mb - samples[samples.size() / 2].rss_mb;
+    std::cout << "Resident memory growth in the second half of the run: " << rss_growth_mb << " MB" << std::endl;
+    EXPECT_LE(rss_growth_mb, FLAGS_stress_max_rss_growth_mb);
+}
+
+
+int main(int argc, char** argv)
+{
+    std::cout << "Running Channel Stress test..." << std::endl;
+    int res = 0;
+    try
+        {
+            testing::InitGoogleTest(&argc, argv);
+        }
+    catch (...)
+        {
+        }  // catch the "testing::internal::<unnamed>::ClassUniqueToAlwaysTrue" from gtest
+
+    google::ParseCommandLineFlags(&argc, &argv, true);
+    google::InitGoogleLogging(argv[0]);
+
+    // Run the Tests
+    try
+        {
+            res = RUN_ALL_TESTS();
+        }
+    catch (...)
+        {
+            LOG(WARNING) << "Unexpected catch";
+        }
+    google::ShutDownCommandLineFlags();
+    return res;
+}
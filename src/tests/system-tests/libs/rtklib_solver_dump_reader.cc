@@ -29,56 +29,52 @@
  */
 
 #include "rtklib_solver_dump_reader.h"
+#include <cstring>
 #include <iostream>
 #include <utility>
 
 bool rtklib_solver_dump_reader::read_binary_obs()
 {
-    try
+    if (!read_epoch(d_next_epoch))
         {
-            d_dump_file.read(reinterpret_cast<char *>(&TOW_at_current_symbol_ms), sizeof(uint32_t));
-            d_dump_file.read(reinterpret_cast<char *>(&week), sizeof(uint32_t));
-            d_dump_file.read(reinterpret_cast<char *>(&RX_time), sizeof(double));
-            d_dump_file.read(reinterpret_cast<char *>(&clk_offset_s), sizeof(double));
-            d_dump_file.read(reinterpret_cast<char *>(&rr[0]), sizeof(double));
-            d_dump_file.read(reinterpret_cast<char *>(&rr[1]), sizeof(double));
-            d_dump_file.read(reinterpret_cast<char *>(&rr[2]), sizeof(double));
-            d_dump_file.read(reinterpret_cast<char *>(&rr[3]), sizeof(double));
-            d_dump_file.read(reinterpret_cast<char *>(&rr[4]), sizeof(double));
-            d_dump_file.read(reinterpret_cast<char *>(&rr[5]), sizeof(double));
-            d_dump_file.read(reinterpret_cast<char *>(&qr[0]), sizeof(double));
-            d_dump_file.read(reinterpret_cast<char *>(&qr[1]), sizeof(double));
-            d_dump_file.read(reinterpret_cast<char *>(&qr[2]), sizeof(double));
-            d_dump_file.read(reinterpret_cast<char *>(&qr[3]), sizeof(double));
-            d_dump_file.read(reinterpret_cast<char *>(&qr[4]), sizeof(double));
-            d_dump_file.read(reinterpret_cast<char *>(&qr[5]), sizeof(double));
-            d_dump_file.read(reinterpret_cast<char *>(&latitude), sizeof(double));
-            d_dump_file.read(reinterpret_cast<char *>(&longitude), sizeof(double));
-            d_dump_file.read(reinterpret_cast<char *>(&height), sizeof(double));
-            d_dump_file.read(reinterpret_cast<char *>(&ns), sizeof(uint8_t));
-            d_dump_file.read(reinterpret_cast<char *>(&status), sizeof(uint8_t));
-            d_dump_file.read(reinterpret_cast<char *>(&type), sizeof(uint8_t));
-            d_dump_file.read(reinterpret_cast<char *>(&AR_ratio), sizeof(float));
-            d_dump_file.read(reinterpret_cast<char *>(&AR_thres), sizeof(float));
-            d_dump_file.read(reinterpret_cast<char *>(&dop[0]), sizeof(double));
-            d_dump_file.read(reinterpret_cast<char *>(&dop[1]), sizeof(double));
-            d_dump_file.read(reinterpret_cast<char *>(&dop[2]), sizeof(double));
-            d_dump_file.read(reinterpret_cast<char *>(&dop[3]), sizeof(double));
+            return false;
         }
-    catch (const std::ifstream::failure &e)
+    d_next_epoch++;
+    return true;
+}
+
+
+bool rtklib_solver_dump_reader::read_epoch(int64_t epoch)
+{
+    if (epoch < 0 or epoch >= num_epochs())
         {
             return false;
         }
+    const char *record = d_dump_map.data() + epoch * EPOCH_SIZE_BYTES;
+    std::memcpy(&TOW_at_current_symbol_ms, record + TOW_AT_CURRENT_SYMBOL_MS, sizeof(uint32_t));
+    std::memcpy(&week, record + WEEK, sizeof(uint32_t));
+    std::memcpy(&RX_time, record + RX_TIME, sizeof(double));
+    std::memcpy(&clk_offset_s, record + CLK_OFFSET_S, sizeof(double));
+    std::memcpy(rr, record + RR, sizeof(rr));
+    std::memcpy(qr, record + QR, sizeof(qr));
+    std::memcpy(&latitude, record + LATITUDE, sizeof(double));
+    std::memcpy(&longitude, record + LONGITUDE, sizeof(double));
+    std::memcpy(&height, record + HEIGHT, sizeof(double));
+    std::memcpy(&ns, record + NS, sizeof(uint8_t));
+    std::memcpy(&status, record + STATUS, sizeof(uint8_t));
+    std::memcpy(&type, record + TYPE, sizeof(uint8_t));
+    std::memcpy(&AR_ratio, record + AR_RATIO, sizeof(float));
+    std::memcpy(&AR_thres, record + AR_THRES, sizeof(float));
+    std::memcpy(dop, record + DOP, sizeof(dop));
     return true;
 }
 
 
 bool rtklib_solver_dump_reader::restart()
 {
-    if (d_dump_file.is_open())
+    if (d_dump_map.is_open())
         {
-            d_dump_file.clear();
-            d_dump_file.seekg(0, std::ios::beg);
+            d_next_epoch = 0;
             return true;
         }
     return false;
@@ -87,47 +83,25 @@ bool rtklib_solver_dump_reader::restart()
 
 int64_t rtklib_solver_dump_reader::num_epochs()
 {
-    std::ifstream::pos_type size;
-    int epoch_size_bytes = 2 * sizeof(uint32_t) + 21 * sizeof(double) + 3 * sizeof(uint8_t) + 2 * sizeof(float);
-    std::ifstream tmpfile(d_dump_filename.c_str(), std::ios::binary | std::ios::ate);
-    if (tmpfile.is_open())
-        {
-            size = tmpfile.tellg();
-            int64_t nepoch = size / epoch_size_bytes;
-            return nepoch;
-        }
-    return 0;
+    return static_cast<int64_t>(d_dump_map.records(EPOCH_SIZE_BYTES));
 }
 
 
 bool rtklib_solver_dump_reader::open_obs_file(std::string out_file)
 {
-    if (d_dump_file.is_open() == false)
+    if (d_dump_map.is_open() == false)
         {
-            try
-                {
-                    d_dump_filename = std::move(out_file);
-                    d_dump_file.exceptions(std::ifstream::failbit | std::ifstream::badbit);
-                    d_dump_file.open(d_dump_filename.c_str(), std::ios::in | std::ios::binary);
-                    return true;
-                }
-            catch (const std::ifstream::failure &e)
+            d_dump_filename = std::move(out_file);
+            if (!d_dump_map.open(d_dump_filename))
                 {
                     std::cout << "Problem opening rtklib_solver dump Log file: " << d_dump_filename.c_str() << std::endl;
                     return false;
                 }
+            d_next_epoch = 0;
+            return true;
         }
     else
         {
             return false;
         }
 }
-
-
-rtklib_solver_dump_reader::~rtklib_solver_dump_reader()
-{
-    if (d_dump_file.is_open() == true)
-        {
-            d_dump_file.close();
-        }
-}
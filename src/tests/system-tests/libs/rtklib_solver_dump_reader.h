@@ -31,20 +31,49 @@
 #ifndef GNSS_SDR_RTKLIB_SOLVER_DUMP_READER_H
 #define GNSS_SDR_RTKLIB_SOLVER_DUMP_READER_H
 
+#include "dump_file_map.h"
+#include <cstddef>
 #include <cstdint>
-#include <fstream>
 #include <string>
 #include <vector>
 
 class rtklib_solver_dump_reader
 {
 public:
-    ~rtklib_solver_dump_reader();
+    //! Byte offsets of the fields in each record
+    enum Field_Offset : size_t
+    {
+        TOW_AT_CURRENT_SYMBOL_MS = 0,
+        WEEK = 4,
+        RX_TIME = 8,
+        CLK_OFFSET_S = 16,
+        RR = 24,  // 6 doubles
+        QR = 72,  // 6 doubles
+        LATITUDE = 120,
+        LONGITUDE = 128,
+        HEIGHT = 136,
+        NS = 144,
+        STATUS = 145,
+        TYPE = 146,
+        AR_RATIO = 147,
+        AR_THRES = 151,
+        DOP = 155,  // 4 doubles
+        EPOCH_SIZE_BYTES = 187
+    };
+
     bool read_binary_obs();
+    bool read_epoch(int64_t epoch);  //!< Loads the dump variables of any epoch, without reading the previous ones
     bool restart();
     int64_t num_epochs();
     bool open_obs_file(std::string out_file);
 
+    //! All the values of one field, e.g. column<double>(LATITUDE) or column<double>(RR, 2) for Z
+    template <typename T>
+    Dump_Column<T> column(Field_Offset offset, size_t index = 0) const
+    {
+        return d_dump_map.column<T>(EPOCH_SIZE_BYTES, offset + index * sizeof(T));
+    }
+
     // rtklib_solver dump variables
     // TOW
     uint32_t TOW_at_current_symbol_ms;
@@ -82,7 +111,9 @@ public:
 
 private:
     std::string d_dump_filename;
-    std::ifstream d_dump_file;
+    // the dump file is memory-mapped, so that long recordings are paged in on demand
+    Dump_File_Map d_dump_map;
+    int64_t d_next_epoch = 0;
 };
 
 #endif  //GNSS_SDR_RTKLIB_SOLVER_DUMP_READER_H
@@ -0,0 +1,500 @@
+/*!
+ * \file realtime_factor.cc
+ * \brief Measures how fast the whole receiver processes a reference capture
+ * with a sweep of channel counts per band and of sample item types.
+ *
+ * Each run reports the real-time factor (seconds of signal processed per
+ * second of wall-clock time), the CPU time per channel, the peak resident
+ * memory and the split of the work time among the types of blocks, in a
+ * JSON summary. The largest channel count processed faster than real time
+ * is also reported for each item type.
+ *
+ * -------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2019  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *          Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------
+ */
+
+#include "concurrent_map.h"
+#include "concurrent_queue.h"
+#include "control_thread.h"
+#include "file_configuration.h"
+#include "gnss_flowgraph.h"
+#include "gps_acq_assist.h"
+#include "in_memory_configuration.h"
+#include <boost/tokenizer.hpp>
+#include <gflags/gflags.h>
+#include <glog/logging.h>
+#include <gnuradio/prefs.h>
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <complex>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <sys/resource.h>
+
+
+DEFINE_string(config_file_rtf, std::string(""), "Receiver configuration file. If empty, a GPS L1 C/A and Galileo E1 receiver reads --rtf_filename. With a file, its signal source and item types are used as they are");
+DEFINE_string(rtf_filename, std::string(""), "Reference capture, in gr_complex samples. If empty, the 4 ms CTTC capture of the test signal samples, repeated");
+DEFINE_int32(rtf_fs, 4000000, "Sampling rate of the reference capture, in Samples/s");
+DEFINE_double(rtf_duration, 30.0, "Seconds of signal processed in each run");
+DEFINE_string(rtf_item_types, std::string("gr_complex,cshort"), "Comma-separated list of item types of the samples processed by the channels (gr_complex, cshort)");
+DEFINE_string(rtf_channels, std::string("1C:4;1C:8;1C:12;1C:16;1C:8,1B:8"), "Semicolon-separated list of runs, each one a comma-separated list of band:channels");
+DEFINE_string(rtf_output, std::string("realtime_factor.json"), "JSON summary output file");
+
+// For GPS NAVIGATION (L1)
+concurrent_queue<Gps_Acq_Assist> global_gps_acq_assist_queue;
+concurrent_map<Gps_Acq_Assist> global_gps_acq_assist_map;
+
+
+struct Rtf_Run_Result
+{
+    std::string item_type;
+    std::map<std::string, int> channels;
+    int total_channels;
+    double wall_time_s;
+    double real_time_factor;
+    double cpu_time_s;
+    double cpu_cores_per_channel;
+    double peak_rss_mb;
+    std::map<std::string, double> block_work_time_s;
+};
+
+
+class RealTimeFactorTest : public ::testing::Test
+{
+public:
+    std::shared_ptr<ConfigurationInterface> configure_receiver(const std::string& item_type, const std::string& filename, const std::map<std::string, int>& channels);
+    bool convert_capture(const std::string& filename_in, const std::string& filename_out);
+    bool run_receiver(const std::shared_ptr<ConfigurationInterface>& config, Rtf_Run_Result& result);
+    void print_report(const std::vector<Rtf_Run_Result>& results);
+
+    const double central_freq = 1575420000.0;
+    const int coherent_integration_time_ms = 1;
+    const float threshold = 0.01;
+    const float doppler_max = 5000.0;
+    const float doppler_step = 250.0;
+    const float pll_bw_hz = 30.0;
+    const float dll_bw_hz = 4.0;
+    const float early_late_space_chips = 0.5;
+    const int output_rate_ms = 100;
+    const int display_rate_ms = 500;
+};
+
+
+std::vector<std::string> split_list(const std::string& list, const char* separator)
+{
+    std::vector<std::string> items;
+    boost::char_separator<char> sep(separator);
+    boost::tokenizer<boost::char_separator<char> > tokens(list, sep);
+    for (const auto& token : tokens)
+        {
+            items.push_back(token);
+        }
+    return items;
+}
+
+
+// Parses "1C:8,1B:4" into the number of channels of each band
+std::map<std::string, int> parse_channels(const std::string& run)
+{
+    std::map<std::string, int> channels;
+    for (const auto& band : split_list(run, ","))
+        {
+            size_t colon = band.find(':');
+            if (colon == std::string::npos)
+                {
+                    std::cout << "Ignoring " << band << ", the format is band:channels" << std::endl;
+                    continue;
+                }
+            channels[band.substr(0, colon)] = std::stoi(band.substr(colon + 1));
+        }
+    return channels;
+}
+
+
+// Peak resident memory of the process since the last reset_peak_rss() [MB]
+double peak_rss_mb()
+{
+    std::ifstream status("/proc/self/status");
+    std::string line;
+    while (std::getline(status, line))
+        {
+            if (line.compare(0, 6, "VmHWM:") == 0)
+                {
+                    return std::stod(line.substr(6)) / 1024.0;
+                }
+        }
+    // not Linux: peak of the whole process life
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    return static_cast<double>(usage.ru_maxrss) / 1024.0;
+}
+
+
+void reset_peak_rss()
+{
+    // Linux >= 4.0 resets VmHWM to the current resident memory
+    std::ofstream clear_refs("/proc/self/clear_refs");
+    clear_refs << "5";
+}
+
+
+// Sampling rate of the signal source [Sps]
+double source_fs(const std::shared_ptr<ConfigurationInterface>& config)
+{
+    int32_t internal_fs = config->property("GNSS-SDR.internal_fs_sps", FLAGS_rtf_fs);
+    return static_cast<double>(config->property("SignalSource.sampling_frequency", static_cast<int64_t>(internal_fs)));
+}
+
+
+double cpu_time_s()
+{
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    return static_cast<double>(usage.ru_utime.tv_sec + usage.ru_stime.tv_sec) + static_cast<double>(usage.ru_utime.tv_usec + usage.ru_stime.tv_usec) * 1e-6;
+}
+
+
+bool RealTimeFactorTest::convert_capture(const std::string& filename_in, const std::string& filename_out)
+{
+    std::ifstream in(filename_in, std::ios::binary);
+    std::ofstream out(filename_out, std::ios::binary);
+    if (!in.is_open() or !out.is_open())
+        {
+            return false;
+        }
+    std::vector<std::complex<float>> samples(1048576);
+    std::vector<std::complex<int16_t>> converted(samples.size());
+    float scale = 0.0;
+    while (in)
+        {
+            in.read(reinterpret_cast<char*>(samples.data()), samples.size() * sizeof(std::complex<float>));
+            size_t n_samples = static_cast<size_t>(in.gcount()) / sizeof(std::complex<float>);
+            if (n_samples == 0)
+                {
+                    break;
+                }
+            if (scale == 0.0)
+                {
+                    // 12-bit front-end: the RMS amplitude at a quarter of the full scale
+                    double power = 0.0;
+                    for (size_t n = 0; n < n_samples; n++)
+                        {
+                            power += std::norm(samples[n]);
+                        }
+                    scale = (power > 0.0) ? static_cast<float>(512.0 / std::sqrt(power / static_cast<double>(n_samples))) : 1.0F;
+                }
+            for (size_t n = 0; n < n_samples; n++)
+                {
+                    float re = std::max(std::min(std::round(samples[n].real() * scale), 2047.0F), -2048.0F);
+                    float im = std::max(std::min(std::round(samples[n].imag() * scale), 2047.0F), -2048.0F);
+                    converted[n] = std::complex<int16_t>(static_cast<int16_t>(re), static_cast<int16_t>(im));
+                }
+            out.write(reinterpret_cast<const char*>(converted.data()), n_samples * sizeof(std::complex<int16_t>));
+        }
+    return true;
+}
+
+
+std::shared_ptr<ConfigurationInterface> RealTimeFactorTest::configure_receiver(const std::string& item_type, const std::string& filename, const std::map<std::string, int>& channels)
+{
+    const auto samples = static_cast<uint64_t>(FLAGS_rtf_duration * static_cast<double>(FLAGS_rtf_fs));
+    if (!FLAGS_config_file_rtf.empty())
+        {
+            std::shared_ptr<FileConfiguration> config = std::make_shared<FileConfiguration>(FLAGS_config_file_rtf);
+            config->set_property("SignalSource.samples", std::to_string(static_cast<uint64_t>(FLAGS_rtf_duration * source_fs(config))));
+            int total_channels = 0;
+            for (const auto& band : channels)
+                {
+                    config->set_property("Channels_" + band.first + ".count", std::to_string(band.second));
+                    total_channels += band.second;
+                }
+            config->set_property("Channels.in_acquisition", std::to_string(total_channels));
+            return config;
+        }
+
+    std::shared_ptr<InMemoryConfiguration> config = std::make_shared<InMemoryConfiguration>();
+    config->set_property("GNSS-SDR.internal_fs_sps", std::to_string(FLAGS_rtf_fs));
+
+    // Set the Signal Source
+    config->set_property("SignalSource.implementation", "File_Signal_Source");
+    config->set_property("SignalSource.filename", filename);
+    config->set_property("SignalSource.item_type", item_type);
+    config->set_property("SignalSource.sampling_frequency", std::to_string(FLAGS_rtf_fs));
+    config->set_property("SignalSource.freq", std::to_string(central_freq));
+    config->set_property("SignalSource.samples", std::to_string(samples));
+    config->set_property("SignalSource.repeat", "true");
+    config->set_property("SignalSource.dump", "false");
+
+    // Set the Signal Conditioner
+    config->set_property("SignalConditioner.implementation", "Signal_Conditioner");
+    for (const auto& role : std::vector<std::string>{"DataTypeAdapter", "InputFilter", "Resampler"})
+        {
+            config->set_property(role + ".implementation", "Pass_Through");
+            config->set_property(role + ".item_type", item_type);
+            config->set_property(role + ".input_item_type", item_type);
+            config->set_property(role + ".output_item_type", item_type);
+        }
+
+    // Set the Channels
+    int total_channels = 0;
+    for (const auto& band : channels)
+        {
+            config->set_property("Channels_" + band.first + ".count", std::to_string(band.second));
+            total_channels += band.second;
+        }
+    // every channel is busy, searching or tracking
+    config->set_property("Channels.in_acquisition", std::to_string(total_channels));
+
+    // GPS L1 C/A
+    config->set_property("Acquisition_1C.implementation", "GPS_L1_CA_PCPS_Acquisition");
+    config->set_property("Acquisition_1C.item_type", item_type);
+    config->set_property("Acquisition_1C.coherent_integration_time_ms", std::to_string(coherent_integration_time_ms));
+    config->set_property("Acquisition_1C.threshold", std::to_string(threshold));
+    config->set_property("Acquisition_1C.doppler_max", std::to_string(doppler_max));
+    config->set_property("Acquisition_1C.doppler_step", std::to_string(doppler_step));
+    config->set_property("Acquisition_1C.dump", "false");
+    config->set_property("Tracking_1C.implementation", "GPS_L1_CA_DLL_PLL_Tracking");
+    config->set_property("Tracking_1C.item_type", item_type);
+    config->set_property("Tracking_1C.pll_bw_hz", std::to_string(pll_bw_hz));
+    config->set_property("Tracking_1C.dll_bw_hz", std::to_string(dll_bw_hz));
+    config->set_property("Tracking_1C.early_late_space_chips", std::to_string(early_late_space_chips));
+    config->set_property("Tracking_1C.dump", "false");
+    config->set_property("TelemetryDecoder_1C.implementation", "GPS_L1_CA_Telemetry_Decoder");
+    config->set_property("TelemetryDecoder_1C.dump", "false");
+
+    // Galileo E1
+    config->set_property("Acquisition_1B.implementation", "Galileo_E1_PCPS_Ambiguous_Acquisition");
+    config->set_property("Acquisition_1B.item_type", item_type);
+    config->set_property("Acquisition_1B.coherent_integration_time_ms", std::to_string(4));
+    config->set_property("Acquisition_1B.threshold", std::to_string(threshold));
+    config->set_property("Acquisition_1B.doppler_max", std::to_string(doppler_max));
+    config->set_property("Acquisition_1B.doppler_step", std::to_string(doppler_step));
+    config->set_property("Acquisition_1B.dump", "false");
+    config->set_property("Tracking_1B.implementation", "Galileo_E1_DLL_PLL_VEML_Tracking");
+    config->set_property("Tracking_1B.item_type", item_type);
+    config->set_property("Tracking_1B.pll_bw_hz", std::to_string(15.0));
+    config->set_property("Tracking_1B.dll_bw_hz", std::to_string(2.0));
+    config->set_property("Tracking_1B.dump", "false");
+    config->set_property("TelemetryDecoder_1B.implementation", "Galileo_E1B_Telemetry_Decoder");
+    config->set_property("TelemetryDecoder_1B.dump", "false");
+
+    // Set Observables
+    config->set_property("Observables.implementation", "Hybrid_Observables");
+    config->set_property("Observables.dump", "false");
+
+    // Set PVT
+    config->set_property("PVT.implementation", "RTKLIB_PVT");
+    config->set_property("PVT.positioning_mode", "Single");
+    config->set_property("PVT.output_rate_ms", std::to_string(output_rate_ms));
+    config->set_property("PVT.display_rate_ms", std::to_string(display_rate_ms));
+    config->set_property("PVT.flag_nmea_tty_port", "false");
+    config->set_property("PVT.flag_rtcm_server", "false");
+    config->set_property("PVT.flag_rtcm_tty_port", "false");
+    config->set_property("PVT.dump", "false");
+    return config;
+}
+
+
+bool RealTimeFactorTest::run_receiver(const std::shared_ptr<ConfigurationInterface>& config, Rtf_Run_Result& result)
+{
+    std::shared_ptr<ControlThread> control_thread = std::make_shared<ControlThread>(config);
+    reset_peak_rss();
+    double cpu_start = cpu_time_s();
+    std::chrono::time_point<std::chrono::steady_clock> start = std::chrono::steady_clock::now();
+    try
+        {
+            control_thread->run();
+        }
+    catch (const boost::exception& e)
+        {
+            std::cout << "Boost exception: " << boost::diagnostic_information(e);
+            return false;
+        }
+    catch (const std::exception& ex)
+        {
+            std::cout << "STD exception: " << ex.what();
+            return false;
+        }
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    result.wall_time_s = elapsed.count();
+    result.cpu_time_s = cpu_time_s() - cpu_start;
+    result.peak_rss_mb = peak_rss_mb();
+
+    std::shared_ptr<GNSSFlowgraph> flowgraph = control_thread->flowgraph();
+    EXPECT_FALSE(flowgraph->running());
+    result.block_work_time_s = flowgraph->get_work_time_per_block_type();
+
+    double signal_s = static_cast<double>(config->property("SignalSource.samples", static_cast<uint64_t>(0))) / source_fs(config);
+    result.real_time_factor = (result.wall_time_s > 0.0) ? signal_s / result.wall_time_s : 0.0;
+    result.cpu_cores_per_channel = ((signal_s > 0.0) and (result.total_channels > 0)) ? result.cpu_time_s / signal_s / static_cast<double>(result.total_channels) : 0.0;
+    return true;
+}
+
+
+void RealTimeFactorTest::print_report(const std::vector<Rtf_Run_Result>& results)
+{
+    std::map<std::string, int> max_real_time_channels;
+    std::stringstream json;
+    json << "{" << std::endl;
+    json << "  \"host\": \"" << std::string(HOST_SYSTEM) << "\"," << std::endl;
+    json << "  \"config_file\": \"" << FLAGS_config_file_rtf << "\"," << std::endl;
+    json << "  \"duration_s\": " << FLAGS_rtf_duration << "," << std::endl;
+    json << "  \"runs\": [" << std::endl;
+    for (size_t r = 0; r < results.size(); r++)
+        {
+            const Rtf_Run_Result& result = results[r];
+            json << "    {\"item_type\": \"" << result.item_type << "\", \"channels\": {";
+            for (auto band = result.channels.begin(); band != result.channels.end(); ++band)
+                {
+                    json << (band == result.channels.begin() ? "" : ", ") << "\"" << band->first << "\": " << band->second;
+                }
+            json << "}, \"total_channels\": " << result.total_channels
+                 << ", \"wall_time_s\": " << result.wall_time_s
+                 << ", \"real_time_factor\": " << result.real_time_factor
+                 << ", \"cpu_time_s\": " << result.cpu_time_s
+                 << ", \"cpu_cores_per_channel\": " << result.cpu_cores_per_channel
+                 << ", \"peak_rss_MB\": " << result.peak_rss_mb
+                 << ", \"block_cpu_split\": {";
+            // share of the CPU time of the process spent in the work calls of each type of block
+            for (auto block = result.block_work_time_s.begin(); block != result.block_work_time_s.end(); ++block)
+                {
+                    json << (block == result.block_work_time_s.begin() ? "" : ", ") << "\"" << block->first << "\": " << (result.cpu_time_s > 0.0 ? block->second / result.cpu_time_s : 0.0);
+                }
+            json << "}}" << (r + 1 < results.size() ? "," : "") << std::endl;
+            if (result.real_time_factor >= 1.0)
+                {
+                    max_real_time_channels[result.item_type] = std::max(max_real_time_channels[result.item_type], result.total_channels);
+                }
+        }
+    json << "  ]," << std::endl;
+    json << "  \"max_real_time_channels\": {";
+    for (auto item_type = max_real_time_channels.begin(); item_type != max_real_time_channels.end(); ++item_type)
+        {
+            json << (item_type == max_real_time_channels.begin() ? "" : ", ") << "\"" << item_type->first << "\": " << item_type->second;
+        }
+    json << "}" << std::endl;
+    json << "}" << std::endl;
+
+    std::cout << json.str();
+    std::ofstream output(FLAGS_rtf_output);
+    if (output.is_open())
+        {
+            output << json.str();
+            std::cout << "Summary written to " << FLAGS_rtf_output << std::endl;
+        }
+}
+
+
+TEST_F(RealTimeFactorTest /*unused*/, ChannelSweep /*unused*/)
+{
+    // the per-block split comes from the GNU Radio performance counters
+    gr::prefs::singleton()->set_bool("PerfCounters", "on", true);
+
+    std::string filename = FLAGS_rtf_filename;
+    if (filename.empty())
+        {
+            filename = std::string(TEST_PATH) + "signal_samples/GSoC_CTTC_capture_2012_07_26_4Msps_4ms.dat";
+        }
+    std::vector<std::string> item_types = split_list(FLAGS_rtf_item_types, ",");
+    if (!FLAGS_config_file_rtf.empty())
+        {
+            // the configuration file sets them
+            item_types = {"configured"};
+        }
+    const std::string cshort_filename = "./realtime_factor_cshort.dat";
+
+    std::vector<Rtf_Run_Result> results;
+    for (const auto& item_type : item_types)
+        {
+            std::string source_filename = filename;
+            if (item_type == "cshort")
+                {
+                    ASSERT_TRUE(convert_capture(filename, cshort_filename)) << "Unable to convert " << filename << " to cshort";
+                    source_filename = cshort_filename;
+                }
+            else if ((item_type != "gr_complex") and (item_type != "configured"))
+                {
+                    std::cout << "Skipping the unsupported item type " << item_type << std::endl;
+                    continue;
+                }
+            for (const auto& run : split_list(FLAGS_rtf_channels, ";"))
+                {
+                    Rtf_Run_Result result{};
+                    result.item_type = item_type;
+                    result.channels = parse_channels(run);
+                    for (const auto& band : result.channels)
+                        {
+                            result.total_channels += band.second;
+                        }
+                    std::cout << "Running " << run << " with " << item_type << " samples..." << std::endl;
+                    if (run_receiver(configure_receiver(item_type, source_filename, result.channels), result))
+                        {
+                            std::cout << "Real-time factor: " << result.real_time_factor << ", CPU cores per channel: " << result.cpu_cores_per_channel << std::endl;
+                            results.push_back(result);
+                        }
+                }
+            if (source_filename == cshort_filename)
+                {
+                    std::remove(cshort_filename.c_str());
+                }
+        }
+    EXPECT_FALSE(results.empty());
+    print_report(results);
+}
+
+
+int main(int argc, char** argv)
+{
+    std::cout << "Running Real-Time Factor test..." << std::endl;
+    int res = 0;
+    try
+        {
+            testing::InitGoogleTest(&argc, argv);
+        }
+    catch (...)
+        {
+        }  // catch the "testing::internal::<unnamed>::ClassUniqueToAlwaysTrue" from gtest
+
+    google::ParseCommandLineFlags(&argc, &argv, true);
+    google::InitGoogleLogging(argv[0]);
+
+    // Run the Tests
+    try
+        {
+            res = RUN_ALL_TESTS();
+        }
+    catch (...)
+        {
+            LOG(WARNING) << "Unexpected catch";
+        }
+    google::ShutDownCommandLineFlags();
+    return res;
+}
@@ -38,20 +38,30 @@
 #include "gps_acq_assist.h"
 #include "in_memory_configuration.h"
 #include <boost/date_time/posix_time/posix_time.hpp>
+#include <boost/tokenizer.hpp>
 #include <gflags/gflags.h>
 #include <glog/logging.h>
 #include <gtest/gtest.h>
+#include <algorithm>
 #include <cerrno>
 #include <chrono>
 #include <cmath>
+#include <cstring>
+#include <fstream>
+#include <iterator>
 #include <limits>
+#include <map>
 #include <numeric>
 #include <random>
+#include <sstream>
 #include <string>
 #include <sys/ipc.h>
 #include <sys/msg.h>
+#include <sys/resource.h>
 #include <sys/types.h>
+#include <sys/wait.h>
 #include <thread>
+#include <unistd.h>
 
 
 DEFINE_int32(fs_in, 4000000, "Sampling rate, in Samples/s");
@@ -61,6 +71,16 @@ DEFINE_string(device_address, "192.168.40.2", "USRP device IP address");
 DEFINE_string(subdevice, "A:0", "USRP subdevice");
 DEFINE_string(config_file_ttff, std::string(""), "File containing the configuration parameters for the TTFF test.");
 
+// Headless benchmark, replaying a recording
+DEFINE_string(ttff_filename, std::string(""), "Reference recording replayed by the TTFF benchmark, in gr_complex samples at --fs_in. If empty, the benchmark is skipped. With --config_file_ttff, it replaces SignalSource.filename");
+DEFINE_string(ttff_modes, std::string("cold,warm,hot"), "Comma-separated list of start modes of the benchmark (cold, warm, hot)");
+DEFINE_int32(ttff_runs, 10, "Starts of the benchmark in each mode");
+DEFINE_int32(ttff_parallel, 4, "Receivers of the benchmark running at the same time, each one in its own process");
+DEFINE_string(ttff_snapshot, std::string(""), "Receiver snapshot (GNSS-SDR.snapshot_filename) injected in the warm starts, without the Doppler shifts, and in the hot starts");
+DEFINE_string(ttff_ephemeris_xml, std::string(""), "GPS ephemeris XML file injected in the hot starts");
+DEFINE_bool(ttff_throttle, true, "Replay the recording at its sampling rate, so that the TTFF is measured in real time");
+DEFINE_string(ttff_output, std::string("ttff_benchmark.json"), "JSON summary output file of the benchmark");
+
 // For GPS NAVIGATION (L1)
 concurrent_queue<Gps_Acq_Assist> global_gps_acq_assist_queue;
 concurrent_map<Gps_Acq_Assist> global_gps_acq_assist_map;
@@ -73,6 +93,19 @@ typedef struct
     double ttff;
 } ttff_msgbuf;
 
+// Startup phases reported by GNSSFlowgraph::get_startup_times()
+const std::vector<std::string> TTFF_STARTUP_PHASES = {"fft_wisdom", "sources", "observables", "pvt", "channels", "connect", "start"};
+
+// Result of a start of the benchmark, sent by its process through a pipe
+struct Ttff_Run_Result
+{
+    int32_t run;
+    bool fixed;
+    double ttff_s;        // from the creation of the receiver to the first fix
+    double cpu_to_fix_s;  // CPU time of the receiver until the first fix
+    double startup_s[7];  // TTFF_STARTUP_PHASES
+};
+
 
 class TtffTest : public ::testing::Test
 {
@@ -80,6 +113,9 @@ public:
     void config_1();
     void config_2();
     void print_TTFF_report(const std::vector<double> &ttff_v, std::shared_ptr<ConfigurationInterface> config_);
+    std::shared_ptr<ConfigurationInterface> benchmark_config(const std::string &mode, int32_t run);
+    Ttff_Run_Result run_benchmark_start(const std::string &mode, int32_t run);
+    void print_benchmark_report(const std::map<std::string, std::vector<Ttff_Run_Result>> &results);
 
     std::shared_ptr<InMemoryConfiguration> config;
     std::shared_ptr<FileConfiguration> config2;
@@ -417,6 +453,261 @@ void TtffTest::print_TTFF_report(const std::vector<double> &ttff_v, std::shared_
 }
 
 
+double ttff_cpu_time_s()
+{
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    return static_cast<double>(usage.ru_utime.tv_sec + usage.ru_stime.tv_sec) + static_cast<double>(usage.ru_utime.tv_usec + usage.ru_stime.tv_usec) * 1e-6;
+}
+
+
+double ttff_percentile(std::vector<double> values, double p)
+{
+    if (values.empty())
+        {
+            return 0.0;
+        }
+    std::sort(values.begin(), values.end());
+    size_t index = static_cast<size_t>(std::ceil(p * static_cast<double>(values.size()))) - 1;
+    return values[std::min(index, values.size() - 1)];
+}
+
+
+std::shared_ptr<ConfigurationInterface> TtffTest::benchmark_config(const std::string &mode, int32_t run)
+{
+    std::shared_ptr<ConfigurationInterface> benchmark_config_;
+    int32_t fs = FLAGS_fs_in;
+    if (!FLAGS_config_file_ttff.empty())
+        {
+            std::shared_ptr<FileConfiguration> file_config = std::make_shared<FileConfiguration>(FLAGS_config_file_ttff);
+            fs = file_config->property("GNSS-SDR.internal_fs_sps", FLAGS_fs_in);
+            file_config->set_property("SignalSource.filename", FLAGS_ttff_filename);
+            file_config->set_property("SignalSource.samples", std::to_string(static_cast<int64_t>(fs) * FLAGS_max_measurement_duration));
+            file_config->set_property("SignalSource.enable_throttle_control", FLAGS_ttff_throttle ? "true" : "false");
+            benchmark_config_ = file_config;
+        }
+    else
+        {
+            std::shared_ptr<InMemoryConfiguration> config_ = std::make_shared<InMemoryConfiguration>();
+            config_->set_property("GNSS-SDR.internal_fs_sps", std::to_string(fs));
+
+            // Set the Signal Source
+            config_->set_property("SignalSource.implementation", "File_Signal_Source");
+            config_->set_property("SignalSource.filename", FLAGS_ttff_filename);
+            config_->set_property("SignalSource.item_type", "gr_complex");
+            config_->set_property("SignalSource.sampling_frequency", std::to_string(fs));
+            config_->set_property("SignalSource.freq", std::to_string(central_freq));
+            config_->set_property("SignalSource.samples", std::to_string(static_cast<int64_t>(fs) * FLAGS_max_measurement_duration));
+            config_->set_property("SignalSource.enable_throttle_control", FLAGS_ttff_throttle ? "true" : "false");
+            config_->set_property("SignalSource.dump", "false");
+
+            // Set the Signal Conditioner
+            config_->set_property("SignalConditioner.implementation", "Signal_Conditioner");
+            config_->set_property("DataTypeAdapter.implementation", "Pass_Through");
+            config_->set_property("InputFilter.implementation", "Pass_Through");
+            config_->set_property("InputFilter.item_type", "gr_complex");
+            config_->set_property("Resampler.implementation", "Pass_Through");
+            config_->set_property("Resampler.item_type", "gr_complex");
+
+            // Set the number of Channels
+            config_->set_property("Channels_1C.count", std::to_string(number_of_channels));
+            config_->set_property("Channels.in_acquisition", std::to_string(in_acquisition));
+            config_->set_property("Channel.signal", "1C");
+
+            // Set Acquisition
+            config_->set_property("Acquisition_1C.implementation", "GPS_L1_CA_PCPS_Acquisition");
+            config_->set_property("Acquisition_1C.item_type", "gr_complex");
+            config_->set_property("Acquisition_1C.coherent_integration_time_ms", std::to_string(coherent_integration_time_ms));
+            config_->set_property("Acquisition_1C.threshold", std::to_string(threshold));
+            config_->set_property("Acquisition_1C.doppler_max", std::to_string(doppler_max));
+            config_->set_property("Acquisition_1C.doppler_step", std::to_string(doppler_step));
+            config_->set_property("Acquisition_1C.max_dwells", std::to_string(max_dwells));
+            config_->set_property("Acquisition_1C.dump", "false");
+
+            // Set Tracking
+            config_->set_property("Tracking_1C.implementation", "GPS_L1_CA_DLL_PLL_Tracking");
+            config_->set_property("Tracking_1C.item_type", "gr_complex");
+            config_->set_property("Tracking_1C.pll_bw_hz", std::to_string(pll_bw_hz));
+            config_->set_property("Tracking_1C.dll_bw_hz", std::to_string(dll_bw_hz));
+            config_->set_property("Tracking_1C.early_late_space_chips", std::to_string(early_late_space_chips));
+            config_->set_property("Tracking_1C.dump", "false");
+
+            // Set Telemetry
+            config_->set_property("TelemetryDecoder_1C.implementation", "GPS_L1_CA_Telemetry_Decoder");
+            config_->set_property("TelemetryDecoder_1C.dump", "false");
+
+            // Set Observables
+            config_->set_property("Observables.implementation", "Hybrid_Observables");
+            config_->set_property("Observables.dump", "false");
+
+            // Set PVT
+            config_->set_property("PVT.implementation", "RTKLIB_PVT");
+            config_->set_property("PVT.positioning_mode", "Single");
+            config_->set_property("PVT.output_rate_ms", std::to_string(output_rate_ms));
+            config_->set_property("PVT.display_rate_ms", std::to_string(display_rate_ms));
+            config_->set_property("PVT.dump", "false");
+            benchmark_config_ = config_;
+        }
+
+    // the receivers running at the same time must not share files, ports or message queues
+    benchmark_config_->set_property("GNSS-SDR.ttff_msg_key", std::to_string(2101 + run));
+    benchmark_config_->set_property("GNSS-SDR.telecommand_enabled", "false");
+    benchmark_config_->set_property("PVT.output_enabled", "false");
+    benchmark_config_->set_property("PVT.flag_nmea_tty_port", "false");
+    benchmark_config_->set_property("PVT.flag_rtcm_server", "false");
+    benchmark_config_->set_property("PVT.flag_rtcm_tty_port", "false");
+    benchmark_config_->set_property("GNSS-SDR.SUPL_gps_enabled", "false");
+
+    // Start mode
+    benchmark_config_->set_property("GNSS-SDR.AGNSS_XML_enabled", "false");
+    benchmark_config_->set_property("GNSS-SDR.snapshot_filename", "");
+    if ((mode == "warm" or mode == "hot") and !FLAGS_ttff_snapshot.empty())
+        {
+            // each receiver saves its own snapshot on shutdown, so it gets a copy
+            std::string snapshot_copy = "./ttff_benchmark_" + std::to_string(run) + ".snapshot";
+            std::ifstream src(FLAGS_ttff_snapshot, std::ios::binary);
+            std::ofstream dst(snapshot_copy, std::ios::binary);
+            dst << src.rdbuf();
+            benchmark_config_->set_property("GNSS-SDR.snapshot_filename", snapshot_copy);
+            // the snapshot comes with the recording, however old they are
+            benchmark_config_->set_property("GNSS-SDR.snapshot_max_age_s", "1e12");
+            benchmark_config_->set_property("GNSS-SDR.snapshot_doppler_max_age_s", mode == "hot" ? "1e12" : "-1");
+        }
+    if ((mode == "hot") and !FLAGS_ttff_ephemeris_xml.empty())
+        {
+            benchmark_config_->set_property("GNSS-SDR.AGNSS_XML_enabled", "true");
+            benchmark_config_->set_property("GNSS-SDR.SUPL_gps_ephemeris_xml", FLAGS_ttff_ephemeris_xml);
+        }
+    return benchmark_config_;
+}
+
+
+// Runs in the process of a start: the receiver runs until its first fix or the end of the recording
+Ttff_Run_Result TtffTest::run_benchmark_start(const std::string &mode, int32_t run)
+{
+    Ttff_Run_Result result{};
+    result.run = run;
+    result.fixed = false;
+    std::shared_ptr<ConfigurationInterface> config_ = benchmark_config(mode, run);
+    const key_t ttff_key = config_->property("GNSS-SDR.ttff_msg_key", 1101);
+
+    double cpu_start = ttff_cpu_time_s();
+    std::chrono::time_point<std::chrono::steady_clock> start = std::chrono::steady_clock::now();
+    std::shared_ptr<ControlThread> control_thread = std::make_shared<ControlThread>(config_);
+    control_thread->set_process_listeners(false);
+
+    // the PVT block has created the queue of its first fix
+    int msqid = msgget(ttff_key, 0644);
+    std::thread fix_waiter([&]() {
+        ttff_msgbuf msg;
+        if ((msqid != -1) and (msgrcv(msqid, &msg, sizeof(msg.ttff), 1, 0) != -1) and (msg.ttff > 0.0))
+            {
+                std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+                result.ttff_s = elapsed.count();
+                result.cpu_to_fix_s = ttff_cpu_time_s() - cpu_start;
+                result.fixed = true;
+                control_thread->stop();
+            }
+    });
+
+    try
+        {
+            control_thread->run();
+        }
+    catch (const boost::exception &e)
+        {
+            std::cout << "Boost exception: " << boost::diagnostic_information(e);
+        }
+    catch (const std::exception &ex)
+        {
+            std::cout << "STD exception: " << ex.what();
+        }
+
+    // no fix until the end of the recording: wake the waiter up
+    ttff_msgbuf no_fix;
+    no_fix.mtype = 1;
+    no_fix.ttff = -1.0;
+    if (msqid != -1)
+        {
+            msgsnd(msqid, &no_fix, sizeof(no_fix.ttff), IPC_NOWAIT);
+        }
+    fix_waiter.join();
+
+    std::map<std::string, double> startup_times = control_thread->flowgraph()->get_startup_times();
+    for (size_t phase = 0; phase < TTFF_STARTUP_PHASES.size(); phase++)
+        {
+            result.startup_s[phase] = startup_times[TTFF_STARTUP_PHASES[phase]];
+        }
+    return result;
+}
+
+
+void TtffTest::print_benchmark_report(const std::map<std::string, std::vector<Ttff_Run_Result>> &results)
+{
+    std::stringstream json;
+    json << "{" << std::endl;
+    json << "  \"host\": \"" << std::string(HOST_SYSTEM) << "\"," << std::endl;
+    json << "  \"recording\": \"" << FLAGS_ttff_filename << "\"," << std::endl;
+    json << "  \"config_file\": \"" << FLAGS_config_file_ttff << "\"," << std::endl;
+    json << "  \"throttle\": " << (FLAGS_ttff_throttle ? "true" : "false") << "," << std::endl;
+    json << "  \"parallel\": " << FLAGS_ttff_parallel << "," << std::endl;
+    json << "  \"modes\": {" << std::endl;
+    for (auto mode = results.begin(); mode != results.end(); ++mode)
+        {
+            std::vector<double> ttff;
+            std::vector<double> cpu;
+            std::vector<double> startup(TTFF_STARTUP_PHASES.size(), 0.0);
+            for (const auto &result : mode->second)
+                {
+                    for (size_t phase = 0; phase < TTFF_STARTUP_PHASES.size(); phase++)
+                        {
+                            startup[phase] += result.startup_s[phase] / static_cast<double>(mode->second.size());
+                        }
+                    if (result.fixed)
+                        {
+                            ttff.push_back(result.ttff_s);
+                            cpu.push_back(result.cpu_to_fix_s);
+                        }
+                }
+            double mean = ttff.empty() ? 0.0 : std::accumulate(ttff.begin(), ttff.end(), 0.0) / static_cast<double>(ttff.size());
+            double sq_sum = std::inner_product(ttff.begin(), ttff.end(), ttff.begin(), 0.0);
+            double stdev = ttff.empty() ? 0.0 : std::sqrt(std::max(sq_sum / static_cast<double>(ttff.size()) - mean * mean, 0.0));
+            double mean_cpu = cpu.empty() ? 0.0 : std::accumulate(cpu.begin(), cpu.end(), 0.0) / static_cast<double>(cpu.size());
+
+            json << "    \"" << mode->first << "\": {\"runs\": " << mode->second.size()
+                 << ", \"fixes\": " << ttff.size()
+                 << ", \"ttff_s\": {\"min\": " << ttff_percentile(ttff, 0.0)
+                 << ", \"median\": " << ttff_percentile(ttff, 0.5)
+                 << ", \"p90\": " << ttff_percentile(ttff, 0.9)
+                 << ", \"max\": " << ttff_percentile(ttff, 1.0)
+                 << ", \"mean\": " << mean
+                 << ", \"stdev\": " << stdev
+                 << ", \"values\": [";
+            for (size_t n = 0; n < ttff.size(); n++)
+                {
+                    json << (n == 0 ? "" : ", ") << ttff[n];
+                }
+            json << "]}, \"cpu_to_fix_s\": " << mean_cpu
+                 << ", \"startup_s\": {";
+            for (size_t phase = 0; phase < TTFF_STARTUP_PHASES.size(); phase++)
+                {
+                    json << (phase == 0 ? "" : ", ") << "\"" << TTFF_STARTUP_PHASES[phase] << "\": " << startup[phase];
+                }
+            json << "}}" << (std::next(mode) != results.end() ? "," : "") << std::endl;
+        }
+    json << "  }" << std::endl;
+    json << "}" << std::endl;
+
+    std::cout << json.str();
+    std::ofstream output(FLAGS_ttff_output);
+    if (output.is_open())
+        {
+            output << json.str();
+            std::cout << "Summary written to " << FLAGS_ttff_output << std::endl;
+        }
+}
+
+
 TEST_F(TtffTest /*unused*/, ColdStart /*unused*/)
 {
     unsigned int num_measurements = 0;
@@ -583,6 +874,106 @@ TEST_F(TtffTest /*unused*/, HotStart /*unused*/)
 }
 
 
+TEST_F(TtffTest /*unused*/, Benchmark /*unused*/)
+{
+    if (FLAGS_ttff_filename.empty())
+        {
+            std::cout << "No --ttff_filename recording, the TTFF benchmark is skipped" << std::endl;
+            return;
+        }
+
+    std::vector<std::pair<std::string, int32_t>> starts;
+    boost::char_separator<char> sep(",");
+    boost::tokenizer<boost::char_separator<char>> modes(FLAGS_ttff_modes, sep);
+    for (const auto &mode : modes)
+        {
+            if ((mode != "cold") and (mode != "warm") and (mode != "hot"))
+                {
+                    std::cout << "Ignoring the unknown start mode " << mode << std::endl;
+                    continue;
+                }
+            if ((mode == "warm") and FLAGS_ttff_snapshot.empty())
+                {
+                    std::cout << "The warm starts need a --ttff_snapshot, skipped" << std::endl;
+                    continue;
+                }
+            for (int32_t n = 0; n < FLAGS_ttff_runs; n++)
+                {
+                    starts.emplace_back(mode, static_cast<int32_t>(starts.size()));
+                }
+        }
+
+    // each start runs in a new process, with nothing cached in memory by the previous ones
+    std::map<std::string, std::vector<Ttff_Run_Result>> results;
+    std::map<pid_t, std::pair<std::string, int>> running;  // pid: mode and read end of its pipe
+    size_t next = 0;
+    while ((next < starts.size()) or !running.empty())
+        {
+            while ((next < starts.size()) and (running.size() < static_cast<size_t>(std::max(FLAGS_ttff_parallel, 1))))
+                {
+                    int fd[2];
+                    if (pipe(fd) == -1)
+                        {
+                            std::cout << "Unable to create a pipe: " << strerror(errno) << std::endl;
+                            next = starts.size();
+                            break;
+                        }
+                    pid_t pid = fork();
+                    if (pid == 0)
+                        {
+                            close(fd[0]);
+                            Ttff_Run_Result result = run_benchmark_start(starts[next].first, starts[next].second);
+                            ssize_t written = write(fd[1], &result, sizeof(result));
+                            close(fd[1]);
+                            _exit(written == static_cast<ssize_t>(sizeof(result)) ? 0 : 1);
+                        }
+                    close(fd[1]);
+                    if (pid == -1)
+                        {
+                            std::cout << "Unable to start a receiver process: " << strerror(errno) << std::endl;
+                            close(fd[0]);
+                            next = starts.size();
+                            break;
+                        }
+                    std::cout << "Started " << starts[next].first << " start " << starts[next].second + 1 << " / " << starts.size() << std::endl;
+                    running[pid] = std::make_pair(starts[next].first, fd[0]);
+                    next++;
+                }
+            if (running.empty())
+                {
+                    break;
+                }
+
+            int status = 0;
+            pid_t pid = wait(&status);
+            auto finished = running.find(pid);
+            if (finished == running.end())
+                {
+                    continue;
+                }
+            Ttff_Run_Result result{};
+            if (read(finished->second.second, &result, sizeof(result)) == static_cast<ssize_t>(sizeof(result)))
+                {
+                    results[finished->second.first].push_back(result);
+                    std::cout << "Finished " << finished->second.first << " start " << result.run + 1 << ": "
+                              << (result.fixed ? std::to_string(result.ttff_s) + " s" : std::string("no fix")) << std::endl;
+                }
+            else
+                {
+                    std::cout << "The receiver process " << pid << " ended without a result" << std::endl;
+                }
+            close(finished->second.second);
+            running.erase(finished);
+        }
+
+    print_benchmark_report(results);
+    for (const auto &mode : results)
+        {
+            EXPECT_FALSE(mode.second.empty());
+        }
+}
+
+
 int main(int argc, char **argv)
 {
     std::cout << "Running Time-To-First-Fix test..." << std::endl;
@@ -94,6 +94,8 @@ DECLARE_string(log_dir);
 #include "unit-tests/control-plane/gnss_flowgraph_test.cc"
 #include "unit-tests/control-plane/in_memory_configuration_test.cc"
 #include "unit-tests/control-plane/string_converter_test.cc"
+#include "unit-tests/signal-processing-blocks/acquisition/acq_dump_writer_test.cc"
+#include "unit-tests/signal-processing-blocks/acquisition/acq_spectrum_cache_test.cc"
 #include "unit-tests/signal-processing-blocks/acquisition/galileo_e1_pcps_8ms_ambiguous_acquisition_gsoc2013_test.cc"
 #include "unit-tests/signal-processing-blocks/acquisition/galileo_e1_pcps_ambiguous_acquisition_gsoc2013_test.cc"
 #include "unit-tests/signal-processing-blocks/acquisition/galileo_e1_pcps_ambiguous_acquisition_gsoc_test.cc"
@@ -113,6 +115,7 @@ DECLARE_string(log_dir);
 #include "unit-tests/signal-processing-blocks/filter/notch_filter_lite_test.cc"
 #include "unit-tests/signal-processing-blocks/filter/notch_filter_test.cc"
 #include "unit-tests/signal-processing-blocks/filter/pulse_blanking_filter_test.cc"
+#include "unit-tests/signal-processing-blocks/observables/gnss_circular_deque_test.cc"
 #include "unit-tests/signal-processing-blocks/resampler/direct_resampler_conditioner_cc_test.cc"
 #include "unit-tests/signal-processing-blocks/resampler/mmse_resampler_test.cc"
 #include "unit-tests/signal-processing-blocks/sources/file_signal_source_test.cc"
@@ -131,6 +134,7 @@ DECLARE_string(log_dir);
 #include "unit-tests/signal-processing-blocks/tracking/galileo_e5a_tracking_test.cc"
 #include "unit-tests/signal-processing-blocks/tracking/glonass_l1_ca_dll_pll_c_aid_tracking_test.cc"
 #include "unit-tests/signal-processing-blocks/tracking/glonass_l1_ca_dll_pll_tracking_test.cc"
+#include "unit-tests/signal-processing-blocks/tracking/secondary_code_sync_test.cc"
 #include "unit-tests/signal-processing-blocks/tracking/tracking_loop_filter_test.cc"
 
 #if CUDA_BLOCKS_TEST
@@ -147,8 +151,12 @@ DECLARE_string(log_dir);
 #include "unit-tests/signal-processing-blocks/pvt/rtcm_printer_test.cc"
 #include "unit-tests/signal-processing-blocks/pvt/rtcm_test.cc"
 #include "unit-tests/signal-processing-blocks/telemetry_decoder/galileo_fnav_inav_decoder_test.cc"
+#include "unit-tests/signal-processing-blocks/telemetry_decoder/gnss_ephemeris_registry_test.cc"
+#include "unit-tests/signal-processing-blocks/telemetry_decoder/linear_ring_buffer_test.cc"
+#include "unit-tests/signal-processing-blocks/telemetry_decoder/preamble_correlator_test.cc"
 #include "unit-tests/system-parameters/glonass_gnav_ephemeris_test.cc"
 #include "unit-tests/system-parameters/glonass_gnav_nav_message_test.cc"
+#include "unit-tests/system-parameters/gnss_packed_bits_test.cc"
 
 
 #if EXTRA_TESTS
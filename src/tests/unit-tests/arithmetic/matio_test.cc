@@ -30,10 +30,12 @@
  * -------------------------------------------------------------------------
  */
 
+#include "gnss_mat_converter.h"
 #include <gnuradio/gr_complex.h>
 #include <gtest/gtest.h>
 #include <matio.h>
 #include <cstdio>
+#include <fstream>
 
 TEST(MatioTest, WriteAndReadDoubles)
 {
@@ -158,3 +160,53 @@ TEST(MatioTest, WriteAndReadGrComplex)
         }
     ASSERT_EQ(remove(filename.c_str()), 0);
 }
+
+
+TEST(MatioTest, ConvertDumpInChunks)
+{
+    // Dump of 1000 records, each one with a {float, double} group per channel
+    const size_t channels = 3;
+    const size_t records = 1000;
+    std::string dump_filename = "./test_dump.dat";
+    std::string filename = "./test_dump.mat";
+    std::ofstream dump_file(dump_filename.c_str(), std::ios::out | std::ios::binary);
+    for (size_t r = 0; r < records; r++)
+        {
+            for (size_t ch = 0; ch < channels; ch++)
+                {
+                    float a = static_cast<float>(r * channels + ch);
+                    double b = -static_cast<double>(r * channels + ch);
+                    dump_file.write(reinterpret_cast<char *>(&a), sizeof(float));
+                    dump_file.write(reinterpret_cast<char *>(&b), sizeof(double));
+                }
+        }
+    dump_file.close();
+
+    const std::vector<Gnss_Mat_Converter::Field> fields = {
+        {"a", MAT_C_SINGLE, MAT_T_SINGLE, sizeof(float)},
+        {"b", MAT_C_DOUBLE, MAT_T_DOUBLE, sizeof(double)}};
+    ASSERT_TRUE(Gnss_Mat_Converter::convert_file(dump_filename, filename, fields, channels, 64));
+
+    mat_t *matfp_read = Mat_Open(filename.c_str(), MAT_ACC_RDONLY);
+    ASSERT_FALSE(reinterpret_cast<long *>(matfp_read) == nullptr) << "Error reading .mat file";
+    matvar_t *a_read = Mat_VarRead(matfp_read, "a");
+    matvar_t *b_read = Mat_VarRead(matfp_read, "b");
+    Mat_Close(matfp_read);
+    ASSERT_FALSE(reinterpret_cast<long *>(a_read) == nullptr) << "Error reading variable in .mat file";
+    ASSERT_FALSE(reinterpret_cast<long *>(b_read) == nullptr) << "Error reading variable in .mat file";
+    EXPECT_EQ(a_read->dims[0], channels);
+    EXPECT_EQ(a_read->dims[1], records);
+    EXPECT_EQ(b_read->dims[0], channels);
+    EXPECT_EQ(b_read->dims[1], records);
+    auto *a = reinterpret_cast<float *>(a_read->data);
+    auto *b = reinterpret_cast<double *>(b_read->data);
+    for (size_t i = 0; i < channels * records; i++)
+        {
+            EXPECT_FLOAT_EQ(a[i], static_cast<float>(i));
+            EXPECT_DOUBLE_EQ(b[i], -static_cast<double>(i));
+        }
+    Mat_VarFree(a_read);
+    Mat_VarFree(b_read);
+    ASSERT_EQ(remove(dump_filename.c_str()), 0);
+    ASSERT_EQ(remove(filename.c_str()), 0);
+}
@@ -0,0 +1,191 @@
+/*!
+ * \file acq_dump_writer_test.cc
+ * \brief  This file implements unit tests for the Acq_Dump_Writer class.
+ *
+ *
+ * -------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2019  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *          Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------
+ */
+
+#include "acq_dump_writer.h"
+#include <gtest/gtest.h>
+#include <matio.h>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+
+namespace
+{
+std::string dump_test_filename(uint32_t n)
+{
+    return "./acq_dump_writer_test_" + std::to_string(n) + ".mat";
+}
+
+
+std::unique_ptr<Acq_Dump_Record> make_dump_record(uint32_t n, const std::vector<float>& grid, size_t rows, bool quantize)
+{
+    std::unique_ptr<Acq_Dump_Record> record(new Acq_Dump_Record(dump_test_filename(n)));
+    record->add("PRN", n);
+    record->add("acq_doppler_hz", -1250.0F);
+    record->add_grid("acq_grid", grid.data(), rows, grid.size() / rows, quantize);
+    return record;
+}
+
+
+// Waits for the writer thread to handle \p records records
+bool wait_for_writer(const std::shared_ptr<Acq_Dump_Writer>& writer, uint64_t records)
+{
+    for (int i = 0; i < 1000; i++)
+        {
+            if (writer->written() + writer->dropped() + writer->failed() == records)
+                {
+                    return true;
+                }
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        }
+    return false;
+}
+}  // namespace
+
+
+TEST(AcqDumpWriterTest, SharedBySettings)
+{
+    std::shared_ptr<Acq_Dump_Writer> a = Acq_Dump_Writer::get_instance(16, true);
+    std::shared_ptr<Acq_Dump_Writer> b = Acq_Dump_Writer::get_instance(16, true);
+    std::shared_ptr<Acq_Dump_Writer> c = Acq_Dump_Writer::get_instance(16, false);
+    std::shared_ptr<Acq_Dump_Writer> d = Acq_Dump_Writer::get_instance(4, true);
+    EXPECT_EQ(a.get(), b.get());
+    EXPECT_NE(a.get(), c.get());
+    EXPECT_NE(a.get(), d.get());
+    EXPECT_NE(c.get(), d.get());
+}
+
+
+TEST(AcqDumpWriterTest, PendingRecordsAreWritten)
+{
+    const uint32_t records = 6;
+    const size_t rows = 8;
+    std::vector<float> grid(rows * 5);
+    for (size_t i = 0; i < grid.size(); i++)
+        {
+            grid[i] = 0.25F * static_cast<float>(i);
+        }
+    std::shared_ptr<Acq_Dump_Writer> writer = std::make_shared<Acq_Dump_Writer>(records, true);
+    for (uint32_t n = 0; n < records; n++)
+        {
+            EXPECT_TRUE(writer->push(make_dump_record(n, grid, rows, n % 2 == 1)));
+        }
+    // Releasing the writer waits for the records still in the queue
+    writer.reset();
+
+    for (uint32_t n = 0; n < records; n++)
+        {
+            bool quantized = (n % 2 == 1);
+            mat_t* matfp = Mat_Open(dump_test_filename(n).c_str(), MAT_ACC_RDONLY);
+            ASSERT_FALSE(matfp == nullptr) << "record " << n << " not written";
+
+            matvar_t* matvar = Mat_VarRead(matfp, "PRN");
+            ASSERT_FALSE(matvar == nullptr);
+            EXPECT_EQ(n, *reinterpret_cast<uint32_t*>(matvar->data));
+            Mat_VarFree(matvar);
+
+            matvar = Mat_VarRead(matfp, "acq_grid");
+            ASSERT_FALSE(matvar == nullptr);
+            EXPECT_EQ(rows, matvar->dims[0]);
+            EXPECT_EQ(grid.size() / rows, matvar->dims[1]);
+            if (quantized)
+                {
+                    matvar_t* scale_var = Mat_VarRead(matfp, "acq_grid_scale");
+                    ASSERT_FALSE(scale_var == nullptr);
+                    float scale = *reinterpret_cast<float*>(scale_var->data);
+                    Mat_VarFree(scale_var);
+                    EXPECT_EQ(MAT_C_UINT16, matvar->class_type);
+                    auto* values = reinterpret_cast<uint16_t*>(matvar->data);
+                    for (size_t i = 0; i < grid.size(); i++)
+                        {
+                            EXPECT_NEAR(grid[i], static_cast<float>(values[i]) * scale, scale);
+                        }
+                }
+            else
+                {
+                    EXPECT_EQ(MAT_C_SINGLE, matvar->class_type);
+                    auto* values = reinterpret_cast<float*>(matvar->data);
+                    for (size_t i = 0; i < grid.size(); i++)
+                        {
+                            EXPECT_FLOAT_EQ(grid[i], values[i]);
+                        }
+                }
+            Mat_VarFree(matvar);
+            Mat_Close(matfp);
+            EXPECT_EQ(0, std::remove(dump_test_filename(n).c_str()));
+        }
+}
+
+
+TEST(AcqDumpWriterTest, FullQueueDropsRecords)
+{
+    // A one-record queue fed faster than the files are written: every record
+    // is either written or dropped, and the caller never waits for the disk
+    const uint32_t records = 50;
+    const size_t rows = 64;
+    std::vector<float> grid(rows * 64, 1.0F);
+    std::shared_ptr<Acq_Dump_Writer> writer = std::make_shared<Acq_Dump_Writer>(1, true);
+    uint32_t accepted = 0;
+    for (uint32_t n = 0; n < records; n++)
+        {
+            if (writer->push(make_dump_record(n, grid, rows, false)))
+                {
+                    accepted++;
+                }
+        }
+    ASSERT_TRUE(wait_for_writer(writer, records));
+    EXPECT_EQ(accepted, writer->written());
+    EXPECT_EQ(records - accepted, writer->dropped());
+    EXPECT_EQ(0ULL, writer->failed());
+    EXPECT_GE(accepted, 1U);
+
+    // A file that cannot be created is counted, and it does not stop the writer
+    std::unique_ptr<Acq_Dump_Record> record(new Acq_Dump_Record("./acq_dump_writer_test_missing_dir/record.mat"));
+    record->add("PRN", 1U);
+    EXPECT_TRUE(writer->push(std::move(record)));
+    ASSERT_TRUE(wait_for_writer(writer, records + 1));
+    EXPECT_EQ(1ULL, writer->failed());
+
+    for (uint32_t n = 0; n < records; n++)
+        {
+            std::ifstream file(dump_test_filename(n));
+            bool exists = file.good();
+            file.close();
+            if (exists)
+                {
+                    EXPECT_EQ(0, std::remove(dump_test_filename(n).c_str()));
+                }
+        }
+}
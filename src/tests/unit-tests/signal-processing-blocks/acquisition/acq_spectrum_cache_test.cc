@@ -0,0 +1,82 @@
+/*!
+ * \file acq_spectrum_cache_test.cc
+ * \brief  This file implements unit tests for the Acq_Spectrum_Cache class.
+ *
+ *
+ * -------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2018  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *          Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------
+ */
+
+#include "acq_spectrum_cache.h"
+#include <gtest/gtest.h>
+#include <vector>
+
+
+TEST(AcqSpectrumCacheTest, StoreAndFind)
+{
+    Acq_Spectrum_Cache cache(16);
+    std::vector<gr_complex> spectrum(16, gr_complex(1.0, -1.0));
+    EXPECT_TRUE(cache.find(4000, -250.0) == nullptr);
+    cache.insert(4000, -250.0, spectrum.data());
+    std::shared_ptr<const gr_complex> stored = cache.find(4000, -250.0);
+    ASSERT_TRUE(stored != nullptr);
+    for (unsigned int i = 0; i < 16; i++)
+        {
+            EXPECT_EQ(spectrum[i], stored.get()[i]);
+        }
+    EXPECT_TRUE(cache.find(4000, 250.0) == nullptr);
+    EXPECT_TRUE(cache.find(8000, -250.0) == nullptr);
+    EXPECT_EQ(1ULL, cache.hits());
+    EXPECT_EQ(3ULL, cache.misses());
+}
+
+
+TEST(AcqSpectrumCacheTest, OldBlocksAreDropped)
+{
+    Acq_Spectrum_Cache cache(8, 2);
+    std::vector<gr_complex> spectrum(8, gr_complex(0.0, 0.0));
+    cache.insert(1000, 0.0, spectrum.data());
+    cache.insert(2000, 0.0, spectrum.data());
+    std::shared_ptr<const gr_complex> in_use = cache.find(1000, 0.0);
+    cache.insert(3000, 0.0, spectrum.data());
+    EXPECT_TRUE(cache.find(1000, 0.0) == nullptr);
+    EXPECT_TRUE(cache.find(2000, 0.0) != nullptr);
+    EXPECT_TRUE(cache.find(3000, 0.0) != nullptr);
+    // a spectrum already handed out survives its removal from the cache
+    EXPECT_EQ(gr_complex(0.0, 0.0), in_use.get()[7]);
+    // blocks older than the retained ones are not stored
+    cache.insert(500, 0.0, spectrum.data());
+    EXPECT_TRUE(cache.find(500, 0.0) == nullptr);
+}
+
+
+TEST(AcqSpectrumCacheTest, SharedInstances)
+{
+    std::shared_ptr<Acq_Spectrum_Cache> a = Acq_Spectrum_Cache::get_instance("1C", 4000000, 4000);
+    std::shared_ptr<Acq_Spectrum_Cache> b = Acq_Spectrum_Cache::get_instance("1C", 4000000, 4000);
+    std::shared_ptr<Acq_Spectrum_Cache> c = Acq_Spectrum_Cache::get_instance("1B", 4000000, 4000);
+    EXPECT_EQ(a.get(), b.get());
+    EXPECT_NE(a.get(), c.get());
+    EXPECT_EQ(4000U, c->fft_size());
+}
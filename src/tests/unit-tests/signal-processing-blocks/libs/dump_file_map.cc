@@ -0,0 +1,93 @@
+/*!
+ * \file dump_file_map.cc
+ * \brief Read-only memory mapping of the binary dump files, with strided
+ * views over the fields of their fixed-size records.
+ *
+ * -------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2019  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *          Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------
+ */
+
+#include "dump_file_map.h"
+#include <fcntl.h>     // for open, O_RDONLY
+#include <sys/mman.h>  // for mmap, munmap
+#include <sys/stat.h>  // for fstat
+#include <unistd.h>    // for close
+
+Dump_File_Map::Dump_File_Map()
+{
+    d_data = nullptr;
+    d_size = 0;
+}
+
+
+Dump_File_Map::~Dump_File_Map()
+{
+    close();
+}
+
+
+bool Dump_File_Map::open(const std::string& filename)
+{
+    close();
+    int fd = ::open(filename.c_str(), O_RDONLY);
+    struct stat file_status;
+    if (fd < 0 or fstat(fd, &file_status) != 0 or file_status.st_size == 0)
+        {
+            if (fd >= 0)
+                {
+                    ::close(fd);
+                }
+            return false;
+        }
+    void* map = mmap(nullptr, file_status.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);  // the mapping keeps the file referenced
+    if (map == MAP_FAILED)
+        {
+            return false;
+        }
+    madvise(map, file_status.st_size, MADV_SEQUENTIAL);
+    d_data = static_cast<const char*>(map);
+    d_size = file_status.st_size;
+    return true;
+}
+
+
+void Dump_File_Map::prefetch() const
+{
+    if (d_data != nullptr)
+        {
+            madvise(const_cast<char*>(d_data), d_size, MADV_WILLNEED);
+        }
+}
+
+
+void Dump_File_Map::close()
+{
+    if (d_data != nullptr)
+        {
+            munmap(const_cast<char*>(d_data), d_size);
+            d_data = nullptr;
+            d_size = 0;
+        }
+}
@@ -0,0 +1,112 @@
+/*!
+ * \file dump_file_map.h
+ * \brief Read-only memory mapping of the binary dump files, with strided
+ * views over the fields of their fixed-size records.
+ *
+ * -------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2019  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *          Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_DUMP_FILE_MAP_H
+#define GNSS_SDR_DUMP_FILE_MAP_H
+
+#include <cstddef>
+#include <cstring>
+#include <string>
+#include <vector>
+
+/*!
+ * \brief Values of one field along the records of a dump file, without
+ * copying them. The records are packed, so the values are read with memcpy.
+ */
+template <typename T>
+class Dump_Column
+{
+public:
+    Dump_Column() : d_first(nullptr), d_stride(0), d_size(0) {}
+    Dump_Column(const char* first, size_t stride, size_t size) : d_first(first), d_stride(stride), d_size(size) {}
+
+    T operator[](size_t i) const
+    {
+        T value;
+        std::memcpy(&value, d_first + i * d_stride, sizeof(T));
+        return value;
+    }
+
+    size_t size() const { return d_size; }
+
+    std::vector<T> to_vector() const
+    {
+        std::vector<T> values(d_size);
+        for (size_t i = 0; i < d_size; i++)
+            {
+                values[i] = (*this)[i];
+            }
+        return values;
+    }
+
+private:
+    const char* d_first;
+    size_t d_stride;
+    size_t d_size;
+};
+
+
+/*!
+ * \brief Maps a dump file in memory, so that long recordings are paged in
+ * on demand and any record can be reached without reading the previous ones.
+ */
+class Dump_File_Map
+{
+public:
+    Dump_File_Map();
+    ~Dump_File_Map();
+    Dump_File_Map(const Dump_File_Map&) = delete;
+    Dump_File_Map& operator=(const Dump_File_Map&) = delete;
+
+    bool open(const std::string& filename);
+    void close();
+    bool is_open() const { return d_data != nullptr; }
+    const char* data() const { return d_data; }
+    size_t size() const { return d_size; }
+
+    //! Reads ahead the whole file, for a file that several readers go through at once
+    void prefetch() const;
+
+    //! Number of complete records of \p record_bytes bytes
+    size_t records(size_t record_bytes) const { return record_bytes == 0 ? 0 : d_size / record_bytes; }
+
+    //! Field at \p offset bytes of each record of \p record_bytes bytes
+    template <typename T>
+    Dump_Column<T> column(size_t record_bytes, size_t offset) const
+    {
+        return Dump_Column<T>(d_data + offset, record_bytes, records(record_bytes));
+    }
+
+private:
+    const char* d_data;
+    size_t d_size;
+};
+
+#endif  //GNSS_SDR_DUMP_FILE_MAP_H
@@ -29,38 +29,48 @@
  */
 
 #include "observables_dump_reader.h"
+#include <cstring>
 #include <iostream>
 #include <utility>
 
 bool observables_dump_reader::read_binary_obs()
 {
-    try
+    if (!read_epoch(d_next_epoch))
         {
-            for (int i = 0; i < n_channels; i++)
-                {
-                    d_dump_file.read(reinterpret_cast<char *>(&RX_time[i]), sizeof(double));
-                    d_dump_file.read(reinterpret_cast<char *>(&TOW_at_current_symbol_s[i]), sizeof(double));
-                    d_dump_file.read(reinterpret_cast<char *>(&Carrier_Doppler_hz[i]), sizeof(double));
-                    d_dump_file.read(reinterpret_cast<char *>(&Acc_carrier_phase_hz[i]), sizeof(double));
-                    d_dump_file.read(reinterpret_cast<char *>(&Pseudorange_m[i]), sizeof(double));
-                    d_dump_file.read(reinterpret_cast<char *>(&PRN[i]), sizeof(double));
-                    d_dump_file.read(reinterpret_cast<char *>(&valid[i]), sizeof(double));
-                }
+            return false;
         }
-    catch (const std::ifstream::failure &e)
+    d_next_epoch++;
+    return true;
+}
+
+
+bool observables_dump_reader::read_epoch(int64_t epoch)
+{
+    if (epoch < 0 or epoch >= num_epochs())
         {
             return false;
         }
+    const char *record = d_dump_map.data() + epoch * CHANNEL_SIZE_BYTES * n_channels;
+    for (int i = 0; i < n_channels; i++)
+        {
+            std::memcpy(&RX_time[i], record + RX_TIME, sizeof(double));
+            std::memcpy(&TOW_at_current_symbol_s[i], record + TOW_AT_CURRENT_SYMBOL_S, sizeof(double));
+            std::memcpy(&Carrier_Doppler_hz[i], record + CARRIER_DOPPLER_HZ, sizeof(double));
+            std::memcpy(&Acc_carrier_phase_hz[i], record + ACC_CARRIER_PHASE_HZ, sizeof(double));
+            std::memcpy(&Pseudorange_m[i], record + PSEUDORANGE_M, sizeof(double));
+            std::memcpy(&PRN[i], record + PRN_NUMBER, sizeof(double));
+            std::memcpy(&valid[i], record + VALID, sizeof(double));
+            record += CHANNEL_SIZE_BYTES;
+        }
     return true;
 }
 
 
 bool observables_dump_reader::restart()
 {
-    if (d_dump_file.is_open())
+    if (d_dump_map.is_open())
         {
-            d_dump_file.clear();
-            d_dump_file.seekg(0, std::ios::beg);
+            d_next_epoch = 0;
             return true;
         }
     return false;
@@ -69,36 +79,22 @@ bool observables_dump_reader::restart()
 
 int64_t observables_dump_reader::num_epochs()
 {
-    std::ifstream::pos_type size;
-    int number_of_vars_in_epoch = n_channels * 7;
-    int epoch_size_bytes = sizeof(double) * number_of_vars_in_epoch;
-    std::ifstream tmpfile(d_dump_filename.c_str(), std::ios::binary | std::ios::ate);
-    if (tmpfile.is_open())
-        {
-            size = tmpfile.tellg();
-            int64_t nepoch = size / epoch_size_bytes;
-            return nepoch;
-        }
-    return 0;
+    return static_cast<int64_t>(d_dump_map.records(CHANNEL_SIZE_BYTES * n_channels));
 }
 
 
 bool observables_dump_reader::open_obs_file(std::string out_file)
 {
-    if (d_dump_file.is_open() == false)
+    if (d_dump_map.is_open() == false)
         {
-            try
+            d_dump_filename = std::move(out_file);
+            if (!d_dump_map.open(d_dump_filename))
                 {
-                    d_dump_filename = std::move(out_file);
-                    d_dump_file.exceptions(std::ifstream::failbit | std::ifstream::badbit);
-                    d_dump_file.open(d_dump_filename.c_str(), std::ios::in | std::ios::binary);
-                    return true;
-                }
-            catch (const std::ifstream::failure &e)
-                {
-                    std::cout << "Problem opening TLM dump Log file: " << d_dump_filename.c_str() << std::endl;
+                    std::cout << "Problem opening Observables dump Log file: " << d_dump_filename.c_str() << std::endl;
                     return false;
                 }
+            d_next_epoch = 0;
+            return true;
         }
     else
         {
@@ -108,15 +104,14 @@ bool observables_dump_reader::open_obs_file(std::string out_file)
 
 void observables_dump_reader::close_obs_file()
 {
-    if (d_dump_file.is_open() == false)
-        {
-            d_dump_file.close();
-        }
+    d_dump_map.close();
+    d_next_epoch = 0;
 }
 
 observables_dump_reader::observables_dump_reader(int n_channels_)
 {
     n_channels = n_channels_;
+    d_next_epoch = 0;
     RX_time = new double[n_channels];
     TOW_at_current_symbol_s = new double[n_channels];
     Carrier_Doppler_hz = new double[n_channels];
@@ -129,10 +124,7 @@ observables_dump_reader::observables_dump_reader(int n_channels_)
 
 observables_dump_reader::~observables_dump_reader()
 {
-    if (d_dump_file.is_open() == true)
-        {
-            d_dump_file.close();
-        }
+    close_obs_file();
     delete[] RX_time;
     delete[] TOW_at_current_symbol_s;
     delete[] Carrier_Doppler_hz;
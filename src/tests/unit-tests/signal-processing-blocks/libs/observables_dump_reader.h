@@ -31,22 +31,43 @@
 #ifndef GNSS_SDR_OBSERVABLES_DUMP_READER_H
 #define GNSS_SDR_OBSERVABLES_DUMP_READER_H
 
+#include "dump_file_map.h"
+#include <cstddef>
 #include <cstdint>
-#include <fstream>
 #include <string>
 #include <vector>
 
 class observables_dump_reader
 {
 public:
+    //! Byte offsets of the fields in the group of each channel
+    enum Field_Offset : size_t
+    {
+        RX_TIME = 0,
+        TOW_AT_CURRENT_SYMBOL_S = 8,
+        CARRIER_DOPPLER_HZ = 16,
+        ACC_CARRIER_PHASE_HZ = 24,
+        PSEUDORANGE_M = 32,
+        PRN_NUMBER = 40,
+        VALID = 48,
+        CHANNEL_SIZE_BYTES = 56
+    };
+
     observables_dump_reader(int n_channels);
     ~observables_dump_reader();
     bool read_binary_obs();
+    bool read_epoch(int64_t epoch);  //!< Loads the dump variables of any epoch, without reading the previous ones
     bool restart();
     int64_t num_epochs();
     bool open_obs_file(std::string out_file);
     void close_obs_file();
 
+    //! All the values of one field of a channel, e.g. column(2, PSEUDORANGE_M)
+    Dump_Column<double> column(int channel, Field_Offset offset) const
+    {
+        return d_dump_map.column<double>(CHANNEL_SIZE_BYTES * n_channels, CHANNEL_SIZE_BYTES * channel + offset);
+    }
+
 
     //dump variables
 
@@ -61,7 +82,9 @@ public:
 private:
     int n_channels;
     std::string d_dump_filename;
-    std::ifstream d_dump_file;
+    // the dump file is memory-mapped, so that long recordings are paged in on demand
+    Dump_File_Map d_dump_map;
+    int64_t d_next_epoch;
 };
 
 #endif  //GNSS_SDR_OBSERVABLES_DUMP_READER_H
@@ -29,31 +29,40 @@
  */
 
 #include "tlm_dump_reader.h"
+#include <cstring>
 #include <iostream>
 #include <utility>
 
 bool tlm_dump_reader::read_binary_obs()
 {
-    try
+    if (!read_epoch(d_next_epoch))
         {
-            d_dump_file.read(reinterpret_cast<char *>(&TOW_at_current_symbol), sizeof(double));
-            d_dump_file.read(reinterpret_cast<char *>(&Tracking_sample_counter), sizeof(uint64_t));
-            d_dump_file.read(reinterpret_cast<char *>(&d_TOW_at_Preamble), sizeof(double));
+            return false;
         }
-    catch (const std::ifstream::failure &e)
+    d_next_epoch++;
+    return true;
+}
+
+
+bool tlm_dump_reader::read_epoch(int64_t epoch)
+{
+    if (epoch < 0 or epoch >= num_epochs())
         {
             return false;
         }
+    const char *record = d_dump_map.data() + epoch * EPOCH_SIZE_BYTES;
+    std::memcpy(&TOW_at_current_symbol, record + TOW_AT_CURRENT_SYMBOL, sizeof(double));
+    std::memcpy(&Tracking_sample_counter, record + TRACKING_SAMPLE_COUNTER, sizeof(uint64_t));
+    std::memcpy(&d_TOW_at_Preamble, record + TOW_AT_PREAMBLE, sizeof(double));
     return true;
 }
 
 
 bool tlm_dump_reader::restart()
 {
-    if (d_dump_file.is_open())
+    if (d_dump_map.is_open())
         {
-            d_dump_file.clear();
-            d_dump_file.seekg(0, std::ios::beg);
+            d_next_epoch = 0;
             return true;
         }
     return false;
@@ -62,49 +71,26 @@ bool tlm_dump_reader::restart()
 
 int64_t tlm_dump_reader::num_epochs()
 {
-    std::ifstream::pos_type size;
-    int number_of_vars_in_epoch = 2;
-    int epoch_size_bytes = sizeof(double) * number_of_vars_in_epoch + sizeof(uint64_t);
-    std::ifstream tmpfile(d_dump_filename.c_str(), std::ios::binary | std::ios::ate);
-    if (tmpfile.is_open())
-        {
-            size = tmpfile.tellg();
-            int64_t nepoch = size / epoch_size_bytes;
-            return nepoch;
-        }
-    return 0;
+    return static_cast<int64_t>(d_dump_map.records(EPOCH_SIZE_BYTES));
 }
 
 
 bool tlm_dump_reader::open_obs_file(std::string out_file)
 {
-    if (d_dump_file.is_open() == false)
+    if (d_dump_map.is_open() == false)
         {
-            try
-                {
-                    d_dump_filename = std::move(out_file);
-                    d_dump_file.exceptions(std::ifstream::failbit | std::ifstream::badbit);
-                    d_dump_file.open(d_dump_filename.c_str(), std::ios::in | std::ios::binary);
-                    std::cout << "TLM dump enabled, Log file: " << d_dump_filename.c_str() << std::endl;
-                    return true;
-                }
-            catch (const std::ifstream::failure &e)
+            d_dump_filename = std::move(out_file);
+            if (!d_dump_map.open(d_dump_filename))
                 {
                     std::cout << "Problem opening TLM dump Log file: " << d_dump_filename.c_str() << std::endl;
                     return false;
                 }
+            d_next_epoch = 0;
+            std::cout << "TLM dump enabled, Log file: " << d_dump_filename.c_str() << std::endl;
+            return true;
         }
     else
         {
             return false;
         }
 }
-
-
-tlm_dump_reader::~tlm_dump_reader()
-{
-    if (d_dump_file.is_open() == true)
-        {
-            d_dump_file.close();
-        }
-}
@@ -31,20 +31,37 @@
 #ifndef GNSS_SDR_TLM_DUMP_READER_H
 #define GNSS_SDR_TLM_DUMP_READER_H
 
+#include "dump_file_map.h"
+#include <cstddef>
 #include <cstdint>
-#include <fstream>
 #include <string>
 #include <vector>
 
 class tlm_dump_reader
 {
 public:
-    ~tlm_dump_reader();
+    //! Byte offsets of the fields in each record
+    enum Field_Offset : size_t
+    {
+        TOW_AT_CURRENT_SYMBOL = 0,
+        TRACKING_SAMPLE_COUNTER = 8,
+        TOW_AT_PREAMBLE = 16,
+        EPOCH_SIZE_BYTES = 24
+    };
+
     bool read_binary_obs();
+    bool read_epoch(int64_t epoch);  //!< Loads the dump variables of any epoch, without reading the previous ones
     bool restart();
     int64_t num_epochs();
     bool open_obs_file(std::string out_file);
 
+    //! All the values of one field, e.g. column<double>(TOW_AT_CURRENT_SYMBOL)
+    template <typename T>
+    Dump_Column<T> column(Field_Offset offset) const
+    {
+        return d_dump_map.column<T>(EPOCH_SIZE_BYTES, offset);
+    }
+
     //telemetry decoder dump variables
     double TOW_at_current_symbol;
     uint64_t Tracking_sample_counter;
@@ -52,7 +69,9 @@ public:
 
 private:
     std::string d_dump_filename;
-    std::ifstream d_dump_file;
+    // the dump file is memory-mapped, so that long recordings are paged in on demand
+    Dump_File_Map d_dump_map;
+    int64_t d_next_epoch = 0;
 };
 
 #endif  //GNSS_SDR_TLM_DUMP_READER_H
@@ -29,50 +29,59 @@
  */
 
 #include "tracking_dump_reader.h"
+#include <cstring>
 #include <iostream>
 #include <utility>
 
 bool tracking_dump_reader::read_binary_obs()
 {
-    try
+    if (!read_epoch(d_next_epoch))
         {
-            d_dump_file.read(reinterpret_cast<char *>(&abs_VE), sizeof(float));
-            d_dump_file.read(reinterpret_cast<char *>(&abs_E), sizeof(float));
-            d_dump_file.read(reinterpret_cast<char *>(&abs_P), sizeof(float));
-            d_dump_file.read(reinterpret_cast<char *>(&abs_L), sizeof(float));
-            d_dump_file.read(reinterpret_cast<char *>(&abs_VL), sizeof(float));
-            d_dump_file.read(reinterpret_cast<char *>(&prompt_I), sizeof(float));
-            d_dump_file.read(reinterpret_cast<char *>(&prompt_Q), sizeof(float));
-            d_dump_file.read(reinterpret_cast<char *>(&PRN_start_sample_count), sizeof(uint64_t));
-            d_dump_file.read(reinterpret_cast<char *>(&acc_carrier_phase_rad), sizeof(float));
-            d_dump_file.read(reinterpret_cast<char *>(&carrier_doppler_hz), sizeof(float));
-            d_dump_file.read(reinterpret_cast<char *>(&carrier_doppler_rate_hz_s), sizeof(float));
-            d_dump_file.read(reinterpret_cast<char *>(&code_freq_chips), sizeof(float));
-            d_dump_file.read(reinterpret_cast<char *>(&code_freq_rate_chips), sizeof(float));
-            d_dump_file.read(reinterpret_cast<char *>(&carr_error_hz), sizeof(float));
-            d_dump_file.read(reinterpret_cast<char *>(&carr_error_filt_hz), sizeof(float));
-            d_dump_file.read(reinterpret_cast<char *>(&code_error_chips), sizeof(float));
-            d_dump_file.read(reinterpret_cast<char *>(&code_error_filt_chips), sizeof(float));
-            d_dump_file.read(reinterpret_cast<char *>(&CN0_SNV_dB_Hz), sizeof(float));
-            d_dump_file.read(reinterpret_cast<char *>(&carrier_lock_test), sizeof(float));
-            d_dump_file.read(reinterpret_cast<char *>(&aux1), sizeof(float));
-            d_dump_file.read(reinterpret_cast<char *>(&aux2), sizeof(double));
-            d_dump_file.read(reinterpret_cast<char *>(&PRN), sizeof(unsigned int));
+            return false;
         }
-    catch (const std::ifstream::failure &e)
+    d_next_epoch++;
+    return true;
+}
+
+
+bool tracking_dump_reader::read_epoch(int64_t epoch)
+{
+    if (epoch < 0 or epoch >= num_epochs())
         {
             return false;
         }
+    const char *record = d_dump_map.data() + epoch * EPOCH_SIZE_BYTES;
+    std::memcpy(&abs_VE, record + ABS_VE, sizeof(float));
+    std::memcpy(&abs_E, record + ABS_E, sizeof(float));
+    std::memcpy(&abs_P, record + ABS_P, sizeof(float));
+    std::memcpy(&abs_L, record + ABS_L, sizeof(float));
+    std::memcpy(&abs_VL, record + ABS_VL, sizeof(float));
+    std::memcpy(&prompt_I, record + PROMPT_I, sizeof(float));
+    std::memcpy(&prompt_Q, record + PROMPT_Q, sizeof(float));
+    std::memcpy(&PRN_start_sample_count, record + PRN_START_SAMPLE_COUNT, sizeof(uint64_t));
+    std::memcpy(&acc_carrier_phase_rad, record + ACC_CARRIER_PHASE_RAD, sizeof(float));
+    std::memcpy(&carrier_doppler_hz, record + CARRIER_DOPPLER_HZ, sizeof(float));
+    std::memcpy(&carrier_doppler_rate_hz_s, record + CARRIER_DOPPLER_RATE_HZ_S, sizeof(float));
+    std::memcpy(&code_freq_chips, record + CODE_FREQ_CHIPS, sizeof(float));
+    std::memcpy(&code_freq_rate_chips, record + CODE_FREQ_RATE_CHIPS, sizeof(float));
+    std::memcpy(&carr_error_hz, record + CARR_ERROR_HZ, sizeof(float));
+    std::memcpy(&carr_error_filt_hz, record + CARR_ERROR_FILT_HZ, sizeof(float));
+    std::memcpy(&code_error_chips, record + CODE_ERROR_CHIPS, sizeof(float));
+    std::memcpy(&code_error_filt_chips, record + CODE_ERROR_FILT_CHIPS, sizeof(float));
+    std::memcpy(&CN0_SNV_dB_Hz, record + CN0_SNV_DB_HZ, sizeof(float));
+    std::memcpy(&carrier_lock_test, record + CARRIER_LOCK_TEST, sizeof(float));
+    std::memcpy(&aux1, record + AUX1, sizeof(float));
+    std::memcpy(&aux2, record + AUX2, sizeof(double));
+    std::memcpy(&PRN, record + PRN_NUMBER, sizeof(unsigned int));
     return true;
 }
 
 
 bool tracking_dump_reader::restart()
 {
-    if (d_dump_file.is_open())
+    if (d_dump_map.is_open())
         {
-            d_dump_file.clear();
-            d_dump_file.seekg(0, std::ios::beg);
+            d_next_epoch = 0;
             return true;
         }
     return false;
@@ -81,52 +90,25 @@ bool tracking_dump_reader::restart()
 
 int64_t tracking_dump_reader::num_epochs()
 {
-    std::ifstream::pos_type size;
-    int number_of_double_vars = 1;
-    int number_of_float_vars = 19;
-    int epoch_size_bytes = sizeof(uint64_t) + sizeof(double) * number_of_double_vars +
-                           sizeof(float) * number_of_float_vars + sizeof(unsigned int);
-    std::ifstream tmpfile(d_dump_filename.c_str(), std::ios::binary | std::ios::ate);
-    if (tmpfile.is_open())
-        {
-            size = tmpfile.tellg();
-            int64_t nepoch = size / epoch_size_bytes;
-            return nepoch;
-        }
-
-
-    return 0;
+    return static_cast<int64_t>(d_dump_map.records(EPOCH_SIZE_BYTES));
 }
 
 
 bool tracking_dump_reader::open_obs_file(std::string out_file)
 {
-    if (d_dump_file.is_open() == false)
+    if (d_dump_map.is_open() == false)
         {
-            try
-                {
-                    d_dump_filename = std::move(out_file);
-                    d_dump_file.exceptions(std::ifstream::failbit | std::ifstream::badbit);
-                    d_dump_file.open(d_dump_filename.c_str(), std::ios::in | std::ios::binary);
-                    return true;
-                }
-            catch (const std::ifstream::failure &e)
+            d_dump_filename = std::move(out_file);
+            if (!d_dump_map.open(d_dump_filename))
                 {
                     std::cout << "Problem opening Tracking dump Log file: " << d_dump_filename.c_str() << std::endl;
                     return false;
                 }
+            d_next_epoch = 0;
+            return true;
         }
     else
         {
             return false;
         }
 }
-
-
-tracking_dump_reader::~tracking_dump_reader()
-{
-    if (d_dump_file.is_open() == true)
-        {
-            d_dump_file.close();
-        }
-}
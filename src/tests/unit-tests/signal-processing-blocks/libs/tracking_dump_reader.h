@@ -31,20 +31,56 @@
 #ifndef GNSS_SDR_TRACKING_DUMP_READER_H
 #define GNSS_SDR_TRACKING_DUMP_READER_H
 
+#include "dump_file_map.h"
+#include <cstddef>
 #include <cstdint>
-#include <fstream>
 #include <string>
 #include <vector>
 
 class tracking_dump_reader
 {
 public:
-    ~tracking_dump_reader();
+    //! Byte offsets of the fields in each record
+    enum Field_Offset : size_t
+    {
+        ABS_VE = 0,
+        ABS_E = 4,
+        ABS_P = 8,
+        ABS_L = 12,
+        ABS_VL = 16,
+        PROMPT_I = 20,
+        PROMPT_Q = 24,
+        PRN_START_SAMPLE_COUNT = 28,
+        ACC_CARRIER_PHASE_RAD = 36,
+        CARRIER_DOPPLER_HZ = 40,
+        CARRIER_DOPPLER_RATE_HZ_S = 44,
+        CODE_FREQ_CHIPS = 48,
+        CODE_FREQ_RATE_CHIPS = 52,
+        CARR_ERROR_HZ = 56,
+        CARR_ERROR_FILT_HZ = 60,
+        CODE_ERROR_CHIPS = 64,
+        CODE_ERROR_FILT_CHIPS = 68,
+        CN0_SNV_DB_HZ = 72,
+        CARRIER_LOCK_TEST = 76,
+        AUX1 = 80,
+        AUX2 = 84,
+        PRN_NUMBER = 92,
+        EPOCH_SIZE_BYTES = 96
+    };
+
     bool read_binary_obs();
+    bool read_epoch(int64_t epoch);  //!< Loads the dump variables of any epoch, without reading the previous ones
     bool restart();
     int64_t num_epochs();
     bool open_obs_file(std::string out_file);
 
+    //! All the values of one field, e.g. column<float>(CN0_SNV_DB_HZ)
+    template <typename T>
+    Dump_Column<T> column(Field_Offset offset) const
+    {
+        return d_dump_map.column<T>(EPOCH_SIZE_BYTES, offset);
+    }
+
     //tracking dump variables
     // VEPLVL
     float abs_VE;
@@ -87,7 +123,9 @@ public:
 
 private:
     std::string d_dump_filename;
-    std::ifstream d_dump_file;
+    // the dump file is memory-mapped, so that long recordings are paged in on demand
+    Dump_File_Map d_dump_map;
+    int64_t d_next_epoch = 0;
 };
 
 #endif  //GNSS_SDR_TRACKING_DUMP_READER_H
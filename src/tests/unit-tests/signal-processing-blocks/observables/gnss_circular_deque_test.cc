@@ -0,0 +1,184 @@
+/*!
+ * \file gnss_circular_deque_test.cc
+ * \brief  This file implements unit tests for the Gnss_circular_deque class.
+ *
+ *
+ * -------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2019  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *          Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------
+ */
+
+#include "gnss_circular_deque.h"
+#include <gtest/gtest.h>
+#include <deque>
+#include <vector>
+
+
+namespace
+{
+// Checks size, front, back, at() and the contiguous contents of a channel against a reference deque
+void expect_channel(const Gnss_circular_deque<int>& deque, unsigned int ch, const std::deque<int>& reference)
+{
+    ASSERT_EQ(reference.size(), deque.size(ch)) << "channel " << ch;
+    if (reference.empty())
+        {
+            return;
+        }
+    EXPECT_EQ(reference.front(), deque.front(ch)) << "channel " << ch;
+    EXPECT_EQ(reference.back(), deque.back(ch)) << "channel " << ch;
+    const int* data = deque.data(ch);
+    for (unsigned int i = 0; i < reference.size(); i++)
+        {
+            EXPECT_EQ(reference[i], data[i]) << "channel " << ch << ", element " << i;
+            EXPECT_EQ(reference[i], deque.at(ch, i)) << "channel " << ch << ", element " << i;
+        }
+}
+
+
+void push(Gnss_circular_deque<int>& deque, std::deque<int>& reference, unsigned int ch, unsigned int max_size, int value)
+{
+    deque.push_back(ch, value);
+    reference.push_back(value);
+    if (reference.size() > max_size)
+        {
+            reference.pop_front();
+        }
+}
+}  // namespace
+
+
+TEST(GnssCircularDequeTest, PushPastCapacity)
+{
+    // A capacity that is not a power of two, and one that is
+    for (unsigned int max_size : {5U, 8U})
+        {
+            Gnss_circular_deque<int> deque(max_size, 1);
+            std::deque<int> reference;
+            expect_channel(deque, 0, reference);
+            // Several turns of the storage, so the mirrored reads cross the wrap point at every index
+            for (int n = 0; n < 40; n++)
+                {
+                    push(deque, reference, 0, max_size, n);
+                    expect_channel(deque, 0, reference);
+                }
+        }
+}
+
+
+TEST(GnssCircularDequeTest, PopFrontAtTheWrapPoint)
+{
+    const unsigned int max_size = 6;
+    Gnss_circular_deque<int> deque(max_size, 1);
+    std::deque<int> reference;
+    for (int n = 0; n < 11; n++)
+        {
+            push(deque, reference, 0, max_size, n);
+        }
+    for (int n = 0; n < 4; n++)
+        {
+            deque.pop_front(0);
+            reference.pop_front();
+            expect_channel(deque, 0, reference);
+        }
+    // Refill a partially empty channel across the end of the storage
+    for (int n = 11; n < 20; n++)
+        {
+            push(deque, reference, 0, max_size, n);
+            expect_channel(deque, 0, reference);
+        }
+    while (!reference.empty())
+        {
+            deque.pop_front(0);
+            reference.pop_front();
+        }
+    expect_channel(deque, 0, reference);
+    deque.pop_front(0);
+    EXPECT_EQ(0U, deque.size(0));
+}
+
+
+TEST(GnssCircularDequeTest, Clear)
+{
+    const unsigned int max_size = 4;
+    Gnss_circular_deque<int> deque(max_size, 2);
+    std::deque<int> reference;
+    for (int n = 0; n < 7; n++)
+        {
+            deque.push_back(0, n);
+            deque.push_back(1, 100 + n);
+        }
+    deque.clear(0);
+    expect_channel(deque, 0, reference);
+    EXPECT_EQ(max_size, deque.size(1));
+    for (int n = 10; n < 16; n++)
+        {
+            push(deque, reference, 0, max_size, n);
+            expect_channel(deque, 0, reference);
+        }
+
+    // reset() empties all the channels and sets a new capacity
+    deque.reset(3, 2);
+    reference.clear();
+    expect_channel(deque, 0, reference);
+    expect_channel(deque, 1, reference);
+    for (int n = 0; n < 5; n++)
+        {
+            push(deque, reference, 1, 3, n);
+        }
+    expect_channel(deque, 1, reference);
+}
+
+
+TEST(GnssCircularDequeTest, ChannelsAreIndependent)
+{
+    const unsigned int max_size = 5;
+    const unsigned int nchann = 4;
+    Gnss_circular_deque<int> deque(max_size, nchann);
+    std::vector<std::deque<int>> reference(nchann);
+    // Each channel gets a different number of elements, so they wrap at different times
+    for (int n = 0; n < 30; n++)
+        {
+            for (unsigned int ch = 0; ch < nchann; ch++)
+                {
+                    if (n % (ch + 1) == 0)
+                        {
+                            push(deque, reference[ch], ch, max_size, 1000 * static_cast<int>(ch) + n);
+                        }
+                }
+            if (n % 7 == 6)
+                {
+                    deque.pop_front(2);
+                    reference[2].pop_front();
+                }
+            for (unsigned int ch = 0; ch < nchann; ch++)
+                {
+                    expect_channel(deque, ch, reference[ch]);
+                }
+        }
+    deque.clear(1);
+    reference[1].clear();
+    for (unsigned int ch = 0; ch < nchann; ch++)
+        {
+            expect_channel(deque, ch, reference[ch]);
+        }
+}
@@ -31,6 +31,8 @@
 
 #include "Galileo_E1.h"
 #include "rtcm.h"
+#include "rtcm_bit_writer.h"
+#include <algorithm>
 #include <memory>
 #include <thread>
 
@@ -185,6 +187,38 @@ TEST(RtcmTest, CheckCRC)
 }
 
 
+TEST(RtcmTest, BitWriter)
+{
+    auto rtcm = std::make_shared<Rtcm>();
+    std::string reference_bin = rtcm->hex_to_bin("D300133ED7D30202980EDEEF34B4BD62AC0941986F33360B98");
+    std::string reference_msg = rtcm->bin_to_binary_data(reference_bin);
+    std::string payload = reference_bin.substr(24, reference_bin.length() - 48);
+
+    // Fields of uneven lengths, crossing byte boundaries
+    Rtcm_Bit_Writer writer;
+    uint32_t index = 0;
+    while (index < payload.length())
+        {
+            uint32_t n_bits = std::min<uint32_t>(13, payload.length() - index);
+            writer.put(rtcm->bin_to_uint(payload.substr(index, n_bits)), n_bits);
+            index += n_bits;
+        }
+    EXPECT_EQ(payload.length(), writer.size_bits());
+    EXPECT_EQ(0, reference_msg.compare(writer.frame()));
+
+    writer.clear();
+    writer.put_bits(payload);
+    EXPECT_EQ(0, reference_msg.compare(writer.frame()));
+
+    // The CRC-24Q of a frame followed by its own parity is zero
+    const auto* bytes = reinterpret_cast<const uint8_t*>(reference_msg.data());
+    uint32_t crc = rtcm_crc24q(0, bytes, 10);
+    crc = rtcm_crc24q(crc, bytes + 10, reference_msg.length() - 10);
+    EXPECT_EQ(0U, crc);
+    EXPECT_EQ(true, rtcm->check_CRC(writer.frame()));
+}
+
+
 TEST(RtcmTest, MT1001)
 {
     auto rtcm = std::make_shared<Rtcm>();
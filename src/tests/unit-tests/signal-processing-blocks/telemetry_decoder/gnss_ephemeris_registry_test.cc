@@ -0,0 +1,179 @@
+/*!
+ * \file gnss_ephemeris_registry_test.cc
+ * \brief  This file implements unit tests for the Gnss_Ephemeris_Registry class.
+ *
+ *
+ * -------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2019  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *          Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------
+ */
+
+#include "gnss_ephemeris_registry.h"
+#include <gtest/gtest.h>
+#include <atomic>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+
+TEST(GnssEphemerisRegistryTest, PublishesEachIssueOnce)
+{
+    Gnss_Ephemeris_Registry registry;
+    EXPECT_TRUE(registry.is_new(Gnss_Ephemeris_Registry::GPS_LNAV, 5, 0));
+    EXPECT_FALSE(registry.is_new(Gnss_Ephemeris_Registry::GPS_LNAV, 5, 0));
+    EXPECT_TRUE(registry.is_new(Gnss_Ephemeris_Registry::GPS_LNAV, 5, 1));
+    EXPECT_FALSE(registry.is_new(Gnss_Ephemeris_Registry::GPS_LNAV, 5, 1));
+    // Going back to a previous issue is a new upload too
+    EXPECT_TRUE(registry.is_new(Gnss_Ephemeris_Registry::GPS_LNAV, 5, 0));
+
+    // Other satellites and navigation messages keep their own issues
+    EXPECT_TRUE(registry.is_new(Gnss_Ephemeris_Registry::GPS_LNAV, 6, 0));
+    EXPECT_TRUE(registry.is_new(Gnss_Ephemeris_Registry::GALILEO_INAV, 5, 0));
+    EXPECT_TRUE(registry.is_new(Gnss_Ephemeris_Registry::GALILEO_FNAV, 5, 0));
+    EXPECT_FALSE(registry.is_new(Gnss_Ephemeris_Registry::GALILEO_INAV, 5, 0));
+
+    registry.clear();
+    EXPECT_TRUE(registry.is_new(Gnss_Ephemeris_Registry::GPS_LNAV, 5, 0));
+    EXPECT_TRUE(registry.is_new(Gnss_Ephemeris_Registry::GALILEO_INAV, 5, 0));
+}
+
+
+TEST(GnssEphemerisRegistryTest, PrnBounds)
+{
+    Gnss_Ephemeris_Registry registry;
+    EXPECT_TRUE(registry.is_new(Gnss_Ephemeris_Registry::GLONASS_GNAV, 63, 7));
+    EXPECT_FALSE(registry.is_new(Gnss_Ephemeris_Registry::GLONASS_GNAV, 63, 7));
+    // PRNs out of the table are not recorded: they are always published, and they do not touch the others
+    for (uint32_t prn : {64U, 65U, 1000U})
+        {
+            EXPECT_TRUE(registry.is_new(Gnss_Ephemeris_Registry::GLONASS_GNAV, prn, 7));
+            EXPECT_TRUE(registry.is_new(Gnss_Ephemeris_Registry::GLONASS_GNAV, prn, 7));
+        }
+    EXPECT_FALSE(registry.is_new(Gnss_Ephemeris_Registry::GLONASS_GNAV, 63, 7));
+    EXPECT_TRUE(registry.is_new(Gnss_Ephemeris_Registry::GPS_CNAV, 0, 7));
+}
+
+
+TEST(GnssEphemerisRegistryTest, Ephemerides)
+{
+    Gnss_Ephemeris_Registry registry;
+    Gps_Ephemeris gps_eph;
+    gps_eph.i_satellite_PRN = 12;
+    gps_eph.d_Toe = 345600;
+    gps_eph.d_IODC = 71;
+    gps_eph.d_IODE_SF2 = 71;
+    gps_eph.d_IODE_SF3 = 71;
+    EXPECT_TRUE(registry.is_new(gps_eph));
+    EXPECT_FALSE(registry.is_new(gps_eph));
+    // A cutover between subframes 2 and 3 is a different issue
+    gps_eph.d_IODE_SF3 = 72;
+    EXPECT_TRUE(registry.is_new(gps_eph));
+
+    Galileo_Ephemeris galileo_eph;
+    galileo_eph.i_satellite_PRN = 12;
+    galileo_eph.t0e_1 = 5760;
+    galileo_eph.IOD_ephemeris = 100;
+    EXPECT_TRUE(registry.is_new(galileo_eph, Gnss_Ephemeris_Registry::GALILEO_INAV));
+    EXPECT_FALSE(registry.is_new(galileo_eph, Gnss_Ephemeris_Registry::GALILEO_INAV));
+    EXPECT_TRUE(registry.is_new(galileo_eph, Gnss_Ephemeris_Registry::GALILEO_FNAV));
+    galileo_eph.IOD_ephemeris = 101;
+    EXPECT_TRUE(registry.is_new(galileo_eph, Gnss_Ephemeris_Registry::GALILEO_INAV));
+}
+
+
+TEST(GnssEphemerisRegistryTest, ConcurrentChannels)
+{
+    // Channels decoding the same satellites race to publish each issue: only one of them may win
+    Gnss_Ephemeris_Registry registry;
+    const uint32_t channels = 8;
+    const uint32_t prns = 64;
+    const uint64_t issues = 50;
+    std::vector<std::atomic<uint32_t>> published(prns * issues);
+    for (auto& count : published)
+        {
+            count.store(0);
+        }
+    std::atomic<bool> start(false);
+    std::vector<std::thread> threads;
+    for (uint32_t ch = 0; ch < channels; ch++)
+        {
+            threads.emplace_back([&registry, &published, &start, ch, prns, issues]() {
+                while (!start.load())
+                    {
+                        std::this_thread::yield();
+                    }
+                for (uint64_t issue = 0; issue < issues; issue++)
+                    {
+                        for (uint32_t n = 0; n < prns; n++)
+                            {
+                                // each channel walks the satellites in a different order
+                                uint32_t prn = (n + ch * 7) % prns;
+                                if (registry.is_new(Gnss_Ephemeris_Registry::GALILEO_INAV, prn, issue))
+                                    {
+                                        published[prn * issues + issue]++;
+                                    }
+                            }
+                    }
+            });
+        }
+    start.store(true);
+    for (auto& thread : threads)
+        {
+            thread.join();
+        }
+    // A channel can see a newer issue already recorded by a faster one, and then
+    // republish an older one, so each issue is published at least once
+    uint32_t total = 0;
+    for (uint32_t prn = 0; prn < prns; prn++)
+        {
+            for (uint64_t issue = 0; issue < issues; issue++)
+                {
+                    EXPECT_GE(published[prn * issues + issue].load(), 1U) << "PRN " << prn << ", issue " << issue;
+                    total += published[prn * issues + issue].load();
+                }
+            // The last issue stays recorded
+            EXPECT_FALSE(registry.is_new(Gnss_Ephemeris_Registry::GALILEO_INAV, prn, issues - 1));
+        }
+    EXPECT_GE(total, prns * issues);
+
+    // All the channels decode the same issue at once: exactly one publishes it
+    for (uint32_t round = 0; round < 20; round++)
+        {
+            std::atomic<uint32_t> winners(0);
+            threads.clear();
+            for (uint32_t ch = 0; ch < channels; ch++)
+                {
+                    threads.emplace_back([&registry, &winners, round]() {
+                        if (registry.is_new(Gnss_Ephemeris_Registry::GPS_LNAV, 17, 1000 + round))
+                            {
+                                winners++;
+                            }
+                    });
+                }
+            for (auto& thread : threads)
+                {
+                    thread.join();
+                }
+            EXPECT_EQ(1U, winners.load()) << "round " << round;
+        }
+}
@@ -0,0 +1,162 @@
+/*!
+ * \file linear_ring_buffer_test.cc
+ * \brief  This file implements unit tests for the Linear_Ring_Buffer class.
+ *
+ *
+ * -------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2019  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *          Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------
+ */
+
+#include "linear_ring_buffer.h"
+#include <gtest/gtest.h>
+#include <deque>
+
+
+namespace
+{
+// Checks size, front, back and the contiguous contents against a reference deque
+void expect_contents(const Linear_Ring_Buffer<int>& buffer, const std::deque<int>& reference)
+{
+    ASSERT_EQ(reference.size(), buffer.size());
+    EXPECT_EQ(reference.empty(), buffer.empty());
+    if (reference.empty())
+        {
+            return;
+        }
+    EXPECT_EQ(reference.front(), buffer.front());
+    EXPECT_EQ(reference.back(), buffer.back());
+    const int* data = buffer.data();
+    for (size_t i = 0; i < reference.size(); i++)
+        {
+            EXPECT_EQ(reference[i], data[i]) << "element " << i;
+            EXPECT_EQ(reference[i], buffer[i]) << "element " << i;
+        }
+}
+}  // namespace
+
+
+TEST(LinearRingBufferTest, WrapAround)
+{
+    const size_t capacity = 7;
+    Linear_Ring_Buffer<int> buffer(capacity);
+    std::deque<int> reference;
+    EXPECT_EQ(capacity, buffer.capacity());
+    EXPECT_TRUE(buffer.empty());
+    EXPECT_FALSE(buffer.full());
+    // Several turns of the storage, so the oldest element is read at every storage index
+    for (int n = 0; n < 5 * static_cast<int>(capacity) + 3; n++)
+        {
+            buffer.push_back(n);
+            reference.push_back(n);
+            if (reference.size() > capacity)
+                {
+                    reference.pop_front();
+                }
+            EXPECT_EQ(reference.size() == capacity, buffer.full());
+            expect_contents(buffer, reference);
+        }
+}
+
+
+TEST(LinearRingBufferTest, PopFront)
+{
+    const size_t capacity = 5;
+    Linear_Ring_Buffer<int> buffer(capacity);
+    std::deque<int> reference;
+    for (int n = 0; n < 8; n++)
+        {
+            buffer.push_back(n);
+            reference.push_back(n);
+            if (reference.size() > capacity)
+                {
+                    reference.pop_front();
+                }
+        }
+    // Drop from the front across the wrap point, then refill
+    for (int n = 0; n < 3; n++)
+        {
+            buffer.pop_front();
+            reference.pop_front();
+            expect_contents(buffer, reference);
+        }
+    for (int n = 8; n < 12; n++)
+        {
+            buffer.push_back(n);
+            reference.push_back(n);
+            if (reference.size() > capacity)
+                {
+                    reference.pop_front();
+                }
+            expect_contents(buffer, reference);
+        }
+    while (!reference.empty())
+        {
+            buffer.pop_front();
+            reference.pop_front();
+        }
+    expect_contents(buffer, reference);
+    buffer.pop_front();
+    EXPECT_TRUE(buffer.empty());
+}
+
+
+TEST(LinearRingBufferTest, ClearAndSetCapacity)
+{
+    Linear_Ring_Buffer<int> buffer(4);
+    for (int n = 0; n < 6; n++)
+        {
+            buffer.push_back(n);
+        }
+    buffer.clear();
+    EXPECT_TRUE(buffer.empty());
+    EXPECT_FALSE(buffer.full());
+    EXPECT_EQ(4U, buffer.capacity());
+    std::deque<int> reference;
+    for (int n = 10; n < 16; n++)
+        {
+            buffer.push_back(n);
+            reference.push_back(n);
+            if (reference.size() > 4)
+                {
+                    reference.pop_front();
+                }
+        }
+    expect_contents(buffer, reference);
+
+    buffer.set_capacity(3);
+    EXPECT_TRUE(buffer.empty());
+    EXPECT_EQ(3U, buffer.capacity());
+    buffer.push_back(20);
+    expect_contents(buffer, std::deque<int>{20});
+}
+
+
+TEST(LinearRingBufferTest, ZeroCapacity)
+{
+    Linear_Ring_Buffer<int> buffer;
+    buffer.push_back(1);
+    EXPECT_TRUE(buffer.empty());
+    EXPECT_FALSE(buffer.full());
+    EXPECT_EQ(0U, buffer.capacity());
+}
@@ -0,0 +1,179 @@
+/*!
+ * \file preamble_correlator_test.cc
+ * \brief  This file implements unit tests for the Preamble_Correlator class.
+ *
+ *
+ * -------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2019  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *          Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------
+ */
+
+#include "preamble_correlator.h"
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <deque>
+#include <random>
+#include <utility>
+#include <vector>
+
+
+namespace
+{
+// Correlation of the last preamble.size() symbols, one multiply and add per sample, as the decoders did it
+int32_t per_symbol_correlation(const std::deque<std::pair<double, bool>>& window, const std::vector<int32_t>& preamble)
+{
+    int32_t corr_value = 0;
+    for (size_t i = 0; i < preamble.size(); i++)
+        {
+            if (window[i].second == true)
+                {
+                    if (window[i].first < 0)
+                        {
+                            corr_value -= preamble[i];
+                        }
+                    else
+                        {
+                            corr_value += preamble[i];
+                        }
+                }
+        }
+    return corr_value;
+}
+
+
+std::vector<int32_t> random_preamble(uint32_t length, std::default_random_engine& engine)
+{
+    std::bernoulli_distribution sign(0.5);
+    std::vector<int32_t> preamble(length);
+    for (auto& sample : preamble)
+        {
+            sample = sign(engine) ? -1 : 1;
+        }
+    return preamble;
+}
+}  // namespace
+
+
+TEST(PreambleCorrelatorTest, MatchesPerSymbolCorrelation)
+{
+    std::default_random_engine engine(1234);
+    std::uniform_int_distribution<int32_t> symbol(-2, 2);  // exact zeros count as positive
+    std::bernoulli_distribution valid(0.9);
+    // Lengths within one word, at the end of a word, across words, and the GPS L1 C/A preamble in symbols
+    for (uint32_t length : {10U, 64U, 65U, 130U, 160U})
+        {
+            std::vector<int32_t> preamble = random_preamble(length, engine);
+            Preamble_Correlator correlator;
+            correlator.set_preamble(preamble.data(), length);
+            std::deque<std::pair<double, bool>> window;
+            for (int32_t n = 0; n < 1000; n++)
+                {
+                    double new_symbol = static_cast<double>(symbol(engine));
+                    bool new_valid = valid(engine);
+                    correlator.push_symbol(new_symbol, new_valid);
+                    window.emplace_back(new_symbol, new_valid);
+                    if (window.size() > length)
+                        {
+                            window.pop_front();
+                        }
+                    ASSERT_EQ(window.size() == length, correlator.full()) << "length " << length << ", symbol " << n;
+                    if (correlator.full())
+                        {
+                            ASSERT_EQ(per_symbol_correlation(window, preamble), correlator.correlation()) << "length " << length << ", symbol " << n;
+                        }
+                }
+        }
+}
+
+
+TEST(PreambleCorrelatorTest, FindsThePreamble)
+{
+    std::default_random_engine engine(42);
+    const uint32_t length = 160U;
+    std::vector<int32_t> preamble = random_preamble(length, engine);
+    Preamble_Correlator correlator;
+    correlator.set_preamble(preamble.data(), length);
+    for (auto sample : preamble)
+        {
+            correlator.push_symbol(0.5 * sample);
+        }
+    EXPECT_EQ(static_cast<int32_t>(length), correlator.correlation());
+    // Inverted polarity
+    for (auto sample : preamble)
+        {
+            correlator.push_symbol(-0.5 * sample);
+        }
+    EXPECT_EQ(-static_cast<int32_t>(length), correlator.correlation());
+    // An invalid symbol does not contribute
+    correlator.push_symbol(0.5 * preamble[0], false);
+    for (uint32_t i = 1; i < length; i++)
+        {
+            correlator.push_symbol(0.5 * preamble[i]);
+        }
+    EXPECT_EQ(static_cast<int32_t>(length) - 1, correlator.correlation());
+}
+
+
+TEST(PreambleCorrelatorTest, ClearDiscardsTheHistory)
+{
+    std::default_random_engine engine(7);
+    std::normal_distribution<double> symbol(0.0, 1.0);
+    const uint32_t length = 65U;
+    std::vector<int32_t> preamble = random_preamble(length, engine);
+    Preamble_Correlator correlator;
+    correlator.set_preamble(preamble.data(), length);
+    for (int32_t n = 0; n < 100; n++)
+        {
+            correlator.push_symbol(symbol(engine));
+        }
+    EXPECT_TRUE(correlator.full());
+
+    correlator.clear();
+    EXPECT_FALSE(correlator.full());
+    EXPECT_EQ(0, correlator.correlation());
+
+    // The symbols before the reset do not leak into the new window
+    std::deque<std::pair<double, bool>> window;
+    for (uint32_t n = 0; n < length; n++)
+        {
+            double new_symbol = symbol(engine);
+            correlator.push_symbol(new_symbol);
+            window.emplace_back(new_symbol, true);
+            EXPECT_EQ(n + 1 == length, correlator.full());
+        }
+    EXPECT_EQ(per_symbol_correlation(window, preamble), correlator.correlation());
+
+    // A new preamble also resets the window
+    correlator.set_preamble(preamble.data(), 10U);
+    EXPECT_FALSE(correlator.full());
+    EXPECT_EQ(0, correlator.correlation());
+}
+
+
+TEST(PreambleCorrelatorTest, NoPreamble)
+{
+    Preamble_Correlator correlator;
+    correlator.push_symbol(1.0);
+    EXPECT_FALSE(correlator.full());
+    EXPECT_EQ(0, correlator.correlation());
+}
@@ -0,0 +1,113 @@
+/*!
+ * \file secondary_code_sync_test.cc
+ * \brief  This file implements unit tests for the Secondary_Code_Sync class.
+ *
+ *
+ * -------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2019  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *          Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------
+ */
+
+#include "GPS_L5.h"
+#include "Galileo_E5a.h"
+#include "secondary_code_sync.h"
+#include <gtest/gtest.h>
+#include <string>
+
+
+namespace
+{
+// Pushes the prompt signs of chips first_chip, first_chip + 1, ... of the code
+void push_chips(Secondary_Code_Sync& sync, const std::string& code, uint32_t first_chip, uint32_t count, bool inverted)
+{
+    for (uint32_t n = 0; n < count; n++)
+        {
+            bool negative = (code[(first_chip + n) % code.length()] == '1');
+            sync.push_sign(negative != inverted);
+        }
+}
+}  // namespace
+
+
+TEST(SecondaryCodeSyncTest, LocksAtNonZeroShift)
+{
+    const std::string& code = GPS_L5i_NH_CODE_STR;
+    Secondary_Code_Sync sync;
+    sync.set_code(code);
+    push_chips(sync, code, 3U, static_cast<uint32_t>(code.length()) - 1U, false);
+    EXPECT_FALSE(sync.full());
+    EXPECT_EQ(-1, sync.find_shift());
+    push_chips(sync, code, 2U, 1U, false);
+    ASSERT_TRUE(sync.full());
+    // The oldest prompt in the history is chip 3
+    EXPECT_EQ(3, sync.find_shift());
+    EXPECT_TRUE(sync.matches_shift(3U));
+    EXPECT_FALSE(sync.matches_shift(0U));
+}
+
+
+TEST(SecondaryCodeSyncTest, DataComponentWaitsForTheCodeBoundary)
+{
+    // A data channel only accepts shift 0: the prompts that follow must reach the
+    // end of the code period before the history is aligned with its start
+    const std::string& code = GPS_L5i_NH_CODE_STR;
+    const uint32_t length = static_cast<uint32_t>(code.length());
+    Secondary_Code_Sync sync;
+    sync.set_code(code);
+    push_chips(sync, code, 6U, length, false);
+    EXPECT_FALSE(sync.matches_shift(0U));
+    for (uint32_t chip = 6U; chip < length - 1U; chip++)
+        {
+            push_chips(sync, code, chip, 1U, false);
+            EXPECT_FALSE(sync.matches_shift(0U)) << "chip " << chip;
+        }
+    push_chips(sync, code, length - 1U, 1U, false);
+    EXPECT_TRUE(sync.matches_shift(0U));
+    EXPECT_EQ(0, sync.find_shift());
+}
+
+
+TEST(SecondaryCodeSyncTest, InvertedSignsMatch)
+{
+    std::string code(Galileo_E5a_Q_SECONDARY_CODE[0]);
+    Secondary_Code_Sync sync;
+    sync.set_code(code);
+    push_chips(sync, code, 77U, static_cast<uint32_t>(code.length()), true);
+    EXPECT_EQ(77, sync.find_shift());
+}
+
+
+TEST(SecondaryCodeSyncTest, NoMatchAndClear)
+{
+    const std::string& code = GPS_L5q_NH_CODE_STR;
+    Secondary_Code_Sync sync;
+    sync.set_code(code);
+    push_chips(sync, code, 0U, static_cast<uint32_t>(code.length()), false);
+    EXPECT_EQ(0, sync.find_shift());
+    // One wrong sign breaks every shift
+    sync.push_sign(code[0] != '1');
+    EXPECT_EQ(-1, sync.find_shift());
+    sync.clear();
+    EXPECT_FALSE(sync.full());
+    EXPECT_FALSE(sync.matches_shift(0U));
+}
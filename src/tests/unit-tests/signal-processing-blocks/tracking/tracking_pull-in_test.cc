@@ -37,6 +37,7 @@
 #include "Galileo_E5a.h"
 #include "acquisition_msg_rx.h"
 #include "control_message_factory.h"
+#include "dump_file_map.h"
 #include "galileo_e1_pcps_ambiguous_acquisition.h"
 #include "galileo_e5a_noncoherent_iq_acquisition_caf.h"
 #include "galileo_e5a_pcps_acquisition.h"
@@ -48,6 +49,7 @@
 #include "gps_l2_m_pcps_acquisition.h"
 #include "gps_l5i_pcps_acquisition.h"
 #include "in_memory_configuration.h"
+#include "parallel_test_grid.h"
 #include "signal_generator_flags.h"
 #include "test_flags.h"
 #include "tracking_dump_reader.h"
@@ -65,8 +67,11 @@
 #include <gnuradio/msg_queue.h>
 #include <gnuradio/top_block.h>
 #include <gtest/gtest.h>
+#include <algorithm>
 #include <chrono>
 #include <cstdint>
+#include <functional>
+#include <memory>
 #include <vector>
 #ifdef GR_GREATER_38
 #include <gnuradio/filter/fir_filter_blk.h>
@@ -789,289 +794,334 @@ TEST_F(TrackingPullInTest, ValidationOfResults)
     std::shared_ptr<std::vector<std::shared_ptr<ControlMessage>>> control_messages_;
 
 
-    //CN0 LOOP
-    std::vector<std::vector<double>> pull_in_results_v_v;
-
+    //build the grid of pull-in errors, in the order of the result meshes
+    struct Pull_In_Point
+    {
+        unsigned int cn0_idx;
+        unsigned int acq_doppler_error_idx;
+        unsigned int acq_code_error_idx;
+    };
+    std::vector<Pull_In_Point> grid_points;
     for (unsigned int current_cn0_idx = 0; current_cn0_idx < generator_CN0_values.size(); current_cn0_idx++)
         {
-            std::vector<double> pull_in_results_v;
             for (unsigned int current_acq_doppler_error_idx = 0; current_acq_doppler_error_idx < acq_doppler_error_hz_values.size(); current_acq_doppler_error_idx++)
                 {
                     for (unsigned int current_acq_code_error_idx = 0; current_acq_code_error_idx < acq_delay_error_chips_values.at(current_acq_doppler_error_idx).size(); current_acq_code_error_idx++)
                         {
-                            gnss_synchro.Acq_samplestamp_samples = acq_samplestamp_samples;
-                            //simulate a Doppler error in acquisition
-                            gnss_synchro.Acq_doppler_hz = true_acq_doppler_hz + acq_doppler_error_hz_values.at(current_acq_doppler_error_idx);
-                            //simulate Code Delay error in acquisition
-                            gnss_synchro.Acq_delay_samples = true_acq_delay_samples + (acq_delay_error_chips_values.at(current_acq_doppler_error_idx).at(current_acq_code_error_idx) / GPS_L1_CA_CODE_RATE_HZ) * static_cast<double>(baseband_sampling_freq);
-
-                            //create flowgraph
-                            top_block = gr::make_top_block("Tracking test");
-                            std::shared_ptr<GNSSBlockInterface> trk_ = factory->GetBlock(config, "Tracking", config->property("Tracking.implementation", std::string("undefined")), 1, 1);
-                            std::shared_ptr<TrackingInterface> tracking = std::dynamic_pointer_cast<TrackingInterface>(trk_);
-                            boost::shared_ptr<TrackingPullInTest_msg_rx> msg_rx = TrackingPullInTest_msg_rx_make();
-
-
-                            ASSERT_NO_THROW({
-                                tracking->set_channel(gnss_synchro.Channel_ID);
-                            }) << "Failure setting channel.";
-
-                            ASSERT_NO_THROW({
-                                tracking->set_gnss_synchro(&gnss_synchro);
-                            }) << "Failure setting gnss_synchro.";
-
-                            ASSERT_NO_THROW({
-                                tracking->connect(top_block);
-                            }) << "Failure connecting tracking to the top_block.";
-
-                            std::string file;
-                            ASSERT_NO_THROW({
-                                if (!FLAGS_enable_external_signal_file)
-                                    {
-                                        file = "./" + filename_raw_data + std::to_string(current_cn0_idx);
-                                    }
-                                else
-                                    {
-                                        file = FLAGS_signal_file;
-                                    }
-                                const char* file_name = file.c_str();
-                                gr::blocks::file_source::sptr file_source = gr::blocks::file_source::make(sizeof(int8_t), file_name, false);
-                                gr::blocks::interleaved_char_to_complex::sptr gr_interleaved_char_to_complex = gr::blocks::interleaved_char_to_complex::make();
-                                gr::blocks::null_sink::sptr sink = gr::blocks::null_sink::make(sizeof(Gnss_Synchro));
-                                gr::blocks::head::sptr head_samples = gr::blocks::head::make(sizeof(gr_complex), baseband_sampling_freq * FLAGS_duration);
-                                top_block->connect(file_source, 0, gr_interleaved_char_to_complex, 0);
-                                top_block->connect(gr_interleaved_char_to_complex, 0, head_samples, 0);
-                                if (acq_to_trk_delay_samples > 0)
-                                    {
-                                        top_block->connect(head_samples, 0, resetable_valve_, 0);
-                                        top_block->connect(resetable_valve_, 0, tracking->get_left_block(), 0);
-                                    }
-                                else
+                            grid_points.push_back({current_cn0_idx, current_acq_doppler_error_idx, current_acq_code_error_idx});
+                        }
+                }
+        }
+
+    //each worker runs its points with its own flow graph and channel (so its own tracking dump file).
+    //The pull-in delay valve and the plots of the tracking dump only work with one worker.
+    unsigned int workers = test_grid_workers(grid_points.size());
+    if (acq_to_trk_delay_samples > 0 or FLAGS_plot_detail_level >= 2)
+        {
+            workers = 1;
+        }
+    std::vector<std::unique_ptr<Dump_File_Map>> signal_files;  // kept in the page cache, read by all the workers
+    if (workers > 1)
+        {
+            for (unsigned int current_cn0_idx = 0; current_cn0_idx < generator_CN0_values.size(); current_cn0_idx++)
+                {
+                    std::string file = FLAGS_enable_external_signal_file ? FLAGS_signal_file : "./" + filename_raw_data + std::to_string(current_cn0_idx);
+                    signal_files.emplace_back(new Dump_File_Map());
+                    if (signal_files.back()->open(file))
+                        {
+                            signal_files.back()->prefetch();
+                        }
+                }
+            std::cout << "Running " << grid_points.size() << " pull-in tests in " << workers << " threads" << std::endl;
+        }
+
+    std::function<void(size_t, unsigned int, double&)> run_pull_in_test = [&](size_t point, unsigned int worker, double& pull_in_result) {
+        const unsigned int current_cn0_idx = grid_points.at(point).cn0_idx;
+        const unsigned int current_acq_doppler_error_idx = grid_points.at(point).acq_doppler_error_idx;
+        const unsigned int current_acq_code_error_idx = grid_points.at(point).acq_code_error_idx;
+        Gnss_Synchro point_gnss_synchro = gnss_synchro;
+        point_gnss_synchro.Channel_ID = static_cast<int32_t>(worker);
+        point_gnss_synchro.Acq_samplestamp_samples = acq_samplestamp_samples;
+        //simulate a Doppler error in acquisition
+        point_gnss_synchro.Acq_doppler_hz = true_acq_doppler_hz + acq_doppler_error_hz_values.at(current_acq_doppler_error_idx);
+        //simulate Code Delay error in acquisition
+        point_gnss_synchro.Acq_delay_samples = true_acq_delay_samples + (acq_delay_error_chips_values.at(current_acq_doppler_error_idx).at(current_acq_code_error_idx) / GPS_L1_CA_CODE_RATE_HZ) * static_cast<double>(baseband_sampling_freq);
+
+        //create flowgraph
+        gr::top_block_sptr top_block = gr::make_top_block("Tracking test");
+        std::shared_ptr<GNSSBlockInterface> trk_ = factory->GetBlock(config, "Tracking", config->property("Tracking.implementation", std::string("undefined")), 1, 1);
+        std::shared_ptr<TrackingInterface> tracking = std::dynamic_pointer_cast<TrackingInterface>(trk_);
+        boost::shared_ptr<TrackingPullInTest_msg_rx> msg_rx = TrackingPullInTest_msg_rx_make();
+
+
+        ASSERT_NO_THROW({
+            tracking->set_channel(point_gnss_synchro.Channel_ID);
+        }) << "Failure setting channel.";
+
+        ASSERT_NO_THROW({
+            tracking->set_gnss_synchro(&point_gnss_synchro);
+        }) << "Failure setting gnss_synchro.";
+
+        ASSERT_NO_THROW({
+            tracking->connect(top_block);
+        }) << "Failure connecting tracking to the top_block.";
+
+        std::string file;
+        ASSERT_NO_THROW({
+            if (!FLAGS_enable_external_signal_file)
+                {
+                    file = "./" + filename_raw_data + std::to_string(current_cn0_idx);
+                }
+            else
+                {
+                    file = FLAGS_signal_file;
+                }
+            const char* file_name = file.c_str();
+            gr::blocks::file_source::sptr file_source = gr::blocks::file_source::make(sizeof(int8_t), file_name, false);
+            gr::blocks::interleaved_char_to_complex::sptr gr_interleaved_char_to_complex = gr::blocks::interleaved_char_to_complex::make();
+            gr::blocks::null_sink::sptr sink = gr::blocks::null_sink::make(sizeof(Gnss_Synchro));
+            gr::blocks::head::sptr head_samples = gr::blocks::head::make(sizeof(gr_complex), baseband_sampling_freq * FLAGS_duration);
+            top_block->connect(file_source, 0, gr_interleaved_char_to_complex, 0);
+            top_block->connect(gr_interleaved_char_to_complex, 0, head_samples, 0);
+            if (acq_to_trk_delay_samples > 0)
+                {
+                    top_block->connect(head_samples, 0, resetable_valve_, 0);
+                    top_block->connect(resetable_valve_, 0, tracking->get_left_block(), 0);
+                }
+            else
+                {
+                    top_block->connect(head_samples, 0, tracking->get_left_block(), 0);
+                }
+            top_block->connect(tracking->get_right_block(), 0, sink, 0);
+            top_block->msg_connect(tracking->get_right_block(), pmt::mp("events"), msg_rx, pmt::mp("events"));
+            file_source->seek(2 * FLAGS_skip_samples, 0);  //skip head. ibyte, two bytes per complex sample
+        }) << "Failure connecting the blocks of tracking test.";
+
+
+        //********************************************************************
+        //***** STEP 5: Perform the signal tracking and read the results *****
+        //********************************************************************
+        std::cout << "--- START TRACKING WITH PULL-IN ERROR: " << acq_doppler_error_hz_values.at(current_acq_doppler_error_idx) << " [Hz] and " << acq_delay_error_chips_values.at(current_acq_doppler_error_idx).at(current_acq_code_error_idx) << " [Chips] ---" << std::endl;
+        std::chrono::time_point<std::chrono::system_clock> start, end;
+        if (acq_to_trk_delay_samples > 0)
+            {
+                EXPECT_NO_THROW({
+                    start = std::chrono::system_clock::now();
+                    std::cout << "--- SIMULATING A PULL-IN DELAY OF " << FLAGS_acq_to_trk_delay_s << " SECONDS ---\n";
+                    top_block->start();
+                    std::cout << " Waiting for valve...\n";
+                    //wait the valve message indicating the circulation of the amount of samples of the delay
+                    gr::message::sptr queue_message = queue->delete_head();
+                    if (queue_message != 0)
+                        {
+                            control_messages_ = control_message_factory_->GetControlMessages(queue_message);
+                        }
+                    else
+                        {
+                            control_messages_->clear();
+                        }
+                    std::cout << " Starting tracking...\n";
+                    tracking->start_tracking();
+                    resetable_valve_->open_valve();
+                    std::cout << " Waiting flowgraph..\n";
+                    top_block->wait();
+                    end = std::chrono::system_clock::now();
+                }) << "Failure running the top_block.";
+            }
+        else
+            {
+                tracking->start_tracking();
+                std::chrono::time_point<std::chrono::system_clock> start, end;
+                EXPECT_NO_THROW({
+                    start = std::chrono::system_clock::now();
+                    top_block->run();  // Start threads and wait
+                    end = std::chrono::system_clock::now();
+                }) << "Failure running the top_block.";
+            }
+
+        std::chrono::duration<double> elapsed_seconds = end - start;
+        std::cout << "Signal tracking completed in " << elapsed_seconds.count() << " seconds" << std::endl;
+
+        pull_in_result = msg_rx->rx_message != 3;  //save last asynchronous tracking message in order to detect a loss of lock
+
+        //********************************
+        //***** STEP 7: Plot results *****
+        //********************************
+        if (FLAGS_plot_detail_level >= 2 and FLAGS_show_plots)
+            {
+                //load the measured values
+                tracking_dump_reader trk_dump;
+                ASSERT_EQ(trk_dump.open_obs_file(std::string("./tracking_ch_0.dat")), true)
+                    << "Failure opening tracking dump file";
+
+                int64_t n_measured_epochs = trk_dump.num_epochs();
+                //todo: use vectors instead
+                arma::vec trk_timestamp_s = arma::zeros(n_measured_epochs, 1);
+                arma::vec trk_acc_carrier_phase_cycles = arma::zeros(n_measured_epochs, 1);
+                arma::vec trk_Doppler_Hz = arma::zeros(n_measured_epochs, 1);
+                arma::vec trk_prn_delay_chips = arma::zeros(n_measured_epochs, 1);
+                std::vector<double> timestamp_s;
+                std::vector<double> prompt;
+                std::vector<double> early;
+                std::vector<double> late;
+                std::vector<double> v_early;
+                std::vector<double> v_late;
+                std::vector<double> promptI;
+                std::vector<double> promptQ;
+                std::vector<double> CN0_dBHz;
+                std::vector<double> Doppler;
+                int64_t epoch_counter = 0;
+                while (trk_dump.read_binary_obs())
+                    {
+                        trk_timestamp_s(epoch_counter) = static_cast<double>(trk_dump.PRN_start_sample_count) / static_cast<double>(baseband_sampling_freq);
+                        trk_acc_carrier_phase_cycles(epoch_counter) = trk_dump.acc_carrier_phase_rad / GPS_TWO_PI;
+                        trk_Doppler_Hz(epoch_counter) = trk_dump.carrier_doppler_hz;
+                        double delay_chips = GPS_L1_CA_CODE_LENGTH_CHIPS - GPS_L1_CA_CODE_LENGTH_CHIPS * (fmod((static_cast<double>(trk_dump.PRN_start_sample_count) + trk_dump.aux1) / static_cast<double>(baseband_sampling_freq), 1.0e-3) / 1.0e-3);
+
+                        trk_prn_delay_chips(epoch_counter) = delay_chips;
+
+                        timestamp_s.push_back(trk_timestamp_s(epoch_counter));
+                        prompt.push_back(trk_dump.abs_P);
+                        early.push_back(trk_dump.abs_E);
+                        late.push_back(trk_dump.abs_L);
+                        v_early.push_back(trk_dump.abs_VE);
+                        v_late.push_back(trk_dump.abs_VL);
+                        promptI.push_back(trk_dump.prompt_I);
+                        promptQ.push_back(trk_dump.prompt_Q);
+                        CN0_dBHz.push_back(trk_dump.CN0_SNV_dB_Hz);
+                        Doppler.push_back(trk_dump.carrier_doppler_hz);
+                        epoch_counter++;
+                    }
+
+
+                const std::string gnuplot_executable(FLAGS_gnuplot_executable);
+                if (gnuplot_executable.empty())
+                    {
+                        std::cout << "WARNING: Although the flag show_plots has been set to TRUE," << std::endl;
+                        std::cout << "gnuplot has not been found in your system." << std::endl;
+                        std::cout << "Test results will not be plotted." << std::endl;
+                    }
+                else
+                    {
+                        try
+                            {
+                                boost::filesystem::path p(gnuplot_executable);
+                                boost::filesystem::path dir = p.parent_path();
+                                std::string gnuplot_path = dir.native();
+                                Gnuplot::set_GNUPlotPath(gnuplot_path);
+                                unsigned int decimate = static_cast<unsigned int>(FLAGS_plot_decimate);
+
+                                if (FLAGS_plot_detail_level >= 2 and FLAGS_show_plots)
                                     {
-                                        top_block->connect(head_samples, 0, tracking->get_left_block(), 0);
-                                    }
-                                top_block->connect(tracking->get_right_block(), 0, sink, 0);
-                                top_block->msg_connect(tracking->get_right_block(), pmt::mp("events"), msg_rx, pmt::mp("events"));
-                                file_source->seek(2 * FLAGS_skip_samples, 0);  //skip head. ibyte, two bytes per complex sample
-                            }) << "Failure connecting the blocks of tracking test.";
-
-
-                            //********************************************************************
-                            //***** STEP 5: Perform the signal tracking and read the results *****
-                            //********************************************************************
-                            std::cout << "--- START TRACKING WITH PULL-IN ERROR: " << acq_doppler_error_hz_values.at(current_acq_doppler_error_idx) << " [Hz] and " << acq_delay_error_chips_values.at(current_acq_doppler_error_idx).at(current_acq_code_error_idx) << " [Chips] ---" << std::endl;
-                            std::chrono::time_point<std::chrono::system_clock> start, end;
-                            if (acq_to_trk_delay_samples > 0)
-                                {
-                                    EXPECT_NO_THROW({
-                                        start = std::chrono::system_clock::now();
-                                        std::cout << "--- SIMULATING A PULL-IN DELAY OF " << FLAGS_acq_to_trk_delay_s << " SECONDS ---\n";
-                                        top_block->start();
-                                        std::cout << " Waiting for valve...\n";
-                                        //wait the valve message indicating the circulation of the amount of samples of the delay
-                                        gr::message::sptr queue_message = queue->delete_head();
-                                        if (queue_message != 0)
+                                        Gnuplot g1("linespoints");
+                                        g1.showonscreen();  // window output
+                                        if (!FLAGS_enable_external_signal_file)
+                                            {
+                                                g1.set_title(std::to_string(generator_CN0_values.at(current_cn0_idx)) + " dB-Hz, " + "PLL/DLL BW: " + std::to_string(FLAGS_PLL_bw_hz_start) + "," + std::to_string(FLAGS_DLL_bw_hz_start) + " [Hz], GPS L1 C/A (PRN #" + std::to_string(FLAGS_test_satellite_PRN) + ")");
+                                            }
+                                        else
+                                            {
+                                                g1.set_title("D_e=" + std::to_string(acq_doppler_error_hz_values.at(current_acq_doppler_error_idx)) + " [Hz] " + "T_e= " + std::to_string(acq_delay_error_chips_values.at(current_acq_doppler_error_idx).at(current_acq_code_error_idx)) + " [Chips], PLL/DLL BW: " + std::to_string(FLAGS_PLL_bw_hz_start) + "," + std::to_string(FLAGS_DLL_bw_hz_start) + " [Hz], (PRN #" + std::to_string(FLAGS_test_satellite_PRN) + ")");
+                                            }
+
+                                        g1.set_grid();
+                                        g1.set_xlabel("Time [s]");
+                                        g1.set_ylabel("Correlators' output");
+                                        //g1.cmd("set key box opaque");
+                                        g1.plot_xy(trk_timestamp_s, prompt, "Prompt", decimate);
+                                        g1.plot_xy(trk_timestamp_s, early, "Early", decimate);
+                                        g1.plot_xy(trk_timestamp_s, late, "Late", decimate);
+                                        if (implementation.compare("Galileo_E1_DLL_PLL_VEML_Tracking") == 0)
+                                            {
+                                                g1.plot_xy(trk_timestamp_s, v_early, "Very Early", decimate);
+                                                g1.plot_xy(trk_timestamp_s, v_late, "Very Late", decimate);
+                                            }
+                                        g1.set_legend();
+                                        g1.savetops("Correlators_outputs");
+
+                                        Gnuplot g2("points");
+                                        g2.showonscreen();  // window output
+                                        if (!FLAGS_enable_external_signal_file)
+                                            {
+                                                g2.set_title(std::to_string(generator_CN0_values.at(current_cn0_idx)) + " dB-Hz Constellation " + "PLL/DLL BW: " + std::to_string(FLAGS_PLL_bw_hz_start) + "," + std::to_string(FLAGS_DLL_bw_hz_start) + " [Hz], (PRN #" + std::to_string(FLAGS_test_satellite_PRN) + ")");
+                                            }
+                                        else
+                                            {
+                                                g2.set_title("D_e=" + std::to_string(acq_doppler_error_hz_values.at(current_acq_doppler_error_idx)) + " [Hz] " + "T_e= " + std::to_string(acq_delay_error_chips_values.at(current_acq_doppler_error_idx).at(current_acq_code_error_idx)) + " [Chips], PLL/DLL BW: " + std::to_string(FLAGS_PLL_bw_hz_start) + "," + std::to_string(FLAGS_DLL_bw_hz_start) + " [Hz], (PRN #" + std::to_string(FLAGS_test_satellite_PRN) + ")");
+                                            }
+
+                                        g2.set_grid();
+                                        g2.set_xlabel("Inphase");
+                                        g2.set_ylabel("Quadrature");
+                                        //g2.cmd("set size ratio -1");
+                                        g2.plot_xy(promptI, promptQ);
+                                        g2.savetops("Constellation");
+
+                                        Gnuplot g3("linespoints");
+                                        if (!FLAGS_enable_external_signal_file)
+                                            {
+                                                g3.set_title(std::to_string(generator_CN0_values.at(current_cn0_idx)) + " dB-Hz, GPS L1 C/A tracking CN0 output (PRN #" + std::to_string(FLAGS_test_satellite_PRN) + ")");
+                                            }
+                                        else
+                                            {
+                                                g3.set_title("D_e=" + std::to_string(acq_doppler_error_hz_values.at(current_acq_doppler_error_idx)) + " [Hz] " + "T_e= " + std::to_string(acq_delay_error_chips_values.at(current_acq_doppler_error_idx).at(current_acq_code_error_idx)) + " [Chips] PLL/DLL BW: " + std::to_string(FLAGS_PLL_bw_hz_start) + "," + std::to_string(FLAGS_DLL_bw_hz_start) + " [Hz], (PRN #" + std::to_string(FLAGS_test_satellite_PRN) + ")");
+                                            }
+                                        g3.set_grid();
+                                        g3.set_xlabel("Time [s]");
+                                        g3.set_ylabel("Reported CN0 [dB-Hz]");
+                                        g3.cmd("set key box opaque");
+
+                                        g3.plot_xy(trk_timestamp_s, CN0_dBHz,
+                                            std::to_string(static_cast<int>(round(generator_CN0_values.at(current_cn0_idx)))) + "[dB-Hz]", decimate);
+
+                                        g3.set_legend();
+                                        g3.savetops("CN0_output");
+
+                                        g3.showonscreen();  // window output
+
+                                        Gnuplot g4("linespoints");
+                                        if (!FLAGS_enable_external_signal_file)
                                             {
-                                                control_messages_ = control_message_factory_->GetControlMessages(queue_message);
+                                                g4.set_title(std::to_string(generator_CN0_values.at(current_cn0_idx)) + " dB-Hz, GPS L1 C/A tracking CN0 output (PRN #" + std::to_string(FLAGS_test_satellite_PRN) + ")");
                                             }
                                         else
                                             {
-                                                control_messages_->clear();
+                                                g4.set_title("D_e=" + std::to_string(acq_doppler_error_hz_values.at(current_acq_doppler_error_idx)) + " [Hz] " + "T_e= " + std::to_string(acq_delay_error_chips_values.at(current_acq_doppler_error_idx).at(current_acq_code_error_idx)) + " [Chips] PLL/DLL BW: " + std::to_string(FLAGS_PLL_bw_hz_start) + "," + std::to_string(FLAGS_DLL_bw_hz_start) + " [Hz], (PRN #" + std::to_string(FLAGS_test_satellite_PRN) + ")");
                                             }
-                                        std::cout << " Starting tracking...\n";
-                                        tracking->start_tracking();
-                                        resetable_valve_->open_valve();
-                                        std::cout << " Waiting flowgraph..\n";
-                                        top_block->wait();
-                                        end = std::chrono::system_clock::now();
-                                    }) << "Failure running the top_block.";
-                                }
-                            else
-                                {
-                                    tracking->start_tracking();
-                                    std::chrono::time_point<std::chrono::system_clock> start, end;
-                                    EXPECT_NO_THROW({
-                                        start = std::chrono::system_clock::now();
-                                        top_block->run();  // Start threads and wait
-                                        end = std::chrono::system_clock::now();
-                                    }) << "Failure running the top_block.";
-                                }
-
-                            std::chrono::duration<double> elapsed_seconds = end - start;
-                            std::cout << "Signal tracking completed in " << elapsed_seconds.count() << " seconds" << std::endl;
-
-                            pull_in_results_v.push_back(msg_rx->rx_message != 3);  //save last asynchronous tracking message in order to detect a loss of lock
-
-                            //********************************
-                            //***** STEP 7: Plot results *****
-                            //********************************
-                            if (FLAGS_plot_detail_level >= 2 and FLAGS_show_plots)
-                                {
-                                    //load the measured values
-                                    tracking_dump_reader trk_dump;
-                                    ASSERT_EQ(trk_dump.open_obs_file(std::string("./tracking_ch_0.dat")), true)
-                                        << "Failure opening tracking dump file";
-
-                                    int64_t n_measured_epochs = trk_dump.num_epochs();
-                                    //todo: use vectors instead
-                                    arma::vec trk_timestamp_s = arma::zeros(n_measured_epochs, 1);
-                                    arma::vec trk_acc_carrier_phase_cycles = arma::zeros(n_measured_epochs, 1);
-                                    arma::vec trk_Doppler_Hz = arma::zeros(n_measured_epochs, 1);
-                                    arma::vec trk_prn_delay_chips = arma::zeros(n_measured_epochs, 1);
-                                    std::vector<double> timestamp_s;
-                                    std::vector<double> prompt;
-                                    std::vector<double> early;
-                                    std::vector<double> late;
-                                    std::vector<double> v_early;
-                                    std::vector<double> v_late;
-                                    std::vector<double> promptI;
-                                    std::vector<double> promptQ;
-                                    std::vector<double> CN0_dBHz;
-                                    std::vector<double> Doppler;
-                                    int64_t epoch_counter = 0;
-                                    while (trk_dump.read_binary_obs())
-                                        {
-                                            trk_timestamp_s(epoch_counter) = static_cast<double>(trk_dump.PRN_start_sample_count) / static_cast<double>(baseband_sampling_freq);
-                                            trk_acc_carrier_phase_cycles(epoch_counter) = trk_dump.acc_carrier_phase_rad / GPS_TWO_PI;
-                                            trk_Doppler_Hz(epoch_counter) = trk_dump.carrier_doppler_hz;
-                                            double delay_chips = GPS_L1_CA_CODE_LENGTH_CHIPS - GPS_L1_CA_CODE_LENGTH_CHIPS * (fmod((static_cast<double>(trk_dump.PRN_start_sample_count) + trk_dump.aux1) / static_cast<double>(baseband_sampling_freq), 1.0e-3) / 1.0e-3);
-
-                                            trk_prn_delay_chips(epoch_counter) = delay_chips;
-
-                                            timestamp_s.push_back(trk_timestamp_s(epoch_counter));
-                                            prompt.push_back(trk_dump.abs_P);
-                                            early.push_back(trk_dump.abs_E);
-                                            late.push_back(trk_dump.abs_L);
-                                            v_early.push_back(trk_dump.abs_VE);
-                                            v_late.push_back(trk_dump.abs_VL);
-                                            promptI.push_back(trk_dump.prompt_I);
-                                            promptQ.push_back(trk_dump.prompt_Q);
-                                            CN0_dBHz.push_back(trk_dump.CN0_SNV_dB_Hz);
-                                            Doppler.push_back(trk_dump.carrier_doppler_hz);
-                                            epoch_counter++;
-                                        }
-
-
-                                    const std::string gnuplot_executable(FLAGS_gnuplot_executable);
-                                    if (gnuplot_executable.empty())
-                                        {
-                                            std::cout << "WARNING: Although the flag show_plots has been set to TRUE," << std::endl;
-                                            std::cout << "gnuplot has not been found in your system." << std::endl;
-                                            std::cout << "Test results will not be plotted." << std::endl;
-                                        }
-                                    else
-                                        {
-                                            try
-                                                {
-                                                    boost::filesystem::path p(gnuplot_executable);
-                                                    boost::filesystem::path dir = p.parent_path();
-                                                    std::string gnuplot_path = dir.native();
-                                                    Gnuplot::set_GNUPlotPath(gnuplot_path);
-                                                    unsigned int decimate = static_cast<unsigned int>(FLAGS_plot_decimate);
-
-                                                    if (FLAGS_plot_detail_level >= 2 and FLAGS_show_plots)
-                                                        {
-                                                            Gnuplot g1("linespoints");
-                                                            g1.showonscreen();  // window output
-                                                            if (!FLAGS_enable_external_signal_file)
-                                                                {
-                                                                    g1.set_title(std::to_string(generator_CN0_values.at(current_cn0_idx)) + " dB-Hz, " + "PLL/DLL BW: " + std::to_string(FLAGS_PLL_bw_hz_start) + "," + std::to_string(FLAGS_DLL_bw_hz_start) + " [Hz], GPS L1 C/A (PRN #" + std::to_string(FLAGS_test_satellite_PRN) + ")");
-                                                                }
-                                                            else
-                                                                {
-                                                                    g1.set_title("D_e=" + std::to_string(acq_doppler_error_hz_values.at(current_acq_doppler_error_idx)) + " [Hz] " + "T_e= " + std::to_string(acq_delay_error_chips_values.at(current_acq_doppler_error_idx).at(current_acq_code_error_idx)) + " [Chips], PLL/DLL BW: " + std::to_string(FLAGS_PLL_bw_hz_start) + "," + std::to_string(FLAGS_DLL_bw_hz_start) + " [Hz], (PRN #" + std::to_string(FLAGS_test_satellite_PRN) + ")");
-                                                                }
-
-                                                            g1.set_grid();
-                                                            g1.set_xlabel("Time [s]");
-                                                            g1.set_ylabel("Correlators' output");
-                                                            //g1.cmd("set key box opaque");
-                                                            g1.plot_xy(trk_timestamp_s, prompt, "Prompt", decimate);
-                                                            g1.plot_xy(trk_timestamp_s, early, "Early", decimate);
-                                                            g1.plot_xy(trk_timestamp_s, late, "Late", decimate);
-                                                            if (implementation.compare("Galileo_E1_DLL_PLL_VEML_Tracking") == 0)
-                                                                {
-                                                                    g1.plot_xy(trk_timestamp_s, v_early, "Very Early", decimate);
-                                                                    g1.plot_xy(trk_timestamp_s, v_late, "Very Late", decimate);
-                                                                }
-                                                            g1.set_legend();
-                                                            g1.savetops("Correlators_outputs");
-
-                                                            Gnuplot g2("points");
-                                                            g2.showonscreen();  // window output
-                                                            if (!FLAGS_enable_external_signal_file)
-                                                                {
-                                                                    g2.set_title(std::to_string(generator_CN0_values.at(current_cn0_idx)) + " dB-Hz Constellation " + "PLL/DLL BW: " + std::to_string(FLAGS_PLL_bw_hz_start) + "," + std::to_string(FLAGS_DLL_bw_hz_start) + " [Hz], (PRN #" + std::to_string(FLAGS_test_satellite_PRN) + ")");
-                                                                }
-                                                            else
-                                                                {
-                                                                    g2.set_title("D_e=" + std::to_string(acq_doppler_error_hz_values.at(current_acq_doppler_error_idx)) + " [Hz] " + "T_e= " + std::to_string(acq_delay_error_chips_values.at(current_acq_doppler_error_idx).at(current_acq_code_error_idx)) + " [Chips], PLL/DLL BW: " + std::to_string(FLAGS_PLL_bw_hz_start) + "," + std::to_string(FLAGS_DLL_bw_hz_start) + " [Hz], (PRN #" + std::to_string(FLAGS_test_satellite_PRN) + ")");
-                                                                }
-
-                                                            g2.set_grid();
-                                                            g2.set_xlabel("Inphase");
-                                                            g2.set_ylabel("Quadrature");
-                                                            //g2.cmd("set size ratio -1");
-                                                            g2.plot_xy(promptI, promptQ);
-                                                            g2.savetops("Constellation");
-
-                                                            Gnuplot g3("linespoints");
-                                                            if (!FLAGS_enable_external_signal_file)
-                                                                {
-                                                                    g3.set_title(std::to_string(generator_CN0_values.at(current_cn0_idx)) + " dB-Hz, GPS L1 C/A tracking CN0 output (PRN #" + std::to_string(FLAGS_test_satellite_PRN) + ")");
-                                                                }
-                                                            else
-                                                                {
-                                                                    g3.set_title("D_e=" + std::to_string(acq_doppler_error_hz_values.at(current_acq_doppler_error_idx)) + " [Hz] " + "T_e= " + std::to_string(acq_delay_error_chips_values.at(current_acq_doppler_error_idx).at(current_acq_code_error_idx)) + " [Chips] PLL/DLL BW: " + std::to_string(FLAGS_PLL_bw_hz_start) + "," + std::to_string(FLAGS_DLL_bw_hz_start) + " [Hz], (PRN #" + std::to_string(FLAGS_test_satellite_PRN) + ")");
-                                                                }
-                                                            g3.set_grid();
-                                                            g3.set_xlabel("Time [s]");
-                                                            g3.set_ylabel("Reported CN0 [dB-Hz]");
-                                                            g3.cmd("set key box opaque");
-
-                                                            g3.plot_xy(trk_timestamp_s, CN0_dBHz,
-                                                                std::to_string(static_cast<int>(round(generator_CN0_values.at(current_cn0_idx)))) + "[dB-Hz]", decimate);
-
-                                                            g3.set_legend();
-                                                            g3.savetops("CN0_output");
-
-                                                            g3.showonscreen();  // window output
-
-                                                            Gnuplot g4("linespoints");
-                                                            if (!FLAGS_enable_external_signal_file)
-                                                                {
-                                                                    g4.set_title(std::to_string(generator_CN0_values.at(current_cn0_idx)) + " dB-Hz, GPS L1 C/A tracking CN0 output (PRN #" + std::to_string(FLAGS_test_satellite_PRN) + ")");
-                                                                }
-                                                            else
-                                                                {
-                                                                    g4.set_title("D_e=" + std::to_string(acq_doppler_error_hz_values.at(current_acq_doppler_error_idx)) + " [Hz] " + "T_e= " + std::to_string(acq_delay_error_chips_values.at(current_acq_doppler_error_idx).at(current_acq_code_error_idx)) + " [Chips] PLL/DLL BW: " + std::to_string(FLAGS_PLL_bw_hz_start) + "," + std::to_string(FLAGS_DLL_bw_hz_start) + " [Hz], (PRN #" + std::to_string(FLAGS_test_satellite_PRN) + ")");
-                                                                }
-                                                            g4.set_grid();
-                                                            g4.set_xlabel("Time [s]");
-                                                            g4.set_ylabel("Estimated Doppler [Hz]");
-                                                            g4.cmd("set key box opaque");
-
-                                                            g4.plot_xy(trk_timestamp_s, Doppler,
-                                                                std::to_string(static_cast<int>(round(generator_CN0_values.at(current_cn0_idx)))) + "[dB-Hz]", decimate);
-
-                                                            g4.set_legend();
-                                                            g4.savetops("Doppler");
-
-                                                            g4.showonscreen();  // window output
-                                                        }
-                                                }
-                                            catch (const GnuplotException& ge)
-                                                {
-                                                    std::cout << ge.what() << std::endl;
-                                                }
-                                        }
-                                }  //end plot
-
-                        }  //end acquisition Delay errors loop
-                }          //end acquisition Doppler errors loop
-            pull_in_results_v_v.push_back(pull_in_results_v);
+                                        g4.set_grid();
+                                        g4.set_xlabel("Time [s]");
+                                        g4.set_ylabel("Estimated Doppler [Hz]");
+                                        g4.cmd("set key box opaque");
 
+                                        g4.plot_xy(trk_timestamp_s, Doppler,
+                                            std::to_string(static_cast<int>(round(generator_CN0_values.at(current_cn0_idx)))) + "[dB-Hz]", decimate);
 
+                                        g4.set_legend();
+                                        g4.savetops("Doppler");
+
+                                        g4.showonscreen();  // window output
+                                    }
+                            }
+                        catch (const GnuplotException& ge)
+                            {
+                                std::cout << ge.what() << std::endl;
+                            }
+                    }
+            }  //end plot
+    };
+
+    std::vector<double> pull_in_results = run_test_grid<double>(grid_points.size(), workers, [&](size_t point, unsigned int worker) {
+        double pull_in_result = 0.0;
+        run_pull_in_test(point, worker, pull_in_result);
+        return pull_in_result;
+    });
+
+    //CN0 LOOP
+    std::vector<std::vector<double>> pull_in_results_v_v;
+    const size_t points_per_cn0 = grid_points.size() / std::max<size_t>(1, generator_CN0_values.size());
+    for (unsigned int current_cn0_idx = 0; current_cn0_idx < generator_CN0_values.size(); current_cn0_idx++)
+        {
+            pull_in_results_v_v.emplace_back(pull_in_results.cbegin() + current_cn0_idx * points_per_cn0, pull_in_results.cbegin() + (current_cn0_idx + 1) * points_per_cn0);
         }  //end CN0 LOOP
            //build the mesh grid
     std::vector<double> doppler_error_mesh;
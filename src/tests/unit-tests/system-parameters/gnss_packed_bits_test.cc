@@ -0,0 +1,73 @@
+/*!
+ * \file gnss_packed_bits_test.cc
+ * \brief  This file implements tests for the extraction of navigation
+ * message fields from packed words
+ *
+ * -------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2019  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *          Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------
+ */
+
+#include "gnss_packed_bits.h"
+#include <cstdint>
+#include <string>
+
+
+TEST(GnssPackedBitsTest, WordsAndCharactersMatch)
+{
+    // Two 30-bit words, with garbage in the two upper bits
+    const uint32_t words[2] = {0xC0000000 | 0x2AAAAAAA, 0x0F0F0F0F};
+    Gnss_Packed_Bits from_words;
+    from_words.assign_words(words, 2, 30);
+
+    Gnss_Packed_Bits from_chars;
+    from_chars.assign_bits(std::string("101010101010101010101010101010") + std::string("001111000011110000111100001111"));
+
+    EXPECT_EQ(60U, from_words.size());
+    for (int32_t first = 1; first <= 60; first++)
+        {
+            for (int32_t length = 1; length <= 32 and first + length - 1 <= 60; length++)
+                {
+                    EXPECT_EQ(from_chars.field(first, length), from_words.field(first, length));
+                }
+        }
+}
+
+
+TEST(GnssPackedBitsTest, ReadFields)
+{
+    Gnss_Packed_Bits bits;
+    bits.assign_bits(std::string("1101") + std::string("00000000000000000000000000000101") + std::string("1110011"));
+
+    EXPECT_EQ(true, bits.read_bool({{1, 1}}));
+    EXPECT_EQ(false, bits.read_bool({{3, 1}}));
+    EXPECT_EQ(13U, bits.read_unsigned({{1, 4}}));
+    EXPECT_EQ(5U, bits.read_unsigned({{5, 32}}));
+    EXPECT_EQ(-3, bits.read_signed({{1, 4}}));
+    EXPECT_EQ(-3, bits.read_sign_magnitude({{37, 3}}));
+    EXPECT_EQ(3, bits.read_sign_magnitude({{41, 3}}));
+
+    // A parameter split in two slices, as in the ICD tables
+    EXPECT_EQ(0x35U, bits.read_unsigned({{1, 4}, {35, 2}}));
+    EXPECT_EQ(-11, bits.read_signed({{1, 4}, {35, 2}}));
+}
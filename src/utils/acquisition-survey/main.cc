@@ -0,0 +1,476 @@
+/*!
+ * \file main.cc
+ * \brief Searches all the satellites of all the signals of a recording, at
+ * several times of the recording, in parallel.
+ *
+ * The samples of each time are read once, through the signal source and the
+ * signal conditioner of the configuration, and every (signal, PRN) pair is
+ * then searched by a pool of threads with the PCPS acquisition of the
+ * receiver. The local code spectra and the Doppler wipe-off tables are
+ * computed once and shared by all the threads through the acquisition caches.
+ *
+ * -------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2019  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *          Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------
+ */
+
+#include "acquisition_interface.h"
+#include "concurrent_map.h"
+#include "concurrent_queue.h"
+#include "file_configuration.h"
+#include "gnss_block_factory.h"
+#include "gnss_sdr_flags.h"
+#include "gnss_synchro.h"
+#include "gps_acq_assist.h"
+#include <boost/bind.hpp>
+#include <gflags/gflags.h>
+#include <glog/logging.h>
+#include <gnuradio/block.h>
+#include <gnuradio/blocks/head.h>
+#include <gnuradio/blocks/vector_sink_c.h>
+#include <gnuradio/blocks/vector_source_c.h>
+#include <gnuradio/msg_queue.h>
+#include <gnuradio/top_block.h>
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+
+DEFINE_string(signals, "", "Comma-separated signals searched (1C, 2S, L5, 1B, 5X, 1G, 2G), by default those with channels in the configuration");
+DEFINE_string(offsets_s, "0", "Comma-separated times of the recording searched, in seconds after SignalSource.seconds_to_skip");
+DEFINE_int32(threads, 0, "Number of satellites searched in parallel (0: one per CPU core)");
+
+concurrent_queue<Gps_Acq_Assist> global_gps_acq_assist_queue;
+
+concurrent_map<Gps_Acq_Assist> global_gps_acq_assist_map;
+
+
+namespace
+{
+struct Survey_Signal
+{
+    const char* signal;
+    char system;
+    uint32_t prns;                    // searched PRNs, from 1
+    const char* implementation;       // default PCPS implementation
+    double chip_rate_hz;              // of the searched code
+    int32_t coherent_integration_ms;  // default
+};
+
+const std::array<Survey_Signal, 7> SIGNALS = {{{"1C", 'G', 32, "GPS_L1_CA_PCPS_Acquisition", 1.023e6, 1},
+    {"2S", 'G', 32, "GPS_L2_M_PCPS_Acquisition", 0.5115e6, 20},
+    {"L5", 'G', 32, "GPS_L5i_PCPS_Acquisition", 10.23e6, 1},
+    {"1B", 'E', 36, "Galileo_E1_PCPS_Ambiguous_Acquisition", 1.023e6, 4},
+    {"5X", 'E', 36, "Galileo_E5a_Pcps_Acquisition", 10.23e6, 1},
+    {"1G", 'R', 24, "GLONASS_L1_CA_PCPS_Acquisition", 0.511e6, 1},
+    {"2G", 'R', 24, "GLONASS_L2_CA_PCPS_Acquisition", 0.511e6, 1}}};
+
+std::vector<std::string> split_list(const std::string& list)
+{
+    std::vector<std::string> items;
+    std::stringstream ss(list);
+    std::string item;
+    while (std::getline(ss, item, ','))
+        {
+            if (!item.empty())
+                {
+                    items.push_back(item);
+                }
+        }
+    return items;
+}
+}  // namespace
+
+
+// ######## GNURADIO BLOCK MESSAGE RECEIVER #########
+class Survey_Msg_Rx;
+
+using Survey_Msg_Rx_sptr = boost::shared_ptr<Survey_Msg_Rx>;
+
+Survey_Msg_Rx_sptr survey_msg_rx_make();
+
+/*!
+ * \brief Keeps the last event of an acquisition block (1: positive, 2: negative)
+ */
+class Survey_Msg_Rx : public gr::block
+{
+public:
+    inline int64_t event() const
+    {
+        return d_event.load();
+    }
+
+private:
+    friend Survey_Msg_Rx_sptr survey_msg_rx_make();
+    Survey_Msg_Rx();
+    void msg_handler_events(pmt::pmt_t msg);
+    std::atomic<int64_t> d_event;
+};
+
+
+Survey_Msg_Rx_sptr survey_msg_rx_make()
+{
+    return Survey_Msg_Rx_sptr(new Survey_Msg_Rx());
+}
+
+
+Survey_Msg_Rx::Survey_Msg_Rx() : gr::block("Survey_Msg_Rx", gr::io_signature::make(0, 0, 0), gr::io_signature::make(0, 0, 0)),
+                                 d_event(0)
+{
+    this->message_port_register_in(pmt::mp("events"));
+    this->set_msg_handler(pmt::mp("events"), boost::bind(&Survey_Msg_Rx::msg_handler_events, this, _1));
+}
+
+
+void Survey_Msg_Rx::msg_handler_events(pmt::pmt_t msg)
+{
+    if (pmt::is_integer(msg))
+        {
+            d_event.store(pmt::to_long(msg));
+        }
+}
+
+
+// ######## PARALLEL SATELLITE SEARCH #########
+
+struct Survey_Job
+{
+    size_t offset;  // index in the offsets
+    size_t signal;  // index in SIGNALS
+    uint32_t prn;
+};
+
+struct Survey_Result
+{
+    Survey_Job job;
+    double doppler_hz;
+    double code_phase_samples;
+    double code_phase_chips;
+    double cn0_db_hz;  // 0 if not estimated
+};
+
+/*!
+ * \brief Acquisition of one signal owned by one search thread
+ */
+struct Survey_Acquisition
+{
+    std::shared_ptr<AcquisitionInterface> acquisition;
+    std::shared_ptr<Gnss_Synchro> gnss_synchro;
+};
+
+
+// Samples of the recording at skip_s, after the signal conditioner, or an empty vector if they can not be read
+std::vector<gr_complex> capture(const std::shared_ptr<FileConfiguration>& configuration, double skip_s, uint64_t nsamples)
+{
+    std::vector<gr_complex> samples;
+    configuration->set_property("SignalSource.seconds_to_skip", std::to_string(skip_s));
+    GNSSBlockFactory block_factory;
+    gr::msg_queue::sptr queue = gr::msg_queue::make(0);
+    gr::top_block_sptr top_block = gr::make_top_block("Acquisition survey capture");
+    try
+        {
+            std::shared_ptr<GNSSBlockInterface> source = block_factory.GetSignalSource(configuration, queue);
+            std::shared_ptr<GNSSBlockInterface> conditioner = block_factory.GetSignalConditioner(configuration);
+            if (!source or !conditioner)
+                {
+                    std::cerr << "Unable to create the signal source and conditioner" << std::endl;
+                    return samples;
+                }
+            source->connect(top_block);
+            conditioner->connect(top_block);
+            if (conditioner->get_right_block()->output_signature()->sizeof_stream_item(0) != sizeof(gr_complex))
+                {
+                    std::cerr << "The signal conditioner must output gr_complex samples" << std::endl;
+                    return samples;
+                }
+            gr::blocks::head::sptr head = gr::blocks::head::make(sizeof(gr_complex), nsamples);
+            gr::blocks::vector_sink_c::sptr sink = gr::blocks::vector_sink_c::make();
+            top_block->connect(source->get_right_block(), 0, conditioner->get_left_block(), 0);
+            top_block->connect(conditioner->get_right_block(), 0, head, 0);
+            top_block->connect(head, 0, sink, 0);
+            top_block->run();
+            samples = sink->data();
+        }
+    catch (const std::exception& e)
+        {
+            std::cerr << "Unable to read the recording at " << skip_s << " s: " << e.what() << std::endl;
+            samples.clear();
+        }
+    if (samples.size() < nsamples)
+        {
+            std::cerr << "The recording ends before " << skip_s << " s plus " << nsamples << " samples" << std::endl;
+            samples.clear();
+        }
+    return samples;
+}
+
+
+// Searches the satellite of the job in the samples, and returns true if it is found
+bool search(Survey_Acquisition& survey_acquisition, const Survey_Job& job, const std::vector<gr_complex>& samples, Survey_Result& result)
+{
+    Gnss_Synchro* gnss_synchro = survey_acquisition.gnss_synchro.get();
+    gnss_synchro->PRN = job.prn;
+    gnss_synchro->CN0_dB_hz = 0.0;
+    std::shared_ptr<AcquisitionInterface> acquisition = survey_acquisition.acquisition;
+    acquisition->set_gnss_synchro(gnss_synchro);
+    acquisition->init();
+    acquisition->set_local_code();
+
+    gr::top_block_sptr top_block = gr::make_top_block("Acquisition survey");
+    gr::blocks::vector_source_c::sptr source = gr::blocks::vector_source_c::make(samples, false);
+    Survey_Msg_Rx_sptr msg_rx = survey_msg_rx_make();
+    acquisition->connect(top_block);
+    top_block->connect(source, 0, acquisition->get_left_block(), 0);
+    top_block->msg_connect(acquisition->get_right_block(), pmt::mp("events"), msg_rx, pmt::mp("events"));
+    acquisition->set_state(0);
+    acquisition->reset();
+    top_block->run();
+    acquisition->disconnect(top_block);
+    if (msg_rx->event() != 1)
+        {
+            return false;
+        }
+
+    result.job = job;
+    result.doppler_hz = gnss_synchro->Acq_doppler_hz;
+    result.code_phase_samples = gnss_synchro->Acq_delay_samples;
+    result.code_phase_chips = gnss_synchro->Acq_delay_samples * SIGNALS[job.signal].chip_rate_hz / static_cast<double>(gnss_synchro->fs);
+    result.cn0_db_hz = gnss_synchro->CN0_dB_hz;
+    return true;
+}
+
+
+int main(int argc, char** argv)
+{
+    const std::string intro_help(
+        std::string("\n acquisition-survey searches all the satellites of all the signals of a recording\n") +
+        "Copyright (C) 2019 (see AUTHORS file for a list of contributors)\n" +
+        "This program comes with ABSOLUTELY NO WARRANTY;\n" +
+        "See COPYING file to see a copy of the General Public License.\n \n" +
+        "Usage: \n" +
+        "   acquisition-survey --config_file=<configuration file> [--signals=1C,1B] [--offsets_s=0,30,60] [--threads=N]");
+
+    google::SetUsageMessage(intro_help);
+    google::SetVersionString("1.0");
+    google::ParseCommandLineFlags(&argc, &argv, true);
+    google::InitGoogleLogging(argv[0]);
+
+    std::string config_file = (FLAGS_c == "-") ? FLAGS_config_file : FLAGS_c;
+    auto configuration = std::make_shared<FileConfiguration>(config_file);
+    const double fs = configuration->property("GNSS-SDR.internal_fs_sps", 0.0);
+    if (fs <= 0.0)
+        {
+            std::cerr << "Set GNSS-SDR.internal_fs_sps in " << config_file << std::endl;
+            google::ShutDownCommandLineFlags();
+            return 1;
+        }
+
+    // signals to search
+    std::vector<size_t> signals;
+    std::vector<std::string> requested = split_list(FLAGS_signals);
+    for (size_t s = 0; s < SIGNALS.size(); s++)
+        {
+            const std::string signal = SIGNALS[s].signal;
+            bool wanted = requested.empty() ? (configuration->property("Channels_" + signal + ".count", 0) > 0) : (std::find(requested.cbegin(), requested.cend(), signal) != requested.cend());
+            if (wanted)
+                {
+                    signals.push_back(s);
+                }
+        }
+    if (signals.empty())
+        {
+            std::cerr << "No signal to search: set --signals, or the Channels_XX.count of the configuration" << std::endl;
+            google::ShutDownCommandLineFlags();
+            return 1;
+        }
+
+    // one dwell per PRN, in blocking mode, with the statistic that gives a C/N0 estimation
+    uint64_t nsamples = 0;
+    for (size_t s : signals)
+        {
+            const std::string role = std::string("Acquisition_") + SIGNALS[s].signal;
+            std::string implementation = configuration->property(role + ".implementation", std::string(""));
+            if (implementation.find("PCPS") == std::string::npos and implementation.find("Pcps") == std::string::npos)
+                {
+                    configuration->set_property(role + ".implementation", SIGNALS[s].implementation);
+                }
+            configuration->set_property(role + ".item_type", "gr_complex");
+            configuration->set_property(role + ".blocking", "true");
+            configuration->set_property(role + ".dump", "false");
+            configuration->set_property(role + ".repeat_satellite", "false");
+            configuration->set_property(role + ".bit_transition_flag", "false");
+            configuration->set_property(role + ".use_CFAR_algorithm", "true");
+            int32_t coherent_ms = configuration->property(role + ".coherent_integration_time_ms", SIGNALS[s].coherent_integration_ms);
+            int32_t max_dwells = std::max(configuration->property(role + ".max_dwells", 1), 1);
+            // some extra samples for the implementations that skip the first block
+            nsamples = std::max(nsamples, static_cast<uint64_t>(std::ceil(fs * coherent_ms * 1e-3)) * (max_dwells + 2));
+        }
+
+    std::vector<double> offsets;
+    for (const auto& offset : split_list(FLAGS_offsets_s))
+        {
+            offsets.push_back(std::stod(offset));
+        }
+
+    std::chrono::time_point<std::chrono::steady_clock> start = std::chrono::steady_clock::now();
+    const double seconds_to_skip = configuration->property("SignalSource.seconds_to_skip", 0.0);
+    std::vector<std::vector<gr_complex>> samples;
+    std::vector<Survey_Job> jobs;
+    for (size_t o = 0; o < offsets.size(); o++)
+        {
+            samples.push_back(capture(configuration, seconds_to_skip + offsets[o], nsamples));
+            if (samples.back().empty())
+                {
+                    continue;
+                }
+            for (size_t s : signals)
+                {
+                    for (uint32_t prn = 1; prn <= SIGNALS[s].prns; prn++)
+                        {
+                            jobs.push_back(Survey_Job{o, s, prn});
+                        }
+                }
+        }
+
+    // the acquisition blocks are created here, so that the FFT plans are not made concurrently
+    uint32_t n_threads = FLAGS_threads > 0 ? static_cast<uint32_t>(FLAGS_threads) : std::max(std::thread::hardware_concurrency(), 1U);
+    n_threads = std::max(std::min(n_threads, static_cast<uint32_t>(jobs.size())), 1U);
+    std::vector<std::vector<Survey_Acquisition>> acquisitions(n_threads, std::vector<Survey_Acquisition>(SIGNALS.size()));
+    GNSSBlockFactory block_factory;
+    for (uint32_t t = 0; t < n_threads; t++)
+        {
+            for (size_t s : signals)
+                {
+                    const std::string signal = SIGNALS[s].signal;
+                    const std::string role = "Acquisition_" + signal;
+                    Survey_Acquisition& survey_acquisition = acquisitions[t][s];
+                    survey_acquisition.gnss_synchro = std::make_shared<Gnss_Synchro>();
+                    survey_acquisition.gnss_synchro->Channel_ID = t;
+                    survey_acquisition.gnss_synchro->System = SIGNALS[s].system;
+                    signal.copy(survey_acquisition.gnss_synchro->Signal, 2, 0);
+                    survey_acquisition.gnss_synchro->PRN = 1;
+                    survey_acquisition.gnss_synchro->fs = static_cast<int64_t>(fs);
+                    std::shared_ptr<GNSSBlockInterface> block = block_factory.GetBlock(configuration, role, configuration->property(role + ".implementation", std::string("")), 1, 0);
+                    survey_acquisition.acquisition = std::dynamic_pointer_cast<AcquisitionInterface>(block);
+                    if (!survey_acquisition.acquisition)
+                        {
+                            std::cerr << "Unable to create the acquisition of the signal " << signal << std::endl;
+                            google::ShutDownCommandLineFlags();
+                            return 1;
+                        }
+                    survey_acquisition.acquisition->set_channel(t);
+                    survey_acquisition.acquisition->set_gnss_synchro(survey_acquisition.gnss_synchro.get());
+                    int32_t doppler_step = FLAGS_doppler_step != 0 ? FLAGS_doppler_step : configuration->property(role + ".doppler_step", 500);
+                    survey_acquisition.acquisition->set_doppler_step(doppler_step);
+                    survey_acquisition.acquisition->set_threshold(configuration->property(role + ".threshold", 0.0));
+                    survey_acquisition.acquisition->init();
+                }
+        }
+
+    // each thread takes the next satellite not yet searched
+    std::vector<Survey_Result> results;
+    std::mutex results_mutex;
+    std::atomic<size_t> next_job(0);
+    std::vector<std::thread> threads;
+    for (uint32_t t = 0; t < n_threads; t++)
+        {
+            threads.emplace_back([&, t]() {
+                for (size_t j = next_job++; j < jobs.size(); j = next_job++)
+                    {
+                        Survey_Result result;
+                        if (search(acquisitions[t][jobs[j].signal], jobs[j], samples[jobs[j].offset], result))
+                            {
+                                std::lock_guard<std::mutex> lock(results_mutex);
+                                results.push_back(result);
+                            }
+                    }
+            });
+        }
+    for (auto& thread : threads)
+        {
+            thread.join();
+        }
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+    std::sort(results.begin(), results.end(), [](const Survey_Result& a, const Survey_Result& b) {
+        if (a.job.offset != b.job.offset)
+            {
+                return a.job.offset < b.job.offset;
+            }
+        if (a.job.signal != b.job.signal)
+            {
+                return a.job.signal < b.job.signal;
+            }
+        return a.job.prn < b.job.prn;
+    });
+    std::cout << std::setw(10) << "Time [s]" << std::setw(8) << "Signal" << std::setw(6) << "PRN"
+              << std::setw(14) << "Doppler [Hz]" << std::setw(22) << "Code phase [samples]" << std::setw(20) << "Code phase [chips]"
+              << std::setw(16) << "C/N0 [dB-Hz]" << std::endl;
+    for (const auto& result : results)
+        {
+            std::cout << std::fixed << std::setprecision(3) << std::setw(10) << offsets[result.job.offset]
+                      << std::setw(8) << SIGNALS[result.job.signal].signal << std::setw(6) << result.job.prn
+                      << std::setprecision(1) << std::setw(14) << result.doppler_hz
+                      << std::setw(22) << result.code_phase_samples << std::setw(20) << result.code_phase_chips;
+            if (result.cn0_db_hz > 0.0)
+                {
+                    std::cout << std::setw(16) << result.cn0_db_hz;
+                }
+            else
+                {
+                    std::cout << std::setw(16) << "-";
+                }
+            std::cout << std::endl;
+        }
+
+    int status = 0;
+    for (size_t o = 0; o < offsets.size(); o++)
+        {
+            if (samples[o].empty())
+                {
+                    status = 1;
+                    continue;
+                }
+            std::cout << "At " << std::setprecision(3) << offsets[o] << " s:";
+            for (size_t s : signals)
+                {
+                    auto found = std::count_if(results.cbegin(), results.cend(), [&](const Survey_Result& result) { return (result.job.offset == o) and (result.job.signal == s); });
+                    std::cout << " " << found << " " << SIGNALS[s].signal;
+                }
+            std::cout << std::endl;
+        }
+    std::cout << jobs.size() << " searches in " << std::setprecision(2) << elapsed.count() << " s with " << n_threads << " threads" << std::endl;
+    google::ShutDownCommandLineFlags();
+    return status;
+}
@@ -33,7 +33,6 @@
 #endif
 
 #include "concurrent_map.h"
-#include "concurrent_queue.h"
 #include "file_configuration.h"
 #include "front_end_cal.h"
 #include "galileo_almanac.h"
@@ -66,13 +65,16 @@
 #include <gnuradio/blocks/skiphead.h>
 #include <gnuradio/msg_queue.h>
 #include <gnuradio/top_block.h>
+#include <algorithm>
 #include <chrono>
 #include <cstdint>
 #include <cstdlib>
 #include <ctime>  // for ctime
+#include <deque>
 #include <exception>
+#include <map>
 #include <memory>
-#include <queue>
+#include <mutex>
 #include <utility>
 #include <vector>
 
@@ -87,37 +89,38 @@ concurrent_map<Gps_Utc_Model> global_gps_utc_model_map;
 concurrent_map<Gps_Almanac> global_gps_almanac_map;
 concurrent_map<Gps_Acq_Assist> global_gps_acq_assist_map;
 
-bool stop;
-concurrent_queue<int> channel_internal_queue;
-GpsL1CaPcpsAcquisitionFineDoppler* acquisition;
-Gnss_Synchro* gnss_synchro;
-std::vector<Gnss_Synchro> gnss_sync_vector;
-
-
 // ######## GNURADIO BLOCK MESSAGE RECEVER #########
 class FrontEndCal_msg_rx;
 
 using FrontEndCal_msg_rx_sptr = boost::shared_ptr<FrontEndCal_msg_rx>;
 
-FrontEndCal_msg_rx_sptr FrontEndCal_msg_rx_make();
+FrontEndCal_msg_rx_sptr FrontEndCal_msg_rx_make(Gnss_Synchro* gnss_synchro);
 
 
 class FrontEndCal_msg_rx : public gr::block
 {
 private:
-    friend FrontEndCal_msg_rx_sptr FrontEndCal_msg_rx_make();
+    friend FrontEndCal_msg_rx_sptr FrontEndCal_msg_rx_make(Gnss_Synchro* gnss_synchro);
     void msg_handler_events(pmt::pmt_t msg);
-    FrontEndCal_msg_rx();
+    explicit FrontEndCal_msg_rx(Gnss_Synchro* gnss_synchro);
+    Gnss_Synchro* d_gnss_synchro;
+    std::vector<Gnss_Synchro> d_positive_acquisitions;
+    std::mutex d_mutex;
 
 public:
     int rx_message;
+
+    /*!
+     * \brief Returns the positive acquisitions received since the last call and forgets them
+     */
+    std::vector<Gnss_Synchro> pop_positive_acquisitions();
     ~FrontEndCal_msg_rx();  //!< Default destructor
 };
 
 
-FrontEndCal_msg_rx_sptr FrontEndCal_msg_rx_make()
+FrontEndCal_msg_rx_sptr FrontEndCal_msg_rx_make(Gnss_Synchro* gnss_synchro)
 {
-    return FrontEndCal_msg_rx_sptr(new FrontEndCal_msg_rx());
+    return FrontEndCal_msg_rx_sptr(new FrontEndCal_msg_rx(gnss_synchro));
 }
 
 
@@ -127,7 +130,11 @@ void FrontEndCal_msg_rx::msg_handler_events(pmt::pmt_t msg)
         {
             int64_t message = pmt::to_long(std::move(msg));
             rx_message = message;
-            channel_internal_queue.push(rx_message);
+            if (message == 1)  // Positive acq
+                {
+                    std::lock_guard<std::mutex> lock(d_mutex);
+                    d_positive_acquisitions.push_back(*d_gnss_synchro);
+                }
         }
     catch (boost::bad_any_cast& e)
         {
@@ -137,10 +144,20 @@ void FrontEndCal_msg_rx::msg_handler_events(pmt::pmt_t msg)
 }
 
 
-FrontEndCal_msg_rx::FrontEndCal_msg_rx() : gr::block("FrontEndCal_msg_rx", gr::io_signature::make(0, 0, 0), gr::io_signature::make(0, 0, 0))
+std::vector<Gnss_Synchro> FrontEndCal_msg_rx::pop_positive_acquisitions()
+{
+    std::lock_guard<std::mutex> lock(d_mutex);
+    std::vector<Gnss_Synchro> positive_acquisitions;
+    positive_acquisitions.swap(d_positive_acquisitions);
+    return positive_acquisitions;
+}
+
+
+FrontEndCal_msg_rx::FrontEndCal_msg_rx(Gnss_Synchro* gnss_synchro) : gr::block("FrontEndCal_msg_rx", gr::io_signature::make(0, 0, 0), gr::io_signature::make(0, 0, 0))
 {
     this->message_port_register_in(pmt::mp("events"));
     this->set_msg_handler(pmt::mp("events"), boost::bind(&FrontEndCal_msg_rx::msg_handler_events, this, _1));
+    d_gnss_synchro = gnss_synchro;
     rx_message = 0;
 }
 
@@ -148,27 +165,129 @@ FrontEndCal_msg_rx::FrontEndCal_msg_rx() : gr::block("FrontEndCal_msg_rx", gr::i
 FrontEndCal_msg_rx::~FrontEndCal_msg_rx() = default;
 
 
-void wait_message()
+// ######## PARALLEL SATELLITE SEARCH #########
+
+/*
+ * Flowgraph (file_source -> Acquisition) owned by one search thread.
+ * Each worker has its own acquisition block, so PRNs can be searched concurrently.
+ * The Doppler wipe-off tables are shared among all of them through the acquisition caches.
+ */
+struct Acquisition_Worker
 {
-    while (!stop)
+    gr::top_block_sptr top_block;
+    boost::shared_ptr<gr::blocks::file_source> source;
+    std::shared_ptr<GpsL1CaPcpsAcquisitionFineDoppler> acquisition;
+    std::shared_ptr<Gnss_Synchro> gnss_synchro;
+    FrontEndCal_msg_rx_sptr msg_rx;
+};
+
+
+/*
+ * State shared by the search threads: the PRNs still to be searched, the
+ * measurements obtained so far and the parameters of the early stop criterion.
+ */
+struct Acquisition_Jobs
+{
+    std::mutex mutex;
+    std::deque<unsigned int> prn_queue;
+    std::map<int, double> doppler_measurements_map;
+    std::vector<double> f_if_estimations_Hz;
+    FrontEndCal* front_end_cal = nullptr;
+    bool tow_known = false;
+    double current_TOW = 0.0;
+    double lat_deg = 0.0;
+    double lon_deg = 0.0;
+    double altitude_m = 0.0;
+    double fs_in = 0.0;
+    uint32_t min_satellites = 0;  // 0 disables the early stop
+    double max_spread_hz = 0.0;
+    bool consistent = false;
+};
+
+
+/*
+ * Returns true if at least min_satellites IF estimations lie within a window of max_spread_hz
+ */
+bool consistent_estimations(std::vector<double> f_if_estimations_Hz, uint32_t min_satellites, double max_spread_hz)
+{
+    if (min_satellites == 0 or f_if_estimations_Hz.size() < min_satellites)
         {
-            int message;
-            channel_internal_queue.wait_and_pop(message);
-            //std::cout<<"Acq message rx="<<message<<std::endl;
-            switch (message)
+            return false;
+        }
+    std::sort(f_if_estimations_Hz.begin(), f_if_estimations_Hz.end());
+    for (size_t first = 0; first + min_satellites <= f_if_estimations_Hz.size(); first++)
+        {
+            if (f_if_estimations_Hz[first + min_satellites - 1] - f_if_estimations_Hz[first] <= max_spread_hz)
                 {
-                case 1:  // Positive acq
-                    gnss_sync_vector.push_back(*gnss_synchro);
-                    //acquisition->reset();
-                    break;
-                case 2:  // negative acq
-                    //acquisition->reset();
-                    break;
-                case 3:
-                    stop = true;
-                    break;
-                default:
-                    break;
+                    return true;
+                }
+        }
+    return false;
+}
+
+
+void acquisition_worker(Acquisition_Worker* worker, Acquisition_Jobs* jobs)
+{
+    while (true)
+        {
+            unsigned int PRN;
+            {
+                std::lock_guard<std::mutex> lock(jobs->mutex);
+                if (jobs->prn_queue.empty())
+                    {
+                        return;
+                    }
+                PRN = jobs->prn_queue.front();
+                jobs->prn_queue.pop_front();
+            }
+
+            worker->gnss_synchro->PRN = PRN;
+            worker->acquisition->set_gnss_synchro(worker->gnss_synchro.get());
+            worker->acquisition->init();
+            worker->acquisition->set_local_code();
+            worker->acquisition->reset();
+            worker->top_block->run();
+            worker->source->seek(0, 0);
+
+            std::vector<Gnss_Synchro> positive_acquisitions = worker->msg_rx->pop_positive_acquisitions();
+            std::lock_guard<std::mutex> lock(jobs->mutex);
+            if (positive_acquisitions.empty())
+                {
+                    std::cout << " . ";
+                    std::cout.flush();
+                    continue;
+                }
+            std::cout << " " << PRN << " ";
+            std::cout.flush();
+            double doppler_measurement_hz = 0;
+            for (auto& it : positive_acquisitions)
+                {
+                    doppler_measurement_hz += it.Acq_doppler_hz;
+                }
+            doppler_measurement_hz = doppler_measurement_hz / positive_acquisitions.size();
+            jobs->doppler_measurements_map.insert(std::pair<int, double>(PRN, doppler_measurement_hz));
+
+            if (!jobs->tow_known or jobs->consistent)
+                {
+                    continue;
+                }
+            try
+                {
+                    double doppler_estimated_hz = jobs->front_end_cal->estimate_doppler_from_eph(PRN, jobs->current_TOW, jobs->lat_deg, jobs->lon_deg, jobs->altitude_m);
+                    double estimated_fs_Hz, estimated_f_if_Hz, f_osc_err_ppm;
+                    jobs->front_end_cal->GPS_L1_front_end_model_E4000(doppler_estimated_hz, doppler_measurement_hz, jobs->fs_in, &estimated_fs_Hz, &estimated_f_if_Hz, &f_osc_err_ppm);
+                    jobs->f_if_estimations_Hz.push_back(estimated_f_if_Hz);
+                }
+            catch (...)
+                {
+                    // No ephemeris for this PRN, it does not count for the early stop
+                    continue;
+                }
+            if (consistent_estimations(jobs->f_if_estimations_Hz, jobs->min_satellites, jobs->max_spread_hz))
+                {
+                    // Enough satellites agree on the front-end IF, do not search the remaining PRNs
+                    jobs->consistent = true;
+                    jobs->prn_queue.clear();
                 }
         }
 }
@@ -342,130 +461,122 @@ int main(int argc, char** argv)
             std::cout << "Unexpected exception" << std::endl;
         }
 
-    // 4. Setup GNU Radio flowgraph (file_source -> Acquisition_10m)
-    gr::top_block_sptr top_block;
-    top_block = gr::make_top_block("Acquisition test");
-
-    // Satellite signal definition
-    gnss_synchro = new Gnss_Synchro();
-    gnss_synchro->Channel_ID = 0;
-    gnss_synchro->System = 'G';
-    std::string signal = "1C";
-    signal.copy(gnss_synchro->Signal, 2, 0);
-    gnss_synchro->PRN = 1;
-
+    // 4. Setup GNU Radio flowgraphs (file_source -> Acquisition_10m), one per search thread
     int64_t fs_in_ = configuration->property("GNSS-SDR.internal_fs_sps", 2048000);
     configuration->set_property("Acquisition.max_dwells", "10");
 
-    GNSSBlockFactory block_factory;
-    acquisition = new GpsL1CaPcpsAcquisitionFineDoppler(configuration.get(), "Acquisition", 1, 1);
+    uint32_t n_threads = configuration->property("Acquisition.calibration_threads", std::max(boost::thread::hardware_concurrency(), 1U));
+    n_threads = std::max(std::min(n_threads, 32U), 1U);
 
-    acquisition->set_channel(1);
-    acquisition->set_gnss_synchro(gnss_synchro);
-    acquisition->set_threshold(configuration->property("Acquisition.threshold", 2.0));
-    acquisition->set_doppler_max(configuration->property("Acquisition.doppler_max", 10000));
-    acquisition->set_doppler_step(configuration->property("Acquisition.doppler_step", 250));
-
-    gr::block_sptr source;
-    source = gr::blocks::file_source::make(sizeof(gr_complex), "tmp_capture.dat");
-    boost::shared_ptr<FrontEndCal_msg_rx> msg_rx;
-    try
+    std::vector<Acquisition_Worker> workers(n_threads);
+    for (uint32_t i = 0; i < n_threads; i++)
         {
-            msg_rx = FrontEndCal_msg_rx_make();
+            Acquisition_Worker& worker = workers[i];
+            worker.top_block = gr::make_top_block("Acquisition test");
+
+            // Satellite signal definition
+            worker.gnss_synchro = std::make_shared<Gnss_Synchro>();
+            worker.gnss_synchro->Channel_ID = i;
+            worker.gnss_synchro->System = 'G';
+            std::string signal = "1C";
+            signal.copy(worker.gnss_synchro->Signal, 2, 0);
+            worker.gnss_synchro->PRN = 1;
+
+            worker.acquisition = std::make_shared<GpsL1CaPcpsAcquisitionFineDoppler>(configuration.get(), "Acquisition", 1, 1);
+            worker.acquisition->set_channel(i + 1);
+            worker.acquisition->set_gnss_synchro(worker.gnss_synchro.get());
+            worker.acquisition->set_threshold(configuration->property("Acquisition.threshold", 2.0));
+            worker.acquisition->set_doppler_max(configuration->property("Acquisition.doppler_max", 10000));
+            worker.acquisition->set_doppler_step(configuration->property("Acquisition.doppler_step", 250));
+
+            worker.source = gr::blocks::file_source::make(sizeof(gr_complex), "tmp_capture.dat");
+            try
+                {
+                    worker.msg_rx = FrontEndCal_msg_rx_make(worker.gnss_synchro.get());
+                }
+            catch (const std::exception& e)
+                {
+                    std::cout << "Failure connecting the message port system: " << e.what() << std::endl;
+                    exit(0);
+                }
+
+            try
+                {
+                    worker.acquisition->connect(worker.top_block);
+                    worker.top_block->connect(worker.source, 0, worker.acquisition->get_left_block(), 0);
+                    worker.top_block->msg_connect(worker.acquisition->get_right_block(), pmt::mp("events"), worker.msg_rx, pmt::mp("events"));
+                }
+            catch (const std::exception& e)
+                {
+                    std::cout << "Failure connecting the GNU Radio blocks: " << e.what() << std::endl;
+                }
         }
-    catch (const std::exception& e)
+
+    // Get user position from config file (or from SUPL using GSM Cell ID)
+    double lat_deg = configuration->property("GNSS-SDR.init_latitude_deg", 41.0);
+    double lon_deg = configuration->property("GNSS-SDR.init_longitude_deg", 2.0);
+    double altitude_m = configuration->property("GNSS-SDR.init_altitude_m", 100);
+
+    // 5. Run the flowgraphs
+    // Get visible GPS satellites (positive acquisitions with Doppler measurements)
+    // Compute Doppler estimations
+    Acquisition_Jobs jobs;
+    jobs.front_end_cal = &front_end_cal;
+    jobs.lat_deg = lat_deg;
+    jobs.lon_deg = lon_deg;
+    jobs.altitude_m = altitude_m;
+    jobs.fs_in = static_cast<double>(fs_in_);
+    jobs.min_satellites = configuration->property("Acquisition.calibration_min_satellites", 4);
+    jobs.max_spread_hz = configuration->property("Acquisition.calibration_max_spread_hz", 500.0);
+
+    // Satellites with SUPL ephemeris are searched first, so they can contribute to the early stop
+    std::map<int, Gps_Ephemeris> supl_eph_map = global_gps_ephemeris_map.get_map_copy();
+    if (!supl_eph_map.empty())
         {
-            std::cout << "Failure connecting the message port system: " << e.what() << std::endl;
-            exit(0);
+            jobs.tow_known = true;
+            jobs.current_TOW = supl_eph_map.begin()->second.d_TOW;
         }
-
-    try
+    for (unsigned int PRN = 1; PRN < 33; PRN++)
         {
-            acquisition->connect(top_block);
-            top_block->connect(source, 0, acquisition->get_left_block(), 0);
-            top_block->msg_connect(acquisition->get_right_block(), pmt::mp("events"), msg_rx, pmt::mp("events"));
+            if (supl_eph_map.find(PRN) != supl_eph_map.end())
+                {
+                    jobs.prn_queue.push_back(PRN);
+                }
         }
-    catch (const std::exception& e)
+    for (unsigned int PRN = 1; PRN < 33; PRN++)
         {
-            std::cout << "Failure connecting the GNU Radio blocks: " << e.what() << std::endl;
+            if (supl_eph_map.find(PRN) == supl_eph_map.end())
+                {
+                    jobs.prn_queue.push_back(PRN);
+                }
         }
 
-    // 5. Run the flowgraph
-    // Get visible GPS satellites (positive acquisitions with Doppler measurements)
-    // Compute Doppler estimations
-
-    //todo: Fix the front-end cal to support new channel internal message system (no more external queues)
-    std::map<int, double> doppler_measurements_map;
-    std::map<int, double> cn0_measurements_map;
-
-    boost::thread ch_thread;
-
     // record startup time
     std::chrono::time_point<std::chrono::system_clock> start, end;
     std::chrono::duration<double> elapsed_seconds{};
     start = std::chrono::system_clock::now();
 
-    bool start_msg = true;
-
-    for (unsigned int PRN = 1; PRN < 33; PRN++)
+    std::cout << "Searching for GPS Satellites in L1 band using " << n_threads << " threads..." << std::endl;
+    std::cout << "[";
+    boost::thread_group search_threads;
+    for (auto& worker : workers)
         {
-            gnss_synchro->PRN = PRN;
-            acquisition->set_gnss_synchro(gnss_synchro);
-            acquisition->init();
-            acquisition->set_local_code();
-            acquisition->reset();
-            stop = false;
             try
                 {
-                    ch_thread = boost::thread(wait_message);
+                    search_threads.create_thread(boost::bind(&acquisition_worker, &worker, &jobs));
                 }
             catch (const boost::thread_resource_error& e)
                 {
                     LOG(INFO) << "Exception caught (thread resource error)";
                 }
-            top_block->run();
-            if (start_msg == true)
-                {
-                    std::cout << "Searching for GPS Satellites in L1 band..." << std::endl;
-                    std::cout << "[";
-                    start_msg = false;
-                }
-            if (!gnss_sync_vector.empty())
-                {
-                    std::cout << " " << PRN << " ";
-                    double doppler_measurement_hz = 0;
-                    for (auto& it : gnss_sync_vector)
-                        {
-                            doppler_measurement_hz += it.Acq_doppler_hz;
-                        }
-                    doppler_measurement_hz = doppler_measurement_hz / gnss_sync_vector.size();
-                    doppler_measurements_map.insert(std::pair<int, double>(PRN, doppler_measurement_hz));
-                }
-            else
-                {
-                    std::cout << " . ";
-                }
-            try
-                {
-                    channel_internal_queue.push(3);
-                }
-            catch (const boost::exception& e)
-                {
-                    LOG(INFO) << "Exception caught while pushing to the internal queue.";
-                }
-            try
-                {
-                    ch_thread.join();
-                }
-            catch (const boost::thread_resource_error& e)
-                {
-                    LOG(INFO) << "Exception caught while joining threads.";
-                }
-            gnss_sync_vector.clear();
-            boost::dynamic_pointer_cast<gr::blocks::file_source>(source)->seek(0, 0);
-            std::cout.flush();
         }
+    search_threads.join_all();
     std::cout << "]" << std::endl;
+    if (jobs.consistent)
+        {
+            std::cout << "Search stopped after " << jobs.doppler_measurements_map.size() << " detected satellites with consistent IF estimations" << std::endl;
+        }
+    std::map<int, double> doppler_measurements_map = jobs.doppler_measurements_map;
 
     // report the elapsed time
     end = std::chrono::system_clock::now();
@@ -495,8 +606,6 @@ int main(int argc, char** argv)
             else
                 {
                     std::cout << "Unable to get Ephemeris SUPL assistance. TOW is unknown!" << std::endl;
-                    delete acquisition;
-                    delete gnss_synchro;
                     google::ShutDownCommandLineFlags();
                     std::cout << "GNSS-SDR Front-end calibration program ended." << std::endl;
                     return 0;
@@ -505,18 +614,11 @@ int main(int argc, char** argv)
     catch (const boost::exception& e)
         {
             std::cout << "Exception in getting Global ephemeris map" << std::endl;
-            delete acquisition;
-            delete gnss_synchro;
             google::ShutDownCommandLineFlags();
             std::cout << "GNSS-SDR Front-end calibration program ended." << std::endl;
             return 0;
         }
 
-    // Get user position from config file (or from SUPL using GSM Cell ID)
-    double lat_deg = configuration->property("GNSS-SDR.init_latitude_deg", 41.0);
-    double lon_deg = configuration->property("GNSS-SDR.init_longitude_deg", 2.0);
-    double altitude_m = configuration->property("GNSS-SDR.init_altitude_m", 100);
-
     std::cout << "Reference location (defined in config file):" << std::endl;
 
     std::cout << "Latitude=" << lat_deg << " [º]" << std::endl;
@@ -526,8 +628,6 @@ int main(int argc, char** argv)
     if (doppler_measurements_map.empty())
         {
             std::cout << "Sorry, no GPS satellites detected in the front-end capture, please check the antenna setup..." << std::endl;
-            delete acquisition;
-            delete gnss_synchro;
             google::ShutDownCommandLineFlags();
             std::cout << "GNSS-SDR Front-end calibration program ended." << std::endl;
             return 0;
@@ -620,9 +720,6 @@ int main(int argc, char** argv)
                 }
         }
 
-    delete acquisition;
-    delete gnss_synchro;
-
     google::ShutDownCommandLineFlags();
     std::cout << "GNSS-SDR Front-end calibration program ended." << std::endl;
 }
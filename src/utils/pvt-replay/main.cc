@@ -0,0 +1,238 @@
+/*!
+ * \file main.cc
+ * \brief Replays a PVT replay log into the RTKLIB solver with several
+ * configurations, in parallel.
+ *
+ * The log is written by the PVT block when PVT.replay_log=true. Each
+ * configuration file is solved by its own rtklib_solver, as fast as the
+ * CPU allows, so the PVT settings can be tuned without processing the
+ * signal again.
+ *
+ * -------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2018  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *          Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------
+ */
+
+
+#include "file_configuration.h"
+#include "pvt_replay_log.h"
+#include "rtklib_pvt.h"
+#include "rtklib_solver.h"
+#include <boost/filesystem/path.hpp>
+#include <gflags/gflags.h>
+#include <glog/logging.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+
+DEFINE_int32(threads, 0, "Number of configurations solved in parallel (0: one per CPU core)");
+DEFINE_string(output_path, ".", "Directory of the solution files, one per configuration");
+DEFINE_string(merge, "", "Joins the replay logs of overlapping segments of a recording, given in time order, into this log");
+
+
+struct Replay_Result
+{
+    std::string configuration_file;
+    std::string solution_file;
+    uint64_t epochs = 0;
+    uint64_t solutions = 0;
+    uint64_t fixed = 0;
+    double elapsed_s = 0.0;
+    bool ok = false;
+};
+
+
+void replay(const std::string& log_file, Replay_Result& result)
+{
+    std::chrono::time_point<std::chrono::steady_clock> start = std::chrono::steady_clock::now();
+    Pvt_Replay_Log_Reader reader(log_file);
+    if (!reader.is_open())
+        {
+            return;
+        }
+    std::shared_ptr<ConfigurationInterface> configuration = std::make_shared<FileConfiguration>(result.configuration_file);
+    const std::string role("PVT");
+    rtk_t rtk = RtklibPvt::make_rtk(configuration.get(), role);
+    const uint32_t output_rate_ms = std::max(configuration->property(role + ".output_rate_ms", 500), 1);
+    const bool dump = configuration->property(role + ".dump", false);
+    const std::string dump_filename = configuration->property(role + ".dump_filename", std::string("./pvt.dat"));
+    const bool dump_mat = configuration->property(role + ".dump_mat", true);
+    rtklib_solver solver(static_cast<int>(reader.nchannels()), dump_filename, dump, dump_mat, rtk);
+    solver.set_averaging_depth(1);
+
+    std::ofstream solutions(result.solution_file.c_str(), std::ios::out | std::ios::trunc);
+    if (!solutions.is_open())
+        {
+            std::cerr << "Cannot open " << result.solution_file << std::endl;
+            return;
+        }
+    solutions << "% GPS week, TOW [s], latitude [deg], longitude [deg], height [m], X [m], Y [m], Z [m], status, satellites" << std::endl;
+    solutions << std::fixed;
+
+    std::vector<Gnss_Synchro> gnss_observables;
+    std::vector<uint32_t> valid_channels;
+    while (reader.next_epoch(solver, gnss_observables, valid_channels))
+        {
+            result.epochs++;
+            // same decimation as the PVT block
+            const auto rx_time_ms = static_cast<uint32_t>(gnss_observables.front().RX_time * 1000.0);
+            if (rx_time_ms % output_rate_ms != 0)
+                {
+                    continue;
+                }
+            if (solver.get_PVT(gnss_observables, valid_channels, false))
+                {
+                    result.solutions++;
+                    if (solver.pvt_sol.stat == SOLQ_FIX)
+                        {
+                            result.fixed++;
+                        }
+                    int week = 0;
+                    double tow = time2gpst(solver.pvt_sol.time, &week);
+                    solutions << week << " " << std::setprecision(3) << tow << " "
+                              << std::setprecision(9) << solver.get_latitude() << " " << solver.get_longitude() << " "
+                              << std::setprecision(4) << solver.get_height() << " "
+                              << solver.pvt_sol.rr[0] << " " << solver.pvt_sol.rr[1] << " " << solver.pvt_sol.rr[2] << " "
+                              << static_cast<int>(solver.pvt_sol.stat) << " " << static_cast<int>(solver.pvt_sol.ns) << "\n";
+                }
+        }
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    result.elapsed_s = elapsed.count();
+    result.ok = true;
+}
+
+
+int merge(int argc, char** argv)
+{
+    std::vector<std::string> segment_files(argv + 1, argv + argc);
+    Pvt_Replay_Merge_Statistics statistics;
+    if (!merge_pvt_replay_logs(segment_files, FLAGS_merge, statistics))
+        {
+            std::cerr << "Cannot merge the PVT replay logs into " << FLAGS_merge << std::endl;
+            return 1;
+        }
+    std::cout << segment_files.size() << " segments merged into " << FLAGS_merge << ": "
+              << statistics.epochs << " epochs, " << statistics.overlap_epochs << " overlapping epochs dropped, "
+              << statistics.seams << " seams, " << statistics.aligned_signals << " carrier phases aligned, "
+              << statistics.unaligned_signals << " not aligned" << std::endl;
+    return 0;
+}
+
+
+int main(int argc, char** argv)
+{
+    const std::string intro_help(
+        std::string("\n pvt-replay solves a PVT replay log with one or several receiver configurations\n") +
+        "Copyright (C) 2018 (see AUTHORS file for a list of contributors)\n" +
+        "This program comes with ABSOLUTELY NO WARRANTY;\n" +
+        "See COPYING file to see a copy of the General Public License.\n \n" +
+        "Usage: \n" +
+        "   pvt-replay [--threads=N] [--output_path=dir] <replay log> <configuration file> [<configuration file> ...]\n" +
+        "   pvt-replay --merge=<merged log> <segment replay log> [<segment replay log> ...]");
+
+    google::SetUsageMessage(intro_help);
+    google::SetVersionString("1.0");
+    google::ParseCommandLineFlags(&argc, &argv, true);
+    google::InitGoogleLogging(argv[0]);
+
+    if (!FLAGS_merge.empty() and argc > 1)
+        {
+            int status = merge(argc, argv);
+            google::ShutDownCommandLineFlags();
+            return status;
+        }
+
+    if (argc < 3)
+        {
+            std::cerr << "Usage:" << std::endl;
+            std::cerr << "   " << argv[0]
+                      << " <replay log> <configuration file> [<configuration file> ...]"
+                      << std::endl;
+            google::ShutDownCommandLineFlags();
+            return 1;
+        }
+    const std::string log_file(argv[1]);
+    {
+        Pvt_Replay_Log_Reader reader(log_file);
+        if (!reader.is_open())
+            {
+                std::cerr << "Cannot read the PVT replay log " << log_file << std::endl;
+                google::ShutDownCommandLineFlags();
+                return 1;
+            }
+    }
+
+    std::vector<Replay_Result> results(argc - 2);
+    for (int i = 2; i < argc; i++)
+        {
+            Replay_Result& result = results[i - 2];
+            result.configuration_file = argv[i];
+            result.solution_file = FLAGS_output_path + boost::filesystem::path::preferred_separator +
+                                   boost::filesystem::path(argv[i]).stem().string() + "_pvt.txt";
+        }
+
+    // each thread takes the next configuration not yet solved
+    uint32_t n_threads = FLAGS_threads > 0 ? static_cast<uint32_t>(FLAGS_threads) : std::max(std::thread::hardware_concurrency(), 1U);
+    n_threads = std::min(n_threads, static_cast<uint32_t>(results.size()));
+    std::atomic<size_t> next_configuration(0);
+    std::vector<std::thread> threads;
+    for (uint32_t t = 0; t < n_threads; t++)
+        {
+            threads.emplace_back([&]() {
+                for (size_t c = next_configuration++; c < results.size(); c = next_configuration++)
+                    {
+                        replay(log_file, results[c]);
+                    }
+            });
+        }
+    for (auto& thread : threads)
+        {
+            thread.join();
+        }
+
+    int status = 0;
+    for (const auto& result : results)
+        {
+            if (!result.ok)
+                {
+                    std::cerr << result.configuration_file << ": replay failed" << std::endl;
+                    status = 1;
+                    continue;
+                }
+            std::cout << result.configuration_file << ": " << result.epochs << " epochs, "
+                      << result.solutions << " solutions (" << result.fixed << " fixed) in "
+                      << std::setprecision(3) << result.elapsed_s << " s, stored at " << result.solution_file << std::endl;
+        }
+    google::ShutDownCommandLineFlags();
+    return status;
+}
@@ -33,6 +33,7 @@
 #include "galileo_ephemeris.h"
 #include "galileo_iono.h"
 #include "galileo_utc_model.h"
+#include "gnss_sdr_binary_store.h"
 #include "gps_ephemeris.h"
 #include "gps_iono.h"
 #include "gps_utc_model.h"
@@ -47,6 +48,118 @@
 #include <gpstk/Rinex3NavStream.hpp>
 #include <cstdlib>
 #include <iostream>
+#include <map>
+#include <string>
+#include <utility>
+
+DEFINE_double(ephemeris_window_s, 0.0, "If 0, only the latest ephemeris of each satellite is kept. Otherwise, all the ephemeris with a reference epoch within this number of seconds of the latest one are kept.");
+DEFINE_bool(xml_output, true, "Write the assistance data as XML files.");
+DEFINE_bool(binary_output, false, "Write the assistance data as compact binary stores (.bin files next to the XML file names).");
+
+
+/*
+ * Selects, while the RINEX file is being read, the ephemeris that will be
+ * written, so that the memory does not grow with the length of the file.
+ */
+template <class Eph>
+class Ephemeris_Filter
+{
+public:
+    explicit Ephemeris_Filter(double window_s) : d_window_s(window_s), d_latest_epoch(0.0), d_empty(true) {}
+
+    void add(const Eph& eph, double epoch)
+    {
+        if (d_empty or epoch > d_latest_epoch)
+            {
+                d_latest_epoch = epoch;
+                d_empty = false;
+            }
+        if (d_window_s > 0.0)
+            {
+                d_window.insert(std::pair<double, Eph>(epoch, eph));
+                // Forget the ephemeris that are already out of the window
+                d_window.erase(d_window.begin(), d_window.lower_bound(d_latest_epoch - d_window_s));
+            }
+        else
+            {
+                auto it = d_latest.find(eph.i_satellite_PRN);
+                if (it == d_latest.end() or epoch >= it->second.first)
+                    {
+                        d_latest[eph.i_satellite_PRN] = std::pair<double, Eph>(epoch, eph);
+                    }
+            }
+    }
+
+    /*
+     * Latest ephemeris indexed by PRN or, with a time window, all the
+     * ephemeris in the window sorted by epoch
+     */
+    std::map<int, Eph> get_map() const
+    {
+        std::map<int, Eph> eph_map;
+        if (d_window_s > 0.0)
+            {
+                int i = 0;
+                for (const auto& it : d_window)
+                    {
+                        eph_map[i] = it.second;
+                        i++;
+                    }
+            }
+        else
+            {
+                for (const auto& it : d_latest)
+                    {
+                        eph_map[it.first] = it.second.second;
+                    }
+            }
+        return eph_map;
+    }
+
+private:
+    double d_window_s;
+    double d_latest_epoch;
+    bool d_empty;
+    std::map<int, std::pair<double, Eph>> d_latest;
+    std::multimap<double, Eph> d_window;
+};
+
+
+/*
+ * Writes data as an XML file and/or as a binary store, according to the flags
+ */
+template <class T>
+bool write_assistance_file(const std::string& xml_filename, const std::string& tag, const T& data)
+{
+    if (FLAGS_xml_output)
+        {
+            std::ofstream ofs;
+            try
+                {
+                    ofs.open(xml_filename.c_str(), std::ofstream::trunc | std::ofstream::out);
+                    boost::archive::xml_oarchive xml(ofs);
+                    xml << boost::serialization::make_nvp(tag.c_str(), data);
+                }
+            catch (std::exception& e)
+                {
+                    std::cerr << "Problem creating the XML file " << xml_filename << ": " << e.what() << std::endl;
+                    return false;
+                }
+            std::cout << "Generated file: " << xml_filename << std::endl;
+        }
+    if (FLAGS_binary_output)
+        {
+            // Written after the XML file, so the receiver does not consider it outdated
+            const std::string binary_filename = gnss_sdr_binary_store_name(xml_filename);
+            if (!gnss_sdr_save_binary_store(binary_filename, tag, data))
+                {
+                    std::cerr << "Problem creating the binary file " << binary_filename << std::endl;
+                    return false;
+                }
+            std::cout << "Generated file: " << binary_filename << std::endl;
+        }
+    return true;
+}
 
 
 int main(int argc, char** argv)
@@ -57,7 +170,7 @@ int main(int argc, char** argv)
         "This program comes with ABSOLUTELY NO WARRANTY;\n" +
         "See COPYING file to see a copy of the General Public License.\n \n" +
         "Usage: \n" +
-        "   rinex2assist <RINEX Nav file input>");
+        "   rinex2assist <RINEX Nav file input> [--ephemeris_window_s=<seconds>] [--xml_output=<true|false>] [--binary_output=<true|false>]");
 
     google::SetUsageMessage(intro_help);
     google::SetVersionString("1.0");
@@ -72,8 +185,6 @@ int main(int argc, char** argv)
             google::ShutDownCommandLineFlags();
             return 1;
         }
-    std::string xml_filename;
-
     // Uncompress if RINEX file is gzipped
     std::string rinex_filename(argv[1]);
     std::string input_filename = rinex_filename;
@@ -149,8 +260,8 @@ int main(int argc, char** argv)
                 }
         }
 
-    std::map<int, Gps_Ephemeris> eph_map;
-    std::map<int, Galileo_Ephemeris> eph_gal_map;
+    Ephemeris_Filter<Gps_Ephemeris> eph_filter(FLAGS_ephemeris_window_s);
+    Ephemeris_Filter<Galileo_Ephemeris> eph_gal_filter(FLAGS_ephemeris_window_s);
 
     Gps_Utc_Model gps_utc_model;
     Gps_Iono gps_iono;
@@ -269,7 +380,7 @@ int main(int argc, char** argv)
                             eph.b_integrity_status_flag = false;  //
                             eph.b_alert_flag = false;             //
                             eph.b_antispoofing_flag = false;      //
-                            eph_map[i] = eph;
+                            eph_filter.add(eph, static_cast<double>(eph.i_GPS_week) * 604800.0 + static_cast<double>(eph.d_Toe));
                             i++;
                         }
                     if (rne.satSys == "E")
@@ -298,7 +409,7 @@ int main(int argc, char** argv)
                             eph.af1_4 = rne.af1;
                             eph.af2_4 = rne.af2;
                             eph.WN_5 = rne.weeknum;
-                            eph_gal_map[j] = eph;
+                            eph_gal_filter.add(eph, static_cast<double>(eph.WN_5) * 604800.0 + static_cast<double>(eph.t0e_1));
                             j++;
                         }
                 }
@@ -318,122 +429,41 @@ int main(int argc, char** argv)
             return 1;
         }
 
-    // Write XML ephemeris
+    // Write ephemeris
+    bool written = true;
     if (i != 0)
         {
-            std::ofstream ofs;
-            if (xml_filename.empty())
-                {
-                    xml_filename = "gps_ephemeris.xml";
-                }
-            try
-                {
-                    ofs.open(xml_filename.c_str(), std::ofstream::trunc | std::ofstream::out);
-                    boost::archive::xml_oarchive xml(ofs);
-                    xml << boost::serialization::make_nvp("GNSS-SDR_ephemeris_map", eph_map);
-                }
-            catch (std::exception& e)
-                {
-                    std::cerr << "Problem creating the XML file " << xml_filename << ": " << e.what() << std::endl;
-                    google::ShutDownCommandLineFlags();
-                    return 1;
-                }
-            std::cout << "Generated file: " << xml_filename << std::endl;
+            written = written and write_assistance_file("gps_ephemeris.xml", "GNSS-SDR_ephemeris_map", eph_filter.get_map());
         }
     if (j != 0)
         {
-            std::ofstream ofs2;
-            xml_filename = "gal_ephemeris.xml";
-            try
-                {
-                    ofs2.open(xml_filename.c_str(), std::ofstream::trunc | std::ofstream::out);
-                    boost::archive::xml_oarchive xml(ofs2);
-                    xml << boost::serialization::make_nvp("GNSS-SDR_gal_ephemeris_map", eph_gal_map);
-                }
-            catch (std::exception& e)
-                {
-                    std::cerr << "Problem creating the XML file " << xml_filename << ": " << e.what() << std::endl;
-                    google::ShutDownCommandLineFlags();
-                    return 1;
-                }
-            std::cout << "Generated file: " << xml_filename << std::endl;
+            written = written and write_assistance_file("gal_ephemeris.xml", "GNSS-SDR_gal_ephemeris_map", eph_gal_filter.get_map());
         }
 
-    // Write XML UTC
+    // Write UTC
     if (gps_utc_model.valid)
         {
-            std::ofstream ofs3;
-            xml_filename = "gps_utc_model.xml";
-            try
-                {
-                    ofs3.open(xml_filename.c_str(), std::ofstream::trunc | std::ofstream::out);
-                    boost::archive::xml_oarchive xml(ofs3);
-                    xml << boost::serialization::make_nvp("GNSS-SDR_utc_model", gps_utc_model);
-                }
-            catch (std::exception& e)
-                {
-                    std::cerr << "Problem creating the XML file " << xml_filename << ": " << e.what() << std::endl;
-                    google::ShutDownCommandLineFlags();
-                    return 1;
-                }
-            std::cout << "Generated file: " << xml_filename << std::endl;
+            written = written and write_assistance_file("gps_utc_model.xml", "GNSS-SDR_utc_model", gps_utc_model);
         }
 
-    // Write XML iono
+    // Write iono
     if (gps_iono.valid)
         {
-            std::ofstream ofs4;
-            xml_filename = "gps_iono.xml";
-            try
-                {
-                    ofs4.open(xml_filename.c_str(), std::ofstream::trunc | std::ofstream::out);
-                    boost::archive::xml_oarchive xml(ofs4);
-                    xml << boost::serialization::make_nvp("GNSS-SDR_iono_model", gps_iono);
-                }
-            catch (std::exception& e)
-                {
-                    std::cerr << "Problem creating the XML file " << xml_filename << ": " << e.what() << std::endl;
-                    google::ShutDownCommandLineFlags();
-                    return 1;
-                }
-            std::cout << "Generated file: " << xml_filename << std::endl;
+            written = written and write_assistance_file("gps_iono.xml", "GNSS-SDR_iono_model", gps_iono);
         }
 
     if (gal_utc_model.A0_6 != 0)
         {
-            std::ofstream ofs5;
-            xml_filename = "gal_utc_model.xml";
-            try
-                {
-                    ofs5.open(xml_filename.c_str(), std::ofstream::trunc | std::ofstream::out);
-                    boost::archive::xml_oarchive xml(ofs5);
-                    xml << boost::serialization::make_nvp("GNSS-SDR_gal_utc_model", gal_utc_model);
-                }
-            catch (std::exception& e)
-                {
-                    std::cerr << "Problem creating the XML file " << xml_filename << ": " << e.what() << std::endl;
-                    google::ShutDownCommandLineFlags();
-                    return 1;
-                }
-            std::cout << "Generated file: " << xml_filename << std::endl;
+            written = written and write_assistance_file("gal_utc_model.xml", "GNSS-SDR_gal_utc_model", gal_utc_model);
         }
     if (gal_iono.ai0_5 != 0)
         {
-            std::ofstream ofs7;
-            xml_filename = "gal_iono.xml";
-            try
-                {
-                    ofs7.open(xml_filename.c_str(), std::ofstream::trunc | std::ofstream::out);
-                    boost::archive::xml_oarchive xml(ofs7);
-                    xml << boost::serialization::make_nvp("GNSS-SDR_gal_iono_model", gal_iono);
-                }
-            catch (std::exception& e)
-                {
-                    std::cerr << "Problem creating the XML file " << xml_filename << ": " << e.what() << std::endl;
-                    google::ShutDownCommandLineFlags();
-                    return 1;
-                }
-            std::cout << "Generated file: " << xml_filename << std::endl;
+            written = written and write_assistance_file("gal_iono.xml", "GNSS-SDR_gal_iono_model", gal_iono);
+        }
+    if (!written)
+        {
+            google::ShutDownCommandLineFlags();
+            return 1;
         }
     google::ShutDownCommandLineFlags();
     return 0;
@@ -0,0 +1,54 @@
+#!/bin/sh
+# GNSS-SDR shell script that processes a recording as overlapping time segments,
+# each one by its own receiver running in parallel, and merges their PVT replay logs
+# usage: ./gnss-sdr-segments.sh ./gnss-sdr config_file.conf duration_s segments [overlap_s]
+# The configuration must read the recording with a SignalSource of implementation
+# File_Signal_Source, Mmap_File_Signal_Source or Direct_File_Signal_Source.
+# The segment configurations, logs and outputs are stored at ./segments, or at $SEGMENTS_DIR
+if [ $# -lt 4 ]; then
+ echo "usage: $0 gnss-sdr config_file.conf duration_s segments [overlap_s]"
+ exit 1
+fi
+GNSS_SDR=$1
+CONFIG=$2
+DURATION=$3
+SEGMENTS=$4
+OVERLAP=${5:-90}
+DIR=${SEGMENTS_DIR:-./segments}
+PVT_REPLAY=${PVT_REPLAY:-$(dirname "$GNSS_SDR")/pvt-replay}
+LENGTH=$(awk "BEGIN { print $DURATION / $SEGMENTS }")
+mkdir -p "$DIR"
+LOGS=""
+k=0
+while [ $k -lt "$SEGMENTS" ]
+do
+ # every segment but the first starts OVERLAP seconds early, so that its receiver
+ # is tracking and has the ephemeris when the previous segment ends
+ if [ $k -eq 0 ]; then
+  SKIP=0
+  PROCESS=$LENGTH
+ else
+  SKIP=$(awk "BEGIN { s = $k * $LENGTH - $OVERLAP; print (s > 0 ? s : 0) }")
+  PROCESS=$(awk "BEGIN { print ($k + 1) * $LENGTH - $SKIP }")
+ fi
+ if [ $k -eq $((SEGMENTS - 1)) ]; then
+  PROCESS=0
+ fi
+ mkdir -p "$DIR/segment_$k"
+ cat "$CONFIG" > "$DIR/segment_$k.conf"
+ {
+  echo ""
+  echo ";######### SEGMENT $k (added by gnss-sdr-segments.sh) ############"
+  echo "SignalSource.seconds_to_skip=$SKIP"
+  echo "SignalSource.seconds_to_process=$PROCESS"
+  echo "PVT.output_path=$DIR/segment_$k"
+  echo "PVT.replay_log=true"
+  echo "PVT.replay_log_filename=$DIR/segment_$k.log"
+ } >> "$DIR/segment_$k.conf"
+ echo "segment $k: from $SKIP s, $DIR/segment_$k.conf"
+ $GNSS_SDR --config_file="$DIR/segment_$k.conf" > "$DIR/segment_$k.out" 2>&1 &
+ LOGS="$LOGS $DIR/segment_$k.log"
+ k=$((k + 1))
+done
+wait
+$PVT_REPLAY --merge="$DIR/merged.log" $LOGS